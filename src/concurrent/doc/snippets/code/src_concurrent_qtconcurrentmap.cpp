@@ -184,3 +184,20 @@ struct Scaled
 QList<QImage> images = ...;
 QFuture<QImage> thumbnails = QtConcurrent::mapped(images, Scaled(100));
 //! [14]
+
+//! [15]
+void scale(QVector<float>::iterator begin, QVector<float>::iterator end)
+{
+    for (auto it = begin; it != end; ++it)
+        *it *= 2.0f;
+}
+
+QVector<float> samples = ...;
+QtConcurrent::blockingMapRanges(samples, 4096, scale);
+
+QFuture<double> roots = QtConcurrent::mappedRanges<double>(samples, 4096,
+    [](QVector<float>::const_iterator begin, QVector<float>::const_iterator end, double *out) {
+        for (auto it = begin; it != end; ++it)
+            *out++ = std::sqrt(*it);
+    });
+//! [15]
@@ -185,13 +185,16 @@ public:
 
     IterateKernel(Iterator _begin, Iterator _end)
         : begin(_begin), end(_end), current(_begin), currentIndex(0),
-           forIteration(selectIteration(typename std::iterator_traits<Iterator>::iterator_category())), progressReportingEnabled(true)
+           forIteration(selectIteration(typename std::iterator_traits<Iterator>::iterator_category())), fixedBlockSize(0), progressReportingEnabled(true)
     {
         iterationCount =  forIteration ? std::distance(_begin, _end) : 0;
     }
 
     virtual ~IterateKernel() { }
 
+    // A block size of 0 or less lets BlockSizeManagerV2 pick it from timing.
+    void setBlockSize(int blockSize) { fixedBlockSize = blockSize; }
+
     virtual bool runIteration(Iterator it, int index , T *result)
         { Q_UNUSED(it); Q_UNUSED(index); Q_UNUSED(result); return false; }
     virtual bool runIterations(Iterator _begin, int beginIndex, int endIndex, T *results)
@@ -229,7 +232,7 @@ public:
             if (this->isCanceled())
                 break;
 
-            const int currentBlockSize = blockSizeManager.blockSize();
+            const int currentBlockSize = fixedBlockSize > 0 ? fixedBlockSize : blockSizeManager.blockSize();
 
             if (currentIndex.load() >= iterationCount)
                 break;
@@ -252,9 +255,11 @@ public:
             resultReporter.reserveSpace(finalBlockSize);
 
             // Call user code with the current iteration range.
-            blockSizeManager.timeBeforeUser();
+            if (fixedBlockSize <= 0)
+                blockSizeManager.timeBeforeUser();
             const bool resultsAvailable = this->runIterations(begin, beginIndex, endIndex, resultReporter.getPointer());
-            blockSizeManager.timeAfterUser();
+            if (fixedBlockSize <= 0)
+                blockSizeManager.timeAfterUser();
 
             if (resultsAvailable)
                 resultReporter.reportResults(beginIndex);
@@ -316,6 +321,7 @@ public:
     bool forIteration;
     QAtomicInt iteratorThreads;
     int iterationCount;
+    int fixedBlockSize;
 
     bool progressReportingEnabled;
     QAtomicInt completed;
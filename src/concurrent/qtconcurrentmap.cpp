@@ -215,6 +215,19 @@
     value for the \e{width} and the \e{transformation mode}:
 
     \snippet code/src_concurrent_qtconcurrentmap.cpp 13
+
+    \section2 Processing Blocks of Items
+
+    QtConcurrent::mapRanges() and QtConcurrent::mappedRanges() call the
+    function once per block of consecutive items instead of once per item,
+    passing the begin and end iterators of the block. This lets numeric
+    code run a tight loop over contiguous memory that the compiler can
+    vectorize, and mappedRanges() stores the results of a whole block at
+    once. The sequence must provide random access iterators. The block
+    size is given explicitly; a value of 0 or less lets QtConcurrent pick
+    it from the measured run time, as map() does.
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 15
 */
 
 /*!
@@ -314,6 +327,77 @@
   \sa map(), {Concurrent Map and Map-Reduce}
 */
 
+/*!
+    \fn QFuture<void> QtConcurrent::mapRanges(Sequence &sequence, int blockSize, RangeFunction function)
+    \since 5.11
+
+    Splits \a sequence into blocks of \a blockSize consecutive items and
+    calls \a function once per block with the begin and end iterators of
+    the block. Modifications done through the iterators appear in
+    \a sequence. If \a blockSize is 0 or less, the block size is chosen
+    automatically.
+
+    \sa mappedRanges(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::mapRanges(Iterator begin, Iterator end, int blockSize, RangeFunction function)
+    \since 5.11
+
+    Splits the items from \a begin to \a end into blocks of \a blockSize
+    items and calls \a function once per block with the begin and end
+    iterators of the block. If \a blockSize is 0 or less, the block size is
+    chosen automatically.
+
+    \sa mappedRanges(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn void QtConcurrent::blockingMapRanges(Sequence &sequence, int blockSize, RangeFunction function)
+    \since 5.11
+
+    Like mapRanges(), but blocks until all blocks of \a sequence have been
+    processed by \a function. \a blockSize is the number of items per block.
+
+    \sa mapRanges(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn void QtConcurrent::blockingMapRanges(Iterator begin, Iterator end, int blockSize, RangeFunction function)
+    \since 5.11
+
+    Like mapRanges(), but blocks until all blocks from \a begin to \a end
+    have been processed by \a function. \a blockSize is the number of items
+    per block.
+
+    \sa mapRanges(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename T> QFuture<T> QtConcurrent::mappedRanges(const Sequence &sequence, int blockSize, RangeFunction function)
+    \since 5.11
+
+    Splits \a sequence into blocks of \a blockSize consecutive items and
+    calls \a function once per block. \a function is passed the begin and
+    end const iterators of the block and a pointer to storage for one result
+    of type \c T per item of the block, which it must fill. The returned
+    future holds the results in the order of \a sequence. If \a blockSize
+    is 0 or less, the block size is chosen automatically.
+
+    \sa mapRanges(), mapped(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename T> QFuture<T> QtConcurrent::mappedRanges(ConstIterator begin, ConstIterator end, int blockSize, RangeFunction function)
+    \since 5.11
+
+    Like mappedRanges() on a sequence, but processes the items from \a begin
+    to \a end. \a blockSize is the number of items per block and
+    \a function fills the results of each block.
+
+    \sa mapRanges(), mapped(), {Concurrent Map and Map-Reduce}
+*/
+
 /*!
   \fn T QtConcurrent::blockingMapped(const Sequence &sequence, MapFunction function)
 
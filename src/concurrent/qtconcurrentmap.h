@@ -79,6 +79,16 @@ namespace QtConcurrent {
     void blockingMap(Sequence &sequence, MapFunction function);
     void blockingMap(Iterator begin, Iterator end, MapFunction function);
 
+    QFuture<void> mapRanges(Sequence &sequence, int blockSize, RangeFunction function);
+    QFuture<void> mapRanges(Iterator begin, Iterator end, int blockSize, RangeFunction function);
+    void blockingMapRanges(Sequence &sequence, int blockSize, RangeFunction function);
+    void blockingMapRanges(Iterator begin, Iterator end, int blockSize, RangeFunction function);
+
+    template <typename T>
+    QFuture<T> mappedRanges(const Sequence &sequence, int blockSize, RangeFunction function);
+    template <typename T>
+    QFuture<T> mappedRanges(ConstIterator begin, ConstIterator end, int blockSize, RangeFunction function);
+
     template <typename T>
     T blockingMapped(const Sequence &sequence, MapFunction function);
     template <typename T>
@@ -260,6 +270,48 @@ typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType blockingMappedRe
         .startBlocking();
 }
 
+// mapRanges() on sequences
+template <typename Sequence, typename RangeFunctor>
+QFuture<void> mapRanges(Sequence &sequence, int blockSize, RangeFunctor map)
+{
+    return startMapRanges(sequence.begin(), sequence.end(), blockSize, map);
+}
+
+// mapRanges() on iterators
+template <typename Iterator, typename RangeFunctor>
+QFuture<void> mapRanges(Iterator begin, Iterator end, int blockSize, RangeFunctor map)
+{
+    return startMapRanges(begin, end, blockSize, map);
+}
+
+// blockingMapRanges() for sequences
+template <typename Sequence, typename RangeFunctor>
+void blockingMapRanges(Sequence &sequence, int blockSize, RangeFunctor map)
+{
+    startMapRanges(sequence.begin(), sequence.end(), blockSize, map).startBlocking();
+}
+
+// blockingMapRanges() for iterator ranges
+template <typename Iterator, typename RangeFunctor>
+void blockingMapRanges(Iterator begin, Iterator end, int blockSize, RangeFunctor map)
+{
+    startMapRanges(begin, end, blockSize, map).startBlocking();
+}
+
+// mappedRanges() for sequences
+template <typename ResultType, typename Sequence, typename RangeFunctor>
+QFuture<ResultType> mappedRanges(const Sequence &sequence, int blockSize, RangeFunctor map)
+{
+    return startMappedRanges<ResultType>(sequence, blockSize, map);
+}
+
+// mappedRanges() for iterator ranges
+template <typename ResultType, typename Iterator, typename RangeFunctor>
+QFuture<ResultType> mappedRanges(Iterator begin, Iterator end, int blockSize, RangeFunctor map)
+{
+    return startMappedRanges<ResultType>(begin, end, blockSize, map);
+}
+
 // mapped() for sequences with a different putput sequence type.
 template <typename OutputSequence, typename InputSequence, typename MapFunctor>
 OutputSequence blockingMapped(const InputSequence &sequence, MapFunctor map)
@@ -171,6 +171,14 @@ public:
     MappedEachKernel(Iterator begin, Iterator end, MapFunctor _map)
         : IterateKernel<Iterator, T>(begin, end), map(_map) { }
 
+    void start() override
+    {
+        IterateKernel<Iterator, T>::start();
+        // one result per item: let the future store them without locking
+        if (this->futureInterface && this->forIteration)
+            this->futureInterfaceTyped()->reserveResults(this->iterationCount);
+    }
+
     bool runIteration(Iterator it, int,  T *result) override
     {
         *result = map(*it);
@@ -191,6 +199,57 @@ public:
     }
 };
 
+// map kernel that hands whole blocks [begin, end) to the functor; parallel-for only
+template <typename Iterator, typename RangeFunctor>
+class MapRangesKernel : public IterateKernel<Iterator, void>
+{
+    Q_STATIC_ASSERT_X((std::is_base_of<std::random_access_iterator_tag,
+                       typename std::iterator_traits<Iterator>::iterator_category>::value),
+                      "QtConcurrent::mapRanges requires random access iterators");
+    RangeFunctor map;
+public:
+    typedef void ReturnType;
+    MapRangesKernel(Iterator begin, Iterator end, RangeFunctor _map)
+        : IterateKernel<Iterator, void>(begin, end), map(_map)
+    { }
+
+    bool runIterations(Iterator sequenceBeginIterator, int beginIndex, int endIndex, void *) override
+    {
+        map(sequenceBeginIterator + beginIndex, sequenceBeginIterator + endIndex);
+        return false;
+    }
+};
+
+// mapped kernel where the functor writes the results of a whole block at once
+template <typename Iterator, typename T, typename RangeFunctor>
+class MappedRangesKernel : public IterateKernel<Iterator, T>
+{
+    Q_STATIC_ASSERT_X((std::is_base_of<std::random_access_iterator_tag,
+                       typename std::iterator_traits<Iterator>::iterator_category>::value),
+                      "QtConcurrent::mappedRanges requires random access iterators");
+    RangeFunctor map;
+public:
+    typedef T ReturnType;
+    typedef T ResultType;
+
+    MappedRangesKernel(Iterator begin, Iterator end, RangeFunctor _map)
+        : IterateKernel<Iterator, T>(begin, end), map(_map)
+    { }
+
+    void start() override
+    {
+        IterateKernel<Iterator, T>::start();
+        if (this->futureInterface)
+            this->futureInterfaceTyped()->reserveResults(this->iterationCount);
+    }
+
+    bool runIterations(Iterator sequenceBeginIterator, int beginIndex, int endIndex, T *results) override
+    {
+        map(sequenceBeginIterator + beginIndex, sequenceBeginIterator + endIndex, results);
+        return true;
+    }
+};
+
 template <typename Iterator, typename Functor>
 inline ThreadEngineStarter<void> startMap(Iterator begin, Iterator end, Functor functor)
 {
@@ -235,6 +294,34 @@ inline ThreadEngineStarter<T> startMapped(const Sequence &sequence, Functor func
     return startThreadEngine(new SequenceHolderType(sequence, functor));
 }
 
+template <typename Iterator, typename RangeFunctor>
+inline ThreadEngineStarter<void> startMapRanges(Iterator begin, Iterator end, int blockSize, RangeFunctor functor)
+{
+    MapRangesKernel<Iterator, RangeFunctor> *kernel = new MapRangesKernel<Iterator, RangeFunctor>(begin, end, functor);
+    kernel->setBlockSize(blockSize);
+    return startThreadEngine(kernel);
+}
+
+template <typename T, typename Iterator, typename RangeFunctor>
+inline ThreadEngineStarter<T> startMappedRanges(Iterator begin, Iterator end, int blockSize, RangeFunctor functor)
+{
+    MappedRangesKernel<Iterator, T, RangeFunctor> *kernel = new MappedRangesKernel<Iterator, T, RangeFunctor>(begin, end, functor);
+    kernel->setBlockSize(blockSize);
+    return startThreadEngine(kernel);
+}
+
+template <typename T, typename Sequence, typename RangeFunctor>
+inline ThreadEngineStarter<T> startMappedRanges(const Sequence &sequence, int blockSize, RangeFunctor functor)
+{
+    typedef SequenceHolder1<Sequence,
+                            MappedRangesKernel<typename Sequence::const_iterator, T, RangeFunctor>, RangeFunctor>
+                            SequenceHolderType;
+
+    SequenceHolderType *kernel = new SequenceHolderType(sequence, functor);
+    kernel->setBlockSize(blockSize);
+    return startThreadEngine(kernel);
+}
+
 template <typename IntermediateType, typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
 inline ThreadEngineStarter<ResultType> startMappedReduced(const Sequence & sequence,
                                                            MapFunctor mapFunctor, ReduceFunctor reduceFunctor,
@@ -176,8 +176,14 @@ public:
     void asynchronousFinish() Q_DECL_OVERRIDE
     {
         finish();
-        futureInterfaceTyped()->reportFinished(result());
-        delete futureInterfaceTyped();
+        QFutureInterface<T> *typedInterface = futureInterfaceTyped();
+        if (const T *finalResult = result())
+            typedInterface->reportResult(finalResult, -1);
+        // Release the engine's hold on the results before waking up the
+        // waiters, so that they are owned by the remaining futures only.
+        QFutureInterfaceBase finishingInterface(*typedInterface);
+        delete typedInterface;
+        finishingInterface.reportFinished();
         delete this;
     }
 
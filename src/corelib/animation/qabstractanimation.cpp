@@ -306,10 +306,11 @@ void QUnifiedTimer::updateAnimationTimers(qint64 currentTick)
         return;
 
     qint64 totalElapsed = currentTick > 0 ? currentTick : elapsed();
+    const qint64 elapsedSinceLastTick = totalElapsed - lastTick;
 
     // ignore consistentTiming in case the pause timer is active
     qint64 delta = (consistentTiming && !pauseTimer.isActive()) ?
-                        timingInterval : totalElapsed - lastTick;
+                        timingInterval : elapsedSinceLastTick;
     if (slowMode) {
         if (slowdownFactor > 0)
             delta = qRound(delta / slowdownFactor);
@@ -325,6 +326,15 @@ void QUnifiedTimer::updateAnimationTimers(qint64 currentTick)
     //* it might happen in some cases that the delta is negative because the animation driver
     //  advances faster than time.elapsed()
     if (delta > 0) {
+        // while the pause timer is active, time jumps on purpose
+        if (driver->isRunning() && !pauseTimer.isActive() && timingInterval > 0) {
+            const qint64 frames = (elapsedSinceLastTick + timingInterval / 2) / timingInterval;
+            if (frames > 1)
+                statistics.droppedFrameCount += frames - 1;
+        }
+
+        QElapsedTimer tickTimer;
+        tickTimer.start();
         insideTick = true;
         if (profilerCallback)
             profilerCallback(delta);
@@ -334,6 +344,12 @@ void QUnifiedTimer::updateAnimationTimers(qint64 currentTick)
         }
         insideTick = false;
         currentAnimationIdx = 0;
+
+        const qint64 tickDuration = tickTimer.nsecsElapsed();
+        ++statistics.tickCount;
+        statistics.lastTickDuration = tickDuration;
+        statistics.maximumTickDuration = qMax(statistics.maximumTickDuration, tickDuration);
+        statistics.totalTickDuration += tickDuration;
     }
 }
 
@@ -562,7 +578,7 @@ QAnimationTimer::QAnimationTimer() :
     QAbstractAnimationTimer(), lastTick(0),
     currentAnimationIdx(0), insideTick(false),
     startAnimationPending(false), stopTimerPending(false),
-    runningLeafAnimations(0)
+    removedAnimationCount(0), runningLeafAnimations(0)
 {
 }
 
@@ -612,12 +628,23 @@ void QAnimationTimer::updateAnimationsTime(qint64 delta)
         insideTick = true;
         for (currentAnimationIdx = 0; currentAnimationIdx < animations.count(); ++currentAnimationIdx) {
             QAbstractAnimation *animation = animations.at(currentAnimationIdx);
+            if (!animation)
+                continue; // stopped earlier in this tick
             int elapsed = QAbstractAnimationPrivate::get(animation)->totalCurrentTime
                           + (animation->direction() == QAbstractAnimation::Forward ? delta : -delta);
             animation->setCurrentTime(elapsed);
         }
         insideTick = false;
         currentAnimationIdx = 0;
+
+        if (removedAnimationCount) {
+            animations.removeAll(nullptr);
+            removedAnimationCount = 0;
+            if (animations.isEmpty() && !stopTimerPending) {
+                stopTimerPending = true;
+                QMetaObject::invokeMethod(this, "stopTimer", Qt::QueuedConnection);
+            }
+        }
     }
 }
 
@@ -658,7 +685,7 @@ void QAnimationTimer::stopTimer()
 {
     stopTimerPending = false;
     bool pendingStart = startAnimationPending && animationsToStart.size() > 0;
-    if (animations.isEmpty() && !pendingStart) {
+    if (animations.count() == removedAnimationCount && !pendingStart) {
         QUnifiedTimer::resumeAnimationTimer(this);
         QUnifiedTimer::stopAnimationTimer(this);
         // invalidate the start reference time
@@ -693,6 +720,23 @@ void QAnimationTimer::unregisterAnimation(QAbstractAnimation *animation)
         if (!QAbstractAnimationPrivate::get(animation)->hasRegisteredTimer)
             return;
 
+        if (inst->insideTick) {
+            // animations mostly stop from within their own setCurrentTime(),
+            // so look at the one being updated first; the list is compacted
+            // once the tick is over instead of shifting it for each of them
+            const int current = inst->currentAnimationIdx;
+            const int idx = (current < inst->animations.count() && inst->animations.at(current) == animation)
+                            ? current : inst->animations.indexOf(animation);
+            if (idx != -1) {
+                inst->animations[idx] = nullptr;
+                ++inst->removedAnimationCount;
+            } else {
+                inst->animationsToStart.removeOne(animation);
+            }
+            QAbstractAnimationPrivate::get(animation)->hasRegisteredTimer = false;
+            return;
+        }
+
         int idx = inst->animations.indexOf(animation);
         if (idx != -1) {
             inst->animations.removeAt(idx);
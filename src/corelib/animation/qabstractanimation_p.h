@@ -191,6 +191,24 @@ public:
     int runningAnimationCount();
     void registerProfilerCallback(void (*cb)(qint64));
 
+    struct FrameStatistics
+    {
+        FrameStatistics()
+            : tickCount(0), droppedFrameCount(0),
+              lastTickDuration(0), maximumTickDuration(0), totalTickDuration(0)
+        {}
+
+        qint64 tickCount;
+        // frames of timingInterval that went by without a tick
+        qint64 droppedFrameCount;
+        // time spent updating the animations, in nanoseconds
+        qint64 lastTickDuration;
+        qint64 maximumTickDuration;
+        qint64 totalTickDuration;
+    };
+    FrameStatistics frameStatistics() const { return statistics; }
+    void resetFrameStatistics() { statistics = FrameStatistics(); }
+
     void startAnimationDriver();
     void stopAnimationDriver();
     qint64 elapsed() const;
@@ -235,6 +253,7 @@ private:
     int closestPausedAnimationTimerTimeToFinish();
 
     void (*profilerCallback)(qint64);
+    FrameStatistics statistics;
 
     qint64 driverStartTime; // The time the animation driver was started
     qint64 temporalDrift; // The delta between animation driver time and wall time.
@@ -269,7 +288,7 @@ public:
     void updateAnimationsTime(qint64 delta) Q_DECL_OVERRIDE;
 
     //useful for profiling/debugging
-    int runningAnimationCount() Q_DECL_OVERRIDE { return animations.count(); }
+    int runningAnimationCount() Q_DECL_OVERRIDE { return animations.count() - removedAnimationCount; }
 
 private Q_SLOTS:
     void startAnimations();
@@ -284,6 +303,10 @@ private:
 
     QList<QAbstractAnimation*> animations, animationsToStart;
 
+    // animations stopped during a tick are nulled out in animations and
+    // removed all at once when the tick is over
+    int removedAnimationCount;
+
     // this is the count of running animations that are not a group neither a pause animation
     int runningLeafAnimations;
     QList<QAbstractAnimation*> runningPauseAnimations;
@@ -152,6 +152,23 @@ static inline bool simdDecodeAscii(ushort *&dst, const uchar *&nextAscii, const
     }
     return src == end;
 }
+
+static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end, const uchar *&nextAscii)
+{
+    // do sixteen characters at a time
+    for ( ; end - src >= 16; src += 16) {
+        __m128i data = _mm_loadu_si128((const __m128i*)src);
+        uint n = _mm_movemask_epi8(data);
+        if (!n)
+            continue;
+
+        // find the next probable ASCII character
+        nextAscii = src + qBitScanReverse(n) + 1;
+        return src + qCountTrailingZeroBits(n);
+    }
+    nextAscii = end;
+    return src;
+}
 #elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vaddv is only available on Aarch64
 static inline bool simdEncodeAscii(uchar *&dst, const ushort *&nextAscii, const ushort *&src, const ushort *end)
 {
@@ -220,6 +237,19 @@ static inline bool simdDecodeAscii(ushort *&dst, const uchar *&nextAscii, const
     }
     return src == end;
 }
+
+static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end, const uchar *&nextAscii)
+{
+    // do sixteen characters at a time
+    for ( ; end - src >= 16; src += 16) {
+        if (vmaxvq_u8(vld1q_u8(src)) < 0x80)
+            continue;
+        nextAscii = src + 16;
+        return src;
+    }
+    nextAscii = end;
+    return src;
+}
 #else
 static inline bool simdEncodeAscii(uchar *, const ushort *, const ushort *, const ushort *)
 {
@@ -230,6 +260,338 @@ static inline bool simdDecodeAscii(ushort *, const uchar *, const uchar *, const
 {
     return false;
 }
+
+static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end, const uchar *&nextAscii)
+{
+    nextAscii = end;
+    return src;
+}
+#endif
+
+// Runs of characters that take two or three bytes in UTF-8 make up most of
+// non-Latin text: Greek, Cyrillic, Hebrew and Arabic letters take two bytes,
+// CJK ideographs three. The functions below convert such runs a block at a
+// time. They only accept valid sequences that are all of one length and
+// stop at the first other character, which the caller then handles. The
+// stores may write past the converted characters, but never past the worst
+// case size of the output buffer.
+#if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+// returns the number of leading 16-bit lanes of \a mask that are all ones
+static Q_ALWAYS_INLINE uint validLanes(__m128i mask)
+{
+    const uint invalid = ~uint(_mm_movemask_epi8(mask)) & 0xffff;
+    return invalid ? qCountTrailingZeroBits(invalid) / 2 : 8;
+}
+
+static inline void simdDecodeTwoByte(ushort *&dst, const uchar *&src, const uchar *end)
+{
+    // eight sequences at a time: the low byte of each 16-bit lane is the lead
+    // byte (110xxxxx), the high byte the continuation byte (10xxxxxx)
+    const __m128i typeMask = _mm_set1_epi16(short(0xc0e0));
+    const __m128i typeBits = _mm_set1_epi16(short(0x80c0));
+    const __m128i overlongMask = _mm_set1_epi16(0x1e);
+    for ( ; end - src >= 16; src += 16, dst += 8) {
+        const __m128i data = _mm_loadu_si128((const __m128i*)src);
+
+        // lead bytes 0xC0 and 0xC1 only start overlong sequences
+        const __m128i valid = _mm_andnot_si128(
+                    _mm_cmpeq_epi16(_mm_and_si128(data, overlongMask), _mm_setzero_si128()),
+                    _mm_cmpeq_epi16(_mm_and_si128(data, typeMask), typeBits));
+
+        const __m128i high = _mm_slli_epi16(_mm_and_si128(data, _mm_set1_epi16(0x1f)), 6);
+        const __m128i low = _mm_and_si128(_mm_srli_epi16(data, 8), _mm_set1_epi16(0x3f));
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(high, low));
+
+        const uint n = validLanes(valid);
+        if (n != 8) {
+            src += 2 * n;
+            dst += n;
+            return;
+        }
+    }
+}
+
+static inline void simdEncodeTwoByte(uchar *&dst, const ushort *&src, const ushort *end)
+{
+    // eight characters at a time, for U+0080 to U+07FF
+    for ( ; end - src >= 8; src += 8, dst += 16) {
+        const __m128i data = _mm_loadu_si128((const __m128i*)src);
+        const __m128i valid = _mm_andnot_si128(
+                    _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))), _mm_setzero_si128()),
+                    _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))), _mm_setzero_si128()));
+
+        const __m128i lead = _mm_or_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0xc0));
+        const __m128i continuation = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(data, _mm_set1_epi16(0x3f)), 8),
+                                                  _mm_set1_epi16(short(0x8000)));
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(lead, continuation));
+
+        const uint n = validLanes(valid);
+        if (n != 8) {
+            src += n;
+            dst += 2 * n;
+            return;
+        }
+    }
+}
+
+#  if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+// Three-byte sequences need a byte shuffle, so they are only converted if
+// the processor supports SSSE3.
+QT_FUNCTION_TARGET(SSSE3)
+static void simdDecodeThreeByte_ssse3(ushort *&dst, const uchar *&src, const uchar *end)
+{
+    // four sequences from each of two overlapping loads; in the 16-bit lanes
+    // of "lead" the low byte is the second byte, the high byte the first one
+    const __m128i leadShuffle = _mm_setr_epi8(1, 0, 4, 3, 7, 6, 10, 9, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i lastShuffle = _mm_setr_epi8(2, -1, 5, -1, 8, -1, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    for ( ; end - src >= 28; src += 24, dst += 8) {
+        const __m128i data1 = _mm_loadu_si128((const __m128i*)src);
+        const __m128i data2 = _mm_loadu_si128((const __m128i*)(src + 12));
+        const __m128i lead = _mm_unpacklo_epi64(_mm_shuffle_epi8(data1, leadShuffle),
+                                                _mm_shuffle_epi8(data2, leadShuffle));
+        const __m128i last = _mm_unpacklo_epi64(_mm_shuffle_epi8(data1, lastShuffle),
+                                                _mm_shuffle_epi8(data2, lastShuffle));
+
+        const __m128i result = _mm_or_si128(
+                    _mm_or_si128(_mm_slli_epi16(_mm_and_si128(lead, _mm_set1_epi16(0x0f00)), 4),
+                                 _mm_slli_epi16(_mm_and_si128(lead, _mm_set1_epi16(0x3f)), 6)),
+                    _mm_and_si128(last, _mm_set1_epi16(0x3f)));
+        _mm_storeu_si128((__m128i*)dst, result);
+
+        // check the types of the bytes (1110xxxx 10xxxxxx 10xxxxxx), then
+        // reject overlong sequences and surrogates
+        const __m128i top = _mm_and_si128(result, _mm_set1_epi16(short(0xf800)));
+        __m128i valid = _mm_and_si128(
+                    _mm_cmpeq_epi16(_mm_and_si128(lead, _mm_set1_epi16(short(0xf0c0))), _mm_set1_epi16(short(0xe080))),
+                    _mm_cmpeq_epi16(_mm_and_si128(last, _mm_set1_epi16(0xc0)), _mm_set1_epi16(0x80)));
+        valid = _mm_andnot_si128(_mm_cmpeq_epi16(top, _mm_setzero_si128()), valid);
+        valid = _mm_andnot_si128(_mm_cmpeq_epi16(top, _mm_set1_epi16(short(0xd800))), valid);
+
+        const uint n = validLanes(valid);
+        if (n != 8) {
+            src += 3 * n;
+            dst += n;
+            return;
+        }
+    }
+}
+
+QT_FUNCTION_TARGET(SSSE3)
+static void simdEncodeThreeByte_ssse3(uchar *&dst, const ushort *&src, const ushort *end)
+{
+    // in "leading", the first and second bytes of each sequence are in the
+    // low and high byte of the 16-bit lanes; in "last", the third byte is in
+    // the low byte. Each shuffle interleaves four sequences into 12 bytes.
+    const __m128i leadingShuffle1 = _mm_setr_epi8(0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, -1, -1, -1, -1);
+    const __m128i lastShuffle1 = _mm_setr_epi8(-1, -1, 0, -1, -1, 2, -1, -1, 4, -1, -1, 6, -1, -1, -1, -1);
+    const __m128i leadingShuffle2 = _mm_setr_epi8(8, 9, -1, 10, 11, -1, 12, 13, -1, 14, 15, -1, -1, -1, -1, -1);
+    const __m128i lastShuffle2 = _mm_setr_epi8(-1, -1, 8, -1, -1, 10, -1, -1, 12, -1, -1, 14, -1, -1, -1, -1);
+    for ( ; end - src >= 16; src += 8, dst += 24) {
+        const __m128i data = _mm_loadu_si128((const __m128i*)src);
+        const __m128i top = _mm_and_si128(data, _mm_set1_epi16(short(0xf800)));
+        const __m128i valid = _mm_andnot_si128(
+                    _mm_or_si128(_mm_cmpeq_epi16(top, _mm_setzero_si128()),
+                                 _mm_cmpeq_epi16(top, _mm_set1_epi16(short(0xd800)))),
+                    _mm_set1_epi16(-1));
+
+        const __m128i leading = _mm_or_si128(
+                    _mm_or_si128(_mm_srli_epi16(data, 12), _mm_set1_epi16(0xe0)),
+                    _mm_or_si128(_mm_slli_epi16(_mm_and_si128(data, _mm_set1_epi16(0x0fc0)), 2),
+                                 _mm_set1_epi16(short(0x8000))));
+        const __m128i last = _mm_or_si128(_mm_and_si128(data, _mm_set1_epi16(0x3f)), _mm_set1_epi16(0x80));
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_shuffle_epi8(leading, leadingShuffle1),
+                                                     _mm_shuffle_epi8(last, lastShuffle1)));
+        _mm_storeu_si128((__m128i*)(dst + 12), _mm_or_si128(_mm_shuffle_epi8(leading, leadingShuffle2),
+                                                            _mm_shuffle_epi8(last, lastShuffle2)));
+
+        const uint n = validLanes(valid);
+        if (n != 8) {
+            src += n;
+            dst += 3 * n;
+            return;
+        }
+    }
+}
+#  endif
+
+static inline void simdDecodeMultiByte(ushort *&dst, const uchar *&src, const uchar *end, int length)
+{
+    if (length == 2) {
+        simdDecodeTwoByte(dst, src, end);
+#  if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    } else if (length == 3 && qCpuHasFeature(SSSE3)) {
+        simdDecodeThreeByte_ssse3(dst, src, end);
+#  endif
+    }
+}
+
+static inline void simdEncodeMultiByte(uchar *&dst, const ushort *&src, const ushort *end, ushort uc)
+{
+    if (uc < 0x800) {
+        simdEncodeTwoByte(dst, src, end);
+#  if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    } else if (qCpuHasFeature(SSSE3)) {
+        simdEncodeThreeByte_ssse3(dst, src, end);
+#  endif
+    }
+}
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+// returns the number of leading 8-bit lanes of \a mask that are all ones
+static Q_ALWAYS_INLINE uint validLanes(uint8x16_t mask)
+{
+    // narrowing shift: four bits per lane
+    const quint64 bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0);
+    return ~bits ? qCountTrailingZeroBits(~bits) / 4 : 16;
+}
+
+static inline void simdDecodeTwoByte(ushort *&dst, const uchar *&src, const uchar *end)
+{
+    // sixteen sequences at a time, loaded as separate lanes of lead and
+    // continuation bytes
+    for ( ; end - src >= 32; src += 32, dst += 16) {
+        const uint8x16x2_t in = vld2q_u8(src);
+        const uint8x16_t lead = vandq_u8(in.val[0], vdupq_n_u8(0x1f));
+        const uint8x16_t continuation = vandq_u8(in.val[1], vdupq_n_u8(0x3f));
+
+        // lead bytes 0xC0 and 0xC1 only start overlong sequences
+        const uint8x16_t valid = vandq_u8(
+                    vandq_u8(vceqq_u8(vandq_u8(in.val[0], vdupq_n_u8(0xe0)), vdupq_n_u8(0xc0)),
+                             vcgeq_u8(in.val[0], vdupq_n_u8(0xc2))),
+                    vceqq_u8(vandq_u8(in.val[1], vdupq_n_u8(0xc0)), vdupq_n_u8(0x80)));
+
+        vst1q_u16(dst, vorrq_u16(vshll_n_u8(vget_low_u8(lead), 6), vmovl_u8(vget_low_u8(continuation))));
+        vst1q_u16(dst + 8, vorrq_u16(vshll_n_u8(vget_high_u8(lead), 6), vmovl_u8(vget_high_u8(continuation))));
+
+        const uint n = validLanes(valid);
+        if (n != 16) {
+            src += 2 * n;
+            dst += n;
+            return;
+        }
+    }
+}
+
+static inline void simdEncodeTwoByte(uchar *&dst, const ushort *&src, const ushort *end)
+{
+    // sixteen characters at a time, for U+0080 to U+07FF
+    for ( ; end - src >= 16; src += 16, dst += 32) {
+        const uint16x8_t data1 = vld1q_u16(src);
+        const uint16x8_t data2 = vld1q_u16(src + 8);
+        const uint8x16_t valid = vcombine_u8(
+                    vmovn_u16(vandq_u16(vcgeq_u16(data1, vdupq_n_u16(0x80)), vcltq_u16(data1, vdupq_n_u16(0x800)))),
+                    vmovn_u16(vandq_u16(vcgeq_u16(data2, vdupq_n_u16(0x80)), vcltq_u16(data2, vdupq_n_u16(0x800)))));
+
+        uint8x16x2_t out;
+        out.val[0] = vorrq_u8(vcombine_u8(vshrn_n_u16(data1, 6), vshrn_n_u16(data2, 6)), vdupq_n_u8(0xc0));
+        out.val[1] = vorrq_u8(vandq_u8(vcombine_u8(vmovn_u16(data1), vmovn_u16(data2)), vdupq_n_u8(0x3f)),
+                              vdupq_n_u8(0x80));
+        vst2q_u8(dst, out);
+
+        const uint n = validLanes(valid);
+        if (n != 16) {
+            src += n;
+            dst += 2 * n;
+            return;
+        }
+    }
+}
+
+static inline void simdDecodeThreeByte(ushort *&dst, const uchar *&src, const uchar *end)
+{
+    // sixteen sequences at a time, loaded as three lanes of bytes
+    for ( ; end - src >= 48; src += 48, dst += 16) {
+        const uint8x16x3_t in = vld3q_u8(src);
+        const uint8x16_t first = vandq_u8(in.val[0], vdupq_n_u8(0x0f));
+        const uint8x16_t second = vandq_u8(in.val[1], vdupq_n_u8(0x3f));
+        const uint8x16_t third = vandq_u8(in.val[2], vdupq_n_u8(0x3f));
+
+        const uint16x8_t result1 = vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(vget_low_u8(first)), 12),
+                                                       vshll_n_u8(vget_low_u8(second), 6)),
+                                             vmovl_u8(vget_low_u8(third)));
+        const uint16x8_t result2 = vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(vget_high_u8(first)), 12),
+                                                       vshll_n_u8(vget_high_u8(second), 6)),
+                                             vmovl_u8(vget_high_u8(third)));
+        vst1q_u16(dst, result1);
+        vst1q_u16(dst + 8, result2);
+
+        // check the types of the bytes (1110xxxx 10xxxxxx 10xxxxxx), then
+        // reject overlong sequences and surrogates
+        const uint8x16_t types = vandq_u8(
+                    vceqq_u8(vandq_u8(in.val[0], vdupq_n_u8(0xf0)), vdupq_n_u8(0xe0)),
+                    vandq_u8(vceqq_u8(vandq_u8(in.val[1], vdupq_n_u8(0xc0)), vdupq_n_u8(0x80)),
+                             vceqq_u8(vandq_u8(in.val[2], vdupq_n_u8(0xc0)), vdupq_n_u8(0x80))));
+        const uint16x8_t range1 = vandq_u16(vcgeq_u16(result1, vdupq_n_u16(0x800)),
+                                            vmvnq_u16(vceqq_u16(vandq_u16(result1, vdupq_n_u16(0xf800)),
+                                                                vdupq_n_u16(0xd800))));
+        const uint16x8_t range2 = vandq_u16(vcgeq_u16(result2, vdupq_n_u16(0x800)),
+                                            vmvnq_u16(vceqq_u16(vandq_u16(result2, vdupq_n_u16(0xf800)),
+                                                                vdupq_n_u16(0xd800))));
+        const uint8x16_t valid = vandq_u8(types, vcombine_u8(vmovn_u16(range1), vmovn_u16(range2)));
+
+        const uint n = validLanes(valid);
+        if (n != 16) {
+            src += 3 * n;
+            dst += n;
+            return;
+        }
+    }
+}
+
+static inline void simdEncodeThreeByte(uchar *&dst, const ushort *&src, const ushort *end)
+{
+    // sixteen characters at a time, for U+0800 to U+FFFF except surrogates
+    for ( ; end - src >= 16; src += 16, dst += 48) {
+        const uint16x8_t data1 = vld1q_u16(src);
+        const uint16x8_t data2 = vld1q_u16(src + 8);
+        const uint16x8_t valid1 = vandq_u16(vcgeq_u16(data1, vdupq_n_u16(0x800)),
+                                            vmvnq_u16(vceqq_u16(vandq_u16(data1, vdupq_n_u16(0xf800)),
+                                                                vdupq_n_u16(0xd800))));
+        const uint16x8_t valid2 = vandq_u16(vcgeq_u16(data2, vdupq_n_u16(0x800)),
+                                            vmvnq_u16(vceqq_u16(vandq_u16(data2, vdupq_n_u16(0xf800)),
+                                                                vdupq_n_u16(0xd800))));
+        const uint8x16_t valid = vcombine_u8(vmovn_u16(valid1), vmovn_u16(valid2));
+
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vcombine_u8(vmovn_u16(vshrq_n_u16(data1, 12)), vmovn_u16(vshrq_n_u16(data2, 12))),
+                              vdupq_n_u8(0xe0));
+        out.val[1] = vorrq_u8(vandq_u8(vcombine_u8(vshrn_n_u16(data1, 6), vshrn_n_u16(data2, 6)), vdupq_n_u8(0x3f)),
+                              vdupq_n_u8(0x80));
+        out.val[2] = vorrq_u8(vandq_u8(vcombine_u8(vmovn_u16(data1), vmovn_u16(data2)), vdupq_n_u8(0x3f)),
+                              vdupq_n_u8(0x80));
+        vst3q_u8(dst, out);
+
+        const uint n = validLanes(valid);
+        if (n != 16) {
+            src += n;
+            dst += 3 * n;
+            return;
+        }
+    }
+}
+
+static inline void simdDecodeMultiByte(ushort *&dst, const uchar *&src, const uchar *end, int length)
+{
+    if (length == 2)
+        simdDecodeTwoByte(dst, src, end);
+    else if (length == 3)
+        simdDecodeThreeByte(dst, src, end);
+}
+
+static inline void simdEncodeMultiByte(uchar *&dst, const ushort *&src, const ushort *end, ushort uc)
+{
+    if (uc < 0x800)
+        simdEncodeTwoByte(dst, src, end);
+    else
+        simdEncodeThreeByte(dst, src, end);
+}
+#else
+static inline void simdDecodeMultiByte(ushort *&, const uchar *&, const uchar *, int)
+{
+}
+
+static inline void simdEncodeMultiByte(uchar *&, const ushort *&, const ushort *, ushort)
+{
+}
 #endif
 
 QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len)
@@ -251,6 +613,9 @@ QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len)
             if (res < 0) {
                 // encoding error - append '?'
                 *dst++ = '?';
+            } else if (uc >= 0x80) {
+                // continue with a block of characters of the same length, if any
+                simdEncodeMultiByte(dst, src, end, uc);
             }
         } while (src < nextAscii);
     }
@@ -302,8 +667,11 @@ QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len, QTextCodec::Conve
             uc = *src++;
             res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, cursor, src, end);
         }
-        if (Q_LIKELY(res >= 0))
+        if (Q_LIKELY(res >= 0)) {
+            if (uc >= 0x80)
+                simdEncodeMultiByte(cursor, src, end, uc);
             continue;
+        }
 
         if (res == QUtf8BaseTraits::Error) {
             // encoding error
@@ -394,6 +762,9 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, const char *chars, int len) Q_DECL
                 if (res < 0) {
                     // decoding error
                     *dst++ = QChar::ReplacementCharacter;
+                } else if (res > 1) {
+                    // continue with a block of sequences of the same length, if any
+                    simdDecodeMultiByte(dst, src, end, res);
                 }
             } while (src < nextAscii);
         }
@@ -402,6 +773,55 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, const char *chars, int len) Q_DECL
     return reinterpret_cast<QChar *>(dst);
 }
 
+/*!
+    \internal
+    \since 5.11
+
+    Checks whether the \a len octets beginning at \a chars are valid UTF-8,
+    without decoding them. The result also tells whether they are plain
+    US-ASCII.
+*/
+QUtf8::ValidUtf8Result QUtf8::isValidUtf8(const char *chars, qsizetype len) Q_DECL_NOTHROW
+{
+    const uchar *src = reinterpret_cast<const uchar *>(chars);
+    const uchar *end = src + len;
+    const uchar *nextAscii = src;
+    bool isValidAscii = true;
+    ushort scratch[256];
+
+    while (src < end) {
+        if (src >= nextAscii)
+            src = simdFindNonAscii(src, end, nextAscii);
+        if (src == end)
+            break;
+
+        do {
+            uchar b = *src++;
+            if ((b & 0x80) == 0)
+                continue;
+
+            isValidAscii = false;
+            QUtf8NoOutputTraits::NoOutput output;
+            int res = QUtf8Functions::fromUtf8<QUtf8NoOutputTraits>(b, output, src, end);
+            if (res < 0) {
+                // decoding error
+                ValidUtf8Result result = { false, false };
+                return result;
+            }
+            if (res > 1) {
+                // skip a block of sequences of the same length, if any, by
+                // decoding them into the scratch buffer
+                ushort *dst = scratch;
+                const uchar *blockEnd = src + qMin<qptrdiff>(end - src, sizeof(scratch) / sizeof(scratch[0]));
+                simdDecodeMultiByte(dst, src, blockEnd, res);
+            }
+        } while (src < nextAscii);
+    }
+
+    ValidUtf8Result result = { true, isValidAscii };
+    return result;
+}
+
 QString QUtf8::convertToUnicode(const char *chars, int len, QTextCodec::ConverterState *state)
 {
     bool headerdone = false;
@@ -488,6 +908,8 @@ QString QUtf8::convertToUnicode(const char *chars, int len, QTextCodec::Converte
                     --dst;
             }
         }
+        if (res > 1)
+            simdDecodeMultiByte(dst, src, end, res);
         if (res == QUtf8BaseTraits::Error) {
             res = 0;
             ++invalid;
@@ -72,3 +72,13 @@ i.toBack();
 while (i.hasPrevious())
     qDebug() << i.previous();
 //! [2]
+
+
+//! [3]
+QFuture<QByteArray> download = QtConcurrent::run(fetchPage, url);
+QFuture<int> wordCount = download.then([](const QByteArray &page) {
+    return countWords(page);
+}).onFailed([](const QException &) {
+    return 0;
+});
+//! [3]
@@ -191,3 +191,8 @@ ba.fill(true, 1, 2);            // ba: [ 0, 1, 0, 0 ]
 ba.fill(true, 1, 3);            // ba: [ 0, 1, 1, 0 ]
 ba.fill(true, 1, 4);            // ba: [ 0, 1, 1, 1 ]
 //! [15]
+
+//! [16]
+for (int i = ba.indexOf(true); i != -1; i = ba.indexOf(true, i + 1))
+    qDebug() << "bit" << i << "is set";
+//! [16]
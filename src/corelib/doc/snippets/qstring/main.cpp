@@ -295,6 +295,17 @@ void Widget::argFunction()
     str.arg("Hello", QString::number(20), QString::number(50)); // returns "Hello5020"
     //! [98]
 
+    {
+    //! [101]
+    int i;                // current file's number
+    int total;            // number of files to process
+    QStringView fileName; // current file's name
+
+    QString status = QString("Processing file %1 of %2: %3")
+                    .arg(i, total, fileName);
+    //! [101]
+    }
+
     //! [14]
     str = QString("Decimal 63 is %1 in hexadecimal")
             .arg(63, 0, 16);
@@ -25,11 +25,14 @@ HEADERS +=  \
         global/qrandom.h \
         global/qrandom_p.h \
         global/qhooks_p.h \
+        global/qtrace_p.h \
+        global/qtcore_tracepoints_p.h \
         global/qversiontagging.h
 
 SOURCES += \
         global/archdetect.cpp \
 	global/qglobal.cpp \
+        global/qendian.cpp \
         global/qlibraryinfo.cpp \
 	global/qmalloc.cpp \
         global/qnumeric.cpp \
@@ -85,6 +88,12 @@ qtConfig(slog2): \
 qtConfig(journald): \
     QMAKE_USE_PRIVATE += journald
 
+qtConfig(lttng)|qtConfig(etw): \
+    SOURCES += global/qtcore_tracepoints.cpp
+
+qtConfig(lttng): \
+    QMAKE_USE_PRIVATE += lttng-ust
+
 gcc:ltcg {
     versiontagging_compiler.commands = $$QMAKE_CXX -c $(CXXFLAGS) $(INCPATH)
 
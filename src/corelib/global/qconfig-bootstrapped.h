@@ -78,12 +78,14 @@
 #define QT_FEATURE_cxx11_random (QT_HAS_INCLUDE(<random>) ? 1 : -1)
 #define QT_NO_DATASTREAM
 #define QT_FEATURE_datetimeparser -1
+#define QT_FEATURE_etw -1
 #define QT_FEATURE_getauxval (QT_HAS_INCLUDE(<sys/auxv.h>) ? 1 : -1)
 #define QT_FEATURE_getentropy -1
 #define QT_NO_GEOM_VARIANT
 #define QT_FEATURE_iconv -1
 #define QT_FEATURE_icu -1
 #define QT_FEATURE_journald -1
+#define QT_FEATURE_lttng -1
 #define QT_FEATURE_futimens -1
 #define QT_FEATURE_futimes -1
 #define QT_FEATURE_library -1
@@ -94,6 +96,7 @@
 #endif
 #define QT_NO_QOBJECT
 #define QT_FEATURE_process -1
+#define QT_FEATURE_qlist_direct_storage -1
 #define QT_FEATURE_renameat2 -1
 #define QT_FEATURE_sharedmemory -1
 #define QT_FEATURE_slog2 -1
@@ -0,0 +1,130 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qendian.h"
+
+#include <private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+template <typename T>
+void *bswapLoop(const uchar *src, qsizetype n, uchar *dst) Q_DECL_NOTHROW
+{
+    for (qsizetype i = 0; i < n; ++i) {
+        qToUnaligned(qbswap(qFromUnaligned<T>(src)), dst);
+        src += sizeof(T);
+        dst += sizeof(T);
+    }
+    return dst;
+}
+
+#if defined(__SSE2__)
+// Reverses the bytes of each Size-byte item in a 16-byte block
+template <int Size> inline __m128i bswapBlock(__m128i v)
+{
+#  if defined(__SSSE3__)
+    const __m128i mask = Size == 2
+            ? _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+            : Size == 4
+            ? _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3)
+            : _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm_shuffle_epi8(v, mask);
+#  else
+    // swap the bytes in each 16-bit word, then reorder the words
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    if (Size == 4) {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if (Size == 8) {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+    return v;
+#  endif
+}
+#endif
+
+template <typename T>
+void *bswap(const void *source, qsizetype n, void *dest) Q_DECL_NOTHROW
+{
+    const uchar *src = static_cast<const uchar *>(source);
+    uchar *dst = static_cast<uchar *>(dest);
+#if defined(__SSE2__)
+    // each block is loaded before it is stored, so src == dst is fine
+    const qsizetype perBlock = 16 / qsizetype(sizeof(T));
+    for (; n >= 2 * perBlock; n -= 2 * perBlock) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), bswapBlock<sizeof(T)>(a));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 16), bswapBlock<sizeof(T)>(b));
+        src += 32;
+        dst += 32;
+    }
+    if (n >= perBlock) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), bswapBlock<sizeof(T)>(a));
+        src += 16;
+        dst += 16;
+        n -= perBlock;
+    }
+#endif
+    return bswapLoop<T>(src, n, dst);
+}
+
+} // unnamed namespace
+
+template <> void *qbswap<2>(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW
+{
+    return bswap<quint16>(source, count, dest);
+}
+
+template <> void *qbswap<4>(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW
+{
+    return bswap<quint32>(source, count, dest);
+}
+
+template <> void *qbswap<8>(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW
+{
+    return bswap<quint64>(source, count, dest);
+}
+
+QT_END_NAMESPACE
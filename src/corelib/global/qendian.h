@@ -157,6 +157,23 @@ template <typename T> inline void qbswap(const T src, void *dest)
     qToUnaligned<T>(qbswap<T>(src), dest);
 }
 
+/*
+ * void *qbswap<Size>(const void *source, qsizetype count, void *dest);
+ * Changes the byte order of \a count items of \a Size bytes each, reading
+ * them from \a source and storing them in \a dest, and returns a pointer
+ * past the last item written. \a source and \a dest may be the same buffer;
+ * otherwise they must not overlap. There are no alignment requirements.
+*/
+template <int Size> void *qbswap(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW;
+template <> inline void *qbswap<1>(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW
+{
+    return source != dest ? static_cast<char *>(memcpy(dest, source, size_t(count))) + count
+                          : static_cast<char *>(dest) + count;
+}
+template <> Q_CORE_EXPORT void *qbswap<2>(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW;
+template <> Q_CORE_EXPORT void *qbswap<4>(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW;
+template <> Q_CORE_EXPORT void *qbswap<8>(const void *source, qsizetype count, void *dest) Q_DECL_NOTHROW;
+
 
 #if Q_BYTE_ORDER == Q_BIG_ENDIAN
 
@@ -172,6 +189,15 @@ template <typename T> inline void qToBigEndian(T src, void *dest)
 { qToUnaligned<T>(src, dest); }
 template <typename T> inline void qToLittleEndian(T src, void *dest)
 { qbswap<T>(src, dest); }
+
+template <typename T> inline void qToBigEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<1>(source, count * qsizetype(sizeof(T)), dest); }
+template <typename T> inline void qFromBigEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<1>(source, count * qsizetype(sizeof(T)), dest); }
+template <typename T> inline void qToLittleEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<sizeof(T)>(source, count, dest); }
+template <typename T> inline void qFromLittleEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<sizeof(T)>(source, count, dest); }
 #else // Q_LITTLE_ENDIAN
 
 template <typename T> inline Q_DECL_CONSTEXPR T qToBigEndian(T source)
@@ -187,6 +213,15 @@ template <typename T> inline void qToBigEndian(T src, void *dest)
 template <typename T> inline void qToLittleEndian(T src, void *dest)
 { qToUnaligned<T>(src, dest); }
 
+template <typename T> inline void qToBigEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<sizeof(T)>(source, count, dest); }
+template <typename T> inline void qFromBigEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<sizeof(T)>(source, count, dest); }
+template <typename T> inline void qToLittleEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<1>(source, count * qsizetype(sizeof(T)), dest); }
+template <typename T> inline void qFromLittleEndian(const void *source, qsizetype count, void *dest)
+{ qbswap<1>(source, count * qsizetype(sizeof(T)), dest); }
+
 #endif // Q_BYTE_ORDER == Q_BIG_ENDIAN
 
 
@@ -53,6 +53,7 @@
 #include "qdatetime.h"
 #include "qcoreapplication.h"
 #include "qthread.h"
+#include "qwaitcondition.h"
 #include "private/qloggingregistry_p.h"
 #include "private/qcoreapplication_p.h"
 #include "private/qsimd_p.h"
@@ -1592,6 +1593,111 @@ static void android_default_message_handler(QtMsgType type,
 }
 #endif //Q_OS_ANDROID
 
+#if !defined(QT_BOOTSTRAPPED) && !defined(QT_NO_THREAD)
+#  define QLOGGING_HAVE_ASYNC_STDERR
+
+static bool qt_logging_async()
+{
+    static const bool async = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC") != 0;
+    return async;
+}
+
+namespace {
+/*
+    Writes messages to stderr from a background thread, so that threads
+    logging a lot do not block on the console. Messages are collected in a
+    single buffer, and the writer thread writes each batch at once.
+*/
+class QAsyncStderrWriter : public QThread
+{
+public:
+    QAsyncStderrWriter()
+    {
+        start();
+        started = isRunning();
+    }
+
+    ~QAsyncStderrWriter()
+    {
+        {
+            QMutexLocker locker(&mutex);
+            stopping = true;
+            bufferNotEmpty.wakeOne();
+        }
+        wait();
+    }
+
+    void write(const QByteArray &message)
+    {
+        if (!started) {
+            fprintf(stderr, "%s\n", message.constData());
+            fflush(stderr);
+            return;
+        }
+
+        QMutexLocker locker(&mutex);
+        // don't let a burst of messages use unbounded memory
+        while (pending.size() >= MaxPendingSize)
+            bufferNotFull.wait(&mutex);
+        // the writer only waits when there is nothing pending
+        if (pending.isEmpty())
+            bufferNotEmpty.wakeOne();
+        pending += message;
+        pending += '\n';
+    }
+
+    void flush()
+    {
+        if (!started)
+            return;
+        QMutexLocker locker(&mutex);
+        while (writing || !pending.isEmpty())
+            bufferWritten.wait(&mutex);
+    }
+
+protected:
+    void run() override
+    {
+        QByteArray batch;
+        QMutexLocker locker(&mutex);
+        forever {
+            while (pending.isEmpty() && !stopping)
+                bufferNotEmpty.wait(&mutex);
+            if (pending.isEmpty())
+                break;
+
+            batch.swap(pending);
+            writing = true;
+            bufferNotFull.wakeAll();
+            locker.unlock();
+
+            fwrite(batch.constData(), 1, size_t(batch.size()), stderr);
+            fflush(stderr);
+            batch.resize(0);
+
+            locker.relock();
+            writing = false;
+            bufferWritten.wakeAll();
+        }
+    }
+
+private:
+    enum { MaxPendingSize = 1024 * 1024 };
+
+    QMutex mutex;
+    QWaitCondition bufferNotEmpty;
+    QWaitCondition bufferNotFull;
+    QWaitCondition bufferWritten;
+    QByteArray pending;
+    bool started = false;
+    bool writing = false;
+    bool stopping = false;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QAsyncStderrWriter, asyncStderrWriter)
+#endif // !QT_BOOTSTRAPPED && !QT_NO_THREAD
+
 /*!
     \internal
 */
@@ -1625,6 +1731,14 @@ static void qDefaultMessageHandler(QtMsgType type, const QMessageLogContext &con
         return;
 #endif
     }
+#ifdef QLOGGING_HAVE_ASYNC_STDERR
+    if (qt_logging_async()) {
+        if (QAsyncStderrWriter *writer = asyncStderrWriter()) {
+            writer->write(logMessage.toLocal8Bit());
+            return;
+        }
+    }
+#endif
     fprintf(stderr, "%s\n", logMessage.toLocal8Bit().constData());
     fflush(stderr);
 }
@@ -1691,6 +1805,12 @@ static void qt_message_print(QtMsgType msgType, const QMessageLogContext &contex
 
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const QString &message)
 {
+#ifdef QLOGGING_HAVE_ASYNC_STDERR
+    // make sure the messages leading up to this one are not lost
+    if (asyncStderrWriter.exists())
+        asyncStderrWriter()->flush();
+#endif
+
 #if defined(Q_CC_MSVC) && defined(QT_DEBUG) && defined(_DEBUG) && defined(_CRT_ERROR)
     wchar_t contextFileL[256];
     // we probably should let the compiler do this for us, by declaring QMessageLogContext::file to
@@ -1803,6 +1923,14 @@ void qErrnoWarning(int code, const char *msg, ...)
     output under X11 or to the debugger under Windows. If it is a
     fatal message, the application aborts immediately.
 
+    Since Qt 5.11, if the \c QT_LOGGING_ASYNC environment variable is set
+    to a non-zero value, the default message handler writes messages for
+    the console to the standard error stream from a background thread.
+    Threads that log a lot then no longer wait for the console, and
+    messages are written in batches. Messages are still written in the
+    order they were logged; pending messages are written before a fatal
+    message aborts the application and when the application exits.
+
     Only one message handler can be defined, since this is usually
     done on an application-wide basis to control debug output.
 
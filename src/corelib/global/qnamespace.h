@@ -516,6 +516,7 @@ public:
         AA_DontShowShortcutsInContextMenus = 28,
         AA_CompressTabletEvents = 29,
         AA_DisableWindowContextHelpButton = 30, // ### Qt 6: remove me
+        AA_PaceWidgetUpdates = 31,
 
         // Add new attributes before this line
         AA_AttributeCount
@@ -1261,6 +1262,8 @@ public:
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
+        BatchedConnection,
+        CoalescedConnection,
         UniqueConnection =  0x80
     };
 
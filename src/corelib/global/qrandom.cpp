@@ -45,6 +45,7 @@
 #include <qobjectdefs.h>
 #include <qmutex.h>
 #include <qthreadstorage.h>
+#include <qalgorithms.h>
 
 #include <errno.h>
 
@@ -1285,6 +1286,478 @@ void QRandomGenerator::_fillRange(void *buffer, void *bufferEnd)
     std::generate(begin, end, [this]() { return storage.engine()(); });
 }
 
+template <typename Generator>
+static quint32 boundedRetry(Generator *rng, quint32 highest, quint32 threshold)
+{
+    quint64 m;
+    do {
+        m = quint64(rng->generate()) * highest;
+    } while (quint32(m) < threshold);
+    return quint32(m >> 32);
+}
+
+// Lemire's nearly divisionless method: the high half of value * highest is
+// uniform in [0, highest) once the values whose low half falls below
+// 2^32 % highest are rejected.
+template <typename Generator>
+static void fillBoundedHelper(Generator *rng, quint32 *buffer, qsizetype count, quint32 highest)
+{
+    if (Q_UNLIKELY(highest == 0)) {
+        std::fill_n(buffer, count, 0U);
+        return;
+    }
+
+    rng->fillRange(buffer, count);
+
+    const quint32 threshold = (0U - highest) % highest;
+    qsizetype i = 0;
+#ifdef __SSE2__
+    const __m128i factor = _mm_set1_epi32(int(highest));
+    const __m128i lowMask = _mm_set_epi32(0, -1, 0, -1);
+    const __m128i signFlip = _mm_set1_epi32(int(0x80000000U));
+    const __m128i limit = _mm_xor_si128(_mm_set1_epi32(int(threshold)), signFlip);
+    for ( ; i + 4 <= count; i += 4) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buffer + i));
+        const __m128i even = _mm_mul_epu32(x, factor);
+        const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), factor);
+        const __m128i high = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(lowMask, odd));
+        const __m128i low = _mm_or_si128(_mm_and_si128(even, lowMask), _mm_slli_epi64(odd, 32));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + i), high);
+
+        // unsigned low < threshold
+        const __m128i rejected = _mm_cmplt_epi32(_mm_xor_si128(low, signFlip), limit);
+        uint mask = _mm_movemask_ps(_mm_castsi128_ps(rejected));
+        while (Q_UNLIKELY(mask)) {
+            buffer[i + qCountTrailingZeroBits(mask)] = boundedRetry(rng, highest, threshold);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for ( ; i < count; ++i) {
+        const quint64 m = quint64(buffer[i]) * highest;
+        if (Q_LIKELY(quint32(m) >= threshold))
+            buffer[i] = quint32(m >> 32);
+        else
+            buffer[i] = boundedRetry(rng, highest, threshold);
+    }
+}
+
+/*!
+    Fills the \a count entries of \a buffer with random 32-bit quantities in
+    the range between 0 (inclusive) and \a highest (exclusive). If \a highest
+    is 0, the buffer is filled with zeroes.
+
+    This function produces the values in bulk, which is considerably faster
+    than calling bounded() for each entry. Unlike bounded(), which scales each
+    value without correction, the result is exactly uniform: values that
+    would introduce bias are rejected and replaced with new ones (Lemire's
+    multiply-and-shift method), so the number of values consumed from the
+    generator may exceed \a count.
+
+    \since 5.11
+    \sa bounded(), fillRange()
+ */
+void QRandomGenerator::fillBounded(quint32 *buffer, qsizetype count, quint32 highest)
+{
+    fillBoundedHelper(this, buffer, count, highest);
+}
+
+/*!
+    \class QFastRandomGenerator
+    \inmodule QtCore
+    \reentrant
+    \since 5.11
+
+    \brief The QFastRandomGenerator class is a fast, non-cryptographic
+    pseudo-random number generator meant for bulk generation.
+
+    QFastRandomGenerator is meant for applications that consume large
+    amounts of random numbers and need them to be cheap, such as Monte Carlo
+    simulations. It provides the same generation API as QRandomGenerator, but
+    instead of a Mersenne Twister it runs four interleaved
+    \l{http://xoshiro.di.unimi.it}{xoshiro128**} streams, which can be
+    advanced together with SIMD instructions. The fillRange() and
+    fillBounded() functions take advantage of that.
+
+    The sequence of numbers produced for a given seed is deterministic and
+    the same on every platform, but it differs from that of QRandomGenerator.
+    The four streams are seeded from the 64-bit seed value with SplitMix64,
+    and the output interleaves them: the first value comes from the first
+    stream, the second from the second, and so on.
+
+    QFastRandomGenerator must not be used for cryptographic purposes, and it
+    is not thread-safe: each thread should use its own instance, for example
+    one obtained with securelySeeded().
+
+    \sa QRandomGenerator
+ */
+
+/*!
+    \fn QFastRandomGenerator::QFastRandomGenerator(quint64 seedValue)
+
+    Initializes this QFastRandomGenerator object with the value \a seedValue
+    as the seed. Two objects constructed or reseeded with the same seed value
+    will produce the same number sequence.
+
+    \sa seed(), securelySeeded()
+ */
+
+/*!
+    \fn bool operator==(const QFastRandomGenerator &rng1, const QFastRandomGenerator &rng2)
+    \relates QFastRandomGenerator
+
+    Returns true if the two generators \a rng1 and \a rng2 are in the same
+    state, that is, if they will produce the same number sequence.
+ */
+
+/*!
+    \fn bool operator!=(const QFastRandomGenerator &rng1, const QFastRandomGenerator &rng2)
+    \relates QFastRandomGenerator
+
+    Returns true if the two generators \a rng1 and \a rng2 are in different
+    states.
+ */
+
+/*!
+    \typedef QFastRandomGenerator::result_type
+
+    A typedef to the type that operator() returns, that is, quint32.
+ */
+
+/*!
+    \fn result_type QFastRandomGenerator::operator()()
+
+    Generates a 32-bit random quantity and returns it.
+
+    \sa generate()
+ */
+
+/*!
+    \fn quint32 QFastRandomGenerator::generate()
+
+    Generates a 32-bit random quantity and returns it.
+
+    \sa QRandomGenerator::generate()
+ */
+
+/*!
+    \fn quint64 QFastRandomGenerator::generate64()
+
+    Generates a 64-bit random quantity and returns it, consuming two 32-bit
+    values from the sequence.
+
+    \sa QRandomGenerator::generate64()
+ */
+
+/*!
+    \fn double QFastRandomGenerator::generateDouble()
+
+    Generates one random double in the canonical range [0, 1).
+
+    \sa QRandomGenerator::generateDouble()
+ */
+
+/*!
+    \fn double QFastRandomGenerator::bounded(double highest)
+
+    Generates one random double in the range between 0 (inclusive) and \a
+    highest (exclusive).
+
+    \sa QRandomGenerator::bounded()
+ */
+
+/*!
+    \fn quint32 QFastRandomGenerator::bounded(quint32 highest)
+
+    \overload
+
+    Generates one random 32-bit quantity in the range between 0 (inclusive) and
+    \a highest (exclusive).
+
+    \sa fillBounded()
+ */
+
+/*!
+    \fn int QFastRandomGenerator::bounded(int highest)
+
+    \overload
+
+    Generates one random 32-bit quantity in the range between 0 (inclusive) and
+    \a highest (exclusive). \a highest must not be negative.
+
+    \sa fillBounded()
+ */
+
+/*!
+    \fn quint32 QFastRandomGenerator::bounded(quint32 lowest, quint32 highest)
+
+    \overload
+
+    Generates one random 32-bit quantity in the range between \a lowest
+    (inclusive) and \a highest (exclusive).
+
+    \sa fillBounded()
+ */
+
+/*!
+    \fn int QFastRandomGenerator::bounded(int lowest, int highest)
+
+    \overload
+
+    Generates one random 32-bit quantity in the range between \a lowest
+    (inclusive) and \a highest (exclusive).
+
+    \sa fillBounded()
+ */
+
+/*!
+    \fn void QFastRandomGenerator::fillRange(UInt *buffer, qsizetype count)
+
+    Generates \a count 32- or 64-bit quantities (depending on the type \c UInt)
+    and stores them in the buffer pointed by \a buffer. Whole blocks of
+    values are written directly into \a buffer, which makes this the
+    most efficient way to obtain many values.
+
+    \sa generate(), fillBounded()
+ */
+
+/*!
+    \fn void QFastRandomGenerator::fillRange(UInt (&buffer)[N])
+
+    \overload
+
+    Generates \c N 32- or 64-bit quantities (depending on the type \c UInt) and
+    stores them in the \a buffer array.
+
+    \sa generate(), fillBounded()
+ */
+
+/*!
+    \fn void QFastRandomGenerator::fillBounded(quint32 (&buffer)[N], quint32 highest)
+
+    \overload
+
+    Fills the \c N entries of the \a buffer array with random 32-bit quantities
+    in the range between 0 (inclusive) and \a highest (exclusive).
+
+    \sa bounded()
+ */
+
+/*!
+    \fn result_type QFastRandomGenerator::min()
+
+    Returns the minimum value that QFastRandomGenerator may ever generate,
+    that is, 0.
+
+    \sa max()
+ */
+
+/*!
+    \fn result_type QFastRandomGenerator::max()
+
+    Returns the maximum value that QFastRandomGenerator may ever generate,
+    that is, \c {std::numeric_limits<result_type>::max()}.
+
+    \sa min()
+ */
+
+/*!
+    \fn void QRandomGenerator::fillBounded(quint32 (&buffer)[N], quint32 highest)
+    \overload
+    \since 5.11
+
+    Fills the \c N entries of the \a buffer array with random 32-bit quantities
+    in the range between 0 (inclusive) and \a highest (exclusive).
+ */
+
+static inline quint32 xoshiroRotl(quint32 x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline quint64 splitMix64(quint64 &x)
+{
+    quint64 z = (x += Q_UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * Q_UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * Q_UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+#ifdef __SSE2__
+template <int K> static inline __m128i xoshiroRotl(__m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi32(x, K), _mm_srli_epi32(x, 32 - K));
+}
+#endif
+
+// Advances the four xoshiro128** streams in \a s by \a steps steps, storing
+// one output per stream and step in \a out.
+static void xoshiroFill(quint32 (&s)[4][4], quint32 *out, qsizetype steps)
+{
+#ifdef __SSE2__
+    __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s[0]));
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s[1]));
+    __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s[2]));
+    __m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s[3]));
+    for ( ; steps; --steps, out += 4) {
+        // rotl(s1 * 5, 7) * 9, with the multiplications as shift and add
+        __m128i x = _mm_add_epi32(_mm_slli_epi32(s1, 2), s1);
+        x = xoshiroRotl<7>(x);
+        x = _mm_add_epi32(_mm_slli_epi32(x, 3), x);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), x);
+
+        const __m128i t = _mm_slli_epi32(s1, 9);
+        s2 = _mm_xor_si128(s2, s0);
+        s3 = _mm_xor_si128(s3, s1);
+        s1 = _mm_xor_si128(s1, s2);
+        s0 = _mm_xor_si128(s0, s3);
+        s2 = _mm_xor_si128(s2, t);
+        s3 = xoshiroRotl<11>(s3);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(s[0]), s0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(s[1]), s1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(s[2]), s2);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(s[3]), s3);
+#else
+    for ( ; steps; --steps, out += 4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            out[lane] = xoshiroRotl(s[1][lane] * 5, 7) * 9;
+
+            const quint32 t = s[1][lane] << 9;
+            s[2][lane] ^= s[0][lane];
+            s[3][lane] ^= s[1][lane];
+            s[1][lane] ^= s[2][lane];
+            s[0][lane] ^= s[3][lane];
+            s[2][lane] ^= t;
+            s[3][lane] = xoshiroRotl(s[3][lane], 11);
+        }
+    }
+#endif
+}
+
+// xoshiro128** must not be seeded with an all-zero state
+static void xoshiroFixZeroState(quint32 (&s)[4][4])
+{
+    for (int lane = 0; lane < 4; ++lane) {
+        if ((s[0][lane] | s[1][lane] | s[2][lane] | s[3][lane]) == 0)
+            s[0][lane] = 1;
+    }
+}
+
+/*!
+    Reseeds this object using the value \a seedValue as the seed.
+
+    \sa QFastRandomGenerator()
+ */
+void QFastRandomGenerator::seed(quint64 seedValue)
+{
+    for (int lane = 0; lane < Lanes; ++lane) {
+        for (int word = 0; word < Words; word += 2) {
+            const quint64 value = splitMix64(seedValue);
+            state[word][lane] = quint32(value);
+            state[word + 1][lane] = quint32(value >> 32);
+        }
+    }
+    xoshiroFixZeroState(state);
+    index = BlockSize;
+}
+
+/*!
+    Returns a new QFastRandomGenerator object whose whole state was filled
+    with data from QRandomGenerator::system(). Use this function to obtain
+    independently seeded generators, for example one per thread.
+ */
+QFastRandomGenerator QFastRandomGenerator::securelySeeded()
+{
+    QFastRandomGenerator result;
+    QRandomGenerator::system()->fillRange(&result.state[0][0], Words * Lanes);
+    xoshiroFixZeroState(result.state);
+    return result;
+}
+
+/*!
+    Discards the next \a z entries from the sequence. This method is
+    equivalent to calling generate() \a z times and discarding the result.
+ */
+void QFastRandomGenerator::discard(unsigned long long z)
+{
+    for ( ; z && index != BlockSize; --z)
+        ++index;
+
+    quint32 scratch[4 * BlockSize];
+    while (z >= BlockSize) {
+        const unsigned long long blocks = qMin<unsigned long long>(z / BlockSize, 4);
+        xoshiroFill(state, scratch, qsizetype(blocks * (BlockSize / Lanes)));
+        z -= blocks * BlockSize;
+    }
+
+    for ( ; z; --z)
+        generate();
+}
+
+bool operator==(const QFastRandomGenerator &rng1, const QFastRandomGenerator &rng2)
+{
+    using Gen = QFastRandomGenerator;
+    return rng1.index == rng2.index
+            && std::equal(rng1.block + rng1.index, rng1.block + Gen::BlockSize, rng2.block + rng2.index)
+            && std::equal(&rng1.state[0][0], &rng1.state[0][0] + Gen::Words * Gen::Lanes,
+                          &rng2.state[0][0]);
+}
+
+/*!
+    \internal
+
+    Produces the next block of values for generate().
+ */
+void QFastRandomGenerator::refill()
+{
+    xoshiroFill(state, block, BlockSize / Lanes);
+    index = 0;
+}
+
+/*!
+    \internal
+
+    Fills the range pointed by \a buffer and \a bufferEnd with 32-bit random
+    values. The buffer must be correctly aligned.
+ */
+void QFastRandomGenerator::_fillRange(void *buffer, void *bufferEnd)
+{
+    Q_ASSERT(quintptr(buffer) % sizeof(quint32) == 0);
+    Q_ASSERT(quintptr(bufferEnd) % sizeof(quint32) == 0);
+    quint32 *begin = static_cast<quint32 *>(buffer);
+    quint32 *end = static_cast<quint32 *>(bufferEnd);
+
+    // drain what generate() has buffered, to keep the sequence intact, then
+    // write whole blocks directly; this leaves the object in the same state
+    // as calling generate() repeatedly would
+    while (begin != end && index != BlockSize)
+        *begin++ = block[index++];
+
+    const qsizetype blocks = (end - begin) / BlockSize;
+    xoshiroFill(state, begin, blocks * (BlockSize / Lanes));
+    begin += blocks * BlockSize;
+
+    while (begin != end)
+        *begin++ = generate();
+}
+
+/*!
+    Fills the \a count entries of \a buffer with random 32-bit quantities in
+    the range between 0 (inclusive) and \a highest (exclusive). If \a highest
+    is 0, the buffer is filled with zeroes.
+
+    The values are exactly uniform: like QRandomGenerator::fillBounded(),
+    this function uses Lemire's multiply-and-shift method with rejection, so
+    the number of values consumed from the generator may exceed \a count.
+
+    \sa bounded(), fillRange()
+ */
+void QFastRandomGenerator::fillBounded(quint32 *buffer, qsizetype count, quint32 highest)
+{
+    fillBoundedHelper(this, buffer, count, highest);
+}
+
 #if defined(Q_OS_ANDROID) && !defined(Q_OS_ANDROID_EMBEDDED) && (__ANDROID_API__ < 21)
 typedef QThreadStorage<QJNIObjectPrivate> AndroidRandomStorage;
 Q_GLOBAL_STATIC(AndroidRandomStorage, randomTLS)
@@ -149,6 +149,14 @@ public:
         _fillRange(buffer, buffer + N);
     }
 
+    Q_CORE_EXPORT void fillBounded(quint32 *buffer, qsizetype count, quint32 highest);
+
+    template <size_t N>
+    void fillBounded(quint32 (&buffer)[N], quint32 highest)
+    {
+        fillBounded(buffer, qsizetype(N), highest);
+    }
+
     // API like std::seed_seq
     template <typename ForwardIterator>
     void generate(ForwardIterator begin, ForwardIterator end)
@@ -251,6 +259,113 @@ public:
 #endif // Q_QDOC
 };
 
+class QFastRandomGenerator
+{
+    template <typename UInt> using IfValidUInt =
+        typename std::enable_if<std::is_unsigned<UInt>::value && sizeof(UInt) >= sizeof(uint), bool>::type;
+public:
+    QFastRandomGenerator(quint64 seedValue = 1)
+    {
+        seed(seedValue);
+    }
+
+    friend Q_CORE_EXPORT bool operator==(const QFastRandomGenerator &rng1, const QFastRandomGenerator &rng2);
+    friend bool operator!=(const QFastRandomGenerator &rng1, const QFastRandomGenerator &rng2)
+    {
+        return !(rng1 == rng2);
+    }
+
+    quint32 generate()
+    {
+        if (Q_UNLIKELY(index == BlockSize))
+            refill();
+        return block[index++];
+    }
+
+    quint64 generate64()
+    {
+        const quint64 low = generate();
+        return low | (quint64(generate()) << 32);
+    }
+
+    double generateDouble()
+    {
+        quint64 x = generate64();
+        quint64 limit = Q_UINT64_C(1) << std::numeric_limits<double>::digits;
+        x >>= std::numeric_limits<quint64>::digits - std::numeric_limits<double>::digits;
+        return double(x) / double(limit);
+    }
+
+    double bounded(double highest)
+    {
+        return generateDouble() * highest;
+    }
+
+    quint32 bounded(quint32 highest)
+    {
+        quint64 value = generate();
+        value *= highest;
+        value /= (max)() + quint64(1);
+        return quint32(value);
+    }
+
+    int bounded(int highest)
+    {
+        return int(bounded(quint32(highest)));
+    }
+
+    quint32 bounded(quint32 lowest, quint32 highest)
+    {
+        return bounded(highest - lowest) + lowest;
+    }
+
+    int bounded(int lowest, int highest)
+    {
+        return bounded(highest - lowest) + lowest;
+    }
+
+    template <typename UInt, IfValidUInt<UInt> = true>
+    void fillRange(UInt *buffer, qsizetype count)
+    {
+        _fillRange(buffer, buffer + count);
+    }
+
+    template <typename UInt, size_t N, IfValidUInt<UInt> = true>
+    void fillRange(UInt (&buffer)[N])
+    {
+        _fillRange(buffer, buffer + N);
+    }
+
+    Q_CORE_EXPORT void fillBounded(quint32 *buffer, qsizetype count, quint32 highest);
+
+    template <size_t N>
+    void fillBounded(quint32 (&buffer)[N], quint32 highest)
+    {
+        fillBounded(buffer, qsizetype(N), highest);
+    }
+
+    // API like std:: random engines
+    typedef quint32 result_type;
+    result_type operator()() { return generate(); }
+    Q_CORE_EXPORT void seed(quint64 s = 1);
+    Q_CORE_EXPORT void discard(unsigned long long z);
+    static Q_DECL_CONSTEXPR result_type min() { return std::numeric_limits<result_type>::min(); }
+    static Q_DECL_CONSTEXPR result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    static Q_CORE_EXPORT QFastRandomGenerator securelySeeded();
+
+private:
+    Q_CORE_EXPORT void refill();
+    Q_CORE_EXPORT void _fillRange(void *buffer, void *bufferEnd);
+
+    // four interleaved xoshiro128** streams, stored word-major so that
+    // each state word of all streams can be loaded into one SIMD register
+    enum { Lanes = 4, Words = 4, BlockSize = 4 * Lanes };
+    quint32 state[Words][Lanes];
+    quint32 block[BlockSize];
+    int index;
+};
+
 inline QRandomGenerator *QRandomGenerator::system()
 {
     return QRandomGenerator64::system();
@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/private/qtrace_p.h>
+
+#if QT_CONFIG(lttng)
+// Emits the probe callbacks and the tracepoint definitions for the
+// qtcore provider; this must happen in exactly one translation unit.
+#  define TRACEPOINT_CREATE_PROBES
+#  define TRACEPOINT_DEFINE
+#endif
+
+#include <QtCore/private/qtcore_tracepoints_p.h>
+
+#if QT_CONFIG(etw)
+// {8548fd92-3c9a-5247-a03d-263a367fdfa4}
+TRACELOGGING_DEFINE_PROVIDER(qtcore_provider, "QtCore",
+    (0x8548fd92, 0x3c9a, 0x5247, 0xa0, 0x3d, 0x26, 0x3a, 0x36, 0x7f, 0xdf, 0xa4));
+
+static void qtcore_register_provider()
+{
+    TraceLoggingRegister(qtcore_provider);
+}
+Q_CONSTRUCTOR_FUNCTION(qtcore_register_provider)
+
+static void qtcore_unregister_provider()
+{
+    TraceLoggingUnregister(qtcore_provider);
+}
+Q_DESTRUCTOR_FUNCTION(qtcore_unregister_provider)
+#endif
@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+// No include guard around the LTTNG part: lttng-ust reads this header
+// several times while generating the probes (TRACEPOINT_HEADER_MULTI_READ).
+
+#include <QtCore/private/qtrace_p.h>
+
+#if defined(Q_TRACING) && QT_CONFIG(lttng)
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER qtcore
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE <QtCore/private/qtcore_tracepoints_p.h>
+
+#if !defined(QTCORE_LTTNG_TRACEPOINTS_H) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define QTCORE_LTTNG_TRACEPOINTS_H
+
+#include <lttng/tracepoint.h>
+#include <stdint.h>
+
+#define Q_LTTNG_POINTER(name) ctf_integer_hex(uintptr_t, name, reinterpret_cast<uintptr_t>(name))
+
+TRACEPOINT_EVENT(qtcore, QCoreApplication_notify_entry,
+    TP_ARGS(const void *, receiver, const void *, event, int, type),
+    TP_FIELDS(Q_LTTNG_POINTER(receiver) Q_LTTNG_POINTER(event) ctf_integer(int, type, type)))
+TRACEPOINT_EVENT(qtcore, QCoreApplication_notify_exit,
+    TP_ARGS(int, consumed),
+    TP_FIELDS(ctf_integer(int, consumed, consumed)))
+TRACEPOINT_EVENT(qtcore, QCoreApplication_postEvent_entry,
+    TP_ARGS(const void *, receiver, const void *, event, int, type),
+    TP_FIELDS(Q_LTTNG_POINTER(receiver) Q_LTTNG_POINTER(event) ctf_integer(int, type, type)))
+TRACEPOINT_EVENT(qtcore, QCoreApplication_postEvent_event_compressed,
+    TP_ARGS(const void *, receiver, const void *, event),
+    TP_FIELDS(Q_LTTNG_POINTER(receiver) Q_LTTNG_POINTER(event)))
+TRACEPOINT_EVENT(qtcore, QCoreApplication_postEvent_event_posted,
+    TP_ARGS(const void *, receiver, const void *, event, int, type, int, pending),
+    TP_FIELDS(Q_LTTNG_POINTER(receiver) Q_LTTNG_POINTER(event) ctf_integer(int, type, type)
+              ctf_integer(int, pending, pending)))
+
+TRACEPOINT_EVENT(qtcore, QEventDispatcherUNIX_processEvents_entry,
+    TP_ARGS(int, flags),
+    TP_FIELDS(ctf_integer_hex(int, flags, flags)))
+TRACEPOINT_EVENT(qtcore, QEventDispatcherUNIX_processEvents_exit,
+    TP_ARGS(int, events),
+    TP_FIELDS(ctf_integer(int, events, events)))
+TRACEPOINT_EVENT(qtcore, QEventDispatcherUNIX_poll_entry,
+    TP_ARGS(int, fds, int, timeout),
+    TP_FIELDS(ctf_integer(int, fds, fds) ctf_integer(int, timeout, timeout)))
+TRACEPOINT_EVENT(qtcore, QEventDispatcherUNIX_poll_exit,
+    TP_ARGS(int, result),
+    TP_FIELDS(ctf_integer(int, result, result)))
+
+TRACEPOINT_EVENT(qtcore, QThreadPool_enqueueTask,
+    TP_ARGS(const void *, runnable, int, priority),
+    TP_FIELDS(Q_LTTNG_POINTER(runnable) ctf_integer(int, priority, priority)))
+TRACEPOINT_EVENT(qtcore, QThreadPool_runTask_entry,
+    TP_ARGS(const void *, runnable),
+    TP_FIELDS(Q_LTTNG_POINTER(runnable)))
+TRACEPOINT_EVENT(qtcore, QThreadPool_runTask_exit,
+    TP_ARGS(const void *, runnable),
+    TP_FIELDS(Q_LTTNG_POINTER(runnable)))
+
+TRACEPOINT_EVENT(qtcore, QMetaObject_activate_entry,
+    TP_ARGS(const void *, sender, int, signalIndex),
+    TP_FIELDS(Q_LTTNG_POINTER(sender) ctf_integer(int, signalIndex, signalIndex)))
+TRACEPOINT_EVENT(qtcore, QMetaObject_activate_exit,
+    TP_ARGS(const void *, sender, int, signalIndex),
+    TP_FIELDS(Q_LTTNG_POINTER(sender) ctf_integer(int, signalIndex, signalIndex)))
+
+#endif // QTCORE_LTTNG_TRACEPOINTS_H
+
+#include <lttng/tracepoint-event.h>
+
+#endif // Q_TRACING && QT_CONFIG(lttng)
+
+#ifndef QTCORE_TRACEPOINTS_P_H
+#define QTCORE_TRACEPOINTS_P_H
+
+#if defined(Q_TRACING) && QT_CONFIG(etw)
+#include <qt_windows.h>
+#include <TraceLoggingProvider.h>
+
+TRACELOGGING_DECLARE_PROVIDER(qtcore_provider);
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QObject;
+class QEvent;
+class QRunnable;
+
+namespace QtPrivate {
+
+Q_TRACEPOINT(qtcore, QCoreApplication_notify_entry,
+    (QObject *receiver, QEvent *event, int type), (receiver, event, type),
+    (TraceLoggingPointer(receiver), TraceLoggingPointer(event), TraceLoggingInt32(type)))
+Q_TRACEPOINT(qtcore, QCoreApplication_notify_exit,
+    (bool consumed), (consumed),
+    (TraceLoggingBool(consumed)))
+Q_TRACEPOINT(qtcore, QCoreApplication_postEvent_entry,
+    (QObject *receiver, QEvent *event, int type), (receiver, event, type),
+    (TraceLoggingPointer(receiver), TraceLoggingPointer(event), TraceLoggingInt32(type)))
+Q_TRACEPOINT(qtcore, QCoreApplication_postEvent_event_compressed,
+    (QObject *receiver, QEvent *event), (receiver, event),
+    (TraceLoggingPointer(receiver), TraceLoggingPointer(event)))
+Q_TRACEPOINT(qtcore, QCoreApplication_postEvent_event_posted,
+    (QObject *receiver, QEvent *event, int type, int pending), (receiver, event, type, pending),
+    (TraceLoggingPointer(receiver), TraceLoggingPointer(event), TraceLoggingInt32(type),
+     TraceLoggingInt32(pending)))
+
+Q_TRACEPOINT(qtcore, QEventDispatcherUNIX_processEvents_entry,
+    (int flags), (flags),
+    (TraceLoggingHexInt32(flags)))
+Q_TRACEPOINT(qtcore, QEventDispatcherUNIX_processEvents_exit,
+    (int events), (events),
+    (TraceLoggingInt32(events)))
+Q_TRACEPOINT(qtcore, QEventDispatcherUNIX_poll_entry,
+    (int fds, int timeout), (fds, timeout),
+    (TraceLoggingInt32(fds), TraceLoggingInt32(timeout)))
+Q_TRACEPOINT(qtcore, QEventDispatcherUNIX_poll_exit,
+    (int result), (result),
+    (TraceLoggingInt32(result)))
+
+Q_TRACEPOINT(qtcore, QThreadPool_enqueueTask,
+    (QRunnable *runnable, int priority), (runnable, priority),
+    (TraceLoggingPointer(runnable), TraceLoggingInt32(priority)))
+Q_TRACEPOINT(qtcore, QThreadPool_runTask_entry,
+    (QRunnable *runnable), (runnable),
+    (TraceLoggingPointer(runnable)))
+Q_TRACEPOINT(qtcore, QThreadPool_runTask_exit,
+    (QRunnable *runnable), (runnable),
+    (TraceLoggingPointer(runnable)))
+
+Q_TRACEPOINT(qtcore, QMetaObject_activate_entry,
+    (QObject *sender, int signalIndex), (sender, signalIndex),
+    (TraceLoggingPointer(sender), TraceLoggingInt32(signalIndex)))
+Q_TRACEPOINT(qtcore, QMetaObject_activate_exit,
+    (QObject *sender, int signalIndex), (sender, signalIndex),
+    (TraceLoggingPointer(sender), TraceLoggingInt32(signalIndex)))
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QTCORE_TRACEPOINTS_P_H
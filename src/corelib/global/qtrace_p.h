@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTRACE_P_H
+#define QTRACE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+/*
+ * The Qt tracepoints API consists of only two macros:
+ *
+ *     - Q_TRACE(tracepoint, args...)
+ *       Fires 'tracepoint' if it is enabled.
+ *
+ *     - Q_TRACE_ENABLED(tracepoint)
+ *       Returns 'true' if 'tracepoint' is enabled; false otherwise.
+ *       Use it to guard the computation of arguments that are only
+ *       needed by the tracepoint, such as strings.
+ *
+ * Tracepoints are declared per module in a <module>_tracepoints_p.h
+ * header (see qtcore_tracepoints_p.h), which must be included before
+ * using the macros above. The header lists each tracepoint twice: once
+ * as an LTTNG event description and once with Q_TRACEPOINT(), which
+ * provides the QtPrivate::trace_<name>() function the macros call into.
+ *
+ * Unless Qt was configured with -trace, the macros expand to nothing and
+ * the arguments are not evaluated, so tracepoints can be put into hot
+ * code paths without any cost for regular builds.
+ */
+
+#include <QtCore/private/qglobal_p.h>
+
+#if (QT_CONFIG(lttng) || QT_CONFIG(etw)) && !defined(QT_BOOTSTRAPPED)
+#  define Q_TRACING
+#  define Q_TRACE(x, ...) QtPrivate::trace_ ## x(__VA_ARGS__)
+#  define Q_TRACE_ENABLED(x) QtPrivate::trace_ ## x ## _enabled()
+#else
+#  define Q_TRACE(x, ...)
+#  define Q_TRACE_ENABLED(x) false
+#endif
+
+#define Q_TRACE_UNPAREN(...) __VA_ARGS__
+
+/*
+ * Q_TRACEPOINT(provider, name, (parameters), (arguments), (etw fields))
+ *
+ * Defines the QtPrivate::trace_<name>() wrapper for a tracepoint. The
+ * arguments are forwarded to the LTTNG event of the same name, the ETW
+ * fields are the TraceLogging field macros describing the event.
+ */
+#if defined(Q_TRACING) && QT_CONFIG(lttng)
+#  define Q_TRACEPOINT(provider, name, params, args, fields) \
+    inline void trace_ ## name params \
+    { tracepoint(provider, name, Q_TRACE_UNPAREN args); } \
+    inline bool trace_ ## name ## _enabled() \
+    { return tracepoint_enabled(provider, name); }
+#elif defined(Q_TRACING) && QT_CONFIG(etw)
+#  define Q_TRACEPOINT(provider, name, params, args, fields) \
+    inline void trace_ ## name params \
+    { TraceLoggingWrite(provider ## _provider, #name, Q_TRACE_UNPAREN fields); } \
+    inline bool trace_ ## name ## _enabled() \
+    { return TraceLoggingProviderEnabled(provider ## _provider, 0, 0); }
+#else
+#  define Q_TRACEPOINT(provider, name, params, args, fields)
+#endif
+
+#endif // QTRACE_P_H
@@ -2,7 +2,9 @@
 
 HEADERS +=  \
         io/qabstractfileengine_p.h \
+        io/qasyncfile.h \
         io/qbuffer.h \
+        io/qcborstream.h \
         io/qdatastream.h \
         io/qdatastream_p.h \
         io/qdataurl_p.h \
@@ -42,6 +44,7 @@ HEADERS +=  \
         io/qsettings_p.h \
         io/qfsfileengine_p.h \
         io/qfsfileengine_iterator_p.h \
+        io/qfilesystemmetadatacache_p.h \
         io/qfilesystemwatcher.h \
         io/qfilesystemwatcher_p.h \
         io/qfilesystemwatcher_polling_p.h \
@@ -56,7 +59,9 @@ HEADERS +=  \
 
 SOURCES += \
         io/qabstractfileengine.cpp \
+        io/qasyncfile.cpp \
         io/qbuffer.cpp \
+        io/qcborstream.cpp \
         io/qdatastream.cpp \
         io/qdataurl.cpp \
         io/qtldurl.cpp \
@@ -85,6 +90,7 @@ SOURCES += \
         io/qsettings.cpp \
         io/qfsfileengine.cpp \
         io/qfsfileengine_iterator.cpp \
+        io/qfilesystemmetadatacache.cpp \
         io/qfilesystemwatcher.cpp \
         io/qfilesystemwatcher_polling.cpp \
         io/qfilesystementry.cpp \
@@ -0,0 +1,459 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qasyncfile.h"
+
+#ifndef QT_NO_QFUTURE
+
+#include "qplatformdefs.h"
+#include "qfile.h"
+#include "qreadwritelock.h"
+#include "qrunnable.h"
+#include "qthread.h"
+#include "qthreadpool.h"
+
+#ifdef Q_OS_UNIX
+#  include <private/qcore_unix_p.h>
+#  if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+#    define QT_PREAD ::pread64
+#    define QT_PWRITE ::pwrite64
+#  else
+#    define QT_PREAD ::pread
+#    define QT_PWRITE ::pwrite
+#  endif
+#endif
+
+#include <limits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// Threads in this pool spend their time waiting for the disk, so they get
+// a pool of their own instead of taking slots of the global one, which
+// is sized for CPU-bound work.
+class FileIoThreadPool : public QThreadPool
+{
+public:
+    FileIoThreadPool() { setMaxThreadCount(qMax(4, QThread::idealThreadCount())); }
+};
+
+template <typename T, typename Function>
+class FileTask : public QFutureInterface<T>, public QRunnable
+{
+public:
+    explicit FileTask(Function &&f) : function(std::move(f)) {}
+
+    QFuture<T> start(QThreadPool *pool)
+    {
+        this->setThreadPool(pool);
+        this->setRunnable(this);
+        this->reportStarted();
+        QFuture<T> theFuture = this->future();
+        pool->start(this);
+        return theFuture;
+    }
+
+    void run() override
+    {
+        if (this->isCanceled()) {
+            this->reportFinished();
+            return;
+        }
+        const T result = function();
+        this->reportResult(result);
+        this->reportFinished();
+    }
+
+private:
+    Function function;
+};
+
+template <typename T, typename Function>
+QFuture<T> startFileTask(QThreadPool *pool, Function f)
+{
+    return (new FileTask<T, Function>(std::move(f)))->start(pool);
+}
+
+// QByteArray cannot hold more than this
+const qint64 MaxByteArraySize = std::numeric_limits<int>::max() - qint64(sizeof(QByteArray::DataPtr) * 4);
+}
+
+Q_GLOBAL_STATIC(FileIoThreadPool, fileIoThreadPool)
+
+class QAsyncFilePrivate
+{
+public:
+    QAsyncFilePrivate() : pool(nullptr) {}
+
+    QByteArray readAt(qint64 offset, qint64 maxSize);
+    qint64 writeAt(qint64 offset, const QByteArray &data);
+    QThreadPool *threadPool() const { return pool ? pool : fileIoThreadPool(); }
+
+    QFile file;
+    QThreadPool *pool;
+    // Operations that can run concurrently hold this for reading; opening,
+    // closing, and operations that go through the QFile hold it for writing.
+    mutable QReadWriteLock lock;
+};
+
+QByteArray QAsyncFilePrivate::readAt(qint64 offset, qint64 maxSize)
+{
+#ifdef Q_OS_UNIX
+    QReadLocker locker(&lock);
+    if (!(file.openMode() & QIODevice::ReadOnly))
+        return QByteArray();
+
+    // pread() leaves the file position alone, so reads can overlap
+    const int fd = file.handle();
+    QT_STATBUF st;
+    if (QT_FSTAT(fd, &st) == -1 || offset >= st.st_size)
+        return QByteArray();
+    maxSize = qMin(maxSize, qMin(qint64(st.st_size) - offset, MaxByteArraySize));
+
+    QByteArray result(int(maxSize), Qt::Uninitialized);
+    qint64 readSoFar = 0;
+    while (readSoFar < maxSize) {
+        qint64 r;
+        EINTR_LOOP(r, QT_PREAD(fd, result.data() + readSoFar, size_t(maxSize - readSoFar),
+                               QT_OFF_T(offset + readSoFar)));
+        if (r <= 0)
+            break;
+        readSoFar += r;
+    }
+    result.resize(int(readSoFar));
+    return result;
+#else
+    QWriteLocker locker(&lock);
+    if (!(file.openMode() & QIODevice::ReadOnly) || offset >= file.size() || !file.seek(offset))
+        return QByteArray();
+    return file.read(qMin(maxSize, qMin(file.size() - offset, MaxByteArraySize)));
+#endif
+}
+
+qint64 QAsyncFilePrivate::writeAt(qint64 offset, const QByteArray &data)
+{
+#ifdef Q_OS_UNIX
+    QReadLocker locker(&lock);
+    if (!(file.openMode() & QIODevice::WriteOnly))
+        return -1;
+
+    const int fd = file.handle();
+    qint64 written = 0;
+    while (written < data.size()) {
+        qint64 w;
+        EINTR_LOOP(w, QT_PWRITE(fd, data.constData() + written, size_t(data.size() - written),
+                                QT_OFF_T(offset + written)));
+        if (w < 0)
+            return written ? written : -1;
+        written += w;
+    }
+    return written;
+#else
+    QWriteLocker locker(&lock);
+    if (!(file.openMode() & QIODevice::WriteOnly) || !file.seek(offset))
+        return -1;
+    return file.write(data);
+#endif
+}
+
+/*!
+    \class QAsyncFile
+    \inmodule QtCore
+    \since 5.11
+    \reentrant
+    \ingroup io
+
+    \brief The QAsyncFile class reads and writes files without blocking the
+    calling thread.
+
+    QAsyncFile opens a file like QFile does, but its read() and write()
+    functions return at once with a QFuture that holds the result when the
+    operation has completed. Each operation names the offset in the file it
+    applies to, so there is no current position, and many operations on the
+    same file or on different files can be outstanding at the same time.
+
+    \snippet code/src_corelib_io_qasyncfile.cpp 0
+
+    Opening and closing the file happen in the calling thread. The
+    operations run in a thread pool dedicated to file I/O, whose maximum
+    thread count bounds how many of them are performed at once; the others
+    wait in its queue. A different pool can be set with setThreadPool().
+
+    On Unix, operations use positional system calls and run concurrently even
+    on the same file. On other platforms, the operations on one file are
+    serialized, while operations on different files still overlap.
+
+    Closing the file, or destroying the QAsyncFile, waits for operations that
+    are running and makes those that have not yet started fail. Operations
+    that fail report an empty QByteArray or -1 as their result, rather than
+    setting error(), which only describes the outcome of open().
+
+    \sa QFile, QFuture, QFutureWatcher
+*/
+
+/*!
+    Constructs a QAsyncFile object with no file name.
+*/
+QAsyncFile::QAsyncFile()
+    : d(new QAsyncFilePrivate)
+{
+}
+
+/*!
+    Constructs a QAsyncFile object for the file with the given \a name.
+*/
+QAsyncFile::QAsyncFile(const QString &name)
+    : d(new QAsyncFilePrivate)
+{
+    d->file.setFileName(name);
+}
+
+/*!
+    Destroys the object, closing the file if it is open.
+
+    \sa close()
+*/
+QAsyncFile::~QAsyncFile()
+{
+    close();
+}
+
+/*!
+    Returns the name of the file.
+
+    \sa setFileName(), QFile::fileName()
+*/
+QString QAsyncFile::fileName() const
+{
+    QReadLocker locker(&d->lock);
+    return d->file.fileName();
+}
+
+/*!
+    Sets the \a name of the file. Does nothing if the file is open.
+
+    \sa fileName(), QFile::setFileName()
+*/
+void QAsyncFile::setFileName(const QString &name)
+{
+    QWriteLocker locker(&d->lock);
+    d->file.setFileName(name);
+}
+
+/*!
+    Opens the file with the given \a mode, returning true if successful;
+    otherwise returns false and sets error().
+
+    The mode must include QIODevice::ReadOnly or QIODevice::WriteOnly and
+    may include QIODevice::Truncate. QIODevice::Append and QIODevice::Text
+    cannot be used, since operations take explicit offsets and transfer raw
+    bytes. Opening blocks the calling thread for as long as QFile::open()
+    would.
+
+    \sa close(), isOpen()
+*/
+bool QAsyncFile::open(QIODevice::OpenMode mode)
+{
+    if (mode & (QIODevice::Append | QIODevice::Text)) {
+        qWarning("QAsyncFile::open: Append and Text modes are not supported");
+        return false;
+    }
+
+    QWriteLocker locker(&d->lock);
+    if (d->file.isOpen()) {
+        qWarning("QAsyncFile::open: File (%s) already open", qPrintable(d->file.fileName()));
+        return false;
+    }
+    return d->file.open(mode | QIODevice::Unbuffered);
+}
+
+/*!
+    Returns \c true if the file is open.
+
+    \sa open(), openMode()
+*/
+bool QAsyncFile::isOpen() const
+{
+    QReadLocker locker(&d->lock);
+    return d->file.isOpen();
+}
+
+/*!
+    Returns the mode the file was opened with, or QIODevice::NotOpen.
+
+    \sa open()
+*/
+QIODevice::OpenMode QAsyncFile::openMode() const
+{
+    QReadLocker locker(&d->lock);
+    return d->file.openMode() & ~QIODevice::Unbuffered;
+}
+
+/*!
+    Closes the file. Operations that are running are waited for; those
+    that have not started yet will fail.
+
+    \sa open()
+*/
+void QAsyncFile::close()
+{
+    QWriteLocker locker(&d->lock);
+    d->file.close();
+}
+
+/*!
+    Returns the size of the file, or 0 if it is not open.
+
+    \sa QFileDevice::size()
+*/
+qint64 QAsyncFile::size() const
+{
+    // QFile caches the size, so this must not race with other users of it
+    QWriteLocker locker(&d->lock);
+    return d->file.isOpen() ? d->file.size() : 0;
+}
+
+/*!
+    Returns the error that the last call to open() produced.
+
+    \sa errorString(), QFileDevice::error()
+*/
+QFileDevice::FileError QAsyncFile::error() const
+{
+    QReadLocker locker(&d->lock);
+    return d->file.error();
+}
+
+/*!
+    Returns a human-readable description of error().
+*/
+QString QAsyncFile::errorString() const
+{
+    QReadLocker locker(&d->lock);
+    return d->file.errorString();
+}
+
+/*!
+    Returns the thread pool that operations on this file are run in.
+
+    \sa setThreadPool()
+*/
+QThreadPool *QAsyncFile::threadPool() const
+{
+    return d->threadPool();
+}
+
+/*!
+    Makes operations that are started afterwards run in \a pool, or in the
+    default pool for file I/O if \a pool is null. The pool must outlive the
+    operations started in it.
+
+    \sa threadPool()
+*/
+void QAsyncFile::setThreadPool(QThreadPool *pool)
+{
+    d->pool = pool;
+}
+
+/*!
+    Starts reading at most \a maxSize bytes from the file, beginning at
+    \a offset, and returns a future for the data.
+
+    The data is shorter than \a maxSize if the end of the file is reached.
+    It is empty if \a offset is at or after the end of the file, if the file
+    is not open for reading, or if an error occurred.
+
+    \sa write()
+*/
+QFuture<QByteArray> QAsyncFile::read(qint64 offset, qint64 maxSize)
+{
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QAsyncFile::read: Called with negative offset or size");
+        return QFuture<QByteArray>();
+    }
+    QSharedPointer<QAsyncFilePrivate> dd = d;
+    return startFileTask<QByteArray>(d->threadPool(), [dd, offset, maxSize]() {
+        return dd->readAt(offset, maxSize);
+    });
+}
+
+/*!
+    Starts writing \a data to the file at \a offset and returns a future for
+    the number of bytes written, which is -1 if the file is not open for
+    writing or an error occurred before anything was written.
+
+    Writes that overlap in the file and are outstanding at the same time
+    are performed in no particular order.
+
+    \sa read()
+*/
+QFuture<qint64> QAsyncFile::write(qint64 offset, const QByteArray &data)
+{
+    if (offset < 0) {
+        qWarning("QAsyncFile::write: Called with negative offset");
+        return QFuture<qint64>();
+    }
+    QSharedPointer<QAsyncFilePrivate> dd = d;
+    return startFileTask<qint64>(d->threadPool(), [dd, offset, data]() {
+        return dd->writeAt(offset, data);
+    });
+}
+
+/*!
+    Starts reading the whole file called \a fileName in \a pool, or in the
+    default pool for file I/O if \a pool is null, and returns a future for
+    its contents. Unlike with the other functions, the file is also opened
+    in the pool, so the calling thread never blocks.
+
+    The contents are empty if the file cannot be opened.
+*/
+QFuture<QByteArray> QAsyncFile::readAll(const QString &fileName, QThreadPool *pool)
+{
+    return startFileTask<QByteArray>(pool ? pool : fileIoThreadPool(), [fileName]() {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly))
+            return QByteArray();
+        return file.readAll();
+    });
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_QFUTURE
@@ -0,0 +1,1373 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qcborstream.h"
+
+#include <qendian.h>
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+#include <private/qutfcodec_p.h>
+
+#include <limits>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+// major types, as stored in the top three bits of the initial byte
+enum {
+    MajorUnsignedInteger = 0x00,
+    MajorNegativeInteger = 0x20,
+    MajorByteString = 0x40,
+    MajorTextString = 0x60,
+    MajorArray = 0x80,
+    MajorMap = 0xa0,
+    MajorTag = 0xc0,
+    MajorSimpleType = 0xe0,
+
+    IndefiniteLength = 0x1f,
+    BreakByte = 0xff
+};
+
+/*!
+    \class QCborStreamWriter
+    \inmodule QtCore
+    \since 5.11
+    \reentrant
+    \ingroup io
+
+    \brief The QCborStreamWriter class is a simple CBOR encoder operating
+    on a one-way stream.
+
+    CBOR (Concise Binary Object Representation, RFC 7049) is a compact
+    binary data format in the spirit of JSON, but with byte strings,
+    tags and full 64-bit integers. QCborStreamWriter appends one item at
+    a time to a QByteArray or a QIODevice; nothing is buffered, so the
+    output is complete as soon as the last container has been closed.
+
+    Arrays and maps are started with startArray() or startMap() and
+    closed with endArray() or endMap(). If the number of items is known
+    up front, pass it to startArray() or startMap() so that the length is
+    encoded in the header; otherwise an indefinite-length container is
+    written and terminated by the matching end call. A map expects keys
+    and values to be appended in alternation.
+
+    \snippet code/src_corelib_io_qcborstream.cpp 0
+
+    \sa QCborStreamReader
+*/
+
+class QCborStreamWriterPrivate
+{
+public:
+    struct Container {
+        uchar major;
+        bool indefinite;
+        quint64 count;          // items left, or items written if indefinite
+    };
+
+    QCborStreamWriterPrivate(QIODevice *device, QByteArray *data)
+        : device(device), data(data)
+    {
+    }
+
+    void write(const char *p, qsizetype len)
+    {
+        if (data)
+            data->append(p, int(len));
+        else if (device)
+            device->write(p, len);
+    }
+
+    void writeHeader(uchar major, quint64 value);
+    void itemWritten()
+    {
+        if (containers.isEmpty())
+            return;
+        Container &c = containers.last();
+        if (c.indefinite)
+            ++c.count;
+        else if (c.count)
+            --c.count;
+    }
+
+    void startContainer(uchar major, quint64 count, bool indefinite);
+    bool endContainer(uchar major);
+
+    QIODevice *device;
+    QByteArray *data;
+    QVarLengthArray<Container, 16> containers;
+};
+
+void QCborStreamWriterPrivate::writeHeader(uchar major, quint64 value)
+{
+    uchar buf[1 + sizeof(quint64)];
+    qsizetype len;
+    if (value < 24) {
+        buf[0] = uchar(major | value);
+        len = 1;
+    } else if (value <= 0xff) {
+        buf[0] = major | 24;
+        buf[1] = uchar(value);
+        len = 2;
+    } else if (value <= 0xffff) {
+        buf[0] = major | 25;
+        qToBigEndian(quint16(value), buf + 1);
+        len = 3;
+    } else if (value <= 0xffffffffU) {
+        buf[0] = major | 26;
+        qToBigEndian(quint32(value), buf + 1);
+        len = 5;
+    } else {
+        buf[0] = major | 27;
+        qToBigEndian(value, buf + 1);
+        len = 9;
+    }
+    write(reinterpret_cast<char *>(buf), len);
+}
+
+void QCborStreamWriterPrivate::startContainer(uchar major, quint64 count, bool indefinite)
+{
+    if (indefinite) {
+        const char c = char(major | IndefiniteLength);
+        write(&c, 1);
+    } else {
+        writeHeader(major, count);
+        if (major == MajorMap)
+            count *= 2;
+    }
+    Container c = { major, indefinite, indefinite ? 0 : count };
+    containers.append(c);
+}
+
+bool QCborStreamWriterPrivate::endContainer(uchar major)
+{
+    if (containers.isEmpty() || containers.last().major != major)
+        return false;
+
+    const Container c = containers.last();
+    containers.removeLast();
+    bool ok = true;
+    if (c.indefinite) {
+        const char b = char(BreakByte);
+        write(&b, 1);
+        if (major == MajorMap && (c.count & 1))
+            ok = false;         // a key without a value
+    } else {
+        ok = c.count == 0;
+    }
+    itemWritten();
+    return ok;
+}
+
+/*!
+    Creates a QCborStreamWriter that appends the encoded stream to
+    \a device. The device must already be open for writing.
+*/
+QCborStreamWriter::QCborStreamWriter(QIODevice *device)
+    : d_ptr(new QCborStreamWriterPrivate(device, nullptr))
+{
+}
+
+/*!
+    Creates a QCborStreamWriter that appends the encoded stream to the
+    byte array \a data, which must outlive the writer.
+*/
+QCborStreamWriter::QCborStreamWriter(QByteArray *data)
+    : d_ptr(new QCborStreamWriterPrivate(nullptr, data))
+{
+}
+
+/*!
+    Destroys the writer. Containers that are still open are not closed.
+*/
+QCborStreamWriter::~QCborStreamWriter()
+{
+}
+
+/*!
+    Makes the writer append to \a device from now on. A byte array set
+    in the constructor is no longer written to.
+
+    \sa device()
+*/
+void QCborStreamWriter::setDevice(QIODevice *device)
+{
+    Q_D(QCborStreamWriter);
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the device the writer appends to, or \nullptr if it writes
+    to a QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QCborStreamWriter::device() const
+{
+    Q_D(const QCborStreamWriter);
+    return d->device;
+}
+
+/*!
+    Appends the unsigned integer \a u, using the shortest encoding that
+    can hold it.
+*/
+void QCborStreamWriter::append(quint64 u)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHeader(MajorUnsignedInteger, u);
+    d->itemWritten();
+}
+
+/*!
+    \overload
+
+    Appends the signed integer \a i. Negative values are stored as CBOR
+    negative integers.
+*/
+void QCborStreamWriter::append(qint64 i)
+{
+    if (i < 0)
+        appendNegativeInteger(quint64(-1 - i));
+    else
+        append(quint64(i));
+}
+
+/*!
+    \fn void QCborStreamWriter::append(uint u)
+    \overload
+*/
+
+/*!
+    \fn void QCborStreamWriter::append(int i)
+    \overload
+*/
+
+/*!
+    Appends the negative integer whose value is -1 - \a n. This covers
+    the whole CBOR range, down to -2\sup{64}, which does not fit in a
+    qint64.
+
+    \sa QCborStreamReader::toNegativeInteger()
+*/
+void QCborStreamWriter::appendNegativeInteger(quint64 n)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHeader(MajorNegativeInteger, n);
+    d->itemWritten();
+}
+
+/*!
+    Appends \a ba as a byte string.
+*/
+void QCborStreamWriter::append(const QByteArray &ba)
+{
+    appendByteString(ba.constData(), ba.size());
+}
+
+/*!
+    \overload
+
+    Appends \a str as a text string. Text in CBOR is UTF-8, so strings
+    that are pure US-ASCII are written as they are and others are
+    converted.
+*/
+void QCborStreamWriter::append(QLatin1String str)
+{
+    const char *p = str.data();
+    for (int i = 0; i < str.size(); ++i) {
+        if (uchar(p[i]) >= 0x80)
+            return append(QStringView(QString(str)));
+    }
+    appendTextString(p, str.size());
+}
+
+/*!
+    \overload
+
+    Appends \a str as a text string, converting it to UTF-8.
+*/
+void QCborStreamWriter::append(QStringView str)
+{
+    const QByteArray utf8 = str.toUtf8();
+    appendTextString(utf8.constData(), utf8.size());
+}
+
+/*!
+    \overload
+
+    Appends the UTF-8 text \a str of \a size bytes as a text string. If
+    \a size is negative, \a str must be null-terminated.
+*/
+void QCborStreamWriter::append(const char *str, qsizetype size)
+{
+    appendTextString(str, size < 0 ? qsizetype(strlen(str)) : size);
+}
+
+/*!
+    Appends the \a len bytes at \a data as a byte string.
+*/
+void QCborStreamWriter::appendByteString(const char *data, qsizetype len)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHeader(MajorByteString, quint64(len));
+    d->write(data, len);
+    d->itemWritten();
+}
+
+/*!
+    Appends the \a len bytes at \a utf8 as a text string. The data must
+    be valid UTF-8; it is not checked.
+*/
+void QCborStreamWriter::appendTextString(const char *utf8, qsizetype len)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHeader(MajorTextString, quint64(len));
+    d->write(utf8, len);
+    d->itemWritten();
+}
+
+/*!
+    Appends the semantic tag \a tag. The tag applies to the item that is
+    appended next, and the two count as a single item of the enclosing
+    container.
+*/
+void QCborStreamWriter::appendTag(quint64 tag)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHeader(MajorTag, tag);
+}
+
+/*!
+    Appends the simple type \a st. Values 24 to 31 are reserved by
+    RFC 7049 and must not be used.
+
+    \sa append(bool), appendNull(), appendUndefined()
+*/
+void QCborStreamWriter::appendSimpleType(quint8 st)
+{
+    Q_ASSERT_X(st < 24 || st >= 32, "QCborStreamWriter::appendSimpleType",
+               "simple types 24 to 31 are reserved");
+    Q_D(QCborStreamWriter);
+    if (st < 24) {
+        const char c = char(MajorSimpleType | st);
+        d->write(&c, 1);
+    } else {
+        const char buf[2] = { char(MajorSimpleType | 24), char(st) };
+        d->write(buf, 2);
+    }
+    d->itemWritten();
+}
+
+/*!
+    Appends the boolean \a b.
+*/
+void QCborStreamWriter::append(bool b)
+{
+    appendSimpleType(b ? QCborStreamReader::True : QCborStreamReader::False);
+}
+
+/*!
+    Appends the half-precision floating point value \a f.
+*/
+void QCborStreamWriter::append(qfloat16 f)
+{
+    Q_D(QCborStreamWriter);
+    quint16 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    uchar buf[3] = { QCborStreamReader::Float16 };
+    qToBigEndian(bits, buf + 1);
+    d->write(reinterpret_cast<char *>(buf), sizeof(buf));
+    d->itemWritten();
+}
+
+/*!
+    \overload
+
+    Appends the single-precision floating point value \a f.
+*/
+void QCborStreamWriter::append(float f)
+{
+    Q_D(QCborStreamWriter);
+    quint32 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    uchar buf[5] = { QCborStreamReader::Float };
+    qToBigEndian(bits, buf + 1);
+    d->write(reinterpret_cast<char *>(buf), sizeof(buf));
+    d->itemWritten();
+}
+
+/*!
+    \overload
+
+    Appends the double-precision floating point value \a d.
+*/
+void QCborStreamWriter::append(double d)
+{
+    quint64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    uchar buf[9] = { QCborStreamReader::Double };
+    qToBigEndian(bits, buf + 1);
+    d_func()->write(reinterpret_cast<char *>(buf), sizeof(buf));
+    d_func()->itemWritten();
+}
+
+/*!
+    Appends the null value.
+*/
+void QCborStreamWriter::appendNull()
+{
+    appendSimpleType(QCborStreamReader::Null);
+}
+
+/*!
+    Appends the undefined value.
+*/
+void QCborStreamWriter::appendUndefined()
+{
+    appendSimpleType(QCborStreamReader::Undefined);
+}
+
+/*!
+    Starts an array of unknown length. Every item appended until the
+    matching endArray() becomes an element of the array.
+*/
+void QCborStreamWriter::startArray()
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(MajorArray, 0, true);
+}
+
+/*!
+    \overload
+
+    Starts an array of exactly \a count elements. Its length is encoded
+    in the header, so the array takes one byte less and readers can
+    preallocate.
+*/
+void QCborStreamWriter::startArray(quint64 count)
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(MajorArray, count, false);
+}
+
+/*!
+    Closes the innermost array. Returns \c false if the innermost
+    container is not an array or if a different number of elements than
+    announced to startArray() was appended; the output is then not valid
+    CBOR.
+*/
+bool QCborStreamWriter::endArray()
+{
+    Q_D(QCborStreamWriter);
+    return d->endContainer(MajorArray);
+}
+
+/*!
+    Starts a map of unknown length. Keys and values are appended in
+    alternation until the matching endMap().
+*/
+void QCborStreamWriter::startMap()
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(MajorMap, 0, true);
+}
+
+/*!
+    \overload
+
+    Starts a map of exactly \a count key/value pairs.
+*/
+void QCborStreamWriter::startMap(quint64 count)
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(MajorMap, count, false);
+}
+
+/*!
+    Closes the innermost map. Returns \c false if the innermost container
+    is not a map, if the last key has no value, or if a different number
+    of pairs than announced to startMap() was appended.
+*/
+bool QCborStreamWriter::endMap()
+{
+    Q_D(QCborStreamWriter);
+    return d->endContainer(MajorMap);
+}
+
+/*!
+    Returns the number of arrays and maps that are currently open.
+*/
+int QCborStreamWriter::containerDepth() const
+{
+    Q_D(const QCborStreamWriter);
+    return d->containers.size();
+}
+
+/*!
+    \class QCborStreamReader
+    \inmodule QtCore
+    \since 5.11
+    \reentrant
+    \ingroup io
+
+    \brief The QCborStreamReader class is a simple CBOR stream decoder
+    operating on a memory buffer.
+
+    QCborStreamReader walks a CBOR (RFC 7049) stream one item at a time
+    without building a document in memory. type() tells what the current
+    item is; scalars are read with the to*() functions and skipped with
+    next(), while strings are consumed by readByteArray(),
+    readUtf8String() or readString(). Arrays and maps are entered with
+    enterContainer(), iterated while hasNext() returns \c true and left
+    with leaveContainer().
+
+    \snippet code/src_corelib_io_qcborstream.cpp 1
+
+    The reader never copies the input. Byte strings and UTF-8 text
+    strings are returned as QByteArray objects created with
+    QByteArray::fromRawData() that point straight into the buffer, which
+    makes it cheap to decode from a file mapped with QFile::map(). Only
+    strings that the encoder split into chunks (indefinite-length
+    strings) have to be assembled into a new array. Since the returned
+    arrays reference the buffer, they are valid only as long as the
+    buffer is: if the reader was handed a raw pointer, that is for as
+    long as the caller keeps the memory; if it was handed a QByteArray,
+    for as long as that array or a copy of it is alive.
+
+    Decoding errors stop the reader: type() becomes \l Invalid, and
+    lastError() and currentOffset() say what went wrong and where.
+
+    \sa QCborStreamWriter
+*/
+
+/*!
+    \enum QCborStreamReader::Type
+
+    This enum describes the current item. The values match the initial
+    byte of the encoded item, or its top three bits.
+
+    \value UnsignedInteger  An integer from 0 to 2\sup{64} - 1.
+    \value NegativeInteger  An integer from -1 to -2\sup{64}.
+    \value ByteString       A string of arbitrary bytes.
+    \value TextString       A string of UTF-8 text.
+    \value Array            An array.
+    \value Map              A map of key/value pairs.
+    \value Tag              A semantic tag applying to the next item.
+    \value SimpleType       A simple value: false, true, null, undefined
+                            or an application-defined one.
+    \value Float16          A half-precision floating point value.
+    \value Float            A single-precision floating point value.
+    \value Double           A double-precision floating point value.
+    \value Invalid          No item: the end of the data or of the current
+                            container was reached, or an error occurred.
+*/
+
+/*!
+    \enum QCborStreamReader::SimpleTypes
+
+    The simple types defined by RFC 7049.
+
+    \value False        The boolean \c false.
+    \value True         The boolean \c true.
+    \value Null         The null value.
+    \value Undefined    The undefined value.
+*/
+
+/*!
+    \enum QCborStreamReader::Error
+
+    \value NoError                  No error occurred.
+    \value EndOfFileError           The data ended in the middle of an item
+                                    or container.
+    \value IllegalTypeError         A chunk of an indefinite-length string
+                                    has the wrong type.
+    \value IllegalNumberError       An item header uses a reserved length
+                                    encoding.
+    \value IllegalSimpleTypeError   A simple type from 24 to 31 was encoded
+                                    in two bytes.
+    \value UnexpectedBreakError     A break byte appeared outside an
+                                    indefinite-length container, or after a
+                                    map key.
+    \value InvalidUtf8StringError   readString() found a text string that is
+                                    not valid UTF-8.
+    \value DataTooLargeError        A string or container is longer than this
+                                    implementation can represent.
+*/
+
+class QCborStreamReaderPrivate
+{
+public:
+    struct Container {
+        QCborStreamReader::Type type;
+        qint64 remaining;       // items left; below zero if indefinite
+    };
+
+    QCborStreamReaderPrivate()
+    {
+        setData(QByteArray());
+    }
+
+    void setData(const QByteArray &ba)
+    {
+        data = ba;
+        ptr = reinterpret_cast<const uchar *>(data.constData());
+        size = data.size();
+        reset();
+    }
+
+    void reset()
+    {
+        offset = 0;
+        containers.clear();
+        error = QCborStreamReader::NoError;
+        preparse();
+    }
+
+    void setError(QCborStreamReader::Error e)
+    {
+        error = e;
+        type = QCborStreamReader::Invalid;
+        atContainerEnd = false;
+    }
+
+    QCborStreamReader::Error decodeArgument(qsizetype pos, quint64 *value, qsizetype *headerSize) const;
+    void preparse();
+    void advance(qsizetype newOffset, bool countItem);
+    qsizetype scanChunks(QByteArray *out);
+    bool skipItem();
+    bool enterContainer();
+    bool leaveContainer();
+    QByteArray readString();
+
+    QByteArray data;
+    const uchar *ptr;
+    qsizetype size;
+
+    qsizetype offset;           // start of the current item
+    qsizetype headerSize;
+    quint64 value;              // argument of the current item's header
+    QCborStreamReader::Type type;
+    bool indefinite;
+    bool atContainerEnd;
+    QCborStreamReader::Error error;
+    QVarLengthArray<Container, 16> containers;
+};
+
+/*
+    Decodes the argument of the item header at \a pos into \a value and
+    its encoded size into \a headerSize. The header must not announce an
+    indefinite length.
+*/
+QCborStreamReader::Error
+QCborStreamReaderPrivate::decodeArgument(qsizetype pos, quint64 *value, qsizetype *headerSize) const
+{
+    const uchar *p = ptr + pos;
+    const uint ai = *p & 0x1f;
+    if (ai < 24) {
+        *value = ai;
+        *headerSize = 1;
+        return QCborStreamReader::NoError;
+    }
+    if (ai > 27)
+        return QCborStreamReader::IllegalNumberError;
+
+    const qsizetype n = qsizetype(1) << (ai - 24);
+    if (size - pos < 1 + n)
+        return QCborStreamReader::EndOfFileError;
+    switch (n) {
+    case 1:
+        *value = p[1];
+        break;
+    case 2:
+        *value = qFromBigEndian<quint16>(p + 1);
+        break;
+    case 4:
+        *value = qFromBigEndian<quint32>(p + 1);
+        break;
+    default:
+        *value = qFromBigEndian<quint64>(p + 1);
+        break;
+    }
+    *headerSize = 1 + n;
+    return QCborStreamReader::NoError;
+}
+
+/*
+    Decodes the header of the item at offset. Everything after the
+    header, such as string contents or container elements, is only
+    validated when it is read or skipped.
+*/
+void QCborStreamReaderPrivate::preparse()
+{
+    type = QCborStreamReader::Invalid;
+    headerSize = 0;
+    value = 0;
+    indefinite = false;
+    atContainerEnd = false;
+    if (error != QCborStreamReader::NoError)
+        return;
+
+    if (!containers.isEmpty() && containers.last().remaining == 0) {
+        atContainerEnd = true;
+        return;
+    }
+    if (offset >= size) {
+        if (!containers.isEmpty())
+            setError(QCborStreamReader::EndOfFileError);
+        return;
+    }
+
+    const uchar b = ptr[offset];
+    if (b == BreakByte) {
+        const Container *c = containers.isEmpty() ? nullptr : &containers.last();
+        // an indefinite map has consumed -1 - remaining items, which must be even
+        if (!c || c->remaining > 0 || (c->type == QCborStreamReader::Map && !(c->remaining & 1)))
+            setError(QCborStreamReader::UnexpectedBreakError);
+        else
+            atContainerEnd = true;
+        return;
+    }
+
+    const uchar major = b & 0xe0;
+    if ((b & 0x1f) == IndefiniteLength) {
+        if (major < MajorByteString || major > MajorMap)
+            return setError(QCborStreamReader::IllegalNumberError);
+        indefinite = true;
+        headerSize = 1;
+        type = QCborStreamReader::Type(major);
+        return;
+    }
+
+    const QCborStreamReader::Error e = decodeArgument(offset, &value, &headerSize);
+    if (e != QCborStreamReader::NoError)
+        return setError(e);
+
+    switch (major) {
+    case MajorSimpleType:
+        if (b >= QCborStreamReader::Float16) {
+            type = QCborStreamReader::Type(b);
+            return;
+        }
+        if (headerSize == 2 && value < 32)
+            return setError(QCborStreamReader::IllegalSimpleTypeError);
+        break;
+    case MajorByteString:
+    case MajorTextString:
+        if (value > quint64(std::numeric_limits<int>::max()))
+            return setError(QCborStreamReader::DataTooLargeError);
+        if (value > quint64(size - offset - headerSize))
+            return setError(QCborStreamReader::EndOfFileError);
+        break;
+    case MajorArray:
+    case MajorMap:
+        if (value > quint64(std::numeric_limits<qint64>::max() / 2))
+            return setError(QCborStreamReader::DataTooLargeError);
+        break;
+    }
+    type = QCborStreamReader::Type(major);
+}
+
+/*
+    Moves to the item at \a newOffset. If \a countItem is true, the item
+    that was just consumed was an element of the enclosing container;
+    tags are not, as they belong to the item they precede.
+*/
+void QCborStreamReaderPrivate::advance(qsizetype newOffset, bool countItem)
+{
+    offset = newOffset;
+    if (countItem && !containers.isEmpty() && containers.last().remaining != 0)
+        --containers.last().remaining;
+    preparse();
+}
+
+/*
+    Walks the chunks of the indefinite-length string at offset, appending
+    them to \a out if it is not null. Returns the offset just past the
+    terminating break byte, or -1 on error.
+*/
+qsizetype QCborStreamReaderPrivate::scanChunks(QByteArray *out)
+{
+    const uchar major = uchar(type);
+    qsizetype pos = offset + 1;
+    qint64 total = 0;
+    forever {
+        if (pos >= size) {
+            setError(QCborStreamReader::EndOfFileError);
+            return -1;
+        }
+        const uchar b = ptr[pos];
+        if (b == BreakByte)
+            return pos + 1;
+        if ((b & 0xe0) != major || (b & 0x1f) == IndefiniteLength) {
+            setError(QCborStreamReader::IllegalTypeError);
+            return -1;
+        }
+
+        quint64 len;
+        qsizetype hsz;
+        const QCborStreamReader::Error e = decodeArgument(pos, &len, &hsz);
+        if (e != QCborStreamReader::NoError) {
+            setError(e);
+            return -1;
+        }
+        if (len > quint64(size - pos - hsz)) {
+            setError(QCborStreamReader::EndOfFileError);
+            return -1;
+        }
+        total += qint64(len);
+        if (total > std::numeric_limits<int>::max()) {
+            setError(QCborStreamReader::DataTooLargeError);
+            return -1;
+        }
+        if (out)
+            out->append(reinterpret_cast<const char *>(ptr + pos + hsz), int(len));
+        pos += hsz + qsizetype(len);
+    }
+}
+
+/*
+    Skips the current item. Containers are skipped iteratively, so that
+    deeply nested input cannot exhaust the stack.
+*/
+bool QCborStreamReaderPrivate::skipItem()
+{
+    switch (type) {
+    case QCborStreamReader::Invalid:
+        return false;
+
+    case QCborStreamReader::Array:
+    case QCborStreamReader::Map: {
+        const int depth = containers.size();
+        enterContainer();
+        while (containers.size() > depth && error == QCborStreamReader::NoError) {
+            if (atContainerEnd)
+                leaveContainer();
+            else if (type == QCborStreamReader::Array || type == QCborStreamReader::Map)
+                enterContainer();
+            else
+                skipItem();
+        }
+        break;
+    }
+
+    case QCborStreamReader::ByteString:
+    case QCborStreamReader::TextString:
+        if (indefinite) {
+            const qsizetype end = scanChunks(nullptr);
+            if (end >= 0)
+                advance(end, true);
+        } else {
+            advance(offset + headerSize + qsizetype(value), true);
+        }
+        break;
+
+    case QCborStreamReader::Tag:
+        advance(offset + headerSize, false);
+        break;
+
+    default:
+        advance(offset + headerSize, true);
+        break;
+    }
+    return error == QCborStreamReader::NoError;
+}
+
+bool QCborStreamReaderPrivate::enterContainer()
+{
+    if (type != QCborStreamReader::Array && type != QCborStreamReader::Map)
+        return false;
+
+    Container c;
+    c.type = type;
+    if (indefinite)
+        c.remaining = -1;
+    else
+        c.remaining = qint64(type == QCborStreamReader::Map ? value * 2 : value);
+    containers.append(c);
+    advance(offset + headerSize, false);
+    return true;
+}
+
+bool QCborStreamReaderPrivate::leaveContainer()
+{
+    if (containers.isEmpty())
+        return false;
+    while (!atContainerEnd) {
+        if (!skipItem())
+            return false;
+    }
+
+    const bool wasIndefinite = containers.last().remaining < 0;
+    containers.removeLast();
+    advance(offset + (wasIndefinite ? 1 : 0), true);
+    return true;
+}
+
+QByteArray QCborStreamReaderPrivate::readString()
+{
+    if (!indefinite) {
+        const QByteArray result =
+                QByteArray::fromRawData(reinterpret_cast<const char *>(ptr + offset + headerSize), int(value));
+        advance(offset + headerSize + qsizetype(value), true);
+        return result;
+    }
+
+    QByteArray result("");
+    const qsizetype end = scanChunks(&result);
+    if (end < 0)
+        return QByteArray();
+    advance(end, true);
+    return result;
+}
+
+/*!
+    Creates a reader with no data. Use setData() to give it something to
+    decode.
+*/
+QCborStreamReader::QCborStreamReader()
+    : d_ptr(new QCborStreamReaderPrivate)
+{
+}
+
+/*!
+    Creates a reader that decodes \a data. The reader keeps a shallow
+    copy of \a data, so the strings it returns stay valid while the
+    reader exists even if the caller's copy goes away.
+*/
+QCborStreamReader::QCborStreamReader(const QByteArray &data)
+    : d_ptr(new QCborStreamReaderPrivate)
+{
+    Q_D(QCborStreamReader);
+    d->setData(data);
+}
+
+/*!
+    \overload
+
+    Creates a reader that decodes the \a len bytes at \a data without
+    copying them, such as the memory returned by QFile::map(). The memory
+    must stay valid and unmodified for as long as the reader and any
+    string it returned are in use.
+*/
+QCborStreamReader::QCborStreamReader(const char *data, qsizetype len)
+    : d_ptr(new QCborStreamReaderPrivate)
+{
+    setData(data, len);
+}
+
+/*!
+    Destroys the reader.
+*/
+QCborStreamReader::~QCborStreamReader()
+{
+}
+
+/*!
+    Discards the current state and starts decoding \a data from the
+    beginning.
+
+    \sa reset()
+*/
+void QCborStreamReader::setData(const QByteArray &data)
+{
+    Q_D(QCborStreamReader);
+    d->setData(data);
+}
+
+/*!
+    \overload
+
+    Starts decoding the \a len bytes at \a data, which are not copied.
+*/
+void QCborStreamReader::setData(const char *data, qsizetype len)
+{
+    Q_ASSERT_X(len <= std::numeric_limits<int>::max(), "QCborStreamReader::setData",
+               "data too large");
+    Q_D(QCborStreamReader);
+    d->setData(QByteArray::fromRawData(data, int(len)));
+}
+
+/*!
+    Returns the data being decoded.
+*/
+QByteArray QCborStreamReader::data() const
+{
+    Q_D(const QCborStreamReader);
+    return d->data;
+}
+
+/*!
+    Rewinds the reader to the beginning of the data and clears any error.
+*/
+void QCborStreamReader::reset()
+{
+    Q_D(QCborStreamReader);
+    d->reset();
+}
+
+/*!
+    Returns the error that stopped the reader, or NoError.
+
+    \sa currentOffset()
+*/
+QCborStreamReader::Error QCborStreamReader::lastError() const
+{
+    Q_D(const QCborStreamReader);
+    return d->error;
+}
+
+/*!
+    \fn bool QCborStreamReader::hasError() const
+
+    Returns \c true if lastError() is not NoError.
+*/
+
+/*!
+    Returns the offset in bytes of the current item from the beginning of
+    the data. After an error, this is the offset of the item that could
+    not be decoded.
+*/
+qint64 QCborStreamReader::currentOffset() const
+{
+    Q_D(const QCborStreamReader);
+    return d->offset;
+}
+
+/*!
+    Returns the type of the current item.
+*/
+QCborStreamReader::Type QCborStreamReader::type() const
+{
+    Q_D(const QCborStreamReader);
+    return d->type;
+}
+
+/*!
+    Returns \c true if the current item is the simple type \a st.
+
+    \sa isFalse(), isTrue(), isNull(), isUndefined()
+*/
+bool QCborStreamReader::isSimpleType(quint8 st) const
+{
+    Q_D(const QCborStreamReader);
+    return d->type == SimpleType && d->value == st;
+}
+
+/*!
+    Returns \c true if there is a current item, that is if the end of the
+    current container or of the data has not been reached and no error
+    occurred.
+
+    \sa next(), leaveContainer()
+*/
+bool QCborStreamReader::hasNext() const
+{
+    Q_D(const QCborStreamReader);
+    return d->type != Invalid;
+}
+
+/*!
+    Skips the current item, including all elements if it is an array or
+    a map, and moves to the next one. A tag is skipped on its own; the
+    item it applies to becomes current. Returns \c false if there was no
+    current item or if the data turned out to be malformed.
+*/
+bool QCborStreamReader::next()
+{
+    Q_D(QCborStreamReader);
+    return d->skipItem();
+}
+
+/*!
+    Returns the number of arrays and maps that have been entered and not
+    yet left.
+*/
+int QCborStreamReader::containerDepth() const
+{
+    Q_D(const QCborStreamReader);
+    return d->containers.size();
+}
+
+/*!
+    Returns \l Array or \l Map if the reader is inside a container, or
+    \l Invalid at the top level.
+*/
+QCborStreamReader::Type QCborStreamReader::parentContainerType() const
+{
+    Q_D(const QCborStreamReader);
+    return d->containers.isEmpty() ? Invalid : d->containers.last().type;
+}
+
+/*!
+    Returns \c true if the current item is a string, array or map whose
+    length is encoded in its header.
+
+    \sa length()
+*/
+bool QCborStreamReader::isLengthKnown() const
+{
+    Q_D(const QCborStreamReader);
+    switch (d->type) {
+    case ByteString:
+    case TextString:
+    case Array:
+    case Map:
+        return !d->indefinite;
+    default:
+        return false;
+    }
+}
+
+/*!
+    Returns the number of bytes in the current string, of elements in the
+    current array or of pairs in the current map, or 0 if the length is
+    not known.
+
+    \sa isLengthKnown()
+*/
+quint64 QCborStreamReader::length() const
+{
+    return isLengthKnown() ? d_func()->value : 0;
+}
+
+/*!
+    Enters the current array or map and makes its first element current.
+    Returns \c false if the current item is not a container.
+
+    \sa leaveContainer(), hasNext()
+*/
+bool QCborStreamReader::enterContainer()
+{
+    Q_D(QCborStreamReader);
+    return d->enterContainer();
+}
+
+/*!
+    Leaves the innermost container that was entered, skipping any
+    elements that have not been read yet, and moves to the item after it.
+    Returns \c false if no container was entered or if the data is
+    malformed.
+*/
+bool QCborStreamReader::leaveContainer()
+{
+    Q_D(QCborStreamReader);
+    return d->leaveContainer();
+}
+
+/*!
+    Returns the value of the current unsigned integer.
+*/
+quint64 QCborStreamReader::toUnsignedInteger() const
+{
+    Q_D(const QCborStreamReader);
+    return d->type == UnsignedInteger ? d->value : 0;
+}
+
+/*!
+    Returns the encoded argument \c n of the current negative integer,
+    whose value is -1 - \c n. Unlike toInteger(), this covers the whole
+    range of CBOR negative integers.
+*/
+quint64 QCborStreamReader::toNegativeInteger() const
+{
+    Q_D(const QCborStreamReader);
+    return d->type == NegativeInteger ? d->value : 0;
+}
+
+/*!
+    Returns the value of the current integer, positive or negative. The
+    result is truncated if it does not fit in a qint64.
+*/
+qint64 QCborStreamReader::toInteger() const
+{
+    Q_D(const QCborStreamReader);
+    if (d->type == UnsignedInteger)
+        return qint64(d->value);
+    if (d->type == NegativeInteger)
+        return -1 - qint64(d->value);
+    return 0;
+}
+
+/*!
+    Returns the number of the current tag.
+*/
+quint64 QCborStreamReader::toTag() const
+{
+    Q_D(const QCborStreamReader);
+    return d->type == Tag ? d->value : 0;
+}
+
+/*!
+    Returns the number of the current simple type.
+
+    \sa isSimpleType()
+*/
+quint8 QCborStreamReader::toSimpleType() const
+{
+    Q_D(const QCborStreamReader);
+    return d->type == SimpleType ? quint8(d->value) : 0;
+}
+
+/*!
+    \fn bool QCborStreamReader::toBool() const
+
+    Returns \c true if the current item is the boolean \c true.
+*/
+
+/*!
+    Returns the value of the current half-precision floating point
+    item.
+*/
+qfloat16 QCborStreamReader::toFloat16() const
+{
+    Q_D(const QCborStreamReader);
+    qfloat16 f;
+    const quint16 bits = d->type == Float16 ? quint16(d->value) : 0;
+    memcpy(static_cast<void *>(&f), &bits, sizeof(bits));
+    return f;
+}
+
+/*!
+    Returns the value of the current single-precision floating point
+    item. A half-precision item is converted.
+*/
+float QCborStreamReader::toFloat() const
+{
+    Q_D(const QCborStreamReader);
+    if (d->type == Float16)
+        return float(toFloat16());
+    float f;
+    const quint32 bits = d->type == Float ? quint32(d->value) : 0;
+    memcpy(&f, &bits, sizeof(bits));
+    return f;
+}
+
+/*!
+    Returns the value of the current double-precision floating point
+    item. Half- and single-precision items are converted.
+*/
+double QCborStreamReader::toDouble() const
+{
+    Q_D(const QCborStreamReader);
+    if (d->type == Float16 || d->type == Float)
+        return double(toFloat());
+    double v;
+    const quint64 bits = d->type == Double ? d->value : 0;
+    memcpy(&v, &bits, sizeof(bits));
+    return v;
+}
+
+/*!
+    Returns the contents of the current byte or text string without
+    copying them and without moving to the next item. Returns a null
+    QByteArray if the current item is not a string or if it is split in
+    chunks; use readByteArray() or readUtf8String() for those.
+*/
+QByteArray QCborStreamReader::byteArrayView() const
+{
+    Q_D(const QCborStreamReader);
+    if ((d->type != ByteString && d->type != TextString) || d->indefinite)
+        return QByteArray();
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(d->ptr + d->offset + d->headerSize),
+                                   int(d->value));
+}
+
+/*!
+    Reads the current byte string and moves to the next item. The result
+    references the decoded buffer unless the string was split in chunks.
+    Returns a null QByteArray if the current item is not a byte string or
+    if an error occurs.
+*/
+QByteArray QCborStreamReader::readByteArray()
+{
+    Q_D(QCborStreamReader);
+    if (d->type != ByteString)
+        return QByteArray();
+    return d->readString();
+}
+
+/*!
+    Reads the current text string as UTF-8 and moves to the next item.
+    The result references the decoded buffer unless the string was
+    split in chunks. The contents are not validated. Returns a null
+    QByteArray if the current item is not a text string or if an error
+    occurs.
+
+    \sa readString()
+*/
+QByteArray QCborStreamReader::readUtf8String()
+{
+    Q_D(QCborStreamReader);
+    if (d->type != TextString)
+        return QByteArray();
+    return d->readString();
+}
+
+/*!
+    Reads the current text string, converts it to QString and moves to
+    the next item. Text that is not valid UTF-8 stops the reader with
+    InvalidUtf8StringError. Returns a null QString if the current item
+    is not a text string or if an error occurs.
+*/
+QString QCborStreamReader::readString()
+{
+    Q_D(QCborStreamReader);
+    if (d->type != TextString)
+        return QString();
+
+    const qsizetype itemOffset = d->offset;
+    const QByteArray utf8 = d->readString();
+    if (d->error != NoError)
+        return QString();
+
+    const QUtf8::ValidUtf8Result r = QUtf8::isValidUtf8(utf8.constData(), utf8.size());
+    if (!r.isValidUtf8) {
+        d->offset = itemOffset;
+        d->setError(InvalidUtf8StringError);
+        return QString();
+    }
+    if (r.isValidAscii)
+        return QString::fromLatin1(utf8.constData(), utf8.size());
+    return QString::fromUtf8(utf8.constData(), utf8.size());
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCBORSTREAM_H
+#define QCBORSTREAM_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfloat16.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QCborStreamWriterPrivate;
+class Q_CORE_EXPORT QCborStreamWriter
+{
+public:
+    explicit QCborStreamWriter(QIODevice *device);
+    explicit QCborStreamWriter(QByteArray *data);
+    ~QCborStreamWriter();
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+
+    void append(quint64 u);
+    void append(qint64 i);
+    inline void append(uint u) { append(quint64(u)); }
+    inline void append(int i) { append(qint64(i)); }
+    void appendNegativeInteger(quint64 n);
+    void append(const QByteArray &ba);
+    void append(QLatin1String str);
+    void append(QStringView str);
+    void append(const char *str, qsizetype size = -1);
+    void appendByteString(const char *data, qsizetype len);
+    void appendTextString(const char *utf8, qsizetype len);
+    void appendTag(quint64 tag);
+    void appendSimpleType(quint8 st);
+    void append(bool b);
+    void append(qfloat16 f);
+    void append(float f);
+    void append(double d);
+    void appendNull();
+    void appendUndefined();
+
+    void startArray();
+    void startArray(quint64 count);
+    bool endArray();
+    void startMap();
+    void startMap(quint64 count);
+    bool endMap();
+
+    int containerDepth() const;
+
+private:
+    Q_DISABLE_COPY(QCborStreamWriter)
+    Q_DECLARE_PRIVATE(QCborStreamWriter)
+    QScopedPointer<QCborStreamWriterPrivate> d_ptr;
+};
+
+class QCborStreamReaderPrivate;
+class Q_CORE_EXPORT QCborStreamReader
+{
+public:
+    enum Type : quint8 {
+        UnsignedInteger = 0x00,
+        NegativeInteger = 0x20,
+        ByteString = 0x40,
+        TextString = 0x60,
+        Array = 0x80,
+        Map = 0xa0,
+        Tag = 0xc0,
+        SimpleType = 0xe0,
+        Float16 = 0xf9,
+        Float = 0xfa,
+        Double = 0xfb,
+
+        Invalid = 0xff
+    };
+
+    enum SimpleTypes : quint8 {
+        False = 20,
+        True = 21,
+        Null = 22,
+        Undefined = 23
+    };
+
+    enum Error {
+        NoError,
+        EndOfFileError,
+        IllegalTypeError,
+        IllegalNumberError,
+        IllegalSimpleTypeError,
+        UnexpectedBreakError,
+        InvalidUtf8StringError,
+        DataTooLargeError
+    };
+
+    QCborStreamReader();
+    explicit QCborStreamReader(const QByteArray &data);
+    QCborStreamReader(const char *data, qsizetype len);
+    ~QCborStreamReader();
+
+    void setData(const QByteArray &data);
+    void setData(const char *data, qsizetype len);
+    QByteArray data() const;
+    void reset();
+
+    Error lastError() const;
+    inline bool hasError() const { return lastError() != NoError; }
+    qint64 currentOffset() const;
+
+    Type type() const;
+    inline bool isValid() const { return type() != Invalid; }
+    inline bool isUnsignedInteger() const { return type() == UnsignedInteger; }
+    inline bool isNegativeInteger() const { return type() == NegativeInteger; }
+    inline bool isInteger() const { return isUnsignedInteger() || isNegativeInteger(); }
+    inline bool isByteArray() const { return type() == ByteString; }
+    inline bool isString() const { return type() == TextString; }
+    inline bool isArray() const { return type() == Array; }
+    inline bool isMap() const { return type() == Map; }
+    inline bool isContainer() const { return isArray() || isMap(); }
+    inline bool isTag() const { return type() == Tag; }
+    inline bool isSimpleType() const { return type() == SimpleType; }
+    inline bool isFloat16() const { return type() == Float16; }
+    inline bool isFloat() const { return type() == Float; }
+    inline bool isDouble() const { return type() == Double; }
+    inline bool isFalse() const { return isSimpleType(False); }
+    inline bool isTrue() const { return isSimpleType(True); }
+    inline bool isBool() const { return isFalse() || isTrue(); }
+    inline bool isNull() const { return isSimpleType(Null); }
+    inline bool isUndefined() const { return isSimpleType(Undefined); }
+    bool isSimpleType(quint8 st) const;
+
+    bool hasNext() const;
+    bool next();
+
+    int containerDepth() const;
+    Type parentContainerType() const;
+    bool isLengthKnown() const;
+    quint64 length() const;
+    bool enterContainer();
+    bool leaveContainer();
+
+    quint64 toUnsignedInteger() const;
+    quint64 toNegativeInteger() const;
+    qint64 toInteger() const;
+    quint64 toTag() const;
+    quint8 toSimpleType() const;
+    inline bool toBool() const { return isTrue(); }
+    qfloat16 toFloat16() const;
+    float toFloat() const;
+    double toDouble() const;
+
+    QByteArray byteArrayView() const;
+    QByteArray readByteArray();
+    QByteArray readUtf8String();
+    QString readString();
+
+private:
+    Q_DISABLE_COPY(QCborStreamReader)
+    Q_DECLARE_PRIVATE(QCborStreamReader)
+    QScopedPointer<QCborStreamReaderPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCBORSTREAM_H
@@ -49,6 +49,8 @@
 #include <stdlib.h>
 #include "qendian.h"
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -1394,6 +1396,181 @@ int QDataStream::skipRawData(int len)
     return skipResult;
 }
 
+static void swapItems(const void *source, qint64 count, int size, void *dest)
+{
+    switch (size) {
+    case 2:
+        qbswap<2>(source, count, dest);
+        break;
+    case 4:
+        qbswap<4>(source, count, dest);
+        break;
+    case 8:
+        qbswap<8>(source, count, dest);
+        break;
+    default:
+        qbswap<1>(source, count * size, dest);
+        break;
+    }
+}
+
+enum { SpanConversionChunk = 512 };
+
+/*!
+    \fn template <typename T> QDataStream &QDataStream::readRawSpan(T *data, int count)
+    \since 5.11
+
+    Reads \a count values of type \c{T} from the stream into the array at
+    \a data and returns a reference to the stream. \c{T} must be one of the
+    integer types qint8 to quint64, qfloat16, \c float or \c double.
+
+    The result is the same as calling operator>>() for each element, taking
+    byteOrder(), floatingPointPrecision() and version() into account, but the
+    data is read from the device in one go and its byte order is changed
+    block-wise where necessary. This is how operator>>() reads a QVector of
+    these types.
+
+    If the stream runs out of data, the elements that could not be read are
+    set to zero and the status is set to ReadPastEnd.
+
+    \sa writeRawSpan(), readRawData()
+*/
+QDataStream &QDataStream::readSpan(void *data, qint64 count, int size, bool isFloatingPoint)
+{
+    char *p = static_cast<char *>(data);
+    if (count <= 0)
+        return *this;
+    if (!dev)
+        memset(p, 0, size_t(count * size));
+    CHECK_STREAM_PRECOND(*this)
+
+    if (isFloatingPoint && version() >= Qt_4_6
+        && (size == 4) != (floatingPointPrecision() == SinglePrecision)) {
+        // the stream holds the other precision: read that and convert it
+        union {
+            float f[SpanConversionChunk];
+            double d[SpanConversionChunk];
+        } buf;
+        while (count > 0) {
+            const int n = int(qMin<qint64>(count, SpanConversionChunk));
+            if (size == 4) {
+                readSpan(buf.d, n, 8, false);
+                for (int i = 0; i < n; ++i)
+                    qToUnaligned(float(buf.d[i]), p + 4 * i);
+            } else {
+                readSpan(buf.f, n, 4, false);
+                for (int i = 0; i < n; ++i)
+                    qToUnaligned(double(buf.f[i]), p + 8 * i);
+            }
+            p += n * size;
+            count -= n;
+        }
+        return *this;
+    }
+
+    if (size == 8 && !isFloatingPoint && version() < 6) {
+        for (; count > 0; --count, p += 8) {
+            qint64 i;
+            *this >> i;
+            qToUnaligned(i, p);
+        }
+        return *this;
+    }
+
+    const qint64 bytes = count * size;
+    qint64 done = 0;
+    while (done < bytes) {
+        const int len = int(qMin<qint64>(bytes - done, std::numeric_limits<int>::max()));
+        const int readResult = readBlock(p + done, len);
+        if (readResult > 0)
+            done += readResult;
+        if (readResult != len)
+            break;
+    }
+
+    // as with operator>>(), what could not be read is zero
+    const qint64 complete = done / size;
+    memset(p + complete * size, 0, size_t(bytes - complete * size));
+    if (!noswap)
+        swapItems(p, complete, size, p);
+    return *this;
+}
+
+/*!
+    \fn template <typename T> QDataStream &QDataStream::writeRawSpan(const T *data, int count)
+    \since 5.11
+
+    Writes the \a count values of type \c{T} at \a data to the stream and
+    returns a reference to the stream. \c{T} must be one of the integer
+    types qint8 to quint64, qfloat16, \c float or \c double.
+
+    The output is the same as calling operator<<() for each element, taking
+    byteOrder(), floatingPointPrecision() and version() into account, but
+    the data is passed to the device in large blocks instead of one write
+    per element, and its byte order is changed block-wise where necessary.
+    If no byte order change is needed, the data is written as it is. This is
+    how operator<<() writes a QVector of these types.
+
+    \sa readRawSpan(), writeRawData()
+*/
+QDataStream &QDataStream::writeSpan(const void *data, qint64 count, int size, bool isFloatingPoint)
+{
+    CHECK_STREAM_WRITE_PRECOND(*this)
+    const char *p = static_cast<const char *>(data);
+    if (count <= 0)
+        return *this;
+
+    if (isFloatingPoint && version() >= Qt_4_6
+        && (size == 4) != (floatingPointPrecision() == SinglePrecision)) {
+        // the stream wants the other precision: convert, then write that as is
+        union {
+            float f[SpanConversionChunk];
+            double d[SpanConversionChunk];
+        } buf;
+        while (count > 0 && q_status == Ok) {
+            const int n = int(qMin<qint64>(count, SpanConversionChunk));
+            if (size == 4) {
+                for (int i = 0; i < n; ++i)
+                    buf.d[i] = qFromUnaligned<float>(p + 4 * i);
+                writeSpan(buf.d, n, 8, false);
+            } else {
+                for (int i = 0; i < n; ++i)
+                    buf.f[i] = float(qFromUnaligned<double>(p + 8 * i));
+                writeSpan(buf.f, n, 4, false);
+            }
+            p += n * size;
+            count -= n;
+        }
+        return *this;
+    }
+
+    if (size == 8 && !isFloatingPoint && version() < 6) {
+        for (; count > 0 && q_status == Ok; --count, p += 8)
+            *this << qFromUnaligned<qint64>(p);
+        return *this;
+    }
+
+    if (noswap || size == 1) {
+        if (dev->write(p, count * size) != count * size)
+            q_status = WriteFailed;
+        return *this;
+    }
+
+    char buf[4096];
+    const qint64 perChunk = qint64(sizeof(buf)) / size;
+    while (count > 0) {
+        const qint64 n = qMin(count, perChunk);
+        swapItems(p, n, size, buf);
+        if (dev->write(buf, n * size) != n * size) {
+            q_status = WriteFailed;
+            break;
+        }
+        p += n * size;
+        count -= n;
+    }
+    return *this;
+}
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_DATASTREAM
@@ -184,6 +184,9 @@ public:
 
     int skipRawData(int len);
 
+    template <typename T> QDataStream &readRawSpan(T *data, int count);
+    template <typename T> QDataStream &writeRawSpan(const T *data, int count);
+
     void startTransaction();
     bool commitTransaction();
     void rollbackTransaction();
@@ -202,6 +205,8 @@ private:
     Status q_status;
 
     int readBlock(char *data, int len);
+    QDataStream &readSpan(void *data, qint64 count, int size, bool isFloatingPoint);
+    QDataStream &writeSpan(const void *data, qint64 count, int size, bool isFloatingPoint);
     friend class QtPrivate::StreamStateSaver;
 };
 
@@ -303,6 +308,64 @@ QDataStream &writeSequentialContainer(QDataStream &s, const Container &c)
     return s;
 }
 
+// Types that QDataStream can read and write in bulk with readRawSpan() and
+// writeRawSpan(): those whose stream format is their memory representation,
+// modulo byte order
+template <typename T> struct IsDataStreamSpanType : std::false_type {};
+template <> struct IsDataStreamSpanType<qint8> : std::true_type {};
+template <> struct IsDataStreamSpanType<quint8> : std::true_type {};
+template <> struct IsDataStreamSpanType<qint16> : std::true_type {};
+template <> struct IsDataStreamSpanType<quint16> : std::true_type {};
+template <> struct IsDataStreamSpanType<qint32> : std::true_type {};
+template <> struct IsDataStreamSpanType<quint32> : std::true_type {};
+template <> struct IsDataStreamSpanType<qint64> : std::true_type {};
+template <> struct IsDataStreamSpanType<quint64> : std::true_type {};
+template <> struct IsDataStreamSpanType<qfloat16> : std::true_type {};
+template <> struct IsDataStreamSpanType<float> : std::true_type {};
+template <> struct IsDataStreamSpanType<double> : std::true_type {};
+
+template <typename T>
+QDataStream &readVector(QDataStream &s, QVector<T> &v, std::false_type)
+{
+    return readArrayBasedContainer(s, v);
+}
+
+template <typename T>
+QDataStream &readVector(QDataStream &s, QVector<T> &v, std::true_type)
+{
+    StreamStateSaver stateSaver(&s);
+
+    v.clear();
+    quint32 n;
+    s >> n;
+    // Grow in bounded steps, so that a corrupt count runs into the end of
+    // the data before it can cause a huge allocation.
+    const quint32 step = (1 << 20) / sizeof(T);
+    for (quint32 done = 0; done < n && s.status() == QDataStream::Ok; ) {
+        const int chunk = int(qMin(n - done, step));
+        v.resize(int(done) + chunk);
+        s.readRawSpan(v.data() + done, chunk);
+        done += chunk;
+    }
+    if (s.status() != QDataStream::Ok)
+        v.clear();
+
+    return s;
+}
+
+template <typename T>
+QDataStream &writeVector(QDataStream &s, const QVector<T> &v, std::false_type)
+{
+    return writeSequentialContainer(s, v);
+}
+
+template <typename T>
+QDataStream &writeVector(QDataStream &s, const QVector<T> &v, std::true_type)
+{
+    s << quint32(v.size());
+    return s.writeRawSpan(v.constData(), v.size());
+}
+
 template <typename Container>
 QDataStream &writeAssociativeContainer(QDataStream &s, const Container &c)
 {
@@ -362,6 +425,22 @@ inline QDataStream &QDataStream::operator<<(quint32 i)
 inline QDataStream &QDataStream::operator<<(quint64 i)
 { return *this << qint64(i); }
 
+template <typename T>
+inline QDataStream &QDataStream::readRawSpan(T *data, int count)
+{
+    Q_STATIC_ASSERT_X(QtPrivate::IsDataStreamSpanType<T>::value,
+                      "readRawSpan() only supports integer and floating point types");
+    return readSpan(data, count, int(sizeof(T)), std::is_floating_point<T>::value);
+}
+
+template <typename T>
+inline QDataStream &QDataStream::writeRawSpan(const T *data, int count)
+{
+    Q_STATIC_ASSERT_X(QtPrivate::IsDataStreamSpanType<T>::value,
+                      "writeRawSpan() only supports integer and floating point types");
+    return writeSpan(data, count, int(sizeof(T)), std::is_floating_point<T>::value);
+}
+
 template <typename Enum>
 inline QDataStream &operator<<(QDataStream &s, QFlags<Enum> e)
 { return s << e.i; }
@@ -397,13 +476,13 @@ inline QDataStream &operator<<(QDataStream &s, const QLinkedList<T> &l)
 template<typename T>
 inline QDataStream &operator>>(QDataStream &s, QVector<T> &v)
 {
-    return QtPrivate::readArrayBasedContainer(s, v);
+    return QtPrivate::readVector(s, v, QtPrivate::IsDataStreamSpanType<T>());
 }
 
 template<typename T>
 inline QDataStream &operator<<(QDataStream &s, const QVector<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    return QtPrivate::writeVector(s, v, QtPrivate::IsDataStreamSpanType<T>());
 }
 
 template <typename T>
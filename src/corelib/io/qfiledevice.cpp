@@ -55,7 +55,8 @@ QT_BEGIN_NAMESPACE
 QFileDevicePrivate::QFileDevicePrivate()
     : fileEngine(0),
       cachedSize(0),
-      error(QFile::NoError), lastWasWrite(false)
+      error(QFile::NoError), lastWasWrite(false),
+      spanMapping(nullptr), spanMappingSize(0), spanMappingAttempted(false)
 {
     writeBufferChunkSize = QFILE_WRITEBUFFER_SIZE;
 }
@@ -331,6 +332,11 @@ void QFileDevice::close()
     // reset cached size
     d->cachedSize = 0;
 
+    // the engine unmaps everything on close
+    d->spanMapping = nullptr;
+    d->spanMappingSize = 0;
+    d->spanMappingAttempted = false;
+
     // keep earlier error from flush
     if (d->fileEngine->close() && flushed)
         unsetError();
@@ -533,6 +539,32 @@ bool QFileDevicePrivate::putCharHelper(char c)
 #endif
 }
 
+/*!
+    \internal
+
+    Maps a file opened in ReadOnly mode into memory the first time it is
+    asked for, so that QIODevice::readSpan() can hand out views of it.
+*/
+const char *QFileDevicePrivate::mappedData(qint64 *size)
+{
+    Q_Q(QFileDevice);
+    if (!spanMappingAttempted) {
+        spanMappingAttempted = true;
+        if ((openMode & (QIODevice::ReadWrite | QIODevice::Text)) == QIODevice::ReadOnly) {
+            const QFileDevice::FileError savedError = error;
+            const QString savedErrorString = errorString;
+            const qint64 fileSize = q->size();
+            if (fileSize > 0 && (spanMapping = q->map(0, fileSize)))
+                spanMappingSize = fileSize;
+            // failing to map is not an error; reading takes the buffered path
+            error = savedError;
+            errorString = savedErrorString;
+        }
+    }
+    *size = spanMappingSize;
+    return reinterpret_cast<const char *>(spanMapping);
+}
+
 /*!
   \reimp
 */
@@ -70,6 +70,7 @@ protected:
     inline bool ensureFlushed() const;
 
     bool putCharHelper(char c) Q_DECL_OVERRIDE;
+    const char *mappedData(qint64 *size) Q_DECL_OVERRIDE;
 
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
@@ -82,6 +83,11 @@ protected:
     QFileDevice::FileError error;
 
     bool lastWasWrite;
+
+    // whole-file mapping backing QIODevice::readSpan(), created on first use
+    uchar *spanMapping;
+    qint64 spanMappingSize;
+    bool spanMappingAttempted;
 };
 
 inline bool QFileDevicePrivate::ensureFlushed() const
@@ -683,8 +683,10 @@ bool QFileInfo::exists() const
     if (d->isDefaultConstructed)
         return false;
     if (d->fileEngine == 0) {
-        if (!d->cache_enabled || !d->metaData.hasFlags(QFileSystemMetaData::ExistsAttribute))
+        if (!d->cache_enabled)
             QFileSystemEngine::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::ExistsAttribute);
+        else if (!d->metaData.hasFlags(QFileSystemMetaData::ExistsAttribute))
+            QFileSystemMetaDataCache::fillMetaData(d->fileEntry, d->metaData, QFileSystemMetaData::ExistsAttribute);
         return d->metaData.exists();
     }
     return d->getFileFlags(QAbstractFileEngine::ExistsFlag);
@@ -711,7 +713,7 @@ bool QFileInfo::exists(const QString &file)
     if (engine)
         return QFileInfo(new QFileInfoPrivate(entry, data, engine)).exists();
 
-    QFileSystemEngine::fillMetaData(entry, data, QFileSystemMetaData::ExistsAttribute);
+    QFileSystemMetaDataCache::fillMetaData(entry, data, QFileSystemMetaData::ExistsAttribute);
     return data.exists();
 }
 
@@ -723,6 +725,7 @@ void QFileInfo::refresh()
 {
     Q_D(QFileInfo);
     d->clear();
+    QFileSystemMetaDataCache::invalidate(d->fileEntry);
 }
 
 /*!
@@ -1409,6 +1412,50 @@ void QFileInfo::setCaching(bool enable)
     d->cache_enabled = enable;
 }
 
+/*!
+    \since 5.11
+
+    Returns \c true if the file information is shared through a
+    process-wide cache; otherwise returns \c false.
+
+    \sa setSharedCaching()
+*/
+bool QFileInfo::sharedCaching()
+{
+    return QFileSystemMetaDataCache::isEnabled();
+}
+
+/*!
+    \since 5.11
+
+    If \a enable is true, makes QFileInfo objects share the information they
+    read from the file system through a process-wide cache, so that asking
+    several objects about the same file queries the file system only once.
+    If \a enable is false, the cache is discarded.
+
+    This is useful for applications that repeatedly look at the same files,
+    like file browsers. The cache is kept up to date using a
+    QFileSystemWatcher, which delivers its notifications through the event
+    loop of the main thread; until they have been processed, changes made by
+    other processes may not be visible. Changes made through Qt's file API,
+    for example by QFile::remove() or by closing a QFile that was written to,
+    are seen at once. Since the number of watched paths is limited, the
+    cache is emptied whenever it grows too large.
+
+    Only files with absolute paths are cached, and only the main thread adds
+    entries, while all threads can use them. QFileInfo objects with caching()
+    disabled bypass the shared cache, and refresh() drops the file from it.
+
+    Shared caching is disabled by default. This function must be called from
+    the main thread, after the QCoreApplication object has been created.
+
+    \sa sharedCaching(), setCaching(), refresh()
+*/
+void QFileInfo::setSharedCaching(bool enable)
+{
+    QFileSystemMetaDataCache::setEnabled(enable);
+}
+
 /*!
     \typedef QFileInfoList
     \relates QFileInfo
@@ -143,6 +143,9 @@ public:
     bool caching() const;
     void setCaching(bool on);
 
+    static bool sharedCaching();
+    static void setSharedCaching(bool enable);
+
 protected:
     QSharedDataPointer<QFileInfoPrivate> d_ptr;
 
@@ -60,6 +60,7 @@
 #include <QtCore/private/qabstractfileengine_p.h>
 #include <QtCore/private/qfilesystementry_p.h>
 #include <QtCore/private/qfilesystemmetadata_p.h>
+#include <QtCore/private/qfilesystemmetadatacache_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -187,8 +188,10 @@ public:
             return defaultValue;
         if (fileEngine)
             return engineLambda();
-        if (!cache_enabled || !metaData.hasFlags(fsFlags)) {
+        if (!cache_enabled) {
             QFileSystemEngine::fillMetaData(fileEntry, metaData, fsFlags);
+        } else if (!metaData.hasFlags(fsFlags)) {
+            QFileSystemMetaDataCache::fillMetaData(fileEntry, metaData, fsFlags);
             // ignore errors, fillMetaData will have cleared the flags
         }
         return fsLambda();
@@ -41,6 +41,7 @@
 
 #include "qplatformdefs.h"
 #include "qfilesystemengine_p.h"
+#include "qfilesystemmetadatacache_p.h"
 #include "qfile.h"
 
 #include <QtCore/qoperatingsystemversion.h>
@@ -1199,6 +1200,7 @@ static bool createDirectoryWithParents(const QByteArray &nativeName, bool should
 //static
 bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool createParents)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     QString dirName = entry.filePath();
     if (Q_UNLIKELY(dirName.isEmpty()))
         return emptyFileEntryWarning(), false;
@@ -1220,6 +1222,7 @@ bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool crea
 //static
 bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool removeEmptyParents)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     if (Q_UNLIKELY(entry.isEmpty()))
         return emptyFileEntryWarning(), false;
 
@@ -1246,6 +1249,7 @@ bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool remo
 //static
 bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(target);
     if (Q_UNLIKELY(source.isEmpty() || target.isEmpty()))
         return emptyFileEntryWarning(), false;
     if (::symlink(source.nativeFilePath().constData(), target.nativeFilePath().constData()) == 0)
@@ -1257,6 +1261,7 @@ bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSy
 //static
 bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(target);
 #if QT_DARWIN_PLATFORM_SDK_EQUAL_OR_ABOVE(101200, 100000, 100000, 30000)
     if (__builtin_available(macOS 10.12, iOS 10, tvOS 10, watchOS 3, *)) {
         if (::clonefile(source.nativeFilePath().constData(),
@@ -1276,6 +1281,8 @@ bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSyst
 //static
 bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator sourceInvalidator(source);
+    const QFileSystemMetaDataCache::Invalidator targetInvalidator(target);
     QFileSystemEntry::NativePath srcPath = source.nativeFilePath();
     QFileSystemEntry::NativePath tgtPath = target.nativeFilePath();
     if (Q_UNLIKELY(srcPath.isEmpty() || tgtPath.isEmpty()))
@@ -1351,6 +1358,8 @@ bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSy
 //static
 bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator sourceInvalidator(source);
+    const QFileSystemMetaDataCache::Invalidator targetInvalidator(target);
     if (Q_UNLIKELY(source.isEmpty() || target.isEmpty()))
         return emptyFileEntryWarning(), false;
     if (::rename(source.nativeFilePath().constData(), target.nativeFilePath().constData()) == 0)
@@ -1362,6 +1371,7 @@ bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, cons
 //static
 bool QFileSystemEngine::removeFile(const QFileSystemEntry &entry, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     if (Q_UNLIKELY(entry.isEmpty()))
         return emptyFileEntryWarning(), false;
     if (unlink(entry.nativeFilePath().constData()) == 0)
@@ -1398,6 +1408,7 @@ static mode_t toMode_t(QFile::Permissions permissions)
 //static
 bool QFileSystemEngine::setPermissions(const QFileSystemEntry &entry, QFile::Permissions permissions, QSystemError &error, QFileSystemMetaData *data)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     if (Q_UNLIKELY(entry.isEmpty()))
         return emptyFileEntryWarning(), false;
 
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qfilesystemengine_p.h"
+#include "qfilesystemmetadatacache_p.h"
 #include "qoperatingsystemversion.h"
 #include "qplatformdefs.h"
 #include "qsysinfo.h"
@@ -1098,6 +1099,7 @@ static bool isDirPath(const QString &dirPath, bool *existed)
 //static
 bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool createParents)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     QString dirName = entry.filePath();
     if (createParents) {
         dirName = QDir::toNativeSeparators(QDir::cleanPath(dirName));
@@ -1159,6 +1161,7 @@ bool QFileSystemEngine::createDirectory(const QFileSystemEntry &entry, bool crea
 //static
 bool QFileSystemEngine::removeDirectory(const QFileSystemEntry &entry, bool removeEmptyParents)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     QString dirName = entry.filePath();
     if (removeEmptyParents) {
         dirName = QDir::toNativeSeparators(QDir::cleanPath(dirName));
@@ -1334,6 +1337,7 @@ QFileSystemEntry QFileSystemEngine::currentPath()
 //static
 bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(target);
     Q_ASSERT(false);
     Q_UNUSED(source)
     Q_UNUSED(target)
@@ -1345,6 +1349,7 @@ bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSy
 //static
 bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(target);
 #ifndef Q_OS_WINRT
     bool ret = ::CopyFile((wchar_t*)source.nativeFilePath().utf16(),
                           (wchar_t*)target.nativeFilePath().utf16(), true) != 0;
@@ -1364,6 +1369,8 @@ bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSyst
 //static
 bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator sourceInvalidator(source);
+    const QFileSystemMetaDataCache::Invalidator targetInvalidator(target);
 #ifndef Q_OS_WINRT
     bool ret = ::MoveFile((wchar_t*)source.nativeFilePath().utf16(),
                           (wchar_t*)target.nativeFilePath().utf16()) != 0;
@@ -1379,6 +1386,8 @@ bool QFileSystemEngine::renameFile(const QFileSystemEntry &source, const QFileSy
 //static
 bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator sourceInvalidator(source);
+    const QFileSystemMetaDataCache::Invalidator targetInvalidator(target);
     bool ret = ::MoveFileEx(reinterpret_cast<const wchar_t *>(source.nativeFilePath().utf16()),
                             reinterpret_cast<const wchar_t *>(target.nativeFilePath().utf16()),
                             MOVEFILE_REPLACE_EXISTING) != 0;
@@ -1390,6 +1399,7 @@ bool QFileSystemEngine::renameOverwriteFile(const QFileSystemEntry &source, cons
 //static
 bool QFileSystemEngine::removeFile(const QFileSystemEntry &entry, QSystemError &error)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     bool ret = ::DeleteFile((wchar_t*)entry.nativeFilePath().utf16()) != 0;
     if(!ret)
         error = QSystemError(::GetLastError(), QSystemError::NativeError);
@@ -1400,6 +1410,7 @@ bool QFileSystemEngine::removeFile(const QFileSystemEntry &entry, QSystemError &
 bool QFileSystemEngine::setPermissions(const QFileSystemEntry &entry, QFile::Permissions permissions, QSystemError &error,
                                        QFileSystemMetaData *data)
 {
+    const QFileSystemMetaDataCache::Invalidator invalidator(entry);
     Q_UNUSED(data);
     int mode = 0;
 
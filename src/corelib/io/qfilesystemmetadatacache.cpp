@@ -0,0 +1,240 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qfilesystemmetadatacache_p.h"
+
+#ifdef QT_FILESYSTEM_METADATA_CACHE
+
+#include "qcoreapplication.h"
+#include "qfilesystemwatcher.h"
+#include "qhash.h"
+#include "qmutex.h"
+#include "qpointer.h"
+#include "qset.h"
+#include "qthread.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// Every cached entry needs the entry itself and its parent directory to be
+// watched; this keeps the number of watches well below common system limits.
+const int MaxWatchedPaths = 4096;
+
+struct MetaDataCache
+{
+    MetaDataCache() : generation(0), updatingWatches(false) {}
+
+    bool watch(const QString &path);
+    void clear();
+    void invalidate(const QString &path);
+
+    QMutex mutex;
+    QHash<QString, QFileSystemMetaData> entries;
+    // Increased by every invalidation, so that a query that ran concurrently
+    // with one does not store its now possibly stale result
+    quint64 generation;
+    QPointer<QFileSystemWatcher> watcher;
+
+    // Only used in the watcher's thread
+    QSet<QString> watchedPaths;
+    bool updatingWatches;
+};
+
+bool MetaDataCache::watch(const QString &path)
+{
+    if (watchedPaths.contains(path))
+        return true;
+    // adding a path queries its metadata, which must not come from the cache
+    updatingWatches = true;
+    const bool added = watcher->addPath(path);
+    updatingWatches = false;
+    if (added)
+        watchedPaths.insert(path);
+    return added;
+}
+
+void MetaDataCache::clear()
+{
+    {
+        QMutexLocker locker(&mutex);
+        entries.clear();
+        ++generation;
+    }
+    if (watcher && !watchedPaths.isEmpty())
+        watcher->removePaths(watchedPaths.toList());
+    watchedPaths.clear();
+}
+
+// Drops \a path and the entries of the directory of that name
+void MetaDataCache::invalidate(const QString &path)
+{
+    QMutexLocker locker(&mutex);
+    ++generation;
+    entries.remove(path);
+    for (auto it = entries.begin(); it != entries.end(); ) {
+        const QString &key = it.key();
+        if (key.size() > path.size() && key.startsWith(path)
+                && key.at(path.size()) == QLatin1Char('/')
+                && key.indexOf(QLatin1Char('/'), path.size() + 1) == -1) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+}
+
+Q_GLOBAL_STATIC(MetaDataCache, metaDataCache)
+
+QBasicAtomicInt QFileSystemMetaDataCache::enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*!
+    \internal
+
+    Turns the process-wide cache on or off, returning \c true if it is in the
+    requested state afterwards. The cache is watched from the main thread,
+    and can only be turned on from it.
+*/
+bool QFileSystemMetaDataCache::setEnabled(bool enable)
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() != app->thread()) {
+        qWarning("QFileInfo::setSharedCaching: Must be called from the main thread"
+                 " after QCoreApplication has been created");
+        return isEnabled() == enable;
+    }
+
+    MetaDataCache *cache = metaDataCache();
+    if (!enable) {
+        enabled.store(0);
+        cache->clear();
+        delete cache->watcher.data();
+        return true;
+    }
+    if (isEnabled() && cache->watcher)
+        return true;
+
+    // The application owns the watcher, so that it does not outlive the
+    // event dispatcher; once it is gone, nothing will be cached anymore.
+    QFileSystemWatcher *watcher = new QFileSystemWatcher(app);
+    auto changed = [cache](const QString &path) {
+        cache->invalidate(path);
+        // removed paths are no longer watched, so forget about all of them
+        cache->watchedPaths.remove(path);
+        cache->watcher->removePath(path);
+    };
+    QObject::connect(watcher, &QFileSystemWatcher::fileChanged, watcher, changed);
+    QObject::connect(watcher, &QFileSystemWatcher::directoryChanged, watcher, changed);
+    QObject::connect(watcher, &QObject::destroyed, [cache]() {
+        enabled.store(0);
+        QMutexLocker locker(&cache->mutex);
+        cache->entries.clear();
+        cache->watchedPaths.clear();
+    });
+    cache->watcher = watcher;
+    enabled.store(1);
+    return true;
+}
+
+bool QFileSystemMetaDataCache::fillMetaDataCached(const QFileSystemEntry &entry,
+                                                  QFileSystemMetaData &data,
+                                                  QFileSystemMetaData::MetaDataFlags what)
+{
+    if (!entry.isAbsolute())
+        return QFileSystemEngine::fillMetaData(entry, data, what);
+
+    MetaDataCache *cache = metaDataCache();
+    const QString path = entry.filePath();
+    QFileSystemMetaData metaData = data;
+    quint64 generation;
+    bool canStore;
+    {
+        QMutexLocker locker(&cache->mutex);
+        const auto it = cache->entries.constFind(path);
+        if (it != cache->entries.constEnd()) {
+            // failed queries clear the flags, so these are known to be valid
+            if (it->hasFlags(what)) {
+                data = *it;
+                return true;
+            }
+            metaData = *it;
+        }
+        generation = cache->generation;
+
+        // Only the watcher's thread can add watches, which must be in place
+        // before the file is queried.
+        QFileSystemWatcher *watcher = cache->watcher.data();
+        canStore = watcher && watcher->thread() == QThread::currentThread()
+                && !cache->updatingWatches;
+    }
+
+    bool result = QFileSystemEngine::fillMetaData(entry, metaData, what);
+    // Missing entries cannot be watched and are not cached. Otherwise the
+    // entry is queried again once its watches are in place, so that changes
+    // made in the meantime are not missed.
+    if (canStore && result && metaData.exists()) {
+        if (cache->watchedPaths.size() + 2 > MaxWatchedPaths)
+            cache->clear();
+        const QString parent = entry.path();
+        canStore = parent != path && cache->watch(parent) && cache->watch(path);
+        if (canStore)
+            result = QFileSystemEngine::fillMetaData(entry, metaData, what);
+    } else {
+        canStore = false;
+    }
+
+    data = metaData;
+    if (canStore && result) {
+        QMutexLocker locker(&cache->mutex);
+        if (cache->generation == generation)
+            cache->entries.insert(path, metaData);
+    }
+    return result;
+}
+
+void QFileSystemMetaDataCache::invalidateEntry(const QFileSystemEntry &entry)
+{
+    const QFileSystemEntry absolute = entry.isAbsolute()
+            ? entry : QFileSystemEngine::absoluteName(entry);
+    metaDataCache()->invalidate(absolute.filePath());
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_FILESYSTEM_METADATA_CACHE
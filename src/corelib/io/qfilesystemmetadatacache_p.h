@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFILESYSTEMMETADATACACHE_P_H
+#define QFILESYSTEMMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qfilesystemengine_p.h"
+
+#include <QtCore/qatomic.h>
+
+#if !defined(QT_BOOTSTRAPPED) && !defined(QT_NO_FILESYSTEMWATCHER)
+#  define QT_FILESYSTEM_METADATA_CACHE
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QFileSystemMetaDataCache
+{
+public:
+#ifdef QT_FILESYSTEM_METADATA_CACHE
+    static bool isEnabled() { return enabled.load() != 0; }
+    static bool setEnabled(bool enable);
+
+    static bool fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                             QFileSystemMetaData::MetaDataFlags what)
+    {
+        if (!isEnabled())
+            return QFileSystemEngine::fillMetaData(entry, data, what);
+        return fillMetaDataCached(entry, data, what);
+    }
+
+    static void invalidate(const QFileSystemEntry &entry)
+    {
+        if (isEnabled())
+            invalidateEntry(entry);
+    }
+#else
+    static bool isEnabled() { return false; }
+    static bool setEnabled(bool) { return false; }
+
+    static bool fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                             QFileSystemMetaData::MetaDataFlags what)
+    { return QFileSystemEngine::fillMetaData(entry, data, what); }
+
+    static void invalidate(const QFileSystemEntry &) {}
+#endif
+
+    // Invalidates an entry when going out of scope, that is, after the
+    // operation that changes it has completed
+    class Invalidator
+    {
+    public:
+        explicit Invalidator(const QFileSystemEntry &entry) : entry(entry) {}
+        ~Invalidator() { invalidate(entry); }
+
+    private:
+        Q_DISABLE_COPY(Invalidator)
+        const QFileSystemEntry &entry;
+    };
+
+private:
+#ifdef QT_FILESYSTEM_METADATA_CACHE
+    static bool fillMetaDataCached(const QFileSystemEntry &entry, QFileSystemMetaData &data,
+                                   QFileSystemMetaData::MetaDataFlags what);
+    static void invalidateEntry(const QFileSystemEntry &entry);
+
+    static QBasicAtomicInt enabled;
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QFILESYSTEMMETADATACACHE_P_H
@@ -47,10 +47,12 @@
 
 #include <qdebug.h>
 #include <qfile.h>
-#include <qfileinfo.h>
+#include <qset.h>
 #include <qsocketnotifier.h>
 #include <qvarlengtharray.h>
 
+#include <algorithm>
+
 #if defined(Q_OS_LINUX)
 #include <sys/syscall.h>
 #include <sys/ioctl.h>
@@ -209,6 +211,7 @@ struct inotify_event {
 #define IN_UNMOUNT              0x00002000
 #define IN_Q_OVERFLOW           0x00004000
 #define IN_IGNORED              0x00008000
+#define IN_ONLYDIR              0x01000000
 
 #define IN_CLOSE                (IN_CLOSE_WRITE | IN_CLOSE_NOWRITE)
 #define IN_MOVE                 (IN_MOVED_FROM | IN_MOVED_TO)
@@ -266,6 +269,9 @@ QInotifyFileSystemWatcherEngine::~QInotifyFileSystemWatcherEngine()
     ::close(inotifyFd);
 }
 
+static const uint DirectoryWatchMask = IN_ATTRIB | IN_MOVE | IN_CREATE | IN_DELETE | IN_DELETE_SELF;
+static const uint FileWatchMask = IN_ATTRIB | IN_MODIFY | IN_MOVE | IN_MOVE_SELF | IN_DELETE_SELF;
+
 QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
                                                       QStringList *files,
                                                       QStringList *directories)
@@ -274,33 +280,20 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
     QMutableListIterator<QString> it(p);
     while (it.hasNext()) {
         QString path = it.next();
-        QFileInfo fi(path);
-        bool isDir = fi.isDir();
-        if (isDir) {
-            if (directories->contains(path))
-                continue;
-        } else {
-            if (files->contains(path))
-                continue;
-        }
+        // files and directories are lists; looking them up would make adding
+        // many paths quadratic
+        if (pathToID.contains(path))
+            continue;
 
-        int wd = inotify_add_watch(inotifyFd,
-                                   QFile::encodeName(path),
-                                   (isDir
-                                    ? (0
-                                       | IN_ATTRIB
-                                       | IN_MOVE
-                                       | IN_CREATE
-                                       | IN_DELETE
-                                       | IN_DELETE_SELF
-                                       )
-                                    : (0
-                                       | IN_ATTRIB
-                                       | IN_MODIFY
-                                       | IN_MOVE
-                                       | IN_MOVE_SELF
-                                       | IN_DELETE_SELF
-                                       )));
+        // Trying to watch the path as a directory first tells whether it is
+        // one without a separate stat(); for other files, it fails with ENOTDIR.
+        const QByteArray nativePath = QFile::encodeName(path);
+        bool isDir = true;
+        int wd = inotify_add_watch(inotifyFd, nativePath, DirectoryWatchMask | IN_ONLYDIR);
+        if (wd < 0 && errno == ENOTDIR) {
+            isDir = false;
+            wd = inotify_add_watch(inotifyFd, nativePath, FileWatchMask);
+        }
         if (wd < 0) {
             qWarning().nospace() << "inotify_add_watch(" << path << ") failed: " << QSystemError(errno, QSystemError::NativeError).toString();
             continue;
@@ -327,6 +320,7 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
                                                          QStringList *directories)
 {
     QStringList p = paths;
+    QSet<QString> removedFiles, removedDirectories;
     QMutableListIterator<QString> it(p);
     while (it.hasNext()) {
         QString path = it.next();
@@ -341,12 +335,23 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
 
         it.remove();
         if (id < 0) {
-            directories->removeAll(path);
+            removedDirectories.insert(path);
         } else {
-            files->removeAll(path);
+            removedFiles.insert(path);
         }
     }
 
+    // update the lists in one pass each
+    const auto removeFrom = [](QStringList *list, const QSet<QString> &removed) {
+        if (!removed.isEmpty()) {
+            list->erase(std::remove_if(list->begin(), list->end(),
+                                       [&removed](const QString &path) { return removed.contains(path); }),
+                        list->end());
+        }
+    };
+    removeFrom(files, removedFiles);
+    removeFrom(directories, removedDirectories);
+
     return p;
 }
 
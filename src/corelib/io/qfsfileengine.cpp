@@ -41,6 +41,7 @@
 #include "qfsfileengine_p.h"
 #include "qfsfileengine_iterator_p.h"
 #include "qfilesystemengine_p.h"
+#include "qfilesystemmetadatacache_p.h"
 #include "qdatetime.h"
 #include "qdiriterator.h"
 #include "qset.h"
@@ -219,6 +220,10 @@ bool QFSFileEngine::open(QIODevice::OpenMode openMode)
     d->fh = 0;
     d->fd = -1;
 
+    if (!(openMode & QFile::WriteOnly))
+        return d->nativeOpen(openMode);
+    // opening for writing may create or truncate the file
+    const QFileSystemMetaDataCache::Invalidator invalidator(d->fileEntry);
     return d->nativeOpen(openMode);
 }
 
@@ -359,6 +364,11 @@ bool QFSFileEnginePrivate::openFd(QIODevice::OpenMode openMode, int fd)
 bool QFSFileEngine::close()
 {
     Q_D(QFSFileEngine);
+    if (!(d->openMode & QIODevice::WriteOnly)) {
+        d->openMode = QIODevice::NotOpen;
+        return d->nativeClose();
+    }
+    const QFileSystemMetaDataCache::Invalidator invalidator(d->fileEntry);
     d->openMode = QIODevice::NotOpen;
     return d->nativeClose();
 }
@@ -43,6 +43,7 @@
 #include "private/qcore_unix_p.h"
 #include "qfilesystementry_p.h"
 #include "qfilesystemengine_p.h"
+#include "qfilesystemmetadatacache_p.h"
 #include "qcoreapplication.h"
 
 #ifndef QT_NO_FSFILEENGINE
@@ -580,6 +581,7 @@ QString QFSFileEngine::owner(FileOwner own) const
 bool QFSFileEngine::setPermissions(uint perms)
 {
     Q_D(QFSFileEngine);
+    const QFileSystemMetaDataCache::Invalidator invalidator(d->fileEntry);
     QSystemError error;
     bool ok;
     if (d->fd != -1)
@@ -596,6 +598,7 @@ bool QFSFileEngine::setPermissions(uint perms)
 bool QFSFileEngine::setSize(qint64 size)
 {
     Q_D(QFSFileEngine);
+    const QFileSystemMetaDataCache::Invalidator invalidator(d->fileEntry);
     bool ret = false;
     if (d->fd != -1)
         ret = QT_FTRUNCATE(d->fd, size) == 0;
@@ -611,6 +614,7 @@ bool QFSFileEngine::setSize(qint64 size)
 bool QFSFileEngine::setFileTime(const QDateTime &newDate, FileTime time)
 {
     Q_D(QFSFileEngine);
+    const QFileSystemMetaDataCache::Invalidator invalidator(d->fileEntry);
 
     if (d->openMode == QIODevice::NotOpen) {
         setError(QFile::PermissionsError, qt_error_string(EACCES));
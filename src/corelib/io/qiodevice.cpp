@@ -1960,6 +1960,154 @@ qint64 QIODevice::skip(qint64 maxSize)
     return skippedSoFar + skipResult;
 }
 
+/*!
+    \since 5.11
+
+    Returns at most \a maxSize bytes from the device without consuming them
+    and, where possible, without copying them. Like peek(), this function
+    has no side effects on the data that read() returns next.
+
+    If the device's contents are accessible in memory, which is the case for
+    a QFile opened in ReadOnly mode, the result references that memory
+    directly. Otherwise any data in the internal buffer is returned, after
+    filling the buffer with one read from the device if it was empty. In
+    both cases the result may be shorter than \a maxSize even if more data
+    is available, since only contiguous bytes can be returned. Devices opened
+    in Text or Unbuffered mode, and sequential devices in a transaction,
+    fall back to peek(), which copies.
+
+    The returned array does not own its data: it is valid only until the
+    next non-const function call on the device. Use readSpan() to consume
+    data without copying.
+
+    \sa readSpan(), peek(), skip()
+*/
+QByteArray QIODevice::peekSpan(qint64 maxSize)
+{
+    Q_D(QIODevice);
+    CHECK_MAXLEN(peekSpan, QByteArray());
+    CHECK_MAXBYTEARRAYSIZE(peekSpan);
+    CHECK_READABLE(peekSpan, QByteArray());
+
+    qint64 length;
+    bool mapped;
+    const char *data = d->spanPointer(&length, &mapped);
+    if (!data)
+        return peek(maxSize);
+    return QByteArray::fromRawData(data, int(qMin(maxSize, length)));
+}
+
+/*!
+    \since 5.11
+
+    Reads at most \a maxSize bytes from the device, avoiding the copies that
+    read() makes where possible, and returns them.
+
+    For a QFile opened in ReadOnly mode, the file is mapped into memory the
+    first time this function or peekSpan() is called, and the result
+    references the mapping; it remains valid until the file is closed. As with
+    QFileDevice::map(), the contents of the result change if the file is
+    modified on disk, and accessing them after the file has been truncated
+    can crash on some platforms. For other devices, when \a maxSize covers a
+    whole block of the internal buffer, that block is handed over instead of
+    being copied, and the result owns its data like the one from read().
+
+    The result may be shorter than \a maxSize even if more data is
+    available. An empty result means that no data was available or that an
+    error occurred.
+
+    \sa peekSpan(), read()
+*/
+QByteArray QIODevice::readSpan(qint64 maxSize)
+{
+    Q_D(QIODevice);
+    CHECK_MAXLEN(readSpan, QByteArray());
+    CHECK_MAXBYTEARRAYSIZE(readSpan);
+    CHECK_READABLE(readSpan, QByteArray());
+
+    qint64 length;
+    bool mapped;
+    const char *data = d->spanPointer(&length, &mapped);
+    if (!data)
+        return read(maxSize);
+
+    if (mapped) {
+        const int size = int(qMin(maxSize, length));
+        d->pos += size;
+        return QByteArray::fromRawData(data, size);
+    }
+    if (length > maxSize)
+        return read(maxSize);
+
+    const QByteArray result = d->buffer.read();
+    if (!d->isSequential())
+        d->pos += result.size();
+    if (d->buffer.isEmpty())
+        readData(nullptr, 0);
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns a pointer to the data at the current position and stores the
+    number of contiguous bytes there in \a length, or returns null if no such
+    view can be provided. The data comes from mappedData() if \a mapped is set
+    to true, or else from the read buffer, which is filled by one readData()
+    call if it was empty.
+*/
+const char *QIODevicePrivate::spanPointer(qint64 *length, bool *mapped)
+{
+    Q_Q(QIODevice);
+    *length = 0;
+    *mapped = false;
+    const bool sequential = isSequential();
+    if ((openMode & QIODevice::Text) || (sequential && transactionStarted))
+        return nullptr;
+
+    if (!sequential) {
+        qint64 mappedSize;
+        const char *data = mappedData(&mappedSize);
+        if (data && pos < mappedSize) {
+            // the buffer holds a copy of what the mapping shows
+            buffer.clear();
+            *length = mappedSize - pos;
+            *mapped = true;
+            return data + pos;
+        }
+    }
+
+    if (buffer.isEmpty()) {
+        if ((openMode & QIODevice::Unbuffered) || readBufferChunkSize <= 0)
+            return nullptr;
+        if (!sequential && pos != devicePos && !q->seek(pos))
+            return nullptr;
+        const qint64 chunkSize = readBufferChunkSize;
+        const qint64 readFromDevice = q->readData(buffer.reserve(chunkSize), chunkSize);
+        buffer.chop(chunkSize - qMax(Q_INT64_C(0), readFromDevice));
+        if (readFromDevice <= 0)
+            return nullptr;
+        if (!sequential)
+            devicePos += readFromDevice;
+    }
+
+    *length = buffer.nextDataBlockSize();
+    return buffer.readPointer();
+}
+
+/*!
+    \internal
+
+    Returns the whole contents of a random-access device if they are
+    accessible in memory, storing their size in \a size, or null otherwise.
+    The base implementation returns null.
+*/
+const char *QIODevicePrivate::mappedData(qint64 *size)
+{
+    *size = 0;
+    return nullptr;
+}
+
 /*!
     \internal
 */
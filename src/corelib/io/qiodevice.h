@@ -137,6 +137,8 @@ public:
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
     qint64 skip(qint64 maxSize);
+    QByteArray peekSpan(qint64 maxSize);
+    QByteArray readSpan(qint64 maxSize);
 
     virtual bool waitForReadyRead(int msecs);
     virtual bool waitForBytesWritten(int msecs);
@@ -177,6 +177,8 @@ public:
     qint64 skipByReading(qint64 maxSize);
     // ### Qt6: consider replacing with a protected virtual QIODevice::skipData().
     virtual qint64 skip(qint64 maxSize);
+    const char *spanPointer(qint64 *length, bool *mapped);
+    virtual const char *mappedData(qint64 *size);
 
 #ifdef QT_NO_QOBJECT
     QIODevice *q_ptr;
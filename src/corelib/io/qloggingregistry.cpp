@@ -331,6 +331,7 @@ void QLoggingRegistry::initializeRules()
     ruleSets[EnvironmentRules] = std::move(er);
     ruleSets[QtConfigRules] = std::move(qr);
     ruleSets[ConfigRules] = std::move(cr);
+    ruleResults.clear();
 
     if (!ruleSets[EnvironmentRules].isEmpty() || !ruleSets[QtConfigRules].isEmpty() || !ruleSets[ConfigRules].isEmpty())
         updateRules();
@@ -390,6 +391,7 @@ void QLoggingRegistry::setApiRules(const QString &content)
 */
 void QLoggingRegistry::updateRules()
 {
+    ruleResults.clear();
     for (auto it = categories.keyBegin(), end = categories.keyEnd(); it != end; ++it)
         (*categoryFilter)(*it);
 }
@@ -425,9 +427,36 @@ QLoggingRegistry *QLoggingRegistry::instance()
 
     As a category filter, it is run with registryMutex held.
 */
+QLoggingRegistry::RuleResult QLoggingRegistry::evaluateRules(const QString &categoryName) const
+{
+    const uint allTypes = (1 << QtDebugMsg) | (1 << QtInfoMsg)
+            | (1 << QtWarningMsg) | (1 << QtCriticalMsg);
+
+    RuleResult result = { 0, 0 };
+    for (const auto &ruleSet : ruleSets) {
+        for (const auto &rule : ruleSet) {
+            // a rule without a message type matches all of them alike, so
+            // it only needs to be checked once
+            const bool allTypesRule = rule.messageType < 0;
+            const int filterpass = rule.pass(categoryName, allTypesRule
+                                             ? QtDebugMsg : QtMsgType(rule.messageType));
+            if (filterpass == 0)
+                continue;
+
+            const uint types = allTypesRule ? allTypes : (1U << rule.messageType);
+            result.matched |= types;
+            if (filterpass > 0)
+                result.enabled |= types;
+            else
+                result.enabled &= ~types;
+        }
+    }
+    return result;
+}
+
 void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
 {
-    const QLoggingRegistry *reg = QLoggingRegistry::instance();
+    QLoggingRegistry *reg = QLoggingRegistry::instance();
     Q_ASSERT(reg->categories.contains(cat));
     QtMsgType enableForLevel = reg->categories.value(cat);
 
@@ -447,24 +476,21 @@ void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
             debug = false;
     }
 
-    QString categoryName = QLatin1String(cat->categoryName());
-
-    for (const auto &ruleSet : reg->ruleSets) {
-        for (const auto &rule : ruleSet) {
-            int filterpass = rule.pass(categoryName, QtDebugMsg);
-            if (filterpass != 0)
-                debug = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtInfoMsg);
-            if (filterpass != 0)
-                info = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtWarningMsg);
-            if (filterpass != 0)
-                warning = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtCriticalMsg);
-            if (filterpass != 0)
-                critical = (filterpass > 0);
-        }
-    }
+    // many category objects can share a name, e.g. ones created on the stack
+    const QString categoryName = QLatin1String(cat->categoryName());
+    auto it = reg->ruleResults.constFind(categoryName);
+    if (it == reg->ruleResults.constEnd())
+        it = reg->ruleResults.insert(categoryName, reg->evaluateRules(categoryName));
+    const RuleResult result = *it;
+
+    const auto applyRules = [&result](QtMsgType type, bool *enabled) {
+        if (result.matched & (1U << type))
+            *enabled = result.enabled & (1U << type);
+    };
+    applyRules(QtDebugMsg, &debug);
+    applyRules(QtInfoMsg, &info);
+    applyRules(QtWarningMsg, &warning);
+    applyRules(QtCriticalMsg, &critical);
 
     cat->setEnabled(QtDebugMsg, debug);
     cat->setEnabled(QtInfoMsg, info);
@@ -52,6 +52,7 @@
 //
 
 #include <QtCore/private/qglobal_p.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qmutex.h>
@@ -128,6 +129,15 @@ public:
 private:
     void updateRules();
 
+    // What the rules say about one category name: for each message type
+    // (bit 1 << type), whether any rule matched and whether the last
+    // matching rule enabled it.
+    struct RuleResult {
+        uint matched;
+        uint enabled;
+    };
+    RuleResult evaluateRules(const QString &categoryName) const;
+
     static void defaultCategoryFilter(QLoggingCategory *category);
 
     enum RuleSet {
@@ -146,6 +156,8 @@ private:
     QVector<QLoggingRule> ruleSets[NumRuleSets];
     QHash<QLoggingCategory*,QtMsgType> categories;
     QLoggingCategory::CategoryFilter categoryFilter;
+    // the rules evaluated per category name, until the rules change
+    QHash<QString, RuleResult> ruleResults;
 
     friend class ::tst_QLoggingRegistry;
 };
@@ -405,6 +405,64 @@ qint64 QNonContiguousByteDeviceIoDeviceImpl::pos() const
     return device->pos();
 }
 
+QNonContiguousByteDevicePrefixedIoDeviceImpl::QNonContiguousByteDevicePrefixedIoDeviceImpl(QSharedPointer<QRingBuffer> rb, QIODevice *d)
+    : QNonContiguousByteDevice(), prefix(qMove(rb)), remainder(d), remainderPosition(0)
+{
+    connect(&remainder, SIGNAL(readyRead()), this, SIGNAL(readyRead()));
+}
+
+QNonContiguousByteDevicePrefixedIoDeviceImpl::~QNonContiguousByteDevicePrefixedIoDeviceImpl()
+{
+}
+
+const char* QNonContiguousByteDevicePrefixedIoDeviceImpl::readPointer(qint64 maximumLength, qint64 &len)
+{
+    // the prefix hands out contiguous pieces, so an advancement never
+    // spans both parts
+    if (!prefix.atEnd())
+        return prefix.readPointer(maximumLength, len);
+    return remainder.readPointer(maximumLength, len);
+}
+
+bool QNonContiguousByteDevicePrefixedIoDeviceImpl::advanceReadPointer(qint64 amount)
+{
+    bool advanced;
+    if (!prefix.atEnd()) {
+        advanced = prefix.advanceReadPointer(amount);
+    } else {
+        advanced = remainder.advanceReadPointer(amount);
+        if (advanced)
+            remainderPosition += amount;
+    }
+
+    // the size is unknown, see QNonContiguousByteDeviceIoDeviceImpl
+    emit readProgress(pos(), pos());
+    return advanced;
+}
+
+bool QNonContiguousByteDevicePrefixedIoDeviceImpl::atEnd() const
+{
+    return prefix.atEnd() && remainder.atEnd();
+}
+
+bool QNonContiguousByteDevicePrefixedIoDeviceImpl::reset()
+{
+    // the data taken from the device so far is gone
+    if (remainderPosition > 0)
+        return false;
+    return prefix.reset();
+}
+
+qint64 QNonContiguousByteDevicePrefixedIoDeviceImpl::size() const
+{
+    return -1;
+}
+
+qint64 QNonContiguousByteDevicePrefixedIoDeviceImpl::pos() const
+{
+    return prefix.pos() + remainderPosition;
+}
+
 QByteDeviceWrappingIoDevice::QByteDeviceWrappingIoDevice(QNonContiguousByteDevice *bd) : QIODevice((QObject*)0)
 {
     byteDevice = bd;
@@ -537,6 +595,19 @@ QSharedPointer<QNonContiguousByteDevice> QNonContiguousByteDeviceFactory::create
     return QSharedPointer<QNonContiguousByteDeviceRingBufferImpl>::create(qMove(ringBuffer));
 }
 
+/*!
+    Create a QNonContiguousByteDevice that returns the data in \a ringBuffer
+    followed by the rest of \a device, return it in a QSharedPointer.
+    Its size is unknown, and it can only be reset as long as no data
+    was taken from \a device.
+
+    \internal
+*/
+QSharedPointer<QNonContiguousByteDevice> QNonContiguousByteDeviceFactory::createShared(QSharedPointer<QRingBuffer> ringBuffer, QIODevice *device)
+{
+    return QSharedPointer<QNonContiguousByteDevicePrefixedIoDeviceImpl>::create(qMove(ringBuffer), device);
+}
+
 /*!
     \fn static QNonContiguousByteDevice* QNonContiguousByteDeviceFactory::create(QByteArray *byteArray)
 
@@ -94,6 +94,8 @@ public:
     static QNonContiguousByteDevice* create(QSharedPointer<QRingBuffer> ringBuffer);
     static QSharedPointer<QNonContiguousByteDevice> createShared(QSharedPointer<QRingBuffer> ringBuffer);
 
+    static QSharedPointer<QNonContiguousByteDevice> createShared(QSharedPointer<QRingBuffer> ringBuffer, QIODevice *device);
+
     static QIODevice* wrap(QNonContiguousByteDevice* byteDevice);
 };
 
@@ -156,6 +158,24 @@ protected:
     qint64 initialPosition;
 };
 
+class QNonContiguousByteDevicePrefixedIoDeviceImpl : public QNonContiguousByteDevice
+{
+    Q_OBJECT
+public:
+    QNonContiguousByteDevicePrefixedIoDeviceImpl(QSharedPointer<QRingBuffer> rb, QIODevice *d);
+    ~QNonContiguousByteDevicePrefixedIoDeviceImpl();
+    const char* readPointer(qint64 maximumLength, qint64 &len) Q_DECL_OVERRIDE;
+    bool advanceReadPointer(qint64 amount) Q_DECL_OVERRIDE;
+    bool atEnd() const Q_DECL_OVERRIDE;
+    bool reset() Q_DECL_OVERRIDE;
+    qint64 size() const Q_DECL_OVERRIDE;
+    qint64 pos() const Q_DECL_OVERRIDE;
+protected:
+    QNonContiguousByteDeviceRingBufferImpl prefix;
+    QNonContiguousByteDeviceIoDeviceImpl remainder;
+    qint64 remainderPosition;
+};
+
 class QNonContiguousByteDeviceBufferImpl : public QNonContiguousByteDevice
 {
     Q_OBJECT
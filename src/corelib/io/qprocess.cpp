@@ -864,6 +864,7 @@ QProcessPrivate::QProcessPrivate()
     writeBufferChunkSize = QRINGBUFFER_CHUNKSIZE;
     processChannelMode = QProcess::SeparateChannels;
     inputChannelMode = QProcess::ManagedInputChannel;
+    pipeBufferSize = 0;
     processError = QProcess::UnknownError;
     processState = QProcess::NotRunning;
     pid = 0;
@@ -1348,6 +1349,48 @@ void QProcess::setInputChannelMode(InputChannelMode mode)
     d->inputChannelMode = mode;
 }
 
+/*!
+    \since 5.11
+
+    Returns the size requested for the pipes that connect QProcess to the
+    standard channels of the child process, or 0 if the system default is
+    used.
+
+    \sa setPipeBufferSize()
+*/
+int QProcess::pipeBufferSize() const
+{
+    Q_D(const QProcess);
+    return d->pipeBufferSize;
+}
+
+/*!
+    \since 5.11
+
+    Requests that the pipes connecting QProcess to the standard channels of
+    the child process hold up to \a size bytes. A value of 0 (the default)
+    uses the system's default size.
+    This size will be used the next time start() is called.
+
+    A larger pipe lets a child that produces a lot of output write more data
+    before it has to wait for QProcess to read it, and lets QProcess read that
+    data in fewer, larger chunks. The size is only a hint: the operating system
+    may round it or ignore it, for example if it exceeds a system-wide limit.
+    On Linux, the default is 64 KiB and unprivileged processes can request up
+    to \c{/proc/sys/fs/pipe-max-size}. On Windows, QProcess uses 1 MiB by
+    default.
+
+    If the output only needs to be stored in a file, setStandardOutputFile()
+    avoids copying it through the calling process altogether.
+
+    \sa pipeBufferSize(), setStandardOutputFile()
+*/
+void QProcess::setPipeBufferSize(int size)
+{
+    Q_D(QProcess);
+    d->pipeBufferSize = qMax(size, 0);
+}
+
 /*!
     Returns the current read channel of the QProcess.
 
@@ -178,6 +178,8 @@ public:
     void setProcessChannelMode(ProcessChannelMode mode);
     InputChannelMode inputChannelMode() const;
     void setInputChannelMode(InputChannelMode mode);
+    int pipeBufferSize() const;
+    void setPipeBufferSize(int size);
 
     ProcessChannel readChannel() const;
     void setReadChannel(ProcessChannel channel);
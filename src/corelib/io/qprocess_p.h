@@ -308,6 +308,7 @@ public:
 
     QProcess::ProcessChannelMode processChannelMode;
     QProcess::InputChannelMode inputChannelMode;
+    int pipeBufferSize;
     QProcess::ProcessError processError;
     QProcess::ProcessState processState;
     QString workingDirectory;
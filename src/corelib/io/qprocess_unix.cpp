@@ -116,6 +116,15 @@ QT_END_NAMESPACE
 
 #if QT_CONFIG(process)
 #include <forkfd.h>
+
+// posix_spawn() starts the child without copying our page tables, which
+// fork() does; we only use it where it reports exec() failures (glibc 2.24)
+#  if defined(Q_OS_LINUX) && _POSIX_SPAWN > 0 && defined(__GLIBC__) \
+    && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 24))
+#    define QPROCESS_USE_SPAWN
+#    include <signal.h>
+#    include <typeinfo>
+#  endif
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -195,7 +204,7 @@ static bool qt_pollfd_check(const pollfd &pfd, short revents)
     return pfd.fd >= 0 && (pfd.revents & (revents | POLLHUP | POLLERR | POLLNVAL)) != 0;
 }
 
-static int qt_create_pipe(int *pipe)
+static int qt_create_pipe(int *pipe, int bufferSize = 0)
 {
     if (pipe[0] != -1)
         qt_safe_close(pipe[0]);
@@ -205,7 +214,15 @@ static int qt_create_pipe(int *pipe)
     if (pipe_ret != 0) {
         qWarning("QProcessPrivate::createPipe: Cannot create pipe %p: %s",
                  pipe, qPrintable(qt_error_string(errno)));
+        return pipe_ret;
     }
+#ifdef F_SETPIPE_SZ
+    // the size is only a hint; keep the default if the kernel refuses it
+    if (bufferSize > 0)
+        ::fcntl(pipe[1], F_SETPIPE_SZ, bufferSize);
+#else
+    Q_UNUSED(bufferSize);
+#endif
     return pipe_ret;
 }
 
@@ -243,7 +260,7 @@ bool QProcessPrivate::openChannel(Channel &channel)
 
     if (channel.type == Channel::Normal) {
         // we're piping this channel to our own process
-        if (qt_create_pipe(channel.pipe) != 0)
+        if (qt_create_pipe(channel.pipe, pipeBufferSize) != 0)
             return false;
 
         // create the socket notifiers
@@ -325,7 +342,7 @@ bool QProcessPrivate::openChannel(Channel &channel)
             Q_ASSERT(sink->pipe[0] == INVALID_Q_PIPE && sink->pipe[1] == INVALID_Q_PIPE);
 
             Q_PIPE pipe[2] = { -1, -1 };
-            if (qt_create_pipe(pipe) != 0)
+            if (qt_create_pipe(pipe, qMax(pipeBufferSize, channel.process->pipeBufferSize)) != 0)
                 return false;
             sink->pipe[0] = pipe[0];
             source->pipe[1] = pipe[1];
@@ -360,6 +377,72 @@ static char **_q_dupEnvironment(const QProcessEnvironmentPrivate::Map &environme
     return envp;
 }
 
+#ifdef QPROCESS_USE_SPAWN
+/*
+    Returns true if nothing needs to run in the child process between
+    forking and executing the program, so that the child can be started
+    with posix_spawn().
+*/
+static bool qt_can_spawn_child(const QProcess *q, const QString &workingDirectory)
+{
+    // posix_spawn() cannot change the working directory portably
+    if (!workingDirectory.isEmpty())
+        return false;
+
+    // a subclass may have overridden setupChildProcess()
+#if defined(__GXX_RTTI) || defined(__cpp_rtti)
+    return typeid(*q) == typeid(QProcess);
+#else
+    Q_UNUSED(q);
+    return false;
+#endif
+}
+
+/*
+    Starts the child process with posix_spawn(), setting it up like
+    QProcessPrivate::execChild() does. Returns the forkfd, or -1 on failure.
+*/
+static int qt_spawn_child(const QProcessPrivate *d, pid_t *childPid, char **argv, char **envp)
+{
+    posix_spawn_file_actions_t fileActions;
+    posix_spawnattr_t attributes;
+    if (posix_spawn_file_actions_init(&fileActions) != 0)
+        return -1;
+    if (posix_spawnattr_init(&attributes) != 0) {
+        posix_spawn_file_actions_destroy(&fileActions);
+        return -1;
+    }
+
+    int ret = 0;
+    if (d->inputChannelMode != QProcess::ForwardedInputChannel)
+        ret |= posix_spawn_file_actions_adddup2(&fileActions, d->stdinChannel.pipe[0], STDIN_FILENO);
+    if (d->processChannelMode != QProcess::ForwardedChannels) {
+        if (d->processChannelMode != QProcess::ForwardedOutputChannel)
+            ret |= posix_spawn_file_actions_adddup2(&fileActions, d->stdoutChannel.pipe[1], STDOUT_FILENO);
+        if (d->processChannelMode == QProcess::MergedChannels)
+            ret |= posix_spawn_file_actions_adddup2(&fileActions, STDOUT_FILENO, STDERR_FILENO);
+        else if (d->processChannelMode != QProcess::ForwardedErrorChannel)
+            ret |= posix_spawn_file_actions_adddup2(&fileActions, d->stderrChannel.pipe[1], STDERR_FILENO);
+    }
+
+    // reset the signal that we ignored
+    sigset_t defaultSignals;
+    sigemptyset(&defaultSignals);
+    sigaddset(&defaultSignals, SIGPIPE);
+    ret |= posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+    ret |= posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF);
+
+    int fd = -1;
+    if (ret == 0)
+        fd = ::spawnfd(FFD_CLOEXEC, childPid, argv[0], &fileActions, &attributes,
+                       argv, envp ? envp : environ);
+
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&fileActions);
+    return fd;
+}
+#endif // QPROCESS_USE_SPAWN
+
 void QProcessPrivate::startProcess()
 {
     Q_Q(QProcess);
@@ -454,7 +537,15 @@ void QProcessPrivate::startProcess()
 
     // Start the process manager, and fork off the child process.
     pid_t childPid;
-    forkfd = ::forkfd(FFD_CLOEXEC, &childPid);
+#ifdef QPROCESS_USE_SPAWN
+    forkfd = -1;
+    // If spawning fails, fork anyway: the child then reports the error
+    // through childStartedPipe, like any other failure to start.
+    if (qt_can_spawn_child(q, workingDirectory))
+        forkfd = qt_spawn_child(this, &childPid, argv, envp);
+    if (forkfd == -1)
+#endif
+        forkfd = ::forkfd(FFD_CLOEXEC, &childPid);
     int lastForkErrno = errno;
     if (forkfd != FFD_CHILD_PROCESS) {
         // Parent process.
@@ -87,7 +87,7 @@ QProcessEnvironment QProcessEnvironment::systemEnvironment()
 
 #if QT_CONFIG(process)
 
-static void qt_create_pipe(Q_PIPE *pipe, bool isInputPipe)
+static void qt_create_pipe(Q_PIPE *pipe, bool isInputPipe, int bufferSize)
 {
     // Anomymous pipes do not support asynchronous I/O. Thus we
     // create named pipes for redirecting stdout, stderr and stdin.
@@ -107,7 +107,7 @@ static void qt_create_pipe(Q_PIPE *pipe, bool isInputPipe)
         DWORD dwOpenMode = FILE_FLAG_OVERLAPPED;
         DWORD dwOutputBufferSize = 0;
         DWORD dwInputBufferSize = 0;
-        const DWORD dwPipeBufferSize = 1024 * 1024;
+        const DWORD dwPipeBufferSize = bufferSize > 0 ? DWORD(bufferSize) : 1024 * 1024;
         if (isInputPipe) {
             dwOpenMode |= PIPE_ACCESS_OUTBOUND;
             dwOutputBufferSize = dwPipeBufferSize;
@@ -189,7 +189,7 @@ bool QProcessPrivate::openChannel(Channel &channel)
         // we're piping this channel to our own process
         if (&channel == &stdinChannel) {
             if (inputChannelMode != QProcess::ForwardedInputChannel) {
-                qt_create_pipe(channel.pipe, true);
+                qt_create_pipe(channel.pipe, true, pipeBufferSize);
             } else {
                 channel.pipe[1] = INVALID_Q_PIPE;
                 HANDLE hStdReadChannel = GetStdHandle(STD_INPUT_HANDLE);
@@ -220,7 +220,7 @@ bool QProcessPrivate::openChannel(Channel &channel)
                 }
             }
             if (channel.reader) {
-                qt_create_pipe(channel.pipe, false);
+                qt_create_pipe(channel.pipe, false, pipeBufferSize);
                 channel.reader->setHandle(channel.pipe[0]);
                 channel.reader->startAsyncRead();
             }
@@ -299,7 +299,8 @@ bool QProcessPrivate::openChannel(Channel &channel)
             Q_ASSERT(source == &stdoutChannel);
             Q_ASSERT(sink->process == this && sink->type == Channel::PipeSink);
 
-            qt_create_pipe(source->pipe, /* in = */ false); // source is stdout
+            qt_create_pipe(source->pipe, /* in = */ false, // source is stdout
+                           qMax(pipeBufferSize, channel.process->pipeBufferSize));
             sink->pipe[0] = source->pipe[0];
             source->pipe[0] = INVALID_Q_PIPE;
 
@@ -324,7 +325,8 @@ bool QProcessPrivate::openChannel(Channel &channel)
             Q_ASSERT(sink == &stdinChannel);
             Q_ASSERT(source->process == this && source->type == Channel::PipeSource);
 
-            qt_create_pipe(sink->pipe, /* in = */ true); // sink is stdin
+            qt_create_pipe(sink->pipe, /* in = */ true, // sink is stdin
+                           qMax(pipeBufferSize, channel.process->pipeBufferSize));
             source->pipe[1] = sink->pipe[1];
             sink->pipe[1] = INVALID_Q_PIPE;
 
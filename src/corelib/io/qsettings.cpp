@@ -1391,6 +1391,12 @@ bool QConfFileSettingsPrivate::isWritable() const
     return confFiles.at(0)->isWritable();
 }
 
+static bool hasKeyWithPrefix(const ParsedSettingsMap &map, const QSettingsKey &prefix)
+{
+    ParsedSettingsMap::const_iterator i = map.lowerBound(prefix);
+    return i != map.constEnd() && i.key().startsWith(prefix);
+}
+
 void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 {
     bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
@@ -1490,7 +1496,30 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
     */
     if (!readOnly) {
         bool ok = false;
+
+        /*
+            Sections that none of the added or removed keys belong to are
+            written back as they were read, without being parsed and
+            re-encoded. The General section can contain keys of any group,
+            so it is always parsed.
+        */
+        UnparsedSettingsMap unchangedIniSections;
+        if (format <= QSettings::IniFormat) {
+            UnparsedSettingsMap::iterator i = confFile->unparsedIniSections.begin();
+            while (i != confFile->unparsedIniSections.end()) {
+                if (!i.key().isEmpty()
+                        && !hasKeyWithPrefix(confFile->addedKeys, i.key())
+                        && !hasKeyWithPrefix(confFile->removedKeys, i.key())) {
+                    unchangedIniSections.insert(i.key(), i.value());
+                    i = confFile->unparsedIniSections.erase(i);
+                } else {
+                    ++i;
+                }
+            }
+        }
+
         ensureAllSectionsParsed(confFile);
+        confFile->unparsedIniSections = unchangedIniSections;
         ParsedSettingsMap mergedKeys = confFile->mergedKeyMap();
 
 #if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(temporaryfile)
@@ -1510,7 +1539,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
         } else
 #endif
         if (format <= QSettings::IniFormat) {
-            ok = writeIniFile(sf, mergedKeys);
+            ok = writeIniFile(sf, mergedKeys, unchangedIniSections);
         } else if (writeFunc) {
             QSettings::SettingsMap tempOriginalKeys;
 
@@ -1528,7 +1557,6 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 #endif
 
         if (ok) {
-            confFile->unparsedIniSections.clear();
             confFile->originalKeys = mergedKeys;
             confFile->addedKeys.clear();
             confFile->removedKeys.clear();
@@ -1810,7 +1838,8 @@ typedef QMap<QString, QSettingsIniSection> IniMap;
     This would be more straightforward if we didn't try to remember the original
     key order in the .ini file, but we do.
 */
-bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSettingsMap &map)
+bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSettingsMap &map,
+                                            const UnparsedSettingsMap &unparsedSections)
 {
     IniMap iniMap;
     IniMap::const_iterator i;
@@ -1839,64 +1868,88 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
         iniSection.keyMap[key] = j.value();
     }
 
-    const int sectionCount = iniMap.size();
-    QVector<QSettingsIniKey> sections;
-    sections.reserve(sectionCount);
+    /*
+        Sections that were never parsed are written out verbatim, in their
+        original place. A null section data pointer refers to iniMap.
+    */
+    struct SectionEntry
+    {
+        QSettingsIniKey name;
+        const QByteArray *data;
+
+        bool operator<(const SectionEntry &other) const { return name < other.name; }
+    };
+
+    QVector<SectionEntry> sections;
+    sections.reserve(iniMap.size() + unparsedSections.size());
     for (i = iniMap.constBegin(); i != iniMap.constEnd(); ++i)
-        sections.append(QSettingsIniKey(i.key(), i.value().position));
-    std::sort(sections.begin(), sections.end());
+        sections.append({ QSettingsIniKey(i.key(), i.value().position), nullptr });
+    for (UnparsedSettingsMap::const_iterator j = unparsedSections.constBegin();
+         j != unparsedSections.constEnd(); ++j) {
+        QString name = j.key().originalCaseKey();
+        name.chop(1); // the trailing '/'
+        sections.append({ QSettingsIniKey(name, j.key().originalKeyPosition()), &j.value() });
+    }
+    std::stable_sort(sections.begin(), sections.end());
 
-    bool writeError = false;
-    for (int j = 0; !writeError && j < sectionCount; ++j) {
-        i = iniMap.constFind(sections.at(j));
-        Q_ASSERT(i != iniMap.constEnd());
+    QByteArray block;
+    for (int j = 0; j < sections.size(); ++j) {
+        const SectionEntry &entry = sections.at(j);
+        block.clear();
 
-        QByteArray realSection;
+        if (j != 0)
+            block += eol;
 
-        iniEscapedKey(i.key(), realSection);
+        QByteArray realSection;
+        iniEscapedKey(entry.name, realSection);
 
         if (realSection.isEmpty()) {
-            realSection = "[General]";
+            block += "[General]";
         } else if (qstricmp(realSection.constData(), "general") == 0) {
-            realSection = "[%General]";
+            block += "[%General]";
         } else {
-            realSection.prepend('[');
-            realSection.append(']');
+            block += '[';
+            block += realSection;
+            block += ']';
         }
+        block += eol;
 
-        if (j != 0)
-            realSection.prepend(eol);
-        realSection += eol;
-
-        device.write(realSection);
-
-        const IniKeyMap &ents = i.value().keyMap;
-        for (IniKeyMap::const_iterator j = ents.constBegin(); j != ents.constEnd(); ++j) {
-            QByteArray block;
-            iniEscapedKey(j.key(), block);
-            block += '=';
-
-            const QVariant &value = j.value();
-
-            /*
-                The size() != 1 trick is necessary because
-                QVariant(QString("foo")).toList() returns an empty
-                list, not a list containing "foo".
-            */
-            if (value.type() == QVariant::StringList
-                    || (value.type() == QVariant::List && value.toList().size() != 1)) {
-                iniEscapedStringList(variantListToStringList(value.toList()), block, iniCodec);
-            } else {
-                iniEscapedString(variantToString(value), block, iniCodec);
+        if (entry.data) {
+            const QByteArray data = entry.data->trimmed();
+            if (!data.isEmpty()) {
+                block += data;
+                block += eol;
             }
-            block += eol;
-            if (device.write(block) == -1) {
-                writeError = true;
-                break;
+        } else {
+            i = iniMap.constFind(entry.name);
+            Q_ASSERT(i != iniMap.constEnd());
+
+            const IniKeyMap &ents = i.value().keyMap;
+            for (IniKeyMap::const_iterator k = ents.constBegin(); k != ents.constEnd(); ++k) {
+                iniEscapedKey(k.key(), block);
+                block += '=';
+
+                const QVariant &value = k.value();
+
+                /*
+                    The size() != 1 trick is necessary because
+                    QVariant(QString("foo")).toList() returns an empty
+                    list, not a list containing "foo".
+                */
+                if (value.type() == QVariant::StringList
+                        || (value.type() == QVariant::List && value.toList().size() != 1)) {
+                    iniEscapedStringList(variantListToStringList(value.toList()), block, iniCodec);
+                } else {
+                    iniEscapedString(variantToString(value), block, iniCodec);
+                }
+                block += eol;
             }
         }
+
+        if (device.write(block) == -1)
+            return false;
     }
-    return !writeError;
+    return true;
 }
 
 void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) const
@@ -283,7 +283,8 @@ private:
     void initFormat();
     void initAccess();
     void syncConfFile(QConfFile *confFile);
-    bool writeIniFile(QIODevice &device, const ParsedSettingsMap &map);
+    bool writeIniFile(QIODevice &device, const ParsedSettingsMap &map,
+                      const UnparsedSettingsMap &unparsedSections);
 #ifdef Q_OS_MAC
     bool readPlistFile(const QByteArray &data, ParsedSettingsMap *map) const;
     bool writePlistFile(QIODevice &file, const ParsedSettingsMap &map) const;
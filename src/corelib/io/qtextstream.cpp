@@ -667,6 +667,26 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // search for the newline with QStringRef::indexOf(), which is
+            // vectorized, instead of looking at one character at a time
+            const int limit = maxlen ? qMin(endOffset, startOffset + maxlen - totalSize) : endOffset;
+            const QStringRef chunk(device ? &readBuffer : string, startOffset, limit - startOffset);
+            const int idx = chunk.indexOf(QLatin1Char('\n'));
+            const int n = idx == -1 ? chunk.size() : idx + 1;
+            if (idx != -1) {
+                const QChar prev = idx ? chPtr[idx - 1] : lastChar;
+                foundToken = true;
+                delimSize = (prev == QLatin1Char('\r')) ? 2 : 1;
+                consumeDelimiter = true;
+            }
+            if (n)
+                lastChar = chPtr[n - 1];
+            totalSize += n;
+            startOffset += n;
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
@@ -685,12 +705,7 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
                 }
                 break;
             case EndOfLine:
-                if (ch == QLatin1Char('\n')) {
-                    foundToken = true;
-                    delimSize = (lastChar == QLatin1Char('\r')) ? 2 : 1;
-                    consumeDelimiter = true;
-                }
-                lastChar = ch;
+                Q_UNREACHABLE();    // handled above
                 break;
             }
         }
@@ -1860,19 +1875,36 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
             val += sign.digitValue();
             ndigits++;
         }
-        // Parse digits
-        QChar ch;
-        while (getChar(&ch)) {
-            if (ch.isDigit()) {
-                val *= 10;
-                val += ch.digitValue();
-            } else if (locale != QLocale::c() && ch == locale.groupSeparator()) {
+        // Parse digits straight from the buffer, consuming them in one go
+        // rather than one getChar() at a time
+        const bool skipGroupSeparators = locale != QLocale::c();
+        const QChar groupSeparator = locale.groupSeparator();
+        for (bool done = false; !done; ) {
+            const int available = string ? string->size() - stringOffset
+                                         : readBuffer.size() - readBufferOffset;
+            if (available == 0) {
+                if (string || !fillReadBuffer())
+                    break;
                 continue;
-            } else {
-                ungetChar(ch);
-                break;
             }
-            ndigits++;
+
+            const QChar *p = readPtr();
+            int n = 0;
+            for ( ; n < available; ++n) {
+                const ushort uc = p[n].unicode();
+                if (uc >= '0' && uc <= '9') {
+                    val = val * 10 + (uc - '0');
+                } else if (p[n].isDigit()) {
+                    val = val * 10 + p[n].digitValue();
+                } else if (skipGroupSeparators && p[n] == groupSeparator) {
+                    continue;
+                } else {
+                    done = true;
+                    break;
+                }
+                ndigits++;
+            }
+            consume(n);
         }
         if (ndigits == 0)
             return npsMissingDigit;
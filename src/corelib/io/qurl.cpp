@@ -4368,4 +4368,297 @@ QUrl QUrl::fromUserInput(const QString &userInput)
     return QUrl();
 }
 
+/*!
+    \class QUrlView
+    \inmodule QtCore
+    \since 5.11
+
+    \brief The QUrlView class splits a URL into its components without
+    copying or decoding them.
+
+    \reentrant
+    \ingroup io
+    \ingroup network
+
+    QUrlView finds the components of a URL the same way QUrl does when
+    parsing it in QUrl::TolerantMode, but it neither allocates memory nor
+    validates, decodes or normalizes the components. Each accessor returns a
+    QStringView into the string passed to the constructor, which must
+    therefore outlive the QUrlView. This makes it suitable for code that
+    looks at large numbers of URLs and needs only some of their parts, such
+    as the scheme and the host.
+
+    Components are returned as they appear in the input: the scheme and the
+    host are not lowercased, international domain names are not converted
+    and percent-encoded sequences are left alone. Use decoded() to decode a
+    component once it is needed, or toUrl() to get a fully parsed and
+    validated QUrl.
+
+    \code
+        QUrlView view(line);
+        if (view.scheme().compare(QLatin1String("https"), Qt::CaseInsensitive) == 0)
+            backend = backendForHost(view.host());
+    \endcode
+
+    \sa QUrl
+*/
+
+/*!
+    \fn QUrlView::QUrlView()
+
+    Constructs an empty QUrlView.
+*/
+
+/*!
+    Splits \a url into its components. \a url must remain valid for as long
+    as this QUrlView or any of the views returned from it are used.
+*/
+QUrlView::QUrlView(QStringView url) Q_DECL_NOTHROW
+    : m_url(url), m_port(-1)
+{
+    // see QUrlPrivate::parse() and QUrlPrivate::setAuthority()
+    const QChar *const begin = url.data();
+    const ushort *const data = reinterpret_cast<const ushort *>(begin);
+    const int len = int(url.size());
+    int colon = -1;
+    int question = -1;
+    int hash = -1;
+
+    for (int i = 0; i < len; ++i) {
+        const ushort uc = data[i];
+        if (uc == '#') {
+            hash = i;
+            break;
+        }
+        if (question == -1) {
+            if (uc == ':' && colon == -1)
+                colon = i;
+            else if (uc == '?')
+                question = i;
+        }
+    }
+
+    // the scheme, if there is a valid one
+    int hierStart = 0;
+    if (colon > 0) {
+        bool valid = true;
+        for (int i = 0; valid && i < colon; ++i) {
+            const ushort uc = data[i] | 0x20;
+            valid = (uc >= 'a' && uc <= 'z')
+                    || (i && ((data[i] >= '0' && data[i] <= '9')
+                              || data[i] == '+' || data[i] == '-' || data[i] == '.'));
+        }
+        if (valid) {
+            m_scheme = QStringView(begin, colon);
+            hierStart = colon + 1;
+        }
+    }
+
+    const int hierEnd = qMin<uint>(qMin<uint>(question, hash), len);
+    int pathStart = hierStart;
+    if (hierEnd - hierStart >= 2 && data[hierStart] == '/' && data[hierStart + 1] == '/') {
+        int from = hierStart + 2;
+        int end = hierEnd;
+        for (int i = from; i < end; ++i) {
+            if (data[i] == '/') {
+                end = i;
+                break;
+            }
+        }
+        m_authority = QStringView(begin + from, end - from);
+        pathStart = end;
+
+        for (int i = from; i < end; ++i) {
+            if (data[i] == '@') {
+                int userNameEnd = i;
+                for (int j = from; j < i; ++j) {
+                    if (data[j] == ':') {
+                        userNameEnd = j;
+                        m_password = QStringView(begin + j + 1, i - j - 1);
+                        break;
+                    }
+                }
+                m_userName = QStringView(begin + from, userNameEnd - from);
+                from = i + 1;
+                break;
+            }
+        }
+
+        int colonIndex = -1;
+        for (int i = end - 1; i >= from; --i) {
+            if (data[i] == ':') {
+                colonIndex = i;
+                break;
+            }
+        }
+        if (colonIndex != -1 && from < end && data[from] == '[') {
+            // a colon inside "[...]" is part of an IPv6 address
+            int closingBracket = from;
+            while (closingBracket < end && data[closingBracket] != ']')
+                ++closingBracket;
+            if (closingBracket == end || closingBracket > colonIndex)
+                colonIndex = -1;
+        }
+
+        int hostEnd = end;
+        if (colonIndex != -1) {
+            hostEnd = colonIndex;
+            uint port = 0;
+            for (int i = colonIndex + 1; i < end && port <= 0xffff; ++i) {
+                if (data[i] < '0' || data[i] > '9')
+                    port = uint(-1);
+                else
+                    port = port * 10 + data[i] - '0';
+            }
+            if (colonIndex + 1 < end && port <= 0xffff)
+                m_port = int(port);
+        }
+
+        if (hostEnd - from >= 2 && data[from] == '[' && data[hostEnd - 1] == ']')
+            m_host = QStringView(begin + from + 1, hostEnd - from - 2);
+        else
+            m_host = QStringView(begin + from, hostEnd - from);
+    }
+
+    m_path = QStringView(begin + pathStart, hierEnd - pathStart);
+    if (uint(question) < uint(hash))
+        m_query = QStringView(begin + question + 1, qMin<uint>(hash, len) - question - 1);
+    if (hash != -1)
+        m_fragment = QStringView(begin + hash + 1, len - hash - 1);
+}
+
+/*!
+    \fn QStringView QUrlView::url() const
+
+    Returns the complete URL this view was constructed from.
+*/
+
+/*!
+    \fn bool QUrlView::isEmpty() const
+
+    Returns \c true if the URL is empty.
+*/
+
+/*!
+    \fn bool QUrlView::isRelative() const
+
+    Returns \c true if the URL has no valid scheme.
+
+    \sa QUrl::isRelative()
+*/
+
+/*!
+    \fn bool QUrlView::hasAuthority() const
+
+    Returns \c true if the URL has an authority, that is, if the part after
+    the scheme starts with "//". The authority may be empty.
+*/
+
+/*!
+    \fn bool QUrlView::hasQuery() const
+
+    Returns \c true if the URL contains a query delimiter ('?'). The query
+    may be empty.
+
+    \sa QUrl::hasQuery()
+*/
+
+/*!
+    \fn bool QUrlView::hasFragment() const
+
+    Returns \c true if the URL contains a fragment delimiter ('#'). The
+    fragment may be empty.
+
+    \sa QUrl::hasFragment()
+*/
+
+/*!
+    \fn QStringView QUrlView::scheme() const
+
+    Returns the scheme of the URL, without the trailing ':', or a null view if
+    the URL has no valid scheme. Unlike QUrl::scheme(), the scheme is not
+    lowercased.
+*/
+
+/*!
+    \fn QStringView QUrlView::authority() const
+
+    Returns the authority of the URL, or a null view if it has none.
+*/
+
+/*!
+    \fn QStringView QUrlView::userName() const
+
+    Returns the user name part of the authority, or a null view if the
+    authority contains no user info. The user name is not decoded.
+*/
+
+/*!
+    \fn QStringView QUrlView::password() const
+
+    Returns the password part of the authority, or a null view if the
+    authority contains none. The password is not decoded.
+*/
+
+/*!
+    \fn QStringView QUrlView::host() const
+
+    Returns the host of the URL, or a null view if the URL has no authority.
+    Square brackets around an IP literal are removed. Unlike QUrl::host(), the
+    host is neither lowercased nor converted from or to ACE, and IP addresses
+    are not normalized.
+*/
+
+/*!
+    \fn int QUrlView::port(int defaultPort) const
+
+    Returns the port of the URL, or \a defaultPort if the URL has no port or
+    if the port is not a number between 0 and 65535.
+*/
+
+/*!
+    \fn QStringView QUrlView::path() const
+
+    Returns the path of the URL. The path is not decoded.
+*/
+
+/*!
+    \fn QStringView QUrlView::query() const
+
+    Returns the query of the URL, without the leading '?', or a null view if
+    the URL has no query. The query is not decoded.
+*/
+
+/*!
+    \fn QStringView QUrlView::fragment() const
+
+    Returns the fragment of the URL, without the leading '#', or a null view
+    if the URL has no fragment. The fragment is not decoded.
+*/
+
+/*!
+    Parses the URL using \a mode and returns it as a QUrl.
+*/
+QUrl QUrlView::toUrl(QUrl::ParsingMode mode) const
+{
+    return QUrl(m_url.toString(), mode);
+}
+
+/*!
+    Returns \a component with all percent-encoded sequences decoded, treating
+    them as UTF-8. Components that contain no '%' are only copied.
+
+    \sa QUrl::fromPercentEncoding()
+*/
+QString QUrlView::decoded(QStringView component)
+{
+    const ushort *p = reinterpret_cast<const ushort *>(component.data());
+    const ushort *const e = p + component.size();
+    for ( ; p != e; ++p) {
+        if (*p == '%')
+            return QUrl::fromPercentEncoding(component.toUtf8());
+    }
+    return component.toString();
+}
+
 QT_END_NAMESPACE
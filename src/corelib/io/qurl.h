@@ -406,6 +406,48 @@ Q_DECL_CONSTEXPR inline QUrl::FormattingOptions operator|(QUrl::ComponentFormatt
 //{ i = int(f); f; }
 #endif // Q_QDOC
 
+class Q_CORE_EXPORT QUrlView
+{
+public:
+    Q_DECL_CONSTEXPR QUrlView() Q_DECL_NOTHROW : m_port(-1) {}
+    explicit QUrlView(QStringView url) Q_DECL_NOTHROW;
+
+    Q_DECL_CONSTEXPR QStringView url() const Q_DECL_NOTHROW { return m_url; }
+    Q_DECL_CONSTEXPR bool isEmpty() const Q_DECL_NOTHROW { return m_url.isEmpty(); }
+    Q_DECL_CONSTEXPR bool isRelative() const Q_DECL_NOTHROW { return m_scheme.isNull(); }
+
+    Q_DECL_CONSTEXPR bool hasAuthority() const Q_DECL_NOTHROW { return !m_authority.isNull(); }
+    Q_DECL_CONSTEXPR bool hasQuery() const Q_DECL_NOTHROW { return !m_query.isNull(); }
+    Q_DECL_CONSTEXPR bool hasFragment() const Q_DECL_NOTHROW { return !m_fragment.isNull(); }
+
+    Q_DECL_CONSTEXPR QStringView scheme() const Q_DECL_NOTHROW { return m_scheme; }
+    Q_DECL_CONSTEXPR QStringView authority() const Q_DECL_NOTHROW { return m_authority; }
+    Q_DECL_CONSTEXPR QStringView userName() const Q_DECL_NOTHROW { return m_userName; }
+    Q_DECL_CONSTEXPR QStringView password() const Q_DECL_NOTHROW { return m_password; }
+    Q_DECL_CONSTEXPR QStringView host() const Q_DECL_NOTHROW { return m_host; }
+    Q_DECL_CONSTEXPR int port(int defaultPort = -1) const Q_DECL_NOTHROW { return m_port == -1 ? defaultPort : m_port; }
+    Q_DECL_CONSTEXPR QStringView path() const Q_DECL_NOTHROW { return m_path; }
+    Q_DECL_CONSTEXPR QStringView query() const Q_DECL_NOTHROW { return m_query; }
+    Q_DECL_CONSTEXPR QStringView fragment() const Q_DECL_NOTHROW { return m_fragment; }
+
+    QUrl toUrl(QUrl::ParsingMode mode = QUrl::TolerantMode) const;
+    static QString decoded(QStringView component);
+
+private:
+    QStringView m_url;
+    QStringView m_scheme;
+    QStringView m_authority;
+    QStringView m_userName;
+    QStringView m_password;
+    QStringView m_host;
+    QStringView m_path;
+    QStringView m_query;
+    QStringView m_fragment;
+    int m_port;
+};
+
+Q_DECLARE_TYPEINFO(QUrlView, Q_PRIMITIVE_TYPE);
+
 #ifndef QT_NO_DATASTREAM
 Q_CORE_EXPORT QDataStream &operator<<(QDataStream &, const QUrl &);
 Q_CORE_EXPORT QDataStream &operator>>(QDataStream &, QUrl &);
@@ -2487,11 +2487,51 @@ static int nextDotDelimiter(const QString &domain, int from = 0)
     return ch - b;
 }
 
+/*
+    Returns true if \a domain consists only of ASCII letters, digits, hyphens
+    and underscores in labels separated by '.', with no empty label (other than
+    after a trailing dot), no label in ACE form and every label satisfying the
+    STD3 rules. Neither nameprep nor Punycode change such a domain and the IDN
+    whitelist does not matter for it: both ACE operations reduce to lowercasing.
+*/
+static bool qt_is_simple_ascii_domain(const QString &domain)
+{
+    const QChar *label = domain.constData();
+    const QChar *const e = label + domain.size();
+    for (const QChar *p = label; ; ++p) {
+        if (p != e && p->unicode() != '.')
+            continue;
+
+        const int labelLength = p - label;
+        if (labelLength == 0)
+            return p == e && p != domain.constData();   // only a trailing dot is allowed
+        if (qt_find_nonstd3(label, labelLength, Qt::CaseInsensitive))
+            return false;
+        if (labelLength > 6 && (label[0].unicode() | 0x20) == 'x' && (label[1].unicode() | 0x20) == 'n'
+                && label[2].unicode() == '-' && label[3].unicode() == '-')
+            return false;
+        if (p == e)
+            return true;
+        label = p + 1;
+    }
+}
+
 QString qt_ACE_do(const QString &domain, AceOperation op, AceLeadingDot dot)
 {
     if (domain.isEmpty())
         return domain;
 
+    if (qt_is_simple_ascii_domain(domain)) {
+        // fastest case: a plain host name, as most are. Always return a copy,
+        // because the caller may have passed a QString::fromRawData().
+        QString result(domain.constData(), domain.size());
+        for (QChar &c : result) {
+            if (c.unicode() >= 'A' && c.unicode() <= 'Z')
+                c = QChar(c.unicode() | 0x20);
+        }
+        return result;
+    }
+
     QString result;
     result.reserve(domain.length());
 
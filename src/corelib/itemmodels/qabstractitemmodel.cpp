@@ -982,6 +982,150 @@ void QAbstractItemModel::resetInternalData()
 
 }
 
+/*!
+    \class QModelRoleData
+    \inmodule QtCore
+    \since 5.11
+    \ingroup model-view
+
+    \brief The QModelRoleData class holds a role and the data associated to that role.
+
+    QModelRoleData objects store an item role (which is a value from the
+    Qt::ItemDataRole enumeration, or an arbitrary integer for a custom role)
+    as well as the data associated with that role.
+
+    A QModelRoleData object is typically created by views or delegates,
+    setting which role they want to fetch the data for. The object
+    is then passed to models (see QAbstractItemModel::multiData()),
+    which populate the data corresponding to the role stored. Finally,
+    the view visualizes the data retrieved from the model.
+
+    \sa {Model/View Programming}, QModelRoleDataSpan
+*/
+
+/*!
+    \fn QModelRoleData::QModelRoleData(int role)
+
+    Constructs a QModelRoleData object for the given \a role.
+*/
+
+/*!
+    \fn int QModelRoleData::role() const
+
+    Returns the role held by this object.
+*/
+
+/*!
+    \fn const QVariant &QModelRoleData::data() const
+
+    Returns the data held by this object.
+*/
+
+/*!
+    \fn QVariant &QModelRoleData::data()
+
+    Returns the data held by this object as a modifiable reference.
+*/
+
+/*!
+    \fn void QModelRoleData::setData(const QVariant &value)
+
+    Sets the data held by this object to \a value.
+*/
+
+/*!
+    \fn void QModelRoleData::clearData()
+
+    Clears the data held by this object.
+*/
+
+/*!
+    \class QModelRoleDataSpan
+    \inmodule QtCore
+    \since 5.11
+    \ingroup model-view
+
+    \brief The QModelRoleDataSpan class provides a span over QModelRoleData objects.
+
+    A QModelRoleDataSpan is used as an abstraction over an array of
+    QModelRoleData objects. Like a view, it does not own the storage it
+    refers to; it is the caller's responsibility to keep the array alive
+    while the span is in use.
+
+    \sa {Model/View Programming}, QAbstractItemModel::multiData()
+*/
+
+/*!
+    \fn QModelRoleDataSpan::QModelRoleDataSpan()
+
+    Constructs an empty QModelRoleDataSpan.
+*/
+
+/*!
+    \fn QModelRoleDataSpan::QModelRoleDataSpan(QModelRoleData &modelRoleData)
+
+    Constructs a QModelRoleDataSpan spanning over \a modelRoleData.
+*/
+
+/*!
+    \fn QModelRoleDataSpan::QModelRoleDataSpan(QModelRoleData *modelRoleData, int len)
+
+    Constructs a QModelRoleDataSpan spanning over the array beginning at
+    \a modelRoleData and with length \a len.
+*/
+
+/*!
+    \fn template <int N> QModelRoleDataSpan::QModelRoleDataSpan(QModelRoleData (&modelRoleData)[N])
+
+    Constructs a QModelRoleDataSpan spanning over the array \a modelRoleData.
+*/
+
+/*!
+    \fn int QModelRoleDataSpan::size() const
+
+    Returns the length of the span represented by this object.
+*/
+
+/*!
+    \fn int QModelRoleDataSpan::length() const
+
+    Returns the length of the span represented by this object.
+*/
+
+/*!
+    \fn QModelRoleData *QModelRoleDataSpan::data() const
+
+    Returns a pointer to the beginning of the span represented by this object.
+*/
+
+/*!
+    \fn QModelRoleData *QModelRoleDataSpan::begin() const
+
+    Returns a pointer to the beginning of the span represented by this object.
+*/
+
+/*!
+    \fn QModelRoleData *QModelRoleDataSpan::end() const
+
+    Returns a pointer to the imaginary element one past the end of the
+    span represented by this object.
+*/
+
+/*!
+    \fn QModelRoleData &QModelRoleDataSpan::operator[](int index) const
+
+    Returns a modifiable reference to the QModelRoleData at position
+    \a index in the span.
+*/
+
+/*!
+    \fn QVariant *QModelRoleDataSpan::dataForRole(int role) const
+
+    Returns a pointer to the data of the first QModelRoleData in the span
+    that holds \a role, or a null pointer if the span does not contain the
+    role.
+*/
+
 /*!
     \class QModelIndex
     \inmodule QtCore
@@ -1131,6 +1275,16 @@ void QAbstractItemModel::resetInternalData()
     index.
 */
 
+/*!
+    \fn void QModelIndex::multiData(QModelRoleDataSpan roleDataSpan) const
+    \since 5.11
+
+    Populates the given \a roleDataSpan for the item referred to by the
+    index.
+
+    \sa QAbstractItemModel::multiData()
+*/
+
 /*!
     \fn Qt::ItemFlags QModelIndex::flags() const
     \since 4.2
@@ -1824,6 +1978,34 @@ QMap<int, QVariant> QAbstractItemModel::itemData(const QModelIndex &index) const
     return roles;
 }
 
+/*!
+    \since 5.11
+
+    Fills the \a roleDataSpan with the data of the item at \a index,
+    one entry for each role requested in the span.
+
+    Views and delegates that need several roles of the same item, such as
+    the display text, the decoration and the font, should use this function
+    instead of calling data() once per role.
+
+    The data of each role is the same as returned by data(). Roles that are
+    not available for the item are set to an invalid QVariant.
+
+    \sa data(), QModelRoleData, QModelRoleDataSpan
+*/
+void QAbstractItemModel::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    Q_D(const QAbstractItemModel);
+    d->multiData(index, roleDataSpan);
+}
+
+void QAbstractItemModelPrivate::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    Q_Q(const QAbstractItemModel);
+    for (QModelRoleData &roleData : roleDataSpan)
+        roleData.setData(q->data(index, roleData.role()));
+}
+
 /*!
     Sets the \a role data for the item at \a index to \a value.
 
@@ -51,6 +51,68 @@ QT_BEGIN_NAMESPACE
 class QAbstractItemModel;
 class QPersistentModelIndex;
 
+class QModelRoleData
+{
+    int m_role;
+    QVariant m_data;
+
+public:
+    explicit QModelRoleData(int role) Q_DECL_NOTHROW
+        : m_role(role)
+    {}
+
+    Q_DECL_CONSTEXPR int role() const Q_DECL_NOTHROW { return m_role; }
+    const QVariant &data() const Q_DECL_NOTHROW { return m_data; }
+    QVariant &data() Q_DECL_NOTHROW { return m_data; }
+
+    void setData(const QVariant &value) { m_data = value; }
+    void clearData() Q_DECL_NOTHROW { m_data.clear(); }
+};
+
+Q_DECLARE_TYPEINFO(QModelRoleData, Q_MOVABLE_TYPE);
+
+class QModelRoleDataSpan
+{
+    QModelRoleData *m_modelRoleData;
+    int m_len;
+
+public:
+    Q_DECL_CONSTEXPR QModelRoleDataSpan() Q_DECL_NOTHROW
+        : m_modelRoleData(Q_NULLPTR), m_len(0)
+    {}
+
+    Q_DECL_CONSTEXPR QModelRoleDataSpan(QModelRoleData &modelRoleData) Q_DECL_NOTHROW
+        : m_modelRoleData(&modelRoleData), m_len(1)
+    {}
+
+    Q_DECL_CONSTEXPR QModelRoleDataSpan(QModelRoleData *modelRoleData, int len) Q_DECL_NOTHROW
+        : m_modelRoleData(modelRoleData), m_len(len)
+    {}
+
+    template <int N>
+    Q_DECL_CONSTEXPR QModelRoleDataSpan(QModelRoleData (&modelRoleData)[N]) Q_DECL_NOTHROW
+        : m_modelRoleData(modelRoleData), m_len(N)
+    {}
+
+    Q_DECL_CONSTEXPR int size() const Q_DECL_NOTHROW { return m_len; }
+    Q_DECL_CONSTEXPR int length() const Q_DECL_NOTHROW { return m_len; }
+    Q_DECL_CONSTEXPR QModelRoleData *data() const Q_DECL_NOTHROW { return m_modelRoleData; }
+    Q_DECL_CONSTEXPR QModelRoleData *begin() const Q_DECL_NOTHROW { return m_modelRoleData; }
+    Q_DECL_CONSTEXPR QModelRoleData *end() const Q_DECL_NOTHROW { return m_modelRoleData + m_len; }
+    Q_DECL_CONSTEXPR QModelRoleData &operator[](int index) const { return m_modelRoleData[index]; }
+
+    QVariant *dataForRole(int role) const
+    {
+        for (QModelRoleData *it = begin(); it != end(); ++it) {
+            if (it->role() == role)
+                return &it->data();
+        }
+        return Q_NULLPTR;
+    }
+};
+
+Q_DECLARE_TYPEINFO(QModelRoleDataSpan, Q_MOVABLE_TYPE);
+
 class Q_CORE_EXPORT QModelIndex
 {
     friend class QAbstractItemModel;
@@ -67,6 +129,7 @@ public:
     QT_DEPRECATED_X("Use QAbstractItemModel::index") inline QModelIndex child(int row, int column) const;
 #endif
     inline QVariant data(int role = Qt::DisplayRole) const;
+    inline void multiData(QModelRoleDataSpan roleDataSpan) const;
     inline Qt::ItemFlags flags() const;
     Q_DECL_CONSTEXPR inline const QAbstractItemModel *model() const Q_DECL_NOTHROW { return m; }
     Q_DECL_CONSTEXPR inline bool isValid() const Q_DECL_NOTHROW { return (r >= 0) && (c >= 0) && (m != Q_NULLPTR); }
@@ -195,6 +258,8 @@ public:
     virtual QMap<int, QVariant> itemData(const QModelIndex &index) const;
     virtual bool setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles);
 
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const;
+
     virtual QStringList mimeTypes() const;
     virtual QMimeData *mimeData(const QModelIndexList &indexes) const;
     virtual bool canDropMimeData(const QMimeData *data, Qt::DropAction action,
@@ -431,6 +496,16 @@ inline QModelIndex QModelIndex::child(int arow, int acolumn) const
 inline QVariant QModelIndex::data(int arole) const
 { return m ? m->data(*this, arole) : QVariant(); }
 
+inline void QModelIndex::multiData(QModelRoleDataSpan roleDataSpan) const
+{
+    if (m) {
+        m->multiData(*this, roleDataSpan);
+    } else {
+        for (QModelRoleData &roleData : roleDataSpan)
+            roleData.clearData();
+    }
+}
+
 inline Qt::ItemFlags QModelIndex::flags() const
 { return m ? m->flags(*this) : Qt::ItemFlags(); }
 
@@ -218,13 +218,14 @@ QT_BEGIN_NAMESPACE
 */
 bool QItemSelectionRange::intersects(const QItemSelectionRange &other) const
 {
-    return (isValid() && other.isValid()
-            && parent() == other.parent()
-            && model() == other.model()
-            && ((top() <= other.top() && bottom() >= other.top())
+    // compare the parents last, they have to be calculated by the model
+    return (((top() <= other.top() && bottom() >= other.top())
                 || (top() >= other.top() && top() <= other.bottom()))
             && ((left() <= other.left() && right() >= other.left())
-                || (left() >= other.left() && left() <= other.right())));
+                || (left() >= other.left() && left() <= other.right()))
+            && model() == other.model()
+            && isValid() && other.isValid()
+            && parent() == other.parent());
 }
 
 /*!
@@ -490,9 +491,12 @@ void QItemSelection::select(const QModelIndex &topLeft, const QModelIndex &botto
 bool QItemSelection::contains(const QModelIndex &index) const
 {
     if (index.flags() & Qt::ItemIsSelectable) {
+        const QModelIndex parent = index.parent();
+        const int row = index.row();
+        const int column = index.column();
         QList<QItemSelectionRange>::const_iterator it = begin();
         for (; it != end(); ++it)
-            if ((*it).contains(index))
+            if ((*it).contains(row, column, parent))
                 return true;
     }
     return false;
@@ -525,6 +529,51 @@ static QVector<QPair<QPersistentModelIndex, uint> > qSelectionPersistentRowLengt
 
     \sa split()
 */
+/*
+    Returns the ranges of \a selection with all items in \a other removed.
+*/
+static QItemSelection qSubtractedRanges(const QItemSelection &selection, const QItemSelection &other)
+{
+    struct RowSpan {
+        int top;
+        int bottom;
+        int position;
+        bool operator<(const RowSpan &span) const { return top < span.top; }
+    };
+    // only the other ranges starting above the bottom of a range can intersect it
+    QVector<RowSpan> otherRows;
+    otherRows.reserve(other.count());
+    for (int i = 0; i < other.count(); ++i)
+        otherRows.append(RowSpan{other.at(i).top(), other.at(i).bottom(), i});
+    std::sort(otherRows.begin(), otherRows.end());
+
+    QItemSelection result;
+    result.reserve(selection.count());
+    QItemSelection pieces;
+    for (const QItemSelectionRange &range : selection) {
+        const int top = range.top();
+        const RowSpan bottom = {range.bottom(), 0, 0};
+        const auto end = std::upper_bound(otherRows.cbegin(), otherRows.cend(), bottom);
+        pieces.clear();
+        pieces.append(range);
+        for (auto span = otherRows.cbegin(); span != end; ++span) {
+            if (span->bottom < top)
+                continue;
+            const QItemSelectionRange &otherRange = other.at(span->position);
+            for (int p = 0; p < pieces.count();) {
+                if (pieces.at(p).intersects(otherRange)) {
+                    QItemSelection::split(pieces.at(p), otherRange, &pieces);
+                    pieces.removeAt(p);
+                } else {
+                    ++p;
+                }
+            }
+        }
+        result += pieces;
+    }
+    return result;
+}
+
 void QItemSelection::merge(const QItemSelection &other, QItemSelectionModel::SelectionFlags command)
 {
     if (other.isEmpty() ||
@@ -534,41 +583,23 @@ void QItemSelection::merge(const QItemSelection &other, QItemSelectionModel::Sel
         return;
 
     QItemSelection newSelection = other;
-    // Collect intersections
-    QItemSelection intersections;
     QItemSelection::iterator it = newSelection.begin();
     while (it != newSelection.end()) {
         if (!(*it).isValid()) {
             it = newSelection.erase(it);
             continue;
         }
-        for (int t = 0; t < count(); ++t) {
-            if ((*it).intersects(at(t)))
-                intersections.append(at(t).intersected(*it));
-        }
         ++it;
     }
 
-    //  Split the old (and new) ranges using the intersections
-    for (int i = 0; i < intersections.count(); ++i) { // for each intersection
-        for (int t = 0; t < count();) { // splitt each old range
-            if (at(t).intersects(intersections.at(i))) {
-                split(at(t), intersections.at(i), this);
-                removeAt(t);
-            } else {
-                ++t;
-            }
-        }
-        // only split newSelection if Toggle is specified
-        for (int n = 0; (command & QItemSelectionModel::Toggle) && n < newSelection.count();) {
-            if (newSelection.at(n).intersects(intersections.at(i))) {
-                split(newSelection.at(n), intersections.at(i), &newSelection);
-                newSelection.removeAt(n);
-            } else {
-                ++n;
-            }
-        }
-    }
+    //  Split the old (and new) ranges where they intersect. Each range is only
+    //  split by the ranges it intersects, so that merging a single range into
+    //  a large selection is linear.
+    const QItemSelection oldSelection = *this;
+    *this = qSubtractedRanges(oldSelection, newSelection);
+    // only split newSelection if Toggle is specified
+    if (command & QItemSelectionModel::Toggle)
+        newSelection = qSubtractedRanges(newSelection, oldSelection);
     // do not add newSelection for Deselect
     if (!(command & QItemSelectionModel::Deselect))
         operator+=(newSelection);
@@ -1437,10 +1468,13 @@ bool QItemSelectionModel::isSelected(const QModelIndex &index) const
         return false;
 
     bool selected = false;
-    //  search model ranges
+    //  search model ranges, the parent is only calculated once
+    const QModelIndex parent = index.parent();
+    const int row = index.row();
+    const int column = index.column();
     QList<QItemSelectionRange>::const_iterator it = d->ranges.begin();
     for (; it != d->ranges.end(); ++it) {
-        if ((*it).isValid() && (*it).contains(index)) {
+        if ((*it).contains(row, column, parent) && (*it).isValid()) {
             selected = true;
             break;
         }
@@ -1833,6 +1867,59 @@ void QItemSelectionModel::setModel(QAbstractItemModel *model)
     Compares the two selections \a newSelection and \a oldSelection
     and emits selectionChanged() with the deselected and selected items.
 */
+/*
+    Removes the ranges that are in both \a first and \a second from both selections,
+    keeping the order of the remaining ranges. Both selections are sorted on the side,
+    so that this does not compare every range with every other range.
+*/
+static void qRemoveEqualRanges(QItemSelection &first, QItemSelection &second)
+{
+    const auto sortedPositions = [](const QItemSelection &selection) {
+        QVector<int> positions(selection.count());
+        for (int i = 0; i < positions.count(); ++i)
+            positions[i] = i;
+        std::sort(positions.begin(), positions.end(), [&selection](int a, int b) {
+            return selection.at(a) < selection.at(b);
+        });
+        return positions;
+    };
+    const QVector<int> firstPositions = sortedPositions(first);
+    const QVector<int> secondPositions = sortedPositions(second);
+
+    QVector<bool> firstRemoved(first.count(), false);
+    QVector<bool> secondRemoved(second.count(), false);
+    bool removed = false;
+    for (int f = 0, s = 0; f < firstPositions.count() && s < secondPositions.count();) {
+        const QItemSelectionRange &a = first.at(firstPositions.at(f));
+        const QItemSelectionRange &b = second.at(secondPositions.at(s));
+        if (a < b) {
+            ++f;
+        } else if (b < a) {
+            ++s;
+        } else if (a == b) {
+            firstRemoved[firstPositions.at(f++)] = true;
+            secondRemoved[secondPositions.at(s++)] = true;
+            removed = true;
+        } else {
+            ++f;
+        }
+    }
+    if (!removed)
+        return;
+
+    const auto removeMarked = [](QItemSelection &selection, const QVector<bool> &marked) {
+        QItemSelection remaining;
+        remaining.reserve(selection.count());
+        for (int i = 0; i < selection.count(); ++i) {
+            if (!marked.at(i))
+                remaining.append(selection.at(i));
+        }
+        selection.swap(remaining);
+    };
+    removeMarked(first, firstRemoved);
+    removeMarked(second, secondRemoved);
+}
+
 void QItemSelectionModel::emitSelectionChanged(const QItemSelection &newSelection,
                                                const QItemSelection &oldSelection)
 {
@@ -1851,52 +1938,12 @@ void QItemSelectionModel::emitSelectionChanged(const QItemSelection &newSelectio
     QItemSelection selected = newSelection;
 
     // remove equal ranges
-    bool advance;
-    for (int o = 0; o < deselected.count(); ++o) {
-        advance = true;
-        for (int s = 0; s < selected.count() && o < deselected.count();) {
-            if (deselected.at(o) == selected.at(s)) {
-                deselected.removeAt(o);
-                selected.removeAt(s);
-                advance = false;
-            } else {
-                ++s;
-            }
-        }
-        if (advance)
-            ++o;
-    }
-
-    // find intersections
-    QItemSelection intersections;
-    for (int o = 0; o < deselected.count(); ++o) {
-        for (int s = 0; s < selected.count(); ++s) {
-            if (deselected.at(o).intersects(selected.at(s)))
-                intersections.append(deselected.at(o).intersected(selected.at(s)));
-        }
-    }
+    qRemoveEqualRanges(deselected, selected);
 
-    // compare remaining ranges with intersections and split them to find deselected and selected
-    for (int i = 0; i < intersections.count(); ++i) {
-        // split deselected
-        for (int o = 0; o < deselected.count();) {
-            if (deselected.at(o).intersects(intersections.at(i))) {
-                QItemSelection::split(deselected.at(o), intersections.at(i), &deselected);
-                deselected.removeAt(o);
-            } else {
-                ++o;
-            }
-        }
-        // split selected
-        for (int s = 0; s < selected.count();) {
-            if (selected.at(s).intersects(intersections.at(i))) {
-                QItemSelection::split(selected.at(s), intersections.at(i), &selected);
-                selected.removeAt(s);
-            } else {
-                ++s;
-            }
-        }
-    }
+    // split the remaining ranges where they intersect to find deselected and selected
+    const QItemSelection remainingSelected = selected;
+    selected = qSubtractedRanges(selected, deselected);
+    deselected = qSubtractedRanges(deselected, remainingSelected);
 
     if (!selected.isEmpty() || !deselected.isEmpty())
         emit selectionChanged(selected, deselected);
@@ -51,6 +51,8 @@
 #include <private/qabstractproxymodel_p.h>
 
 #include <algorithm>
+#include <functional>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -171,6 +173,7 @@ public:
     Qt::CaseSensitivity sort_casesensitivity;
     int sort_role;
     bool sort_localeaware;
+    bool sort_keycaching;
 
     int filter_column;
     int filter_role;
@@ -259,6 +262,8 @@ public:
     bool update_source_sort_column();
     void sort_source_rows(QVector<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    void sort_source_rows_by_keys(QVector<int> &source_rows,
+                                  const QModelIndex &source_parent) const;
     QVector<QPair<int, QVector<int > > > proxy_intervals_for_source_items_to_add(
         const QVector<int> &proxy_to_source, const QVector<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -292,10 +297,12 @@ public:
     void update_persistent_indexes(const QModelIndexPairList &source_indexes);
 
     void filter_about_to_be_changed(const QModelIndex &source_parent = QModelIndex());
-    void filter_changed(const QModelIndex &source_parent = QModelIndex());
+    void filter_changed(const QModelIndex &source_parent = QModelIndex(), bool filter_narrowed = false);
+    bool is_filter_narrowed_by(const QRegExp &regExp) const;
     QSet<int> handle_filter_changed(
         QVector<int> &source_to_proxy, QVector<int> &proxy_to_source,
-        const QModelIndex &source_parent, Qt::Orientation orient);
+        const QModelIndex &source_parent, Qt::Orientation orient,
+        bool filter_narrowed = false);
 
     void updateChildrenMapping(const QModelIndex &source_parent, Mapping *parent_mapping,
                                Qt::Orientation orient, int start, int end, int delta_item_count, bool remove);
@@ -531,7 +538,9 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
-        if (sort_order == Qt::AscendingOrder) {
+        if (sort_keycaching) {
+            sort_source_rows_by_keys(source_rows, source_parent);
+        } else if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
             std::stable_sort(source_rows.begin(), source_rows.end(), lt);
         } else {
@@ -543,6 +552,108 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
     }
 }
 
+template <typename Key, typename LessThan>
+static void qt_sort_rows_by_keys(QVector<int> &source_rows, const QVector<Key> &keys,
+                                 Qt::SortOrder order, LessThan lessThan)
+{
+    QVector<int> positions(source_rows.size());
+    std::iota(positions.begin(), positions.end(), 0);
+    if (order == Qt::AscendingOrder) {
+        std::stable_sort(positions.begin(), positions.end(), [&](int p1, int p2) {
+            return lessThan(keys.at(p1), keys.at(p2));
+        });
+    } else {
+        std::stable_sort(positions.begin(), positions.end(), [&](int p1, int p2) {
+            return lessThan(keys.at(p2), keys.at(p1));
+        });
+    }
+
+    QVector<int> sorted;
+    sorted.reserve(source_rows.size());
+    for (int position : qAsConst(positions))
+        sorted.append(source_rows.at(position));
+    source_rows = sorted;
+}
+
+/*!
+  \internal
+
+  Sorts the given \a source_rows like sort_source_rows(), but queries the
+  sort role of every row only once instead of once per comparison. When all
+  values have the same type, they are compared as integers, floating point
+  numbers or strings without going through QVariant.
+*/
+void QSortFilterProxyModelPrivate::sort_source_rows_by_keys(
+    QVector<int> &source_rows, const QModelIndex &source_parent) const
+{
+    QVector<QVariant> values;
+    values.reserve(source_rows.size());
+    int type = QVariant::Invalid;
+    for (int row : qAsConst(source_rows)) {
+        values.append(model->index(row, source_sort_column, source_parent).data(sort_role));
+        const int valueType = values.constLast().userType();
+        if (values.size() == 1)
+            type = valueType;
+        else if (type != valueType)
+            type = QVariant::Invalid;
+    }
+
+    switch (type) {
+    case QVariant::Int:
+    case QVariant::LongLong: {
+        QVector<qint64> keys;
+        keys.reserve(values.size());
+        for (const QVariant &value : qAsConst(values))
+            keys.append(value.toLongLong());
+        qt_sort_rows_by_keys(source_rows, keys, sort_order, std::less<qint64>());
+        break;
+    }
+    case QVariant::UInt:
+    case QVariant::ULongLong: {
+        QVector<quint64> keys;
+        keys.reserve(values.size());
+        for (const QVariant &value : qAsConst(values))
+            keys.append(value.toULongLong());
+        qt_sort_rows_by_keys(source_rows, keys, sort_order, std::less<quint64>());
+        break;
+    }
+    case QMetaType::Float:
+    case QVariant::Double: {
+        QVector<double> keys;
+        keys.reserve(values.size());
+        for (const QVariant &value : qAsConst(values))
+            keys.append(value.toDouble());
+        qt_sort_rows_by_keys(source_rows, keys, sort_order, std::less<double>());
+        break;
+    }
+    case QVariant::String: {
+        QVector<QString> keys;
+        keys.reserve(values.size());
+        for (const QVariant &value : qAsConst(values))
+            keys.append(value.toString());
+        const Qt::CaseSensitivity cs = sort_casesensitivity;
+        if (sort_localeaware) {
+            qt_sort_rows_by_keys(source_rows, keys, sort_order, [](const QString &s1, const QString &s2) {
+                return s1.localeAwareCompare(s2) < 0;
+            });
+        } else {
+            qt_sort_rows_by_keys(source_rows, keys, sort_order, [cs](const QString &s1, const QString &s2) {
+                return s1.compare(s2, cs) < 0;
+            });
+        }
+        break;
+    }
+    default: {
+        const Qt::CaseSensitivity cs = sort_casesensitivity;
+        const bool localeAware = sort_localeaware;
+        qt_sort_rows_by_keys(source_rows, values, sort_order, [cs, localeAware](const QVariant &v1, const QVariant &v2) {
+            return QAbstractItemModelPrivate::isVariantLessThan(v1, v2, cs, localeAware);
+        });
+        break;
+    }
+    }
+}
+
 /*!
   \internal
 
@@ -1110,14 +1221,19 @@ void QSortFilterProxyModelPrivate::filter_about_to_be_changed(const QModelIndex
 
   Updates the proxy model (adds/removes rows) based on the
   new filter.
+
+  If \a filter_narrowed is true, the new filter accepts a subset of
+  the rows accepted by the previous one, so only the rows currently
+  in the proxy need to be checked again.
 */
-void QSortFilterProxyModelPrivate::filter_changed(const QModelIndex &source_parent)
+void QSortFilterProxyModelPrivate::filter_changed(const QModelIndex &source_parent, bool filter_narrowed)
 {
     IndexMap::const_iterator it = source_index_mapping.constFind(source_parent);
     if (it == source_index_mapping.constEnd())
         return;
     Mapping *m = it.value();
-    QSet<int> rows_removed = handle_filter_changed(m->proxy_rows, m->source_rows, source_parent, Qt::Vertical);
+    QSet<int> rows_removed = handle_filter_changed(m->proxy_rows, m->source_rows, source_parent, Qt::Vertical,
+                                                   filter_narrowed);
     QSet<int> columns_removed = handle_filter_changed(m->proxy_columns, m->source_columns, source_parent, Qt::Horizontal);
 
     // We need to iterate over a copy of m->mapped_children because otherwise it may be changed by other code, invalidating
@@ -1132,7 +1248,7 @@ void QSortFilterProxyModelPrivate::filter_changed(const QModelIndex &source_pare
             indexesToRemove.push_back(i);
             remove_from_mapping(source_child_index);
         } else {
-            filter_changed(source_child_index);
+            filter_changed(source_child_index, filter_narrowed);
         }
     }
     QVector<int>::const_iterator removeIt = indexesToRemove.constEnd();
@@ -1149,13 +1265,30 @@ void QSortFilterProxyModelPrivate::filter_changed(const QModelIndex &source_pare
     }
 }
 
+/*!
+  \internal
+
+  Returns true if replacing the current filter with \a regExp can only
+  remove rows from the proxy, which is the case when a fixed string
+  filter is extended, as happens while the user types.
+*/
+bool QSortFilterProxyModelPrivate::is_filter_narrowed_by(const QRegExp &regExp) const
+{
+    if (filter_regexp.patternSyntax() != QRegExp::FixedString
+        || regExp.patternSyntax() != QRegExp::FixedString
+        || filter_regexp.caseSensitivity() != regExp.caseSensitivity()) {
+        return false;
+    }
+    return regExp.pattern().contains(filter_regexp.pattern(), regExp.caseSensitivity());
+}
+
 /*!
   \internal
   returns the removed items indexes
 */
 QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     QVector<int> &source_to_proxy, QVector<int> &proxy_to_source,
-    const QModelIndex &source_parent, Qt::Orientation orient)
+    const QModelIndex &source_parent, Qt::Orientation orient, bool filter_narrowed)
 {
     Q_Q(QSortFilterProxyModel);
     // Figure out which mapped items to remove
@@ -1171,7 +1304,7 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     }
     // Figure out which non-mapped items to insert
     QVector<int> source_items_insert;
-    int source_count = source_to_proxy.size();
+    int source_count = (filter_narrowed && orient == Qt::Vertical) ? 0 : source_to_proxy.size();
     for (int source_item = 0; source_item < source_count; ++source_item) {
         if (source_to_proxy.at(source_item) == -1) {
             if ((orient == Qt::Vertical)
@@ -1832,6 +1965,7 @@ QSortFilterProxyModel::QSortFilterProxyModel(QObject *parent)
     d->sort_casesensitivity = Qt::CaseSensitive;
     d->sort_role = Qt::DisplayRole;
     d->sort_localeaware = false;
+    d->sort_keycaching = false;
     d->filter_column = 0;
     d->filter_role = Qt::DisplayRole;
     d->filter_recursive = false;
@@ -2428,8 +2562,9 @@ void QSortFilterProxyModel::setFilterRegExp(const QRegExp &regExp)
 {
     Q_D(QSortFilterProxyModel);
     d->filter_about_to_be_changed();
+    const bool narrowed = d->is_filter_narrowed_by(regExp);
     d->filter_regexp = regExp;
-    d->filter_changed();
+    d->filter_changed(QModelIndex(), narrowed);
 }
 
 /*!
@@ -2566,15 +2701,24 @@ void QSortFilterProxyModel::setFilterWildcard(const QString &pattern)
     Sets the fixed string used to filter the contents
     of the source model to the given \a pattern.
 
+    If the previous filter was also a fixed string and \a pattern contains
+    it, for instance because the user typed another character, only the
+    rows that are currently accepted are filtered again. A reimplemented
+    filterAcceptsRow() must not accept more rows when the fixed string
+    grows in this way.
+
     \sa setFilterCaseSensitivity(), setFilterRegExp(), setFilterWildcard(), filterRegExp()
 */
 void QSortFilterProxyModel::setFilterFixedString(const QString &pattern)
 {
     Q_D(QSortFilterProxyModel);
     d->filter_about_to_be_changed();
-    d->filter_regexp.setPatternSyntax(QRegExp::FixedString);
-    d->filter_regexp.setPattern(pattern);
-    d->filter_changed();
+    QRegExp regExp = d->filter_regexp;
+    regExp.setPatternSyntax(QRegExp::FixedString);
+    regExp.setPattern(pattern);
+    const bool narrowed = d->is_filter_narrowed_by(regExp);
+    d->filter_regexp = regExp;
+    d->filter_changed(QModelIndex(), narrowed);
 }
 
 /*!
@@ -2682,6 +2826,40 @@ void QSortFilterProxyModel::setRecursiveFilteringEnabled(bool recursive)
     d->filter_changed();
 }
 
+/*!
+    \since 5.11
+    \property QSortFilterProxyModel::sortKeyCachingEnabled
+    \brief whether the sort role data is fetched once per row when sorting
+
+    By default, every comparison made while sorting calls lessThan(), which
+    queries the data of both items from the source model. When this property
+    is enabled, the data of the sort column is fetched once for each row and
+    the rows are sorted by comparing these values directly. For large models
+    this is considerably faster.
+
+    Because lessThan() is not called in this mode, it must only be enabled
+    when lessThan() is not reimplemented, or when the reimplementation is
+    equivalent to comparing the sortRole() data like the default
+    implementation does.
+
+    The default value is false.
+
+    \sa lessThan(), sortRole
+*/
+bool QSortFilterProxyModel::isSortKeyCachingEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->sort_keycaching;
+}
+
+void QSortFilterProxyModel::setSortKeyCachingEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    if (d->sort_keycaching == enable)
+        return;
+    d->sort_keycaching = enable;
+}
+
 /*!
     \obsolete
 
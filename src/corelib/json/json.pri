@@ -4,6 +4,8 @@ HEADERS += \
     json/qjsonobject.h \
     json/qjsonvalue.h \
     json/qjsonarray.h \
+    json/qjsonbuilder.h \
+    json/qjsonstream.h \
     json/qjsonwriter_p.h \
     json/qjsonparser_p.h
 
@@ -12,6 +14,8 @@ SOURCES += \
     json/qjsondocument.cpp \
     json/qjsonobject.cpp \
     json/qjsonarray.cpp \
+    json/qjsonbuilder.cpp \
     json/qjsonvalue.cpp \
+    json/qjsonstream.cpp \
     json/qjsonwriter.cpp \
     json/qjsonparser.cpp
@@ -0,0 +1,739 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonbuilder.h"
+#include "qjsonobject.h"
+#include "qjsonarray.h"
+#include "qjsondocument.h"
+#include "qjson_p.h"
+
+#include <qhash.h>
+#include <qvarlengtharray.h>
+#include <qvector.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonBuilderPrivate
+{
+public:
+    struct Node {
+        QString key;                    // objects only
+        QJsonValue value;               // unless one of the builders below is set
+        QJsonObjectBuilder *object;     // owned
+        QJsonArrayBuilder *array;       // owned
+
+        // set by computeSize(), used by write()
+        int valueSize;
+        bool latinKey;
+        bool latinOrIntValue;
+    };
+
+    explicit QJsonBuilderPrivate(bool object)
+        : isObject(object), indexed(false), size(0)
+    {}
+    ~QJsonBuilderPrivate()
+    {
+        for (const Node &n : qAsConst(nodes))
+            deleteChildren(n);
+    }
+
+    static QJsonBuilderPrivate *get(QJsonBuilderPrivate *&d, bool object)
+    {
+        if (!d)
+            d = new QJsonBuilderPrivate(object);
+        return d;
+    }
+
+    static void deleteChildren(const Node &n)
+    {
+        delete n.object;
+        delete n.array;
+    }
+
+    static void replaceValue(Node &n, const Node &other)
+    {
+        deleteChildren(n);
+        n.value = other.value;
+        n.object = other.object;
+        n.array = other.array;
+    }
+
+    Node &insertNode(const QString &key);
+    Node &appendNode();
+    void ensureIndex();
+    void removeNode(int i);
+
+    void sortMembers();
+    qint64 computeSize();
+    void write(char *dest) const;
+    void writeValue(const Node &n, QJsonPrivate::Value &v, char *base, uint valueOffset) const;
+    QJsonPrivate::Data *freeze();
+
+    QVector<Node> nodes;
+    QHash<QString, int> index;          // key to position in nodes, once indexed
+    QVector<int> order;                 // unique members sorted by key, set by sortMembers()
+    bool isObject;
+    bool indexed;
+    int size;                           // of the binary Base, set by computeSize()
+
+private:
+    Q_DISABLE_COPY(QJsonBuilderPrivate)
+};
+
+Q_DECLARE_TYPEINFO(QJsonBuilderPrivate::Node, Q_MOVABLE_TYPE);
+
+/*
+    Inserting into an object only appends, so that building an object
+    costs no hashing at all. A key inserted more than once is resolved in
+    favor of the last insertion, either when the object is frozen or when
+    contains(), remove() or size() need the index.
+*/
+QJsonBuilderPrivate::Node &QJsonBuilderPrivate::insertNode(const QString &key)
+{
+    if (indexed) {
+        QHash<QString, int>::const_iterator it = index.constFind(key);
+        if (it != index.constEnd()) {
+            Node &n = nodes[*it];
+            deleteChildren(n);
+            n.object = nullptr;
+            n.array = nullptr;
+            n.value = QJsonValue();
+            return n;
+        }
+        index.insert(key, nodes.size());
+    }
+    Node &n = appendNode();
+    n.key = key;
+    return n;
+}
+
+QJsonBuilderPrivate::Node &QJsonBuilderPrivate::appendNode()
+{
+    const Node n = { QString(), QJsonValue(), nullptr, nullptr, 0, false, false };
+    nodes.append(n);
+    return nodes.last();
+}
+
+void QJsonBuilderPrivate::ensureIndex()
+{
+    if (indexed)
+        return;
+    indexed = true;
+    index.reserve(nodes.size());
+    int kept = 0;
+    for (int i = 0; i < nodes.size(); ++i) {
+        QHash<QString, int>::const_iterator it = index.constFind(nodes.at(i).key);
+        if (it != index.constEnd()) {
+            replaceValue(nodes[*it], nodes.at(i));
+            continue;
+        }
+        index.insert(nodes.at(i).key, kept);
+        if (kept != i)
+            nodes[kept] = nodes.at(i);
+        ++kept;
+    }
+    nodes.resize(kept);
+}
+
+void QJsonBuilderPrivate::removeNode(int i)
+{
+    // members are sorted when the builder is frozen, so their order does not matter
+    deleteChildren(nodes.at(i));
+    const int last = nodes.size() - 1;
+    if (i != last) {
+        nodes[i] = nodes.at(last);
+        index[nodes.at(i).key] = i;
+    }
+    nodes.removeLast();
+}
+
+static inline bool keyLessThan(const QString &lhs, const QString &rhs)
+{
+    // the order of QJsonPrivate::String::operator<(), code unit by code unit
+    const ushort *l = reinterpret_cast<const ushort *>(lhs.constData());
+    const ushort *r = reinterpret_cast<const ushort *>(rhs.constData());
+    const int n = qMin(lhs.size(), rhs.size());
+    for (int i = 0; i < n; ++i) {
+        if (l[i] != r[i])
+            return l[i] < r[i];
+    }
+    return lhs.size() < rhs.size();
+}
+
+/*
+    Fills order with the positions of the members in key order, keeping
+    only the last insertion of each key.
+*/
+void QJsonBuilderPrivate::sortMembers()
+{
+    order.resize(nodes.size());
+    for (int i = 0; i < nodes.size(); ++i)
+        order[i] = i;
+
+    const auto lessThan = [this](int lhs, int rhs) {
+        return keyLessThan(nodes.at(lhs).key, nodes.at(rhs).key);
+    };
+    // keys generated in order need no sorting
+    if (!std::is_sorted(order.cbegin(), order.cend(), lessThan))
+        std::stable_sort(order.begin(), order.end(), lessThan);
+
+    if (indexed)
+        return;
+    int kept = 0;
+    for (int i = 0; i < order.size(); ++i) {
+        if (kept && !lessThan(order.at(kept - 1), order.at(i)))
+            order[kept - 1] = order.at(i);  // same key, the later insertion wins
+        else
+            order[kept++] = order.at(i);
+    }
+    order.resize(kept);
+}
+
+/*
+    Computes the size of the binary representation, for every nested
+    builder as well, and caches what write() needs to know about each
+    value. Returns a value of at least Value::MaxSize if the result would
+    be too large.
+*/
+qint64 QJsonBuilderPrivate::computeSize()
+{
+    using namespace QJsonPrivate;
+
+    if (isObject)
+        sortMembers();
+    const int length = isObject ? order.size() : nodes.size();
+
+    qint64 total = sizeof(Base) + qint64(length) * sizeof(offset);
+    for (int i = 0; i < length; ++i) {
+        Node &n = nodes[isObject ? order.at(i) : i];
+        if (n.object || n.array) {
+            QJsonBuilderPrivate *child = n.object ? n.object->d : n.array->d;
+            const qint64 childSize = child ? child->computeSize() : qint64(sizeof(Base));
+            if (childSize >= Value::MaxSize)
+                return Value::MaxSize;
+            n.valueSize = int(childSize);
+            n.latinOrIntValue = false;
+        } else {
+            n.valueSize = Value::requiredStorage(n.value, &n.latinOrIntValue);
+        }
+        total += n.valueSize;
+        if (isObject) {
+            n.latinKey = useCompressed(n.key);
+            total += sizeof(Entry) + qStringSize(n.key, n.latinKey);
+        }
+        if (total >= Value::MaxSize)
+            return Value::MaxSize;
+    }
+    size = int(total);
+    return total;
+}
+
+static void writeEmptyBase(char *dest, bool isObject)
+{
+    QJsonPrivate::Base *b = reinterpret_cast<QJsonPrivate::Base *>(dest);
+    b->size = sizeof(QJsonPrivate::Base);
+    b->_dummy = 0;
+    b->is_object = isObject;
+    b->tableOffset = sizeof(QJsonPrivate::Base);
+}
+
+void QJsonBuilderPrivate::writeValue(const Node &n, QJsonPrivate::Value &v, char *base, uint valueOffset) const
+{
+    using namespace QJsonPrivate;
+
+    v._dummy = 0;
+    if (n.object || n.array) {
+        QJsonBuilderPrivate *child = n.object ? n.object->d : n.array->d;
+        v.type = n.object ? QJsonValue::Object : QJsonValue::Array;
+        v.value = valueOffset;
+        if (child)
+            child->write(base + valueOffset);
+        else
+            writeEmptyBase(base + valueOffset, n.object);
+        return;
+    }
+
+    const QJsonValue::Type t = n.value.type();
+    v.type = t == QJsonValue::Undefined ? QJsonValue::Null : t;
+    v.latinOrIntValue = n.latinOrIntValue;
+    v.value = Value::valueToStore(n.value, valueOffset);
+    if (n.valueSize)
+        Value::copyData(n.value, base + valueOffset, n.latinOrIntValue);
+}
+
+/*
+    Writes the binary representation in one pass, with the object's
+    table sorted by key as QJsonPrivate::Object::indexOf() requires.
+*/
+void QJsonBuilderPrivate::write(char *dest) const
+{
+    using namespace QJsonPrivate;
+
+    const int length = isObject ? order.size() : nodes.size();
+    Base *b = reinterpret_cast<Base *>(dest);
+    b->size = size;
+    b->_dummy = 0;
+    b->is_object = isObject;
+    b->length = length;
+    b->tableOffset = size - length * int(sizeof(offset));
+    offset *table = b->table();
+
+    uint pos = sizeof(Base);
+    if (isObject) {
+        for (int i = 0; i < length; ++i) {
+            const Node &n = nodes.at(order.at(i));
+            table[i] = pos;
+            Entry *e = reinterpret_cast<Entry *>(dest + pos);
+            const uint valueOffset = pos + sizeof(Entry) + qStringSize(n.key, n.latinKey);
+            writeValue(n, e->value, dest, valueOffset);
+            e->value.latinKey = n.latinKey;
+            copyString(dest + pos + sizeof(Entry), n.key, n.latinKey);
+            pos = valueOffset + n.valueSize;
+        }
+    } else {
+        Value *values = reinterpret_cast<Value *>(table);
+        for (int i = 0; i < length; ++i) {
+            const Node &n = nodes.at(i);
+            writeValue(n, values[i], dest, pos);
+            pos += n.valueSize;
+        }
+    }
+    Q_ASSERT(pos == b->tableOffset);
+}
+
+QJsonPrivate::Data *QJsonBuilderPrivate::freeze()
+{
+    using namespace QJsonPrivate;
+
+    const qint64 baseSize = computeSize();
+    if (baseSize >= Value::MaxSize) {
+        qWarning("QJson: Document too large to store in data structure");
+        return nullptr;
+    }
+
+    const int alloc = sizeof(Header) + int(baseSize);
+    char *raw = static_cast<char *>(malloc(alloc));
+    Q_CHECK_PTR(raw);
+    Header *h = reinterpret_cast<Header *>(raw);
+    h->tag = QJsonDocument::BinaryFormatTag;
+    h->version = 1;
+    write(raw + sizeof(Header));
+    return new Data(raw, alloc);
+}
+
+/*!
+    \class QJsonObjectBuilder
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 5.11
+
+    \brief The QJsonObjectBuilder class builds a JSON object efficiently.
+
+    QJsonObject keeps its members in the compact binary representation
+    also used by QJsonDocument::toBinaryData(). That representation is
+    very fast to read and to share, but every insert() has to move the
+    object's sorted table of members, so building a large object one
+    member at a time takes time quadratic in its size. Modifying a member
+    of a nested object also copies the nested object.
+
+    QJsonObjectBuilder is a mutable tree for objects under construction.
+    Members are inserted in constant time, nested objects and arrays are
+    built in place through insertObject() and insertArray(), and the
+    whole tree is converted to a QJsonObject by toObject() in a single
+    pass:
+
+    \code
+    QJsonObjectBuilder builder;
+    for (const Record &record : records) {
+        QJsonObjectBuilder &entry = builder.insertObject(record.id);
+        entry.insert(QStringLiteral("name"), record.name);
+        QJsonArrayBuilder &tags = entry.insertArray(QStringLiteral("tags"));
+        for (const QString &tag : record.tags)
+            tags.append(tag);
+    }
+    QJsonObject object = builder.toObject();
+    \endcode
+
+    As in QJsonObject, inserting a key that already exists replaces its
+    value, and inserting an undefined QJsonValue removes the key.
+
+    QJsonObjectBuilder cannot be copied, but it can be moved, including
+    into another builder with insert().
+
+    \sa QJsonArrayBuilder, QJsonObject
+*/
+
+/*!
+    \fn QJsonObjectBuilder::QJsonObjectBuilder()
+
+    Constructs an empty builder.
+*/
+
+/*!
+    \fn QJsonObjectBuilder::QJsonObjectBuilder(QJsonObjectBuilder &&other)
+
+    Move-constructs a builder from \a other, which becomes empty.
+*/
+
+/*!
+    \fn QJsonObjectBuilder &QJsonObjectBuilder::operator=(QJsonObjectBuilder &&other)
+
+    Move-assigns \a other to this builder.
+*/
+
+/*!
+    \fn void QJsonObjectBuilder::swap(QJsonObjectBuilder &other)
+
+    Swaps this builder with \a other. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    \fn bool QJsonObjectBuilder::isEmpty() const
+
+    Returns \c true if the builder has no members.
+
+    \sa size()
+*/
+
+/*!
+    Destroys the builder and all nested builders.
+*/
+QJsonObjectBuilder::~QJsonObjectBuilder()
+{
+    delete d;
+}
+
+/*!
+    Returns the number of members.
+*/
+int QJsonObjectBuilder::size() const
+{
+    if (!d)
+        return 0;
+    d->ensureIndex();
+    return d->nodes.size();
+}
+
+/*!
+    Reserves space for \a size members.
+*/
+void QJsonObjectBuilder::reserve(int size)
+{
+    QJsonBuilderPrivate::get(d, true)->nodes.reserve(size);
+}
+
+/*!
+    Removes all members.
+*/
+void QJsonObjectBuilder::clear()
+{
+    delete d;
+    d = nullptr;
+}
+
+/*!
+    Returns \c true if the builder has a member called \a key.
+*/
+bool QJsonObjectBuilder::contains(const QString &key) const
+{
+    if (!d)
+        return false;
+    d->ensureIndex();
+    return d->index.contains(key);
+}
+
+/*!
+    Removes the member called \a key, if any. Builders returned by
+    insertObject() or insertArray() for that member are destroyed.
+*/
+void QJsonObjectBuilder::remove(const QString &key)
+{
+    if (!d)
+        return;
+    d->ensureIndex();
+    QHash<QString, int>::iterator it = d->index.find(key);
+    if (it == d->index.end())
+        return;
+    const int i = *it;
+    d->index.erase(it);
+    d->removeNode(i);
+}
+
+/*!
+    Inserts a member with the key \a key and the value \a value,
+    replacing any existing member with that key. If \a value is
+    \l{QJsonValue::Undefined}{undefined}, the member is removed instead.
+
+    Objects and arrays passed as QJsonValue are shared, and copied into
+    the result only once, by toObject().
+*/
+void QJsonObjectBuilder::insert(const QString &key, const QJsonValue &value)
+{
+    if (value.isUndefined()) {
+        remove(key);
+        return;
+    }
+    QJsonBuilderPrivate::get(d, true)->insertNode(key).value = value;
+}
+
+/*!
+    \overload
+
+    Inserts a member with the key \a key whose value is the object being
+    built by \a object. \a object is moved into this builder.
+*/
+void QJsonObjectBuilder::insert(const QString &key, QJsonObjectBuilder &&object)
+{
+    QJsonBuilderPrivate::get(d, true)->insertNode(key).object = new QJsonObjectBuilder(std::move(object));
+}
+
+/*!
+    \overload
+
+    Inserts a member with the key \a key whose value is the array being
+    built by \a array. \a array is moved into this builder.
+*/
+void QJsonObjectBuilder::insert(const QString &key, QJsonArrayBuilder &&array)
+{
+    QJsonBuilderPrivate::get(d, true)->insertNode(key).array = new QJsonArrayBuilder(std::move(array));
+}
+
+/*!
+    Inserts a member with the key \a key whose value is a new, empty
+    object, and returns a builder for that object. The returned reference
+    stays valid until the member is replaced or removed, or this builder
+    is destroyed or cleared.
+*/
+QJsonObjectBuilder &QJsonObjectBuilder::insertObject(const QString &key)
+{
+    QJsonObjectBuilder *object = new QJsonObjectBuilder;
+    QJsonBuilderPrivate::get(d, true)->insertNode(key).object = object;
+    return *object;
+}
+
+/*!
+    Inserts a member with the key \a key whose value is a new, empty
+    array, and returns a builder for that array. The returned reference
+    stays valid until the member is replaced or removed, or this builder
+    is destroyed or cleared.
+*/
+QJsonArrayBuilder &QJsonObjectBuilder::insertArray(const QString &key)
+{
+    QJsonArrayBuilder *array = new QJsonArrayBuilder;
+    QJsonBuilderPrivate::get(d, true)->insertNode(key).array = array;
+    return *array;
+}
+
+/*!
+    Converts the builder and all nested builders to a QJsonObject. The
+    builder is left unchanged.
+
+    Returns an empty object if the result would exceed the size limit of
+    the binary JSON representation.
+*/
+QJsonObject QJsonObjectBuilder::toObject() const
+{
+    if (!d)
+        return QJsonObject();
+    QJsonPrivate::Data *data = d->freeze();
+    if (!data)
+        return QJsonObject();
+    return data->toObject(static_cast<QJsonPrivate::Object *>(data->header->root()));
+}
+
+/*!
+    \class QJsonArrayBuilder
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 5.11
+
+    \brief The QJsonArrayBuilder class builds a JSON array efficiently.
+
+    QJsonArrayBuilder is the array counterpart of QJsonObjectBuilder.
+    Values are appended in constant time, nested objects and arrays are
+    built in place through appendObject() and appendArray(), and
+    toArray() converts the whole tree to a QJsonArray in a single pass.
+
+    \sa QJsonObjectBuilder, QJsonArray
+*/
+
+/*!
+    \fn QJsonArrayBuilder::QJsonArrayBuilder()
+
+    Constructs an empty builder.
+*/
+
+/*!
+    \fn QJsonArrayBuilder::QJsonArrayBuilder(QJsonArrayBuilder &&other)
+
+    Move-constructs a builder from \a other, which becomes empty.
+*/
+
+/*!
+    \fn QJsonArrayBuilder &QJsonArrayBuilder::operator=(QJsonArrayBuilder &&other)
+
+    Move-assigns \a other to this builder.
+*/
+
+/*!
+    \fn void QJsonArrayBuilder::swap(QJsonArrayBuilder &other)
+
+    Swaps this builder with \a other. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    \fn bool QJsonArrayBuilder::isEmpty() const
+
+    Returns \c true if the builder has no elements.
+
+    \sa size()
+*/
+
+/*!
+    Destroys the builder and all nested builders.
+*/
+QJsonArrayBuilder::~QJsonArrayBuilder()
+{
+    delete d;
+}
+
+/*!
+    Returns the number of elements.
+*/
+int QJsonArrayBuilder::size() const
+{
+    return d ? d->nodes.size() : 0;
+}
+
+/*!
+    Reserves space for \a size elements.
+*/
+void QJsonArrayBuilder::reserve(int size)
+{
+    QJsonBuilderPrivate::get(d, false)->nodes.reserve(size);
+}
+
+/*!
+    Removes all elements.
+*/
+void QJsonArrayBuilder::clear()
+{
+    delete d;
+    d = nullptr;
+}
+
+/*!
+    Appends \a value. As in QJsonArray, an undefined value is stored as
+    null.
+*/
+void QJsonArrayBuilder::append(const QJsonValue &value)
+{
+    QJsonBuilderPrivate::get(d, false)->appendNode().value = value;
+}
+
+/*!
+    \overload
+
+    Appends the object being built by \a object, which is moved into this
+    builder.
+*/
+void QJsonArrayBuilder::append(QJsonObjectBuilder &&object)
+{
+    QJsonBuilderPrivate::get(d, false)->appendNode().object = new QJsonObjectBuilder(std::move(object));
+}
+
+/*!
+    \overload
+
+    Appends the array being built by \a array, which is moved into this
+    builder.
+*/
+void QJsonArrayBuilder::append(QJsonArrayBuilder &&array)
+{
+    QJsonBuilderPrivate::get(d, false)->appendNode().array = new QJsonArrayBuilder(std::move(array));
+}
+
+/*!
+    Appends a new, empty object and returns a builder for it. The
+    returned reference stays valid until this builder is destroyed or
+    cleared.
+*/
+QJsonObjectBuilder &QJsonArrayBuilder::appendObject()
+{
+    QJsonObjectBuilder *object = new QJsonObjectBuilder;
+    QJsonBuilderPrivate::get(d, false)->appendNode().object = object;
+    return *object;
+}
+
+/*!
+    Appends a new, empty array and returns a builder for it. The returned
+    reference stays valid until this builder is destroyed or cleared.
+*/
+QJsonArrayBuilder &QJsonArrayBuilder::appendArray()
+{
+    QJsonArrayBuilder *array = new QJsonArrayBuilder;
+    QJsonBuilderPrivate::get(d, false)->appendNode().array = array;
+    return *array;
+}
+
+/*!
+    Converts the builder and all nested builders to a QJsonArray. The
+    builder is left unchanged.
+
+    Returns an empty array if the result would exceed the size limit of
+    the binary JSON representation.
+*/
+QJsonArray QJsonArrayBuilder::toArray() const
+{
+    if (!d)
+        return QJsonArray();
+    QJsonPrivate::Data *data = d->freeze();
+    if (!data)
+        return QJsonArray();
+    return data->toArray(static_cast<QJsonPrivate::Array *>(data->header->root()));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QJSONBUILDER_H
+#define QJSONBUILDER_H
+
+#include <QtCore/qjsonvalue.h>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonArrayBuilder;
+class QJsonBuilderPrivate;
+
+class Q_CORE_EXPORT QJsonObjectBuilder
+{
+public:
+    QJsonObjectBuilder() Q_DECL_NOTHROW : d(nullptr) {}
+    ~QJsonObjectBuilder();
+
+    QJsonObjectBuilder(QJsonObjectBuilder &&other) Q_DECL_NOTHROW
+        : d(other.d)
+    { other.d = nullptr; }
+    QJsonObjectBuilder &operator=(QJsonObjectBuilder &&other) Q_DECL_NOTHROW
+    { swap(other); return *this; }
+
+    void swap(QJsonObjectBuilder &other) Q_DECL_NOTHROW
+    { qSwap(d, other.d); }
+
+    int size() const;
+    inline bool isEmpty() const { return size() == 0; }
+    void reserve(int size);
+    void clear();
+
+    bool contains(const QString &key) const;
+    void remove(const QString &key);
+
+    void insert(const QString &key, const QJsonValue &value);
+    void insert(const QString &key, QJsonObjectBuilder &&object);
+    void insert(const QString &key, QJsonArrayBuilder &&array);
+    QJsonObjectBuilder &insertObject(const QString &key);
+    QJsonArrayBuilder &insertArray(const QString &key);
+
+    QJsonObject toObject() const;
+
+private:
+    Q_DISABLE_COPY(QJsonObjectBuilder)
+    friend class QJsonBuilderPrivate;
+    QJsonBuilderPrivate *d;
+};
+
+class Q_CORE_EXPORT QJsonArrayBuilder
+{
+public:
+    QJsonArrayBuilder() Q_DECL_NOTHROW : d(nullptr) {}
+    ~QJsonArrayBuilder();
+
+    QJsonArrayBuilder(QJsonArrayBuilder &&other) Q_DECL_NOTHROW
+        : d(other.d)
+    { other.d = nullptr; }
+    QJsonArrayBuilder &operator=(QJsonArrayBuilder &&other) Q_DECL_NOTHROW
+    { swap(other); return *this; }
+
+    void swap(QJsonArrayBuilder &other) Q_DECL_NOTHROW
+    { qSwap(d, other.d); }
+
+    int size() const;
+    inline bool isEmpty() const { return size() == 0; }
+    void reserve(int size);
+    void clear();
+
+    void append(const QJsonValue &value);
+    void append(QJsonObjectBuilder &&object);
+    void append(QJsonArrayBuilder &&array);
+    QJsonObjectBuilder &appendObject();
+    QJsonArrayBuilder &appendArray();
+
+    QJsonArray toArray() const;
+
+private:
+    Q_DISABLE_COPY(QJsonArrayBuilder)
+    friend class QJsonBuilderPrivate;
+    QJsonBuilderPrivate *d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONBUILDER_H
@@ -70,7 +70,11 @@ QT_BEGIN_NAMESPACE
 
     You can convert the object to and from text based JSON through QJsonDocument.
 
-    \sa {JSON Support in Qt}, {JSON Save Game Example}
+    Every insert() moves the object's sorted table of keys. To build an object
+    with many members, use QJsonObjectBuilder and convert the result with
+    QJsonObjectBuilder::toObject().
+
+    \sa {JSON Support in Qt}, {JSON Save Game Example}, QJsonObjectBuilder
 */
 
 /*!
@@ -45,6 +45,7 @@
 #include "qjsonparser_p.h"
 #include "qjson_p.h"
 #include "private/qutfcodec_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -195,6 +196,8 @@ QString QJsonParseError::errorString() const
 #endif
 }
 
+void qt_from_latin1(ushort *dst, const char *str, size_t size) Q_DECL_NOTHROW;
+
 using namespace QJsonPrivate;
 
 Parser::Parser(const char *json, int length)
@@ -256,8 +259,32 @@ void Parser::eatBOM()
         json += 3;
 }
 
+static inline bool isJsonSpace(char c)
+{
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
 bool Parser::eatSpace()
 {
+#ifdef __SSE2__
+    // indentation comes in runs, skip it 16 bytes at a time
+    if (json < end && isJsonSpace(*json)) {
+        const __m128i space = _mm_set1_epi8(Space);
+        const __m128i tab = _mm_set1_epi8(Tab);
+        const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+        const __m128i ret = _mm_set1_epi8(Return);
+        for ( ; end - json >= 16; json += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+            const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                                            _mm_or_si128(_mm_cmpeq_epi8(chunk, lineFeed), _mm_cmpeq_epi8(chunk, ret)));
+            const uint mask = ~uint(_mm_movemask_epi8(ws)) & 0xffffu;
+            if (mask) {
+                json += qCountTrailingZeroBits(mask);
+                return true;
+            }
+        }
+    }
+#endif
     while (json < end) {
         if (*json > Space)
             break;
@@ -897,6 +924,43 @@ static inline bool scanEscapeSequence(const char *&json, const char *end, uint *
     return true;
 }
 
+// characters that can be copied from the input as they are
+static inline bool isPlainAscii(char c)
+{
+    return uchar(c) < 0x80 && c != '"' && c != '\\';
+}
+
+// returns the end of the run of plain ASCII characters starting at json
+static inline const char *scanPlainAscii(const char *json, const char *end)
+{
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for ( ; end - json >= 16; json += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        // the sign bit is set for non-ASCII bytes as well as for matches
+        const uint mask = _mm_movemask_epi8(_mm_or_si128(chunk, special));
+        if (mask)
+            return json + qCountTrailingZeroBits(mask);
+    }
+#endif
+    while (json < end && isPlainAscii(*json))
+        ++json;
+    return json;
+}
+
+static inline void widenAscii(char *dest, const char *src, int length)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    qt_from_latin1(reinterpret_cast<ushort *>(dest), src, size_t(length));
+#else
+    QJsonPrivate::qle_ushort *d = reinterpret_cast<QJsonPrivate::qle_ushort *>(dest);
+    for (int i = 0; i < length; ++i)
+        d[i] = uchar(src[i]);
+#endif
+}
+
 static inline bool scanUtf8Char(const char *&json, const char *end, uint *result)
 {
     const uchar *&src = reinterpret_cast<const uchar *&>(json);
@@ -927,6 +991,22 @@ bool Parser::parseString(bool *latin1)
 
     BEGIN << "parse string stringPos=" << stringPos << json;
     while (json < end) {
+        if (isPlainAscii(*json)) {
+            // copy runs of ASCII in one go; overlong strings are stored as UTF-16
+            const char *run = scanPlainAscii(json, qMin(end, start + 0x8000));
+            const int length = int(run - json);
+            int pos = reserveSpace(length);
+            if (pos < 0)
+                return false;
+            memcpy(data + pos, json, length);
+            json = run;
+            if (json - start >= 0x8000) {
+                *latin1 = false;
+                break;
+            }
+            continue;
+        }
+
         uint ch = 0;
         if (*json == '"')
             break;
@@ -979,6 +1059,17 @@ bool Parser::parseString(bool *latin1)
     current = outStart + sizeof(int);
 
     while (json < end) {
+        if (isPlainAscii(*json)) {
+            const char *run = scanPlainAscii(json, end);
+            const int length = int(run - json);
+            int pos = reserveSpace(2 * length);
+            if (pos < 0)
+                return false;
+            widenAscii(data + pos, json, length);
+            json = run;
+            continue;
+        }
+
         uint ch = 0;
         if (*json == '"')
             break;
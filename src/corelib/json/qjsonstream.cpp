@@ -0,0 +1,1498 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstream.h"
+#include "qjsonarray.h"
+#include "qjsonobject.h"
+#include "qjsondocument.h"
+#include "qjsonwriter_p.h"
+
+#include <qcoreapplication.h>
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+#include <private/qutfcodec_p.h>
+
+QT_BEGIN_NAMESPACE
+
+static const int nestingLimit = 1024;
+static const int readChunkSize = 16384;
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum State {
+        TopLevel,       // between top-level values
+        ObjectStart,    // after '{': a name or '}'
+        ObjectName,     // after ',' in an object: a name
+        ObjectValue,    // after "name": the member value
+        ObjectNext,     // after a member: ',' or '}'
+        ArrayStart,     // after '[': a value or ']'
+        ArrayValue,     // after ',' in an array: a value
+        ArrayNext       // after an element: ',' or ']'
+    };
+
+    enum Result {
+        TokenRead,
+        NeedMoreData,
+        Failed
+    };
+
+    QJsonStreamReaderPrivate()
+    {
+        init();
+    }
+
+    void init();
+    void compact();
+    bool fillBuffer();
+
+    Result readToken(bool endOfInput);
+    Result readValue(bool endOfInput);
+    Result readName();
+    Result readString(const char *p, const char **next, QString *out);
+    Result readNumber(bool endOfInput);
+    Result readLiteral(const char *literal, int length, QJsonStreamReader::TokenType literalType);
+    Result endContainer(QJsonStreamReader::TokenType endType);
+
+    void finishValue()
+    {
+        if (containers.isEmpty())
+            state = TopLevel;
+        else
+            state = containers.last() == '{' ? ObjectNext : ArrayNext;
+    }
+
+    void raiseParseError(QJsonParseError::ParseError parseError, const char *where);
+
+    QIODevice *device;
+    QByteArray buffer;
+    int pos;                    // first unconsumed byte in buffer
+    qint64 bufferOffset;        // stream offset of buffer[0]
+    QVarLengthArray<char, 64> containers;
+    State state;
+    bool bomChecked;
+
+    QJsonStreamReader::TokenType type;
+    QString name;
+    QString string;
+    double number;
+    bool boolean;
+
+    QJsonStreamReader::Error error;
+    QString errorString;
+};
+
+void QJsonStreamReaderPrivate::init()
+{
+    buffer.clear();
+    pos = 0;
+    bufferOffset = 0;
+    containers.clear();
+    state = TopLevel;
+    bomChecked = false;
+    type = QJsonStreamReader::NoToken;
+    name.clear();
+    string.clear();
+    number = 0;
+    boolean = false;
+    error = QJsonStreamReader::NoError;
+    errorString.clear();
+}
+
+/*
+    Drops the bytes that have been consumed already, so that the buffer
+    never holds more than the token being read plus one chunk of input.
+*/
+void QJsonStreamReaderPrivate::compact()
+{
+    if (!pos)
+        return;
+    const int remaining = buffer.size() - pos;
+    if (remaining)
+        memmove(buffer.data(), buffer.constData() + pos, remaining);
+    buffer.resize(remaining);
+    bufferOffset += pos;
+    pos = 0;
+}
+
+bool QJsonStreamReaderPrivate::fillBuffer()
+{
+    if (!device)
+        return false;
+    compact();
+
+    // grow geometrically, so that a single huge token is not rescanned once per chunk
+    const int oldSize = buffer.size();
+    const int chunkSize = qMax(readChunkSize, oldSize);
+    if (buffer.capacity() < oldSize + chunkSize)
+        buffer.reserve(oldSize + chunkSize);
+    buffer.resize(oldSize + chunkSize);
+    const qint64 bytesRead = device->read(buffer.data() + oldSize, chunkSize);
+    buffer.resize(oldSize + int(qMax(bytesRead, Q_INT64_C(0))));
+    return bytesRead > 0;
+}
+
+void QJsonStreamReaderPrivate::raiseParseError(QJsonParseError::ParseError parseError, const char *where)
+{
+    QJsonParseError e;
+    e.offset = int(bufferOffset + (where - buffer.constData()));
+    e.error = parseError;
+    type = QJsonStreamReader::Invalid;
+    error = QJsonStreamReader::NotWellFormedError;
+    errorString = e.errorString();
+}
+
+static inline bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/*
+    Reads the next token starting at pos. Nothing but whitespace and
+    separators is consumed unless a complete token is available, so a
+    NeedMoreData result can be retried once more input has arrived.
+*/
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::readToken(bool endOfInput)
+{
+    const char *begin = buffer.constData();
+    const char *end = begin + buffer.size();
+
+    if (!bomChecked) {
+        const int available = qMin(3, int(end - begin - pos));
+        if (memcmp(begin + pos, "\xef\xbb\xbf", available) == 0) {
+            if (available < 3 && !endOfInput)
+                return NeedMoreData;
+            if (available == 3)
+                pos += 3;
+        }
+        bomChecked = true;
+    }
+
+    forever {
+        const char *p = begin + pos;
+        while (p < end && isJsonSpace(*p))
+            ++p;
+        pos = int(p - begin);
+
+        if (p == end) {
+            if (state == TopLevel && endOfInput) {
+                type = QJsonStreamReader::EndDocument;
+                return TokenRead;
+            }
+            return NeedMoreData;
+        }
+
+        switch (state) {
+        case TopLevel:
+        case ObjectValue:
+        case ArrayValue:
+            return readValue(endOfInput);
+        case ArrayStart:
+            if (*p == ']')
+                return endContainer(QJsonStreamReader::EndArray);
+            return readValue(endOfInput);
+        case ArrayNext:
+            if (*p == ',') {
+                ++pos;
+                state = ArrayValue;
+                continue;
+            }
+            if (*p == ']')
+                return endContainer(QJsonStreamReader::EndArray);
+            raiseParseError(QJsonParseError::MissingValueSeparator, p);
+            return Failed;
+        case ObjectStart:
+            if (*p == '}')
+                return endContainer(QJsonStreamReader::EndObject);
+            Q_FALLTHROUGH();
+        case ObjectName:
+            if (*p == '"')
+                return readName();
+            raiseParseError(*p == '}' ? QJsonParseError::MissingObject
+                                      : QJsonParseError::UnterminatedObject, p);
+            return Failed;
+        case ObjectNext:
+            if (*p == ',') {
+                ++pos;
+                state = ObjectName;
+                continue;
+            }
+            if (*p == '}')
+                return endContainer(QJsonStreamReader::EndObject);
+            raiseParseError(QJsonParseError::UnterminatedObject, p);
+            return Failed;
+        }
+    }
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::endContainer(QJsonStreamReader::TokenType endType)
+{
+    ++pos;
+    containers.removeLast();
+    type = endType;
+    finishValue();
+    return TokenRead;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::readValue(bool endOfInput)
+{
+    const char *begin = buffer.constData();
+    const char *p = begin + pos;
+
+    switch (*p) {
+    case '{':
+    case '[':
+        if (containers.size() >= nestingLimit) {
+            raiseParseError(QJsonParseError::DeepNesting, p);
+            return Failed;
+        }
+        containers.append(*p);
+        ++pos;
+        if (*p == '{') {
+            type = QJsonStreamReader::StartObject;
+            state = ObjectStart;
+        } else {
+            type = QJsonStreamReader::StartArray;
+            state = ArrayStart;
+        }
+        return TokenRead;
+    case '"': {
+        const char *next;
+        QString s;
+        const Result result = readString(p + 1, &next, &s);
+        if (result != TokenRead)
+            return result;
+        pos = int(next - begin);
+        string = std::move(s);
+        type = QJsonStreamReader::String;
+        finishValue();
+        return TokenRead;
+    }
+    case 't':
+        boolean = true;
+        return readLiteral("true", 4, QJsonStreamReader::Bool);
+    case 'f':
+        boolean = false;
+        return readLiteral("false", 5, QJsonStreamReader::Bool);
+    case 'n':
+        return readLiteral("null", 4, QJsonStreamReader::Null);
+    case '}':
+    case ']':
+        raiseParseError(QJsonParseError::MissingObject, p);
+        return Failed;
+    default:
+        if (*p == '-' || (*p >= '0' && *p <= '9'))
+            return readNumber(endOfInput);
+        raiseParseError(QJsonParseError::IllegalValue, p);
+        return Failed;
+    }
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::readLiteral(const char *literal, int length,
+                                                                       QJsonStreamReader::TokenType literalType)
+{
+    const char *p = buffer.constData() + pos;
+    const int available = qMin(length, buffer.size() - pos);
+    if (memcmp(p, literal, available) != 0) {
+        raiseParseError(QJsonParseError::IllegalValue, p);
+        return Failed;
+    }
+    if (available < length)
+        return NeedMoreData;
+    pos += length;
+    type = literalType;
+    finishValue();
+    return TokenRead;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::readNumber(bool endOfInput)
+{
+    const char *start = buffer.constData() + pos;
+    const char *end = buffer.constData() + buffer.size();
+    const char *p = start;
+
+    // same grammar as QJsonPrivate::Parser::parseNumber()
+    if (p < end && *p == '-')
+        ++p;
+    if (p < end && *p == '0') {
+        ++p;
+    } else {
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        if (p < end && (*p == '-' || *p == '+'))
+            ++p;
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+    }
+
+    // a number can only be terminated by the end of input at the top level
+    if (p == end && !(endOfInput && containers.isEmpty()))
+        return NeedMoreData;
+
+    bool ok;
+    const double d = QByteArray::fromRawData(start, int(p - start)).toDouble(&ok);
+    if (!ok) {
+        raiseParseError(QJsonParseError::IllegalNumber, start);
+        return Failed;
+    }
+    pos = int(p - buffer.constData());
+    number = d;
+    type = QJsonStreamReader::Number;
+    finishValue();
+    return TokenRead;
+}
+
+static inline bool addHexDigit(char digit, uint *result)
+{
+    *result <<= 4;
+    if (digit >= '0' && digit <= '9')
+        *result |= (digit - '0');
+    else if (digit >= 'a' && digit <= 'f')
+        *result |= (digit - 'a') + 10;
+    else if (digit >= 'A' && digit <= 'F')
+        *result |= (digit - 'A') + 10;
+    else
+        return false;
+    return true;
+}
+
+// same rules as scanEscapeSequence() in qjsonparser.cpp
+static inline bool scanEscapeSequence(const char *&json, const char *end, ushort *ch)
+{
+    ++json;
+    if (json >= end)
+        return false;
+
+    const char escaped = *json++;
+    switch (escaped) {
+    case 'b':
+        *ch = 0x8; break;
+    case 'f':
+        *ch = 0xc; break;
+    case 'n':
+        *ch = 0xa; break;
+    case 'r':
+        *ch = 0xd; break;
+    case 't':
+        *ch = 0x9; break;
+    case 'u': {
+        if (json > end - 4)
+            return false;
+        uint u = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (!addHexDigit(*json, &u))
+                return false;
+            ++json;
+        }
+        *ch = ushort(u);
+        break;
+    }
+    default:
+        // '"', '\\' and '/', plus anything else, taken literally
+        *ch = uchar(escaped);
+        break;
+    }
+    return true;
+}
+
+/*
+    Decodes the string starting after the opening quote at \a p. The
+    closing quote is located first, so that a string split across
+    chunks is reported as NeedMoreData without decoding anything.
+*/
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::readString(const char *p, const char **next, QString *out)
+{
+    const char *end = buffer.constData() + buffer.size();
+    const char *q = p;
+    while (q < end && *q != '"') {
+        if (*q == '\\' && ++q == end)
+            break;
+        ++q;
+    }
+    if (q >= end)
+        return NeedMoreData;
+
+    // every input byte produces at most one UTF-16 code unit
+    QString s(int(q - p), Qt::Uninitialized);
+    ushort *dst = reinterpret_cast<ushort *>(s.data());
+    const char *src = p;
+    while (src < q) {
+        const uchar b = uchar(*src);
+        if (b < 0x80 && b != '\\') {
+            *dst++ = b;
+            ++src;
+        } else if (b == '\\') {
+            const char *escape = src;
+            if (!scanEscapeSequence(src, q, dst++)) {
+                raiseParseError(QJsonParseError::IllegalEscapeSequence, escape);
+                return Failed;
+            }
+        } else {
+            const uchar *usrc = reinterpret_cast<const uchar *>(src) + 1;
+            if (QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, usrc, reinterpret_cast<const uchar *>(q)) < 0) {
+                raiseParseError(QJsonParseError::IllegalUTF8String, src);
+                return Failed;
+            }
+            src = reinterpret_cast<const char *>(usrc);
+        }
+    }
+    s.resize(int(dst - reinterpret_cast<const ushort *>(s.constData())));
+
+    *next = q + 1;
+    *out = std::move(s);
+    return TokenRead;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::readName()
+{
+    const char *begin = buffer.constData();
+    const char *end = begin + buffer.size();
+    const char *p;
+    QString s;
+    const Result result = readString(begin + pos + 1, &p, &s);
+    if (result != TokenRead)
+        return result;
+
+    while (p < end && isJsonSpace(*p))
+        ++p;
+    if (p == end)
+        return NeedMoreData;
+    if (*p != ':') {
+        raiseParseError(QJsonParseError::MissingNameSeparator, p);
+        return Failed;
+    }
+
+    pos = int(p + 1 - begin);
+    name = std::move(s);
+    type = QJsonStreamReader::Name;
+    state = ObjectValue;
+    return TokenRead;
+}
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 5.11
+
+    \brief The QJsonStreamReader class provides a fast pull parser for
+    reading JSON incrementally.
+
+    QJsonStreamReader reads JSON from a QIODevice, or from chunks of data
+    passed to addData(), one token at a time. Unlike
+    QJsonDocument::fromJson(), it never holds more than the token being
+    read plus one chunk of input in memory, which makes it suitable for
+    very large documents and for feeds of newline-delimited JSON values
+    (JSON Lines). Any number of values may follow each other at the top
+    level; EndDocument is reported when the input is exhausted between
+    two of them.
+
+    The basic loop mirrors QXmlStreamReader:
+
+    \code
+    QJsonStreamReader reader(&file);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isName() && reader.name() == QLatin1String("id"))
+            handleId(reader.readValue());
+    }
+    if (reader.hasError())
+        qWarning() << reader.errorString();
+    \endcode
+
+    readValue() reads the current value, including any nested objects and
+    arrays, into a QJsonValue, and skipValue() steps over it without
+    building one. Both can be combined freely with readNext(), so that an
+    application parses just the records it is interested in.
+
+    If the input runs out in the middle of a value, the reader reports a
+    PrematureEndOfDocumentError. This error is recoverable: after more data
+    has been made available, either through addData() or by the device
+    receiving it, the next call to readNext() continues where the previous
+    one left off.
+
+    The reader accepts the same syntax as QJsonDocument::fromJson(),
+    including its nesting limit, and reports syntax errors with the same
+    messages.
+
+    \sa QJsonStreamWriter, QJsonDocument, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken The reader has not yet read anything.
+    \value Invalid An error has occurred, reported in error() and errorString().
+    \value StartObject The reader reports the start of an object.
+    \value EndObject The reader reports the end of an object.
+    \value StartArray The reader reports the start of an array.
+    \value EndArray The reader reports the end of an array.
+    \value Name The reader reports the name of an object member; the name is
+        available through name().
+    \value String The reader reports a string value.
+    \value Number The reader reports a number.
+    \value Bool The reader reports \c true or \c false.
+    \value Null The reader reports \c null.
+    \value EndDocument The input is exhausted between two top-level values.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies different error cases.
+
+    \value NoError No error has occurred.
+    \value CustomError A custom error has been raised with raiseError().
+    \value NotWellFormedError The parser internally raised an error due to
+        the read JSON not being well-formed.
+    \value PrematureEndOfDocumentError The input ended in the middle of a
+        value. More data can be added with addData(), or by the device,
+        and reading resumes with the next call to readNext().
+*/
+
+/*!
+    Constructs a stream reader without any input.
+
+    \sa setDevice(), addData()
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+    d_ptr->device = 0;
+}
+
+/*!
+    Creates a new stream reader that reads from \a device.
+
+    \sa setDevice(), clear()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+    d_ptr->device = device;
+}
+
+/*!
+    Creates a new stream reader that reads from \a data.
+
+    \sa addData(), clear(), setDevice()
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+    d_ptr->device = 0;
+    d_ptr->buffer = data;
+}
+
+/*!
+    Destructs the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device. Setting the device resets the
+    stream to its initial state.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    Q_D(QJsonStreamReader);
+    d->init();
+    d->device = device;
+}
+
+/*!
+    Returns the current device associated with the QJsonStreamReader, or
+    \nullptr if no device has been assigned.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->device;
+}
+
+/*!
+    Adds more \a data for the reader to read. This function does nothing
+    if the reader has a device().
+
+    \sa readNext(), clear()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    Q_D(QJsonStreamReader);
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->compact();
+    d->buffer += data;
+}
+
+/*!
+    Removes any device() or data from the reader and resets its internal
+    state to the initial state.
+
+    \sa addData()
+*/
+void QJsonStreamReader::clear()
+{
+    Q_D(QJsonStreamReader);
+    d->init();
+    d->device = 0;
+}
+
+/*!
+    Returns \c true if the reader has read until the end of the available
+    input, or if an error() has occurred and reading has been aborted.
+    Otherwise, it returns \c false.
+
+    When atEnd() and hasError() return true and error() returns
+    PrematureEndOfDocumentError, the JSON has been well-formed so far but
+    a value is incomplete; reading resumes once more data is available.
+    When atEnd() returns true and tokenType() is EndDocument, more
+    top-level values may still follow if more data becomes available.
+
+    \sa hasError(), error(), device(), QIODevice::atEnd()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == EndDocument || d->error != NoError;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    With one exception, once an error() is reported by readNext(),
+    further reading of the JSON stream is not possible. Then atEnd()
+    returns \c true, hasError() returns \c true, and this function returns
+    QJsonStreamReader::Invalid.
+
+    The exception is when error() returns PrematureEndOfDocumentError.
+    This error is reported when the end of the input is reached in the
+    middle of a value. Calling this function again after more data has
+    become available continues with the incomplete value.
+
+    \sa tokenType(), tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    Q_D(QJsonStreamReader);
+    if (d->error == PrematureEndOfDocumentError) {
+        d->error = NoError;
+        d->errorString.clear();
+    } else if (d->error != NoError) {
+        return Invalid;
+    }
+
+    bool endOfInput = false;
+    forever {
+        switch (d->readToken(endOfInput)) {
+        case QJsonStreamReaderPrivate::TokenRead:
+        case QJsonStreamReaderPrivate::Failed:
+            return d->type;
+        case QJsonStreamReaderPrivate::NeedMoreData:
+            if (d->fillBuffer())
+                break;
+            if (endOfInput) {
+                d->type = Invalid;
+                d->error = PrematureEndOfDocumentError;
+                d->errorString = QCoreApplication::translate("QJsonStreamReader", "Premature end of document.");
+                return Invalid;
+            }
+            // give tokens that may end with the input (top-level numbers) a chance
+            endOfInput = true;
+            break;
+        }
+    }
+}
+
+/*!
+    Returns the type of the current token.
+
+    The current token can also be queried with the convenience functions
+    isStartObject(), isEndObject(), isStartArray(), isEndArray(), isName(),
+    isString(), isNumber(), isBool(), isNull() and isEndDocument().
+
+    \sa tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type;
+}
+
+/*!
+    Returns the reader's current token as string.
+
+    \sa tokenType()
+*/
+QString QJsonStreamReader::tokenString() const
+{
+    static const char tokenNames[] =
+        "NoToken\0Invalid\0StartObject\0EndObject\0StartArray\0EndArray\0"
+        "Name\0String\0Number\0Bool\0Null\0EndDocument\0";
+    static const short tokenNameOffsets[] = {
+        0, 8, 16, 28, 38, 49, 58, 63, 70, 77, 82, 87
+    };
+    Q_D(const QJsonStreamReader);
+    return QLatin1String(tokenNames + tokenNameOffsets[d->type]);
+}
+
+/*!
+    \fn bool QJsonStreamReader::isStartObject() const
+
+    Returns \c true if tokenType() equals \l StartObject; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndObject() const
+
+    Returns \c true if tokenType() equals \l EndObject; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isStartArray() const
+
+    Returns \c true if tokenType() equals \l StartArray; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndArray() const
+
+    Returns \c true if tokenType() equals \l EndArray; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isName() const
+
+    Returns \c true if tokenType() equals \l Name; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isString() const
+
+    Returns \c true if tokenType() equals \l String; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNumber() const
+
+    Returns \c true if tokenType() equals \l Number; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isBool() const
+
+    Returns \c true if tokenType() equals \l Bool; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNull() const
+
+    Returns \c true if tokenType() equals \l Null; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndDocument() const
+
+    Returns \c true if tokenType() equals \l EndDocument; otherwise
+    returns \c false.
+*/
+
+/*!
+    Returns the number of objects and arrays the current token is nested
+    in. StartObject and StartArray tokens count themselves, EndObject and
+    EndArray tokens do not.
+*/
+int QJsonStreamReader::depth() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->containers.size();
+}
+
+/*!
+    Returns the name of the most recently read object member. The name
+    stays available while the member's value is being read.
+
+    \sa isName()
+*/
+QString QJsonStreamReader::name() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->name;
+}
+
+/*!
+    Returns the value of the current token if it is a String, Number,
+    Bool or Null token. Otherwise returns an undefined QJsonValue.
+
+    \sa readValue()
+*/
+QJsonValue QJsonStreamReader::value() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->type) {
+    case String:
+        return QJsonValue(d->string);
+    case Number:
+        return QJsonValue(d->number);
+    case Bool:
+        return QJsonValue(d->boolean);
+    case Null:
+        return QJsonValue(QJsonValue::Null);
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*!
+    Reads the value starting at the current token and returns it. If the
+    current token is StartObject or StartArray, the whole object or array
+    is read and the reader is left on the matching EndObject or EndArray.
+    If the current token is a Name, the member value following it is read.
+    For any other value token this is the same as value().
+
+    Returns an undefined QJsonValue if an error occurs. Unlike readNext(),
+    a premature end of document cannot be resumed from within this
+    function, as the partly read value is lost.
+
+    \sa skipValue(), value()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    Q_D(QJsonStreamReader);
+    switch (d->type) {
+    case Name:
+        readNext();
+        return readValue();
+    case StartObject: {
+        QJsonObject object;
+        while (readNext() == Name) {
+            const QString key = d->name;
+            readNext();
+            const QJsonValue v = readValue();
+            if (hasError())
+                return QJsonValue(QJsonValue::Undefined);
+            object.insert(key, v);
+        }
+        if (d->type != EndObject)
+            return QJsonValue(QJsonValue::Undefined);
+        return object;
+    }
+    case StartArray: {
+        QJsonArray array;
+        while (readNext() != EndArray) {
+            const QJsonValue v = readValue();
+            if (hasError())
+                return QJsonValue(QJsonValue::Undefined);
+            array.append(v);
+        }
+        return array;
+    }
+    default:
+        return value();
+    }
+}
+
+/*!
+    Skips the value starting at the current token. If the current token is
+    StartObject or StartArray, the reader is moved to the matching
+    EndObject or EndArray. If the current token is a Name, the member
+    value following it is skipped. For any other token this function does
+    nothing.
+
+    \sa readValue()
+*/
+void QJsonStreamReader::skipValue()
+{
+    Q_D(QJsonStreamReader);
+    if (d->type == Name)
+        readNext();
+    if (d->type != StartObject && d->type != StartArray)
+        return;
+    const int level = d->containers.size();
+    while (!hasError()) {
+        const TokenType t = readNext();
+        if ((t == EndObject || t == EndArray) && d->containers.size() < level)
+            break;
+    }
+}
+
+/*!
+    Returns the offset of the first byte after the current token, counted
+    from the start of the input.
+*/
+qint64 QJsonStreamReader::characterOffset() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    Raises a custom error with an optional error \a message.
+
+    \sa error(), errorString()
+*/
+void QJsonStreamReader::raiseError(const QString &message)
+{
+    Q_D(QJsonStreamReader);
+    d->type = Invalid;
+    d->error = CustomError;
+    d->errorString = message;
+    if (d->errorString.isNull())
+        d->errorString = QCoreApplication::translate("QJsonStreamReader", "Invalid JSON.");
+}
+
+/*!
+    Returns the error message that was set with raiseError(), or the
+    message describing why the input is not well-formed.
+
+    \sa error(), characterOffset(), QJsonParseError::errorString()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->errorString;
+}
+
+/*!
+    Returns the type of the current error, or NoError if no error occurred.
+
+    \sa errorString(), raiseError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->error;
+}
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if an error has occurred, otherwise \c false.
+
+    \sa errorString(), error()
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    struct Container {
+        char type;  // '{' or '['
+        int count;
+    };
+
+    QJsonStreamWriterPrivate()
+        : device(0), array(0), topLevelValues(0),
+          autoFormatting(false), nameWritten(false), hasError(false)
+    {
+        scratch.reserve(256);
+    }
+
+    QByteArray &out() { return array ? *array : scratch; }
+    void flush();
+    void writeSeparator(Container &c);
+    bool beginValue(const char *function);
+    void endValue();
+    void startContainer(char type, const char *function);
+    void endContainer(char type, const char *function);
+
+    QIODevice *device;
+    QByteArray *array;
+    QByteArray scratch;
+    QVarLengthArray<Container, 64> containers;
+    int topLevelValues;
+    bool autoFormatting;
+    bool nameWritten;
+    bool hasError;
+};
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (array)
+        return;
+    if (device && !scratch.isEmpty() && device->write(scratch) != scratch.size())
+        hasError = true;
+    scratch.resize(0);
+}
+
+void QJsonStreamWriterPrivate::writeSeparator(Container &c)
+{
+    QByteArray &json = out();
+    if (c.count++)
+        json += autoFormatting ? ",\n" : ",";
+    if (autoFormatting)
+        json.append(4 * containers.size(), ' ');
+}
+
+bool QJsonStreamWriterPrivate::beginValue(const char *function)
+{
+    if (containers.isEmpty()) {
+        // separate top-level values, one per line
+        if (topLevelValues++ && !autoFormatting)
+            out() += '\n';
+        return true;
+    }
+    Container &c = containers.last();
+    if (c.type == '{') {
+        if (!nameWritten) {
+            qWarning("QJsonStreamWriter::%s: object members need a name", function);
+            return false;
+        }
+        nameWritten = false;
+        return true;
+    }
+    writeSeparator(c);
+    return true;
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (containers.isEmpty() && autoFormatting)
+        out() += '\n';
+    flush();
+}
+
+void QJsonStreamWriterPrivate::startContainer(char type, const char *function)
+{
+    if (!beginValue(function))
+        return;
+    out() += type;
+    if (autoFormatting)
+        out() += '\n';
+    containers.append(Container { type, 0 });
+    flush();
+}
+
+void QJsonStreamWriterPrivate::endContainer(char type, const char *function)
+{
+    if (containers.isEmpty() || containers.last().type != type || nameWritten) {
+        qWarning("QJsonStreamWriter::%s: no matching %s to end", function,
+                 type == '{' ? "object" : "array");
+        return;
+    }
+    const Container c = containers.last();
+    containers.removeLast();
+    QByteArray &json = out();
+    if (autoFormatting) {
+        if (c.count)
+            json += '\n';
+        json.append(4 * containers.size(), ' ');
+    }
+    json += type == '{' ? '}' : ']';
+    endValue();
+}
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 5.11
+
+    \brief The QJsonStreamWriter class provides a JSON writer with a
+    simple streaming API.
+
+    QJsonStreamWriter is the counterpart to QJsonStreamReader for writing
+    JSON. It writes each token to the output as soon as it is passed in,
+    so arbitrarily large documents can be produced without building a
+    QJsonDocument first.
+
+    Objects are opened with writeStartObject() and closed with
+    writeEndObject(); every member is a writeName() followed by exactly
+    one value. Arrays are written with writeStartArray() and
+    writeEndArray(). Values are written with writeString(), writeNumber(),
+    writeBool(), writeNull(), or writeValue() for any QJsonValue including
+    whole objects and arrays.
+
+    \code
+    QJsonStreamWriter writer(&file);
+    writer.writeStartObject();
+    writer.writeMember(QStringLiteral("id"), 42);
+    writer.writeStartArray(QStringLiteral("tags"));
+    writer.writeString(QStringLiteral("new"));
+    writer.writeEndArray();
+    writer.writeEndObject();
+    \endcode
+
+    More than one value may be written at the top level. Without
+    autoFormatting() consecutive top-level values are separated by a
+    newline, which produces newline-delimited JSON (JSON Lines).
+
+    The output is identical to what QJsonDocument::toJson() generates for
+    the same data, in the QJsonDocument::Indented format if
+    autoFormatting() is enabled and QJsonDocument::Compact otherwise.
+
+    \sa QJsonStreamReader, QJsonDocument, QXmlStreamWriter
+*/
+
+/*!
+    Constructs a stream writer without a device.
+
+    \sa setDevice()
+*/
+QJsonStreamWriter::QJsonStreamWriter()
+    : d_ptr(new QJsonStreamWriterPrivate)
+{
+}
+
+/*!
+    Constructs a stream writer that writes to \a device.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d_ptr(new QJsonStreamWriterPrivate)
+{
+    d_ptr->device = device;
+}
+
+/*!
+    Constructs a stream writer that appends to \a array.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *array)
+    : d_ptr(new QJsonStreamWriterPrivate)
+{
+    d_ptr->array = array;
+}
+
+/*!
+    Destructor.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+}
+
+/*!
+    Sets the current device to \a device. If you want the stream to
+    write into a QByteArray, use the QJsonStreamWriter(QByteArray *)
+    constructor instead.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    Q_D(QJsonStreamWriter);
+    d->device = device;
+    d->array = 0;
+    d->scratch.resize(0);
+}
+
+/*!
+    Returns the device associated with the QJsonStreamWriter, or \nullptr
+    if no device has been assigned.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    Q_D(const QJsonStreamWriter);
+    return d->device;
+}
+
+/*!
+    Enables auto formatting if \a enable is \c true, otherwise disables
+    it.
+
+    With auto formatting, the output is indented by four spaces per level
+    and every member and array element is written on a line of its own,
+    as in QJsonDocument::Indented.
+
+    \sa autoFormatting()
+*/
+void QJsonStreamWriter::setAutoFormatting(bool enable)
+{
+    Q_D(QJsonStreamWriter);
+    d->autoFormatting = enable;
+}
+
+/*!
+    Returns \c true if auto formatting is enabled, otherwise \c false.
+
+    \sa setAutoFormatting()
+*/
+bool QJsonStreamWriter::autoFormatting() const
+{
+    Q_D(const QJsonStreamWriter);
+    return d->autoFormatting;
+}
+
+/*!
+    Writes the start of an object. Inside an object, a member name must
+    have been written with writeName() first.
+
+    \sa writeEndObject()
+*/
+void QJsonStreamWriter::writeStartObject()
+{
+    Q_D(QJsonStreamWriter);
+    d->startContainer('{', "writeStartObject");
+}
+
+/*!
+    \overload
+
+    Writes a member called \a name whose value is an object. This is a
+    convenience function equivalent to:
+    \code
+    writeName(name);
+    writeStartObject();
+    \endcode
+*/
+void QJsonStreamWriter::writeStartObject(const QString &name)
+{
+    writeName(name);
+    writeStartObject();
+}
+
+/*!
+    Closes the object opened by the matching writeStartObject().
+*/
+void QJsonStreamWriter::writeEndObject()
+{
+    Q_D(QJsonStreamWriter);
+    d->endContainer('{', "writeEndObject");
+}
+
+/*!
+    Writes the start of an array. Inside an object, a member name must
+    have been written with writeName() first.
+
+    \sa writeEndArray()
+*/
+void QJsonStreamWriter::writeStartArray()
+{
+    Q_D(QJsonStreamWriter);
+    d->startContainer('[', "writeStartArray");
+}
+
+/*!
+    \overload
+
+    Writes a member called \a name whose value is an array. This is a
+    convenience function equivalent to:
+    \code
+    writeName(name);
+    writeStartArray();
+    \endcode
+*/
+void QJsonStreamWriter::writeStartArray(const QString &name)
+{
+    writeName(name);
+    writeStartArray();
+}
+
+/*!
+    Closes the array opened by the matching writeStartArray().
+*/
+void QJsonStreamWriter::writeEndArray()
+{
+    Q_D(QJsonStreamWriter);
+    d->endContainer('[', "writeEndArray");
+}
+
+/*!
+    Writes the member name \a name. The next value written becomes the
+    value of this member. This function can only be called inside an
+    object.
+*/
+void QJsonStreamWriter::writeName(const QString &name)
+{
+    Q_D(QJsonStreamWriter);
+    if (d->containers.isEmpty() || d->containers.last().type != '{' || d->nameWritten) {
+        qWarning("QJsonStreamWriter::writeName: a name can only be written inside an object, before each value");
+        return;
+    }
+    d->writeSeparator(d->containers.last());
+    QJsonPrivate::Writer::stringToJson(name, d->out());
+    d->out() += d->autoFormatting ? ": " : ":";
+    d->nameWritten = true;
+    d->flush();
+}
+
+/*!
+    Writes a member called \a name with the value \a value. This is a
+    convenience function equivalent to:
+    \code
+    writeName(name);
+    writeValue(value);
+    \endcode
+*/
+void QJsonStreamWriter::writeMember(const QString &name, const QJsonValue &value)
+{
+    writeName(name);
+    writeValue(value);
+}
+
+/*!
+    Writes \a value. Objects and arrays are written with all their
+    contents. An undefined value is written as \c null.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Bool:
+        writeBool(value.toBool());
+        break;
+    case QJsonValue::Double:
+        writeNumber(value.toDouble());
+        break;
+    case QJsonValue::String:
+        writeString(value.toString());
+        break;
+    case QJsonValue::Array: {
+        const QJsonArray a = value.toArray();
+        writeStartArray();
+        for (const QJsonValue &v : a)
+            writeValue(v);
+        writeEndArray();
+        break;
+    }
+    case QJsonValue::Object: {
+        const QJsonObject o = value.toObject();
+        writeStartObject();
+        for (QJsonObject::const_iterator it = o.constBegin(), end = o.constEnd(); it != end; ++it)
+            writeMember(it.key(), it.value());
+        writeEndObject();
+        break;
+    }
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        writeNull();
+        break;
+    }
+}
+
+/*!
+    Writes the string \a value, escaped as required by JSON.
+*/
+void QJsonStreamWriter::writeString(const QString &value)
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->beginValue("writeString"))
+        return;
+    QJsonPrivate::Writer::stringToJson(value, d->out());
+    d->endValue();
+}
+
+/*!
+    Writes the number \a value. Infinities and NaN have no representation
+    in JSON and are written as \c null, like QJsonDocument::toJson() does.
+*/
+void QJsonStreamWriter::writeNumber(double value)
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->beginValue("writeNumber"))
+        return;
+    QJsonPrivate::Writer::doubleToJson(value, d->out());
+    d->endValue();
+}
+
+/*!
+    Writes \c true or \c false, depending on \a value.
+*/
+void QJsonStreamWriter::writeBool(bool value)
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->beginValue("writeBool"))
+        return;
+    d->out() += value ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    Writes \c null.
+*/
+void QJsonStreamWriter::writeNull()
+{
+    Q_D(QJsonStreamWriter);
+    if (!d->beginValue("writeNull"))
+        return;
+    d->out() += "null";
+    d->endValue();
+}
+
+/*!
+    Returns the number of objects and arrays that have been started but
+    not yet ended.
+*/
+int QJsonStreamWriter::depth() const
+{
+    Q_D(const QJsonStreamWriter);
+    return d->containers.size();
+}
+
+/*!
+    Returns \c true if writing failed.
+
+    This can happen if the stream failed to write to the underlying
+    device.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    Q_D(const QJsonStreamWriter);
+    return d->hasError;
+}
+
+QT_END_NAMESPACE
@@ -128,20 +128,11 @@ static void valueToJson(const QJsonPrivate::Base *b, const QJsonPrivate::Value &
     case QJsonValue::Bool:
         json += v.toBoolean() ? "true" : "false";
         break;
-    case QJsonValue::Double: {
-        const double d = v.toDouble(b);
-        if (qIsFinite(d)) { // +2 to format to ensure the expected precision
-            const double abs = std::abs(d);
-            json += QByteArray::number(d, abs == static_cast<quint64>(abs) ? 'f' : 'g', QLocale::FloatingPointShortest);
-        } else {
-            json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
-        }
+    case QJsonValue::Double:
+        Writer::doubleToJson(v.toDouble(b), json);
         break;
-    }
     case QJsonValue::String:
-        json += '"';
-        json += escapedString(v.toString(b));
-        json += '"';
+        Writer::stringToJson(v.toString(b), json);
         break;
     case QJsonValue::Array:
         json += compact ? "[" : "[\n";
@@ -195,9 +186,8 @@ static void objectContentToJson(const QJsonPrivate::Object *o, QByteArray &json,
     while (1) {
         QJsonPrivate::Entry *e = o->entryAt(i);
         json += indentString;
-        json += '"';
-        json += escapedString(e->key());
-        json += compact ? "\":" : "\": ";
+        Writer::stringToJson(e->key(), json);
+        json += compact ? ":" : ": ";
         valueToJson(o, e->value, json, indent, compact);
 
         if (++i == o->length) {
@@ -228,4 +218,21 @@ void Writer::arrayToJson(const QJsonPrivate::Array *a, QByteArray &json, int ind
     json += compact ? "]" : "]\n";
 }
 
+void Writer::stringToJson(const QString &s, QByteArray &json)
+{
+    json += '"';
+    json += escapedString(s);
+    json += '"';
+}
+
+void Writer::doubleToJson(double d, QByteArray &json)
+{
+    if (qIsFinite(d)) { // +2 to format to ensure the expected precision
+        const double abs = std::abs(d);
+        json += QByteArray::number(d, abs == static_cast<quint64>(abs) ? 'f' : 'g', QLocale::FloatingPointShortest);
+    } else {
+        json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
+    }
+}
+
 QT_END_NAMESPACE
@@ -9,6 +9,7 @@ HEADERS += \
         kernel/qelapsedtimer.h \
         kernel/qeventloop.h\
         kernel/qpointer.h \
+        kernel/qstartuptrace_p.h \
         kernel/qcorecmdlineargs_p.h \
         kernel/qcoreapplication.h \
         kernel/qcoreevent.h \
@@ -52,6 +53,7 @@ SOURCES += \
         kernel/qelapsedtimer.cpp \
         kernel/qeventloop.cpp \
         kernel/qcoreapplication.cpp \
+        kernel/qstartuptrace.cpp \
         kernel/qcoreevent.cpp \
         kernel/qmetaobject.cpp \
         kernel/qmetatype.cpp \
@@ -47,6 +47,7 @@
 #include "qeventloop.h"
 #endif
 #include "qcorecmdlineargs_p.h"
+#include "qstartuptrace_p.h"
 #include <qdatastream.h>
 #include <qdebug.h>
 #include <qdir.h>
@@ -64,11 +65,13 @@
 #endif
 #include <qelapsedtimer.h>
 #include <qlibraryinfo.h>
+#include <qset.h>
 #include <qvarlengtharray.h>
 #include <private/qfactoryloader_p.h>
 #include <private/qfunctions_p.h>
 #include <private/qlocale_p.h>
 #include <private/qhooks_p.h>
+#include <private/qtcore_tracepoints_p.h>
 
 #ifndef QT_NO_QOBJECT
 #if defined(Q_OS_UNIX)
@@ -148,6 +151,10 @@ int QCoreApplicationPrivate::app_compile_version = 0x050000; //we don't know exa
 
 bool QCoreApplicationPrivate::setuidAllowed = false;
 
+#ifndef QT_NO_QOBJECT
+int QCoreApplicationPrivate::postedEventsTimeBudget = 0;
+#endif
+
 #if !defined(Q_OS_WIN)
 #ifdef Q_OS_DARWIN
 QString QCoreApplicationPrivate::infoDictionaryStringProperty(const QString &propertyName)
@@ -789,12 +796,21 @@ void QCoreApplicationPrivate::init()
 #endif
 
     Q_Q(QCoreApplication);
+    QStartupTrace::Phase totalPhase("QCoreApplication");
 
-    initLocale();
+    {
+        QStartupTrace::Phase phase("locale");
+        initLocale();
+    }
 
     Q_ASSERT_X(!QCoreApplication::self, "QCoreApplication", "there should be only one application object");
     QCoreApplication::self = q;
 
+#ifndef QT_NO_QOBJECT
+    // milliseconds a single pass over the posted events may take; 0 means unlimited
+    postedEventsTimeBudget = qMax(0, qEnvironmentVariableIntValue("QT_POSTED_EVENTS_TIME_BUDGET"));
+#endif
+
     // Store app name/version (so they're still available after QCoreApplication is destroyed)
     if (!coreappdata()->applicationNameSet)
         coreappdata()->application = appName();
@@ -811,6 +827,7 @@ void QCoreApplicationPrivate::init()
 #endif
 
 #if QT_CONFIG(library)
+    QStartupTrace::Phase libraryPathsPhase("library paths");
     // Reset the lib paths, so that they will be recomputed, taking the availability of argv[0]
     // into account. If necessary, recompute right away and replay the manual changes on top of the
     // new lib paths.
@@ -838,9 +855,11 @@ void QCoreApplicationPrivate::init()
         }
         delete appPaths;
     }
+    libraryPathsPhase.finish();
 #endif
 
 #ifndef QT_NO_QOBJECT
+    QStartupTrace::Phase eventDispatcherPhase("event dispatcher");
     // use the event dispatcher created by the app programmer (if any)
     if (!eventDispatcher)
         eventDispatcher = threadData->eventDispatcher.load();
@@ -856,6 +875,7 @@ void QCoreApplicationPrivate::init()
 
     threadData->eventDispatcher = eventDispatcher;
     eventDispatcherReady();
+    eventDispatcherPhase.finish();
 #endif
 
 #ifdef QT_EVAL
@@ -865,6 +885,7 @@ void QCoreApplicationPrivate::init()
 
     processCommandLineArguments();
 
+    QStartupTrace::Phase startupRoutinesPhase("startup routines");
     qt_call_pre_routines();
     qt_startup_hook();
 #ifndef QT_BOOTSTRAPPED
@@ -963,9 +984,9 @@ bool QCoreApplication::isSetuidAllowed()
 void QCoreApplication::setAttribute(Qt::ApplicationAttribute attribute, bool on)
 {
     if (on)
-        QCoreApplicationPrivate::attribs |= 1 << attribute;
+        QCoreApplicationPrivate::attribs |= 1u << attribute;
     else
-        QCoreApplicationPrivate::attribs &= ~(1 << attribute);
+        QCoreApplicationPrivate::attribs &= ~(1u << attribute);
 }
 
 /*!
@@ -1045,9 +1066,10 @@ bool QCoreApplication::notifyInternal2(QObject *receiver, QEvent *event)
     QObjectPrivate *d = receiver->d_func();
     QThreadData *threadData = d->threadData;
     QScopedScopeLevelCounter scopeLevelCounter(threadData);
-    if (!selfRequired)
-        return doNotify(receiver, event);
-    return self->notify(receiver, event);
+    Q_TRACE(QCoreApplication_notify_entry, receiver, event, event->type());
+    result = selfRequired ? self->notify(receiver, event) : doNotify(receiver, event);
+    Q_TRACE(QCoreApplication_notify_exit, result);
+    return result;
 }
 
 /*!
@@ -1442,6 +1464,8 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    Q_TRACE(QCoreApplication_postEvent_entry, receiver, event, event->type());
+
     QThreadData * volatile * pdata = &receiver->d_func()->threadData;
     QThreadData *data = *pdata;
     if (!data) {
@@ -1472,6 +1496,7 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
+        Q_TRACE(QCoreApplication_postEvent_event_compressed, receiver, event);
         return;
     }
 
@@ -1508,6 +1533,8 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     event->posted = true;
     ++receiver->d_func()->postedEvents;
     data->canWait = false;
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type(),
+            data->postEventList.size() - data->postEventList.startOffset);
     locker.unlock();
 
     QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
@@ -1552,17 +1579,11 @@ bool QCoreApplication::compressEvent(QEvent *event, QObject *receiver, QPostEven
         return false;
     }
 
-    if (event->type() == QEvent::Quit && receiver->d_func()->postedEvents > 0) {
-        for (int i = 0; i < postedEvents->size(); ++i) {
-            const QPostEvent &cur = postedEvents->at(i);
-            if (cur.receiver != receiver
-                    || cur.event == 0
-                    || cur.event->type() != event->type())
-                continue;
-            // found an event for this receiver
-            delete event;
-            return true;
-        }
+    if (event->type() == QEvent::Quit && receiver->d_func()->postedEvents > 0
+        && postedEvents->findCompressible(receiver, QEvent::Quit)) {
+        // there is a Quit event for this receiver already
+        delete event;
+        return true;
     }
 
     return false;
@@ -1608,6 +1629,9 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         return;
     }
 
+    if (data->postEventList.batchedEvents.load())
+        QObjectPrivate::postBatchedMetaCalls(data);
+
     ++data->postEventList.recursion;
 
     QMutexLocker locker(&data->postEventList.mutex);
@@ -1664,11 +1688,23 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     };
     CleanUp cleanup(receiver, event_type, data);
 
+    // a global pass may be limited in time, so that a flood of posted events
+    // cannot starve timers and input; the rest is sent on the next pass
+    const int timeBudget = (!event_type && !receiver) ? postedEventsTimeBudget : 0;
+    QElapsedTimer budgetTimer;
+    if (timeBudget > 0)
+        budgetTimer.start();
+
     while (i < data->postEventList.size()) {
         // avoid live-lock
         if (i >= data->postEventList.insertionOffset)
             break;
 
+        if (timeBudget > 0 && budgetTimer.hasExpired(timeBudget)) {
+            data->canWait = false;
+            break;
+        }
+
         const QPostEvent &pe = data->postEventList.at(i);
         ++i;
 
@@ -1724,6 +1760,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
         // next, update the data structure so that we're ready
         // for the next event.
+        data->postEventList.forgetEvent(pe);
         const_cast<QPostEvent &>(pe).event = 0;
 
         struct MutexUnlocker
@@ -1793,6 +1830,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
             --pe.receiver->d_func()->postedEvents;
             pe.event->posted = false;
             events.append(pe.event);
+            data->postEventList.forgetEvent(pe);
             const_cast<QPostEvent &>(pe).event = 0;
         } else if (!data->postEventList.recursion) {
             if (i != j)
@@ -1828,6 +1866,59 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
   \threadsafe
 */
 
+/*!
+  \internal
+  Removes all the events posted to \a receivers, which live in the thread
+  of \a data, in a single pass over its posted events.
+
+  This spares deleting many objects with posted events, e.g. after a lot
+  of deleteLater() calls, from going through the list once for each.
+*/
+void QCoreApplicationPrivate::removePostedEvents(const QObjectList &receivers, QThreadData *data)
+{
+    QMutexLocker locker(&data->postEventList.mutex);
+
+    QSet<QObject *> remaining;
+    remaining.reserve(receivers.size());
+    for (QObject *receiver : receivers) {
+        Q_ASSERT(receiver->d_func()->threadData == data);
+        if (receiver->d_func()->postedEvents)
+            remaining.insert(receiver);
+    }
+    if (remaining.isEmpty())
+        return;
+
+    QVarLengthArray<QEvent*> events;
+    int n = data->postEventList.size();
+    int j = 0;
+
+    for (int i = 0; i < n; ++i) {
+        const QPostEvent &pe = data->postEventList.at(i);
+
+        if (pe.event && remaining.contains(pe.receiver)) {
+            --pe.receiver->d_func()->postedEvents;
+            pe.event->posted = false;
+            events.append(pe.event);
+            data->postEventList.forgetEvent(pe);
+            const_cast<QPostEvent &>(pe).event = 0;
+        } else if (!data->postEventList.recursion) {
+            if (i != j)
+                qSwap(data->postEventList[i], data->postEventList[j]);
+            ++j;
+        }
+    }
+
+    if (!data->postEventList.recursion) {
+        // truncate list
+        data->postEventList.erase(data->postEventList.begin() + j, data->postEventList.end());
+    }
+
+    locker.unlock();
+    for (int i = 0; i < events.count(); ++i) {
+        delete events[i];
+    }
+}
+
 void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
 {
     if (!event || !event->posted)
@@ -1856,6 +1947,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
 #endif
             --pe.receiver->d_func()->postedEvents;
             pe.event->posted = false;
+            data->postEventList.forgetEvent(pe);
             delete pe.event;
             const_cast<QPostEvent &>(pe).event = 0;
             return;
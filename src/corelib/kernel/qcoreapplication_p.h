@@ -106,6 +106,7 @@ public:
     virtual void createEventDispatcher();
     virtual void eventDispatcherReady();
     static void removePostedEvent(QEvent *);
+    static void removePostedEvents(const QObjectList &receivers, QThreadData *data);
 #ifdef Q_OS_WIN
     static void removePostedTimerEvent(QObject *object, int timerId);
 #endif
@@ -159,11 +160,12 @@ public:
     static QAbstractEventDispatcher *eventDispatcher;
     static bool is_app_running;
     static bool is_app_closing;
+    static int postedEventsTimeBudget;
 #endif
 
     static bool setuidAllowed;
     static uint attribs;
-    static inline bool testAttribute(uint flag) { return attribs & (1 << flag); }
+    static inline bool testAttribute(uint flag) { return attribs & (1u << flag); }
     static int app_compile_version;
 
     void processCommandLineArguments();
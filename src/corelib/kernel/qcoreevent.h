@@ -321,6 +321,7 @@ private:
 
     friend class QCoreApplication;
     friend class QCoreApplicationPrivate;
+    friend class QObjectPrivate;
     friend class QThreadData;
     friend class QApplication;
     friend class QShortcutMap;
@@ -50,6 +50,7 @@
 #include <private/qthread_p.h>
 #include <private/qcoreapplication_p.h>
 #include <private/qcore_unix_p.h>
+#include <private/qtcore_tracepoints_p.h>
 
 #include <errno.h>
 #include <stdio.h>
@@ -223,17 +224,148 @@ int QThreadPipe::check(const pollfd &pfd)
 }
 
 QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
+#if QT_CONFIG(epoll)
+    : epollFd(-1)
+#endif
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Can not continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIsSet("QT_EVENT_DISPATCHER_EPOLL") && !initEpoll())
+        perror("QEventDispatcherUNIXPrivate: Unable to create epoll set, falling back to poll");
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     qDeleteAll(timerList);
 }
 
+#if QT_CONFIG(epoll)
+/*
+    The epoll(7) backend keeps the socket notifiers in a persistent kernel
+    set instead of rebuilding a pollfd array for every iteration, so the cost
+    of processEvents() no longer depends on the number of registered
+    notifiers, only on the number of ready ones. The epoll descriptor itself
+    is polled together with the thread pipe, which keeps the nanosecond
+    timeout behaviour of qt_safe_poll() for the timers.
+*/
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    return epollFd >= 0;
+}
+
+static uint epollEventsFromPollEvents(short events)
+{
+    uint result = 0;
+    if (events & POLLIN)
+        result |= EPOLLIN;
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+    if (events & POLLPRI)
+        result |= EPOLLPRI;
+    return result;
+}
+
+static short pollEventsFromEpollEvents(uint events)
+{
+    short result = 0;
+    if (events & EPOLLIN)
+        result |= POLLIN;
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+    if (events & EPOLLPRI)
+        result |= POLLPRI;
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+    if (events & EPOLLERR)
+        result |= POLLERR;
+    return result;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpoll(int fd, QSocketNotifierSetUNIX &sn_set, short oldEvents)
+{
+    const short newEvents = sn_set.events();
+    if (sn_set.pollOnly) {
+        if (!newEvents)
+            pollOnlyFds.removeOne(fd);
+        return;
+    }
+
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = epollEventsFromPollEvents(newEvents);
+    ev.data.fd = fd;
+
+    int op = !oldEvents ? EPOLL_CTL_ADD : (newEvents ? EPOLL_CTL_MOD : EPOLL_CTL_DEL);
+    if (epoll_ctl(epollFd, op, fd, &ev) == 0)
+        return;
+
+    // The kernel drops a descriptor from the set when its last reference is
+    // closed, and a dup()ed descriptor may still be registered after that.
+    if (op == EPOLL_CTL_ADD && errno == EEXIST) {
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0)
+            return;
+    } else if (op == EPOLL_CTL_MOD && errno == ENOENT) {
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+            return;
+    } else if (op == EPOLL_CTL_DEL) {
+        return;
+    }
+
+    if (errno == EPERM) {
+        // regular files and directories are always ready for poll(2), but
+        // epoll(7) refuses them, so fall back to polling them individually
+        sn_set.pollOnly = true;
+        pollOnlyFds.append(fd);
+        return;
+    }
+
+    perror("QEventDispatcherUNIXPrivate: epoll_ctl");
+}
+
+void QEventDispatcherUNIXPrivate::fetchEpollEvents()
+{
+    Q_ASSERT(!pollfds.isEmpty() && pollfds.constFirst().fd == epollFd);
+
+    pollfd &epollPfd = pollfds.first();
+    const bool ready = epollPfd.revents & POLLIN;
+    epollPfd.fd = -1;
+    if (!ready)
+        return;
+
+    epollEvents.resize(qMax(1, socketNotifiers.size()));
+
+    int n;
+    EINTR_LOOP(n, epoll_wait(epollFd, epollEvents.data(), epollEvents.size(), 0));
+    if (n < 0) {
+        perror("QEventDispatcherUNIXPrivate: epoll_wait");
+        return;
+    }
+
+    pollfds.reserve(pollfds.size() + n);
+    for (int i = 0; i < n; ++i) {
+        const int fd = epollEvents.at(i).data.fd;
+        // a descriptor that was closed while still shared with another
+        // process can keep reporting events after its notifiers are gone
+        if (!socketNotifiers.contains(fd))
+            continue;
+
+        pollfd pfd = qt_make_pollfd(fd, 0);
+        pfd.revents = pollEventsFromEpollEvents(epollEvents.at(i).events);
+        pollfds.append(pfd);
+    }
+}
+#endif // QT_CONFIG(epoll)
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -291,6 +423,10 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        fetchEpollEvents();
+#endif
     markPendingSocketNotifiers();
 
     if (pendingNotifiers.isEmpty())
@@ -411,7 +547,16 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && sn_set.events() != oldEvents)
+        d->updateEpoll(sockfd, sn_set, oldEvents);
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -450,8 +595,17 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpoll(sockfd, sn_set, oldEvents);
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -460,6 +614,7 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
 {
     Q_D(QEventDispatcherUNIX);
     d->interrupt.store(0);
+    Q_TRACE(QEventDispatcherUNIX_processEvents_entry, int(flags));
 
     // we are awake, broadcast it
     emit awake();
@@ -486,18 +641,37 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
         tm = &wait_tm;
 
     d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0) {
+        if (include_notifiers) {
+            // This must be first, as fetchEpollEvents() expects it there
+            d->pollfds.reserve(2 + d->pollOnlyFds.size());
+            d->pollfds.append(qt_make_pollfd(d->epollFd, POLLIN));
+            for (int fd : qAsConst(d->pollOnlyFds))
+                d->pollfds.append(qt_make_pollfd(fd, d->socketNotifiers.value(fd).events()));
+        }
+    } else
+#endif
+    {
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
+        if (include_notifiers)
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+    }
 
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
     int nevents = 0;
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+    Q_TRACE(QEventDispatcherUNIX_poll_entry, d->pollfds.size(),
+            tm ? int(tm->tv_sec * 1000 + tm->tv_nsec / (1000 * 1000)) : -1);
+    const int pollResult = qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm);
+    Q_TRACE(QEventDispatcherUNIX_poll_exit, pollResult);
+
+    switch (pollResult) {
     case -1:
         perror("qt_safe_poll");
         break;
@@ -513,6 +687,8 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (include_timers)
         nevents += d->activateTimers();
 
+    Q_TRACE(QEventDispatcherUNIX_processEvents_exit, nevents);
+
     // return true if we handled events, false otherwise
     return (nevents > 0);
 }
@@ -58,6 +58,10 @@
 #include "QtCore/qvarlengtharray.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -70,6 +74,7 @@ struct Q_CORE_EXPORT QSocketNotifierSetUNIX Q_DECL_FINAL
     inline short events() const Q_DECL_NOTHROW;
 
     QSocketNotifier *notifiers[3];
+    bool pollOnly; // fd cannot be watched by epoll(7), e.g. a regular file
 };
 
 Q_DECLARE_TYPEINFO(QSocketNotifierSetUNIX, Q_PRIMITIVE_TYPE);
@@ -140,6 +145,17 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpoll(int fd, QSocketNotifierSetUNIX &sn_set, short oldEvents);
+    void fetchEpollEvents();
+
+    // the persistent epoll(7) set, or -1 if the poll(2) backend is in use
+    int epollFd;
+    QVector<int> pollOnlyFds;
+    QVector<epoll_event> epollEvents;
+#endif
+
     QThreadPipe threadPipe;
     QVector<pollfd> pollfds;
 
@@ -155,6 +171,7 @@ inline QSocketNotifierSetUNIX::QSocketNotifierSetUNIX() Q_DECL_NOTHROW
     notifiers[0] = 0;
     notifiers[1] = 0;
     notifiers[2] = 0;
+    pollOnly = false;
 }
 
 inline bool QSocketNotifierSetUNIX::isEmpty() const Q_DECL_NOTHROW
@@ -591,6 +591,7 @@ static inline int indexOfMethodRelative(const QMetaObject **baseObject,
                                         const QByteArray &name, int argc,
                                         const QArgumentType *types)
 {
+    const uint hash = QMetaObjectPrivate::methodNameHash(name.constData(), name.size());
     for (const QMetaObject *m = *baseObject; m; m = m->d.superdata) {
         Q_ASSERT(priv(m->d.data)->revision >= 7);
         int i = (MethodType == MethodSignal)
@@ -598,6 +599,28 @@ static inline int indexOfMethodRelative(const QMetaObject **baseObject,
         const int end = (MethodType == MethodSlot)
                         ? (priv(m->d.data)->signalCount) : 0;
 
+        if (priv(m->d.data)->revision >= 8 && priv(m->d.data)->methodHashData) {
+            // Only the methods sharing the bucket of the name need to be
+            // checked; they are stored from the highest index down, like the
+            // linear scan below visits them.
+            const uint *table = m->d.data + priv(m->d.data)->methodHashData;
+            const uint bucket = hash & (table[0] - 1);
+            const uint *indexes = table + 2 + table[0];
+            for (uint k = table[1 + bucket]; k < table[2 + bucket]; ++k) {
+                const int index = int(indexes[k]);
+                if (index > i)
+                    continue;
+                if (index < end)
+                    break;
+                int handle = priv(m->d.data)->methodData + 5*index;
+                if (methodMatch(m, handle, name, argc, types)) {
+                    *baseObject = m;
+                    return index;
+                }
+            }
+            continue;
+        }
+
         for (; i >= end; --i) {
             int handle = priv(m->d.data)->methodData + 5*i;
             if (methodMatch(m, handle, name, argc, types)) {
@@ -1504,6 +1527,8 @@ bool QMetaObject::invokeMethodImpl(QObject *object, QtPrivate::QSlotObjectBase *
     QThread *objectThread = object->thread();
     if (type == Qt::AutoConnection)
         type = (currentThread == objectThread) ? Qt::DirectConnection : Qt::QueuedConnection;
+    else if (type == Qt::BatchedConnection || type == Qt::CoalescedConnection)
+        type = Qt::QueuedConnection; // batching only applies to connections
 
     void *argv[] = { ret };
 
@@ -1516,14 +1541,8 @@ bool QMetaObject::invokeMethodImpl(QObject *object, QtPrivate::QSlotObjectBase *
             return false;
         }
 
-        // args and typesCopy will be deallocated by ~QMetaCallEvent() using free()
-        void **args = static_cast<void **>(calloc(1, sizeof(void *)));
-        Q_CHECK_PTR(args);
-
-        int *types = static_cast<int *>(calloc(1, sizeof(int)));
-        Q_CHECK_PTR(types);
-
-        QCoreApplication::postEvent(object, new QMetaCallEvent(slot, 0, -1, 1, types, args));
+        // the event allocates the (empty) argument arrays itself
+        QCoreApplication::postEvent(object, new QMetaCallEvent(slot, 0, -1, 1));
     } else if (type == Qt::BlockingQueuedConnection) {
 #ifndef QT_NO_THREAD
         if (currentThread == objectThread)
@@ -2279,6 +2298,9 @@ bool QMetaMethod::invoke(QObject *object,
         connectionType = currentThread == objectThread
                          ? Qt::DirectConnection
                          : Qt::QueuedConnection;
+    } else if (connectionType == Qt::BatchedConnection || connectionType == Qt::CoalescedConnection) {
+        // batching only applies to connections
+        connectionType = Qt::QueuedConnection;
     }
 
 #ifdef QT_NO_THREAD
@@ -171,7 +171,8 @@ class QMutex;
 struct QMetaObjectPrivate
 {
     // revision 7 is Qt 5.0 everything lower is not supported
-    enum { OutputRevision = 7 }; // Used by moc, qmetaobjectbuilder and qdbus
+    // revision 8 adds the method name hash table
+    enum { OutputRevision = 8 }; // Used by moc, qmetaobjectbuilder and qdbus
 
     int revision;
     int className;
@@ -182,10 +183,54 @@ struct QMetaObjectPrivate
     int constructorCount, constructorData;
     int flags;
     int signalCount;
+    int methodHashData; // since revision 8, 0 if there is no table
 
     static inline const QMetaObjectPrivate *get(const QMetaObject *metaobject)
     { return reinterpret_cast<const QMetaObjectPrivate*>(metaobject->d.data); }
 
+    // The method hash table consists of the bucket count (a power of two),
+    // bucketCount + 1 offsets into the index list, and the list of local
+    // method indexes, in decreasing order within each bucket. Moc and
+    // QMetaObjectBuilder must hash the names exactly like the lookup does.
+    static inline uint methodNameHash(const char *name, int length)
+    {
+        uint h = 2166136261u;
+        for (int i = 0; i < length; ++i)
+            h = (h ^ uchar(name[i])) * 16777619u;
+        return h;
+    }
+    static inline int methodHashBucketCount(int methodCount)
+    {
+        int n = 1;
+        while (n < methodCount)
+            n <<= 1;
+        return n;
+    }
+    static inline int methodHashTableSize(int methodCount)
+    { return methodCount ? 2 + methodHashBucketCount(methodCount) + methodCount : 0; }
+    // \a hashes holds the name hash of each local method; \a table must
+    // have room for methodHashTableSize(methodCount) entries.
+    static inline void buildMethodHashTable(int *table, const uint *hashes, int methodCount)
+    {
+        const int bucketCount = methodHashBucketCount(methodCount);
+        int *offsets = table + 1;
+        int *indexes = offsets + bucketCount + 1;
+        table[0] = bucketCount;
+        for (int b = 0; b <= bucketCount; ++b)
+            offsets[b] = 0;
+        for (int i = 0; i < methodCount; ++i)
+            ++offsets[(hashes[i] & (bucketCount - 1)) + 1];
+        for (int b = 0; b < bucketCount; ++b)
+            offsets[b + 1] += offsets[b];
+        // offsets[b] is used as the insertion point of bucket b, which
+        // leaves it at the start of bucket b + 1 afterwards.
+        for (int i = methodCount - 1; i >= 0; --i)
+            indexes[offsets[hashes[i] & (bucketCount - 1)]++] = i;
+        for (int b = bucketCount; b > 0; --b)
+            offsets[b] = offsets[b - 1];
+        offsets[0] = 0;
+    }
+
     static int originalClone(const QMetaObject *obj, int local_method_index);
 
     static QByteArray decodeMethodSignature(const char *signature,
@@ -229,7 +274,8 @@ struct QMetaObjectPrivate
                            const QMetaObject *smeta,
                            const QObject *receiver, int method_index, void **slot,
                            DisconnectType = DisconnectAll);
-    static inline bool disconnectHelper(QObjectPrivate::Connection *c,
+    static inline bool disconnectHelper(QObjectConnectionListVector *connectionLists,
+                                        QObjectPrivate::Connection *c,
                                         const QObject *receiver, int method_index, void **slot,
                                         QMutex *senderMutex, DisconnectType = DisconnectAll);
 #endif
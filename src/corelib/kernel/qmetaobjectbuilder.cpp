@@ -1215,8 +1215,10 @@ static int buildMetaObject(QMetaObjectBuilderPrivate *d, char *buf,
              + aggregateParameterCount(d->constructors)) * 2) // types and parameter names
             - int(d->methods.size())       // return "parameters" don't have names
             - int(d->constructors.size()); // "this" parameters don't have names
+    const int methodHashTableSize =
+            QMetaObjectPrivate::methodHashTableSize(int(d->methods.size()));
     if (buf) {
-        Q_STATIC_ASSERT_X(QMetaObjectPrivate::OutputRevision == 7, "QMetaObjectBuilder should generate the same version as moc");
+        Q_STATIC_ASSERT_X(QMetaObjectPrivate::OutputRevision == 8, "QMetaObjectBuilder should generate the same version as moc");
         pmeta->revision = QMetaObjectPrivate::OutputRevision;
         pmeta->flags = d->flags;
         pmeta->className = 0;   // Class name is always the first string.
@@ -1249,6 +1251,9 @@ static int buildMetaObject(QMetaObjectBuilderPrivate *d, char *buf,
         pmeta->constructorCount = int(d->constructors.size());
         pmeta->constructorData = dataIndex;
         dataIndex += 5 * int(d->constructors.size());
+
+        pmeta->methodHashData = d->methods.empty() ? 0 : dataIndex;
+        dataIndex += methodHashTableSize;
     } else {
         dataIndex += 2 * int(d->classInfoNames.size());
         dataIndex += 5 * int(d->methods.size());
@@ -1263,6 +1268,7 @@ static int buildMetaObject(QMetaObjectBuilderPrivate *d, char *buf,
             dataIndex += int(d->properties.size());
         dataIndex += 4 * int(d->enumerators.size());
         dataIndex += 5 * int(d->constructors.size());
+        dataIndex += methodHashTableSize;
     }
 
     // Allocate space for the enumerator key names and values.
@@ -1449,6 +1455,20 @@ static int buildMetaObject(QMetaObjectBuilderPrivate *d, char *buf,
         paramsIndex += 1 + argc * 2;
     }
 
+    // Output the method hash table.
+    Q_ASSERT(!buf || d->methods.empty() || dataIndex == pmeta->methodHashData);
+    if (buf && methodHashTableSize) {
+        QVarLengthArray<uint> hashes;
+        hashes.reserve(int(d->methods.size()));
+        for (const auto &method : d->methods) {
+            const QByteArray name = method.name();
+            hashes.append(QMetaObjectPrivate::methodNameHash(name.constData(), name.size()));
+        }
+        QMetaObjectPrivate::buildMethodHashTable(data + dataIndex, hashes.constData(),
+                                                 int(d->methods.size()));
+    }
+    dataIndex += methodHashTableSize;
+
     size += strings.blobSize();
 
     if (buf)
@@ -42,7 +42,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
-#include "qreadwritelock.h"
+#include "qmutex.h"
 #include "qstring.h"
 #include "qstringlist.h"
 #include "qvector.h"
@@ -500,60 +500,150 @@ Q_CORE_EXPORT const QMetaTypeInterface *qMetaTypeGuiHelper = 0;
 Q_CORE_EXPORT const QMetaTypeInterface *qMetaTypeWidgetsHelper = 0;
 Q_CORE_EXPORT const QMetaObject *qMetaObjectWidgetsHelper = 0;
 
+/*
+    A registered name of a custom type. Names are never modified or freed
+    while the registry exists, so lookups can compare against them without
+    locking; unregistering a type only clears the alive flag.
+*/
+struct QCustomTypeName
+{
+    QCustomTypeName(const QByteArray &name, int id)
+        : typeName(name), type(id), alive(1)
+    {}
+    const QByteArray typeName;
+    const int type;  // the type id, or the aliased type for typedefs
+    QAtomicInt alive;
+};
+
 class QCustomTypeInfo : public QMetaTypeInterface
 {
 public:
     QCustomTypeInfo()
-        : alias(-1)
+        : name(0), alias(-1)
     {
         QMetaTypeInterface empty = QT_METATYPE_INTERFACE_INIT(void);
         *static_cast<QMetaTypeInterface*>(this) = empty;
     }
-    QByteArray typeName;
+    QAtomicPointer<QCustomTypeName> name;  // null if unused or unregistered
     int alias;
 };
 
+/*
+    Maps a type (or a pair of types) to a converter, comparator or debug
+    stream function.
+
+    Lookups happen for every QVariant conversion and comparison, so they do
+    not take a lock: the entries live in an open addressing table that
+    readers probe after an acquire load. Writers serialize on a mutex, fill
+    in the key and the function before publishing an entry, and replace the
+    whole table when it becomes half full. Replaced tables are kept until the
+    registry is destroyed, since a reader may still be probing them;
+    registrations are rare, so this costs at most as much memory as the
+    current table.
+*/
 template<typename T, typename Key>
 class QMetaTypeFunctionRegistry
 {
+    struct Entry
+    {
+        QAtomicInt used;
+        Key key;
+        QAtomicPointer<const T> function;
+    };
+
+    struct Table
+    {
+        explicit Table(int size)
+            : mask(size - 1), count(0), entries(new Entry[size]), previous(0)
+        {}
+        ~Table() { delete [] entries; }
+
+        Entry *find(const Key &k) const
+        {
+            for (uint i = qHash(k) & mask; ; i = (i + 1) & mask) {
+                Entry *e = entries + i;
+                if (!e->used.loadAcquire() || e->key == k)
+                    return e;
+            }
+        }
+
+        const uint mask;
+        int count;
+        Entry *entries;
+        Table *previous;
+    };
+
 public:
     ~QMetaTypeFunctionRegistry()
     {
-        const QWriteLocker locker(&lock);
-        map.clear();
+        Table *t = table.load();
+        while (t) {
+            Table *previous = t->previous;
+            delete t;
+            t = previous;
+        }
     }
 
     bool contains(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.contains(k);
+        return function(k) != 0;
     }
 
     bool insertIfNotContains(Key k, const T *f)
     {
-        const QWriteLocker locker(&lock);
-        const T* &fun = map[k];
-        if (fun != 0)
+        const QMutexLocker locker(&lock);
+        Table *t = table.load();
+        if (!t || 2 * (t->count + 1) > int(t->mask + 1))
+            t = grow(t);
+        Entry *e = t->find(k);
+        if (e->function.load() != 0)
             return false;
-        fun = f;
+        e->function.storeRelease(f);
+        if (!e->used.load()) {
+            e->key = k;
+            e->used.storeRelease(1);
+            ++t->count;
+        }
         return true;
     }
 
     const T *function(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.value(k, 0);
+        const Table *t = table.loadAcquire();
+        return t ? t->find(k)->function.loadAcquire() : 0;
     }
 
     void remove(int from, int to)
     {
         const Key k(from, to);
-        const QWriteLocker locker(&lock);
-        map.remove(k);
+        const QMutexLocker locker(&lock);
+        if (Table *t = table.load())
+            t->find(k)->function.storeRelease(0);
     }
 private:
-    mutable QReadWriteLock lock;
-    QHash<Key, const T *> map;
+    // must be called with lock held
+    Table *grow(Table *old)
+    {
+        Table *t = new Table(old ? 2 * int(old->mask + 1) : 16);
+        if (old) {
+            for (uint i = 0; i <= old->mask; ++i) {
+                const Entry &o = old->entries[i];
+                if (!o.used.load() || !o.function.load())
+                    continue;
+                Entry *e = t->find(o.key);
+                e->key = o.key;
+                e->function.store(o.function.load());
+                e->used.store(1);
+                ++t->count;
+            }
+        }
+        t->previous = old;
+        table.storeRelease(t);
+        return t;
+    }
+
+    QMutex lock;
+    QAtomicPointer<Table> table;
 };
 
 typedef QMetaTypeFunctionRegistry<QtPrivate::AbstractConverterFunction,QPair<int,int> >
@@ -571,9 +661,181 @@ union CheckThatItIsPod
 };
 }
 
-Q_DECLARE_TYPEINFO(QCustomTypeInfo, Q_MOVABLE_TYPE);
-Q_GLOBAL_STATIC(QVector<QCustomTypeInfo>, customTypes)
-Q_GLOBAL_STATIC(QReadWriteLock, customTypesLock)
+/*
+    The custom types, indexed by type id - QMetaType::User.
+
+    QMetaType::type() and the per-type accessors run on every queued
+    connection and QVariant operation, so neither takes a lock. Entries are
+    allocated in chunks of growing size that are never moved, and are
+    published by a release store of the count; names are found through an
+    open addressing hash index that is replaced, not modified in place, when
+    it needs to grow. Registration, which is rare, serializes on the mutex.
+*/
+class QCustomTypeRegistry
+{
+    enum { FirstChunkSize = 64, ChunkCount = 25 };
+
+    struct NameIndex
+    {
+        explicit NameIndex(int size)
+            : mask(size - 1), count(0), entries(new QAtomicPointer<QCustomTypeName>[size]),
+              previous(0)
+        {}
+        ~NameIndex() { delete [] entries; }
+
+        const uint mask;
+        int count;
+        QAtomicPointer<QCustomTypeName> *entries;
+        NameIndex *previous;
+    };
+
+public:
+    QCustomTypeRegistry() : freeSlots(0) {}
+    ~QCustomTypeRegistry()
+    {
+        for (int i = 0; i < ChunkCount; ++i)
+            delete [] chunks[i].load();
+        for (NameIndex *t = index.load(); t; ) {
+            NameIndex *previous = t->previous;
+            delete t;
+            t = previous;
+        }
+        qDeleteAll(names);
+    }
+
+    // Returns the entry for the custom type \a type, or null if there is
+    // no such entry. Does not lock.
+    const QCustomTypeInfo *info(int type) const
+    {
+        const uint i = uint(type) - QMetaType::User;
+        if (Q_UNLIKELY(i >= uint(count.loadAcquire())))
+            return 0;
+        return entry(i);
+    }
+
+    // Returns the type called \a typeName, or QMetaType::UnknownType. Does
+    // not lock.
+    int type(const char *typeName, int length) const
+    {
+        const NameIndex *t = index.loadAcquire();
+        if (!t)
+            return QMetaType::UnknownType;
+        for (uint i = qHashBits(typeName, length) & t->mask; ; i = (i + 1) & t->mask) {
+            const QCustomTypeName *n = t->entries[i].loadAcquire();
+            if (!n)
+                return QMetaType::UnknownType;
+            if (n->typeName.size() == length && !memcmp(n->typeName.constData(), typeName, length)
+                    && n->alive.loadAcquire()) {
+                return n->type;
+            }
+        }
+    }
+
+    // Adds a type (or a typedef if \a alias is not negative) in the lowest
+    // free position and returns its type id. Must be called with the mutex
+    // held.
+    int add(const QByteArray &typeName, const QMetaTypeInterface &iface, int alias)
+    {
+        int i = 0;
+        const int n = count.load();
+        if (freeSlots) {
+            while (entry(i)->name.load())
+                ++i;
+            --freeSlots;
+        } else {
+            i = n;
+            const int chunk = chunkOf(i);
+            if (!chunks[chunk].load())
+                chunks[chunk].store(new QCustomTypeInfo[FirstChunkSize << chunk]);
+        }
+
+        QCustomTypeInfo *inf = entry(i);
+        *static_cast<QMetaTypeInterface *>(inf) = iface;
+        inf->alias = alias;
+        QCustomTypeName *name = new QCustomTypeName(typeName,
+                                                    alias >= 0 ? alias : i + QMetaType::User);
+        names.append(name);
+        inf->name.storeRelease(name);
+        if (i == n)
+            count.storeRelease(n + 1);
+        insertName(name);
+        return i + QMetaType::User;
+    }
+
+    // Must be called with the mutex held.
+    QCustomTypeInfo *mutableInfo(int type)
+    {
+        return const_cast<QCustomTypeInfo *>(info(type));
+    }
+
+    // Must be called with the mutex held.
+    void remove(int type)
+    {
+        QCustomTypeInfo *inf = mutableInfo(type);
+        inf->name.load()->alive.storeRelease(0);
+        inf->name.storeRelease(0);
+        ++freeSlots;
+    }
+
+    int size() const { return count.load(); }
+
+    QMutex mutex;
+
+private:
+    static int chunkOf(uint i)
+    {
+        return 31 - qCountLeadingZeroBits(quint32(i / FirstChunkSize + 1));
+    }
+
+    QCustomTypeInfo *entry(uint i) const
+    {
+        const int chunk = chunkOf(i);
+        return chunks[chunk].load() + (i - FirstChunkSize * ((1u << chunk) - 1));
+    }
+
+    void insertName(QCustomTypeName *name)
+    {
+        NameIndex *t = index.load();
+        if (!t || 2 * (t->count + 1) > int(t->mask + 1)) {
+            NameIndex *old = t;
+            t = new NameIndex(old ? 2 * int(old->mask + 1) : 256);
+            t->previous = old;
+            if (old) {
+                for (uint i = 0; i <= old->mask; ++i) {
+                    QCustomTypeName *n = old->entries[i].load();
+                    if (n && n->alive.load())
+                        insertName(t, n);
+                }
+            }
+            index.storeRelease(t);
+        }
+        insertName(t, name);
+    }
+
+    static void insertName(NameIndex *t, QCustomTypeName *name)
+    {
+        const QByteArray &typeName = name->typeName;
+        uint i = qHashBits(typeName.constData(), typeName.size()) & t->mask;
+        while (t->entries[i].load())
+            i = (i + 1) & t->mask;
+        t->entries[i].storeRelease(name);
+        ++t->count;
+    }
+
+    QAtomicPointer<QCustomTypeInfo> chunks[ChunkCount];
+    QAtomicInt count;
+    QAtomicPointer<NameIndex> index;
+    QVector<QCustomTypeName *> names;
+    int freeSlots;
+};
+
+Q_GLOBAL_STATIC(QCustomTypeRegistry, customTypes)
+
+static inline const QCustomTypeInfo *qMetaTypeCustomInfo(int type)
+{
+    const QCustomTypeRegistry *ct = customTypes();
+    return ct ? ct->info(type) : 0;
+}
 Q_GLOBAL_STATIC(QMetaTypeConverterRegistry, customTypesConversionRegistry)
 Q_GLOBAL_STATIC(QMetaTypeComparatorRegistry, customTypesComparatorRegistry)
 Q_GLOBAL_STATIC(QMetaTypeDebugStreamRegistry, customTypesDebugStreamRegistry)
@@ -816,13 +1078,15 @@ void QMetaType::registerStreamOperators(int idx, SaveOperator saveOp,
 {
     if (idx < User)
         return; //builtin types should not be registered;
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
     if (!ct)
         return;
-    QWriteLocker locker(customTypesLock());
-    QCustomTypeInfo &inf = (*ct)[idx - User];
-    inf.saveOp = saveOp;
-    inf.loadOp = loadOp;
+    QMutexLocker locker(&ct->mutex);
+    QCustomTypeInfo *inf = ct->mutableInfo(idx);
+    if (!inf)
+        return;
+    inf->saveOp = saveOp;
+    inf->loadOp = loadOp;
 }
 #endif // QT_NO_DATASTREAM
 
@@ -935,11 +1199,9 @@ const char *QMetaType::typeName(int typeId)
         return nullptr; // It can happen when someone cast int to QVariant::Type, we should not crash...
     }
 
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
-    QReadLocker locker(customTypesLock());
-    return ct && uint(ct->count()) > type - QMetaType::User && !ct->at(type - QMetaType::User).typeName.isEmpty()
-            ? ct->at(type - QMetaType::User).typeName.constData()
-            : nullptr;
+    const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+    const QCustomTypeName *name = info ? info->name.loadAcquire() : nullptr;
+    return name ? name->typeName.constData() : nullptr;
 
 #undef QT_METATYPE_TYPEID_TYPENAME_CONVERTER
 }
@@ -958,31 +1220,12 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 }
 
 /*
-    Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
-    The extra \a firstInvalidIndex parameter is an easy way to avoid
-    iterating over customTypes() a second time in registerNormalizedType().
+    Similar to QMetaType::type(), but only looks in the custom set of types.
 */
-static int qMetaTypeCustomType_unlocked(const char *typeName, int length, int *firstInvalidIndex = 0)
+static inline int qMetaTypeCustomType(const char *typeName, int length)
 {
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
-    if (!ct)
-        return QMetaType::UnknownType;
-
-    if (firstInvalidIndex)
-        *firstInvalidIndex = -1;
-    for (int v = 0; v < ct->count(); ++v) {
-        const QCustomTypeInfo &customInfo = ct->at(v);
-        if ((length == customInfo.typeName.size())
-            && !memcmp(typeName, customInfo.typeName.constData(), length)) {
-            if (customInfo.alias >= 0)
-                return customInfo.alias;
-            return v + QMetaType::User;
-        }
-        if (firstInvalidIndex && (*firstInvalidIndex < 0) && customInfo.typeName.isEmpty())
-            *firstInvalidIndex = v;
-    }
-    return QMetaType::UnknownType;
+    const QCustomTypeRegistry *ct = customTypes();
+    return ct ? ct->type(typeName, length) : int(QMetaType::UnknownType);
 }
 
 /*!
@@ -1012,21 +1255,25 @@ int QMetaType::registerType(const char *typeName, Deleter deleter,
  */
 bool QMetaType::unregisterType(int type)
 {
-    QWriteLocker locker(customTypesLock());
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
+    if (!ct)
+        return false;
+    QMutexLocker locker(&ct->mutex);
 
     // check if user type
-    if ((type < User) || ((type - User) >= ct->size()))
+    const QCustomTypeInfo *inf = ct->info(type);
+    if (!inf || !inf->name.load())
         return false;
 
     // only types without Q_DECLARE_METATYPE can be unregistered
-    if (ct->data()[type - User].flags & WasDeclaredAsMetaType)
+    if (inf->flags & WasDeclaredAsMetaType)
         return false;
 
     // invalidate type and all its alias entries
-    for (int v = 0; v < ct->count(); ++v) {
-        if (((v + User) == type) || (ct->at(v).alias == type))
-            ct->data()[v].typeName.clear();
+    for (int v = User; v < ct->size() + User; ++v) {
+        inf = ct->info(v);
+        if (inf->name.load() && (v == type || inf->alias == type))
+            ct->remove(v);
     }
     return true;
 }
@@ -1093,7 +1340,7 @@ int QMetaType::registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
                             Constructor constructor,
                             int size, TypeFlags flags, const QMetaObject *metaObject)
 {
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
     if (!ct || normalizedTypeName.isEmpty() || !destructor || !constructor)
         return -1;
 
@@ -1103,46 +1350,41 @@ int QMetaType::registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
     int previousSize = 0;
     QMetaType::TypeFlags::Int previousFlags = 0;
     if (idx == UnknownType) {
-        QWriteLocker locker(customTypesLock());
-        int posInVector = -1;
-        idx = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                           normalizedTypeName.size(),
-                                           &posInVector);
+        // qRegisterMetaType() is called over and over for the same types,
+        // so look for an existing registration before taking the mutex
+        idx = ct->type(normalizedTypeName.constData(), normalizedTypeName.size());
         if (idx == UnknownType) {
-            QCustomTypeInfo inf;
-            inf.typeName = normalizedTypeName;
+            QMutexLocker locker(&ct->mutex);
+            idx = ct->type(normalizedTypeName.constData(), normalizedTypeName.size());
+            if (idx == UnknownType) {
+                QMetaTypeInterface inf = QT_METATYPE_INTERFACE_INIT(void);
 #ifndef QT_NO_DATASTREAM
-            inf.loadOp = 0;
-            inf.saveOp = 0;
+                inf.loadOp = 0;
+                inf.saveOp = 0;
 #endif
-            inf.alias = -1;
-            inf.constructor = constructor;
-            inf.destructor = destructor;
-            inf.size = size;
-            inf.flags = flags;
-            inf.metaObject = metaObject;
-            if (posInVector == -1) {
-                idx = ct->size() + User;
-                ct->append(inf);
-            } else {
-                idx = posInVector + User;
-                ct->data()[posInVector] = inf;
+                inf.constructor = constructor;
+                inf.destructor = destructor;
+                inf.size = size;
+                inf.flags = flags;
+                inf.metaObject = metaObject;
+                return ct->add(normalizedTypeName, inf, -1);
             }
-            return idx;
         }
 
         if (idx >= User) {
-            previousSize = ct->at(idx - User).size;
-            previousFlags = ct->at(idx - User).flags;
+            const QCustomTypeInfo *inf = ct->info(idx);
+            previousSize = inf->size;
+            previousFlags = inf->flags;
 
             // Set new/additional flags in case of old library/app.
             // Ensures that older code works in conjunction with new Qt releases
             // requiring the new flags.
             if (flags != previousFlags) {
-                QCustomTypeInfo &inf = ct->data()[idx - User];
-                inf.flags |= flags;
+                QMutexLocker locker(&ct->mutex);
+                QCustomTypeInfo *inf = ct->mutableInfo(idx);
+                inf->flags |= flags;
                 if (metaObject)
-                    inf.metaObject = metaObject;
+                    inf->metaObject = metaObject;
             }
         }
     }
@@ -1201,7 +1443,7 @@ int QMetaType::registerTypedef(const char* typeName, int aliasId)
 */
 int QMetaType::registerNormalizedTypedef(const NS(QByteArray) &normalizedTypeName, int aliasId)
 {
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
     if (!ct || normalizedTypeName.isEmpty())
         return -1;
 
@@ -1209,20 +1451,12 @@ int QMetaType::registerNormalizedTypedef(const NS(QByteArray) &normalizedTypeNam
                                   normalizedTypeName.size());
 
     if (idx == UnknownType) {
-        QWriteLocker locker(customTypesLock());
-        int posInVector = -1;
-        idx = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                               normalizedTypeName.size(),
-                                               &posInVector);
+        QMutexLocker locker(&ct->mutex);
+        idx = ct->type(normalizedTypeName.constData(), normalizedTypeName.size());
 
         if (idx == UnknownType) {
-            QCustomTypeInfo inf;
-            inf.typeName = normalizedTypeName;
-            inf.alias = aliasId;
-            if (posInVector == -1)
-                ct->append(inf);
-            else
-                ct->data()[posInVector] = inf;
+            const QMetaTypeInterface inf = QT_METATYPE_INTERFACE_INIT(void);
+            ct->add(normalizedTypeName, inf, aliasId);
             return aliasId;
         }
     }
@@ -1252,9 +1486,8 @@ bool QMetaType::isRegistered(int type)
         return true;
     }
 
-    QReadLocker locker(customTypesLock());
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
-    return ((type >= User) && (ct && ct->count() > type - User) && !ct->at(type - User).typeName.isEmpty());
+    const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+    return info && info->name.loadAcquire();
 }
 
 template <bool tryNormalizedType>
@@ -1264,16 +1497,15 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(customTypesLock());
-        type = qMetaTypeCustomType_unlocked(typeName, length);
+        type = qMetaTypeCustomType(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
             const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
             type = qMetaTypeStaticType(normalizedTypeName.constData(),
                                        normalizedTypeName.size());
             if (type == QMetaType::UnknownType) {
-                type = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                                    normalizedTypeName.size());
+                type = qMetaTypeCustomType(normalizedTypeName.constData(),
+                                           normalizedTypeName.size());
             }
         }
 #endif
@@ -1524,16 +1756,8 @@ bool QMetaType::save(QDataStream &stream, int type, const void *data)
         stream << *static_cast<const NS(QUuid)*>(data);
         break;
     default: {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (!ct)
-            return false;
-
-        SaveOperator saveOp = 0;
-        {
-            QReadLocker locker(customTypesLock());
-            saveOp = ct->at(type - User).saveOp;
-        }
-
+        const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+        const SaveOperator saveOp = info ? info->saveOp : 0;
         if (!saveOp)
             return false;
         saveOp(stream, data);
@@ -1754,16 +1978,8 @@ bool QMetaType::load(QDataStream &stream, int type, void *data)
         stream >> *static_cast< NS(QUuid)*>(data);
         break;
     default: {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (!ct)
-            return false;
-
-        LoadOperator loadOp = 0;
-        {
-            QReadLocker locker(customTypesLock());
-            loadOp = ct->at(type - User).loadOp;
-        }
-
+        const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+        const LoadOperator loadOp = info ? info->loadOp : 0;
         if (!loadOp)
             return false;
         loadOp(stream, data);
@@ -1835,14 +2051,10 @@ public:
 private:
     static void *customTypeConstructor(const int type, void *where, const void *copy)
     {
-        QMetaType::Constructor ctor;
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        {
-            QReadLocker locker(customTypesLock());
-            if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
-                return 0;
-            ctor = ct->at(type - QMetaType::User).constructor;
-        }
+        const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+        if (Q_UNLIKELY(!info))
+            return 0;
+        const QMetaType::Constructor ctor = info->constructor;
         Q_ASSERT_X(ctor, "void *QMetaType::construct(int type, void *where, const void *copy)", "The type was not properly registered");
         return ctor(where, copy);
     }
@@ -1928,14 +2140,10 @@ public:
 private:
     static void customTypeDestructor(const int type, void *where)
     {
-        QMetaType::Destructor dtor;
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        {
-            QReadLocker locker(customTypesLock());
-            if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
-                return;
-            dtor = ct->at(type - QMetaType::User).destructor;
-        }
+        const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+        if (Q_UNLIKELY(!info))
+            return;
+        const QMetaType::Destructor dtor = info->destructor;
         Q_ASSERT_X(dtor, "void QMetaType::destruct(int type, void *where)", "The type was not properly registered");
         dtor(where);
     }
@@ -1997,11 +2205,8 @@ public:
 private:
     static int customTypeSizeOf(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        QReadLocker locker(customTypesLock());
-        if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
-            return 0;
-        return ct->at(type - QMetaType::User).size;
+        const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+        return Q_LIKELY(info) ? info->size : 0;
     }
 
     const int m_type;
@@ -2065,13 +2270,8 @@ private:
     const int m_type;
     static quint32 customTypeFlags(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (Q_UNLIKELY(!ct || type < QMetaType::User))
-            return 0;
-        QReadLocker locker(customTypesLock());
-        if (Q_UNLIKELY(ct->count() <= type - QMetaType::User))
-            return 0;
-        return ct->at(type - QMetaType::User).flags;
+        const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+        return Q_LIKELY(info) ? info->flags : 0;
     }
 };
 }  // namespace
@@ -2125,13 +2325,8 @@ private:
     const int m_type;
     static const QMetaObject *customMetaObject(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (Q_UNLIKELY(!ct || type < QMetaType::User))
-            return 0;
-        QReadLocker locker(customTypesLock());
-        if (Q_UNLIKELY(ct->count() <= type - QMetaType::User))
-            return 0;
-        return ct->at(type - QMetaType::User).metaObject;
+        const QCustomTypeInfo *info = qMetaTypeCustomInfo(type);
+        return Q_LIKELY(info) ? info->metaObject : 0;
     }
 };
 }  // namespace
@@ -2329,12 +2524,8 @@ public:
 private:
     void customTypeInfo(const uint type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (Q_UNLIKELY(!ct))
-            return;
-        QReadLocker locker(customTypesLock());
-        if (Q_LIKELY(uint(ct->count()) > type - QMetaType::User))
-            info = ct->at(type - QMetaType::User);
+        if (const QCustomTypeInfo *custom = qMetaTypeCustomInfo(type))
+            info = *custom;
     }
 
     const uint m_type;
@@ -62,6 +62,8 @@
 
 #include <private/qorderedmutexlocker_p.h>
 #include <private/qhooks_p.h>
+#include <private/qfreelist_p.h>
+#include <private/qtcore_tracepoints_p.h>
 
 #include <new>
 
@@ -291,30 +293,198 @@ static void computeOffsets(const QMetaObject *metaobject, int *signalOffset, int
 
     This vector is protected by the object mutex (signalSlotMutexes())
 
+    Emissions read the lists without locking the mutex (see
+    QMetaObject::activate()). What they might still reach is not freed
+    right away: disconnected connections, their slot objects and the signal
+    vectors replaced when growing are retired. Each emission counts itself
+    in the epoch it started in; what was retired before an epoch began is
+    freed once the emissions of the previous epoch have all finished, so
+    that emissions that keep overlapping never hold it back for long.
+
     Each Connection is also part of a 'senders' linked list. The mutex
     of the receiver must be locked when touching the pointers of this
     linked list.
 */
-class QObjectConnectionListVector : public QVector<QObjectPrivate::ConnectionList>
+class QObjectConnectionListVector
 {
 public:
+    typedef QVector<QObjectPrivate::ConnectionList> SignalVector;
+    struct Orphans {
+        QVector<QObjectPrivate::Connection *> connections; //each one holds a reference
+        QVector<SignalVector *> signalVectors;
+        bool isEmpty() const { return connections.isEmpty() && signalVectors.isEmpty(); }
+    };
+
     bool orphaned; //the QObject owner of this vector has been destroyed while the vector was inUse
     bool dirty; //some Connection have been disconnected (their receiver is 0) but not removed from the list yet
     int inUse; //number of functions that are currently accessing this object or its connections
+    QAtomicInt epoch;
+    QAtomicInt emitting[2]; //number of emissions reading the lists without the lock, by parity of their epoch
+    QAtomicInt hasOrphans;
+    QAtomicInteger<uint> currentConnectionId; //id of the most recent connection
     QObjectPrivate::ConnectionList allsignals;
+    QAtomicPointer<SignalVector> signalVector;
+    Orphans orphans; //retired during the current epoch
+    Orphans expiring; //retired before the current epoch
 
     QObjectConnectionListVector()
-        : QVector<QObjectPrivate::ConnectionList>(), orphaned(false), dirty(false), inUse(0)
+        : orphaned(false), dirty(false), inUse(0)
     { }
+    ~QObjectConnectionListVector();
+
+    int count() const
+    {
+        const SignalVector *vector = signalVector.load();
+        return vector ? vector->count() : 0;
+    }
+
+    const QObjectPrivate::ConnectionList &at(int at) const
+    {
+        return signalVector.load()->at(at);
+    }
 
     QObjectPrivate::ConnectionList &operator[](int at)
     {
         if (at < 0)
             return allsignals;
-        return QVector<QObjectPrivate::ConnectionList>::operator[](at);
+        return (*signalVector.load())[at];
+    }
+
+    int pin()
+    {
+        forever {
+            const int e = epoch.loadAcquire();
+            emitting[e & 1].ref();
+            // make sure no epoch began before we were counted
+            if (epoch.fetchAndAddOrdered(0) == e)
+                return e & 1;
+            emitting[e & 1].deref();
+        }
+    }
+
+    // returns false if this was the last emission of its epoch
+    bool unpin(int parity) { return emitting[parity].deref(); }
+
+    bool isEmitting()
+    {
+        return emitting[0].fetchAndAddOrdered(0) || emitting[1].fetchAndAddOrdered(0);
     }
+
+    void resize(int size);
+    void retire(QObjectPrivate::Connection *c);
+    QtPrivate::QSlotObjectBase *takeSlotObject(QObjectPrivate::Connection *c);
+    void cleanOrphans(QMutex *senderMutex);
 };
 
+static void releaseOrphans(const QObjectConnectionListVector::Orphans &orphans)
+{
+    for (QObjectPrivate::Connection *c : orphans.connections) {
+        if (c->isSlotObject) {
+            c->isSlotObject = false;
+            c->slotObj->destroyIfLastRef();
+        }
+        c->deref();
+    }
+    qDeleteAll(orphans.signalVectors);
+}
+
+QObjectConnectionListVector::~QObjectConnectionListVector()
+{
+    releaseOrphans(expiring);
+    releaseOrphans(orphans);
+    delete signalVector.load();
+}
+
+/*!
+  \internal
+  Grows the vector to \a size signals. The signalSlotLock() of the owner
+  must be locked.
+ */
+void QObjectConnectionListVector::resize(int size)
+{
+    SignalVector *previous = signalVector.load();
+    SignalVector *vector = new SignalVector(size);
+    for (int signal = 0; signal < count(); ++signal)
+        (*vector)[signal] = previous->at(signal);
+    signalVector.storeRelease(vector);
+
+    if (!previous)
+        return;
+    if (isEmitting()) {
+        orphans.signalVectors.append(previous);
+        hasOrphans.store(1);
+    } else {
+        delete previous;
+    }
+}
+
+/*!
+  \internal
+  Releases the reference of the lists to the connection \a c, which has
+  just been unlinked, once no emission can reach it anymore. The
+  signalSlotLock() of the owner must be locked.
+ */
+void QObjectConnectionListVector::retire(QObjectPrivate::Connection *c)
+{
+    if (isEmitting()) {
+        orphans.connections.append(c);
+        hasOrphans.store(1);
+    } else {
+        c->deref();
+    }
+}
+
+/*!
+  \internal
+  Returns the slot object of the disconnected connection \a c, which the
+  caller must destroy once the signalSlotLock() of the owner is unlocked.
+  Returns 0 if an emission might still call it; it is then destroyed by
+  cleanOrphans().
+ */
+QtPrivate::QSlotObjectBase *QObjectConnectionListVector::takeSlotObject(QObjectPrivate::Connection *c)
+{
+    Q_ASSERT(c->isSlotObject && !c->receiver.load());
+    if (!isEmitting()) {
+        c->isSlotObject = false;
+        return c->slotObj;
+    }
+    c->ref();
+    orphans.connections.append(c);
+    hasOrphans.store(1);
+    return Q_NULLPTR;
+}
+
+/*!
+  \internal
+  Frees what no emission can reach anymore, and begins a new epoch for
+  what was retired during the current one. \a senderMutex must be locked;
+  it is unlocked while the slot objects are destroyed.
+ */
+void QObjectConnectionListVector::cleanOrphans(QMutex *senderMutex)
+{
+    Orphans released;
+    while (hasOrphans.load()) {
+        // the emissions of the previous epoch may still see what expires
+        const int e = epoch.load();
+        if (emitting[(e + 1) & 1].fetchAndAddOrdered(0))
+            break;
+        released.connections += expiring.connections;
+        released.signalVectors += expiring.signalVectors;
+        expiring = orphans;
+        orphans = Orphans();
+        if (expiring.isEmpty())
+            hasOrphans.store(0);
+        else
+            epoch.fetchAndAddOrdered(1);
+    }
+    if (released.isEmpty())
+        return;
+
+    senderMutex->unlock();
+    releaseOrphans(released);
+    senderMutex->lock();
+}
+
 // Used by QAccessibleWidget
 bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
 {
@@ -323,15 +493,15 @@ bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
     if (signal_index < 0)
         return false;
     QMutexLocker locker(signalSlotLock(q));
-    if (connectionLists) {
+    if (const QObjectConnectionListVector *connectionLists = this->connectionLists.load()) {
         if (signal_index < connectionLists->count()) {
             const QObjectPrivate::Connection *c =
-                connectionLists->at(signal_index).first;
+                connectionLists->at(signal_index).first.load();
 
             while (c) {
-                if (c->receiver == receiver)
+                if (c->receiver.load() == receiver)
                     return true;
-                c = c->nextConnectionList;
+                c = c->nextConnectionList.load();
             }
         }
     }
@@ -347,14 +517,14 @@ QObjectList QObjectPrivate::receiverList(const char *signal) const
     if (signal_index < 0)
         return returnValue;
     QMutexLocker locker(signalSlotLock(q));
-    if (connectionLists) {
+    if (const QObjectConnectionListVector *connectionLists = this->connectionLists.load()) {
         if (signal_index < connectionLists->count()) {
-            const QObjectPrivate::Connection *c = connectionLists->at(signal_index).first;
+            const QObjectPrivate::Connection *c = connectionLists->at(signal_index).first.load();
 
             while (c) {
-                if (c->receiver)
-                    returnValue << c->receiver;
-                c = c->nextConnectionList;
+                if (QObject *receiver = c->receiver.load())
+                    returnValue << receiver;
+                c = c->nextConnectionList.load();
             }
         }
     }
@@ -384,22 +554,28 @@ QObjectList QObjectPrivate::senderList() const
 void QObjectPrivate::addConnection(int signal, Connection *c)
 {
     Q_ASSERT(c->sender == q_ptr);
-    if (!connectionLists)
+    QObjectConnectionListVector *connectionLists = this->connectionLists.load();
+    if (!connectionLists) {
         connectionLists = new QObjectConnectionListVector();
+        this->connectionLists.storeRelease(connectionLists);
+    }
     if (signal >= connectionLists->count())
         connectionLists->resize(signal + 1);
 
+    c->id = connectionLists->currentConnectionId.load() + 1;
+    connectionLists->currentConnectionId.storeRelease(c->id);
+
     ConnectionList &connectionList = (*connectionLists)[signal];
-    if (connectionList.last) {
-        connectionList.last->nextConnectionList = c;
+    if (Connection *last = connectionList.last.load()) {
+        last->nextConnectionList.storeRelease(c);
     } else {
-        connectionList.first = c;
+        connectionList.first.storeRelease(c);
     }
-    connectionList.last = c;
+    connectionList.last.store(c);
 
     cleanConnectionLists();
 
-    c->prev = &(QObjectPrivate::get(c->receiver)->senders);
+    c->prev = &(QObjectPrivate::get(c->receiver.load())->senders);
     c->next = *c->prev;
     *c->prev = c;
     if (c->next)
@@ -414,7 +590,10 @@ void QObjectPrivate::addConnection(int signal, Connection *c)
 
 void QObjectPrivate::cleanConnectionLists()
 {
+    QObjectConnectionListVector *connectionLists = this->connectionLists.load();
     if (connectionLists->dirty && !connectionLists->inUse) {
+        QVarLengthArray<Connection *, 16> removed;
+
         // remove broken connections
         for (int signal = -1; signal < connectionLists->count(); ++signal) {
             QObjectPrivate::ConnectionList &connectionList =
@@ -425,26 +604,28 @@ void QObjectPrivate::cleanConnectionLists()
             // at the end of the cleanup.
             QObjectPrivate::Connection *last = 0;
 
-            QObjectPrivate::Connection **prev = &connectionList.first;
-            QObjectPrivate::Connection *c = *prev;
+            QAtomicPointer<QObjectPrivate::Connection> *prev = &connectionList.first;
+            QObjectPrivate::Connection *c = prev->load();
             while (c) {
-                if (c->receiver) {
+                QObjectPrivate::Connection *next = c->nextConnectionList.load();
+                if (c->receiver.load()) {
                     last = c;
                     prev = &c->nextConnectionList;
-                    c = *prev;
                 } else {
-                    QObjectPrivate::Connection *next = c->nextConnectionList;
-                    *prev = next;
-                    c->deref();
-                    c = next;
+                    prev->storeRelease(next);
+                    removed.append(c);
                 }
+                c = next;
             }
 
             // Correct the connection list's last pointer.
             // As conectionList.last could equal last, this could be a noop
-            connectionList.last = last;
+            connectionList.last.store(last);
         }
         connectionLists->dirty = false;
+
+        for (Connection *c : qAsConst(removed))
+            connectionLists->retire(c);
     }
 }
 
@@ -456,8 +637,12 @@ QMetaCallEvent::QMetaCallEvent(ushort method_offset, ushort method_relative, QOb
                                int nargs, int *types, void **args, QSemaphore *semaphore)
     : QEvent(MetaCall), slotObj_(0), sender_(sender), signalId_(signalId),
       nargs_(nargs), types_(types), args_(args), semaphore_(semaphore),
-      callFunction_(callFunction), method_offset_(method_offset), method_relative_(method_relative)
-{ }
+      callFunction_(callFunction), method_offset_(method_offset), method_relative_(method_relative),
+      inlineDataUsed_(0)
+{
+    if (nargs_ > 0 && !types_ && !args_)
+        allocateArguments();
+}
 
 /*!
     \internal
@@ -466,10 +651,13 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::QSlotObjectBase *slotO, const QObject
                                int nargs, int *types, void **args, QSemaphore *semaphore)
     : QEvent(MetaCall), slotObj_(slotO), sender_(sender), signalId_(signalId),
       nargs_(nargs), types_(types), args_(args), semaphore_(semaphore),
-      callFunction_(0), method_offset_(0), method_relative_(ushort(-1))
+      callFunction_(0), method_offset_(0), method_relative_(ushort(-1)),
+      inlineDataUsed_(0)
 {
     if (slotObj_)
         slotObj_->ref();
+    if (nargs_ > 0 && !types_ && !args_)
+        allocateArguments();
 }
 
 /*!
@@ -479,11 +667,17 @@ QMetaCallEvent::~QMetaCallEvent()
 {
     if (types_) {
         for (int i = 0; i < nargs_; ++i) {
-            if (types_[i] && args_[i])
+            if (!types_[i] || !args_[i])
+                continue;
+            if (isInlineArgument(args_[i]))
+                QMetaType::destruct(types_[i], args_[i]);
+            else
                 QMetaType::destroy(types_[i], args_[i]);
         }
-        free(types_);
-        free(args_);
+        if (types_ != inlineTypes_) {
+            free(types_);
+            free(args_);
+        }
     }
 #ifndef QT_NO_THREAD
     if (semaphore_)
@@ -493,6 +687,208 @@ QMetaCallEvent::~QMetaCallEvent()
         slotObj_->destroyIfLastRef();
 }
 
+/*!
+    \internal
+
+    Called when the event was created with a number of arguments but
+    without the arrays holding them: the event then owns the arrays, and
+    the arguments are filled in with copyArgument(). The arrays of small
+    argument packs are kept inside the event itself.
+ */
+void QMetaCallEvent::allocateArguments()
+{
+    if (nargs_ <= InlineArgumentCount) {
+        types_ = inlineTypes_;
+        args_ = inlineArgs_;
+        memset(inlineTypes_, 0, sizeof(inlineTypes_));
+        memset(inlineArgs_, 0, sizeof(inlineArgs_));
+    } else {
+        types_ = static_cast<int *>(calloc(nargs_, sizeof(int)));
+        Q_CHECK_PTR(types_);
+        args_ = static_cast<void **>(calloc(nargs_, sizeof(void *)));
+        Q_CHECK_PTR(args_);
+    }
+}
+
+/*!
+    \internal
+
+    Returns space for an argument of \a size bytes in the event's inline
+    buffer, or 0 if it does not fit. Since the alignment of a type always
+    divides its size, aligning the argument to the lowest set bit of \a size
+    is sufficient.
+ */
+void *QMetaCallEvent::inlineArgumentStorage(int size)
+{
+    if (size <= 0 || size > InlineArgumentDataSize)
+        return 0;
+    const quintptr alignment = quintptr(size) & (0 - quintptr(size));
+    const quintptr base = quintptr(inlineData_);
+    const quintptr offset = ((base + inlineDataUsed_ + alignment - 1) & ~(alignment - 1)) - base;
+    if (offset + size > quintptr(InlineArgumentDataSize))
+        return 0;
+    return inlineData_ + offset;
+}
+
+/*!
+    \internal
+
+    Stores a copy of \a copy, which is of the meta type \a type, as the
+    argument at \a index. Arguments that are small enough are constructed in
+    the event's inline buffer; others are allocated on the heap.
+
+    Only valid for events that own their arguments, see allocateArguments().
+ */
+void *QMetaCallEvent::copyArgument(int index, int type, const void *copy)
+{
+    Q_ASSERT(types_ == inlineTypes_ || nargs_ > InlineArgumentCount);
+    Q_ASSERT(index > 0 && index < nargs_);
+    types_[index] = type;
+    void *arg = 0;
+    if (void *where = inlineArgumentStorage(QMetaType::sizeOf(type))) {
+        arg = QMetaType::construct(type, where, copy);
+        if (arg)
+            inlineDataUsed_ = ushort(static_cast<char *>(where) - inlineData_ + QMetaType::sizeOf(type));
+    }
+    if (!arg)
+        arg = QMetaType::create(type, copy);
+    args_[index] = arg;
+    return arg;
+}
+
+namespace {
+// Queued calls create and destroy meta call events at a high rate, and
+// often in different threads; so do programs with many small objects for
+// their QObjectPrivate. Those of the common sizes are taken from lock-free
+// pools of fixed size blocks instead of the general allocator. The header
+// before each block tells operator delete where it came from.
+union PoolBlockHeader
+{
+    int id; // index in the pool, or -1 if allocated on the heap
+    qint64 forAlignment1;
+    double forAlignment2;
+    void *forAlignment3;
+    long double forAlignment4;
+};
+
+template <int Size>
+struct PoolBlock
+{
+    PoolBlockHeader header;
+    union {
+        char data[Size];
+        PoolBlockHeader forAlignment;
+    };
+};
+
+template <int Capacity>
+struct BlockPoolConstants : QFreeListDefaultConstants
+{
+    enum {
+        InitialNextValue = 0,
+        BlockCount = 4
+    };
+    static const int Sizes[BlockCount];
+};
+
+template <int Capacity>
+const int BlockPoolConstants<Capacity>::Sizes[BlockPoolConstants<Capacity>::BlockCount] = {
+    64,
+    256,
+    1024,
+    Capacity - 64 - 256 - 1024
+};
+
+template <int Size, int Capacity>
+struct BlockPool
+{
+    typedef QFreeList<PoolBlock<Size>, BlockPoolConstants<Capacity> > Blocks;
+
+    BlockPool() : blocks(new Blocks) { }
+    // what is still in use may be freed after us, e.g. by global objects
+    ~BlockPool() { if (!used.load()) delete blocks; }
+
+    Blocks *blocks;
+    // the blocks in use, so that we never ask the free list for more
+    // than it has and fall back to the heap instead
+    QAtomicInt used;
+};
+
+template <int Size, int Capacity>
+void *allocateBlock(BlockPool<Size, Capacity> *pool, std::size_t size)
+{
+    if (size <= Size && pool) {
+        if (pool->used.fetchAndAddRelaxed(1) < Capacity) {
+            const int id = pool->blocks->next();
+            PoolBlock<Size> &block = (*pool->blocks)[id];
+            block.header.id = id;
+            return block.data;
+        }
+        pool->used.fetchAndAddRelaxed(-1);
+    }
+    PoolBlockHeader *header = static_cast<PoolBlockHeader *>(::operator new(sizeof(PoolBlockHeader) + size));
+    header->id = -1;
+    return header + 1;
+}
+
+template <int Size, int Capacity>
+void freeBlock(BlockPool<Size, Capacity> *pool, void *ptr)
+{
+    if (!ptr)
+        return;
+    PoolBlockHeader *header = static_cast<PoolBlockHeader *>(ptr) - 1;
+    if (header->id < 0) {
+        ::operator delete(header);
+        return;
+    }
+    // once the pool is gone, the block is never reused
+    if (pool) {
+        pool->blocks->release(header->id);
+        pool->used.fetchAndAddRelaxed(-1);
+    }
+}
+
+typedef BlockPool<256, 4096> MetaCallEventPool;
+typedef BlockPool<128, 16384> ObjectPrivatePool;
+}
+
+Q_GLOBAL_STATIC(MetaCallEventPool, metaCallEventPool)
+Q_GLOBAL_STATIC(ObjectPrivatePool, objectPrivatePool)
+
+/*!
+    \internal
+ */
+void *QMetaCallEvent::operator new(std::size_t size)
+{
+    return allocateBlock(metaCallEventPool(), size);
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr) Q_DECL_NOTHROW
+{
+    freeBlock(metaCallEventPool(), ptr);
+}
+
+/*!
+    \internal
+    QObjectPrivate and the subclasses that are not larger are allocated
+    from a pool, since many programs create and destroy a lot of objects.
+ */
+void *QObjectPrivate::operator new(std::size_t size)
+{
+    return allocateBlock(objectPrivatePool(), size);
+}
+
+/*!
+    \internal
+ */
+void QObjectPrivate::operator delete(void *ptr) Q_DECL_NOTHROW
+{
+    freeBlock(objectPrivatePool(), ptr);
+}
+
 /*!
     \internal
  */
@@ -507,6 +903,42 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*!
+    \internal
+ */
+QBatchedMetaCallEvent::QBatchedMetaCallEvent(QObjectPrivate::Connection *c, ushort method_offset,
+                                             ushort method_relative,
+                                             QObjectPrivate::StaticMetaCallFunction callFunction,
+                                             const QObject *sender, int signalId,
+                                             int nargs, int *types, void **args)
+    : QMetaCallEvent(method_offset, method_relative, callFunction, sender, signalId, nargs, types, args),
+      connection(c), nextBatched(nullptr)
+{
+    connection->ref();
+}
+
+/*!
+    \internal
+ */
+QBatchedMetaCallEvent::QBatchedMetaCallEvent(QObjectPrivate::Connection *c,
+                                             QtPrivate::QSlotObjectBase *slotObj,
+                                             const QObject *sender, int signalId,
+                                             int nargs, int *types, void **args)
+    : QMetaCallEvent(slotObj, sender, signalId, nargs, types, args),
+      connection(c), nextBatched(nullptr)
+{
+    connection->ref();
+}
+
+/*!
+    \internal
+ */
+QBatchedMetaCallEvent::~QBatchedMetaCallEvent()
+{
+    if (connection)
+        connection->deref();
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals()
@@ -917,37 +1349,37 @@ QObject::~QObject()
         d->currentSender->ref = 0;
     d->currentSender = 0;
 
-    if (d->connectionLists || d->senders) {
+    if (d->connectionLists.load() || d->senders) {
         QMutex *signalSlotMutex = signalSlotLock(this);
         QMutexLocker locker(signalSlotMutex);
 
         // disconnect all receivers
-        if (d->connectionLists) {
-            ++d->connectionLists->inUse;
-            int connectionListsCount = d->connectionLists->count();
+        if (QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+            ++connectionLists->inUse;
+            int connectionListsCount = connectionLists->count();
             for (int signal = -1; signal < connectionListsCount; ++signal) {
                 QObjectPrivate::ConnectionList &connectionList =
-                    (*d->connectionLists)[signal];
+                    (*connectionLists)[signal];
 
-                while (QObjectPrivate::Connection *c = connectionList.first) {
-                    if (!c->receiver) {
-                        connectionList.first = c->nextConnectionList;
+                while (QObjectPrivate::Connection *c = connectionList.first.load()) {
+                    if (!c->receiver.load()) {
+                        connectionList.first.store(c->nextConnectionList.load());
                         c->deref();
                         continue;
                     }
 
-                    QMutex *m = signalSlotLock(c->receiver);
+                    QMutex *m = signalSlotLock(c->receiver.load());
                     bool needToUnlock = QOrderedMutexLocker::relock(signalSlotMutex, m);
 
-                    if (c->receiver) {
+                    if (c->receiver.load()) {
                         *c->prev = c->next;
                         if (c->next) c->next->prev = c->prev;
                     }
-                    c->receiver = 0;
+                    c->receiver.store(0);
                     if (needToUnlock)
                         m->unlock();
 
-                    connectionList.first = c->nextConnectionList;
+                    connectionList.first.store(c->nextConnectionList.load());
 
                     // The destroy operation must happen outside the lock
                     if (c->isSlotObject) {
@@ -960,12 +1392,13 @@ QObject::~QObject()
                 }
             }
 
-            if (!--d->connectionLists->inUse) {
-                delete d->connectionLists;
+            if (!--connectionLists->inUse && !connectionLists->isEmitting()) {
+                connectionLists->cleanOrphans(signalSlotMutex);
+                delete connectionLists;
             } else {
-                d->connectionLists->orphaned = true;
+                connectionLists->orphaned = true;
             }
-            d->connectionLists = 0;
+            d->connectionLists.store(0);
         }
 
         /* Disconnect all senders:
@@ -994,15 +1427,19 @@ QObject::~QObject()
                 m->unlock();
                 continue;
             }
-            node->receiver = 0;
-            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists;
+            node->receiver.store(0);
+            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists.load();
             if (senderLists)
                 senderLists->dirty = true;
 
             QtPrivate::QSlotObjectBase *slotObj = Q_NULLPTR;
             if (node->isSlotObject) {
-                slotObj = node->slotObj;
-                node->isSlotObject = false;
+                if (senderLists) {
+                    slotObj = senderLists->takeSlotObject(node);
+                } else {
+                    slotObj = node->slotObj;
+                    node->isSlotObject = false;
+                }
             }
 
             node = node->next;
@@ -1416,6 +1853,23 @@ QThread *QObject::thread() const
     return d_func()->threadData->thread;
 }
 
+/*!
+  \internal
+  Updates the thread cached in the connections to \a object and its
+  children, which have been moved to the thread of \a data.
+ */
+static void updateReceiverThreadData(QObject *object, QThreadData *data)
+{
+    QObjectPrivate *d = QObjectPrivate::get(object);
+    {
+        QMutexLocker locker(signalSlotLock(object));
+        for (QObjectPrivate::Connection *c = d->senders; c; c = c->next)
+            c->receiverThreadData.store(data);
+    }
+    for (int i = 0; i < d->children.size(); ++i)
+        updateReceiverThreadData(d->children.at(i), data);
+}
+
 /*!
     Changes the thread affinity for this object and its children. The
     object cannot be moved if it has a parent. Event processing will
@@ -1504,6 +1958,9 @@ void QObject::moveToThread(QThread *targetThread)
 
     locker.unlock();
 
+    // not while holding the postEventList mutexes: signalSlotLock() comes first
+    updateReceiverThreadData(this, targetData);
+
     // now currentData can commit suicide if it wants to
     currentData->deref();
 }
@@ -1532,6 +1989,7 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
         if (pe.receiver == q) {
             // move this post event to the targetList
             targetData->postEventList.addEvent(pe);
+            currentData->postEventList.forgetEvent(pe);
             const_cast<QPostEvent &>(pe).event = 0;
             ++eventsMoved;
         }
@@ -1984,6 +2442,18 @@ void QObjectPrivate::deleteChildren()
 {
     Q_ASSERT_X(!isDeletingChildren, "QObjectPrivate::deleteChildren()", "isDeletingChildren already set, did this function recurse?");
     isDeletingChildren = true;
+
+    // remove the events posted to the children, e.g. by deleteLater(),
+    // at once rather than in the destructor of each one
+    QObjectList withPostedEvents;
+    for (QObject *child : qAsConst(children)) {
+        QObjectPrivate *childD = child->d_func();
+        if (childD->postedEvents && childD->threadData == threadData)
+            withPostedEvents.append(child);
+    }
+    if (withPostedEvents.size() > 1)
+        QCoreApplicationPrivate::removePostedEvents(withPostedEvents, threadData);
+
     // delete children objects
     // don't use qDeleteAll as the destructor of the child might
     // delete siblings
@@ -2452,13 +2922,13 @@ int QObject::receivers(const char *signal) const
         }
 
         QMutexLocker locker(signalSlotLock(this));
-        if (d->connectionLists) {
-            if (signal_index < d->connectionLists->count()) {
+        if (const QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+            if (signal_index < connectionLists->count()) {
                 const QObjectPrivate::Connection *c =
-                    d->connectionLists->at(signal_index).first;
+                    connectionLists->at(signal_index).first.load();
                 while (c) {
-                    receivers += c->receiver ? 1 : 0;
-                    c = c->nextConnectionList;
+                    receivers += c->receiver.load() ? 1 : 0;
+                    c = c->nextConnectionList.load();
                 }
             }
         }
@@ -2503,14 +2973,14 @@ bool QObject::isSignalConnected(const QMetaMethod &signal) const
         return d->isSignalConnected(signalIndex);
 
     QMutexLocker locker(signalSlotLock(this));
-    if (d->connectionLists) {
-        if (signalIndex < uint(d->connectionLists->count())) {
+    if (const QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+        if (signalIndex < uint(connectionLists->count())) {
             const QObjectPrivate::Connection *c =
-                d->connectionLists->at(signalIndex).first;
+                connectionLists->at(signalIndex).first.load();
             while (c) {
-                if (c->receiver)
+                if (c->receiver.load())
                     return true;
-                c = c->nextConnectionList;
+                c = c->nextConnectionList.load();
             }
         }
     }
@@ -3284,17 +3754,17 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
                                signalSlotLock(receiver));
 
     if (type & Qt::UniqueConnection) {
-        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
+        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists.load();
         if (connectionLists && connectionLists->count() > signal_index) {
             const QObjectPrivate::Connection *c2 =
-                (*connectionLists)[signal_index].first;
+                (*connectionLists)[signal_index].first.load();
 
             int method_index_absolute = method_index + method_offset;
 
             while (c2) {
-                if (!c2->isSlotObject && c2->receiver == receiver && c2->method() == method_index_absolute)
+                if (!c2->isSlotObject && c2->receiver.load() == receiver && c2->method() == method_index_absolute)
                     return 0;
-                c2 = c2->nextConnectionList;
+                c2 = c2->nextConnectionList.load();
             }
         }
         type &= Qt::UniqueConnection - 1;
@@ -3303,13 +3773,14 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     QScopedPointer<QObjectPrivate::Connection> c(new QObjectPrivate::Connection);
     c->sender = s;
     c->signal_index = signal_index;
-    c->receiver = r;
+    c->receiver.store(r);
+    c->receiverThreadData.store(QObjectPrivate::get(r)->threadData);
     c->method_relative = method_index;
     c->method_offset = method_offset;
     c->connectionType = type;
     c->isSlotObject = false;
     c->argumentTypes.store(types);
-    c->nextConnectionList = 0;
+    c->nextConnectionList.store(0);
     c->callFunction = callFunction;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.data());
@@ -3355,24 +3826,25 @@ bool QMetaObject::disconnectOne(const QObject *sender, int signal_index,
     \internal
     Helper function to remove the connection from the senders list and setting the receivers to 0
  */
-bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
+bool QMetaObjectPrivate::disconnectHelper(QObjectConnectionListVector *connectionLists,
+                                          QObjectPrivate::Connection *c,
                                           const QObject *receiver, int method_index, void **slot,
                                           QMutex *senderMutex, DisconnectType disconnectType)
 {
     bool success = false;
     while (c) {
-        if (c->receiver
-            && (receiver == 0 || (c->receiver == receiver
+        if (c->receiver.load()
+            && (receiver == 0 || (c->receiver.load() == receiver
                            && (method_index < 0 || (!c->isSlotObject && c->method() == method_index))
                            && (slot == 0 || (c->isSlotObject && c->slotObj->compare(slot)))))) {
             bool needToUnlock = false;
             QMutex *receiverMutex = 0;
-            if (c->receiver) {
-                receiverMutex = signalSlotLock(c->receiver);
+            if (QObject *r = c->receiver.load()) {
+                receiverMutex = signalSlotLock(r);
                 // need to relock this receiver and sender in the correct order
                 needToUnlock = QOrderedMutexLocker::relock(senderMutex, receiverMutex);
             }
-            if (c->receiver) {
+            if (c->receiver.load()) {
                 *c->prev = c->next;
                 if (c->next)
                     c->next->prev = c->prev;
@@ -3381,13 +3853,16 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
             if (needToUnlock)
                 receiverMutex->unlock();
 
-            c->receiver = 0;
+            c->receiver.store(0);
 
             if (c->isSlotObject) {
-                c->isSlotObject = false;
-                senderMutex->unlock();
-                c->slotObj->destroyIfLastRef();
-                senderMutex->lock();
+                // emissions in progress may still be about to call it
+                QtPrivate::QSlotObjectBase *slotObj = connectionLists->takeSlotObject(c);
+                if (slotObj) {
+                    senderMutex->unlock();
+                    slotObj->destroyIfLastRef();
+                    senderMutex->lock();
+                }
             }
 
             success = true;
@@ -3395,7 +3870,7 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
             if (disconnectType == DisconnectOne)
                 return success;
         }
-        c = c->nextConnectionList;
+        c = c->nextConnectionList.load();
     }
     return success;
 }
@@ -3417,7 +3892,7 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
     QMutex *senderMutex = signalSlotLock(sender);
     QMutexLocker locker(senderMutex);
 
-    QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
+    QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists.load();
     if (!connectionLists)
         return false;
 
@@ -3429,16 +3904,16 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
         // remove from all connection lists
         for (int sig_index = -1; sig_index < connectionLists->count(); ++sig_index) {
             QObjectPrivate::Connection *c =
-                (*connectionLists)[sig_index].first;
-            if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+                (*connectionLists)[sig_index].first.load();
+            if (disconnectHelper(connectionLists, c, receiver, method_index, slot, senderMutex, disconnectType)) {
                 success = true;
                 connectionLists->dirty = true;
             }
         }
     } else if (signal_index < connectionLists->count()) {
         QObjectPrivate::Connection *c =
-            (*connectionLists)[signal_index].first;
-        if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+            (*connectionLists)[signal_index].first.load();
+        if (disconnectHelper(connectionLists, c, receiver, method_index, slot, senderMutex, disconnectType)) {
             success = true;
             connectionLists->dirty = true;
         }
@@ -3446,8 +3921,12 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
 
     --connectionLists->inUse;
     Q_ASSERT(connectionLists->inUse >= 0);
-    if (connectionLists->orphaned && !connectionLists->inUse)
-        delete connectionLists;
+    if (connectionLists->orphaned) {
+        if (!connectionLists->inUse && !connectionLists->isEmitting())
+            delete connectionLists;
+    } else {
+        connectionLists->cleanOrphans(senderMutex);
+    }
 
     locker.unlock();
     if (success) {
@@ -3586,38 +4065,137 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     int nargs = 1; // include return type
     while (argumentTypes[nargs-1])
         ++nargs;
-    int *types = (int *) malloc(nargs*sizeof(int));
-    Q_CHECK_PTR(types);
-    void **args = (void **) malloc(nargs*sizeof(void *));
-    Q_CHECK_PTR(args);
-    types[0] = 0; // return type
-    args[0] = 0; // return value
 
-    if (nargs > 1) {
-        for (int n = 1; n < nargs; ++n)
-            types[n] = argumentTypes[n-1];
+    // the events allocate the argument arrays themselves (see
+    // QMetaCallEvent::allocateArguments()), small ones without using the heap
+    const bool batched = c->connectionType == Qt::BatchedConnection
+            || c->connectionType == Qt::CoalescedConnection;
+    QMetaCallEvent *ev;
+    if (batched) {
+        ev = c->isSlotObject ?
+            new QBatchedMetaCallEvent(c, c->slotObj, sender, signal, nargs, 0, 0) :
+            new QBatchedMetaCallEvent(c, c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs, 0, 0);
+    } else {
+        ev = c->isSlotObject ?
+            new QMetaCallEvent(c->slotObj, sender, signal, nargs) :
+            new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs);
+    }
 
+    if (nargs > 1) {
         locker.unlock();
         for (int n = 1; n < nargs; ++n)
-            args[n] = QMetaType::create(types[n], argv[n]);
+            ev->copyArgument(n, argumentTypes[n-1], argv[n]);
         locker.relock();
 
-        if (!c->receiver) {
+        if (!c->receiver.load()) {
             locker.unlock();
             // we have been disconnected while the mutex was unlocked
-            for (int n = 1; n < nargs; ++n)
-                QMetaType::destroy(types[n], args[n]);
-            free(types);
-            free(args);
+            delete ev;
             locker.relock();
             return;
         }
     }
 
-    QMetaCallEvent *ev = c->isSlotObject ?
-        new QMetaCallEvent(c->slotObj, sender, signal, nargs, types, args) :
-        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs, types, args);
-    QCoreApplication::postEvent(c->receiver, ev);
+    if (batched) {
+        // the receiver cannot be destroyed while we hold the lock, and
+        // keeps its thread data alive
+        QThreadData *data = QObjectPrivate::get(c->receiver.load())->threadData;
+        if (data->postEventList.addBatchedEvent(static_cast<QBatchedMetaCallEvent *>(ev))) {
+            // only the first call of a batch needs to wake up the thread
+            QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire();
+            if (dispatcher)
+                dispatcher->wakeUp();
+        }
+        return;
+    }
+
+    QCoreApplication::postEvent(c->receiver.load(), ev);
+}
+
+/*!
+    \internal
+
+    Moves the meta calls that batched connections queued for objects living
+    in the thread of \a data into its list of posted events. Of the pending
+    calls of a Qt::CoalescedConnection only the most recent one is kept.
+
+    Must be called in the thread of \a data.
+*/
+void QObjectPrivate::postBatchedMetaCalls(QThreadData *data)
+{
+    QBatchedMetaCallEvent *head = data->postEventList.batchedEvents.fetchAndStoreAcquire(nullptr);
+    if (!head)
+        return;
+
+    // the list is most recent first: whatever a coalesced connection
+    // queued before its first entry there is outdated
+    QVarLengthArray<QBatchedMetaCallEvent *, 64> events;
+    QSet<Connection *> coalesced;
+    while (head) {
+        QBatchedMetaCallEvent *ev = head;
+        head = head->nextBatched;
+        if (ev->connection->connectionType == Qt::CoalescedConnection) {
+            if (coalesced.contains(ev->connection)) {
+                delete ev;
+                continue;
+            }
+            coalesced.insert(ev->connection);
+        }
+        events.append(ev);
+    }
+
+    // post them in the order of emission, taking the locks once for each
+    // run of calls that go to the same receiver
+    int i = events.size();
+    while (i > 0) {
+        QObject *receiver = events.at(i - 1)->connection->receiver.load();
+        if (!receiver) {
+            // disconnected, or the receiver was destroyed
+            delete events.at(--i);
+            continue;
+        }
+
+        QMutexLocker locker(signalSlotLock(receiver));
+        if (events.at(i - 1)->connection->receiver.load() != receiver)
+            continue; // disconnected before we got the lock
+
+        QMutexLocker postLocker(&data->postEventList.mutex);
+        // holding the mutex, the receiver cannot be moved to another thread;
+        // but it may have been moved after the calls were queued
+        const bool moved = receiver->d_func()->threadData != data;
+        if (moved)
+            postLocker.unlock();
+        while (i > 0 && events.at(i - 1)->connection->receiver.load() == receiver) {
+            QBatchedMetaCallEvent *ev = events.at(--i);
+            ev->connection->deref();
+            ev->connection = nullptr;
+            if (moved) {
+                QCoreApplication::postEvent(receiver, ev);
+            } else {
+                data->postEventList.addEvent(QPostEvent(receiver, ev, Qt::NormalEventPriority));
+                ev->posted = true;
+                ++receiver->d_func()->postedEvents;
+            }
+        }
+        if (!moved)
+            data->canWait = false;
+    }
+}
+
+/*!
+    \internal
+
+    Deletes the meta calls that batched connections queued for objects
+    living in the thread of \a data, which is about to be destroyed.
+*/
+void QObjectPrivate::discardBatchedMetaCalls(QThreadData *data)
+{
+    QBatchedMetaCallEvent *head = data->postEventList.batchedEvents.fetchAndStoreAcquire(nullptr);
+    while (head) {
+        QBatchedMetaCallEvent *ev = head;
+        head = head->nextBatched;
+        delete ev;
+    }
 }
 
 /*!
@@ -3652,6 +4230,8 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
         return;
     }
 
+    Q_TRACE(QMetaObject_activate_entry, sender, signal_index);
+
     void *empty_argv[] = { 0 };
     if (qt_signal_spy_callback_set.signal_begin_callback != 0) {
         qt_signal_spy_callback_set.signal_begin_callback(sender, signal_index,
@@ -3659,64 +4239,80 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
     }
 
     {
-    QMutexLocker locker(signalSlotLock(sender));
-    struct ConnectionListsRef {
+    // The lists are traversed without locking the sender; only queued and
+    // blocking connections take the lock, to post their event.
+    struct EmissionPin {
+        QObject *sender;
         QObjectConnectionListVector *connectionLists;
-        ConnectionListsRef(QObjectConnectionListVector *connectionLists) : connectionLists(connectionLists)
+        int parity;
+        EmissionPin(QObject *sender, QObjectConnectionListVector *connectionLists)
+            : sender(sender), connectionLists(connectionLists), parity(0)
         {
             if (connectionLists)
-                ++connectionLists->inUse;
+                parity = connectionLists->pin();
         }
-        ~ConnectionListsRef()
+        ~EmissionPin()
         {
-            if (!connectionLists)
+            if (!connectionLists || connectionLists->unpin(parity))
                 return;
 
-            --connectionLists->inUse;
-            Q_ASSERT(connectionLists->inUse >= 0);
+            // the last emission of an epoch lets what was retired before it go
+            if (!connectionLists->orphaned && !connectionLists->hasOrphans.loadAcquire())
+                return;
+            QMutex *senderMutex = signalSlotLock(sender);
+            QMutexLocker locker(senderMutex);
             if (connectionLists->orphaned) {
-                if (!connectionLists->inUse)
+                if (!connectionLists->inUse && !connectionLists->isEmitting()) {
+                    locker.unlock();
                     delete connectionLists;
+                }
+            } else {
+                connectionLists->cleanOrphans(senderMutex);
             }
         }
 
         QObjectConnectionListVector *operator->() const { return connectionLists; }
     };
-    ConnectionListsRef connectionLists = sender->d_func()->connectionLists;
+    EmissionPin connectionLists(sender, sender->d_func()->connectionLists.loadAcquire());
     if (!connectionLists.connectionLists) {
-        locker.unlock();
         if (qt_signal_spy_callback_set.signal_end_callback != 0)
             qt_signal_spy_callback_set.signal_end_callback(sender, signal_index);
+        Q_TRACE(QMetaObject_activate_exit, sender, signal_index);
         return;
     }
 
-    const QObjectPrivate::ConnectionList *list;
-    if (signal_index < connectionLists->count())
-        list = &connectionLists->at(signal_index);
-    else
-        list = &connectionLists->allsignals;
+    // Connections made during the emission are not emitted to.
+    const uint highestConnectionId = connectionLists->currentConnectionId.loadAcquire();
+
+    const QObjectPrivate::ConnectionList *list = &connectionLists->allsignals;
+    const QObjectConnectionListVector::SignalVector *signalVector =
+        connectionLists->signalVector.loadAcquire();
+    if (signalVector && signal_index < signalVector->count())
+        list = &signalVector->at(signal_index);
 
-    Qt::HANDLE currentThreadId = QThread::currentThreadId();
+    const QThreadData * const currentThreadData = QThreadData::current(false);
 
     do {
-        QObjectPrivate::Connection *c = list->first;
-        if (!c) continue;
-        // We need to check against last here to ensure that signals added
-        // during the signal emission are not emitted in this emission.
-        QObjectPrivate::Connection *last = list->last;
-
-        do {
-            if (!c->receiver)
+        for (QObjectPrivate::Connection *c = list->first.loadAcquire(); c;
+             c = c->nextConnectionList.loadAcquire()) {
+            if (c->id > highestConnectionId)
+                break;
+
+            QObject * const receiver = c->receiver.loadAcquire();
+            if (!receiver)
                 continue;
 
-            QObject * const receiver = c->receiver;
-            const bool receiverInSameThread = currentThreadId == receiver->d_func()->threadData->threadId.load();
+            const bool receiverInSameThread = c->receiverThreadData.load() == currentThreadData;
 
             // determine if this connection should be sent immediately or
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
-                || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
+                || (c->connectionType == Qt::QueuedConnection)
+                || (c->connectionType == Qt::BatchedConnection)
+                || (c->connectionType == Qt::CoalescedConnection)) {
+                QMutexLocker locker(signalSlotLock(sender));
+                if (c->receiver.load())
+                    queued_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
                 continue;
 #ifndef QT_NO_THREAD
             } else if (c->connectionType == Qt::BlockingQueuedConnection) {
@@ -3726,6 +4322,9 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                     sender->metaObject()->className(), sender,
                     receiver->metaObject()->className(), receiver);
                 }
+                QMutexLocker locker(signalSlotLock(sender));
+                if (!c->receiver.load())
+                    continue;
                 QSemaphore semaphore;
                 QMetaCallEvent *ev = c->isSlotObject ?
                     new QMetaCallEvent(c->slotObj, sender, signal_index, 0, 0, argv ? argv : empty_argv, &semaphore) :
@@ -3733,7 +4332,6 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 QCoreApplication::postEvent(receiver, ev);
                 locker.unlock();
                 semaphore.acquire();
-                locker.relock();
                 continue;
 #endif
             }
@@ -3744,23 +4342,15 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 sw.switchSender(receiver, sender, signal_index);
             }
             if (c->isSlotObject) {
+                // a disconnection leaves the slot object alive until the emission is done
                 c->slotObj->ref();
                 QScopedPointer<QtPrivate::QSlotObjectBase, QSlotObjectBaseDeleter> obj(c->slotObj);
-                locker.unlock();
                 obj->call(receiver, argv ? argv : empty_argv);
-
-                // Make sure the slot object gets destroyed before the mutex is locked again, as the
-                // destructor of the slot object might also lock a mutex from the signalSlotLock() mutex pool,
-                // and that would deadlock if the pool happens to return the same mutex.
-                obj.reset();
-
-                locker.relock();
             } else if (c->callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
                 //we compare the vtable to make sure we are not in the destructor of the object.
                 const int methodIndex = c->method();
                 const int method_relative = c->method_relative;
                 const auto callFunction = c->callFunction;
-                locker.unlock();
                 if (qt_signal_spy_callback_set.slot_begin_callback != 0)
                     qt_signal_spy_callback_set.slot_begin_callback(receiver, methodIndex, argv ? argv : empty_argv);
 
@@ -3768,10 +4358,8 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, methodIndex);
-                locker.relock();
             } else {
                 const int method = c->method_relative + c->method_offset;
-                locker.unlock();
 
                 if (qt_signal_spy_callback_set.slot_begin_callback != 0) {
                     qt_signal_spy_callback_set.slot_begin_callback(receiver,
@@ -3783,13 +4371,11 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, method);
-
-                locker.relock();
             }
 
             if (connectionLists->orphaned)
                 break;
-        } while (c != last && (c = c->nextConnectionList) != 0);
+        }
 
         if (connectionLists->orphaned)
             break;
@@ -3802,6 +4388,7 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
     if (qt_signal_spy_callback_set.signal_end_callback != 0)
         qt_signal_spy_callback_set.signal_end_callback(sender, signal_index);
 
+    Q_TRACE(QMetaObject_activate_exit, sender, signal_index);
 }
 
 /*!
@@ -4062,32 +4649,33 @@ void QObject::dumpObjectInfo() const
     // first, look for connections where this object is the sender
     qDebug("  SIGNALS OUT");
 
-    if (d->connectionLists) {
-        for (int signal_index = 0; signal_index < d->connectionLists->count(); ++signal_index) {
+    if (const QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+        for (int signal_index = 0; signal_index < connectionLists->count(); ++signal_index) {
             const QMetaMethod signal = QMetaObjectPrivate::signal(metaObject(), signal_index);
             qDebug("        signal: %s", signal.methodSignature().constData());
 
             // receivers
             const QObjectPrivate::Connection *c =
-                d->connectionLists->at(signal_index).first;
+                connectionLists->at(signal_index).first.load();
             while (c) {
-                if (!c->receiver) {
+                const QObject *receiver = c->receiver.load();
+                if (!receiver) {
                     qDebug("          <Disconnected receiver>");
-                    c = c->nextConnectionList;
+                    c = c->nextConnectionList.load();
                     continue;
                 }
                 if (c->isSlotObject) {
                     qDebug("          <functor or function pointer>");
-                    c = c->nextConnectionList;
+                    c = c->nextConnectionList.load();
                     continue;
                 }
-                const QMetaObject *receiverMetaObject = c->receiver->metaObject();
+                const QMetaObject *receiverMetaObject = receiver->metaObject();
                 const QMetaMethod method = receiverMetaObject->method(c->method());
                 qDebug("          --> %s::%s %s",
                        receiverMetaObject->className(),
-                       c->receiver->objectName().isEmpty() ? "unnamed" : qPrintable(c->receiver->objectName()),
+                       receiver->objectName().isEmpty() ? "unnamed" : qPrintable(receiver->objectName()),
                        method.methodSignature().constData());
-                c = c->nextConnectionList;
+                c = c->nextConnectionList.load();
             }
         }
     } else {
@@ -4811,17 +5399,17 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
                                signalSlotLock(receiver));
 
     if (type & Qt::UniqueConnection && slot) {
-        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
+        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists.load();
         if (connectionLists && connectionLists->count() > signal_index) {
             const QObjectPrivate::Connection *c2 =
-                (*connectionLists)[signal_index].first;
+                (*connectionLists)[signal_index].first.load();
 
             while (c2) {
-                if (c2->receiver == receiver && c2->isSlotObject && c2->slotObj->compare(slot)) {
+                if (c2->receiver.load() == receiver && c2->isSlotObject && c2->slotObj->compare(slot)) {
                     slotObj->destroyIfLastRef();
                     return QMetaObject::Connection();
                 }
-                c2 = c2->nextConnectionList;
+                c2 = c2->nextConnectionList.load();
             }
         }
         type = static_cast<Qt::ConnectionType>(type ^ Qt::UniqueConnection);
@@ -4830,7 +5418,8 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     QScopedPointer<QObjectPrivate::Connection> c(new QObjectPrivate::Connection);
     c->sender = s;
     c->signal_index = signal_index;
-    c->receiver = r;
+    c->receiver.store(r);
+    c->receiverThreadData.store(QObjectPrivate::get(r)->threadData);
     c->slotObj = slotObj;
     c->connectionType = type;
     c->isSlotObject = true;
@@ -4862,30 +5451,32 @@ bool QObject::disconnect(const QMetaObject::Connection &connection)
 {
     QObjectPrivate::Connection *c = static_cast<QObjectPrivate::Connection *>(connection.d_ptr);
 
-    if (!c || !c->receiver)
+    if (!c || !c->receiver.load())
         return false;
 
     QMutex *senderMutex = signalSlotLock(c->sender);
-    QMutex *receiverMutex = signalSlotLock(c->receiver);
+    QMutex *receiverMutex = signalSlotLock(c->receiver.load());
 
+    QtPrivate::QSlotObjectBase *slotObj = Q_NULLPTR;
     {
         QOrderedMutexLocker locker(senderMutex, receiverMutex);
 
-        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(c->sender)->connectionLists;
+        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(c->sender)->connectionLists.load();
         Q_ASSERT(connectionLists);
         connectionLists->dirty = true;
 
         *c->prev = c->next;
         if (c->next)
             c->next->prev = c->prev;
-        c->receiver = 0;
+        c->receiver.store(0);
+
+        if (c->isSlotObject)
+            slotObj = connectionLists->takeSlotObject(c);
     }
 
     // destroy the QSlotObject, if possible
-    if (c->isSlotObject) {
-        c->slotObj->destroyIfLastRef();
-        c->isSlotObject = false;
-    }
+    if (slotObj)
+        slotObj->destroyIfLastRef();
 
     c->sender->disconnectNotify(QMetaObjectPrivate::signal(c->sender->metaObject(),
                                                            c->signal_index));
@@ -5066,7 +5657,7 @@ bool QMetaObject::Connection::isConnected_helper() const
     Q_ASSERT(d_ptr);    // we're only called from operator RestrictedBool() const
     QObjectPrivate::Connection *c = static_cast<QObjectPrivate::Connection *>(d_ptr);
 
-    return c->receiver;
+    return c->receiver.load();
 }
 
 
@@ -127,25 +127,28 @@ public:
     struct Connection
     {
         QObject *sender;
-        QObject *receiver;
+        QAtomicPointer<QObject> receiver;
+        // The thread of the receiver, so that emissions need not access it
+        QAtomicPointer<QThreadData> receiverThreadData;
         union {
             StaticMetaCallFunction callFunction;
             QtPrivate::QSlotObjectBase *slotObj;
         };
         // The next pointer for the singly-linked ConnectionList
-        Connection *nextConnectionList;
+        QAtomicPointer<Connection> nextConnectionList;
         //senders linked list
         Connection *next;
         Connection **prev;
         QAtomicPointer<const int> argumentTypes;
         QAtomicInt ref_;
+        uint id; // increases with each connection made to the sender
         ushort method_offset;
         ushort method_relative;
         uint signal_index : 27; // In signal range (see QObjectPrivate::signalIndex())
         ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
-        Connection() : nextConnectionList(0), ref_(2), ownArgumentTypes(true) {
+        Connection() : nextConnectionList(0), ref_(2), id(0), ownArgumentTypes(true) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -153,16 +156,17 @@ public:
         void ref() { ref_.ref(); }
         void deref() {
             if (!ref_.deref()) {
-                Q_ASSERT(!receiver);
+                Q_ASSERT(!receiver.load());
                 delete this;
             }
         }
     };
-    // ConnectionList is a singly-linked list
+    // ConnectionList is a singly-linked list. Emissions traverse it without
+    // locking, it is only modified with the sender's mutex locked.
     struct ConnectionList {
         ConnectionList() : first(0), last(0) {}
-        Connection *first;
-        Connection *last;
+        QAtomicPointer<Connection> first;
+        QAtomicPointer<Connection> last;
     };
 
     struct Sender
@@ -175,6 +179,12 @@ public:
 
     QObjectPrivate(int version = QObjectPrivateVersion);
     virtual ~QObjectPrivate();
+
+    static void *operator new(std::size_t size);
+    static void *operator new(std::size_t, void *where) Q_DECL_NOTHROW { return where; }
+    static void operator delete(void *ptr) Q_DECL_NOTHROW;
+    static void operator delete(void *, void *) Q_DECL_NOTHROW { }
+
     void deleteChildren();
 
     void setParent_helper(QObject *);
@@ -189,6 +199,9 @@ public:
     void addConnection(int signal, Connection *c);
     void cleanConnectionLists();
 
+    static void postBatchedMetaCalls(QThreadData *data);
+    static void discardBatchedMetaCalls(QThreadData *data);
+
     static inline Sender *setCurrentSender(QObject *receiver,
                                     Sender *sender);
     static inline void resetCurrentSender(QObject *receiver,
@@ -228,7 +241,7 @@ public:
     ExtraData *extraData;    // extra data set by the user
     QThreadData *threadData; // id of the thread that owns the object
 
-    QObjectConnectionListVector *connectionLists;
+    QAtomicPointer<QObjectConnectionListVector> connectionLists;
 
     Connection *senders;     // linked list of connections connected to this object
     Sender *currentSender;   // object currently activating the object
@@ -389,10 +402,28 @@ public:
     inline const QObject *sender() const { return sender_; }
     inline int signalId() const { return signalId_; }
     inline void **args() const { return args_; }
+    inline int *types() const { return types_; }
+
+    void *copyArgument(int index, int type, const void *copy);
 
     virtual void placeMetaCall(QObject *object);
 
+    static void *operator new(std::size_t size);
+    static void *operator new(std::size_t, void *where) Q_DECL_NOTHROW { return where; }
+    static void operator delete(void *ptr) Q_DECL_NOTHROW;
+    static void operator delete(void *, void *) Q_DECL_NOTHROW { }
+
 private:
+    enum { InlineArgumentCount = 5, InlineArgumentDataSize = 64 };
+
+    void allocateArguments();
+    void *inlineArgumentStorage(int size);
+    inline bool isInlineArgument(const void *arg) const
+    {
+        return arg >= static_cast<const void *>(inlineData_)
+            && arg < static_cast<const void *>(inlineData_ + InlineArgumentDataSize);
+    }
+
     QtPrivate::QSlotObjectBase *slotObj_;
     const QObject *sender_;
     int signalId_;
@@ -403,6 +434,34 @@ private:
     QObjectPrivate::StaticMetaCallFunction callFunction_;
     ushort method_offset_;
     ushort method_relative_;
+    ushort inlineDataUsed_;
+    // storage for the argument packs of most queued calls, so that
+    // posting them does not need additional allocations
+    int inlineTypes_[InlineArgumentCount];
+    void *inlineArgs_[InlineArgumentCount];
+    union {
+        char inlineData_[InlineArgumentDataSize];
+        qint64 inlineDataAlignment_;
+        double inlineDataAlignment2_;
+        void *inlineDataAlignment3_;
+    };
+};
+
+// A meta call queued by a Qt::BatchedConnection or Qt::CoalescedConnection.
+// It holds a reference to the connection, which decides at delivery time
+// whether the receiver still exists.
+class QBatchedMetaCallEvent : public QMetaCallEvent
+{
+public:
+    QBatchedMetaCallEvent(QObjectPrivate::Connection *c, ushort method_offset, ushort method_relative,
+                          QObjectPrivate::StaticMetaCallFunction callFunction, const QObject *sender,
+                          int signalId, int nargs, int *types, void **args);
+    QBatchedMetaCallEvent(QObjectPrivate::Connection *c, QtPrivate::QSlotObjectBase *slotObj,
+                          const QObject *sender, int signalId, int nargs, int *types, void **args);
+    ~QBatchedMetaCallEvent();
+
+    QObjectPrivate::Connection *connection;
+    QBatchedMetaCallEvent *nextBatched;
 };
 
 class QBoolBlocker
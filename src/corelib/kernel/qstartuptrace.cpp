@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qstartuptrace_p.h"
+
+#include <QtCore/qthread.h>
+#ifndef QT_NO_THREAD
+#  include <QtCore/qrunnable.h>
+#  include <QtCore/qthreadpool.h>
+#endif
+#include <private/qcoreapplication_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QT_STARTUP_TRACE=1 makes QCoreApplication and QGuiApplication print the
+    time spent in each phase of their initialization. Phases that run on a
+    background thread are marked as such.
+*/
+bool QStartupTrace::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT_STARTUP_TRACE") > 0;
+    return enabled;
+}
+
+void QStartupTrace::report(const char *phase, qint64 nsecs)
+{
+    const bool mainThread = QThread::currentThread() == QCoreApplicationPrivate::theMainThread.load();
+    qDebug("Startup phase %-32s %9.3f ms%s", phase, nsecs / 1000000.,
+           mainThread ? "" : " (background thread)");
+}
+
+#ifndef QT_NO_THREAD
+namespace {
+class QStartupTaskRunner : public QRunnable
+{
+public:
+    QStartupTaskRunner(const char *phase, QStartupTaskGroup::Task task, QSemaphore *done)
+        : m_phase(phase), m_task(task), m_done(done)
+    {}
+
+    void run() override
+    {
+        {
+            QStartupTrace::Phase phase(m_phase);
+            m_task();
+        }
+        m_done->release();
+    }
+
+private:
+    const char *m_phase;
+    QStartupTaskGroup::Task m_task;
+    QSemaphore *m_done;
+};
+} // unnamed namespace
+#endif
+
+void QStartupTaskGroup::start(const char *phase, Task task)
+{
+#ifndef QT_NO_THREAD
+    if (QThreadPool *threadPool = QThreadPool::globalInstance()) {
+        QStartupTaskRunner *runner = new QStartupTaskRunner(phase, task, &m_done);
+        if (threadPool->tryStart(runner)) {
+            ++m_started;
+            return;
+        }
+        delete runner;
+    }
+#endif
+    QStartupTrace::Phase tracePhase(phase);
+    task();
+}
+
+/*
+    Blocks until all tasks started so far have finished.
+*/
+void QStartupTaskGroup::waitForDone()
+{
+#ifndef QT_NO_THREAD
+    m_done.acquire(m_started);
+#endif
+    m_started = 0;
+}
+
+QT_END_NAMESPACE
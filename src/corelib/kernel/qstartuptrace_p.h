@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSTARTUPTRACE_P_H
+#define QSTARTUPTRACE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qelapsedtimer.h>
+#ifndef QT_NO_THREAD
+#  include <QtCore/qsemaphore.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QStartupTrace
+{
+public:
+    // true if QT_STARTUP_TRACE is set to a positive value
+    static bool isEnabled();
+    static void report(const char *phase, qint64 nsecs);
+
+    // Measures the time until it goes out of scope or finish() is called
+    class Phase
+    {
+    public:
+        explicit Phase(const char *name)
+            : m_name(name), m_active(QStartupTrace::isEnabled())
+        {
+            if (m_active)
+                m_timer.start();
+        }
+        ~Phase() { finish(); }
+
+        void finish()
+        {
+            if (m_active) {
+                QStartupTrace::report(m_name, m_timer.nsecsElapsed());
+                m_active = false;
+            }
+        }
+
+    private:
+        Q_DISABLE_COPY(Phase)
+        const char *m_name;
+        QElapsedTimer m_timer;
+        bool m_active;
+    };
+};
+
+// Runs independent startup work on the global thread pool; the work runs
+// inline if no thread is available. Each task is traced as its own phase.
+class Q_CORE_EXPORT QStartupTaskGroup
+{
+public:
+    typedef void (*Task)();
+
+    QStartupTaskGroup() : m_started(0) {}
+    ~QStartupTaskGroup() { waitForDone(); }
+
+    void start(const char *phase, Task task);
+    void waitForDone();
+
+private:
+    Q_DISABLE_COPY(QStartupTaskGroup)
+#ifndef QT_NO_THREAD
+    QSemaphore m_done;
+#endif
+    int m_started;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTARTUPTRACE_P_H
@@ -40,6 +40,7 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
@@ -84,6 +85,7 @@ QTimerInfoList::QTimerInfoList()
 #endif
 
     firstTimerInfo = 0;
+    nextSequence = 0;
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -174,18 +176,77 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+static inline bool timerFiresBefore(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout < t2->timeout)
+        return true;
+    return t1->timeout == t2->timeout && t1->sequence < t2->sequence;
+}
+
+inline void QTimerInfoList::heapPlace(int index, QTimerInfo *t)
+{
+    (*this)[index] = t;
+    t->heapIndex = index;
+}
+
+void QTimerInfoList::heapMoveUp(int index)
+{
+    QTimerInfo *t = at(index);
+    while (index > 0) {
+        const int parent = (index - 1) / 2;
+        QTimerInfo *p = at(parent);
+        if (!timerFiresBefore(t, p))
+            break;
+        heapPlace(index, p);
+        index = parent;
+    }
+    heapPlace(index, t);
+}
+
+void QTimerInfoList::heapMoveDown(int index)
+{
+    const int n = size();
+    QTimerInfo *t = at(index);
+    for (;;) {
+        int child = 2 * index + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && timerFiresBefore(at(child + 1), at(child)))
+            ++child;
+        QTimerInfo *c = at(child);
+        if (!timerFiresBefore(c, t))
+            break;
+        heapPlace(index, c);
+        index = child;
+    }
+    heapPlace(index, t);
+}
+
+/*
+  remove the timer at \a index from the heap, without deleting it
+*/
+void QTimerInfoList::heapRemove(int index)
+{
+    QTimerInfo *last = takeLast();
+    if (index == size())
+        return;
+
+    heapPlace(index, last);
+    if (index > 0 && timerFiresBefore(last, at((index - 1) / 2)))
+        heapMoveUp(index);
+    else
+        heapMoveDown(index);
+}
+
 /*
   insert timer info into list
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
-    }
-    insert(index+1, ti);
+    // timers with the same timeout fire in the order they were (re)inserted
+    ti->sequence = nextSequence++;
+    append(ti);
+    heapMoveUp(size() - 1);
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -388,13 +449,25 @@ bool QTimerInfoList::timerWait(timespec &tm)
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
 
-    // Find first waiting timer not already active
+    // Find first waiting timer not already active. Only timers that are
+    // being activated further up the stack are skipped, and everything
+    // below an inactive timer fires after it, so this only visits a few
+    // nodes of the heap.
     QTimerInfo *t = 0;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
+    QVarLengthArray<int, 32> pending;
+    if (!isEmpty())
+        pending.append(0);
+    while (!pending.isEmpty()) {
+        const int index = pending.last();
+        pending.removeLast();
+        QTimerInfo *candidate = at(index);
+        if (!candidate->activateRef) {
+            if (!t || timerFiresBefore(candidate, t))
+                t = candidate;
+            continue;
         }
+        for (int child = 2 * index + 1; child <= 2 * index + 2 && child < size(); ++child)
+            pending.append(child);
     }
 
     if (!t)
@@ -423,16 +496,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -493,6 +563,7 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
             ++t->timeout.tv_sec;
     }
 
+    timersById.insert(timerId, t);
     timerInsert(t);
 
 #ifdef QTIMERINFO_DEBUG
@@ -507,42 +578,48 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
+
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    heapRemove(t->heapIndex);
+    if (t == firstTimerInfo)
+        firstTimerInfo = 0;
+    if (t->activateRef)
+        *(t->activateRef) = 0;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
+
+    // compact the remaining timers and rebuild the heap once, rather
+    // than removing the object's timers one by one
+    int remaining = 0;
     for (int i = 0; i < count(); ++i) {
         QTimerInfo *t = at(i);
         if (t->obj == object) {
             // object found
-            removeAt(i);
+            timersById.remove(t->id);
             if (t == firstTimerInfo)
                 firstTimerInfo = 0;
             if (t->activateRef)
                 *(t->activateRef) = 0;
             delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+        } else {
+            heapPlace(remaining++, t);
         }
     }
+    if (remaining == count())
+        return true;
+
+    erase(begin() + remaining, end());
+    for (int i = remaining / 2 - 1; i >= 0; --i)
+        heapMoveDown(i);
     return true;
 }
 
@@ -579,10 +656,16 @@ int QTimerInfoList::activateTimers()
 
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
+    QVarLengthArray<int, 32> pending;
+    pending.append(0);
+    while (!pending.isEmpty()) {
+        const int index = pending.last();
+        pending.removeLast();
+        if (currentTime < at(index)->timeout)
+            continue;
         maxCount++;
+        for (int child = 2 * index + 1; child <= 2 * index + 2 && child < size(); ++child)
+            pending.append(child);
     }
 
     //fire the timers.
@@ -605,7 +688,7 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        heapRemove(0);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -401,6 +401,9 @@ class Q_CORE_EXPORT QVariant
             QObject *o;
             void *ptr;
             PrivateShared *shared;
+            // Movable custom types of up to this size are stored in place
+            // instead of being allocated through PrivateShared.
+            void *inlineStorage[3];
         } data;
         uint type : 30;
         uint is_shared : 1;
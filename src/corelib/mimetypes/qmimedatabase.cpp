@@ -167,6 +167,10 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
     // specific) in both cases, even when there is already a suffix matching candidate.
     *accuracyPtr = 0;
 
+    // The device is only read with the mutex unlocked, so that slow devices
+    // don't hold up lookups from other threads.
+    QMutexLocker locker(&mutex);
+
     // Pass 1) Try to match on the file name
     QMimeGlobMatchResult candidatesByName;
     if (fileName.endsWith(QLatin1Char('/')))
@@ -187,7 +191,9 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
 
         // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
         // This is much faster than seeking back and forth into QIODevice.
+        locker.unlock();
         const QByteArray data = device->peek(16384);
+        locker.relock();
 
         int magicAccuracy = 0;
         QMimeType candidateByData(findByData(data, &magicAccuracy));
@@ -357,10 +363,9 @@ QMimeType QMimeDatabase::mimeTypeForName(const QString &nameOrAlias) const
 */
 QMimeType QMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode) const
 {
-    QMutexLocker locker(&d->mutex);
-
+    // The file system is only accessed with the mutex unlocked
     if (fileInfo.isDir())
-        return d->mimeTypeForName(QLatin1String("inode/directory"));
+        return mimeTypeForName(QLatin1String("inode/directory"));
 
     QFile file(fileInfo.absoluteFilePath());
 
@@ -371,13 +376,13 @@ QMimeType QMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mo
     QT_STATBUF statBuffer;
     if (QT_STAT(nativeFilePath.constData(), &statBuffer) == 0) {
         if (S_ISCHR(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/chardevice"));
+            return mimeTypeForName(QLatin1String("inode/chardevice"));
         if (S_ISBLK(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/blockdevice"));
+            return mimeTypeForName(QLatin1String("inode/blockdevice"));
         if (S_ISFIFO(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/fifo"));
+            return mimeTypeForName(QLatin1String("inode/fifo"));
         if (S_ISSOCK(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/socket"));
+            return mimeTypeForName(QLatin1String("inode/socket"));
     }
 #endif
 
@@ -387,19 +392,15 @@ QMimeType QMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mo
         file.open(QIODevice::ReadOnly); // isOpen() will be tested by method below
         return d->mimeTypeForFileNameAndData(fileInfo.absoluteFilePath(), &file, &priority);
     case MatchExtension:
-        locker.unlock();
         return mimeTypeForFile(fileInfo.absoluteFilePath(), mode);
     case MatchContent:
-        if (file.open(QIODevice::ReadOnly)) {
-            locker.unlock();
+        if (file.open(QIODevice::ReadOnly))
             return mimeTypeForData(&file);
-        } else {
-            return d->mimeTypeForName(d->defaultMimeType());
-        }
+        break;
     default:
         Q_ASSERT(false);
     }
-    return d->mimeTypeForName(d->defaultMimeType());
+    return mimeTypeForName(d->defaultMimeType());
 }
 
 /*!
@@ -487,20 +488,18 @@ QMimeType QMimeDatabase::mimeTypeForData(const QByteArray &data) const
 */
 QMimeType QMimeDatabase::mimeTypeForData(QIODevice *device) const
 {
-    QMutexLocker locker(&d->mutex);
-
     int accuracy = 0;
     const bool openedByUs = !device->isOpen() && device->open(QIODevice::ReadOnly);
     if (device->isOpen()) {
         // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
         // This is much faster than seeking back and forth into QIODevice.
         const QByteArray data = device->peek(16384);
-        const QMimeType result = d->findByData(data, &accuracy);
         if (openedByUs)
             device->close();
-        return result;
+        QMutexLocker locker(&d->mutex);
+        return d->findByData(data, &accuracy);
     }
-    return d->mimeTypeForName(d->defaultMimeType());
+    return mimeTypeForName(d->defaultMimeType());
 }
 
 /*!
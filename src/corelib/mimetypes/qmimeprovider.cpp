@@ -121,10 +121,13 @@ struct QMimeBinaryProvider::CacheFile
     }
     bool load();
     bool reload();
+    void loadGlobs();
 
     QFile file;
     uchar *data;
     QDateTime m_mtime;
+    // The complex globs, parsed once rather than on every lookup
+    QMimeGlobPatternList m_globs;
     bool m_valid;
 };
 
@@ -149,6 +152,8 @@ bool QMimeBinaryProvider::CacheFile::load()
         m_valid = (major == 1 && minor >= 1 && minor <= 2);
     }
     m_mtime = QFileInfo(file).lastModified();
+    if (m_valid)
+        loadGlobs();
     return m_valid;
 }
 
@@ -160,6 +165,7 @@ bool QMimeBinaryProvider::CacheFile::reload()
         file.close();
     }
     data = 0;
+    m_globs.clear();
     return load();
 }
 
@@ -190,6 +196,24 @@ enum {
     PosGenericIconsListOffset = 36
 };
 
+void QMimeBinaryProvider::CacheFile::loadGlobs()
+{
+    const int off = getUint32(PosGlobListOffset);
+    const int numGlobs = getUint32(off);
+    m_globs.reserve(numGlobs);
+    for (int i = 0; i < numGlobs; ++i) {
+        const int globOffset = getUint32(off + 4 + 12 * i);
+        const int mimeTypeOffset = getUint32(off + 4 + 12 * i + 4);
+        const int flagsAndWeight = getUint32(off + 4 + 12 * i + 8);
+        const int weight = flagsAndWeight & 0xff;
+        const bool caseSensitive = flagsAndWeight & 0x100;
+        const Qt::CaseSensitivity qtCaseSensitive = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        m_globs.append(QMimeGlobPattern(QLatin1String(getCharStar(globOffset)),
+                                        QLatin1String(getCharStar(mimeTypeOffset)),
+                                        weight, qtCaseSensitive));
+    }
+}
+
 bool QMimeBinaryProvider::isValid()
 {
 #if defined(QT_USE_MMAP)
@@ -297,9 +321,9 @@ QMimeGlobMatchResult QMimeBinaryProvider::findByFileName(const QString &fileName
     // TODO this parses in the order (local, global). Check that it handles "NOGLOBS" correctly.
     for (CacheFile *cacheFile : qAsConst(m_cacheFiles)) {
         // Check literals (e.g. "Makefile")
-        matchGlobList(result, cacheFile, cacheFile->getUint32(PosLiteralListOffset), fileName);
+        matchLiteralList(result, cacheFile, fileName);
         // Check complex globs (e.g. "callgrind.out[0-9]*")
-        matchGlobList(result, cacheFile, cacheFile->getUint32(PosGlobListOffset), fileName);
+        cacheFile->m_globs.match(result, fileName);
         // Check the very common *.txt cases with the suffix tree
         const int reverseSuffixTreeOffset = cacheFile->getUint32(PosReverseSuffixTreeOffset);
         const int numRoots = cacheFile->getUint32(reverseSuffixTreeOffset);
@@ -311,26 +335,22 @@ QMimeGlobMatchResult QMimeBinaryProvider::findByFileName(const QString &fileName
     return result;
 }
 
-void QMimeBinaryProvider::matchGlobList(QMimeGlobMatchResult &result, CacheFile *cacheFile, int off, const QString &fileName)
+void QMimeBinaryProvider::matchLiteralList(QMimeGlobMatchResult &result, CacheFile *cacheFile, const QString &fileName)
 {
-    const int numGlobs = cacheFile->getUint32(off);
-    //qDebug() << "Loading" << numGlobs << "globs from" << cacheFile->file.fileName() << "at offset" << cacheFile->globListOffset;
-    for (int i = 0; i < numGlobs; ++i) {
-        const int globOffset = cacheFile->getUint32(off + 4 + 12 * i);
-        const int mimeTypeOffset = cacheFile->getUint32(off + 4 + 12 * i + 4);
+    const int off = cacheFile->getUint32(PosLiteralListOffset);
+    const int numLiterals = cacheFile->getUint32(off);
+    for (int i = 0; i < numLiterals; ++i) {
+        const int literalOffset = cacheFile->getUint32(off + 4 + 12 * i);
+        const QLatin1String literal(cacheFile->getCharStar(literalOffset));
+        if (literal.size() != fileName.size())
+            continue;
         const int flagsAndWeight = cacheFile->getUint32(off + 4 + 12 * i + 8);
-        const int weight = flagsAndWeight & 0xff;
         const bool caseSensitive = flagsAndWeight & 0x100;
-        const Qt::CaseSensitivity qtCaseSensitive = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-        const QString pattern = QLatin1String(cacheFile->getCharStar(globOffset));
-
-        const char *mimeType = cacheFile->getCharStar(mimeTypeOffset);
-        //qDebug() << pattern << mimeType << weight << caseSensitive;
-        QMimeGlobPattern glob(pattern, QString() /*unused*/, weight, qtCaseSensitive);
-
-        // TODO: this could be done faster for literals where a simple == would do.
-        if (glob.matchFileName(fileName))
-            result.addMatch(QLatin1String(mimeType), weight, pattern);
+        if (fileName.compare(literal, caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive) == 0) {
+            const int mimeTypeOffset = cacheFile->getUint32(off + 4 + 12 * i + 4);
+            const char *mimeType = cacheFile->getCharStar(mimeTypeOffset);
+            result.addMatch(QLatin1String(mimeType), flagsAndWeight & 0xff, literal);
+        }
     }
 }
 
@@ -199,6 +199,7 @@ void QFactoryLoader::update()
             }
         }
     }
+    QLibraryPrivate::savePluginMetaDataCache();
 #else
     Q_D(QFactoryLoader);
     if (qt_debug_component()) {
@@ -61,6 +61,11 @@
 #include <qendian.h>
 #include <qjsondocument.h>
 #include <qjsonvalue.h>
+#include <qdatastream.h>
+#include <qdatetime.h>
+#include <qhash.h>
+#include <qsavefile.h>
+#include <qstandardpaths.h>
 #include "qelfparser_p.h"
 #include "qmachparser_p.h"
 
@@ -336,6 +341,157 @@ static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
     return ret;
 }
 
+/*
+  Finding the metadata of a plugin means reading and parsing the whole
+  library, for every plugin in every plugin directory, in every process.
+  So the metadata found is kept in a file in the user's cache directory,
+  shared by all processes using the same build of Qt, and reused for as
+  long as the library's size and modification time are unchanged.
+
+  Setting QT_NO_PLUGIN_CACHE turns this off, as does QT_DEBUG_PLUGINS, so
+  that the latter always reports on the libraries themselves.
+*/
+class QPluginMetaDataCache
+{
+public:
+    QPluginMetaDataCache();
+
+    bool isEnabled() const { return !m_fileName.isEmpty(); }
+    bool find(const QFileInfo &info, QJsonObject *metaData);
+    void insert(const QFileInfo &info, const QJsonObject &metaData);
+    void save();
+
+private:
+    struct Entry
+    {
+        qint64 size;
+        qint64 lastModified;
+        QByteArray metaData; // binary JSON
+    };
+    typedef QHash<QString, Entry> EntryHash;
+
+    enum { Magic = 0x51504d43, Version = 1 }; // 'QPMC'
+
+    EntryHash read() const;
+
+    QMutex m_mutex;
+    EntryHash m_entries;
+    QString m_fileName;
+    bool m_dirty;
+};
+
+QPluginMetaDataCache::QPluginMetaDataCache()
+    : m_dirty(false)
+{
+    if (!qEnvironmentVariableIsEmpty("QT_NO_PLUGIN_CACHE") || qt_debug_component())
+        return;
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheDir.isEmpty())
+        return;
+    m_fileName = cacheDir + QLatin1String("/qtplugincache/metadata-" QT_VERSION_STR "-")
+            + QSysInfo::buildAbi() + QLatin1String(QLIBRARY_AS_DEBUG ? "-debug" : "");
+    m_entries = read();
+}
+
+QPluginMetaDataCache::EntryHash QPluginMetaDataCache::read() const
+{
+    EntryHash entries;
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return entries;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    quint32 magic, version, count;
+    stream >> magic >> version >> count;
+    if (magic != Magic || version != Version)
+        return entries;
+
+    entries.reserve(count);
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString fileName;
+        Entry entry;
+        stream >> fileName >> entry.size >> entry.lastModified >> entry.metaData;
+        entries.insert(fileName, entry);
+    }
+    if (stream.status() != QDataStream::Ok)
+        entries.clear();
+    return entries;
+}
+
+bool QPluginMetaDataCache::find(const QFileInfo &info, QJsonObject *metaData)
+{
+    QMutexLocker locker(&m_mutex);
+    const EntryHash::const_iterator it = m_entries.constFind(info.filePath());
+    if (it == m_entries.constEnd() || it->size != info.size()
+            || it->lastModified != info.lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+    const QJsonDocument doc = QJsonDocument::fromBinaryData(it->metaData);
+    if (!doc.isObject())
+        return false;
+    *metaData = doc.object();
+    return true;
+}
+
+void QPluginMetaDataCache::insert(const QFileInfo &info, const QJsonObject &metaData)
+{
+    Entry entry;
+    entry.size = info.size();
+    entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+    entry.metaData = QJsonDocument(metaData).toBinaryData();
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.insert(info.filePath(), entry);
+    m_dirty = true;
+}
+
+void QPluginMetaDataCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_dirty)
+        return;
+    m_dirty = false;
+
+    // Other processes may have added libraries of their own meanwhile
+    EntryHash entries = read();
+    for (EntryHash::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+        entries.insert(it.key(), it.value());
+    // Forget about libraries that are gone
+    for (EntryHash::iterator it = entries.begin(); it != entries.end(); ) {
+        if (QFile::exists(it.key()))
+            ++it;
+        else
+            it = entries.erase(it);
+    }
+
+    QDir().mkpath(QFileInfo(m_fileName).path());
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << quint32(Magic) << quint32(Version) << quint32(entries.size());
+    for (EntryHash::const_iterator it = entries.constBegin(); it != entries.constEnd(); ++it)
+        stream << it.key() << it->size << it->lastModified << it->metaData;
+    file.commit();
+    m_entries = entries;
+}
+
+Q_GLOBAL_STATIC(QPluginMetaDataCache, pluginMetaDataCache)
+
+/*!
+    \internal
+    Writes the metadata of the plugins found since the last call to the
+    shared cache, if there were any new ones.
+*/
+void QLibraryPrivate::savePluginMetaDataCache()
+{
+    QPluginMetaDataCache *cache = pluginMetaDataCache();
+    if (cache && cache->isEnabled())
+        cache->save();
+}
+
 static void installCoverageTool(QLibraryPrivate *libPrivate)
 {
 #ifdef __COVERAGESCANNER__
@@ -729,8 +885,17 @@ void QLibraryPrivate::updatePluginState()
 #endif
 
     if (!pHnd) {
-        // scan for the plugin metadata without loading
-        success = findPatternUnloaded(fileName, this);
+        // scan for the plugin metadata without loading, unless the library
+        // is unchanged since the last scan
+        QPluginMetaDataCache *cache = pluginMetaDataCache();
+        const QFileInfo info(fileName);
+        if (cache && cache->isEnabled() && cache->find(info, &metaData)) {
+            success = true;
+        } else {
+            success = findPatternUnloaded(fileName, this);
+            if (success && cache && cache->isEnabled())
+                cache->insert(info, metaData);
+        }
     } else {
         // library is already loaded (probably via QLibrary)
         // simply get the target function and call it.
@@ -99,6 +99,7 @@ public:
                                          QLibrary::LoadHints loadHints = 0);
     static QStringList suffixes_sys(const QString &fullVersion);
     static QStringList prefixes_sys();
+    static void savePluginMetaDataCache();
 
     QPointer<QObject> inst;
     QtPluginInstanceFunction instance;
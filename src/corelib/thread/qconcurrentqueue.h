@@ -0,0 +1,384 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTQUEUE_H
+#define QCONCURRENTQUEUE_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+
+#ifndef QT_NO_THREAD
+
+namespace QtPrivate {
+
+// Lets threads sleep until a queue operation can succeed. The operations
+// themselves never take the mutex; it is only locked if a thread is waiting.
+class QueueWaiter
+{
+public:
+    QueueWaiter() : waiters(0) {}
+
+    void wake()
+    {
+        // pairs with the fence in wait(): either the waiter sees the change
+        // to the queue, or we see the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load()) {
+            QMutexLocker locker(&mutex);
+            condition.wakeOne();
+        }
+    }
+
+    template <typename Operation>
+    bool wait(Operation tryOnce, int timeout)
+    {
+        QDeadlineTimer deadline(timeout < 0 ? QDeadlineTimer(QDeadlineTimer::Forever)
+                                            : QDeadlineTimer(timeout, Qt::PreciseTimer));
+        QMutexLocker locker(&mutex);
+        waiters.ref();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ok;
+        while (!(ok = tryOnce()) && !deadline.hasExpired()) {
+            condition.wait(&mutex, deadline.isForever() ? ULONG_MAX
+                                                        : (unsigned long)deadline.remainingTime());
+        }
+        waiters.deref();
+        return ok;
+    }
+
+private:
+    QAtomicInt waiters;
+    QMutex mutex;
+    QWaitCondition condition;
+};
+
+inline int queueCapacity(int capacity)
+{
+    int n = 2;
+    while (n < capacity && n < (1 << 30))
+        n *= 2;
+    return n;
+}
+
+} // namespace QtPrivate
+
+template <typename T>
+class QSpscQueue
+{
+public:
+    explicit QSpscQueue(int capacity);
+    ~QSpscQueue();
+
+    int capacity() const { return int(mask + 1); }
+    int size() const { return int(tail.load() - head.load()); }
+    bool isEmpty() const { return size() == 0; }
+
+    bool tryPush(const T &value)
+    { if (!emplace(value)) return false; notEmpty.wake(); return true; }
+    bool tryPush(T &&value)
+    { if (!emplace(std::move(value))) return false; notEmpty.wake(); return true; }
+    bool tryPush(const T &value, int timeout);
+    bool tryPush(T &&value, int timeout);
+    void push(const T &value) { tryPush(value, -1); }
+    void push(T &&value) { tryPush(std::move(value), -1); }
+
+    bool tryPop(T *value)
+    { if (!take(value)) return false; notFull.wake(); return true; }
+    bool tryPop(T *value, int timeout);
+    T pop() { T value; tryPop(&value, -1); return value; }
+
+private:
+    Q_DISABLE_COPY(QSpscQueue)
+
+    template <typename U> bool emplace(U &&value);
+    bool take(T *value);
+
+    T *buffer;
+    quintptr mask;
+    Q_DECL_UNUSED_MEMBER char padding1[64]; // keep the indexes in different cache lines
+    QAtomicInteger<quintptr> head;  // written by the consumer
+    quintptr cachedTail;            // the consumer's copy of tail
+    Q_DECL_UNUSED_MEMBER char padding2[64];
+    QAtomicInteger<quintptr> tail;  // written by the producer
+    quintptr cachedHead;            // the producer's copy of head
+    Q_DECL_UNUSED_MEMBER char padding3[64];
+    QtPrivate::QueueWaiter notEmpty;
+    QtPrivate::QueueWaiter notFull;
+};
+
+template <typename T>
+QSpscQueue<T>::QSpscQueue(int capacity)
+    : mask(quintptr(QtPrivate::queueCapacity(capacity)) - 1),
+      head(0), cachedTail(0), tail(0), cachedHead(0)
+{
+    buffer = static_cast<T *>(::operator new((mask + 1) * sizeof(T)));
+}
+
+template <typename T>
+QSpscQueue<T>::~QSpscQueue()
+{
+    for (quintptr i = head.load(), end = tail.load(); i != end; ++i)
+        buffer[i & mask].~T();
+    ::operator delete(buffer);
+}
+
+template <typename T>
+template <typename U>
+bool QSpscQueue<T>::emplace(U &&value)
+{
+    const quintptr t = tail.load();
+    if (t - cachedHead > mask) {
+        // looks full; only now read the consumer's index
+        cachedHead = head.loadAcquire();
+        if (t - cachedHead > mask)
+            return false;
+    }
+    new (buffer + (t & mask)) T(std::forward<U>(value));
+    tail.storeRelease(t + 1);
+    return true;
+}
+
+template <typename T>
+bool QSpscQueue<T>::take(T *value)
+{
+    const quintptr h = head.load();
+    if (h == cachedTail) {
+        cachedTail = tail.loadAcquire();
+        if (h == cachedTail)
+            return false;
+    }
+    T &slot = buffer[h & mask];
+    *value = std::move(slot);
+    slot.~T();
+    head.storeRelease(h + 1);
+    return true;
+}
+
+template <typename T>
+bool QSpscQueue<T>::tryPush(const T &value, int timeout)
+{
+    if (!notFull.wait([&]() { return emplace(value); }, timeout))
+        return false;
+    notEmpty.wake();
+    return true;
+}
+
+template <typename T>
+bool QSpscQueue<T>::tryPush(T &&value, int timeout)
+{
+    if (!notFull.wait([&]() { return emplace(std::move(value)); }, timeout))
+        return false;
+    notEmpty.wake();
+    return true;
+}
+
+template <typename T>
+bool QSpscQueue<T>::tryPop(T *value, int timeout)
+{
+    if (!notEmpty.wait([&]() { return take(value); }, timeout))
+        return false;
+    notFull.wake();
+    return true;
+}
+
+template <typename T>
+class QMpmcQueue
+{
+public:
+    explicit QMpmcQueue(int capacity);
+    ~QMpmcQueue();
+
+    int capacity() const { return int(mask + 1); }
+    int size() const;
+    bool isEmpty() const { return size() == 0; }
+
+    bool tryPush(const T &value)
+    { if (!emplace(value)) return false; notEmpty.wake(); return true; }
+    bool tryPush(T &&value)
+    { if (!emplace(std::move(value))) return false; notEmpty.wake(); return true; }
+    bool tryPush(const T &value, int timeout);
+    bool tryPush(T &&value, int timeout);
+    void push(const T &value) { tryPush(value, -1); }
+    void push(T &&value) { tryPush(std::move(value), -1); }
+
+    bool tryPop(T *value)
+    { if (!take(value)) return false; notFull.wake(); return true; }
+    bool tryPop(T *value, int timeout);
+    T pop() { T value; tryPop(&value, -1); return value; }
+
+private:
+    Q_DISABLE_COPY(QMpmcQueue)
+
+    // The sequence number of a cell tells whose turn it is: it equals the
+    // position of the next push into the cell, or that position + 1 once
+    // the cell holds a value that can be popped.
+    struct Cell {
+        QAtomicInteger<quintptr> sequence;
+        typename std::aligned_storage<sizeof(T), Q_ALIGNOF(T)>::type storage;
+        T *value() { return reinterpret_cast<T *>(&storage); }
+    };
+
+    template <typename U> bool emplace(U &&value);
+    bool take(T *value);
+
+    Cell *cells;
+    quintptr mask;
+    Q_DECL_UNUSED_MEMBER char padding1[64]; // keep the indexes in different cache lines
+    QAtomicInteger<quintptr> pushPosition;
+    Q_DECL_UNUSED_MEMBER char padding2[64];
+    QAtomicInteger<quintptr> popPosition;
+    Q_DECL_UNUSED_MEMBER char padding3[64];
+    QtPrivate::QueueWaiter notEmpty;
+    QtPrivate::QueueWaiter notFull;
+};
+
+template <typename T>
+QMpmcQueue<T>::QMpmcQueue(int capacity)
+    : mask(quintptr(QtPrivate::queueCapacity(capacity)) - 1),
+      pushPosition(0), popPosition(0)
+{
+    cells = new Cell[mask + 1];
+    for (quintptr i = 0; i <= mask; ++i)
+        cells[i].sequence.store(i);
+}
+
+template <typename T>
+QMpmcQueue<T>::~QMpmcQueue()
+{
+    for (quintptr i = popPosition.load(), end = pushPosition.load(); i != end; ++i)
+        cells[i & mask].value()->~T();
+    delete [] cells;
+}
+
+template <typename T>
+int QMpmcQueue<T>::size() const
+{
+    const qintptr n = qintptr(pushPosition.load() - popPosition.load());
+    return n < 0 ? 0 : n > qintptr(mask + 1) ? int(mask + 1) : int(n);
+}
+
+template <typename T>
+template <typename U>
+bool QMpmcQueue<T>::emplace(U &&value)
+{
+    quintptr position = pushPosition.load();
+    Cell *cell;
+    for (;;) {
+        cell = &cells[position & mask];
+        const qintptr diff = qintptr(cell->sequence.loadAcquire() - position);
+        if (diff == 0) {
+            if (pushPosition.testAndSetRelaxed(position, position + 1, position))
+                break;
+        } else if (diff < 0) {
+            return false; // the cell still holds the value pushed one lap ago
+        } else {
+            position = pushPosition.load();
+        }
+    }
+    new (cell->value()) T(std::forward<U>(value));
+    cell->sequence.storeRelease(position + 1);
+    return true;
+}
+
+template <typename T>
+bool QMpmcQueue<T>::take(T *value)
+{
+    quintptr position = popPosition.load();
+    Cell *cell;
+    for (;;) {
+        cell = &cells[position & mask];
+        const qintptr diff = qintptr(cell->sequence.loadAcquire() - (position + 1));
+        if (diff == 0) {
+            if (popPosition.testAndSetRelaxed(position, position + 1, position))
+                break;
+        } else if (diff < 0) {
+            return false; // nothing has been pushed into the cell yet
+        } else {
+            position = popPosition.load();
+        }
+    }
+    T *slot = cell->value();
+    *value = std::move(*slot);
+    slot->~T();
+    cell->sequence.storeRelease(position + mask + 1);
+    return true;
+}
+
+template <typename T>
+bool QMpmcQueue<T>::tryPush(const T &value, int timeout)
+{
+    if (!notFull.wait([&]() { return emplace(value); }, timeout))
+        return false;
+    notEmpty.wake();
+    return true;
+}
+
+template <typename T>
+bool QMpmcQueue<T>::tryPush(T &&value, int timeout)
+{
+    if (!notFull.wait([&]() { return emplace(std::move(value)); }, timeout))
+        return false;
+    notEmpty.wake();
+    return true;
+}
+
+template <typename T>
+bool QMpmcQueue<T>::tryPop(T *value, int timeout)
+{
+    if (!notEmpty.wait([&]() { return take(value); }, timeout))
+        return false;
+    notFull.wake();
+    return true;
+}
+
+#endif // QT_NO_THREAD
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTQUEUE_H
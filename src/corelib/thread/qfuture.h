@@ -46,6 +46,11 @@
 
 #include <QtCore/qfutureinterface.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <type_traits>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -55,6 +60,25 @@ class QFutureWatcher;
 template <>
 class QFutureWatcher<void>;
 
+namespace QtPrivate {
+
+// the type returned by a continuation passed to QFuture<T>::then()
+template <typename T, typename Function>
+struct ContinuationResult
+{
+    typedef typename std::decay<decltype(std::declval<Function &>()(std::declval<const T &>()))>::type Type;
+};
+
+template <typename Function>
+struct ContinuationResult<void, Function>
+{
+    typedef typename std::decay<decltype(std::declval<Function &>()())>::type Type;
+};
+
+struct FutureAccess;
+
+} // namespace QtPrivate
+
 template <typename T>
 class QFuture
 {
@@ -96,6 +120,15 @@ public:
     operator T() const { return result(); }
     QList<T> results() const { return d.results(); }
 
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<T, Function>::Type> then(Function function);
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<T, Function>::Type> then(QThreadPool *pool, Function function);
+#ifndef QT_NO_EXCEPTIONS
+    template <typename Function>
+    QFuture<T> onFailed(Function handler);
+#endif
+
     class const_iterator
     {
     public:
@@ -220,8 +253,18 @@ public:
     QString progressText() const { return d.progressText(); }
     void waitForFinished() { d.waitForFinished(); }
 
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<void, Function>::Type> then(Function function);
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResult<void, Function>::Type> then(QThreadPool *pool, Function function);
+#ifndef QT_NO_EXCEPTIONS
+    template <typename Function>
+    QFuture<void> onFailed(Function handler);
+#endif
+
 private:
     friend class QFutureWatcher<void>;
+    friend struct QtPrivate::FutureAccess;
 
 #ifdef QFUTURE_TEST
 public:
@@ -240,6 +283,264 @@ QFuture<void> qToVoidFuture(const QFuture<T> &future)
     return QFuture<void>(future.d);
 }
 
+namespace QtPrivate {
+
+// how a continuation reads the result of the future it is attached to
+template <typename T>
+struct ContinuationParent
+{
+    typedef QFutureInterface<T> Type;
+
+    template <typename Function>
+    static auto invoke(Function &function, const Type &parent) -> decltype(function(parent.resultReference(0)))
+    { return function(parent.resultReference(0)); }
+
+    static bool hasResult(const Type &parent) { return parent.resultCount() > 0; }
+
+    static void forwardResults(const Type &parent, QFutureInterface<T> &promise)
+    {
+        for (int i = 0; i < parent.resultCount(); ++i)
+            promise.reportResult(parent.resultReference(i), i);
+    }
+};
+
+template <>
+struct ContinuationParent<void>
+{
+    typedef QFutureInterfaceBase Type;
+
+    template <typename Function>
+    static auto invoke(Function &function, const Type &) -> decltype(function())
+    { return function(); }
+
+    static bool hasResult(const Type &) { return true; }
+    static void forwardResults(const Type &, QFutureInterface<void> &) {}
+};
+
+template <typename R>
+struct ContinuationReporter
+{
+    template <typename Call>
+    static void report(QFutureInterface<R> &promise, const Call &call)
+    { promise.reportResult(call()); }
+};
+
+template <>
+struct ContinuationReporter<void>
+{
+    template <typename Call>
+    static void report(QFutureInterface<void> &, const Call &call)
+    { call(); }
+};
+
+struct FutureAccess
+{
+    template <typename T>
+    static QFutureInterfaceBase &futureInterface(const QFuture<T> &future) { return future.d; }
+};
+
+// finishes promise the same way parent failed: with its exception or canceled
+inline void reportContinuationFailure(const QFutureInterfaceBase &parent, QFutureInterfaceBase &promise)
+{
+#ifndef QT_NO_EXCEPTIONS
+    QFutureInterfaceBase source(parent);
+    if (source.exceptionStore().hasException())
+        promise.reportException(*source.exceptionStore().exception().exception());
+    else
+#endif
+        promise.reportCanceled();
+    promise.reportFinished();
+}
+
+template <typename T, typename R, typename Function>
+class ContinuationRunnable : public QRunnable
+{
+public:
+    ContinuationRunnable(const Function &function, const typename ContinuationParent<T>::Type &parent,
+                         const QFutureInterface<R> &promise)
+        : function(function), parent(parent), promise(promise)
+    { }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        if (promise.isCanceled()) {
+            promise.reportFinished();
+            return;
+        }
+#ifndef QT_NO_EXCEPTIONS
+        try {
+#endif
+            ContinuationReporter<R>::report(promise, [this]() {
+                return ContinuationParent<T>::invoke(function, parent);
+            });
+#ifndef QT_NO_EXCEPTIONS
+        } catch (QException &e) {
+            promise.reportException(e);
+        } catch (...) {
+            promise.reportException(QUnhandledException());
+        }
+#endif
+        promise.reportFinished();
+    }
+
+private:
+    Function function;
+    typename ContinuationParent<T>::Type parent;
+    QFutureInterface<R> promise;
+};
+
+template <typename T, typename Function>
+QFuture<typename ContinuationResult<T, Function>::Type>
+addThenContinuation(QFutureInterfaceBase &d, QThreadPool *pool, const Function &function)
+{
+    typedef typename ContinuationResult<T, Function>::Type R;
+
+    QFutureInterface<R> promise;
+    promise.reportStarted();
+    QFuture<R> future = promise.future();
+    // holding the parent keeps its results alive until the continuation ran
+    const typename ContinuationParent<T>::Type parent(d);
+    d.addContinuation([pool, function, promise, parent](const QFutureInterfaceBase &) mutable {
+        if (parent.isCanceled()) {
+            reportContinuationFailure(parent, promise);
+            return;
+        }
+        if (!ContinuationParent<T>::hasResult(parent)) {
+            reportContinuationFailure(parent, promise);
+            return;
+        }
+        QThreadPool *threadPool = pool ? pool : QThreadPool::globalInstance();
+        threadPool->start(new ContinuationRunnable<T, R, Function>(function, parent, promise));
+    });
+    return future;
+}
+
+#ifndef QT_NO_EXCEPTIONS
+template <typename T, typename Function>
+QFuture<T> addFailureContinuation(QFutureInterfaceBase &d, const Function &handler)
+{
+    QFutureInterface<T> promise;
+    promise.reportStarted();
+    QFuture<T> future = promise.future();
+    typename ContinuationParent<T>::Type parent(d);
+    d.addContinuation([handler, promise, parent](const QFutureInterfaceBase &) mutable {
+        if (!parent.exceptionStore().hasException()) {
+            if (parent.isCanceled())
+                promise.reportCanceled();
+            else
+                ContinuationParent<T>::forwardResults(parent, promise);
+            promise.reportFinished();
+            return;
+        }
+
+        QException *exception = parent.exceptionStore().exception().exception();
+        try {
+            ContinuationReporter<T>::report(promise, [&handler, exception]() {
+                return handler(*exception);
+            });
+        } catch (QException &e) {
+            promise.reportException(e);
+        } catch (...) {
+            promise.reportException(QUnhandledException());
+        }
+        promise.reportFinished();
+    });
+    return future;
+}
+#endif // QT_NO_EXCEPTIONS
+
+} // namespace QtPrivate
+
+template <typename T>
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResult<T, Function>::Type> QFuture<T>::then(Function function)
+{
+    return QtPrivate::addThenContinuation<T>(d, Q_NULLPTR, function);
+}
+
+template <typename T>
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResult<T, Function>::Type> QFuture<T>::then(QThreadPool *pool, Function function)
+{
+    return QtPrivate::addThenContinuation<T>(d, pool, function);
+}
+
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResult<void, Function>::Type> QFuture<void>::then(Function function)
+{
+    return QtPrivate::addThenContinuation<void>(d, Q_NULLPTR, function);
+}
+
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResult<void, Function>::Type> QFuture<void>::then(QThreadPool *pool, Function function)
+{
+    return QtPrivate::addThenContinuation<void>(d, pool, function);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+template <typename T>
+template <typename Function>
+QFuture<T> QFuture<T>::onFailed(Function handler)
+{
+    return QtPrivate::addFailureContinuation<T>(d, handler);
+}
+
+template <typename Function>
+QFuture<void> QFuture<void>::onFailed(Function handler)
+{
+    return QtPrivate::addFailureContinuation<void>(d, handler);
+}
+#endif
+
+namespace QtFuture {
+
+template <typename T>
+QFuture<void> whenAll(const QList<QFuture<T> > &futures)
+{
+    QFutureInterface<void> promise;
+    promise.reportStarted();
+    QFuture<void> future = promise.future();
+    if (futures.isEmpty()) {
+        promise.reportFinished();
+        return future;
+    }
+
+    QSharedPointer<QAtomicInt> remaining(new QAtomicInt(futures.count()));
+    for (const QFuture<T> &f : futures) {
+        QtPrivate::FutureAccess::futureInterface(f).addContinuation([promise, remaining](const QFutureInterfaceBase &) mutable {
+            if (!remaining->deref())
+                promise.reportFinished();
+        });
+    }
+    return future;
+}
+
+template <typename T>
+QFuture<int> whenAny(const QList<QFuture<T> > &futures)
+{
+    QFutureInterface<int> promise;
+    promise.reportStarted();
+    QFuture<int> future = promise.future();
+    if (futures.isEmpty()) {
+        promise.reportCanceled();
+        promise.reportFinished();
+        return future;
+    }
+
+    QSharedPointer<QAtomicInt> done(new QAtomicInt(0));
+    for (int i = 0; i < futures.count(); ++i) {
+        QtPrivate::FutureAccess::futureInterface(futures.at(i)).addContinuation([promise, done, i](const QFutureInterfaceBase &) mutable {
+            if (done->testAndSetRelaxed(0, 1)) {
+                promise.reportResult(i);
+                promise.reportFinished();
+            }
+        });
+    }
+    return future;
+}
+
+} // namespace QtFuture
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_QFUTURE
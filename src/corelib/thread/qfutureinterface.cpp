@@ -293,7 +293,35 @@ void QFutureInterfaceBase::reportFinished()
         switch_from_to(d->state, Running, Finished);
         d->waitCondition.wakeAll();
         d->sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::Finished));
+
+        if (!d->continuations.isEmpty()) {
+            // run them without the lock, they may query this future
+            const QVector<std::function<void(const QFutureInterfaceBase &)> > continuations
+                = std::move(d->continuations);
+            d->continuations.clear();
+            locker.unlock();
+            for (const auto &continuation : continuations)
+                continuation(*this);
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Registers \a continuation to be called once this future is finished,
+    in the thread that reports it finished. If the future is already
+    finished, \a continuation is called immediately.
+*/
+void QFutureInterfaceBase::addContinuation(const std::function<void(const QFutureInterfaceBase &)> &continuation)
+{
+    QMutexLocker locker(&d->m_mutex);
+    if (!isFinished()) {
+        d->continuations.append(continuation);
+        return;
     }
+    locker.unlock();
+    continuation(*this);
 }
 
 void QFutureInterfaceBase::setExpectedResultCount(int resultCount)
@@ -329,8 +357,10 @@ void QFutureInterfaceBase::waitForResult(int resultIndex)
     lock.relock();
 
     const int waitIndex = (resultIndex == -1) ? INT_MAX : resultIndex;
+    d->resultObservers.ref();
     while (isRunning() && !d->internal_isResultReadyAt(waitIndex))
         d->waitCondition.wait(&d->m_mutex);
+    d->resultObservers.deref();
 
     d->m_exceptionStore.throwPossibleException();
 }
@@ -353,6 +383,24 @@ void QFutureInterfaceBase::waitForFinished()
     d->m_exceptionStore.throwPossibleException();
 }
 
+/*!
+    \internal
+
+    Called without the mutex after results from \a beginIndex to
+    \a endIndex were added to a store in indexed mode. Their slots are
+    already published, so the lock is only taken when a thread waits for a
+    result, a QFutureWatcher is connected, or progress is derived from the
+    result count.
+*/
+void QFutureInterfaceBase::reportIndexedResultsReady(int beginIndex, int endIndex)
+{
+    if (d->resultObservers.loadAcquire() == 0 && d->manualProgress)
+        return;
+
+    QMutexLocker locker(&d->m_mutex);
+    reportResultsReady(beginIndex, endIndex);
+}
+
 void QFutureInterfaceBase::reportResultsReady(int beginIndex, int endIndex)
 {
     if (beginIndex == endIndex || (d->state.load() & (Canceled|Finished)))
@@ -489,8 +537,10 @@ bool QFutureInterfaceBasePrivate::internal_waitForNextResult()
     if (m_results.hasNextResult())
         return true;
 
+    resultObservers.ref();
     while ((state.load() & QFutureInterfaceBase::Running) && m_results.hasNextResult() == false)
         waitCondition.wait(&m_mutex);
+    resultObservers.deref();
 
     return !(state.load() & QFutureInterfaceBase::Canceled) && m_results.hasNextResult();
 }
@@ -569,14 +619,31 @@ void QFutureInterfaceBasePrivate::connectOutputInterface(QFutureCallOutInterface
                                                         m_progressText));
     }
 
-    QtPrivate::ResultIteratorBase it = m_results.begin();
-    while (it != m_results.end()) {
-        const int begin = it.resultIndex();
-        const int end = begin + it.batchSize();
-        interface->postCallOutEvent(QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady,
-                                                        begin,
-                                                        end));
-        it.batchedAdvance();
+    resultObservers.ref();
+    if (m_results.isIndexed()) {
+        // post one event per run of ready slots
+        int begin = -1;
+        for (int i = 0; i <= m_results.indexedCapacity(); ++i) {
+            const bool ready = i < m_results.indexedCapacity() && m_results.contains(i);
+            if (ready && begin == -1) {
+                begin = i;
+            } else if (!ready && begin != -1) {
+                interface->postCallOutEvent(QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady,
+                                                                begin,
+                                                                i));
+                begin = -1;
+            }
+        }
+    } else {
+        QtPrivate::ResultIteratorBase it = m_results.begin();
+        while (it != m_results.end()) {
+            const int begin = it.resultIndex();
+            const int end = begin + it.batchSize();
+            interface->postCallOutEvent(QFutureCallOutEvent(QFutureCallOutEvent::ResultsReady,
+                                                            begin,
+                                                            end));
+            it.batchedAdvance();
+        }
     }
 
     if (state.load() & QFutureInterfaceBase::Paused)
@@ -598,6 +665,7 @@ void QFutureInterfaceBasePrivate::disconnectOutputInterface(QFutureCallOutInterf
     if (index == -1)
         return;
     outputConnections.removeAt(index);
+    resultObservers.deref();
 
     interface->callOutInterfaceDisconnected();
 }
@@ -48,6 +48,8 @@
 #include <QtCore/qexception.h>
 #include <QtCore/qresultstore.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -82,6 +84,7 @@ public:
     void reportException(const QException &e);
 #endif
     void reportResultsReady(int beginIndex, int endIndex);
+    void reportIndexedResultsReady(int beginIndex, int endIndex);
 
     void setRunnable(QRunnable *runnable);
     void setThreadPool(QThreadPool *pool);
@@ -127,6 +130,8 @@ public:
     inline bool operator!=(const QFutureInterfaceBase &other) const { return d != other.d; }
     QFutureInterfaceBase &operator=(const QFutureInterfaceBase &other);
 
+    void addContinuation(const std::function<void(const QFutureInterfaceBase &)> &continuation);
+
 protected:
     bool refT() const;
     bool derefT() const;
@@ -156,6 +161,11 @@ public:
     {
         refT();
     }
+    explicit QFutureInterface(const QFutureInterfaceBase &other)
+        : QFutureInterfaceBase(other)
+    {
+        refT();
+    }
     ~QFutureInterface()
     {
         if (!derefT())
@@ -180,6 +190,7 @@ public:
     inline void reportResult(const T &result, int index = -1);
     inline void reportResults(const QVector<T> &results, int beginIndex = -1, int count = -1);
     inline void reportFinished(const T *result = 0);
+    inline void reserveResults(int count);
 
     inline const T &resultReference(int index) const;
     inline const T *resultPointer(int index) const;
@@ -189,13 +200,22 @@ public:
 template <typename T>
 inline void QFutureInterface<T>::reportResult(const T *result, int index)
 {
+    QtPrivate::ResultStoreBase &store = resultStoreBase();
+    if (store.isIndexed()) {
+        // preallocated store: no locking
+        if (!result || this->queryState(Canceled) || this->queryState(Finished))
+            return;
+        const int insertIndex = store.addIndexedResult<T>(index, *result);
+        if (insertIndex != -1)
+            this->reportIndexedResultsReady(insertIndex, insertIndex + 1);
+        return;
+    }
+
     QMutexLocker locker(mutex());
     if (this->queryState(Canceled) || this->queryState(Finished)) {
         return;
     }
 
-    QtPrivate::ResultStoreBase &store = resultStoreBase();
-
     if (store.filterMode()) {
         const int resultCountBefore = store.count();
         store.addResult<T>(index, result);
@@ -215,13 +235,21 @@ inline void QFutureInterface<T>::reportResult(const T &result, int index)
 template <typename T>
 inline void QFutureInterface<T>::reportResults(const QVector<T> &_results, int beginIndex, int count)
 {
+    auto &store = resultStoreBase();
+    if (store.isIndexed()) {
+        if (this->queryState(Canceled) || this->queryState(Finished) || _results.isEmpty())
+            return;
+        const int insertIndex = store.addIndexedResults<T>(beginIndex, _results, _results.count());
+        if (insertIndex != -1)
+            this->reportIndexedResultsReady(insertIndex, insertIndex + _results.count());
+        return;
+    }
+
     QMutexLocker locker(mutex());
     if (this->queryState(Canceled) || this->queryState(Finished)) {
         return;
     }
 
-    auto &store = resultStoreBase();
-
     if (store.filterMode()) {
         const int resultCountBefore = store.count();
         store.addResults(beginIndex, &_results, count);
@@ -240,18 +268,31 @@ inline void QFutureInterface<T>::reportFinished(const T *result)
     QFutureInterfaceBase::reportFinished();
 }
 
+template <typename T>
+inline void QFutureInterface<T>::reserveResults(int count)
+{
+    QMutexLocker locker(mutex());
+    resultStoreBase().template reserveIndexedResults<T>(count);
+}
+
 template <typename T>
 inline const T &QFutureInterface<T>::resultReference(int index) const
 {
+    const QtPrivate::ResultStoreBase &store = resultStoreBase();
+    if (store.isIndexed())
+        return store.indexedResult<T>(index);
     QMutexLocker lock(mutex());
-    return resultStoreBase().resultAt(index).template value<T>();
+    return store.resultAt(index).template value<T>();
 }
 
 template <typename T>
 inline const T *QFutureInterface<T>::resultPointer(int index) const
 {
+    const QtPrivate::ResultStoreBase &store = resultStoreBase();
+    if (store.isIndexed())
+        return &store.indexedResult<T>(index);
     QMutexLocker lock(mutex());
-    return resultStoreBase().resultAt(index).template pointer<T>();
+    return store.resultAt(index).template pointer<T>();
 }
 
 template <typename T>
@@ -266,6 +307,14 @@ inline QList<T> QFutureInterface<T>::results()
     QList<T> res;
     QMutexLocker lock(mutex());
 
+    if (resultStoreBase().isIndexed()) {
+        const int count = resultStoreBase().count();
+        res.reserve(count);
+        for (int i = 0; i < count; ++i)
+            res.append(resultStoreBase().template indexedResult<T>(i));
+        return res;
+    }
+
     QtPrivate::ResultIteratorBase it = resultStoreBase().begin();
     while (it != resultStoreBase().end()) {
         res.append(it.value<T>());
@@ -50,6 +50,17 @@
 #include "qelapsedtimer.h"
 #include "private/qfreelist_p.h"
 
+#ifdef QT_LINUX_FUTEX
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <errno.h>
+#  include <limits.h>
+#endif
+#if defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86)
+#  include <intrin.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 /*
@@ -62,6 +73,15 @@ QT_BEGIN_NAMESPACE
  *    are waiting, and the lock is not recursive.
  *  - when d_ptr == 0x2: We are locked for write and nobody is waiting. (no contention)
  *  - In any other case, d_ptr points to an actual QReadWriteLockPrivate.
+ *
+ * Non-recursive locks constructed with PreferReaders additionally have the
+ * 0x4 bit set in all of the above states that are not a pointer, e.g. such a
+ * lock is unlocked when d_ptr == 0x4. When a QReadWriteLockPrivate gets
+ * assigned, the preference is stored in it instead.
+ *
+ * Before assigning a QReadWriteLockPrivate and going to sleep, a thread that
+ * finds the lock taken spins for a while on multi-core machines, waiting for
+ * the holder to release it.
  */
 
 namespace {
@@ -69,13 +89,111 @@ enum {
     StateMask = 0x3,
     StateLockedForRead = 0x1,
     StateLockedForWrite = 0x2,
+    PreferReadersFlag = 0x4,
 };
 const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForRead));
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
+const auto dummyUnlockedPreferringReaders = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(PreferReadersFlag));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
+inline bool isUnlocked(const QReadWriteLockPrivate *d)
+{ return quintptr(d) == 0 || quintptr(d) == PreferReadersFlag; }
+inline bool prefersReaders(const QReadWriteLockPrivate *d)
+{ return quintptr(d) & PreferReadersFlag; }
+// the value of d_ptr once the lock in state \a d is unlocked
+inline QReadWriteLockPrivate *unlockedState(const QReadWriteLockPrivate *d)
+{ return reinterpret_cast<QReadWriteLockPrivate *>(quintptr(d) & PreferReadersFlag); }
+inline QReadWriteLockPrivate *withState(const QReadWriteLockPrivate *d, quintptr state)
+{ return reinterpret_cast<QReadWriteLockPrivate *>((quintptr(d) & PreferReadersFlag) | state); }
+
+inline void relaxCpu()
+{
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC)
+    _mm_pause();
+#elif defined(Q_PROCESSOR_X86) && defined(Q_CC_GNU)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Adaptive spinning, in the spirit of glibc's adaptive mutexes: a thread
+// spins at most twice as often as the running average of what the previous
+// spins needed, so that locks held for short periods are taken over without
+// sleeping, while long critical sections quickly stop wasting CPU time.
+enum { MaxSpinCount = 1000 };
+QBasicAtomicInt spinEstimate = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+// Spins as long as the state of d_ptr is one of \a lockedStates. Returns
+// true, with \a d updated, if the lock left that state in time.
+bool spinWhileLocked(const QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
+                     QReadWriteLockPrivate *&d, quintptr lockedStates)
+{
+    static const bool multiCore = QThread::idealThreadCount() > 1;
+    if (!multiCore)
+        return false;
+
+    const int estimate = spinEstimate.load();
+    const int maxSpins = qMin(int(MaxSpinCount), estimate * 2 + 10);
+    int spins = 0;
+    QReadWriteLockPrivate *current = d;
+    while (spins < maxSpins) {
+        ++spins;
+        relaxCpu();
+        current = d_ptr.load();
+        if (!isUncontendedLocked(current) || !(quintptr(current) & lockedStates))
+            break;
+    }
+    spinEstimate.store(estimate + (spins - estimate) / 8);
+
+    if (isUncontendedLocked(current) && (quintptr(current) & lockedStates))
+        return false;
+    d = current;
+    return true;
+}
+}
+
+#ifdef QT_LINUX_FUTEX
+static inline int _q_futex(QAtomicInt *addr, int op, int val, const struct timespec *timeout) Q_DECL_NOTHROW
+{
+#ifndef FUTEX_PRIVATE_FLAG
+    const int privateFlag = 0;
+#else
+    const int privateFlag = FUTEX_PRIVATE_FLAG;
+#endif
+    return syscall(__NR_futex, reinterpret_cast<int *>(addr), op | privateFlag, val, timeout, nullptr, 0);
+}
+
+bool QReadWriteLockWaitQueue::wait(QMutex *mutex, unsigned long time)
+{
+    struct timespec ts, *pts = nullptr;
+    if (time != ULONG_MAX) {
+        ts.tv_sec = time / 1000;
+        ts.tv_nsec = (time % 1000) * 1000 * 1000;
+        pts = &ts;
+    }
+
+    // the sequence only changes with the mutex locked, so a wake-up that
+    // happens after the mutex is unlocked cannot get lost
+    const int expected = sequence.load();
+    mutex->unlock();
+    const int r = _q_futex(&sequence, FUTEX_WAIT, expected, pts);
+    const bool timedOut = r != 0 && errno == ETIMEDOUT;
+    mutex->lock();
+    return !timedOut;
 }
 
+void QReadWriteLockWaitQueue::wakeOne()
+{
+    sequence.ref();
+    _q_futex(&sequence, FUTEX_WAKE, 1, nullptr);
+}
+
+void QReadWriteLockWaitQueue::wakeAll()
+{
+    sequence.ref();
+    _q_futex(&sequence, FUTEX_WAKE, INT_MAX, nullptr);
+}
+#endif // QT_LINUX_FUTEX
+
 /*! \class QReadWriteLock
     \inmodule QtCore
     \brief The QReadWriteLock class provides read-write locking.
@@ -104,7 +222,11 @@ inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
     writer waiting for access, even if the lock is currently only
     accessed by other readers. Also, if the lock is accessed by a
     writer and another writer comes in, that writer will have
-    priority over any readers that might also be waiting.
+    priority over any readers that might also be waiting. Locks
+    constructed with \l{QReadWriteLock::PreferReaders} instead let
+    readers in for as long as the lock is accessed by other readers,
+    which maximizes the read throughput at the risk of starving the
+    writers.
 
     Like QMutex, a QReadWriteLock can be recursively locked by the
     same thread when constructed with \l{QReadWriteLock::Recursive} as
@@ -132,6 +254,26 @@ inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
     \sa QReadWriteLock()
 */
 
+/*!
+    \enum QReadWriteLock::Preference
+    \since 5.11
+
+    This enum describes who gets the lock first when both readers and
+    writers are waiting for it.
+
+    \value PreferWriters Readers that attempt to lock do not succeed if a
+    writer is waiting, even if the lock is currently only accessed by
+    other readers. When the lock is released, waiting writers are woken up
+    before waiting readers. This is the default.
+
+    \value PreferReaders Readers succeed whenever the lock is not locked
+    for writing, even if writers are waiting. When the lock is released,
+    waiting readers are woken up before waiting writers. Writers may starve
+    if the lock is never free of readers.
+
+    \sa preference()
+*/
+
 /*!
     \since 4.4
 
@@ -147,6 +289,22 @@ QReadWriteLock::QReadWriteLock(RecursionMode recursionMode)
     Q_ASSERT_X(!(quintptr(d_ptr.load()) & StateMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
 }
 
+/*!
+    \since 5.11
+
+    Constructs a QReadWriteLock object in the given \a recursionMode that
+    resolves contention between readers and writers with the given \a
+    preference.
+
+    \sa preference(), lockForRead(), lockForWrite()
+*/
+QReadWriteLock::QReadWriteLock(RecursionMode recursionMode, Preference preference)
+    : d_ptr(recursionMode == Recursive ? new QReadWriteLockPrivate(true, preference == PreferReaders)
+            : preference == PreferReaders ? dummyUnlockedPreferringReaders : nullptr)
+{
+    Q_ASSERT_X(!(quintptr(d_ptr.load()) & StateMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
+}
+
 /*!
     Destroys the QReadWriteLock object.
 
@@ -160,7 +318,31 @@ QReadWriteLock::~QReadWriteLock()
         qWarning("QReadWriteLock: destroying locked QReadWriteLock");
         return;
     }
-    delete d;
+    if (!isUnlocked(d))
+        delete d;
+}
+
+/*!
+    \since 5.11
+
+    Returns the preference this lock was constructed with.
+
+    \sa Preference
+*/
+QReadWriteLock::Preference QReadWriteLock::preference() const
+{
+    // the preference of a lock never changes, so whatever the state, it is
+    // either in d_ptr itself or in the QReadWriteLockPrivate d_ptr points to
+    QReadWriteLockPrivate *d = d_ptr.loadAcquire();
+    while (!isUncontendedLocked(d) && !isUnlocked(d)) {
+        if (d->recursive)
+            return d->preferReaders ? PreferReaders : PreferWriters;
+        QMutexLocker lock(&d->mutex);
+        if (d == d_ptr.load())
+            return d->preferReaders ? PreferReaders : PreferWriters;
+        d = d_ptr.loadAcquire();
+    }
+    return prefersReaders(d) ? PreferReaders : PreferWriters;
 }
 
 /*!
@@ -226,9 +408,10 @@ bool QReadWriteLock::tryLockForRead(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
         return true;
 
+    bool spun = false;
     while (true) {
-        if (d == 0) {
-            if (!d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
+        if (isUnlocked(d)) {
+            if (!d_ptr.testAndSetAcquire(d, withState(d, StateLockedForRead), d))
                 continue;
             return true;
         }
@@ -243,12 +426,18 @@ bool QReadWriteLock::tryLockForRead(int timeout)
             return true;
         }
 
-        if (d == dummyLockedForWrite) {
+        if ((quintptr(d) & StateMask) == StateLockedForWrite) {
             if (!timeout)
                 return false;
 
+            if (!spun) {
+                spun = true;
+                if (spinWhileLocked(d_ptr, d, StateLockedForWrite))
+                    continue;
+            }
+
             // locked for write, assign a d_ptr and wait.
-            auto val = QReadWriteLockPrivate::allocate();
+            auto val = QReadWriteLockPrivate::allocate(prefersReaders(d));
             val->writerCount = 1;
             if (!d_ptr.testAndSetOrdered(d, val, d)) {
                 val->writerCount = 0;
@@ -340,9 +529,10 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
         return true;
 
+    bool spun = false;
     while (true) {
-        if (d == 0) {
-            if (!d_ptr.testAndSetAcquire(d, dummyLockedForWrite, d))
+        if (isUnlocked(d)) {
+            if (!d_ptr.testAndSetAcquire(d, withState(d, StateLockedForWrite), d))
                 continue;
             return true;
         }
@@ -351,9 +541,15 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
             if (!timeout)
                 return false;
 
+            if (!spun) {
+                spun = true;
+                if (spinWhileLocked(d_ptr, d, StateMask))
+                    continue;
+            }
+
             // locked for either read or write, assign a d_ptr and wait.
-            auto val = QReadWriteLockPrivate::allocate();
-            if (d == dummyLockedForWrite)
+            auto val = QReadWriteLockPrivate::allocate(prefersReaders(d));
+            if ((quintptr(d) & StateMask) == StateLockedForWrite)
                 val->writerCount = 1;
             else
                 val->readerCount = (quintptr(d) >> 4) + 1;
@@ -394,11 +590,11 @@ void QReadWriteLock::unlock()
 {
     QReadWriteLockPrivate *d = d_ptr.loadAcquire();
     while (true) {
-        Q_ASSERT_X(d, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
+        Q_ASSERT_X(!isUnlocked(d), "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
 
         // Fast case: no contention: (no waiters, no other readers)
-        if (quintptr(d) <= 2) { // 1 or 2 (StateLockedForRead or StateLockedForWrite)
-            if (!d_ptr.testAndSetOrdered(d, nullptr, d))
+        if (isUncontendedLocked(d) && (quintptr(d) >> 4) == 0) { // StateLockedForRead or StateLockedForWrite
+            if (!d_ptr.testAndSetOrdered(d, unlockedState(d), d))
                 continue;
             return;
         }
@@ -435,7 +631,7 @@ void QReadWriteLock::unlock()
             d->unlock();
         } else {
             Q_ASSERT(d_ptr.load() == d); // should not change when we still hold the mutex
-            d_ptr.storeRelease(nullptr);
+            d_ptr.storeRelease(d->preferReaders ? dummyUnlockedPreferringReaders : nullptr);
             d->release();
         }
         return;
@@ -451,7 +647,7 @@ QReadWriteLock::StateForWaitCondition QReadWriteLock::stateForWaitCondition() co
     case StateLockedForWrite: return LockedForWrite;
     }
 
-    if (!d)
+    if (isUnlocked(d))
         return Unlocked;
     if (d->writerCount > 1)
         return RecursivelyLocked;
@@ -469,7 +665,7 @@ bool QReadWriteLockPrivate::lockForRead(int timeout)
     if (timeout > 0)
         t.start();
 
-    while (waitingWriters || writerCount) {
+    while (writerCount || (waitingWriters && !preferReaders)) {
         if (timeout == 0)
             return false;
         if (timeout > 0) {
@@ -528,10 +724,10 @@ bool QReadWriteLockPrivate::lockForWrite(int timeout)
 void QReadWriteLockPrivate::unlock()
 {
     Q_ASSERT(!mutex.tryLock()); // mutex must be locked when entering this function
-    if (waitingWriters)
-        writerCond.wakeOne();
-    else if (waitingReaders)
+    if (waitingReaders && (preferReaders || !waitingWriters))
         readerCond.wakeAll();
+    else if (waitingWriters)
+        writerCond.wakeOne();
 }
 
 bool QReadWriteLockPrivate::recursiveLockForRead(int timeout)
@@ -617,11 +813,12 @@ typedef QFreeList<QReadWriteLockPrivate, FreeListConstants> FreeList;
 Q_GLOBAL_STATIC(FreeList, freelist);
 }
 
-QReadWriteLockPrivate *QReadWriteLockPrivate::allocate()
+QReadWriteLockPrivate *QReadWriteLockPrivate::allocate(bool preferReaders)
 {
     int i = freelist->next();
     QReadWriteLockPrivate *d = &(*freelist)[i];
     d->id = i;
+    d->preferReaders = preferReaders;
     Q_ASSERT(!d->recursive);
     Q_ASSERT(!d->waitingReaders && !d->waitingReaders && !d->readerCount && !d->writerCount);
     return d;
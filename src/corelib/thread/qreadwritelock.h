@@ -53,10 +53,14 @@ class Q_CORE_EXPORT QReadWriteLock
 {
 public:
     enum RecursionMode { NonRecursive, Recursive };
+    enum Preference { PreferWriters, PreferReaders };
 
     explicit QReadWriteLock(RecursionMode recursionMode = NonRecursive);
+    QReadWriteLock(RecursionMode recursionMode, Preference preference);
     ~QReadWriteLock();
 
+    Preference preference() const;
+
     void lockForRead();
     bool tryLockForRead();
     bool tryLockForRead(int timeout);
@@ -55,26 +55,49 @@
 #include <QtCore/private/qglobal_p.h>
 #include <QtCore/qhash.h>
 #include <QtCore/QWaitCondition>
+#include <QtCore/private/qmutex_p.h>
 
 #ifndef QT_NO_THREAD
 
 QT_BEGIN_NAMESPACE
 
+#ifdef QT_LINUX_FUTEX
+// A condition variable built directly on a futex: waiters sleep as long as
+// the sequence number is unchanged, and every wake-up increments it. Unlike
+// QWaitCondition this does not need a second mutex. All functions must be
+// called with the mutex of the QReadWriteLockPrivate locked.
+class QReadWriteLockWaitQueue
+{
+public:
+    QReadWriteLockWaitQueue() : sequence(0) {}
+
+    bool wait(QMutex *mutex, unsigned long time = ULONG_MAX);
+    void wakeOne();
+    void wakeAll();
+
+private:
+    QAtomicInt sequence;
+};
+#else
+typedef QWaitCondition QReadWriteLockWaitQueue;
+#endif
+
 class QReadWriteLockPrivate
 {
 public:
-    QReadWriteLockPrivate(bool isRecursive = false)
+    QReadWriteLockPrivate(bool isRecursive = false, bool isPreferringReaders = false)
         : readerCount(0), writerCount(0), waitingReaders(0), waitingWriters(0),
-        recursive(isRecursive), id(0), currentWriter(nullptr) {}
+        recursive(isRecursive), preferReaders(isPreferringReaders), id(0), currentWriter(nullptr) {}
 
     QMutex mutex;
-    QWaitCondition writerCond;
-    QWaitCondition readerCond;
+    QReadWriteLockWaitQueue writerCond;
+    QReadWriteLockWaitQueue readerCond;
     int readerCount;
     int writerCount;
     int waitingReaders;
     int waitingWriters;
     const bool recursive;
+    bool preferReaders; // set by allocate() for the non-recursive ones
 
     //Called with the mutex locked
     bool lockForWrite(int timeout);
@@ -84,7 +107,7 @@ public:
     //memory management
     int id;
     void release();
-    static QReadWriteLockPrivate *allocate();
+    static QReadWriteLockPrivate *allocate(bool preferReaders);
 
     // Recusive mutex handling
     Qt::HANDLE currentWriter;
@@ -96,19 +96,57 @@ bool ResultIteratorBase::canIncrementVectorIndex() const
 }
 
 ResultStoreBase::ResultStoreBase()
-    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0) { }
+    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0),
+      m_indexedResults(Q_NULLPTR), m_indexedReady(Q_NULLPTR), m_indexedCapacity(0) { }
 
 ResultStoreBase::~ResultStoreBase()
 {
     // QFutureInterface's dtor must delete the contents of m_results.
     Q_ASSERT(m_results.isEmpty());
+    Q_ASSERT(!isIndexed());
 }
 
 void ResultStoreBase::setFilterMode(bool enable)
 {
+    Q_ASSERT(!enable || !isIndexed());
     m_filterMode = enable;
 }
 
+/*
+    Returns the first of \a count slots starting at \a index, picking the
+    next free slots if \a index is -1. Returns -1 if the slots are out of
+    range of the preallocated buffer.
+*/
+int ResultStoreBase::reserveIndexedSlots(int index, int count)
+{
+    if (index == -1)
+        index = m_indexedNext.fetchAndAddRelaxed(count);
+    if (index < 0 || count <= 0 || index > m_indexedCapacity - count) {
+        qWarning("QFutureInterface: result index %d is out of the reserved range", index);
+        return -1;
+    }
+    return index;
+}
+
+/*
+    Publishes the slots from \a beginIndex to \a endIndex, which the caller
+    has written, and advances the count of consecutive results. Safe to call
+    from several threads at once for different slots.
+*/
+void ResultStoreBase::markIndexedResultsReady(int beginIndex, int endIndex)
+{
+    for (int i = beginIndex; i < endIndex; ++i)
+        m_indexedReady[i].fetchAndStoreOrdered(1);
+    m_indexedStored.fetchAndAddOrdered(endIndex - beginIndex);
+
+    // whichever thread sees the next slot ready moves the count past it
+    int current = m_indexedCount.loadAcquire();
+    while (current < m_indexedCapacity && m_indexedReady[current].loadAcquire()) {
+        if (m_indexedCount.testAndSetOrdered(current, current + 1, current))
+            ++current;
+    }
+}
+
 bool ResultStoreBase::filterMode() const
 {
     return m_filterMode;
@@ -196,6 +234,8 @@ ResultIteratorBase ResultStoreBase::end() const
 
 bool ResultStoreBase::hasNextResult() const
 {
+    if (isIndexed())
+        return m_indexedStored.loadAcquire() > 0;
     return begin() != end();
 }
 
@@ -232,11 +272,15 @@ ResultIteratorBase ResultStoreBase::resultAt(int index) const
 
 bool ResultStoreBase::contains(int index) const
 {
+    if (isIndexed())
+        return index >= 0 && index < m_indexedCapacity && m_indexedReady[index].loadAcquire();
     return (resultAt(index) != end());
 }
 
 int ResultStoreBase::count() const
 {
+    if (isIndexed())
+        return m_indexedCount.loadAcquire();
     return resultCount;
 }
 
@@ -45,6 +45,8 @@
 #ifndef QT_NO_QFUTURE
 
 #include <QtCore/qmap.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qatomic.h>
 #include <QtCore/qdebug.h>
 
 QT_BEGIN_NAMESPACE
@@ -56,6 +58,12 @@ QT_BEGIN_NAMESPACE
     which indexes are in the store can be done either by iterating or by random
     accees. In addition results kan be removed from the front of the store,
     either individually or in batches.
+
+    When the number of results is known in advance, reserveIndexedResults()
+    switches the store to a preallocated buffer with one slot per index.
+    Results are then written into their slots and published with atomic
+    flags, so adding them needs neither the QFutureInterface mutex nor an
+    allocation. Filter mode and indexed mode are mutually exclusive.
 */
 
 #ifndef Q_QDOC
@@ -126,6 +134,11 @@ public:
     int count() const;
     virtual ~ResultStoreBase();
 
+    bool isIndexed() const { return m_indexedResults != Q_NULLPTR; }
+    int indexedCapacity() const { return m_indexedCapacity; }
+    int reserveIndexedSlots(int index, int count);
+    void markIndexedResultsReady(int beginIndex, int endIndex);
+
 protected:
     int insertResultItem(int index, ResultItem &resultItem);
     void insertResultItemIfValid(int index, ResultItem &resultItem);
@@ -141,6 +154,14 @@ protected:
     QMap<int, ResultItem> pendingResults;
     int filteredResults;
 
+    // indexed mode, see reserveIndexedResults()
+    void *m_indexedResults;    // QVector<T> with one slot per index
+    QAtomicInt *m_indexedReady; // one flag per slot, set once the slot is written
+    int m_indexedCapacity;
+    QAtomicInt m_indexedCount;  // consecutive ready slots, starting at 0
+    QAtomicInt m_indexedStored; // ready slots in total
+    QAtomicInt m_indexedNext;   // the slot used for results added with index -1
+
 public:
     template <typename T>
     int addResult(int index, const T *result)
@@ -166,6 +187,47 @@ public:
             return addResults(index, new QVector<T>(*results), results->count(), totalCount);
     }
 
+    template <typename T>
+    void reserveIndexedResults(int count)
+    {
+        if (m_filterMode || isIndexed() || count <= 0 || !m_results.isEmpty())
+            return;
+        m_indexedResults = new QVector<T>(count);
+        m_indexedReady = new QAtomicInt[count];
+        m_indexedCapacity = count;
+    }
+
+    // returns the index the result was stored at, or -1 if it is out of range
+    template <typename T>
+    int addIndexedResult(int index, const T &result)
+    {
+        index = reserveIndexedSlots(index, 1);
+        if (index == -1)
+            return -1;
+        static_cast<QVector<T> *>(m_indexedResults)->data()[index] = result;
+        markIndexedResultsReady(index, index + 1);
+        return index;
+    }
+
+    template <typename T>
+    int addIndexedResults(int index, const QVector<T> &results, int count)
+    {
+        index = reserveIndexedSlots(index, count);
+        if (index == -1)
+            return -1;
+        T *destination = static_cast<QVector<T> *>(m_indexedResults)->data() + index;
+        std::copy(results.constBegin(), results.constBegin() + count, destination);
+        markIndexedResultsReady(index, index + count);
+        return index;
+    }
+
+    // the caller must have checked contains(index)
+    template <typename T>
+    const T &indexedResult(int index) const
+    {
+        return static_cast<const QVector<T> *>(m_indexedResults)->at(index);
+    }
+
     int addCanceledResult(int index)
     {
         return addResult(index, static_cast<void *>(nullptr));
@@ -181,6 +243,16 @@ public:
     template <typename T>
     void clear()
     {
+        if (isIndexed()) {
+            delete static_cast<QVector<T> *>(m_indexedResults);
+            delete [] m_indexedReady;
+            m_indexedResults = Q_NULLPTR;
+            m_indexedReady = Q_NULLPTR;
+            m_indexedCapacity = 0;
+            m_indexedCount.store(0);
+            m_indexedStored.store(0);
+            m_indexedNext.store(0);
+        }
         QMap<int, ResultItem>::const_iterator mapIterator = m_results.constBegin();
         while (mapIterator != m_results.constEnd()) {
             if (mapIterator.value().isVector())
@@ -89,6 +89,7 @@ QThreadData::~QThreadData()
     thread = 0;
     delete t;
 
+    QObjectPrivate::discardBatchedMetaCalls(this);
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -497,6 +498,47 @@ uint QThread::stackSize() const
     return d->stackSize;
 }
 
+/*!
+    \since 5.11
+
+    Restricts the thread to the logical processors listed in \a cpus.
+    Processors are numbered from 0 in the order used by the operating
+    system. An empty list removes the restriction, letting the thread
+    run on any processor available to the process.
+
+    If the thread is running, the new affinity is applied immediately;
+    otherwise it is applied when the thread is started, before run() is
+    called. Processors that do not exist are ignored.
+
+    Setting the affinity is supported on Linux and Windows. On other
+    platforms a warning is printed and the list is ignored.
+
+    \sa cpuAffinity(), QThreadPool::setThreadAffinityPolicy()
+*/
+void QThread::setCpuAffinity(const QVector<int> &cpus)
+{
+    Q_D(QThread);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    if (d->running && !d->isInFinish)
+        d->applyCpuAffinity();
+}
+
+/*!
+    \since 5.11
+
+    Returns the list of processors set with setCpuAffinity(), or an empty
+    list if the thread is not restricted to particular processors.
+
+    \sa setCpuAffinity()
+*/
+QVector<int> QThread::cpuAffinity() const
+{
+    Q_D(const QThread);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
 /*!
     Enters the event loop and waits until exit() is called, returning the value
     that was passed to exit(). The value returned is 0 if exit() is called via
@@ -42,6 +42,7 @@
 #define QTHREAD_H
 
 #include <QtCore/qobject.h>
+#include <QtCore/qvector.h>
 
 // For QThread::create. The configure-time test just checks for the availability
 // of std::future and std::async; for the C++17 codepath we perform some extra
@@ -105,6 +106,9 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setCpuAffinity(const QVector<int> &cpus);
+    QVector<int> cpuAffinity() const;
+
     void exit(int retcode = 0);
 
     QAbstractEventDispatcher *eventDispatcher() const;
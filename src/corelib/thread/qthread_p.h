@@ -59,6 +59,8 @@
 #include "QtCore/qstack.h"
 #include "QtCore/qwaitcondition.h"
 #include "QtCore/qmap.h"
+#include "QtCore/qhash.h"
+#include "QtCore/qpair.h"
 #include "QtCore/qcoreapplication.h"
 #include "private/qobject_p.h"
 
@@ -114,11 +116,75 @@ public:
 
     QMutex mutex;
 
+    // the meta calls of batched connections, most recent first; they do not
+    // need the mutex and are moved into the list by sendPostedEvents()
+    QAtomicPointer<QBatchedMetaCallEvent> batchedEvents;
+
+    // the first posted event of each compressible type for each receiver,
+    // so that compressEvent() does not have to search the list
+    typedef QPair<QObject *, int> CompressionKey;
+    QHash<CompressionKey, QEvent *> compressible;
+
     inline QPostEventList()
         : QVector<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0)
     { }
 
+    // returns true if there were no batched events before
+    bool addBatchedEvent(QBatchedMetaCallEvent *ev)
+    {
+        QBatchedMetaCallEvent *head = batchedEvents.loadAcquire();
+        do {
+            ev->nextBatched = head;
+        } while (!batchedEvents.testAndSetRelease(head, ev, head));
+        return head == nullptr;
+    }
+
+    static bool isCompressibleType(int type)
+    {
+        switch (type) {
+        case QEvent::Quit:
+        case QEvent::UpdateRequest:
+        case QEvent::LayoutRequest:
+        case QEvent::Resize:
+        case QEvent::Move:
+        case QEvent::LanguageChange:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // returns the first event of the given compressible type posted to
+    // receiver and not yet delivered, or null
+    QEvent *findCompressible(QObject *receiver, int type) const
+    {
+        Q_ASSERT(isCompressibleType(type));
+        return compressible.value(CompressionKey(receiver, type));
+    }
+
+    // must be called for every event taken out of the list (by nulling it)
+    void forgetEvent(const QPostEvent &ev)
+    {
+        if (!ev.event || !isCompressibleType(ev.event->type()))
+            return;
+        const auto it = compressible.find(CompressionKey(ev.receiver, ev.event->type()));
+        if (it != compressible.end() && it.value() == ev.event)
+            compressible.erase(it);
+    }
+
+    void clear()
+    {
+        QVector<QPostEvent>::clear();
+        compressible.clear();
+    }
+
     void addEvent(const QPostEvent &ev) {
+        if (isCompressibleType(ev.event->type())) {
+            QEvent *&first = compressible[CompressionKey(ev.receiver, ev.event->type())];
+            if (!first)
+                first = ev.event;
+        }
+
         int priority = ev.priority;
         if (isEmpty() ||
             constLast().priority >= priority ||
@@ -158,6 +224,10 @@ public:
     ~QThreadPrivate();
 
     void setPriority(QThread::Priority prio);
+    bool applyCpuAffinity();
+
+    static int numaNodeCount();
+    static QVector<int> numaNodeCpus(int node);
 
     mutable QMutex mutex;
     QAtomicInt quitLockRef;
@@ -172,6 +242,7 @@ public:
 
     uint stackSize;
     QThread::Priority priority;
+    QVector<int> cpuAffinity;
 
     static QThread *threadForId(int id);
 
@@ -251,7 +322,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.batchedEvents.load();
     }
 
     // This class provides per-thread (by way of being a QThreadData
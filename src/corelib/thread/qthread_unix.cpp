@@ -105,6 +105,10 @@
 # define SCHED_IDLE    5
 #endif
 
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID) && !defined(QT_LINUXBASE) && defined(CPU_SETSIZE)
+#define QT_HAS_THREAD_AFFINITY
+#endif
+
 #if defined(Q_OS_DARWIN) || !defined(Q_OS_ANDROID) && !defined(Q_OS_OPENBSD) && defined(_POSIX_THREAD_PRIORITY_SCHEDULING) && (_POSIX_THREAD_PRIORITY_SCHEDULING-0 >= 0)
 #define QT_HAS_THREAD_PRIORITY_SCHEDULING
 #endif
@@ -704,6 +708,9 @@ void QThread::start(Priority priority)
         d->running = false;
         d->finished = false;
         d->data->threadId.store(nullptr);
+    } else if (!d->cpuAffinity.isEmpty()) {
+        // the new thread blocks on d->mutex before it calls run()
+        d->applyCpuAffinity();
     }
 }
 
@@ -803,6 +810,94 @@ void QThreadPrivate::setPriority(QThread::Priority threadPriority)
 #endif
 }
 
+// Caller must lock the mutex
+bool QThreadPrivate::applyCpuAffinity()
+{
+#ifdef QT_HAS_THREAD_AFFINITY
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpuAffinity.isEmpty()) {
+        // no restriction; the kernel masks out what the process may not use
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &set);
+    } else {
+        for (int cpu : qAsConst(cpuAffinity)) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        }
+    }
+
+    int code = pthread_setaffinity_np(from_HANDLE<pthread_t>(data->threadId.load()), sizeof(set), &set);
+    if (code) {
+        qWarning("QThread::setCpuAffinity: Failed to set CPU affinity: %s", qPrintable(qt_error_string(code)));
+        return false;
+    }
+    return true;
+#else
+    if (cpuAffinity.isEmpty())
+        return true;
+    qWarning("QThread::setCpuAffinity: Not supported on this platform");
+    return false;
+#endif
+}
+
+#ifdef Q_OS_LINUX
+static QByteArray readNumaNodeFile(int node, const char *name)
+{
+    const QByteArray path = "/sys/devices/system/node/node" + QByteArray::number(node) + '/' + name;
+    int fd = qt_safe_open(path.constData(), O_RDONLY);
+    if (fd == -1)
+        return QByteArray();
+
+    char buffer[4096];
+    qint64 len = qt_safe_read(fd, buffer, sizeof buffer - 1);
+    qt_safe_close(fd);
+    return len > 0 ? QByteArray(buffer, int(len)).trimmed() : QByteArray();
+}
+#endif
+
+int QThreadPrivate::numaNodeCount()
+{
+#ifdef Q_OS_LINUX
+    int count = 0;
+    while (QT_ACCESS(QByteArray("/sys/devices/system/node/node" + QByteArray::number(count)).constData(), F_OK) == 0)
+        ++count;
+    return qMax(count, 1);
+#else
+    return 1;
+#endif
+}
+
+QVector<int> QThreadPrivate::numaNodeCpus(int node)
+{
+    QVector<int> cpus;
+#ifdef Q_OS_LINUX
+    // the list has the form "0-3,8-11"
+    const QByteArray list = readNumaNodeFile(node, "cpulist");
+    for (const QByteArray &range : list.split(',')) {
+        if (range.isEmpty())
+            continue;
+        const int dash = range.indexOf('-');
+        bool ok1, ok2 = true;
+        const int first = (dash < 0 ? range : range.left(dash)).toInt(&ok1);
+        const int last = dash < 0 ? first : range.mid(dash + 1).toInt(&ok2);
+        if (!ok1 || !ok2)
+            return QVector<int>();
+        for (int cpu = first; cpu <= last; ++cpu)
+            cpus.append(cpu);
+    }
+    if (!cpus.isEmpty() || node != 0)
+        return cpus;
+#endif
+    if (node == 0) {
+        // no NUMA information: node 0 holds every processor
+        const int count = QThread::idealThreadCount();
+        for (int cpu = 0; cpu < count; ++cpu)
+            cpus.append(cpu);
+    }
+    return cpus;
+}
+
 #endif // QT_NO_THREAD
 
 QT_END_NAMESPACE
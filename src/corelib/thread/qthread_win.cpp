@@ -559,6 +559,9 @@ void QThread::start(Priority priority)
         qErrnoWarning("QThread::start: Failed to set thread priority");
     }
 
+    if (!d->cpuAffinity.isEmpty())
+        d->applyCpuAffinity();
+
     if (ResumeThread(d->handle) == (DWORD) -1) {
         qErrnoWarning("QThread::start: Failed to resume new thread");
     }
@@ -698,5 +701,68 @@ void QThreadPrivate::setPriority(QThread::Priority threadPriority)
     }
 }
 
+// Caller must lock the mutex
+bool QThreadPrivate::applyCpuAffinity()
+{
+#ifndef Q_OS_WINRT
+    DWORD_PTR mask = 0;
+    if (cpuAffinity.isEmpty()) {
+        DWORD_PTR systemMask;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask)) {
+            qErrnoWarning("QThread::setCpuAffinity: Failed to get process affinity");
+            return false;
+        }
+    } else {
+        for (int cpu : qAsConst(cpuAffinity)) {
+            if (cpu >= 0 && cpu < int(sizeof(DWORD_PTR) * 8))
+                mask |= DWORD_PTR(1) << cpu;
+        }
+    }
+
+    if (!SetThreadAffinityMask(handle, mask)) {
+        qErrnoWarning("QThread::setCpuAffinity: Failed to set CPU affinity");
+        return false;
+    }
+    return true;
+#else
+    if (cpuAffinity.isEmpty())
+        return true;
+    qWarning("QThread::setCpuAffinity: Not supported on this platform");
+    return false;
+#endif
+}
+
+int QThreadPrivate::numaNodeCount()
+{
+#ifndef Q_OS_WINRT
+    ULONG highestNode;
+    if (GetNumaHighestNodeNumber(&highestNode))
+        return int(highestNode) + 1;
+#endif
+    return 1;
+}
+
+QVector<int> QThreadPrivate::numaNodeCpus(int node)
+{
+    QVector<int> cpus;
+#ifndef Q_OS_WINRT
+    ULONGLONG mask;
+    if (node >= 0 && node <= 0xff && GetNumaNodeProcessorMask(UCHAR(node), &mask)) {
+        for (int cpu = 0; cpu < int(sizeof(DWORD_PTR) * 8); ++cpu) {
+            if (mask & (ULONGLONG(1) << cpu))
+                cpus.append(cpu);
+        }
+        return cpus;
+    }
+#endif
+    if (node == 0) {
+        // no NUMA information: node 0 holds every processor
+        const int count = QThread::idealThreadCount();
+        for (int cpu = 0; cpu < count; ++cpu)
+            cpus.append(cpu);
+    }
+    return cpus;
+}
+
 QT_END_NAMESPACE
 #endif // QT_NO_THREAD
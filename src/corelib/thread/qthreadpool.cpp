@@ -39,7 +39,9 @@
 
 #include "qthreadpool.h"
 #include "qthreadpool_p.h"
+#include "qthread_p.h"
 #include "qelapsedtimer.h"
+#include <private/qtcore_tracepoints_p.h>
 
 #include <algorithm>
 
@@ -59,11 +61,23 @@ public:
     void run() Q_DECL_OVERRIDE;
     void registerThreadInactive();
 
+    QRunnable *takeLocalTask();
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // runnables started from this thread while work stealing is enabled;
+    // the thread itself takes from the back, other threads steal from the front
+    QMutex localMutex;
+    QQueue<QRunnable *> localQueue;
+    QAtomicInt localCount; // localQueue.count(), readable without localMutex
 };
 
+#if defined(Q_COMPILER_THREAD_LOCAL)
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+#endif
+
 /*
     QThreadPool private class.
 */
@@ -83,6 +97,9 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+#if defined(Q_COMPILER_THREAD_LOCAL)
+    currentPoolThread = this;
+#endif
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -90,28 +107,31 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                const bool autoDelete = r->autoDelete();
-
-
-                // run the task
+                // run the task, followed by the ones it started locally
                 locker.unlock();
+                do {
+                    const bool autoDelete = r->autoDelete();
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        Q_TRACE(QThreadPool_runTask_entry, r);
+                        r->run();
+                        Q_TRACE(QThreadPool_runTask_exit, r);
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
-                locker.relock();
 
-                if (autoDelete && !--r->ref)
-                    delete r;
+                    if (autoDelete && !--r->ref)
+                        delete r;
+                } while ((r = takeLocalTask()) != nullptr);
+                locker.relock();
             }
 
             // if too many threads are active, expire this thread
@@ -119,8 +139,11 @@ void QThreadPoolThread::run()
                 break;
 
             if (manager->queue.isEmpty()) {
-                r = nullptr;
-                break;
+                // nothing queued globally, help the other threads instead
+                r = manager->stealTask(this);
+                if (!r)
+                    break;
+                continue;
             }
 
             QueuePage *page = manager->queue.first();
@@ -141,12 +164,15 @@ void QThreadPoolThread::run()
         bool expired = manager->tooManyThreadsActive();
         if (!expired) {
             manager->waitingThreads.enqueue(this);
+            manager->waitingThreadCount.ref();
             registerThreadInactive();
             // wait for work, exiting after the expiry timeout is reached
             runnableReady.wait(locker.mutex(), manager->expiryTimeout);
             ++manager->activeThreads;
-            if (manager->waitingThreads.removeOne(this))
+            if (manager->waitingThreads.removeOne(this)) {
+                manager->waitingThreadCount.deref();
                 expired = true;
+            }
         }
         if (expired) {
             manager->expiredThreads.enqueue(this);
@@ -162,6 +188,23 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+/*
+    \internal
+    Takes the most recently started local runnable, if any, without
+    locking the pool.
+*/
+QRunnable *QThreadPoolThread::takeLocalTask()
+{
+    if (localCount.load() == 0)
+        return nullptr;
+
+    QMutexLocker locker(&localMutex);
+    if (localQueue.isEmpty())
+        return nullptr;
+    localCount.deref();
+    return localQueue.takeLast();
+}
+
 
 /*
     \internal
@@ -186,6 +229,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         // recycle an available thread
         enqueueTask(task);
         waitingThreads.takeFirst()->runnableReady.wakeOne();
+        waitingThreadCount.deref();
         return true;
     }
 
@@ -216,6 +260,7 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    Q_TRACE(QThreadPool_enqueueTask, runnable, priority);
     if (runnable->autoDelete())
         ++runnable->ref;
 
@@ -254,6 +299,60 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
     }
 }
 
+/*!
+    \internal
+    Queues \a runnable on the calling pool thread instead of the shared
+    queue, if work stealing is enabled. The pool mutex is only taken when
+    an idle thread could pick the runnable up right away. Must be called
+    without holding the pool mutex. Returns \c false if the calling thread
+    is not one of this pool's threads.
+*/
+bool QThreadPoolPrivate::startLocal(QRunnable *runnable)
+{
+#if defined(Q_COMPILER_THREAD_LOCAL)
+    QThreadPoolThread *self = currentPoolThread;
+    if (!self || self->manager != this || !workStealing.load())
+        return false;
+
+    if (self->localCount.load() == 0 || waitingThreadCount.load() > 0) {
+        QMutexLocker locker(&mutex);
+        if (tryStart(runnable))
+            return true;
+    }
+
+    if (runnable->autoDelete())
+        ++runnable->ref;
+
+    QMutexLocker locker(&self->localMutex);
+    self->localQueue.append(runnable);
+    self->localCount.ref();
+    return true;
+#else
+    Q_UNUSED(runnable);
+    return false;
+#endif
+}
+
+/*!
+    \internal
+    Takes the oldest runnable queued locally by any thread other than
+    \a thief. Called with the pool mutex held.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        if (thread == thief || thread->localCount.load() == 0)
+            continue;
+
+        QMutexLocker locker(&thread->localMutex);
+        if (!thread->localQueue.isEmpty()) {
+            thread->localCount.deref();
+            return thread->localQueue.takeFirst();
+        }
+    }
+    return nullptr;
+}
+
 bool QThreadPoolPrivate::tooManyThreadsActive() const
 {
     const int activeThreadCount = this->activeThreadCount();
@@ -275,9 +374,31 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
     if (runnable->autoDelete())
         ++runnable->ref;
     thread->runnable = runnable;
+    applyThreadAffinity(thread.data());
     thread.take()->start();
 }
 
+/*!
+    \internal
+    Sets the CPU affinity of a new pool thread according to affinityPolicy.
+*/
+void QThreadPoolPrivate::applyThreadAffinity(QThread *thread)
+{
+    switch (affinityPolicy) {
+    case QThreadPool::NoAffinity:
+        break;
+    case QThreadPool::SharedCpuAffinity:
+        thread->setCpuAffinity(cpuAffinity);
+        break;
+    case QThreadPool::OneCpuPerThread: {
+        int count = cpuAffinity.isEmpty() ? QThread::idealThreadCount() : cpuAffinity.count();
+        int index = nextAffinityCpu++ % count;
+        thread->setCpuAffinity(QVector<int>(1, cpuAffinity.isEmpty() ? index : cpuAffinity.at(index)));
+        break;
+    }
+    }
+}
+
 /*!
     \internal
     Makes all threads exit, waits for each thread to exit and deletes it.
@@ -304,6 +425,7 @@ void QThreadPoolPrivate::reset()
     }
 
     waitingThreads.clear();
+    waitingThreadCount.store(0);
     expiredThreads.clear();
 
     isExiting = false;
@@ -338,6 +460,16 @@ void QThreadPoolPrivate::clear()
     }
     qDeleteAll(queue);
     queue.clear();
+
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        for (QRunnable *r : qAsConst(thread->localQueue)) {
+            if (r->autoDelete() && !--r->ref)
+                delete r;
+        }
+        thread->localQueue.clear();
+        thread->localCount.store(0);
+    }
 }
 
 /*!
@@ -377,6 +509,16 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                 return true;
             }
         }
+
+        for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+            QMutexLocker localLocker(&thread->localMutex);
+            if (thread->localQueue.removeOne(runnable)) {
+                thread->localCount.deref();
+                if (runnable->autoDelete())
+                    --runnable->ref; // undo ++ref in start()
+                return true;
+            }
+        }
     }
 
     return false;
@@ -493,6 +635,10 @@ QThreadPool *QThreadPool::globalInstance()
     ownership of \a runnable remains with the caller. Note that
     changing the auto-deletion on \a runnable after calling this
     functions results in undefined behavior.
+
+    If \l workStealingEnabled is \c true and this function is called from
+    one of this pool's threads while all threads are busy, \a runnable is
+    queued on the calling thread instead, and \a priority is ignored.
 */
 void QThreadPool::start(QRunnable *runnable, int priority)
 {
@@ -500,12 +646,17 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->startLocal(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
     if (!d->tryStart(runnable)) {
         d->enqueueTask(runnable, priority);
 
-        if (!d->waitingThreads.isEmpty())
+        if (!d->waitingThreads.isEmpty()) {
             d->waitingThreads.takeFirst()->runnableReady.wakeOne();
+            d->waitingThreadCount.deref();
+        }
     }
 }
 
@@ -659,6 +810,171 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+
+    This property holds whether runnables started from within the pool's own
+    threads are queued on the starting thread.
+
+    By default, every call to start() goes through one queue shared by all
+    threads of the pool. When work stealing is enabled, a runnable started
+    from one of this pool's threads while no other thread is available is
+    kept in a queue owned by the starting thread. That thread runs the most
+    recently queued runnable as soon as its current one returns, without
+    locking the shared queue, while idle threads take the oldest runnables
+    from the other threads' queues. This reduces lock contention for
+    workloads that split into many small runnables from inside the pool.
+
+    Runnables started from other threads still go through the shared
+    queue. Priorities are not taken into account for locally queued
+    runnables.
+
+    The default value is \c false.
+
+    \since 5.11
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.store(enabled);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load();
+}
+
+/*!
+    \enum QThreadPool::ThreadAffinityPolicy
+    \since 5.11
+
+    This enum describes how the thread pool sets the CPU affinity of the
+    threads it creates.
+
+    \value NoAffinity The threads may run on any processor. This is the
+        default.
+    \value SharedCpuAffinity Every thread is restricted to all processors
+        in cpuAffinity().
+    \value OneCpuPerThread Each thread is pinned to a single processor.
+        The processors in cpuAffinity() are handed out in turn as threads
+        are created; if cpuAffinity() is empty, processors 0 to
+        QThread::idealThreadCount() - 1 are used.
+
+    \sa QThread::setCpuAffinity()
+*/
+
+/*! \property QThreadPool::threadAffinityPolicy
+    \since 5.11
+
+    This property holds how the CPU affinity of the pool's threads is set.
+
+    Like stackSize, the value is only used when the thread pool creates new
+    threads. Changing it has no effect for already created threads.
+
+    The default value is NoAffinity.
+
+    \sa setCpuAffinity(), setNumaNode()
+*/
+void QThreadPool::setThreadAffinityPolicy(ThreadAffinityPolicy policy)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->affinityPolicy = policy;
+}
+
+QThreadPool::ThreadAffinityPolicy QThreadPool::threadAffinityPolicy() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->affinityPolicy;
+}
+
+/*!
+    \since 5.11
+
+    Sets the processors used by threadAffinityPolicy() to \a cpus.
+    Like threadAffinityPolicy, this only affects threads created after
+    the call.
+
+    \sa cpuAffinity(), setNumaNode()
+*/
+void QThreadPool::setCpuAffinity(const QVector<int> &cpus)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    d->nextAffinityCpu = 0;
+}
+
+/*!
+    \since 5.11
+
+    Returns the processors set with setCpuAffinity().
+
+    \sa setCpuAffinity()
+*/
+QVector<int> QThreadPool::cpuAffinity() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
+/*!
+    \since 5.11
+
+    Restricts the threads this pool creates from now on to the processors
+    of NUMA node \a node, so that runnables stay close to the memory
+    allocated by that node. If the threadAffinityPolicy is NoAffinity, it
+    is changed to SharedCpuAffinity.
+
+    A pool bound to a node can be passed to QtConcurrent::run() to keep
+    that work on the node.
+
+    \sa numaNodeCount(), numaNodeCpus(), setCpuAffinity()
+*/
+void QThreadPool::setNumaNode(int node)
+{
+    const QVector<int> cpus = numaNodeCpus(node);
+    if (cpus.isEmpty()) {
+        qWarning("QThreadPool::setNumaNode: No processors found for node %d", node);
+        return;
+    }
+
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    d->nextAffinityCpu = 0;
+    if (d->affinityPolicy == NoAffinity)
+        d->affinityPolicy = SharedCpuAffinity;
+}
+
+/*!
+    \since 5.11
+
+    Returns the number of NUMA nodes of the system. Systems without NUMA
+    information are reported as having a single node.
+
+    \sa numaNodeCpus()
+*/
+int QThreadPool::numaNodeCount()
+{
+    return QThreadPrivate::numaNodeCount();
+}
+
+/*!
+    \since 5.11
+
+    Returns the processors belonging to NUMA node \a node, or an empty list
+    if there is no such node.
+
+    \sa numaNodeCount(), setNumaNode()
+*/
+QVector<int> QThreadPool::numaNodeCpus(int node)
+{
+    return QThreadPrivate::numaNodeCpus(node);
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
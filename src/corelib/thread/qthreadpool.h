@@ -59,9 +59,18 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
+    Q_PROPERTY(bool workStealingEnabled READ isWorkStealingEnabled WRITE setWorkStealingEnabled)
+    Q_PROPERTY(ThreadAffinityPolicy threadAffinityPolicy READ threadAffinityPolicy WRITE setThreadAffinityPolicy)
     friend class QFutureInterfaceBase;
 
 public:
+    enum ThreadAffinityPolicy {
+        NoAffinity,
+        SharedCpuAffinity,
+        OneCpuPerThread
+    };
+    Q_ENUM(ThreadAffinityPolicy)
+
     QThreadPool(QObject *parent = Q_NULLPTR);
     ~QThreadPool();
 
@@ -81,6 +90,19 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setWorkStealingEnabled(bool enabled);
+    bool isWorkStealingEnabled() const;
+
+    void setThreadAffinityPolicy(ThreadAffinityPolicy policy);
+    ThreadAffinityPolicy threadAffinityPolicy() const;
+
+    void setCpuAffinity(const QVector<int> &cpus);
+    QVector<int> cpuAffinity() const;
+
+    void setNumaNode(int node);
+    static int numaNodeCount();
+    static QVector<int> numaNodeCpus(int node);
+
     void reserveThread();
     void releaseThread();
 
@@ -54,6 +54,7 @@
 
 #include "QtCore/qmutex.h"
 #include "QtCore/qthread.h"
+#include "QtCore/qthreadpool.h"
 #include "QtCore/qwaitcondition.h"
 #include "QtCore/qset.h"
 #include "QtCore/qqueue.h"
@@ -161,16 +162,21 @@ public:
     bool tooManyThreadsActive() const;
 
     void startThread(QRunnable *runnable = 0);
+    void applyThreadAffinity(QThread *thread);
     void reset();
     bool waitForDone(int msecs);
     void clear();
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    bool startLocal(QRunnable *runnable);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+
     mutable QMutex mutex;
     QList<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
     QQueue<QThreadPoolThread *> expiredThreads;
+    QAtomicInt waitingThreadCount; // mirrors waitingThreads.count(), readable without the mutex
     QVector<QueuePage*> queue;
     QWaitCondition noActiveThreads;
 
@@ -179,6 +185,10 @@ public:
     int reservedThreads = 0;
     int activeThreads = 0;
     uint stackSize = 0;
+    QAtomicInt workStealing; // bool
+    QThreadPool::ThreadAffinityPolicy affinityPolicy = QThreadPool::NoAffinity;
+    QVector<int> cpuAffinity;
+    int nextAffinityCpu = 0;
     bool isExiting = false;
 };
 
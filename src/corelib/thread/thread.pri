@@ -4,6 +4,7 @@
 HEADERS += thread/qmutex.h \
            thread/qrunnable.h \
            thread/qreadwritelock.h \
+           thread/qconcurrentqueue.h \
            thread/qsemaphore.h \
            thread/qthread.h \
            thread/qthreadpool.h \
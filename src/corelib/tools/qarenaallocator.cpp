@@ -0,0 +1,378 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qarenaallocator.h"
+#include "qarenaallocator_p.h"
+
+#include <qalgorithms.h>
+#include <qmutex.h>
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QArenaAllocator
+    \inmodule QtCore
+    \since 5.11
+    \brief The QArenaAllocator class provides a monotonic memory arena for
+    the containers of Qt.
+
+    \ingroup tools
+    \reentrant
+
+    Code that builds many temporary containers and then discards all of
+    them at once, such as the handler of a request, spends much of its time
+    in malloc() and free(). While a QArenaAllocatorScope is active in a
+    thread, the memory that QVector, QString, QByteArray, QHash and QMap
+    allocate in that thread is instead taken from the blocks of a
+    QArenaAllocator, by simply bumping a pointer. Freeing such memory does
+    nothing; all of it is returned at once when the allocator is destroyed
+    or release() is called.
+
+    \code
+    QArenaAllocator arena;
+    {
+        QArenaAllocatorScope scope(&arena);
+        QHash<QString, QVector<int> > index;
+        parseRequest(&index);
+        sendReply(index);
+    } // index is destroyed before the arena
+    \endcode
+
+    Since the containers of Qt have no allocator parameter, the allocator
+    applies to all the allocations made by them in the thread while the
+    scope is active, including those of containers created before it and
+    those made inside of Qt. Memory from the arena must not be used after
+    the allocator was released, so all the containers holding it must be
+    destroyed before that; containers that may outlive the arena must be
+    created outside of the scope, or inside a nested scope for a null
+    allocator.
+
+    Memory from the arena can be freed from any thread, but a
+    QArenaAllocator allocates only for the thread of the scope it is active
+    in, and must not be active in more than one thread at a time.
+
+    \note On compilers without support for \c thread_local, scopes have no
+    effect and all memory is allocated on the heap.
+
+    \sa QArenaAllocatorScope
+*/
+
+/*!
+    \class QArenaAllocatorScope
+    \inmodule QtCore
+    \since 5.11
+    \brief The QArenaAllocatorScope class makes a QArenaAllocator current
+    in a thread.
+
+    \ingroup tools
+
+    A QArenaAllocatorScope makes the allocator passed to its constructor
+    the current allocator of the calling thread, until it is destroyed.
+    Scopes can be nested; the innermost one applies. A scope for a null
+    allocator suspends the use of arenas.
+
+    \sa QArenaAllocator
+*/
+
+/*!
+    \enum QArenaAllocator::anonymous
+    \internal
+*/
+
+#if defined(Q_COMPILER_THREAD_LOCAL)
+static thread_local QArenaAllocator *currentAllocator = nullptr;
+#endif
+
+namespace {
+// All the blocks of all allocators, sorted by address, to tell whether
+// memory handed to the deallocation functions came from an arena.
+struct BlockRegistry
+{
+    QBasicMutex mutex;
+    std::vector<QArenaAllocatorPrivate::Block> blocks;
+};
+
+inline bool beginsBefore(const QArenaAllocatorPrivate::Block &block, const char *ptr)
+{
+    return block.begin < ptr;
+}
+}
+
+Q_GLOBAL_STATIC(BlockRegistry, blockRegistry)
+
+QBasicAtomicInt QArenaAllocatorPrivate::liveBlocks = Q_BASIC_ATOMIC_INITIALIZER(0);
+QBasicAtomicInt QArenaAllocatorPrivate::activeScopes = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+QArenaAllocatorPrivate::QArenaAllocatorPrivate(int size)
+    : initialBlockSize(qMax(size, 1024)), position(0), limit(0), lastAllocation(0), reserved(0)
+{
+}
+
+static inline char *alignedPosition(char *ptr, size_t alignment)
+{
+    return reinterpret_cast<char *>((quintptr(ptr) + alignment - 1) & ~quintptr(alignment - 1));
+}
+
+bool QArenaAllocatorPrivate::addBlock(size_t size)
+{
+    BlockRegistry *registry = blockRegistry();
+    if (!registry)
+        return false;
+    char *memory = static_cast<char *>(::malloc(size));
+    if (!memory)
+        return false;
+
+    const Block block = { memory, memory + size };
+    QT_TRY {
+        blocks.push_back(block);
+        QMutexLocker locker(&registry->mutex);
+        registry->blocks.insert(std::lower_bound(registry->blocks.begin(), registry->blocks.end(),
+                                                         memory, beginsBefore),
+                                block);
+    } QT_CATCH(...) {
+        if (!blocks.empty() && blocks.back().begin == memory)
+            blocks.pop_back();
+        ::free(memory);
+        return false;
+    }
+    liveBlocks.ref();
+    reserved += size;
+    return true;
+}
+
+void *QArenaAllocatorPrivate::allocateInBlock(size_t size, size_t alignment)
+{
+    Q_ASSERT(alignment && !(alignment & (alignment - 1)));
+    char *ptr = alignedPosition(position, alignment);
+    if (!position || ptr > limit || size > size_t(limit - ptr)) {
+        // successive blocks get larger, up to 32 times the initial size
+        const size_t blockSize = size_t(initialBlockSize) << qMin<size_t>(blocks.size(), 5);
+        if (size + alignment > blockSize / 2) {
+            // a large allocation gets a block of its own, so that the free
+            // space of the current block is not lost
+            if (!addBlock(size + alignment))
+                return 0;
+            return alignedPosition(blocks.back().begin, alignment);
+        }
+        if (!addBlock(blockSize))
+            return 0;
+        position = blocks.back().begin;
+        limit = blocks.back().end;
+        ptr = alignedPosition(position, alignment);
+    }
+    position = ptr + size;
+    lastAllocation = ptr;
+    return ptr;
+}
+
+void *QArenaAllocatorPrivate::reallocateInBlock(void *ptr, size_t oldSize, size_t newSize,
+                                                size_t alignment)
+{
+    char *p = static_cast<char *>(ptr);
+    if (p == lastAllocation && newSize <= size_t(limit - p)) {
+        // the most recent allocation can simply grow or shrink
+        position = p + newSize;
+        return ptr;
+    }
+    void *result = allocateInBlock(newSize, alignment);
+    if (result)
+        memcpy(result, ptr, qMin(oldSize, newSize));
+    return result;
+}
+
+void QArenaAllocatorPrivate::release()
+{
+    if (blocks.empty())
+        return;
+    if (BlockRegistry *registry = blockRegistry()) {
+        QMutexLocker locker(&registry->mutex);
+        for (std::vector<Block>::const_iterator it = blocks.begin(); it != blocks.end(); ++it) {
+            std::vector<Block>::iterator entry =
+                    std::lower_bound(registry->blocks.begin(), registry->blocks.end(), it->begin, beginsBefore);
+            Q_ASSERT(entry != registry->blocks.end() && entry->begin == it->begin);
+            registry->blocks.erase(entry);
+        }
+    }
+    for (std::vector<Block>::const_iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        ::free(it->begin);
+        liveBlocks.deref();
+    }
+    blocks.clear();
+    position = limit = lastAllocation = 0;
+    reserved = 0;
+}
+
+void *QArenaAllocatorPrivate::reallocate(void *ptr, size_t oldSize, size_t newSize,
+                                         size_t alignment) Q_DECL_NOTHROW
+{
+    void *result = 0;
+    if (QArenaAllocator *allocator = QArenaAllocator::current())
+        result = allocator->d->reallocateInBlock(ptr, oldSize, newSize, alignment);
+    if (!result) {
+        result = ::malloc(newSize);
+        if (result)
+            memcpy(result, ptr, qMin(oldSize, newSize));
+    }
+    return result;
+}
+
+bool QArenaAllocatorPrivate::ownsSlow(const void *ptr) Q_DECL_NOTHROW
+{
+    BlockRegistry *registry = blockRegistry();
+    if (!registry)
+        return false;
+    const char *p = static_cast<const char *>(ptr);
+    QMutexLocker locker(&registry->mutex);
+    // the last block that begins at or before p
+    std::vector<Block>::const_iterator it =
+            std::lower_bound(registry->blocks.cbegin(), registry->blocks.cend(), p + 1, beginsBefore);
+    if (it == registry->blocks.cbegin())
+        return false;
+    --it;
+    return p >= it->begin && p < it->end;
+}
+
+/*!
+    Constructs an allocator that reserves memory in blocks of at least
+    \a blockSize bytes. No memory is reserved until the first allocation.
+*/
+QArenaAllocator::QArenaAllocator(int blockSize)
+    : d(new QArenaAllocatorPrivate(blockSize))
+{
+}
+
+/*!
+    Destroys the allocator and releases all of its memory.
+
+    \sa release()
+*/
+QArenaAllocator::~QArenaAllocator()
+{
+    Q_ASSERT_X(current() != this, "QArenaAllocator", "Destroyed while a scope was active");
+    d->release();
+    delete d;
+}
+
+/*!
+    Returns \a size bytes of memory, aligned to \a alignment bytes, which
+    must be a power of two. The memory stays valid until the allocator is
+    released.
+*/
+void *QArenaAllocator::allocate(size_t size, size_t alignment)
+{
+    void *ptr = d->allocateInBlock(size, alignment);
+    Q_CHECK_PTR(ptr);
+    return ptr;
+}
+
+/*!
+    Returns all the memory of the allocator to the system. Nothing that was
+    allocated from it may be used afterwards. The allocator can then be
+    used again.
+*/
+void QArenaAllocator::release()
+{
+    d->release();
+}
+
+/*!
+    Returns the number of bytes the allocator has reserved from the heap.
+*/
+size_t QArenaAllocator::bytesReserved() const
+{
+    return d->reserved;
+}
+
+/*!
+    Returns the size of the first block that the allocator reserves. The
+    following blocks get larger.
+*/
+int QArenaAllocator::blockSize() const
+{
+    return d->initialBlockSize;
+}
+
+/*!
+    Returns the allocator that is current in the calling thread, or 0 if
+    there is none.
+
+    \sa QArenaAllocatorScope
+*/
+QArenaAllocator *QArenaAllocator::current()
+{
+#if defined(Q_COMPILER_THREAD_LOCAL)
+    return currentAllocator;
+#else
+    return 0;
+#endif
+}
+
+/*!
+    Makes \a allocator the current allocator of the calling thread. Passing
+    a null pointer stops the use of any allocator until the scope is
+    destroyed.
+*/
+QArenaAllocatorScope::QArenaAllocatorScope(QArenaAllocator *allocator)
+    : previous(QArenaAllocator::current()), reserved(0)
+{
+#if defined(Q_COMPILER_THREAD_LOCAL)
+    currentAllocator = allocator;
+    QArenaAllocatorPrivate::activeScopes.ref();
+#else
+    Q_UNUSED(allocator);
+#endif
+}
+
+/*!
+    Makes the allocator that was current when the scope was created current
+    again.
+*/
+QArenaAllocatorScope::~QArenaAllocatorScope()
+{
+#if defined(Q_COMPILER_THREAD_LOCAL)
+    QArenaAllocatorPrivate::activeScopes.deref();
+    currentAllocator = previous;
+#endif
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QARENAALLOCATOR_H
+#define QARENAALLOCATOR_H
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class QArenaAllocatorPrivate;
+
+class Q_CORE_EXPORT QArenaAllocator
+{
+public:
+    enum { DefaultBlockSize = 64 * 1024 };
+
+    explicit QArenaAllocator(int blockSize = DefaultBlockSize);
+    ~QArenaAllocator();
+
+    void *allocate(size_t size, size_t alignment = 2 * sizeof(void *));
+    void release();
+
+    size_t bytesReserved() const;
+    int blockSize() const;
+
+    static QArenaAllocator *current();
+
+private:
+    Q_DISABLE_COPY(QArenaAllocator)
+    friend class QArenaAllocatorPrivate;
+    friend class QArenaAllocatorScope;
+    QArenaAllocatorPrivate *d;
+};
+
+class Q_CORE_EXPORT QArenaAllocatorScope
+{
+public:
+    explicit QArenaAllocatorScope(QArenaAllocator *allocator);
+    ~QArenaAllocatorScope();
+
+private:
+    Q_DISABLE_COPY(QArenaAllocatorScope)
+    QArenaAllocator *previous;
+    void *reserved;
+};
+
+QT_END_NAMESPACE
+
+#endif // QARENAALLOCATOR_H
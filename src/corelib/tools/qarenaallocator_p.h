@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QARENAALLOCATOR_P_H
+#define QARENAALLOCATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qarenaallocator.h>
+#include <QtCore/qatomic.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+// The hooks used by the allocation functions of the containers. They cost
+// a relaxed load of a global counter as long as no arena is in use.
+class QArenaAllocatorPrivate
+{
+public:
+    struct Block
+    {
+        char *begin;
+        char *end;
+    };
+
+    explicit QArenaAllocatorPrivate(int size);
+
+    void *allocateInBlock(size_t size, size_t alignment);
+    void *reallocateInBlock(void *ptr, size_t oldSize, size_t newSize, size_t alignment);
+    void release();
+
+    bool addBlock(size_t size);
+
+    std::vector<Block> blocks;
+    int initialBlockSize;
+    char *position;
+    char *limit;
+    char *lastAllocation;
+    size_t reserved;
+
+#ifndef QT_BOOTSTRAPPED
+    static QBasicAtomicInt liveBlocks;
+    static QBasicAtomicInt activeScopes;
+
+    // Allocates from the allocator that is current in this thread. Returns
+    // 0 if there is none, and the caller must allocate on the heap.
+    static void *allocate(size_t size, size_t alignment) Q_DECL_NOTHROW
+    {
+        if (Q_LIKELY(!activeScopes.load()))
+            return 0;
+        QArenaAllocator *allocator = QArenaAllocator::current();
+        return allocator ? allocator->d->allocateInBlock(size, alignment) : 0;
+    }
+
+    // Resizes memory that owns() returned true for. The result comes from
+    // the current allocator, or from malloc() if there is none.
+    static void *reallocate(void *ptr, size_t oldSize, size_t newSize, size_t alignment) Q_DECL_NOTHROW;
+
+    // Returns true if \a ptr points into the blocks of any allocator, in
+    // which case it must not be passed to free().
+    static bool owns(const void *ptr) Q_DECL_NOTHROW
+    {
+        return Q_UNLIKELY(liveBlocks.load() != 0) && ownsSlow(ptr);
+    }
+
+private:
+    static bool ownsSlow(const void *ptr) Q_DECL_NOTHROW;
+#else
+    static void *allocate(size_t, size_t) Q_DECL_NOTHROW { return 0; }
+    static void *reallocate(void *, size_t, size_t, size_t) Q_DECL_NOTHROW { return 0; }
+    static bool owns(const void *) Q_DECL_NOTHROW { return false; }
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QARENAALLOCATOR_P_H
@@ -39,6 +39,7 @@
 ****************************************************************************/
 
 #include <QtCore/qarraydata.h>
+#include <QtCore/private/qarenaallocator_p.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
 
@@ -78,9 +79,13 @@ static inline size_t calculateBlockSize(size_t &capacity, size_t objectSize, siz
     }
 }
 
-static QArrayData *reallocateData(QArrayData *header, size_t allocSize, uint options)
+static QArrayData *reallocateData(QArrayData *header, size_t oldAllocSize, size_t allocSize, uint options)
 {
-    header = static_cast<QArrayData *>(::realloc(header, allocSize));
+    if (QArenaAllocatorPrivate::owns(header))
+        header = static_cast<QArrayData *>(QArenaAllocatorPrivate::reallocate(header, oldAllocSize, allocSize,
+                                                                               Q_ALIGNOF(QArrayData)));
+    else
+        header = static_cast<QArrayData *>(::realloc(header, allocSize));
     if (header)
         header->capacityReserved = bool(options & QArrayData::CapacityReserved);
     return header;
@@ -115,7 +120,9 @@ QArrayData *QArrayData::allocate(size_t objectSize, size_t alignment,
         return 0;
 
     size_t allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
-    QArrayData *header = static_cast<QArrayData *>(::malloc(allocSize));
+    QArrayData *header = static_cast<QArrayData *>(QArenaAllocatorPrivate::allocate(allocSize, Q_ALIGNOF(QArrayData)));
+    if (!header)
+        header = static_cast<QArrayData *>(::malloc(allocSize));
     if (header) {
         quintptr data = (quintptr(header) + sizeof(QArrayData) + alignment - 1)
                 & ~(alignment - 1);
@@ -142,8 +149,9 @@ QArrayData *QArrayData::reallocateUnaligned(QArrayData *data, size_t objectSize,
     Q_ASSERT(!data->ref.isShared());
 
     size_t headerSize = sizeof(QArrayData);
+    const size_t oldAllocSize = headerSize + objectSize * data->alloc;
     size_t allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
-    QArrayData *header = static_cast<QArrayData *>(reallocateData(data, allocSize, options));
+    QArrayData *header = static_cast<QArrayData *>(reallocateData(data, oldAllocSize, allocSize, options));
     if (header)
         header->alloc = capacity;
     return header;
@@ -164,6 +172,8 @@ void QArrayData::deallocate(QArrayData *data, size_t objectSize,
 
     Q_ASSERT_X(data == 0 || !data->ref.isStatic(), "QArrayData::deallocate",
                "Static data can not be deleted");
+    if (QArenaAllocatorPrivate::owns(data))
+        return;
     ::free(data);
 }
 
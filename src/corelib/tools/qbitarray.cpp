@@ -43,6 +43,7 @@
 #include <qdatastream.h>
 #include <qdebug.h>
 #include <qendian.h>
+#include <private/qsimd_p.h>
 #include <string.h>
 
 QT_BEGIN_NAMESPACE
@@ -175,15 +176,12 @@ QBitArray::QBitArray(int size, bool value)
     1-bits stored in the bit array; otherwise the number
     of 0-bits is returned.
 */
-int QBitArray::count(bool on) const
+static inline int countBits(const quint8 *bits, const quint8 *const end)
 {
     int numBits = 0;
-    const quint8 *bits = reinterpret_cast<const quint8 *>(d.data()) + 1;
 
     // the loops below will try to read from *end
     // it's the QByteArray implicit NUL, so it will not change the bit count
-    const quint8 *const end = reinterpret_cast<const quint8 *>(d.end());
-
     while (bits + 7 <= end) {
         quint64 v = qFromUnaligned<quint64>(bits);
         bits += 8;
@@ -202,9 +200,84 @@ int QBitArray::count(bool on) const
     if (bits < end)
         numBits += int(qPopulationCount(bits[0]));
 
+    return numBits;
+}
+
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SSE4_2) && !defined(QT_BOOTSTRAPPED)
+#  define QBITARRAY_RUNTIME_POPCNT
+// all processors with SSE4.2 have POPCNT, so this lets the compiler emit it for
+// qPopulationCount() instead of the portable bit twiddling
+QT_FUNCTION_TARGET(POPCNT)
+static int countBitsPopcnt(const quint8 *bits, const quint8 *const end)
+{
+    return countBits(bits, end);
+}
+#endif
+
+int QBitArray::count(bool on) const
+{
+    const quint8 *bits = reinterpret_cast<const quint8 *>(d.data()) + 1;
+    const quint8 *const end = reinterpret_cast<const quint8 *>(d.end());
+    int numBits;
+#ifdef QBITARRAY_RUNTIME_POPCNT
+    if (qCpuHasFeature(POPCNT))
+        numBits = countBitsPopcnt(bits, end);
+    else
+#endif
+        numBits = countBits(bits, end);
+
     return on ? numBits : size() - numBits;
 }
 
+/*!
+    \since 5.11
+
+    Returns the index position of the first bit that is set to \a on,
+    searching forward from index position \a from. Returns -1 if no such
+    bit is found.
+
+    If \a from is -1, the search starts at the last bit; if it is -2, at the
+    next to last bit and so on.
+
+    The search looks at 64 bits at a time, which makes it much faster than
+    calling testBit() in a loop. For example, to visit all bits that are set:
+
+    \snippet code/src_corelib_tools_qbitarray.cpp 16
+
+    \sa count(), testBit()
+*/
+int QBitArray::indexOf(bool on, int from) const
+{
+    const int n = size();
+    if (from < 0)
+        from = qMax(from + n, 0);
+    if (from >= n)
+        return -1;
+
+    const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+    const int numBytes = d.size() - 1;
+    const quint64 flip = on ? 0 : ~Q_UINT64_C(0);
+    int byte = from >> 3;
+    int found = -1;
+
+    // the bits beyond size() are 0, so they may be found when searching for
+    // a cleared bit: the bounds check at the end takes care of that
+    uint v = (bits[byte] ^ uint(flip)) & (0xffu << (from & 7)) & 0xffu;
+    if (v) {
+        found = byte * 8 + qCountTrailingZeroBits(v);
+    } else {
+        for (++byte; found == -1 && byte + 8 <= numBytes; byte += 8) {
+            if (const quint64 w = qFromLittleEndian<quint64>(bits + byte) ^ flip)
+                found = byte * 8 + qCountTrailingZeroBits(w);
+        }
+        for ( ; found == -1 && byte < numBytes; ++byte) {
+            if ((v = (bits[byte] ^ uint(flip)) & 0xffu))
+                found = byte * 8 + qCountTrailingZeroBits(v);
+        }
+    }
+    return found < n ? found : -1;
+}
+
 /*!
     Resizes the bit array to \a size bits.
 
@@ -473,6 +546,80 @@ void QBitArray::fill(bool value, int begin, int end)
     \sa operator==()
 */
 
+namespace {
+struct AndOperation
+{
+    static const bool KeepLongerTail = false;
+    quint64 operator()(quint64 a, quint64 b) const { return a & b; }
+#ifdef __SSE2__
+    __m128i operator()(__m128i a, __m128i b) const { return _mm_and_si128(a, b); }
+#endif
+};
+
+struct OrOperation
+{
+    static const bool KeepLongerTail = true;
+    quint64 operator()(quint64 a, quint64 b) const { return a | b; }
+#ifdef __SSE2__
+    __m128i operator()(__m128i a, __m128i b) const { return _mm_or_si128(a, b); }
+#endif
+};
+
+struct XorOperation
+{
+    static const bool KeepLongerTail = true;
+    quint64 operator()(quint64 a, quint64 b) const { return a ^ b; }
+#ifdef __SSE2__
+    __m128i operator()(__m128i a, __m128i b) const { return _mm_xor_si128(a, b); }
+#endif
+};
+} // unnamed namespace
+
+// dst[i] = op(src1[i], src2[i]) for \a n bytes; dst may be the same as src1
+template <typename Operation>
+static void bitwiseOperation(uchar *dst, const uchar *src1, const uchar *src2, int n, Operation op)
+{
+    int i = 0;
+#ifdef __SSE2__
+    for ( ; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), op(a, b));
+    }
+#endif
+    for ( ; i + 8 <= n; i += 8)
+        qToUnaligned(op(qFromUnaligned<quint64>(src1 + i), qFromUnaligned<quint64>(src2 + i)), dst + i);
+    for ( ; i < n; ++i)
+        dst[i] = uchar(op(quint64(src1[i]), quint64(src2[i])));
+}
+
+// Returns the result of applying \a op to the bits of \a d1 and \a d2 in one pass,
+// without first copying one of the operands
+template <typename Operation>
+static QByteArray bitwiseOperation(const QByteArray &d1, const QByteArray &d2, Operation op)
+{
+    // the bit array with more bits determines the size of the result (and
+    // has at least as many bytes)
+    const bool firstIsLonger = (d1.size() << 3) - *d1.constData() >= (d2.size() << 3) - *d2.constData();
+    const QByteArray &longer = firstIsLonger ? d1 : d2;
+    const QByteArray &shorter = firstIsLonger ? d2 : d1;
+    if (longer.isEmpty())
+        return longer;
+
+    QByteArray result(longer.size(), Qt::Uninitialized);
+    uchar *dst = reinterpret_cast<uchar *>(result.data());
+    const uchar *src1 = reinterpret_cast<const uchar *>(longer.constData());
+    const uchar *src2 = reinterpret_cast<const uchar *>(shorter.constData());
+    const int n = qMax(shorter.size() - 1, 0);
+    dst[0] = src1[0];
+    bitwiseOperation(dst + 1, src1 + 1, src2 + 1, n, op);
+    if (Operation::KeepLongerTail)
+        memcpy(dst + 1 + n, src1 + 1 + n, longer.size() - 1 - n);
+    else
+        memset(dst + 1 + n, 0, longer.size() - 1 - n);
+    return result;
+}
+
 /*!
     Performs the AND operation between all bits in this bit array and
     \a other. Assigns the result to this bit array, and returns a
@@ -493,12 +640,10 @@ QBitArray &QBitArray::operator&=(const QBitArray &other)
     resize(qMax(size(), other.size()));
     uchar *a1 = reinterpret_cast<uchar*>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar*>(other.d.constData()) + 1;
-    int n = other.d.size() -1 ;
-    int p = d.size() - 1 - n;
-    while (n-- > 0)
-        *a1++ &= *a2++;
-    while (p-- > 0)
-        *a1++ = 0;
+    const int n = qMax(other.d.size() - 1, 0);
+    bitwiseOperation(a1, a1, a2, n, AndOperation());
+    if (d.size() - 1 > n)
+        memset(a1 + n, 0, d.size() - 1 - n);
     return *this;
 }
 
@@ -522,9 +667,7 @@ QBitArray &QBitArray::operator|=(const QBitArray &other)
     resize(qMax(size(), other.size()));
     uchar *a1 = reinterpret_cast<uchar*>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    int n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ |= *a2++;
+    bitwiseOperation(a1, a1, a2, qMax(other.d.size() - 1, 0), OrOperation());
     return *this;
 }
 
@@ -548,9 +691,7 @@ QBitArray &QBitArray::operator^=(const QBitArray &other)
     resize(qMax(size(), other.size()));
     uchar *a1 = reinterpret_cast<uchar*>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    int n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ ^= *a2++;
+    bitwiseOperation(a1, a1, a2, qMax(other.d.size() - 1, 0), XorOperation());
     return *this;
 }
 
@@ -598,8 +739,8 @@ QBitArray QBitArray::operator~() const
 
 QBitArray operator&(const QBitArray &a1, const QBitArray &a2)
 {
-    QBitArray tmp = a1;
-    tmp &= a2;
+    QBitArray tmp;
+    tmp.d = bitwiseOperation(a1.d, a2.d, AndOperation());
     return tmp;
 }
 
@@ -621,8 +762,8 @@ QBitArray operator&(const QBitArray &a1, const QBitArray &a2)
 
 QBitArray operator|(const QBitArray &a1, const QBitArray &a2)
 {
-    QBitArray tmp = a1;
-    tmp |= a2;
+    QBitArray tmp;
+    tmp.d = bitwiseOperation(a1.d, a2.d, OrOperation());
     return tmp;
 }
 
@@ -644,11 +785,68 @@ QBitArray operator|(const QBitArray &a1, const QBitArray &a2)
 
 QBitArray operator^(const QBitArray &a1, const QBitArray &a2)
 {
-    QBitArray tmp = a1;
-    tmp ^= a2;
+    QBitArray tmp;
+    tmp.d = bitwiseOperation(a1.d, a2.d, XorOperation());
     return tmp;
 }
 
+#ifdef Q_COMPILER_RVALUE_REFS
+/*!
+    \relates QBitArray
+    \since 5.11
+    \overload
+
+    Returns a bit array that is the AND of the bit arrays \a a1 and \a a2.
+    If \a a1 is not shared with another bit array and is at least as long as
+    \a a2, the operation is done in place in the storage of \a a1, which is
+    then moved into the result. This lets expressions such as
+    \c{a & b & c} reuse a single buffer.
+*/
+QBitArray operator&(QBitArray &&a1, const QBitArray &a2)
+{
+    if (!a1.isDetached() || a1.size() < a2.size())
+        return static_cast<const QBitArray &>(a1) & a2;
+    a1 &= a2;
+    return std::move(a1);
+}
+
+/*!
+    \relates QBitArray
+    \since 5.11
+    \overload
+
+    Returns a bit array that is the OR of the bit arrays \a a1 and \a a2,
+    reusing the storage of \a a1 if possible.
+
+    \sa operator&(QBitArray &&, const QBitArray &)
+*/
+QBitArray operator|(QBitArray &&a1, const QBitArray &a2)
+{
+    if (!a1.isDetached() || a1.size() < a2.size())
+        return static_cast<const QBitArray &>(a1) | a2;
+    a1 |= a2;
+    return std::move(a1);
+}
+
+/*!
+    \relates QBitArray
+    \since 5.11
+    \overload
+
+    Returns a bit array that is the XOR of the bit arrays \a a1 and \a a2,
+    reusing the storage of \a a1 if possible.
+
+    \sa operator&(QBitArray &&, const QBitArray &)
+*/
+QBitArray operator^(QBitArray &&a1, const QBitArray &a2)
+{
+    if (!a1.isDetached() || a1.size() < a2.size())
+        return static_cast<const QBitArray &>(a1) ^ a2;
+    a1 ^= a2;
+    return std::move(a1);
+}
+#endif
+
 /*!
     \class QBitRef
     \inmodule QtCore
@@ -51,6 +51,9 @@ class Q_CORE_EXPORT QBitArray
     friend Q_CORE_EXPORT QDataStream &operator<<(QDataStream &, const QBitArray &);
     friend Q_CORE_EXPORT QDataStream &operator>>(QDataStream &, QBitArray &);
     friend Q_CORE_EXPORT uint qHash(const QBitArray &key, uint seed) Q_DECL_NOTHROW;
+    friend Q_CORE_EXPORT QBitArray operator&(const QBitArray &, const QBitArray &);
+    friend Q_CORE_EXPORT QBitArray operator|(const QBitArray &, const QBitArray &);
+    friend Q_CORE_EXPORT QBitArray operator^(const QBitArray &, const QBitArray &);
     QByteArray d;
 
 public:
@@ -69,6 +72,7 @@ public:
     inline int size() const { return (d.size() << 3) - *d.constData(); }
     inline int count() const { return (d.size() << 3) - *d.constData(); }
     int count(bool on) const;
+    int indexOf(bool on, int from = 0) const;
 
     inline bool isEmpty() const { return d.isEmpty(); }
     inline bool isNull() const { return d.isNull(); }
@@ -115,6 +119,11 @@ inline bool QBitArray::fill(bool aval, int asize)
 Q_CORE_EXPORT QBitArray operator&(const QBitArray &, const QBitArray &);
 Q_CORE_EXPORT QBitArray operator|(const QBitArray &, const QBitArray &);
 Q_CORE_EXPORT QBitArray operator^(const QBitArray &, const QBitArray &);
+#ifdef Q_COMPILER_RVALUE_REFS
+Q_CORE_EXPORT QBitArray operator&(QBitArray &&, const QBitArray &);
+Q_CORE_EXPORT QBitArray operator|(QBitArray &&, const QBitArray &);
+Q_CORE_EXPORT QBitArray operator^(QBitArray &&, const QBitArray &);
+#endif
 
 inline bool QBitArray::testBit(int i) const
 { Q_ASSERT(uint(i) < uint(size()));
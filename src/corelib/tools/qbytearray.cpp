@@ -50,6 +50,7 @@
 #include "qstringalgorithms_p.h"
 #include "qscopedpointer.h"
 #include "qbytearray_p.h"
+#include "private/qutfcodec_p.h"
 #include <qdatastream.h>
 #include <qmath.h>
 
@@ -2961,6 +2962,22 @@ bool QByteArray::endsWith(char ch) const
     return d->data()[d->size - 1] == ch;
 }
 
+/*!
+    \since 5.11
+
+    Returns \c true if this byte array contains valid UTF-8 encoded data,
+    or is empty; otherwise returns \c false. Overlong sequences, encoded
+    surrogates and code points above U+10FFFF are not valid.
+
+    This is much faster than decoding the data with QString::fromUtf8().
+
+    \sa QString::fromUtf8()
+*/
+bool QByteArray::isValidUtf8() const
+{
+    return QUtf8::isValidUtf8(d->data(), d->size).isValidUtf8;
+}
+
 /*!
     Returns a byte array that contains the leftmost \a len bytes of
     this byte array.
@@ -4152,7 +4169,9 @@ QByteArray &QByteArray::setNum(double n, char f, int prec)
             break;
     }
 
-    *this = QLocaleData::c()->doubleToString(n, prec, form, -1, flags).toLatin1();
+    QLocaleData::CharBuff buf;
+    QLocaleData::doubleToCLocale(&buf, n, prec, form, -1, flags);
+    *this = QByteArray(buf.constData(), buf.size());
     return *this;
 }
 
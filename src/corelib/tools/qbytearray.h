@@ -243,6 +243,8 @@ public:
 
     bool endsWith(const QByteArray &a) const;
     bool endsWith(char c) const;
+
+    bool isValidUtf8() const;
     bool endsWith(const char *c) const;
 
     void truncate(int pos);
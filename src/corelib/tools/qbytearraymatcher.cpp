@@ -39,6 +39,12 @@
 
 #include "qbytearraymatcher.h"
 
+#include "qsimd_p.h"
+#include "qvector.h"
+#include <QtCore/qiodevice.h>
+
+#include <algorithm>
+
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
@@ -52,11 +58,64 @@ static inline void bm_init_skiptable(const uchar *cc, int len, uchar *skiptable)
         skiptable[*cc++] = l;
 }
 
+#ifdef __SSE2__
+/*
+    Compares 16 candidate positions at a time against the first and the last
+    byte of the needle, and verifies with memcmp() only the positions where
+    both match. Needles rarely have both bytes matching by chance, so this
+    is faster than Boyer-Moore unless the needle is long enough for the
+    latter to skip more than 16 bytes at a time.
+*/
+enum { PrefilterMaximumNeedleLength = 32 };
+
+static int prefiltered_find(const uchar *cc, int l, int index, const uchar *puc, int pl)
+{
+    Q_ASSERT(pl >= 2);
+
+    // the last position where the needle can start
+    const int lastStart = l - pl;
+    const __m128i first = _mm_set1_epi8(char(puc[0]));
+    const __m128i last = _mm_set1_epi8(char(puc[pl - 1]));
+
+    int i = index;
+    for ( ; i + 15 <= lastStart; i += 16) {
+        const __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + i));
+        const __m128i lastBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + i + pl - 1));
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, firstBlock),
+                                                    _mm_cmpeq_epi8(last, lastBlock)));
+        while (mask) {
+            const int candidate = i + qCountTrailingZeroBits(mask);
+            if (memcmp(cc + candidate + 1, puc + 1, pl - 2) == 0)
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+
+    for ( ; i <= lastStart; ++i) {
+        if (cc[i] == puc[0] && cc[i + pl - 1] == puc[pl - 1]
+                && memcmp(cc + i + 1, puc + 1, pl - 2) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+#endif
+
 static inline int bm_find(const uchar *cc, int l, int index, const uchar *puc, uint pl,
                           const uchar *skiptable)
 {
     if (pl == 0)
         return index > l ? -1 : index;
+    if (index >= l)
+        return -1;
+    if (pl == 1) {
+        const void *found = memchr(cc + index, puc[0], l - index);
+        return found ? int(static_cast<const uchar *>(found) - cc) : -1;
+    }
+#ifdef __SSE2__
+    if (pl <= PrefilterMaximumNeedleLength)
+        return prefiltered_find(cc, l, index, puc, int(pl));
+#endif
     const uint pl_minus_one = pl - 1;
 
     const uchar *current = cc + index + pl_minus_one;
@@ -231,16 +290,12 @@ int QByteArrayMatcher::indexIn(const char *str, int len, int from) const
 
 static int findChar(const char *str, int len, char ch, int from)
 {
-    const uchar *s = (const uchar *)str;
-    uchar c = (uchar)ch;
     if (from < 0)
         from = qMax(from + len, 0);
     if (from < len) {
-        const uchar *n = s + from - 1;
-        const uchar *e = s + len;
-        while (++n != e)
-            if (*n == c)
-                return  n - s;
+        const void *found = memchr(str + from, uchar(ch), len - from);
+        if (found)
+            return static_cast<const char *>(found) - str;
     }
     return -1;
 }
@@ -286,6 +341,13 @@ int qFindByteArray(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle[0], from);
 
+#ifdef __SSE2__
+    // no table to build, so this pays off even for one-off searches
+    if (sl <= PrefilterMaximumNeedleLength)
+        return prefiltered_find(reinterpret_cast<const uchar *>(haystack0), l, from,
+                                reinterpret_cast<const uchar *>(needle), sl);
+#endif
+
     /*
       We use the Boyer-Moore algorithm in cases where the overhead
       for the skip table should pay off, otherwise we use a simple
@@ -430,5 +492,399 @@ int QStaticByteArrayMatcherBase::indexOfIn(const char *needle, uint nlen, const
     \endcode
 */
 
+/*!
+    \class QMultiByteArrayMatcher
+    \since 5.11
+    \inmodule QtCore
+    \brief The QMultiByteArrayMatcher class searches byte arrays for any of
+    a set of patterns in a single pass.
+
+    \ingroup tools
+    \ingroup string-processing
+    \reentrant
+
+    Searching some data for each of many patterns with QByteArrayMatcher
+    costs one pass over the data per pattern. QMultiByteArrayMatcher builds
+    an Aho-Corasick automaton out of all the patterns instead, and finds the
+    occurrences of any of them in a single pass, whose cost does not depend
+    on the number of patterns.
+
+    Create the matcher with the list of patterns to search for, then call
+    indexIn(). It returns the position of the first occurrence and can also
+    report which pattern was found:
+
+    \code
+    const QMultiByteArrayMatcher matcher({ "error", "warning", "fatal" });
+    int keyword;
+    int pos = matcher.indexIn(line, 0, &keyword);
+    while (pos != -1) {
+        // the keyword matcher.patterns().at(keyword) is at pos
+        pos = matcher.indexIn(line, pos + 1, &keyword);
+    }
+    \endcode
+
+    The matches are reported in the order in which they \e end: if the
+    patterns overlap in the data, the occurrence that is complete first is
+    returned, and if several patterns end at the same position, the longest
+    one is returned. That is also the order in which they are found when the
+    data is read sequentially, which allows indexIn() to search a QIODevice
+    chunk by chunk, without ever keeping more than one chunk in memory.
+
+    The automaton is built once, in the constructor or in setPatterns(); the
+    matcher is implicitly shared, so copying it is cheap.
+
+    \sa QByteArrayMatcher
+*/
+
+struct QMultiByteArrayMatcherPrivate : QSharedData
+{
+    struct State {
+        // the children are edges[firstEdge .. firstEdge + edgeCount), sorted by byte
+        int firstEdge;
+        int edgeCount;
+        // the state of the longest proper suffix of this state that is in the trie
+        int failure;
+        int depth;
+        // the longest pattern ending in this state, or -1
+        int output;
+    };
+
+    struct Edge {
+        uchar byte;
+        int target;
+    };
+
+    void build();
+    int child(int state, uchar byte) const;
+    inline int next(int state, uchar byte) const;
+    int scan(const uchar *data, int len, int *state, int *patternIndex) const;
+
+    QList<QByteArray> patterns;
+    QVector<State> states;
+    QVector<Edge> edges;
+    // most of the bytes of most data lead back to the root, so the root
+    // gets a dense table
+    int rootTransitions[256];
+    int emptyPattern;
+};
+
+/*!
+    \internal
+
+    Builds the trie of the patterns, and then the failure links and the
+    outputs with a breadth-first visit of the trie.
+*/
+void QMultiByteArrayMatcherPrivate::build()
+{
+    emptyPattern = -1;
+    std::fill(rootTransitions, rootTransitions + 256, 0);
+
+    // the trie, with one vector of (byte, target) children per state
+    QVector<QVector<Edge> > children(1);
+    QVector<int> terminals(1, -1);
+    for (int i = 0; i < patterns.size(); ++i) {
+        const QByteArray &pattern = patterns.at(i);
+        if (pattern.isEmpty()) {
+            if (emptyPattern < 0)
+                emptyPattern = i;
+            continue;
+        }
+
+        int state = 0;
+        for (char ch : pattern) {
+            const uchar byte = uchar(ch);
+            QVector<Edge> &edgeList = children[state];
+            const auto it = std::lower_bound(edgeList.begin(), edgeList.end(), byte,
+                                             [](const Edge &e, uchar b) { return e.byte < b; });
+            if (it != edgeList.end() && it->byte == byte) {
+                state = it->target;
+            } else {
+                const int target = children.size();
+                const Edge edge = { byte, target };
+                edgeList.insert(it, edge);
+                children.append(QVector<Edge>());
+                terminals.append(-1);
+                state = target;
+            }
+        }
+        // duplicates: the first one wins
+        if (terminals.at(state) < 0)
+            terminals[state] = i;
+    }
+
+    // flatten the trie
+    states.resize(children.size());
+    edges.clear();
+    for (int i = 0; i < children.size(); ++i) {
+        State &state = states[i];
+        state.firstEdge = edges.size();
+        state.edgeCount = children.at(i).size();
+        state.failure = 0;
+        state.depth = 0;
+        state.output = terminals.at(i);
+        edges += children.at(i);
+    }
+    children = QVector<QVector<Edge> >();
+
+    // breadth-first, so that the failure state of a state (always shallower)
+    // is complete before the state itself
+    QVector<int> queue;
+    queue.reserve(states.size());
+    for (int e = 0; e < states.at(0).edgeCount; ++e) {
+        const Edge &edge = edges.at(e);
+        rootTransitions[edge.byte] = edge.target;
+        states[edge.target].depth = 1;
+        queue.append(edge.target);
+    }
+    for (int head = 0; head < queue.size(); ++head) {
+        const int parent = queue.at(head);
+        const State parentState = states.at(parent);
+        for (int e = parentState.firstEdge; e < parentState.firstEdge + parentState.edgeCount; ++e) {
+            const Edge edge = edges.at(e);
+            State &state = states[edge.target];
+            state.depth = parentState.depth + 1;
+            state.failure = next(parentState.failure, edge.byte);
+            if (state.output < 0)
+                state.output = states.at(state.failure).output;
+            queue.append(edge.target);
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Returns the child of \a state for \a byte, or 0 if there is none.
+*/
+int QMultiByteArrayMatcherPrivate::child(int state, uchar byte) const
+{
+    const State &s = states.at(state);
+    const Edge *begin = edges.constData() + s.firstEdge;
+    const Edge *end = begin + s.edgeCount;
+    const Edge *it = std::lower_bound(begin, end, byte,
+                                      [](const Edge &e, uchar b) { return e.byte < b; });
+    return (it != end && it->byte == byte) ? it->target : 0;
+}
+
+/*!
+    \internal
+
+    Returns the state reached from \a state by reading \a byte.
+*/
+inline int QMultiByteArrayMatcherPrivate::next(int state, uchar byte) const
+{
+    while (state) {
+        if (const int target = child(state, byte))
+            return target;
+        state = states.at(state).failure;
+    }
+    return rootTransitions[byte];
+}
+
+/*!
+    \internal
+
+    Feeds the \a len bytes of \a data to the automaton, starting from and
+    updating \a state. Returns the index in \a data one past the end of the
+    first match and stores its pattern into \a patternIndex, or returns -1
+    if no match ends in \a data.
+*/
+int QMultiByteArrayMatcherPrivate::scan(const uchar *data, int len, int *state, int *patternIndex) const
+{
+    int current = *state;
+    for (int i = 0; i < len; ++i) {
+        current = next(current, data[i]);
+        const int output = states.at(current).output;
+        if (output >= 0) {
+            *state = current;
+            *patternIndex = output;
+            return i + 1;
+        }
+    }
+    *state = current;
+    return -1;
+}
+
+/*!
+    Constructs a matcher without patterns, which won't match anything.
+    Call setPatterns() to give it the patterns to match.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+{
+}
+
+/*!
+    Constructs a matcher that will search for any of the given \a patterns.
+    Call indexIn() to perform a search.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &patterns)
+{
+    setPatterns(patterns);
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher()
+{
+}
+
+/*!
+    Assigns \a other to this matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Sets the patterns this matcher will search for to \a patterns, and
+    builds the automaton for them. The indexes reported by indexIn() are
+    indexes in \a patterns.
+
+    An empty pattern matches everywhere.
+
+    \sa patterns()
+*/
+void QMultiByteArrayMatcher::setPatterns(const QList<QByteArray> &patterns)
+{
+    QMultiByteArrayMatcherPrivate *dd = new QMultiByteArrayMatcherPrivate;
+    dd->patterns = patterns;
+    dd->build();
+    d = dd;
+}
+
+/*!
+    Returns the patterns this matcher searches for.
+
+    \sa setPatterns()
+*/
+QList<QByteArray> QMultiByteArrayMatcher::patterns() const
+{
+    return d ? d->patterns : QList<QByteArray>();
+}
+
+/*!
+    Searches the byte array \a ba, from byte position \a from (default 0,
+    i.e. from the first byte), for any of the patterns(). Returns the
+    position where the first match starts, or -1 if no match was found. If
+    \a patternIndex is not null, the index of the pattern that matched is
+    stored into it.
+
+    See the class documentation for which occurrence is returned when
+    several patterns match.
+*/
+int QMultiByteArrayMatcher::indexIn(const QByteArray &ba, int from, int *patternIndex) const
+{
+    return indexIn(ba.constData(), ba.size(), from, patternIndex);
+}
+
+/*!
+    \overload
+
+    Searches the char string \a str, which has length \a len, from byte
+    position \a from (default 0, i.e. from the first byte), for any of the
+    patterns(). Returns the position where the first match starts, or -1 if
+    no match was found. If \a patternIndex is not null, the index of the
+    pattern that matched is stored into it.
+*/
+int QMultiByteArrayMatcher::indexIn(const char *str, int len, int from, int *patternIndex) const
+{
+    if (!d)
+        return -1;
+    if (from < 0)
+        from = 0;
+    if (from > len)
+        return -1;
+    if (d->emptyPattern >= 0) {
+        if (patternIndex)
+            *patternIndex = d->emptyPattern;
+        return from;
+    }
+
+    int state = 0;
+    int pattern = -1;
+    const int end = d->scan(reinterpret_cast<const uchar *>(str) + from, len - from, &state, &pattern);
+    if (end < 0)
+        return -1;
+    if (patternIndex)
+        *patternIndex = pattern;
+    return from + end - d->patterns.at(pattern).size();
+}
+
+/*!
+    \overload
+
+    Reads \a device, from its current position, until one of the patterns()
+    is found or no more data is available, and returns the position where
+    the match starts, relative to the position of the device when this
+    function was called. Returns -1 if no match was found. If \a
+    patternIndex is not null, the index of the pattern that matched is
+    stored into it.
+
+    After a match, the device is positioned right after the end of the
+    match, so calling this function again finds the next (non-overlapping)
+    match. Otherwise all the data that was available has been read.
+
+    The data is processed in chunks as they come from the device, without
+    copying them whenever possible (see QIODevice::peekSpan()); matches
+    spanning several chunks are found all the same. This function does not
+    wait for more data to arrive on sequential devices.
+*/
+qint64 QMultiByteArrayMatcher::indexIn(QIODevice *device, int *patternIndex) const
+{
+    if (!d || !device || !device->isReadable())
+        return -1;
+    if (d->emptyPattern >= 0) {
+        if (patternIndex)
+            *patternIndex = d->emptyPattern;
+        return 0;
+    }
+
+    enum { ChunkSize = 64 * 1024 };
+    qint64 consumed = 0;
+    int state = 0;
+    for (;;) {
+        const QByteArray chunk = device->peekSpan(ChunkSize);
+        if (chunk.isEmpty())
+            return -1;
+
+        int pattern = -1;
+        const int end = d->scan(reinterpret_cast<const uchar *>(chunk.constData()), chunk.size(),
+                                &state, &pattern);
+        if (end >= 0) {
+            device->skip(end);
+            if (patternIndex)
+                *patternIndex = pattern;
+            return consumed + end - d->patterns.at(pattern).size();
+        }
+
+        device->skip(chunk.size());
+        consumed += chunk.size();
+    }
+}
+
 
 QT_END_NAMESPACE
@@ -41,9 +41,12 @@
 #define QBYTEARRAYMATCHER_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
 
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
 
 class QByteArrayMatcherPrivate;
 
@@ -164,6 +167,36 @@ template <uint N>
 Q_DECL_RELAXED_CONSTEXPR QStaticByteArrayMatcher<N> qMakeStaticByteArrayMatcher(const char (&pattern)[N]) Q_DECL_NOTHROW
 { return QStaticByteArrayMatcher<N>(pattern); }
 
+class QMultiByteArrayMatcherPrivate;
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    QMultiByteArrayMatcher();
+    explicit QMultiByteArrayMatcher(const QList<QByteArray> &patterns);
+    QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other);
+    ~QMultiByteArrayMatcher();
+
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other);
+#ifdef Q_COMPILER_RVALUE_REFS
+    QMultiByteArrayMatcher &operator=(QMultiByteArrayMatcher &&other) Q_DECL_NOTHROW
+    { swap(other); return *this; }
+#endif
+    void swap(QMultiByteArrayMatcher &other) Q_DECL_NOTHROW { d.swap(other.d); }
+
+    void setPatterns(const QList<QByteArray> &patterns);
+    QList<QByteArray> patterns() const;
+
+    int indexIn(const QByteArray &ba, int from = 0, int *patternIndex = nullptr) const;
+    int indexIn(const char *str, int len, int from = 0, int *patternIndex = nullptr) const;
+    qint64 indexIn(QIODevice *device, int *patternIndex = nullptr) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiByteArrayMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+
 QT_END_NAMESPACE
 
 #endif // QBYTEARRAYMATCHER_H
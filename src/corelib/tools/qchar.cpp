@@ -1528,9 +1528,18 @@ uint QChar::toTitleCase(uint ucs4) Q_DECL_NOTHROW
     return convertCase_helper<QUnicodeTables::TitlecaseTraits>(ucs4);
 }
 
+// The ASCII fast paths below avoid the property lookup for the
+// characters case-insensitive searches and comparisons see the most.
+static inline uint foldCaseAscii(uint ch) Q_DECL_NOTHROW
+{
+    return ch - 'A' <= 'Z' - 'A' ? ch | 0x20 : ch;
+}
+
 static inline uint foldCase(const ushort *ch, const ushort *start)
 {
     uint ucs4 = *ch;
+    if (ucs4 < 0x80)
+        return foldCaseAscii(ucs4);
     if (QChar::isLowSurrogate(ucs4) && ch > start && QChar::isHighSurrogate(*(ch - 1)))
         ucs4 = QChar::surrogateToUcs4(*(ch - 1), ucs4);
     return convertCase_helper<QUnicodeTables::CasefoldTraits>(ucs4);
@@ -1538,6 +1547,10 @@ static inline uint foldCase(const ushort *ch, const ushort *start)
 
 static inline uint foldCase(uint ch, uint &last) Q_DECL_NOTHROW
 {
+    if (ch < 0x80) {
+        last = ch;
+        return foldCaseAscii(ch);
+    }
     uint ucs4 = ch;
     if (QChar::isLowSurrogate(ucs4) && QChar::isHighSurrogate(last))
         ucs4 = QChar::surrogateToUcs4(last, ucs4);
@@ -1547,6 +1560,8 @@ static inline uint foldCase(uint ch, uint &last) Q_DECL_NOTHROW
 
 static inline ushort foldCase(ushort ch) Q_DECL_NOTHROW
 {
+    if (ch < 0x80)
+        return ushort(foldCaseAscii(ch));
     return convertCase_helper<QUnicodeTables::CasefoldTraits>(ch);
 }
 
@@ -43,6 +43,15 @@
 #include "qstring.h"
 
 #include "qdebug.h"
+#ifndef QT_NO_THREAD
+#include "qrunnable.h"
+#include "qsemaphore.h"
+#include "qthreadpool.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -322,6 +331,135 @@ bool QCollator::ignorePunctuation() const
     string and then sort using the keys.
  */
 
+namespace {
+#ifndef QT_NO_THREAD
+// Below this many strings the sort keys are not worth handing to other threads
+enum { ParallelSortKeyThreshold = 4096 };
+
+class SortKeyTask : public QRunnable
+{
+public:
+    SortKeyTask(const QCollator &collator, const QStringList &list, int begin, int end,
+                QSemaphore *done)
+        : collator(collator), list(list), begin(begin), end(end), done(done)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        keys.reserve(end - begin);
+        for (int i = begin; i < end; ++i)
+            keys.push_back(collator.sortKey(list.at(i)));
+        done->release();
+    }
+
+    // Platform collators are not safe to share between threads, so each
+    // task gets its own, set up like the one doing the sort.
+    QCollator collator;
+    const QStringList &list;
+    const int begin;
+    const int end;
+    QSemaphore *done;
+    std::vector<QCollatorSortKey> keys;
+};
+
+QCollator cloneCollator(const QCollator &other)
+{
+    QCollator collator(other.locale());
+    collator.setCaseSensitivity(other.caseSensitivity());
+    collator.setNumericMode(other.numericMode());
+    collator.setIgnorePunctuation(other.ignorePunctuation());
+    return collator;
+}
+#endif
+
+bool isAsciiNumberList(const QStringList &list)
+{
+    for (const QString &s : list) {
+        if (!QCollatorPrivate::isAsciiNumber(s.constData(), s.size()))
+            return false;
+    }
+    return true;
+}
+} // unnamed namespace
+
+/*!
+    \since 5.11
+
+    Sorts \a list according to this collator. The sort is stable.
+
+    This is faster than passing the collator to std::sort(), because the
+    sort key of every string is computed only once, instead of collating
+    both strings for each comparison. For large lists, the sort keys are
+    computed in parallel on the global QThreadPool.
+
+    \sa sortKey()
+*/
+void QCollator::sort(QStringList &list) const
+{
+    const int size = list.size();
+    if (size < 2)
+        return;
+
+    if (d->numericMode && isAsciiNumberList(list)) {
+        std::stable_sort(list.begin(), list.end(), [](const QString &a, const QString &b) {
+            return QCollatorPrivate::compareAsciiNumbers(a.constData(), a.size(),
+                                                         b.constData(), b.size()) < 0;
+        });
+        return;
+    }
+
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(size);
+
+#ifndef QT_NO_THREAD
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int chunks = qMin(size / ParallelSortKeyThreshold, pool->maxThreadCount());
+    if (chunks > 1) {
+        QSemaphore done;
+        std::vector<std::unique_ptr<SortKeyTask>> tasks;
+        tasks.reserve(chunks);
+        for (int i = 0; i < chunks; ++i) {
+            const int begin = int(qint64(size) * i / chunks);
+            const int end = int(qint64(size) * (i + 1) / chunks);
+            tasks.emplace_back(new SortKeyTask(cloneCollator(*this), list, begin, end, &done));
+        }
+        for (int i = 1; i < chunks; ++i)
+            pool->start(tasks[i].get());
+
+        // Work on the first chunk here, and on any chunk the pool has not
+        // picked up yet, so this cannot stall when the pool is busy.
+        tasks[0]->run();
+        for (int i = 1; i < chunks; ++i) {
+            if (pool->tryTake(tasks[i].get()))
+                tasks[i]->run();
+        }
+        done.acquire(chunks);
+
+        for (const auto &task : tasks)
+            keys.insert(keys.end(), task->keys.begin(), task->keys.end());
+    } else
+#endif
+    {
+        for (const QString &s : qAsConst(list))
+            keys.push_back(sortKey(s));
+    }
+
+    std::vector<int> order(size);
+    for (int i = 0; i < size; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+        return keys[a].compare(keys[b]) < 0;
+    });
+
+    QStringList sorted;
+    sorted.reserve(size);
+    for (int i : order)
+        sorted.append(std::move(list[i]));
+    list.swap(sorted);
+}
+
 /*!
     \class QCollatorSortKey
     \inmodule QtCore
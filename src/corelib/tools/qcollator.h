@@ -118,6 +118,8 @@ public:
 
     QCollatorSortKey sortKey(const QString &string) const;
 
+    void sort(QStringList &list) const;
+
 private:
     QCollatorPrivate *d;
 
@@ -105,6 +105,9 @@ void QCollatorPrivate::cleanup()
 
 int QCollator::compare(const QChar *s1, int len1, const QChar *s2, int len2) const
 {
+    if (d->useAsciiNumberFastPath(s1, len1, s2, len2))
+        return QCollatorPrivate::compareAsciiNumbers(s1, len1, s2, len2);
+
     if (d->dirty)
         d->init();
 
@@ -112,6 +112,35 @@ public:
     void init();
     void cleanup();
 
+    // Strings made only of ASCII digits, without leading zeros, collate by
+    // their numeric value in numeric mode; no platform collator is needed.
+    static bool isAsciiNumber(const QChar *s, int len)
+    {
+        if (len == 0 || (len > 1 && s[0] == QLatin1Char('0')))
+            return false;
+        for (int i = 0; i < len; ++i) {
+            if (s[i].unicode() < '0' || s[i].unicode() > '9')
+                return false;
+        }
+        return true;
+    }
+
+    static int compareAsciiNumbers(const QChar *s1, int len1, const QChar *s2, int len2)
+    {
+        if (len1 != len2)
+            return len1 < len2 ? -1 : 1;
+        for (int i = 0; i < len1; ++i) {
+            if (s1[i] != s2[i])
+                return s1[i].unicode() < s2[i].unicode() ? -1 : 1;
+        }
+        return 0;
+    }
+
+    bool useAsciiNumberFastPath(const QChar *s1, int len1, const QChar *s2, int len2) const
+    {
+        return numericMode && isAsciiNumber(s1, len1) && isAsciiNumber(s2, len2);
+    }
+
     QCollatorPrivate()
         : ref(1),
           caseSensitivity(Qt::CaseSensitive),
@@ -53,7 +53,7 @@ void QCollatorPrivate::init()
     if (caseSensitivity != Qt::CaseSensitive)
         qWarning("Case insensitive sorting unsupported in the posix collation implementation");
     if (numericMode)
-        qWarning("Numeric mode unsupported in the posix collation implementation");
+        qWarning("Numeric mode only supports plain ASCII numbers in the posix collation implementation");
     if (ignorePunctuation)
         qWarning("Ignoring punctuation unsupported in the posix collation implementation");
     dirty = false;
@@ -73,6 +73,9 @@ static void stringToWCharArray(QVarLengthArray<wchar_t> &ret, const QString &str
 
 int QCollator::compare(const QChar *s1, int len1, const QChar *s2, int len2) const
 {
+    if (d->useAsciiNumberFastPath(s1, len1, s2, len2))
+        return QCollatorPrivate::compareAsciiNumbers(s1, len1, s2, len2);
+
     QVarLengthArray<wchar_t> array1, array2;
     stringToWCharArray(array1, QString(s1, len1));
     stringToWCharArray(array2, QString(s2, len2));
@@ -81,6 +84,10 @@ int QCollator::compare(const QChar *s1, int len1, const QChar *s2, int len2) con
 
 int QCollator::compare(const QString &s1, const QString &s2) const
 {
+    if (d->useAsciiNumberFastPath(s1.constData(), s1.size(), s2.constData(), s2.size()))
+        return QCollatorPrivate::compareAsciiNumbers(s1.constData(), s1.size(),
+                                                     s2.constData(), s2.size());
+
     QVarLengthArray<wchar_t> array1, array2;
     stringToWCharArray(array1, s1);
     stringToWCharArray(array2, s2);
@@ -103,10 +110,10 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
     QVarLengthArray<wchar_t> original;
     stringToWCharArray(original, string);
     QVector<wchar_t> result(string.size());
-    size_t size = std::wcsxfrm(result.data(), original.constData(), string.size());
-    if (size > uint(result.size())) {
+    size_t size = std::wcsxfrm(result.data(), original.constData(), result.size());
+    if (size >= uint(result.size())) {
         result.resize(size+1);
-        size = std::wcsxfrm(result.data(), original.constData(), string.size());
+        size = std::wcsxfrm(result.data(), original.constData(), result.size());
     }
     result.resize(size+1);
     result[size] = 0;
@@ -0,0 +1,333 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTCACHE_H
+#define QCONCURRENTCACHE_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qsharedpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+
+template <class Key, class T>
+class QConcurrentCache
+{
+    struct Node {
+        inline Node() : keyPtr(nullptr), c(0), p(nullptr), n(nullptr) {}
+        inline Node(const QSharedPointer<T> &data, int cost)
+            : keyPtr(nullptr), t(data), c(cost), p(nullptr), n(nullptr) {}
+        const Key *keyPtr; QSharedPointer<T> t; int c; Node *p, *n;
+        mutable QAtomicInt referenced;
+    };
+
+    // Each shard is a QHash whose nodes are also linked in a ring that the
+    // CLOCK hand walks when objects need to be evicted. A hit only sets the
+    // node's referenced flag, so lookups need no more than a read lock.
+    struct Shard {
+        inline Shard() : hand(nullptr), mx(0), total(0), insertions(0), evictions(0) {}
+        mutable QReadWriteLock lock;
+        QHash<Key, Node> hash;
+        Node *hand;
+        int mx, total;
+        mutable QAtomicInteger<qint64> hits, misses;
+        qint64 insertions, evictions;
+    };
+    Shard *shards;
+    int shardMask;
+    QAtomicInt mx;
+
+    inline Shard &shardFor(const Key &key) const {
+        uint h = qHash(key);
+        h ^= h >> 16;
+        return shards[h & uint(shardMask)];
+    }
+    static void link(Shard &s, Node *n) {
+        if (!s.hand) {
+            n->p = n->n = n;
+            s.hand = n;
+        } else {
+            // add behind the hand, so it is the last node the hand visits
+            n->n = s.hand;
+            n->p = s.hand->p;
+            s.hand->p->n = n;
+            s.hand->p = n;
+        }
+    }
+    static void unlink(Shard &s, Node &n) {
+        if (n.n == &n) {
+            s.hand = nullptr;
+        } else {
+            n.p->n = n.n;
+            n.n->p = n.p;
+            if (s.hand == &n)
+                s.hand = n.n;
+        }
+        s.total -= n.c;
+        s.hash.remove(*n.keyPtr);
+    }
+    static void trim(Shard &s, int m) {
+        // the second time the hand passes a node, its flag has been cleared,
+        // so this terminates after at most two rounds
+        while (s.hand && s.total > m) {
+            Node *n = s.hand;
+            if (n->referenced.load()) {
+                n->referenced.store(0);
+                s.hand = n->n;
+            } else {
+                unlink(s, *n);
+                ++s.evictions;
+            }
+        }
+    }
+    static QSharedPointer<T> take(Shard &s, const Key &key) {
+        typename QHash<Key, Node>::iterator i = s.hash.find(key);
+        if (i == s.hash.end())
+            return QSharedPointer<T>();
+        QSharedPointer<T> t = i->t;
+        unlink(s, *i);
+        return t;
+    }
+    void distributeMaxCost(int m);
+
+    Q_DISABLE_COPY(QConcurrentCache)
+
+public:
+    struct Statistics {
+        qint64 hits;
+        qint64 misses;
+        qint64 insertions;
+        qint64 evictions;
+    };
+
+    explicit QConcurrentCache(int maxCost = 100, int shardCount = 16);
+    inline ~QConcurrentCache() { delete [] shards; }
+
+    inline int maxCost() const { return mx.load(); }
+    void setMaxCost(int m);
+    int totalCost() const;
+
+    int size() const;
+    inline int count() const { return size(); }
+    inline bool isEmpty() const { return size() == 0; }
+    QList<Key> keys() const;
+    inline int shardCount() const { return shardMask + 1; }
+
+    void clear();
+
+    bool insert(const Key &key, const QSharedPointer<T> &object, int cost = 1);
+    inline bool insert(const Key &key, T *object, int cost = 1)
+    { return insert(key, QSharedPointer<T>(object), cost); }
+    QSharedPointer<T> object(const Key &key) const;
+    bool contains(const Key &key) const;
+    inline QSharedPointer<T> operator[](const Key &key) const { return object(key); }
+
+    bool remove(const Key &key);
+    QSharedPointer<T> take(const Key &key);
+
+    Statistics statistics() const;
+    void resetStatistics();
+};
+
+template <class Key, class T>
+QConcurrentCache<Key, T>::QConcurrentCache(int amaxCost, int ashardCount)
+    : shards(nullptr), shardMask(0), mx(amaxCost)
+{
+    int n = 1;
+    while (n < ashardCount && n < 1024)
+        n *= 2;
+    shards = new Shard[n];
+    shardMask = n - 1;
+    distributeMaxCost(amaxCost);
+}
+
+template <class Key, class T>
+void QConcurrentCache<Key, T>::distributeMaxCost(int m)
+{
+    // spread the remainder over the first shards, so the limits add up to m
+    const int n = shardCount();
+    for (int i = 0; i < n; ++i) {
+        Shard &s = shards[i];
+        QWriteLocker locker(&s.lock);
+        s.mx = m / n + (i < m % n ? 1 : 0);
+        trim(s, s.mx);
+    }
+}
+
+template <class Key, class T>
+inline void QConcurrentCache<Key, T>::setMaxCost(int m)
+{ mx.store(m); distributeMaxCost(m); }
+
+template <class Key, class T>
+int QConcurrentCache<Key, T>::totalCost() const
+{
+    int total = 0;
+    for (int i = 0; i < shardCount(); ++i) {
+        QReadLocker locker(&shards[i].lock);
+        total += shards[i].total;
+    }
+    return total;
+}
+
+template <class Key, class T>
+int QConcurrentCache<Key, T>::size() const
+{
+    int size = 0;
+    for (int i = 0; i < shardCount(); ++i) {
+        QReadLocker locker(&shards[i].lock);
+        size += shards[i].hash.size();
+    }
+    return size;
+}
+
+template <class Key, class T>
+QList<Key> QConcurrentCache<Key, T>::keys() const
+{
+    QList<Key> result;
+    for (int i = 0; i < shardCount(); ++i) {
+        QReadLocker locker(&shards[i].lock);
+        result += shards[i].hash.keys();
+    }
+    return result;
+}
+
+template <class Key, class T>
+void QConcurrentCache<Key, T>::clear()
+{
+    for (int i = 0; i < shardCount(); ++i) {
+        Shard &s = shards[i];
+        QWriteLocker locker(&s.lock);
+        s.hash.clear();
+        s.hand = nullptr;
+        s.total = 0;
+    }
+}
+
+template <class Key, class T>
+bool QConcurrentCache<Key, T>::insert(const Key &akey, const QSharedPointer<T> &aobject, int acost)
+{
+    Shard &s = shardFor(akey);
+    QWriteLocker locker(&s.lock);
+    take(s, akey);
+    if (acost > s.mx)
+        return false;
+    trim(s, s.mx - acost);
+    typename QHash<Key, Node>::iterator i = s.hash.insert(akey, Node(aobject, acost));
+    s.total += acost;
+    ++s.insertions;
+    Node *n = &i.value();
+    n->keyPtr = &i.key();
+    link(s, n);
+    return true;
+}
+
+template <class Key, class T>
+QSharedPointer<T> QConcurrentCache<Key, T>::object(const Key &key) const
+{
+    Shard &s = shardFor(key);
+    QReadLocker locker(&s.lock);
+    typename QHash<Key, Node>::const_iterator i = s.hash.constFind(key);
+    if (i == s.hash.constEnd()) {
+        s.misses.ref();
+        return QSharedPointer<T>();
+    }
+    // avoid writing to the node's cache line if the flag is already set
+    if (!i->referenced.load())
+        i->referenced.store(1);
+    s.hits.ref();
+    return i->t;
+}
+
+template <class Key, class T>
+bool QConcurrentCache<Key, T>::contains(const Key &key) const
+{
+    Shard &s = shardFor(key);
+    QReadLocker locker(&s.lock);
+    return s.hash.contains(key);
+}
+
+template <class Key, class T>
+inline bool QConcurrentCache<Key, T>::remove(const Key &key)
+{ return !take(key).isNull(); }
+
+template <class Key, class T>
+QSharedPointer<T> QConcurrentCache<Key, T>::take(const Key &key)
+{
+    Shard &s = shardFor(key);
+    QSharedPointer<T> t;
+    {
+        QWriteLocker locker(&s.lock);
+        t = take(s, key);
+    }
+    return t; // may delete the object, but not while the shard is locked
+}
+
+template <class Key, class T>
+typename QConcurrentCache<Key, T>::Statistics QConcurrentCache<Key, T>::statistics() const
+{
+    Statistics result = { 0, 0, 0, 0 };
+    for (int i = 0; i < shardCount(); ++i) {
+        const Shard &s = shards[i];
+        QReadLocker locker(&s.lock);
+        result.hits += s.hits.load();
+        result.misses += s.misses.load();
+        result.insertions += s.insertions;
+        result.evictions += s.evictions;
+    }
+    return result;
+}
+
+template <class Key, class T>
+void QConcurrentCache<Key, T>::resetStatistics()
+{
+    for (int i = 0; i < shardCount(); ++i) {
+        Shard &s = shards[i];
+        QWriteLocker locker(&s.lock);
+        s.hits.store(0);
+        s.misses.store(0);
+        s.insertions = 0;
+        s.evictions = 0;
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTCACHE_H
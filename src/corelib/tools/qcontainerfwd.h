@@ -46,6 +46,7 @@ QT_BEGIN_NAMESPACE
 
 
 template <class Key, class T> class QCache;
+template <class Key, class T> class QFlatHash;
 template <class Key, class T> class QHash;
 template <class T> class QLinkedList;
 template <class T> class QList;
@@ -40,6 +40,10 @@
 
 #include <qcryptographichash.h>
 #include <qiodevice.h>
+#ifndef QT_NO_QOBJECT
+#include <qfiledevice.h>
+#endif
+#include <private/qsimd_p.h>
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -164,6 +168,337 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 
 QT_BEGIN_NAMESPACE
 
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SHA) && !defined(QT_BOOTSTRAPPED)
+#  define QCRYPTOGRAPHICHASH_SHANI
+static inline bool hasShaNi()
+{
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+}
+
+// Processes \a blocks 64-byte blocks of \a data with the SHA-1 extensions.
+// \a state holds h0...h4.
+QT_FUNCTION_TARGET(SHA)
+static void sha1BlocksShaNi(quint32 *state, const uchar *data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(Q_INT64_C(0x0001020304050607), Q_INT64_C(0x08090a0b0c0d0e0f));
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abcdSave = abcd;
+        const __m128i eSave = e0;
+        __m128i prevAbcd = abcd;
+        __m128i msg[4];
+
+        // 20 groups of 4 rounds; the message schedule is kept in a ring of 4 vectors
+        for (int g = 0; g < 20; ++g) {
+            __m128i &m = msg[g & 3];
+            if (g < 4) {
+                m = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * g)), byteSwap);
+            } else {
+                m = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(m, msg[(g + 1) & 3]),
+                                                     msg[(g + 2) & 3]),
+                                       msg[(g + 3) & 3]);
+            }
+
+            const __m128i e = g ? _mm_sha1nexte_epu32(prevAbcd, m) : _mm_add_epi32(e0, m);
+            prevAbcd = abcd;
+            switch (g / 5) {    // the round function must be an immediate
+            case 0: abcd = _mm_sha1rnds4_epu32(abcd, e, 0); break;
+            case 1: abcd = _mm_sha1rnds4_epu32(abcd, e, 1); break;
+            case 2: abcd = _mm_sha1rnds4_epu32(abcd, e, 2); break;
+            default: abcd = _mm_sha1rnds4_epu32(abcd, e, 3); break;
+            }
+        }
+
+        e0 = _mm_sha1nexte_epu32(prevAbcd, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = _mm_extract_epi32(e0, 3);
+}
+#endif // QCRYPTOGRAPHICHASH_SHANI
+
+static void sha1Input(Sha1State *state, const uchar *data, qint64 length)
+{
+#ifdef QCRYPTOGRAPHICHASH_SHANI
+    if (hasShaNi()) {
+        // complete a partially filled block first, the rest goes through the
+        // buffer of Sha1State as before
+        const qint64 rest = qint64(state->messageSize & 63);
+        if (rest) {
+            const qint64 n = qMin(length, 64 - rest);
+            sha1Update(state, data, n);
+            data += n;
+            length -= n;
+        }
+
+        if (const qint64 blocks = length / 64) {
+            quint32 h[5] = { state->h0, state->h1, state->h2, state->h3, state->h4 };
+            sha1BlocksShaNi(h, data, size_t(blocks));
+            state->h0 = h[0];
+            state->h1 = h[1];
+            state->h2 = h[2];
+            state->h3 = h[3];
+            state->h4 = h[4];
+            state->messageSize += quint64(blocks) * 64;
+            data += blocks * 64;
+            length -= blocks * 64;
+        }
+    }
+#endif
+    sha1Update(state, data, length);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#ifdef QCRYPTOGRAPHICHASH_SHANI
+static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// Processes \a blocks 64-byte blocks of \a data with the SHA-256 extensions.
+// \a state holds the eight words of the intermediate hash.
+QT_FUNCTION_TARGET(SHA)
+static void sha256BlocksShaNi(quint32 *state, const uchar *data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(Q_INT64_C(0x0c0d0e0f08090a0b), Q_INT64_C(0x0405060700010203));
+
+    // the instructions want the state as ABEF and CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i msg[4];
+
+        // 16 groups of 4 rounds; the message schedule is kept in a ring of 4 vectors
+        for (int g = 0; g < 16; ++g) {
+            __m128i &m = msg[g & 3];
+            if (g < 4) {
+                m = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * g)), byteSwap);
+            } else {
+                m = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(m, msg[(g + 1) & 3]),
+                                                       _mm_alignr_epi8(msg[(g + 3) & 3], msg[(g + 2) & 3], 4)),
+                                         msg[(g + 3) & 3]);
+            }
+
+            const __m128i k = _mm_add_epi32(m, _mm_loadu_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants + 4 * g)));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(k, 0x0E));
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+}
+#endif // QCRYPTOGRAPHICHASH_SHANI
+
+/*
+    SHA256Input() from RFC 6234 moves the data byte by byte into the message
+    block and updates the length for every byte. Feed whole blocks directly to
+    the compression function instead.
+*/
+static void sha256Input(SHA256Context *context, const uchar *data, uint length)
+{
+    if (context->Computed || context->Corrupted) {
+        SHA256Input(context, data, length);     // sets the error code
+        return;
+    }
+
+    if (context->Message_Block_Index) {
+        const uint n = qMin(length, uint(SHA256_Message_Block_Size - context->Message_Block_Index));
+        SHA256Input(context, data, n);
+        data += n;
+        length -= n;
+    }
+
+    if (const uint blocks = length / SHA256_Message_Block_Size) {
+#ifdef QCRYPTOGRAPHICHASH_SHANI
+        if (hasShaNi()) {
+            sha256BlocksShaNi(context->Intermediate_Hash, data, blocks);
+        } else
+#endif
+        {
+            for (uint i = 0; i < blocks; ++i) {
+                memcpy(context->Message_Block, data + i * SHA256_Message_Block_Size, SHA256_Message_Block_Size);
+                SHA224_256ProcessMessageBlock(context);
+            }
+        }
+
+        const quint64 bits = quint64(context->Length_High) << 32 | context->Length_Low;
+        const quint64 added = quint64(blocks) * SHA256_Message_Block_Size * 8;
+        if (bits + added < bits)
+            context->Corrupted = shaInputTooLong;
+        context->Length_High = quint32((bits + added) >> 32);
+        context->Length_Low = quint32(bits + added);
+        data += blocks * SHA256_Message_Block_Size;
+        length -= blocks * SHA256_Message_Block_Size;
+    }
+
+    if (length)
+        SHA256Input(context, data, length);
+}
+
+/*
+    BLAKE2b and BLAKE2s (RFC 7693), unkeyed, with a configurable digest length.
+    Both variants share the same structure and only differ in the word size,
+    the number of rounds and the rotation distances.
+*/
+static const uchar blake2Sigma[10][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+static const quint64 blake2bIV[8] = {
+    Q_UINT64_C(0x6a09e667f3bcc908), Q_UINT64_C(0xbb67ae8584caa73b),
+    Q_UINT64_C(0x3c6ef372fe94f82b), Q_UINT64_C(0xa54ff53a5f1d36f1),
+    Q_UINT64_C(0x510e527fade682d1), Q_UINT64_C(0x9b05688c2b3e6c1f),
+    Q_UINT64_C(0x1f83d9abfb41bd6b), Q_UINT64_C(0x5be0cd19137e2179)
+};
+
+static const quint32 blake2sIV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+template <typename Word, int Rounds, int R1, int R2, int R3, int R4>
+struct Blake2Context
+{
+    enum { BlockSize = 16 * sizeof(Word) };
+
+    Word h[8];
+    Word t[2];
+    uchar buffer[BlockSize];
+    uint bufferLength;
+    uint hashLength;
+
+    static Word rotr(Word w, int n) { return (w >> n) | (w << (8 * sizeof(Word) - n)); }
+    static const Word *iv();
+
+    void init(uint length)
+    {
+        memcpy(h, iv(), sizeof h);
+        h[0] ^= 0x01010000 ^ length;    // fanout = depth = 1, no key
+        t[0] = t[1] = 0;
+        bufferLength = 0;
+        hashLength = length;
+    }
+
+    void increment(Word n)
+    {
+        t[0] += n;
+        if (t[0] < n)
+            ++t[1];
+    }
+
+    void compress(const uchar *block, bool last)
+    {
+        Word m[16];
+        Word v[16];
+        for (int i = 0; i < 16; ++i)
+            m[i] = qFromLittleEndian<Word>(block + i * sizeof(Word));
+        memcpy(v, h, sizeof h);
+        memcpy(v + 8, iv(), sizeof h);
+        v[12] ^= t[0];
+        v[13] ^= t[1];
+        if (last)
+            v[14] = ~v[14];
+
+        for (int r = 0; r < Rounds; ++r) {
+            const uchar *s = blake2Sigma[r % 10];
+            mix(v, 0, 4,  8, 12, m[s[ 0]], m[s[ 1]]);
+            mix(v, 1, 5,  9, 13, m[s[ 2]], m[s[ 3]]);
+            mix(v, 2, 6, 10, 14, m[s[ 4]], m[s[ 5]]);
+            mix(v, 3, 7, 11, 15, m[s[ 6]], m[s[ 7]]);
+            mix(v, 0, 5, 10, 15, m[s[ 8]], m[s[ 9]]);
+            mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            mix(v, 2, 7,  8, 13, m[s[12]], m[s[13]]);
+            mix(v, 3, 4,  9, 14, m[s[14]], m[s[15]]);
+        }
+
+        for (int i = 0; i < 8; ++i)
+            h[i] ^= v[i] ^ v[i + 8];
+    }
+
+    static void mix(Word *v, int a, int b, int c, int d, Word x, Word y)
+    {
+        v[a] += v[b] + x;
+        v[d] = rotr(v[d] ^ v[a], R1);
+        v[c] += v[d];
+        v[b] = rotr(v[b] ^ v[c], R2);
+        v[a] += v[b] + y;
+        v[d] = rotr(v[d] ^ v[a], R3);
+        v[c] += v[d];
+        v[b] = rotr(v[b] ^ v[c], R4);
+    }
+
+    void update(const uchar *data, size_t length)
+    {
+        // the last block must be compressed with the finalization flag set,
+        // so a full buffer is only processed once more data arrives
+        if (length > BlockSize - bufferLength) {
+            const size_t fill = BlockSize - bufferLength;
+            memcpy(buffer + bufferLength, data, fill);
+            increment(BlockSize);
+            compress(buffer, false);
+            bufferLength = 0;
+            data += fill;
+            length -= fill;
+            while (length > BlockSize) {
+                increment(BlockSize);
+                compress(data, false);
+                data += BlockSize;
+                length -= BlockSize;
+            }
+        }
+        memcpy(buffer + bufferLength, data, length);
+        bufferLength += uint(length);
+    }
+
+    void final(uchar *out)
+    {
+        increment(bufferLength);
+        memset(buffer + bufferLength, 0, BlockSize - bufferLength);
+        compress(buffer, true);
+
+        uchar digest[8 * sizeof(Word)];
+        for (int i = 0; i < 8; ++i)
+            qToLittleEndian(h[i], digest + i * sizeof(Word));
+        memcpy(out, digest, hashLength);
+    }
+};
+
+typedef Blake2Context<quint64, 12, 32, 24, 16, 63> Blake2bContext;
+typedef Blake2Context<quint32, 10, 16, 12, 8, 7> Blake2sContext;
+
+template <> const quint64 *Blake2bContext::iv() { return blake2bIV; }
+template <> const quint32 *Blake2sContext::iv() { return blake2sIV; }
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
 class QCryptographicHashPrivate
 {
 public:
@@ -178,6 +513,8 @@ public:
         SHA384Context sha384Context;
         SHA512Context sha512Context;
         SHA3Context sha3Context;
+        Blake2bContext blake2bContext;
+        Blake2sContext blake2sContext;
 #endif
     };
 #ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -273,12 +610,46 @@ void QCryptographicHashPrivate::sha3Finish(int bitCount, Sha3Variant sha3Variant
   \value Keccak_256 Generate a Keccak-256 hash sum. Introduced in Qt 5.9.2
   \value Keccak_384 Generate a Keccak-384 hash sum. Introduced in Qt 5.9.2
   \value Keccak_512 Generate a Keccak-512 hash sum. Introduced in Qt 5.9.2
+  \value Blake2b_160 Generate a BLAKE2b-160 hash sum. Introduced in Qt 5.11
+  \value Blake2b_256 Generate a BLAKE2b-256 hash sum. Introduced in Qt 5.11
+  \value Blake2b_384 Generate a BLAKE2b-384 hash sum. Introduced in Qt 5.11
+  \value Blake2b_512 Generate a BLAKE2b-512 hash sum. Introduced in Qt 5.11
+  \value Blake2s_128 Generate a BLAKE2s-128 hash sum. Introduced in Qt 5.11
+  \value Blake2s_160 Generate a BLAKE2s-160 hash sum. Introduced in Qt 5.11
+  \value Blake2s_224 Generate a BLAKE2s-224 hash sum. Introduced in Qt 5.11
+  \value Blake2s_256 Generate a BLAKE2s-256 hash sum. Introduced in Qt 5.11
   \omitvalue RealSha3_224
   \omitvalue RealSha3_256
   \omitvalue RealSha3_384
   \omitvalue RealSha3_512
 */
 
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static uint hashLength(QCryptographicHash::Algorithm method)
+{
+    switch (method) {
+    case QCryptographicHash::Blake2b_160:
+    case QCryptographicHash::Blake2s_160:
+        return 160 / 8;
+    case QCryptographicHash::Blake2b_256:
+    case QCryptographicHash::Blake2s_256:
+        return 256 / 8;
+    case QCryptographicHash::Blake2b_384:
+        return 384 / 8;
+    case QCryptographicHash::Blake2b_512:
+        return 512 / 8;
+    case QCryptographicHash::Blake2s_128:
+        return 128 / 8;
+    case QCryptographicHash::Blake2s_224:
+        return 224 / 8;
+    default:
+        break;
+    }
+    Q_UNREACHABLE();
+    return 0;
+}
+#endif
+
 /*!
   Constructs an object that can be used to create a cryptographic hash from data using \a method.
 */
@@ -346,6 +717,18 @@ void QCryptographicHash::reset()
     case Keccak_512:
         sha3Init(&d->sha3Context, 512);
         break;
+    case Blake2b_160:
+    case Blake2b_256:
+    case Blake2b_384:
+    case Blake2b_512:
+        d->blake2bContext.init(hashLength(d->method));
+        break;
+    case Blake2s_128:
+    case Blake2s_160:
+    case Blake2s_224:
+    case Blake2s_256:
+        d->blake2sContext.init(hashLength(d->method));
+        break;
 #endif
     }
     d->result.clear();
@@ -359,7 +742,7 @@ void QCryptographicHash::addData(const char *data, int length)
 {
     switch (d->method) {
     case Sha1:
-        sha1Update(&d->sha1Context, (const unsigned char *)data, length);
+        sha1Input(&d->sha1Context, (const unsigned char *)data, length);
         break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
     default:
@@ -374,10 +757,10 @@ void QCryptographicHash::addData(const char *data, int length)
         MD5Update(&d->md5Context, (const unsigned char *)data, length);
         break;
     case Sha224:
-        SHA224Input(&d->sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+        sha256Input(&d->sha224Context, reinterpret_cast<const unsigned char *>(data), length);
         break;
     case Sha256:
-        SHA256Input(&d->sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+        sha256Input(&d->sha256Context, reinterpret_cast<const unsigned char *>(data), length);
         break;
     case Sha384:
         SHA384Input(&d->sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -401,6 +784,18 @@ void QCryptographicHash::addData(const char *data, int length)
     case Keccak_512:
         sha3Update(&d->sha3Context, reinterpret_cast<const BitSequence *>(data), length*8);
         break;
+    case Blake2b_160:
+    case Blake2b_256:
+    case Blake2b_384:
+    case Blake2b_512:
+        d->blake2bContext.update(reinterpret_cast<const uchar *>(data), length);
+        break;
+    case Blake2s_128:
+    case Blake2s_160:
+    case Blake2s_224:
+    case Blake2s_256:
+        d->blake2sContext.update(reinterpret_cast<const uchar *>(data), length);
+        break;
 #endif
     }
     d->result.clear();
@@ -414,9 +809,42 @@ void QCryptographicHash::addData(const QByteArray &data)
     addData(data.constData(), data.length());
 }
 
+#ifndef QT_NO_QOBJECT
+/*
+    Hashes the rest of \a file from a memory mapping instead of copying it
+    through a buffer. Big files are mapped in chunks so that they do not
+    exhaust the address space of 32-bit processes. Returns \c false if the
+    file cannot be mapped; the position then points to the data that has not
+    been hashed yet.
+*/
+static bool addMappedFile(QCryptographicHash *hash, QFileDevice *file)
+{
+    const qint64 chunkSize = Q_INT64_C(64) * 1024 * 1024;
+    const qint64 size = file->size();
+    qint64 pos = file->pos();
+
+    while (pos < size) {
+        const qint64 length = qMin(chunkSize, size - pos);
+        uchar *data = file->map(pos, length);
+        if (!data) {
+            file->seek(pos);
+            return false;
+        }
+        hash->addData(reinterpret_cast<const char *>(data), int(length));
+        file->unmap(data);
+        pos += length;
+    }
+    return file->seek(size);
+}
+#endif
+
 /*!
   Reads the data from the open QIODevice \a device until it ends
   and hashes it. Returns \c true if reading was successful.
+
+  Since Qt 5.11, files that can be memory-mapped are hashed directly from the
+  mapping.
+
   \since 5.0
  */
 bool QCryptographicHash::addData(QIODevice* device)
@@ -427,7 +855,19 @@ bool QCryptographicHash::addData(QIODevice* device)
     if (!device->isOpen())
         return false;
 
-    char buffer[1024];
+#ifndef QT_NO_QOBJECT
+    // Small files are cheaper to read than to map. Files whose size is not
+    // known up front (such as those in /proc) are read as well.
+    enum { MinimumMappedSize = 64 * 1024 };
+    QFileDevice *file = qobject_cast<QFileDevice *>(device);
+    if (file && !file->isSequential() && !(file->openMode() & QIODevice::Text)
+            && file->size() - file->pos() >= MinimumMappedSize) {
+        if (addMappedFile(this, file))
+            return true;
+    }
+#endif
+
+    char buffer[4096];
     int length;
 
     while ((length = device->read(buffer,sizeof(buffer))) > 0)
@@ -529,6 +969,24 @@ QByteArray QCryptographicHash::result() const
         d->sha3Finish(512, QCryptographicHashPrivate::Sha3Variant::Keccak);
         break;
     }
+    case Blake2b_160:
+    case Blake2b_256:
+    case Blake2b_384:
+    case Blake2b_512: {
+        Blake2bContext copy = d->blake2bContext;
+        d->result.resize(copy.hashLength);
+        copy.final(reinterpret_cast<uchar *>(d->result.data()));
+        break;
+    }
+    case Blake2s_128:
+    case Blake2s_160:
+    case Blake2s_224:
+    case Blake2s_256: {
+        Blake2sContext copy = d->blake2sContext;
+        d->result.resize(copy.hashLength);
+        copy.final(reinterpret_cast<uchar *>(d->result.data()));
+        break;
+    }
 #endif
     }
     return d->result;
@@ -74,6 +74,14 @@ public:
         RealSha3_256,
         RealSha3_384,
         RealSha3_512,
+        Blake2b_160 = 15,
+        Blake2b_256,
+        Blake2b_384,
+        Blake2b_512,
+        Blake2s_128 = 19,
+        Blake2s_160,
+        Blake2s_224,
+        Blake2s_256,
 #  ifndef QT_SHA3_KECCAK_COMPAT
         Sha3_224 = RealSha3_224,
         Sha3_256 = RealSha3_256,
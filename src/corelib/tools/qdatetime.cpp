@@ -44,7 +44,9 @@
 #include "private/qdatetimeparser_p.h"
 #endif
 
+#include "qcache.h"
 #include "qdatastream.h"
+#include "qmutex.h"
 #include "qset.h"
 #include "qlocale.h"
 #include "qdatetime.h"
@@ -57,6 +59,7 @@
 #include <locale.h>
 #endif
 
+#include <chrono>
 #include <cmath>
 #include <time.h>
 #ifdef Q_OS_WIN
@@ -1271,6 +1274,48 @@ QDate QDate::fromString(const QString& string, Qt::DateFormat format)
     return QDate();
 }
 
+#if QT_CONFIG(datetimeparser)
+/*
+    Parsing a format string is a good part of the work of converting a string
+    with it, and programs tend to use the same few formats over and over. So
+    the parsed form of recently used formats is kept, and each conversion
+    works on a copy of it.
+*/
+namespace {
+struct QDateTimeFormatCache
+{
+    QMutex mutex;
+    QCache<QPair<int, QString>, QDateTimeParser> parsers;
+};
+}
+Q_GLOBAL_STATIC(QDateTimeFormatCache, dateTimeFormatCache)
+
+static QDateTimeParser formatParser(QVariant::Type type, const QString &format, bool *ok)
+{
+    const QPair<int, QString> key(type, format);
+    QDateTimeFormatCache *cache = dateTimeFormatCache();
+    if (cache) {
+        QMutexLocker locker(&cache->mutex);
+        if (const QDateTimeParser *parser = cache->parsers.object(key)) {
+            *ok = true;
+            QDateTimeParser copy(*parser);
+            locker.unlock();
+            // The default locale is not needed for parsing the format itself
+            copy.setDefaultLocale(QLocale::system());
+            return copy;
+        }
+    }
+
+    QDateTimeParser parser(type, QDateTimeParser::FromString);
+    *ok = parser.parseFormat(format);
+    if (*ok && cache) {
+        QMutexLocker locker(&cache->mutex);
+        cache->parsers.insert(key, new QDateTimeParser(parser));
+    }
+    return parser;
+}
+#endif // datetimeparser
+
 /*!
     \fn QDate::fromString(const QString &string, const QString &format)
 
@@ -1340,9 +1385,10 @@ QDate QDate::fromString(const QString &string, const QString &format)
 {
     QDate date;
 #if QT_CONFIG(datetimeparser)
-    QDateTimeParser dt(QVariant::Date, QDateTimeParser::FromString);
+    bool ok;
+    const QDateTimeParser dt = formatParser(QVariant::Date, format, &ok);
     // dt.setDefaultLocale(QLocale::c()); ### Qt 6
-    if (dt.parseFormat(format))
+    if (ok)
         dt.fromString(string, &date, 0);
 #else
     Q_UNUSED(string);
@@ -2058,9 +2104,10 @@ QTime QTime::fromString(const QString &string, const QString &format)
 {
     QTime time;
 #if QT_CONFIG(datetimeparser)
-    QDateTimeParser dt(QVariant::Time, QDateTimeParser::FromString);
+    bool ok;
+    const QDateTimeParser dt = formatParser(QVariant::Time, format, &ok);
     // dt.setDefaultLocale(QLocale::c()); ### Qt 6
-    if (dt.parseFormat(format))
+    if (ok)
         dt.fromString(string, 0, &time);
 #else
     Q_UNUSED(string);
@@ -2247,6 +2294,126 @@ int QDateTimeParser::startsWithLocalTimeZone(const QStringRef name)
 }
 #endif // datetimeparser && timezone
 
+#if defined(Q_COMPILER_THREAD_LOCAL) && (defined(Q_OS_LINUX) || defined(Q_OS_BSD4))
+#  define QT_USE_LOCALTIME_CACHE
+#endif
+
+#ifdef QT_USE_LOCALTIME_CACHE
+/*
+    localtime_r() and mktime() take a process-wide lock in most C libraries,
+    and are called for every conversion between UTC and local time. Each
+    thread therefore remembers a span of time over which the local offset
+    from UTC was found not to change, and converts within it by plain
+    arithmetic.
+
+    The span is established by sampling localtime_r() every few hours across
+    a few days around the requested time, so it only relies on the zone not
+    changing its offset and changing it back in between two samples. The
+    cache is dropped when TZ changes, and after a second in any case, so that
+    changes to the system time zone are picked up.
+*/
+static void msecsToTime(qint64 msecs, QDate *date, QTime *time);
+
+namespace {
+struct LocalTimeCache
+{
+    enum {
+        SampleStep = 3 * SECS_PER_HOUR,
+        Margin = 2 * SECS_PER_DAY,
+        // Offsets of one zone never differ by more than this, so local
+        // times within it of the span's edges are left to mktime()
+        MaxOffsetChange = 26 * SECS_PER_HOUR,
+        MaxTzLength = 64
+    };
+
+    qint64 start = 0; // seconds since the epoch, inclusive
+    qint64 end = 0;   // exclusive; empty when equal to start
+    qint64 failedBlock = -1; // hour in which the offset changes
+    int offset = 0;   // seconds east of UTC
+    int isDst = -1;
+    int lastMktimeIsDst = -1; // as found by the last conversion to UTC
+    std::chrono::steady_clock::time_point expiry;
+    char tz[MaxTzLength] = {};
+    bool tzSet = false;
+
+    bool isCurrent(const char *currentTz, std::chrono::steady_clock::time_point now) const
+    {
+        if (now >= expiry || tzSet != (currentTz != nullptr))
+            return false;
+        return !currentTz || qstrcmp(tz, currentTz) == 0;
+    }
+
+    bool sample(qint64 first, qint64 last, qint64 step);
+    bool refresh(qint64 secs);
+};
+
+static thread_local LocalTimeCache localTimeCache;
+
+// Checks that localtime_r() gives the same offset from first to last
+bool LocalTimeCache::sample(qint64 first, qint64 last, qint64 step)
+{
+    tm local;
+    for (qint64 t = first; ; t = qMin(t + step, last)) {
+        const time_t when = time_t(t);
+        if (qint64(when) != t || !localtime_r(&when, &local))
+            return false;
+        if (t == first) {
+            offset = int(local.tm_gmtoff);
+            isDst = local.tm_isdst;
+        } else if (local.tm_gmtoff != offset || local.tm_isdst != isDst) {
+            return false;
+        }
+        if (t == last)
+            break;
+    }
+    start = first;
+    end = last + 1;
+    return true;
+}
+
+bool LocalTimeCache::refresh(qint64 secs)
+{
+    const char *currentTz = getenv("TZ");
+    if (currentTz && qstrlen(currentTz) >= MaxTzLength) {
+        expiry = std::chrono::steady_clock::time_point();
+        return false;
+    }
+    expiry = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    tzSet = currentTz != nullptr;
+    if (tzSet)
+        qstrcpy(tz, currentTz);
+
+    qt_tzset();
+    const qint64 block = secs - (secs % SECS_PER_HOUR + SECS_PER_HOUR) % SECS_PER_HOUR;
+    start = end = 0;
+    failedBlock = -1;
+    // Prefer a span wide enough for converting local times back to UTC; close
+    // to a transition, settle for the hour around secs
+    if (sample(block - Margin, block + SECS_PER_HOUR - 1 + Margin, SampleStep)
+            || sample(block, block + SECS_PER_HOUR - 1, SECS_PER_HOUR - 1)) {
+        return true;
+    }
+    start = end = 0;
+    failedBlock = block;
+    return false;
+}
+
+// Returns the cached span containing secsSinceEpoch, if the offset there can
+// be cached at all
+static const LocalTimeCache *cachedLocalTime(qint64 secsSinceEpoch)
+{
+    LocalTimeCache &cache = localTimeCache;
+    if (cache.isCurrent(getenv("TZ"), std::chrono::steady_clock::now())) {
+        if (secsSinceEpoch >= cache.start && secsSinceEpoch < cache.end)
+            return &cache;
+        if (secsSinceEpoch >= cache.failedBlock && secsSinceEpoch < cache.failedBlock + SECS_PER_HOUR)
+            return nullptr;
+    }
+    return cache.refresh(secsSinceEpoch) ? &cache : nullptr;
+}
+} // unnamed namespace
+#endif // QT_USE_LOCALTIME_CACHE
+
 // Calls the platform variant of mktime for the given date, time and daylightStatus,
 // and updates the date, time, daylightStatus and abbreviation with the returned values
 // If the date falls outside the 1970 to 2037 range supported by mktime / time_t
@@ -2256,6 +2423,34 @@ static qint64 qt_mktime(QDate *date, QTime *time, QDateTimePrivate::DaylightStat
                         QString *abbreviation, bool *ok = 0)
 {
     const qint64 msec = time->msec();
+
+#ifdef QT_USE_LOCALTIME_CACHE
+    // Only unambiguous local times, well inside a span of constant offset,
+    // are sure to get the same answer as from mktime()
+    if (!abbreviation && date->isValid() && time->isValid()) {
+        const qint64 localSecs = (date->toJulianDay() - JULIAN_DAY_FOR_EPOCH) * SECS_PER_DAY
+                                 + time->msecsSinceStartOfDay() / 1000;
+        const qint64 guess = localSecs - localTimeCache.offset;
+        if (const LocalTimeCache *cache = cachedLocalTime(guess)) {
+            const qint64 utcSecs = localSecs - cache->offset;
+            if (utcSecs - LocalTimeCache::MaxOffsetChange >= cache->start
+                    && utcSecs + LocalTimeCache::MaxOffsetChange < cache->end
+                    && (!daylightStatus || *daylightStatus == QDateTimePrivate::UnknownDaylightTime
+                        || int(*daylightStatus) == cache->isDst)) {
+                if (daylightStatus) {
+                    *daylightStatus = cache->isDst > 0 ? QDateTimePrivate::DaylightTime
+                                    : cache->isDst == 0 ? QDateTimePrivate::StandardTime
+                                    : QDateTimePrivate::UnknownDaylightTime;
+                }
+                if (ok)
+                    *ok = true;
+                localTimeCache.lastMktimeIsDst = cache->isDst;
+                return utcSecs * 1000 + msec;
+            }
+        }
+    }
+#endif // QT_USE_LOCALTIME_CACHE
+
     int yy, mm, dd;
     date->getDate(&yy, &mm, &dd);
 
@@ -2276,7 +2471,35 @@ static qint64 qt_mktime(QDate *date, QTime *time, QDateTimePrivate::DaylightStat
 #if defined(Q_OS_WIN)
     int hh = local.tm_hour;
 #endif // Q_OS_WIN
+#ifdef QT_USE_LOCALTIME_CACHE
+    const tm requested = local;
+#endif
     time_t secsSinceEpoch = mktime(&local);
+#ifdef QT_USE_LOCALTIME_CACHE
+    /*
+      When asked for a local time that occurs twice, at the end of DST, glibc
+      picks the one matching the offset its previous mktime() call found. The
+      fast path above skips many of those calls, so remember what they would
+      have found and make the same choice here.
+    */
+    const int lastIsDst = localTimeCache.lastMktimeIsDst;
+    if (secsSinceEpoch != time_t(-1) && requested.tm_isdst < 0 && lastIsDst >= 0
+            && (local.tm_isdst > 0) != (lastIsDst > 0)) {
+        tm other = requested;
+        other.tm_isdst = lastIsDst;
+        const time_t otherSecs = mktime(&other);
+        if (otherSecs != time_t(-1) && otherSecs != secsSinceEpoch
+                && (other.tm_isdst > 0) == (lastIsDst > 0)
+                && other.tm_hour == requested.tm_hour && other.tm_min == requested.tm_min
+                && other.tm_mday == requested.tm_mday && other.tm_mon == requested.tm_mon
+                && other.tm_year == requested.tm_year) {
+            local = other;
+            secsSinceEpoch = otherSecs;
+        }
+    }
+    if (secsSinceEpoch != time_t(-1))
+        localTimeCache.lastMktimeIsDst = local.tm_isdst;
+#endif // QT_USE_LOCALTIME_CACHE
     if (secsSinceEpoch != time_t(-1)) {
         *date = QDate(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
         *time = QTime(local.tm_hour, local.tm_min, local.tm_sec, msec);
@@ -2332,6 +2555,18 @@ static bool qt_localtime(qint64 msecsSinceEpoch, QDate *localDate, QTime *localT
     const time_t secsSinceEpoch = msecsSinceEpoch / 1000;
     const int msec = msecsSinceEpoch % 1000;
 
+#ifdef QT_USE_LOCALTIME_CACHE
+    if (const LocalTimeCache *cache = cachedLocalTime(secsSinceEpoch)) {
+        msecsToTime(msecsSinceEpoch + cache->offset * qint64(1000), localDate, localTime);
+        if (daylightStatus) {
+            *daylightStatus = cache->isDst > 0 ? QDateTimePrivate::DaylightTime
+                            : cache->isDst == 0 ? QDateTimePrivate::StandardTime
+                            : QDateTimePrivate::UnknownDaylightTime;
+        }
+        return true;
+    }
+#endif // QT_USE_LOCALTIME_CACHE
+
     tm local;
     bool valid = false;
 
@@ -5061,9 +5296,10 @@ QDateTime QDateTime::fromString(const QString &string, const QString &format)
     QTime time;
     QDate date;
 
-    QDateTimeParser dt(QVariant::DateTime, QDateTimeParser::FromString);
+    bool ok;
+    const QDateTimeParser dt = formatParser(QVariant::DateTime, format, &ok);
     // dt.setDefaultLocale(QLocale::c()); ### Qt 6
-    if (dt.parseFormat(format) && dt.fromString(string, &date, &time))
+    if (ok && dt.fromString(string, &date, &time))
         return QDateTime(date, time);
 #else
     Q_UNUSED(string);
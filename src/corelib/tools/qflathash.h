@@ -0,0 +1,750 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFLATHASH_H
+#define QFLATHASH_H
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrefcount.h>
+
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+#include <initializer_list>
+#endif
+
+#include <iterator>
+#include <new>
+#include <utility>
+#include <string.h>
+
+#if defined(__SSE2__) || (defined(Q_CC_MSVC) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#  include <emmintrin.h>
+#  define QT_FLATHASH_SSE2
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QFlatHashPrivate {
+
+// Every slot of the table has a control byte: negative if the slot is
+// free, otherwise the lowest seven bits of the (mixed) hash of its key.
+enum Control {
+    Empty = -128,
+    Deleted = -2
+};
+
+enum {
+    GroupWidth = 16,
+    MinimumCapacity = GroupWidth
+};
+
+// The control bytes of GroupWidth consecutive slots, matched all at once.
+// Bit n of a match is set if slot n of the group matches.
+struct Group
+{
+#ifdef QT_FLATHASH_SSE2
+    explicit Group(const signed char *ctrl)
+        : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) { }
+
+    uint match(signed char h2) const
+    { return uint(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes))); }
+    uint matchFree() const
+    { return uint(_mm_movemask_epi8(bytes)); }
+
+    __m128i bytes;
+#else
+    explicit Group(const signed char *ctrl) : bytes(ctrl) { }
+
+    uint match(signed char h2) const
+    {
+        uint result = 0;
+        for (int n = 0; n < GroupWidth; ++n)
+            result |= uint(bytes[n] == h2) << n;
+        return result;
+    }
+    uint matchFree() const
+    {
+        uint result = 0;
+        for (int n = 0; n < GroupWidth; ++n)
+            result |= uint(bytes[n] < 0) << n;
+        return result;
+    }
+
+    const signed char *bytes;
+#endif
+    uint matchEmpty() const { return match(Empty); }
+    uint matchFull() const { return ~matchFree() & ((1u << GroupWidth) - 1); }
+};
+
+// qHash() maps many common keys (integers, for instance) to hashes that
+// differ in only a few bits; spread them over the whole table.
+inline quint64 mix(uint h) Q_DECL_NOTHROW
+{
+    const quint64 x = quint64(h) * Q_UINT64_C(0x9e3779b97f4a7c15);
+    return x ^ (x >> 32);
+}
+
+inline int maximumLoad(int capacity) Q_DECL_NOTHROW
+{
+    return capacity - capacity / 8;
+}
+
+inline int capacityFor(int size) Q_DECL_NOTHROW
+{
+    int capacity = MinimumCapacity;
+    while (capacity < (1 << 30) && maximumLoad(capacity) < size)
+        capacity *= 2;
+    return capacity;
+}
+
+} // namespace QFlatHashPrivate
+
+template <class Key, class T>
+class QFlatHash
+{
+    struct Node
+    {
+        Node(const Key &k, const T &v) : key(k), value(v) { }
+        Key key;
+        T value;
+    };
+
+    struct Data
+    {
+        QtPrivate::RefCount ref;
+        int size;
+        int capacity; // a power of two, at least MinimumCapacity
+        int deleted;
+        uint seed;
+        // capacity + GroupWidth - 1 bytes: the last ones mirror the first
+        // ones, so that groups can be read across the end of the table
+        signed char *ctrl;
+        Node *nodes;
+    };
+
+    Data *d;
+
+public:
+    inline QFlatHash() Q_DECL_NOTHROW : d(Q_NULLPTR) { }
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatHash(std::initializer_list<std::pair<Key, T> > list)
+        : d(Q_NULLPTR)
+    {
+        reserve(int(list.size()));
+        for (typename std::initializer_list<std::pair<Key, T> >::const_iterator it = list.begin(); it != list.end(); ++it)
+            insert(it->first, it->second);
+    }
+#endif
+    QFlatHash(const QFlatHash &other) : d(other.d) { if (d) d->ref.ref(); }
+    ~QFlatHash() { if (d && !d->ref.deref()) freeData(d); }
+
+    QFlatHash &operator=(const QFlatHash &other)
+    {
+        QFlatHash copy(other);
+        swap(copy);
+        return *this;
+    }
+#ifdef Q_COMPILER_RVALUE_REFS
+    QFlatHash(QFlatHash &&other) Q_DECL_NOTHROW : d(other.d) { other.d = Q_NULLPTR; }
+    QFlatHash &operator=(QFlatHash &&other) Q_DECL_NOTHROW
+    { QFlatHash moved(std::move(other)); swap(moved); return *this; }
+#endif
+    void swap(QFlatHash &other) Q_DECL_NOTHROW { qSwap(d, other.d); }
+
+    bool operator==(const QFlatHash &other) const;
+    inline bool operator!=(const QFlatHash &other) const { return !(*this == other); }
+
+    inline int size() const { return d ? d->size : 0; }
+    inline int count() const { return size(); }
+    inline bool isEmpty() const { return size() == 0; }
+
+    inline int capacity() const { return d ? d->capacity : 0; }
+    void reserve(int size);
+    void squeeze();
+
+    inline void detach() { if (d && d->ref.isShared()) detach_helper(); }
+    inline bool isDetached() const { return !d || !d->ref.isShared(); }
+    inline bool isSharedWith(const QFlatHash &other) const { return d == other.d; }
+
+    inline void clear() { *this = QFlatHash(); }
+
+    int remove(const Key &akey);
+    T take(const Key &akey);
+
+    inline bool contains(const Key &akey) const { return findIndex(akey) >= 0; }
+    inline int count(const Key &akey) const { return contains(akey) ? 1 : 0; }
+
+    const Key key(const T &avalue) const;
+    const Key key(const T &avalue, const Key &defaultKey) const;
+    const T value(const Key &akey) const;
+    const T value(const Key &akey, const T &defaultValue) const;
+    T &operator[](const Key &akey);
+    const T operator[](const Key &akey) const;
+
+    QList<Key> keys() const;
+    QList<T> values() const;
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class const_iterator;
+        friend class QFlatHash<Key, T>;
+        Data *data;
+        int index;
+
+        inline iterator(Data *x, int n) : data(x), index(n) { }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        inline iterator() : data(Q_NULLPTR), index(0) { }
+
+        inline const Key &key() const { return data->nodes[index].key; }
+        inline T &value() const { return data->nodes[index].value; }
+        inline T &operator*() const { return value(); }
+        inline T *operator->() const { return &value(); }
+        inline bool operator==(const iterator &o) const { return index == o.index && data == o.data; }
+        inline bool operator!=(const iterator &o) const { return !(*this == o); }
+
+        inline iterator &operator++()
+        {
+            index = QFlatHash::nextFull(data, index + 1);
+            return *this;
+        }
+        inline iterator operator++(int)
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        inline bool operator==(const const_iterator &o) const { return index == o.index && data == o.data; }
+        inline bool operator!=(const const_iterator &o) const { return !(*this == o); }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class iterator;
+        friend class QFlatHash<Key, T>;
+        const Data *data;
+        int index;
+
+        inline const_iterator(const Data *x, int n) : data(x), index(n) { }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() : data(Q_NULLPTR), index(0) { }
+        inline const_iterator(const iterator &o) : data(o.data), index(o.index) { }
+
+        inline const Key &key() const { return data->nodes[index].key; }
+        inline const T &value() const { return data->nodes[index].value; }
+        inline const T &operator*() const { return value(); }
+        inline const T *operator->() const { return &value(); }
+        inline bool operator==(const const_iterator &o) const { return index == o.index && data == o.data; }
+        inline bool operator!=(const const_iterator &o) const { return !(*this == o); }
+
+        inline const_iterator &operator++()
+        {
+            index = QFlatHash::nextFull(data, index + 1);
+            return *this;
+        }
+        inline const_iterator operator++(int)
+        {
+            const_iterator r = *this;
+            ++*this;
+            return r;
+        }
+    };
+    friend class const_iterator;
+
+    // STL style
+    inline iterator begin() { detach(); return iterator(d, d ? nextFull(d, 0) : 0); }
+    inline const_iterator begin() const { return constBegin(); }
+    inline const_iterator cbegin() const { return constBegin(); }
+    inline const_iterator constBegin() const { return const_iterator(d, d ? nextFull(d, 0) : 0); }
+    inline iterator end() { detach(); return iterator(d, capacity()); }
+    inline const_iterator end() const { return constEnd(); }
+    inline const_iterator cend() const { return constEnd(); }
+    inline const_iterator constEnd() const { return const_iterator(d, capacity()); }
+
+    iterator erase(const_iterator it);
+    inline iterator erase(iterator it) { return erase(const_iterator(it)); }
+
+    iterator insert(const Key &akey, const T &avalue);
+    iterator find(const Key &akey);
+    const_iterator find(const Key &akey) const;
+    const_iterator constFind(const Key &akey) const;
+
+    // STL compatibility
+    typedef T mapped_type;
+    typedef Key key_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    void detach_helper();
+    void rehash(int newCapacity);
+    int findIndex(const Key &akey) const;
+    int prepareInsert(const Key &akey, signed char *h2);
+    void commitInsert(int n, signed char h2);
+    void eraseAt(int n);
+
+    static inline quint64 hashOf(const Key &akey, uint seed)
+    { return QFlatHashPrivate::mix(qHash(akey, seed)); }
+    static inline signed char controlFor(quint64 h) { return static_cast<signed char>(h & 0x7f); }
+
+    static Data *allocate(int capacity, uint seed);
+    static Data *copy(const Data *x);
+    static void freeData(Data *x);
+    static void setControl(Data *x, int n, signed char c);
+    static int findFree(const Data *x, quint64 h);
+    static int nextFull(const Data *x, int n);
+};
+
+template <class Key, class T>
+typename QFlatHash<Key, T>::Data *QFlatHash<Key, T>::allocate(int capacity, uint seed)
+{
+    const size_t controlBytes = size_t(capacity) + QFlatHashPrivate::GroupWidth - 1;
+    Data *x = new Data;
+    QT_TRY {
+        x->ctrl = new signed char[controlBytes];
+        QT_TRY {
+            x->nodes = static_cast<Node *>(::operator new(sizeof(Node) * size_t(capacity)));
+        } QT_CATCH(...) {
+            delete [] x->ctrl;
+            QT_RETHROW;
+        }
+    } QT_CATCH(...) {
+        delete x;
+        QT_RETHROW;
+    }
+    memset(x->ctrl, QFlatHashPrivate::Empty, controlBytes);
+    x->ref.initializeOwned();
+    x->size = 0;
+    x->capacity = capacity;
+    x->deleted = 0;
+    x->seed = seed;
+    return x;
+}
+
+template <class Key, class T>
+typename QFlatHash<Key, T>::Data *QFlatHash<Key, T>::copy(const Data *x)
+{
+    // keep every element in its slot, so that indexes stay valid
+    Data *c = allocate(x->capacity, x->seed);
+    QT_TRY {
+        for (int n = 0; n < x->capacity; ++n) {
+            if (x->ctrl[n] < 0)
+                continue;
+            new (c->nodes + n) Node(x->nodes[n]);
+            setControl(c, n, x->ctrl[n]);
+            ++c->size;
+        }
+    } QT_CATCH(...) {
+        freeData(c);
+        QT_RETHROW;
+    }
+    for (int n = 0; n < x->capacity; ++n) {
+        if (x->ctrl[n] == QFlatHashPrivate::Deleted)
+            setControl(c, n, QFlatHashPrivate::Deleted);
+    }
+    c->deleted = x->deleted;
+    return c;
+}
+
+template <class Key, class T>
+void QFlatHash<Key, T>::freeData(Data *x)
+{
+    if (QTypeInfo<Key>::isComplex || QTypeInfo<T>::isComplex) {
+        for (int n = 0; n < x->capacity; ++n) {
+            if (x->ctrl[n] >= 0)
+                x->nodes[n].~Node();
+        }
+    }
+    delete [] x->ctrl;
+    ::operator delete(x->nodes);
+    delete x;
+}
+
+template <class Key, class T>
+inline void QFlatHash<Key, T>::setControl(Data *x, int n, signed char c)
+{
+    x->ctrl[n] = c;
+    if (n < QFlatHashPrivate::GroupWidth - 1)
+        x->ctrl[x->capacity + n] = c;
+}
+
+template <class Key, class T>
+inline int QFlatHash<Key, T>::findFree(const Data *x, quint64 h)
+{
+    // triangular probing visits every group once the table size is a
+    // power of two; the load factor guarantees that a free slot exists
+    const uint mask = uint(x->capacity) - 1;
+    uint pos = uint(h >> 7) & mask;
+    for (uint step = QFlatHashPrivate::GroupWidth; ; step += QFlatHashPrivate::GroupWidth) {
+        if (const uint m = QFlatHashPrivate::Group(x->ctrl + pos).matchFree())
+            return int((pos + qCountTrailingZeroBits(m)) & mask);
+        pos = (pos + step) & mask;
+    }
+}
+
+template <class Key, class T>
+inline int QFlatHash<Key, T>::nextFull(const Data *x, int n)
+{
+    while (n < x->capacity) {
+        if (const uint m = QFlatHashPrivate::Group(x->ctrl + n).matchFull())
+            return qMin(n + int(qCountTrailingZeroBits(m)), x->capacity);
+        n += QFlatHashPrivate::GroupWidth;
+    }
+    return x->capacity;
+}
+
+template <class Key, class T>
+int QFlatHash<Key, T>::findIndex(const Key &akey) const
+{
+    if (!d || d->size == 0)
+        return -1;
+    const quint64 h = hashOf(akey, d->seed);
+    const signed char h2 = controlFor(h);
+    const uint mask = uint(d->capacity) - 1;
+    uint pos = uint(h >> 7) & mask;
+    for (uint step = QFlatHashPrivate::GroupWidth; ; step += QFlatHashPrivate::GroupWidth) {
+        const QFlatHashPrivate::Group group(d->ctrl + pos);
+        for (uint m = group.match(h2); m; m &= m - 1) {
+            const uint n = (pos + qCountTrailingZeroBits(m)) & mask;
+            if (d->nodes[n].key == akey)
+                return int(n);
+        }
+        if (group.matchEmpty())
+            return -1;
+        pos = (pos + step) & mask;
+    }
+}
+
+template <class Key, class T>
+void QFlatHash<Key, T>::rehash(int newCapacity)
+{
+    Data *x = allocate(newCapacity, d ? d->seed : uint(qGlobalQHashSeed()));
+    if (!d) {
+        d = x;
+        return;
+    }
+
+    const bool shared = d->ref.isShared();
+    QT_TRY {
+        for (int n = 0; n < d->capacity; ++n) {
+            if (d->ctrl[n] < 0)
+                continue;
+            Node &node = d->nodes[n];
+            const quint64 h = hashOf(node.key, x->seed);
+            const int slot = findFree(x, h);
+            if (shared)
+                new (x->nodes + slot) Node(node);
+            else
+                new (x->nodes + slot) Node(std::move(node));
+            setControl(x, slot, controlFor(h));
+            ++x->size;
+        }
+    } QT_CATCH(...) {
+        freeData(x);
+        QT_RETHROW;
+    }
+    if (!d->ref.deref())
+        freeData(d);
+    d = x;
+}
+
+template <class Key, class T>
+void QFlatHash<Key, T>::detach_helper()
+{
+    Data *x = copy(d);
+    if (!d->ref.deref())
+        freeData(d);
+    d = x;
+}
+
+template <class Key, class T>
+int QFlatHash<Key, T>::prepareInsert(const Key &akey, signed char *h2)
+{
+    if (!d) {
+        rehash(QFlatHashPrivate::MinimumCapacity);
+    } else if (d->size + d->deleted >= QFlatHashPrivate::maximumLoad(d->capacity)) {
+        // grow if the table is busy, or just drop the deleted slots
+        const bool grow = d->size >= d->capacity / 2 - d->capacity / 16;
+        rehash(grow ? d->capacity * 2 : d->capacity);
+    } else {
+        detach();
+    }
+    const quint64 h = hashOf(akey, d->seed);
+    *h2 = controlFor(h);
+    return findFree(d, h);
+}
+
+template <class Key, class T>
+inline void QFlatHash<Key, T>::commitInsert(int n, signed char h2)
+{
+    if (d->ctrl[n] == QFlatHashPrivate::Deleted)
+        --d->deleted;
+    setControl(d, n, h2);
+    ++d->size;
+}
+
+template <class Key, class T>
+void QFlatHash<Key, T>::eraseAt(int n)
+{
+    d->nodes[n].~Node();
+    --d->size;
+
+    // A slot can become empty again unless it is part of a run of at least
+    // GroupWidth non-empty slots: a lookup might have probed past it.
+    const uint mask = uint(d->capacity) - 1;
+    const uint emptyBefore = QFlatHashPrivate::Group(d->ctrl + ((uint(n) - QFlatHashPrivate::GroupWidth) & mask)).matchEmpty();
+    const uint emptyAfter = QFlatHashPrivate::Group(d->ctrl + n).matchEmpty();
+    if (qCountLeadingZeroBits(quint16(emptyBefore)) + qCountTrailingZeroBits(emptyAfter) < uint(QFlatHashPrivate::GroupWidth)) {
+        setControl(d, n, QFlatHashPrivate::Empty);
+    } else {
+        setControl(d, n, QFlatHashPrivate::Deleted);
+        ++d->deleted;
+    }
+}
+
+template <class Key, class T>
+void QFlatHash<Key, T>::reserve(int asize)
+{
+    const int newCapacity = QFlatHashPrivate::capacityFor(asize);
+    if (newCapacity > capacity())
+        rehash(newCapacity);
+    else
+        detach();
+}
+
+template <class Key, class T>
+void QFlatHash<Key, T>::squeeze()
+{
+    if (!d)
+        return;
+    if (d->size == 0) {
+        clear();
+        return;
+    }
+    const int newCapacity = QFlatHashPrivate::capacityFor(d->size);
+    if (newCapacity < d->capacity || d->deleted)
+        rehash(newCapacity);
+}
+
+template <class Key, class T>
+bool QFlatHash<Key, T>::operator==(const QFlatHash &other) const
+{
+    if (size() != other.size())
+        return false;
+    if (d == other.d)
+        return true;
+    for (int n = 0; n < d->capacity; ++n) {
+        if (d->ctrl[n] < 0)
+            continue;
+        const int o = other.findIndex(d->nodes[n].key);
+        if (o < 0 || !(other.d->nodes[o].value == d->nodes[n].value))
+            return false;
+    }
+    return true;
+}
+
+template <class Key, class T>
+int QFlatHash<Key, T>::remove(const Key &akey)
+{
+    const int n = findIndex(akey);
+    if (n < 0)
+        return 0;
+    detach();
+    eraseAt(n);
+    return 1;
+}
+
+template <class Key, class T>
+T QFlatHash<Key, T>::take(const Key &akey)
+{
+    const int n = findIndex(akey);
+    if (n < 0)
+        return T();
+    detach();
+    T t = std::move(d->nodes[n].value);
+    eraseAt(n);
+    return t;
+}
+
+template <class Key, class T>
+const Key QFlatHash<Key, T>::key(const T &avalue) const
+{
+    return key(avalue, Key());
+}
+
+template <class Key, class T>
+const Key QFlatHash<Key, T>::key(const T &avalue, const Key &defaultKey) const
+{
+    for (const_iterator it = constBegin(); it != constEnd(); ++it) {
+        if (it.value() == avalue)
+            return it.key();
+    }
+    return defaultKey;
+}
+
+template <class Key, class T>
+const T QFlatHash<Key, T>::value(const Key &akey) const
+{
+    const int n = findIndex(akey);
+    return n < 0 ? T() : d->nodes[n].value;
+}
+
+template <class Key, class T>
+const T QFlatHash<Key, T>::value(const Key &akey, const T &defaultValue) const
+{
+    const int n = findIndex(akey);
+    return n < 0 ? defaultValue : d->nodes[n].value;
+}
+
+template <class Key, class T>
+T &QFlatHash<Key, T>::operator[](const Key &akey)
+{
+    int n = findIndex(akey);
+    if (n >= 0) {
+        detach();
+        return d->nodes[n].value;
+    }
+    signed char h2;
+    n = prepareInsert(akey, &h2);
+    new (d->nodes + n) Node(akey, T());
+    commitInsert(n, h2);
+    return d->nodes[n].value;
+}
+
+template <class Key, class T>
+inline const T QFlatHash<Key, T>::operator[](const Key &akey) const
+{
+    return value(akey);
+}
+
+template <class Key, class T>
+QList<Key> QFlatHash<Key, T>::keys() const
+{
+    QList<Key> res;
+    res.reserve(size());
+    for (const_iterator it = constBegin(); it != constEnd(); ++it)
+        res.append(it.key());
+    return res;
+}
+
+template <class Key, class T>
+QList<T> QFlatHash<Key, T>::values() const
+{
+    QList<T> res;
+    res.reserve(size());
+    for (const_iterator it = constBegin(); it != constEnd(); ++it)
+        res.append(it.value());
+    return res;
+}
+
+template <class Key, class T>
+typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::insert(const Key &akey, const T &avalue)
+{
+    int n = findIndex(akey);
+    if (n >= 0) {
+        detach();
+        d->nodes[n].value = avalue;
+        return iterator(d, n);
+    }
+    signed char h2;
+    n = prepareInsert(akey, &h2);
+    new (d->nodes + n) Node(akey, avalue);
+    commitInsert(n, h2);
+    return iterator(d, n);
+}
+
+template <class Key, class T>
+typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::erase(const_iterator it)
+{
+    if (it == constEnd())
+        return end();
+    const int n = it.index;
+    // detaching keeps the elements in their slots
+    detach();
+    eraseAt(n);
+    return iterator(d, nextFull(d, n + 1));
+}
+
+template <class Key, class T>
+typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::find(const Key &akey)
+{
+    const int n = findIndex(akey);
+    detach();
+    return iterator(d, n < 0 ? capacity() : n);
+}
+
+template <class Key, class T>
+inline typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::find(const Key &akey) const
+{
+    return constFind(akey);
+}
+
+template <class Key, class T>
+typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::constFind(const Key &akey) const
+{
+    const int n = findIndex(akey);
+    return const_iterator(d, n < 0 ? capacity() : n);
+}
+
+QT_END_NAMESPACE
+
+#undef QT_FLATHASH_SSE2
+
+#endif // QFLATHASH_H
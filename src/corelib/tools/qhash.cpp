@@ -60,6 +60,7 @@
 #include <qbasicatomic.h>
 #include <qendian.h>
 #include <private/qsimd_p.h>
+#include <private/qarenaallocator_p.h>
 
 #ifndef QT_BOOTSTRAPPED
 #include <qcoreapplication.h>
@@ -197,12 +198,139 @@ static uint crc32(...)
 }
 #endif
 
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AES) && QT_COMPILER_SUPPORTS_HERE(SSE4_2)
+// keys shorter than one AES block are hashed faster by the CRC32 code
+enum { AesHashMinimumLength = 16 };
+
+static inline bool hasFastAesHash()
+{
+    return qCpuHasFeature(AES) && qCpuHasFeature(SSE4_2);
+}
+
+QT_FUNCTION_TARGET(AES)
+static uint aeshash(const uchar *p, size_t len, uint seed)
+{
+    // One AES round per 16-byte block, in four independent lanes so that
+    // the latency of the AESENC instruction is hidden. Not a cryptographic
+    // hash, but every bit of a block affects every bit of its lane.
+    Q_ASSERT(len >= AesHashMinimumLength);
+    const uchar *const e = p + len;
+    const __m128i key = _mm_aesenc_si128(_mm_set_epi32(int(seed), int(len), int(seed), int(len >> 31 >> 1)),
+                                         _mm_set1_epi32(int(seed)));
+    __m128i state0 = key;
+    __m128i state1 = _mm_aesenc_si128(key, key);
+    __m128i state2 = _mm_aesenc_si128(state1, key);
+    __m128i state3 = _mm_aesenc_si128(state2, key);
+
+    for ( ; p + 64 <= e; p += 64) {
+        state0 = _mm_aesenc_si128(_mm_xor_si128(state0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p))), key);
+        state1 = _mm_aesenc_si128(_mm_xor_si128(state1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16))), key);
+        state2 = _mm_aesenc_si128(_mm_xor_si128(state2, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 32))), key);
+        state3 = _mm_aesenc_si128(_mm_xor_si128(state3, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 48))), key);
+    }
+    for ( ; p + 16 <= e; p += 16)
+        state0 = _mm_aesenc_si128(_mm_xor_si128(state0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p))), key);
+    if (p != e) {
+        // the last, partial block overlaps the one before it
+        state1 = _mm_aesenc_si128(_mm_xor_si128(state1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(e - 16))), key);
+    }
+
+    __m128i h = _mm_aesenc_si128(_mm_xor_si128(state0, state1), _mm_xor_si128(state2, state3));
+    h = _mm_aesenc_si128(h, key);
+    h = _mm_aesenc_si128(h, key);
+    h = _mm_xor_si128(h, _mm_srli_si128(h, 8));
+    return uint(_mm_cvtsi128_si32(h) ^ _mm_extract_epi32(h, 1));
+}
+#else
+enum { AesHashMinimumLength = 0 };
+
+static inline bool hasFastAesHash()
+{
+    return false;
+}
+
+static uint aeshash(...)
+{
+    Q_UNREACHABLE();
+    return 0;
+}
+#endif
+
+// The 64x64 to 128-bit multiplication, with the halves of the result
+// folded into each other. It mixes the bits of both operands much faster
+// than any number of shifts and additions.
+static inline quint64 foldedMultiply(quint64 a, quint64 b)
+{
+#if defined(Q_CC_GNU) && defined(__SIZEOF_INT128__)
+    const QIntegerForSize<16>::Unsigned r = QIntegerForSize<16>::Unsigned(a) * b;
+    return quint64(r) ^ quint64(r >> 64);
+#elif defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86_64)
+    quint64 high;
+    const quint64 low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    const quint64 aLow = a & 0xffffffff, aHigh = a >> 32;
+    const quint64 bLow = b & 0xffffffff, bHigh = b >> 32;
+    const quint64 ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    const quint64 middle = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    const quint64 low = (ll & 0xffffffff) | (middle << 32);
+    const quint64 high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+static uint multiplyHash(const uchar *p, size_t len, uint seed) Q_DECL_NOTHROW
+{
+    // In the style of wyhash: 16 bytes per multiplication, in two
+    // independent lanes as long as there is enough input.
+    const quint64 k0 = Q_UINT64_C(0xa0761d6478bd642f);
+    const quint64 k1 = Q_UINT64_C(0xe7037ed1a0b428db);
+    const quint64 k2 = Q_UINT64_C(0x8ebc6af09c88c6e3);
+    const quint64 k3 = Q_UINT64_C(0x589965cc75374cc3);
+    const size_t total = len;
+    if (!len)
+        return seed;
+
+    quint64 h0 = seed ^ k0;
+    if (len > 32) {
+        quint64 h1 = h0;
+        for ( ; len > 32; p += 32, len -= 32) {
+            h0 = foldedMultiply(qFromUnaligned<quint64>(p) ^ k1, qFromUnaligned<quint64>(p + 8) ^ h0);
+            h1 = foldedMultiply(qFromUnaligned<quint64>(p + 16) ^ k2, qFromUnaligned<quint64>(p + 24) ^ h1);
+        }
+        h0 ^= h1;
+    }
+    for ( ; len > 16; p += 16, len -= 16)
+        h0 = foldedMultiply(qFromUnaligned<quint64>(p) ^ k1, qFromUnaligned<quint64>(p + 8) ^ h0);
+
+    // the remaining 0 to 16 bytes, read as two possibly overlapping words
+    quint64 a = 0;
+    quint64 b = 0;
+    if (len >= 8) {
+        a = qFromUnaligned<quint64>(p);
+        b = qFromUnaligned<quint64>(p + len - 8);
+    } else if (len >= 4) {
+        a = qFromUnaligned<quint32>(p);
+        b = qFromUnaligned<quint32>(p + len - 4);
+    } else if (len > 0) {
+        a = (quint64(p[0]) << 16) | (quint64(p[len >> 1]) << 8) | p[len - 1];
+    }
+    h0 = foldedMultiply(a ^ k1, b ^ h0);
+    h0 = foldedMultiply(h0 ^ k3, quint64(total) ^ k2);
+    return uint(h0 ^ (h0 >> 32));
+}
+
 static inline uint hash(const uchar *p, size_t len, uint seed) Q_DECL_NOTHROW
 {
     uint h = seed;
 
-    if (seed && hasFastCrc32())
-        return crc32(p, len, h);
+    if (seed) {
+        if (len >= size_t(AesHashMinimumLength) && hasFastAesHash())
+            return aeshash(p, len, h);
+        if (hasFastCrc32())
+            return crc32(p, len, h);
+        return multiplyHash(p, len, h);
+    }
 
     for (size_t i = 0; i < len; ++i)
         h = 31 * h + p[i];
@@ -219,8 +347,14 @@ static inline uint hash(const QChar *p, size_t len, uint seed) Q_DECL_NOTHROW
 {
     uint h = seed;
 
-    if (seed && hasFastCrc32())
-        return crc32(p, len, h);
+    if (seed) {
+        const uchar *bytes = reinterpret_cast<const uchar *>(p);
+        if (len * sizeof(QChar) >= size_t(AesHashMinimumLength) && hasFastAesHash())
+            return aeshash(bytes, len * sizeof(QChar), h);
+        if (hasFastCrc32())
+            return crc32(p, len, h);
+        return multiplyHash(bytes, len * sizeof(QChar), h);
+    }
 
     for (size_t i = 0; i < len; ++i)
         h = 31 * h + p[i].unicode();
@@ -476,13 +610,17 @@ const QHashData QHashData::shared_null = {
 
 void *QHashData::allocateNode(int nodeAlign)
 {
-    void *ptr = strictAlignment ? qMallocAligned(nodeSize, nodeAlign) : malloc(nodeSize);
+    void *ptr = QArenaAllocatorPrivate::allocate(nodeSize, qMax<size_t>(nodeAlign, sizeof(void *)));
+    if (!ptr)
+        ptr = strictAlignment ? qMallocAligned(nodeSize, nodeAlign) : malloc(nodeSize);
     Q_CHECK_PTR(ptr);
     return ptr;
 }
 
 void QHashData::freeNode(void *node)
 {
+    if (QArenaAllocatorPrivate::owns(node))
+        return;
     if (strictAlignment)
         qFreeAligned(node);
     else
@@ -196,43 +196,59 @@ void **QListData::append(const QListData& l)
 }
 
 void **QListData::prepend()
+{
+    return prepend(1);
+}
+
+// ensures that enough space is available to prepend n elements
+void **QListData::prepend(int n)
 {
     Q_ASSERT(!d->ref.isShared());
-    if (d->begin == 0) {
-        if (d->end >= d->alloc / 3)
-            realloc_grow(1);
+    if (d->begin < n) {
+        int size = d->end - d->begin;
+        if (size + n > d->alloc / 3)
+            realloc_grow(n);
 
-        if (d->end < d->alloc / 3)
-            d->begin = d->alloc - 2 * d->end;
+        int b;
+        if (size + n <= d->alloc / 3)
+            b = d->alloc - 2 * size;
         else
-            d->begin = d->alloc - d->end;
+            b = d->alloc - size;
 
-        ::memmove(d->array + d->begin, d->array, d->end * sizeof(void *));
-        d->end += d->begin;
+        ::memmove(d->array + b, d->array + d->begin, size * sizeof(void *));
+        d->begin = b;
+        d->end = b + size;
     }
-    return d->array + --d->begin;
+    d->begin -= n;
+    return d->array + d->begin;
 }
 
 void **QListData::insert(int i)
+{
+    return insert(i, 1);
+}
+
+// ensures that enough space is available to insert n elements at position i
+void **QListData::insert(int i, int n)
 {
     Q_ASSERT(!d->ref.isShared());
     if (i <= 0)
-        return prepend();
+        return prepend(n);
     int size = d->end - d->begin;
     if (i >= size)
-        return append();
+        return append(n);
 
     bool leftward = false;
 
-    if (d->begin == 0) {
-        if (d->end == d->alloc) {
+    if (d->begin < n) {
+        if (d->end + n > d->alloc) {
             // If the array is full, we expand it and move some items rightward
-            realloc_grow(1);
+            realloc_grow(n);
         } else {
             // If there is free space at the end of the array, we move some items rightward
         }
     } else {
-        if (d->end == d->alloc) {
+        if (d->end + n > d->alloc) {
             // If there is free space at the beginning of the array, we move some items leftward
             leftward = true;
         } else {
@@ -242,12 +258,12 @@ void **QListData::insert(int i)
     }
 
     if (leftward) {
-        --d->begin;
-        ::memmove(d->array + d->begin, d->array + d->begin + 1, i * sizeof(void *));
+        d->begin -= n;
+        ::memmove(d->array + d->begin, d->array + d->begin + n, i * sizeof(void *));
     } else {
-        ::memmove(d->array + d->begin + i + 1, d->array + d->begin + i,
+        ::memmove(d->array + d->begin + i + n, d->array + d->begin + i,
                   (size - i) * sizeof(void *));
-        ++d->end;
+        d->end += n;
     }
     return d->array + d->begin + i;
 }
@@ -392,6 +408,15 @@ void **QListData::erase(void **xi)
     choice for use cases that do a lot of appending or inserting, because
     QVector can allocate memory for many items in a single heap allocation.
 
+    Larger types can be stored directly in the array as well, if they are
+    movable and have been declared with \l Q_DECLARE_LIST_DIRECT_STORAGE.
+    Each item then takes as many array entries as needed to hold it, and
+    QList no longer allocates individual items. Qt can also be configured
+    with the \c qlist-direct-storage feature, which does this for all large
+    movable types, including QVariant and QModelIndex. As with QVector,
+    references and iterators to directly stored items become invalid when
+    the list is modified.
+
     Note that the internal array only ever gets bigger over the life
     of the list. It never shrinks. The internal array is deallocated
     by the destructor and by the assignment operator, when one list
@@ -1438,6 +1463,47 @@ void **QListData::erase(void **xi)
     Appends \a value to the list.
 */
 
+/*!
+    \class QListDirectStorage
+    \inmodule QtCore
+    \since 5.11
+    \brief The QListDirectStorage class decides whether QList stores items of
+    a type directly in its array.
+
+    The static \c value member is \c true if QList\<T\> keeps its items
+    in its internal array, as QVector does, even though they are larger than
+    a pointer. Otherwise, such items are allocated on the heap one by one.
+
+    By default, \c value is \c false, unless Qt was configured with the
+    \c qlist-direct-storage feature. Then it is \c true for all movable types
+    whose alignment is not stricter than a pointer's. Use
+    \l Q_DECLARE_LIST_DIRECT_STORAGE to enable direct storage for a type of
+    your own.
+
+    \sa QList, Q_DECLARE_TYPEINFO
+*/
+
+/*!
+    \macro Q_DECLARE_LIST_DIRECT_STORAGE(Type)
+    \relates QListDirectStorage
+    \since 5.11
+
+    Makes QList\<\a Type\> store its items directly in its internal array,
+    instead of allocating each item that is larger than a pointer on the heap.
+    This saves one memory allocation per item and makes iterating over the
+    list faster.
+
+    \a Type must be declared as \c Q_MOVABLE_TYPE or \c Q_PRIMITIVE_TYPE
+    with \l Q_DECLARE_TYPEINFO, and its alignment must not be stricter than a
+    pointer's. Like Q_DECLARE_TYPEINFO, the macro must be used right after the
+    declaration of \a Type, before any QList of it is instantiated.
+
+    \warning This changes the memory layout of QList\<\a Type\>. All code
+    that exchanges such lists must see the same declaration.
+
+    \sa QListDirectStorage
+*/
+
 /*! \class QList::iterator
     \inmodule QtCore
     \brief The QList::iterator class provides an STL-style non-const iterator for QList and QQueue.
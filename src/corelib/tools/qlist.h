@@ -106,7 +106,9 @@ struct Q_CORE_EXPORT QListData {
     void **append();
     void **append(const QListData &l);
     void **prepend();
+    void **prepend(int n);
     void **insert(int i);
+    void **insert(int i, int n);
     void remove(int i);
     void remove(int i, int n);
     void move(int from, int to);
@@ -117,6 +119,41 @@ struct Q_CORE_EXPORT QListData {
     inline void **end() const Q_DECL_NOTHROW { return d->array + d->end; }
 };
 
+template <typename T>
+struct QListDirectStorage
+{
+    enum {
+        value = QT_CONFIG(qlist_direct_storage)
+                && QTypeInfo<T>::isLarge && !QTypeInfo<T>::isStatic
+                && Q_ALIGNOF(T) <= Q_ALIGNOF(void *)
+    };
+};
+
+#define Q_DECLARE_LIST_DIRECT_STORAGE(TYPE) \
+template <> struct QListDirectStorage<TYPE> \
+{ \
+    enum { value = true }; \
+};
+
+namespace QtPrivate {
+template <typename T>
+struct QListNodeTraits
+{
+    enum {
+        isDirect = QListDirectStorage<T>::value,
+        // the element is allocated on the heap and the array holds a pointer to it
+        isIndirect = (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic) && !isDirect,
+        // number of array entries (void pointers) taken by one element
+        words = isDirect ? (sizeof(T) + sizeof(void *) - 1) / sizeof(void *) : 1
+    };
+    Q_STATIC_ASSERT_X(!isDirect || (!QTypeInfo<T>::isStatic && Q_ALIGNOF(T) <= Q_ALIGNOF(void *)),
+                      "QList can only store movable types with at most pointer alignment directly");
+};
+
+template <int Words> struct QListNodeStorage { void *v; void *tail[Words - 1]; };
+template <> struct QListNodeStorage<1> { void *v; };
+}
+
 template <typename T>
 class QList
 #ifndef Q_QDOC
@@ -127,26 +164,58 @@ public:
     struct MemoryLayout
         : std::conditional<
             // must stay isStatic until ### Qt 6 for BC reasons (don't use !isRelocatable)!
-            QTypeInfo<T>::isStatic || QTypeInfo<T>::isLarge,
+            QtPrivate::QListNodeTraits<T>::isIndirect,
             QListData::IndirectLayout,
             typename std::conditional<
-                sizeof(T) == sizeof(void*),
+                sizeof(T) == sizeof(void*) * QtPrivate::QListNodeTraits<T>::words,
                 QListData::ArrayCompatibleLayout,
                 QListData::InlineWithPaddingLayout
              >::type>::type {};
 private:
-    struct Node { void *v;
+    typedef QtPrivate::QListNodeTraits<T> NodeTraits;
+
+    // An element stored directly spans NodeTraits::words entries of the
+    // QListData array; all of QListData's indexes count entries, not elements.
+    struct Node : QtPrivate::QListNodeStorage<NodeTraits::words> {
 #if defined(Q_CC_BOR)
         Q_INLINE_TEMPLATE T &t();
 #else
         Q_INLINE_TEMPLATE T &t()
-        { return *reinterpret_cast<T*>(QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic
-                                       ? v : this); }
+        { return *reinterpret_cast<T*>(NodeTraits::isIndirect ? this->v : static_cast<void *>(this)); }
 #endif
     };
 
     union { QListData p; QListData::Data *d; };
 
+    inline int nodeCount() const Q_DECL_NOTHROW
+    { return NodeTraits::words == 1 ? p.size() : p.size() / int(NodeTraits::words); }
+    inline Node *nodeBegin() const Q_DECL_NOTHROW { return reinterpret_cast<Node *>(p.begin()); }
+    inline Node *nodeEnd() const Q_DECL_NOTHROW { return reinterpret_cast<Node *>(p.end()); }
+    inline Node *nodeAt(int i) const Q_DECL_NOTHROW { return nodeBegin() + i; }
+    inline Node *nodeAppend()
+    {
+        return reinterpret_cast<Node *>(NodeTraits::words == 1 ? p.append()
+                                                               : p.append(int(NodeTraits::words)));
+    }
+    inline Node *nodePrepend()
+    {
+        return reinterpret_cast<Node *>(NodeTraits::words == 1 ? p.prepend()
+                                                               : p.prepend(int(NodeTraits::words)));
+    }
+    inline Node *nodeInsert(int i)
+    {
+        return reinterpret_cast<Node *>(NodeTraits::words == 1 ? p.insert(i)
+                                                               : p.insert(i * int(NodeTraits::words), int(NodeTraits::words)));
+    }
+    inline void nodeRemove(int i)
+    {
+        if (NodeTraits::words == 1)
+            p.remove(i);
+        else
+            p.remove(i * int(NodeTraits::words), int(NodeTraits::words));
+    }
+    inline void nodeRemove(int i, int n) { p.remove(i * int(NodeTraits::words), n * int(NodeTraits::words)); }
+
 public:
     inline QList() Q_DECL_NOTHROW : d(const_cast<QListData::Data *>(&QListData::shared_null)) { }
     QList(const QList<T> &l);
@@ -167,7 +236,7 @@ public:
     bool operator==(const QList<T> &l) const;
     inline bool operator!=(const QList<T> &l) const { return !(*this == l); }
 
-    inline int size() const Q_DECL_NOTHROW { return p.size(); }
+    inline int size() const Q_DECL_NOTHROW { return nodeCount(); }
 
     inline void detach() { if (d->ref.isShared()) detach_helper(); }
 
@@ -340,8 +409,8 @@ public:
     // more Qt
     typedef iterator Iterator;
     typedef const_iterator ConstIterator;
-    inline int count() const { return p.size(); }
-    inline int length() const { return p.size(); } // Same as count()
+    inline int count() const { return nodeCount(); }
+    inline int length() const { return nodeCount(); } // Same as count()
     inline T& first() { Q_ASSERT(!isEmpty()); return *begin(); }
     inline const T& constFirst() const { return first(); }
     inline const T& first() const { Q_ASSERT(!isEmpty()); return at(0); }
@@ -426,13 +495,13 @@ private:
 #if defined(Q_CC_BOR)
 template <typename T>
 Q_INLINE_TEMPLATE T &QList<T>::Node::t()
-{ return QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic ? *(T*)v:*(T*)this; }
+{ return NodeTraits::isIndirect ? *(T*)this->v:*(T*)this; }
 #endif
 
 template <typename T>
 Q_INLINE_TEMPLATE void QList<T>::node_construct(Node *n, const T &t)
 {
-    if (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic) n->v = new T(t);
+    if (NodeTraits::isIndirect) n->v = new T(t);
     else if (QTypeInfo<T>::isComplex) new (n) T(t);
 #if (defined(__GNUC__) || defined(__INTEL_COMPILER) || defined(__IBMCPP__)) && !defined(__OPTIMIZE__)
     // This violates pointer aliasing rules, but it is known to be safe (and silent)
@@ -448,7 +517,7 @@ Q_INLINE_TEMPLATE void QList<T>::node_construct(Node *n, const T &t)
 template <typename T>
 Q_INLINE_TEMPLATE void QList<T>::node_destruct(Node *n)
 {
-    if (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic) delete reinterpret_cast<T*>(n->v);
+    if (NodeTraits::isIndirect) delete reinterpret_cast<T*>(n->v);
     else if (QTypeInfo<T>::isComplex) reinterpret_cast<T*>(n)->~T();
 }
 
@@ -456,7 +525,7 @@ template <typename T>
 Q_INLINE_TEMPLATE void QList<T>::node_copy(Node *from, Node *to, Node *src)
 {
     Node *current = from;
-    if (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic) {
+    if (NodeTraits::isIndirect) {
         QT_TRY {
             while(current != to) {
                 current->v = new T(*reinterpret_cast<T*>(src->v));
@@ -490,7 +559,7 @@ Q_INLINE_TEMPLATE void QList<T>::node_copy(Node *from, Node *to, Node *src)
 template <typename T>
 Q_INLINE_TEMPLATE void QList<T>::node_destruct(Node *from, Node *to)
 {
-    if (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic)
+    if (NodeTraits::isIndirect)
         while(from != to) --to, delete reinterpret_cast<T*>(to->v);
     else if (QTypeInfo<T>::isComplex)
         while (from != to) --to, reinterpret_cast<T*>(to)->~T();
@@ -515,11 +584,11 @@ inline typename QList<T>::iterator QList<T>::insert(iterator before, const T &t)
     if (d->ref.isShared())
         n = detach_helper_grow(iBefore, 1);
     else
-        n = reinterpret_cast<Node *>(p.insert(iBefore));
+        n = nodeInsert(iBefore);
     QT_TRY {
         node_construct(n, t);
     } QT_CATCH(...) {
-        p.remove(iBefore);
+        nodeRemove(iBefore);
         QT_RETHROW;
     }
     return n;
@@ -534,29 +603,33 @@ inline typename QList<T>::iterator QList<T>::erase(iterator it)
         it += offset;
     }
     node_destruct(it.i);
-    return reinterpret_cast<Node *>(p.erase(reinterpret_cast<void**>(it.i)));
+    if (NodeTraits::words == 1)
+        return reinterpret_cast<Node *>(p.erase(reinterpret_cast<void**>(it.i)));
+    const int i = int(it.i - nodeBegin());
+    nodeRemove(i);
+    return nodeAt(i);
 }
 template <typename T>
 inline const T &QList<T>::at(int i) const
-{ Q_ASSERT_X(i >= 0 && i < p.size(), "QList<T>::at", "index out of range");
- return reinterpret_cast<Node *>(p.at(i))->t(); }
+{ Q_ASSERT_X(i >= 0 && i < nodeCount(), "QList<T>::at", "index out of range");
+ return nodeAt(i)->t(); }
 template <typename T>
 inline const T &QList<T>::operator[](int i) const
-{ Q_ASSERT_X(i >= 0 && i < p.size(), "QList<T>::operator[]", "index out of range");
- return reinterpret_cast<Node *>(p.at(i))->t(); }
+{ Q_ASSERT_X(i >= 0 && i < nodeCount(), "QList<T>::operator[]", "index out of range");
+ return nodeAt(i)->t(); }
 template <typename T>
 inline T &QList<T>::operator[](int i)
-{ Q_ASSERT_X(i >= 0 && i < p.size(), "QList<T>::operator[]", "index out of range");
-  detach(); return reinterpret_cast<Node *>(p.at(i))->t(); }
+{ Q_ASSERT_X(i >= 0 && i < nodeCount(), "QList<T>::operator[]", "index out of range");
+  detach(); return nodeAt(i)->t(); }
 template <typename T>
 inline void QList<T>::removeAt(int i)
-{ if(i >= 0 && i < p.size()) { detach();
- node_destruct(reinterpret_cast<Node *>(p.at(i))); p.remove(i); } }
+{ if(i >= 0 && i < nodeCount()) { detach();
+ node_destruct(nodeAt(i)); nodeRemove(i); } }
 template <typename T>
 inline T QList<T>::takeAt(int i)
-{ Q_ASSERT_X(i >= 0 && i < p.size(), "QList<T>::take", "index out of range");
- detach(); Node *n = reinterpret_cast<Node *>(p.at(i)); T t = std::move(n->t()); node_destruct(n);
- p.remove(i); return t; }
+{ Q_ASSERT_X(i >= 0 && i < nodeCount(), "QList<T>::take", "index out of range");
+ detach(); Node *n = nodeAt(i); T t = std::move(n->t()); node_destruct(n);
+ nodeRemove(i); return t; }
 template <typename T>
 inline T QList<T>::takeFirst()
 { T t = std::move(first()); removeFirst(); return t; }
@@ -567,11 +640,12 @@ inline T QList<T>::takeLast()
 template <typename T>
 Q_OUTOFLINE_TEMPLATE void QList<T>::reserve(int alloc)
 {
-    if (d->alloc < alloc) {
+    const int words = alloc * int(NodeTraits::words);
+    if (d->alloc < words) {
         if (d->ref.isShared())
-            detach_helper(alloc);
+            detach_helper(words);
         else
-            p.realloc(alloc);
+            p.realloc(words);
     }
 }
 
@@ -583,23 +657,23 @@ Q_OUTOFLINE_TEMPLATE void QList<T>::append(const T &t)
         QT_TRY {
             node_construct(n, t);
         } QT_CATCH(...) {
-            --d->end;
+            d->end -= NodeTraits::words;
             QT_RETHROW;
         }
     } else {
-        if (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic) {
-            Node *n = reinterpret_cast<Node *>(p.append());
+        if (NodeTraits::isIndirect) {
+            Node *n = nodeAppend();
             QT_TRY {
                 node_construct(n, t);
             } QT_CATCH(...) {
-                --d->end;
+                d->end -= NodeTraits::words;
                 QT_RETHROW;
             }
         } else {
             Node *n, copy;
             node_construct(&copy, t); // t might be a reference to an object in the array
             QT_TRY {
-                n = reinterpret_cast<Node *>(p.append());;
+                n = nodeAppend();
             } QT_CATCH(...) {
                 node_destruct(&copy);
                 QT_RETHROW;
@@ -617,23 +691,23 @@ inline void QList<T>::prepend(const T &t)
         QT_TRY {
             node_construct(n, t);
         } QT_CATCH(...) {
-            ++d->begin;
+            d->begin += NodeTraits::words;
             QT_RETHROW;
         }
     } else {
-        if (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic) {
-            Node *n = reinterpret_cast<Node *>(p.prepend());
+        if (NodeTraits::isIndirect) {
+            Node *n = nodePrepend();
             QT_TRY {
                 node_construct(n, t);
             } QT_CATCH(...) {
-                ++d->begin;
+                d->begin += NodeTraits::words;
                 QT_RETHROW;
             }
         } else {
             Node *n, copy;
             node_construct(&copy, t); // t might be a reference to an object in the array
             QT_TRY {
-                n = reinterpret_cast<Node *>(p.prepend());;
+                n = nodePrepend();
             } QT_CATCH(...) {
                 node_destruct(&copy);
                 QT_RETHROW;
@@ -651,23 +725,23 @@ inline void QList<T>::insert(int i, const T &t)
         QT_TRY {
             node_construct(n, t);
         } QT_CATCH(...) {
-            p.remove(i);
+            nodeRemove(i);
             QT_RETHROW;
         }
     } else {
-        if (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic) {
-            Node *n = reinterpret_cast<Node *>(p.insert(i));
+        if (NodeTraits::isIndirect) {
+            Node *n = nodeInsert(i);
             QT_TRY {
                 node_construct(n, t);
             } QT_CATCH(...) {
-                p.remove(i);
+                nodeRemove(i);
                 QT_RETHROW;
             }
         } else {
             Node *n, copy;
             node_construct(&copy, t); // t might be a reference to an object in the array
             QT_TRY {
-                n = reinterpret_cast<Node *>(p.insert(i));;
+                n = nodeInsert(i);
             } QT_CATCH(...) {
                 node_destruct(&copy);
                 QT_RETHROW;
@@ -680,27 +754,36 @@ inline void QList<T>::insert(int i, const T &t)
 template <typename T>
 inline void QList<T>::replace(int i, const T &t)
 {
-    Q_ASSERT_X(i >= 0 && i < p.size(), "QList<T>::replace", "index out of range");
+    Q_ASSERT_X(i >= 0 && i < nodeCount(), "QList<T>::replace", "index out of range");
     detach();
-    reinterpret_cast<Node *>(p.at(i))->t() = t;
+    nodeAt(i)->t() = t;
 }
 
 template <typename T>
 inline void QList<T>::swap(int i, int j)
 {
-    Q_ASSERT_X(i >= 0 && i < p.size() && j >= 0 && j < p.size(),
+    Q_ASSERT_X(i >= 0 && i < nodeCount() && j >= 0 && j < nodeCount(),
                 "QList<T>::swap", "index out of range");
     detach();
-    std::swap(d->array[d->begin + i], d->array[d->begin + j]);
+    std::swap(*nodeAt(i), *nodeAt(j));
 }
 
 template <typename T>
 inline void QList<T>::move(int from, int to)
 {
-    Q_ASSERT_X(from >= 0 && from < p.size() && to >= 0 && to < p.size(),
+    Q_ASSERT_X(from >= 0 && from < nodeCount() && to >= 0 && to < nodeCount(),
                "QList<T>::move", "index out of range");
     detach();
-    p.move(from, to);
+    if (NodeTraits::words == 1) {
+        p.move(from, to);
+    } else if (from != to) {
+        Node t = *nodeAt(from);
+        if (from < to)
+            ::memmove(nodeAt(from), nodeAt(from + 1), (to - from) * sizeof(Node));
+        else
+            ::memmove(nodeAt(to + 1), nodeAt(to), (from - to) * sizeof(Node));
+        *nodeAt(to) = t;
+    }
 }
 
 template<typename T>
@@ -721,11 +804,9 @@ Q_OUTOFLINE_TEMPLATE QList<T> QList<T>::mid(int pos, int alength) const
     if (alength <= 0)
         return cpy;
     cpy.reserve(alength);
-    cpy.d->end = alength;
+    cpy.d->end = alength * NodeTraits::words;
     QT_TRY {
-        cpy.node_copy(reinterpret_cast<Node *>(cpy.p.begin()),
-                      reinterpret_cast<Node *>(cpy.p.end()),
-                      reinterpret_cast<Node *>(p.begin() + pos));
+        cpy.node_copy(cpy.nodeBegin(), cpy.nodeEnd(), nodeAt(pos));
     } QT_CATCH(...) {
         // restore the old end
         cpy.d->end = 0;
@@ -737,37 +818,42 @@ Q_OUTOFLINE_TEMPLATE QList<T> QList<T>::mid(int pos, int alength) const
 template<typename T>
 Q_OUTOFLINE_TEMPLATE T QList<T>::value(int i) const
 {
-    if (i < 0 || i >= p.size()) {
+    if (i < 0 || i >= nodeCount()) {
         return T();
     }
-    return reinterpret_cast<Node *>(p.at(i))->t();
+    return nodeAt(i)->t();
 }
 
 template<typename T>
 Q_OUTOFLINE_TEMPLATE T QList<T>::value(int i, const T& defaultValue) const
 {
-    return ((i < 0 || i >= p.size()) ? defaultValue : reinterpret_cast<Node *>(p.at(i))->t());
+    return ((i < 0 || i >= nodeCount()) ? defaultValue : nodeAt(i)->t());
 }
 
 template <typename T>
 Q_OUTOFLINE_TEMPLATE typename QList<T>::Node *QList<T>::detach_helper_grow(int i, int c)
 {
-    Node *n = reinterpret_cast<Node *>(p.begin());
-    QListData::Data *x = p.detach_grow(&i, c);
+    Node *n = nodeBegin();
+    QListData::Data *x;
+    if (NodeTraits::words == 1) {
+        x = p.detach_grow(&i, c);
+    } else {
+        // QListData clamps the index, which must not overflow when scaled
+        int idx = i < 0 ? -1 : qMin(i, nodeCount()) * int(NodeTraits::words);
+        x = p.detach_grow(&idx, c * int(NodeTraits::words));
+        i = idx / int(NodeTraits::words);
+    }
     QT_TRY {
-        node_copy(reinterpret_cast<Node *>(p.begin()),
-                  reinterpret_cast<Node *>(p.begin() + i), n);
+        node_copy(nodeBegin(), nodeAt(i), n);
     } QT_CATCH(...) {
         p.dispose();
         d = x;
         QT_RETHROW;
     }
     QT_TRY {
-        node_copy(reinterpret_cast<Node *>(p.begin() + i + c),
-                  reinterpret_cast<Node *>(p.end()), n + i);
+        node_copy(nodeAt(i + c), nodeEnd(), n + i);
     } QT_CATCH(...) {
-        node_destruct(reinterpret_cast<Node *>(p.begin()),
-                      reinterpret_cast<Node *>(p.begin() + i));
+        node_destruct(nodeBegin(), nodeAt(i));
         p.dispose();
         d = x;
         QT_RETHROW;
@@ -776,7 +862,7 @@ Q_OUTOFLINE_TEMPLATE typename QList<T>::Node *QList<T>::detach_helper_grow(int i
     if (!x->ref.deref())
         dealloc(x);
 
-    return reinterpret_cast<Node *>(p.begin() + i);
+    return nodeAt(i);
 }
 
 template <typename T>
@@ -856,7 +942,7 @@ inline bool QList<T>::op_eq_impl(const QList &l, QListData::ArrayCompatibleLayou
     const T *lb = reinterpret_cast<const T*>(l.p.begin());
     const T *b  = reinterpret_cast<const T*>(p.begin());
     const T *e  = reinterpret_cast<const T*>(p.end());
-    return std::equal(b, e, QT_MAKE_CHECKED_ARRAY_ITERATOR(lb, l.p.size()));
+    return std::equal(b, e, QT_MAKE_CHECKED_ARRAY_ITERATOR(lb, l.nodeCount()));
 }
 
 template <typename T>
@@ -884,7 +970,7 @@ Q_OUTOFLINE_TEMPLATE int QList<T>::removeAll(const T &_t)
     const T t = _t;
     detach();
 
-    Node *i = reinterpret_cast<Node *>(p.at(index));
+    Node *i = nodeAt(index);
     Node *e = reinterpret_cast<Node *>(p.end());
     Node *n = i;
     node_destruct(i);
@@ -896,7 +982,7 @@ Q_OUTOFLINE_TEMPLATE int QList<T>::removeAll(const T &_t)
     }
 
     int removedCount = int(e - n);
-    d->end -= removedCount;
+    d->end -= removedCount * NodeTraits::words;
     return removedCount;
 }
 
@@ -931,7 +1017,7 @@ Q_OUTOFLINE_TEMPLATE typename QList<T>::iterator QList<T>::erase(typename QList<
     for (Node *n = afirst.i; n < alast.i; ++n)
         node_destruct(n);
     int idx = afirst - begin();
-    p.remove(idx, alast - afirst);
+    nodeRemove(idx, int(alast - afirst));
     return begin() + idx;
 }
 
@@ -950,7 +1036,7 @@ Q_OUTOFLINE_TEMPLATE QList<T> &QList<T>::operator+=(const QList<T> &l)
                           reinterpret_cast<Node *>(l.p.begin()));
             } QT_CATCH(...) {
                 // restore the old end
-                d->end -= int(reinterpret_cast<Node *>(p.end()) - n);
+                d->end -= int(nodeEnd() - n) * NodeTraits::words;
                 QT_RETHROW;
             }
         }
@@ -968,9 +1054,9 @@ template <typename T>
 Q_OUTOFLINE_TEMPLATE int QList<T>::indexOf(const T &t, int from) const
 {
     if (from < 0)
-        from = qMax(from + p.size(), 0);
-    if (from < p.size()) {
-        Node *n = reinterpret_cast<Node *>(p.at(from -1));
+        from = qMax(from + nodeCount(), 0);
+    if (from < nodeCount()) {
+        Node *n = nodeAt(from -1);
         Node *e = reinterpret_cast<Node *>(p.end());
         while (++n != e)
             if (n->t() == t)
@@ -983,12 +1069,12 @@ template <typename T>
 Q_OUTOFLINE_TEMPLATE int QList<T>::lastIndexOf(const T &t, int from) const
 {
     if (from < 0)
-        from += p.size();
-    else if (from >= p.size())
-        from = p.size()-1;
+        from += nodeCount();
+    else if (from >= nodeCount())
+        from = nodeCount() - 1;
     if (from >= 0) {
         Node *b = reinterpret_cast<Node *>(p.begin());
-        Node *n = reinterpret_cast<Node *>(p.at(from + 1));
+        Node *n = nodeAt(from + 1);
         while (n-- != b) {
             if (n->t() == t)
                 return n - b;
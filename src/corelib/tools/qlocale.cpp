@@ -3003,6 +3003,178 @@ QString QLocalePrivate::dateTimeToString(QStringView format, const QDateTime &da
     return result;
 }
 
+static void appendCLocaleDecimalForm(QLocaleData::CharBuff *out, const char *digits, int length,
+                                     int decpt, int precision, PrecisionMode pm,
+                                     bool always_show_decpt)
+{
+    // Same layout as decimalForm(), without the intermediate QString
+    const int leadingZeros = decpt < 0 ? -decpt : 0;
+    if (decpt < 0)
+        decpt = 0;
+    int total = leadingZeros + qMax(length, decpt);
+    if (pm == PMDecimalDigits)
+        total = qMax(total, decpt + precision);
+    else if (pm == PMSignificantDigits)
+        total = qMax(total, precision);
+
+    auto digitAt = [&](int i) {
+        i -= leadingZeros;
+        return i >= 0 && i < length ? digits[i] : '0';
+    };
+
+    if (decpt == 0)
+        out->append('0');
+    for (int i = 0; i < decpt; ++i)
+        out->append(digitAt(i));
+    if (always_show_decpt || decpt < total)
+        out->append('.');
+    for (int i = decpt; i < total; ++i)
+        out->append(digitAt(i));
+}
+
+static void appendCLocaleExponentForm(QLocaleData::CharBuff *out, const char *digits, int length,
+                                      int decpt, int precision, PrecisionMode pm,
+                                      bool always_show_decpt, bool leading_zero_in_exponent)
+{
+    // Same layout as exponentForm(), without the intermediate QString
+    int total = length;
+    if (pm == PMDecimalDigits)
+        total = qMax(total, precision + 1);
+    else if (pm == PMSignificantDigits)
+        total = qMax(total, precision);
+
+    out->append(digits[0]);
+    if (always_show_decpt || total > 1)
+        out->append('.');
+    for (int i = 1; i < total; ++i)
+        out->append(i < length ? digits[i] : '0');
+
+    int exp = decpt - 1;
+    out->append('e');
+    out->append(exp < 0 ? '-' : '+');
+    if (exp < 0)
+        exp = -exp;
+    char expDigits[8];
+    int n = 0;
+    do {
+        expDigits[n++] = char('0' + exp % 10);
+        exp /= 10;
+    } while (exp);
+    if (leading_zero_in_exponent && n < 2)
+        expDigits[n++] = '0';
+    while (n)
+        out->append(expDigits[--n]);
+}
+
+/*!
+    \internal
+
+    Appends the C locale representation of \a d to \a out, in the same format
+    doubleToString() produces for zero '0', decimal point '.' and exponent
+    'e', but without the intermediate QString. \a flags must not contain
+    ThousandsGroup.
+*/
+void QLocaleData::doubleToCLocale(CharBuff *out, double d, int precision, DoubleForm form,
+                                  int width, unsigned flags)
+{
+    Q_ASSERT(!(flags & ThousandsGroup));
+    if (precision != QLocale::FloatingPointShortest && precision < 0)
+        precision = 6;
+
+    bool negative = false;
+    int decpt;
+    int bufSize = 1;
+    if (precision == QLocale::FloatingPointShortest)
+        bufSize += DoubleMaxSignificant;
+    else if (form == DFDecimal) // optimize for numbers between -512k and 512k
+        bufSize += ((d > (1 << 19) || d < -(1 << 19)) ? DoubleMaxDigitsBeforeDecimal : 6) +
+                precision;
+    else // Add extra digit due to different interpretations of precision. Also, "nan" has to fit.
+        bufSize += qMax(2, precision) + 1;
+
+    QVarLengthArray<char> buf(bufSize);
+    int length;
+
+    doubleToAscii(d, form, precision, buf.data(), bufSize, negative, length, decpt);
+
+    if (isZero(d))
+        negative = false;
+
+    // add sign
+    const int signStart = out->size();
+    if (negative)
+        out->append('-');
+    else if (flags & AlwaysShowSign)
+        out->append('+');
+    else if (flags & BlankBeforePositive)
+        out->append(' ');
+    const int start = out->size();
+
+    if (qstrncmp(buf.data(), "inf", 3) == 0 || qstrncmp(buf.data(), "nan", 3) == 0) {
+        out->append(buf.data(), length);
+    } else { // Handle normal numbers
+        bool always_show_decpt = (flags & ForcePoint);
+        switch (form) {
+            case DFExponent:
+                appendCLocaleExponentForm(out, buf.data(), length, decpt, precision,
+                                          PMDecimalDigits, always_show_decpt,
+                                          flags & ZeroPadExponent);
+                break;
+            case DFDecimal:
+                appendCLocaleDecimalForm(out, buf.data(), length, decpt, precision,
+                                         PMDecimalDigits, always_show_decpt);
+                break;
+            case DFSignificantDigits: {
+                PrecisionMode mode = (flags & AddTrailingZeroes) ?
+                            PMSignificantDigits : PMChopTrailingZeros;
+
+                int cutoff = precision < 0 ? 6 : precision;
+                // Find out which representation is shorter
+                if (precision == QLocale::FloatingPointShortest && decpt > 0) {
+                    cutoff = length + 4; // 'e', '+'/'-', one digit exponent
+                    if (decpt <= 10) {
+                        ++cutoff;
+                    } else {
+                        cutoff += decpt > 100 ? 2 : 1;
+                    }
+                    if (!always_show_decpt && length > decpt)
+                        ++cutoff; // decpt shown in exponent form, but not in decimal form
+                }
+
+                if (decpt != length && (decpt <= -4 || decpt > cutoff))
+                    appendCLocaleExponentForm(out, buf.data(), length, decpt, precision, mode,
+                                              always_show_decpt, flags & ZeroPadExponent);
+                else
+                    appendCLocaleDecimalForm(out, buf.data(), length, decpt, precision, mode,
+                                             always_show_decpt);
+                break;
+            }
+        }
+
+        // pad with zeros. LeftAdjusted overrides this flag). Also, we don't
+        // pad special numbers
+        if (flags & ZeroPadded && !(flags & LeftAdjusted)) {
+            const int oldSize = out->size();
+            // the sign, if any, already takes up space
+            const int num_pad_chars = width - (oldSize - signStart);
+            if (num_pad_chars > 0) {
+                out->resize(oldSize + num_pad_chars);
+                char *body = out->data() + start;
+                memmove(body + num_pad_chars, body, oldSize - start);
+                memset(body, '0', num_pad_chars);
+            }
+        }
+    }
+
+    if (flags & CapitalEorX) {
+        for (int i = start; i < out->size(); ++i) {
+            char &c = (*out)[i];
+            if (c >= 'a' && c <= 'z')
+                c -= 'a' - 'A';
+        }
+    }
+}
+
 QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
                                     int width, unsigned flags) const
 {
@@ -3014,6 +3186,13 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
                                     const QChar exponential, const QChar group, const QChar decimal,
                                     double d, int precision, DoubleForm form, int width, unsigned flags)
 {
+    if (_zero.unicode() == '0' && decimal.unicode() == '.' && exponential.unicode() == 'e'
+            && minus.unicode() == '-' && plus.unicode() == '+' && !(flags & ThousandsGroup)) {
+        CharBuff buf;
+        doubleToCLocale(&buf, d, precision, form, width, flags);
+        return QString::fromLatin1(buf.constData(), buf.size());
+    }
+
     if (precision != QLocale::FloatingPointShortest && precision < 0)
         precision = 6;
     if (width < 0)
@@ -217,6 +217,8 @@ public:
                                   double d, int precision,
                                   DoubleForm form,
                                   int width, unsigned flags);
+    static void doubleToCLocale(CharBuff *out, double d, int precision, DoubleForm form,
+                                int width, unsigned flags);
     static QString longLongToString(const QChar zero, const QChar group,
                                     const QChar plus, const QChar minus,
                                     qint64 l, int precision, int base,
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qmap.h"
+#include <private/qarenaallocator_p.h>
 
 #include <stdlib.h>
 
@@ -167,6 +168,33 @@ void QMapDataBase::rebalance(QMapNodeBase *x)
     root->setColor(QMapNodeBase::Black);
 }
 
+static inline int qMapAlignmentThreshold()
+{
+    // malloc on 32-bit platforms should return pointers that are 8-byte
+    // aligned or more while on 64-bit platforms they should be 16-byte aligned
+    // or more
+    return 2 * sizeof(void*);
+}
+
+static inline void *qMapAllocate(int alloc, int alignment)
+{
+    if (void *ptr = QArenaAllocatorPrivate::allocate(alloc, qMax<size_t>(alignment, sizeof(void *))))
+        return ptr;
+    return alignment > qMapAlignmentThreshold()
+        ? qMallocAligned(alloc, alignment)
+        : ::malloc(alloc);
+}
+
+static inline void qMapDeallocate(QMapNodeBase *node, int alignment)
+{
+    if (QArenaAllocatorPrivate::owns(node))
+        return;
+    if (alignment > qMapAlignmentThreshold())
+        qFreeAligned(node);
+    else
+        ::free(node);
+}
+
 void QMapDataBase::freeNodeAndRebalance(QMapNodeBase *z)
 {
     QMapNodeBase *&root = header.left;
@@ -290,7 +318,7 @@ void QMapDataBase::freeNodeAndRebalance(QMapNodeBase *z)
     if (x)
         x->setColor(QMapNodeBase::Black);
     }
-    free(y);
+    qMapDeallocate(y, 0);
     --size;
 }
 
@@ -301,29 +329,6 @@ void QMapDataBase::recalcMostLeftNode()
         mostLeftNode = mostLeftNode->left;
 }
 
-static inline int qMapAlignmentThreshold()
-{
-    // malloc on 32-bit platforms should return pointers that are 8-byte
-    // aligned or more while on 64-bit platforms they should be 16-byte aligned
-    // or more
-    return 2 * sizeof(void*);
-}
-
-static inline void *qMapAllocate(int alloc, int alignment)
-{
-    return alignment > qMapAlignmentThreshold()
-        ? qMallocAligned(alloc, alignment)
-        : ::malloc(alloc);
-}
-
-static inline void qMapDeallocate(QMapNodeBase *node, int alignment)
-{
-    if (alignment > qMapAlignmentThreshold())
-        qFreeAligned(node);
-    else
-        ::free(node);
-}
-
 QMapNodeBase *QMapDataBase::createNode(int alloc, int alignment, QMapNodeBase *parent, bool left)
 {
     QMapNodeBase *node = static_cast<QMapNodeBase *>(qMapAllocate(alloc, alignment));
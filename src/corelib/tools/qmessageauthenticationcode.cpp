@@ -111,6 +111,16 @@ static int qt_hash_block_size(QCryptographicHash::Algorithm method)
     case QCryptographicHash::RealSha3_512:
     case QCryptographicHash::Keccak_512:
         return 72;
+    case QCryptographicHash::Blake2b_160:
+    case QCryptographicHash::Blake2b_256:
+    case QCryptographicHash::Blake2b_384:
+    case QCryptographicHash::Blake2b_512:
+        return 128;
+    case QCryptographicHash::Blake2s_128:
+    case QCryptographicHash::Blake2s_160:
+    case QCryptographicHash::Blake2s_224:
+    case QCryptographicHash::Blake2s_256:
+        return 64;
     }
     return 0;
 }
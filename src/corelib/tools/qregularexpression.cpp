@@ -43,8 +43,10 @@
 
 #ifndef QT_NO_REGULAREXPRESSION
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qreadwritelock.h>
 #include <QtCore/qvector.h>
 #include <QtCore/qstringlist.h>
@@ -846,6 +848,9 @@ struct QRegularExpressionPrivate : QSharedData
     ~QRegularExpressionPrivate();
     QRegularExpressionPrivate(const QRegularExpressionPrivate &other);
 
+    static QExplicitlySharedDataPointer<QRegularExpressionPrivate>
+    cachedPrivate(const QString &pattern, QRegularExpression::PatternOptions patternOptions);
+
     void cleanCompiledPattern();
     void compilePattern();
     void getPatternInfo();
@@ -856,6 +861,7 @@ struct QRegularExpressionPrivate : QSharedData
     };
 
     void optimizePattern(OptimizePatternOption option);
+    void autoOptimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -871,15 +877,20 @@ struct QRegularExpressionPrivate : QSharedData
                                             CheckSubjectStringOption checkSubjectStringOption = CheckSubjectString,
                                             const QRegularExpressionMatchPrivate *previous = 0) const;
 
+    bool doHasMatch(QStringView subject,
+                    int offset,
+                    QRegularExpression::MatchOptions matchOptions) const;
+
     int captureIndexForName(QStringView name) const;
 
     // sizeof(QSharedData) == 4, so start our members with an enum
     QRegularExpression::PatternOptions patternOptions;
     QString pattern;
 
-    // *All* of the following members are managed while holding this mutex,
-    // except for isDirty which is set to true by QRegularExpression setters
-    // (right after a detach happened).
+    // *All* of the following members are managed while holding this mutex.
+    // Privates are shared through cachedPrivate() by unrelated objects, even
+    // in different threads, so the QRegularExpression setters never modify
+    // them: they replace them instead.
     mutable QReadWriteLock mutex;
 
     // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
@@ -891,6 +902,7 @@ struct QRegularExpressionPrivate : QSharedData
     int capturingCount;
     unsigned int usedCount;
     bool usingCrLfNewlines;
+    bool isOptimized;
     bool isDirty;
 };
 
@@ -960,6 +972,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate()
       capturingCount(0),
       usedCount(0),
       usingCrLfNewlines(false),
+      isOptimized(false),
       isDirty(true)
 {
 }
@@ -992,10 +1005,80 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
       capturingCount(0),
       usedCount(0),
       usingCrLfNewlines(false),
+      isOptimized(false),
       isDirty(true)
 {
 }
 
+namespace {
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+
+    bool operator==(const QRegularExpressionCacheKey &other) const
+    {
+        return patternOptions == other.patternOptions && pattern == other.pattern;
+    }
+};
+
+uint qHash(const QRegularExpressionCacheKey &key, uint seed = 0) Q_DECL_NOTHROW
+{
+    return qHash(key.pattern, seed) ^ uint(key.patternOptions);
+}
+
+struct QRegularExpressionCache
+{
+    // Compiled patterns, and their JIT code, are not small; keep only the
+    // most recently used ones around.
+    enum { MaximumEntries = 64 };
+
+    QRegularExpressionCache() : entries(MaximumEntries) {}
+
+    QMutex mutex;
+    QCache<QRegularExpressionCacheKey, QRegularExpression> entries;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QRegularExpressionCache, regularExpressionCache)
+
+/*!
+    \internal
+
+    Returns a private for the given \a pattern and \a patternOptions, shared
+    with all the other QRegularExpression objects of the process built from
+    the same pattern and options. This way a pattern is compiled, and
+    JIT-compiled, only once, no matter how many objects use it.
+
+    The returned private must not be modified; the QRegularExpression setters
+    call this function again instead.
+*/
+QExplicitlySharedDataPointer<QRegularExpressionPrivate>
+QRegularExpressionPrivate::cachedPrivate(const QString &pattern, QRegularExpression::PatternOptions patternOptions)
+{
+    QRegularExpressionCache *cache = regularExpressionCache();
+    if (Q_UNLIKELY(!cache)) {
+        // called during the destruction of the statics
+        QExplicitlySharedDataPointer<QRegularExpressionPrivate> d(new QRegularExpressionPrivate);
+        d->pattern = pattern;
+        d->patternOptions = patternOptions;
+        return d;
+    }
+
+    QRegularExpressionCacheKey key = { pattern, patternOptions };
+
+    const QMutexLocker lock(&cache->mutex);
+    if (QRegularExpression *re = cache->entries.object(key))
+        return re->d;
+
+    QRegularExpressionPrivate *d = new QRegularExpressionPrivate;
+    d->pattern = pattern;
+    d->patternOptions = patternOptions;
+    QRegularExpression *re = new QRegularExpression(*d);
+    cache->entries.insert(key, re);
+    return re->d;
+}
+
 /*!
     \internal
 */
@@ -1008,6 +1091,7 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
     capturingCount = 0;
     usedCount = 0;
     usingCrLfNewlines = false;
+    isOptimized = false;
 }
 
 /*!
@@ -1015,6 +1099,15 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
 */
 void QRegularExpressionPrivate::compilePattern()
 {
+    {
+        // privates coming from the cache are shared by all the objects with
+        // the same pattern and have been compiled long ago; don't serialize
+        // all of their matches on the write lock below
+        const QReadLocker lock(&mutex);
+        if (!isDirty)
+            return;
+    }
+
     const QWriteLocker lock(&mutex);
 
     if (!isDirty)
@@ -1117,6 +1210,77 @@ static pcre2_jit_stack_16 *qtPcreCallback(void *)
     return 0;
 }
 
+/*
+    The match context and the match data used by the matches performed in a
+    thread, kept around in a QThreadStorage so that matching does not need to
+    create and destroy them every time.
+*/
+class QPcreMatchScratch
+{
+    Q_DISABLE_COPY(QPcreMatchScratch)
+
+public:
+    /*!
+        \internal
+    */
+    QPcreMatchScratch()
+        : matchContext(pcre2_match_context_create_16(NULL)),
+          matchData(0),
+          matchDataPairs(0)
+    {
+        pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, NULL);
+    }
+    /*!
+        \internal
+    */
+    ~QPcreMatchScratch()
+    {
+        pcre2_match_data_free_16(matchData);
+        pcre2_match_context_free_16(matchContext);
+    }
+
+    /*!
+        \internal
+
+        Returns a match data block with room for at least \a pairs pairs of
+        offsets; it's only reallocated when a pattern needs a larger one.
+    */
+    pcre2_match_data_16 *matchDataFor(int pairs)
+    {
+        if (pairs > matchDataPairs) {
+            pcre2_match_data_free_16(matchData);
+            matchData = pcre2_match_data_create_16(pairs, NULL);
+            matchDataPairs = pairs;
+        }
+        return matchData;
+    }
+
+    pcre2_match_context_16 *matchContext;
+    pcre2_match_data_16 *matchData;
+    int matchDataPairs;
+};
+
+Q_GLOBAL_STATIC(QThreadStorage<QPcreMatchScratch *>, matchScratches)
+
+/*!
+    \internal
+
+    Returns the match scratch of the current thread. During the destruction of
+    the statics a new one is created and stored into \a fallback.
+*/
+static QPcreMatchScratch *localMatchScratch(QScopedPointer<QPcreMatchScratch> &fallback)
+{
+    QThreadStorage<QPcreMatchScratch *> *storage = matchScratches();
+    if (Q_UNLIKELY(!storage)) {
+        fallback.reset(new QPcreMatchScratch);
+        return fallback.data();
+    }
+
+    if (!storage->hasLocalData())
+        storage->setLocalData(new QPcreMatchScratch);
+    return storage->localData();
+}
+
 /*!
     \internal
 */
@@ -1159,12 +1323,42 @@ void QRegularExpressionPrivate::optimizePattern(OptimizePatternOption option)
     if (!enableJit)
         return;
 
+    {
+        const QReadLocker lock(&mutex);
+        if (isOptimized)
+            return;
+    }
+
     const QWriteLocker lock(&mutex);
 
-    if ((option == LazyOptimizeOption) && (++usedCount != qt_qregularexpression_optimize_after_use_count))
+    if (isOptimized)
+        return;
+
+    if ((option == LazyOptimizeOption) && (++usedCount < qt_qregularexpression_optimize_after_use_count))
         return;
 
     pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    isOptimized = true;
+}
+
+/*!
+    \internal
+
+    Optimizes the pattern as requested by its pattern options; called before
+    every match.
+*/
+void QRegularExpressionPrivate::autoOptimizePattern()
+{
+    if (patternOptions & QRegularExpression::DontAutomaticallyOptimizeOption)
+        return;
+
+    const OptimizePatternOption optimizePatternOption =
+            (patternOptions & QRegularExpression::OptimizeOnFirstUsageOption)
+                ? ImmediateOptimizeOption
+                : LazyOptimizeOption;
+
+    // this is mutex protected
+    optimizePattern(optimizePatternOption);
 }
 
 /*!
@@ -1275,15 +1469,7 @@ QRegularExpressionMatchPrivate *QRegularExpressionPrivate::doMatch(const QString
         return priv;
     }
 
-    if (!(patternOptions & QRegularExpression::DontAutomaticallyOptimizeOption)) {
-        const OptimizePatternOption optimizePatternOption =
-                (patternOptions & QRegularExpression::OptimizeOnFirstUsageOption)
-                    ? ImmediateOptimizeOption
-                    : LazyOptimizeOption;
-
-        // this is mutex protected
-        const_cast<QRegularExpressionPrivate *>(this)->optimizePattern(optimizePatternOption);
-    }
+    const_cast<QRegularExpressionPrivate *>(this)->autoOptimizePattern();
 
     int pcreOptions = convertToPcreOptions(matchOptions);
 
@@ -1301,9 +1487,10 @@ QRegularExpressionMatchPrivate *QRegularExpressionPrivate::doMatch(const QString
         previousMatchWasEmpty = true;
     }
 
-    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(NULL);
-    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, NULL);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, NULL);
+    QScopedPointer<QPcreMatchScratch> fallbackScratch;
+    QPcreMatchScratch *scratch = localMatchScratch(fallbackScratch);
+    pcre2_match_context_16 *matchContext = scratch->matchContext;
+    pcre2_match_data_16 *matchData = scratch->matchDataFor(capturingCount + 1);
 
     const unsigned short * const subjectUtf16 = subject.utf16() + subjectStart;
 
@@ -1404,12 +1591,60 @@ QRegularExpressionMatchPrivate *QRegularExpressionPrivate::doMatch(const QString
         }
     }
 
-    pcre2_match_data_free_16(matchData);
-    pcre2_match_context_free_16(matchContext);
-
     return priv;
 }
 
+/*!
+    \internal
+
+    Returns whether the pattern matches the \a subject string, starting from
+    \a offset (counted from the end of \a subject if negative) and honoring
+    \a matchOptions.
+
+    Unlike doMatch(), no QRegularExpressionMatchPrivate is created and the
+    captured substrings are never extracted: the match data is just large
+    enough for PCRE to report whether a match was found at all.
+*/
+bool QRegularExpressionPrivate::doHasMatch(QStringView subject,
+                                           int offset,
+                                           QRegularExpression::MatchOptions matchOptions) const
+{
+    const int subjectLength = int(subject.size());
+    if (offset < 0)
+        offset += subjectLength;
+
+    if (offset < 0 || offset > subjectLength)
+        return false;
+
+    if (Q_UNLIKELY(!compiledPattern)) {
+        qWarning("QRegularExpressionPrivate::doHasMatch(): called on an invalid QRegularExpression object");
+        return false;
+    }
+
+    const_cast<QRegularExpressionPrivate *>(this)->autoOptimizePattern();
+
+    const int pcreOptions = convertToPcreOptions(matchOptions);
+
+    // PCRE refuses null subjects, even empty ones
+    static const ushort emptySubject = 0;
+    const ushort *subjectUtf16 = subject.isNull()
+            ? &emptySubject
+            : reinterpret_cast<const ushort *>(subject.utf16());
+
+    QScopedPointer<QPcreMatchScratch> fallbackScratch;
+    QPcreMatchScratch *scratch = localMatchScratch(fallbackScratch);
+
+    const QReadLocker lock(&mutex);
+
+    // a result of 0 means that the match data was too small to hold the
+    // captures, which we don't care about anyway
+    const int result = safe_pcre2_match_16(compiledPattern,
+                                           subjectUtf16, subjectLength,
+                                           offset, pcreOptions,
+                                           scratch->matchDataFor(1), scratch->matchContext);
+    return result >= 0;
+}
+
 /*!
     \internal
 */
@@ -1492,10 +1727,8 @@ QRegularExpression::QRegularExpression()
     \sa setPattern(), setPatternOptions()
 */
 QRegularExpression::QRegularExpression(const QString &pattern, PatternOptions options)
-    : d(new QRegularExpressionPrivate)
+    : d(QRegularExpressionPrivate::cachedPrivate(pattern, options))
 {
-    d->pattern = pattern;
-    d->patternOptions = options;
 }
 
 /*!
@@ -1550,9 +1783,7 @@ QString QRegularExpression::pattern() const
 */
 void QRegularExpression::setPattern(const QString &pattern)
 {
-    d.detach();
-    d->isDirty = true;
-    d->pattern = pattern;
+    d = QRegularExpressionPrivate::cachedPrivate(pattern, d->patternOptions);
 }
 
 /*!
@@ -1573,9 +1804,7 @@ QRegularExpression::PatternOptions QRegularExpression::patternOptions() const
 */
 void QRegularExpression::setPatternOptions(PatternOptions options)
 {
-    d.detach();
-    d->isDirty = true;
-    d->patternOptions = options;
+    d = QRegularExpressionPrivate::cachedPrivate(d->pattern, options);
 }
 
 /*!
@@ -1756,6 +1985,28 @@ QRegularExpressionMatch QRegularExpression::match(const QStringRef &subjectRef,
     return QRegularExpressionMatch(*priv);
 }
 
+/*!
+    \since 5.11
+
+    Returns \c true if the regular expression matches the \a subject string,
+    starting at the position \a offset inside the subject and honoring the
+    given \a matchOptions; returns \c false otherwise, including when the
+    regular expression is not valid.
+
+    This is equivalent to \c{match(subject, offset, NormalMatch,
+    matchOptions).hasMatch()}, but it does not allocate memory for the result
+    nor extract the captured substrings, which makes it the fastest way of
+    testing strings against a pattern.
+
+    \sa match(), QRegularExpressionMatch::hasMatch()
+*/
+bool QRegularExpression::hasMatch(QStringView subject, int offset, MatchOptions matchOptions) const
+{
+    d.data()->compilePattern();
+
+    return d->doHasMatch(subject, offset, matchOptions);
+}
+
 /*!
     Attempts to perform a global match of the regular expression against the
     given \a subject string, starting at the position \a offset inside the
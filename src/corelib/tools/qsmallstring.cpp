@@ -0,0 +1,486 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsmallstring.h"
+
+#include <private/qutfcodec_p.h>
+
+QT_BEGIN_NAMESPACE
+
+void qt_from_latin1(ushort *dst, const char *str, size_t size) Q_DECL_NOTHROW;
+
+/*!
+    \class QSmallString
+    \inmodule QtCore
+    \since 5.11
+    \brief The QSmallString class provides an immutable Unicode string that
+    stores short strings without allocating memory.
+    \reentrant
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    Every non-empty QString allocates a block of memory for its data, which
+    is costly for code such as parsers that create a large number of short
+    strings, for example identifiers and keys. A QSmallString stores
+    strings of up to InlineCapacity UTF-16 code units inside the object
+    itself. Longer strings are kept in an implicitly shared QString, so that
+    converting between QString and QSmallString never copies them.
+
+    QSmallString provides the read-only part of the string API: the data
+    can be accessed through constData(), at() and iterators, and a
+    QSmallString converts implicitly to QStringView, so it can be passed to
+    all functions taking one. It can be compared with QString and
+    QLatin1String, used as a key of QHash, and it participates in
+    QStringBuilder expressions. Use toString() to obtain a QString for
+    modification.
+
+    \code
+    QHash<QSmallString, int> counts;
+    for (QStringView word : words)
+        ++counts[QSmallString(word)];   // no allocation for short words
+    \endcode
+
+    \sa QString, QStringView
+*/
+
+/*!
+    \enum QSmallString::anonymous
+
+    \value InlineCapacity The maximum number of UTF-16 code units that are
+    stored without allocating memory.
+*/
+
+/*!
+    \typedef QSmallString::value_type
+
+    Alias for QChar. Provided for compatibility with the STL.
+*/
+
+/*!
+    \typedef QSmallString::const_iterator
+
+    Alias for \c{const QChar *}. Provided for compatibility with the STL.
+*/
+
+/*!
+    \typedef QSmallString::const_pointer
+
+    Alias for \c{const QChar *}. Provided for compatibility with the STL.
+*/
+
+/*!
+    \typedef QSmallString::const_reference
+
+    Alias for \c{const QChar &}. Provided for compatibility with the STL.
+*/
+
+/*!
+    \typedef QSmallString::size_type
+
+    Alias for \c int. Provided for compatibility with the STL.
+*/
+
+/*!
+    \fn QSmallString::QSmallString()
+
+    Constructs an empty string.
+*/
+
+/*!
+    \fn QSmallString::QSmallString(QStringView str)
+
+    Constructs a copy of the string viewed by \a str.
+*/
+
+/*!
+    \fn QSmallString::QSmallString(const QChar *str, int size)
+
+    Constructs a string from the first \a size characters of \a str.
+*/
+
+/*!
+    Constructs a copy of \a str. If \a str is longer than InlineCapacity,
+    its data is shared instead of copied.
+*/
+QSmallString::QSmallString(const QString &str)
+{
+    if (str.size() <= int(InlineCapacity)) {
+        memcpy(m_storage.chars, str.constData(), str.size() * sizeof(QChar));
+        m_storage.chars[InlineCapacity] = ushort(str.size());
+    } else {
+        initHeap(str);
+    }
+}
+
+/*!
+    Constructs a string from the Latin-1 string \a str.
+*/
+QSmallString::QSmallString(QLatin1String str)
+{
+    if (str.size() <= int(InlineCapacity)) {
+        qt_from_latin1(m_storage.chars, str.data(), size_t(str.size()));
+        m_storage.chars[InlineCapacity] = ushort(str.size());
+    } else {
+        initHeap(QString(str));
+    }
+}
+
+/*!
+    \fn QSmallString::QSmallString(const QSmallString &other)
+
+    Constructs a copy of \a other.
+*/
+
+/*!
+    \fn QSmallString::QSmallString(QSmallString &&other)
+
+    Move-constructs a QSmallString instance, making it point at the same
+    object that \a other was pointing to.
+*/
+
+/*!
+    \fn QSmallString::~QSmallString()
+
+    Destroys the string.
+*/
+
+/*!
+    \fn QSmallString &QSmallString::operator=(const QSmallString &other)
+
+    Assigns \a other to this string and returns a reference to this string.
+*/
+
+/*!
+    \fn QSmallString &QSmallString::operator=(QSmallString &&other)
+
+    Move-assigns \a other to this QSmallString instance.
+*/
+
+/*!
+    \fn void QSmallString::swap(QSmallString &other)
+
+    Swaps this string with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Returns a string decoded from the first \a size bytes of the UTF-8
+    string \a str. If \a size is -1, the length of \a str is determined
+    with strlen().
+
+    Strings that decode to at most InlineCapacity code units are decoded
+    without allocating memory.
+
+    \sa QString::fromUtf8()
+*/
+QSmallString QSmallString::fromUtf8(const char *str, int size)
+{
+    if (!str)
+        return QSmallString();
+    if (size < 0)
+        size = int(strlen(str));
+
+    // a UTF-8 sequence of n bytes decodes to at most n code units
+    if (size <= 3 * int(InlineCapacity)) {
+        QChar buffer[3 * InlineCapacity];
+        const QChar *end = QUtf8::convertToUnicode(buffer, str, size);
+        return QSmallString(buffer, int(end - buffer));
+    }
+    QSmallString result;
+    result.initHeap(QString::fromUtf8(str, size));
+    return result;
+}
+
+/*!
+    \fn QSmallString QSmallString::fromUtf8(const QByteArray &str)
+    \overload
+
+    Returns a string decoded from the UTF-8 data in \a str.
+*/
+
+/*!
+    \fn QSmallString QSmallString::fromLatin1(const char *str, int size)
+
+    Returns a string decoded from the first \a size bytes of the Latin-1
+    string \a str. If \a size is -1, the length of \a str is determined
+    with strlen().
+*/
+
+/*!
+    \fn bool QSmallString::isInline() const
+
+    Returns \c true if the string is stored inside the object; otherwise
+    returns \c false, if the string was longer than InlineCapacity and its
+    data is held by a QString.
+*/
+
+/*!
+    \fn int QSmallString::size() const
+
+    Returns the number of UTF-16 code units in the string.
+
+    \sa length(), isEmpty()
+*/
+
+/*!
+    \fn int QSmallString::length() const
+
+    Same as size().
+*/
+
+/*!
+    \fn bool QSmallString::isEmpty() const
+
+    Returns \c true if the string has no characters; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn const QChar *QSmallString::constData() const
+
+    Returns a pointer to the data of the string. The data is not
+    null-terminated. The pointer remains valid as long as the string is not
+    modified or destroyed; note that moving an inline string moves its data.
+*/
+
+/*!
+    \fn const QChar *QSmallString::data() const
+
+    Same as constData().
+*/
+
+/*!
+    \fn const ushort *QSmallString::utf16() const
+
+    Returns the data of the string as an array of UTF-16 code units. The
+    data is not null-terminated.
+*/
+
+/*!
+    \fn const QChar QSmallString::at(int i) const
+
+    Returns the character at index position \a i, which must be a valid
+    index position in the string.
+*/
+
+/*!
+    \fn const QChar QSmallString::operator[](int i) const
+
+    Same as at(\a i).
+*/
+
+/*!
+    \fn QSmallString::const_iterator QSmallString::begin() const
+
+    Returns an STL-style iterator pointing to the first character of the
+    string.
+*/
+
+/*!
+    \fn QSmallString::const_iterator QSmallString::cbegin() const
+
+    Same as begin().
+*/
+
+/*!
+    \fn QSmallString::const_iterator QSmallString::end() const
+
+    Returns an STL-style iterator pointing to the imaginary character after
+    the last character of the string.
+*/
+
+/*!
+    \fn QSmallString::const_iterator QSmallString::cend() const
+
+    Same as end().
+*/
+
+/*!
+    Returns a copy of this string as a QString. Strings that are not stored
+    inline are shared with the result.
+*/
+QString QSmallString::toString() const
+{
+    if (isInline())
+        return QString(constData(), size());
+    m_storage.d->ref.ref();
+    QStringDataPtr dataPtr = { m_storage.d };
+    return QString(dataPtr);
+}
+
+/*!
+    \fn QSmallString::operator QStringView() const
+
+    Returns a QStringView on the data of this string.
+*/
+
+/*!
+    \fn int QSmallString::compare(QStringView other, Qt::CaseSensitivity cs) const
+
+    Compares this string with \a other and returns a negative integer,
+    zero, or a positive integer if this string is less than, equal to, or
+    greater than \a other, respectively.
+
+    If \a cs is Qt::CaseSensitive, the comparison is case sensitive;
+    otherwise the comparison is case insensitive.
+*/
+
+void QSmallString::initHeap(const QString &str)
+{
+    Q_ASSERT(str.size() > int(InlineCapacity));
+    // share the data of str, as the copy constructor of QString would
+    m_storage.d = const_cast<QString &>(str).data_ptr();
+    m_storage.d->ref.ref();
+    m_storage.chars[InlineCapacity] = HeapTag;
+}
+
+void QSmallString::releaseHeap() Q_DECL_NOTHROW
+{
+    // adopt the reference, and let QString release it
+    QStringDataPtr dataPtr = { m_storage.d };
+    QString adopted(dataPtr);
+}
+
+/*!
+    \fn bool operator==(const QSmallString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+
+    Returns \c true if \a lhs is equal to \a rhs; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool operator!=(const QSmallString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+
+    Returns \c true if \a lhs is not equal to \a rhs; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool operator<(const QSmallString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+
+    Returns \c true if \a lhs is lexically less than \a rhs; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator<=(const QSmallString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+
+    Returns \c true if \a lhs is lexically less than or equal to \a rhs;
+    otherwise returns \c false.
+*/
+
+/*!
+    \fn bool operator>(const QSmallString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+
+    Returns \c true if \a lhs is lexically greater than \a rhs; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator>=(const QSmallString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+
+    Returns \c true if \a lhs is lexically greater than or equal to \a rhs;
+    otherwise returns \c false.
+*/
+
+/*!
+    \fn bool operator==(const QSmallString &lhs, const QString &rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn bool operator!=(const QSmallString &lhs, const QString &rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn bool operator==(const QString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn bool operator!=(const QString &lhs, const QSmallString &rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn bool operator==(const QSmallString &lhs, QLatin1String rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn bool operator!=(const QSmallString &lhs, QLatin1String rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn bool operator==(QLatin1String lhs, const QSmallString &rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn bool operator!=(QLatin1String lhs, const QSmallString &rhs)
+    \relates QSmallString
+    \overload
+*/
+
+/*!
+    \fn uint qHash(const QSmallString &key, uint seed)
+    \relates QSmallString
+
+    Returns the hash value for \a key, using \a seed to seed the
+    calculation. The result equals the hash of a QString with the same
+    contents.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qstring.h>
+#include <QtCore/qstringbuilder.h>
+#include <QtCore/qstringview.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class Q_CORE_EXPORT QSmallString
+{
+public:
+    enum { InlineCapacity = 15 };
+
+    typedef QChar value_type;
+    typedef const QChar *const_iterator;
+    typedef const QChar *const_pointer;
+    typedef const QChar &const_reference;
+    typedef int size_type;
+
+    inline QSmallString() Q_DECL_NOTHROW { m_storage.chars[InlineCapacity] = 0; }
+    inline explicit QSmallString(QStringView str) { initFrom(str.data(), int(str.size())); }
+    inline QSmallString(const QChar *str, int size) { initFrom(str, size); }
+    QSmallString(const QString &str);
+    explicit QSmallString(QLatin1String str);
+    inline QSmallString(const QSmallString &other) Q_DECL_NOTHROW;
+    inline ~QSmallString();
+
+    inline QSmallString &operator=(const QSmallString &other) Q_DECL_NOTHROW;
+#ifdef Q_COMPILER_RVALUE_REFS
+    inline QSmallString(QSmallString &&other) Q_DECL_NOTHROW
+    {
+        m_storage = other.m_storage;
+        other.m_storage.chars[InlineCapacity] = 0;
+    }
+    inline QSmallString &operator=(QSmallString &&other) Q_DECL_NOTHROW
+    { swap(other); return *this; }
+#endif
+    inline void swap(QSmallString &other) Q_DECL_NOTHROW { qSwap(m_storage, other.m_storage); }
+
+    static QSmallString fromUtf8(const char *str, int size = -1);
+    static inline QSmallString fromUtf8(const QByteArray &str)
+    { return str.isNull() ? QSmallString() : fromUtf8(str.constData(), str.size()); }
+    static inline QSmallString fromLatin1(const char *str, int size = -1)
+    { return str ? QSmallString(QLatin1String(str, size < 0 ? int(strlen(str)) : size)) : QSmallString(); }
+
+    inline bool isInline() const Q_DECL_NOTHROW { return m_storage.chars[InlineCapacity] != HeapTag; }
+    inline int size() const Q_DECL_NOTHROW
+    { return isInline() ? int(m_storage.chars[InlineCapacity]) : m_storage.d->size; }
+    inline int length() const Q_DECL_NOTHROW { return size(); }
+    inline bool isEmpty() const Q_DECL_NOTHROW { return !size(); }
+
+    inline const QChar *constData() const Q_DECL_NOTHROW
+    {
+        return isInline() ? reinterpret_cast<const QChar *>(m_storage.chars)
+                          : reinterpret_cast<const QChar *>(m_storage.d->data());
+    }
+    inline const QChar *data() const Q_DECL_NOTHROW { return constData(); }
+    inline const ushort *utf16() const Q_DECL_NOTHROW
+    { return reinterpret_cast<const ushort *>(constData()); }
+
+    inline const QChar at(int i) const
+    { Q_ASSERT(uint(i) < uint(size())); return constData()[i]; }
+    inline const QChar operator[](int i) const { return at(i); }
+
+    inline const_iterator begin() const Q_DECL_NOTHROW { return constData(); }
+    inline const_iterator cbegin() const Q_DECL_NOTHROW { return constData(); }
+    inline const_iterator end() const Q_DECL_NOTHROW { return constData() + size(); }
+    inline const_iterator cend() const Q_DECL_NOTHROW { return end(); }
+
+    QString toString() const;
+    inline operator QStringView() const Q_DECL_NOTHROW { return QStringView(constData(), size()); }
+
+    inline int compare(QStringView other, Qt::CaseSensitivity cs = Qt::CaseSensitive) const Q_DECL_NOTHROW
+    { return QtPrivate::compareStrings(QStringView(*this), other, cs); }
+
+private:
+    enum { HeapTag = 0xffff };
+
+    void initFrom(const QChar *str, int size);
+    void initHeap(const QString &str);
+    void releaseHeap() Q_DECL_NOTHROW;
+
+    // The last code unit holds the size of an inline string, or HeapTag if
+    // d points to the data of a QString.
+    union Storage {
+        ushort chars[InlineCapacity + 1];
+        QStringData *d;
+    } m_storage;
+};
+
+Q_DECLARE_SHARED(QSmallString)
+
+inline void QSmallString::initFrom(const QChar *str, int size)
+{
+    if (Q_LIKELY(size <= int(InlineCapacity))) {
+        if (size > 0)
+            memcpy(m_storage.chars, str, size * sizeof(QChar));
+        m_storage.chars[InlineCapacity] = ushort(qMax(size, 0));
+    } else {
+        initHeap(QString(str, size));
+    }
+}
+
+inline QSmallString::QSmallString(const QSmallString &other) Q_DECL_NOTHROW
+    : m_storage(other.m_storage)
+{
+    if (!isInline())
+        m_storage.d->ref.ref();
+}
+
+inline QSmallString::~QSmallString()
+{
+    if (!isInline())
+        releaseHeap();
+}
+
+inline QSmallString &QSmallString::operator=(const QSmallString &other) Q_DECL_NOTHROW
+{
+    QSmallString copy(other);
+    swap(copy);
+    return *this;
+}
+
+inline bool operator==(const QSmallString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return QStringView(lhs) == QStringView(rhs); }
+inline bool operator!=(const QSmallString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return !(lhs == rhs); }
+inline bool operator< (const QSmallString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return QStringView(lhs) <  QStringView(rhs); }
+inline bool operator<=(const QSmallString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return QStringView(lhs) <= QStringView(rhs); }
+inline bool operator> (const QSmallString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return QStringView(lhs) >  QStringView(rhs); }
+inline bool operator>=(const QSmallString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return QStringView(lhs) >= QStringView(rhs); }
+
+inline bool operator==(const QSmallString &lhs, const QString &rhs) Q_DECL_NOTHROW
+{ return QStringView(lhs) == QStringView(rhs); }
+inline bool operator!=(const QSmallString &lhs, const QString &rhs) Q_DECL_NOTHROW
+{ return !(lhs == rhs); }
+inline bool operator==(const QString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return rhs == lhs; }
+inline bool operator!=(const QString &lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return !(rhs == lhs); }
+
+inline bool operator==(const QSmallString &lhs, QLatin1String rhs) Q_DECL_NOTHROW
+{ return QStringView(lhs) == rhs; }
+inline bool operator!=(const QSmallString &lhs, QLatin1String rhs) Q_DECL_NOTHROW
+{ return !(lhs == rhs); }
+inline bool operator==(QLatin1String lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return rhs == lhs; }
+inline bool operator!=(QLatin1String lhs, const QSmallString &rhs) Q_DECL_NOTHROW
+{ return !(rhs == lhs); }
+
+inline uint qHash(const QSmallString &key, uint seed = 0) Q_DECL_NOTHROW
+{ return qHash(QStringView(key), seed); }
+
+template <> struct QConcatenable<QSmallString> : private QAbstractConcatenable
+{
+    typedef QSmallString type;
+    typedef QString ConvertTo;
+    enum { ExactSize = true };
+    static int size(const QSmallString &a) { return a.size(); }
+    static inline void appendTo(const QSmallString &a, QChar *&out)
+    {
+        const int n = a.size();
+        memcpy(out, reinterpret_cast<const char*>(a.constData()), sizeof(QChar) * n);
+        out += n;
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
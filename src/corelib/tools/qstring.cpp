@@ -418,6 +418,135 @@ static void qt_to_latin1(uchar *dst, const ushort *src, int length)
 #endif
 }
 
+// ASCII fast paths for the case-insensitive functions below. The code
+// units in the range [first, last] are letters whose case differs from
+// the one we want by exactly 0x20; nothing outside of ASCII is touched.
+#if defined(__SSE2__)
+static inline __m128i asciiNonAsciiMask(__m128i data)
+{
+    // all bits set for the code units above 0x7f
+    const __m128i asciiMask = _mm_set1_epi16(short(0xff80));
+    return _mm_xor_si128(_mm_cmpeq_epi16(_mm_and_si128(data, asciiMask), _mm_setzero_si128()),
+                         _mm_set1_epi16(-1));
+}
+
+static inline __m128i asciiRangeMask(__m128i data, ushort first, ushort last)
+{
+    // data - first is less than or equal to last - first (unsigned) only
+    // inside the range; the saturating subtraction turns that into a zero
+    const __m128i offset = _mm_sub_epi16(data, _mm_set1_epi16(first));
+    return _mm_cmpeq_epi16(_mm_subs_epu16(offset, _mm_set1_epi16(last - first)), _mm_setzero_si128());
+}
+
+static inline __m128i asciiFoldCase(__m128i data)
+{
+    return _mm_or_si128(data, _mm_and_si128(asciiRangeMask(data, 'A', 'Z'), _mm_set1_epi16(0x20)));
+}
+
+// returns true if the 8 code units are ASCII and equal after folding
+static inline bool asciiFoldedEqual(__m128i a, __m128i b)
+{
+    const __m128i nonAscii = asciiNonAsciiMask(_mm_or_si128(a, b));
+    const __m128i equal = _mm_cmpeq_epi16(asciiFoldCase(a), asciiFoldCase(b));
+    return _mm_movemask_epi8(_mm_andnot_si128(nonAscii, equal)) == 0xffff;
+}
+
+static inline bool asciiFoldedEqual(const ushort *a, const ushort *b)
+{
+    return asciiFoldedEqual(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a)),
+                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(b)));
+}
+
+static inline bool asciiFoldedEqual(const ushort *a, const uchar *b)
+{
+    const __m128i latin1 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(b));
+    return asciiFoldedEqual(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a)),
+                            _mm_unpacklo_epi8(latin1, _mm_setzero_si128()));
+}
+#  define QT_ASCII_FOLDED_EQUAL
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vminv is only available on Aarch64
+static inline uint16x8_t asciiRangeMask(uint16x8_t data, ushort first, ushort last)
+{
+    return vcleq_u16(vsubq_u16(data, vdupq_n_u16(first)), vdupq_n_u16(last - first));
+}
+
+static inline uint16x8_t asciiFoldCase(uint16x8_t data)
+{
+    return vorrq_u16(data, vandq_u16(asciiRangeMask(data, 'A', 'Z'), vdupq_n_u16(0x20)));
+}
+
+static inline bool asciiFoldedEqual(uint16x8_t a, uint16x8_t b)
+{
+    const uint16x8_t nonAscii = vtstq_u16(vorrq_u16(a, b), vdupq_n_u16(0xff80));
+    const uint16x8_t equal = vceqq_u16(asciiFoldCase(a), asciiFoldCase(b));
+    return vminvq_u16(vbicq_u16(equal, nonAscii)) == 0xffff;
+}
+
+static inline bool asciiFoldedEqual(const ushort *a, const ushort *b)
+{
+    return asciiFoldedEqual(vld1q_u16(a), vld1q_u16(b));
+}
+
+static inline bool asciiFoldedEqual(const ushort *a, const uchar *b)
+{
+    return asciiFoldedEqual(vld1q_u16(a), vmovl_u8(vld1_u8(b)));
+}
+#  define QT_ASCII_FOLDED_EQUAL
+#endif
+
+// Returns a pointer to the first code unit in [ptr, end) that is either
+// outside ASCII or inside the range [first, last], or end if there is none.
+static const ushort *asciiFindCaseCandidate(const ushort *ptr, const ushort *end,
+                                            ushort first, ushort last) Q_DECL_NOTHROW
+{
+#if defined(__SSE2__)
+    for ( ; ptr + 8 <= end; ptr += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const uint mask = _mm_movemask_epi8(_mm_or_si128(asciiNonAsciiMask(data),
+                                                         asciiRangeMask(data, first, last)));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask) / 2;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    for ( ; ptr + 8 <= end; ptr += 8) {
+        const uint16x8_t data = vld1q_u16(ptr);
+        const uint16x8_t found = vorrq_u16(vtstq_u16(data, vdupq_n_u16(0xff80)),
+                                           asciiRangeMask(data, first, last));
+        if (vmaxvq_u16(found))
+            break;      // the scalar loop below finds the exact position
+    }
+#endif
+    for ( ; ptr != end; ++ptr) {
+        if (*ptr > 0x7f || (*ptr >= first && *ptr <= last))
+            return ptr;
+    }
+    return end;
+}
+
+// Toggles the case of the letters in [first, last] within [ptr, end);
+// all other code units are left alone.
+static void asciiConvertCase(ushort *ptr, ushort *end, ushort first, ushort last) Q_DECL_NOTHROW
+{
+#if defined(__SSE2__)
+    const __m128i caseBit = _mm_set1_epi16(0x20);
+    for ( ; ptr + 8 <= end; ptr += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i result = _mm_xor_si128(data, _mm_and_si128(asciiRangeMask(data, first, last), caseBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), result);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const uint16x8_t caseBit = vdupq_n_u16(0x20);
+    for ( ; ptr + 8 <= end; ptr += 8) {
+        const uint16x8_t data = vld1q_u16(ptr);
+        vst1q_u16(ptr, veorq_u16(data, vandq_u16(asciiRangeMask(data, first, last), caseBit)));
+    }
+#endif
+    for ( ; ptr != end; ++ptr) {
+        if (*ptr >= first && *ptr <= last)
+            *ptr ^= 0x20;
+    }
+}
+
 // Unicode case-insensitive comparison
 static int ucstricmp(const QChar *a, const QChar *ae, const QChar *b, const QChar *be)
 {
@@ -435,14 +564,24 @@ static int ucstricmp(const QChar *a, const QChar *ae, const QChar *b, const QCha
     uint alast = 0;
     uint blast = 0;
     while (a < e) {
-//         qDebug() << hex << alast << blast;
-//         qDebug() << hex << "*a=" << *a << "alast=" << alast << "folded=" << foldCase (*a, alast);
-//         qDebug() << hex << "*b=" << *b << "blast=" << blast << "folded=" << foldCase (*b, blast);
-        int diff = foldCase(a->unicode(), alast) - foldCase(b->unicode(), blast);
-        if ((diff))
-            return diff;
-        ++a;
-        ++b;
+#ifdef QT_ASCII_FOLDED_EQUAL
+        // skip ASCII runs that are equal after folding, eight at a time;
+        // they end any surrogate pair, so the last characters are reset
+        while (e - a >= 8 && asciiFoldedEqual(reinterpret_cast<const ushort *>(a),
+                                              reinterpret_cast<const ushort *>(b))) {
+            a += 8;
+            b += 8;
+            alast = blast = 0;
+        }
+        const QChar *blockEnd = a + qMin<qptrdiff>(e - a, 8);
+#else
+        const QChar *blockEnd = e;
+#endif
+        for ( ; a < blockEnd; ++a, ++b) {
+            int diff = foldCase(a->unicode(), alast) - foldCase(b->unicode(), blast);
+            if ((diff))
+                return diff;
+        }
     }
     if (a == ae) {
         if (b == be)
@@ -465,11 +604,21 @@ static int ucstricmp(const QChar *a, const QChar *ae, const char *b, const char
         e = a + (be - b);
 
     while (a < e) {
-        int diff = foldCase(a->unicode()) - foldCase(uchar(*b));
-        if ((diff))
-            return diff;
-        ++a;
-        ++b;
+#ifdef QT_ASCII_FOLDED_EQUAL
+        while (e - a >= 8 && asciiFoldedEqual(reinterpret_cast<const ushort *>(a),
+                                              reinterpret_cast<const uchar *>(b))) {
+            a += 8;
+            b += 8;
+        }
+        const QChar *blockEnd = a + qMin<qptrdiff>(e - a, 8);
+#else
+        const QChar *blockEnd = e;
+#endif
+        for ( ; a < blockEnd; ++a, ++b) {
+            int diff = foldCase(a->unicode()) - foldCase(uchar(*b));
+            if ((diff))
+                return diff;
+        }
     }
     if (a == ae) {
         if (b == be)
@@ -835,6 +984,32 @@ int QtPrivate::compareStrings(QLatin1String lhs, QLatin1String rhs, Qt::CaseSens
     return qt_compare_strings(lhs, rhs, cs);
 }
 
+/*!
+    \internal
+    \since 5.11
+
+    Returns the hash value of the case folded \a key, using \a seed to seed
+    the calculation. The result is the same as that of
+    qHash(QString(key).toCaseFolded(), seed), without creating the string,
+    which makes it suitable for case-insensitive lookups of Latin-1 keys
+    such as header names.
+*/
+uint QtPrivate::qHashCaseFolded(QLatin1String key, uint seed)
+{
+    QVarLengthArray<ushort, 256> folded(key.size());
+    ushort *ptr = folded.data();
+    ushort *end = ptr + folded.size();
+    qt_from_latin1(ptr, key.data(), size_t(key.size()));
+
+    // fold the ASCII letters in bulk, then whatever is left above ASCII
+    asciiConvertCase(ptr, end, 'A', 'Z');
+    while ((ptr = const_cast<ushort *>(asciiFindCaseCandidate(ptr, end, 0x80, 0x80))) != end) {
+        *ptr = foldCase(*ptr);
+        ++ptr;
+    }
+    return qHash(QStringView(reinterpret_cast<const QChar *>(folded.constData()), folded.size()), seed);
+}
+
 /*!
     \internal
 
@@ -6228,17 +6403,40 @@ static QString detachAndConvertCase(T &str, QStringIterator it)
     return s;
 }
 
+// the ASCII letters changed by the case traits
+template <typename Traits> struct AsciiCaseRange;
+template <> struct AsciiCaseRange<LowercaseTraits> { enum : ushort { First = 'A', Last = 'Z' }; };
+template <> struct AsciiCaseRange<UppercaseTraits> { enum : ushort { First = 'a', Last = 'z' }; };
+template <> struct AsciiCaseRange<CasefoldTraits> { enum : ushort { First = 'A', Last = 'Z' }; };
+
 template <typename Traits, typename T>
 static QString convertCase(T &str)
 {
     const QChar *p = str.constBegin();
     const QChar *e = p + str.size();
 
+    // ASCII fast path: skip what needs no conversion without looking
+    // up the Unicode properties, and convert pure ASCII strings in bulk
+    const ushort first = AsciiCaseRange<Traits>::First;
+    const ushort last = AsciiCaseRange<Traits>::Last;
+    const ushort *uc = reinterpret_cast<const ushort *>(p);
+    const ushort *ue = reinterpret_cast<const ushort *>(e);
+    const ushort *candidate = asciiFindCaseCandidate(uc, ue, first, last);
+    if (candidate == ue)
+        return qMove(str);
+    const int index = int(candidate - uc);
+    if (*candidate <= 0x7f && asciiFindCaseCandidate(candidate, ue, 0x80, 0x80) == ue) {
+        QString s = qMove(str);         // will copy if T is const QString
+        ushort *data = reinterpret_cast<ushort *>(s.data()); // will detach if necessary
+        asciiConvertCase(data + index, data + s.size(), first, last);
+        return s;
+    }
+
     // this avoids out of bounds check in the loop
     while (e != p && e[-1].isHighSurrogate())
         --e;
 
-    QStringIterator it(p, e);
+    QStringIterator it(p, index, e);
     while (it.hasNext()) {
         uint uc = it.nextUnchecked();
         if (Traits::caseDiff(qGetProp(uc))) {
@@ -8503,6 +8701,175 @@ QString QString::multiArg(int numArgs, const QString **args) const
     return result;
 }
 
+/*!
+    \fn template <typename... Args> QString QString::arg(const Args &...args) const
+    \overload arg()
+    \since 5.11
+
+    Replaces occurrences of \c{%N} in this string with the corresponding
+    argument from \a args, in a single pass. The arguments can be any
+    combination of QString, QStringView, QLatin1String, QChar and integral or
+    floating-point numbers:
+
+    \snippet qstring/main.cpp 101
+
+    Unlike chained arg() calls, which create a new string and search it for
+    place markers again for every argument, this scans the format string once,
+    works out the size of the result and fills it in a single allocation.
+    Numbers are formatted as by the single-argument arg() overloads with their
+    default arguments; for a \c{%L} place marker they are formatted according
+    to the default locale. Strings are never affected by \c{%L}.
+
+    As with the overloads taking up to nine QString arguments, the lowest
+    numbered place marker is replaced by the first argument, the next lowest
+    by the second, and so on. Place-marker numbers must be in the range 1 to
+    999.
+
+    \note A call that matches one of the single-argument overloads, for
+    instance a string followed by an integer and optionally a QChar, selects
+    that overload and uses the integer as its \c fieldWidth.
+*/
+
+namespace {
+struct ArgPlaceholder
+{
+    int begin;
+    int end;
+    int number;  // the N in %N; later, the index of the argument that replaces it or -1
+    bool localized;
+};
+
+struct ArgText
+{
+    ArgText() : latin1(), isLatin1(false), isFormatted(false) {}
+
+    QStringView utf16;
+    QLatin1String latin1;
+    bool isLatin1;
+    bool isFormatted;
+    QString storage;
+    char buffer[24];  // enough for any 64-bit integer in decimal, and the sign
+
+    int size() const { return isLatin1 ? latin1.size() : int(utf16.size()); }
+};
+} // unnamed namespace
+
+static void formatArg(ArgText &text, const QtPrivate::ArgBase *arg, bool localized)
+{
+    using QtPrivate::ArgBase;
+    text.isFormatted = true;
+    switch (arg->tag) {
+    case ArgBase::L1:
+        text.latin1 = static_cast<const QtPrivate::QLatin1StringArg *>(arg)->string;
+        text.isLatin1 = true;
+        return;
+    case ArgBase::U16:
+        text.utf16 = static_cast<const QtPrivate::QStringViewArg *>(arg)->string;
+        return;
+    case ArgBase::LongLong:
+    case ArgBase::ULongLong: {
+        const QtPrivate::NumberArg *number = static_cast<const QtPrivate::NumberArg *>(arg);
+        if (localized) {
+            QLocale locale;
+            text.storage = arg->tag == ArgBase::LongLong ? locale.toString(number->i)
+                                                         : locale.toString(number->u);
+            text.utf16 = text.storage;
+            return;
+        }
+        const bool negative = arg->tag == ArgBase::LongLong && number->i < 0;
+        qulonglong value = negative ? 0 - number->u : number->u;
+        char *const end = text.buffer + sizeof(text.buffer);
+        char *p = end;
+        do {
+            *--p = '0' + value % 10;
+            value /= 10;
+        } while (value);
+        if (negative)
+            *--p = '-';
+        text.latin1 = QLatin1String(p, int(end - p));
+        text.isLatin1 = true;
+        return;
+    }
+    case ArgBase::Double: {
+        const double d = static_cast<const QtPrivate::NumberArg *>(arg)->d;
+        text.storage = localized ? QLocale().toString(d, 'g', 6) : QString::number(d);
+        text.utf16 = text.storage;
+        return;
+    }
+    }
+    Q_UNREACHABLE();
+}
+
+QString QtPrivate::argToQString(QStringView pattern, size_t numArgs, const ArgBase **args)
+{
+    // parse the pattern once, recording where the place markers are
+    const QChar *uc = pattern.data();
+    const int len = int(pattern.size());
+    QVarLengthArray<ArgPlaceholder, 32> placeholders;
+    for (int i = 0; i < len - 1; ) {
+        if (uc[i] == QLatin1Char('%')) {
+            const int percent = i;
+            const bool localized = uc[i + 1] == QLatin1Char('L');
+            const int number = getEscape(uc, &i, len);
+            if (number != -1) {
+                const ArgPlaceholder placeholder = { percent, i, number, localized };
+                placeholders.append(placeholder);
+                continue;
+            }
+        }
+        ++i;
+    }
+
+    // map the place-marker numbers to the arguments, as multiArg() does
+    QVarLengthArray<int, 16> numbers;
+    for (const ArgPlaceholder &placeholder : placeholders)
+        numbers.append(placeholder.number);
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+    if (size_t(numbers.size()) > numArgs)
+        numbers.resize(int(numArgs));
+    else if (size_t(numbers.size()) < numArgs)
+        qWarning("QString::arg: %d argument(s) missing in %ls",
+                 int(numArgs) - numbers.size(), qUtf16Printable(pattern.toString()));
+
+    // format the arguments that are used and add up the size of the result
+    QVarLengthArray<ArgText, 16> texts(int(numArgs) * 2); // plain and %L versions
+    int totalSize = len;
+    for (ArgPlaceholder &placeholder : placeholders) {
+        const int *it = std::lower_bound(numbers.cbegin(), numbers.cend(), placeholder.number);
+        if (it == numbers.cend() || *it != placeholder.number) {
+            placeholder.number = -1;
+            continue;
+        }
+        placeholder.number = int(it - numbers.cbegin());
+        ArgText &text = texts[placeholder.number * 2 + placeholder.localized];
+        if (!text.isFormatted)
+            formatArg(text, args[placeholder.number], placeholder.localized);
+        totalSize += text.size() - (placeholder.end - placeholder.begin);
+    }
+
+    QString result(totalSize, Qt::Uninitialized);
+    ushort *out = reinterpret_cast<ushort *>(result.data());
+    int last = 0;
+    for (const ArgPlaceholder &placeholder : placeholders) {
+        if (placeholder.number == -1)
+            continue;
+        memcpy(out, uc + last, (placeholder.begin - last) * sizeof(QChar));
+        out += placeholder.begin - last;
+        last = placeholder.end;
+
+        const ArgText &text = texts[placeholder.number * 2 + placeholder.localized];
+        if (text.isLatin1)
+            qt_from_latin1(out, text.latin1.data(), size_t(text.latin1.size()));
+        else
+            memcpy(out, text.utf16.data(), text.utf16.size() * sizeof(QChar));
+        out += text.size();
+    }
+    memcpy(out, uc + last, (len - last) * sizeof(QChar));
+
+    return result;
+}
+
 /*! \fn bool QString::isSimpleText() const
 
     \internal
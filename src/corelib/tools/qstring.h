@@ -209,6 +209,69 @@ bool QStringView::startsWith(QLatin1String s, Qt::CaseSensitivity cs) const Q_DE
 bool QStringView::endsWith(QLatin1String s, Qt::CaseSensitivity cs) const Q_DECL_NOTHROW
 { return QtPrivate::endsWith(*this, s, cs); }
 
+//
+// helpers for the variadic QString::arg():
+//
+namespace QtPrivate {
+struct ArgBase {
+    enum Tag : uchar { L1, U16, LongLong, ULongLong, Double } tag;
+};
+
+struct QStringViewArg : ArgBase {
+    QStringView string;
+    Q_DECL_CONSTEXPR explicit QStringViewArg(QStringView v) Q_DECL_NOTHROW : ArgBase{U16}, string{v} {}
+};
+
+struct QLatin1StringArg : ArgBase {
+    QLatin1String string;
+    Q_DECL_CONSTEXPR explicit QLatin1StringArg(QLatin1String v) Q_DECL_NOTHROW : ArgBase{L1}, string{v} {}
+};
+
+struct NumberArg : ArgBase {
+    union {
+        qlonglong i;
+        qulonglong u;
+        double d;
+    };
+    Q_DECL_CONSTEXPR explicit NumberArg(qlonglong v) Q_DECL_NOTHROW : ArgBase{LongLong}, i(v) {}
+    Q_DECL_CONSTEXPR explicit NumberArg(qulonglong v) Q_DECL_NOTHROW : ArgBase{ULongLong}, u(v) {}
+    Q_DECL_CONSTEXPR explicit NumberArg(double v) Q_DECL_NOTHROW : ArgBase{Double}, d(v) {}
+};
+
+Q_REQUIRED_RESULT Q_CORE_EXPORT QString argToQString(QStringView pattern, size_t numArgs, const ArgBase **args);
+
+template <typename... Args>
+Q_ALWAYS_INLINE QString argToQStringDispatch(QStringView pattern, const Args &...args);
+
+inline QStringViewArg qToArg(QStringView s) Q_DECL_NOTHROW { return QStringViewArg(s); }
+inline QStringViewArg qToArg(const QChar &c) Q_DECL_NOTHROW { return QStringViewArg(QStringView(&c, 1)); }
+Q_DECL_CONSTEXPR inline QLatin1StringArg qToArg(QLatin1String s) Q_DECL_NOTHROW { return QLatin1StringArg(s); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(short v) Q_DECL_NOTHROW { return NumberArg(qlonglong(v)); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(ushort v) Q_DECL_NOTHROW { return NumberArg(qulonglong(v)); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(int v) Q_DECL_NOTHROW { return NumberArg(qlonglong(v)); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(uint v) Q_DECL_NOTHROW { return NumberArg(qulonglong(v)); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(long v) Q_DECL_NOTHROW { return NumberArg(qlonglong(v)); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(ulong v) Q_DECL_NOTHROW { return NumberArg(qulonglong(v)); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(qlonglong v) Q_DECL_NOTHROW { return NumberArg(v); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(qulonglong v) Q_DECL_NOTHROW { return NumberArg(v); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(float v) Q_DECL_NOTHROW { return NumberArg(double(v)); }
+Q_DECL_CONSTEXPR inline NumberArg qToArg(double v) Q_DECL_NOTHROW { return NumberArg(v); }
+
+template <typename T> struct IsArgLike
+    : std::integral_constant<bool,
+        std::is_convertible<T, QStringView>::value
+        || std::is_same<T, QChar>::value || std::is_same<T, QLatin1String>::value
+        || std::is_same<T, short>::value || std::is_same<T, ushort>::value
+        || std::is_same<T, int>::value || std::is_same<T, uint>::value
+        || std::is_same<T, long>::value || std::is_same<T, ulong>::value
+        || std::is_same<T, qlonglong>::value || std::is_same<T, qulonglong>::value
+        || std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+template <typename... Args> struct AreArgLike : std::true_type {};
+template <typename T, typename... Args> struct AreArgLike<T, Args...>
+    : std::integral_constant<bool, IsArgLike<T>::value && AreArgLike<Args...>::value> {};
+} // namespace QtPrivate
+
 class Q_CORE_EXPORT QString
 {
 public:
@@ -313,6 +376,11 @@ public:
     Q_REQUIRED_RESULT QString arg(const QString &a1, const QString &a2, const QString &a3,
                 const QString &a4, const QString &a5, const QString &a6,
                 const QString &a7, const QString &a8, const QString &a9) const;
+    template <typename... Args>
+    Q_REQUIRED_RESULT
+    typename std::enable_if<(sizeof...(Args) >= 2) && QtPrivate::AreArgLike<Args...>::value, QString>::type
+    arg(const Args &...args) const
+    { return QtPrivate::argToQStringDispatch(qToStringViewIgnoringNull(*this), QtPrivate::qToArg(args)...); }
 
     QString &vsprintf(const char *format, va_list ap) Q_ATTRIBUTE_FORMAT_PRINTF(2, 0);
     QString &sprintf(const char *format, ...) Q_ATTRIBUTE_FORMAT_PRINTF(2, 3);
@@ -909,6 +977,13 @@ public:
 QString QStringView::toString() const
 { return Q_ASSERT(size() == length()), QString(data(), length()); }
 
+template <typename... Args>
+Q_ALWAYS_INLINE QString QtPrivate::argToQStringDispatch(QStringView pattern, const Args &...args)
+{
+    const ArgBase *argBases[] = { &args..., /* avoid zero-sized array */ nullptr };
+    return QtPrivate::argToQString(pattern, sizeof...(Args), argBases);
+}
+
 //
 // QString inline members
 //
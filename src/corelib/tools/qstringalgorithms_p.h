@@ -56,6 +56,10 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace QtPrivate {
+Q_REQUIRED_RESULT Q_CORE_EXPORT uint qHashCaseFolded(QLatin1String key, uint seed = 0);
+}
+
 template <typename StringType> struct QStringAlgorithms
 {
     typedef typename StringType::value_type Char;
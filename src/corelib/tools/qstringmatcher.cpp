@@ -39,6 +39,8 @@
 
 #include "qstringmatcher.h"
 
+#include "qsimd_p.h"
+
 QT_BEGIN_NAMESPACE
 
 static void bm_init_skiptable(const ushort *uc, int len, uchar *skiptable, Qt::CaseSensitivity cs)
@@ -60,11 +62,57 @@ static void bm_init_skiptable(const ushort *uc, int len, uchar *skiptable, Qt::C
     }
 }
 
+#ifdef __SSE2__
+/*
+    Like the byte array version in qbytearraymatcher.cpp: compares 8
+    candidate positions at a time against the first and the last character
+    of the needle, and only verifies the positions where both match.
+*/
+enum { PrefilterMaximumNeedleLength = 16 };
+
+static int prefiltered_find(const ushort *uc, int l, int index, const ushort *puc, int pl)
+{
+    Q_ASSERT(pl >= 2);
+
+    const int lastStart = l - pl;
+    const __m128i first = _mm_set1_epi16(short(puc[0]));
+    const __m128i last = _mm_set1_epi16(short(puc[pl - 1]));
+    const size_t middleSize = (pl - 2) * sizeof(ushort);
+
+    int i = index;
+    for ( ; i + 7 <= lastStart; i += 8) {
+        const __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + i));
+        const __m128i lastBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + i + pl - 1));
+        // two bits per character; keep one of them
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(first, firstBlock),
+                                                    _mm_cmpeq_epi16(last, lastBlock))) & 0x5555;
+        while (mask) {
+            const int candidate = i + qCountTrailingZeroBits(mask) / 2;
+            if (memcmp(uc + candidate + 1, puc + 1, middleSize) == 0)
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+
+    for ( ; i <= lastStart; ++i) {
+        if (uc[i] == puc[0] && uc[i + pl - 1] == puc[pl - 1]
+                && memcmp(uc + i + 1, puc + 1, middleSize) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+#endif
+
 static inline int bm_find(const ushort *uc, uint l, int index, const ushort *puc, uint pl,
                           const uchar *skiptable, Qt::CaseSensitivity cs)
 {
     if (pl == 0)
         return index > (int)l ? -1 : index;
+#ifdef __SSE2__
+    if (cs == Qt::CaseSensitive && pl >= 2 && pl <= PrefilterMaximumNeedleLength)
+        return index >= int(l) ? -1 : prefiltered_find(uc, int(l), index, puc, int(pl));
+#endif
     const uint pl_minus_one = pl - 1;
 
     const ushort *current = uc + index + pl_minus_one;
@@ -592,6 +592,29 @@ int QTimeZone::offsetFromUtc(const QDateTime &atDateTime) const
         return 0;
 }
 
+/*!
+    \since 5.11
+
+    Stores in \a offsets the total effective offset from UTC, in seconds, at
+    each of the \a count times in \a msecsSinceEpoch, given as milliseconds
+    since the start of 1970, UTC. Both arrays must hold at least \a count
+    elements.
+
+    This gives the same results as calling offsetFromUtc() for each time, but
+    is considerably faster when converting many times, particularly when
+    they are sorted.
+
+    \sa offsetFromUtc()
+*/
+
+void QTimeZone::offsetsFromUtc(const qint64 *msecsSinceEpoch, int *offsets, int count) const
+{
+    if (isValid())
+        d->offsetsFromUtc(msecsSinceEpoch, offsets, count);
+    else
+        std::fill(offsets, offsets + count, 0);
+}
+
 /*!
     Returns the standard time offset at the given \a atDateTime, i.e. the
     number of seconds to add to UTC to obtain the local Standard Time.  This
@@ -124,6 +124,7 @@ public:
     QString abbreviation(const QDateTime &atDateTime) const;
 
     int offsetFromUtc(const QDateTime &atDateTime) const;
+    void offsetsFromUtc(const qint64 *msecsSinceEpoch, int *offsets, int count) const;
     int standardTimeOffset(const QDateTime &atDateTime) const;
     int daylightTimeOffset(const QDateTime &atDateTime) const;
 
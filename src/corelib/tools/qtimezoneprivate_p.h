@@ -54,6 +54,7 @@
 
 #include "qtimezone.h"
 #include "qlocale_p.h"
+#include "qmutex.h"
 #include "qvector.h"
 
 #if QT_CONFIG(icu)
@@ -112,6 +113,7 @@ public:
     virtual QString abbreviation(qint64 atMSecsSinceEpoch) const;
 
     virtual int offsetFromUtc(qint64 atMSecsSinceEpoch) const;
+    virtual void offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets, int count) const;
     virtual int standardTimeOffset(qint64 atMSecsSinceEpoch) const;
     virtual int daylightTimeOffset(qint64 atMSecsSinceEpoch) const;
 
@@ -309,6 +311,7 @@ public:
     QString abbreviation(qint64 atMSecsSinceEpoch) const Q_DECL_OVERRIDE;
 
     int offsetFromUtc(qint64 atMSecsSinceEpoch) const Q_DECL_OVERRIDE;
+    void offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets, int count) const Q_DECL_OVERRIDE;
     int standardTimeOffset(qint64 atMSecsSinceEpoch) const Q_DECL_OVERRIDE;
     int daylightTimeOffset(qint64 atMSecsSinceEpoch) const Q_DECL_OVERRIDE;
 
@@ -329,7 +332,29 @@ public:
 private:
     void init(const QByteArray &ianaId);
 
+    // The span of time over which data() does not change
+    struct Period {
+        qint64 start = 0;
+        qint64 end = 0; // exclusive; empty when start == end
+        Data data;
+
+        bool contains(qint64 msecs) const { return start <= msecs && msecs < end; }
+    };
+    Period period(qint64 forMSecsSinceEpoch) const;
+
+    // Remembers the last period looked up, as lookups tend to cluster;
+    // copies start out empty.
+    struct PeriodCache {
+        PeriodCache() {}
+        PeriodCache(const PeriodCache &) {}
+        PeriodCache &operator=(const PeriodCache &) { return *this; }
+
+        QMutex mutex;
+        Period period;
+    };
+
     Data dataForTzTransition(QTzTransitionTime tran) const;
+    mutable PeriodCache m_periodCache;
     QVector<QTzTransitionTime> m_tranTimes;
     QVector<QTzTransitionRule> m_tranRules;
     QList<QByteArray> m_abbreviations;
@@ -40,10 +40,12 @@
 #include "qtimezone.h"
 #include "qtimezoneprivate_p.h"
 
+#include <QtCore/QCache>
 #include <QtCore/QFile>
 #include <QtCore/QHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
+#include <QtCore/QMutex>
 
 #include <qdebug.h>
 
@@ -635,21 +637,44 @@ QTzTimeZonePrivate *QTzTimeZonePrivate::clone() const
     return new QTzTimeZonePrivate(*this);
 }
 
-void QTzTimeZonePrivate::init(const QByteArray &ianaId)
+// Parsed tz files, shared by all QTzTimeZonePrivate instances of the same zone
+struct QTzTimeZoneCacheEntry
+{
+    QVector<QTzTransitionTime> m_tranTimes;
+    QVector<QTzTransitionRule> m_tranRules;
+    QList<QByteArray> m_abbreviations;
+    QByteArray m_posixRule;
+};
+
+class QTzTimeZoneCache
+{
+public:
+    QTzTimeZoneCache() : m_cache(100) {}
+
+    QTzTimeZoneCacheEntry fetchEntry(const QByteArray &ianaId, bool *ok);
+
+private:
+    QMutex m_mutex;
+    QCache<QByteArray, QTzTimeZoneCacheEntry> m_cache;
+};
+
+Q_GLOBAL_STATIC(QTzTimeZoneCache, tzCache)
+
+static bool parseTzFile(const QByteArray &ianaId, QTzTimeZoneCacheEntry *entry)
 {
     QFile tzif;
     if (ianaId.isEmpty()) {
         // Open system tz
         tzif.setFileName(QStringLiteral("/etc/localtime"));
         if (!tzif.open(QIODevice::ReadOnly))
-            return;
+            return false;
     } else {
         // Open named tz, try modern path first, if fails try legacy path
         tzif.setFileName(QLatin1String("/usr/share/zoneinfo/") + QString::fromLocal8Bit(ianaId));
         if (!tzif.open(QIODevice::ReadOnly)) {
             tzif.setFileName(QLatin1String("/usr/lib/zoneinfo/") + QString::fromLocal8Bit(ianaId));
             if (!tzif.open(QIODevice::ReadOnly))
-                return;
+                return false;
         }
     }
 
@@ -659,59 +684,59 @@ void QTzTimeZonePrivate::init(const QByteArray &ianaId)
     bool ok = false;
     QTzHeader hdr = parseTzHeader(ds, &ok);
     if (!ok || ds.status() != QDataStream::Ok)
-        return;
+        return false;
     QVector<QTzTransition> tranList = parseTzTransitions(ds, hdr.tzh_timecnt, false);
     if (ds.status() != QDataStream::Ok)
-        return;
+        return false;
     QVector<QTzType> typeList = parseTzTypes(ds, hdr.tzh_typecnt);
     if (ds.status() != QDataStream::Ok)
-        return;
+        return false;
     QMap<int, QByteArray> abbrevMap = parseTzAbbreviations(ds, hdr.tzh_charcnt, typeList);
     if (ds.status() != QDataStream::Ok)
-        return;
+        return false;
     parseTzLeapSeconds(ds, hdr.tzh_leapcnt, false);
     if (ds.status() != QDataStream::Ok)
-        return;
+        return false;
     typeList = parseTzIndicators(ds, typeList, hdr.tzh_ttisstdcnt, hdr.tzh_ttisgmtcnt);
     if (ds.status() != QDataStream::Ok)
-        return;
+        return false;
 
     // If version 2 then parse the second block of data
     if (hdr.tzh_version == '2' || hdr.tzh_version == '3') {
         ok = false;
         QTzHeader hdr2 = parseTzHeader(ds, &ok);
         if (!ok || ds.status() != QDataStream::Ok)
-            return;
+            return false;
         tranList = parseTzTransitions(ds, hdr2.tzh_timecnt, true);
         if (ds.status() != QDataStream::Ok)
-            return;
+            return false;
         typeList = parseTzTypes(ds, hdr2.tzh_typecnt);
         if (ds.status() != QDataStream::Ok)
-            return;
+            return false;
         abbrevMap = parseTzAbbreviations(ds, hdr2.tzh_charcnt, typeList);
         if (ds.status() != QDataStream::Ok)
-            return;
+            return false;
         parseTzLeapSeconds(ds, hdr2.tzh_leapcnt, true);
         if (ds.status() != QDataStream::Ok)
-            return;
+            return false;
         typeList = parseTzIndicators(ds, typeList, hdr2.tzh_ttisstdcnt, hdr2.tzh_ttisgmtcnt);
         if (ds.status() != QDataStream::Ok)
-            return;
-        m_posixRule = parseTzPosixRule(ds);
+            return false;
+        entry->m_posixRule = parseTzPosixRule(ds);
         if (ds.status() != QDataStream::Ok)
-            return;
+            return false;
     }
 
     // Translate the TZ file into internal format
 
     // Translate the array index based tz_abbrind into list index
     const int size = abbrevMap.size();
-    m_abbreviations.clear();
-    m_abbreviations.reserve(size);
+    entry->m_abbreviations.clear();
+    entry->m_abbreviations.reserve(size);
     QVector<int> abbrindList;
     abbrindList.reserve(size);
     for (auto it = abbrevMap.cbegin(), end = abbrevMap.cend(); it != end; ++it) {
-        m_abbreviations.append(it.value());
+        entry->m_abbreviations.append(it.value());
         abbrindList.append(it.key());
     }
     for (int i = 0; i < typeList.size(); ++i)
@@ -728,8 +753,8 @@ void QTzTimeZonePrivate::init(const QByteArray &ianaId)
     }
 
     // Now for each transition time calculate and store our rule:
-    const int tranCount = tranList.count();;
-    m_tranTimes.reserve(tranCount);
+    const int tranCount = tranList.count();
+    entry->m_tranTimes.reserve(tranCount);
     // The DST offset when in effect: usually stable, usually an hour:
     int lastDstOff = 3600;
     for (int i = 0; i < tranCount; i++) {
@@ -783,17 +808,62 @@ void QTzTimeZonePrivate::init(const QByteArray &ianaId)
         rule.abbreviationIndex = tz_type.tz_abbrind;
 
         // If the rule already exist then use that, otherwise add it
-        int ruleIndex = m_tranRules.indexOf(rule);
+        int ruleIndex = entry->m_tranRules.indexOf(rule);
         if (ruleIndex == -1) {
-            m_tranRules.append(rule);
-            tran.ruleIndex = m_tranRules.size() - 1;
+            entry->m_tranRules.append(rule);
+            tran.ruleIndex = entry->m_tranRules.size() - 1;
         } else {
             tran.ruleIndex = ruleIndex;
         }
 
         tran.atMSecsSinceEpoch = tz_tran.tz_time * 1000;
-        m_tranTimes.append(tran);
+        entry->m_tranTimes.append(tran);
+    }
+
+    return true;
+}
+
+QTzTimeZoneCacheEntry QTzTimeZoneCache::fetchEntry(const QByteArray &ianaId, bool *ok)
+{
+    // The system time zone may be replaced at any time, so only named
+    // zones are cached
+    if (ianaId.isEmpty()) {
+        QTzTimeZoneCacheEntry entry;
+        *ok = parseTzFile(ianaId, &entry);
+        return entry;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (const QTzTimeZoneCacheEntry *cached = m_cache.object(ianaId)) {
+        *ok = true;
+        return *cached;
     }
+    locker.unlock();
+
+    QTzTimeZoneCacheEntry *entry = new QTzTimeZoneCacheEntry;
+    *ok = parseTzFile(ianaId, entry);
+    if (!*ok) {
+        delete entry;
+        return QTzTimeZoneCacheEntry();
+    }
+
+    const QTzTimeZoneCacheEntry result = *entry;
+    locker.relock();
+    m_cache.insert(ianaId, entry);
+    return result;
+}
+
+void QTzTimeZonePrivate::init(const QByteArray &ianaId)
+{
+    bool ok = false;
+    const QTzTimeZoneCacheEntry entry = tzCache->fetchEntry(ianaId, &ok);
+    if (!ok)
+        return;
+
+    m_tranTimes = entry.m_tranTimes;
+    m_tranRules = entry.m_tranRules;
+    m_abbreviations = entry.m_abbreviations;
+    m_posixRule = entry.m_posixRule;
 
     if (ianaId.isEmpty())
         m_id = systemTimeZoneId();
@@ -940,8 +1010,20 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::dataForTzTransition(QTzTransitionTime
     return data;
 }
 
-QTimeZonePrivate::Data QTzTimeZonePrivate::data(qint64 forMSecsSinceEpoch) const
+static bool atLessThan(qint64 msecs, const QTzTransitionTime &tran)
+{
+    return msecs < tran.atMSecsSinceEpoch;
+}
+
+static bool atLessThanMSecs(const QTzTransitionTime &tran, qint64 msecs)
+{
+    return tran.atMSecsSinceEpoch < msecs;
+}
+
+QTzTimeZonePrivate::Period QTzTimeZonePrivate::period(qint64 forMSecsSinceEpoch) const
 {
+    Period result;
+
     // If the required time is after the last transition and we have a POSIX rule then use it
     if (m_tranTimes.size() > 0 && m_tranTimes.last().atMSecsSinceEpoch < forMSecsSinceEpoch
         && !m_posixRule.isEmpty() && forMSecsSinceEpoch >= 0) {
@@ -951,31 +1033,82 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::data(qint64 forMSecsSinceEpoch) const
                                       m_tranTimes.last().atMSecsSinceEpoch);
         for (int i = posixTrans.size() - 1; i >= 0; --i) {
             if (posixTrans.at(i).atMSecsSinceEpoch <= forMSecsSinceEpoch) {
-                QTimeZonePrivate::Data data = posixTrans.at(i);
-                data.atMSecsSinceEpoch = forMSecsSinceEpoch;
-                return data;
+                result.data = posixTrans.at(i);
+                // Before the last transition, or before the epoch, the POSIX rule is not used
+                result.start = qMax(posixTrans.at(i).atMSecsSinceEpoch,
+                                    qMax(m_tranTimes.last().atMSecsSinceEpoch + 1, Q_INT64_C(0)));
+                // Without a later transition in the calculated years, only
+                // this instant is known to be covered
+                result.end = i + 1 < posixTrans.size() ? posixTrans.at(i + 1).atMSecsSinceEpoch
+                                                       : forMSecsSinceEpoch + 1;
+                return result;
             }
         }
     }
 
     // Otherwise if we can find a valid tran then use its rule
-    for (int i = m_tranTimes.size() - 1; i >= 0; --i) {
-        if (m_tranTimes.at(i).atMSecsSinceEpoch <= forMSecsSinceEpoch) {
-            Data data = dataForTzTransition(m_tranTimes.at(i));
-            data.atMSecsSinceEpoch = forMSecsSinceEpoch;
-            return data;
+    const auto next = std::upper_bound(m_tranTimes.cbegin(), m_tranTimes.cend(),
+                                       forMSecsSinceEpoch, atLessThan);
+    if (next != m_tranTimes.cbegin()) {
+        result.data = dataForTzTransition(*(next - 1));
+        result.start = (next - 1)->atMSecsSinceEpoch;
+        if (next != m_tranTimes.cend()) {
+            result.end = next->atMSecsSinceEpoch;
+        } else if (m_posixRule.isEmpty()) {
+            result.end = maxMSecs();
+        } else {
+            // The POSIX rule may take over after the last transition
+            result.start = forMSecsSinceEpoch;
+            result.end = forMSecsSinceEpoch + 1;
         }
+        return result;
     }
 
     // Otherwise use the earliest transition we have
     if (m_tranTimes.size() > 0) {
-        Data data = dataForTzTransition(m_tranTimes.at(0));
-        data.atMSecsSinceEpoch = forMSecsSinceEpoch;
-        return data;
+        result.data = dataForTzTransition(m_tranTimes.at(0));
+        result.start = minMSecs();
+        result.end = m_tranTimes.at(0).atMSecsSinceEpoch;
+        return result;
     }
 
     // Otherwise we have no rules, so probably an invalid tz, so return invalid data
-    return invalidData();
+    result.data = invalidData();
+    return result;
+}
+
+QTimeZonePrivate::Data QTzTimeZonePrivate::data(qint64 forMSecsSinceEpoch) const
+{
+    Data data;
+    QMutexLocker locker(&m_periodCache.mutex);
+    if (m_periodCache.period.contains(forMSecsSinceEpoch)) {
+        data = m_periodCache.period.data;
+    } else {
+        locker.unlock();
+        const Period found = period(forMSecsSinceEpoch);
+        if (found.data.atMSecsSinceEpoch == invalidMSecs())
+            return found.data;
+        if (found.contains(forMSecsSinceEpoch)) {
+            locker.relock();
+            m_periodCache.period = found;
+        }
+        data = found.data;
+    }
+
+    data.atMSecsSinceEpoch = forMSecsSinceEpoch;
+    return data;
+}
+
+void QTzTimeZonePrivate::offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                        int count) const
+{
+    // Keep the current period locally, instead of taking the lock for each entry
+    Period current;
+    for (int i = 0; i < count; ++i) {
+        if (!current.contains(atMSecsSinceEpoch[i]))
+            current = period(atMSecsSinceEpoch[i]);
+        offsets[i] = current.data.offsetFromUtc;
+    }
 }
 
 bool QTzTimeZonePrivate::hasTransitions() const
@@ -999,11 +1132,10 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::nextTransition(qint64 afterMSecsSince
     }
 
     // Otherwise if we can find a valid tran then use its rule
-    for (int i = 0; i < m_tranTimes.size(); ++i) {
-        if (m_tranTimes.at(i).atMSecsSinceEpoch > afterMSecsSinceEpoch) {
-            return dataForTzTransition(m_tranTimes.at(i));
-        }
-    }
+    const auto next = std::upper_bound(m_tranTimes.cbegin(), m_tranTimes.cend(),
+                                       afterMSecsSinceEpoch, atLessThan);
+    if (next != m_tranTimes.cend())
+        return dataForTzTransition(*next);
 
     // Otherwise we have no rule, or there is no next transition, so return invalid data
     return invalidData();
@@ -1025,11 +1157,10 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::previousTransition(qint64 beforeMSecs
     }
 
     // Otherwise if we can find a valid tran then use its rule
-    for (int i = m_tranTimes.size() - 1; i >= 0; --i) {
-        if (m_tranTimes.at(i).atMSecsSinceEpoch < beforeMSecsSinceEpoch) {
-            return dataForTzTransition(m_tranTimes.at(i));
-        }
-    }
+    const auto next = std::lower_bound(m_tranTimes.cbegin(), m_tranTimes.cend(),
+                                       beforeMSecsSinceEpoch, atLessThanMSecs);
+    if (next != m_tranTimes.cbegin())
+        return dataForTzTransition(*(next - 1));
 
     // Otherwise we have no rule, so return invalid data
     return invalidData();
@@ -4,6 +4,8 @@ intel_icc: QMAKE_CXXFLAGS += -fp-model strict
 
 HEADERS +=  \
         tools/qalgorithms.h \
+        tools/qarenaallocator.h \
+        tools/qarenaallocator_p.h \
         tools/qarraydata.h \
         tools/qarraydataops.h \
         tools/qarraydatapointer.h \
@@ -17,12 +19,14 @@ HEADERS +=  \
         tools/qchar.h \
         tools/qcollator.h \
         tools/qcollator_p.h \
+        tools/qconcurrentcache.h \
         tools/qcontainerfwd.h \
         tools/qcryptographichash.h \
         tools/qdatetime.h \
         tools/qdatetime_p.h \
         tools/qdoublescanprint_p.h \
         tools/qeasingcurve.h \
+        tools/qflathash.h \
         tools/qfreelist_p.h \
         tools/qhash.h \
         tools/qhashfunctions.h \
@@ -53,6 +57,7 @@ HEADERS +=  \
         tools/qsharedpointer_impl.h \
         tools/qset.h \
         tools/qsimd_p.h \
+        tools/qsmallstring.h \
         tools/qsize.h \
         tools/qstack.h \
         tools/qstring.h \
@@ -75,6 +80,7 @@ HEADERS +=  \
 
 
 SOURCES += \
+        tools/qarenaallocator.cpp \
         tools/qarraydata.cpp \
         tools/qbitarray.cpp \
         tools/qbytearray.cpp \
@@ -103,6 +109,7 @@ SOURCES += \
         tools/qshareddata.cpp \
         tools/qsharedpointer.cpp \
         tools/qsimd.cpp \
+        tools/qsmallstring.cpp \
         tools/qsize.cpp \
         tools/qstring.cpp \
         tools/qstringbuilder.cpp \
@@ -48,6 +48,7 @@
 #include <qtextcodec.h>
 #include <qstack.h>
 #include <qbuffer.h>
+#include <private/qsimd_p.h>
 #ifndef QT_BOOTSTRAPPED
 #include <qcoreapplication.h>
 #else
@@ -1225,6 +1226,57 @@ inline int QXmlStreamReaderPrivate::fastScanSpace()
     return n;
 }
 
+/*!
+  \internal
+
+  Returns the number of characters at the start of [\a p, \a end) that
+  fastScanContentCharList() can append to the text buffer as they are,
+  i.e. before the first control character, '&', '<', ']' or non-character.
+  \a allSpaces is set to whether they are all spaces.
+ */
+static int plainContentLength(const ushort *p, const ushort *end, bool *allSpaces)
+{
+    const ushort *begin = p;
+    bool spaces = true;
+#ifdef __SSE2__
+    const __m128i controlMax = _mm_set1_epi16(0x1f);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i ones = _mm_set1_epi16(-1);
+    const __m128i amp = _mm_set1_epi16('&');
+    const __m128i lt = _mm_set1_epi16('<');
+    const __m128i bracket = _mm_set1_epi16(']');
+    const __m128i space = _mm_set1_epi16(' ');
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; end - p >= 8; p += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        // unsigned c <= 0x1f and c >= 0xfffe through saturating arithmetic
+        __m128i special = _mm_cmpeq_epi16(_mm_subs_epu16(data, controlMax), zero);
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(_mm_adds_epu16(data, one), ones));
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(data, amp));
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(data, lt));
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(data, bracket));
+        const uint specialMask = _mm_movemask_epi8(special);
+        const uint plainMask = specialMask ? (1u << qCountTrailingZeroBits(specialMask)) - 1 : 0xffffu;
+        const uint spaceMask = _mm_movemask_epi8(_mm_cmpeq_epi16(data, space));
+        if ((spaceMask & plainMask) != plainMask)
+            spaces = false;
+        if (specialMask) {
+            *allSpaces = spaces;
+            return int(p - begin) + qCountTrailingZeroBits(specialMask) / 2;
+        }
+    }
+#endif
+    for ( ; p < end; ++p) {
+        const ushort c = *p;
+        if (c < 0x20 || c == '&' || c == '<' || c == ']' || c >= 0xfffe)
+            break;
+        if (c != ' ')
+            spaces = false;
+    }
+    *allSpaces = spaces;
+    return int(p - begin);
+}
+
 /*!
   \internal
 
@@ -1235,7 +1287,23 @@ inline int QXmlStreamReaderPrivate::fastScanContentCharList()
 {
     int n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    forever {
+        // copy runs of ordinary characters straight from the decoded buffer
+        if (putStack.isEmpty() && readBufferPos < readBuffer.size()) {
+            const ushort *begin = readBuffer.utf16() + readBufferPos;
+            bool allSpaces;
+            const int length = plainContentLength(begin, begin + readBuffer.size() - readBufferPos,
+                                                  &allSpaces);
+            if (length) {
+                textBuffer.append(reinterpret_cast<const QChar *>(begin), length);
+                readBufferPos += length;
+                n += length;
+                if (!allSpaces)
+                    isWhitespace = false;
+            }
+        }
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
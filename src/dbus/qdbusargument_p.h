@@ -90,6 +90,7 @@ public:
     }
     static inline QDBusArgumentPrivate *d(QDBusArgument &q)
     { return q.d; }
+    static bool demarshallFixedList(const QDBusArgument &q, int id, void *data);
 
 public:
     DBusMessage *message;
@@ -143,6 +144,7 @@ public:
 
     bool appendVariantInternal(const QVariant &arg);
     bool appendRegisteredType(const QVariant &arg);
+    bool appendFixedList(const QVariant &arg);
     bool appendCrossMarshalling(QDBusDemarshaller *arg);
 
 public:
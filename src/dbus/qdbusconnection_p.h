@@ -332,7 +332,6 @@ public:
     SignalHookHash signalHooks;
     MatchRefCountHash matchRefCounts;
     ObjectTreeNode rootNode;
-    MetaObjectHash cachedMetaObjects;
     PendingCallList pendingCalls;
 
     bool anonymousAuthenticationAllowed;
@@ -359,6 +359,81 @@ QByteArray QDBusDemarshaller::toByteArray()
     return QByteArray();
 }
 
+template <typename T, typename Wire>
+static void qIterGetFixedList(DBusMessageIter *it, void *data)
+{
+    DBusMessageIter sub;
+    q_dbus_message_iter_recurse(it, &sub);
+    q_dbus_message_iter_next(it);
+    int len;
+    const Wire *values;
+    q_dbus_message_iter_get_fixed_array(&sub, &values, &len);
+
+    QList<T> &list = *static_cast<QList<T> *>(data);
+    list.clear();
+    list.reserve(len);
+    for (int i = 0; i < len; ++i)
+        list.append(T(values[i]));
+}
+
+bool QDBusArgumentPrivate::demarshallFixedList(const QDBusArgument &q, int id, void *data)
+{
+    int type;
+    if (id == qMetaTypeId<QList<bool> >())
+        type = DBUS_TYPE_BOOLEAN;
+    else if (id == qMetaTypeId<QList<short> >())
+        type = DBUS_TYPE_INT16;
+    else if (id == qMetaTypeId<QList<ushort> >())
+        type = DBUS_TYPE_UINT16;
+    else if (id == qMetaTypeId<QList<int> >())
+        type = DBUS_TYPE_INT32;
+    else if (id == qMetaTypeId<QList<uint> >())
+        type = DBUS_TYPE_UINT32;
+    else if (id == qMetaTypeId<QList<qlonglong> >())
+        type = DBUS_TYPE_INT64;
+    else if (id == qMetaTypeId<QList<qulonglong> >())
+        type = DBUS_TYPE_UINT64;
+    else if (id == qMetaTypeId<QList<double> >())
+        type = DBUS_TYPE_DOUBLE;
+    else
+        return false;
+
+    if (!checkReadAndDetach(q.d))
+        return false;
+    DBusMessageIter *it = &q.d->demarshaller()->iterator;
+    if (q_dbus_message_iter_get_arg_type(it) != DBUS_TYPE_ARRAY
+            || q_dbus_message_iter_get_element_type(it) != type)
+        return false;           // let the generic code deal with it
+
+    switch (type) {
+    case DBUS_TYPE_BOOLEAN:
+        qIterGetFixedList<bool, dbus_bool_t>(it, data);
+        break;
+    case DBUS_TYPE_INT16:
+        qIterGetFixedList<short, dbus_int16_t>(it, data);
+        break;
+    case DBUS_TYPE_UINT16:
+        qIterGetFixedList<ushort, dbus_uint16_t>(it, data);
+        break;
+    case DBUS_TYPE_INT32:
+        qIterGetFixedList<int, dbus_int32_t>(it, data);
+        break;
+    case DBUS_TYPE_UINT32:
+        qIterGetFixedList<uint, dbus_uint32_t>(it, data);
+        break;
+    case DBUS_TYPE_INT64:
+        qIterGetFixedList<qlonglong, dbus_int64_t>(it, data);
+        break;
+    case DBUS_TYPE_UINT64:
+        qIterGetFixedList<qulonglong, dbus_uint64_t>(it, data);
+        break;
+    case DBUS_TYPE_DOUBLE:
+        qIterGetFixedList<double, double>(it, data);
+        break;
+    }
+    return true;
+}
+
 bool QDBusDemarshaller::atEnd()
 {
     // dbus_message_iter_has_next is broken if the list has one single element
@@ -132,6 +132,17 @@ qdbusThreadDebugFunc qdbusThreadDebug = 0;
 typedef QVarLengthArray<QDBusSpyCallEvent::Hook, 4> QDBusSpyHookList;
 Q_GLOBAL_STATIC(QDBusSpyHookList, qDBusSpyHookList)
 
+// Metaobjects generated from introspection data depend only on the interface
+// definition, so they are shared by all connections in the process
+struct QDBusMetaObjectCache
+{
+    ~QDBusMetaObjectCache() { qDeleteAll(metaObjects); }
+
+    QReadWriteLock lock;
+    QDBusConnectionPrivate::MetaObjectHash metaObjects;
+};
+Q_GLOBAL_STATIC(QDBusMetaObjectCache, qDBusMetaObjectCache)
+
 extern "C" {
 
     // libdbus-1 callbacks
@@ -786,13 +797,14 @@ QDBusCallDeliveryEvent* QDBusConnectionPrivate::prepareReply(QDBusConnectionPriv
     if (metaTypes[n] == QDBusMetaTypeId::message())
         --n;
 
-    if (msg.arguments().count() < n)
+    const QVariantList arguments = msg.arguments();
+    if (arguments.count() < n)
         return 0;               // too few arguments
 
     // check that types match
     for (int i = 0; i < n; ++i)
-        if (metaTypes.at(i + 1) != msg.arguments().at(i).userType() &&
-            msg.arguments().at(i).userType() != qMetaTypeId<QDBusArgument>())
+        if (metaTypes.at(i + 1) != arguments.at(i).userType() &&
+            arguments.at(i).userType() != QDBusMetaTypeId::argument())
             return 0;           // no match
 
     // we can deliver
@@ -1070,7 +1082,6 @@ QDBusConnectionPrivate::~QDBusConnectionPrivate()
                  qPrintable(name));
 
     closeConnection();
-    qDeleteAll(cachedMetaObjects);
 
     if (mode == ClientMode || mode == PeerMode) {
         // the bus service object holds a reference back to us;
@@ -1619,24 +1630,41 @@ void QDBusConnectionPrivate::handleSignal(const QString &key, const QDBusMessage
 {
     SignalHookHash::const_iterator it = signalHooks.constFind(key);
     SignalHookHash::const_iterator end = signalHooks.constEnd();
+    if (it == end)
+        return;
+
+    // fetch what we compare against only once, not once per hook
+    const QString service = msg.service();
+    const QString path = msg.path();
+    const QString signature = msg.signature();
+    QStringList argumentStrings;
+    bool argumentsConverted = false;
+
     //qDebug("looking for: %s", path.toLocal8Bit().constData());
     //qDBusDebug() << signalHooks.keys();
     for ( ; it != end && it.key() == key; ++it) {
         const SignalHook &hook = it.value();
         if (!hook.service.isEmpty()) {
-            QString owner = watchedServices.value(hook.service, WatchedServiceData(hook.service)).owner;
-            if (owner != msg.service())
+            WatchedServicesHash::ConstIterator wit = watchedServices.constFind(hook.service);
+            const QString &owner = wit != watchedServices.constEnd() ? wit->owner : hook.service;
+            if (owner != service)
                 continue;
         }
-        if (!hook.path.isEmpty() && hook.path != msg.path())
+        if (!hook.path.isEmpty() && hook.path != path)
             continue;
-        if (!hook.signature.isEmpty() && hook.signature != msg.signature())
+        if (!hook.signature.isEmpty() && hook.signature != signature)
             continue;
-        if (hook.signature.isEmpty() && !hook.signature.isNull() && !msg.signature().isEmpty())
+        if (hook.signature.isEmpty() && !hook.signature.isNull() && !signature.isEmpty())
             continue;
         if (!hook.argumentMatch.isEmpty()) {
-            const QVariantList arguments = msg.arguments();
-            if (hook.argumentMatch.size() > arguments.size())
+            if (!argumentsConverted) {
+                const QVariantList arguments = msg.arguments();
+                argumentStrings.reserve(arguments.size());
+                for (const QVariant &argument : arguments)
+                    argumentStrings.append(argument.toString());
+                argumentsConverted = true;
+            }
+            if (hook.argumentMatch.size() > argumentStrings.size())
                 continue;
 
             bool matched = true;
@@ -1644,7 +1672,7 @@ void QDBusConnectionPrivate::handleSignal(const QString &key, const QDBusMessage
                 const QString &param = hook.argumentMatch.at(i);
                 if (param.isNull())
                     continue;   // don't try to match against this
-                if (param == arguments.at(i).toString())
+                if (param == argumentStrings.at(i))
                     continue;   // matched
                 matched = false;
                 break;
@@ -1672,6 +1700,8 @@ void QDBusConnectionPrivate::handleSignal(const QDBusMessage& msg)
     key += msg.interface();
 
     QDBusReadLocker locker(HandleSignalAction, this);
+    if (signalHooks.isEmpty())
+        return;
     handleSignal(key, msg);                  // one try
 
     key.truncate(msg.member().length() + 1); // keep the ':'
@@ -2530,10 +2560,12 @@ QDBusMetaObject *
 QDBusConnectionPrivate::findMetaObject(const QString &service, const QString &path,
                                        const QString &interface, QDBusError &error)
 {
+    QDBusMetaObjectCache *cache = qDBusMetaObjectCache();
+
     // service must be a unique connection name
     if (!interface.isEmpty()) {
-        QDBusReadLocker locker(FindMetaObject1Action, this);
-        QDBusMetaObject *mo = cachedMetaObjects.value(interface, 0);
+        QReadLocker locker(&cache->lock);
+        QDBusMetaObject *mo = cache->metaObjects.value(interface, 0);
         if (mo)
             return mo;
     }
@@ -2546,15 +2578,6 @@ QDBusConnectionPrivate::findMetaObject(const QString &service, const QString &pa
 
     QDBusMessage reply = sendWithReply(msg, QDBus::Block);
 
-    // it doesn't exist yet, we have to create it
-    QDBusWriteLocker locker(FindMetaObject2Action, this);
-    QDBusMetaObject *mo = 0;
-    if (!interface.isEmpty())
-        mo = cachedMetaObjects.value(interface, 0);
-    if (mo)
-        // maybe it got created when we switched from read to write lock
-        return mo;
-
     QString xml;
     if (reply.type() == QDBusMessage::ReplyMessage) {
         if (reply.signature() == QLatin1String("s"))
@@ -2562,14 +2585,27 @@ QDBusConnectionPrivate::findMetaObject(const QString &service, const QString &pa
             xml = reply.arguments().at(0).toString();
     } else {
         error = QDBusError(reply);
-        lastError = error;
-        if (reply.type() != QDBusMessage::ErrorMessage || error.type() != QDBusError::UnknownMethod)
+        if (reply.type() != QDBusMessage::ErrorMessage || error.type() != QDBusError::UnknownMethod) {
+            QDBusWriteLocker locker(FindMetaObject2Action, this);
+            lastError = error;
             return 0; // error
+        }
     }
 
-    // release the lock and return
-    QDBusMetaObject *result = QDBusMetaObject::createMetaObject(interface, xml,
-                                                                cachedMetaObjects, error);
+    // it doesn't exist yet, we have to create it
+    QDBusMetaObject *result = 0;
+    {
+        QWriteLocker locker(&cache->lock);
+        if (!interface.isEmpty())
+            result = cache->metaObjects.value(interface, 0);
+        if (result)
+            // maybe it got created when we switched from read to write lock
+            error = QDBusError();
+        else
+            result = QDBusMetaObject::createMetaObject(interface, xml, cache->metaObjects, error);
+    }
+
+    QDBusWriteLocker locker(FindMetaObject2Action, this);
     lastError = error;
     return result;
 }
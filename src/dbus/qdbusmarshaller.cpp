@@ -42,6 +42,8 @@
 #include "qdbusmetatype_p.h"
 #include "qdbusutil_p.h"
 
+#include <qvarlengtharray.h>
+
 #ifndef QT_NO_DBUS
 
 QT_BEGIN_NAMESPACE
@@ -54,6 +56,24 @@ static void qIterAppend(DBusMessageIter *it, QByteArray *ba, int type, const voi
         q_dbus_message_iter_append_basic(it, type, arg);
 }
 
+template <typename T, typename Wire>
+static void qIterAppendFixedList(DBusMessageIter *it, int type, const void *arg)
+{
+    // QList stores small types in pointer-sized slots, so copy into a
+    // contiguous buffer and hand the whole array to libdbus in one go
+    const QList<T> &list = *static_cast<const QList<T> *>(arg);
+    QVarLengthArray<Wire, 256> buffer(list.size());
+    for (int i = 0; i < list.size(); ++i)
+        buffer[i] = Wire(list.at(i));
+
+    const char signature[2] = { char(type), 0 };
+    const Wire *data = buffer.constData();
+    DBusMessageIter sub;
+    q_dbus_message_iter_open_container(it, DBUS_TYPE_ARRAY, signature, &sub);
+    q_dbus_message_iter_append_fixed_array(&sub, type, &data, buffer.size());
+    q_dbus_message_iter_close_container(it, &sub);
+}
+
 QDBusMarshaller::~QDBusMarshaller()
 {
     close();
@@ -524,8 +544,38 @@ bool QDBusMarshaller::appendVariantInternal(const QVariant &arg)
     return true;
 }
 
+bool QDBusMarshaller::appendFixedList(const QVariant &arg)
+{
+    const int id = arg.userType();
+    const void *data = arg.constData();
+    if (id == qMetaTypeId<QList<bool> >())
+        qIterAppendFixedList<bool, dbus_bool_t>(&iterator, DBUS_TYPE_BOOLEAN, data);
+    else if (id == qMetaTypeId<QList<short> >())
+        qIterAppendFixedList<short, dbus_int16_t>(&iterator, DBUS_TYPE_INT16, data);
+    else if (id == qMetaTypeId<QList<ushort> >())
+        qIterAppendFixedList<ushort, dbus_uint16_t>(&iterator, DBUS_TYPE_UINT16, data);
+    else if (id == qMetaTypeId<QList<int> >())
+        qIterAppendFixedList<int, dbus_int32_t>(&iterator, DBUS_TYPE_INT32, data);
+    else if (id == qMetaTypeId<QList<uint> >())
+        qIterAppendFixedList<uint, dbus_uint32_t>(&iterator, DBUS_TYPE_UINT32, data);
+    else if (id == qMetaTypeId<QList<qlonglong> >())
+        qIterAppendFixedList<qlonglong, dbus_int64_t>(&iterator, DBUS_TYPE_INT64, data);
+    else if (id == qMetaTypeId<QList<qulonglong> >())
+        qIterAppendFixedList<qulonglong, dbus_uint64_t>(&iterator, DBUS_TYPE_UINT64, data);
+    else if (id == qMetaTypeId<QList<double> >())
+        qIterAppendFixedList<double, double>(&iterator, DBUS_TYPE_DOUBLE, data);
+    else
+        return false;
+    return true;
+}
+
 bool QDBusMarshaller::appendRegisteredType(const QVariant &arg)
 {
+    // lists of fixed-size types go straight to libdbus instead of
+    // being appended one element at a time through QDBusArgument
+    if (!ba && appendFixedList(arg))
+        return true;
+
     ref.ref();                  // reference up
     QDBusArgument self(QDBusArgumentPrivate::create(this));
     return QDBusMetaType::marshall(self, arg.userType(), arg.constData());
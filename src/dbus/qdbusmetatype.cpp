@@ -283,6 +283,8 @@ bool QDBusMetaType::demarshall(const QDBusArgument &arg, int id, void *data)
     }
 #ifndef QT_BOOTSTRAPPED
     QDBusArgument copy = arg;
+    if (QDBusArgumentPrivate::demarshallFixedList(copy, id, data))
+        return true;
     df(copy, data);
 #else
     Q_UNUSED(arg);
@@ -849,6 +849,11 @@ void QAccessible::setRootObject(QObject *object)
   performance penalty for calling this function is small, but if
   determining the parameters of the call is expensive you can test
   QAccessible::isActive() to avoid unnecessary computation.
+
+  Since Qt 5.11, repeated name, description, help, location and visible
+  data changes, as well as table model DataChanged events, for the same
+  object are merged and delivered to the platform once per event loop
+  iteration.
 */
 void QAccessible::updateAccessibility(QAccessibleEvent *event)
 {
@@ -858,21 +863,43 @@ void QAccessible::updateAccessibility(QAccessibleEvent *event)
     // during construction of widgets. If you see cases where the
     // cache seems wrong, this call is "to blame", but the code that
     // caches dynamic data should be updated to handle change events.
-    QAccessibleInterface *iface = event->accessibleInterface();
-    if (isActive() && iface) {
-        if (event->type() == QAccessible::TableModelChanged) {
-            if (iface->tableInterface())
-                iface->tableInterface()->modelChange(static_cast<QAccessibleTableModelChangeEvent*>(event));
+    // Only do so when accessibility is active, though: creating an
+    // interface for every widget that is constructed or shown is
+    // expensive, and nobody listens to the event otherwise.
+    if (isActive()) {
+        // Resolve the interface only when somebody needs it here; the
+        // platform backend creates child interfaces on demand.
+        if (updateHandler || event->type() == QAccessible::TableModelChanged) {
+            QAccessibleInterface *iface = event->accessibleInterface();
+            if (iface) {
+                if (event->type() == QAccessible::TableModelChanged) {
+                    if (iface->tableInterface())
+                        iface->tableInterface()->modelChange(static_cast<QAccessibleTableModelChangeEvent*>(event));
+                }
+
+                if (updateHandler) {
+                    updateHandler(event);
+                    return;
+                }
+            }
         }
+    }
 
-        if (updateHandler) {
-            updateHandler(event);
+    QPlatformAccessibility *pfAccessibility = platformAccessibility();
+    if (!pfAccessibility)
+        return;
+
+    if (isActive()) {
+        // Coalesce property and data changes until the next event loop
+        // iteration; anything else is delivered right away, after what
+        // has been queued so far to keep the order intact.
+        QAccessibleCache *cache = QAccessibleCache::instance();
+        if (cache->queueEvent(event))
             return;
-        }
+        cache->flushEvents();
     }
 
-    if (QPlatformAccessibility *pfAccessibility = platformAccessibility())
-        pfAccessibility->notifyAccessibilityUpdate(event);
+    pfAccessibility->notifyAccessibilityUpdate(event);
 }
 
 #if QT_DEPRECATED_SINCE(5, 0)
@@ -39,6 +39,11 @@
 
 #include "qaccessiblecache_p.h"
 
+#include <QtCore/qcoreevent.h>
+#include <QtGui/private/qguiapplication_p.h>
+#include <qpa/qplatformaccessibility.h>
+#include <qpa/qplatformintegration.h>
+
 #ifndef QT_NO_ACCESSIBILITY
 
 QT_BEGIN_NAMESPACE
@@ -143,6 +148,130 @@ void QAccessibleCache::deleteInterface(QAccessible::Id id, QObject *obj)
 #endif
 }
 
+/*!
+    Defers delivery of \a event to the platform accessibility backend
+    until the next event loop iteration, merging it with equivalent
+    pending events. Returns \c true if the event was queued, in which
+    case it must not be delivered by the caller.
+
+    Only events that carry no state of their own are deferred: property
+    changes that assistive technology will query anyway, and DataChanged
+    table model changes, whose ranges are united. Views that update their
+    model item by item thus result in a single notification per frame,
+    and the interfaces of the affected children are only created once
+    the notification is actually delivered.
+*/
+bool QAccessibleCache::queueEvent(QAccessibleEvent *event)
+{
+    // events created from an interface can't be recreated later
+    QObject *object = event->object();
+    if (!object)
+        return false;
+
+    int firstRow = -1;
+    int firstColumn = -1;
+    int lastRow = -1;
+    int lastColumn = -1;
+
+    switch (event->type()) {
+    case QAccessible::NameChanged:
+    case QAccessible::DescriptionChanged:
+    case QAccessible::HelpChanged:
+    case QAccessible::LocationChanged:
+    case QAccessible::VisibleDataChanged:
+        break;
+    case QAccessible::TableModelChanged: {
+        QAccessibleTableModelChangeEvent *change = static_cast<QAccessibleTableModelChangeEvent *>(event);
+        if (change->modelChangeType() != QAccessibleTableModelChangeEvent::DataChanged)
+            return false;
+        firstRow = change->firstRow();
+        firstColumn = change->firstColumn();
+        lastRow = change->lastRow();
+        lastColumn = change->lastColumn();
+        if (firstRow < 0 || firstColumn < 0 || lastRow < 0 || lastColumn < 0)
+            return false;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    const PendingEventKey key = { object, event->child(), event->type() };
+    const auto it = pendingEventIndex.constFind(key);
+    if (it != pendingEventIndex.constEnd()) {
+        PendingEvent &pending = pendingEvents[it.value()];
+        if (pending.object.isNull()) {
+            // a new object reused the address of a deleted one
+            pending.object = object;
+            pending.firstRow = firstRow;
+            pending.firstColumn = firstColumn;
+            pending.lastRow = lastRow;
+            pending.lastColumn = lastColumn;
+        } else if (key.type == QAccessible::TableModelChanged) {
+            pending.firstRow = qMin(pending.firstRow, firstRow);
+            pending.firstColumn = qMin(pending.firstColumn, firstColumn);
+            pending.lastRow = qMax(pending.lastRow, lastRow);
+            pending.lastColumn = qMax(pending.lastColumn, lastColumn);
+        }
+        return true;
+    }
+
+    const PendingEvent pending = { object, key.child, key.type, firstRow, firstColumn, lastRow, lastColumn };
+    pendingEventIndex.insert(key, pendingEvents.size());
+    pendingEvents.append(pending);
+    if (!flushTimer.isActive())
+        flushTimer.start(0, this);
+    return true;
+}
+
+/*!
+    Delivers all events queued by queueEvent() to the platform
+    accessibility backend, in the order they were first queued.
+*/
+void QAccessibleCache::flushEvents()
+{
+    if (pendingEvents.isEmpty())
+        return;
+    flushTimer.stop();
+
+    // delivering an event may cause new ones to be queued
+    const QVector<PendingEvent> events = std::move(pendingEvents);
+    pendingEvents.clear();
+    pendingEventIndex.clear();
+
+    QPlatformIntegration *pfIntegration = QGuiApplicationPrivate::platformIntegration();
+    QPlatformAccessibility *pfAccessibility = pfIntegration ? pfIntegration->accessibility() : nullptr;
+    if (!pfAccessibility)
+        return;
+
+    for (const PendingEvent &pending : events) {
+        QObject *object = pending.object.data();
+        if (!object)
+            continue;
+        if (pending.type == QAccessible::TableModelChanged) {
+            QAccessibleTableModelChangeEvent event(object, QAccessibleTableModelChangeEvent::DataChanged);
+            event.setFirstRow(pending.firstRow);
+            event.setFirstColumn(pending.firstColumn);
+            event.setLastRow(pending.lastRow);
+            event.setLastColumn(pending.lastColumn);
+            pfAccessibility->notifyAccessibilityUpdate(&event);
+        } else {
+            QAccessibleEvent event(object, pending.type);
+            event.setChild(pending.child);
+            pfAccessibility->notifyAccessibilityUpdate(&event);
+        }
+    }
+}
+
+void QAccessibleCache::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == flushTimer.timerId()) {
+        flushEvents();
+        return;
+    }
+    QObject::timerEvent(event);
+}
+
 QT_END_NAMESPACE
 
 #endif
@@ -54,6 +54,9 @@
 #include <QtGui/private/qtguiglobal_p.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qbasictimer.h>
 
 #include "qaccessible.h"
 
@@ -74,17 +77,48 @@ public:
     QAccessible::Id insert(QObject *object, QAccessibleInterface *iface) const;
     void deleteInterface(QAccessible::Id id, QObject *obj = 0);
 
+    bool queueEvent(QAccessibleEvent *event);
+    void flushEvents();
+
 #ifdef Q_OS_MAC
     QT_MANGLE_NAMESPACE(QMacAccessibilityElement) *elementForId(QAccessible::Id axid) const;
     void insertElement(QAccessible::Id axid, QT_MANGLE_NAMESPACE(QMacAccessibilityElement) *element) const;
 #endif
 
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
 private Q_SLOTS:
     void objectDestroyed(QObject *obj);
 
 private:
     QAccessible::Id acquireId() const;
 
+    struct PendingEventKey {
+        const QObject *object;
+        int child;
+        QAccessible::Event type;
+
+        bool operator==(const PendingEventKey &other) const
+        { return object == other.object && child == other.child && type == other.type; }
+    };
+    friend uint qHash(const PendingEventKey &key, uint seed = 0) Q_DECL_NOTHROW
+    { return qHash(key.object, seed) ^ uint(key.child) ^ (uint(key.type) << 16); }
+
+    struct PendingEvent {
+        QPointer<QObject> object;
+        int child;
+        QAccessible::Event type;
+        int firstRow;
+        int firstColumn;
+        int lastRow;
+        int lastColumn;
+    };
+
+    QVector<PendingEvent> pendingEvents;
+    QHash<PendingEventKey, int> pendingEventIndex;
+    QBasicTimer flushTimer;
+
     mutable QHash<QAccessible::Id, QAccessibleInterface *> idToInterface;
     mutable QHash<QAccessibleInterface *, QAccessible::Id> interfaceToId;
     mutable QHash<QObject *, QAccessible::Id> objectToId;
@@ -74,3 +74,16 @@ QImageReader reader(":/image.png");
 if (reader.supportsOption(QImageIOHandler::Size))
     qDebug() << "Size:" << reader.size();
 //! [3]
+
+
+//! [4]
+QImageReader *reader = new QImageReader("photo.jpg");
+reader->setScaledSize(QSize(256, 256));
+QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>;
+QObject::connect(watcher, &QFutureWatcher<QImage>::finished, [reader, watcher]() {
+    label->setPixmap(QPixmap::fromImage(watcher->result()));
+    delete reader;
+    watcher->deleteLater();
+});
+watcher->setFuture(reader->readAsync());
+//! [4]
@@ -7,6 +7,8 @@ HEADERS += \
         image/qbitmap.h \
         image/qimage.h \
         image/qimage_p.h \
+        image/qimagecache.h \
+        image/qsharedimagecache.h \
         image/qimageiohandler.h \
         image/qimagereader.h \
         image/qimagewriter.h \
@@ -30,6 +32,8 @@ HEADERS += \
 SOURCES += \
         image/qbitmap.cpp \
         image/qimage.cpp \
+        image/qimagecache.cpp \
+        image/qsharedimagecache.cpp \
         image/qimage_conversions.cpp \
         image/qimageiohandler.cpp \
         image/qimagereader.cpp \
@@ -44,12 +44,15 @@
 
 #include <QtGui/QIconEnginePlugin>
 #include <QtGui/QPixmapCache>
+#include <QtGui/QSharedImageCache>
 #include <qpa/qplatformtheme.h>
 #include <QtGui/QIconEngine>
 #include <QtGui/QPalette>
 #include <QtCore/qmath.h>
 #include <QtCore/QList>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QSet>
 #include <QtCore/QSettings>
 #include <QtGui/QPainter>
 
@@ -292,6 +295,49 @@ QVector<const char *> QIconCacheGtkReader::lookup(const QStringRef &name)
     return ret;
 }
 
+/*!
+    \internal
+    Helper class that lists the files in the subdirectories of an icon theme
+    directory that has no usable GTK+ cache. Without it, looking up an icon
+    has to stat a file for every subdirectory and extension of the theme.
+    Each subdirectory is read once, the first time an icon is looked up in
+    it, and the index is shared by all the copies of the theme.
+*/
+class QIconDirIndex
+{
+public:
+    explicit QIconDirIndex(const QString &themeDir) : m_themeDir(themeDir) {}
+    bool contains(const QString &subDir, const QString &fileName);
+private:
+    static QString normalized(const QString &fileName)
+    {
+#ifdef Q_OS_WIN
+        return fileName.toLower(); // like the file system, ignore the case
+#else
+        return fileName;
+#endif
+    }
+
+    QString m_themeDir;
+    QHash<QString, QSet<QString> > m_files;
+};
+
+bool QIconDirIndex::contains(const QString &subDir, const QString &fileName)
+{
+    QHash<QString, QSet<QString> >::iterator it = m_files.find(subDir);
+    if (it == m_files.end()) {
+        QSet<QString> files;
+        // no filter, so that entries are not stat'ed one by one
+        QDirIterator dirIt(m_themeDir + QLatin1Char('/') + subDir, QDir::NoFilter);
+        while (dirIt.hasNext()) {
+            dirIt.next();
+            files.insert(normalized(dirIt.fileName()));
+        }
+        it = m_files.insert(subDir, files);
+    }
+    return it->contains(normalized(fileName));
+}
+
 QIconTheme::QIconTheme(const QString &themeName)
         : m_valid(false)
 {
@@ -306,6 +352,7 @@ QIconTheme::QIconTheme(const QString &themeName)
         if (themeDirInfo.isDir()) {
             m_contentDirs << themeDir;
             m_gtkCaches << QSharedPointer<QIconCacheGtkReader>::create(themeDir);
+            m_dirIndexes << QSharedPointer<QIconDirIndex>::create(themeDir);
         }
 
         if (!m_valid) {
@@ -427,12 +474,19 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
                 }
             }
 
+            // Otherwise, look the files up in the listing of the subdirectories
+            QIconDirIndex *index = cache->isValid() ? nullptr : theme.m_dirIndexes.at(i).data();
+            const auto iconExists = [index](const QIconDirInfo &dirInfo, const QString &fileName,
+                                            const QString &filePath) {
+                return index ? index->contains(dirInfo.path, fileName) : QFile::exists(filePath);
+            };
+
             QString contentDir = contentDirs.at(i) + QLatin1Char('/');
             for (int j = 0; j < subDirs.size() ; ++j) {
                 const QIconDirInfo &dirInfo = subDirs.at(j);
                 const QString subDir = contentDir + dirInfo.path + QLatin1Char('/');
                 const QString pngPath = subDir + pngIconName;
-                if (QFile::exists(pngPath)) {
+                if (iconExists(dirInfo, pngIconName, pngPath)) {
                     PixmapEntry *iconEntry = new PixmapEntry;
                     iconEntry->dir = dirInfo;
                     iconEntry->filename = pngPath;
@@ -441,7 +495,7 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
                     info.entries.prepend(iconEntry);
                 } else if (m_supportsSvg) {
                     const QString svgPath = subDir + svgIconName;
-                    if (QFile::exists(svgPath)) {
+                    if (iconExists(dirInfo, svgIconName, svgPath)) {
                         ScalableEntry *iconEntry = new ScalableEntry;
                         iconEntry->dir = dirInfo;
                         iconEntry->filename = svgPath;
@@ -667,6 +721,29 @@ QSize QIconLoaderEngine::actualSize(const QSize &size, QIcon::Mode mode,
     return QSize(0, 0);
 }
 
+// Loads an icon file through the cross-process image cache, if there is one,
+// so that applications showing the same icons decode them only once.
+static QPixmap loadIconPixmap(const QString &filename)
+{
+    QSharedImageCache *sharedCache = QSharedImageCache::globalInstance();
+    QFile file(filename);
+    if (!sharedCache || !file.open(QIODevice::ReadOnly))
+        return QPixmap(filename);
+
+    const QByteArray data = file.readAll();
+    QImage image;
+    if (!sharedCache->find(data, &image)) {
+        image = QImage::fromData(data);
+        if (image.isNull())
+            return QPixmap();
+        image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                              : QImage::Format_RGB32);
+        if (sharedCache->insert(data, image))
+            sharedCache->find(data, &image);
+    }
+    return QPixmap::fromImage(std::move(image));
+}
+
 QPixmap PixmapEntry::pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state)
 {
     Q_UNUSED(state);
@@ -674,7 +751,7 @@ QPixmap PixmapEntry::pixmap(const QSize &size, QIcon::Mode mode, QIcon::State st
     // Ensure that basePixmap is lazily initialized before generating the
     // key, otherwise the cache key is not unique
     if (basePixmap.isNull())
-        basePixmap.load(filename);
+        basePixmap = loadIconPixmap(filename);
 
     QSize actualSize = basePixmap.size();
     // If the size of the best match we have (basePixmap) is larger than the
@@ -3003,6 +3003,38 @@ template<class T> inline void do_mirror_data(QImageData *dst, QImageData *src,
                                              int dstXIncr, int dstYIncr,
                                              int w, int h)
 {
+    const qsizetype bytes = qsizetype(src->bytes_per_line) * h;
+    if (dstXIncr < 0) {
+        // Rows are independent of each other, so large images are mirrored
+        // in bands on several threads.
+        if (dst == src) {
+            // Reverse each row in place; when flipping as well, the rows of
+            // each pair are swapped after that, up to the middle line.
+            const int rows = dstY0 ? (h + 1) / 2 : h;
+            qt_imageConvertSegmented(bytes, rows, [=](int yStart, int yEnd) {
+                for (int srcY = yStart; srcY < yEnd; ++srcY) {
+                    T *srcPtr = (T *) (src->data + srcY * src->bytes_per_line);
+                    qt_memreverse(srcPtr, srcPtr, w);
+                    const int dstY = dstY0 + srcY * dstYIncr;
+                    if (dstY != srcY) {
+                        T *dstPtr = (T *) (dst->data + dstY * dst->bytes_per_line);
+                        qt_memreverse(dstPtr, dstPtr, w);
+                        std::swap_ranges(srcPtr, srcPtr + w, dstPtr);
+                    }
+                }
+            });
+        } else {
+            qt_imageConvertSegmented(bytes, h, [=](int yStart, int yEnd) {
+                for (int srcY = yStart; srcY < yEnd; ++srcY) {
+                    const int dstY = dstY0 + srcY * dstYIncr;
+                    qt_memreverse((const T *) (src->data + srcY * src->bytes_per_line),
+                                  (T *) (dst->data + dstY * dst->bytes_per_line), w);
+                }
+            });
+        }
+        return;
+    }
+
     if (dst == src) {
         // When mirroring in-place, stop in the middle for one of the directions, since we
         // are swapping the bytes instead of merely copying.
@@ -53,13 +53,15 @@ void convert_ARGB_to_ARGB_PM_avx2(QImageData *dest, const QImageData *src, Qt::I
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const uint *src_data = (uint *) src->data;
-    uint *dest_data = (uint *) dest->data;
-    for (int i = 0; i < src->height; ++i) {
-        qt_convertARGB32ToARGB32PM(dest_data, src_data, src->width);
-        src_data += src->bytes_per_line >> 2;
-        dest_data += dest->bytes_per_line >> 2;
-    }
+    qt_imageConvertSegmented(qMax(src->nbytes, dest->nbytes), src->height, [=](int yStart, int yEnd) {
+        const uint *src_data = (uint *) (src->data + src->bytes_per_line * yStart);
+        uint *dest_data = (uint *) (dest->data + dest->bytes_per_line * yStart);
+        for (int i = yStart; i < yEnd; ++i) {
+            qt_convertARGB32ToARGB32PM(dest_data, src_data, src->width);
+            src_data += src->bytes_per_line >> 2;
+            dest_data += dest->bytes_per_line >> 2;
+        }
+    });
 }
 
 QT_END_NAMESPACE
@@ -45,6 +45,13 @@
 #include <private/qimage_p.h>
 #include <qendian.h>
 
+#ifndef QT_NO_THREAD
+#include <qatomic.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 struct QDefaultColorTables
@@ -114,6 +121,115 @@ void qGamma_correct_back_to_linear_cs(QImage *image)
     }
 }
 
+/*****************************************************************************
+  Splitting images into bands of rows processed on several threads.
+ *****************************************************************************/
+
+#ifndef QT_NO_THREAD
+namespace {
+struct QImageSegmentRunner
+{
+    QImageSegmentFunction function;
+    void *closure;
+    int height;
+    int segments;
+    QAtomicInt nextSegment;
+
+    // Processes the bands nobody has taken yet
+    void runSegments()
+    {
+        for (int i = nextSegment.fetchAndAddRelaxed(1); i < segments;
+             i = nextSegment.fetchAndAddRelaxed(1)) {
+            const int yStart = int(qint64(height) * i / segments);
+            const int yEnd = int(qint64(height) * (i + 1) / segments);
+            function(closure, yStart, yEnd);
+        }
+    }
+};
+
+class QImageSegmentHelper : public QRunnable
+{
+public:
+    QImageSegmentHelper(QImageSegmentRunner *runner, QSemaphore *done)
+        : runner(runner), done(done)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        runner->runSegments();
+        done->release();
+    }
+
+private:
+    QImageSegmentRunner *runner;
+    QSemaphore *done;
+};
+} // unnamed namespace
+#endif
+
+/*
+    Calls \a function for \a segments bands covering the rows [0, height),
+    using the threads of the global thread pool that are free right away
+    next to the calling thread. As the calling thread takes bands too,
+    this cannot deadlock when called from a pool thread.
+*/
+void qt_imageRunSegments(int segments, int height, QImageSegmentFunction function, void *closure)
+{
+#ifndef QT_NO_THREAD
+    segments = qMin(segments, height);
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    if (segments > 1 && threadPool) {
+        QImageSegmentRunner runner;
+        runner.function = function;
+        runner.closure = closure;
+        runner.height = height;
+        runner.segments = segments;
+        runner.nextSegment.store(0);
+
+        const int maxHelpers = qMin(segments, threadPool->maxThreadCount()) - 1;
+        QSemaphore done;
+        int started = 0;
+        while (started < maxHelpers) {
+            QImageSegmentHelper *helper = new QImageSegmentHelper(&runner, &done);
+            if (!threadPool->tryStart(helper)) {
+                delete helper;
+                break;
+            }
+            ++started;
+        }
+        runner.runSegments();
+        done.acquire(started);
+        return;
+    }
+#else
+    Q_UNUSED(segments);
+#endif
+    function(closure, 0, height);
+}
+
+/*
+    Returns the number of bands a conversion touching \a bytes bytes of
+    image data is split into. A band holds at least 64K bytes by default;
+    the QT_IMAGE_CONVERSION_SEGMENT_SIZE environment variable overrides
+    that minimum.
+*/
+int qt_imageConversionSegments(qsizetype bytes, int height)
+{
+#ifndef QT_NO_THREAD
+    enum { DefaultSegmentSize = 1 << 16 };
+    static const int segmentSize = [] {
+        const int size = qEnvironmentVariableIntValue("QT_IMAGE_CONVERSION_SEGMENT_SIZE");
+        return size > 0 ? size : int(DefaultSegmentSize);
+    }();
+    return int(qBound<qint64>(1, bytes / segmentSize, height));
+#else
+    Q_UNUSED(bytes);
+    Q_UNUSED(height);
+    return 1;
+#endif
+}
+
 /*****************************************************************************
   Internal routines for converting image depth.
  *****************************************************************************/
@@ -145,13 +261,8 @@ void convert_generic(QImageData *dest, const QImageData *src, Qt::ImageConversio
     // Cannot be used with indexed formats.
     Q_ASSERT(dest->format > QImage::Format_Indexed8);
     Q_ASSERT(src->format > QImage::Format_Indexed8);
-    const int buffer_size = 2048;
-    uint buf[buffer_size];
-    uint *buffer = buf;
     const QPixelLayout *srcLayout = &qPixelLayouts[src->format];
     const QPixelLayout *destLayout = &qPixelLayouts[dest->format];
-    const uchar *srcData = src->data;
-    uchar *destData = dest->data;
 
     const FetchPixelsFunc fetch = qFetchPixels[srcLayout->bpp];
     const StorePixelsFunc store = qStorePixels[destLayout->bpp];
@@ -182,31 +293,39 @@ void convert_generic(QImageData *dest, const QImageData *src, Qt::ImageConversio
         else
             convertFromARGB32PM = destLayout->convertFromRGB32;
     }
-    QDitherInfo dither;
-    QDitherInfo *ditherPtr = 0;
-    if ((flags & Qt::PreferDither) && (flags & Qt::Dither_Mask) != Qt::ThresholdDither)
-        ditherPtr = &dither;
-
-    for (int y = 0; y < src->height; ++y) {
-        dither.y = y;
-        int x = 0;
-        while (x < src->width) {
-            dither.x = x;
-            int l = src->width - x;
-            if (destLayout->bpp == QPixelLayout::BPP32)
-                buffer = reinterpret_cast<uint *>(destData) + x;
-            else
-                l = qMin(l, buffer_size);
-            const uint *ptr = fetch(buffer, srcData, x, l);
-            ptr = convertToARGB32PM(buffer, ptr, l, 0, ditherPtr);
-            ptr = convertFromARGB32PM(buffer, ptr, l, 0, ditherPtr);
-            if (ptr != reinterpret_cast<uint *>(destData))
-                store(destData, ptr, x, l);
-            x += l;
+    const bool dithered = (flags & Qt::PreferDither) && (flags & Qt::Dither_Mask) != Qt::ThresholdDither;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        enum { BufferSize = 2048 };
+        uint buf[BufferSize];
+        uint *buffer = buf;
+        const uchar *srcData = src->data + src->bytes_per_line * yStart;
+        uchar *destData = dest->data + dest->bytes_per_line * yStart;
+        QDitherInfo dither;
+        QDitherInfo *ditherPtr = dithered ? &dither : 0;
+
+        for (int y = yStart; y < yEnd; ++y) {
+            dither.y = y;
+            int x = 0;
+            while (x < src->width) {
+                dither.x = x;
+                int l = src->width - x;
+                if (destLayout->bpp == QPixelLayout::BPP32)
+                    buffer = reinterpret_cast<uint *>(destData) + x;
+                else
+                    l = qMin(l, int(BufferSize));
+                const uint *ptr = fetch(buffer, srcData, x, l);
+                ptr = convertToARGB32PM(buffer, ptr, l, 0, ditherPtr);
+                ptr = convertFromARGB32PM(buffer, ptr, l, 0, ditherPtr);
+                if (ptr != reinterpret_cast<uint *>(destData))
+                    store(destData, ptr, x, l);
+                x += l;
+            }
+            srcData += src->bytes_per_line;
+            destData += dest->bytes_per_line;
         }
-        srcData += src->bytes_per_line;
-        destData += dest->bytes_per_line;
-    }
+    };
+    qt_imageConvertSegmented(qMax(src->nbytes, dest->nbytes), src->height, convertSegment);
 }
 
 bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::ImageConversionFlags flags)
@@ -217,11 +336,8 @@ bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::Im
     if (data->depth != qt_depthForFormat(dst_format))
         return false;
 
-    const int buffer_size = 2048;
-    uint buffer[buffer_size];
     const QPixelLayout *srcLayout = &qPixelLayouts[data->format];
     const QPixelLayout *destLayout = &qPixelLayouts[dst_format];
-    uchar *srcData = data->data;
 
     const FetchPixelsFunc fetch = qFetchPixels[srcLayout->bpp];
     const StorePixelsFunc store = qStorePixels[destLayout->bpp];
@@ -251,27 +367,33 @@ bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::Im
         else
             convertFromARGB32PM = destLayout->convertFromRGB32;
     }
-    QDitherInfo dither;
-    QDitherInfo *ditherPtr = 0;
-    if ((flags & Qt::PreferDither) && (flags & Qt::Dither_Mask) != Qt::ThresholdDither)
-        ditherPtr = &dither;
-
-    for (int y = 0; y < data->height; ++y) {
-        dither.y = y;
-        int x = 0;
-        while (x < data->width) {
-            dither.x = x;
-            int l = qMin(data->width - x, buffer_size);
-            const uint *ptr = fetch(buffer, srcData, x, l);
-            ptr = convertToARGB32PM(buffer, ptr, l, 0, ditherPtr);
-            ptr = convertFromARGB32PM(buffer, ptr, l, 0, ditherPtr);
-            // The conversions might be passthrough and not use the buffer, in that case we are already done.
-            if (srcData != (const uchar*)ptr)
-                store(srcData, ptr, x, l);
-            x += l;
+    const bool dithered = (flags & Qt::PreferDither) && (flags & Qt::Dither_Mask) != Qt::ThresholdDither;
+
+    auto convertSegment = [=](int yStart, int yEnd) {
+        enum { BufferSize = 2048 };
+        uint buffer[BufferSize];
+        uchar *srcData = data->data + data->bytes_per_line * yStart;
+        QDitherInfo dither;
+        QDitherInfo *ditherPtr = dithered ? &dither : 0;
+
+        for (int y = yStart; y < yEnd; ++y) {
+            dither.y = y;
+            int x = 0;
+            while (x < data->width) {
+                dither.x = x;
+                int l = qMin(data->width - x, int(BufferSize));
+                const uint *ptr = fetch(buffer, srcData, x, l);
+                ptr = convertToARGB32PM(buffer, ptr, l, 0, ditherPtr);
+                ptr = convertFromARGB32PM(buffer, ptr, l, 0, ditherPtr);
+                // The conversions might be passthrough and not use the buffer, in that case we are already done.
+                if (srcData != (const uchar*)ptr)
+                    store(srcData, ptr, x, l);
+                x += l;
+            }
+            srcData += data->bytes_per_line;
         }
-        srcData += data->bytes_per_line;
-    }
+    };
+    qt_imageConvertSegmented(data->nbytes, data->height, convertSegment);
     data->format = dst_format;
     return true;
 }
@@ -312,21 +434,23 @@ static void convert_ARGB_to_ARGB_PM(QImageData *dest, const QImageData *src, Qt:
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const int src_pad = (src->bytes_per_line >> 2) - src->width;
-    const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
-    const QRgb *src_data = (QRgb *) src->data;
-    QRgb *dest_data = (QRgb *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        const QRgb *end = src_data + src->width;
-        while (src_data < end) {
-            *dest_data = qPremultiply(*src_data);
-            ++src_data;
-            ++dest_data;
+    qt_imageConvertSegmented(qMax(src->nbytes, dest->nbytes), src->height, [=](int yStart, int yEnd) {
+        const int src_pad = (src->bytes_per_line >> 2) - src->width;
+        const int dest_pad = (dest->bytes_per_line >> 2) - dest->width;
+        const QRgb *src_data = (QRgb *) (src->data + src->bytes_per_line * yStart);
+        QRgb *dest_data = (QRgb *) (dest->data + dest->bytes_per_line * yStart);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgb *end = src_data + src->width;
+            while (src_data < end) {
+                *dest_data = qPremultiply(*src_data);
+                ++src_data;
+                ++dest_data;
+            }
+            src_data += src_pad;
+            dest_data += dest_pad;
         }
-        src_data += src_pad;
-        dest_data += dest_pad;
-    }
+    });
 }
 
 Q_GUI_EXPORT void QT_FASTCALL qt_convert_rgb888_to_rgb32(quint32 *dest_data, const uchar *src_data, int len)
@@ -419,16 +543,18 @@ static void convert_RGB888_to_RGB(QImageData *dest, const QImageData *src, Qt::I
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const uchar *src_data = (uchar *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
     Rgb888ToRgbConverter line_converter= rgbx ? qt_convert_rgb888_to_rgbx8888 : qt_convert_rgb888_to_rgb32;
 
-    for (int i = 0; i < src->height; ++i) {
-        line_converter(dest_data, src_data, src->width);
-        src_data += src->bytes_per_line;
-        dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
-    }
+    qt_imageConvertSegmented(dest->nbytes, src->height, [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + src->bytes_per_line * yStart;
+        quint32 *dest_data = (quint32 *) (dest->data + dest->bytes_per_line * yStart);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            line_converter(dest_data, src_data, src->width);
+            src_data += src->bytes_per_line;
+            dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
+        }
+    });
 }
 
 #ifdef __SSE2__
@@ -438,17 +564,19 @@ static bool convert_ARGB_to_ARGB_PM_inplace(QImageData *data,Qt::ImageConversion
 {
     Q_ASSERT(data->format == QImage::Format_ARGB32 || data->format == QImage::Format_RGBA8888);
 
-    const int pad = (data->bytes_per_line >> 2) - data->width;
-    QRgb *rgb_data = (QRgb *) data->data;
+    qt_imageConvertSegmented(data->nbytes, data->height, [=](int yStart, int yEnd) {
+        const int pad = (data->bytes_per_line >> 2) - data->width;
+        QRgb *rgb_data = (QRgb *) (data->data + data->bytes_per_line * yStart);
 
-    for (int i = 0; i < data->height; ++i) {
-        const QRgb *end = rgb_data + data->width;
-        while (rgb_data < end) {
-            *rgb_data = qPremultiply(*rgb_data);
-            ++rgb_data;
+        for (int i = yStart; i < yEnd; ++i) {
+            const QRgb *end = rgb_data + data->width;
+            while (rgb_data < end) {
+                *rgb_data = qPremultiply(*rgb_data);
+                ++rgb_data;
+            }
+            rgb_data += pad;
         }
-        rgb_data += pad;
-    }
+    });
 
     if (data->format == QImage::Format_ARGB32)
         data->format = QImage::Format_ARGB32_Premultiplied;
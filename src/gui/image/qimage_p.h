@@ -115,6 +115,31 @@ extern InPlace_Image_Converter qimage_inplace_converter_map[QImage::NImageFormat
 void convert_generic(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
 bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::ImageConversionFlags);
 
+// Processes the rows [yStart, yEnd) of an image, possibly on several threads at once
+typedef void (*QImageSegmentFunction)(void *closure, int yStart, int yEnd);
+void qt_imageRunSegments(int segments, int height, QImageSegmentFunction function, void *closure);
+int qt_imageConversionSegments(qsizetype bytes, int height);
+
+// Runs functor(yStart, yEnd) over the given number of bands on the global thread pool
+template <typename Functor>
+inline void qt_imageRunSegments(int segments, int height, Functor functor)
+{
+    struct Thunk {
+        static void run(void *closure, int yStart, int yEnd)
+        {
+            (*static_cast<Functor *>(closure))(yStart, yEnd);
+        }
+    };
+    qt_imageRunSegments(segments, height, &Thunk::run, &functor);
+}
+
+// Runs functor(yStart, yEnd) over bands of a large image on the global thread pool
+template <typename Functor>
+inline void qt_imageConvertSegmented(qsizetype bytes, int height, Functor functor)
+{
+    qt_imageRunSegments(qt_imageConversionSegments(bytes, height), height, functor);
+}
+
 void dither_to_Mono(QImageData *dst, const QImageData *src, Qt::ImageConversionFlags flags, bool fromalpha);
 
 const uchar *qt_get_bitflip_array();
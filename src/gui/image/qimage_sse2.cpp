@@ -51,67 +51,68 @@ bool convert_ARGB_to_ARGB_PM_inplace_sse2(QImageData *data, Qt::ImageConversionF
 {
     Q_ASSERT(data->format == QImage::Format_ARGB32 || data->format == QImage::Format_RGBA8888);
 
-    const int width = data->width;
-    const int height = data->height;
-    const int bpl = data->bytes_per_line;
+    qt_imageConvertSegmented(data->nbytes, data->height, [=](int yStart, int yEnd) {
+        const int width = data->width;
+        const int bpl = data->bytes_per_line;
 
-    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
-    const __m128i nullVector = _mm_setzero_si128();
-    const __m128i half = _mm_set1_epi16(0x80);
-    const __m128i colorMask = _mm_set1_epi32(0x00ff00ff);
+        const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+        const __m128i nullVector = _mm_setzero_si128();
+        const __m128i half = _mm_set1_epi16(0x80);
+        const __m128i colorMask = _mm_set1_epi32(0x00ff00ff);
 
-    uchar *d = data->data;
-    for (int y = 0; y < height; ++y) {
-        int i = 0;
-        quint32 *d32 = reinterpret_cast<quint32 *>(d);
-        ALIGNMENT_PROLOGUE_16BYTES(d, i, width) {
-            const quint32 p = d32[i];
-            if (p <= 0x00ffffff)
-                d32[i] = 0;
-            else if (p < 0xff000000)
-                d32[i] = qPremultiply(p);
-        }
-        __m128i *d128 = reinterpret_cast<__m128i *>(d32 + i);
-        for (; i < (width - 3); i += 4) {
-            const __m128i srcVector = _mm_load_si128(d128);
+        uchar *d = data->data + qsizetype(bpl) * yStart;
+        for (int y = yStart; y < yEnd; ++y) {
+            int i = 0;
+            quint32 *d32 = reinterpret_cast<quint32 *>(d);
+            ALIGNMENT_PROLOGUE_16BYTES(d, i, width) {
+                const quint32 p = d32[i];
+                if (p <= 0x00ffffff)
+                    d32[i] = 0;
+                else if (p < 0xff000000)
+                    d32[i] = qPremultiply(p);
+            }
+            __m128i *d128 = reinterpret_cast<__m128i *>(d32 + i);
+            for (; i < (width - 3); i += 4) {
+                const __m128i srcVector = _mm_load_si128(d128);
 #ifdef __SSE4_1__
-            if (_mm_testc_si128(srcVector, alphaMask)) {
-                // opaque, data is unchanged
-            } else if (_mm_testz_si128(srcVector, alphaMask)) {
-                // fully transparent
-                _mm_store_si128(d128, nullVector);
-            } else {
-                const __m128i srcVectorAlpha = _mm_and_si128(srcVector, alphaMask);
+                if (_mm_testc_si128(srcVector, alphaMask)) {
+                    // opaque, data is unchanged
+                } else if (_mm_testz_si128(srcVector, alphaMask)) {
+                    // fully transparent
+                    _mm_store_si128(d128, nullVector);
+                } else {
+                    const __m128i srcVectorAlpha = _mm_and_si128(srcVector, alphaMask);
 #else
-            const __m128i srcVectorAlpha = _mm_and_si128(srcVector, alphaMask);
-            if (_mm_movemask_epi8(_mm_cmpeq_epi32(srcVectorAlpha, alphaMask)) == 0xffff) {
-                // opaque, data is unchanged
-            } else if (_mm_movemask_epi8(_mm_cmpeq_epi32(srcVectorAlpha, nullVector)) == 0xffff) {
-                // fully transparent
-                _mm_store_si128(d128, nullVector);
-            } else {
+                const __m128i srcVectorAlpha = _mm_and_si128(srcVector, alphaMask);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(srcVectorAlpha, alphaMask)) == 0xffff) {
+                    // opaque, data is unchanged
+                } else if (_mm_movemask_epi8(_mm_cmpeq_epi32(srcVectorAlpha, nullVector)) == 0xffff) {
+                    // fully transparent
+                    _mm_store_si128(d128, nullVector);
+                } else {
 #endif
-                __m128i alphaChannel = _mm_srli_epi32(srcVector, 24);
-                alphaChannel = _mm_or_si128(alphaChannel, _mm_slli_epi32(alphaChannel, 16));
+                    __m128i alphaChannel = _mm_srli_epi32(srcVector, 24);
+                    alphaChannel = _mm_or_si128(alphaChannel, _mm_slli_epi32(alphaChannel, 16));
 
-                __m128i result;
-                BYTE_MUL_SSE2(result, srcVector, alphaChannel, colorMask, half);
-                result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), srcVectorAlpha);
-                _mm_store_si128(d128, result);
+                    __m128i result;
+                    BYTE_MUL_SSE2(result, srcVector, alphaChannel, colorMask, half);
+                    result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), srcVectorAlpha);
+                    _mm_store_si128(d128, result);
+                }
+                d128++;
             }
-            d128++;
-        }
 
-        SIMD_EPILOGUE(i, width, 3) {
-            const quint32 p = d32[i];
-            if (p <= 0x00ffffff)
-                d32[i] = 0;
-            else if (p < 0xff000000)
-                d32[i] = qPremultiply(p);
-        }
+            SIMD_EPILOGUE(i, width, 3) {
+                const quint32 p = d32[i];
+                if (p <= 0x00ffffff)
+                    d32[i] = 0;
+                else if (p < 0xff000000)
+                    d32[i] = qPremultiply(p);
+            }
 
-        d += bpl;
-    }
+            d += bpl;
+        }
+    });
 
     if (data->format == QImage::Format_ARGB32)
         data->format = QImage::Format_ARGB32_Premultiplied;
@@ -126,14 +126,16 @@ void convert_RGB888_to_RGB32_ssse3(QImageData *dest, const QImageData *src, Qt::
     Q_ASSERT(src->width == dest->width);
     Q_ASSERT(src->height == dest->height);
 
-    const uchar *src_data = (uchar *) src->data;
-    quint32 *dest_data = (quint32 *) dest->data;
-
-    for (int i = 0; i < src->height; ++i) {
-        qt_convert_rgb888_to_rgb32_ssse3(dest_data, src_data, src->width);
-        src_data += src->bytes_per_line;
-        dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
-    }
+    qt_imageConvertSegmented(dest->nbytes, src->height, [=](int yStart, int yEnd) {
+        const uchar *src_data = src->data + src->bytes_per_line * yStart;
+        quint32 *dest_data = (quint32 *) (dest->data + dest->bytes_per_line * yStart);
+
+        for (int i = yStart; i < yEnd; ++i) {
+            qt_convert_rgb888_to_rgb32_ssse3(dest_data, src_data, src->width);
+            src_data += src->bytes_per_line;
+            dest_data = (quint32 *)((uchar*)dest_data + dest->bytes_per_line);
+        }
+    });
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,395 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qimagecache.h"
+
+#include <qatomic.h>
+#include <qhash.h>
+#include <qmap.h>
+#include <qmutex.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QImageCache
+    \inmodule QtGui
+    \since 5.11
+    \threadsafe
+
+    \brief The QImageCache class provides a cache for images that can be
+    shared between threads.
+
+    QPixmapCache can only be used from the GUI thread, since QPixmap
+    cannot be created in other threads. QImageCache stores QImage objects
+    instead, and all of its functions can be called from any thread. For
+    example, worker threads that decode thumbnails can insert them, and
+    the GUI thread can find them later without decoding them again.
+
+    Like QPixmapCache, the cache is limited by the memory its images use,
+    which is given in kilobytes by cacheLimit(). When an insertion takes
+    it over the limit, the least recently used images are removed until
+    it fits again. Images are found and inserted by a QString key.
+
+    The entries are spread over several shards according to the hash of
+    their key, and each shard has a lock of its own, so threads that work
+    on different keys rarely wait for each other.
+
+    hitCount() and missCount() tell how many calls to find() succeeded and
+    how many failed, which helps with choosing the cache limit.
+
+    globalInstance() returns a cache shared by the whole application.
+
+    \sa QPixmapCache, QCache
+*/
+
+namespace {
+struct CacheEntry
+{
+    QImage image;
+    qint64 cost;
+    quint64 tick;
+};
+
+struct CacheShard
+{
+    CacheShard() : hits(0), misses(0) {}
+
+    QMutex mutex;
+    QHash<QString, CacheEntry> entries;
+    QMap<quint64, QString> lru;         // tick of last use -> key, oldest first
+    qint64 hits;
+    qint64 misses;
+};
+} // unnamed namespace
+
+class QImageCachePrivate
+{
+public:
+    enum { ShardCount = 16 };
+
+    explicit QImageCachePrivate(int limit) : limit(limit) {}
+
+    CacheShard &shardFor(const QString &key) { return shards[qHash(key) % ShardCount]; }
+    void touch(CacheShard &shard, CacheEntry &entry, const QString &key);
+    void removeEntry(CacheShard &shard, QHash<QString, CacheEntry>::iterator it);
+    void trim();
+
+    CacheShard shards[ShardCount];
+    QAtomicInteger<qint64> totalCost;
+    QAtomicInteger<quint64> clock;
+    QAtomicInt limit;                   // in kilobytes
+};
+
+static inline qint64 imageCost(const QImage &image)
+{
+    return qMax<qint64>(1, image.sizeInBytes());
+}
+
+// Requires the shard's mutex to be held.
+void QImageCachePrivate::touch(CacheShard &shard, CacheEntry &entry, const QString &key)
+{
+    shard.lru.remove(entry.tick);
+    entry.tick = clock.fetchAndAddRelaxed(1);
+    shard.lru.insert(entry.tick, key);
+}
+
+// Requires the shard's mutex to be held.
+void QImageCachePrivate::removeEntry(CacheShard &shard, QHash<QString, CacheEntry>::iterator it)
+{
+    shard.lru.remove(it->tick);
+    totalCost.fetchAndSubRelaxed(it->cost);
+    shard.entries.erase(it);
+}
+
+// Removes the least recently used entries of all shards until the total
+// cost is within the limit. Only one shard is locked at a time.
+void QImageCachePrivate::trim()
+{
+    while (totalCost.load() > qint64(limit.load()) * 1024) {
+        int oldestShard = -1;
+        quint64 oldestTick = 0;
+        for (int i = 0; i < ShardCount; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            if (!shards[i].lru.isEmpty() && (oldestShard < 0 || shards[i].lru.firstKey() < oldestTick)) {
+                oldestShard = i;
+                oldestTick = shards[i].lru.firstKey();
+            }
+        }
+        if (oldestShard < 0)
+            return;
+
+        // Another thread may have used or removed the entry since, in
+        // which case the shard's least recently used entry goes instead.
+        CacheShard &shard = shards[oldestShard];
+        QMutexLocker locker(&shard.mutex);
+        if (!shard.lru.isEmpty())
+            removeEntry(shard, shard.entries.find(shard.lru.first()));
+    }
+}
+
+Q_GLOBAL_STATIC(QImageCache, globalImageCache)
+
+/*!
+    Constructs a cache that holds images up to a total of \a cacheLimit
+    kilobytes.
+*/
+QImageCache::QImageCache(int cacheLimit)
+    : d(new QImageCachePrivate(cacheLimit))
+{
+}
+
+/*!
+    Destroys the cache and the images in it.
+*/
+QImageCache::~QImageCache()
+{
+    delete d;
+}
+
+/*!
+    Returns the application-wide image cache, which has the default limit
+    of 10240 KB.
+*/
+QImageCache *QImageCache::globalInstance()
+{
+    return globalImageCache();
+}
+
+/*!
+    Returns the cache limit in kilobytes.
+
+    \sa setCacheLimit()
+*/
+int QImageCache::cacheLimit() const
+{
+    return d->limit.load();
+}
+
+/*!
+    Sets the cache limit to \a n kilobytes, removing the least recently
+    used images if the cache is bigger than that.
+
+    \sa cacheLimit()
+*/
+void QImageCache::setCacheLimit(int n)
+{
+    d->limit.store(n);
+    d->trim();
+}
+
+/*!
+    Inserts the \a image into the cache under \a key, replacing any image
+    that was there before. Returns \c true if the image was inserted, or
+    \c false if it is null or bigger than the cache limit.
+
+    The cost of an image is the number of bytes of its data, as returned
+    by QImage::sizeInBytes(). Since images are implicitly shared, an image
+    that is still used elsewhere does not take more memory when inserted.
+*/
+bool QImageCache::insert(const QString &key, const QImage &image)
+{
+    const qint64 cost = imageCost(image);
+    if (image.isNull() || cost > qint64(d->limit.load()) * 1024)
+        return false;
+
+    CacheShard &shard = d->shardFor(key);
+    {
+        QMutexLocker locker(&shard.mutex);
+        QHash<QString, CacheEntry>::iterator it = shard.entries.find(key);
+        if (it != shard.entries.end())
+            d->removeEntry(shard, it);
+        CacheEntry entry = { image, cost, d->clock.fetchAndAddRelaxed(1) };
+        shard.entries.insert(key, entry);
+        shard.lru.insert(entry.tick, key);
+        d->totalCost.fetchAndAddRelaxed(cost);
+    }
+    d->trim();
+    return true;
+}
+
+/*!
+    Looks for an image stored under \a key. If there is one, it is
+    assigned to \a image and this function returns \c true; otherwise
+    it returns \c false and leaves \a image alone.
+
+    A successful lookup makes the image the most recently used one.
+
+    \sa hitCount(), missCount()
+*/
+bool QImageCache::find(const QString &key, QImage *image)
+{
+    CacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    QHash<QString, CacheEntry>::iterator it = shard.entries.find(key);
+    if (it == shard.entries.end()) {
+        ++shard.misses;
+        return false;
+    }
+    ++shard.hits;
+    d->touch(shard, *it, key);
+    if (image)
+        *image = it->image;
+    return true;
+}
+
+/*!
+    \overload
+
+    Returns the image stored under \a key, or a null image if there is
+    none.
+*/
+QImage QImageCache::find(const QString &key)
+{
+    QImage image;
+    find(key, &image);
+    return image;
+}
+
+/*!
+    Returns \c true if an image is stored under \a key. Unlike find(),
+    this function does not change the order in which images are removed
+    and is not counted in the statistics.
+*/
+bool QImageCache::contains(const QString &key) const
+{
+    CacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    return shard.entries.contains(key);
+}
+
+/*!
+    Removes the image stored under \a key. Returns \c true if there was
+    one.
+*/
+bool QImageCache::remove(const QString &key)
+{
+    CacheShard &shard = d->shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    QHash<QString, CacheEntry>::iterator it = shard.entries.find(key);
+    if (it == shard.entries.end())
+        return false;
+    d->removeEntry(shard, it);
+    return true;
+}
+
+/*!
+    Removes all images from the cache. The statistics are kept.
+
+    \sa resetStatistics()
+*/
+void QImageCache::clear()
+{
+    for (CacheShard &shard : d->shards) {
+        QMutexLocker locker(&shard.mutex);
+        for (const CacheEntry &entry : qAsConst(shard.entries))
+            d->totalCost.fetchAndSubRelaxed(entry.cost);
+        shard.entries.clear();
+        shard.lru.clear();
+    }
+}
+
+/*!
+    Returns the number of images in the cache.
+*/
+int QImageCache::count() const
+{
+    int n = 0;
+    for (CacheShard &shard : d->shards) {
+        QMutexLocker locker(&shard.mutex);
+        n += shard.entries.size();
+    }
+    return n;
+}
+
+/*!
+    Returns the number of bytes used by the images in the cache.
+
+    \sa cacheLimit()
+*/
+qint64 QImageCache::totalUsed() const
+{
+    return d->totalCost.load();
+}
+
+/*!
+    Returns how many calls to find() found an image since the cache was
+    created or resetStatistics() was called.
+
+    \sa missCount()
+*/
+qint64 QImageCache::hitCount() const
+{
+    qint64 n = 0;
+    for (CacheShard &shard : d->shards) {
+        QMutexLocker locker(&shard.mutex);
+        n += shard.hits;
+    }
+    return n;
+}
+
+/*!
+    Returns how many calls to find() did not find an image since the cache
+    was created or resetStatistics() was called.
+
+    \sa hitCount()
+*/
+qint64 QImageCache::missCount() const
+{
+    qint64 n = 0;
+    for (CacheShard &shard : d->shards) {
+        QMutexLocker locker(&shard.mutex);
+        n += shard.misses;
+    }
+    return n;
+}
+
+/*!
+    Sets hitCount() and missCount() back to zero.
+*/
+void QImageCache::resetStatistics()
+{
+    for (CacheShard &shard : d->shards) {
+        QMutexLocker locker(&shard.mutex);
+        shard.hits = 0;
+        shard.misses = 0;
+    }
+}
+
+QT_END_NAMESPACE
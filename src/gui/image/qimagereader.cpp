@@ -151,9 +151,15 @@
 #include <qcoreapplication.h>
 #include <private/qfactoryloader_p.h>
 #include <QMutexLocker>
+#ifndef QT_NO_QFUTURE
+#include <qfuture.h>
+#include <qrunnable.h>
+#include <qthreadpool.h>
+#endif
 
 // for qt_getImageText
 #include <private/qimage_p.h>
+#include <private/qtgui_tracepoints_p.h>
 
 // image handlers
 #include <private/qbmphandler_p.h>
@@ -527,6 +533,10 @@ public:
     QImageReader::ImageReaderError imageReaderError;
     QString errorString;
 
+#ifndef QT_NO_QFUTURE
+    QFuture<QImage> asyncRead;
+#endif
+
     QImageReader *q;
 };
 
@@ -661,6 +671,10 @@ QImageReader::QImageReader(const QString &fileName, const QByteArray &format)
 */
 QImageReader::~QImageReader()
 {
+#ifndef QT_NO_QFUTURE
+    d->asyncRead.cancel();
+    d->asyncRead.waitForFinished();
+#endif
     delete d;
 }
 
@@ -1310,7 +1324,11 @@ bool QImageReader::read(QImage *image)
         d->handler->setOption(QImageIOHandler::Quality, d->quality);
 
     // read the image
-    if (!d->handler->read(image)) {
+    if (Q_TRACE_ENABLED(QImageReader_read_before_reading))
+        Q_TRACE(QImageReader_read_before_reading, this, d->handler->format().constData());
+    const bool result = d->handler->read(image);
+    Q_TRACE(QImageReader_read_after_reading, this, result);
+    if (!result) {
         d->imageReaderError = InvalidDataError;
         d->errorString = QImageReader::tr("Unable to read image data");
         return false;
@@ -1378,6 +1396,79 @@ bool QImageReader::read(QImage *image)
     return true;
 }
 
+#ifndef QT_NO_QFUTURE
+namespace {
+class ImageReadTask : public QFutureInterface<QImage>, public QRunnable
+{
+public:
+    explicit ImageReadTask(QImageReader *reader) : reader(reader) {}
+
+    QFuture<QImage> start(QThreadPool *pool)
+    {
+        setThreadPool(pool);
+        setRunnable(this);
+        reportStarted();
+        QFuture<QImage> theFuture = future();
+        pool->start(this);
+        return theFuture;
+    }
+
+    void run() override
+    {
+        int index = 0;
+        while (!isCanceled()) {
+            if (index > 0 && !(reader->supportsAnimation() && reader->canRead()))
+                break;
+            QImage image;
+            const bool ok = reader->read(&image);
+            // The first result is always reported, so that result() does
+            // not wait for one that never comes.
+            if (ok || index == 0)
+                reportResult(image, index++);
+            if (!ok)
+                break;
+        }
+        reportFinished();
+    }
+
+private:
+    QImageReader *reader;
+};
+} // unnamed namespace
+
+/*!
+    \since 5.11
+
+    Starts reading the image in  pool, or in the global thread pool if
+     pool is null, and returns a future for it. The calling thread does
+    not wait for the image to be decoded.
+
+    For image formats that support animation, every frame that has not been
+    read yet becomes a result of the future as soon as it is decoded.
+    Cancel the future to stop after the frame that is being decoded.
+    Otherwise the future has one result, which is a null image if reading
+    failed; error() and errorString() then describe the failure.
+
+    \snippet code/src_gui_image_qimagereader.cpp 4
+
+    The QImageReader must not be used until the future has finished.
+    Destroying it cancels the read and waits for the running frame.
+    If a QIODevice was set, it is read from a thread of the pool, so
+    it must not be used by any other thread meanwhile.
+
+    \sa read(), QFutureWatcher
+*/
+QFuture<QImage> QImageReader::readAsync(QThreadPool *pool)
+{
+    if (!d->asyncRead.isFinished()) {
+        qWarning("QImageReader::readAsync: An asynchronous read is already in progress");
+        return QFuture<QImage>();
+    }
+    d->asyncRead = (new ImageReadTask(this))->start(pool ? pool : QThreadPool::globalInstance());
+    return d->asyncRead;
+}
+#endif // QT_NO_QFUTURE
+
 /*!
    For image formats that support animation, this function steps over the
    current image, returning true if successful or false if there is no
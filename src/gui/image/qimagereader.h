@@ -54,6 +54,10 @@ class QIODevice;
 class QRect;
 class QSize;
 class QStringList;
+class QThreadPool;
+#ifndef QT_NO_QFUTURE
+template <typename T> class QFuture;
+#endif
 
 class QImageReaderPrivate;
 class Q_GUI_EXPORT QImageReader
@@ -126,6 +130,9 @@ public:
     bool canRead() const;
     QImage read();
     bool read(QImage *image);
+#ifndef QT_NO_QFUTURE
+    QFuture<QImage> readAsync(QThreadPool *pool = nullptr);
+#endif
 
     bool jumpToNextImage();
     bool jumpToImage(int imageNumber);
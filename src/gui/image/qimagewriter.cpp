@@ -528,6 +528,11 @@ float QImageWriter::gamma() const
     For example, saving an image in DDS format with A8R8G8R8 subtype:
 
     \snippet code/src_gui_image_qimagewriter.cpp 3
+
+    The PNG handler uses the subtype to select the row filter: one of
+    \c none, \c sub, \c up, \c average, \c paeth or \c adaptive.
+    By default libpng chooses adaptively, and rows are left unfiltered
+    when the image is saved without compression.
 */
 void QImageWriter::setSubType(const QByteArray &type)
 {
@@ -114,7 +114,10 @@
 
     This enum describes the different cache modes of QMovie.
 
-    \value CacheNone No frames are cached (the default).
+    \value CacheNone No frames are cached (the default). As an exception,
+    an animation whose frames take up less than a few megabytes is kept in
+    memory once it has been played through, so that looping it does not
+    decode it again.
 
     \value CacheAll All frames are cached.
 */
@@ -180,6 +183,7 @@
 #include "qpixmap.h"
 #include "qrect.h"
 #include "qdatetime.h"
+#include "qelapsedtimer.h"
 #include "qtimer.h"
 #include "qpair.h"
 #include "qmap.h"
@@ -189,6 +193,10 @@
 #include "private/qobject_p.h"
 
 #define QMOVIE_INVALID_DELAY -1
+// bytes of frames that are kept when no caching was asked for
+#define QMOVIE_SMALL_MOVIE_CACHE_LIMIT (4 * 1024 * 1024)
+// frames that may be dropped at once when playback falls behind
+#define QMOVIE_MAX_DROPPED_FRAMES 10
 
 QT_BEGIN_NAMESPACE
 
@@ -236,6 +244,8 @@ public:
     int frameCount() const;
     bool jumpToNextFrame();
     QFrameInfo infoForFrame(int frameNumber);
+    void cacheSmallMovieFrame(int frameNumber, const QFrameInfo &info);
+    bool isSmallMovieCached() const;
     void reset();
 
     inline void enterState(QMovie::MovieState newState) {
@@ -262,9 +272,14 @@ public:
     bool haveReadAll;
     bool isFirstIteration;
     QMap<int, QFrameInfo> frameMap;
+    // bytes taken by the frames in frameMap in CacheNone mode, or -1
+    // once the movie turned out to be too large to be kept
+    qint64 smallMovieCacheSize;
     QString absoluteFilePath;
 
     QTimer nextImageTimer;
+    QElapsedTimer playbackClock;
+    qint64 nextFrameDue; // on playbackClock, or -1
 };
 
 /*! \internal
@@ -273,10 +288,12 @@ QMoviePrivate::QMoviePrivate(QMovie *qq)
     : reader(0), speed(100), movieState(QMovie::NotRunning),
       currentFrameNumber(-1), nextFrameNumber(0), greatestFrameNumber(-1),
       nextDelay(0), playCounter(-1),
-      cacheMode(QMovie::CacheNone), haveReadAll(false), isFirstIteration(true)
+      cacheMode(QMovie::CacheNone), haveReadAll(false), isFirstIteration(true),
+      smallMovieCacheSize(0), nextFrameDue(-1)
 {
     q_ptr = qq;
     nextImageTimer.setSingleShot(true);
+    playbackClock.start();
 }
 
 /*! \internal
@@ -294,6 +311,38 @@ void QMoviePrivate::reset()
     haveReadAll = false;
     isFirstIteration = true;
     frameMap.clear();
+    smallMovieCacheSize = 0;
+    nextFrameDue = -1;
+}
+
+/*!
+    \internal
+
+    Keeps the frames read in CacheNone mode as long as they are read in
+    sequence from the first one and do not exceed a small memory budget.
+    If the whole movie fits, isSmallMovieCached() becomes true once it has
+    been read, and later loops are played from memory.
+*/
+void QMoviePrivate::cacheSmallMovieFrame(int frameNumber, const QFrameInfo &info)
+{
+    if (smallMovieCacheSize < 0 || frameNumber != frameMap.size())
+        return;
+    const QPixmap &pixmap = info.pixmap;
+    smallMovieCacheSize += qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    if (smallMovieCacheSize > QMOVIE_SMALL_MOVIE_CACHE_LIMIT) {
+        frameMap.clear();
+        smallMovieCacheSize = -1;
+        return;
+    }
+    frameMap.insert(frameNumber, info);
+}
+
+/*!
+    \internal
+*/
+bool QMoviePrivate::isSmallMovieCached() const
+{
+    return haveReadAll && smallMovieCacheSize >= 0 && frameMap.size() == greatestFrameNumber + 1;
 }
 
 /*! \internal
@@ -342,6 +391,8 @@ QFrameInfo QMoviePrivate::infoForFrame(int frameNumber)
     }
 
     if (cacheMode == QMovie::CacheNone) {
+        if (isSmallMovieCached())
+            return frameMap.value(frameNumber);
         if (frameNumber != currentFrameNumber+1) {
             // Non-sequential frame access
             if (!reader->jumpToImage(frameNumber)) {
@@ -381,7 +432,9 @@ QFrameInfo QMoviePrivate::infoForFrame(int frameNumber)
                 greatestFrameNumber = frameNumber;
             QPixmap aPixmap = QPixmap::fromImage(anImage);
             int aDelay = reader->nextImageDelay();
-            return QFrameInfo(aPixmap, aDelay);
+            QFrameInfo info(aPixmap, aDelay);
+            cacheSmallMovieFrame(frameNumber, info);
+            return info;
         } else if (frameNumber != 0) {
             // We've read all frames now. Return an end marker
             haveReadAll = true;
@@ -494,7 +547,23 @@ void QMoviePrivate::_q_loadNextFrame()
 void QMoviePrivate::_q_loadNextFrame(bool starting)
 {
     Q_Q(QMovie);
-    if (next()) {
+    int lateness = 0;
+    if (nextFrameDue >= 0 && movieState == QMovie::Running)
+        lateness = int(qMin<qint64>(playbackClock.elapsed() - nextFrameDue, INT_MAX));
+    nextFrameDue = -1;
+
+    bool ok = next();
+
+    // If the timer fired so late that the frame should already have been
+    // replaced, drop it and the following ones until playback catches up,
+    // instead of painting each of them
+    for (int dropped = 0; ok && speed && nextDelay > 0 && lateness >= nextDelay
+                          && dropped < QMOVIE_MAX_DROPPED_FRAMES; ++dropped) {
+        lateness -= nextDelay;
+        ok = next();
+    }
+
+    if (ok) {
         if (starting && movieState == QMovie::NotRunning) {
             enterState(QMovie::Running);
             emit q->started();
@@ -508,8 +577,11 @@ void QMoviePrivate::_q_loadNextFrame(bool starting)
         emit q->updated(frameRect);
         emit q->frameChanged(currentFrameNumber);
 
-        if (speed && movieState == QMovie::Running)
-            nextImageTimer.start(nextDelay);
+        if (speed && movieState == QMovie::Running) {
+            const int delay = qMax(0, nextDelay - qMax(0, lateness));
+            nextImageTimer.start(delay);
+            nextFrameDue = playbackClock.elapsed() + delay;
+        }
     } else {
         // Could not read another frame
         if (!isDone()) {
@@ -560,6 +632,7 @@ bool QMoviePrivate::jumpToFrame(int frameNumber)
     nextFrameNumber = frameNumber;
     if (movieState == QMovie::Running)
         nextImageTimer.stop();
+    nextFrameDue = -1;
     _q_loadNextFrame();
     return (nextFrameNumber == currentFrameNumber+1);
 }
@@ -909,6 +982,7 @@ void QMovie::setPaused(bool paused)
             return;
         d->enterState(Paused);
         d->nextImageTimer.stop();
+        d->nextFrameDue = -1;
     } else {
         if (d->movieState == Running)
             return;
@@ -978,6 +1052,7 @@ void QMovie::stop()
         return;
     d->enterState(NotRunning);
     d->nextImageTimer.stop();
+    d->nextFrameDue = -1;
     d->nextFrameNumber = 0;
 }
 
@@ -106,6 +106,7 @@ public:
     float fileGamma;
     int quality;
     QString description;
+    QByteArray subType;
     QSize scaledSize;
     QStringList readTexts;
 
@@ -159,6 +160,7 @@ public:
     void setLooping(int loops=0); // 0 == infinity
     void setFrameDelay(int msecs);
     void setGamma(float);
+    void setFilters(int);
 
     bool writeImage(const QImage& img, int x, int y);
     bool writeImage(const QImage& img, volatile int quality, const QString &description, int x, int y);
@@ -176,6 +178,7 @@ private:
     int looping;
     int ms_delay;
     float gamma;
+    int filters;
 };
 
 extern "C" {
@@ -698,7 +701,8 @@ QPNGImageWriter::QPNGImageWriter(QIODevice* iod) :
     disposal(Unspecified),
     looping(-1),
     ms_delay(-1),
-    gamma(0.0)
+    gamma(0.0),
+    filters(-1)
 {
 }
 
@@ -726,6 +730,12 @@ void QPNGImageWriter::setGamma(float g)
     gamma = g;
 }
 
+// A combination of PNG_FILTER_* flags, or -1 to let libpng choose.
+void QPNGImageWriter::setFilters(int f)
+{
+    filters = f;
+}
+
 static void set_text(const QImage &image, png_structp png_ptr, png_infop info_ptr,
                      const QString &description)
 {
@@ -826,6 +836,13 @@ bool QPNGImageWriter::writeImage(const QImage& image, volatile int quality_in, c
         png_set_compression_level(png_ptr, quality);
     }
 
+    // Filtering only pays off when the rows are compressed afterwards
+    int filter_flags = filters;
+    if (filter_flags < 0 && quality == 0)
+        filter_flags = PNG_FILTER_NONE;
+    if (filter_flags >= 0)
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filter_flags);
+
     png_set_write_fn(png_ptr, (void*)this, qpiw_write_fn, qpiw_flush_fn);
 
 
@@ -877,15 +894,20 @@ bool QPNGImageWriter::writeImage(const QImage& image, volatile int quality_in, c
         }
     }
 
+    // RGB888 and the RGBA8888 formats are stored in PNG byte order
+    // regardless of endianness, and are written without conversion
+    const bool byteOrdered = image.format() == QImage::Format_RGB888
+                          || image.format() == QImage::Format_RGBA8888
+                          || image.format() == QImage::Format_RGBX8888;
+
     // Swap ARGB to RGBA (normal PNG format) before saving on
     // BigEndian machines
-    if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
+    if (QSysInfo::ByteOrder == QSysInfo::BigEndian && !byteOrdered) {
         png_set_swap_alpha(png_ptr);
     }
 
-    // Qt==ARGB==Big(ARGB)==Little(BGRA). But RGB888 is RGB regardless
-    if (QSysInfo::ByteOrder == QSysInfo::LittleEndian
-        && image.format() != QImage::Format_RGB888) {
+    // Qt==ARGB==Big(ARGB)==Little(BGRA)
+    if (QSysInfo::ByteOrder == QSysInfo::LittleEndian && !byteOrdered) {
         png_set_bgr(png_ptr);
     }
 
@@ -911,7 +933,7 @@ bool QPNGImageWriter::writeImage(const QImage& image, volatile int quality_in, c
 
     if (color_type == PNG_COLOR_TYPE_RGB && image.format() != QImage::Format_RGB888)
         png_set_filler(png_ptr, 0,
-            QSysInfo::ByteOrder == QSysInfo::BigEndian ?
+            QSysInfo::ByteOrder == QSysInfo::BigEndian && !byteOrdered ?
                 PNG_FILLER_BEFORE : PNG_FILLER_AFTER);
 
     if (looping >= 0 && frames_written == 0) {
@@ -940,6 +962,8 @@ bool QPNGImageWriter::writeImage(const QImage& image, volatile int quality_in, c
     case QImage::Format_RGB32:
     case QImage::Format_ARGB32:
     case QImage::Format_RGB888:
+    case QImage::Format_RGBX8888:
+    case QImage::Format_RGBA8888:
         {
             png_bytep* row_pointers = new png_bytep[height];
             for (int y=0; y<height; y++)
@@ -948,6 +972,20 @@ bool QPNGImageWriter::writeImage(const QImage& image, volatile int quality_in, c
             delete [] row_pointers;
         }
         break;
+    case QImage::Format_ARGB32_Premultiplied:
+        {
+            // Unpremultiply one row at a time into a reused buffer
+            QRgb *row = new QRgb[width];
+            png_bytep row_pointers[1] = { reinterpret_cast<png_bytep>(row) };
+            for (int y=0; y<height; y++) {
+                const QRgb *src = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+                for (int x=0; x<width; x++)
+                    row[x] = qUnpremultiply(src[x]);
+                png_write_rows(png_ptr, row_pointers, 1);
+            }
+            delete [] row;
+        }
+        break;
     default:
         {
             QImage::Format fmt = image.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32;
@@ -970,10 +1008,29 @@ bool QPNGImageWriter::writeImage(const QImage& image, volatile int quality_in, c
     return true;
 }
 
+static int png_filters_for_subtype(const QByteArray &subType)
+{
+    if (subType == "none")
+        return PNG_FILTER_NONE;
+    if (subType == "sub")
+        return PNG_FILTER_SUB;
+    if (subType == "up")
+        return PNG_FILTER_UP;
+    if (subType == "average")
+        return PNG_FILTER_AVG;
+    if (subType == "paeth")
+        return PNG_FILTER_PAETH;
+    if (subType == "adaptive")
+        return PNG_ALL_FILTERS;
+    return -1;
+}
+
 static bool write_png_image(const QImage &image, QIODevice *device,
-                            int quality, float gamma, const QString &description)
+                            int quality, float gamma, const QString &description,
+                            const QByteArray &subType)
 {
     QPNGImageWriter writer(device);
+    writer.setFilters(png_filters_for_subtype(subType));
     if (quality >= 0) {
         quality = qMin(quality, 100);
         quality = (100-quality) * 9 / 91; // map [0,100] -> [9,0]
@@ -1026,7 +1083,7 @@ bool QPngHandler::read(QImage *image)
 
 bool QPngHandler::write(const QImage &image)
 {
-    return write_png_image(image, device(), d->quality, d->gamma, d->description);
+    return write_png_image(image, device(), d->quality, d->gamma, d->description, d->subType);
 }
 
 bool QPngHandler::supportsOption(ImageOption option) const
@@ -1036,11 +1093,19 @@ bool QPngHandler::supportsOption(ImageOption option) const
         || option == ImageFormat
         || option == Quality
         || option == Size
-        || option == ScaledSize;
+        || option == ScaledSize
+        || option == SubType
+        || option == SupportedSubTypes;
 }
 
 QVariant QPngHandler::option(ImageOption option) const
 {
+    if (option == SubType)
+        return d->subType;
+    if (option == SupportedSubTypes)
+        return QVariant::fromValue(QList<QByteArray>() << "none" << "sub" << "up"
+                                                       << "average" << "paeth" << "adaptive");
+
     if (d->state == QPngHandlerPrivate::Error)
         return QVariant();
     if (d->state == QPngHandlerPrivate::Ready && !d->readPngHeader())
@@ -1072,6 +1137,8 @@ void QPngHandler::setOption(ImageOption option, const QVariant &value)
         d->description = value.toString();
     else if (option == ScaledSize)
         d->scaledSize = value.toSize();
+    else if (option == SubType)
+        d->subType = value.toByteArray().toLower();
 }
 
 QByteArray QPngHandler::name() const
@@ -0,0 +1,528 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsharedimagecache.h"
+
+#include <qatomic.h>
+#include <qcryptographichash.h>
+#include <qdir.h>
+#include <qmutex.h>
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+#include <qsharedmemory.h>
+#endif
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSharedImageCache
+    \inmodule QtGui
+    \since 5.11
+    \threadsafe
+
+    \brief The QSharedImageCache class provides a cache of decoded images
+    that is shared between processes.
+
+    Applications that run at the same time often decode the same icons,
+    thumbnails and theme images, and each keeps its own copy of the
+    pixels. QSharedImageCache stores decoded images in a shared memory
+    segment, which all processes that use the same key() attach to. An
+    image that one process inserted can be found by the others without
+    decoding it again, and the images returned by find() use the shared
+    memory directly instead of copying it. They are read-only: modifying
+    one detaches it into a private copy, like any other QImage.
+
+    Images are found and inserted by a QByteArray key that identifies
+    their content, typically the encoded image data they were decoded from.
+    The cache stores only a SHA-1 hash of the key, so long keys cost no
+    extra shared memory.
+
+    The segment has a fixed size(), given in kilobytes when constructing
+    the cache. Images are never removed, since other processes might still
+    use them, so once the segment is full, insert() fails and the
+    application should use its own copy of the image. The segment is
+    released when the last process that uses it detaches from it.
+
+    Insertions from different processes are serialized with the lock of
+    the shared memory segment, which is a system semaphore. Lookups do not
+    take the lock.
+
+    globalInstance() returns a cache shared by all Qt applications of the
+    user, if it was enabled with the \c QT_SHARED_IMAGE_CACHE environment
+    variable. The icon theme loader then uses it for the icon images it
+    loads from files.
+
+    \note Processes that use the same key can read and modify all images in
+    the segment, so the key should only be shared between applications that
+    trust each other.
+
+    \sa QImageCache, QSharedMemory
+*/
+
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+namespace {
+enum {
+    Magic = 0x43495351,         // "QSIC"
+    LayoutVersion = 1,
+    DigestSize = 20,            // SHA-1
+    DataAlignment = 64,
+    BytesPerEntry = 16 * 1024   // the table has one entry per this many bytes of the segment
+};
+
+struct SharedHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 qtVersion;
+    quint32 tableSize;          // number of entries, a power of two
+    quint32 dataBegin;          // offset of the image data after the table
+    quint32 dataEnd;            // end of the image data handed out so far
+    quint32 count;
+    quint32 reserved;
+};
+
+struct SharedEntry
+{
+    uchar digest[DigestSize];
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+    double devicePixelRatio;
+    // Offset of the image data, or 0 while the entry is unused. It is
+    // written last, so that whoever sees it also sees the other members.
+    QBasicAtomicInteger<quint32> offset;
+    quint32 reserved;
+};
+
+// The attached segment. It is referenced by the cache and by every image
+// handed out by find(), so that images stay valid after the cache is gone.
+struct SharedMapping
+{
+    SharedMapping() : ref(1) {}
+
+    QSharedMemory memory;
+    QAtomicInt ref;
+};
+} // unnamed namespace
+
+static inline quint32 tableSizeFor(quint32 capacity)
+{
+    quint32 n = 64;
+    while (quint64(n) * BytesPerEntry < capacity)
+        n *= 2;
+    return n;
+}
+
+static inline quint32 dataBeginFor(quint32 tableSize)
+{
+    const quint32 end = quint32(sizeof(SharedHeader) + tableSize * sizeof(SharedEntry));
+    return (end + DataAlignment - 1) & ~quint32(DataAlignment - 1);
+}
+
+static void releaseMapping(void *info)
+{
+    SharedMapping *mapping = static_cast<SharedMapping *>(info);
+    if (!mapping->ref.deref())
+        delete mapping;
+}
+#endif // QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+
+class QSharedImageCachePrivate
+{
+public:
+    QSharedImageCachePrivate() : capacity(0)
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+      , mapping(nullptr)
+#endif
+    {}
+
+    QString key;
+    quint32 capacity;
+
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    bool attach(int size);
+    void release();
+
+    uchar *base() const { return static_cast<uchar *>(mapping->memory.data()); }
+    SharedHeader *header() const { return reinterpret_cast<SharedHeader *>(base()); }
+    SharedEntry *findEntry(const QByteArray &digest) const;
+
+    SharedMapping *mapping;
+    // QSharedMemory::lock() only works across processes, not across the
+    // threads of one process
+    QMutex writeMutex;
+#endif
+};
+
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+bool QSharedImageCachePrivate::attach(int size)
+{
+    mapping = new SharedMapping;
+    QSharedMemory &memory = mapping->memory;
+    memory.setKey(key);
+
+    const int minimumSize = dataBeginFor(tableSizeFor(0)) + 64 * 1024;
+    const int bytes = int(qBound<qint64>(minimumSize, qint64(size) * 1024, INT_MAX / 2));
+    if (!memory.create(bytes)) {
+        // Another process created it first; its size wins.
+        if (memory.error() != QSharedMemory::AlreadyExists || !memory.attach()) {
+            release();
+            return false;
+        }
+    }
+    if (memory.size() < minimumSize || !memory.lock()) {
+        release();
+        return false;
+    }
+
+    // A new segment is zero-filled. Whoever locks it first lays it out.
+    capacity = quint32(memory.size());
+    const quint32 tableSize = tableSizeFor(capacity);
+    SharedHeader *h = header();
+    if (h->magic == 0) {
+        h->version = LayoutVersion;
+        h->qtVersion = QT_VERSION;
+        h->tableSize = tableSize;
+        h->dataBegin = dataBeginFor(tableSize);
+        h->dataEnd = h->dataBegin;
+        h->count = 0;
+        h->magic = Magic;
+    }
+    const bool valid = h->magic == Magic && h->version == LayoutVersion
+            && h->qtVersion == QT_VERSION && h->tableSize == tableSize
+            && h->dataBegin == dataBeginFor(tableSize) && h->dataEnd <= capacity;
+    memory.unlock();
+
+    if (!valid) {
+        release();
+        return false;
+    }
+    return true;
+}
+
+void QSharedImageCachePrivate::release()
+{
+    if (mapping && !mapping->ref.deref())
+        delete mapping;
+    mapping = nullptr;
+    capacity = 0;
+}
+
+// Returns the entry for digest if there is one, otherwise the unused entry
+// where it would go, or nullptr if the table is full.
+SharedEntry *QSharedImageCachePrivate::findEntry(const QByteArray &digest) const
+{
+    SharedEntry *table = reinterpret_cast<SharedEntry *>(header() + 1);
+    const quint32 mask = tableSizeFor(capacity) - 1;
+    quint32 start;
+    memcpy(&start, digest.constData(), sizeof(start));
+    for (quint32 probe = 0; probe <= mask; ++probe) {
+        SharedEntry *entry = table + ((start + probe) & mask);
+        if (!entry->offset.loadAcquire() || memcmp(entry->digest, digest.constData(), DigestSize) == 0)
+            return entry;
+    }
+    return nullptr;
+}
+
+static inline QByteArray digestFor(const QByteArray &key)
+{
+    return QCryptographicHash::hash(key, QCryptographicHash::Sha1);
+}
+
+namespace {
+struct GlobalSharedImageCache
+{
+    GlobalSharedImageCache() : cache(nullptr)
+    {
+        const int size = qEnvironmentVariableIntValue("QT_SHARED_IMAGE_CACHE");
+        if (size > 0) {
+            cache = new QSharedImageCache(QLatin1String("qt-shared-image-cache-" QT_VERSION_STR "-")
+                                          + QDir::homePath(), size * 1024);
+        }
+    }
+    ~GlobalSharedImageCache() { delete cache; }
+
+    QSharedImageCache *cache;
+};
+}
+
+Q_GLOBAL_STATIC(GlobalSharedImageCache, globalSharedImageCache)
+#endif // QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+
+/*!
+    Constructs a cache that uses the shared memory segment identified by
+    \a key, creating it with a size of \a size kilobytes if no other process
+    has created it yet.
+
+    Use isAttached() to check whether the segment could be used. The
+    segment cannot be used if it was created by a different version of Qt,
+    or if shared memory is not available on the platform.
+*/
+QSharedImageCache::QSharedImageCache(const QString &key, int size)
+    : d(new QSharedImageCachePrivate)
+{
+    d->key = key;
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    d->attach(size);
+#else
+    Q_UNUSED(size);
+#endif
+}
+
+/*!
+    Destroys the cache object. The shared memory segment stays attached as
+    long as images found in the cache are still in use.
+*/
+QSharedImageCache::~QSharedImageCache()
+{
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    d->release();
+#endif
+    delete d;
+}
+
+/*!
+    Returns the cache shared by all Qt applications of the current user, or
+    \c nullptr if there is none.
+
+    The global cache is only used if the \c QT_SHARED_IMAGE_CACHE
+    environment variable is set to its size in megabytes. It is created
+    with that size by the first application that uses it.
+*/
+QSharedImageCache *QSharedImageCache::globalInstance()
+{
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    GlobalSharedImageCache *global = globalSharedImageCache();
+    if (global && global->cache && global->cache->isAttached())
+        return global->cache;
+#endif
+    return nullptr;
+}
+
+/*!
+    Returns the key of the shared memory segment.
+*/
+QString QSharedImageCache::key() const
+{
+    return d->key;
+}
+
+/*!
+    Returns \c true if the cache is attached to its shared memory segment.
+    Otherwise, nothing can be inserted into the cache, and nothing is found
+    in it.
+*/
+bool QSharedImageCache::isAttached() const
+{
+    return d->capacity != 0;
+}
+
+/*!
+    Returns the size of the shared memory segment in kilobytes, or 0 if the
+    cache is not attached.
+*/
+int QSharedImageCache::size() const
+{
+    return int(d->capacity / 1024);
+}
+
+/*!
+    Copies \a image into the shared memory segment and stores it under
+    \a key. Returns \c true if the image is in the cache afterwards, also
+    when another process had already inserted it, and \c false if it is null
+    or does not fit into the segment any more.
+
+    Images with a color table are converted to QImage::Format_RGB32 or
+    QImage::Format_ARGB32_Premultiplied first. To use the shared copy
+    instead of \a image, call find() after inserting it.
+*/
+bool QSharedImageCache::insert(const QByteArray &key, const QImage &image)
+{
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    if (!isAttached() || image.isNull())
+        return false;
+
+    QImage source = image;
+    if (source.colorCount() > 0) {
+        source = source.convertToFormat(source.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                                 : QImage::Format_RGB32);
+    }
+    const qint64 bytes = source.sizeInBytes();
+    const QByteArray digest = digestFor(key);
+
+    QMutexLocker locker(&d->writeMutex);
+    if (!d->mapping->memory.lock())
+        return false;
+
+    bool inserted = false;
+    SharedHeader *h = d->header();
+    SharedEntry *entry = d->findEntry(digest);
+    if (entry && entry->offset.load()) {
+        inserted = true;
+    } else if (entry && h->count < h->tableSize / 4 * 3 && h->dataEnd <= d->capacity) {
+        const quint64 offset = (quint64(h->dataEnd) + DataAlignment - 1) & ~quint64(DataAlignment - 1);
+        if (offset + bytes <= d->capacity) {
+            // Claim the space before writing to it, so that it is not handed
+            // out twice should this process die halfway through.
+            h->dataEnd = quint32(offset + bytes);
+            memcpy(d->base() + offset, source.constBits(), size_t(bytes));
+            memcpy(entry->digest, digest.constData(), DigestSize);
+            entry->width = source.width();
+            entry->height = source.height();
+            entry->bytesPerLine = source.bytesPerLine();
+            entry->format = source.format();
+            entry->devicePixelRatio = source.devicePixelRatio();
+            entry->offset.storeRelease(quint32(offset));
+            ++h->count;
+            inserted = true;
+        }
+    }
+
+    d->mapping->memory.unlock();
+    return inserted;
+#else
+    Q_UNUSED(key);
+    Q_UNUSED(image);
+    return false;
+#endif
+}
+
+/*!
+    Looks for an image stored under \a key. If there is one, it is
+    assigned to \a image and this function returns \c true; otherwise
+    it returns \c false and leaves \a image alone.
+
+    The image uses the shared memory segment and is read-only.
+*/
+bool QSharedImageCache::find(const QByteArray &key, QImage *image) const
+{
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    if (!isAttached())
+        return false;
+
+    const SharedEntry *entry = d->findEntry(digestFor(key));
+    const quint32 offset = entry ? entry->offset.loadAcquire() : 0;
+    if (!offset)
+        return false;
+
+    // Do not trust what other processes wrote.
+    const int width = entry->width;
+    const int height = entry->height;
+    const int bytesPerLine = entry->bytesPerLine;
+    const int format = entry->format;
+    if (width <= 0 || height <= 0 || bytesPerLine <= 0
+            || format <= QImage::Format_Invalid || format >= QImage::NImageFormats
+            || quint64(offset) + quint64(bytesPerLine) * quint64(height) > d->capacity) {
+        return false;
+    }
+
+    if (image) {
+        d->mapping->ref.ref();
+        QImage shared(d->base() + offset, width, height, bytesPerLine, QImage::Format(format),
+                      releaseMapping, d->mapping);
+        if (shared.isNull()) {
+            // too few bytes per line for the format; QImage does not call
+            // the cleanup function then
+            releaseMapping(d->mapping);
+            return false;
+        }
+        shared.setDevicePixelRatio(entry->devicePixelRatio);
+        *image = std::move(shared);
+    }
+    return true;
+#else
+    Q_UNUSED(key);
+    Q_UNUSED(image);
+    return false;
+#endif
+}
+
+/*!
+    \overload
+
+    Returns the image stored under \a key, or a null image if there is
+    none.
+*/
+QImage QSharedImageCache::find(const QByteArray &key) const
+{
+    QImage image;
+    find(key, &image);
+    return image;
+}
+
+/*!
+    Returns \c true if an image is stored under \a key.
+*/
+bool QSharedImageCache::contains(const QByteArray &key) const
+{
+    return find(key, nullptr);
+}
+
+/*!
+    Returns the number of images in the cache, including those inserted by
+    other processes.
+*/
+int QSharedImageCache::count() const
+{
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    if (isAttached())
+        return int(d->header()->count);
+#endif
+    return 0;
+}
+
+/*!
+    Returns the number of bytes of the shared memory segment used by the
+    images in the cache.
+
+    \sa size()
+*/
+qint64 QSharedImageCache::totalUsed() const
+{
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    if (isAttached())
+        return qint64(d->header()->dataEnd) - qint64(d->header()->dataBegin);
+#endif
+    return 0;
+}
+
+QT_END_NAMESPACE
@@ -124,7 +124,7 @@ void QStandardItemPrivate::setChild(int row, int column, QStandardItem *item,
     int index = childIndex(row, column);
     Q_ASSERT(index != -1);
     QStandardItem *oldItem = children.at(index);
-    if (item == oldItem)
+    if (item == oldItem && !(flat && flatValues.at(index).isValid()))
         return;
 
     if (model && emitChanged) {
@@ -144,6 +144,8 @@ void QStandardItemPrivate::setChild(int row, int column, QStandardItem *item,
         oldItem->d_func()->setModel(0);
     delete oldItem;
     children.replace(index, item);
+    if (flat)
+        flatValues[index] = QVariant();
 
     if (model && emitChanged)
         emit model->layoutChanged();
@@ -231,37 +233,75 @@ void QStandardItemPrivate::sortChildren(int column, Qt::SortOrder order)
     if (column >= columnCount())
         return;
 
-    QVector<QPair<QStandardItem*, int> > sortable;
+    QVector<int> sortedRows;
     QVector<int> unsortable;
 
-    sortable.reserve(rowCount());
+    sortedRows.reserve(rowCount());
     unsortable.reserve(rowCount());
 
-    for (int row = 0; row < rowCount(); ++row) {
-        QStandardItem *itm = q->child(row, column);
-        if (itm)
-            sortable.append(QPair<QStandardItem*,int>(itm, row));
-        else
-            unsortable.append(row);
-    }
+    if (flat) {
+        // compare the sort role data directly, items are not created for
+        // the flat values
+        QVector<QPair<QVariant, int> > sortable;
+        sortable.reserve(rowCount());
+        const int role = model ? model->sortRole() : Qt::DisplayRole;
+        for (int row = 0; row < rowCount(); ++row) {
+            const int index = childIndex(row, column);
+            if (QStandardItem *itm = children.at(index))
+                sortable.append(qMakePair(itm->data(role), row));
+            else if ((role == Qt::DisplayRole || role == Qt::EditRole) && flatValues.at(index).isValid())
+                sortable.append(qMakePair(flatValues.at(index), row));
+            else
+                unsortable.append(row);
+        }
 
-    if (order == Qt::AscendingOrder) {
-        QStandardItemModelLessThan lt;
-        std::stable_sort(sortable.begin(), sortable.end(), lt);
+        const auto lessThan = [](const QPair<QVariant, int> &l, const QPair<QVariant, int> &r) {
+            return QAbstractItemModelPrivate::isVariantLessThan(l.first, r.first);
+        };
+        if (order == Qt::AscendingOrder) {
+            std::stable_sort(sortable.begin(), sortable.end(), lessThan);
+        } else {
+            std::stable_sort(sortable.begin(), sortable.end(),
+                             [&lessThan](const QPair<QVariant, int> &l, const QPair<QVariant, int> &r) {
+                                 return lessThan(r, l);
+                             });
+        }
+        for (const auto &entry : qAsConst(sortable))
+            sortedRows.append(entry.second);
     } else {
-        QStandardItemModelGreaterThan gt;
-        std::stable_sort(sortable.begin(), sortable.end(), gt);
+        QVector<QPair<QStandardItem*, int> > sortable;
+        sortable.reserve(rowCount());
+
+        for (int row = 0; row < rowCount(); ++row) {
+            QStandardItem *itm = q->child(row, column);
+            if (itm)
+                sortable.append(QPair<QStandardItem*,int>(itm, row));
+            else
+                unsortable.append(row);
+        }
+
+        if (order == Qt::AscendingOrder) {
+            QStandardItemModelLessThan lt;
+            std::stable_sort(sortable.begin(), sortable.end(), lt);
+        } else {
+            QStandardItemModelGreaterThan gt;
+            std::stable_sort(sortable.begin(), sortable.end(), gt);
+        }
+        for (const auto &entry : qAsConst(sortable))
+            sortedRows.append(entry.second);
     }
+    sortedRows += unsortable;
 
     QModelIndexList changedPersistentIndexesFrom, changedPersistentIndexesTo;
     QVector<QStandardItem*> sorted_children(children.count());
+    QVector<QVariant> sorted_flatValues(flatValues.count());
     for (int i = 0; i < rowCount(); ++i) {
-        int r = (i < sortable.count()
-                 ? sortable.at(i).second
-                 : unsortable.at(i - sortable.count()));
+        int r = sortedRows.at(i);
         for (int c = 0; c < columnCount(); ++c) {
             QStandardItem *itm = q->child(r, c);
             sorted_children[childIndex(i, c)] = itm;
+            if (flat)
+                sorted_flatValues[childIndex(i, c)] = flatValues.at(childIndex(r, c));
             if (model) {
                 QModelIndex from = model->createIndex(r, c, q);
                 if (model->d_func()->persistent.indexes.contains(from)) {
@@ -274,6 +314,7 @@ void QStandardItemPrivate::sortChildren(int column, Qt::SortOrder order)
     }
 
     children = sorted_children;
+    flatValues = sorted_flatValues;
 
     if (model) {
         model->changePersistentIndexList(changedPersistentIndexesFrom, changedPersistentIndexesTo);
@@ -315,6 +356,78 @@ void QStandardItemPrivate::setModel(QStandardItemModel *mod)
     }
 }
 
+/*!
+  \internal
+  Returns a new item holding the flat value of the child at \a index and
+  clears the value, or 0 if there is no value. The item has no parent yet.
+*/
+QStandardItem *QStandardItemPrivate::takeFlatValue(int index)
+{
+    if (!flat || index == -1 || !flatValues.at(index).isValid())
+        return 0;
+    QStandardItem *item = model ? model->d_func()->createItem() : new QStandardItem;
+    item->setData(flatValues.at(index), Qt::DisplayRole);
+    flatValues[index] = QVariant();
+    return item;
+}
+
+/*!
+  \internal
+  Replaces the flat value of the child at \a index with an item, and
+  returns the item, or 0 if there is no value.
+*/
+QStandardItem *QStandardItemPrivate::materializeFlatValue(int index)
+{
+    Q_Q(QStandardItem);
+    QStandardItem *item = takeFlatValue(index);
+    if (item) {
+        item->d_func()->setParentAndModel(q, model);
+        children.replace(index, item);
+    }
+    return item;
+}
+
+/*!
+  \internal
+*/
+void QStandardItemPrivate::setFlat(bool enable)
+{
+    if (flat == enable)
+        return;
+    if (enable) {
+        flatValues.resize(children.count());
+        flat = true;
+    } else {
+        for (int i = 0; i < flatValues.count(); ++i)
+            materializeFlatValue(i);
+        flatValues.clear();
+        flat = false;
+    }
+}
+
+/*!
+  \internal
+  Sets the flat value for the top-level cell at \a index if the model is in
+  flat storage mode and the cell has no item; returns \c false if the value
+  has to go to an item instead.
+*/
+bool QStandardItemModelPrivate::setFlatValue(const QModelIndex &index, const QVariant &value)
+{
+    Q_Q(QStandardItemModel);
+    QStandardItemPrivate *rd = root->d_func();
+    if (!rd->flat || index.model() != q || index.internalPointer() != root.data())
+        return false;
+    const int i = rd->childIndex(index.row(), index.column());
+    if (i == -1 || rd->children.at(i))
+        return false;
+    QVariant &old = rd->flatValues[i];
+    if (old.type() == value.type() && old == value)
+        return true;
+    old = value;
+    emit q->dataChanged(index, index);
+    return true;
+}
+
 /*!
   \internal
 */
@@ -375,12 +488,17 @@ bool QStandardItemPrivate::insertRows(int row, const QList<QStandardItem*> &item
         if (columnCount() == 0)
             q->setColumnCount(1);
         children.resize(columnCount() * count);
+        if (flat)
+            flatValues.resize(children.count());
         rows = count;
     } else {
         rows += count;
         int index = childIndex(row, 0);
-        if (index != -1)
+        if (index != -1) {
             children.insert(index, columnCount() * count, 0);
+            if (flat)
+                flatValues.insert(index, columnCount() * count, QVariant());
+        }
     }
     for (int i = 0; i < items.count(); ++i) {
         QStandardItem *item = items.at(i);
@@ -403,12 +521,17 @@ bool QStandardItemPrivate::insertRows(int row, int count, const QList<QStandardI
         model->d_func()->rowsAboutToBeInserted(q, row, row + count - 1);
     if (rowCount() == 0) {
         children.resize(columnCount() * count);
+        if (flat)
+            flatValues.resize(children.count());
         rows = count;
     } else {
         rows += count;
         int index = childIndex(row, 0);
-        if (index != -1)
+        if (index != -1) {
             children.insert(index, columnCount() * count, 0);
+            if (flat)
+                flatValues.insert(index, columnCount() * count, QVariant());
+        }
     }
     if (!items.isEmpty()) {
         int index = childIndex(row, 0);
@@ -445,12 +568,16 @@ bool QStandardItemPrivate::insertColumns(int column, int count, const QList<QSta
         model->d_func()->columnsAboutToBeInserted(q, column, column + count - 1);
     if (columnCount() == 0) {
         children.resize(rowCount() * count);
+        if (flat)
+            flatValues.resize(children.count());
         columns = count;
     } else {
         columns += count;
         int index = childIndex(0, column);
         for (int row = 0; row < rowCount(); ++row) {
             children.insert(index, count, 0);
+            if (flat)
+                flatValues.insert(index, count, QVariant());
             index += columnCount();
         }
     }
@@ -1682,6 +1809,8 @@ void QStandardItem::removeRows(int row, int count)
         delete oldItem;
     }
     d->children.remove(qMax(i, 0), n);
+    if (d->flat)
+        d->flatValues.remove(qMax(i, 0), n);
     d->rows -= count;
     if (d->model)
         d->model->d_func()->rowsRemoved(this, row, count);
@@ -1709,6 +1838,8 @@ void QStandardItem::removeColumns(int column, int count)
             delete oldItem;
         }
         d->children.remove(i, count);
+        if (d->flat)
+            d->flatValues.remove(i, count);
     }
     d->columns -= count;
     if (d->model)
@@ -1781,6 +1912,8 @@ QStandardItem *QStandardItem::takeChild(int row, int column)
         item = d->children.at(index);
         if (item)
             item->d_func()->setParentAndModel(0, 0);
+        else
+            item = d->takeFlatValue(index);
         d->children.replace(index, 0);
     }
     return item;
@@ -1810,9 +1943,13 @@ QList<QStandardItem*> QStandardItem::takeRow(int row)
             QStandardItem *ch = d->children.at(index + column);
             if (ch)
                 ch->d_func()->setParentAndModel(0, 0);
+            else
+                ch = d->takeFlatValue(index + column);
             items.append(ch);
         }
         d->children.remove(index, col_count);
+        if (d->flat)
+            d->flatValues.remove(index, col_count);
     }
     d->rows--;
     if (d->model)
@@ -1843,7 +1980,11 @@ QList<QStandardItem*> QStandardItem::takeColumn(int column)
         QStandardItem *ch = d->children.at(index);
         if (ch)
             ch->d_func()->setParentAndModel(0, 0);
+        else
+            ch = d->takeFlatValue(index);
         d->children.remove(index);
+        if (d->flat)
+            d->flatValues.remove(index);
         items.prepend(ch);
     }
     d->columns--;
@@ -2142,9 +2283,11 @@ void QStandardItemModel::clear()
 {
     Q_D(QStandardItemModel);
     beginResetModel();
+    const bool flat = d->root->d_func()->flat;
     d->root.reset(new QStandardItem);
     d->root->setFlags(Qt::ItemIsDropEnabled);
     d->root->d_func()->setModel(this);
+    d->root->d_func()->flat = flat;
     qDeleteAll(d->columnHeaderItems);
     d->columnHeaderItems.clear();
     qDeleteAll(d->rowHeaderItems);
@@ -2182,8 +2325,12 @@ QStandardItem *QStandardItemModel::itemFromIndex(const QModelIndex &index) const
     QStandardItem *item = parent->child(index.row(), index.column());
     // lazy part
     if (item == 0) {
-        item = d->createItem();
-        parent->d_func()->setChild(index.row(), index.column(), item);
+        QStandardItemPrivate *p = parent->d_func();
+        item = p->materializeFlatValue(p->childIndex(index.row(), index.column()));
+        if (item == 0) {
+            item = d->createItem();
+            p->setChild(index.row(), index.column(), item);
+        }
     }
     return item;
 }
@@ -2266,12 +2413,20 @@ void QStandardItemModel::setItem(int row, int column, QStandardItem *item)
     Returns the item for the given \a row and \a column if one has been set;
     otherwise returns 0.
 
-    \sa setItem(), takeItem(), itemFromIndex()
+    In flat storage mode, the item is created when this function is called
+    for a cell that holds a value.
+
+    \sa setItem(), takeItem(), itemFromIndex(), setFlatStorageEnabled()
 */
 QStandardItem *QStandardItemModel::item(int row, int column) const
 {
     Q_D(const QStandardItemModel);
-    return d->root->child(row, column);
+    QStandardItem *item = d->root->child(row, column);
+    if (item == 0) {
+        QStandardItemPrivate *rd = d->root->d_func();
+        item = rd->materializeFlatValue(rd->childIndex(row, column));
+    }
+    return item;
 }
 
 /*!
@@ -2693,6 +2848,155 @@ void QStandardItemModel::setSortRole(int role)
     d->sortRole = role;
 }
 
+/*!
+    \since 5.11
+
+    Returns \c true if the model keeps the display data of its top-level
+    cells in flat storage; otherwise returns \c false.
+
+    \sa setFlatStorageEnabled()
+*/
+bool QStandardItemModel::isFlatStorageEnabled() const
+{
+    Q_D(const QStandardItemModel);
+    return d->root->d_func()->flat;
+}
+
+/*!
+    \since 5.11
+
+    Enables flat storage for the top-level cells of the model if \a enable
+    is true; otherwise disables it. Flat storage is disabled by default.
+
+    In flat storage mode, the Qt::DisplayRole data of a top-level cell that
+    has no item is kept in a single array owned by the model, instead of in
+    a QStandardItem created for the cell. An item is only created when it is
+    requested with item() or itemFromIndex(), or when data for another role
+    is set on the cell. This considerably reduces the memory used by large,
+    non-hierarchical tables, in particular when they are filled with
+    appendRows() or setColumnData().
+
+    Cells that have no item have the default flags, and itemChanged() is not
+    emitted for them. QStandardItem::child() on the invisibleRootItem()
+    returns 0 for such cells. When sorting, the sortRole() data is compared
+    directly and QStandardItem::operator<() is not called.
+
+    Disabling flat storage creates items for all cells that hold a value.
+
+    \sa appendRows(), setColumnData()
+*/
+void QStandardItemModel::setFlatStorageEnabled(bool enable)
+{
+    Q_D(QStandardItemModel);
+    d->root->d_func()->setFlat(enable);
+}
+
+/*!
+    \since 5.11
+
+    Appends a row for each entry in \a rows. An entry holds the Qt::DisplayRole
+    data of the row's cells, starting at column 0; the column count is
+    increased to fit the longest row if necessary.
+
+    In flat storage mode the values are stored without creating items;
+    otherwise an item is created for each valid value, using itemPrototype().
+    All rows are inserted at once, with a single rowsInserted() signal.
+
+    \sa appendRow(), setColumnData(), setFlatStorageEnabled()
+*/
+void QStandardItemModel::appendRows(const QVector<QVector<QVariant> > &rows)
+{
+    Q_D(QStandardItemModel);
+    if (rows.isEmpty())
+        return;
+    int columns = columnCount();
+    for (const QVector<QVariant> &row : rows)
+        columns = qMax(columns, row.count());
+    setColumnCount(columns);
+
+    QStandardItemPrivate *rd = d->root->d_func();
+    const int first = rowCount();
+    if (rd->flat) {
+        d->rowsAboutToBeInserted(d->root.data(), first, first + rows.count() - 1);
+        rd->children.resize(rd->children.count() + columns * rows.count());
+        rd->flatValues.reserve(rd->children.count());
+        for (const QVector<QVariant> &row : rows) {
+            rd->flatValues += row;
+            rd->flatValues.resize(rd->flatValues.count() + columns - row.count());
+        }
+        rd->rows += rows.count();
+        d->rowsInserted(d->root.data(), first, rows.count());
+    } else {
+        QList<QStandardItem*> items;
+        items.reserve(columns * rows.count());
+        for (const QVector<QVariant> &row : rows) {
+            for (int column = 0; column < columns; ++column) {
+                QStandardItem *item = 0;
+                if (column < row.count() && row.at(column).isValid()) {
+                    item = d->createItem();
+                    item->setData(row.at(column), Qt::DisplayRole);
+                }
+                items.append(item);
+            }
+        }
+        rd->insertRows(first, rows.count(), items);
+    }
+}
+
+/*!
+    \since 5.11
+
+    Sets the Qt::DisplayRole data of the top-level cells in \a column,
+    starting at \a firstRow, to \a values. The row and column counts are
+    increased to fit the values if necessary.
+
+    In flat storage mode, no items are created for cells that do not have
+    one. Existing items are updated directly, without calling
+    QStandardItem::setData(), and a single dataChanged() signal is emitted
+    for the whole range.
+
+    \sa appendRows(), setFlatStorageEnabled()
+*/
+void QStandardItemModel::setColumnData(int column, const QVector<QVariant> &values, int firstRow)
+{
+    Q_D(QStandardItemModel);
+    if ((column < 0) || (firstRow < 0) || values.isEmpty())
+        return;
+    const int lastRow = firstRow + values.count() - 1;
+    if (columnCount() <= column)
+        setColumnCount(column + 1);
+    if (rowCount() <= lastRow)
+        setRowCount(lastRow + 1);
+
+    QStandardItemPrivate *rd = d->root->d_func();
+    for (int i = 0; i < values.count(); ++i) {
+        const QVariant &value = values.at(i);
+        const int index = rd->childIndex(firstRow + i, column);
+        if (QStandardItem *item = rd->children.at(index)) {
+            // update the item without emitting a signal for every cell
+            QVector<QStandardItemData> &itemValues = item->d_func()->values;
+            auto it = std::find_if(itemValues.begin(), itemValues.end(),
+                                   [](const QStandardItemData &data) { return data.role == Qt::DisplayRole; });
+            if (it == itemValues.end()) {
+                if (value.isValid())
+                    itemValues.append(QStandardItemData(Qt::DisplayRole, value));
+            } else if (value.isValid()) {
+                it->value = value;
+            } else {
+                itemValues.erase(it);
+            }
+        } else if (rd->flat) {
+            rd->flatValues[index] = value;
+        } else if (value.isValid()) {
+            QStandardItem *item = d->createItem();
+            item->setData(value, Qt::DisplayRole);
+            item->d_func()->setParentAndModel(d->root.data(), this);
+            rd->children.replace(index, item);
+        }
+    }
+    emit dataChanged(index(firstRow, column), index(lastRow, column));
+}
+
 /*!
   \reimp
 */
@@ -2710,7 +3014,7 @@ QVariant QStandardItemModel::data(const QModelIndex &index, int role) const
 {
     Q_D(const QStandardItemModel);
     QStandardItem *item = d->itemFromIndex(index);
-    return item ? item->data(role) : QVariant();
+    return item ? item->data(role) : d->flatValue(index, role);
 }
 
 /*!
@@ -2827,7 +3131,13 @@ QMap<int, QVariant> QStandardItemModel::itemData(const QModelIndex &index) const
 {
     Q_D(const QStandardItemModel);
     QStandardItem *item = d->itemFromIndex(index);
-    return item ? item->d_func()->itemData() : QMap<int, QVariant>();
+    if (item)
+        return item->d_func()->itemData();
+    QMap<int, QVariant> roles;
+    const QVariant value = d->flatValue(index, Qt::DisplayRole);
+    if (value.isValid())
+        roles.insert(Qt::DisplayRole, value);
+    return roles;
 }
 
 /*!
@@ -2883,8 +3193,11 @@ int QStandardItemModel::rowCount(const QModelIndex &parent) const
 */
 bool QStandardItemModel::setData(const QModelIndex &index, const QVariant &value, int role)
 {
+    Q_D(QStandardItemModel);
     if (!index.isValid())
         return false;
+    if ((role == Qt::DisplayRole || role == Qt::EditRole) && d->setFlatValue(index, value))
+        return true;
     QStandardItem *item = itemFromIndex(index);
     if (item == 0)
         return false;
@@ -2931,6 +3244,15 @@ bool QStandardItemModel::setHeaderData(int section, Qt::Orientation orientation,
 */
 bool QStandardItemModel::setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles)
 {
+    Q_D(QStandardItemModel);
+    bool displayOnly = true;
+    for (auto it = roles.cbegin(), end = roles.cend(); it != end && displayOnly; ++it)
+        displayOnly = it.key() == Qt::DisplayRole || it.key() == Qt::EditRole;
+    if (displayOnly) {
+        const QVariant value = roles.value(Qt::EditRole, roles.value(Qt::DisplayRole));
+        if (d->setFlatValue(index, value))
+            return true;
+    }
     QStandardItem *item = itemFromIndex(index);
     if (item == 0)
         return false;
@@ -414,6 +414,12 @@ public:
     int sortRole() const;
     void setSortRole(int role);
 
+    bool isFlatStorageEnabled() const;
+    void setFlatStorageEnabled(bool enable);
+
+    void appendRows(const QVector<QVector<QVariant> > &rows);
+    void setColumnData(int column, const QVector<QVariant> &values, int firstRow = 0);
+
     QStringList mimeTypes() const Q_DECL_OVERRIDE;
     QMimeData *mimeData(const QModelIndexList &indexes) const Q_DECL_OVERRIDE;
     bool dropMimeData (const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) Q_DECL_OVERRIDE;
@@ -103,7 +103,8 @@ public:
           rows(0),
           columns(0),
           q_ptr(0),
-          lastIndexOf(2)
+          lastIndexOf(2),
+          flat(false)
         { }
 
     inline int childIndex(int row, int column) const {
@@ -150,6 +151,10 @@ public:
 
     void sortChildren(int column, Qt::SortOrder order);
 
+    QStandardItem *takeFlatValue(int index);
+    QStandardItem *materializeFlatValue(int index);
+    void setFlat(bool enable);
+
     QStandardItemModel *model;
     QStandardItem *parent;
     QVector<QStandardItemData> values;
@@ -159,7 +164,12 @@ public:
 
     QStandardItem *q_ptr;
 
+    // Qt::DisplayRole values of the children that have no item; only used
+    // by the root item in flat storage mode, then parallel to children
+    QVector<QVariant> flatValues;
+
     int lastIndexOf;
+    bool flat;
 };
 
 class QStandardItemModelPrivate : public QAbstractItemModelPrivate
@@ -188,6 +198,17 @@ public:
         return parent->child(index.row(), index.column());
     }
 
+    inline QVariant flatValue(const QModelIndex &index, int role) const {
+        const QStandardItemPrivate *rd = root->d_func();
+        if (!rd->flat || (role != Qt::DisplayRole && role != Qt::EditRole)
+            || index.internalPointer() != root.data()) {
+            return QVariant();
+        }
+        const int i = rd->childIndex(index.row(), index.column());
+        return i == -1 ? QVariant() : rd->flatValues.at(i);
+    }
+    bool setFlatValue(const QModelIndex &index, const QVariant &value);
+
     void sort(QStandardItem *parent, int column, Qt::SortOrder order);
     void itemChanged(QStandardItem *item);
     void rowsAboutToBeInserted(QStandardItem *parent, int start, int end);
@@ -78,7 +78,8 @@ HEADERS += \
         kernel/qplatformgraphicsbufferhelper.h \
         kernel/qinputdevicemanager_p.h \
         kernel/qinputdevicemanager_p_p.h \
-        kernel/qhighdpiscaling_p.h
+        kernel/qhighdpiscaling_p.h \
+        kernel/qtgui_tracepoints_p.h
 
 
 SOURCES += \
@@ -138,6 +139,12 @@ SOURCES += \
         kernel/qinputdevicemanager.cpp \
         kernel/qhighdpiscaling.cpp
 
+qtConfig(lttng)|qtConfig(etw): \
+    SOURCES += kernel/qtgui_tracepoints.cpp
+
+qtConfig(lttng): \
+    QMAKE_USE_PRIVATE += lttng-ust
+
 
 qtConfig(opengl) {
     HEADERS += \
@@ -58,6 +58,7 @@
 #include <QtCore/private/qabstracteventdispatcher_p.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/private/qthread_p.h>
+#include <QtCore/private/qstartuptrace_p.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qnumeric.h>
@@ -88,6 +89,7 @@
 
 #include "private/qdnd_p.h"
 #include <qpa/qplatformthemefactory_p.h>
+#include <qpa/qplatforminputcontextfactory_p.h>
 
 #ifndef QT_NO_CURSOR
 #include <qpa/qplatformcursor.h>
@@ -1337,16 +1339,31 @@ void QGuiApplicationPrivate::eventDispatcherReady()
         QHighDpiScaling::updateHighDpiScaling();
 }
 
+extern void qt_populateFontDatabase();
+
 void QGuiApplicationPrivate::init()
 {
 #if defined(Q_OS_MACOS)
     QMacAutoReleasePool pool;
 #endif
 
+    QStartupTrace::Phase totalPhase("QGuiApplication");
+
     QCoreApplicationPrivate::init();
 
     QCoreApplicationPrivate::is_app_running = false; // Starting up.
 
+    // Work that does not depend on the platform integration runs on the
+    // thread pool while the integration is being created. The group waits
+    // for all of it when init() returns.
+    QStartupTaskGroup startupTasks;
+    startupTasks.start("plugin discovery", [] {
+        // scanning the plugin directories populates the factory loaders
+        QGenericPluginFactory::keys();
+        QPlatformThemeFactory::keys();
+        QPlatformInputContextFactory::keys();
+    });
+
     bool loadTestability = false;
     QList<QByteArray> pluginList;
     // Get command line params
@@ -1430,9 +1447,14 @@ void QGuiApplicationPrivate::init()
     if (!envPlugins.isEmpty())
         pluginList += envPlugins.split(',');
 
-    if (platform_integration == 0)
+    if (platform_integration == 0) {
+        QStartupTrace::Phase phase("platform integration");
         createPlatformIntegration();
+    }
+
+    startupTasks.start("font database", qt_populateFontDatabase);
 
+    QStartupTrace::Phase palettePhase("palette and fonts");
     initPalette();
     QFont::initialize();
 
@@ -1462,9 +1484,16 @@ void QGuiApplicationPrivate::init()
 #endif
 
     QWindowSystemInterfacePrivate::eventTime.start();
+    // A wakeup left pending by a previous application instance went to an
+    // event dispatcher that no longer exists.
+    QWindowSystemInterfacePrivate::wakeUpPending.store(0);
+    palettePhase.finish();
 
     is_app_running = true;
-    init_plugins(pluginList);
+    {
+        QStartupTrace::Phase phase("generic plugins");
+        init_plugins(pluginList);
+    }
     QWindowSystemInterface::flushWindowSystemEvents();
 
     Q_Q(QGuiApplication);
@@ -1478,6 +1507,7 @@ void QGuiApplicationPrivate::init()
         loadTestability = true;
 
     if (loadTestability) {
+        QStartupTrace::Phase phase("testability");
         QLibrary testLib(QStringLiteral("qttestability"));
         if (Q_UNLIKELY(!testLib.load())) {
             qCritical() << "Library qttestability load failed:" << testLib.errorString();
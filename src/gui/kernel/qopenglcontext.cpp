@@ -50,6 +50,7 @@
 #include <QtGui/private/qopengl_p.h>
 #include <QtGui/private/qwindow_p.h>
 #include <QtGui/QScreen>
+#include <QtGui/QRegion>
 #include <qpa/qplatformnativeinterface.h>
 
 #include <private/qopenglextensions_p.h>
@@ -1079,7 +1080,21 @@ QSurface *QOpenGLContext::surface() const
 void QOpenGLContext::swapBuffers(QSurface *surface)
 {
     Q_D(QOpenGLContext);
-    if (!isValid())
+    d->swapBuffers(surface, QRegion());
+}
+
+/*!
+    \internal
+
+    Swaps the buffers of \a surface like QOpenGLContext::swapBuffers(), but
+    passes \a damage, in device pixels, to the platform so that only the
+    changed area needs to be presented. An empty \a damage means the whole
+    surface has changed.
+*/
+void QOpenGLContextPrivate::swapBuffers(QSurface *surface, const QRegion &damage)
+{
+    Q_Q(QOpenGLContext);
+    if (!q->isValid())
         return;
 
     if (!surface) {
@@ -1103,12 +1118,15 @@ void QOpenGLContext::swapBuffers(QSurface *surface)
         return;
 
 #if !defined(QT_NO_DEBUG)
-    if (!QOpenGLContextPrivate::toggleMakeCurrentTracker(this, false))
+    if (!toggleMakeCurrentTracker(q, false))
         qWarning("QOpenGLContext::swapBuffers() called without corresponding makeCurrent()");
 #endif
     if (surface->format().swapBehavior() == QSurfaceFormat::SingleBuffer)
-        functions()->glFlush();
-    d->platformGLContext->swapBuffers(surfaceHandle);
+        q->functions()->glFlush();
+    if (damage.isEmpty())
+        platformGLContext->swapBuffers(surfaceHandle);
+    else
+        platformGLContext->swapBuffersWithDamage(surfaceHandle, damage);
 }
 
 /*!
@@ -192,6 +192,7 @@ private:
 class QPaintEngineEx;
 class QOpenGLFunctions;
 class QOpenGLTextureHelper;
+class QRegion;
 
 class Q_GUI_EXPORT QOpenGLContextPrivate : public QObjectPrivate
 {
@@ -264,6 +265,8 @@ public:
 
     int maxTextureSize();
 
+    void swapBuffers(QSurface *surface, const QRegion &damage);
+
     static QOpenGLContextPrivate *get(QOpenGLContext *context)
     {
         return context ? context->d_func() : Q_NULLPTR;
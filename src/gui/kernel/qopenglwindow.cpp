@@ -45,6 +45,7 @@
 #include <QtGui/QOpenGLTextureBlitter>
 #include <QtGui/private/qopenglextensions_p.h>
 #include <QtGui/private/qopenglcontext_p.h>
+#include <qpa/qplatformopenglcontext.h>
 #include <QtGui/QMatrix4x4>
 #include <QtGui/QOffscreenSurface>
 
@@ -133,6 +134,13 @@ QT_BEGIN_NAMESPACE
   code in paintGL() which only repaints a smaller area at a time, because, unlike
   NoPartialUpdate, the previous content is preserved.
 
+  Starting with Qt 5.11, when the window is updated via update() with a
+  rectangle or region and the platform can report the age of the back buffer
+  (for example via EGL_EXT_buffer_age), only the changed area is blitted and,
+  when supported, presented (for example via EGL_KHR_swap_buffers_with_damage).
+  Content drawn in paintUnderGL() or paintOverGL() outside the updated
+  region may then not become visible until the next full update.
+
   \value PartialUpdateBlend Similar to PartialUpdateBlit, but instead of using
   framebuffer blits, the contents of the extra framebuffer is rendered by
   drawing a textured quad with blending enabled. This, unlike PartialUpdateBlit,
@@ -192,6 +200,9 @@ public:
     void endPaint() Q_DECL_OVERRIDE;
     void flush(const QRegion &region) Q_DECL_OVERRIDE;
 
+    QRegion deviceRegion(const QRegion &region) const;
+    QRegion repaintRegionForBufferAge(const QRegion &damage);
+
     QOpenGLWindow::UpdateBehavior updateBehavior;
     bool hasFboBlit;
     QScopedPointer<QOpenGLContext> context;
@@ -201,6 +212,9 @@ public:
     QOpenGLTextureBlitter blitter;
     QColor backgroundColor;
     QScopedPointer<QOffscreenSurface> offscreenSurface;
+    // Damage of the previous frames in device pixels, most recent first.
+    QVector<QRegion> damageHistory;
+    QRegion frameDamage;
 };
 
 QOpenGLWindowPrivate::~QOpenGLWindowPrivate()
@@ -237,9 +251,50 @@ void QOpenGLWindowPrivate::initialize()
     q->initializeGL();
 }
 
+QRegion QOpenGLWindowPrivate::deviceRegion(const QRegion &region) const
+{
+    Q_Q(const QOpenGLWindow);
+    const qreal dpr = q->devicePixelRatio();
+    if (dpr == 1)
+        return region;
+    QRegion result;
+    for (const QRect &r : region)
+        result += QRectF(r.x() * dpr, r.y() * dpr, r.width() * dpr, r.height() * dpr).toAlignedRect();
+    return result;
+}
+
+/*
+    Returns the region of the back buffer that has to be refreshed for a
+    frame with the given \a damage, or an empty region when the whole
+    buffer must be refreshed. Records \a damage for the following frames.
+*/
+QRegion QOpenGLWindowPrivate::repaintRegionForBufferAge(const QRegion &damage)
+{
+    Q_Q(QOpenGLWindow);
+    static const int maxDamageHistory = 4;
+
+    QRegion repaint;
+    const int age = context->handle() ? context->handle()->bufferAge(q->handle()) : 0;
+    if (!damage.isEmpty() && age > 0 && age <= damageHistory.size() + 1) {
+        repaint = damage;
+        for (int i = 0; i < age - 1; ++i) {
+            // An empty entry stands for a frame where everything changed.
+            if (damageHistory.at(i).isEmpty()) {
+                repaint = QRegion();
+                break;
+            }
+            repaint += damageHistory.at(i);
+        }
+    }
+
+    damageHistory.prepend(damage);
+    if (damageHistory.size() > maxDamageHistory)
+        damageHistory.removeLast();
+    return repaint;
+}
+
 void QOpenGLWindowPrivate::beginPaint(const QRegion &region)
 {
-    Q_UNUSED(region);
     Q_Q(QOpenGLWindow);
 
     initialize();
@@ -272,6 +327,17 @@ void QOpenGLWindowPrivate::beginPaint(const QRegion &region)
 
     context->functions()->glBindFramebuffer(GL_FRAMEBUFFER, context->defaultFramebufferObject());
 
+    // Track what changed so that only that part needs to be blitted and
+    // presented. An empty frameDamage means the whole window.
+    frameDamage = QRegion();
+    if (updateBehavior == QOpenGLWindow::PartialUpdateBlit && hasFboBlit) {
+        const QRegion damage = deviceRegion(region);
+        if (damage != QRegion(QRect(QPoint(0, 0), deviceSize)))
+            frameDamage = damage;
+    } else {
+        damageHistory.clear();
+    }
+
     q->paintUnderGL();
 
     if (updateBehavior > QOpenGLWindow::NoPartialUpdate)
@@ -293,9 +359,21 @@ void QOpenGLWindowPrivate::endPaint()
         QOpenGLExtensions extensions(context.data());
         extensions.glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo->handle());
         extensions.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, context->defaultFramebufferObject());
-        extensions.glBlitFramebuffer(0, 0, deviceWidth, deviceHeight,
-                                     0, 0, deviceWidth, deviceHeight,
-                                     GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        const QRegion repaint = repaintRegionForBufferAge(frameDamage);
+        if (repaint.isEmpty()) {
+            frameDamage = QRegion();
+            extensions.glBlitFramebuffer(0, 0, deviceWidth, deviceHeight,
+                                         0, 0, deviceWidth, deviceHeight,
+                                         GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        } else {
+            for (const QRect &r : repaint) {
+                // GL has its origin in the bottom-left corner.
+                const int y = deviceHeight - r.y() - r.height();
+                extensions.glBlitFramebuffer(r.x(), y, r.x() + r.width(), y + r.height(),
+                                             r.x(), y, r.x() + r.width(), y + r.height(),
+                                             GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            }
+        }
     } else if (updateBehavior > QOpenGLWindow::NoPartialUpdate) {
         if (updateBehavior == QOpenGLWindow::PartialUpdateBlend) {
             context->functions()->glEnable(GL_BLEND);
@@ -329,7 +407,7 @@ void QOpenGLWindowPrivate::flush(const QRegion &region)
 {
     Q_UNUSED(region);
     Q_Q(QOpenGLWindow);
-    context->swapBuffers(q);
+    QOpenGLContextPrivate::get(context.data())->swapBuffers(q, frameDamage);
     emit q->frameSwapped();
 }
 
@@ -115,6 +115,41 @@ GLuint QPlatformOpenGLContext::defaultFramebufferObject(QPlatformSurface *) cons
     return 0;
 }
 
+/*!
+    Swaps the buffers of \a surface, telling the windowing system that only
+    \a damage has changed since the previous frame. \a damage is in device
+    pixels with the origin in the top-left corner of the surface.
+
+    Reimplement in subclass if the platform can restrict presentation to a
+    region, for example through EGL_KHR_swap_buffers_with_damage. The default
+    implementation calls swapBuffers().
+
+    \since 5.11
+*/
+void QPlatformOpenGLContext::swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage)
+{
+    Q_UNUSED(damage);
+    swapBuffers(surface);
+}
+
+/*!
+    Returns the age of the current back buffer of \a surface, that is, the
+    number of frames that have been swapped since its contents were last
+    presented. 0 means the contents are undefined and the whole surface must
+    be redrawn.
+
+    Reimplement in subclass if the platform supports querying the buffer age,
+    for example through EGL_EXT_buffer_age. The default implementation
+    returns 0.
+
+    \since 5.11
+*/
+int QPlatformOpenGLContext::bufferAge(QPlatformSurface *surface) const
+{
+    Q_UNUSED(surface);
+    return 0;
+}
+
 QOpenGLContext *QPlatformOpenGLContext::context() const
 {
     Q_D(const QPlatformOpenGLContext);
@@ -62,6 +62,7 @@ QT_BEGIN_NAMESPACE
 
 
 class QPlatformOpenGLContextPrivate;
+class QRegion;
 
 class Q_GUI_EXPORT QPlatformOpenGLContext
 {
@@ -75,6 +76,8 @@ public:
     virtual QSurfaceFormat format() const = 0;
 
     virtual void swapBuffers(QPlatformSurface *surface) = 0;
+    virtual void swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage);
+    virtual int bufferAge(QPlatformSurface *surface) const;
 
     virtual GLuint defaultFramebufferObject(QPlatformSurface *surface) const;
 
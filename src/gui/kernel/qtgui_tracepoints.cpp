@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/private/qtrace_p.h>
+
+#if QT_CONFIG(lttng)
+// Emits the probe callbacks and the tracepoint definitions for the
+// qtgui provider; this must happen in exactly one translation unit.
+#  define TRACEPOINT_CREATE_PROBES
+#  define TRACEPOINT_DEFINE
+#endif
+
+#include <QtGui/private/qtgui_tracepoints_p.h>
+
+#if QT_CONFIG(etw)
+// {c8f51c79-626c-55f1-a47e-cdbb40d3417f}
+TRACELOGGING_DEFINE_PROVIDER(qtgui_provider, "QtGui",
+    (0xc8f51c79, 0x626c, 0x55f1, 0xa4, 0x7e, 0xcd, 0xbb, 0x40, 0xd3, 0x41, 0x7f));
+
+static void qtgui_register_provider()
+{
+    TraceLoggingRegister(qtgui_provider);
+}
+Q_CONSTRUCTOR_FUNCTION(qtgui_register_provider)
+
+static void qtgui_unregister_provider()
+{
+    TraceLoggingUnregister(qtgui_provider);
+}
+Q_DESTRUCTOR_FUNCTION(qtgui_unregister_provider)
+#endif
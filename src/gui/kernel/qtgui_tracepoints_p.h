@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+// No include guard around the LTTNG part: lttng-ust reads this header
+// several times while generating the probes (TRACEPOINT_HEADER_MULTI_READ).
+
+#include <QtCore/private/qtrace_p.h>
+
+#if defined(Q_TRACING) && QT_CONFIG(lttng)
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER qtgui
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE <QtGui/private/qtgui_tracepoints_p.h>
+
+#if !defined(QTGUI_LTTNG_TRACEPOINTS_H) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define QTGUI_LTTNG_TRACEPOINTS_H
+
+#include <lttng/tracepoint.h>
+#include <stdint.h>
+
+#define Q_LTTNG_POINTER(name) ctf_integer_hex(uintptr_t, name, reinterpret_cast<uintptr_t>(name))
+
+TRACEPOINT_EVENT(qtgui, QImageReader_read_before_reading,
+    TP_ARGS(const void *, reader, const char *, format),
+    TP_FIELDS(Q_LTTNG_POINTER(reader) ctf_string(format, format)))
+TRACEPOINT_EVENT(qtgui, QImageReader_read_after_reading,
+    TP_ARGS(const void *, reader, int, result),
+    TP_FIELDS(Q_LTTNG_POINTER(reader) ctf_integer(int, result, result)))
+
+#endif // QTGUI_LTTNG_TRACEPOINTS_H
+
+#include <lttng/tracepoint-event.h>
+
+#endif // Q_TRACING && QT_CONFIG(lttng)
+
+#ifndef QTGUI_TRACEPOINTS_P_H
+#define QTGUI_TRACEPOINTS_P_H
+
+#if defined(Q_TRACING) && QT_CONFIG(etw)
+#include <qt_windows.h>
+#include <TraceLoggingProvider.h>
+
+TRACELOGGING_DECLARE_PROVIDER(qtgui_provider);
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QImageReader;
+
+namespace QtPrivate {
+
+Q_TRACEPOINT(qtgui, QImageReader_read_before_reading,
+    (QImageReader *reader, const char *format), (reader, format),
+    (TraceLoggingPointer(reader), TraceLoggingString(format)))
+Q_TRACEPOINT(qtgui, QImageReader_read_after_reading,
+    (QImageReader *reader, bool result), (reader, result),
+    (TraceLoggingPointer(reader), TraceLoggingBool(result)))
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QTGUI_TRACEPOINTS_P_H
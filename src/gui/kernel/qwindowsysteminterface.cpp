@@ -58,6 +58,8 @@ bool QWindowSystemInterfacePrivate::TabletEvent::platformSynthesizesMouse = true
 QWaitCondition QWindowSystemInterfacePrivate::eventsFlushed;
 QMutex QWindowSystemInterfacePrivate::flushEventMutex;
 QAtomicInt QWindowSystemInterfacePrivate::eventAccepted;
+QAtomicInt QWindowSystemInterfacePrivate::wakeUpPending;
+QWindowSystemInterfacePrivate::DeliveryLatency QWindowSystemInterfacePrivate::deliveryLatency;
 QWindowSystemEventHandler *QWindowSystemInterfacePrivate::eventHandler;
 QWindowSystemInterfacePrivate::WindowSystemEventList QWindowSystemInterfacePrivate::windowSystemEventQueue;
 
@@ -76,9 +78,15 @@ extern QPointer<QWindow> qt_last_mouse_receiver;
 template<>
 bool QWindowSystemInterfacePrivate::handleWindowSystemEvent<QWindowSystemInterface::AsynchronousDelivery>(WindowSystemEvent *ev)
 {
+    ev->queueTime = eventTime.nsecsElapsed();
     windowSystemEventQueue.append(ev);
-    if (QAbstractEventDispatcher *dispatcher = QGuiApplicationPrivate::qt_qpa_core_dispatcher())
-        dispatcher->wakeUp();
+    // Input devices read on another thread can queue events much faster than
+    // the Gui thread delivers them. One wakeup is enough until the Gui thread
+    // starts delivering, as sendWindowSystemEvents() then drains the queue.
+    if (QAbstractEventDispatcher *dispatcher = QGuiApplicationPrivate::qt_qpa_core_dispatcher()) {
+        if (wakeUpPending.testAndSetOrdered(0, 1))
+            dispatcher->wakeUp();
+    }
     return true;
 }
 
@@ -166,6 +174,24 @@ void QWindowSystemInterfacePrivate::removeWindowSystemEvent(WindowSystemEvent *e
     windowSystemEventQueue.remove(event);
 }
 
+void QWindowSystemInterfacePrivate::recordDeliveryLatency(const WindowSystemEvent *event)
+{
+    if (event->queueTime < 0 || !(event->type & UserInputEvent))
+        return;
+
+    const qint64 latency = qMax(Q_INT64_C(0), (eventTime.nsecsElapsed() - event->queueTime) / 1000);
+    const int bucket = qMin(int(DeliveryLatency::BucketCount) - 1,
+                            64 - int(qCountLeadingZeroBits(quint64(latency))));
+    ++deliveryLatency.counts[bucket];
+    ++deliveryLatency.eventCount;
+    deliveryLatency.maximum = qMax(deliveryLatency.maximum, latency);
+}
+
+void QWindowSystemInterfacePrivate::resetDeliveryLatency()
+{
+    deliveryLatency = DeliveryLatency();
+}
+
 void QWindowSystemInterfacePrivate::installWindowSystemEventHandler(QWindowSystemEventHandler *handler)
 {
     if (!eventHandler)
@@ -968,6 +994,10 @@ bool QWindowSystemInterface::sendWindowSystemEvents(QEventLoop::ProcessEventsFla
 {
     int nevents = 0;
 
+    // Events queued from now on need a new wakeup, those queued before are
+    // delivered by the loop below.
+    QWindowSystemInterfacePrivate::wakeUpPending.fetchAndStoreOrdered(0);
+
     while (QWindowSystemInterfacePrivate::windowSystemEventsQueued()) {
         QWindowSystemInterfacePrivate::WindowSystemEvent *event =
             (flags & QEventLoop::ExcludeUserInputEvents) ?
@@ -976,6 +1006,8 @@ bool QWindowSystemInterface::sendWindowSystemEvents(QEventLoop::ProcessEventsFla
         if (!event)
             break;
 
+        QWindowSystemInterfacePrivate::recordDeliveryLatency(event);
+
         if (QWindowSystemInterfacePrivate::eventHandler) {
             if (QWindowSystemInterfacePrivate::eventHandler->sendEvent(event))
                 nevents++;
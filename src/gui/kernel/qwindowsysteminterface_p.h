@@ -110,7 +110,7 @@ public:
         };
 
         explicit WindowSystemEvent(EventType t)
-            : type(t), flags(0), eventAccepted(true) { }
+            : type(t), flags(0), eventAccepted(true), queueTime(-1) { }
         virtual ~WindowSystemEvent() { }
 
         bool synthetic() const  { return flags & Synthetic; }
@@ -119,6 +119,7 @@ public:
         EventType type;
         int flags;
         bool eventAccepted;
+        qint64 queueTime; // eventTime.nsecsElapsed() when queued, -1 if never queued
     };
 
     class CloseEvent : public WindowSystemEvent {
@@ -521,6 +522,24 @@ public:
     static QMutex flushEventMutex;
     static QAtomicInt eventAccepted;
 
+    // Set when the event dispatcher has been woken up for queued events and
+    // has not started delivering them yet, so further events need no wakeup.
+    static QAtomicInt wakeUpPending;
+
+    // How long user input events wait in the queue before they are delivered.
+    struct DeliveryLatency {
+        enum { BucketCount = 16 };
+        // counts[0] holds events delivered in less than 1 microsecond, counts[i]
+        // those delivered in [2^(i-1), 2^i) microseconds. The last bucket also
+        // holds everything slower.
+        quint64 counts[BucketCount];
+        quint64 eventCount;
+        qint64 maximum; // microseconds
+    };
+    static DeliveryLatency deliveryLatency;
+    static void recordDeliveryLatency(const WindowSystemEvent *event);
+    static void resetDeliveryLatency();
+
     static QList<QTouchEvent::TouchPoint>
         fromNativeTouchPoints(const QList<QWindowSystemInterface::TouchPoint> &points,
                               const QWindow *window, quint8 deviceId, QEvent::Type *type = Q_NULLPTR);
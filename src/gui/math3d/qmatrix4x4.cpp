@@ -42,8 +42,11 @@
 #include <QtCore/qvariant.h>
 #include <QtGui/qmatrix.h>
 #include <QtGui/qtransform.h>
+#include <QtCore/private/qsimd_p.h>
 
+#include <algorithm>
 #include <cmath>
+#include <string.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -1771,6 +1774,67 @@ QTransform QMatrix4x4::toTransform(float distanceToPlane) const
     \sa map()
 */
 
+/*!
+    \since 5.11
+
+    Maps the \a count points in \a points by multiplying this matrix by
+    each of them, and writes the results to \a results.  This is
+    equivalent to calling map() on every point, but the special cases
+    recognized by optimize() are dispatched once for the whole array
+    instead of once per point.
+
+    \a points and \a results may be the same array; otherwise they
+    must not overlap.
+
+    \sa mapVector()
+*/
+void QMatrix4x4::map(const QVector3D *points, QVector3D *results, int count) const
+{
+    if (flagBits == Identity) {
+        if (points != results)
+            std::copy(points, points + count, results);
+    } else if (flagBits < Rotation2D) {
+        // Translation | Scale
+        for (int i = 0; i < count; ++i) {
+            const QVector3D &p = points[i];
+            results[i] = QVector3D(p.x() * m[0][0] + m[3][0],
+                                   p.y() * m[1][1] + m[3][1],
+                                   p.z() * m[2][2] + m[3][2]);
+        }
+    } else if (flagBits < Rotation) {
+        // Translation | Scale | Rotation2D
+        for (int i = 0; i < count; ++i) {
+            const QVector3D &p = points[i];
+            results[i] = QVector3D(p.x() * m[0][0] + p.y() * m[1][0] + m[3][0],
+                                   p.x() * m[0][1] + p.y() * m[1][1] + m[3][1],
+                                   p.z() * m[2][2] + m[3][2]);
+        }
+    } else {
+#ifdef __SSE2__
+        const __m128 c0 = _mm_loadu_ps(m[0]);
+        const __m128 c1 = _mm_loadu_ps(m[1]);
+        const __m128 c2 = _mm_loadu_ps(m[2]);
+        const __m128 c3 = _mm_loadu_ps(m[3]);
+        float r[4];
+        for (int i = 0; i < count; ++i) {
+            const QVector3D &p = points[i];
+            __m128 v = _mm_mul_ps(c0, _mm_set1_ps(p.x()));
+            v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_set1_ps(p.y())));
+            v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(p.z())));
+            v = _mm_add_ps(v, c3);
+            _mm_storeu_ps(r, v);
+            if (r[3] == 1.0f)
+                results[i] = QVector3D(r[0], r[1], r[2]);
+            else
+                results[i] = QVector3D(r[0] / r[3], r[1] / r[3], r[2] / r[3]);
+        }
+#else
+        for (int i = 0; i < count; ++i)
+            results[i] = *this * points[i];
+#endif
+    }
+}
+
 #endif
 
 #ifndef QT_NO_VECTOR4D
@@ -1930,6 +1994,41 @@ QMatrix4x4 QMatrix4x4::orthonormalInverse() const
     return result;
 }
 
+// Helper routine for multiplying two general matrices, both in
+// column-major order.  The result may alias m1, but not m2.
+void QMatrix4x4::multiplyGeneral(float *result, const float *m1, const float *m2)
+{
+#ifdef __SSE2__
+    // Each column of the result is a linear combination of the columns of m1.
+    // The terms are summed in the same order as the scalar code below, so
+    // both paths produce identical results.
+    const __m128 c0 = _mm_loadu_ps(m1);
+    const __m128 c1 = _mm_loadu_ps(m1 + 4);
+    const __m128 c2 = _mm_loadu_ps(m1 + 8);
+    const __m128 c3 = _mm_loadu_ps(m1 + 12);
+    for (int col = 0; col < 4; ++col) {
+        const float *b = m2 + col * 4;
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(b[0]));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(b[1])));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(b[2])));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(b[3])));
+        _mm_storeu_ps(result + col * 4, r);
+    }
+#else
+    float r[16];
+    for (int col = 0; col < 4; ++col) {
+        const float *b = m2 + col * 4;
+        for (int row = 0; row < 4; ++row) {
+            r[col * 4 + row] = m1[row] * b[0]
+                             + m1[4 + row] * b[1]
+                             + m1[8 + row] * b[2]
+                             + m1[12 + row] * b[3];
+        }
+    }
+    memcpy(result, r, sizeof(r));
+#endif
+}
+
 /*!
     Optimize the usage of this matrix from its current elements.
 
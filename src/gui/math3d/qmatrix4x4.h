@@ -165,6 +165,7 @@ public:
 #ifndef QT_NO_VECTOR3D
     QVector3D map(const QVector3D& point) const;
     QVector3D mapVector(const QVector3D& vector) const;
+    void map(const QVector3D *points, QVector3D *results, int count) const;
 #endif
 #ifndef QT_NO_VECTOR4D
     QVector4D map(const QVector4D& point) const;
@@ -207,6 +208,8 @@ private:
 
     QMatrix4x4 orthonormalInverse() const;
 
+    static void multiplyGeneral(float *result, const float *m1, const float *m2);
+
     void projectedRotate(float angle, float x, float y, float z);
 
     friend class QGraphicsRotation;
@@ -439,86 +442,7 @@ inline QMatrix4x4& QMatrix4x4::operator*=(const QMatrix4x4& o)
         return *this;
     }
 
-    float m0, m1, m2;
-    m0 = m[0][0] * other.m[0][0]
-            + m[1][0] * other.m[0][1]
-            + m[2][0] * other.m[0][2]
-            + m[3][0] * other.m[0][3];
-    m1 = m[0][0] * other.m[1][0]
-            + m[1][0] * other.m[1][1]
-            + m[2][0] * other.m[1][2]
-            + m[3][0] * other.m[1][3];
-    m2 = m[0][0] * other.m[2][0]
-            + m[1][0] * other.m[2][1]
-            + m[2][0] * other.m[2][2]
-            + m[3][0] * other.m[2][3];
-    m[3][0] = m[0][0] * other.m[3][0]
-            + m[1][0] * other.m[3][1]
-            + m[2][0] * other.m[3][2]
-            + m[3][0] * other.m[3][3];
-    m[0][0] = m0;
-    m[1][0] = m1;
-    m[2][0] = m2;
-
-    m0 = m[0][1] * other.m[0][0]
-            + m[1][1] * other.m[0][1]
-            + m[2][1] * other.m[0][2]
-            + m[3][1] * other.m[0][3];
-    m1 = m[0][1] * other.m[1][0]
-            + m[1][1] * other.m[1][1]
-            + m[2][1] * other.m[1][2]
-            + m[3][1] * other.m[1][3];
-    m2 = m[0][1] * other.m[2][0]
-            + m[1][1] * other.m[2][1]
-            + m[2][1] * other.m[2][2]
-            + m[3][1] * other.m[2][3];
-    m[3][1] = m[0][1] * other.m[3][0]
-            + m[1][1] * other.m[3][1]
-            + m[2][1] * other.m[3][2]
-            + m[3][1] * other.m[3][3];
-    m[0][1] = m0;
-    m[1][1] = m1;
-    m[2][1] = m2;
-
-    m0 = m[0][2] * other.m[0][0]
-            + m[1][2] * other.m[0][1]
-            + m[2][2] * other.m[0][2]
-            + m[3][2] * other.m[0][3];
-    m1 = m[0][2] * other.m[1][0]
-            + m[1][2] * other.m[1][1]
-            + m[2][2] * other.m[1][2]
-            + m[3][2] * other.m[1][3];
-    m2 = m[0][2] * other.m[2][0]
-            + m[1][2] * other.m[2][1]
-            + m[2][2] * other.m[2][2]
-            + m[3][2] * other.m[2][3];
-    m[3][2] = m[0][2] * other.m[3][0]
-            + m[1][2] * other.m[3][1]
-            + m[2][2] * other.m[3][2]
-            + m[3][2] * other.m[3][3];
-    m[0][2] = m0;
-    m[1][2] = m1;
-    m[2][2] = m2;
-
-    m0 = m[0][3] * other.m[0][0]
-            + m[1][3] * other.m[0][1]
-            + m[2][3] * other.m[0][2]
-            + m[3][3] * other.m[0][3];
-    m1 = m[0][3] * other.m[1][0]
-            + m[1][3] * other.m[1][1]
-            + m[2][3] * other.m[1][2]
-            + m[3][3] * other.m[1][3];
-    m2 = m[0][3] * other.m[2][0]
-            + m[1][3] * other.m[2][1]
-            + m[2][3] * other.m[2][2]
-            + m[3][3] * other.m[2][3];
-    m[3][3] = m[0][3] * other.m[3][0]
-            + m[1][3] * other.m[3][1]
-            + m[2][3] * other.m[3][2]
-            + m[3][3] * other.m[3][3];
-    m[0][3] = m0;
-    m[1][3] = m1;
-    m[2][3] = m2;
+    multiplyGeneral(*m, *m, *other.m);
     return *this;
 }
 
@@ -647,73 +571,7 @@ inline QMatrix4x4 operator*(const QMatrix4x4& m1, const QMatrix4x4& m2)
     }
 
     QMatrix4x4 m(1);
-    m.m[0][0] = m1.m[0][0] * m2.m[0][0]
-              + m1.m[1][0] * m2.m[0][1]
-              + m1.m[2][0] * m2.m[0][2]
-              + m1.m[3][0] * m2.m[0][3];
-    m.m[0][1] = m1.m[0][1] * m2.m[0][0]
-              + m1.m[1][1] * m2.m[0][1]
-              + m1.m[2][1] * m2.m[0][2]
-              + m1.m[3][1] * m2.m[0][3];
-    m.m[0][2] = m1.m[0][2] * m2.m[0][0]
-              + m1.m[1][2] * m2.m[0][1]
-              + m1.m[2][2] * m2.m[0][2]
-              + m1.m[3][2] * m2.m[0][3];
-    m.m[0][3] = m1.m[0][3] * m2.m[0][0]
-              + m1.m[1][3] * m2.m[0][1]
-              + m1.m[2][3] * m2.m[0][2]
-              + m1.m[3][3] * m2.m[0][3];
-
-    m.m[1][0] = m1.m[0][0] * m2.m[1][0]
-              + m1.m[1][0] * m2.m[1][1]
-              + m1.m[2][0] * m2.m[1][2]
-              + m1.m[3][0] * m2.m[1][3];
-    m.m[1][1] = m1.m[0][1] * m2.m[1][0]
-              + m1.m[1][1] * m2.m[1][1]
-              + m1.m[2][1] * m2.m[1][2]
-              + m1.m[3][1] * m2.m[1][3];
-    m.m[1][2] = m1.m[0][2] * m2.m[1][0]
-              + m1.m[1][2] * m2.m[1][1]
-              + m1.m[2][2] * m2.m[1][2]
-              + m1.m[3][2] * m2.m[1][3];
-    m.m[1][3] = m1.m[0][3] * m2.m[1][0]
-              + m1.m[1][3] * m2.m[1][1]
-              + m1.m[2][3] * m2.m[1][2]
-              + m1.m[3][3] * m2.m[1][3];
-
-    m.m[2][0] = m1.m[0][0] * m2.m[2][0]
-              + m1.m[1][0] * m2.m[2][1]
-              + m1.m[2][0] * m2.m[2][2]
-              + m1.m[3][0] * m2.m[2][3];
-    m.m[2][1] = m1.m[0][1] * m2.m[2][0]
-              + m1.m[1][1] * m2.m[2][1]
-              + m1.m[2][1] * m2.m[2][2]
-              + m1.m[3][1] * m2.m[2][3];
-    m.m[2][2] = m1.m[0][2] * m2.m[2][0]
-              + m1.m[1][2] * m2.m[2][1]
-              + m1.m[2][2] * m2.m[2][2]
-              + m1.m[3][2] * m2.m[2][3];
-    m.m[2][3] = m1.m[0][3] * m2.m[2][0]
-              + m1.m[1][3] * m2.m[2][1]
-              + m1.m[2][3] * m2.m[2][2]
-              + m1.m[3][3] * m2.m[2][3];
-
-    m.m[3][0] = m1.m[0][0] * m2.m[3][0]
-              + m1.m[1][0] * m2.m[3][1]
-              + m1.m[2][0] * m2.m[3][2]
-              + m1.m[3][0] * m2.m[3][3];
-    m.m[3][1] = m1.m[0][1] * m2.m[3][0]
-              + m1.m[1][1] * m2.m[3][1]
-              + m1.m[2][1] * m2.m[3][2]
-              + m1.m[3][1] * m2.m[3][3];
-    m.m[3][2] = m1.m[0][2] * m2.m[3][0]
-              + m1.m[1][2] * m2.m[3][1]
-              + m1.m[2][2] * m2.m[3][2]
-              + m1.m[3][2] * m2.m[3][3];
-    m.m[3][3] = m1.m[0][3] * m2.m[3][0]
-              + m1.m[1][3] * m2.m[3][1]
-              + m1.m[2][3] * m2.m[3][2]
-              + m1.m[3][3] * m2.m[3][3];
+    QMatrix4x4::multiplyGeneral(*m.m, *m1.m, *m2.m);
     m.flagBits = flagBits;
     return m;
 }
@@ -31,6 +31,7 @@ qtConfig(opengl) {
                opengl/qopengltextureblitter.h \
                opengl/qopengltexture.h \
                opengl/qopengltexture_p.h \
+               opengl/qopengltextureuploader.h \
                opengl/qopengltexturehelper_p.h \
                opengl/qopenglpixeltransferoptions.h \
                opengl/qopenglextrafunctions.h \
@@ -55,6 +56,7 @@ qtConfig(opengl) {
                opengl/qopengldebug.cpp \
                opengl/qopengltextureblitter.cpp \
                opengl/qopengltexture.cpp \
+               opengl/qopengltextureuploader.cpp \
                opengl/qopengltexturehelper.cpp \
                opengl/qopenglpixeltransferoptions.cpp \
                opengl/qopenglprogrambinarycache.cpp
@@ -894,14 +894,81 @@ bool QOpenGLEngineShaderManager::useCorrectShaderProg()
 
     // Make sure all the vertex attribute arrays the program uses are enabled (and the ones it
     // doesn't use are disabled)
+    // (there is no active engine when the programs are only precompiled)
     QOpenGLContextPrivate* ctx_d = ctx->d_func();
-    QOpenGL2PaintEngineEx *active_engine = static_cast<QOpenGL2PaintEngineEx *>(ctx_d->active_engine);
-    active_engine->d_func()->setVertexAttribArrayEnabled(QT_VERTEX_COORDS_ATTR, true);
-    active_engine->d_func()->setVertexAttribArrayEnabled(QT_TEXTURE_COORDS_ATTR, currentShaderProg && currentShaderProg->useTextureCoords);
-    active_engine->d_func()->setVertexAttribArrayEnabled(QT_OPACITY_ATTR, currentShaderProg && currentShaderProg->useOpacityAttribute);
+    if (QOpenGL2PaintEngineEx *active_engine = static_cast<QOpenGL2PaintEngineEx *>(ctx_d->active_engine)) {
+        active_engine->d_func()->setVertexAttribArrayEnabled(QT_VERTEX_COORDS_ATTR, true);
+        active_engine->d_func()->setVertexAttribArrayEnabled(QT_TEXTURE_COORDS_ATTR, currentShaderProg && currentShaderProg->useTextureCoords);
+        active_engine->d_func()->setVertexAttribArrayEnabled(QT_OPACITY_ATTR, currentShaderProg && currentShaderProg->useOpacityAttribute);
+    }
 
     shaderProgNeedsChanging = false;
     return true;
 }
 
+/*
+    Compiles and links the programs the paint engine needs for the common
+    combinations of source, opacity and mask, so that they end up in the
+    program binary cache. Composition modes that need a shader and custom
+    stages are left out. Returns \c false if any program failed to link.
+*/
+bool QOpenGLEngineShaderManager::precompilePrograms(QOpenGLContext *context)
+{
+    Q_ASSERT(context == QOpenGLContext::currentContext());
+    if (context->d_func()->active_engine) {
+        qWarning("QOpenGLEngineShaderManager::precompilePrograms: Cannot precompile while painting");
+        return false;
+    }
+
+    QOpenGLEngineShaderManager manager(context);
+    if (!manager.sharedShaders)
+        return false;
+
+    bool ok = manager.simpleProgram()->isLinked() && manager.blitProgram()->isLinked();
+
+    auto compile = [&manager, &ok](int srcPixelType, OpacityMode opacityMode, MaskType maskType, bool complexGeometry) {
+        if (srcPixelType <= Qt::TexturePattern)
+            manager.setSrcPixelType(Qt::BrushStyle(srcPixelType));
+        else
+            manager.setSrcPixelType(PixelSrcType(srcPixelType));
+        manager.setOpacityMode(opacityMode);
+        manager.setMaskType(maskType);
+        manager.setHasComplexGeometry(complexGeometry);
+        manager.setDirty();
+        manager.useCorrectShaderProg();
+        ok &= manager.currentShaderProg != 0;
+    };
+
+    static const int brushSources[] = {
+        Qt::SolidPattern, Qt::Dense4Pattern, Qt::LinearGradientPattern,
+        Qt::RadialGradientPattern, Qt::ConicalGradientPattern, Qt::TexturePattern
+    };
+    static const int imageSources[] = {
+        ImageSrc, NonPremultipliedImageSrc, PatternSrc, GrayscaleImageSrc, AlphaImageSrc
+    };
+
+    // Fills and strokes
+    for (int src : brushSources) {
+        for (OpacityMode opacityMode : { NoOpacity, UniformOpacity })
+            compile(src, opacityMode, NoMask, false);
+    }
+    compile(Qt::SolidPattern, NoOpacity, NoMask, true);
+
+    // Images and pixmaps, and pixmap fragments
+    for (int src : imageSources) {
+        for (OpacityMode opacityMode : { NoOpacity, UniformOpacity })
+            compile(src, opacityMode, NoMask, false);
+    }
+    compile(ImageSrc, AttributeOpacity, NoMask, false);
+
+    // Text drawn from glyph caches
+    for (MaskType maskType : { PixelMask, SubPixelMaskPass1, SubPixelMaskPass2, SubPixelWithGammaMask }) {
+        for (OpacityMode opacityMode : { NoOpacity, UniformOpacity })
+            compile(Qt::SolidPattern, opacityMode, maskType, true);
+    }
+
+    context->functions()->glUseProgram(0);
+    return ok;
+}
+
 QT_END_NAMESPACE
@@ -488,6 +488,8 @@ public:
     QOpenGLShaderProgram* simpleProgram(); // Used to draw into e.g. stencil buffers
     QOpenGLShaderProgram* blitProgram(); // Used to blit a texture into the framebuffer
 
+    static bool precompilePrograms(QOpenGLContext *context);
+
     QOpenGLEngineSharedShaders* sharedShaders;
 
 private:
@@ -46,11 +46,13 @@
 #include <private/qopenglcontext_p.h>
 #include <private/qopenglframebufferobject_p.h>
 #include <private/qopenglpaintengine_p.h>
+#include <private/qopenglengineshadermanager_p.h>
 
 // for qt_defaultDpiX/Y
 #include <private/qfont_p.h>
 
 #include <qopenglfunctions.h>
+#include <qopengltextureblitter.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -369,4 +371,40 @@ void QOpenGLPaintDevice::ensureActiveTarget()
 {
 }
 
+/*!
+    \since 5.11
+
+    Compiles the shader programs that QPainter uses most often with an
+    OpenGL paint device, and the program of QOpenGLTextureBlitter, for the
+    current context.
+
+    The paint engine otherwise compiles its programs when they are first
+    needed, which can noticeably delay the first frames, in particular on
+    embedded GPUs. When program binaries are supported, linked programs are
+    stored in the shader disk cache, so calling this function once, for
+    example at installation time or behind a splash screen, lets later runs
+    of the application load the binaries instead.
+
+    Must be called with a current context and while no QPainter is active on
+    it. Returns \c false if a program could not be compiled or linked.
+
+    \sa QOpenGLShaderProgram::addCacheableShaderFromSourceCode()
+*/
+bool QOpenGLPaintDevice::precompileShaders()
+{
+    QOpenGLContext *ctx = QOpenGLContext::currentContext();
+    if (!ctx) {
+        qWarning("QOpenGLPaintDevice::precompileShaders: No current context");
+        return false;
+    }
+
+    bool ok = QOpenGLEngineShaderManager::precompilePrograms(ctx);
+
+    QOpenGLTextureBlitter blitter;
+    ok &= blitter.create();
+    blitter.destroy();
+
+    return ok;
+}
+
 QT_END_NAMESPACE
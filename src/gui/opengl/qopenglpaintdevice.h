@@ -80,6 +80,8 @@ public:
 
     virtual void ensureActiveTarget();
 
+    static bool precompileShaders();
+
 protected:
     QOpenGLPaintDevice(QOpenGLPaintDevicePrivate &dd);
     int metric(QPaintDevice::PaintDeviceMetric metric) const override;
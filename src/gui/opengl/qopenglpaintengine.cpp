@@ -558,7 +558,8 @@ static inline void setCoords(GLfloat *coords, const QOpenGLRect &rect)
     coords[7] = rect.bottom;
 }
 
-void QOpenGL2PaintEngineExPrivate::drawTexture(const QOpenGLRect& dest, const QOpenGLRect& src, const QSize &textureSize, bool opaque, bool pattern)
+void QOpenGL2PaintEngineExPrivate::drawTexture(const QOpenGLRect& dest, const QOpenGLRect& src, const QSize &textureSize, bool opaque, bool pattern,
+                                               const QImage &batchImage)
 {
     // Setup for texture drawing
     currentBrush = noBrush;
@@ -576,6 +577,15 @@ void QOpenGL2PaintEngineExPrivate::drawTexture(const QOpenGLRect& dest, const QO
         shaderManager->currentProgram()->setUniformValue(location(QOpenGLEngineShaderManager::PatternColor), col);
     }
 
+    // The program and its uniforms are now set up for this texture. Rather
+    // than drawing right away, let following draws of the same image add to
+    // the vertex arrays; any other operation or state change flushes first.
+    if (!batchImage.isNull()) {
+        textureBatchImage = batchImage;
+        addToTextureBatch(dest, src);
+        return;
+    }
+
     GLfloat dx = 1.0 / textureSize.width();
     GLfloat dy = 1.0 / textureSize.height();
 
@@ -593,9 +603,51 @@ void QOpenGL2PaintEngineExPrivate::drawTexture(const QOpenGLRect& dest, const QO
     funcs.glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 
+void QOpenGL2PaintEngineExPrivate::addToTextureBatch(const QOpenGLRect &dest, const QOpenGLRect &src)
+{
+    GLfloat dx = 1.0 / textureBatchImage.width();
+    GLfloat dy = 1.0 / textureBatchImage.height();
+
+    QOpenGLRect srcTextureRect(src.left*dx, src.top*dy, src.right*dx, src.bottom*dy);
+
+    // Two triangles per rectangle, so that all of them go into one draw call
+    textureBatchVertexArray.addVertex(dest.left, dest.top);
+    textureBatchVertexArray.addVertex(dest.right, dest.top);
+    textureBatchVertexArray.addVertex(dest.right, dest.bottom);
+    textureBatchVertexArray.addVertex(dest.right, dest.bottom);
+    textureBatchVertexArray.addVertex(dest.left, dest.bottom);
+    textureBatchVertexArray.addVertex(dest.left, dest.top);
+
+    textureBatchTextureArray.addVertex(srcTextureRect.left, srcTextureRect.top);
+    textureBatchTextureArray.addVertex(srcTextureRect.right, srcTextureRect.top);
+    textureBatchTextureArray.addVertex(srcTextureRect.right, srcTextureRect.bottom);
+    textureBatchTextureArray.addVertex(srcTextureRect.right, srcTextureRect.bottom);
+    textureBatchTextureArray.addVertex(srcTextureRect.left, srcTextureRect.bottom);
+    textureBatchTextureArray.addVertex(srcTextureRect.left, srcTextureRect.top);
+}
+
+void QOpenGL2PaintEngineExPrivate::flushTextureBatch()
+{
+    if (textureBatchImage.isNull())
+        return;
+
+    setVertexAttribArrayEnabled(QT_VERTEX_COORDS_ATTR, true);
+    setVertexAttribArrayEnabled(QT_TEXTURE_COORDS_ATTR, true);
+
+    uploadData(QT_VERTEX_COORDS_ATTR, (GLfloat*)textureBatchVertexArray.data(), textureBatchVertexArray.vertexCount() * 2);
+    uploadData(QT_TEXTURE_COORDS_ATTR, (GLfloat*)textureBatchTextureArray.data(), textureBatchTextureArray.vertexCount() * 2);
+
+    funcs.glDrawArrays(GL_TRIANGLES, 0, textureBatchVertexArray.vertexCount());
+
+    textureBatchVertexArray.clear();
+    textureBatchTextureArray.clear();
+    textureBatchImage = QImage();
+}
+
 void QOpenGL2PaintEngineEx::beginNativePainting()
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     ensureActive();
     d->transferMode(BrushDrawingMode);
 
@@ -693,6 +745,7 @@ void QOpenGL2PaintEngineEx::endNativePainting()
 void QOpenGL2PaintEngineEx::invalidateState()
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     d->needsSync = true;
 }
 
@@ -1268,6 +1321,7 @@ QOpenGL2PaintEngineEx::~QOpenGL2PaintEngineEx()
 void QOpenGL2PaintEngineEx::fill(const QVectorPath &path, const QBrush &brush)
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     if (qbrush_style(brush) == Qt::NoBrush)
         return;
@@ -1282,6 +1336,7 @@ Q_GUI_EXPORT bool qt_scaleForTransform(const QTransform &transform, qreal *scale
 void QOpenGL2PaintEngineEx::stroke(const QVectorPath &path, const QPen &pen)
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     const QBrush &penBrush = qpen_brush(pen);
     if (qpen_style(pen) == Qt::NoPen || qbrush_style(penBrush) == Qt::NoBrush)
@@ -1381,6 +1436,7 @@ void QOpenGL2PaintEngineEx::opacityChanged()
 {
 //    qDebug("QOpenGL2PaintEngineEx::opacityChanged()");
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     state()->opacityChanged = true;
 
     Q_ASSERT(d->shaderManager);
@@ -1392,17 +1448,19 @@ void QOpenGL2PaintEngineEx::compositionModeChanged()
 {
 //     qDebug("QOpenGL2PaintEngineEx::compositionModeChanged()");
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     state()->compositionModeChanged = true;
     d->compositionModeDirty = true;
 }
 
 void QOpenGL2PaintEngineEx::renderHintsChanged()
 {
+    Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     state()->renderHintsChanged = true;
 
 #ifndef QT_OPENGL_ES_2
     if (!QOpenGLContext::currentContext()->isOpenGLES()) {
-        Q_D(QOpenGL2PaintEngineEx);
         if ((state()->renderHints & QPainter::Antialiasing)
             || (state()->renderHints & QPainter::HighQualityAntialiasing))
             d->funcs.glEnable(GL_MULTISAMPLE);
@@ -1411,8 +1469,6 @@ void QOpenGL2PaintEngineEx::renderHintsChanged()
     }
 #endif // QT_OPENGL_ES_2
 
-    Q_D(QOpenGL2PaintEngineEx);
-
     // This is a somewhat sneaky way of conceptually making the next call to
     // updateTexture() use FoceUpdate for the TextureUpdateMode. We need this
     // as new render hints may require updating the filter mode.
@@ -1425,6 +1481,7 @@ void QOpenGL2PaintEngineEx::renderHintsChanged()
 void QOpenGL2PaintEngineEx::transformChanged()
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     d->matrixDirty = true;
     state()->matrixChanged = true;
 }
@@ -1445,6 +1502,8 @@ void QOpenGL2PaintEngineEx::drawPixmap(const QRectF& dest, const QPixmap & pixma
     if (pixmap.paintEngine()->type() == QPaintEngine::Raster && !pixmap.isQBitmap())
         return drawImage(dest, pixmap.toImage(), src);
 
+    d->flushTextureBatch();
+
     int max_texture_size = ctx->d_func()->maxTextureSize();
     if (pixmap.width() > max_texture_size || pixmap.height() > max_texture_size) {
         QPixmap scaled = pixmap.scaled(max_texture_size, max_texture_size, Qt::KeepAspectRatio);
@@ -1489,6 +1548,17 @@ void QOpenGL2PaintEngineEx::drawImage(const QRectF& dest, const QImage& image, c
     }
 
     ensureActive();
+
+    if (!d->textureBatchImage.isNull()) {
+        // Nothing that affects drawing has changed since the batch was
+        // started, otherwise it would have been flushed already.
+        if (d->textureBatchImage.cacheKey() == image.cacheKey()) {
+            d->addToTextureBatch(dest, src);
+            return;
+        }
+        d->flushTextureBatch();
+    }
+
     d->transferMode(ImageDrawingMode);
 
     QOpenGLTextureCache::BindOptions bindOption = QOpenGLTextureCache::PremultipliedAlphaBindOption;
@@ -1522,12 +1592,13 @@ void QOpenGL2PaintEngineEx::drawImage(const QRectF& dest, const QImage& image, c
     GLenum filterMode = state()->renderHints & QPainter::SmoothPixmapTransform ? GL_LINEAR : GL_NEAREST;
     d->updateTexture(QT_IMAGE_TEXTURE_UNIT, imageWithOptions, GL_CLAMP_TO_EDGE, filterMode);
 
-    d->drawTexture(dest, src, image.size(), !image.hasAlphaChannel());
+    d->drawTexture(dest, src, image.size(), !image.hasAlphaChannel(), false, image);
 }
 
 void QOpenGL2PaintEngineEx::drawStaticTextItem(QStaticTextItem *textItem)
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     ensureActive();
 
@@ -1555,6 +1626,7 @@ void QOpenGL2PaintEngineEx::drawStaticTextItem(QStaticTextItem *textItem)
 bool QOpenGL2PaintEngineEx::drawTexture(const QRectF &dest, GLuint textureId, const QSize &size, const QRectF &src)
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     if (!d->shaderManager)
         return false;
 
@@ -1575,6 +1647,7 @@ bool QOpenGL2PaintEngineEx::drawTexture(const QRectF &dest, GLuint textureId, co
 void QOpenGL2PaintEngineEx::drawTextItem(const QPointF &p, const QTextItem &textItem)
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     ensureActive();
     QOpenGL2PaintEngineState *s = state();
@@ -1976,6 +2049,7 @@ void QOpenGL2PaintEngineEx::drawPixmapFragments(const QPainter::PixmapFragment *
                                             QPainter::PixmapFragmentHints hints)
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
     // Use fallback for extended composition modes.
     if (state()->composition_mode > QPainter::CompositionMode_Plus) {
         QPaintEngineEx::drawPixmapFragments(fragments, fragmentCount, pixmap, hints);
@@ -2186,6 +2260,7 @@ bool QOpenGL2PaintEngineEx::begin(QPaintDevice *pdev)
 bool QOpenGL2PaintEngineEx::end()
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     QOpenGLPaintDevicePrivate::get(d->device)->endPaint();
 
@@ -2224,6 +2299,10 @@ void QOpenGL2PaintEngineEx::ensureActive()
         d->vao.bind();
 
     if (isActive() && ctx->d_func()->active_engine != this) {
+        // Draw what the previously active engine has batched before its
+        // target and state are replaced.
+        if (ctx->d_func()->active_engine)
+            static_cast<QOpenGL2PaintEngineEx *>(ctx->d_func()->active_engine)->d_func()->flushTextureBatch();
         ctx->d_func()->active_engine = this;
         d->needsSync = true;
     }
@@ -2296,6 +2375,7 @@ void QOpenGL2PaintEngineExPrivate::setScissor(const QRect &rect)
 void QOpenGL2PaintEngineEx::clipEnabledChanged()
 {
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     state()->clipChanged = true;
 
@@ -2395,6 +2475,7 @@ void QOpenGL2PaintEngineEx::clip(const QVectorPath &path, Qt::ClipOperation op)
 {
 //     qDebug("QOpenGL2PaintEngineEx::clip()");
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     state()->clipChanged = true;
 
@@ -2463,6 +2544,8 @@ void QOpenGL2PaintEngineExPrivate::systemStateChanged()
 {
     Q_Q(QOpenGL2PaintEngineEx);
 
+    flushTextureBatch();
+
     q->state()->clipChanged = true;
 
     if (systemClip.isEmpty()) {
@@ -2513,6 +2596,7 @@ void QOpenGL2PaintEngineEx::setState(QPainterState *new_state)
     //     qDebug("QOpenGL2PaintEngineEx::setState()");
 
     Q_D(QOpenGL2PaintEngineEx);
+    d->flushTextureBatch();
 
     QOpenGL2PaintEngineState *s = static_cast<QOpenGL2PaintEngineState *>(new_state);
     QOpenGL2PaintEngineState *old_state = state();
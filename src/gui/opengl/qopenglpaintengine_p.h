@@ -223,7 +223,12 @@ public:
     // however writeClip can also be thought of as en entry point as it does similar things.
     void fill(const QVectorPath &path);
     void stroke(const QVectorPath &path, const QPen &pen);
-    void drawTexture(const QOpenGLRect& dest, const QOpenGLRect& src, const QSize &textureSize, bool opaque, bool pattern = false);
+    void drawTexture(const QOpenGLRect& dest, const QOpenGLRect& src, const QSize &textureSize, bool opaque, bool pattern = false,
+                     const QImage &batchImage = QImage());
+    // Consecutive drawImage() calls with the same image are collected into a
+    // single draw call, which is issued by flushTextureBatch().
+    void addToTextureBatch(const QOpenGLRect &dest, const QOpenGLRect &src);
+    void flushTextureBatch();
     void drawPixmapFragments(const QPainter::PixmapFragment *fragments, int fragmentCount, const QPixmap &pixmap,
                              QPainter::PixmapFragmentHints hints);
     void drawCachedGlyphs(QFontEngine::GlyphFormat glyphFormat, QStaticTextItem *staticTextItem);
@@ -313,6 +318,10 @@ public:
     GLfloat staticVertexCoordinateArray[8];
     GLfloat staticTextureCoordinateArray[8];
 
+    QImage textureBatchImage; // keeps the batched texture alive until it is drawn
+    QOpenGL2PEXVertexArray textureBatchVertexArray;
+    QOpenGL2PEXVertexArray textureBatchTextureArray;
+
     bool snapToPixelGrid;
     bool nativePaintingActive;
     GLfloat pmvMatrix[3][3];
@@ -0,0 +1,409 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopengltextureuploader.h"
+
+#include <QtGui/QImage>
+#include <QtGui/QOpenGLBuffer>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLExtraFunctions>
+#include <QtGui/QOpenGLPixelTransferOptions>
+#include <QtCore/QVector>
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
+#endif
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT        0x00000001
+#endif
+
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED                0x911B
+#endif
+
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED                    0x911D
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpenGLTextureUploader
+    \brief The QOpenGLTextureUploader class streams texture data to OpenGL through a ring of pixel buffer objects.
+    \since 5.11
+    \ingroup painting-3D
+    \inmodule QtGui
+
+    QOpenGLTexture::setData() copies the pixel data from client memory
+    while the call is made, which stalls the rendering thread for large
+    images and video frames. QOpenGLTextureUploader instead hands out
+    memory mapped from one of a small ring of pixel buffer objects. Once
+    the data has been written there, the texture is updated from the
+    buffer, and a fence makes sure that a buffer is only reused after the
+    GPU has finished reading it.
+
+    The memory returned by uploadData() is plain memory that can be filled
+    by any thread, without an OpenGL context. Only beginUpload() and
+    endUpload() have to be called with the uploader's context current:
+
+    \code
+    // On the rendering thread
+    const int upload = m_uploader.beginUpload(frame.sizeInBytes());
+    m_decoder->decodeInto(m_uploader.uploadData(upload));  // may run on a worker thread
+
+    // Later, on the rendering thread, once the decoder is done
+    m_uploader.endUpload(upload, m_texture, 0, QOpenGLTexture::RGBA, QOpenGLTexture::UInt8);
+    \endcode
+
+    Pixel buffer objects and fences require OpenGL 3.2 or OpenGL ES 3.0.
+    With older contexts, the uploader falls back to client memory and
+    usesPixelBuffers() returns \c false; the API behaves the same, but
+    endUpload() copies the data synchronously.
+ */
+
+class QOpenGLTextureUploaderPrivate
+{
+public:
+    struct UploadBuffer
+    {
+        UploadBuffer()
+            : buffer(QOpenGLBuffer::PixelUnpackBuffer),
+              capacity(0),
+              fence(0),
+              data(0)
+        {
+        }
+
+        QOpenGLBuffer buffer;
+        int capacity;
+        GLsync fence;
+        void *data;             // non-null while an upload is in progress
+        QByteArray clientData;  // used without pixel buffer objects
+    };
+
+    explicit QOpenGLTextureUploaderPrivate(int bufferCount)
+        : buffers(qMax(1, bufferCount)),
+          nextBuffer(0),
+          context(0),
+          usePixelBuffers(false)
+    {
+    }
+
+    void waitForFence(UploadBuffer &buffer);
+
+    QVector<UploadBuffer> buffers;
+    int nextBuffer;
+    QOpenGLContext *context;
+    bool usePixelBuffers;
+};
+
+void QOpenGLTextureUploaderPrivate::waitForFence(UploadBuffer &buffer)
+{
+    if (!buffer.fence)
+        return;
+
+    QOpenGLExtraFunctions *f = context->extraFunctions();
+    // glClientWaitSync() has no infinite timeout, so wait in steps of a second
+    for (;;) {
+        const GLenum status = f->glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        if (status != GL_TIMEOUT_EXPIRED)
+            break;
+    }
+    f->glDeleteSync(buffer.fence);
+    buffer.fence = 0;
+}
+
+/*!
+    Constructs a new uploader that cycles through \a bufferCount buffers.
+    Up to that many uploads can be in progress at the same time.
+
+    Call create() with a current context before using it.
+ */
+QOpenGLTextureUploader::QOpenGLTextureUploader(int bufferCount)
+    : d_ptr(new QOpenGLTextureUploaderPrivate(bufferCount))
+{
+}
+
+/*!
+    Destructs the instance.
+
+    \note The OpenGL context used by the uploader must be current, or the
+    buffers must have been released with destroy() before.
+ */
+QOpenGLTextureUploader::~QOpenGLTextureUploader()
+{
+    if (isCreated()) {
+        if (QOpenGLContext::currentContext() == d_ptr->context)
+            destroy();
+        else
+            qWarning("QOpenGLTextureUploader: Failed to release buffers, context is not current");
+    }
+}
+
+/*!
+    Initializes the uploader for the current context.
+
+    Returns \c true on success, \c false if there is no current context.
+ */
+bool QOpenGLTextureUploader::create()
+{
+    Q_D(QOpenGLTextureUploader);
+    QOpenGLContext *ctx = QOpenGLContext::currentContext();
+    if (!ctx)
+        return false;
+
+    if (d->context)
+        return d->context == ctx;
+
+    const QSurfaceFormat format = ctx->format();
+    if (ctx->isOpenGLES())
+        d->usePixelBuffers = format.majorVersion() >= 3;
+    else
+        d->usePixelBuffers = format.version() >= qMakePair(3, 2);
+
+    if (d->usePixelBuffers) {
+        for (QOpenGLTextureUploaderPrivate::UploadBuffer &buffer : d->buffers) {
+            if (!buffer.buffer.create()) {
+                d->usePixelBuffers = false;
+                break;
+            }
+            buffer.buffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+        }
+        if (!d->usePixelBuffers) {
+            for (QOpenGLTextureUploaderPrivate::UploadBuffer &buffer : d->buffers)
+                buffer.buffer.destroy();
+        }
+    }
+
+    d->context = ctx;
+    return true;
+}
+
+/*!
+    Returns \c true if create() was called and succeeded.
+ */
+bool QOpenGLTextureUploader::isCreated() const
+{
+    Q_D(const QOpenGLTextureUploader);
+    return d->context != 0;
+}
+
+/*!
+    Releases the buffers and fences, waiting for the GPU to finish
+    reading from them. Uploads that are still in progress are discarded.
+
+    The context used by create() must be current.
+ */
+void QOpenGLTextureUploader::destroy()
+{
+    Q_D(QOpenGLTextureUploader);
+    if (!d->context)
+        return;
+
+    for (QOpenGLTextureUploaderPrivate::UploadBuffer &buffer : d->buffers) {
+        if (d->usePixelBuffers) {
+            d->waitForFence(buffer);
+            if (buffer.data) {
+                buffer.buffer.bind();
+                buffer.buffer.unmap();
+                buffer.buffer.release();
+            }
+            buffer.buffer.destroy();
+        }
+        buffer.capacity = 0;
+        buffer.data = 0;
+        buffer.clientData.clear();
+    }
+
+    d->nextBuffer = 0;
+    d->context = 0;
+    d->usePixelBuffers = false;
+}
+
+/*!
+    Returns the number of buffers the uploader cycles through.
+ */
+int QOpenGLTextureUploader::bufferCount() const
+{
+    Q_D(const QOpenGLTextureUploader);
+    return d->buffers.size();
+}
+
+/*!
+    Returns \c true if uploads go through pixel buffer objects, \c false if
+    the context does not support them and client memory is used instead.
+ */
+bool QOpenGLTextureUploader::usesPixelBuffers() const
+{
+    Q_D(const QOpenGLTextureUploader);
+    return d->usePixelBuffers;
+}
+
+/*!
+    Starts an upload of \a size bytes and returns its handle, or -1 on
+    failure. Use uploadData() to get the memory to write the data to, and
+    endUpload() to transfer it to a texture.
+
+    If the next buffer of the ring is still being read by the GPU, this
+    waits for it to finish. Fails if all buffers have uploads in progress.
+
+    The context used by create() must be current.
+ */
+int QOpenGLTextureUploader::beginUpload(int size)
+{
+    Q_D(QOpenGLTextureUploader);
+    if (!d->context) {
+        qWarning("QOpenGLTextureUploader::beginUpload: Uploader not created");
+        return -1;
+    }
+    if (size <= 0)
+        return -1;
+
+    const int upload = d->nextBuffer;
+    QOpenGLTextureUploaderPrivate::UploadBuffer &buffer = d->buffers[upload];
+    if (buffer.data) {
+        qWarning("QOpenGLTextureUploader::beginUpload: All buffers are in use");
+        return -1;
+    }
+
+    if (d->usePixelBuffers) {
+        d->waitForFence(buffer);
+
+        buffer.buffer.bind();
+        if (size > buffer.capacity) {
+            buffer.buffer.allocate(size);
+            buffer.capacity = size;
+        }
+        buffer.data = buffer.buffer.mapRange(0, size, QOpenGLBuffer::RangeWrite
+                                                      | QOpenGLBuffer::RangeInvalidateBuffer);
+        buffer.buffer.release();
+        if (!buffer.data)
+            return -1;
+    } else {
+        buffer.clientData.resize(size);
+        buffer.data = buffer.clientData.data();
+    }
+
+    d->nextBuffer = (upload + 1) % d->buffers.size();
+    return upload;
+}
+
+/*!
+    Returns the memory to write the data of \a upload to, or \c nullptr if
+    \a upload is not in progress.
+
+    The memory can be written from any thread, as long as that is finished
+    before endUpload() is called.
+ */
+void *QOpenGLTextureUploader::uploadData(int upload) const
+{
+    Q_D(const QOpenGLTextureUploader);
+    if (upload < 0 || upload >= d->buffers.size())
+        return 0;
+    return d->buffers.at(upload).data;
+}
+
+/*!
+    Finishes \a upload by transferring its data to the mipmap level
+    \a mipLevel of \a texture, which must have storage allocated. The
+    data is interpreted according to \a sourceFormat, \a sourceType and
+    \a options, as with QOpenGLTexture::setData().
+
+    With pixel buffer objects, the transfer is queued and this returns
+    without waiting for it.
+
+    The context used by create() must be current.
+ */
+void QOpenGLTextureUploader::endUpload(int upload, QOpenGLTexture *texture, int mipLevel,
+                                       QOpenGLTexture::PixelFormat sourceFormat,
+                                       QOpenGLTexture::PixelType sourceType,
+                                       const QOpenGLPixelTransferOptions * const options)
+{
+    Q_D(QOpenGLTextureUploader);
+    if (upload < 0 || upload >= d->buffers.size() || !d->buffers.at(upload).data) {
+        qWarning("QOpenGLTextureUploader::endUpload: No upload %d in progress", upload);
+        return;
+    }
+
+    QOpenGLTextureUploaderPrivate::UploadBuffer &buffer = d->buffers[upload];
+    if (d->usePixelBuffers) {
+        buffer.buffer.bind();
+        buffer.buffer.unmap();
+        buffer.data = 0;
+        // With a pixel unpack buffer bound, the data pointer is an offset into it
+        if (texture)
+            texture->setData(mipLevel, sourceFormat, sourceType, static_cast<const void *>(0), options);
+        buffer.buffer.release();
+        buffer.fence = d->context->extraFunctions()->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    } else {
+        if (texture)
+            texture->setData(mipLevel, sourceFormat, sourceType, buffer.clientData.constData(), options);
+        buffer.data = 0;
+    }
+}
+
+/*!
+    Uploads \a image to the base mipmap level of \a texture, which must
+    have storage allocated for the size of the image.
+
+    The image is converted to QImage::Format_RGBA8888 if needed, as
+    QOpenGLTexture::setData() does. Returns \c true if the upload was
+    started.
+ */
+bool QOpenGLTextureUploader::setData(QOpenGLTexture *texture, const QImage &image)
+{
+    if (!texture || image.isNull())
+        return false;
+
+    const QImage rgba = image.convertToFormat(QImage::Format_RGBA8888);
+    const int size = rgba.bytesPerLine() * rgba.height();
+    const int upload = beginUpload(size);
+    if (upload < 0)
+        return false;
+
+    memcpy(uploadData(upload), rgba.constBits(), size);
+
+    QOpenGLPixelTransferOptions uploadOptions;
+    uploadOptions.setAlignment(1);
+    endUpload(upload, texture, 0, QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, &uploadOptions);
+    return true;
+}
+
+QT_END_NAMESPACE
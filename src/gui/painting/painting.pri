@@ -6,6 +6,7 @@ HEADERS += \
         painting/qblendfunctions_p.h \
         painting/qblittable_p.h \
         painting/qbrush.h \
+        painting/qcellrasterizer_p.h \
         painting/qcolor.h \
         painting/qcolor_p.h \
         painting/qcolorprofile_p.h \
@@ -63,6 +64,7 @@ SOURCES += \
         painting/qblendfunctions.cpp \
         painting/qblittable.cpp \
         painting/qbrush.cpp \
+        painting/qcellrasterizer.cpp \
         painting/qcolor.cpp \
         painting/qcolorprofile.cpp \
         painting/qcompositionfunctions.cpp \
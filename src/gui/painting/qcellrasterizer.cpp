@@ -0,0 +1,587 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qcellrasterizer_p.h"
+
+#include <QtCore/qalgorithms.h>
+#include <private/qsimd_p.h>
+
+#include <limits.h>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+// The fixed point format and the cell arithmetic are the ones of
+// qgrayraster.c, so that both produce the same spans.
+static const long OnePixel = 1L << 8;
+
+static inline long truncPos(long x) { return x >> 8; }
+static inline long subPixels(long x) { return x * OnePixel; }
+static inline long upscale(long x) { return x * (OnePixel >> 6); }
+
+// Number of cells accumulated at once; the outline is decomposed once per band.
+static const int CellBudget = 1 << 16;
+
+// Cells are swept in blocks, the cells of untouched blocks are known to be empty.
+static const int BlockShift = 4;
+static const int BlockSize = 1 << BlockShift;
+
+static inline int cellCoverage(int area, bool oddEven)
+{
+    int coverage = area >> 9;
+    if (coverage < 0)
+        coverage = -coverage;
+    if (oddEven) {
+        coverage &= 511;
+        if (coverage > 256)
+            coverage = 512 - coverage;
+        else if (coverage == 256)
+            coverage = 255;
+    } else if (coverage >= 256) {
+        coverage = 255;
+    }
+    return coverage;
+}
+
+QCellRasterizer::QCellRasterizer()
+    : m_stride(0),
+      m_blockWords(0),
+      m_callback(0),
+      m_userData(0),
+      m_spanCount(0)
+{
+}
+
+/*!
+    \internal
+
+    Rasterizes \a outline clipped to \a clipRect and passes the antialiased
+    spans to \a callback. Returns \c false without producing spans if the
+    outline contains curve segments.
+*/
+bool QCellRasterizer::rasterize(const QT_FT_Outline *outline, const QRect &clipRect,
+                                ProcessSpans callback, void *userData)
+{
+    if (outline->n_points <= 0 || outline->n_contours <= 0)
+        return true;
+    if (!outline->contours || !outline->points
+        || outline->n_points != outline->contours[outline->n_contours - 1] + 1)
+        return true;
+    if (clipRect.left() < 0 || clipRect.top() < 0
+        || clipRect.right() >= SHRT_MAX || clipRect.bottom() >= SHRT_MAX)
+        return false;
+    for (int i = 0; i < outline->n_points; ++i) {
+        if (QT_FT_CURVE_TAG(outline->tags[i]) != QT_FT_CURVE_TAG_ON)
+            return false;
+    }
+
+    const QT_FT_Vector *points = outline->points;
+    long minX = points[0].x, maxX = points[0].x;
+    long minY = points[0].y, maxY = points[0].y;
+    for (int i = 1; i < outline->n_points; ++i) {
+        minX = qMin<long>(minX, points[i].x);
+        maxX = qMax<long>(maxX, points[i].x);
+        minY = qMin<long>(minY, points[i].y);
+        maxY = qMax<long>(maxY, points[i].y);
+    }
+    m_minEx = minX >> 6;
+    m_minEy = minY >> 6;
+    m_maxEx = (maxX + 63) >> 6;
+    m_maxEy = (maxY + 63) >> 6;
+
+    const long clipRight = clipRect.x() + clipRect.width();
+    const long clipBottom = clipRect.y() + clipRect.height();
+    if (m_maxEx <= clipRect.x() || m_minEx >= clipRight
+        || m_maxEy <= clipRect.y() || m_minEy >= clipBottom)
+        return true;
+
+    m_minEx = qMax<long>(m_minEx, clipRect.x());
+    m_maxEx = qMin(m_maxEx, clipRight);
+    const long minEy = qMax<long>(m_minEy, clipRect.y());
+    const long maxEy = qMin(m_maxEy, clipBottom);
+    m_countEx = m_maxEx - m_minEx;
+
+    // one extra cell on the left collects the cover of everything left of the clip
+    m_stride = (int(m_countEx) + BlockSize) & ~(BlockSize - 1);
+    m_blockWords = (m_stride / BlockSize + 63) / 64;
+    const int bandRows = qBound(1, CellBudget / m_stride, int(maxEy - minEy));
+    if (m_covers.size() < bandRows * m_stride) {
+        m_covers.resize(bandRows * m_stride);
+        m_areas.resize(bandRows * m_stride);
+    }
+    if (m_blocks.size() < bandRows * m_blockWords)
+        m_blocks.resize(bandRows * m_blockWords);
+
+    m_oddEven = outline->flags & QT_FT_OUTLINE_EVEN_ODD_FILL;
+    m_callback = callback;
+    m_userData = userData;
+    m_spanCount = 0;
+
+    for (long bandMin = minEy; bandMin < maxEy; bandMin += bandRows) {
+        m_minEy = bandMin;
+        m_maxEy = qMin(bandMin + bandRows, maxEy);
+        m_countEy = m_maxEy - m_minEy;
+        m_invalid = true;
+
+        int first = 0;
+        for (int n = 0; n < outline->n_contours; ++n) {
+            const int last = outline->contours[n];
+            if (last < first)
+                break;
+            moveTo(points[first].x, points[first].y);
+            for (int i = first + 1; i <= last; ++i)
+                renderLine(upscale(points[i].x), upscale(points[i].y));
+            renderLine(upscale(points[first].x), upscale(points[first].y));
+            first = last + 1;
+        }
+        if (!m_invalid)
+            recordCell();
+
+        sweep();
+    }
+    flushSpans();
+    return true;
+}
+
+void QCellRasterizer::moveTo(long x, long y)
+{
+    if (!m_invalid)
+        recordCell();
+
+    x = upscale(x);
+    y = upscale(y);
+    startCell(truncPos(x), truncPos(y));
+    m_x = x;
+    m_y = y;
+}
+
+void QCellRasterizer::startCell(long ex, long ey)
+{
+    if (ex > m_maxEx)
+        ex = m_maxEx;
+    if (ex < m_minEx)
+        ex = m_minEx - 1;
+
+    m_area = 0;
+    m_cover = 0;
+    m_ex = ex - m_minEx;
+    m_ey = ey - m_minEy;
+    m_invalid = false;
+
+    setCell(ex, ey);
+}
+
+void QCellRasterizer::setCell(long ex, long ey)
+{
+    // Cells left of the clip all go to the extra cell at -1, cells right
+    // of it and outside the band are dropped.
+    ey -= m_minEy;
+
+    if (ex > m_maxEx)
+        ex = m_maxEx;
+    ex -= m_minEx;
+    if (ex < 0)
+        ex = -1;
+
+    if (ex != m_ex || ey != m_ey) {
+        if (!m_invalid)
+            recordCell();
+
+        m_area = 0;
+        m_cover = 0;
+        m_ex = ex;
+        m_ey = ey;
+    }
+
+    m_invalid = ((unsigned long)ey >= (unsigned long)m_countEy || ex >= m_countEx);
+}
+
+void QCellRasterizer::recordCell()
+{
+    if (m_area | m_cover) {
+        const int x = int(m_ex) + 1;
+        const int index = int(m_ey) * m_stride + x;
+        m_covers[index] += m_cover;
+        m_areas[index] += int(m_area);
+        const int block = x >> BlockShift;
+        m_blocks[int(m_ey) * m_blockWords + (block >> 6)] |= Q_UINT64_C(1) << (block & 63);
+    }
+}
+
+void QCellRasterizer::renderScanline(long ey, long x1, long y1, long x2, long y2)
+{
+    long ex1, ex2, fx1, fx2, delta, mod;
+    int p, first, dx;
+    int incr;
+
+    dx = x2 - x1;
+
+    ex1 = truncPos(x1);
+    ex2 = truncPos(x2);
+    fx1 = x1 - subPixels(ex1);
+    fx2 = x2 - subPixels(ex2);
+
+    if (y1 == y2) {
+        setCell(ex2, ey);
+        return;
+    }
+
+    // everything is located in a single cell
+    if (ex1 == ex2) {
+        delta = y2 - y1;
+        m_area += (fx1 + fx2) * delta;
+        m_cover += delta;
+        return;
+    }
+
+    // render a run of adjacent cells on the same scanline
+    p = (OnePixel - fx1) * (y2 - y1);
+    first = OnePixel;
+    incr = 1;
+
+    if (dx < 0) {
+        p = fx1 * (y2 - y1);
+        first = 0;
+        incr = -1;
+        dx = -dx;
+    }
+
+    delta = p / dx;
+    mod = p % dx;
+    if (mod < 0) {
+        delta--;
+        mod += dx;
+    }
+
+    m_area += (fx1 + first) * delta;
+    m_cover += delta;
+
+    ex1 += incr;
+    setCell(ex1, ey);
+    y1 += delta;
+
+    if (ex1 != ex2) {
+        long lift, rem;
+
+        p = OnePixel * (y2 - y1 + delta);
+        lift = p / dx;
+        rem = p % dx;
+        if (rem < 0) {
+            lift--;
+            rem += dx;
+        }
+
+        mod -= dx;
+
+        while (ex1 != ex2) {
+            delta = lift;
+            mod += rem;
+            if (mod >= 0) {
+                mod -= dx;
+                delta++;
+            }
+
+            m_area += OnePixel * delta;
+            m_cover += delta;
+            y1 += delta;
+            ex1 += incr;
+            setCell(ex1, ey);
+        }
+    }
+
+    delta = y2 - y1;
+    m_area += (fx2 + OnePixel - first) * delta;
+    m_cover += delta;
+}
+
+void QCellRasterizer::renderLine(long toX, long toY)
+{
+    long ey1, ey2, fy1, fy2, mod;
+    long dx, dy, x, x2;
+    int p, first;
+    int delta, rem, lift, incr;
+
+    const long fromX = m_x;
+    const long fromY = m_y;
+    m_x = toX;
+    m_y = toY;
+
+    ey1 = truncPos(fromY);
+    ey2 = truncPos(toY);
+    fy1 = fromY - subPixels(ey1);
+    fy2 = toY - subPixels(ey2);
+
+    dx = toX - fromX;
+    dy = toY - fromY;
+
+    // vertical clipping
+    if ((ey1 >= m_maxEy && ey2 >= m_maxEy) || (ey1 < m_minEy && ey2 < m_minEy))
+        return;
+
+    // everything is on a single scanline
+    if (ey1 == ey2) {
+        renderScanline(ey1, fromX, fy1, toX, fy2);
+        return;
+    }
+
+    // vertical line
+    if (dx == 0) {
+        const long ex = truncPos(fromX);
+        const long twoFx = (fromX - subPixels(ex)) << 1;
+
+        first = OnePixel;
+        if (dy < 0)
+            first = 0;
+
+        delta = first - fy1;
+        m_area += twoFx * delta;
+        m_cover += delta;
+
+        delta = first + first - OnePixel;
+        const long area = twoFx * delta;
+        const long maxEy1 = m_countEy + m_minEy;
+        if (dy < 0) {
+            if (ey1 > maxEy1) {
+                ey1 = (maxEy1 > ey2) ? maxEy1 : ey2;
+                setCell(ex, ey1);
+            } else {
+                ey1--;
+                setCell(ex, ey1);
+            }
+            while (ey1 > ey2 && ey1 >= m_minEy) {
+                m_area += area;
+                m_cover += delta;
+                ey1--;
+                setCell(ex, ey1);
+            }
+            if (ey1 != ey2) {
+                ey1 = ey2;
+                setCell(ex, ey1);
+            }
+        } else {
+            if (ey1 < m_minEy) {
+                ey1 = (m_minEy < ey2) ? m_minEy : ey2;
+                setCell(ex, ey1);
+            } else {
+                ey1++;
+                setCell(ex, ey1);
+            }
+            while (ey1 < ey2 && ey1 < maxEy1) {
+                m_area += area;
+                m_cover += delta;
+                ey1++;
+                setCell(ex, ey1);
+            }
+            if (ey1 != ey2) {
+                ey1 = ey2;
+                setCell(ex, ey1);
+            }
+        }
+
+        delta = fy2 - OnePixel + first;
+        m_area += twoFx * delta;
+        m_cover += delta;
+        return;
+    }
+
+    // render several scanlines
+    p = (OnePixel - fy1) * dx;
+    first = OnePixel;
+    incr = 1;
+
+    if (dy < 0) {
+        p = fy1 * dx;
+        first = 0;
+        incr = -1;
+        dy = -dy;
+    }
+
+    delta = p / dy;
+    mod = p % dy;
+    if (mod < 0) {
+        delta--;
+        mod += dy;
+    }
+
+    x = fromX + delta;
+    renderScanline(ey1, fromX, fy1, x, first);
+
+    ey1 += incr;
+    setCell(truncPos(x), ey1);
+
+    if (ey1 != ey2) {
+        p = OnePixel * dx;
+        lift = p / dy;
+        rem = p % dy;
+        if (rem < 0) {
+            lift--;
+            rem += dy;
+        }
+        mod -= dy;
+
+        while (ey1 != ey2) {
+            delta = lift;
+            mod += rem;
+            if (mod >= 0) {
+                mod -= dy;
+                delta++;
+            }
+
+            x2 = x + delta;
+            renderScanline(ey1, x, OnePixel - first, x2, first);
+            x = x2;
+
+            ey1 += incr;
+            setCell(truncPos(x), ey1);
+        }
+    }
+
+    renderScanline(ey1, x, OnePixel - first, toX, fy2);
+}
+
+void QCellRasterizer::sweep()
+{
+    for (int row = 0; row < m_countEy; ++row) {
+        int *covers = m_covers.data() + row * m_stride;
+        int *areas = m_areas.data() + row * m_stride;
+        quint64 *blocks = m_blocks.data() + row * m_blockWords;
+        const int y = row + int(m_minEy);
+        // cell i covers pixel i - 1, the cell left of the clip only contributes its cover
+        const int offset = int(m_minEx) - 1;
+        const int last = int(m_countEx);
+
+        int cover = 0;
+        int next = 0;
+        for (int word = 0; word < m_blockWords; ++word) {
+            while (blocks[word]) {
+                const int block = word * 64 + qCountTrailingZeroBits(blocks[word]);
+                blocks[word] &= blocks[word] - 1;
+
+                const int blockStart = block * BlockSize;
+                if (cover && blockStart > next) {
+                    const int value = cellCoverage(cover * 512, m_oddEven);
+                    if (value)
+                        addSpan(next + offset, y, blockStart - next, value);
+                }
+
+                int i = blockStart;
+                if (i == 0) {
+                    cover = covers[0];
+                    i = 1;
+                }
+                const int blockEnd = qMin(blockStart + BlockSize, last + 1);
+#ifdef __SSE2__
+                const __m128i v512 = _mm_set1_epi16(512);
+                const __m128i v511 = _mm_set1_epi32(511);
+                for (; i + 4 <= blockEnd; i += 4) {
+                    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(covers + i));
+                    c = _mm_add_epi32(c, _mm_slli_si128(c, 4));
+                    c = _mm_add_epi32(c, _mm_slli_si128(c, 8));
+                    c = _mm_add_epi32(c, _mm_set1_epi32(cover));
+                    cover = _mm_cvtsi128_si32(_mm_shuffle_epi32(c, _MM_SHUFFLE(3, 3, 3, 3)));
+
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(areas + i));
+                    __m128i v = _mm_srai_epi32(_mm_sub_epi32(_mm_slli_epi32(c, 9), a), 9);
+                    const __m128i sign = _mm_srai_epi32(v, 31);
+                    v = _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+                    if (m_oddEven) {
+                        v = _mm_packs_epi32(_mm_and_si128(v, v511), v);
+                        v = _mm_min_epi16(v, _mm_sub_epi16(v512, v));
+                    } else {
+                        v = _mm_packs_epi32(v, v);
+                    }
+                    const uint values = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+                    if (!values)
+                        continue;
+                    for (int j = 0; j < 4; ++j) {
+                        const int value = (values >> (j * 8)) & 0xff;
+                        if (value)
+                            addSpan(i + j + offset, y, 1, value);
+                    }
+                }
+#endif
+                for (; i < blockEnd; ++i) {
+                    cover += covers[i];
+                    const int value = cellCoverage(cover * 512 - areas[i], m_oddEven);
+                    if (value)
+                        addSpan(i + offset, y, 1, value);
+                }
+
+                memset(covers + blockStart, 0, BlockSize * sizeof(int));
+                memset(areas + blockStart, 0, BlockSize * sizeof(int));
+                next = blockEnd;
+            }
+        }
+
+        if (cover && next <= last) {
+            const int value = cellCoverage(cover * 512, m_oddEven);
+            if (value)
+                addSpan(next + offset, y, last + 1 - next, value);
+        }
+    }
+}
+
+void QCellRasterizer::addSpan(int x, int y, int len, int coverage)
+{
+    if (m_spanCount > 0) {
+        QT_FT_Span *span = m_spans + m_spanCount - 1;
+        if (span->y == y && span->x + span->len == x && span->coverage == coverage) {
+            span->len += len;
+            return;
+        }
+        if (m_spanCount == int(sizeof(m_spans) / sizeof(m_spans[0])))
+            flushSpans();
+    }
+
+    QT_FT_Span *span = m_spans + m_spanCount++;
+    span->x = short(x);
+    span->len = ushort(len);
+    span->y = short(y);
+    span->coverage = uchar(coverage);
+}
+
+void QCellRasterizer::flushSpans()
+{
+    if (m_spanCount) {
+        m_callback(m_spanCount, m_spans, m_userData);
+        m_spanCount = 0;
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCELLRASTERIZER_P_H
+#define QCELLRASTERIZER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtCore/qrect.h>
+#include <QtCore/qvector.h>
+
+#include <private/qdrawhelper_p.h>
+#include <private/qrasterdefs_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Antialiased scan converter for outlines made of straight lines.
+
+    It computes the same cell coverage as the gray raster, but accumulates
+    the cells of a band of scanlines in dense arrays instead of sorted cell
+    lists, and turns them into spans with a vectorized sweep. Outlines with
+    curve segments are left to the gray raster.
+*/
+class QCellRasterizer
+{
+public:
+    QCellRasterizer();
+
+    bool rasterize(const QT_FT_Outline *outline, const QRect &clipRect,
+                   ProcessSpans callback, void *userData);
+
+private:
+    void moveTo(long x, long y);
+    void renderLine(long toX, long toY);
+    void renderScanline(long ey, long x1, long y1, long x2, long y2);
+    void startCell(long ex, long ey);
+    void setCell(long ex, long ey);
+    void recordCell();
+    void sweep();
+    void addSpan(int x, int y, int len, int coverage);
+    void flushSpans();
+
+    long m_ex, m_ey;
+    long m_minEx, m_maxEx;
+    long m_minEy, m_maxEy;
+    long m_countEx, m_countEy;
+    long m_area;
+    int m_cover;
+    bool m_invalid;
+    long m_x, m_y;
+    bool m_oddEven;
+
+    int m_stride;
+    int m_blockWords;
+    QVector<int> m_covers;
+    QVector<int> m_areas;
+    QVector<quint64> m_blocks;
+
+    ProcessSpans m_callback;
+    void *m_userData;
+    int m_spanCount;
+    QT_FT_Span m_spans[256];
+};
+
+QT_END_NAMESPACE
+
+#endif // QCELLRASTERIZER_P_H
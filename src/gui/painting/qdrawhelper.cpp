@@ -54,6 +54,7 @@
 #include <private/qdrawhelper_mips_dsp_p.h>
 #endif
 #include <private/qguiapplication_p.h>
+#include <private/qimage_p.h>
 #include <private/qrgba64_p.h>
 #include <qloggingcategory.h>
 #include <qmath.h>
@@ -708,13 +709,50 @@ static const uint *QT_FASTCALL convertRGBXFromARGB32PM(uint *buffer, const uint
     return buffer;
 }
 
+#ifdef __SSE2__
+template<QtPixelOrder PixelOrder>
+static inline void qConvertA2RGB30PMToARGB32PM_sse2(uint *buffer, const uint *src, int count)
+{
+    const __m128i rmask = _mm_set1_epi32(0x3fc00000);
+    const __m128i gmask = _mm_set1_epi32(0x000ff000);
+    const __m128i bmask = _mm_set1_epi32(0x000003fc);
+    const __m128i amask = _mm_set1_epi32(0xc0000000);
+    int i = 0;
+
+    for (; i < count - 3; i += 4) {
+        const __m128i vs = _mm_loadu_si128((const __m128i *)(src + i));
+        // Keep the top eight bits of each 10-bit color, and spread the
+        // two alpha bits over the eight bits of the ARGB32 alpha.
+        __m128i va = _mm_and_si128(vs, amask);
+        va = _mm_or_si128(va, _mm_srli_epi32(va, 2));
+        va = _mm_or_si128(va, _mm_srli_epi32(va, 4));
+        const __m128i vr = _mm_and_si128(vs, rmask);
+        const __m128i vg = _mm_srli_epi32(_mm_and_si128(vs, gmask), 4);
+        const __m128i vb = _mm_and_si128(vs, bmask);
+        __m128i vrb;
+        if (PixelOrder == PixelOrderRGB)
+            vrb = _mm_or_si128(_mm_srli_epi32(vr, 6), _mm_srli_epi32(vb, 2));
+        else
+            vrb = _mm_or_si128(_mm_srli_epi32(vr, 22), _mm_slli_epi32(vb, 14));
+        _mm_storeu_si128((__m128i *)(buffer + i), _mm_or_si128(_mm_or_si128(va, vg), vrb));
+    }
+
+    SIMD_EPILOGUE(i, count, 3)
+        buffer[i] = qConvertA2rgb30ToArgb32<PixelOrder>(src[i]);
+}
+#endif
+
 template<QtPixelOrder PixelOrder>
 static const uint *QT_FASTCALL convertA2RGB30PMToARGB32PM(uint *buffer, const uint *src, int count,
                                                           const QVector<QRgb> *, QDitherInfo *dither)
 {
     if (!dither) {
+#ifdef __SSE2__
+        qConvertA2RGB30PMToARGB32PM_sse2<PixelOrder>(buffer, src, count);
+#else
         for (int i = 0; i < count; ++i)
             buffer[i] = qConvertA2rgb30ToArgb32<PixelOrder>(src[i]);
+#endif
     } else {
         for (int i = 0; i < count; ++i) {
             const uint c = src[i];
@@ -3725,30 +3763,54 @@ static inline Operator getOperator(const QSpanData *data, const QSpan *spans, in
 
 // -------------------- blend methods ---------------------
 
+// Spans of one fill never overlap, so the spans of large fills are
+// blended in bands on the threads of the global thread pool.
+enum { SpanSegmentPixels = 1 << 14 };
+
+template <typename Functor>
+static inline void qt_parallelSpans(int count, const QSpan *spans, Functor function)
+{
+    int segments = 1;
+#ifndef QT_NO_THREAD
+    if (count > 1) {
+        qint64 pixels = 0;
+        for (int i = 0; i < count; ++i)
+            pixels += spans[i].len;
+        segments = int(qMin<qint64>(pixels / SpanSegmentPixels, count));
+    }
+#else
+    Q_UNUSED(spans);
+#endif
+    qt_imageRunSegments(segments, count, function);
+}
+
 #if !defined(Q_CC_SUN)
 static
 #endif
 void blend_color_generic(int count, const QSpan *spans, void *userData)
 {
     QSpanData *data = reinterpret_cast<QSpanData *>(userData);
-    uint buffer[buffer_size];
     Operator op = getOperator(data, spans, count);
     const uint color = data->solid.color.toArgb32();
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        while (length) {
-            int l = qMin(buffer_size, length);
-            uint *dest = op.destFetch ? op.destFetch(buffer, data->rasterBuffer, x, spans->y, l) : buffer;
-            op.funcSolid(dest, l, color, spans->coverage);
-            if (op.destStore)
-                op.destStore(data->rasterBuffer, x, spans->y, dest, l);
-            length -= l;
-            x += l;
+    auto function = [=, &op] (int cStart, int cEnd) {
+        uint buffer[buffer_size];
+
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            while (length) {
+                int l = qMin(buffer_size, length);
+                uint *dest = op.destFetch ? op.destFetch(buffer, data->rasterBuffer, x, spans[c].y, l) : buffer;
+                op.funcSolid(dest, l, color, spans[c].coverage);
+                if (op.destStore)
+                    op.destStore(data->rasterBuffer, x, spans[c].y, dest, l);
+                length -= l;
+                x += l;
+            }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_color_argb(int count, const QSpan *spans, void *userData)
@@ -3760,26 +3822,30 @@ static void blend_color_argb(int count, const QSpan *spans, void *userData)
 
     if (op.mode == QPainter::CompositionMode_Source) {
         // inline for performance
-        while (count--) {
-            uint *target = ((uint *)data->rasterBuffer->scanLine(spans->y)) + spans->x;
-            if (spans->coverage == 255) {
-                QT_MEMFILL_UINT(target, spans->len, color);
-            } else {
-                uint c = BYTE_MUL(color, spans->coverage);
-                int ialpha = 255 - spans->coverage;
-                for (int i = 0; i < spans->len; ++i)
-                    target[i] = c + BYTE_MUL(target[i], ialpha);
+        auto function = [=] (int cStart, int cEnd) {
+            for (int c = cStart; c < cEnd; ++c) {
+                uint *target = ((uint *)data->rasterBuffer->scanLine(spans[c].y)) + spans[c].x;
+                if (spans[c].coverage == 255) {
+                    QT_MEMFILL_UINT(target, spans[c].len, color);
+                } else {
+                    uint s = BYTE_MUL(color, spans[c].coverage);
+                    int ialpha = 255 - spans[c].coverage;
+                    for (int i = 0; i < spans[c].len; ++i)
+                        target[i] = s + BYTE_MUL(target[i], ialpha);
+                }
             }
-            ++spans;
-        }
+        };
+        qt_parallelSpans(count, spans, function);
         return;
     }
 
-    while (count--) {
-        uint *target = ((uint *)data->rasterBuffer->scanLine(spans->y)) + spans->x;
-        op.funcSolid(target, spans->len, color, spans->coverage);
-        ++spans;
-    }
+    auto function = [=, &op] (int cStart, int cEnd) {
+        for (int c = cStart; c < cEnd; ++c) {
+            uint *target = ((uint *)data->rasterBuffer->scanLine(spans[c].y)) + spans[c].x;
+            op.funcSolid(target, spans[c].len, color, spans[c].coverage);
+        }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 void blend_color_generic_rgb64(int count, const QSpan *spans, void *userData)
@@ -3791,22 +3857,25 @@ void blend_color_generic_rgb64(int count, const QSpan *spans, void *userData)
         return blend_color_generic(count, spans, userData);
     }
 
-    quint64 buffer[buffer_size];
     const QRgba64 color = data->solid.color;
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        while (length) {
-            int l = qMin(buffer_size, length);
-            QRgba64 *dest = op.destFetch64((QRgba64 *)buffer, data->rasterBuffer, x, spans->y, l);
-            op.funcSolid64(dest, l, color, spans->coverage);
-            op.destStore64(data->rasterBuffer, x, spans->y, dest, l);
-            length -= l;
-            x += l;
+    auto function = [=, &op] (int cStart, int cEnd) {
+        quint64 buffer[buffer_size];
+
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            while (length) {
+                int l = qMin(buffer_size, length);
+                QRgba64 *dest = op.destFetch64((QRgba64 *)buffer, data->rasterBuffer, x, spans[c].y, l);
+                op.funcSolid64(dest, l, color, spans[c].coverage);
+                op.destStore64(data->rasterBuffer, x, spans[c].y, dest, l);
+                length -= l;
+                x += l;
+            }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_color_rgb16(int count, const QSpan *spans, void *userData)
@@ -3988,11 +4057,6 @@ public:
     {
     }
 
-    bool isSupported() const
-    {
-        return op.func64 && op.destFetch64 && op.destStore64;
-    }
-
     const quint64 *fetch(int x, int y, int len)
     {
         dest = (quint64 *)op.destFetch64((QRgba64 *)buffer, data->rasterBuffer, x, y, len);
@@ -4013,21 +4077,31 @@ public:
 static void blend_src_generic(int count, const QSpan *spans, void *userData)
 {
     QSpanData *data = reinterpret_cast<QSpanData *>(userData);
-    BlendSrcGeneric blend(data, getOperator(data, spans, count));
-    handleSpans(count, spans, data, blend);
+    const Operator op = getOperator(data, spans, count);
+    auto function = [=, &op] (int cStart, int cEnd) {
+        BlendSrcGeneric blend(data, op);
+        handleSpans(cEnd - cStart, spans + cStart, data, blend);
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_src_generic_rgb64(int count, const QSpan *spans, void *userData)
 {
     QSpanData *data = reinterpret_cast<QSpanData *>(userData);
-    Operator op = getOperator(data, spans, count);
-    BlendSrcGenericRGB64 blend64(data, op);
-    if (blend64.isSupported())
-        handleSpans(count, spans, data, blend64);
-    else {
+    const Operator op = getOperator(data, spans, count);
+    if (op.func64 && op.destFetch64 && op.destStore64) {
+        auto function = [=, &op] (int cStart, int cEnd) {
+            BlendSrcGenericRGB64 blend64(data, op);
+            handleSpans(cEnd - cStart, spans + cStart, data, blend64);
+        };
+        qt_parallelSpans(count, spans, function);
+    } else {
         qCDebug(lcQtGuiDrawHelper, "blend_src_generic_rgb64: unsupported 64-bit blend attempted, falling back to 32-bit");
-        BlendSrcGeneric blend32(data, op);
-        handleSpans(count, spans, data, blend32);
+        auto function = [=, &op] (int cStart, int cEnd) {
+            BlendSrcGeneric blend32(data, op);
+            handleSpans(cEnd - cStart, spans + cStart, data, blend32);
+        };
+        qt_parallelSpans(count, spans, function);
     }
 }
 
@@ -4035,8 +4109,6 @@ static void blend_untransformed_generic(int count, const QSpan *spans, void *use
 {
     QSpanData *data = reinterpret_cast<QSpanData *>(userData);
 
-    uint buffer[buffer_size];
-    uint src_buffer[buffer_size];
     Operator op = getOperator(data, spans, count);
 
     const int image_width = data->texture.width;
@@ -4044,36 +4116,41 @@ static void blend_untransformed_generic(int count, const QSpan *spans, void *use
     int xoff = -qRound(-data->dx);
     int yoff = -qRound(-data->dy);
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        int sx = xoff + x;
-        int sy = yoff + spans->y;
-        if (sy >= 0 && sy < image_height && sx < image_width) {
-            if (sx < 0) {
-                x -= sx;
-                length += sx;
-                sx = 0;
-            }
-            if (sx + length > image_width)
-                length = image_width - sx;
-            if (length > 0) {
-                const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-                while (length) {
-                    int l = qMin(buffer_size, length);
-                    const uint *src = op.srcFetch(src_buffer, &op, data, sy, sx, l);
-                    uint *dest = op.destFetch ? op.destFetch(buffer, data->rasterBuffer, x, spans->y, l) : buffer;
-                    op.func(dest, src, l, coverage);
-                    if (op.destStore)
-                        op.destStore(data->rasterBuffer, x, spans->y, dest, l);
-                    x += l;
-                    sx += l;
-                    length -= l;
+    auto function = [=, &op] (int cStart, int cEnd) {
+        uint buffer[buffer_size];
+        uint src_buffer[buffer_size];
+
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            int sx = xoff + x;
+            int sy = yoff + spans[c].y;
+            if (sy >= 0 && sy < image_height && sx < image_width) {
+                if (sx < 0) {
+                    x -= sx;
+                    length += sx;
+                    sx = 0;
+                }
+                if (sx + length > image_width)
+                    length = image_width - sx;
+                if (length > 0) {
+                    const int coverage = (spans[c].coverage * data->texture.const_alpha) >> 8;
+                    while (length) {
+                        int l = qMin(buffer_size, length);
+                        const uint *src = op.srcFetch(src_buffer, &op, data, sy, sx, l);
+                        uint *dest = op.destFetch ? op.destFetch(buffer, data->rasterBuffer, x, spans[c].y, l) : buffer;
+                        op.func(dest, src, l, coverage);
+                        if (op.destStore)
+                            op.destStore(data->rasterBuffer, x, spans[c].y, dest, l);
+                        x += l;
+                        sx += l;
+                        length -= l;
+                    }
                 }
             }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_untransformed_generic_rgb64(int count, const QSpan *spans, void *userData)
@@ -4085,43 +4162,46 @@ static void blend_untransformed_generic_rgb64(int count, const QSpan *spans, voi
         qCDebug(lcQtGuiDrawHelper, "blend_untransformed_generic_rgb64: unsupported 64-bit blend attempted, falling back to 32-bit");
         return blend_untransformed_generic(count, spans, userData);
     }
-    quint64 buffer[buffer_size];
-    quint64 src_buffer[buffer_size];
 
     const int image_width = data->texture.width;
     const int image_height = data->texture.height;
     int xoff = -qRound(-data->dx);
     int yoff = -qRound(-data->dy);
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        int sx = xoff + x;
-        int sy = yoff + spans->y;
-        if (sy >= 0 && sy < image_height && sx < image_width) {
-            if (sx < 0) {
-                x -= sx;
-                length += sx;
-                sx = 0;
-            }
-            if (sx + length > image_width)
-                length = image_width - sx;
-            if (length > 0) {
-                const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-                while (length) {
-                    int l = qMin(buffer_size, length);
-                    const QRgba64 *src = op.srcFetch64((QRgba64 *)src_buffer, &op, data, sy, sx, l);
-                    QRgba64 *dest = op.destFetch64((QRgba64 *)buffer, data->rasterBuffer, x, spans->y, l);
-                    op.func64(dest, src, l, coverage);
-                    op.destStore64(data->rasterBuffer, x, spans->y, dest, l);
-                    x += l;
-                    sx += l;
-                    length -= l;
+    auto function = [=, &op] (int cStart, int cEnd) {
+        quint64 buffer[buffer_size];
+        quint64 src_buffer[buffer_size];
+
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            int sx = xoff + x;
+            int sy = yoff + spans[c].y;
+            if (sy >= 0 && sy < image_height && sx < image_width) {
+                if (sx < 0) {
+                    x -= sx;
+                    length += sx;
+                    sx = 0;
+                }
+                if (sx + length > image_width)
+                    length = image_width - sx;
+                if (length > 0) {
+                    const int coverage = (spans[c].coverage * data->texture.const_alpha) >> 8;
+                    while (length) {
+                        int l = qMin(buffer_size, length);
+                        const QRgba64 *src = op.srcFetch64((QRgba64 *)src_buffer, &op, data, sy, sx, l);
+                        QRgba64 *dest = op.destFetch64((QRgba64 *)buffer, data->rasterBuffer, x, spans[c].y, l);
+                        op.func64(dest, src, l, coverage);
+                        op.destStore64(data->rasterBuffer, x, spans[c].y, dest, l);
+                        x += l;
+                        sx += l;
+                        length -= l;
+                    }
                 }
             }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_untransformed_argb(int count, const QSpan *spans, void *userData)
@@ -4140,28 +4220,30 @@ static void blend_untransformed_argb(int count, const QSpan *spans, void *userDa
     int xoff = -qRound(-data->dx);
     int yoff = -qRound(-data->dy);
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        int sx = xoff + x;
-        int sy = yoff + spans->y;
-        if (sy >= 0 && sy < image_height && sx < image_width) {
-            if (sx < 0) {
-                x -= sx;
-                length += sx;
-                sx = 0;
-            }
-            if (sx + length > image_width)
-                length = image_width - sx;
-            if (length > 0) {
-                const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-                const uint *src = (const uint *)data->texture.scanLine(sy) + sx;
-                uint *dest = ((uint *)data->rasterBuffer->scanLine(spans->y)) + x;
-                op.func(dest, src, length, coverage);
+    auto function = [=, &op] (int cStart, int cEnd) {
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            int sx = xoff + x;
+            int sy = yoff + spans[c].y;
+            if (sy >= 0 && sy < image_height && sx < image_width) {
+                if (sx < 0) {
+                    x -= sx;
+                    length += sx;
+                    sx = 0;
+                }
+                if (sx + length > image_width)
+                    length = image_width - sx;
+                if (length > 0) {
+                    const int coverage = (spans[c].coverage * data->texture.const_alpha) >> 8;
+                    const uint *src = (const uint *)data->texture.scanLine(sy) + sx;
+                    uint *dest = ((uint *)data->rasterBuffer->scanLine(spans[c].y)) + x;
+                    op.func(dest, src, length, coverage);
+                }
             }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static inline quint16 interpolate_pixel_rgb16_255(quint16 x, quint8 a,
@@ -4273,8 +4355,6 @@ static void blend_tiled_generic(int count, const QSpan *spans, void *userData)
 {
     QSpanData *data = reinterpret_cast<QSpanData *>(userData);
 
-    uint buffer[buffer_size];
-    uint src_buffer[buffer_size];
     Operator op = getOperator(data, spans, count);
 
     const int image_width = data->texture.width;
@@ -4287,34 +4367,39 @@ static void blend_tiled_generic(int count, const QSpan *spans, void *userData)
     if (yoff < 0)
         yoff += image_height;
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        int sx = (xoff + spans->x) % image_width;
-        int sy = (spans->y + yoff) % image_height;
-        if (sx < 0)
-            sx += image_width;
-        if (sy < 0)
-            sy += image_height;
-
-        const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-        while (length) {
-            int l = qMin(image_width - sx, length);
-            if (buffer_size < l)
-                l = buffer_size;
-            const uint *src = op.srcFetch(src_buffer, &op, data, sy, sx, l);
-            uint *dest = op.destFetch ? op.destFetch(buffer, data->rasterBuffer, x, spans->y, l) : buffer;
-            op.func(dest, src, l, coverage);
-            if (op.destStore)
-                op.destStore(data->rasterBuffer, x, spans->y, dest, l);
-            x += l;
-            sx += l;
-            length -= l;
-            if (sx >= image_width)
-                sx = 0;
+    auto function = [=, &op] (int cStart, int cEnd) {
+        uint buffer[buffer_size];
+        uint src_buffer[buffer_size];
+
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            int sx = (xoff + spans[c].x) % image_width;
+            int sy = (spans[c].y + yoff) % image_height;
+            if (sx < 0)
+                sx += image_width;
+            if (sy < 0)
+                sy += image_height;
+
+            const int coverage = (spans[c].coverage * data->texture.const_alpha) >> 8;
+            while (length) {
+                int l = qMin(image_width - sx, length);
+                if (buffer_size < l)
+                    l = buffer_size;
+                const uint *src = op.srcFetch(src_buffer, &op, data, sy, sx, l);
+                uint *dest = op.destFetch ? op.destFetch(buffer, data->rasterBuffer, x, spans[c].y, l) : buffer;
+                op.func(dest, src, l, coverage);
+                if (op.destStore)
+                    op.destStore(data->rasterBuffer, x, spans[c].y, dest, l);
+                x += l;
+                sx += l;
+                length -= l;
+                if (sx >= image_width)
+                    sx = 0;
+            }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_tiled_generic_rgb64(int count, const QSpan *spans, void *userData)
@@ -4326,8 +4411,6 @@ static void blend_tiled_generic_rgb64(int count, const QSpan *spans, void *userD
         qCDebug(lcQtGuiDrawHelper, "blend_tiled_generic_rgb64: unsupported 64-bit blend attempted, falling back to 32-bit");
         return blend_tiled_generic(count, spans, userData);
     }
-    quint64 buffer[buffer_size];
-    quint64 src_buffer[buffer_size];
 
     const int image_width = data->texture.width;
     const int image_height = data->texture.height;
@@ -4339,33 +4422,38 @@ static void blend_tiled_generic_rgb64(int count, const QSpan *spans, void *userD
     if (yoff < 0)
         yoff += image_height;
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        int sx = (xoff + spans->x) % image_width;
-        int sy = (spans->y + yoff) % image_height;
-        if (sx < 0)
-            sx += image_width;
-        if (sy < 0)
-            sy += image_height;
-
-        const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-        while (length) {
-            int l = qMin(image_width - sx, length);
-            if (buffer_size < l)
-                l = buffer_size;
-            const QRgba64 *src = op.srcFetch64((QRgba64 *)src_buffer, &op, data, sy, sx, l);
-            QRgba64 *dest = op.destFetch64((QRgba64 *)buffer, data->rasterBuffer, x, spans->y, l);
-            op.func64(dest, src, l, coverage);
-            op.destStore64(data->rasterBuffer, x, spans->y, dest, l);
-            x += l;
-            sx += l;
-            length -= l;
-            if (sx >= image_width)
-                sx = 0;
+    auto function = [=, &op] (int cStart, int cEnd) {
+        quint64 buffer[buffer_size];
+        quint64 src_buffer[buffer_size];
+
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            int sx = (xoff + spans[c].x) % image_width;
+            int sy = (spans[c].y + yoff) % image_height;
+            if (sx < 0)
+                sx += image_width;
+            if (sy < 0)
+                sy += image_height;
+
+            const int coverage = (spans[c].coverage * data->texture.const_alpha) >> 8;
+            while (length) {
+                int l = qMin(image_width - sx, length);
+                if (buffer_size < l)
+                    l = buffer_size;
+                const QRgba64 *src = op.srcFetch64((QRgba64 *)src_buffer, &op, data, sy, sx, l);
+                QRgba64 *dest = op.destFetch64((QRgba64 *)buffer, data->rasterBuffer, x, spans[c].y, l);
+                op.func64(dest, src, l, coverage);
+                op.destStore64(data->rasterBuffer, x, spans[c].y, dest, l);
+                x += l;
+                sx += l;
+                length -= l;
+                if (sx >= image_width)
+                    sx = 0;
+            }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_tiled_argb(int count, const QSpan *spans, void *userData)
@@ -4389,32 +4477,34 @@ static void blend_tiled_argb(int count, const QSpan *spans, void *userData)
     if (yoff < 0)
         yoff += image_height;
 
-    while (count--) {
-        int x = spans->x;
-        int length = spans->len;
-        int sx = (xoff + spans->x) % image_width;
-        int sy = (spans->y + yoff) % image_height;
-        if (sx < 0)
-            sx += image_width;
-        if (sy < 0)
-            sy += image_height;
-
-        const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-        while (length) {
-            int l = qMin(image_width - sx, length);
-            if (buffer_size < l)
-                l = buffer_size;
-            const uint *src = (const uint *)data->texture.scanLine(sy) + sx;
-            uint *dest = ((uint *)data->rasterBuffer->scanLine(spans->y)) + x;
-            op.func(dest, src, l, coverage);
-            x += l;
-            sx += l;
-            length -= l;
-            if (sx >= image_width)
-                sx = 0;
+    auto function = [=, &op] (int cStart, int cEnd) {
+        for (int c = cStart; c < cEnd; ++c) {
+            int x = spans[c].x;
+            int length = spans[c].len;
+            int sx = (xoff + spans[c].x) % image_width;
+            int sy = (spans[c].y + yoff) % image_height;
+            if (sx < 0)
+                sx += image_width;
+            if (sy < 0)
+                sy += image_height;
+
+            const int coverage = (spans[c].coverage * data->texture.const_alpha) >> 8;
+            while (length) {
+                int l = qMin(image_width - sx, length);
+                if (buffer_size < l)
+                    l = buffer_size;
+                const uint *src = (const uint *)data->texture.scanLine(sy) + sx;
+                uint *dest = ((uint *)data->rasterBuffer->scanLine(spans[c].y)) + x;
+                op.func(dest, src, l, coverage);
+                x += l;
+                sx += l;
+                length -= l;
+                if (sx >= image_width)
+                    sx = 0;
+            }
         }
-        ++spans;
-    }
+    };
+    qt_parallelSpans(count, spans, function);
 }
 
 static void blend_tiled_rgb565(int count, const QSpan *spans, void *userData)
@@ -4718,7 +4808,6 @@ static void blend_transformed_argb(int count, const QSpan *spans, void *userData
     }
 
     CompositionFunction func = functionForMode[data->rasterBuffer->compositionMode];
-    uint buffer[buffer_size];
     quint32 mask = (data->texture.format == QImage::Format_RGB32) ? 0xff000000 : 0;
 
     const int image_x1 = data->texture.x1;
@@ -4731,82 +4820,90 @@ static void blend_transformed_argb(int count, const QSpan *spans, void *userData
         int fdx = (int)(data->m11 * fixed_scale);
         int fdy = (int)(data->m12 * fixed_scale);
 
-        while (count--) {
-            void *t = data->rasterBuffer->scanLine(spans->y);
+        auto function = [=] (int cStart, int cEnd) {
+            uint buffer[buffer_size];
+            for (int c = cStart; c < cEnd; ++c) {
+                const QSpan *span = spans + c;
+                void *t = data->rasterBuffer->scanLine(span->y);
 
-            uint *target = ((uint *)t) + spans->x;
+                uint *target = ((uint *)t) + span->x;
 
-            const qreal cx = spans->x + qreal(0.5);
-            const qreal cy = spans->y + qreal(0.5);
-
-            int x = int((data->m21 * cy
-                         + data->m11 * cx + data->dx) * fixed_scale);
-            int y = int((data->m22 * cy
-                         + data->m12 * cx + data->dy) * fixed_scale);
+                const qreal cx = span->x + qreal(0.5);
+                const qreal cy = span->y + qreal(0.5);
 
-            int length = spans->len;
-            const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-            while (length) {
-                int l = qMin(length, buffer_size);
-                const uint *end = buffer + l;
-                uint *b = buffer;
-                while (b < end) {
-                    int px = qBound(image_x1, x >> 16, image_x2);
-                    int py = qBound(image_y1, y >> 16, image_y2);
-                    *b = reinterpret_cast<const uint *>(data->texture.scanLine(py))[px] | mask;
+                int x = int((data->m21 * cy
+                             + data->m11 * cx + data->dx) * fixed_scale);
+                int y = int((data->m22 * cy
+                             + data->m12 * cx + data->dy) * fixed_scale);
 
-                    x += fdx;
-                    y += fdy;
-                    ++b;
+                int length = span->len;
+                const int coverage = (span->coverage * data->texture.const_alpha) >> 8;
+                while (length) {
+                    int l = qMin(length, buffer_size);
+                    const uint *end = buffer + l;
+                    uint *b = buffer;
+                    while (b < end) {
+                        int px = qBound(image_x1, x >> 16, image_x2);
+                        int py = qBound(image_y1, y >> 16, image_y2);
+                        *b = reinterpret_cast<const uint *>(data->texture.scanLine(py))[px] | mask;
+
+                        x += fdx;
+                        y += fdy;
+                        ++b;
+                    }
+                    func(target, buffer, l, coverage);
+                    target += l;
+                    length -= l;
                 }
-                func(target, buffer, l, coverage);
-                target += l;
-                length -= l;
             }
-            ++spans;
-        }
+        };
+        qt_parallelSpans(count, spans, function);
     } else {
         const qreal fdx = data->m11;
         const qreal fdy = data->m12;
         const qreal fdw = data->m13;
-        while (count--) {
-            void *t = data->rasterBuffer->scanLine(spans->y);
+        auto function = [=] (int cStart, int cEnd) {
+            uint buffer[buffer_size];
+            for (int c = cStart; c < cEnd; ++c) {
+                const QSpan *span = spans + c;
+                void *t = data->rasterBuffer->scanLine(span->y);
 
-            uint *target = ((uint *)t) + spans->x;
+                uint *target = ((uint *)t) + span->x;
 
-            const qreal cx = spans->x + qreal(0.5);
-            const qreal cy = spans->y + qreal(0.5);
+                const qreal cx = span->x + qreal(0.5);
+                const qreal cy = span->y + qreal(0.5);
 
-            qreal x = data->m21 * cy + data->m11 * cx + data->dx;
-            qreal y = data->m22 * cy + data->m12 * cx + data->dy;
-            qreal w = data->m23 * cy + data->m13 * cx + data->m33;
+                qreal x = data->m21 * cy + data->m11 * cx + data->dx;
+                qreal y = data->m22 * cy + data->m12 * cx + data->dy;
+                qreal w = data->m23 * cy + data->m13 * cx + data->m33;
 
-            int length = spans->len;
-            const int coverage = (spans->coverage * data->texture.const_alpha) >> 8;
-            while (length) {
-                int l = qMin(length, buffer_size);
-                const uint *end = buffer + l;
-                uint *b = buffer;
-                while (b < end) {
-                    const qreal iw = w == 0 ? 1 : 1 / w;
-                    const qreal tx = x * iw;
-                    const qreal ty = y * iw;
-                    const int px = qBound(image_x1, int(tx) - (tx < 0), image_x2);
-                    const int py = qBound(image_y1, int(ty) - (ty < 0), image_y2);
-
-                    *b = reinterpret_cast<const uint *>(data->texture.scanLine(py))[px] | mask;
-                    x += fdx;
-                    y += fdy;
-                    w += fdw;
+                int length = span->len;
+                const int coverage = (span->coverage * data->texture.const_alpha) >> 8;
+                while (length) {
+                    int l = qMin(length, buffer_size);
+                    const uint *end = buffer + l;
+                    uint *b = buffer;
+                    while (b < end) {
+                        const qreal iw = w == 0 ? 1 : 1 / w;
+                        const qreal tx = x * iw;
+                        const qreal ty = y * iw;
+                        const int px = qBound(image_x1, int(tx) - (tx < 0), image_x2);
+                        const int py = qBound(image_y1, int(ty) - (ty < 0), image_y2);
+
+                        *b = reinterpret_cast<const uint *>(data->texture.scanLine(py))[px] | mask;
+                        x += fdx;
+                        y += fdy;
+                        w += fdw;
 
-                    ++b;
+                        ++b;
+                    }
+                    func(target, buffer, l, coverage);
+                    target += l;
+                    length -= l;
                 }
-                func(target, buffer, l, coverage);
-                target += l;
-                length -= l;
             }
-            ++spans;
-        }
+        };
+        qt_parallelSpans(count, spans, function);
     }
 }
 
@@ -6402,9 +6499,11 @@ static void qInitDrawhelperFunctions()
         extern void QT_FASTCALL comp_func_SourceOver_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
         extern void QT_FASTCALL comp_func_solid_SourceOver_avx2(uint *destPixels, int length, uint color, uint const_alpha);
         extern void QT_FASTCALL comp_func_Source_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
+        extern void QT_FASTCALL comp_func_Plus_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha);
         qt_functionForMode_C[QPainter::CompositionMode_SourceOver] = comp_func_SourceOver_avx2;
         qt_functionForModeSolid_C[QPainter::CompositionMode_SourceOver] = comp_func_solid_SourceOver_avx2;
         qt_functionForMode_C[QPainter::CompositionMode_Source] = comp_func_Source_avx2;
+        qt_functionForMode_C[QPainter::CompositionMode_Plus] = comp_func_Plus_avx2;
 
         extern void QT_FASTCALL fetchTransformedBilinearARGB32PM_simple_upscale_helper_avx2(uint *b, uint *end, const QTextureData &image,
                                                                                             int &fx, int &fy, int fdx, int /*fdy*/);
@@ -38,6 +38,7 @@
 ****************************************************************************/
 #include <private/qimagescale_p.h>
 #include <private/qdrawhelper_p.h>
+#include <private/qimage_p.h>
 
 #include "qimage.h"
 #include "qcolor.h"
@@ -725,6 +726,53 @@ static void qt_qimageScaleAARGB_down_xy(QImageScaleInfo *isi, unsigned int *dest
     }
 }
 
+typedef void (*QImageScaleFunction)(QImageScaleInfo *isi, unsigned int *dest,
+                                    int dw, int dh, int dow, int sow);
+
+// Every destination row only depends on the scale info of that row, so a
+// band of rows is scaled by moving the row tables to its first row.
+namespace {
+struct QImageScaleRows
+{
+    QImageScaleFunction scale;
+    const QImageScaleInfo *isi;
+    unsigned int *dest;
+    int dw, dow, sow;
+
+    static void run(void *closure, int yStart, int yEnd)
+    {
+        const QImageScaleRows *rows = static_cast<const QImageScaleRows *>(closure);
+        QImageScaleInfo section = *rows->isi;
+        section.ypoints += yStart;
+        if (section.yapoints)
+            section.yapoints += yStart;
+        rows->scale(&section, rows->dest + qint64(yStart) * rows->dow,
+                    rows->dw, yEnd - yStart, rows->dow, rows->sow);
+    }
+};
+} // unnamed namespace
+
+// Source or destination pixels below which an image is scaled in one band
+enum { ScaleSegmentPixels = 1 << 16 };
+
+/*
+    Scales large images in bands on the threads of the global thread pool.
+    The result does not depend on how the bands are distributed.
+*/
+static void qt_qimageScaleParallel(QImageScaleFunction scale, QImageScaleInfo *isi,
+                                   unsigned int *dest, int sw, int sh,
+                                   int dw, int dh, int dow, int sow)
+{
+    const qint64 pixels = qMax(qint64(sw) * sh, qint64(dw) * dh);
+    const int segments = int(qMin<qint64>(pixels / ScaleSegmentPixels, dh));
+    if (segments > 1) {
+        QImageScaleRows rows = { scale, isi, dest, dw, dow, sow };
+        qt_imageRunSegments(segments, dh, &QImageScaleRows::run, &rows);
+        return;
+    }
+    scale(isi, dest, dw, dh, dow, sow);
+}
+
 QImage qSmoothScaleImage(const QImage &src, int dw, int dh)
 {
     QImage buffer;
@@ -745,12 +793,9 @@ QImage qSmoothScaleImage(const QImage &src, int dw, int dh)
         return QImage();
     }
 
-    if (src.hasAlphaChannel())
-        qt_qimageScaleAARGBA(scaleinfo, (unsigned int *)buffer.scanLine(0),
-                             dw, dh, dw, src.bytesPerLine() / 4);
-    else
-        qt_qimageScaleAARGB(scaleinfo, (unsigned int *)buffer.scanLine(0),
-                            dw, dh, dw, src.bytesPerLine() / 4);
+    qt_qimageScaleParallel(src.hasAlphaChannel() ? qt_qimageScaleAARGBA : qt_qimageScaleAARGB,
+                           scaleinfo, (unsigned int *)buffer.scanLine(0),
+                           w, h, dw, dh, dw, src.bytesPerLine() / 4);
 
     qimageFreeScaleInfo(scaleinfo);
     return buffer;
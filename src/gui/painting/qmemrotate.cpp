@@ -38,11 +38,81 @@
 ****************************************************************************/
 
 #include "private/qmemrotate_p.h"
+#include "private/qimage_p.h"
+#include <private/qsimd_p.h>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
 static const int tileSize = 32;
 
+#if defined(__SSE2__)
+// The operations on 16 bytes of pixels of the given size
+template <int Size> struct QMemRotatePixels;
+
+template <> struct QMemRotatePixels<4>
+{
+    static inline __m128i unpacklo(__m128i a, __m128i b) { return _mm_unpacklo_epi32(a, b); }
+    static inline __m128i unpackhi(__m128i a, __m128i b) { return _mm_unpackhi_epi32(a, b); }
+    static inline __m128i reverse(__m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+};
+
+template <> struct QMemRotatePixels<2>
+{
+    static inline __m128i unpacklo(__m128i a, __m128i b) { return _mm_unpacklo_epi16(a, b); }
+    static inline __m128i unpackhi(__m128i a, __m128i b) { return _mm_unpackhi_epi16(a, b); }
+    static inline __m128i reverse(__m128i v)
+    {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+};
+
+template <> struct QMemRotatePixels<1>
+{
+    static inline __m128i unpacklo(__m128i a, __m128i b) { return _mm_unpacklo_epi8(a, b); }
+    static inline __m128i unpackhi(__m128i a, __m128i b) { return _mm_unpackhi_epi8(a, b); }
+    static inline __m128i reverse(__m128i v)
+    {
+        // swap the bytes of each 16-bit word, then reverse the words
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        return QMemRotatePixels<2>::reverse(v);
+    }
+};
+
+/*
+    Transposes a block of 16 / sizeof(T) rows of 16 bytes each from \a src
+    to \a dest. Negative strides mirror the block in the same go.
+*/
+template <class T>
+static inline void qt_memtranspose_block_sse2(const uchar *src, qsizetype sstride,
+                                              uchar *dest, qsizetype dstride)
+{
+    enum { N = 16 / sizeof(T) };
+    typedef QMemRotatePixels<sizeof(T)> Pixels;
+
+    __m128i rows[N];
+    for (int i = 0; i < N; ++i)
+        rows[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * sstride));
+
+    // log2(N) rounds of interleaving the first half of the rows with the second
+    for (int round = 1; round < N; round *= 2) {
+        __m128i next[N];
+        for (int k = 0; k < N / 2; ++k) {
+            next[2 * k] = Pixels::unpacklo(rows[k], rows[k + N / 2]);
+            next[2 * k + 1] = Pixels::unpackhi(rows[k], rows[k + N / 2]);
+        }
+        for (int i = 0; i < N; ++i)
+            rows[i] = next[i];
+    }
+
+    for (int i = 0; i < N; ++i)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i * dstride), rows[i]);
+}
+#endif // __SSE2__
+
 template <class T>
 Q_STATIC_TEMPLATE_FUNCTION
 inline void qt_memrotate90_tiled(const T *src, int w, int h, int sstride, T *dest, int dstride)
@@ -218,6 +288,141 @@ inline void qt_memrotate270_tiled_unpacked(const T *src, int w, int h, int sstri
 }
 
 
+template <class T>
+Q_STATIC_TEMPLATE_FUNCTION
+inline void qt_memreverse_template(const T *src, T *dest, int count)
+{
+    if (src == dest)
+        std::reverse(dest, dest + count);
+    else
+        std::reverse_copy(src, src + count, dest);
+}
+
+#if defined(__SSE2__)
+template <class T>
+Q_STATIC_TEMPLATE_FUNCTION
+inline void qt_memreverse_sse2(const T *src, T *dest, int count)
+{
+    enum { N = 16 / sizeof(T) };
+    typedef QMemRotatePixels<sizeof(T)> Pixels;
+
+    if (src == dest) {
+        // swap the blocks at both ends until they would overlap
+        int i = 0;
+        int j = count;
+        for ( ; j - i >= 2 * N; i += N, j -= N) {
+            const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + i));
+            const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + j - N));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), Pixels::reverse(tail));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + j - N), Pixels::reverse(head));
+        }
+        std::reverse(dest + i, dest + j);
+        return;
+    }
+
+    int i = 0;
+    for ( ; i + N <= count; i += N) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + count - i - N));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), Pixels::reverse(data));
+    }
+    for ( ; i < count; ++i)
+        dest[i] = src[count - 1 - i];
+}
+
+template <>
+inline void qt_memreverse_template<quint32>(const quint32 *src, quint32 *dest, int count)
+{
+    qt_memreverse_sse2(src, dest, count);
+}
+
+template <>
+inline void qt_memreverse_template<quint16>(const quint16 *src, quint16 *dest, int count)
+{
+    qt_memreverse_sse2(src, dest, count);
+}
+
+template <>
+inline void qt_memreverse_template<quint8>(const quint8 *src, quint8 *dest, int count)
+{
+    qt_memreverse_sse2(src, dest, count);
+}
+
+/*
+    Rotates by transposing whole blocks of 16 bytes by 16 / sizeof(T) rows,
+    visited in tiles; the pixels right of and below the last whole block
+    go through the scalar code.
+*/
+template <class T>
+Q_STATIC_TEMPLATE_FUNCTION
+inline void qt_memrotate90_sse2(const T *src, int w, int h, int sstride, T *dest, int dstride)
+{
+    enum { N = 16 / sizeof(T) };
+    const int wBlocks = w - w % N;
+    const int hBlocks = h - h % N;
+    const uchar *s = reinterpret_cast<const uchar *>(src);
+    uchar *d = reinterpret_cast<uchar *>(dest);
+
+    for (int tx = 0; tx < wBlocks; tx += tileSize) {
+        const int stopx = qMin(tx + tileSize, wBlocks);
+        for (int ty = 0; ty < hBlocks; ty += tileSize) {
+            const int stopy = qMin(ty + tileSize, hBlocks);
+            for (int x = tx; x < stopx; x += N) {
+                for (int y = ty; y < stopy; y += N) {
+                    qt_memtranspose_block_sse2<T>(s + qsizetype(y) * sstride + x * sizeof(T), sstride,
+                                                  d + qsizetype(w - 1 - x) * dstride + y * sizeof(T),
+                                                  -qsizetype(dstride));
+                }
+            }
+        }
+    }
+
+    if (wBlocks < w)
+        qt_memrotate90_tiled_unpacked(src + wBlocks, w - wBlocks, h, sstride, dest, dstride);
+    if (hBlocks < h && wBlocks > 0) {
+        qt_memrotate90_tiled_unpacked(reinterpret_cast<const T *>(s + qsizetype(hBlocks) * sstride),
+                                      wBlocks, h - hBlocks, sstride,
+                                      reinterpret_cast<T *>(d + qsizetype(w - wBlocks) * dstride) + hBlocks,
+                                      dstride);
+    }
+}
+
+template <class T>
+Q_STATIC_TEMPLATE_FUNCTION
+inline void qt_memrotate270_sse2(const T *src, int w, int h, int sstride, T *dest, int dstride)
+{
+    enum { N = 16 / sizeof(T) };
+    const int wBlocks = w - w % N;
+    const int hBlocks = h - h % N;
+    const uchar *s = reinterpret_cast<const uchar *>(src);
+    uchar *d = reinterpret_cast<uchar *>(dest);
+
+    for (int tx = 0; tx < wBlocks; tx += tileSize) {
+        const int stopx = qMin(tx + tileSize, wBlocks);
+        for (int ty = 0; ty < hBlocks; ty += tileSize) {
+            const int stopy = qMin(ty + tileSize, hBlocks);
+            for (int x = tx; x < stopx; x += N) {
+                for (int y = ty; y < stopy; y += N) {
+                    // reading the rows bottom up mirrors the transposed block
+                    qt_memtranspose_block_sse2<T>(s + qsizetype(y + N - 1) * sstride + x * sizeof(T),
+                                                  -qsizetype(sstride),
+                                                  d + qsizetype(x) * dstride + (h - N - y) * sizeof(T),
+                                                  dstride);
+                }
+            }
+        }
+    }
+
+    if (wBlocks < w) {
+        qt_memrotate270_tiled_unpacked(src + wBlocks, w - wBlocks, h, sstride,
+                                       reinterpret_cast<T *>(d + qsizetype(wBlocks) * dstride), dstride);
+    }
+    if (hBlocks < h && wBlocks > 0) {
+        qt_memrotate270_tiled_unpacked(reinterpret_cast<const T *>(s + qsizetype(hBlocks) * sstride),
+                                       wBlocks, h - hBlocks, sstride, dest, dstride);
+    }
+}
+#endif // __SSE2__
+
 template <class T>
 Q_STATIC_TEMPLATE_FUNCTION
 inline void qt_memrotate90_template(const T *src, int srcWidth, int srcHeight, int srcStride,
@@ -235,10 +440,28 @@ inline void qt_memrotate90_template(const T *src, int srcWidth, int srcHeight, i
 template <>
 inline void qt_memrotate90_template<quint32>(const quint32 *src, int w, int h, int sstride, quint32 *dest, int dstride)
 {
+#if defined(__SSE2__)
+    qt_memrotate90_sse2(src, w, h, sstride, dest, dstride);
+#else
     // packed algorithm doesn't have any benefit for quint32
     qt_memrotate90_tiled_unpacked(src, w, h, sstride, dest, dstride);
+#endif
+}
+
+#if defined(__SSE2__)
+template <>
+inline void qt_memrotate90_template<quint16>(const quint16 *src, int w, int h, int sstride, quint16 *dest, int dstride)
+{
+    qt_memrotate90_sse2(src, w, h, sstride, dest, dstride);
 }
 
+template <>
+inline void qt_memrotate90_template<quint8>(const quint8 *src, int w, int h, int sstride, quint8 *dest, int dstride)
+{
+    qt_memrotate90_sse2(src, w, h, sstride, dest, dstride);
+}
+#endif
+
 template <class T>
 Q_STATIC_TEMPLATE_FUNCTION
 inline void qt_memrotate180_template(const T *src, int w, int h, int sstride, T *dest, int dstride)
@@ -246,10 +469,7 @@ inline void qt_memrotate180_template(const T *src, int w, int h, int sstride, T
     const char *s = (const char*)(src) + (h - 1) * sstride;
     for (int dy = 0; dy < h; ++dy) {
         T *d = reinterpret_cast<T*>((char *)(dest) + dy * dstride);
-        src = reinterpret_cast<const T*>(s);
-        for (int dx = 0; dx < w; ++dx) {
-            d[dx] = src[w - 1 - dx];
-        }
+        qt_memreverse_template(reinterpret_cast<const T*>(s), d, w);
         s -= sstride;
     }
 }
@@ -271,10 +491,28 @@ inline void qt_memrotate270_template(const T *src, int srcWidth, int srcHeight,
 template <>
 inline void qt_memrotate270_template<quint32>(const quint32 *src, int w, int h, int sstride, quint32 *dest, int dstride)
 {
+#if defined(__SSE2__)
+    qt_memrotate270_sse2(src, w, h, sstride, dest, dstride);
+#else
     // packed algorithm doesn't have any benefit for quint32
     qt_memrotate270_tiled_unpacked(src, w, h, sstride, dest, dstride);
+#endif
 }
 
+#if defined(__SSE2__)
+template <>
+inline void qt_memrotate270_template<quint16>(const quint16 *src, int w, int h, int sstride, quint16 *dest, int dstride)
+{
+    qt_memrotate270_sse2(src, w, h, sstride, dest, dstride);
+}
+
+template <>
+inline void qt_memrotate270_template<quint8>(const quint8 *src, int w, int h, int sstride, quint8 *dest, int dstride)
+{
+    qt_memrotate270_sse2(src, w, h, sstride, dest, dstride);
+}
+#endif
+
 #define QT_IMPL_MEMROTATE(type)                                     \
 Q_GUI_EXPORT void qt_memrotate90(const type *src, int w, int h, int sstride, \
                                  type *dest, int dstride)           \
@@ -317,64 +555,113 @@ QT_IMPL_MEMROTATE(quint16)
 QT_IMPL_MEMROTATE(quint24)
 QT_IMPL_MEMROTATE(quint8)
 
+void qt_memreverse(const quint32 *src, quint32 *dest, int count)
+{
+    qt_memreverse_template(src, dest, count);
+}
+
+void qt_memreverse(const quint24 *src, quint24 *dest, int count)
+{
+    qt_memreverse_template(src, dest, count);
+}
+
+void qt_memreverse(const quint16 *src, quint16 *dest, int count)
+{
+    qt_memreverse_template(src, dest, count);
+}
+
+void qt_memreverse(const quint8 *src, quint8 *dest, int count)
+{
+    qt_memreverse_template(src, dest, count);
+}
+
+/*
+    Rotates large images in bands of source rows on the global thread pool.
+    The bands are a whole number of tiles high, so that only the last one
+    can end in a partial block.
+*/
+template <class T, int Rotation>
+static void qt_memrotate_segmented(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
+{
+    const int tiles = (h + tileSize - 1) / tileSize;
+    const int segments = qt_imageConversionSegments(qsizetype(w) * h * sizeof(T), tiles);
+    qt_imageRunSegments(segments, tiles, [=](int tileStart, int tileEnd) {
+        const int yStart = tileStart * tileSize;
+        const int yEnd = qMin(tileEnd * tileSize, h);
+        const T *src = reinterpret_cast<const T *>(srcPixels + qsizetype(yStart) * sbpl);
+        switch (Rotation) {
+        case 90:
+            qt_memrotate90(src, w, yEnd - yStart, sbpl, reinterpret_cast<T *>(destPixels) + yStart, dbpl);
+            break;
+        case 180:
+            qt_memrotate180(src, w, yEnd - yStart, sbpl,
+                            reinterpret_cast<T *>(destPixels + qsizetype(h - yEnd) * dbpl), dbpl);
+            break;
+        case 270:
+            qt_memrotate270(src, w, yEnd - yStart, sbpl, reinterpret_cast<T *>(destPixels) + (h - yEnd), dbpl);
+            break;
+        }
+    });
+}
+
 void qt_memrotate90_8(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate90(srcPixels, w, h, sbpl, destPixels, dbpl);
+    qt_memrotate_segmented<quint8, 90>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate180_8(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate180(srcPixels, w, h, sbpl, destPixels, dbpl);
+    qt_memrotate_segmented<quint8, 180>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate270_8(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate270(srcPixels, w, h, sbpl, destPixels, dbpl);
+    qt_memrotate_segmented<quint8, 270>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate90_16(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate90((const ushort *)srcPixels, w, h, sbpl, (ushort *)destPixels, dbpl);
+    qt_memrotate_segmented<quint16, 90>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate180_16(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate180((const ushort *)srcPixels, w, h, sbpl, (ushort *)destPixels, dbpl);
+    qt_memrotate_segmented<quint16, 180>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate270_16(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate270((const ushort *)srcPixels, w, h, sbpl, (ushort *)destPixels, dbpl);
+    qt_memrotate_segmented<quint16, 270>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate90_24(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate90((const quint24 *)srcPixels, w, h, sbpl, (quint24 *)destPixels, dbpl);
+    qt_memrotate_segmented<quint24, 90>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate180_24(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate180((const quint24 *)srcPixels, w, h, sbpl, (quint24 *)destPixels, dbpl);
+    qt_memrotate_segmented<quint24, 180>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate270_24(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate270((const quint24 *)srcPixels, w, h, sbpl, (quint24 *)destPixels, dbpl);
+    qt_memrotate_segmented<quint24, 270>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate90_32(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate90((const uint *)srcPixels, w, h, sbpl, (uint *)destPixels, dbpl);
+    qt_memrotate_segmented<quint32, 90>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate180_32(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate180((const uint *)srcPixels, w, h, sbpl, (uint *)destPixels, dbpl);
+    qt_memrotate_segmented<quint32, 180>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 void qt_memrotate270_32(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
 {
-    qt_memrotate270((const uint *)srcPixels, w, h, sbpl, (uint *)destPixels, dbpl);
+    qt_memrotate_segmented<quint32, 270>(srcPixels, w, h, sbpl, destPixels, dbpl);
 }
 
 MemRotateFunc qMemRotateFunctions[QPixelLayout::BPPCount][3] =
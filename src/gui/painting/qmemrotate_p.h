@@ -68,6 +68,12 @@ QT_DECL_MEMROTATE(quint8);
 
 #undef QT_DECL_MEMROTATE
 
+// Copies count pixels from src to dest in reverse order; src may equal dest
+void qt_memreverse(const quint32 *src, quint32 *dest, int count);
+void qt_memreverse(const quint24 *src, quint24 *dest, int count);
+void qt_memreverse(const quint16 *src, quint16 *dest, int count);
+void qt_memreverse(const quint8 *src, quint8 *dest, int count);
+
 QT_END_NAMESPACE
 
 #endif // QMEMROTATE_P_H
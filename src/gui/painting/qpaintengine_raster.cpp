@@ -46,6 +46,7 @@
 #include <private/qrasterdefs_p.h>
 #include <private/qgrayraster_p.h>
 
+#include <qcache.h>
 #include <qpainterpath.h>
 #include <qdebug.h>
 #include <qbitmap.h>
@@ -304,7 +305,8 @@ static QRect qrect_normalized(const QRect &rect)
 
 QRasterPaintEnginePrivate::QRasterPaintEnginePrivate() :
     QPaintEngineExPrivate(),
-    cachedLines(0)
+    cachedLines(0),
+    pathCache(0)
 {
 }
 
@@ -397,6 +399,8 @@ void QRasterPaintEngine::init()
 
 
     d->rasterizer.reset(new QRasterizer);
+    d->cellRasterizer.reset(new QCellRasterizer);
+    d->cell_rasterizer_enabled = true;
     d->rasterBuffer.reset(new QRasterBuffer());
     d->outlineMapper.reset(new QOutlineMapper);
     d->outlinemapper_xform_dirty = true;
@@ -447,6 +451,10 @@ void QRasterPaintEngine::init()
             gccaps |= PorterDuff;
         break;
     }
+
+    static const int defaultPathCacheLimit = qEnvironmentVariableIntValue("QT_RASTER_PATH_CACHE_LIMIT");
+    if (defaultPathCacheLimit > 0)
+        setPathCacheLimit(defaultPathCacheLimit);
 }
 
 
@@ -458,6 +466,7 @@ QRasterPaintEngine::~QRasterPaintEngine()
     Q_D(QRasterPaintEngine);
 
     qt_ft_grays_raster.raster_done(*d->grayRaster.data());
+    setPathCacheLimit(0);
 }
 
 /*!
@@ -1044,10 +1053,19 @@ void QRasterPaintEnginePrivate::drawImage(const QPointF &pt,
     // call the blend function...
     int dstSize = rasterBuffer->bytesPerPixel();
     qsizetype dstBPL = rasterBuffer->bytesPerLine();
-    func(rasterBuffer->buffer() + x * dstSize + y * dstBPL, dstBPL,
-         srcBits, srcBPL,
-         iw, ih,
-         alpha);
+    uchar *dstBits = rasterBuffer->buffer() + x * dstSize + y * dstBPL;
+
+    // Rows blend independently, so large images are blended in bands,
+    // unless the image is drawn onto itself.
+    const uchar *bufferEnd = rasterBuffer->buffer() + rasterBuffer->height() * dstBPL;
+    const bool overlaps = srcBits < bufferEnd && srcBits + ih * srcBPL > rasterBuffer->buffer();
+    const int segments = overlaps ? 1 : qt_imageConversionSegments(qsizetype(iw) * ih * dstSize, ih);
+    qt_imageRunSegments(segments, ih, [=](int yStart, int yEnd) {
+        func(dstBits + yStart * dstBPL, dstBPL,
+             srcBits + yStart * srcBPL, srcBPL,
+             iw, yEnd - yStart,
+             alpha);
+    });
 }
 
 
@@ -1678,6 +1696,245 @@ QRect QRasterPaintEngine::toNormalizedFillRect(const QRectF &rect)
     return QRect(x1, y1, x2 - x1, y2 - y1);
 }
 
+/*
+    Antialiased fills of paths that are drawn over and over again, like icons
+    or map symbols, can skip the outline conversion and rasterization by
+    replaying the spans produced the last time the path was filled.
+
+    The spans are recorded before clipping and blending, so an entry stays
+    valid for any clip, brush and composition mode, and only depends on the
+    transformation, the rounding mode and the device rectangle used to clip
+    the rasterization. Entries whose spans were not cut by the device
+    rectangle can also be replayed under a different integer translation.
+*/
+struct QRasterCachedSpans
+{
+    QTransform matrix; // transformation without its integer translation
+    QPoint offset;     // integer translation the spans were recorded at
+    QRect deviceRect;
+    bool legacyRounding;
+    bool relocatable;
+    QVector<QSpan> spans;
+};
+
+class QRasterPathCache
+{
+public:
+    explicit QRasterPathCache(int maxCost) : ref(1), entries(maxCost) { }
+
+    void release()
+    {
+        if (!ref.deref())
+            delete this;
+    }
+
+    QAtomicInt ref;
+    QMutex mutex;
+    QCache<const void *, QRasterCachedSpans> entries;
+};
+
+// Attached to the QVectorPath, which can be destroyed in any thread.
+struct QRasterPathCacheKey
+{
+    QRasterPathCache *cache;
+
+    void detach()
+    {
+        {
+            QMutexLocker locker(&cache->mutex);
+            cache->entries.remove(this);
+        }
+        cache->release();
+        cache = 0;
+    }
+};
+
+static void qt_raster_path_cache_cleanup(QPaintEngineEx *, void *data)
+{
+    QRasterPathCacheKey *key = static_cast<QRasterPathCacheKey *>(data);
+    key->detach();
+    delete key;
+}
+
+struct QSpanRecorder
+{
+    ProcessSpans callback;
+    void *userData;
+    QVector<QSpan> *spans;
+};
+
+static void qt_span_record(int count, const QSpan *spans, void *userData)
+{
+    QSpanRecorder *recorder = static_cast<QSpanRecorder *>(userData);
+    const int size = recorder->spans->size();
+    recorder->spans->resize(size + count);
+    memcpy(recorder->spans->data() + size, spans, count * sizeof(QSpan));
+    recorder->callback(count, spans, recorder->userData);
+}
+
+/*!
+    \internal
+
+    Sets the size of the cache holding the rasterized coverage of
+    repeatedly filled paths to \a kilobytes. A limit of 0, the default,
+    disables the cache. The default can be changed with the
+    \c QT_RASTER_PATH_CACHE_LIMIT environment variable.
+*/
+void QRasterPaintEngine::setPathCacheLimit(int kilobytes)
+{
+    Q_D(QRasterPaintEngine);
+    if (kilobytes <= 0) {
+        if (d->pathCache) {
+            {
+                QMutexLocker locker(&d->pathCache->mutex);
+                d->pathCache->entries.clear();
+            }
+            d->pathCache->release();
+            d->pathCache = 0;
+        }
+        return;
+    }
+
+    const int maxCost = qMin(kilobytes, INT_MAX / 1024) * 1024;
+    if (!d->pathCache) {
+        d->pathCache = new QRasterPathCache(maxCost);
+    } else {
+        QMutexLocker locker(&d->pathCache->mutex);
+        d->pathCache->entries.setMaxCost(maxCost);
+    }
+}
+
+/*!
+    \internal
+
+    Returns the size of the path coverage cache in kilobytes, or 0 if the
+    cache is disabled.
+*/
+int QRasterPaintEngine::pathCacheLimit() const
+{
+    Q_D(const QRasterPaintEngine);
+    if (!d->pathCache)
+        return 0;
+    QMutexLocker locker(&d->pathCache->mutex);
+    return d->pathCache->entries.maxCost() / 1024;
+}
+
+/*!
+    \internal
+
+    Sets whether antialiased outlines made of straight lines are scan
+    converted by the cell rasterizer instead of the gray raster to
+    \a enabled. Both produce the same spans; this is enabled by default.
+*/
+void QRasterPaintEngine::setCellRasterizerEnabled(bool enabled)
+{
+    Q_D(QRasterPaintEngine);
+    d->cell_rasterizer_enabled = enabled;
+}
+
+/*!
+    \internal
+
+    Returns whether the cell rasterizer is used for antialiased outlines.
+*/
+bool QRasterPaintEngine::cellRasterizerEnabled() const
+{
+    Q_D(const QRasterPaintEngine);
+    return d->cell_rasterizer_enabled;
+}
+
+/*!
+    \internal
+
+    Fills \a path by replaying or recording its spans in the path cache.
+    Returns \c false if the path has to be rasterized normally. Expects the
+    outline mapper to be up to date.
+*/
+bool QRasterPaintEnginePrivate::fillCached(const QVectorPath &path, const QRect &pathDeviceRect,
+                                           ProcessSpans callback, void *userData)
+{
+    Q_Q(QRasterPaintEngine);
+    QRasterPaintEngineState *s = q->state();
+
+    // Only cache paths that are filled more than once.
+    if (!path.isCacheable()) {
+        path.makeCacheable();
+        return false;
+    }
+
+    QTransform matrix = s->matrix;
+    QPoint offset;
+    if (matrix.type() <= QTransform::TxShear) {
+        offset = QPoint(qFloor(matrix.dx()), qFloor(matrix.dy()));
+        matrix = QTransform(matrix.m11(), matrix.m12(), matrix.m21(), matrix.m22(),
+                            matrix.dx() - offset.x(), matrix.dy() - offset.y());
+    }
+    const bool relocatable = deviceRect.contains(pathDeviceRect.adjusted(-2, -2, 2, 2));
+
+    QRasterPathCacheKey *key = 0;
+    if (QVectorPath::CacheEntry *e = path.lookupCacheData(q))
+        key = static_cast<QRasterPathCacheKey *>(e->data);
+    if (!key) {
+        key = new QRasterPathCacheKey;
+        key->cache = 0;
+        path.addCacheData(q, key, qt_raster_path_cache_cleanup);
+    } else if (key->cache != pathCache) {
+        // Left behind by an engine that had the same address, or by an
+        // earlier cache of this engine.
+        key->detach();
+    }
+    if (!key->cache) {
+        key->cache = pathCache;
+        pathCache->ref.ref();
+    }
+
+    QMutexLocker locker(&pathCache->mutex);
+    if (const QRasterCachedSpans *entry = pathCache->entries.object(key)) {
+        const QPoint delta = offset - entry->offset;
+        if (entry->legacyRounding == bool(s->flags.legacy_rounding)
+            && entry->deviceRect == deviceRect
+            && qFuzzyCompare(entry->matrix, matrix)
+            && (delta.isNull() || (entry->relocatable && relocatable))) {
+            const QVector<QSpan> spans = entry->spans;
+            locker.unlock();
+
+            if (delta.isNull()) {
+                callback(spans.size(), spans.constData(), userData);
+                return true;
+            }
+
+            const int chunkSize = 256;
+            QSpan shifted[chunkSize];
+            for (int i = 0; i < spans.size(); i += chunkSize) {
+                const int count = qMin(chunkSize, spans.size() - i);
+                for (int j = 0; j < count; ++j) {
+                    shifted[j] = spans.at(i + j);
+                    shifted[j].x += delta.x();
+                    shifted[j].y += delta.y();
+                }
+                callback(count, shifted, userData);
+            }
+            return true;
+        }
+    }
+    locker.unlock();
+
+    QRasterCachedSpans *entry = new QRasterCachedSpans;
+    entry->matrix = matrix;
+    entry->offset = offset;
+    entry->deviceRect = deviceRect;
+    entry->legacyRounding = s->flags.legacy_rounding;
+    entry->relocatable = relocatable;
+
+    QSpanRecorder recorder = { callback, userData, &entry->spans };
+    rasterize(outlineMapper->convertPath(path), qt_span_record, &recorder, rasterBuffer.data());
+
+    const int cost = sizeof(QRasterCachedSpans) + entry->spans.size() * sizeof(QSpan);
+    locker.relock();
+    pathCache->entries.insert(key, entry, cost);
+    return true;
+}
+
 /*!
     \internal
 */
@@ -1746,6 +2003,10 @@ void QRasterPaintEngine::fill(const QVectorPath &path, const QBrush &brush)
 //         }
 
     ensureOutlineMapper();
+    if (d->pathCache && s->flags.antialiased
+        && d->fillCached(path, pathDeviceRect, blend, &s->brushData))
+        return;
+
     d->rasterize(d->outlineMapper->convertPath(path), blend, &s->brushData, d->rasterBuffer.data());
 }
 
@@ -3566,6 +3827,9 @@ void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
         return;
     }
 
+    if (cell_rasterizer_enabled && cellRasterizer->rasterize(outline, deviceRect, callback, userData))
+        return;
+
     // Initial size for raster pool is MINIMUM_POOL_SIZE so as to
     // minimize memory reallocations. However if initial size for
     // raster pool is changed for lower value, reallocations will
@@ -58,6 +58,7 @@
 #include "private/qdrawhelper_p.h"
 #include "private/qpaintengine_p.h"
 #include "private/qrasterizer_p.h"
+#include "private/qcellrasterizer_p.h"
 #include "private/qstroker_p.h"
 #include "private/qpainter_p.h"
 #include "private/qtextureglyphcache_p.h"
@@ -71,6 +72,7 @@ class QOutlineMapper;
 class QRasterPaintEnginePrivate;
 class QRasterBuffer;
 class QClipData;
+class QRasterPathCache;
 
 class QRasterPaintEngineState : public QPainterState
 {
@@ -198,6 +200,12 @@ public:
     inline const QClipData *clipData() const;
 
     void drawStaticTextItem(QStaticTextItem *textItem) Q_DECL_OVERRIDE;
+
+    void setPathCacheLimit(int kilobytes);
+    int pathCacheLimit() const;
+
+    void setCellRasterizerEnabled(bool enabled);
+    bool cellRasterizerEnabled() const;
     virtual bool drawCachedGlyphs(int numGlyphs, const glyph_t *glyphs, const QFixedPoint *positions,
                                   QFontEngine *fontEngine);
 
@@ -292,6 +300,8 @@ public:
     void drawImage(const QPointF &pt, const QImage &img, SrcOverBlendFunc func,
                    const QRect &clip, int alpha, const QRect &sr = QRect());
 
+    bool fillCached(const QVectorPath &path, const QRect &pathDeviceRect, ProcessSpans callback, void *userData);
+
     QTransform brushMatrix() const {
         Q_Q(const QRasterPaintEngine);
         const QRasterPaintEngineState *s = q->state();
@@ -344,8 +354,12 @@ public:
 
     uint mono_surface : 1;
     uint outlinemapper_xform_dirty : 1;
+    uint cell_rasterizer_enabled : 1;
 
     QScopedPointer<QRasterizer> rasterizer;
+    QScopedPointer<QCellRasterizer> cellRasterizer;
+
+    QRasterPathCache *pathCache;
 };
 
 
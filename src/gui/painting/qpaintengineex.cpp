@@ -463,6 +463,9 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &pen)
         // change the current transform. Normal transformed,
         // non-cosmetic pens will be transformed as part of fill
         // later, so they are also covered here..
+        qreal scale;
+        qt_scaleForTransform(state()->matrix, &scale);
+        d->stroker.setCurveThresholdForScale(scale);
         d->activeStroker->setCurveThresholdFromTransform(state()->matrix);
         d->activeStroker->begin(d->strokeHandler);
         if (types) {
@@ -515,6 +518,7 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &pen)
         fill(strokePath, pen.brush());
     } else {
         // For cosmetic pens we need a bit of trickery... We to process xform the input points
+        d->stroker.setCurveThresholdForScale(1);
         if (state()->matrix.type() >= QTransform::TxProject) {
             QPainterPath painterPath = state()->matrix.map(path.convertToPainterPath());
             d->activeStroker->strokePath(painterPath, d->strokeHandler, QTransform());
@@ -5835,6 +5835,179 @@ void QPainter::drawStaticText(const QPointF &topLeftPosition, const QStaticText
         d->state->matrix = oldMatrix;
 }
 
+/*!
+    \since 5.11
+
+    Draws the first \a count static texts in \a staticTexts, each at the
+    corresponding top-left position in \a positions.
+
+    This gives the same result as calling drawStaticText() for each of the
+    texts, but the glyphs of all texts that use the same font engine and color
+    are handed to the paint engine in a single call. With paint engines that
+    draw text from a glyph cache, this means one draw call per glyph texture
+    rather than one per text.
+
+    \note Since the texts are drawn grouped by font and color, texts that
+    overlap each other and have different colors may not be drawn in the
+    order in which they appear in \a staticTexts.
+
+    \sa drawStaticText(), QStaticText
+*/
+void QPainter::drawStaticTexts(const QPointF *positions, const QStaticText *staticTexts, int count)
+{
+    Q_D(QPainter);
+    if (!d->engine || count <= 0 || pen().style() == Qt::NoPen)
+        return;
+
+    // Without an extended paint engine or with a projective transform each
+    // text goes through drawText() anyway, so there is nothing to merge.
+    if (d->extended == 0 || !d->state->matrix.isAffine()) {
+        for (int i = 0; i < count; ++i)
+            drawStaticText(positions[i], staticTexts[i]);
+        return;
+    }
+
+    struct GlyphRun {
+        QFontEngine *fontEngine;
+        QColor color;
+        QFont font;
+        QVector<glyph_t> glyphs;
+        QVector<QFixedPoint> glyphPositions;
+    };
+    QVector<GlyphRun> runs;
+    QVector<QStaticTextItem *> decoratedItems;
+    QVector<QStaticTextPrivate *> decoratedTexts;
+
+    const QPen oldPen = d->state->pen;
+
+    auto flushRuns = [&]() {
+        QColor currentColor = oldPen.color();
+        for (const GlyphRun &run : qAsConst(runs)) {
+            if (currentColor != run.color) {
+                setPen(run.color);
+                currentColor = run.color;
+            }
+            QStaticTextItem item;
+            item.glyphs = const_cast<glyph_t *>(run.glyphs.constData());
+            item.glyphPositions = const_cast<QFixedPoint *>(run.glyphPositions.constData());
+            item.numGlyphs = run.glyphs.size();
+            item.font = run.font;
+            item.color = run.color;
+            item.setFontEngine(run.fontEngine);
+            d->extended->drawStaticTextItem(&item);
+        }
+        for (int i = 0; i < decoratedItems.size(); ++i) {
+            QStaticTextItem *item = decoratedItems.at(i);
+            const QColor color = item->color.isValid() ? item->color : oldPen.color();
+            if (currentColor != color) {
+                setPen(color);
+                currentColor = color;
+            }
+            qt_draw_decoration_for_glyphs(this, item->glyphs, item->glyphPositions,
+                                          item->numGlyphs, item->fontEngine(),
+                                          decoratedTexts.at(i)->font, QTextCharFormat());
+        }
+        if (currentColor != oldPen.color())
+            setPen(oldPen);
+        runs.clear();
+        decoratedItems.clear();
+        decoratedTexts.clear();
+    };
+
+    for (int i = 0; i < count; ++i) {
+        const QStaticText &staticText = staticTexts[i];
+        if (staticText.text().isEmpty())
+            continue;
+
+        QStaticTextPrivate *staticText_d =
+                const_cast<QStaticTextPrivate *>(QStaticTextPrivate::get(&staticText));
+
+        if (font() != staticText_d->font) {
+            staticText_d->font = font();
+            staticText_d->needsRelayout = true;
+        }
+
+        QFontEngine *fe = staticText_d->font.d->engineForScript(QChar::Script_Common);
+        if (fe->type() == QFontEngine::Multi)
+            fe = static_cast<QFontEngineMulti *>(fe)->engine(0);
+
+        // Texts that have to be laid out in device coordinates are drawn on
+        // their own, after everything queued so far to keep the stacking order.
+        if (!fe->supportsTransformation(d->state->matrix)
+                || d->extended->requiresPretransformedGlyphPositions(fe, d->state->matrix)) {
+            flushRuns();
+            drawStaticText(positions[i], staticText);
+            continue;
+        }
+
+        if (!staticText_d->untransformedCoordinates) {
+            staticText_d->untransformedCoordinates = true;
+            staticText_d->needsRelayout = true;
+        }
+
+        if (staticText_d->needsRelayout)
+            staticText_d->init();
+
+        const QPointF &topLeftPosition = positions[i];
+        if (topLeftPosition != staticText_d->position) { // Translate to actual position
+            QFixed fx = QFixed::fromReal(topLeftPosition.x());
+            QFixed fy = QFixed::fromReal(topLeftPosition.y());
+            QFixed oldX = QFixed::fromReal(staticText_d->position.x());
+            QFixed oldY = QFixed::fromReal(staticText_d->position.y());
+            for (int item=0; item<staticText_d->itemCount;++item) {
+                QStaticTextItem *textItem = staticText_d->items + item;
+                for (int j=0; j<textItem->numGlyphs; ++j) {
+                    textItem->glyphPositions[j].x += fx - oldX;
+                    textItem->glyphPositions[j].y += fy - oldY;
+                }
+                textItem->userDataNeedsUpdate = true;
+            }
+
+            staticText_d->position = topLeftPosition;
+        }
+
+        const bool decorated = staticText_d->font.underline()
+                || staticText_d->font.overline()
+                || staticText_d->font.strikeOut();
+
+        for (int j=0; j<staticText_d->itemCount; ++j) {
+            QStaticTextItem *item = staticText_d->items + j;
+            if (item->numGlyphs == 0)
+                continue;
+
+            const QColor color = item->color.isValid() ? item->color : oldPen.color();
+            QFontEngine *itemEngine = item->fontEngine();
+            GlyphRun *run = 0;
+            for (GlyphRun &candidate : runs) {
+                if (candidate.fontEngine == itemEngine && candidate.color == color) {
+                    run = &candidate;
+                    break;
+                }
+            }
+            if (!run) {
+                runs.append(GlyphRun());
+                run = &runs.last();
+                run->fontEngine = itemEngine;
+                run->color = color;
+                run->font = item->font;
+            }
+            run->glyphs.reserve(run->glyphs.size() + item->numGlyphs);
+            run->glyphPositions.reserve(run->glyphPositions.size() + item->numGlyphs);
+            for (int k = 0; k < item->numGlyphs; ++k) {
+                run->glyphs.append(item->glyphs[k]);
+                run->glyphPositions.append(item->glyphPositions[k]);
+            }
+
+            if (decorated) {
+                decoratedItems.append(item);
+                decoratedTexts.append(staticText_d);
+            }
+        }
+    }
+
+    flushRuns();
+}
+
 /*!
    \internal
 */
@@ -409,6 +409,7 @@ public:
     void drawStaticText(const QPointF &topLeftPosition, const QStaticText &staticText);
     inline void drawStaticText(const QPoint &topLeftPosition, const QStaticText &staticText);
     inline void drawStaticText(int left, int top, const QStaticText &staticText);
+    void drawStaticTexts(const QPointF *positions, const QStaticText *staticTexts, int count);
 
     void drawText(const QPointF &p, const QString &s);
     inline void drawText(const QPoint &p, const QString &s);
@@ -2568,7 +2568,8 @@ void qt_path_stroke_cubic_to(qfixed c1x, qfixed c1y,
 */
 
 QPainterPathStrokerPrivate::QPainterPathStrokerPrivate()
-    : dashOffset(0)
+    : dasher(&stroker),
+      dashOffset(0)
 {
     stroker.setMoveToHook(qt_path_stroke_move_to);
     stroker.setLineToHook(qt_path_stroke_line_to);
@@ -2623,6 +2624,10 @@ QPainterPathStroker::~QPainterPathStroker()
     painter path. Otherwise it may cause unexpected
     behavior. Generated outlines also require the Qt::WindingFill rule
     which is set by default.
+
+    If \a path is the same, unmodified path as in the previous call and
+    none of the stroker's properties have changed since, the previously
+    generated outline is returned without stroking the path again.
 */
 QPainterPath QPainterPathStroker::createStroke(const QPainterPath &path) const
 {
@@ -2630,16 +2635,20 @@ QPainterPath QPainterPathStroker::createStroke(const QPainterPath &path) const
     QPainterPath stroke;
     if (path.isEmpty())
         return path;
+    if (path.d_ptr == d->cachedPath.d_ptr && d->stroker.clipRect() == d->cachedClipRect)
+        return d->cachedStroke;
     if (d->dashPattern.isEmpty()) {
         d->stroker.strokePath(path, &stroke, QTransform());
     } else {
-        QDashStroker dashStroker(&d->stroker);
-        dashStroker.setDashPattern(d->dashPattern);
-        dashStroker.setDashOffset(d->dashOffset);
-        dashStroker.setClipRect(d->stroker.clipRect());
-        dashStroker.strokePath(path, &stroke, QTransform());
+        d->dasher.setDashPattern(d->dashPattern);
+        d->dasher.setDashOffset(d->dashOffset);
+        d->dasher.setClipRect(d->stroker.clipRect());
+        d->dasher.strokePath(path, &stroke, QTransform());
     }
     stroke.setFillRule(Qt::WindingFill);
+    d->cachedPath = path;
+    d->cachedStroke = stroke;
+    d->cachedClipRect = d->stroker.clipRect();
     return stroke;
 }
 
@@ -2655,6 +2664,7 @@ void QPainterPathStroker::setWidth(qreal width)
     if (width <= 0)
         width = 1;
     d->stroker.setStrokeWidth(qt_real_to_fixed(width));
+    d->invalidateCache();
 }
 
 /*!
@@ -2673,7 +2683,9 @@ qreal QPainterPathStroker::width() const
 */
 void QPainterPathStroker::setCapStyle(Qt::PenCapStyle style)
 {
-    d_func()->stroker.setCapStyle(style);
+    Q_D(QPainterPathStroker);
+    d->stroker.setCapStyle(style);
+    d->invalidateCache();
 }
 
 
@@ -2690,7 +2702,9 @@ Qt::PenCapStyle QPainterPathStroker::capStyle() const
 */
 void QPainterPathStroker::setJoinStyle(Qt::PenJoinStyle style)
 {
-    d_func()->stroker.setJoinStyle(style);
+    Q_D(QPainterPathStroker);
+    d->stroker.setJoinStyle(style);
+    d->invalidateCache();
 }
 
 /*!
@@ -2713,7 +2727,9 @@ Qt::PenJoinStyle QPainterPathStroker::joinStyle() const
 */
 void QPainterPathStroker::setMiterLimit(qreal limit)
 {
-    d_func()->stroker.setMiterLimit(qt_real_to_fixed(limit));
+    Q_D(QPainterPathStroker);
+    d->stroker.setMiterLimit(qt_real_to_fixed(limit));
+    d->invalidateCache();
 }
 
 /*!
@@ -2735,7 +2751,9 @@ qreal QPainterPathStroker::miterLimit() const
 */
 void QPainterPathStroker::setCurveThreshold(qreal threshold)
 {
-    d_func()->stroker.setCurveThreshold(qt_real_to_fixed(threshold));
+    Q_D(QPainterPathStroker);
+    d->stroker.setCurveThreshold(qt_real_to_fixed(threshold));
+    d->invalidateCache();
 }
 
 /*!
@@ -2752,7 +2770,9 @@ qreal QPainterPathStroker::curveThreshold() const
 */
 void QPainterPathStroker::setDashPattern(Qt::PenStyle style)
 {
-    d_func()->dashPattern = QDashStroker::patternForStyle(style);
+    Q_D(QPainterPathStroker);
+    d->dashPattern = QDashStroker::patternForStyle(style);
+    d->invalidateCache();
 }
 
 /*!
@@ -2773,9 +2793,11 @@ void QPainterPathStroker::setDashPattern(Qt::PenStyle style)
 */
 void QPainterPathStroker::setDashPattern(const QVector<qreal> &dashPattern)
 {
-    d_func()->dashPattern.clear();
+    Q_D(QPainterPathStroker);
+    d->dashPattern.clear();
     for (int i=0; i<dashPattern.size(); ++i)
-        d_func()->dashPattern << qt_real_to_fixed(dashPattern.at(i));
+        d->dashPattern << qt_real_to_fixed(dashPattern.at(i));
+    d->invalidateCache();
 }
 
 /*!
@@ -2802,7 +2824,9 @@ qreal QPainterPathStroker::dashOffset() const
  */
 void QPainterPathStroker::setDashOffset(qreal offset)
 {
-    d_func()->dashOffset = offset;
+    Q_D(QPainterPathStroker);
+    d->dashOffset = offset;
+    d->invalidateCache();
 }
 
 /*!
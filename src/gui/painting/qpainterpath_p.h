@@ -92,9 +92,22 @@ class QPainterPathStrokerPrivate
 public:
     QPainterPathStrokerPrivate();
 
+    void invalidateCache()
+    {
+        cachedPath = QPainterPath();
+        cachedStroke = QPainterPath();
+    }
+
     QStroker stroker;
+    QDashStroker dasher;
     QVector<qfixed> dashPattern;
     qreal dashOffset;
+
+    // The last path passed to createStroke() and its outline. The path is
+    // kept referenced, so any change to the caller's copy detaches it.
+    QPainterPath cachedPath;
+    QPainterPath cachedStroke;
+    QRectF cachedClipRect;
 };
 
 class QPolygonF;
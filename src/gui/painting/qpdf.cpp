@@ -1498,6 +1498,7 @@ bool QPdfEngine::begin(QPaintDevice *pdev)
 
     d->pages.clear();
     d->imageCache.clear();
+    d->imageContentCache.clear();
     d->alphaCache.clear();
 
     setActive(true);
@@ -2660,6 +2661,22 @@ static inline bool is_monochrome(const QVector<QRgb> &colorTable)
         ;
 }
 
+// Identifies an image by its contents, so that separately loaded copies
+// of the same image are only embedded once.
+static QByteArray imageContentKey(const QImage &image, bool bitmap)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const int header[] = { image.width(), image.height(), int(image.format()), int(bitmap) };
+    hash.addData(reinterpret_cast<const char *>(header), sizeof(header));
+    const QVector<QRgb> colorTable = image.colorTable();
+    hash.addData(reinterpret_cast<const char *>(colorTable.constData()),
+                 colorTable.size() * int(sizeof(QRgb)));
+    const int bytesPerLine = (image.width() * image.depth() + 7) >> 3;
+    for (int y = 0; y < image.height(); ++y)
+        hash.addData(reinterpret_cast<const char *>(image.constScanLine(y)), bytesPerLine);
+    return hash.result();
+}
+
 /*!
  * Adds an image to the pdf and return the pdf-object id. Returns -1 if adding the image failed.
  */
@@ -2672,6 +2689,14 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, qint64 serial_n
     if(object)
         return object;
 
+    const QByteArray contentKey = imageContentKey(img, *bitmap);
+    object = imageContentCache.value(contentKey);
+    if (object) {
+        *bitmap = *bitmap && img.depth() == 1 && is_monochrome(img.colorTable());
+        imageCache.insert(serial_no, object);
+        return object;
+    }
+
     QImage image = img;
     QImage::Format format = image.format();
 
@@ -2802,6 +2827,7 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, qint64 serial_n
                             maskObject, softMaskObject, dct);
     }
     imageCache.insert(serial_no, object);
+    imageContentCache.insert(contentKey, object);
     return object;
 }
 
@@ -325,6 +325,7 @@ private:
     int pageRoot, catalog, info, graphicsState, patternColorSpace;
     QVector<uint> pages;
     QHash<qint64, uint> imageCache;
+    QHash<QByteArray, uint> imageContentCache;
     QHash<QPair<uint, uint>, uint > alphaCache;
 };
 
@@ -48,6 +48,7 @@
 #include "qbitmap.h"
 
 #include <private/qdebug_p.h>
+#include <private/qsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -2113,6 +2114,30 @@ static void miIntersectO(QRegionPrivate &dest, const QRect *r1, const QRect *r1E
  *
  *-----------------------------------------------------------------------
  */
+/*
+ * Returns \c true if the \a count boxes at \a a and \a b have the same
+ * horizontal extents, pairwise.
+ */
+static inline bool bandsHaveSameColumns(const QRect *a, const QRect *b, int count)
+{
+    int i = 0;
+#ifdef __SSE2__
+    // A QRect is laid out as x1, y1, x2, y2, so one compare tests both x1 and
+    // x2 of a box; the bytes of the y coordinates are masked out.
+    for (; i < count; ++i) {
+        const __m128i boxA = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i boxB = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi32(boxA, boxB)) & 0x0f0f) != 0x0f0f)
+            return false;
+    }
+#endif
+    for (; i < count; ++i) {
+        if (a[i].left() != b[i].left() || a[i].right() != b[i].right())
+            return false;
+    }
+    return true;
+}
+
 static int miCoalesce(QRegionPrivate &dest, int prevStart, int curStart)
 {
     QRect *pPrevBox;   /* Current box in previous band */
@@ -2166,19 +2191,12 @@ static int miCoalesce(QRegionPrivate &dest, int prevStart, int curStart)
              * cover the most area possible. I.e. two boxes in a band must
              * have some horizontal space between them.
              */
-            do {
-                if (pPrevBox->left() != pCurBox->left() || pPrevBox->right() != pCurBox->right()) {
-                     // The bands don't line up so they can't be coalesced.
-                    return curStart;
-                }
-                ++pPrevBox;
-                ++pCurBox;
-                --prevNumRects;
-            } while (prevNumRects != 0);
+            if (!bandsHaveSameColumns(pPrevBox, pCurBox, curNumRects)) {
+                // The bands don't line up so they can't be coalesced.
+                return curStart;
+            }
 
             dest.numRects -= curNumRects;
-            pCurBox -= curNumRects;
-            pPrevBox -= curNumRects;
 
             /*
              * The bands may be merged, so set the bottom y of each box
@@ -2281,7 +2299,15 @@ static void miRegionOp(QRegionPrivate &dest,
 
     dest.vectorize();
 
-    QVector<QRect> oldRects = dest.rects;
+    /*
+     * If dest is one of the source regions, its rectangles must stay alive
+     * until the end, so move them aside instead of sharing them; otherwise
+     * the resize below would detach and copy rectangles that are about to be
+     * overwritten anyway. A dest that is not a source keeps its buffer.
+     */
+    QVector<QRect> oldRects;
+    if (&dest == reg1 || &dest == reg2)
+        oldRects.swap(dest.rects);
 
     dest.numRects = 0;
 
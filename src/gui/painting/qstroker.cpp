@@ -117,8 +117,9 @@ private:
 class QSubpathFlatIterator
 {
 public:
-    QSubpathFlatIterator(const QDataBuffer<QStrokerOps::Element> *path, qreal threshold)
-        : m_path(path), m_pos(0), m_curve_index(-1), m_curve_threshold(threshold) { }
+    QSubpathFlatIterator(const QDataBuffer<QStrokerOps::Element> *path, qreal threshold,
+                         QDataBuffer<QPointF> *curve)
+        : m_path(path), m_pos(0), m_curve(curve), m_curve_index(-1), m_curve_threshold(threshold) { }
 
     inline bool hasNext() const { return m_curve_index >= 0 || m_pos < m_path->size(); }
 
@@ -128,11 +129,11 @@ public:
 
         if (m_curve_index >= 0) {
             QStrokerOps::Element e = { QPainterPath::LineToElement,
-                                       qt_real_to_fixed(m_curve.at(m_curve_index).x()),
-                                       qt_real_to_fixed(m_curve.at(m_curve_index).y())
+                                       qt_real_to_fixed(m_curve->at(m_curve_index).x()),
+                                       qt_real_to_fixed(m_curve->at(m_curve_index).y())
                                        };
             ++m_curve_index;
-            if (m_curve_index >= m_curve.size())
+            if (m_curve_index >= m_curve->size())
                 m_curve_index = -1;
             return e;
         }
@@ -142,18 +143,21 @@ public:
             Q_ASSERT(m_pos > 0);
             Q_ASSERT(m_pos < m_path->size());
 
-            m_curve = QBezier::fromPoints(QPointF(qt_fixed_to_real(m_path->at(m_pos-1).x),
-                                                  qt_fixed_to_real(m_path->at(m_pos-1).y)),
-                                          QPointF(qt_fixed_to_real(e.x),
-                                                  qt_fixed_to_real(e.y)),
-                                          QPointF(qt_fixed_to_real(m_path->at(m_pos+1).x),
-                                                  qt_fixed_to_real(m_path->at(m_pos+1).y)),
-                                          QPointF(qt_fixed_to_real(m_path->at(m_pos+2).x),
-                                                  qt_fixed_to_real(m_path->at(m_pos+2).y))).toPolygon(m_curve_threshold);
+            const QPointF start(qt_fixed_to_real(m_path->at(m_pos-1).x),
+                                qt_fixed_to_real(m_path->at(m_pos-1).y));
+            m_curve->reset();
+            m_curve->add(start);
+            QBezier::fromPoints(start,
+                                QPointF(qt_fixed_to_real(e.x),
+                                        qt_fixed_to_real(e.y)),
+                                QPointF(qt_fixed_to_real(m_path->at(m_pos+1).x),
+                                        qt_fixed_to_real(m_path->at(m_pos+1).y)),
+                                QPointF(qt_fixed_to_real(m_path->at(m_pos+2).x),
+                                        qt_fixed_to_real(m_path->at(m_pos+2).y))).addToPolygon(*m_curve, m_curve_threshold);
             m_curve_index = 1;
             e.type = QPainterPath::LineToElement;
-            e.x = m_curve.at(0).x();
-            e.y = m_curve.at(0).y();
+            e.x = m_curve->at(0).x();
+            e.y = m_curve->at(0).y();
             m_pos += 2;
         }
         Q_ASSERT(e.isLineTo() || e.isMoveTo());
@@ -164,7 +168,7 @@ public:
 private:
     const QDataBuffer<QStrokerOps::Element> *m_path;
     int m_pos;
-    QPolygonF m_curve;
+    QDataBuffer<QPointF> *m_curve;
     int m_curve_index;
     qreal m_curve_threshold;
 };
@@ -1016,7 +1020,7 @@ static inline void qdashstroker_cubicTo(qfixed, qfixed, qfixed, qfixed, qfixed,
  * QDashStroker members
  */
 QDashStroker::QDashStroker(QStroker *stroker)
-    : m_stroker(stroker), m_dashOffset(0), m_stroke_width(1), m_miter_limit(1)
+    : m_stroker(stroker), m_flattenedCurve(0), m_dashOffset(0), m_stroke_width(1), m_miter_limit(1)
 {
     if (m_stroker) {
         setMoveToHook(qdashstroker_moveTo);
@@ -1147,7 +1151,7 @@ void QDashStroker::processCurrentSubpath()
 
     QLineF cline;
 
-    QSubpathFlatIterator it(&m_elements, m_dashThreshold);
+    QSubpathFlatIterator it(&m_elements, m_dashThreshold, &m_flattenedCurve);
     qfixed2d prev = it.next();
 
     bool clipping = !m_clip_rect.isEmpty();
@@ -208,9 +208,18 @@ public:
     QStroker();
     ~QStroker();
 
-    void setStrokeWidth(qfixed width) { m_strokeWidth = width; m_curveThreshold = qt_real_to_fixed(width > 4 ? 1.0/width : 0.25); }
+    void setStrokeWidth(qfixed width) { m_strokeWidth = width; setCurveThresholdForScale(1); }
     qfixed strokeWidth() const { return m_strokeWidth; }
 
+    // Offset curves are accurate to about half a unit once the stroke is
+    // scaled by scale, so strokes that are scaled up stay smooth and strokes
+    // that are scaled down are not split more than they need to be.
+    void setCurveThresholdForScale(qreal scale)
+    {
+        const qreal width = qt_fixed_to_real(m_strokeWidth) * scale;
+        m_curveThreshold = qt_real_to_fixed(width > 4 ? 1.0/width : 0.25);
+    }
+
     void setCapStyle(Qt::PenCapStyle capStyle) { m_capStyle = joinModeForCap(capStyle); }
     Qt::PenCapStyle capStyle() const { return capForJoinMode(m_capStyle); }
     LineJoinMode capStyleMode() const { return m_capStyle; }
@@ -275,6 +284,7 @@ protected:
     void processCurrentSubpath() override;
 
     QStroker *m_stroker;
+    QDataBuffer<QPointF> m_flattenedCurve; // scratch space, reused across subpaths
     QVector<qfixed> m_dashPattern;
     qreal m_dashOffset;
 
@@ -38,6 +38,9 @@
 ****************************************************************************/
 
 #include <qmath.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
 
 #include "qtextureglyphcache_p.h"
 #include "private/qfontengine_p.h"
@@ -47,6 +50,65 @@ QT_BEGIN_NAMESPACE
 
 // #define CACHE_DEBUG
 
+// Below this many pending glyphs, rasterizing on the calling thread is
+// cheaper than loading the font again in the worker threads.
+static const int qt_minimumGlyphsPerRasterizationTask = 32;
+
+static QImage rasterizeGlyph(QFontEngine *fontEngine, QFontEngine::GlyphFormat format,
+                             glyph_t g, QFixed subPixelPosition, const QTransform &transform)
+{
+    switch (format) {
+    case QFontEngine::Format_A32:
+        return fontEngine->alphaRGBMapForGlyph(g, subPixelPosition, transform);
+    case QFontEngine::Format_ARGB:
+        return fontEngine->bitmapForGlyph(g, subPixelPosition, transform);
+    default:
+        return fontEngine->alphaMapForGlyph(g, subPixelPosition, transform);
+    }
+}
+
+#ifndef QT_NO_THREAD
+class QGlyphRasterizationTask : public QRunnable
+{
+public:
+    QGlyphRasterizationTask(const QFontEngine *fontEngine, QFontEngine::GlyphFormat format,
+                            const QTransform &transform,
+                            const QList<QTextureGlyphCache::GlyphAndSubPixelPosition> *glyphs,
+                            QImage *images, int start, int count, QSemaphore *done)
+        : m_fontEngine(fontEngine), m_format(format), m_transform(transform),
+          m_glyphs(glyphs), m_images(images), m_start(start), m_count(count), m_done(done)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        // The clone has to be created and destroyed on this thread. If it
+        // cannot be created, the images stay null and the glyphs are
+        // rasterized on the calling thread instead.
+        QScopedPointer<QFontEngine> fontEngine(m_fontEngine->cloneForThread());
+        if (!fontEngine.isNull()) {
+            for (int i = m_start; i < m_start + m_count; ++i) {
+                const QTextureGlyphCache::GlyphAndSubPixelPosition &g = m_glyphs->at(i);
+                m_images[i] = rasterizeGlyph(fontEngine.data(), m_format, g.glyph,
+                                             g.subPixelPosition, m_transform);
+            }
+        }
+        m_done->release();
+    }
+
+private:
+    const QFontEngine *m_fontEngine;
+    QFontEngine::GlyphFormat m_format;
+    QTransform m_transform;
+    const QList<QTextureGlyphCache::GlyphAndSubPixelPosition> *m_glyphs;
+    QImage *m_images;
+    int m_start;
+    int m_count;
+    QSemaphore *m_done;
+};
+#endif
+
 // out-of-line to avoid vtable duplication, breaking e.g. RTTI
 QTextureGlyphCache::~QTextureGlyphCache()
 {
@@ -246,6 +308,8 @@ void QTextureGlyphCache::fillInPendingGlyphs()
             resizeCache(qNextPowerOfTwo(requiredWidth - 1), qNextPowerOfTwo(requiredHeight - 1));
     }
 
+    rasterizePendingGlyphs();
+
     beginFillTexture();
     {
         QHash<GlyphAndSubPixelPosition, Coord>::iterator iter = m_pendingGlyphs.begin();
@@ -259,18 +323,60 @@ void QTextureGlyphCache::fillInPendingGlyphs()
     endFillTexture();
 
     m_pendingGlyphs.clear();
+    m_rasterizedGlyphs.clear();
+}
+
+/*
+    Rasterizes the pending glyphs on the global thread pool when there are
+    enough of them and the font engine can be cloned for other threads, so
+    that fillTexture() only has to copy the results into the texture.
+*/
+void QTextureGlyphCache::rasterizePendingGlyphs()
+{
+#ifndef QT_NO_THREAD
+    const int glyphCount = m_pendingGlyphs.size();
+    if (glyphCount < 2 * qt_minimumGlyphsPerRasterizationTask
+            || !m_current_fontengine->supportsThreadedRasterization()) {
+        return;
+    }
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int taskCount = qMin(pool->maxThreadCount(), glyphCount / qt_minimumGlyphsPerRasterizationTask);
+    if (taskCount < 2)
+        return;
+
+    const QList<GlyphAndSubPixelPosition> glyphs = m_pendingGlyphs.keys();
+    QVector<QImage> images(glyphCount);
+
+    QSemaphore done;
+    const int glyphsPerTask = (glyphCount + taskCount - 1) / taskCount;
+    int startedTasks = 0;
+    for (int start = 0; start < glyphCount; start += glyphsPerTask) {
+        const int count = qMin(glyphsPerTask, glyphCount - start);
+        QGlyphRasterizationTask *task = new QGlyphRasterizationTask(m_current_fontengine, m_format, m_transform,
+                                                                    &glyphs, images.data(), start, count, &done);
+        if (!pool->tryStart(task))
+            delete task; // rasterized by textureMapForGlyph() instead
+        else
+            ++startedTasks;
+    }
+    done.acquire(startedTasks);
+
+    for (int i = 0; i < glyphCount; ++i) {
+        if (!images.at(i).isNull())
+            m_rasterizedGlyphs.insert(glyphs.at(i), images.at(i));
+    }
+#endif
 }
 
 QImage QTextureGlyphCache::textureMapForGlyph(glyph_t g, QFixed subPixelPosition) const
 {
-    switch (m_format) {
-    case QFontEngine::Format_A32:
-        return m_current_fontengine->alphaRGBMapForGlyph(g, subPixelPosition, m_transform);
-    case QFontEngine::Format_ARGB:
-        return m_current_fontengine->bitmapForGlyph(g, subPixelPosition, m_transform);
-    default:
-        return m_current_fontengine->alphaMapForGlyph(g, subPixelPosition, m_transform);
+    if (!m_rasterizedGlyphs.isEmpty()) {
+        const QImage image = m_rasterizedGlyphs.value(GlyphAndSubPixelPosition(g, subPixelPosition));
+        if (!image.isNull())
+            return image;
     }
+    return rasterizeGlyph(m_current_fontengine, m_format, g, subPixelPosition, m_transform);
 }
 
 /************************************************************************
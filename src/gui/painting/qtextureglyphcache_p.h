@@ -145,9 +145,11 @@ public:
 
 protected:
     int calculateSubPixelPositionCount(glyph_t) const;
+    void rasterizePendingGlyphs();
 
     QFontEngine *m_current_fontengine;
     QHash<GlyphAndSubPixelPosition, Coord> m_pendingGlyphs;
+    QHash<GlyphAndSubPixelPosition, QImage> m_rasterizedGlyphs;
 
     int m_w; // image width
     int m_h; // image height
@@ -1788,6 +1788,17 @@ quint64 Selector::pseudoClass(quint64 *negated) const
 
 ///////////////////////////////////////////////////////////////////////////////
 // StyleSheet
+static QString firstClassName(const BasicSelector &sel)
+{
+    for (const AttributeSelector &a : sel.attributeSelectors) {
+        if (a.valueMatchCriterium == AttributeSelector::MatchIncludes
+            && a.name == QLatin1String("class")
+            && !a.value.isEmpty() && !a.value.contains(QLatin1Char(' ')))
+            return a.value;
+    }
+    return QString();
+}
+
 void StyleSheet::buildIndexes(Qt::CaseSensitivity nameCaseSensitivity)
 {
     QVector<StyleRule> universals;
@@ -1825,7 +1836,18 @@ void StyleSheet::buildIndexes(Qt::CaseSensitivity nameCaseSensitivity)
                     name = std::move(name).toLower();
                 nameIndex.insert(name, nr);
             } else {
-                universalsSelectors += selector;
+                // index ".foo" selectors by their first class name so that
+                // they do not have to be matched against every node
+                const QString className = firstClassName(sel);
+                if (!className.isEmpty()) {
+                    StyleRule nr;
+                    nr.selectors += selector;
+                    nr.declarations = rule.declarations;
+                    nr.order = i;
+                    classIndex.insert(className, nr);
+                } else {
+                    universalsSelectors += selector;
+                }
             }
         }
         if (!universalsSelectors.isEmpty()) {
@@ -2035,6 +2057,25 @@ QVector<StyleRule> StyleSelector::styleRulesForNode(NodePtr node)
                 }
             }
         }
+        if (!styleSheet.classIndex.isEmpty() && hasAttributes(node)) {
+            const QString classes = attribute(node, QLatin1String("class"));
+            const auto classNames = classes.splitRef(QLatin1Char(' '), QString::SkipEmptyParts);
+            for (int i = 0; i < classNames.count(); i++) {
+                const QStringRef &className = classNames.at(i);
+                // a node listing the same class twice must not match its rules twice
+                bool seen = false;
+                for (int j = 0; j < i && !seen; j++)
+                    seen = classNames.at(j) == className;
+                if (seen)
+                    continue;
+                const QString key = className.toString();
+                QMultiHash<QString, StyleRule>::const_iterator it = styleSheet.classIndex.constFind(key);
+                while (it != styleSheet.classIndex.constEnd() && it.key() == key) {
+                    matchRule(node, it.value(), styleSheet.origin, styleSheet.depth, &weightedRules);
+                    ++it;
+                }
+            }
+        }
         if (!medium.isEmpty()) {
             for (int i = 0; i < styleSheet.mediaRules.count(); ++i) {
                 if (styleSheet.mediaRules.at(i).media.contains(medium, Qt::CaseInsensitive)) {
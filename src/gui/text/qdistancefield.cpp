@@ -42,6 +42,10 @@
 #include <private/qdatabuffer_p.h>
 #include <private/qimage_p.h>
 #include <private/qpathsimplifier_p.h>
+#include <qvarlengtharray.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -940,31 +944,139 @@ glyph_t QDistanceField::glyph() const
     return d->glyph;
 }
 
-void QDistanceField::setGlyph(const QRawFont &font, glyph_t glyph, bool doubleResolution)
+static QPainterPath distanceFieldPath(const QRawFont &renderFont, glyph_t glyph)
 {
-    QRawFont renderFont = font;
-    renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * QT_DISTANCEFIELD_SCALE(doubleResolution));
-
     QPainterPath path = renderFont.pathForGlyph(glyph);
     path.translate(-path.boundingRect().topLeft());
     path.setFillRule(Qt::WindingFill);
-
-    d = QDistanceFieldData::create(path, doubleResolution);
-    d->glyph = glyph;
+    return path;
 }
 
-void QDistanceField::setGlyph(QFontEngine *fontEngine, glyph_t glyph, bool doubleResolution)
+static QPainterPath distanceFieldPath(QFontEngine *fontEngine, glyph_t glyph)
 {
     QFixedPoint position;
     QPainterPath path;
     fontEngine->addGlyphsToPath(&glyph, &position, 1, &path, 0);
     path.translate(-path.boundingRect().topLeft());
     path.setFillRule(Qt::WindingFill);
+    return path;
+}
+
+void QDistanceField::setGlyph(const QRawFont &font, glyph_t glyph, bool doubleResolution)
+{
+    QRawFont renderFont = font;
+    renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * QT_DISTANCEFIELD_SCALE(doubleResolution));
 
-    d = QDistanceFieldData::create(path, doubleResolution);
+    d = QDistanceFieldData::create(distanceFieldPath(renderFont, glyph), doubleResolution);
     d->glyph = glyph;
 }
 
+void QDistanceField::setGlyph(QFontEngine *fontEngine, glyph_t glyph, bool doubleResolution)
+{
+    d = QDistanceFieldData::create(distanceFieldPath(fontEngine, glyph), doubleResolution);
+    d->glyph = glyph;
+}
+
+#ifndef QT_NO_THREAD
+class QDistanceFieldTask : public QRunnable
+{
+public:
+    QDistanceFieldTask(const QVector<QPainterPath> &paths, QDistanceFieldData **results,
+                       int start, int count, bool doubleResolution, QSemaphore *done)
+        : m_paths(paths), m_results(results), m_start(start), m_count(count),
+          m_doubleResolution(doubleResolution), m_done(done)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = m_start; i < m_start + m_count; ++i)
+            m_results[i] = QDistanceFieldData::create(m_paths.at(i), m_doubleResolution);
+        m_done->release();
+    }
+
+private:
+    const QVector<QPainterPath> &m_paths;
+    QDistanceFieldData **m_results;
+    int m_start;
+    int m_count;
+    bool m_doubleResolution;
+    QSemaphore *m_done;
+};
+#endif
+
+/*
+    Renders the distance fields of \a glyphs. The outlines are extracted on
+    the calling thread, since font engines are not thread-safe, while the
+    fields themselves are computed on the global thread pool.
+*/
+QVector<QDistanceField> QDistanceField::renderGlyphs(const QRawFont &font, const QVector<glyph_t> &glyphs,
+                                                     bool doubleResolution)
+{
+    QRawFont renderFont = font;
+    renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * QT_DISTANCEFIELD_SCALE(doubleResolution));
+
+    QVector<QPainterPath> paths;
+    paths.reserve(glyphs.size());
+    for (glyph_t glyph : glyphs)
+        paths.append(distanceFieldPath(renderFont, glyph));
+    return renderPaths(paths, glyphs, doubleResolution);
+}
+
+QVector<QDistanceField> QDistanceField::renderGlyphs(QFontEngine *fontEngine, const QVector<glyph_t> &glyphs,
+                                                     bool doubleResolution)
+{
+    QVector<QPainterPath> paths;
+    paths.reserve(glyphs.size());
+    for (glyph_t glyph : glyphs)
+        paths.append(distanceFieldPath(fontEngine, glyph));
+    return renderPaths(paths, glyphs, doubleResolution);
+}
+
+QVector<QDistanceField> QDistanceField::renderPaths(const QVector<QPainterPath> &paths, const QVector<glyph_t> &glyphs,
+                                                    bool doubleResolution)
+{
+    const int count = paths.size();
+    QVarLengthArray<QDistanceFieldData *> results(count);
+    for (int i = 0; i < count; ++i)
+        results[i] = 0;
+
+#ifndef QT_NO_THREAD
+    // reads the environment on this thread, before the workers need the factors
+    initialDistanceFieldFactor();
+
+    // a task per few glyphs keeps the threads busy without much overhead
+    const int glyphsPerTask = 8;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    if (count > glyphsPerTask && pool->maxThreadCount() > 1) {
+        QSemaphore done;
+        int startedTasks = 0;
+        for (int start = 0; start < count; start += glyphsPerTask) {
+            QDistanceFieldTask *task = new QDistanceFieldTask(paths, results.data(), start,
+                                                              qMin(glyphsPerTask, count - start),
+                                                              doubleResolution, &done);
+            if (pool->tryStart(task))
+                ++startedTasks;
+            else
+                delete task; // rendered below instead
+        }
+        done.acquire(startedTasks);
+    }
+#endif
+
+    QVector<QDistanceField> fields;
+    fields.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QDistanceFieldData *data = results[i];
+        if (!data)
+            data = QDistanceFieldData::create(paths.at(i), doubleResolution);
+        data->glyph = glyphs.at(i);
+        fields.append(QDistanceField(data));
+    }
+    return fields;
+}
+
 int QDistanceField::width() const
 {
     return d->width;
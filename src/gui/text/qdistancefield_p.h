@@ -55,6 +55,7 @@
 #include <qrawfont.h>
 #include <private/qfontengine_p.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
 #include <QtCore/qglobal.h>
 #include <QLoggingCategory>
 
@@ -102,6 +103,11 @@ public:
     void setGlyph(const QRawFont &font, glyph_t glyph, bool doubleResolution = false);
     void setGlyph(QFontEngine *fontEngine, glyph_t glyph, bool doubleResolution = false);
 
+    static QVector<QDistanceField> renderGlyphs(const QRawFont &font, const QVector<glyph_t> &glyphs,
+                                                bool doubleResolution = false);
+    static QVector<QDistanceField> renderGlyphs(QFontEngine *fontEngine, const QVector<glyph_t> &glyphs,
+                                                bool doubleResolution = false);
+
     int width() const;
     int height() const;
 
@@ -121,6 +127,8 @@ public:
 
 private:
     QDistanceField(QDistanceFieldData *data);
+    static QVector<QDistanceField> renderPaths(const QVector<QPainterPath> &paths, const QVector<glyph_t> &glyphs,
+                                               bool doubleResolution);
     QSharedDataPointer<QDistanceFieldData> d;
 
     friend class QDistanceFieldData;
@@ -906,6 +906,13 @@ static void initializeDb()
     }
 }
 
+// used by QGuiApplicationPrivate::init() to populate the database on a background thread
+void qt_populateFontDatabase()
+{
+    QMutexLocker locker(fontDatabaseMutex());
+    initializeDb();
+}
+
 static inline void load(const QString & = QString(), int = -1)
 {
     // Only initialize the database if it has been cleared or not initialized yet
@@ -248,6 +248,8 @@ QFontEngine::QFontEngine(Type type)
     : m_type(type), ref(0),
       font_(),
       face_(),
+      m_shapingCache(0),
+      m_asciiAdvancesInitialized(false),
       m_minLeftBearing(kBearingNotInitialized),
       m_minRightBearing(kBearingNotInitialized)
 {
@@ -270,6 +272,7 @@ QFontEngine::QFontEngine(Type type)
 
 QFontEngine::~QFontEngine()
 {
+    delete m_shapingCache;
 #ifdef QT_BUILD_INTERNAL
     if (enginesCollector)
         enginesCollector->removeOne(this);
@@ -1091,6 +1094,74 @@ QFontEngineGlyphCache *QFontEngine::glyphCache(const void *context, GlyphFormat
     return Q_NULLPTR;
 }
 
+/*!
+    \internal
+
+    Returns the cache of glyph runs that QTextEngine has shaped with this
+    font engine. The cache is created on first use and has the same lifetime
+    (and thread affinity) as the font engine.
+*/
+QShapingCache *QFontEngine::shapingCache() const
+{
+    if (!m_shapingCache)
+        m_shapingCache = new QShapingCache;
+    return m_shapingCache;
+}
+
+/*!
+    \internal
+
+    Returns the advances of the printable ASCII characters, indexed by the
+    character code minus 0x20, or 0 if text cannot be measured in this font
+    engine by adding them up. That is the case when the font has tables that
+    shaping could use to substitute or reposition glyphs, or when it lacks a
+    glyph for one of the characters.
+
+    The advances are rounded the same way QTextEngine rounds shaped advances.
+*/
+const QFixed *QFontEngine::asciiAdvances() const
+{
+    if (!m_asciiAdvancesInitialized) {
+        m_asciiAdvancesInitialized = true;
+
+        static const uint shapingTables[] = {
+            MAKE_TAG('G', 'S', 'U', 'B'),
+            MAKE_TAG('G', 'P', 'O', 'S'),
+            MAKE_TAG('k', 'e', 'r', 'n'),
+            MAKE_TAG('k', 'e', 'r', 'x'),
+            MAKE_TAG('m', 'o', 'r', 't'),
+            MAKE_TAG('m', 'o', 'r', 'x')
+        };
+        for (uint tag : shapingTables) {
+            uint length = 0;
+            if (getSfntTableData(tag, 0, &length) && length > 0)
+                return 0;
+        }
+
+        const int count = 0x7f - 0x20;
+        glyph_t glyphs[count];
+        QFixed advances[count];
+        for (int i = 0; i < count; ++i) {
+            glyphs[i] = glyphIndex(0x20 + i);
+            if (glyphs[i] == 0)
+                return 0;
+        }
+
+        QGlyphLayout g;
+        g.numGlyphs = count;
+        g.glyphs = glyphs;
+        g.advances = advances;
+        recalcAdvances(&g, 0);
+
+        const bool roundAdvances = !supportsSubPixelPositions()
+                || (fontDef.styleStrategy & QFont::ForceIntegerMetrics);
+        m_asciiAdvances.resize(count);
+        for (int i = 0; i < count; ++i)
+            m_asciiAdvances[i] = roundAdvances ? advances[i].round() : advances[i];
+    }
+    return m_asciiAdvances.isEmpty() ? 0 : m_asciiAdvances.constData();
+}
+
 static inline QFixed kerning(int left, int right, const QFontEngine::KernPair *pairs, int numPairs)
 {
     uint left_right = (left << 16) + right;
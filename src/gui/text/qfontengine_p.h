@@ -236,6 +236,11 @@ public:
 
     virtual QFontEngine *cloneWithSize(qreal /*pixelSize*/) const { return 0; }
 
+    // cloneForThread() is called on the thread that will use the clone and must
+    // return an engine that shares no rasterization state with this one
+    virtual bool supportsThreadedRasterization() const { return false; }
+    virtual QFontEngine *cloneForThread() const { return 0; }
+
     virtual Qt::HANDLE handle() const;
 
     void *harfbuzzFont() const;
@@ -254,6 +259,9 @@ public:
     void setGlyphCache(const void *key, QFontEngineGlyphCache *data);
     QFontEngineGlyphCache *glyphCache(const void *key, GlyphFormat format, const QTransform &transform) const;
 
+    QShapingCache *shapingCache() const;
+    const QFixed *asciiAdvances() const;
+
     static const uchar *getCMap(const uchar *table, uint tableSize, bool *isSymbolFont, int *cmapSize);
     static quint32 getTrueTypeGlyphIndex(const uchar *cmap, int cmapSize, uint unicode);
 
@@ -372,6 +380,9 @@ private:
     };
     typedef QLinkedList<GlyphCacheEntry> GlyphCaches;
     mutable QHash<const void *, GlyphCaches> m_glyphCaches;
+    mutable QShapingCache *m_shapingCache;
+    mutable QVector<QFixed> m_asciiAdvances;
+    mutable bool m_asciiAdvancesInitialized;
 
 private:
     QVariant m_userData;
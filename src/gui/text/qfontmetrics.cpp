@@ -52,6 +52,49 @@ extern void qt_format_text(const QFont& font, const QRectF &_r,
                            int tabStops, int *tabArray, int tabArrayLen,
                            QPainter *painter);
 
+static inline QFontEngine *primaryEngine(QFontEngine *engine)
+{
+    if (engine->type() == QFontEngine::Multi)
+        return static_cast<QFontEngineMulti *>(engine)->engine(0);
+    return engine;
+}
+
+/*
+    Measures text that only consists of printable ASCII characters by adding
+    up cached advances instead of shaping it. This gives the same result as
+    QTextEngine when the font has nothing shaping would apply to the text,
+    see QFontEngine::asciiAdvances().
+*/
+static bool qt_asciiTextWidth(QFontPrivate *d, const QChar *text, int len, QFixed *width)
+{
+    if (d->capital != QFont::MixedCase || d->letterSpacing != 0 || d->wordSpacing != 0
+            || (d->request.styleStrategy & QFont::PreferNoShaping)) {
+        return false;
+    }
+
+    for (int i = 0; i < len; ++i) {
+        const ushort uc = text[i].unicode();
+        if (uc < 0x20 || uc > 0x7e)
+            return false;
+    }
+
+    // letters and punctuation on its own are itemized into different
+    // scripts, so both have to resolve to the same font
+    QFontEngine *engine = primaryEngine(d->engineForScript(QChar::Script_Latin));
+    if (engine != primaryEngine(d->engineForScript(QChar::Script_Common)))
+        return false;
+
+    const QFixed *advances = engine->asciiAdvances();
+    if (!advances)
+        return false;
+
+    QFixed w;
+    for (int i = 0; i < len; ++i)
+        w += advances[text[i].unicode() - 0x20];
+    *width = w;
+    return true;
+}
+
 /*****************************************************************************
   QFontMetrics member functions
  *****************************************************************************/
@@ -557,6 +600,10 @@ int QFontMetrics::width(const QString &text, int len, int flags) const
     }
 #endif
 
+    QFixed asciiWidth;
+    if (qt_asciiTextWidth(d.data(), text.constData(), len, &asciiWidth))
+        return qRound(asciiWidth);
+
     QStackTextEngine layout(text, QFont(d.data()));
     return qRound(layout.width(0, len));
 }
@@ -1411,6 +1458,10 @@ qreal QFontMetricsF::width(const QString &text) const
     int pos = text.indexOf(QLatin1Char('\x9c'));
     int len = (pos != -1) ? pos : text.length();
 
+    QFixed asciiWidth;
+    if (qt_asciiTextWidth(d.data(), text.constData(), len, &asciiWidth))
+        return asciiWidth.toReal();
+
     QStackTextEngine layout(text, QFont(d.data()));
     layout.itemize();
     return layout.width(0, len).toReal();
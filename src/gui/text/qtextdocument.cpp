@@ -488,6 +488,43 @@ bool QTextDocument::isUndoRedoEnabled() const
     return d->isUndoRedoEnabled();
 }
 
+/*!
+    \property QTextDocument::maximumUndoSteps
+    \since 5.11
+    \brief the maximum number of steps kept in the undo stack
+
+    When more steps are added to the undo stack, the oldest ones are
+    removed. A step is a single edit, or all edits made between
+    QTextCursor::beginEditBlock() and QTextCursor::endEditBlock().
+
+    The text that a removed step was needed for is freed the next time
+    the document compacts its text buffer, so that the memory used by the
+    undo history of a long-running editor does not keep growing.
+
+    A negative or zero value means that the number of undo steps is not
+    limited. The default value is 0.
+
+    Setting this property applies the limit to the existing undo stack.
+
+    \sa undoRedoEnabled, availableUndoSteps()
+*/
+int QTextDocument::maximumUndoSteps() const
+{
+    Q_D(const QTextDocument);
+    return d->maximumUndoSteps;
+}
+
+void QTextDocument::setMaximumUndoSteps(int maximum)
+{
+    Q_D(QTextDocument);
+    d->maximumUndoSteps = maximum;
+    if (d->editBlock)
+        return; // applied when the edit block ends
+    d->ensureMaximumUndoSteps();
+    d->compressPieceTable();
+    d->emitUndoAvailable(d->isUndoAvailable());
+}
+
 /*!
     \property QTextDocument::maximumBlockCount
     \since 4.2
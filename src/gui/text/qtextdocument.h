@@ -111,6 +111,7 @@ class Q_GUI_EXPORT QTextDocument : public QObject
     Q_PROPERTY(QString defaultStyleSheet READ defaultStyleSheet WRITE setDefaultStyleSheet)
 #endif
     Q_PROPERTY(int maximumBlockCount READ maximumBlockCount WRITE setMaximumBlockCount)
+    Q_PROPERTY(int maximumUndoSteps READ maximumUndoSteps WRITE setMaximumUndoSteps)
     Q_PROPERTY(qreal documentMargin READ documentMargin WRITE setDocumentMargin)
     QDOC_PROPERTY(QTextOption defaultTextOption READ defaultTextOption WRITE setDefaultTextOption)
     Q_PROPERTY(QUrl baseUrl READ baseUrl WRITE setBaseUrl NOTIFY baseUrlChanged)
@@ -134,6 +135,9 @@ public:
     int availableUndoSteps() const;
     int availableRedoSteps() const;
 
+    int maximumUndoSteps() const;
+    void setMaximumUndoSteps(int maximum);
+
     int revision() const;
 
     void setDocumentLayout(QAbstractTextDocumentLayout *layout);
@@ -211,6 +211,7 @@ QTextDocumentPrivate::QTextDocumentPrivate()
     documentMargin = 4;
 
     maximumBlockCount = 0;
+    maximumUndoSteps = 0;
     needsEnsureMaximumBlockCount = false;
     unreachableCharacterCount = 0;
     lastBlockCount = 0;
@@ -1092,8 +1093,70 @@ void QTextDocumentPrivate::appendUndoItem(const QTextUndoCommand &c)
     emitUndoAvailable(true);
     emitRedoAvailable(false);
 
-    if (!c.block_part)
+    if (!c.block_part) {
+        ensureMaximumUndoSteps();
         emit document()->undoCommandAdded();
+    }
+}
+
+/*
+    Frees what the undo command \a c owns before it is dropped from the undo
+    stack. Text that was removed from the document is only referenced by its
+    undo command, so it becomes garbage for compressPieceTable().
+*/
+void QTextDocumentPrivate::releaseUndoCommand(const QTextUndoCommand &c)
+{
+    switch (c.command) {
+    case QTextUndoCommand::Removed:
+        unreachableCharacterCount += c.length;
+        break;
+    case QTextUndoCommand::BlockRemoved:
+    case QTextUndoCommand::BlockDeleted:
+        ++unreachableCharacterCount;
+        break;
+    case QTextUndoCommand::Custom:
+        delete c.custom;
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+    Drops the oldest undo steps until at most maximumUndoSteps are left.
+    An undo step is either a single command or a group of commands that
+    were added in one edit block.
+*/
+void QTextDocumentPrivate::ensureMaximumUndoSteps()
+{
+    // every step has at least one command
+    if (maximumUndoSteps <= 0 || undoState <= maximumUndoSteps)
+        return;
+
+    int steps = 0;
+    for (int i = 0; i < undoState; ++i) {
+        const QTextUndoCommand &c = undoStack.at(i);
+        if (!c.block_part || c.block_end || i == undoState - 1)
+            ++steps;
+    }
+
+    int stepsToRemove = steps - maximumUndoSteps;
+    if (stepsToRemove <= 0)
+        return;
+
+    int commandsToRemove = 0;
+    while (stepsToRemove > 0) {
+        const QTextUndoCommand &c = undoStack.at(commandsToRemove++);
+        if (!c.block_part || c.block_end)
+            --stepsToRemove;
+    }
+
+    for (int i = 0; i < commandsToRemove; ++i)
+        releaseUndoCommand(undoStack.at(i));
+    undoStack.remove(0, commandsToRemove);
+    undoState -= commandsToRemove;
+    if (modifiedState != -1)
+        modifiedState = modifiedState >= commandsToRemove ? modifiedState - commandsToRemove : -1;
 }
 
 void QTextDocumentPrivate::clearUndoRedoStacks(QTextDocument::Stacks stacksToClear,
@@ -1102,33 +1165,27 @@ void QTextDocumentPrivate::clearUndoRedoStacks(QTextDocument::Stacks stacksToCle
     bool undoCommandsAvailable = undoState != 0;
     bool redoCommandsAvailable = undoState != undoStack.size();
     if (stacksToClear == QTextDocument::UndoStack && undoCommandsAvailable) {
-        for (int i = 0; i < undoState; ++i) {
-            QTextUndoCommand c = undoStack.at(undoState);
-            if (c.command & QTextUndoCommand::Custom)
-                delete c.custom;
-        }
+        for (int i = 0; i < undoState; ++i)
+            releaseUndoCommand(undoStack.at(i));
         undoStack.remove(0, undoState);
-        undoStack.resize(undoStack.size() - undoState);
+        if (modifiedState != undoState)
+            modifiedState = -1;
+        else
+            modifiedState = 0;
         undoState = 0;
         if (emitSignals)
             emitUndoAvailable(false);
     } else if (stacksToClear == QTextDocument::RedoStack
                && redoCommandsAvailable) {
-        for (int i = undoState; i < undoStack.size(); ++i) {
-            QTextUndoCommand c = undoStack.at(i);
-            if (c.command & QTextUndoCommand::Custom)
-                delete c.custom;
-        }
+        for (int i = undoState; i < undoStack.size(); ++i)
+            releaseUndoCommand(undoStack.at(i));
         undoStack.resize(undoState);
         if (emitSignals)
             emitRedoAvailable(false);
     } else if (stacksToClear == QTextDocument::UndoAndRedoStacks
                && !undoStack.isEmpty()) {
-        for (int i = 0; i < undoStack.size(); ++i) {
-            QTextUndoCommand c = undoStack.at(i);
-            if (c.command & QTextUndoCommand::Custom)
-                delete c.custom;
-        }
+        for (int i = 0; i < undoStack.size(); ++i)
+            releaseUndoCommand(undoStack.at(i));
         undoState = 0;
         undoStack.clear();
         if (emitSignals && undoCommandsAvailable)
@@ -1191,6 +1248,7 @@ void QTextDocumentPrivate::endEditBlock()
         const bool wasBlocking = !undoStack.at(undoState - 1).block_end;
         if (undoStack.at(undoState - 1).block_part) {
             undoStack[undoState - 1].block_end = true;
+            ensureMaximumUndoSteps();
             if (wasBlocking)
                 emit document()->undoCommandAdded();
         }
@@ -1250,7 +1308,7 @@ void QTextDocumentPrivate::finishEdit()
         emit q->blockCountChanged(lastBlockCount);
     }
 
-    if (!undoEnabled && unreachableCharacterCount)
+    if (unreachableCharacterCount)
         compressPieceTable();
 }
 
@@ -1656,9 +1714,6 @@ void QTextDocumentPrivate::contentsChanged()
 
 void QTextDocumentPrivate::compressPieceTable()
 {
-    if (undoEnabled)
-        return;
-
     const uint garbageCollectionThreshold = 96 * 1024; // bytes
 
     //qDebug() << "unreachable bytes:" << unreachableCharacterCount * sizeof(QChar) << " -- limit" << garbageCollectionThreshold << "text size =" << text.size() << "capacity:" << text.capacity();
@@ -1668,6 +1723,11 @@ void QTextDocumentPrivate::compressPieceTable()
     if (!compressTable)
         return;
 
+    if (undoEnabled) {
+        compressPieceTableKeepingUndoText();
+        return;
+    }
+
     QString newText;
     newText.resize(text.size());
     QChar *newTextPtr = newText.data();
@@ -1687,6 +1747,115 @@ void QTextDocumentPrivate::compressPieceTable()
     unreachableCharacterCount = 0;
 }
 
+struct QTextStringRange
+{
+    uint start;
+    uint end;
+    uint newStart;
+};
+Q_DECLARE_TYPEINFO(QTextStringRange, Q_PRIMITIVE_TYPE);
+
+static inline bool operator<(const QTextStringRange &range, uint position)
+{
+    return range.end <= position;
+}
+
+static inline uint mapStringPosition(const QVector<QTextStringRange> &ranges, uint position)
+{
+    QVector<QTextStringRange>::const_iterator range = std::lower_bound(ranges.constBegin(), ranges.constEnd(), position);
+    Q_ASSERT(range != ranges.constEnd() && range->start <= position);
+    return range->newStart + position - range->start;
+}
+
+/*
+    Like compressPieceTable(), but also keeps the text that the undo and
+    redo commands refer to. Text becomes unreachable here once the commands
+    that removed it are dropped from the stack, see releaseUndoCommand().
+*/
+void QTextDocumentPrivate::compressPieceTableKeepingUndoText()
+{
+    QVector<QTextStringRange> ranges;
+    ranges.reserve(fragments.numNodes() + undoStack.size());
+    for (FragmentMap::Iterator it = fragments.begin(); !it.atEnd(); ++it) {
+        const uint start = uint(it->stringPosition);
+        const QTextStringRange range = { start, start + it->size_array[0], 0 };
+        ranges.append(range);
+    }
+    for (const QTextUndoCommand &c : qAsConst(undoStack)) {
+        switch (c.command) {
+        case QTextUndoCommand::Inserted:
+        case QTextUndoCommand::Removed: {
+            const QTextStringRange range = { c.strPos, c.strPos + c.length, 0 };
+            ranges.append(range);
+            break;
+        }
+        case QTextUndoCommand::BlockInserted:
+        case QTextUndoCommand::BlockRemoved:
+        case QTextUndoCommand::BlockAdded:
+        case QTextUndoCommand::BlockDeleted: {
+            const QTextStringRange range = { c.strPos, c.strPos + 1, 0 };
+            ranges.append(range);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // merge overlapping and adjacent ranges
+    std::sort(ranges.begin(), ranges.end(), [](const QTextStringRange &a, const QTextStringRange &b) {
+        return a.start < b.start;
+    });
+    int merged = 0;
+    for (int i = 1; i < ranges.size(); ++i) {
+        if (ranges.at(i).start <= ranges.at(merged).end)
+            ranges[merged].end = qMax(ranges.at(merged).end, ranges.at(i).end);
+        else
+            ranges[++merged] = ranges.at(i);
+    }
+    ranges.resize(ranges.isEmpty() ? 0 : merged + 1);
+
+    uint newLen = 0;
+    for (QTextStringRange &range : ranges) {
+        range.newStart = newLen;
+        newLen += range.end - range.start;
+    }
+    if (newLen == uint(text.size())) {
+        unreachableCharacterCount = 0;
+        return;
+    }
+
+    QString newText(newLen, Qt::Uninitialized);
+    QChar *newTextPtr = newText.data();
+    for (const QTextStringRange &range : qAsConst(ranges)) {
+        memcpy(newTextPtr, text.constData() + range.start, (range.end - range.start) * sizeof(QChar));
+        newTextPtr += range.end - range.start;
+    }
+
+    for (FragmentMap::Iterator it = fragments.begin(); !it.atEnd(); ++it)
+        it->stringPosition = mapStringPosition(ranges, it->stringPosition);
+    for (QTextUndoCommand &c : undoStack) {
+        switch (c.command) {
+        case QTextUndoCommand::Inserted:
+        case QTextUndoCommand::Removed:
+            if (c.length == 0)
+                break;
+            Q_FALLTHROUGH();
+        case QTextUndoCommand::BlockInserted:
+        case QTextUndoCommand::BlockRemoved:
+        case QTextUndoCommand::BlockAdded:
+        case QTextUndoCommand::BlockDeleted:
+            c.strPos = mapStringPosition(ranges, c.strPos);
+            break;
+        default:
+            break;
+        }
+    }
+
+    text = newText;
+    unreachableCharacterCount = 0;
+}
+
 void QTextDocumentPrivate::setModified(bool m)
 {
     Q_Q(QTextDocument);
@@ -304,6 +304,9 @@ private:
     void contentsChanged();
 
     void compressPieceTable();
+    void compressPieceTableKeepingUndoText();
+    void ensureMaximumUndoSteps();
+    void releaseUndoCommand(const QTextUndoCommand &c);
 
     QString text;
     uint unreachableCharacterCount;
@@ -311,6 +314,7 @@ private:
     QVector<QTextUndoCommand> undoStack;
     bool undoEnabled;
     int undoState;
+    int maximumUndoSteps;
     int revision;
     // position in undo stack of the last setModified(false) call
     int modifiedState;
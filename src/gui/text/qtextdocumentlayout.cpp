@@ -57,6 +57,9 @@
 #include <qvarlengtharray.h>
 #include <limits.h>
 #include <qbasictimer.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
 #include "private/qfunctions_p.h"
 
 #include <algorithm>
@@ -465,6 +468,8 @@ public:
     int lastPageCount;
     qreal idealWidth;
     bool contentHasAlignment;
+    bool parallelLayout;
+    QSet<const QTextLayout *> preparedLayouts;
 
     QFixed blockIndent(const QTextBlockFormat &blockFormat) const;
 
@@ -507,8 +512,14 @@ public:
     QRectF layoutFrame(QTextFrame *f, int layoutFrom, int layoutTo, QFixed parentY = 0);
     QRectF layoutFrame(QTextFrame *f, int layoutFrom, int layoutTo, QFixed frameWidth, QFixed frameHeight, QFixed parentY = 0);
 
+    QTextOption blockTextOption(const QTextBlockFormat &blockFormat, Qt::LayoutDirection dir) const;
+    void blockMargins(const QTextBlock &bl, const QTextBlockFormat &blockFormat, Qt::LayoutDirection dir,
+                      QFixed *totalLeftMargin, QFixed *totalRightMargin) const;
     void layoutBlock(const QTextBlock &bl, int blockPosition, const QTextBlockFormat &blockFormat,
                      QTextLayoutStruct *layoutStruct, int layoutFrom, int layoutTo, const QTextBlockFormat *previousBlockFormat);
+#ifndef QT_NO_THREAD
+    void prepareBlocksInParallel(QTextFrame::Iterator it, const QTextLayoutStruct *layoutStruct, int layoutFrom, int layoutTo);
+#endif
     void layoutFlow(QTextFrame::Iterator it, QTextLayoutStruct *layoutStruct, int layoutFrom, int layoutTo, QFixed width = 0);
 
     void floatMargins(const QFixed &y, const QTextLayoutStruct *layoutStruct, QFixed *left, QFixed *right) const;
@@ -542,6 +553,7 @@ QTextDocumentLayoutPrivate::QTextDocumentLayoutPrivate()
     insideDocumentChange = false;
     idealWidth = 0;
     contentHasAlignment = false;
+    parallelLayout = false;
 }
 
 QTextFrame::Iterator QTextDocumentLayoutPrivate::frameIteratorForYPosition(QFixed y) const
@@ -2293,6 +2305,11 @@ void QTextDocumentLayoutPrivate::layoutFlow(QTextFrame::Iterator it, QTextLayout
         }
     }
 
+#ifndef QT_NO_THREAD
+    if (inRootFrame && parallelLayout)
+        prepareBlocksInParallel(it, layoutStruct, layoutFrom, layoutTo);
+#endif
+
     QTextBlockFormat previousBlockFormat = previousIt.currentBlock().blockFormat();
 
     QFixed maximumBlockWidth = 0;
@@ -2560,8 +2577,10 @@ void QTextDocumentLayoutPrivate::layoutFlow(QTextFrame::Iterator it, QTextLayout
             // #######
             //checkPoints.last().positionInFrame = q->document()->docHandle()->length();
         }
-    }
 
+        // blocks the lazy layout did not get to yet are laid out again later
+        preparedLayouts.clear();
+    }
 
     fd->currentLayoutStruct = 0;
 }
@@ -2584,6 +2603,235 @@ static inline void getLineHeightParams(const QTextBlockFormat &blockFormat, cons
     }
 }
 
+QTextOption QTextDocumentLayoutPrivate::blockTextOption(const QTextBlockFormat &blockFormat, Qt::LayoutDirection dir) const
+{
+    QTextOption option = docPrivate->defaultTextOption;
+    option.setTextDirection(dir);
+    option.setTabs( blockFormat.tabPositions() );
+
+    Qt::Alignment align = docPrivate->defaultTextOption.alignment();
+    if (blockFormat.hasProperty(QTextFormat::BlockAlignment))
+        align = blockFormat.alignment();
+    option.setAlignment(QGuiApplicationPrivate::visualAlignment(dir, align)); // for paragraph that are RTL, alignment is auto-reversed;
+
+    if (blockFormat.nonBreakableLines() || document->pageSize().width() < 0) {
+        option.setWrapMode(QTextOption::ManualWrap);
+    }
+
+    return option;
+}
+
+void QTextDocumentLayoutPrivate::blockMargins(const QTextBlock &bl, const QTextBlockFormat &blockFormat, Qt::LayoutDirection dir,
+                                              QFixed *totalLeftMargin, QFixed *totalRightMargin) const
+{
+    QFixed extraMargin;
+    if (docPrivate->defaultTextOption.flags() & QTextOption::AddSpaceForLineAndParagraphSeparators) {
+        QFontMetricsF fm(bl.charFormat().font());
+        extraMargin = QFixed::fromReal(fm.width(QChar(QChar(0x21B5))));
+    }
+
+    const QFixed indent = this->blockIndent(blockFormat);
+    *totalLeftMargin = QFixed::fromReal(blockFormat.leftMargin()) + (dir == Qt::RightToLeft ? extraMargin : indent);
+    *totalRightMargin = QFixed::fromReal(blockFormat.rightMargin()) + (dir == Qt::RightToLeft ? indent : extraMargin);
+}
+
+#ifndef QT_NO_THREAD
+
+struct QTextBlockLineBreakJob
+{
+    QTextLayout *layout;
+    QTextBlockFormat blockFormat;
+    Qt::LayoutDirection direction;
+    QFixed left; // of the lines, relative to the frame
+    QFixed right;
+    QFixed textIndent;
+    int fixedColumnWidth;
+    qreal scaling;
+};
+Q_DECLARE_TYPEINFO(QTextBlockLineBreakJob, Q_MOVABLE_TYPE);
+
+// Breaks the block into lines the same way layoutBlock() does, for a flow that
+// has no floats and no page breaks. Line positions are relative to the block,
+// so layoutBlock() only has to move the block into place afterwards.
+static void breakBlockIntoLines(const QTextBlockLineBreakJob &job)
+{
+    QTextLayout *tl = job.layout;
+    QTextOption option = tl->textOption();
+    const bool haveWordOrAnyWrapMode = (option.wrapMode() == QTextOption::WrapAtWordBoundaryOrAnywhere);
+
+    QFixed y;
+    tl->beginLayout();
+    bool firstLine = true;
+    while (1) {
+        QTextLine line = tl->createLine();
+        if (!line.isValid())
+            break;
+        line.setLeadingIncluded(true);
+
+        QFixed left = job.left;
+        QFixed right = job.right;
+        if (firstLine) {
+            if (job.direction == Qt::LeftToRight)
+                left += job.textIndent;
+            else
+                right -= job.textIndent;
+            firstLine = false;
+        }
+
+        if (job.fixedColumnWidth != -1)
+            line.setNumColumns(job.fixedColumnWidth, (right - left).toReal());
+        else
+            line.setLineWidth((right - left).toReal());
+
+        if (job.fixedColumnWidth == -1 && QFixed::fromReal(line.naturalTextWidth()) > right - left) {
+            line.setLineWidth((right - left).toReal());
+            if (QFixed::fromReal(line.naturalTextWidth()) > right - left) {
+                if (haveWordOrAnyWrapMode) {
+                    option.setWrapMode(QTextOption::WrapAnywhere);
+                    tl->setTextOption(option);
+                }
+
+                line.setLineWidth(qMax<qreal>(line.naturalTextWidth(), (right - left).toReal()));
+
+                if (haveWordOrAnyWrapMode) {
+                    option.setWrapMode(QTextOption::WordWrap);
+                    tl->setTextOption(option);
+                }
+            }
+        }
+
+        QFixed lineBreakHeight, lineHeight, lineAdjustment;
+        getLineHeightParams(job.blockFormat, line, job.scaling, &lineAdjustment, &lineBreakHeight, &lineHeight);
+
+        line.setPosition(QPointF(left.toReal(), (y - lineAdjustment).toReal()));
+        y += lineHeight;
+    }
+    tl->endLayout();
+}
+
+class QTextBlockLineBreakTask : public QRunnable
+{
+public:
+    QTextBlockLineBreakTask(const QVector<QTextBlockLineBreakJob> &jobs, int from, int to, QSemaphore *done)
+        : m_jobs(jobs), m_from(from), m_to(to), m_done(done)
+    {}
+
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = m_from; i < m_to; ++i)
+            breakBlockIntoLines(m_jobs.at(i));
+        if (m_done)
+            m_done->release();
+    }
+
+private:
+    const QVector<QTextBlockLineBreakJob> &m_jobs;
+    const int m_from;
+    const int m_to;
+    QSemaphore *m_done;
+};
+
+/*
+    Shapes and breaks the blocks that the following layoutFlow() pass is going
+    to lay out on the global thread pool. This is only possible when the
+    width available to a block does not depend on its vertical position, that
+    is when there are no floats and no page breaks in the flow. Blocks with
+    inline objects are left alone as they have to go through the document
+    layout. The vertical positions are still assigned sequentially by
+    layoutBlock().
+*/
+void QTextDocumentLayoutPrivate::prepareBlocksInParallel(QTextFrame::Iterator it, const QTextLayoutStruct *layoutStruct,
+                                                         int layoutFrom, int layoutTo)
+{
+    Q_Q(QTextDocumentLayout);
+    enum { MinimumBlocksPerTask = 16 };
+
+    if (layoutStruct->pageHeight != QFIXED_MAX || !data(layoutStruct->frame)->floats.isEmpty())
+        return;
+    const QList<QTextFrame *> childFrames = layoutStruct->frame->childFrames();
+    for (QTextFrame *frame : childFrames) {
+        if (frame->frameFormat().position() != QTextFrameFormat::InFlow)
+            return;
+    }
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxTasks = pool->maxThreadCount() + 1;
+    if (maxTasks < 2)
+        return;
+
+    // don't get ahead of the lazy layout
+    const int lastPosition = currentLazyLayoutPosition == -1 ? INT_MAX : currentLazyLayoutPosition + lazyLayoutStepSize;
+    const qreal scaling = (q->paintDevice() && q->paintDevice()->logicalDpiY() != qt_defaultDpi()) ?
+                          qreal(q->paintDevice()->logicalDpiY()) / qreal(qt_defaultDpi()) : 1;
+
+    QVector<QTextBlockLineBreakJob> jobs;
+    for (; !it.atEnd(); ++it) {
+        const QTextBlock block = it.currentBlock();
+        if (!block.isValid())
+            continue;
+        const int blockPosition = block.position();
+        if (blockPosition > lastPosition)
+            break;
+        if (!block.isVisible())
+            continue;
+        if (!layoutStruct->fullLayout && !(blockPosition + block.length() > layoutFrom && blockPosition <= layoutTo))
+            continue;
+        if (block.text().contains(QChar::ObjectReplacementCharacter))
+            continue;
+
+        QTextBlockLineBreakJob job;
+        job.layout = block.layout(); // created here, not in the worker threads
+        job.blockFormat = block.blockFormat();
+        job.direction = block.textDirection();
+        QFixed totalLeftMargin, totalRightMargin;
+        blockMargins(block, job.blockFormat, job.direction, &totalLeftMargin, &totalRightMargin);
+        job.left = totalLeftMargin;
+        job.right = layoutStruct->x_right - layoutStruct->x_left - totalRightMargin;
+        job.textIndent = QFixed::fromReal(job.blockFormat.textIndent());
+        job.fixedColumnWidth = fixedColumnWidth;
+        job.scaling = scaling;
+        job.layout->setTextOption(blockTextOption(job.blockFormat, job.direction));
+        jobs.append(job);
+    }
+
+    const int taskCount = qMin(maxTasks, jobs.size() / MinimumBlocksPerTask);
+    if (taskCount < 2)
+        return;
+
+    // QTextFormat resolves its font lazily; do that here rather than racing in the workers
+    const QTextFormatCollection *collection = docPrivate->formatCollection();
+    for (const QTextFormat &format : collection->formats) {
+        if (format.isCharFormat())
+            format.toCharFormat().font();
+    }
+
+    QSemaphore done;
+    int started = 0;
+    for (int i = 1; i < taskCount; ++i) {
+        const int from = jobs.size() * i / taskCount;
+        const int to = jobs.size() * (i + 1) / taskCount;
+        QTextBlockLineBreakTask *task = new QTextBlockLineBreakTask(jobs, from, to, &done);
+        if (pool->tryStart(task)) {
+            ++started;
+        } else {
+            // don't wait for a busy pool, which might be the one we are running in
+            task->run();
+            delete task;
+            done.acquire();
+        }
+    }
+    QTextBlockLineBreakTask(jobs, 0, jobs.size() / taskCount, 0).run();
+    done.acquire(started);
+
+    for (const QTextBlockLineBreakJob &job : qAsConst(jobs)) {
+        // drop the font engines of the worker threads
+        job.layout->engine()->resetFontEngineCache();
+        preparedLayouts.insert(job.layout);
+    }
+}
+
+#endif // QT_NO_THREAD
+
 void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosition, const QTextBlockFormat &blockFormat,
                                              QTextLayoutStruct *layoutStruct, int layoutFrom, int layoutTo, const QTextBlockFormat *previousBlockFormat)
 {
@@ -2610,38 +2858,23 @@ void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosi
 
     Qt::LayoutDirection dir = bl.textDirection();
 
-    QFixed extraMargin;
-    if (docPrivate->defaultTextOption.flags() & QTextOption::AddSpaceForLineAndParagraphSeparators) {
-        QFontMetricsF fm(bl.charFormat().font());
-        extraMargin = QFixed::fromReal(fm.width(QChar(QChar(0x21B5))));
-    }
-
-    const QFixed indent = this->blockIndent(blockFormat);
-    const QFixed totalLeftMargin = QFixed::fromReal(blockFormat.leftMargin()) + (dir == Qt::RightToLeft ? extraMargin : indent);
-    const QFixed totalRightMargin = QFixed::fromReal(blockFormat.rightMargin()) + (dir == Qt::RightToLeft ? indent : extraMargin);
+    QFixed totalLeftMargin, totalRightMargin;
+    blockMargins(bl, blockFormat, dir, &totalLeftMargin, &totalRightMargin);
 
     const QPointF oldPosition = tl->position();
     tl->setPosition(QPointF(layoutStruct->x_left.toReal(), layoutStruct->y.toReal()));
 
-    if (layoutStruct->fullLayout
-        || (blockPosition + blockLength > layoutFrom && blockPosition <= layoutTo)
-        // force relayout if we cross a page boundary
-        || (layoutStruct->pageHeight != QFIXED_MAX && layoutStruct->absoluteY() + QFixed::fromReal(tl->boundingRect().height()) > layoutStruct->pageBottom)) {
-
-        LDEBUG << " do layout";
-        QTextOption option = docPrivate->defaultTextOption;
-        option.setTextDirection(dir);
-        option.setTabs( blockFormat.tabPositions() );
+    // blocks whose lines were already broken by prepareBlocksInParallel() only need to be moved
+    const bool prepared = preparedLayouts.remove(tl);
 
-        Qt::Alignment align = docPrivate->defaultTextOption.alignment();
-        if (blockFormat.hasProperty(QTextFormat::BlockAlignment))
-            align = blockFormat.alignment();
-        option.setAlignment(QGuiApplicationPrivate::visualAlignment(dir, align)); // for paragraph that are RTL, alignment is auto-reversed;
-
-        if (blockFormat.nonBreakableLines() || document->pageSize().width() < 0) {
-            option.setWrapMode(QTextOption::ManualWrap);
-        }
+    if (!prepared
+        && (layoutStruct->fullLayout
+            || (blockPosition + blockLength > layoutFrom && blockPosition <= layoutTo)
+            // force relayout if we cross a page boundary
+            || (layoutStruct->pageHeight != QFIXED_MAX && layoutStruct->absoluteY() + QFixed::fromReal(tl->boundingRect().height()) > layoutStruct->pageBottom))) {
 
+        LDEBUG << " do layout";
+        QTextOption option = blockTextOption(blockFormat, dir);
         tl->setTextOption(option);
 
         const bool haveWordOrAnyWrapMode = (option.wrapMode() == QTextOption::WrapAtWordBoundaryOrAnywhere);
@@ -2769,7 +3002,8 @@ void QTextDocumentLayoutPrivate::layoutBlock(const QTextBlock &bl, int blockPosi
             }
             layoutStruct->y += lineHeight;
         }
-        if (layoutStruct->updateRect.isValid()
+        if (!prepared
+            && layoutStruct->updateRect.isValid()
             && blockLength > 1) {
             if (layoutFrom >= blockPosition + blockLength) {
                 // if our height didn't change and the change in the document is
@@ -3198,6 +3432,27 @@ void QTextDocumentLayout::setFixedColumnWidth(int width)
     d->fixedColumnWidth = width;
 }
 
+/*!
+    \internal
+
+    When \a enable is true, blocks of the root frame are shaped and broken into
+    lines on the global thread pool before they are positioned. This speeds
+    up the layout of large documents, such as logs, on multi-core machines.
+    Documents with floating frames or page breaks are always laid out on the
+    calling thread. The default is false.
+*/
+void QTextDocumentLayout::setParallelLayoutEnabled(bool enable)
+{
+    Q_D(QTextDocumentLayout);
+    d->parallelLayout = enable;
+}
+
+bool QTextDocumentLayout::isParallelLayoutEnabled() const
+{
+    Q_D(const QTextDocumentLayout);
+    return d->parallelLayout;
+}
+
 QRectF QTextDocumentLayout::tableCellBoundingRect(QTextTable *table, const QTextTableCell &cell) const
 {
     if (!cell.isValid())
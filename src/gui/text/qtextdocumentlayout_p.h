@@ -88,6 +88,9 @@ public:
     // internal for QTextEdit's NoWrap mode
     void setViewport(const QRectF &viewport);
 
+    void setParallelLayoutEnabled(bool enable);
+    bool isParallelLayoutEnabled() const;
+
     virtual QRectF frameBoundingRect(QTextFrame *frame) const Q_DECL_OVERRIDE;
     virtual QRectF blockBoundingRect(const QTextBlock &block) const Q_DECL_OVERRIDE;
     QRectF tableBoundingRect(QTextTable *table) const;
@@ -960,6 +960,15 @@ void QTextEngine::shapeLine(const QScriptLine &line)
 extern bool qt_useHarfbuzzNG(); // defined in qfontengine.cpp
 #endif
 
+static inline void copyGlyphs(QGlyphLayout *destination, const QGlyphLayout &source, int numGlyphs)
+{
+    memcpy(static_cast<void *>(destination->offsets), source.offsets, numGlyphs * sizeof(QFixedPoint));
+    memcpy(destination->glyphs, source.glyphs, numGlyphs * sizeof(glyph_t));
+    memcpy(static_cast<void *>(destination->advances), source.advances, numGlyphs * sizeof(QFixed));
+    memcpy(static_cast<void *>(destination->justifications), source.justifications, numGlyphs * sizeof(QGlyphJustification));
+    memcpy(destination->attributes, source.attributes, numGlyphs * sizeof(QGlyphAttributes));
+}
+
 void QTextEngine::shapeText(int item) const
 {
     Q_ASSERT(item < layoutData->items.size());
@@ -1033,74 +1042,123 @@ void QTextEngine::shapeText(int item) const
             letterSpacing *= font.d->dpi / qt_defaultDpiY();
     }
 
-    // split up the item into parts that come from different font engines
-    // k * 3 entries, array[k] == index in string, array[k + 1] == index in glyphs, array[k + 2] == engine index
-    QVector<uint> itemBoundaries;
-    itemBoundaries.reserve(24);
-
-    QGlyphLayout initialGlyphs = availableGlyphs(&si);
-    int nGlyphs = initialGlyphs.numGlyphs;
-    if (fontEngine->type() == QFontEngine::Multi || !shapingEnabled) {
-        // ask the font engine to find out which glyphs (as an index in the specific font)
-        // to use for the text in one item.
-        QFontEngine::ShaperFlags shaperFlags =
-                shapingEnabled
-                    ? QFontEngine::GlyphIndicesOnly
-                    : QFontEngine::ShaperFlag(0);
-        if (!fontEngine->stringToCMap(reinterpret_cast<const QChar *>(string), itemLength, &initialGlyphs, &nGlyphs, shaperFlags))
-            Q_UNREACHABLE();
-    }
-
-    if (fontEngine->type() == QFontEngine::Multi) {
-        uint lastEngine = ~0u;
-        for (int i = 0, glyph_pos = 0; i < itemLength; ++i, ++glyph_pos) {
-            const uint engineIdx = initialGlyphs.glyphs[glyph_pos] >> 24;
-            if (lastEngine != engineIdx) {
-                itemBoundaries.append(i);
-                itemBoundaries.append(glyph_pos);
-                itemBoundaries.append(engineIdx);
-
-                if (engineIdx != 0) {
-                    QFontEngine *actualFontEngine = static_cast<QFontEngineMulti *>(fontEngine)->engine(engineIdx);
-                    si.ascent = qMax(actualFontEngine->ascent(), si.ascent);
-                    si.descent = qMax(actualFontEngine->descent(), si.descent);
-                    si.leading = qMax(actualFontEngine->leading(), si.leading);
+    QShapingCache *shapingCache = itemLength <= QShapingCache::MaxItemLength ? fontEngine->shapingCache() : 0;
+    QShapingCacheKey cacheKey;
+    const QShapedRun *cachedRun = 0;
+    if (shapingCache) {
+        cacheKey.text = QString::fromRawData(reinterpret_cast<const QChar *>(string), itemLength);
+        cacheKey.script = si.analysis.script;
+        cacheKey.flags = si.analysis.flags
+                | uint(si.analysis.bidiLevel % 2) << 3
+                | uint(kerningEnabled) << 4
+                | uint(shapingEnabled) << 5
+                | uint(letterSpacing != 0) << 6
+                | uint(option.useDesignMetrics()) << 7;
+        cachedRun = shapingCache->object(cacheKey);
+    }
+
+    if (cachedRun) {
+        if (Q_UNLIKELY(!ensureSpace(cachedRun->numGlyphs))) {
+            Q_UNREACHABLE(); // ### report OOM error somehow
+            return;
+        }
+
+        QGlyphLayout glyphs = availableGlyphs(&si);
+        const QGlyphLayout cachedGlyphs(const_cast<char *>(cachedRun->glyphData.constData()), cachedRun->numGlyphs);
+        copyGlyphs(&glyphs, cachedGlyphs, cachedRun->numGlyphs);
+        memcpy(logClusters(&si), cachedRun->logClusters.constData(), itemLength * sizeof(ushort));
+
+        si.ascent = cachedRun->ascent;
+        si.descent = cachedRun->descent;
+        si.leading = cachedRun->leading;
+        si.num_glyphs = cachedRun->numGlyphs;
+    } else {
+        // split up the item into parts that come from different font engines
+        // k * 3 entries, array[k] == index in string, array[k + 1] == index in glyphs, array[k + 2] == engine index
+        QVector<uint> itemBoundaries;
+        itemBoundaries.reserve(24);
+
+        QGlyphLayout initialGlyphs = availableGlyphs(&si);
+        int nGlyphs = initialGlyphs.numGlyphs;
+        if (fontEngine->type() == QFontEngine::Multi || !shapingEnabled) {
+            // ask the font engine to find out which glyphs (as an index in the specific font)
+            // to use for the text in one item.
+            QFontEngine::ShaperFlags shaperFlags =
+                    shapingEnabled
+                        ? QFontEngine::GlyphIndicesOnly
+                        : QFontEngine::ShaperFlag(0);
+            if (!fontEngine->stringToCMap(reinterpret_cast<const QChar *>(string), itemLength, &initialGlyphs, &nGlyphs, shaperFlags))
+                Q_UNREACHABLE();
+        }
+
+        if (fontEngine->type() == QFontEngine::Multi) {
+            uint lastEngine = ~0u;
+            for (int i = 0, glyph_pos = 0; i < itemLength; ++i, ++glyph_pos) {
+                const uint engineIdx = initialGlyphs.glyphs[glyph_pos] >> 24;
+                if (lastEngine != engineIdx) {
+                    itemBoundaries.append(i);
+                    itemBoundaries.append(glyph_pos);
+                    itemBoundaries.append(engineIdx);
+
+                    if (engineIdx != 0) {
+                        QFontEngine *actualFontEngine = static_cast<QFontEngineMulti *>(fontEngine)->engine(engineIdx);
+                        si.ascent = qMax(actualFontEngine->ascent(), si.ascent);
+                        si.descent = qMax(actualFontEngine->descent(), si.descent);
+                        si.leading = qMax(actualFontEngine->leading(), si.leading);
+                    }
+
+                    lastEngine = engineIdx;
                 }
 
-                lastEngine = engineIdx;
+                if (QChar::isHighSurrogate(string[i]) && i + 1 < itemLength && QChar::isLowSurrogate(string[i + 1]))
+                    ++i;
             }
-
-            if (QChar::isHighSurrogate(string[i]) && i + 1 < itemLength && QChar::isLowSurrogate(string[i + 1]))
-                ++i;
+        } else {
+            itemBoundaries.append(0);
+            itemBoundaries.append(0);
+            itemBoundaries.append(0);
         }
-    } else {
-        itemBoundaries.append(0);
-        itemBoundaries.append(0);
-        itemBoundaries.append(0);
-    }
-
-    if (Q_UNLIKELY(!shapingEnabled)) {
-        ushort *log_clusters = logClusters(&si);
-
-        int glyph_pos = 0;
-        for (int i = 0; i < itemLength; ++i, ++glyph_pos) {
-            log_clusters[i] = glyph_pos;
-            initialGlyphs.attributes[glyph_pos].clusterStart = true;
-            if (QChar::isHighSurrogate(string[i])
-                    && i + 1 < itemLength
-                    && QChar::isLowSurrogate(string[i + 1])) {
-                ++i;
+
+        if (Q_UNLIKELY(!shapingEnabled)) {
+            ushort *log_clusters = logClusters(&si);
+
+            int glyph_pos = 0;
+            for (int i = 0; i < itemLength; ++i, ++glyph_pos) {
                 log_clusters[i] = glyph_pos;
+                initialGlyphs.attributes[glyph_pos].clusterStart = true;
+                if (QChar::isHighSurrogate(string[i])
+                        && i + 1 < itemLength
+                        && QChar::isLowSurrogate(string[i + 1])) {
+                    ++i;
+                    log_clusters[i] = glyph_pos;
+                }
             }
+
+            si.num_glyphs = glyph_pos;
+    #if QT_CONFIG(harfbuzz)
+        } else if (Q_LIKELY(qt_useHarfbuzzNG())) {
+            si.num_glyphs = shapeTextWithHarfbuzzNG(si, string, itemLength, fontEngine, itemBoundaries, kerningEnabled, letterSpacing != 0);
+    #endif
+        } else {
+            si.num_glyphs = shapeTextWithHarfbuzz(si, string, itemLength, fontEngine, itemBoundaries, kerningEnabled);
         }
 
-        si.num_glyphs = glyph_pos;
-#if QT_CONFIG(harfbuzz)
-    } else if (Q_LIKELY(qt_useHarfbuzzNG())) {
-        si.num_glyphs = shapeTextWithHarfbuzzNG(si, string, itemLength, fontEngine, itemBoundaries, kerningEnabled, letterSpacing != 0);
-#endif
-    } else {
-        si.num_glyphs = shapeTextWithHarfbuzz(si, string, itemLength, fontEngine, itemBoundaries, kerningEnabled);
+        if (shapingCache && si.num_glyphs) {
+            QShapedRun *run = new QShapedRun;
+            run->numGlyphs = si.num_glyphs;
+            run->glyphData.resize(si.num_glyphs * QGlyphLayout::SpaceNeeded);
+            QGlyphLayout cachedGlyphs(run->glyphData.data(), si.num_glyphs);
+            copyGlyphs(&cachedGlyphs, availableGlyphs(&si), si.num_glyphs);
+            run->logClusters.resize(itemLength);
+            memcpy(run->logClusters.data(), logClusters(&si), itemLength * sizeof(ushort));
+            run->ascent = si.ascent;
+            run->descent = si.descent;
+            run->leading = si.leading;
+
+            // the key must own its text, the shaped string may go away
+            cacheKey.text = QString(reinterpret_cast<const QChar *>(string), itemLength);
+            shapingCache->insert(cacheKey, run, si.num_glyphs);
+        }
     }
     if (Q_UNLIKELY(si.num_glyphs == 0)) {
         Q_UNREACHABLE(); // ### report shaping errors somehow
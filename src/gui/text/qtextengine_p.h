@@ -64,6 +64,7 @@
 #include "QtGui/qtextoption.h"
 #include "QtGui/qtextcursor.h"
 #include "QtCore/qset.h"
+#include "QtCore/qcache.h"
 #include "QtCore/qdebug.h"
 #ifndef QT_BUILD_COMPAT_LIB
 #include "private/qtextdocument_p.h"
@@ -347,6 +348,48 @@ Q_DECLARE_TYPEINFO(QScriptItem, Q_PRIMITIVE_TYPE);
 
 typedef QVector<QScriptItem> QScriptItemArray;
 
+// Shaped glyph runs are cached per font engine, keyed by the (case-mapped)
+// text of the item and everything else that influences the shaper.
+struct QShapingCacheKey
+{
+    QString text;
+    uint script;
+    uint flags;
+
+    bool operator==(const QShapingCacheKey &other) const Q_DECL_NOTHROW
+    { return script == other.script && flags == other.flags && text == other.text; }
+};
+
+inline uint qHash(const QShapingCacheKey &key, uint seed = 0) Q_DECL_NOTHROW
+{
+    QtPrivate::QHashCombine hash;
+    seed = hash(seed, key.text);
+    seed = hash(seed, key.script);
+    seed = hash(seed, key.flags);
+    return seed;
+}
+
+struct QShapedRun
+{
+    QByteArray glyphData; // QGlyphLayout storage for numGlyphs glyphs
+    QVector<ushort> logClusters;
+    int numGlyphs;
+    QFixed ascent;
+    QFixed descent;
+    QFixed leading;
+};
+
+class QShapingCache : public QCache<QShapingCacheKey, QShapedRun>
+{
+public:
+    enum {
+        MaxItemLength = 128, // longer items are rarely shaped more than once
+        MaxCost = 8192       // in glyphs
+    };
+
+    QShapingCache() : QCache<QShapingCacheKey, QShapedRun>(MaxCost) {}
+};
+
 struct Q_AUTOTEST_EXPORT QScriptLine
 {
     // created and filled in QTextLine::layout_helper
@@ -1211,7 +1211,7 @@ void QTextLayout::draw(QPainter *p, const QPointF &pos, const QVector<FormatRang
 
         for (int line = firstLine; line < lastLine; ++line) {
             QTextLine l(line, d);
-            l.draw(p, position, &selection);
+            l.draw_internal(p, position, &selection, clip);
         }
         p->restore();
 
@@ -1235,7 +1235,7 @@ void QTextLayout::draw(QPainter *p, const QPointF &pos, const QVector<FormatRang
         selection.format.setProperty(SuppressBackground, true);
         for (int line = firstLine; line < lastLine; ++line) {
             QTextLine l(line, d);
-            l.draw(p, position, &selection);
+            l.draw_internal(p, position, &selection, clip);
         }
         p->restore();
     }
@@ -1254,7 +1254,7 @@ void QTextLayout::draw(QPainter *p, const QPointF &pos, const QVector<FormatRang
 
     for (int i = firstLine; i < lastLine; ++i) {
         QTextLine l(i, d);
-        l.draw(p, position);
+        l.draw_internal(p, position, 0, clip);
     }
     if (!excludedRegion.isEmpty())
         p->restore();
@@ -2436,6 +2436,16 @@ QList<QGlyphRun> QTextLine::glyphRuns(int from, int length) const
     The \a selection is reserved for internal use.
 */
 void QTextLine::draw(QPainter *p, const QPointF &pos, const QTextLayout::FormatRange *selection) const
+{
+    draw_internal(p, pos, selection, QRectF());
+}
+
+/*
+    Like draw(), but skips the items that are horizontally outside of \a clip,
+    if it is valid. This keeps painting part of a very long line cheap.
+*/
+void QTextLine::draw_internal(QPainter *p, const QPointF &pos, const QTextLayout::FormatRange *selection,
+                              const QRectF &clip) const
 {
 #ifndef QT_NO_RAWFONT
     // Not intended to work with rawfont
@@ -2468,10 +2478,25 @@ void QTextLine::draw(QPainter *p, const QPointF &pos, const QTextLayout::FormatR
 
     const QFixed y = QFixed::fromReal(pos.y()) + line.y + lineBase;
 
+    // glyphs can extend past their advances, so allow for some overhang
+    QFixed clipLeft = -QFIXED_MAX;
+    QFixed clipRight = QFIXED_MAX;
+    if (clip.isValid()) {
+        const QFixed overhang = line.height();
+        clipLeft = QFixed::fromReal(clip.left()) - overhang;
+        clipRight = QFixed::fromReal(clip.right()) + overhang;
+    }
+
     bool suppressColors = (eng->option.flags() & QTextOption::SuppressColors);
     while (!iterator.atEnd()) {
         QScriptItem &si = iterator.next();
 
+        // items are visited in visual order, left to right
+        if (iterator.x > clipRight)
+            break;
+        if (iterator.x + iterator.itemWidth < clipLeft)
+            continue;
+
         if (selection && selection->start >= 0 && iterator.isOutsideSelection())
             continue;
 
@@ -264,6 +264,8 @@ public:
 private:
     QTextLine(int line, QTextEngine *e) : index(line), eng(e) {}
     void layout_helper(int numGlyphs);
+    void draw_internal(QPainter *p, const QPointF &point, const QTextLayout::FormatRange *selection,
+                       const QRectF &clip) const;
 
     friend class QTextLayout;
     friend class QTextFragment;
@@ -304,6 +304,15 @@ QVulkanWindowPrivate::~QVulkanWindowPrivate()
     \value PersistentResources Ensures no graphics resources are released when
     the window becomes unexposed. The default behavior is to release
     everything, and reinitialize later when becoming visible again.
+
+    \value DedicatedTransferQueue Uses a queue from a transfer-only queue
+    family, if available, for the image uploads of uploadImage(), so that
+    they can run in parallel with rendering. This value was introduced in
+    Qt 5.11.
+
+    \value AsyncComputeQueue Creates a queue from a compute queue family
+    without graphics support, if available, and returns it from
+    computeQueue(). This value was introduced in Qt 5.11.
  */
 
 /*!
@@ -700,18 +709,49 @@ void QVulkanWindowPrivate::init()
 #endif
     qCDebug(lcGuiVk, "Using queue families: graphics = %u present = %u", gfxQueueFamilyIdx, presQueueFamilyIdx);
 
-    VkDeviceQueueCreateInfo queueInfo[2];
+    // Transfers and compute work go to the graphics queue unless a dedicated
+    // queue family was requested and is available.
+    transferQueueFamilyIdx = gfxQueueFamilyIdx;
+    computeQueueFamilyIdx = gfxQueueFamilyIdx;
+    if (flags.testFlag(QVulkanWindow::DedicatedTransferQueue)) {
+        for (int i = 0; i < queueFamilyProps.count(); ++i) {
+            const VkQueueFlags queueFlags = queueFamilyProps[i].queueFlags;
+            if ((queueFlags & VK_QUEUE_TRANSFER_BIT)
+                    && !(queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                transferQueueFamilyIdx = i;
+                const VkExtent3D &granularity(queueFamilyProps[i].minImageTransferGranularity);
+                transferQueueCopiesAnyRegion = granularity.width == 1 && granularity.height == 1
+                        && granularity.depth == 1;
+                break;
+            }
+        }
+    }
+    if (flags.testFlag(QVulkanWindow::AsyncComputeQueue)) {
+        for (int i = 0; i < queueFamilyProps.count(); ++i) {
+            const VkQueueFlags queueFlags = queueFamilyProps[i].queueFlags;
+            if ((queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+                computeQueueFamilyIdx = i;
+                break;
+            }
+        }
+    }
+    qCDebug(lcGuiVk, "Using queue families: transfer = %u compute = %u", transferQueueFamilyIdx, computeQueueFamilyIdx);
+
+    VkDeviceQueueCreateInfo queueInfo[4];
     const float prio[] = { 0 };
     memset(queueInfo, 0, sizeof(queueInfo));
-    queueInfo[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueInfo[0].queueFamilyIndex = gfxQueueFamilyIdx;
-    queueInfo[0].queueCount = 1;
-    queueInfo[0].pQueuePriorities = prio;
-    if (gfxQueueFamilyIdx != presQueueFamilyIdx) {
-        queueInfo[1].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-        queueInfo[1].queueFamilyIndex = presQueueFamilyIdx;
-        queueInfo[1].queueCount = 1;
-        queueInfo[1].pQueuePriorities = prio;
+    uint32_t queueInfoCount = 0;
+    for (uint32_t familyIdx : { gfxQueueFamilyIdx, presQueueFamilyIdx, transferQueueFamilyIdx, computeQueueFamilyIdx }) {
+        bool found = false;
+        for (uint32_t i = 0; i < queueInfoCount; ++i)
+            found = found || queueInfo[i].queueFamilyIndex == familyIdx;
+        if (found)
+            continue;
+        queueInfo[queueInfoCount].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueInfo[queueInfoCount].queueFamilyIndex = familyIdx;
+        queueInfo[queueInfoCount].queueCount = 1;
+        queueInfo[queueInfoCount].pQueuePriorities = prio;
+        ++queueInfoCount;
     }
 
     // Filter out unsupported extensions in order to keep symmetry
@@ -729,7 +769,7 @@ void QVulkanWindowPrivate::init()
     VkDeviceCreateInfo devInfo;
     memset(&devInfo, 0, sizeof(devInfo));
     devInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    devInfo.queueCreateInfoCount = gfxQueueFamilyIdx == presQueueFamilyIdx ? 1 : 2;
+    devInfo.queueCreateInfoCount = queueInfoCount;
     devInfo.pQueueCreateInfos = queueInfo;
     devInfo.enabledExtensionCount = devExts.count();
     devInfo.ppEnabledExtensionNames = devExts.constData();
@@ -792,6 +832,14 @@ void QVulkanWindowPrivate::init()
         presQueue = gfxQueue;
     else
         devFuncs->vkGetDeviceQueue(dev, presQueueFamilyIdx, 0, &presQueue);
+    if (gfxQueueFamilyIdx == transferQueueFamilyIdx)
+        transferQueue = gfxQueue;
+    else
+        devFuncs->vkGetDeviceQueue(dev, transferQueueFamilyIdx, 0, &transferQueue);
+    if (gfxQueueFamilyIdx == computeQueueFamilyIdx)
+        computeQueue = gfxQueue;
+    else
+        devFuncs->vkGetDeviceQueue(dev, computeQueueFamilyIdx, 0, &computeQueue);
 
     VkCommandPoolCreateInfo poolInfo;
     memset(&poolInfo, 0, sizeof(poolInfo));
@@ -812,6 +860,24 @@ void QVulkanWindowPrivate::init()
             return;
         }
     }
+    if (gfxQueueFamilyIdx != transferQueueFamilyIdx) {
+        poolInfo.queueFamilyIndex = transferQueueFamilyIdx;
+        err = devFuncs->vkCreateCommandPool(dev, &poolInfo, nullptr, &transferCmdPool);
+        if (err != VK_SUCCESS) {
+            qWarning("QVulkanWindow: Failed to create command pool for transfer queue: %d", err);
+            status = StatusFail;
+            return;
+        }
+    }
+    if (gfxQueueFamilyIdx != computeQueueFamilyIdx) {
+        poolInfo.queueFamilyIndex = computeQueueFamilyIdx;
+        err = devFuncs->vkCreateCommandPool(dev, &poolInfo, nullptr, &computeCmdPool);
+        if (err != VK_SUCCESS) {
+            qWarning("QVulkanWindow: Failed to create command pool for compute queue: %d", err);
+            status = StatusFail;
+            return;
+        }
+    }
 
     hostVisibleMemIndex = 0;
     VkPhysicalDeviceMemoryProperties physDevMemProps;
@@ -931,6 +997,11 @@ void QVulkanWindowPrivate::reset()
         devFuncs->vkDeviceWaitIdle(dev);
     }
 
+    // uploads that were never submitted are dropped
+    releaseAllUploads();
+    releaseUploadBatch(&pendingUpload);
+    releaseStagingBuffer();
+
     if (defaultRenderPass) {
         devFuncs->vkDestroyRenderPass(dev, defaultRenderPass, nullptr);
         defaultRenderPass = VK_NULL_HANDLE;
@@ -946,6 +1017,16 @@ void QVulkanWindowPrivate::reset()
         presCmdPool = VK_NULL_HANDLE;
     }
 
+    if (transferCmdPool) {
+        devFuncs->vkDestroyCommandPool(dev, transferCmdPool, nullptr);
+        transferCmdPool = VK_NULL_HANDLE;
+    }
+
+    if (computeCmdPool) {
+        devFuncs->vkDestroyCommandPool(dev, computeCmdPool, nullptr);
+        computeCmdPool = VK_NULL_HANDLE;
+    }
+
     if (frameGrabImage) {
         devFuncs->vkDestroyImage(dev, frameGrabImage, nullptr);
         frameGrabImage = VK_NULL_HANDLE;
@@ -1444,6 +1525,9 @@ void QVulkanWindowPrivate::releaseSwapChain()
         devFuncs->vkDeviceWaitIdle(dev);
     }
 
+    // the device is idle, so every submitted upload has completed
+    releaseAllUploads();
+
     for (int i = 0; i < frameLag; ++i) {
         FrameResources &frame(frameRes[i]);
         if (frame.fence) {
@@ -1846,6 +1930,7 @@ void QVulkanWindowPrivate::beginFrame()
         devFuncs->vkWaitForFences(dev, 1, &image.cmdFence, VK_TRUE, UINT64_MAX);
         devFuncs->vkResetFences(dev, 1, &image.cmdFence);
         image.cmdFenceWaitable = false;
+        releaseUploadsUpTo(currentImage);
     }
 
     // build new draw command buffer
@@ -1941,22 +2026,41 @@ void QVulkanWindowPrivate::endFrame()
         return;
     }
 
+    // Uploads recorded since the previous frame go first: their transfer
+    // queue part is submitted now, and the graphics queue part runs before
+    // the frame's own command buffer.
+    if (!finishPendingUploads())
+        return;
+    VkCommandBuffer cmdBufs[2];
+    uint32_t cmdBufCount = 0;
+    VkSemaphore waitSems[2];
+    VkPipelineStageFlags waitStages[2];
+    uint32_t waitSemCount = 0;
+    if (pendingUpload.transferCmdBuf) {
+        waitSems[waitSemCount] = pendingUpload.transferSem;
+        waitStages[waitSemCount++] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+    if (pendingUpload.gfxCmdBuf)
+        cmdBufs[cmdBufCount++] = pendingUpload.gfxCmdBuf;
+    cmdBufs[cmdBufCount++] = image.cmdBuf;
+
     // submit draw calls
     VkSubmitInfo submitInfo;
     memset(&submitInfo, 0, sizeof(submitInfo));
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &image.cmdBuf;
+    submitInfo.commandBufferCount = cmdBufCount;
+    submitInfo.pCommandBuffers = cmdBufs;
     if (frame.imageSemWaitable) {
-        submitInfo.waitSemaphoreCount = 1;
-        submitInfo.pWaitSemaphores = &frame.imageSem;
+        waitSems[waitSemCount] = frame.imageSem;
+        waitStages[waitSemCount++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     }
+    submitInfo.waitSemaphoreCount = waitSemCount;
+    submitInfo.pWaitSemaphores = waitSems;
     if (!frameGrabbing) {
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores = &frame.drawSem;
     }
-    VkPipelineStageFlags psf = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    submitInfo.pWaitDstStageMask = &psf;
+    submitInfo.pWaitDstStageMask = waitStages;
 
     Q_ASSERT(!image.cmdFenceWaitable);
 
@@ -1964,9 +2068,20 @@ void QVulkanWindowPrivate::endFrame()
     if (err == VK_SUCCESS) {
         frame.imageSemWaitable = false;
         image.cmdFenceWaitable = true;
+        if (pendingUpload.transferCmdBuf || pendingUpload.gfxCmdBuf) {
+            // the staging data and command buffers are released once
+            // image.cmdFence has signaled
+            pendingUpload.imageIndex = currentImage;
+            uploadsInFlight.append(pendingUpload);
+            pendingUpload = UploadBatch();
+        }
     } else {
-        if (!checkDeviceLost(err))
+        if (!checkDeviceLost(err)) {
             qWarning("QVulkanWindow: Failed to submit to graphics queue: %d", err);
+            // the uploads cannot be resubmitted; drop them
+            devFuncs->vkDeviceWaitIdle(dev);
+            releaseUploadBatch(&pendingUpload);
+        }
         return;
     }
 
@@ -2205,6 +2320,275 @@ void QVulkanWindowPrivate::finishBlockingReadback()
     frameGrabImageMem = VK_NULL_HANDLE;
 }
 
+static inline VkDeviceSize qvk_alignUp(VkDeviceSize v, VkDeviceSize alignment)
+{
+    return (v + alignment - 1) / alignment * alignment;
+}
+
+static void qvk_imageBarrier(QVulkanDeviceFunctions *devFuncs, VkCommandBuffer cb, VkImage image,
+                             VkImageLayout oldLayout, VkImageLayout newLayout,
+                             VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+                             VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage,
+                             uint32_t srcQueueFamilyIdx = VK_QUEUE_FAMILY_IGNORED,
+                             uint32_t dstQueueFamilyIdx = VK_QUEUE_FAMILY_IGNORED)
+{
+    VkImageMemoryBarrier barrier;
+    memset(&barrier, 0, sizeof(barrier));
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = srcQueueFamilyIdx;
+    barrier.dstQueueFamilyIndex = dstQueueFamilyIdx;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = barrier.subresourceRange.layerCount = 1;
+    devFuncs->vkCmdPipelineBarrier(cb, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+bool QVulkanWindowPrivate::ensureStagingBuffer()
+{
+    if (stagingBuf)
+        return true;
+
+    const uint32_t queueFamilies[] = { gfxQueueFamilyIdx, transferQueueFamilyIdx };
+    VkBufferCreateInfo bufInfo;
+    memset(&bufInfo, 0, sizeof(bufInfo));
+    bufInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufInfo.size = stagingBufSize;
+    bufInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    if (gfxQueueFamilyIdx != transferQueueFamilyIdx) {
+        // read by both queues, without ownership transfers
+        bufInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufInfo.queueFamilyIndexCount = 2;
+        bufInfo.pQueueFamilyIndices = queueFamilies;
+    }
+    VkResult err = devFuncs->vkCreateBuffer(dev, &bufInfo, nullptr, &stagingBuf);
+    if (err != VK_SUCCESS) {
+        qWarning("QVulkanWindow: Failed to create staging buffer: %d", err);
+        return false;
+    }
+
+    VkMemoryRequirements memReq;
+    devFuncs->vkGetBufferMemoryRequirements(dev, stagingBuf, &memReq);
+    if (!(memReq.memoryTypeBits & (1 << hostVisibleMemIndex))) {
+        qWarning("QVulkanWindow: Staging buffer cannot use the host visible memory type");
+        releaseStagingBuffer();
+        return false;
+    }
+
+    VkMemoryAllocateInfo memInfo = {
+        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, memReq.size, hostVisibleMemIndex };
+    err = devFuncs->vkAllocateMemory(dev, &memInfo, nullptr, &stagingBufMem);
+    if (err != VK_SUCCESS) {
+        qWarning("QVulkanWindow: Failed to allocate staging buffer memory: %d", err);
+        releaseStagingBuffer();
+        return false;
+    }
+
+    err = devFuncs->vkBindBufferMemory(dev, stagingBuf, stagingBufMem, 0);
+    if (err == VK_SUCCESS)
+        err = devFuncs->vkMapMemory(dev, stagingBufMem, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void **>(&stagingPtr));
+    if (err != VK_SUCCESS) {
+        qWarning("QVulkanWindow: Failed to set up staging buffer memory: %d", err);
+        releaseStagingBuffer();
+        return false;
+    }
+
+    stagingHead = 0;
+    return true;
+}
+
+void QVulkanWindowPrivate::releaseStagingBuffer()
+{
+    if (stagingPtr) {
+        devFuncs->vkUnmapMemory(dev, stagingBufMem);
+        stagingPtr = nullptr;
+    }
+    if (stagingBuf) {
+        devFuncs->vkDestroyBuffer(dev, stagingBuf, nullptr);
+        stagingBuf = VK_NULL_HANDLE;
+    }
+    if (stagingBufMem) {
+        devFuncs->vkFreeMemory(dev, stagingBufMem, nullptr);
+        stagingBufMem = VK_NULL_HANDLE;
+    }
+    stagingHead = 0;
+}
+
+/*
+    Reserves \a size bytes in the staging ring buffer. The space used by a
+    batch of uploads becomes free again once the frame it was submitted with
+    has finished on the GPU, so this never blocks; it fails instead when the
+    ring is full.
+ */
+bool QVulkanWindowPrivate::allocateStaging(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize *offset)
+{
+    if (size > stagingBufSize)
+        return false;
+
+    releaseFinishedUploads();
+
+    const bool inUse = pendingUpload.usesStaging || !uploadsInFlight.isEmpty();
+    if (!inUse)
+        stagingHead = 0;
+    // start of the oldest region still in use
+    const VkDeviceSize tail = !uploadsInFlight.isEmpty() ? uploadsInFlight.first().stagingBegin
+                                                         : pendingUpload.stagingBegin;
+
+    VkDeviceSize start = qvk_alignUp(stagingHead, alignment);
+    if (!inUse || stagingHead >= tail) {
+        // free space is [head, end) followed by [0, tail)
+        if (start + size > stagingBufSize) {
+            start = 0;
+            if (inUse && size >= tail)
+                return false;
+        }
+    } else if (start + size >= tail) {
+        // wrapped around, free space is [head, tail)
+        return false;
+    }
+
+    if (!pendingUpload.usesStaging) {
+        pendingUpload.usesStaging = true;
+        pendingUpload.stagingBegin = start;
+    }
+    stagingHead = start + size;
+    *offset = start;
+    return true;
+}
+
+VkCommandBuffer QVulkanWindowPrivate::uploadCommandBuffer(bool onTransferQueue)
+{
+    VkCommandBuffer *cmdBuf = onTransferQueue ? &pendingUpload.transferCmdBuf : &pendingUpload.gfxCmdBuf;
+    if (*cmdBuf)
+        return *cmdBuf;
+
+    VkResult err;
+    if (onTransferQueue && !pendingUpload.transferSem) {
+        VkSemaphoreCreateInfo semInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, nullptr, 0 };
+        err = devFuncs->vkCreateSemaphore(dev, &semInfo, nullptr, &pendingUpload.transferSem);
+        if (err != VK_SUCCESS) {
+            qWarning("QVulkanWindow: Failed to create upload semaphore: %d", err);
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    VkCommandPool pool = onTransferQueue ? transferCmdPool : cmdPool;
+    VkCommandBufferAllocateInfo cmdBufInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1 };
+    err = devFuncs->vkAllocateCommandBuffers(dev, &cmdBufInfo, cmdBuf);
+    if (err != VK_SUCCESS) {
+        *cmdBuf = VK_NULL_HANDLE;
+        if (!checkDeviceLost(err))
+            qWarning("QVulkanWindow: Failed to allocate upload command buffer: %d", err);
+        return VK_NULL_HANDLE;
+    }
+
+    VkCommandBufferBeginInfo cmdBufBeginInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr };
+    err = devFuncs->vkBeginCommandBuffer(*cmdBuf, &cmdBufBeginInfo);
+    if (err != VK_SUCCESS) {
+        devFuncs->vkFreeCommandBuffers(dev, pool, 1, cmdBuf);
+        *cmdBuf = VK_NULL_HANDLE;
+        if (!checkDeviceLost(err))
+            qWarning("QVulkanWindow: Failed to begin upload command buffer: %d", err);
+        return VK_NULL_HANDLE;
+    }
+
+    return *cmdBuf;
+}
+
+/*
+    Ends the command buffers of the pending upload batch and submits its
+    transfer queue part. Returns false if the device got lost.
+ */
+bool QVulkanWindowPrivate::finishPendingUploads()
+{
+    if (pendingUpload.gfxCmdBuf && pendingUpload.hasBufferCopies) {
+        VkMemoryBarrier barrier;
+        memset(&barrier, 0, sizeof(barrier));
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+        devFuncs->vkCmdPipelineBarrier(pendingUpload.gfxCmdBuf,
+                                       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                       0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    VkResult err = VK_SUCCESS;
+    if (pendingUpload.transferCmdBuf)
+        err = devFuncs->vkEndCommandBuffer(pendingUpload.transferCmdBuf);
+    if (err == VK_SUCCESS && pendingUpload.gfxCmdBuf)
+        err = devFuncs->vkEndCommandBuffer(pendingUpload.gfxCmdBuf);
+    if (err == VK_SUCCESS && pendingUpload.transferCmdBuf) {
+        VkSubmitInfo submitInfo;
+        memset(&submitInfo, 0, sizeof(submitInfo));
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &pendingUpload.transferCmdBuf;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &pendingUpload.transferSem;
+        err = devFuncs->vkQueueSubmit(transferQueue, 1, &submitInfo, VK_NULL_HANDLE);
+    }
+
+    if (err != VK_SUCCESS) {
+        if (checkDeviceLost(err))
+            return false;
+        qWarning("QVulkanWindow: Failed to submit uploads: %d", err);
+        devFuncs->vkDeviceWaitIdle(dev);
+        releaseUploadBatch(&pendingUpload);
+    }
+    return true;
+}
+
+void QVulkanWindowPrivate::releaseUploadBatch(UploadBatch *batch)
+{
+    if (batch->transferCmdBuf)
+        devFuncs->vkFreeCommandBuffers(dev, transferCmdPool, 1, &batch->transferCmdBuf);
+    if (batch->gfxCmdBuf)
+        devFuncs->vkFreeCommandBuffers(dev, cmdPool, 1, &batch->gfxCmdBuf);
+    if (batch->transferSem)
+        devFuncs->vkDestroySemaphore(dev, batch->transferSem, nullptr);
+    *batch = UploadBatch();
+}
+
+// Releases the upload batches whose frame has finished, without blocking.
+void QVulkanWindowPrivate::releaseFinishedUploads()
+{
+    int done = 0;
+    while (done < uploadsInFlight.count()) {
+        const ImageResources &image(imageRes[uploadsInFlight.at(done).imageIndex]);
+        if (image.cmdFenceWaitable && devFuncs->vkGetFenceStatus(dev, image.cmdFence) != VK_SUCCESS)
+            break;
+        releaseUploadBatch(&uploadsInFlight[done]);
+        ++done;
+    }
+    uploadsInFlight.remove(0, done);
+}
+
+// Called when the fence of the given swapchain image was waited for. A
+// signaled fence means everything submitted before it has finished too.
+void QVulkanWindowPrivate::releaseUploadsUpTo(int imageIndex)
+{
+    int last = -1;
+    for (int i = 0; i < uploadsInFlight.count(); ++i) {
+        if (uploadsInFlight.at(i).imageIndex == imageIndex)
+            last = i;
+    }
+    for (int i = 0; i <= last; ++i)
+        releaseUploadBatch(&uploadsInFlight[i]);
+    uploadsInFlight.remove(0, last + 1);
+}
+
+void QVulkanWindowPrivate::releaseAllUploads()
+{
+    for (UploadBatch &batch : uploadsInFlight)
+        releaseUploadBatch(&batch);
+    uploadsInFlight.clear();
+}
+
 /*!
     Returns the active physical device.
 
@@ -2263,6 +2647,21 @@ VkQueue QVulkanWindow::graphicsQueue() const
     return d->gfxQueue;
 }
 
+/*!
+    Returns the family index of the active graphics queue.
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+ */
+uint32_t QVulkanWindow::graphicsQueueFamilyIndex() const
+{
+    Q_D(const QVulkanWindow);
+    return d->gfxQueueFamilyIdx;
+}
+
 /*!
     Returns the active graphics command pool.
 
@@ -2276,6 +2675,100 @@ VkCommandPool QVulkanWindow::graphicsCommandPool() const
     return d->cmdPool;
 }
 
+/*!
+    Returns the queue used by uploadBuffer() and uploadImage().
+
+    This is a queue from a transfer-only queue family when the
+    DedicatedTransferQueue flag is set and the physical device offers such a
+    family. Otherwise it is the same as graphicsQueue().
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+    \sa transferQueueFamilyIndex()
+ */
+VkQueue QVulkanWindow::transferQueue() const
+{
+    Q_D(const QVulkanWindow);
+    return d->transferQueue;
+}
+
+/*!
+    Returns the family index of the queue returned by transferQueue().
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+ */
+uint32_t QVulkanWindow::transferQueueFamilyIndex() const
+{
+    Q_D(const QVulkanWindow);
+    return d->transferQueueFamilyIdx;
+}
+
+/*!
+    Returns a queue for compute work.
+
+    This is a queue from a compute queue family without graphics support when
+    the AsyncComputeQueue flag is set and the physical device offers such a
+    family, so that compute work can overlap with rendering. Otherwise it is
+    the same as graphicsQueue().
+
+    QVulkanWindow does not submit anything to this queue. Applications are
+    responsible for synchronizing their compute submissions with rendering,
+    for example with semaphores, and for queue family ownership transfers of
+    resources with \c{VK_SHARING_MODE_EXCLUSIVE} that are shared between the
+    two queues.
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+    \sa computeQueueFamilyIndex(), computeCommandPool()
+ */
+VkQueue QVulkanWindow::computeQueue() const
+{
+    Q_D(const QVulkanWindow);
+    return d->computeQueue;
+}
+
+/*!
+    Returns the family index of the queue returned by computeQueue().
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+ */
+uint32_t QVulkanWindow::computeQueueFamilyIndex() const
+{
+    Q_D(const QVulkanWindow);
+    return d->computeQueueFamilyIdx;
+}
+
+/*!
+    Returns a command pool for command buffers submitted to computeQueue().
+    When the compute queue is the graphics queue, this is the same as
+    graphicsCommandPool().
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+ */
+VkCommandPool QVulkanWindow::computeCommandPool() const
+{
+    Q_D(const QVulkanWindow);
+    return d->computeCmdPool ? d->computeCmdPool : d->cmdPool;
+}
+
 /*!
     Returns a host visible memory type index suitable for general use.
 
@@ -2717,4 +3210,200 @@ QMatrix4x4 QVulkanWindow::clipCorrectionMatrix()
     return d->m_clipCorrect;
 }
 
+/*!
+    Sets the size of the staging buffer used by uploadBuffer() and
+    uploadImage() to \a size bytes. The default is 4 MB.
+
+    The staging buffer is a ring: each upload copies its data into the next
+    free range, and that range is reused once the frame that consumed the
+    upload has finished on the GPU. An upload that does not fit fails instead
+    of stalling, so the size limits how much data can be in flight at a time,
+    and also the largest single upload.
+
+    \note This function must be called before the window is made visible or at
+    latest in QVulkanWindowRenderer::preInitResources(), and has no effect if
+    called afterwards.
+
+    \since 5.11
+    \sa stagingBufferSize()
+ */
+void QVulkanWindow::setStagingBufferSize(VkDeviceSize size)
+{
+    Q_D(QVulkanWindow);
+    if (d->status != QVulkanWindowPrivate::StatusUninitialized) {
+        qWarning("QVulkanWindow: Attempted to set staging buffer size when already initialized");
+        return;
+    }
+    d->stagingBufSize = size;
+}
+
+/*!
+    Returns the size of the staging buffer in bytes.
+
+    \since 5.11
+    \sa setStagingBufferSize()
+ */
+VkDeviceSize QVulkanWindow::stagingBufferSize() const
+{
+    Q_D(const QVulkanWindow);
+    return d->stagingBufSize;
+}
+
+/*!
+    Schedules copying \a size bytes from \a data to \a buffer, starting at
+    \a offset in the buffer. The data is copied into the staging buffer
+    immediately, so \a data can be released after the call returns.
+
+    The copy is executed on the graphics queue, before the command buffer of
+    the next frame, that is, of the next call to frameReady(). Its results
+    are visible to all commands of that frame. The buffer must have been
+    created with \c{VK_BUFFER_USAGE_TRANSFER_DST_BIT}, and it must not be used
+    by frames that are still in flight.
+
+    Returns \c false if the staging buffer has no room left for \a size
+    bytes, or if recording the copy failed. The application can retry in a
+    later frame, when earlier uploads have finished.
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+    \sa uploadImage(), setStagingBufferSize()
+ */
+bool QVulkanWindow::uploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void *data, VkDeviceSize size)
+{
+    Q_D(QVulkanWindow);
+    if (!d->dev) {
+        qWarning("QVulkanWindow: Attempted to upload data without a device");
+        return false;
+    }
+    if (!size)
+        return true;
+    if (!d->ensureStagingBuffer())
+        return false;
+
+    VkCommandBuffer cb = d->uploadCommandBuffer(false);
+    VkDeviceSize stagingOffset;
+    if (!cb || !d->allocateStaging(size, 4, &stagingOffset))
+        return false;
+
+    memcpy(d->stagingPtr + stagingOffset, data, size);
+
+    VkBufferCopy region = { stagingOffset, offset, size };
+    d->devFuncs->vkCmdCopyBuffer(cb, d->stagingBuf, buffer, 1, &region);
+    d->pendingUpload.hasBufferCopies = true;
+    return true;
+}
+
+/*!
+    Schedules copying the contents of \a data into the first mip level and
+    array layer of \a image, starting at its top-left corner.
+
+    \a image must have a 32-bit RGBA format, such as
+    \c{VK_FORMAT_R8G8B8A8_UNORM}, it must be at least as large as \a data,
+    and it must have been created with \c{VK_IMAGE_USAGE_TRANSFER_DST_BIT}
+    and \c{VK_SHARING_MODE_EXCLUSIVE}. \a data is converted to
+    QImage::Format_RGBA8888_Premultiplied unless it already is in one of the
+    RGBA8888 formats.
+
+    \a oldLayout is the layout \a image is in when the copy starts, and
+    \a newLayout is the layout it is transitioned to afterwards. When \a
+    oldLayout is \c{VK_IMAGE_LAYOUT_UNDEFINED}, the previous contents are
+    discarded, and the copy is executed on transferQueue(). With a dedicated
+    transfer queue, it then runs in parallel with the rendering of earlier
+    frames, and ownership of the image is transferred to the graphics queue
+    family afterwards. Otherwise, the copy is executed on the graphics queue
+    before the command buffer of the next frame.
+
+    The results are visible to all commands of the frame that follows the
+    call, that is, of the next call to frameReady(). The image must not be
+    used by frames that are still in flight.
+
+    Returns \c false if the staging buffer has no room left for the image
+    data, or if recording the copy failed.
+
+    \note Calling this function is only valid from the invocation of
+    QVulkanWindowRenderer::initResources() up until
+    QVulkanWindowRenderer::releaseResources().
+
+    \since 5.11
+    \sa uploadBuffer(), setStagingBufferSize()
+ */
+bool QVulkanWindow::uploadImage(VkImage image, const QImage &data,
+                                VkImageLayout oldLayout, VkImageLayout newLayout)
+{
+    Q_D(QVulkanWindow);
+    if (!d->dev) {
+        qWarning("QVulkanWindow: Attempted to upload an image without a device");
+        return false;
+    }
+    if (data.isNull())
+        return false;
+    if (!d->ensureStagingBuffer())
+        return false;
+
+    QImage src = data;
+    if (src.format() != QImage::Format_RGBA8888 && src.format() != QImage::Format_RGBA8888_Premultiplied
+            && src.format() != QImage::Format_RGBX8888)
+        src = src.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+
+    const bool onTransferQueue = d->transferQueueFamilyIdx != d->gfxQueueFamilyIdx
+            && d->transferQueueCopiesAnyRegion && oldLayout == VK_IMAGE_LAYOUT_UNDEFINED;
+    VkCommandBuffer cb = d->uploadCommandBuffer(onTransferQueue);
+    VkCommandBuffer acquireCb = onTransferQueue ? d->uploadCommandBuffer(false) : VK_NULL_HANDLE;
+    if (!cb || (onTransferQueue && !acquireCb))
+        return false;
+
+    const VkDeviceSize rowSize = VkDeviceSize(src.width()) * 4;
+    const VkDeviceSize size = rowSize * src.height();
+    const VkDeviceSize alignment = qMax<VkDeviceSize>(4, d->physDevProps[d->physDevIndex].limits.optimalBufferCopyOffsetAlignment);
+    VkDeviceSize stagingOffset;
+    if (!d->allocateStaging(size, alignment, &stagingOffset))
+        return false;
+
+    quint8 *p = d->stagingPtr + stagingOffset;
+    if (VkDeviceSize(src.bytesPerLine()) == rowSize) {
+        memcpy(p, src.constBits(), size);
+    } else {
+        for (int y = 0; y < src.height(); ++y, p += rowSize)
+            memcpy(p, src.constScanLine(y), rowSize);
+    }
+
+    QVulkanDeviceFunctions *df = d->devFuncs;
+    const bool discard = oldLayout == VK_IMAGE_LAYOUT_UNDEFINED;
+    qvk_imageBarrier(df, cb, image, oldLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                     discard ? 0 : VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                     discard ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                     VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    VkBufferImageCopy region;
+    memset(&region, 0, sizeof(region));
+    region.bufferOffset = stagingOffset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent.width = src.width();
+    region.imageExtent.height = src.height();
+    region.imageExtent.depth = 1;
+    df->vkCmdCopyBufferToImage(cb, d->stagingBuf, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    if (onTransferQueue) {
+        // release from the transfer queue family, then acquire on the
+        // graphics queue family, with the same layout transition in both
+        qvk_imageBarrier(df, cb, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, newLayout,
+                         VK_ACCESS_TRANSFER_WRITE_BIT, 0,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         d->transferQueueFamilyIdx, d->gfxQueueFamilyIdx);
+        qvk_imageBarrier(df, acquireCb, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, newLayout,
+                         0, VK_ACCESS_MEMORY_READ_BIT,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         d->transferQueueFamilyIdx, d->gfxQueueFamilyIdx);
+    } else {
+        qvk_imageBarrier(df, cb, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, newLayout,
+                         VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_MEMORY_READ_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
+    return true;
+}
+
 QT_END_NAMESPACE
@@ -82,7 +82,9 @@ class Q_GUI_EXPORT QVulkanWindow : public QWindow
 
 public:
     enum Flag {
-        PersistentResources = 0x01
+        PersistentResources = 0x01,
+        DedicatedTransferQueue = 0x02,
+        AsyncComputeQueue = 0x04
     };
     Q_DECLARE_FLAGS(Flags, Flag)
 
@@ -112,7 +114,13 @@ public:
     const VkPhysicalDeviceProperties *physicalDeviceProperties() const;
     VkDevice device() const;
     VkQueue graphicsQueue() const;
+    uint32_t graphicsQueueFamilyIndex() const;
     VkCommandPool graphicsCommandPool() const;
+    VkQueue transferQueue() const;
+    uint32_t transferQueueFamilyIndex() const;
+    VkQueue computeQueue() const;
+    uint32_t computeQueueFamilyIndex() const;
+    VkCommandPool computeCommandPool() const;
     uint32_t hostVisibleMemoryIndex() const;
     uint32_t deviceLocalMemoryIndex() const;
     VkRenderPass defaultRenderPass() const;
@@ -144,6 +152,13 @@ public:
 
     QMatrix4x4 clipCorrectionMatrix();
 
+    void setStagingBufferSize(VkDeviceSize size);
+    VkDeviceSize stagingBufferSize() const;
+    bool uploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void *data, VkDeviceSize size);
+    bool uploadImage(VkImage image, const QImage &data,
+                     VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                     VkImageLayout newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
 Q_SIGNALS:
     void frameGrabbed(const QImage &image);
 
@@ -83,6 +83,28 @@ public:
     void addReadback();
     void finishBlockingReadback();
 
+    struct UploadBatch {
+        // copies on the dedicated transfer queue, if there is one
+        VkCommandBuffer transferCmdBuf = VK_NULL_HANDLE;
+        VkSemaphore transferSem = VK_NULL_HANDLE;
+        // copies and ownership acquires on the graphics queue, submitted
+        // together with (and before) the frame's command buffer
+        VkCommandBuffer gfxCmdBuf = VK_NULL_HANDLE;
+        bool hasBufferCopies = false;
+        bool usesStaging = false;
+        VkDeviceSize stagingBegin = 0;
+        int imageIndex = -1;
+    };
+    bool ensureStagingBuffer();
+    bool allocateStaging(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize *offset);
+    VkCommandBuffer uploadCommandBuffer(bool onTransferQueue);
+    bool finishPendingUploads();
+    void releaseUploadBatch(UploadBatch *batch);
+    void releaseFinishedUploads();
+    void releaseUploadsUpTo(int imageIndex);
+    void releaseAllUploads();
+    void releaseStagingBuffer();
+
     enum Status {
         StatusUninitialized,
         StatusFail,
@@ -107,10 +129,17 @@ public:
     QVulkanDeviceFunctions *devFuncs;
     uint32_t gfxQueueFamilyIdx;
     uint32_t presQueueFamilyIdx;
+    uint32_t transferQueueFamilyIdx;
+    uint32_t computeQueueFamilyIdx;
     VkQueue gfxQueue;
     VkQueue presQueue;
+    VkQueue transferQueue;
+    VkQueue computeQueue;
+    bool transferQueueCopiesAnyRegion = false;
     VkCommandPool cmdPool = VK_NULL_HANDLE;
     VkCommandPool presCmdPool = VK_NULL_HANDLE;
+    VkCommandPool transferCmdPool = VK_NULL_HANDLE;
+    VkCommandPool computeCmdPool = VK_NULL_HANDLE;
     uint32_t hostVisibleMemIndex;
     uint32_t deviceLocalMemIndex;
     VkFormat colorFormat;
@@ -179,6 +208,14 @@ public:
     VkDeviceMemory frameGrabImageMem = VK_NULL_HANDLE;
 
     QMatrix4x4 m_clipCorrect;
+
+    VkDeviceSize stagingBufSize = 4 * 1024 * 1024;
+    VkBuffer stagingBuf = VK_NULL_HANDLE;
+    VkDeviceMemory stagingBufMem = VK_NULL_HANDLE;
+    quint8 *stagingPtr = nullptr;
+    VkDeviceSize stagingHead = 0;
+    UploadBatch pendingUpload;
+    QVector<UploadBatch> uploadsInFlight;
 };
 
 QT_END_NAMESPACE
@@ -91,7 +91,18 @@ qtConfig(networkdiskcache) {
     SOURCES += access/qnetworkdiskcache.cpp
 }
 
+qtConfig(networkmemorycache) {
+    HEADERS += \
+        access/qnetworkmemorycache_p.h \
+        access/qnetworkmemorycache.h
+
+    SOURCES += access/qnetworkmemorycache.cpp
+}
+
 mac: LIBS_PRIVATE += -framework Security
 
+qtConfig(brotli): QMAKE_USE_PRIVATE += brotli
+qtConfig(zstd): QMAKE_USE_PRIVATE += zstd
+
 include($$PWD/../../3rdparty/zlib_dependency.pri)
 include($$PWD/http2/http2.pri)
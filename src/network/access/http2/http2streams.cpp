@@ -57,7 +57,8 @@ Stream::Stream(const HttpMessagePair &message, quint32 id, qint32 sendSize, qint
     : httpPair(message),
       streamID(id),
       sendWindow(sendSize),
-      recvWindow(recvSize)
+      recvWindow(recvSize),
+      recvWindowSize(recvSize)
 {
 }
 
@@ -65,6 +66,7 @@ Stream::Stream(const QString &cacheKey, quint32 id, qint32 recvSize)
     : streamID(id),
       // sendWindow is 0, this stream only receives data
       recvWindow(recvSize),
+      recvWindowSize(recvSize),
       state(remoteReserved),
       key(cacheKey)
 {
@@ -100,6 +100,9 @@ struct Q_AUTOTEST_EXPORT Stream
     // Signed as window sizes can become negative:
     qint32 sendWindow = 65535;
     qint32 recvWindow = 65535;
+    // The size we refill recvWindow to; it grows for streams that keep
+    // exhausting their window (see QHttp2ProtocolHandler::handleDATA):
+    qint32 recvWindowSize = 65535;
 
     StreamState state = idle;
     QString key; // for PUSH_PROMISE
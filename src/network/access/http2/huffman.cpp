@@ -352,30 +352,6 @@ const CodeEntry staticHuffmanCodeTable[]
     {256, 0xfffffffcul, 30}   // EOS 11111111|11111111|11111111|111111
 };
 
-void write_huffman_code(BitOStream &outputStream, const CodeEntry &code)
-{
-    // Append octet by octet.
-    auto bitLength = code.bitLength;
-    const auto hc = code.huffmanCode >> (32 - bitLength);
-
-    if (bitLength > 24) {
-        outputStream.writeBits(uchar(hc >> 24), bitLength - 24);
-        bitLength = 24;
-    }
-
-    if (bitLength > 16) {
-        outputStream.writeBits(uchar(hc >> 16), bitLength - 16);
-        bitLength = 16;
-    }
-
-    if (bitLength > 8) {
-        outputStream.writeBits(uchar(hc >> 8), bitLength - 8);
-        bitLength = 8;
-    }
-
-    outputStream.writeBits(uchar(hc), bitLength);
-}
-
 }
 
 // That's from HPACK's specs - we deal with octets.
@@ -385,17 +361,31 @@ quint64 huffman_encoded_bit_length(const QByteArray &inputData)
 {
     quint64 bitLength = 0;
     for (int i = 0, e = inputData.size(); i < e; ++i)
-        bitLength += staticHuffmanCodeTable[int(inputData[i])].bitLength;
+        bitLength += staticHuffmanCodeTable[uchar(inputData[i])].bitLength;
 
     return bitLength;
 }
 
 void huffman_encode_string(const QByteArray &inputData, BitOStream &outputStream)
 {
-    for (int i = 0, e = inputData.size(); i < e; ++i)
-        write_huffman_code(outputStream, staticHuffmanCodeTable[int(inputData[i])]);
+    // Codes are collected in 'bits' (at most 7 + 30 bits pending at any time)
+    // and written out octet by octet, instead of splitting every code into
+    // 8-bit chunks.
+    quint64 bits = 0;
+    quint32 pending = 0;
+    for (int i = 0, e = inputData.size(); i < e; ++i) {
+        const CodeEntry &code = staticHuffmanCodeTable[uchar(inputData[i])];
+        bits = (bits << code.bitLength) | (code.huffmanCode >> (32 - code.bitLength));
+        pending += code.bitLength;
+        while (pending >= 8) {
+            pending -= 8;
+            outputStream.writeBits(uchar(bits >> pending), 8);
+        }
+    }
 
     // Pad bits ...
+    if (pending)
+        outputStream.writeBits(uchar(bits & ((1 << pending) - 1)), quint8(pending));
     if (outputStream.bitLength() % 8)
         outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
 }
@@ -492,15 +482,28 @@ HuffmanDecoder::HuffmanDecoder()
 
 bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
 {
+    // The shortest code has 'minCodeLength' bits, which gives us the upper
+    // bound for the decoded size; we write directly into the buffer and
+    // shrink it when done, instead of appending byte by byte.
+    const int oldSize = outputBuffer.size();
+    const quint64 maxLength = (inputStream.bitLength() - inputStream.streamOffset()) / minCodeLength;
+    outputBuffer.resize(oldSize + int(maxLength));
+    char *const begin = outputBuffer.data() + oldSize;
+    char *dst = begin;
+
+    bool result = false;
     while (true) {
         quint32 chunk = 0;
         const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
+        if (!readBits) {
+            result = !inputStream.hasMoreBits();
+            break;
+        }
 
         if (readBits < minCodeLength) {
             inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            result = padding_is_valid(chunk, readBits);
+            break;
         }
 
         quint32 tableIndex = 0;
@@ -520,20 +523,23 @@ bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuf
 
         if (entry.bitLength > readBits) {
             inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            result = padding_is_valid(chunk, readBits);
+            break;
         }
 
         if (!entry.bitLength || entry.byteValue == 256) {
             //EOS (256) == compression error (HPACK).
             inputStream.skipBits(readBits);
-            return false;
+            break;
         }
 
-        outputBuffer.append(entry.byteValue);
+        Q_ASSERT(dst - begin < int(maxLength));
+        *dst++ = char(entry.byteValue);
         inputStream.skipBits(entry.bitLength);
     }
 
-    return false;
+    outputBuffer.resize(oldSize + int(dst - begin));
+    return result;
 }
 
 quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
@@ -414,7 +414,7 @@ void QNetworkCacheMetaDataPrivate::load(QDataStream &in, QNetworkCacheMetaData &
     QNetworkAccessManager.  QAbstractNetworkCache is an abstract class and cannot be
     instantiated.
 
-    \sa QNetworkDiskCache
+    \sa QNetworkDiskCache, QNetworkMemoryCache
 */
 
 /*!
@@ -44,6 +44,8 @@
 #include "QtCore/qvector.h"
 #include "QtCore/qlist.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 static bool is_valid_domain_name(const QString &host)
@@ -121,14 +123,13 @@ void QHstsCache::updateKnownHost(const QString &host, const QDateTime &expires,
     // HSTS is a per-host policy, regardless of protocol, port or any of the other
     // details in an URL; so we only want the host part.  QUrl::host handles
     // IDNA 2003 (RFC3490) for us, as required by HSTS (RFC6797, section 10).
-    const HostName hostName(host);
-    const auto pos = knownHosts.find(hostName);
     QHstsPolicy::PolicyFlags flags;
     if (includeSubDomains)
         flags = QHstsPolicy::IncludeSubDomains;
 
-    const QHstsPolicy newPolicy(expires, flags, hostName.name);
-    if (pos == knownHosts.end()) {
+    const QHstsPolicy newPolicy(expires, flags, host);
+    const int node = findNode(host);
+    if (node == -1 || !nodes.at(node).hasPolicy) {
         // A new, previously unknown host.
         if (newPolicy.isExpired()) {
             // Nothing to do at all - we did not know this host previously,
@@ -136,23 +137,87 @@ void QHstsCache::updateKnownHost(const QString &host, const QDateTime &expires,
             return;
         }
 
-        knownHosts.insert(pos, hostName, newPolicy);
+        Node &newNode = nodes[insertNode(host)];
+        newNode.policy = newPolicy;
+        newNode.hasPolicy = true;
         if (hstsStore)
             hstsStore->addToObserved(newPolicy);
         return;
     }
 
-    if (newPolicy.isExpired())
-        knownHosts.erase(pos);
-    else  if (*pos != newPolicy)
-        *pos = std::move(newPolicy);
-    else
+    Node &knownNode = nodes[node];
+    if (newPolicy.isExpired()) {
+        knownNode.policy = QHstsPolicy();
+        knownNode.hasPolicy = false;
+    } else if (knownNode.policy != newPolicy) {
+        knownNode.policy = newPolicy;
+    } else {
         return;
+    }
 
     if (hstsStore)
         hstsStore->addToObserved(newPolicy);
 }
 
+// Calls 'f' with every label of 'hostName', from the top-level domain down,
+// until it returns false. The labels refer to 'hostName'.
+template <typename F>
+static void forEachLabel(const QString &hostName, F f)
+{
+    int end = hostName.size();
+    forever {
+        const int dot = end > 0 ? hostName.lastIndexOf(QLatin1Char('.'), end - 1) : -1;
+        if (!f(hostName.midRef(dot + 1, end - dot - 1), dot == -1) || dot == -1)
+            return;
+        end = dot;
+    }
+}
+
+int QHstsCache::findChild(int node, const QStringRef &label) const
+{
+    const QVector<int> &children = nodes.at(node).children;
+    const auto pos = std::lower_bound(children.cbegin(), children.cend(), label,
+                                      [this](int child, const QStringRef &label) {
+        return QStringRef(&nodes.at(child).label) < label;
+    });
+    if (pos != children.cend() && nodes.at(*pos).label == label)
+        return *pos;
+    return -1;
+}
+
+int QHstsCache::findNode(const QString &hostName) const
+{
+    int node = 0;
+    forEachLabel(hostName, [&](const QStringRef &label, bool) {
+        node = findChild(node, label);
+        return node != -1;
+    });
+    return node;
+}
+
+int QHstsCache::insertNode(const QString &hostName)
+{
+    int node = 0;
+    forEachLabel(hostName, [&](const QStringRef &label, bool) {
+        int child = findChild(node, label);
+        if (child == -1) {
+            child = nodes.size();
+            Node newNode;
+            newNode.label = label.toString();
+            nodes.append(newNode);
+            QVector<int> &children = nodes[node].children;
+            const auto pos = std::lower_bound(children.begin(), children.end(), label,
+                                              [this](int child, const QStringRef &label) {
+                return QStringRef(&nodes.at(child).label) < label;
+            });
+            children.insert(pos, child);
+        }
+        node = child;
+        return true;
+    });
+    return node;
+}
+
 bool QHstsCache::isKnownHost(const QUrl &url) const
 {
     if (!url.isValid() || !is_valid_domain_name(url.host()))
@@ -173,51 +238,50 @@ bool QHstsCache::isKnownHost(const QUrl &url) const
           further labels to compare -- then the given domain name
           congruently matches this Known HSTS Host.
 
-        We start from the congruent match, and then chop labels and dots and
-        proceed with superdomain match. While RFC6797 recommends to start from
-        superdomain, the result is the same - some valid policy will make a host
-        known.
+        We walk down the trie from the top-level domain, so we see the
+        superdomains first, as RFC6797 recommends, and end with the
+        congruent match.
     */
 
-    bool superDomainMatch = false;
+    bool known = false;
     const QString hostNameAsString(url.host());
-    HostName nameToTest(static_cast<QStringRef>(&hostNameAsString));
-    while (nameToTest.fragment.size()) {
-        auto const pos = knownHosts.find(nameToTest);
-        if (pos != knownHosts.end()) {
-            if (pos.value().isExpired()) {
-                knownHosts.erase(pos);
-                if (hstsStore) {
-                    // Inform our store that this policy has expired.
-                    hstsStore->addToObserved(pos.value());
-                }
-            } else if (!superDomainMatch || pos.value().includesSubDomains()) {
-                return true;
+    int node = 0;
+    forEachLabel(hostNameAsString, [&](const QStringRef &label, bool congruent) {
+        node = findChild(node, label);
+        if (node == -1)
+            return false;
+        Node &candidate = nodes[node];
+        if (!candidate.hasPolicy)
+            return true;
+        if (candidate.policy.isExpired()) {
+            const QHstsPolicy expired = candidate.policy;
+            candidate.policy = QHstsPolicy();
+            candidate.hasPolicy = false;
+            if (hstsStore) {
+                // Inform our store that this policy has expired.
+                hstsStore->addToObserved(expired);
             }
+            return true;
         }
+        known = congruent || candidate.policy.includesSubDomains();
+        return !known;
+    });
 
-        const int dot = nameToTest.fragment.indexOf(QLatin1Char('.'));
-        if (dot == -1)
-            break;
-
-        nameToTest.fragment = nameToTest.fragment.mid(dot + 1);
-        superDomainMatch = true;
-    }
-
-    return false;
+    return known;
 }
 
 void QHstsCache::clear()
 {
-    knownHosts.clear();
+    nodes = QVector<Node>(1);
 }
 
 QVector<QHstsPolicy> QHstsCache::policies() const
 {
     QVector<QHstsPolicy> values;
-    values.reserve(knownHosts.size());
-    for (const auto &host : knownHosts)
-        values << host;
+    for (const Node &node : qAsConst(nodes)) {
+        if (node.hasPolicy)
+            values << node.policy;
+    }
     return values;
 }
 
@@ -233,8 +297,8 @@ void QHstsCache::setStore(QHstsStore *store)
         // First we augment our store with the policies we already know about
         // (and thus the cached policy takes priority over whatever policy we
         // had in the store for the same host, if any).
-        if (knownHosts.size()) {
-            const QVector<QHstsPolicy> observed(policies());
+        const QVector<QHstsPolicy> observed(policies());
+        if (observed.size()) {
             for (const auto &policy : observed)
                 hstsStore->addToObserved(policy);
             hstsStore->synchronize();
@@ -61,12 +61,11 @@
 #include <QtCore/qglobal.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qurl.h>
-#include <QtCore/qmap.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
 template<typename T> class QList;
-template <typename T> class QVector;
 
 class QHstsStore;
 
@@ -91,33 +90,22 @@ private:
     void updateKnownHost(const QString &hostName, const QDateTime &expires,
                          bool includeSubDomains);
 
-    struct HostName
+    // Known hosts are kept in a trie of domain labels, starting from the
+    // top-level domain, so that a lookup walks the labels of a host name once
+    // and compares them in place, without copying them.
+    struct Node
     {
-        explicit HostName(const QString &n) : name(n) { }
-        explicit HostName(const QStringRef &r) : fragment(r) { }
-
-        bool operator < (const HostName &rhs) const
-        {
-            if (fragment.size()) {
-                if (rhs.fragment.size())
-                    return fragment < rhs.fragment;
-                return fragment < QStringRef(&rhs.name);
-            }
-
-            if (rhs.fragment.size())
-                return QStringRef(&name) < rhs.fragment;
-            return name < rhs.name;
-        }
-
-        // We use 'name' for a HostName object contained in our dictionary;
-        // we use 'fragment' only during lookup, when chopping the complete host
-        // name, removing subdomain names (such HostName object is 'transient', it
-        // must not outlive the original QString object.
-        QString name;
-        QStringRef fragment;
+        QString label;
+        QVector<int> children; // indexes into nodes, sorted by label
+        QHstsPolicy policy;
+        bool hasPolicy = false;
     };
 
-    mutable QMap<HostName, QHstsPolicy> knownHosts;
+    int findChild(int node, const QStringRef &label) const;
+    int findNode(const QString &hostName) const;
+    int insertNode(const QString &hostName);
+
+    mutable QVector<Node> nodes = QVector<Node>(1); // nodes[0] is the root
     QHstsStore *hstsStore = nullptr;
 };
 
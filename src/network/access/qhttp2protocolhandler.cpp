@@ -470,14 +470,20 @@ bool QHttp2ProtocolHandler::sendDATA(Stream &stream)
     const auto replyPrivate = reply->d_func();
     Q_ASSERT(replyPrivate);
 
+    // Without a content length the data is streamed, and the stream
+    // ends when the upload device is at the end.
+    const bool streamed = request.contentLength() == -1;
     auto slot = std::min<qint32>(sessionSendWindowSize, stream.sendWindow);
     while (!stream.data()->atEnd() && slot) {
         qint64 chunkSize = 0;
         const uchar *src =
             reinterpret_cast<const uchar *>(stream.data()->readPointer(slot, chunkSize));
 
-        if (chunkSize == -1)
+        if (chunkSize == -1) {
+            if (streamed && stream.data()->atEnd())
+                break;
             return false;
+        }
 
         if (!src || !chunkSize) {
             // Stream is not suspended by the flow control,
@@ -500,7 +506,8 @@ bool QHttp2ProtocolHandler::sendDATA(Stream &stream)
         slot = std::min(sessionSendWindowSize, stream.sendWindow);
     }
 
-    if (replyPrivate->totallyUploadedData == request.contentLength()) {
+    if (streamed ? stream.data()->atEnd()
+                 : replyPrivate->totallyUploadedData == request.contentLength()) {
         frameWriter.start(FrameType::DATA, FrameFlag::END_STREAM, stream.streamID);
         frameWriter.setPayloadSize(0);
         frameWriter.write(*m_socket);
@@ -575,11 +582,16 @@ void QHttp2ProtocolHandler::handleDATA()
             if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
                 finishStream(stream);
                 deleteActiveStream(stream.streamID);
-            } else if (stream.recvWindow < streamInitialReceiveWindowSize / 2) {
+            } else if (stream.recvWindow < stream.recvWindowSize / 2) {
+                // The stream keeps exhausting its window, so the window (and not
+                // the link) is what limits the download speed. Let it grow; the
+                // session window still bounds the amount of data in flight:
+                stream.recvWindowSize = qint32(std::min<qint64>(qint64(stream.recvWindowSize) * 2,
+                                                                maxSessionReceiveWindowSize));
                 QMetaObject::invokeMethod(this, "sendWINDOW_UPDATE", Qt::QueuedConnection,
                                           Q_ARG(quint32, stream.streamID),
-                                          Q_ARG(quint32, streamInitialReceiveWindowSize - stream.recvWindow));
-                stream.recvWindow = streamInitialReceiveWindowSize;
+                                          Q_ARG(quint32, stream.recvWindowSize - stream.recvWindow));
+                stream.recvWindow = stream.recvWindowSize;
             }
         }
     }
@@ -1136,7 +1148,6 @@ void QHttp2ProtocolHandler::updateStream(Stream &stream, const Frame &frame,
         auto &httpRequest = stream.request();
         auto replyPrivate = httpReply->d_func();
 
-        replyPrivate->compressedData.append(data, length);
         replyPrivate->totalProgress += length;
 
         const QByteArray wrapped(data, length);
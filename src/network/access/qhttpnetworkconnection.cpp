@@ -45,6 +45,7 @@
 #include <private/qobject_p.h>
 #include <private/qauthenticator_p.h>
 #include "private/qhostinfo_p.h"
+#include <private/qtnetwork_tracepoints_p.h>
 #include <qnetworkproxy.h>
 #include <qauthenticator.h>
 #include <qcoreapplication.h>
@@ -88,6 +89,7 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(const QString &host
 #endif
                         ? 1 : defaultHttpChannelCount)
   , channelCount(defaultHttpChannelCount)
+  , pipelineLength(defaultPipelineLength)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
@@ -106,7 +108,12 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(quint16 connectionC
                                                              QHttpNetworkConnection::ConnectionType type)
 : state(RunningState), networkLayerState(Unknown),
   hostName(hostName), port(port), encrypt(encrypt), delayIpv4(true),
-  activeChannelCount(connectionCount), channelCount(connectionCount)
+  activeChannelCount(type == QHttpNetworkConnection::ConnectionTypeHTTP2
+#ifndef QT_NO_SSL
+                     || type == QHttpNetworkConnection::ConnectionTypeSPDY
+#endif
+                     ? 1 : connectionCount),
+  channelCount(connectionCount), pipelineLength(defaultPipelineLength)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
@@ -278,8 +285,10 @@ void QHttpNetworkConnectionPrivate::prepareRequest(HttpMessagePair &messagePair)
             request.setContentLength(uploadDeviceSize);
         } else if (contentLength != -1 && uploadDeviceSize == -1) {
             // everything OK, the user supplied us the contentLength
-        } else if (Q_UNLIKELY(contentLength == -1 && uploadDeviceSize == -1)) {
-            qFatal("QHttpNetworkConnectionPrivate: Neither content-length nor upload device size were given");
+        } else if (contentLength == -1 && uploadDeviceSize == -1) {
+            // the data is streamed, send it as it comes in. HTTP/2 drops
+            // this header and ends the stream when the device is at the end
+            request.setHeaderField("Transfer-Encoding", "chunked");
         }
     }
     // set the Connection/Proxy-Connection: Keep-Alive headers
@@ -299,13 +308,20 @@ void QHttpNetworkConnectionPrivate::prepareRequest(HttpMessagePair &messagePair)
 
     // If the request had a accept-encoding set, we better not mess
     // with it. If it was not set, we announce that we understand gzip
-    // and remember this fact in request.d->autoDecompress so that
-    // we can later decompress the HTTP reply if it has such an
-    // encoding.
+    // (and brotli and zstd, if available) and remember this fact in
+    // request.d->autoDecompress so that we can later decompress the
+    // HTTP reply if it has such an encoding.
     value = request.headerField("accept-encoding");
     if (value.isEmpty()) {
 #ifndef QT_NO_COMPRESS
-        request.setHeaderField("Accept-Encoding", "gzip, deflate");
+        request.setHeaderField("Accept-Encoding", "gzip, deflate"
+#if QT_CONFIG(brotli)
+                                                  ", br"
+#endif
+#if QT_CONFIG(zstd)
+                                                  ", zstd"
+#endif
+                               );
         request.d->autoDecompress = true;
 #else
         // if zlib is not available set this to false always
@@ -624,6 +640,11 @@ QHttpNetworkReply* QHttpNetworkConnectionPrivate::queueRequest(const QHttpNetwor
     reply->d_func()->connectionChannel = &channels[0]; // will have the correct one set later
     HttpMessagePair pair = qMakePair(request, reply);
 
+    if (Q_TRACE_ENABLED(QHttpNetworkConnection_queueRequest)) {
+        Q_TRACE(QHttpNetworkConnection_queueRequest, reply,
+                request.url().toEncoded().constData(), int(request.priority()));
+    }
+
     if (request.isPreConnect())
         preConnectRequests++;
 
@@ -738,6 +759,7 @@ bool QHttpNetworkConnectionPrivate::dequeueRequest(QAbstractSocket *socket)
 
 void QHttpNetworkConnectionPrivate::updateChannel(int i, const HttpMessagePair &messagePair)
 {
+    Q_TRACE(QHttpNetworkConnection_dequeueRequest, messagePair.second, i);
     channels[i].request = messagePair.first;
     channels[i].reply = messagePair.second;
     // Now that reply is assigned a channel, correct reply to channel association
@@ -767,7 +789,8 @@ void QHttpNetworkConnectionPrivate::fillPipeline(QAbstractSocket *socket)
     if (channels[i].reply == 0)
         return;
 
-    if (! (defaultPipelineLength - channels[i].alreadyPipelinedRequests.length() >= defaultRePipelineLength)) {
+    if (! (pipelineLength - channels[i].alreadyPipelinedRequests.length()
+           >= qMin(pipelineLength, defaultRePipelineLength))) {
         return;
     }
 
@@ -811,7 +834,7 @@ void QHttpNetworkConnectionPrivate::fillPipeline(QAbstractSocket *socket)
         lengthBefore = channels[i].alreadyPipelinedRequests.length();
         fillPipeline(highPriorityQueue, channels[i]);
 
-        if (channels[i].alreadyPipelinedRequests.length() >= defaultPipelineLength) {
+        if (channels[i].alreadyPipelinedRequests.length() >= pipelineLength) {
             channels[i].pipelineFlush();
             return;
         }
@@ -824,7 +847,7 @@ void QHttpNetworkConnectionPrivate::fillPipeline(QAbstractSocket *socket)
         lengthBefore = channels[i].alreadyPipelinedRequests.length();
         fillPipeline(lowPriorityQueue, channels[i]);
 
-        if (channels[i].alreadyPipelinedRequests.length() >= defaultPipelineLength) {
+        if (channels[i].alreadyPipelinedRequests.length() >= pipelineLength) {
             channels[i].pipelineFlush();
             return;
         }
@@ -1437,6 +1460,19 @@ void QHttpNetworkConnection::setConnectionType(ConnectionType type)
     d->connectionType = type;
 }
 
+int QHttpNetworkConnection::pipelineLength() const
+{
+    Q_D(const QHttpNetworkConnection);
+    return d->pipelineLength;
+}
+
+void QHttpNetworkConnection::setPipelineLength(int length)
+{
+    Q_D(QHttpNetworkConnection);
+    if (length > 0)
+        d->pipelineLength = length;
+}
+
 Http2::ProtocolParameters QHttpNetworkConnection::http2Parameters() const
 {
     Q_D(const QHttpNetworkConnection);
@@ -143,6 +143,9 @@ public:
     Http2::ProtocolParameters http2Parameters() const;
     void setHttp2Parameters(const Http2::ProtocolParameters &params);
 
+    int pipelineLength() const;
+    void setPipelineLength(int length);
+
 #ifndef QT_NO_SSL
     void setSslConfiguration(const QSslConfiguration &config);
     void ignoreSslErrors(int channel = -1);
@@ -253,6 +256,8 @@ public:
     int activeChannelCount;
     // The total number of channels we reserved:
     const int channelCount;
+    // The maximum number of requests pipelined on one channel:
+    int pipelineLength;
     QTimer delayedConnectionTimer;
     QHttpNetworkConnectionChannel *channels; // parallel connections to the server
     bool shouldEmitChannelError(QAbstractSocket *socket);
@@ -50,6 +50,7 @@
 #include <private/qhttp2protocolhandler_p.h>
 #include <private/qhttpprotocolhandler_p.h>
 #include <private/qspdyprotocolhandler_p.h>
+#include <private/qtnetwork_tracepoints_p.h>
 
 #ifndef QT_NO_SSL
 #    include <private/qsslsocket_p.h>
@@ -477,6 +478,8 @@ void QHttpNetworkConnectionChannel::allDone()
     bool connectionCloseEnabled = reply->d_func()->isConnectionCloseEnabled();
     detectPipeliningSupport();
 
+    Q_TRACE(QHttpNetworkConnectionChannel_allDone, reply, reply->statusCode());
+
     handleStatus();
     // handleStatus() might have removed the reply because it already called connection->emitReplyError()
 
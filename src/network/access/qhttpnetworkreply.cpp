@@ -50,6 +50,12 @@
 
 #ifndef QT_NO_COMPRESS
 #include <zlib.h>
+#if QT_CONFIG(brotli)
+#include <brotli/decode.h>
+#endif
+#if QT_CONFIG(zstd)
+#include <zstd.h>
+#endif
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -338,6 +344,12 @@ QHttpNetworkReplyPrivate::QHttpNetworkReplyPrivate(const QUrl &newUrl)
       ,userProvidedDownloadBuffer(0)
 #ifndef QT_NO_COMPRESS
       ,inflateStrm(0)
+#if QT_CONFIG(brotli)
+      ,brotliDecoderState(0)
+#endif
+#if QT_CONFIG(zstd)
+      ,zstdDecoderStream(0)
+#endif
 #endif
 
 {
@@ -353,6 +365,7 @@ QHttpNetworkReplyPrivate::~QHttpNetworkReplyPrivate()
 #ifndef QT_NO_COMPRESS
       if (inflateStrm)
           delete inflateStrm;
+      releaseDecoders();
 #endif
 }
 
@@ -370,6 +383,7 @@ void QHttpNetworkReplyPrivate::clearHttpLayerInformation()
 #ifndef QT_NO_COMPRESS
     if (autoDecompress && inflateStrm)
         inflateEnd(inflateStrm);
+    releaseDecoders();
 #endif
     fields.clear();
 }
@@ -392,7 +406,14 @@ qint64 QHttpNetworkReplyPrivate::bytesAvailable() const
 bool QHttpNetworkReplyPrivate::isCompressed()
 {
     QByteArray encoding = headerField("content-encoding");
-    return qstricmp(encoding.constData(), "gzip") == 0 || qstricmp(encoding.constData(), "deflate") == 0;
+    return qstricmp(encoding.constData(), "gzip") == 0 || qstricmp(encoding.constData(), "deflate") == 0
+#if QT_CONFIG(brotli)
+        || qstricmp(encoding.constData(), "br") == 0
+#endif
+#if QT_CONFIG(zstd)
+        || qstricmp(encoding.constData(), "zstd") == 0
+#endif
+        ;
 }
 
 void QHttpNetworkReplyPrivate::removeAutoDecompressHeader()
@@ -595,8 +616,10 @@ qint64 QHttpNetworkReplyPrivate::readHeader(QAbstractSocket *socket)
             (connectionHeaderField.isEmpty() && !headerField("proxy-connection").toLower().contains("keep-alive")));
 
 #ifndef QT_NO_COMPRESS
-        if (autoDecompress && isCompressed()) {
-            // allocate inflate state
+        const QByteArray encoding = headerField("content-encoding");
+        if (autoDecompress && (qstricmp(encoding.constData(), "gzip") == 0
+                               || qstricmp(encoding.constData(), "deflate") == 0)) {
+            // allocate inflate state, the other decoders are created on first use
             if (!inflateStrm)
                 inflateStrm = new z_stream;
             int ret = initializeInflateStream();
@@ -707,8 +730,9 @@ qint64 QHttpNetworkReplyPrivate::readBody(QAbstractSocket *socket, QByteDataBuff
     qint64 bytes = 0;
 
 #ifndef QT_NO_COMPRESS
-    // for gzip we'll allocate a temporary one that we then decompress
-    QByteDataBuffer *tempOutDataBuffer = (autoDecompress ? new QByteDataBuffer : out);
+    // for compressed data we use a temporary one that we then decompress
+    QByteDataBuffer compressedDataBuffer;
+    QByteDataBuffer *tempOutDataBuffer = (autoDecompress ? &compressedDataBuffer : out);
 #else
     QByteDataBuffer *tempOutDataBuffer = out;
 #endif
@@ -731,7 +755,6 @@ qint64 QHttpNetworkReplyPrivate::readBody(QAbstractSocket *socket, QByteDataBuff
     // This is true if there is compressed encoding and we're supposed to use it.
     if (autoDecompress) {
         qint64 uncompressRet = uncompressBodyData(tempOutDataBuffer, out);
-        delete tempOutDataBuffer;
         if (uncompressRet < 0)
             return -1;
     }
@@ -759,7 +782,40 @@ int QHttpNetworkReplyPrivate::initializeInflateStream()
     return ret;
 }
 
+void QHttpNetworkReplyPrivate::releaseDecoders()
+{
+    // the inflate stream is kept around, it is reinitialized for the next reply
+#if QT_CONFIG(brotli)
+    if (brotliDecoderState) {
+        BrotliDecoderDestroyInstance(brotliDecoderState);
+        brotliDecoderState = 0;
+    }
+#endif
+#if QT_CONFIG(zstd)
+    if (zstdDecoderStream) {
+        ZSTD_freeDStream(zstdDecoderStream);
+        zstdDecoderStream = 0;
+    }
+#endif
+}
+
 qint64 QHttpNetworkReplyPrivate::uncompressBodyData(QByteDataBuffer *in, QByteDataBuffer *out)
+{
+#if QT_CONFIG(brotli) || QT_CONFIG(zstd)
+    const QByteArray encoding = headerField("content-encoding");
+#endif
+#if QT_CONFIG(brotli)
+    if (qstricmp(encoding.constData(), "br") == 0)
+        return brotliDecodeBodyData(in, out);
+#endif
+#if QT_CONFIG(zstd)
+    if (qstricmp(encoding.constData(), "zstd") == 0)
+        return zstdDecodeBodyData(in, out);
+#endif
+    return inflateBodyData(in, out);
+}
+
+qint64 QHttpNetworkReplyPrivate::inflateBodyData(QByteDataBuffer *in, QByteDataBuffer *out)
 {
     if (!inflateStrm) { // happens when called from the SPDY protocol handler
         inflateStrm = new z_stream;
@@ -814,6 +870,79 @@ qint64 QHttpNetworkReplyPrivate::uncompressBodyData(QByteDataBuffer *in, QByteDa
 
     return out->byteAmount();
 }
+
+#if QT_CONFIG(brotli)
+qint64 QHttpNetworkReplyPrivate::brotliDecodeBodyData(QByteDataBuffer *in, QByteDataBuffer *out)
+{
+    if (!brotliDecoderState)
+        brotliDecoderState = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+    if (!brotliDecoderState)
+        return -1;
+
+    for (int i = 0; i < in->bufferCount(); i++) {
+        const QByteArray &bIn = (*in)[i];
+
+        size_t availableIn = bIn.size();
+        const uint8_t *nextIn = reinterpret_cast<const uint8_t *>(bIn.constData());
+
+        BrotliDecoderResult result;
+        do {
+            QByteArray bOut;
+            // make a wild guess about the uncompressed size.
+            bOut.reserve(int(availableIn) * 4 + 512);
+            size_t availableOut = bOut.capacity();
+            uint8_t *nextOut = reinterpret_cast<uint8_t *>(bOut.data());
+
+            result = BrotliDecoderDecompressStream(brotliDecoderState, &availableIn, &nextIn,
+                                                   &availableOut, &nextOut, nullptr);
+            if (result == BROTLI_DECODER_RESULT_ERROR)
+                return -1;
+            bOut.resize(bOut.capacity() - int(availableOut));
+            if (!bOut.isEmpty())
+                out->append(bOut);
+            if (result == BROTLI_DECODER_RESULT_SUCCESS)
+                return out->byteAmount();
+        } while (result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT);
+    }
+
+    return out->byteAmount();
+}
+#endif
+
+#if QT_CONFIG(zstd)
+qint64 QHttpNetworkReplyPrivate::zstdDecodeBodyData(QByteDataBuffer *in, QByteDataBuffer *out)
+{
+    if (!zstdDecoderStream) {
+        zstdDecoderStream = ZSTD_createDStream();
+        if (!zstdDecoderStream || ZSTD_isError(ZSTD_initDStream(zstdDecoderStream)))
+            return -1;
+    }
+
+    for (int i = 0; i < in->bufferCount(); i++) {
+        const QByteArray &bIn = (*in)[i];
+
+        ZSTD_inBuffer input = { bIn.constData(), size_t(bIn.size()), 0 };
+        bool outputFull;
+        do {
+            QByteArray bOut;
+            // make a wild guess about the uncompressed size.
+            bOut.reserve(int(input.size - input.pos) * 4 + 512);
+            ZSTD_outBuffer output = { bOut.data(), size_t(bOut.capacity()), 0 };
+
+            const size_t ret = ZSTD_decompressStream(zstdDecoderStream, &output, &input);
+            if (ZSTD_isError(ret))
+                return -1;
+            bOut.resize(int(output.pos));
+            if (!bOut.isEmpty())
+                out->append(bOut);
+            // a full output buffer may leave data inside the decoder
+            outputFull = (output.pos == output.size);
+        } while (input.pos < input.size || outputFull);
+    }
+
+    return out->byteAmount();
+}
+#endif
 #endif
 
 qint64 QHttpNetworkReplyPrivate::readReplyBodyRaw(QAbstractSocket *socket, QByteDataBuffer *out, qint64 size)
@@ -987,7 +1116,6 @@ bool QHttpNetworkReplyPrivate::expectContent()
 
 void QHttpNetworkReplyPrivate::eraseData()
 {
-    compressedData.clear();
     responseData.clear();
 }
 
@@ -59,6 +59,12 @@
 
 #ifndef QT_NO_COMPRESS
 struct z_stream_s;
+#if QT_CONFIG(brotli)
+struct BrotliDecoderStateStruct;
+#endif
+#if QT_CONFIG(zstd)
+struct ZSTD_DCtx_s;
+#endif
 #endif
 
 #include <QtNetwork/qtcpsocket.h>
@@ -263,7 +269,6 @@ public:
     bool autoDecompress;
 
     QByteDataBuffer responseData; // uncompressed body
-    QByteArray compressedData; // compressed body (temporary)
     bool requestIsPrepared;
 
     bool pipeliningUsed;
@@ -275,8 +280,22 @@ public:
 
 #ifndef QT_NO_COMPRESS
     z_stream_s *inflateStrm;
+#if QT_CONFIG(brotli)
+    BrotliDecoderStateStruct *brotliDecoderState;
+#endif
+#if QT_CONFIG(zstd)
+    ZSTD_DCtx_s *zstdDecoderStream;
+#endif
     int initializeInflateStream();
     qint64 uncompressBodyData(QByteDataBuffer *in, QByteDataBuffer *out);
+    qint64 inflateBodyData(QByteDataBuffer *in, QByteDataBuffer *out);
+#if QT_CONFIG(brotli)
+    qint64 brotliDecodeBodyData(QByteDataBuffer *in, QByteDataBuffer *out);
+#endif
+#if QT_CONFIG(zstd)
+    qint64 zstdDecodeBodyData(QByteDataBuffer *in, QByteDataBuffer *out);
+#endif
+    void releaseDecoders();
 #endif
 };
 
@@ -355,6 +355,9 @@ bool QHttpProtocolHandler::sendRequest()
         const qint64 socketBufferFill = 32*1024;
         const qint64 socketWriteMaxSize = 16*1024;
 
+        // without a content length, the data goes out with chunked transfer encoding
+        const bool chunked = (m_channel->bytesTotal == -1);
+
 
 #ifndef QT_NO_SSL
         QSslSocket *sslSocket = qobject_cast<QSslSocket*>(m_socket);
@@ -368,10 +371,21 @@ bool QHttpProtocolHandler::sendRequest()
         {
             // get pointer to upload data
             qint64 currentReadSize = 0;
-            qint64 desiredReadSize = qMin(socketWriteMaxSize, m_channel->bytesTotal - m_channel->written);
+            qint64 desiredReadSize = chunked ? socketWriteMaxSize
+                                             : qMin(socketWriteMaxSize, m_channel->bytesTotal - m_channel->written);
             const char *readPointer = uploadByteDevice->readPointer(desiredReadSize, currentReadSize);
 
-            if (currentReadSize == -1) {
+            if (chunked && currentReadSize == -1 && uploadByteDevice->atEnd()) {
+                // the last chunk
+                if (m_socket->write("0\r\n\r\n", 5) != 5) {
+                    m_connection->d_func()->emitReplyError(m_socket, m_reply, QNetworkReply::UnknownNetworkError);
+                    return false;
+                }
+                emit m_reply->dataSendProgress(m_channel->written, m_channel->written);
+                m_channel->state = QHttpNetworkConnectionChannel::WaitingState;
+                sendRequest();
+                break;
+            } else if (currentReadSize == -1) {
                 // premature eof happened
                 m_connection->d_func()->emitReplyError(m_socket, m_reply, QNetworkReply::UnknownNetworkError);
                 return false;
@@ -386,7 +400,16 @@ bool QHttpProtocolHandler::sendRequest()
                     m_connection->d_func()->emitReplyError(m_socket, m_reply, QNetworkReply::ProtocolFailure);
                     return false;
                 }
+                if (chunked) {
+                    const QByteArray chunkHeader = QByteArray::number(currentReadSize, 16) + "\r\n";
+                    if (m_socket->write(chunkHeader) != chunkHeader.size()) {
+                        m_connection->d_func()->emitReplyError(m_socket, m_reply, QNetworkReply::UnknownNetworkError);
+                        return false;
+                    }
+                }
                 qint64 currentWriteSize = m_socket->write(readPointer, currentReadSize);
+                if (chunked && currentWriteSize == currentReadSize && m_socket->write("\r\n", 2) != 2)
+                    currentWriteSize = -1;
                 if (currentWriteSize == -1 || currentWriteSize != currentReadSize) {
                     // socket broke down
                     m_connection->d_func()->emitReplyError(m_socket, m_reply, QNetworkReply::UnknownNetworkError);
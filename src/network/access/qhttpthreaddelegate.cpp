@@ -182,21 +182,26 @@ class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
     // Q_OBJECT
 public:
 #ifdef QT_NO_BEARERMANAGEMENT
-    QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
+    QNetworkAccessCachedHttpConnection(quint16 channelCount, const QString &hostName, quint16 port,
+                                       bool encrypt,
                                        QHttpNetworkConnection::ConnectionType connectionType)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType)
+        : QHttpNetworkConnection(channelCount, hostName, port, encrypt, /*parent=*/0,
+                                 connectionType)
 #else
-    QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
+    QNetworkAccessCachedHttpConnection(quint16 channelCount, const QString &hostName, quint16 port,
+                                       bool encrypt,
                                        QHttpNetworkConnection::ConnectionType connectionType,
                                        QSharedPointer<QNetworkSession> networkSession)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType, /*parent=*/0,
-                                 qMove(networkSession))
+        : QHttpNetworkConnection(channelCount, hostName, port, encrypt, /*parent=*/0,
+                                 qMove(networkSession), connectionType)
 #endif
     {
         setExpires(true);
         setShareable(true);
     }
 
+    using QNetworkAccessCache::CacheableObject::setExpiryTimeout;
+
     virtual void dispose() Q_DECL_OVERRIDE
     {
 #if 0  // sample code; do this right with the API
@@ -219,11 +224,35 @@ QHttpThreadDelegate::~QHttpThreadDelegate()
 
     // Get the object cache that stores our QHttpNetworkConnection objects
     // and release the entry for this QHttpNetworkConnection
-    if (connections.hasLocalData() && !cacheKey.isEmpty()) {
-        connections.localData()->releaseEntry(cacheKey);
+    if (!cacheKey.isEmpty()) {
+        // The timeout of the last request applies once the connection is idle
+    if (idleTimeout >= 0)
+        httpConnection->setExpiryTimeout(idleTimeout);
+
+    if (inManagerThread) {
+            // Clearing the manager's cache disposes of the connection
+            if (managerConnectionCache && managerConnection)
+                managerConnectionCache->releaseEntry(cacheKey);
+        } else if (connections.hasLocalData()) {
+            connections.localData()->releaseEntry(cacheKey);
+        }
     }
 }
 
+QNetworkAccessCache *QHttpThreadDelegate::cache()
+{
+    if (inManagerThread) {
+        Q_ASSERT(managerConnectionCache);
+        return managerConnectionCache.data();
+    }
+
+    // Check QThreadStorage for the QNetworkAccessCache
+    // If not there, create this connection cache
+    if (!connections.hasLocalData())
+        connections.setLocalData(new QNetworkAccessCache());
+    return connections.localData();
+}
+
 
 QHttpThreadDelegate::QHttpThreadDelegate(QObject *parent) :
     QObject(parent)
@@ -240,6 +269,10 @@ QHttpThreadDelegate::QHttpThreadDelegate(QObject *parent) :
     , incomingContentLength(-1)
     , removedContentLength(-1)
     , incomingErrorCode(QNetworkReply::NoError)
+    , channelCount(0)
+    , pipelineLength(0)
+    , idleTimeout(-1)
+    , inManagerThread(false)
     , downloadBuffer()
     , httpConnection(0)
     , httpReply(0)
@@ -279,11 +312,7 @@ void QHttpThreadDelegate::startRequest()
 #ifdef QHTTPTHREADDELEGATE_DEBUG
     qDebug() << "QHttpThreadDelegate::startRequest() thread=" << QThread::currentThreadId();
 #endif
-    // Check QThreadStorage for the QNetworkAccessCache
-    // If not there, create this connection cache
-    if (!connections.hasLocalData()) {
-        connections.setLocalData(new QNetworkAccessCache());
-    }
+    QNetworkAccessCache *connectionCache = cache();
 
     // check if we have an open connection to this host
     QUrl urlCopy = httpRequest.url();
@@ -320,20 +349,32 @@ void QHttpThreadDelegate::startRequest()
 #endif
         cacheKey = makeCacheKey(urlCopy, 0);
 
+    // Connections with a non-default size or pipeline length are not shared
+    // with requests that did not ask for the same.
+    if (channelCount > 0)
+        cacheKey += ";channels=" + QByteArray::number(channelCount);
+    if (pipelineLength > 0)
+        cacheKey += ";pipeline=" + QByteArray::number(pipelineLength);
 
     // the http object is actually a QHttpNetworkConnection
-    httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
+    httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connectionCache->requestEntryNow(cacheKey));
     if (httpConnection == 0) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
+        const quint16 connectionChannelCount = channelCount > 0
+                ? quint16(channelCount) : quint16(QHttpNetworkConnectionPrivate::defaultHttpChannelCount);
 #ifdef QT_NO_BEARERMANAGEMENT
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
+        httpConnection = new QNetworkAccessCachedHttpConnection(connectionChannelCount,
+                                                                urlCopy.host(), urlCopy.port(), ssl,
                                                                 connectionType);
 #else
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
+        httpConnection = new QNetworkAccessCachedHttpConnection(connectionChannelCount,
+                                                                urlCopy.host(), urlCopy.port(), ssl,
                                                                 connectionType,
                                                                 networkSession);
 #endif // QT_NO_BEARERMANAGEMENT
+        if (pipelineLength > 0)
+            httpConnection->setPipelineLength(pipelineLength);
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             && http2Parameters.validate()) {
             httpConnection->setHttp2Parameters(http2Parameters);
@@ -350,7 +391,7 @@ void QHttpThreadDelegate::startRequest()
 #endif
 
         // cache the QHttpNetworkConnection corresponding to this cache key
-        connections.localData()->addEntry(cacheKey, httpConnection);
+        connectionCache->addEntry(cacheKey, httpConnection);
     } else {
         if (httpRequest.withCredentials()) {
             QNetworkAuthenticationCredential credential = authenticationManager->fetchCachedCredentials(httpRequest.url(), 0);
@@ -363,6 +404,9 @@ void QHttpThreadDelegate::startRequest()
         }
     }
 
+    if (inManagerThread)
+        managerConnection = httpConnection;
+
     // Send the request to the connection
     httpReply = httpConnection->sendRequest(httpRequest);
     httpReply->setParent(this);
@@ -64,6 +64,7 @@
 #include "qhttpnetworkconnection_p.h"
 #include <QSharedPointer>
 #include <QScopedPointer>
+#include <QPointer>
 #include "private/qnoncontiguousbytedevice_p.h"
 #include "qnetworkaccessauthenticationmanager_p.h"
 #include <QtNetwork/private/http2protocol_p.h>
@@ -117,9 +118,18 @@ public:
     QNetworkReply::NetworkError incomingErrorCode;
     QString incomingErrorDetail;
     Http2::ProtocolParameters http2Parameters;
+    // 0 means the QHttpNetworkConnection defaults
+    int channelCount;
+    int pipelineLength;
+    // Seconds an idle connection is kept for reuse, -1 for the cache default
+    int idleTimeout;
 #ifndef QT_NO_BEARERMANAGEMENT
     QSharedPointer<QNetworkSession> networkSession;
 #endif
+    // Set when the delegate runs in the thread of the QNetworkAccessManager.
+    // The connections are then cached by the manager instead of per thread.
+    bool inManagerThread;
+    QPointer<QNetworkAccessCache> managerConnectionCache;
 
 protected:
     // The zerocopy download buffer, if used:
@@ -127,6 +137,7 @@ protected:
     // The QHttpNetworkConnection that is used
     QNetworkAccessCachedHttpConnection *httpConnection;
     QByteArray cacheKey;
+    QPointer<QHttpNetworkConnection> managerConnection;
     QHttpNetworkReply *httpReply;
 
     // Used for implementing the synchronous HTTP, see startRequestSynchronously()
@@ -183,6 +194,8 @@ protected slots:
 #endif
 
 protected:
+    QNetworkAccessCache *cache();
+
     // Cache for all the QHttpNetworkConnection objects.
     // This is per thread.
     static QThreadStorage<QNetworkAccessCache *> connections;
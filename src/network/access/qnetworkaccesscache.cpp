@@ -77,8 +77,9 @@ struct QNetworkAccessCache::Node
 };
 
 QNetworkAccessCache::CacheableObject::CacheableObject()
+    : expiryTimeout(ExpiryTime)
 {
-    // leave the members uninitialized
+    // leave the other members uninitialized
     // they must be initialized by the derived class's constructor
 }
 
@@ -101,6 +102,17 @@ void QNetworkAccessCache::CacheableObject::setShareable(bool enable)
     shareable = enable;
 }
 
+/*!
+    Sets how long, in \a seconds, the object stays in the cache once it is
+    no longer in use. The value is read each time the object is released,
+    so changing it affects the next idle period. It has no effect unless
+    the object expires.
+ */
+void QNetworkAccessCache::CacheableObject::setExpiryTimeout(int seconds)
+{
+    expiryTimeout = qMax(seconds, 0);
+}
+
 QNetworkAccessCache::QNetworkAccessCache()
     : oldest(0), newest(0)
 {
@@ -157,8 +169,26 @@ void QNetworkAccessCache::linkEntry(const QByteArray &key)
         oldest = node;
     }
 
-    node->timestamp = QDateTime::currentDateTimeUtc().addSecs(ExpiryTime);
+    node->timestamp = QDateTime::currentDateTimeUtc().addSecs(node->object->expiryTimeout);
     newest = node;
+
+    // Objects may have different timeouts, so keep the list sorted by
+    // expiry time. Most objects share the default and stay at the end.
+    while (node->older && node->timestamp < node->older->timestamp) {
+        Node *const older = node->older;
+        if (older->older)
+            older->older->newer = node;
+        else
+            oldest = node;
+        if (node == newest)
+            newest = older;
+        node->older = older->older;
+        older->newer = node->newer;
+        if (node->newer)
+            node->newer->older = older;
+        node->newer = older;
+        older->older = node;
+    }
 }
 
 /*!
@@ -196,15 +226,9 @@ void QNetworkAccessCache::updateTimer()
     if (!oldest)
         return;
 
-    int interval = QDateTime::currentDateTimeUtc().secsTo(oldest->timestamp);
-    if (interval <= 0) {
-        interval = 0;
-    } else {
-        // round up the interval
-        interval = (interval + 15) & ~16;
-    }
-
-    timer.start(interval * 1000, this);
+    // A coarse timer is precise enough and lets the system batch wake-ups
+    const qint64 interval = QDateTime::currentDateTimeUtc().msecsTo(oldest->timestamp);
+    timer.start(int(qBound<qint64>(0, interval, INT_MAX)), Qt::CoarseTimer, this);
 }
 
 bool QNetworkAccessCache::emitEntryReady(Node *node, QObject *target, const char *member)
@@ -227,6 +251,7 @@ void QNetworkAccessCache::timerEvent(QTimerEvent *)
     while (oldest && oldest->timestamp < now) {
         Node *next = oldest->newer;
         oldest->object->dispose();
+        ++stats.expired;
 
         hash.remove(oldest->key); // oldest gets deleted
         oldest = next;
@@ -268,10 +293,13 @@ bool QNetworkAccessCache::hasEntry(const QByteArray &key) const
 bool QNetworkAccessCache::requestEntry(const QByteArray &key, QObject *target, const char *member)
 {
     NodeHash::Iterator it = hash.find(key);
-    if (it == hash.end())
+    if (it == hash.end()) {
+        ++stats.misses;
         return false;           // no such entry
+    }
 
     Node *node = &it.value();
+    ++stats.hits;
 
     if (node->useCount > 0 && !node->object->shareable) {
         // object is not shareable and is in use
@@ -297,21 +325,26 @@ bool QNetworkAccessCache::requestEntry(const QByteArray &key, QObject *target, c
 QNetworkAccessCache::CacheableObject *QNetworkAccessCache::requestEntryNow(const QByteArray &key)
 {
     NodeHash::Iterator it = hash.find(key);
-    if (it == hash.end())
+    if (it == hash.end()) {
+        ++stats.misses;
         return 0;
+    }
     if (it->useCount > 0) {
         if (it->object->shareable) {
             ++it->useCount;
+            ++stats.hits;
             return it->object;
         }
 
         // object in use and not shareable
+        ++stats.misses;
         return 0;
     }
 
     // entry not in use, let the caller have it
     bool wasOldest = unlinkEntry(key);
     ++it->useCount;
+    ++stats.hits;
 
     if (wasOldest)
         updateTimer();
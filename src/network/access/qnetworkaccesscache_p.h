@@ -79,6 +79,7 @@ public:
         QByteArray key;
         bool expires;
         bool shareable;
+        int expiryTimeout;
     public:
         CacheableObject();
         virtual ~CacheableObject();
@@ -88,6 +89,14 @@ public:
     protected:
         void setExpires(bool enable);
         void setShareable(bool enable);
+        void setExpiryTimeout(int seconds);
+    };
+
+    struct Statistics
+    {
+        quint64 hits = 0;       // requests handed an existing entry
+        quint64 misses = 0;     // requests that found no usable entry
+        quint64 expired = 0;    // idle entries disposed of by the timer
     };
 
     QNetworkAccessCache();
@@ -102,6 +111,8 @@ public:
     void releaseEntry(const QByteArray &key);
     void removeEntry(const QByteArray &key);
 
+    Statistics statistics() const { return stats; }
+
 signals:
     void entryReady(QNetworkAccessCache::CacheableObject *);
 
@@ -115,6 +126,7 @@ private:
     Node *newest;
 
     QBasicTimer timer;
+    Statistics stats;
 
     void linkEntry(const QByteArray &key);
     bool unlinkEntry(const QByteArray &key);
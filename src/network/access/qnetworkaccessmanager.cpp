@@ -627,7 +627,8 @@ QAbstractNetworkCache *QNetworkAccessManager::cache() const
     \note QNetworkAccessManager takes ownership of the \a cache object.
 
     QNetworkAccessManager by default does not have a set cache.
-    Qt provides a simple disk cache, QNetworkDiskCache, which can be used.
+    Qt provides a simple disk cache, QNetworkDiskCache, and an in-memory
+    cache, QNetworkMemoryCache, which can be used.
 
     \sa cache(), QNetworkRequest::CacheLoadControl
 */
@@ -1147,6 +1148,9 @@ QSharedPointer<QNetworkSession> QNetworkAccessManagerPrivate::getNetworkSession(
     \a sslConfiguration. This function is useful to complete the TCP and SSL handshake
     to a host before the HTTPS request is made, resulting in a lower network latency.
 
+    Calling this function several times for the same host opens that many
+    connections in parallel, up to the number of connections used per host.
+
     \note Preconnecting a SPDY connection can be done by calling setAllowedNextProtocols()
     on \a sslConfiguration with QSslConfiguration::NextProtocolSpdy3_0 contained in
     the list of allowed protocols. When using SPDY, one single connection per host is
@@ -1185,6 +1189,9 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
     This function is useful to complete the TCP handshake
     to a host before the HTTP request is made, resulting in a lower network latency.
 
+    Calling this function several times for the same host opens that many
+    connections in parallel, up to the number of connections used per host.
+
     \note This function has no possibility to report errors.
 
     \sa connectToHostEncrypted(), get(), post(), put(), deleteResource()
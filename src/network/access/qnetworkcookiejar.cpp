@@ -47,6 +47,8 @@
 #include "private/qtldurl_p.h"
 #endif
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -120,7 +122,26 @@ QNetworkCookieJar::~QNetworkCookieJar()
 */
 QList<QNetworkCookie> QNetworkCookieJar::allCookies() const
 {
-    return d_func()->allCookies;
+    Q_D(const QNetworkCookieJar);
+    if (!d->allCookiesValid) {
+        QVector<const QNetworkCookieJarPrivate::StoredCookie *> stored;
+        stored.reserve(d->cookieCount);
+        for (const QNetworkCookieJarPrivate::Bucket &bucket : d->cookiesByDomain) {
+            for (const QNetworkCookieJarPrivate::StoredCookie &storedCookie : bucket)
+                stored.append(&storedCookie);
+        }
+        std::sort(stored.begin(), stored.end(),
+                  [](const QNetworkCookieJarPrivate::StoredCookie *lhs,
+                     const QNetworkCookieJarPrivate::StoredCookie *rhs) {
+            return lhs->sequence < rhs->sequence;
+        });
+        d->allCookies.clear();
+        d->allCookies.reserve(stored.size());
+        for (const QNetworkCookieJarPrivate::StoredCookie *storedCookie : qAsConst(stored))
+            d->allCookies.append(storedCookie->cookie);
+        d->allCookiesValid = true;
+    }
+    return d->allCookies;
 }
 
 /*!
@@ -135,7 +156,74 @@ QList<QNetworkCookie> QNetworkCookieJar::allCookies() const
 void QNetworkCookieJar::setAllCookies(const QList<QNetworkCookie> &cookieList)
 {
     Q_D(QNetworkCookieJar);
+    d->clear();
+    for (const QNetworkCookie &cookie : cookieList)
+        d->append(cookie);
     d->allCookies = cookieList;
+    d->allCookiesValid = true;
+}
+
+QString QNetworkCookieJarPrivate::domainKey(const QString &domain)
+{
+    return domain.startsWith(QLatin1Char('.')) ? domain.mid(1) : domain;
+}
+
+void QNetworkCookieJarPrivate::clear()
+{
+    cookiesByDomain.clear();
+    cookieCount = 0;
+    insertionsSinceSweep = 0;
+    allCookies.clear();
+    allCookiesValid = true;
+}
+
+void QNetworkCookieJarPrivate::append(const QNetworkCookie &cookie)
+{
+    StoredCookie storedCookie;
+    storedCookie.sequence = ++lastSequence;
+    storedCookie.cookie = cookie;
+    cookiesByDomain[domainKey(cookie.domain())].append(storedCookie);
+    ++cookieCount;
+    allCookiesValid = false;
+}
+
+bool QNetworkCookieJarPrivate::remove(const QNetworkCookie &cookie)
+{
+    const auto bucket = cookiesByDomain.find(domainKey(cookie.domain()));
+    if (bucket == cookiesByDomain.end())
+        return false;
+    for (auto it = bucket->begin(), end = bucket->end(); it != end; ++it) {
+        if (it->cookie.hasSameIdentifier(cookie)) {
+            bucket->erase(it);
+            if (bucket->isEmpty())
+                cookiesByDomain.erase(bucket);
+            --cookieCount;
+            allCookiesValid = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+void QNetworkCookieJarPrivate::removeExpiredCookies(const QDateTime &now)
+{
+    const auto isExpired = [&now](const StoredCookie &storedCookie) {
+        return !storedCookie.cookie.isSessionCookie()
+                && storedCookie.cookie.expirationDate() < now;
+    };
+    for (auto bucket = cookiesByDomain.begin(); bucket != cookiesByDomain.end(); ) {
+        const auto expired = std::remove_if(bucket->begin(), bucket->end(), isExpired);
+        if (expired != bucket->end()) {
+            cookieCount -= int(bucket->end() - expired);
+            bucket->erase(expired, bucket->end());
+            allCookiesValid = false;
+        }
+        if (bucket->isEmpty())
+            bucket = cookiesByDomain.erase(bucket);
+        else
+            ++bucket;
+    }
+    insertionsSinceSweep = 0;
 }
 
 static inline bool isParentPath(const QString &path, const QString &reference)
@@ -225,39 +313,51 @@ QList<QNetworkCookie> QNetworkCookieJar::cookiesForUrl(const QUrl &url) const
 
     Q_D(const QNetworkCookieJar);
     const QDateTime now = QDateTime::currentDateTimeUtc();
-    QList<QNetworkCookie> result;
+    QVector<const QNetworkCookieJarPrivate::StoredCookie *> matches;
     bool isEncrypted = url.scheme() == QLatin1String("https");
-
-    // scan our cookies for something that matches
-    QList<QNetworkCookie>::ConstIterator it = d->allCookies.constBegin(),
-                                        end = d->allCookies.constEnd();
-    for ( ; it != end; ++it) {
-        if (!isParentDomain(url.host(), it->domain()))
-            continue;
-        if (!isParentPath(url.path(), it->path()))
-            continue;
-        if (!(*it).isSessionCookie() && (*it).expirationDate() < now)
-            continue;
-        if ((*it).isSecure() && !isEncrypted)
-            continue;
-
-        // insert this cookie into result, sorted by path
-        QList<QNetworkCookie>::Iterator insertIt = result.begin();
-        while (insertIt != result.end()) {
-            if (insertIt->path().length() < it->path().length()) {
-                // insert here
-                insertIt = result.insert(insertIt, *it);
-                break;
-            } else {
-                ++insertIt;
+    const QString host = url.host();
+    const QString path = url.path();
+
+    // only cookies for the host and its parent domains can match, look at
+    // the bucket of every domain, from the host up to the last label
+    int from = 0;
+    forever {
+        const auto bucket = d->cookiesByDomain.constFind(host.mid(from));
+        if (bucket != d->cookiesByDomain.constEnd()) {
+            for (const QNetworkCookieJarPrivate::StoredCookie &storedCookie : *bucket) {
+                const QNetworkCookie &cookie = storedCookie.cookie;
+                if (!isParentDomain(host, cookie.domain()))
+                    continue;
+                if (!isParentPath(path, cookie.path()))
+                    continue;
+                if (!cookie.isSessionCookie() && cookie.expirationDate() < now)
+                    continue;
+                if (cookie.isSecure() && !isEncrypted)
+                    continue;
+                matches.append(&storedCookie);
             }
         }
-
-        // this is the shortest path yet, just append
-        if (insertIt == result.end())
-            result += *it;
+        from = host.indexOf(QLatin1Char('.'), from) + 1;
+        if (from == 0)
+            break;
     }
 
+    // sort by path, longest first, keeping the order in which the cookies
+    // were added for paths of the same length
+    std::sort(matches.begin(), matches.end(),
+              [](const QNetworkCookieJarPrivate::StoredCookie *lhs,
+                 const QNetworkCookieJarPrivate::StoredCookie *rhs) {
+        const int lhsLength = lhs->cookie.path().length();
+        const int rhsLength = rhs->cookie.path().length();
+        if (lhsLength != rhsLength)
+            return lhsLength > rhsLength;
+        return lhs->sequence < rhs->sequence;
+    });
+
+    QList<QNetworkCookie> result;
+    result.reserve(matches.size());
+    for (const QNetworkCookieJarPrivate::StoredCookie *storedCookie : qAsConst(matches))
+        result.append(storedCookie->cookie);
     return result;
 }
 
@@ -269,6 +369,9 @@ QList<QNetworkCookie> QNetworkCookieJar::cookiesForUrl(const QUrl &url) const
 
     If a cookie with the same identifier already exists in the
     cookie jar, it will be overridden.
+
+    Cookies that have expired are removed from the jar from time to time
+    when new cookies are inserted.
 */
 bool QNetworkCookieJar::insertCookie(const QNetworkCookie &cookie)
 {
@@ -280,7 +383,11 @@ bool QNetworkCookieJar::insertCookie(const QNetworkCookie &cookie)
     deleteCookie(cookie);
 
     if (!isDeletion) {
-        d->allCookies += cookie;
+        d->append(cookie);
+        // drop the expired cookies once the jar has seen insertions for half
+        // of its size, which keeps insertion amortized O(1)
+        if (++d->insertionsSinceSweep >= qMax(d->cookieCount / 2, 16))
+            d->removeExpiredCookies(now);
         return true;
     }
     return false;
@@ -314,14 +421,7 @@ bool QNetworkCookieJar::updateCookie(const QNetworkCookie &cookie)
 bool QNetworkCookieJar::deleteCookie(const QNetworkCookie &cookie)
 {
     Q_D(QNetworkCookieJar);
-    QList<QNetworkCookie>::Iterator it;
-    for (it = d->allCookies.begin(); it != d->allCookies.end(); ++it) {
-        if (it->hasSameIdentifier(cookie)) {
-            d->allCookies.erase(it);
-            return true;
-        }
-    }
-    return false;
+    return d->remove(cookie);
 }
 
 /*!
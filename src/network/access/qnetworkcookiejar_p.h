@@ -55,15 +55,47 @@
 #include "private/qobject_p.h"
 #include "qnetworkcookie.h"
 
+#include <QtCore/qhash.h>
+#include <QtCore/qvector.h>
+
 QT_BEGIN_NAMESPACE
 
+class QDateTime;
+
 class QNetworkCookieJarPrivate: public QObjectPrivate
 {
 public:
-    QList<QNetworkCookie> allCookies;
+    QNetworkCookieJarPrivate()
+        : lastSequence(0), cookieCount(0), insertionsSinceSweep(0), allCookiesValid(true)
+    {}
+
+    // the sequence number keeps the order in which the cookies were added
+    struct StoredCookie {
+        quint64 sequence;
+        QNetworkCookie cookie;
+    };
+    typedef QVector<StoredCookie> Bucket;
+
+    static QString domainKey(const QString &domain);
+    void clear();
+    void append(const QNetworkCookie &cookie);
+    bool remove(const QNetworkCookie &cookie);
+    void removeExpiredCookies(const QDateTime &now);
+
+    // cookies are bucketed by their domain without the leading dot, so that
+    // a lookup only looks at the buckets of the host and its parent domains
+    QHash<QString, Bucket> cookiesByDomain;
+    quint64 lastSequence;
+    int cookieCount;
+    int insertionsSinceSweep;
+
+    // allCookies() in insertion order, built when asked for
+    mutable QList<QNetworkCookie> allCookies;
+    mutable bool allCookiesValid;
 
     Q_DECLARE_PUBLIC(QNetworkCookieJar)
 };
+Q_DECLARE_TYPEINFO(QNetworkCookieJarPrivate::StoredCookie, Q_MOVABLE_TYPE);
 
 QT_END_NAMESPACE
 
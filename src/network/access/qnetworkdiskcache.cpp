@@ -49,14 +49,19 @@
 #include <qdatastream.h>
 #include <qdatetime.h>
 #include <qdiriterator.h>
+#include <qendian.h>
+#include <qsavefile.h>
 #include <qurl.h>
 #include <qcryptographichash.h>
 #include <qdebug.h>
 
+#include <algorithm>
+
 #define CACHE_POSTFIX QLatin1String(".d")
 #define PREPARED_SLASH QLatin1String("prepared/")
 #define CACHE_VERSION 8
 #define DATA_DIR QLatin1String("data")
+#define INDEX_FILE QLatin1String("index")
 
 #define MAX_COMPRESSION_SIZE (1024 * 1024 * 3)
 
@@ -77,6 +82,13 @@ QT_BEGIN_NAMESPACE
     Currently you cannot share the same cache files with more than
     one disk cache.
 
+    The size and the last use of every cache file are kept in an index,
+    which is written to the cache directory when the cache is destroyed
+    and read back the next time the directory is used, so that expire()
+    does not have to inspect every file in the cache. If the index is
+    missing, for example because the application did not exit cleanly,
+    it is rebuilt from the files in the cache directory.
+
     QNetworkDiskCache by default limits the amount of space that the cache will
     use on the system to 50MB.
 
@@ -113,6 +125,7 @@ QNetworkDiskCache::~QNetworkDiskCache()
 {
     Q_D(QNetworkDiskCache);
     qDeleteAll(d->inserting);
+    d->saveIndex();
 }
 
 /*!
@@ -142,6 +155,10 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
     Q_D(QNetworkDiskCache);
     if (cacheDir.isEmpty())
         return;
+    d->saveIndex();
+    d->index.clear();
+    d->indexLoaded = false;
+    d->currentCacheSize = -1;
     d->cacheDirectory = cacheDir;
     QDir dir(d->cacheDirectory);
     d->cacheDirectory = dir.absolutePath();
@@ -271,7 +288,7 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
     Q_ASSERT(!fileName.isEmpty());
 
     if (QFile::exists(fileName)) {
-        if (!QFile::remove(fileName)) {
+        if (!removeFile(fileName)) {
             qWarning() << "QNetworkDiskCache: couldn't remove the cache file " << fileName;
             return;
         }
@@ -294,10 +311,13 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         && cacheItem->file->error() == QFile::NoError) {
         cacheItem->file->setAutoRemove(false);
         // ### use atomic rename rather then remove & rename
-        if (cacheItem->file->rename(fileName))
-            currentCacheSize += cacheItem->file->size();
-        else
+        if (cacheItem->file->rename(fileName)) {
+            const qint64 size = cacheItem->file->size();
+            currentCacheSize += size;
+            touch(fileName, size);
+        } else {
             cacheItem->file->setAutoRemove(true);
+        }
     }
     if (cacheItem->metaData.url() == lastItem.metaData.url())
         lastItem.reset();
@@ -345,8 +365,11 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
     qint64 size = info.size();
     if (QFile::remove(file)) {
         currentCacheSize -= size;
+        index.remove(indexKey(file));
         return true;
     }
+    if (!info.exists())
+        index.remove(indexKey(file));
     return false;
 }
 
@@ -401,6 +424,7 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
     if (d->lastItem.metaData.url() == url && d->lastItem.data.isOpen()) {
         buffer.reset(new QBuffer);
         buffer->setData(d->lastItem.data.data());
+        d->touch(d->cacheFileName(url));
     } else {
         QScopedPointer<QFile> file(new QFile(d->cacheFileName(url)));
         if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered))
@@ -411,6 +435,7 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
             remove(url);
             return 0;
         }
+        d->touch(file->fileName(), file->size());
         if (d->lastItem.data.isOpen()) {
             // compressed
             buffer.reset(new QBuffer);
@@ -500,9 +525,9 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
     Returns the current size of the cache.
 
     When the current size of the cache is greater than the maximumCacheSize()
-    older cache files are removed until the total size is less then 90% of
-    maximumCacheSize() starting with the oldest ones first using the file
-    creation date to determine how old a cache file is.
+    cache files are removed until the total size is less then 90% of
+    maximumCacheSize(), starting with the least recently used ones. A cache
+    file is used when it is inserted and when its data() is read.
 
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
@@ -527,30 +552,22 @@ qint64 QNetworkDiskCache::expire()
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
 
-    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
+    d->loadIndex();
 
-    QMultiMap<QDateTime, QString> cacheItems;
+    QMultiMap<quint64, QString> cacheItems;
     qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QString path = it.next();
-        QFileInfo info = it.fileInfo();
-        QString fileName = info.fileName();
-        if (fileName.endsWith(CACHE_POSTFIX)) {
-            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
-            cacheItems.insert(birthTime.isValid() ? birthTime
-                              : info.fileTime(QFile::FileMetadataChangeTime), path);
-            totalSize += info.size();
-        }
+    for (auto it = d->index.cbegin(), end = d->index.cend(); it != end; ++it) {
+        cacheItems.insert(it.value().lastUse, it.key());
+        totalSize += it.value().size;
     }
 
     int removedFiles = 0;
     qint64 goal = (maximumCacheSize() * 9) / 10;
-    QMultiMap<QDateTime, QString>::const_iterator i = cacheItems.constBegin();
+    QMultiMap<quint64, QString>::const_iterator i = cacheItems.constBegin();
     while (i != cacheItems.constEnd()) {
         if (totalSize < goal)
             break;
-        QString name = i.value();
+        QString name = d->cacheDirectory + i.value();
         QFile file(name);
 
         if (name.contains(PREPARED_SLASH)) {
@@ -563,9 +580,8 @@ qint64 QNetworkDiskCache::expire()
             }
         }
 
-        qint64 size = file.size();
         file.remove();
-        totalSize -= size;
+        totalSize -= d->index.take(i.value()).size;
         ++removedFiles;
         ++i;
     }
@@ -594,6 +610,186 @@ void QNetworkDiskCache::clear()
     d->maximumCacheSize = size;
 }
 
+QString QNetworkDiskCachePrivate::indexFileName() const
+{
+    return dataDirectory + INDEX_FILE;
+}
+
+QString QNetworkDiskCachePrivate::indexKey(const QString &fileName) const
+{
+    if (cacheDirectory.isEmpty() || !fileName.startsWith(cacheDirectory))
+        return QString();
+    return fileName.mid(cacheDirectory.length());
+}
+
+/*!
+    Marks the cache file \a fileName as used now. A negative \a size keeps
+    the size already known for the file.
+ */
+void QNetworkDiskCachePrivate::touch(const QString &fileName, qint64 size)
+{
+    const QString key = indexKey(fileName);
+    if (key.isEmpty())
+        return;
+    loadIndex();
+    auto it = index.find(key);
+    if (it == index.end()) {
+        if (size < 0)
+            return;
+        it = index.insert(key, IndexEntry());
+    }
+    if (size >= 0)
+        it->size = size;
+    it->lastUse = ++lastUse;
+}
+
+/*!
+    Makes sure the index describes the cache directory, either by reading
+    the index file written by an earlier cache or by looking at the files.
+ */
+void QNetworkDiskCachePrivate::loadIndex()
+{
+    if (indexLoaded || cacheDirectory.isEmpty())
+        return;
+    indexLoaded = true;
+    index.clear();
+    lastUse = 0;
+    if (!readIndex())
+        rebuildIndex();
+    // the index is rewritten when the cache is destroyed, an index file
+    // left behind after a crash would not describe the directory anymore
+    QFile::remove(indexFileName());
+}
+
+enum
+{
+    IndexMagic = 0x51444349, // "QDCI"
+    IndexVersion = 1
+};
+
+// The index file is a header of three little endian quint32 (magic,
+// version, entry count) followed by the entries. Each entry is a qint64
+// size, a quint64 last use and a quint32 length followed by that many
+// bytes of UTF-8 encoded key.
+bool QNetworkDiskCachePrivate::readIndex()
+{
+    QFile file(indexFileName());
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const qint64 fileSize = file.size();
+    const int headerSize = 3 * sizeof(quint32);
+    const int entrySize = sizeof(qint64) + sizeof(quint64) + sizeof(quint32);
+    if (fileSize < headerSize)
+        return false;
+
+    QByteArray contents;
+    const uchar *data = file.map(0, fileSize);
+    if (!data) {
+        contents = file.readAll();
+        if (contents.size() != fileSize)
+            return false;
+        data = reinterpret_cast<const uchar *>(contents.constData());
+    }
+    const uchar *end = data + fileSize;
+
+    if (qFromLittleEndian<quint32>(data) != IndexMagic
+        || qFromLittleEndian<quint32>(data + 4) != IndexVersion)
+        return false;
+    const quint32 count = qFromLittleEndian<quint32>(data + 8);
+    const uchar *p = data + headerSize;
+    index.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        quint32 length = 0;
+        if (end - p >= entrySize)
+            length = qFromLittleEndian<quint32>(p + 16);
+        if (end - p < entrySize || quint32(end - p - entrySize) < length) {
+            // truncated
+            index.clear();
+            lastUse = 0;
+            return false;
+        }
+        IndexEntry entry;
+        entry.size = qFromLittleEndian<qint64>(p);
+        entry.lastUse = qFromLittleEndian<quint64>(p + 8);
+        p += entrySize;
+        index.insert(QString::fromUtf8(reinterpret_cast<const char *>(p), length), entry);
+        lastUse = qMax(lastUse, entry.lastUse);
+        p += length;
+    }
+    return true;
+}
+
+void QNetworkDiskCachePrivate::rebuildIndex()
+{
+    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
+    QDirIterator it(cacheDirectory, filters, QDirIterator::Subdirectories);
+
+    // files that were never used since are ordered by their creation date
+    QMultiMap<QDateTime, QPair<QString, qint64> > cacheItems;
+    while (it.hasNext()) {
+        QString path = it.next();
+        QFileInfo info = it.fileInfo();
+        QString fileName = info.fileName();
+        if (!fileName.endsWith(CACHE_POSTFIX))
+            continue;
+        if (path.contains(PREPARED_SLASH)) {
+            // still being written, it is indexed once it is inserted
+            const bool inserting = std::any_of(this->inserting.cbegin(), this->inserting.cend(),
+                                               [&path](const QCacheItem *item) {
+                return item && item->file && item->file->fileName() == path;
+            });
+            if (inserting)
+                continue;
+        }
+        const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+        cacheItems.insert(birthTime.isValid() ? birthTime
+                          : info.fileTime(QFile::FileMetadataChangeTime),
+                          qMakePair(indexKey(path), info.size()));
+    }
+
+    index.reserve(cacheItems.size());
+    for (auto i = cacheItems.cbegin(), end = cacheItems.cend(); i != end; ++i) {
+        IndexEntry entry;
+        entry.size = i.value().second;
+        entry.lastUse = ++lastUse;
+        index.insert(i.value().first, entry);
+    }
+}
+
+template <typename T>
+static void appendLittleEndian(QByteArray &data, T value)
+{
+    const T le = qToLittleEndian(value);
+    data.append(reinterpret_cast<const char *>(&le), sizeof(le));
+}
+
+void QNetworkDiskCachePrivate::saveIndex()
+{
+    if (!indexLoaded)
+        return;
+    if (index.isEmpty()) {
+        QFile::remove(indexFileName());
+        return;
+    }
+
+    QByteArray data;
+    data.reserve(12 + index.size() * 32);
+    appendLittleEndian(data, quint32(IndexMagic));
+    appendLittleEndian(data, quint32(IndexVersion));
+    appendLittleEndian(data, quint32(index.size()));
+    for (auto it = index.cbegin(), end = index.cend(); it != end; ++it) {
+        const QByteArray key = it.key().toUtf8();
+        appendLittleEndian(data, it.value().size);
+        appendLittleEndian(data, it.value().lastUse);
+        appendLittleEndian(data, quint32(key.size()));
+        data.append(key);
+    }
+
+    QSaveFile file(indexFileName());
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+        qWarning() << "QNetworkDiskCache: couldn't write the cache index" << file.fileName();
+}
+
 /*!
     Given a URL, generates a unique enough filename (and subdirectory)
  */
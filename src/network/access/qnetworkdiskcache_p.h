@@ -101,6 +101,8 @@ public:
         : QAbstractNetworkCachePrivate()
         , maximumCacheSize(1024 * 1024 * 50)
         , currentCacheSize(-1)
+        , lastUse(0)
+        , indexLoaded(false)
         {}
 
     static QString uniqueFileName(const QUrl &url);
@@ -111,12 +113,30 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    // the index remembers the size and the last use of every cache file,
+    // keyed by its path relative to the cache directory
+    struct IndexEntry {
+        qint64 size;
+        quint64 lastUse;
+    };
+    QString indexFileName() const;
+    QString indexKey(const QString &fileName) const;
+    void loadIndex();
+    bool readIndex();
+    void rebuildIndex();
+    void saveIndex();
+    void touch(const QString &fileName, qint64 size = -1);
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
     qint64 maximumCacheSize;
     qint64 currentCacheSize;
 
+    QHash<QString, IndexEntry> index;
+    quint64 lastUse;
+    bool indexLoaded;
+
     QHash<QIODevice*, QCacheItem*> inserting;
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
@@ -0,0 +1,311 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qnetworkmemorycache.h"
+#include "qnetworkmemorycache_p.h"
+#include "QtCore/qscopedpointer.h"
+
+#include <qdebug.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QNetworkMemoryCache
+    \since 5.11
+    \inmodule QtNetwork
+
+    \brief The QNetworkMemoryCache class provides a cache for network
+    resources that is kept in memory.
+
+    \ingroup network
+
+    QNetworkMemoryCache keeps the cached responses in memory instead of
+    writing them to disk, which suits clients that repeatedly request the
+    same small resources and do not need the cache to outlive the
+    application. Only responses that are allowed to be saved to disk, as
+    reported by QNetworkCacheMetaData::saveToDisk(), are cached.
+
+    The cache is limited to maximumCacheSize() bytes, 10MB by default.
+    When a new entry does not fit, the least recently used entries are
+    discarded. An entry is used when its metaData() or data() is looked
+    up.
+
+    A QNetworkAccessManager takes ownership of its cache, so each manager
+    needs its own QNetworkMemoryCache object. The entries of the caches
+    can be shared with shareWith(), including between managers that live
+    in different threads.
+
+    When a cached response is stale, QNetworkAccessManager revalidates it
+    with If-None-Match and If-Modified-Since headers built from its ETag
+    and Last-Modified headers, and keeps serving it from the cache when the
+    server answers with "304 Not Modified".
+
+    \sa QNetworkDiskCache, QNetworkAccessManager::setCache()
+*/
+
+int QNetworkMemoryCacheStorage::cost(const QNetworkMemoryCacheEntry &entry)
+{
+    // headers and URL count too, a cache of empty replies still uses memory
+    qint64 cost = entry.data.size() + entry.metaData.url().toEncoded().size();
+    const auto headers = entry.metaData.rawHeaders();
+    for (const auto &header : headers)
+        cost += header.first.size() + header.second.size();
+    return int(qMin<qint64>(cost, std::numeric_limits<int>::max()));
+}
+
+/*!
+    The key for a URL, the password and the fragment are never sent to the
+    server and do not identify a different resource.
+ */
+QUrl QNetworkMemoryCachePrivate::cacheKey(const QUrl &url)
+{
+    return url.adjusted(QUrl::RemovePassword | QUrl::RemoveFragment);
+}
+
+/*!
+    Creates a new memory cache. The \a parent argument is passed to
+    QAbstractNetworkCache's constructor.
+ */
+QNetworkMemoryCache::QNetworkMemoryCache(QObject *parent)
+    : QAbstractNetworkCache(*new QNetworkMemoryCachePrivate, parent)
+{
+}
+
+/*!
+    Destroys the cache object. The entries are discarded, unless they are
+    shared with another cache that still exists.
+ */
+QNetworkMemoryCache::~QNetworkMemoryCache()
+{
+    Q_D(QNetworkMemoryCache);
+    qDeleteAll(d->inserting.keyBegin(), d->inserting.keyEnd());
+}
+
+/*!
+    Makes this cache use the same entries as \a other, dropping the entries
+    it had so far. Inserting into or removing from either cache is visible
+    in the other one, and both share the same maximumCacheSize().
+
+    The caches may be used from different threads. Devices returned by
+    prepare() are still inserted into the entries used at the time
+    insert() is called.
+ */
+void QNetworkMemoryCache::shareWith(const QNetworkMemoryCache *other)
+{
+    Q_D(QNetworkMemoryCache);
+    if (!other || other == this)
+        return;
+    d->storage = other->d_func()->storage;
+}
+
+/*!
+    Returns the current maximum size in bytes of the cache.
+
+    \sa setMaximumCacheSize()
+ */
+qint64 QNetworkMemoryCache::maximumCacheSize() const
+{
+    Q_D(const QNetworkMemoryCache);
+    QMutexLocker locker(&d->storage->mutex);
+    return d->storage->entries.maxCost();
+}
+
+/*!
+    Sets the maximum size of the cache to be \a size bytes.
+
+    If the new size is smaller than the current cache size, the least
+    recently used entries are discarded.
+
+    \sa maximumCacheSize()
+ */
+void QNetworkMemoryCache::setMaximumCacheSize(qint64 size)
+{
+    Q_D(QNetworkMemoryCache);
+    QMutexLocker locker(&d->storage->mutex);
+    d->storage->entries.setMaxCost(int(qBound<qint64>(0, size, std::numeric_limits<int>::max())));
+}
+
+/*!
+    \reimp
+*/
+qint64 QNetworkMemoryCache::cacheSize() const
+{
+    Q_D(const QNetworkMemoryCache);
+    QMutexLocker locker(&d->storage->mutex);
+    return d->storage->entries.totalCost();
+}
+
+/*!
+    \reimp
+*/
+QNetworkCacheMetaData QNetworkMemoryCache::metaData(const QUrl &url)
+{
+    Q_D(QNetworkMemoryCache);
+    QMutexLocker locker(&d->storage->mutex);
+    const QNetworkMemoryCacheEntry *entry = d->storage->entries.object(d->cacheKey(url));
+    return entry ? entry->metaData : QNetworkCacheMetaData();
+}
+
+/*!
+    \reimp
+*/
+void QNetworkMemoryCache::updateMetaData(const QNetworkCacheMetaData &metaData)
+{
+    Q_D(QNetworkMemoryCache);
+    QMutexLocker locker(&d->storage->mutex);
+    const QUrl key = d->cacheKey(metaData.url());
+    QNetworkMemoryCacheEntry *entry = d->storage->entries.object(key);
+    if (!entry)
+        return;
+
+    // reinsert, the headers are part of the cost
+    QScopedPointer<QNetworkMemoryCacheEntry> newEntry(new QNetworkMemoryCacheEntry);
+    newEntry->metaData = metaData;
+    newEntry->data = entry->data;
+    const int cost = QNetworkMemoryCacheStorage::cost(*newEntry);
+    d->storage->entries.insert(key, newEntry.take(), cost);
+}
+
+/*!
+    \reimp
+*/
+QIODevice *QNetworkMemoryCache::data(const QUrl &url)
+{
+    Q_D(QNetworkMemoryCache);
+    QByteArray data;
+    {
+        QMutexLocker locker(&d->storage->mutex);
+        const QNetworkMemoryCacheEntry *entry = d->storage->entries.object(d->cacheKey(url));
+        if (!entry)
+            return 0;
+        data = entry->data;
+    }
+    // the buffer shares the data with the entry, the entry can go away
+    QBuffer *buffer = new QBuffer;
+    buffer->setData(data);
+    buffer->open(QBuffer::ReadOnly);
+    return buffer;
+}
+
+/*!
+    \reimp
+*/
+bool QNetworkMemoryCache::remove(const QUrl &url)
+{
+    Q_D(QNetworkMemoryCache);
+    const QUrl key = d->cacheKey(url);
+
+    // remove is also used to cancel insertions, not a common operation
+    for (auto it = d->inserting.begin(), end = d->inserting.end(); it != end; ++it) {
+        if (d->cacheKey(it.value().url()) == key) {
+            delete it.key();
+            d->inserting.erase(it);
+            return true;
+        }
+    }
+
+    QMutexLocker locker(&d->storage->mutex);
+    return d->storage->entries.remove(key);
+}
+
+/*!
+    \reimp
+*/
+QIODevice *QNetworkMemoryCache::prepare(const QNetworkCacheMetaData &metaData)
+{
+    Q_D(QNetworkMemoryCache);
+    if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk())
+        return 0;
+
+    const auto headers = metaData.rawHeaders();
+    for (const auto &header : headers) {
+        if (header.first.toLower() == "content-length") {
+            const qint64 size = header.second.toLongLong();
+            if (size > maximumCacheSize())
+                return 0;
+            break;
+        }
+    }
+
+    QBuffer *buffer = new QBuffer;
+    buffer->open(QBuffer::ReadWrite);
+    d->inserting.insert(buffer, metaData);
+    return buffer;
+}
+
+/*!
+    \reimp
+*/
+void QNetworkMemoryCache::insert(QIODevice *device)
+{
+    Q_D(QNetworkMemoryCache);
+    const auto it = d->inserting.constFind(device);
+    if (Q_UNLIKELY(it == d->inserting.cend())) {
+        qWarning() << "QNetworkMemoryCache::insert() called on a device we don't know about" << device;
+        return;
+    }
+
+    QScopedPointer<QNetworkMemoryCacheEntry> entry(new QNetworkMemoryCacheEntry);
+    entry->metaData = it.value();
+    entry->data = static_cast<QBuffer *>(device)->data();
+    const QUrl key = d->cacheKey(entry->metaData.url());
+    const int cost = QNetworkMemoryCacheStorage::cost(*entry);
+    delete device;
+    d->inserting.erase(it);
+
+    // an entry larger than the whole cache is dropped, along with any entry
+    // it would have replaced
+    QMutexLocker locker(&d->storage->mutex);
+    d->storage->entries.insert(key, entry.take(), cost);
+}
+
+/*!
+    \reimp
+*/
+void QNetworkMemoryCache::clear()
+{
+    Q_D(QNetworkMemoryCache);
+    QMutexLocker locker(&d->storage->mutex);
+    d->storage->entries.clear();
+}
+
+QT_END_NAMESPACE
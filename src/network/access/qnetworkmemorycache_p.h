@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QNETWORKMEMORYCACHE_P_H
+#define QNETWORKMEMORYCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include "private/qabstractnetworkcache_p.h"
+
+#include <qbuffer.h>
+#include <qcache.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qsharedpointer.h>
+#include <qurl.h>
+
+QT_REQUIRE_CONFIG(networkmemorycache);
+
+QT_BEGIN_NAMESPACE
+
+struct QNetworkMemoryCacheEntry
+{
+    QNetworkCacheMetaData metaData;
+    QByteArray data;
+};
+
+// The entries of a cache, shared by all caches created with shareWith().
+// Every access locks the mutex, the caches may live in different threads.
+class QNetworkMemoryCacheStorage
+{
+public:
+    QNetworkMemoryCacheStorage()
+        : entries(1024 * 1024 * 10)
+    {}
+
+    static int cost(const QNetworkMemoryCacheEntry &entry);
+
+    QMutex mutex;
+    QCache<QUrl, QNetworkMemoryCacheEntry> entries;
+};
+
+class QNetworkMemoryCachePrivate : public QAbstractNetworkCachePrivate
+{
+public:
+    QNetworkMemoryCachePrivate()
+        : QAbstractNetworkCachePrivate()
+        , storage(QSharedPointer<QNetworkMemoryCacheStorage>::create())
+        {}
+
+    static QUrl cacheKey(const QUrl &url);
+
+    QSharedPointer<QNetworkMemoryCacheStorage> storage;
+    QHash<QIODevice*, QNetworkCacheMetaData> inserting;
+    Q_DECLARE_PUBLIC(QNetworkMemoryCache)
+};
+
+QT_END_NAMESPACE
+
+#endif // QNETWORKMEMORYCACHE_P_H
@@ -64,6 +64,10 @@
 
 #include <string.h>             // for strchr
 
+#ifndef QT_NO_COMPRESS
+#include <zlib.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QNetworkProxy;
@@ -198,6 +202,12 @@ QNetworkReplyHttpImpl::QNetworkReplyHttpImpl(QNetworkAccessManager* const manage
     // FIXME Later maybe set to Unbuffered, especially if it is zerocopy or from cache?
     QIODevice::open(QIODevice::ReadOnly);
 
+#ifndef QT_NO_COMPRESS
+    // compressing needs all of the data, so it is buffered in any case
+    d->compressUploadData = outgoingData
+            && request.attribute(QNetworkRequest::CompressUploadDataAttribute).toBool()
+            && !request.hasRawHeader("Content-Encoding");
+#endif
 
     // Internal code that does a HTTP reply for the synchronous Ajax
     // in Qt WebKit.
@@ -229,22 +239,22 @@ QNetworkReplyHttpImpl::QNetworkReplyHttpImpl(QNetworkAccessManager* const manage
             QMetaObject::invokeMethod(this, "_q_startOperation", Qt::QueuedConnection);
             // FIXME make direct call?
         } else {
-            bool bufferingDisallowed =
+            bool bufferingDisallowed = !d->compressUploadData &&
                     request.attribute(QNetworkRequest::DoNotBufferUploadDataAttribute,
                                   false).toBool();
 
             if (bufferingDisallowed) {
-                // if a valid content-length header for the request was supplied, we can disable buffering
-                // if not, we will buffer anyway
-                if (request.header(QNetworkRequest::ContentLengthHeader).isValid()) {
-                    QMetaObject::invokeMethod(this, "_q_startOperation", Qt::QueuedConnection);
-                    // FIXME make direct call?
-                } else {
-                    d->state = d->Buffering;
-                    QMetaObject::invokeMethod(this, "_q_bufferOutgoingData", Qt::QueuedConnection);
-                }
+                // stream the data; without a valid content-length header for the request,
+                // it is sent with chunked transfer encoding
+                QMetaObject::invokeMethod(this, "_q_startOperation", Qt::QueuedConnection);
+                // FIXME make direct call?
             } else {
                 // _q_startOperation will be called when the buffering has finished.
+                bool ok = false;
+                const qint64 limit = request.attribute(QNetworkRequest::MaximumUploadBufferSizeAttribute)
+                                         .toLongLong(&ok);
+                if (ok && limit >= 0 && !d->compressUploadData)
+                    d->outgoingDataBufferLimit = limit;
                 d->state = d->Buffering;
                 QMetaObject::invokeMethod(this, "_q_bufferOutgoingData", Qt::QueuedConnection);
             }
@@ -448,6 +458,10 @@ QNetworkReplyHttpImplPrivate::QNetworkReplyHttpImplPrivate()
     , uploadByteDevicePosition(false)
     , uploadDeviceChoking(false)
     , outgoingData(0)
+    , outgoingDataBufferLimit(-1)
+    , outgoingDataStreamed(false)
+    , compressUploadData(false)
+    , uploadDataCompressed(false)
     , bytesUploaded(-1)
     , cacheLoadDevice(0)
     , loadingFromCache(false)
@@ -620,6 +634,14 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
 {
     Q_Q(QNetworkReplyHttpImpl);
 
+    // An asynchronous request can be handled in this thread instead of the
+    // HTTP thread, see HttpRunInManagerThreadAttribute.
+    const bool inManagerThread = !synchronous
+            && newHttpRequest.attribute(QNetworkRequest::HttpRunInManagerThreadAttribute).toBool();
+    // The connection type for the callbacks that need an answer right away
+    const Qt::ConnectionType blockingConnection = inManagerThread ? Qt::DirectConnection
+                                                                  : Qt::BlockingQueuedConnection;
+
     QThread *thread = 0;
     if (synchronous) {
         // A synchronous HTTP request uses its own thread
@@ -627,7 +649,7 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
         thread->setObjectName(QStringLiteral("Qt HTTP synchronous thread"));
         QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
         thread->start();
-    } else {
+    } else if (!inManagerThread) {
         // We use the manager-global thread.
         // At some point we could switch to having multiple threads if it makes sense.
         thread = managerPrivate->createThread();
@@ -764,6 +786,14 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     for (const QByteArray &header : qAsConst(headers))
         httpRequest.setHeaderField(header, newHttpRequest.rawHeader(header));
 
+    if (uploadDataCompressed && (operation == QNetworkAccessManager::PostOperation
+                                 || operation == QNetworkAccessManager::PutOperation
+                                 || operation == QNetworkAccessManager::CustomOperation)) {
+        // the headers of the request describe the uncompressed data
+        httpRequest.setHeaderField("Content-Encoding", "gzip");
+        httpRequest.setContentLength(outgoingDataBuffer->size());
+    }
+
     if (newHttpRequest.attribute(QNetworkRequest::HttpPipeliningAllowedAttribute).toBool())
         httpRequest.setPipeliningAllowed(true);
 
@@ -788,13 +818,30 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     const QVariant blob(manager->property(Http2::http2ParametersPropertyName));
     if (blob.isValid() && blob.canConvert<Http2::ProtocolParameters>())
         delegate->http2Parameters = blob.value<Http2::ProtocolParameters>();
+    const int channelCount = request.attribute(QNetworkRequest::MaximumConnectionsPerHostAttribute).toInt();
+    if (channelCount > 0)
+        delegate->channelCount = qMin(channelCount, 0xffff);
+    const int pipelineLength = request.attribute(QNetworkRequest::HttpPipeliningDepthAttribute).toInt();
+    if (pipelineLength > 0)
+        delegate->pipelineLength = pipelineLength;
+    bool idleTimeoutOk = false;
+    const int idleTimeout = request.attribute(QNetworkRequest::ConnectionIdleTimeoutAttribute).toInt(&idleTimeoutOk);
+    if (idleTimeoutOk && idleTimeout >= 0)
+        delegate->idleTimeout = idleTimeout;
 #ifndef QT_NO_BEARERMANAGEMENT
     delegate->networkSession = managerPrivate->getNetworkSession();
 #endif
 
     // For the synchronous HTTP, this is the normal way the delegate gets deleted
     // For the asynchronous HTTP this is a safety measure, the delegate deletes itself when HTTP is finished
-    QObject::connect(thread, SIGNAL(finished()), delegate, SLOT(deleteLater()));
+    if (thread)
+        QObject::connect(thread, SIGNAL(finished()), delegate, SLOT(deleteLater()));
+
+    // Without a thread of their own, the connections are cached by the manager
+    if (inManagerThread) {
+        delegate->inManagerThread = true;
+        delegate->managerConnectionCache = &managerPrivate->objectCache;
+    }
 
     // Set the properties it needs
     delegate->httpRequest = httpRequest;
@@ -866,27 +913,31 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
                 Qt::QueuedConnection);
 #endif
         // Those need to report back, therefore BlockingQueuedConnection
+        // (or a direct call, if the delegate runs in this thread)
         QObject::connect(delegate, SIGNAL(authenticationRequired(QHttpNetworkRequest,QAuthenticator*)),
                 q, SLOT(httpAuthenticationRequired(QHttpNetworkRequest,QAuthenticator*)),
-                Qt::BlockingQueuedConnection);
+                blockingConnection);
 #ifndef QT_NO_NETWORKPROXY
         QObject::connect(delegate, SIGNAL(proxyAuthenticationRequired(QNetworkProxy,QAuthenticator*)),
                  q, SLOT(proxyAuthenticationRequired(QNetworkProxy,QAuthenticator*)),
-                 Qt::BlockingQueuedConnection);
+                 blockingConnection);
 #endif
 #ifndef QT_NO_SSL
         QObject::connect(delegate, SIGNAL(encrypted()), q, SLOT(replyEncrypted()),
-                Qt::BlockingQueuedConnection);
+                blockingConnection);
         QObject::connect(delegate, SIGNAL(sslErrors(QList<QSslError>,bool*,QList<QSslError>*)),
                 q, SLOT(replySslErrors(QList<QSslError>,bool*,QList<QSslError>*)),
-                Qt::BlockingQueuedConnection);
+                blockingConnection);
         QObject::connect(delegate, SIGNAL(preSharedKeyAuthenticationRequired(QSslPreSharedKeyAuthenticator*)),
                          q, SLOT(replyPreSharedKeyAuthenticationRequiredSlot(QSslPreSharedKeyAuthenticator*)),
-                         Qt::BlockingQueuedConnection);
+                         blockingConnection);
 #endif
         // This signal we will use to start the request.
         QObject::connect(q, SIGNAL(startHttpRequest()), delegate, SLOT(startRequest()));
-        QObject::connect(q, SIGNAL(abortHttpRequest()), delegate, SLOT(abortRequest()));
+        // Aborting from this thread must not delete the HTTP reply while it
+        // is emitting one of the signals above, so defer it
+        QObject::connect(q, SIGNAL(abortHttpRequest()), delegate, SLOT(abortRequest()),
+                         inManagerThread ? Qt::QueuedConnection : Qt::AutoConnection);
 
         // To throttle the connection.
         QObject::connect(q, SIGNAL(readBufferSizeChanged(qint64)), delegate, SLOT(readBufferSizeChanged(qint64)));
@@ -917,7 +968,7 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
                              q, SLOT(sentUploadDataSlot(qint64,qint64)));
             QObject::connect(forwardUploadDevice, SIGNAL(resetData(bool*)),
                     q, SLOT(resetUploadDataSlot(bool*)),
-                    Qt::BlockingQueuedConnection); // this is the only one with BlockingQueued!
+                    blockingConnection); // this is the only one with BlockingQueued!
         }
     } else if (synchronous) {
         QObject::connect(q, SIGNAL(startHttpRequestSynchronously()), delegate, SLOT(startRequestSynchronously()), Qt::BlockingQueuedConnection);
@@ -935,7 +986,8 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
 
 
     // Move the delegate to the http thread
-    delegate->moveToThread(thread);
+    if (thread)
+        delegate->moveToThread(thread);
     // This call automatically moves the uploadDevice too for the asynchronous case.
 
     // Prepare timers for progress notifications
@@ -2046,6 +2098,13 @@ void QNetworkReplyHttpImplPrivate::_q_bufferOutgoingData()
         } else {
             // don't break, try to read() again
             outgoingDataBuffer->chop(bytesToBuffer - bytesBuffered);
+
+            if (outgoingDataBufferLimit != -1 && outgoingDataBuffer->size() >= outgoingDataBufferLimit) {
+                // stop here, the rest of the data is streamed after what we have
+                outgoingDataStreamed = true;
+                _q_bufferOutgoingDataFinished();
+                break;
+            }
         }
     }
 }
@@ -2147,11 +2206,69 @@ void QNetworkReplyHttpImplPrivate::emitReplyUploadProgress(qint64 bytesSent, qin
     emit q->uploadProgress(bytesSent, bytesTotal);
 }
 
+#ifndef QT_NO_COMPRESS
+bool QNetworkReplyHttpImplPrivate::compressOutgoingData()
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // add 16 to windowBits to write a gzip header and trailer
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    QSharedPointer<QRingBuffer> compressed = QSharedPointer<QRingBuffer>::create();
+    const auto deflateData = [&stream, &compressed](const char *data, qint64 size, int flush) {
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        stream.avail_in = uInt(size);
+        do {
+            const qint64 blockSize = 16*1024;
+            stream.next_out = reinterpret_cast<Bytef *>(compressed->reserve(blockSize));
+            stream.avail_out = uInt(blockSize);
+            const int ret = deflate(&stream, flush);
+            Q_ASSERT(ret != Z_STREAM_ERROR);
+            Q_UNUSED(ret);
+            compressed->chop(stream.avail_out);
+        } while (stream.avail_out == 0);
+    };
+
+    if (outgoingDataBuffer) {
+        qint64 position = 0;
+        while (position < outgoingDataBuffer->size()) {
+            qint64 length = 0;
+            const char *data = outgoingDataBuffer->readPointerAtPosition(position, length);
+            deflateData(data, length, Z_NO_FLUSH);
+            position += length;
+        }
+    } else {
+        // random-access data that was not buffered
+        QByteArray block(16*1024, Qt::Uninitialized);
+        qint64 haveRead;
+        while ((haveRead = outgoingData->read(block.data(), block.size())) > 0)
+            deflateData(block.constData(), haveRead, Z_NO_FLUSH);
+    }
+    deflateData(nullptr, 0, Z_FINISH);
+    deflateEnd(&stream);
+
+    outgoingDataBuffer = compressed;
+    uploadDataCompressed = true;
+    return true;
+}
+#endif
+
 QNonContiguousByteDevice* QNetworkReplyHttpImplPrivate::createUploadByteDevice()
 {
     Q_Q(QNetworkReplyHttpImpl);
 
-    if (outgoingDataBuffer)
+#ifndef QT_NO_COMPRESS
+    // when this fails, the data is sent uncompressed
+    if (compressUploadData && !uploadDataCompressed && outgoingData)
+        compressOutgoingData();
+#endif
+
+    if (outgoingDataBuffer && outgoingDataStreamed)
+        uploadByteDevice = QNonContiguousByteDeviceFactory::createShared(outgoingDataBuffer, outgoingData);
+    else if (outgoingDataBuffer)
         uploadByteDevice = QNonContiguousByteDeviceFactory::createShared(outgoingDataBuffer);
     else if (outgoingData) {
         uploadByteDevice = QNonContiguousByteDeviceFactory::createShared(outgoingData);
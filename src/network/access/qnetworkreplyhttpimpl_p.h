@@ -216,6 +216,13 @@ public:
     bool uploadDeviceChoking; // if we couldn't readPointer() any data at the moment
     QIODevice *outgoingData;
     QSharedPointer<QRingBuffer> outgoingDataBuffer;
+    qint64 outgoingDataBufferLimit; // -1 if unbounded
+    bool outgoingDataStreamed; // if outgoingDataBuffer holds only the start of the data
+    bool compressUploadData;
+    bool uploadDataCompressed; // if outgoingDataBuffer holds the gzip compressed data
+#ifndef QT_NO_COMPRESS
+    bool compressOutgoingData();
+#endif
     void emitReplyUploadProgress(qint64 bytesSent, qint64 bytesTotal); // dup?
     void onRedirected(const QUrl &redirectUrl, int httpStatus, int maxRedirectsRemainig);
     void followRedirect();
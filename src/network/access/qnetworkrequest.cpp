@@ -185,8 +185,12 @@ QT_BEGIN_NAMESPACE
         Requests only, type: QMetaType::Bool (default: false)
         Indicates whether the QNetworkAccessManager code is
         allowed to buffer the upload data, e.g. when doing a HTTP POST.
-        When using this flag with sequential upload data, the ContentLengthHeader
-        header must be set.
+        When using this flag with sequential upload data and the
+        ContentLengthHeader header is not set, the data is sent with
+        chunked transfer encoding (since 5.11; before, it was buffered
+        anyway). Unbuffered data cannot be sent a second time, so a
+        request that needs to be resent, for example for a 307 or 308
+        redirect, fails with QNetworkReply::ContentReSendError.
 
     \value HttpPipeliningAllowedAttribute
         Requests only, type: QMetaType::Bool (default: false)
@@ -298,6 +302,72 @@ QT_BEGIN_NAMESPACE
         This attribute obsoletes FollowRedirectsAttribute.
         (This value was introduced in 5.9.)
 
+    \value MaximumConnectionsPerHostAttribute
+        Requests only, type: QMetaType::Int (default: 6)
+        Indicates the number of parallel HTTP/1.1 connections that
+        QNetworkAccessManager opens to the host of this request.
+        The value is used when the connections are established:
+        requests with different values do not share connections.
+        (This value was introduced in 5.11.)
+
+    \value HttpPipeliningDepthAttribute
+        Requests only, type: QMetaType::Int (default: 3)
+        Indicates how many requests QNetworkAccessManager pipelines
+        behind the request in flight on each connection, if
+        HttpPipeliningAllowedAttribute is set. Like
+        MaximumConnectionsPerHostAttribute, it applies to the
+        connections and requests with different values do not share
+        connections.
+        (This value was introduced in 5.11.)
+
+    \value HttpRunInManagerThreadAttribute
+        Requests only, type: QMetaType::Bool (default: false)
+        Indicates whether the HTTP protocol handling for this request
+        runs in the thread of the QNetworkAccessManager, instead of a
+        separate thread shared by all requests of the manager. This
+        avoids passing every event and piece of data between two
+        threads, but the network traffic then competes with the other
+        work of the manager's thread. Slots connected to signals that
+        need an immediate answer, like
+        QNetworkAccessManager::authenticationRequired() and
+        QNetworkReply::sslErrors(), must not spin an event loop.
+        Connections made by such requests are not shared with requests
+        handled in the separate thread. The attribute is ignored for
+        synchronous requests.
+        (This value was introduced in 5.11.)
+
+    \value MaximumUploadBufferSizeAttribute
+        Requests only, type: QMetaType::LongLong (default: -1, no limit)
+        Limits how much of sequential upload data QNetworkAccessManager
+        buffers before sending the request. Once the limit is reached,
+        the buffered data is sent followed by the rest of the data as it
+        becomes available, with chunked transfer encoding unless the
+        ContentLengthHeader header is set. If the request then needs to
+        be sent a second time, it fails with
+        QNetworkReply::ContentReSendError. The attribute is ignored if
+        DoNotBufferUploadDataAttribute is set.
+        (This value was introduced in 5.11.)
+
+    \value CompressUploadDataAttribute
+        Requests only, type: QMetaType::Bool (default: false)
+        Indicates whether QNetworkAccessManager compresses the upload
+        data with gzip and sends it with a "Content-Encoding: gzip"
+        header. The complete data is buffered for this, so
+        DoNotBufferUploadDataAttribute and
+        MaximumUploadBufferSizeAttribute are ignored. The attribute has
+        no effect if the request already has a Content-Encoding header,
+        and the server must be able to decode the data.
+        (This value was introduced in 5.11.)
+
+    \value ConnectionIdleTimeoutAttribute
+        Requests only, type: QMetaType::Int (default: 120)
+        Indicates how many seconds QNetworkAccessManager keeps the HTTP
+        connections used by this request open once they have no more
+        requests to handle, so that later requests to the same host can
+        reuse them. A value of 0 closes them as soon as they are idle.
+        The value of the last request sent over the connections applies.
+        (This value was introduced in 5.11.)
+
     \value User
         Special type. Additional information can be passed in
         QVariants with types ranging from User to UserMax. The default
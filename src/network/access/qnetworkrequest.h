@@ -92,6 +92,12 @@ public:
         HTTP2WasUsedAttribute,
         OriginalContentLengthAttribute,
         RedirectPolicyAttribute,
+        MaximumConnectionsPerHostAttribute,
+        HttpPipeliningDepthAttribute,
+        HttpRunInManagerThreadAttribute,
+        MaximumUploadBufferSizeAttribute,
+        CompressUploadDataAttribute,
+        ConnectionIdleTimeoutAttribute,
 
         User = 1000,
         UserMax = 32767
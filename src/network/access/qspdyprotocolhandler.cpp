@@ -1227,9 +1227,6 @@ void QSpdyProtocolHandler::handleDataFrame(const QByteArray &frameHeaders)
         replyPrivate->currentlyReceivedDataInWindow = 0;
     }
 
-    httpReply->d_func()->compressedData.append(data);
-
-
     replyPrivate->totalProgress += length;
 
     if (httpRequest.d->autoDecompress && httpReply->d_func()->isCompressed()) {
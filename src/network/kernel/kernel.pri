@@ -17,7 +17,8 @@ HEADERS += kernel/qtnetworkglobal.h \
            kernel/qnetworkdatagram_p.h \
            kernel/qnetworkinterface.h \
            kernel/qnetworkinterface_p.h \
-           kernel/qnetworkproxy.h
+           kernel/qnetworkproxy.h \
+           kernel/qtnetwork_tracepoints_p.h
 
 SOURCES += kernel/qauthenticator.cpp \
            kernel/qdnslookup.cpp \
@@ -27,6 +28,12 @@ SOURCES += kernel/qauthenticator.cpp \
            kernel/qnetworkinterface.cpp \
            kernel/qnetworkproxy.cpp
 
+qtConfig(lttng)|qtConfig(etw): \
+    SOURCES += kernel/qtnetwork_tracepoints.cpp
+
+qtConfig(lttng): \
+    QMAKE_USE_PRIVATE += lttng-ust
+
 qtConfig(ftp) {
     HEADERS += kernel/qurlinfo_p.h
     SOURCES += kernel/qurlinfo.cpp
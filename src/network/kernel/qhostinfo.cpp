@@ -96,6 +96,14 @@ std::pair<OutputIt1, OutputIt2> separate_if(InputIt first, InputIt last, OutputI
     return std::make_pair(dest1, dest2);
 }
 
+// Lets deployments tune the lookup manager without rebuilding Qt
+int hostInfoSetting(const char *name, int defaultValue)
+{
+    bool ok = false;
+    const int value = qEnvironmentVariableIntValue(name, &ok);
+    return ok && value > 0 ? value : defaultValue;
+}
+
 int get_signal_index()
 {
     static auto senderMetaObject = &QHostInfoResult::staticMetaObject;
@@ -729,7 +737,8 @@ QHostInfoLookupManager::QHostInfoLookupManager() : mutex(QMutex::Recursive), was
 {
     moveToThread(QCoreApplicationPrivate::mainThread());
     connect(QCoreApplication::instance(), SIGNAL(destroyed()), SLOT(waitForThreadPoolDone()), Qt::DirectConnection);
-    threadPool.setMaxThreadCount(20); // do up to 20 DNS lookups in parallel
+    // do up to 20 DNS lookups in parallel by default
+    threadPool.setMaxThreadCount(hostInfoSetting("QT_HOSTINFO_MAX_THREADS", 20));
 }
 
 QHostInfoLookupManager::~QHostInfoLookupManager()
@@ -920,9 +929,13 @@ void qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolut
 }
 #endif
 
-// cache for 60 seconds
+// cache for 60 seconds, failed lookups for 5 seconds
 // cache 128 items
-QHostInfoCache::QHostInfoCache() : max_age(60), enabled(true), cache(128)
+QHostInfoCache::QHostInfoCache()
+    : max_age(hostInfoSetting("QT_HOSTINFO_CACHE_MAX_AGE", 60)),
+      negative_max_age(qMin(5, max_age)),
+      enabled(true),
+      cache(hostInfoSetting("QT_HOSTINFO_CACHE_SIZE", 128))
 {
 #ifdef QT_QHOSTINFO_CACHE_DISABLED_BY_DEFAULT
     enabled = false;
@@ -948,7 +961,8 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
     *valid = false;
     if (QHostInfoCacheElement *element = cache.object(name)) {
-        if (element->age.elapsed() < max_age*1000)
+        const int age = element->info.error() == QHostInfo::NoError ? max_age : negative_max_age;
+        if (element->age.elapsed() < age*1000)
             *valid = true;
         return element->info;
 
@@ -962,8 +976,9 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
 void QHostInfoCache::put(const QString &name, const QHostInfo &info)
 {
-    // if the lookup failed, don't cache
-    if (info.error() != QHostInfo::NoError)
+    // if the lookup failed, only remember that the host does not exist;
+    // other errors may be temporary
+    if (info.error() != QHostInfo::NoError && info.error() != QHostInfo::HostNotFound)
         return;
 
     QHostInfoCacheElement* element = new QHostInfoCacheElement();
@@ -169,6 +169,7 @@ class QHostInfoCache
 public:
     QHostInfoCache();
     const int max_age; // seconds
+    const int negative_max_age; // seconds, for HostNotFound results
 
     QHostInfo get(const QString &name, bool *valid);
     void put(const QString &name, const QHostInfo &info);
@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/private/qtrace_p.h>
+
+#if QT_CONFIG(lttng)
+// Emits the probe callbacks and the tracepoint definitions for the
+// qtnetwork provider; this must happen in exactly one translation unit.
+#  define TRACEPOINT_CREATE_PROBES
+#  define TRACEPOINT_DEFINE
+#endif
+
+#include <QtNetwork/private/qtnetwork_tracepoints_p.h>
+
+#if QT_CONFIG(etw)
+// {1de07345-64aa-53e5-9254-3f31d6277fbb}
+TRACELOGGING_DEFINE_PROVIDER(qtnetwork_provider, "QtNetwork",
+    (0x1de07345, 0x64aa, 0x53e5, 0x92, 0x54, 0x3f, 0x31, 0xd6, 0x27, 0x7f, 0xbb));
+
+static void qtnetwork_register_provider()
+{
+    TraceLoggingRegister(qtnetwork_provider);
+}
+Q_CONSTRUCTOR_FUNCTION(qtnetwork_register_provider)
+
+static void qtnetwork_unregister_provider()
+{
+    TraceLoggingUnregister(qtnetwork_provider);
+}
+Q_DESTRUCTOR_FUNCTION(qtnetwork_unregister_provider)
+#endif
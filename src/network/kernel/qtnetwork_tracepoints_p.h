@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+// No include guard around the LTTNG part: lttng-ust reads this header
+// several times while generating the probes (TRACEPOINT_HEADER_MULTI_READ).
+
+#include <QtCore/private/qtrace_p.h>
+
+#if defined(Q_TRACING) && QT_CONFIG(lttng)
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER qtnetwork
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE <QtNetwork/private/qtnetwork_tracepoints_p.h>
+
+#if !defined(QTNETWORK_LTTNG_TRACEPOINTS_H) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define QTNETWORK_LTTNG_TRACEPOINTS_H
+
+#include <lttng/tracepoint.h>
+#include <stdint.h>
+
+#define Q_LTTNG_POINTER(name) ctf_integer_hex(uintptr_t, name, reinterpret_cast<uintptr_t>(name))
+
+TRACEPOINT_EVENT(qtnetwork, QHttpNetworkConnection_queueRequest,
+    TP_ARGS(const void *, reply, const char *, url, int, priority),
+    TP_FIELDS(Q_LTTNG_POINTER(reply) ctf_string(url, url) ctf_integer(int, priority, priority)))
+TRACEPOINT_EVENT(qtnetwork, QHttpNetworkConnection_dequeueRequest,
+    TP_ARGS(const void *, reply, int, channel),
+    TP_FIELDS(Q_LTTNG_POINTER(reply) ctf_integer(int, channel, channel)))
+TRACEPOINT_EVENT(qtnetwork, QHttpNetworkConnectionChannel_allDone,
+    TP_ARGS(const void *, reply, int, statusCode),
+    TP_FIELDS(Q_LTTNG_POINTER(reply) ctf_integer(int, statusCode, statusCode)))
+
+#endif // QTNETWORK_LTTNG_TRACEPOINTS_H
+
+#include <lttng/tracepoint-event.h>
+
+#endif // Q_TRACING && QT_CONFIG(lttng)
+
+#ifndef QTNETWORK_TRACEPOINTS_P_H
+#define QTNETWORK_TRACEPOINTS_P_H
+
+#if defined(Q_TRACING) && QT_CONFIG(etw)
+#include <qt_windows.h>
+#include <TraceLoggingProvider.h>
+
+TRACELOGGING_DECLARE_PROVIDER(qtnetwork_provider);
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QHttpNetworkReply;
+
+namespace QtPrivate {
+
+Q_TRACEPOINT(qtnetwork, QHttpNetworkConnection_queueRequest,
+    (QHttpNetworkReply *reply, const char *url, int priority), (reply, url, priority),
+    (TraceLoggingPointer(reply), TraceLoggingString(url), TraceLoggingInt32(priority)))
+Q_TRACEPOINT(qtnetwork, QHttpNetworkConnection_dequeueRequest,
+    (QHttpNetworkReply *reply, int channel), (reply, channel),
+    (TraceLoggingPointer(reply), TraceLoggingInt32(channel)))
+Q_TRACEPOINT(qtnetwork, QHttpNetworkConnectionChannel_allDone,
+    (QHttpNetworkReply *reply, int statusCode), (reply, statusCode),
+    (TraceLoggingPointer(reply), TraceLoggingInt32(statusCode)))
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QTNETWORK_TRACEPOINTS_P_H
@@ -492,6 +492,9 @@
 #define QABSTRACTSOCKET_BUFFERSIZE 32768
 #endif
 #define QT_TRANSFER_TIMEOUT 120000
+// how long the first attempt for each address may take while other
+// addresses are still waiting to be tried
+#define QT_CONNECT_ATTEMPT_DELAY 2000
 
 QT_BEGIN_NAMESPACE
 
@@ -557,6 +560,7 @@ QAbstractSocketPrivate::QAbstractSocketPrivate()
       pendingClose(false),
       pauseMode(QAbstractSocket::PauseNever),
       port(0),
+      distinctAddressCount(0),
       localPort(0),
       peerPort(0),
       socketEngine(0),
@@ -845,8 +849,25 @@ bool QAbstractSocketPrivate::writeToSocket()
     qint64 nextSize = writeBuffer.nextDataBlockSize();
     const char *ptr = writeBuffer.readPointer();
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    qint64 written;
+    if (socketType == QAbstractSocket::TcpSocket && nextSize < writeBuffer.size()) {
+        // The data spans several chunks of the write buffer, hand as many
+        // of them as we can to the engine in one go.
+        const int maxBlocks = 16;
+        const char *blocks[maxBlocks];
+        qint64 lengths[maxBlocks];
+        int count = 0;
+        for (qint64 pos = 0; count < maxBlocks; ++count) {
+            blocks[count] = writeBuffer.readPointerAtPosition(pos, lengths[count]);
+            if (!blocks[count])
+                break;
+            pos += lengths[count];
+        }
+        written = socketEngine->writeBlocks(blocks, lengths, count);
+    } else {
+        // Attempt to write it all in one chunk.
+        written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -1007,7 +1028,24 @@ void QAbstractSocketPrivate::_q_startConnecting(const QHostInfo &hostInfo)
     // Only add the addresses for the preferred network layer.
     // Or all if preferred network layer is not set.
     if (preferredNetworkLayerProtocol == QAbstractSocket::UnknownNetworkLayerProtocol || preferredNetworkLayerProtocol == QAbstractSocket::AnyIPProtocol) {
-        addresses = hostInfo.addresses();
+        // Alternate between the address families, starting with the family
+        // of the first address (RFC 8305, section 4), so that a family that
+        // is broken on this network only delays the connection by one attempt.
+        QList<QHostAddress> sameFamily;
+        QList<QHostAddress> otherFamily;
+        const auto candidates = hostInfo.addresses();
+        for (const QHostAddress &address : candidates) {
+            if (sameFamily.isEmpty() || address.protocol() == sameFamily.first().protocol())
+                sameFamily += address;
+            else
+                otherFamily += address;
+        }
+        for (int i = 0; i < sameFamily.size() || i < otherFamily.size(); ++i) {
+            if (i < sameFamily.size())
+                addresses += sameFamily.at(i);
+            if (i < otherFamily.size())
+                addresses += otherFamily.at(i);
+        }
     } else {
         const auto candidates = hostInfo.addresses();
         for (const QHostAddress &address : candidates) {
@@ -1027,7 +1065,9 @@ void QAbstractSocketPrivate::_q_startConnecting(const QHostInfo &hostInfo)
     qDebug("QAbstractSocketPrivate::_q_startConnecting(hostInfo == %s)", s.toLatin1().constData());
 #endif
 
-    // Try all addresses twice.
+    // Try all addresses twice. During the first round, an attempt that
+    // does not complete quickly is abandoned in favor of the next address.
+    distinctAddressCount = addresses.size();
     addresses += addresses;
 
     // If there are no addresses in the host list, report this to the
@@ -1148,6 +1188,8 @@ void QAbstractSocketPrivate::_q_connectToNextAddress()
                 connectTimeout = networkConfiguration.connectTimeout();
             }
 #endif
+            if (isFirstConnectRound())
+                connectTimeout = qMin(connectTimeout, QT_CONNECT_ATTEMPT_DELAY);
             connectTimer->start(connectTimeout);
         }
 
@@ -1158,6 +1200,16 @@ void QAbstractSocketPrivate::_q_connectToNextAddress()
     } while (state != QAbstractSocket::ConnectedState);
 }
 
+/*! \internal
+
+    Returns \c true while the host has more than one address and not all
+    of them have been tried yet.
+*/
+bool QAbstractSocketPrivate::isFirstConnectRound() const
+{
+    return distinctAddressCount > 1 && addresses.size() >= distinctAddressCount;
+}
+
 /*! \internal
 
     Tests if a connection has been established. If it has, connected()
@@ -2150,6 +2202,8 @@ bool QAbstractSocket::waitForConnected(int msecs)
         int timeout = qt_subtract_from_timeout(msecs, stopWatch.elapsed());
         if (msecs != -1 && timeout > connectTimeout)
             timeout = connectTimeout;
+        if (d->isFirstConnectRound() && (timeout == -1 || timeout > QT_CONNECT_ATTEMPT_DELAY))
+            timeout = QT_CONNECT_ATTEMPT_DELAY;
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug("QAbstractSocket::waitForConnected(%i) waiting %.2f secs for connection attempt #%i",
                msecs, timeout / 1000.0, attempt++);
@@ -96,6 +96,8 @@ public:
     void _q_testConnection();
     void _q_abortConnectionAttempt();
 
+    bool isFirstConnectRound() const;
+
     bool emittedReadyRead;
     bool emittedBytesWritten;
 
@@ -108,6 +110,7 @@ public:
     quint16 port;
     QHostAddress host;
     QList<QHostAddress> addresses;
+    int distinctAddressCount;
 
     quint16 localPort;
     quint16 peerPort;
@@ -263,6 +263,33 @@ void QAbstractSocketEngine::setPeerPort(quint16 port)
     d_func()->peerPort = port;
 }
 
+// Writes as much as possible of 'count' consecutive blocks and returns the
+// number of bytes written, or -1 on error. By default only the first block
+// is written; engines that can gather several blocks reimplement this.
+qint64 QAbstractSocketEngine::writeBlocks(const char * const *data, const qint64 *lengths, int count)
+{
+    return count > 0 ? write(data[0], lengths[0]) : Q_INT64_C(0);
+}
+
+// Reads up to 'count' datagrams of at most 'maxlen' bytes each, datagram i
+// going to data + i * maxlen with its size in lengths[i] and its header in
+// headers[i]. Returns the number of datagrams read, or the (negative) result
+// of readDatagram() if none could be read. By default reads one datagram;
+// engines that can receive several in one call reimplement this.
+int QAbstractSocketEngine::readDatagrams(char *data, qint64 maxlen, int count, qint64 *lengths,
+                                         QIpPacketHeader *headers, PacketHeaderOptions options)
+{
+    if (count <= 0)
+        return 0;
+
+    const qint64 readBytes = readDatagram(data, maxlen, headers, options);
+    if (readBytes < 0)
+        return int(readBytes);
+
+    lengths[0] = readBytes;
+    return 1;
+}
+
 int QAbstractSocketEngine::inboundStreamCount() const
 {
     return d_func()->inboundStreamCount;
@@ -144,6 +144,47 @@ QT_BEGIN_NAMESPACE
     \sa setSocketDescriptor()
 */
 
+/*!
+    \fn bool QLocalSocket::writeFileDescriptor(qintptr descriptor)
+    \since 5.11
+
+    Sends a copy of the file descriptor \a descriptor to the peer. The copy
+    is sent with the first byte written after this call, so it reaches the
+    peer at that point in the data stream. Nothing is sent until more data
+    is written. You can close \a descriptor as soon as this function
+    returns. The peer retrieves the copy with readFileDescriptor().
+
+    This lets processes share memory, for example a file created with
+    memfd_create(), instead of copying bulk data through the socket.
+
+    Returns \c true if the descriptor was queued for sending; otherwise
+    returns \c false. Passing file descriptors is only supported on Unix,
+    where QLocalSocket uses Unix domain sockets.
+
+    \sa readFileDescriptor()
+*/
+
+/*!
+    \fn qintptr QLocalSocket::readFileDescriptor()
+    \since 5.11
+
+    Returns the oldest file descriptor received from the peer, or -1 if
+    there is none. A descriptor is available once the data that was
+    written after it has arrived. The caller owns the returned descriptor
+    and must close it. Descriptors not read by the time the socket is
+    closed are closed with it.
+
+    \sa writeFileDescriptor(), fileDescriptorsAvailable()
+*/
+
+/*!
+    \fn int QLocalSocket::fileDescriptorsAvailable() const
+    \since 5.11
+
+    Returns the number of received file descriptors waiting to be read
+    with readFileDescriptor().
+*/
+
 /*!
     \fn qint64 QLocalSocket::readData(char *data, qint64 c)
     \reimp
@@ -108,6 +108,10 @@ public:
                              OpenMode openMode = ReadWrite);
     qintptr socketDescriptor() const;
 
+    bool writeFileDescriptor(qintptr descriptor);
+    qintptr readFileDescriptor();
+    int fileDescriptorsAvailable() const;
+
     LocalSocketState state() const;
     bool waitForBytesWritten(int msecs = 30000) Q_DECL_OVERRIDE;
     bool waitForConnected(int msecs = 30000);
@@ -138,6 +142,7 @@ private:
     Q_PRIVATE_SLOT(d_func(), void _q_error(QAbstractSocket::SocketError))
     Q_PRIVATE_SLOT(d_func(), void _q_connectToSocket())
     Q_PRIVATE_SLOT(d_func(), void _q_abortConnectionAttempt())
+    Q_PRIVATE_SLOT(d_func(), void _q_readyRead())
 #endif
 };
 
@@ -75,6 +75,10 @@ QT_REQUIRE_CONFIG(localserver);
 
 QT_BEGIN_NAMESPACE
 
+#if !defined(Q_OS_WIN) && !defined(QT_LOCALSOCKET_TCP)
+class QNativeSocketEngine;
+#endif
+
 #if !defined(Q_OS_WIN) || defined(QT_LOCALSOCKET_TCP)
 class QLocalUnixSocket : public QTcpSocket
 {
@@ -146,7 +150,13 @@ public:
     void _q_error(QAbstractSocket::SocketError newError);
     void _q_connectToSocket();
     void _q_abortConnectionAttempt();
+    void _q_readyRead();
     void cancelDelayedConnect();
+    QNativeSocketEngine *socketEngine() const;
+    void takeReceivedDescriptors();
+    void closeReceivedDescriptors();
+    // received with data the socket already read, not taken by the user yet
+    QVector<int> receivedDescriptors;
     QSocketNotifier *delayConnect;
     QTimer *connectTimer;
     int connectingSocket;
@@ -295,6 +295,23 @@ qintptr QLocalSocket::socketDescriptor() const
     return d->tcpSocket->socketDescriptor();
 }
 
+bool QLocalSocket::writeFileDescriptor(qintptr descriptor)
+{
+    // descriptors can only be passed over Unix domain sockets
+    Q_UNUSED(descriptor);
+    return false;
+}
+
+qintptr QLocalSocket::readFileDescriptor()
+{
+    return -1;
+}
+
+int QLocalSocket::fileDescriptorsAvailable() const
+{
+    return 0;
+}
+
 qint64 QLocalSocket::readData(char *data, qint64 c)
 {
     Q_D(QLocalSocket);
@@ -40,6 +40,8 @@
 #include "qlocalsocket.h"
 #include "qlocalsocket_p.h"
 #include "qnet_unix_p.h"
+#include "private/qabstractsocket_p.h"
+#include "private/qnativesocketengine_p.h"
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -76,7 +78,7 @@ void QLocalSocketPrivate::init()
     q->connect(&unixSocket, SIGNAL(aboutToClose()), q, SIGNAL(aboutToClose()));
     q->connect(&unixSocket, SIGNAL(bytesWritten(qint64)),
                q, SIGNAL(bytesWritten(qint64)));
-    q->connect(&unixSocket, SIGNAL(readyRead()), q, SIGNAL(readyRead()));
+    q->connect(&unixSocket, SIGNAL(readyRead()), q, SLOT(_q_readyRead()));
     // QAbstractSocket signals
     q->connect(&unixSocket, SIGNAL(connected()), q, SIGNAL(connected()));
     q->connect(&unixSocket, SIGNAL(disconnected()), q, SIGNAL(disconnected()));
@@ -98,6 +100,39 @@ void QLocalSocketPrivate::_q_error(QAbstractSocket::SocketError socketError)
     emit q->error(error);
 }
 
+void QLocalSocketPrivate::_q_readyRead()
+{
+    Q_Q(QLocalSocket);
+    // The engine goes away with the connection, the data read stays
+    takeReceivedDescriptors();
+    emit q->readyRead();
+}
+
+QNativeSocketEngine *QLocalSocketPrivate::socketEngine() const
+{
+    QAbstractSocketPrivate *socketPrivate = static_cast<QAbstractSocketPrivate *>(
+                QObjectPrivate::get(const_cast<QLocalUnixSocket *>(&unixSocket)));
+    return qobject_cast<QNativeSocketEngine *>(socketPrivate->socketEngine);
+}
+
+void QLocalSocketPrivate::takeReceivedDescriptors()
+{
+    QNativeSocketEngine *engine = socketEngine();
+    if (!engine)
+        return;
+    for (int descriptor = engine->takeReceivedDescriptor(); descriptor != -1;
+         descriptor = engine->takeReceivedDescriptor()) {
+        receivedDescriptors.append(descriptor);
+    }
+}
+
+void QLocalSocketPrivate::closeReceivedDescriptors()
+{
+    for (int descriptor : qAsConst(receivedDescriptors))
+        qt_safe_close(descriptor);
+    receivedDescriptors.clear();
+}
+
 void QLocalSocketPrivate::_q_stateChanged(QAbstractSocket::SocketState newState)
 {
     Q_Q(QLocalSocket);
@@ -328,6 +363,8 @@ void QLocalSocketPrivate::_q_connectToSocket()
     fullServerName = connectingPathName;
     if (unixSocket.setSocketDescriptor(connectingSocket,
         QAbstractSocket::ConnectedState, connectingOpenMode)) {
+        if (QNativeSocketEngine *engine = socketEngine())
+            engine->setDescriptorPassingEnabled(true);
         q->QIODevice::open(connectingOpenMode | QIODevice::Unbuffered);
         q->emit connected();
     } else {
@@ -360,8 +397,11 @@ bool QLocalSocket::setSocketDescriptor(qintptr socketDescriptor,
     }
     QIODevice::open(openMode);
     d->state = socketState;
-    return d->unixSocket.setSocketDescriptor(socketDescriptor,
-                                             newSocketState, openMode);
+    if (!d->unixSocket.setSocketDescriptor(socketDescriptor, newSocketState, openMode))
+        return false;
+    if (QNativeSocketEngine *engine = d->socketEngine())
+        engine->setDescriptorPassingEnabled(true);
+    return true;
 }
 
 void QLocalSocketPrivate::_q_abortConnectionAttempt()
@@ -388,6 +428,32 @@ qintptr QLocalSocket::socketDescriptor() const
     return d->unixSocket.socketDescriptor();
 }
 
+bool QLocalSocket::writeFileDescriptor(qintptr descriptor)
+{
+    Q_D(QLocalSocket);
+    QNativeSocketEngine *engine = d->socketEngine();
+    if (!engine || d->unixSocket.state() != QAbstractSocket::ConnectedState)
+        return false;
+    // the descriptor goes with the first byte written after the buffered data
+    return engine->queueDescriptor(int(descriptor), d->unixSocket.bytesToWrite());
+}
+
+qintptr QLocalSocket::readFileDescriptor()
+{
+    Q_D(QLocalSocket);
+    d->takeReceivedDescriptors();
+    if (d->receivedDescriptors.isEmpty())
+        return -1;
+    return d->receivedDescriptors.takeFirst();
+}
+
+int QLocalSocket::fileDescriptorsAvailable() const
+{
+    Q_D(const QLocalSocket);
+    QNativeSocketEngine *engine = d->socketEngine();
+    return d->receivedDescriptors.size() + (engine ? engine->receivedDescriptorCount() : 0);
+}
+
 qint64 QLocalSocket::readData(char *data, qint64 c)
 {
     Q_D(QLocalSocket);
@@ -436,6 +502,7 @@ void QLocalSocket::close()
     d->connectingOpenMode = 0;
     d->serverName.clear();
     d->fullServerName.clear();
+    d->closeReceivedDescriptors();
     QIODevice::close();
 }
 
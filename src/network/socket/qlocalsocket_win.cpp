@@ -374,6 +374,23 @@ qintptr QLocalSocket::socketDescriptor() const
     return (qintptr)d->handle;
 }
 
+bool QLocalSocket::writeFileDescriptor(qintptr descriptor)
+{
+    // descriptors can only be passed over Unix domain sockets
+    Q_UNUSED(descriptor);
+    return false;
+}
+
+qintptr QLocalSocket::readFileDescriptor()
+{
+    return -1;
+}
+
+int QLocalSocket::fileDescriptorsAvailable() const
+{
+    return 0;
+}
+
 qint64 QLocalSocket::readBufferSize() const
 {
     Q_D(const QLocalSocket);
@@ -194,6 +194,10 @@ QNativeSocketEnginePrivate::QNativeSocketEnginePrivate() :
     readNotifier(0),
     writeNotifier(0),
     exceptNotifier(0)
+#ifdef Q_OS_UNIX
+    , totalBytesWritten(0)
+    , descriptorPassing(false)
+#endif
 {
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
     QSysInfo::machineHostName();        // this initializes ws2_32.dll
@@ -870,6 +874,31 @@ qint64 QNativeSocketEngine::readDatagram(char *data, qint64 maxSize, QIpPacketHe
     return d->nativeReceiveDatagram(data, maxSize, header, options);
 }
 
+/*!
+    Reads up to \a count datagrams of at most \a maxSize bytes each. The
+    datagram number \e i is stored at \a data + \e i * \a maxSize, its size
+    in \a lengths[\e i] and its header in \a headers[\e i]. Returns the
+    number of datagrams read, or a negative value if none could be read.
+
+    On Linux, the datagrams are received with a single recvmmsg() call.
+*/
+int QNativeSocketEngine::readDatagrams(char *data, qint64 maxSize, int count, qint64 *lengths,
+                                       QIpPacketHeader *headers, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#ifdef Q_OS_LINUX
+    if (count > 1 && maxSize > 0)
+        return d->nativeReceiveDatagrams(data, maxSize, count, lengths, headers, options);
+#else
+    Q_UNUSED(d);
+#endif
+    return QAbstractSocketEngine::readDatagrams(data, maxSize, count, lengths, headers, options);
+}
+
 /*!
     Writes a datagram of size \a size bytes to the socket from
     \a data to the destination contained in \a header, and returns the
@@ -918,6 +947,28 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes as much as possible of the \a count blocks given in \a data and
+    \a lengths, as if they were one contiguous block. Returns the number of
+    bytes written, or -1 if an error occurred.
+
+    On Unix, the blocks are passed to a single writev() call.
+*/
+qint64 QNativeSocketEngine::writeBlocks(const char * const *data, const qint64 *lengths, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeBlocks(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeBlocks(), QAbstractSocket::ConnectedState, -1);
+#ifdef Q_OS_UNIX
+    // Blocks are written one by one while descriptors wait for their byte
+    return count > 1 && d->outgoingDescriptors.isEmpty()
+            ? d->nativeWriteBlocks(data, lengths, count)
+            : QAbstractSocketEngine::writeBlocks(data, lengths, count);
+#else
+    Q_UNUSED(d);
+    return QAbstractSocketEngine::writeBlocks(data, lengths, count);
+#endif
+}
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -976,6 +1027,9 @@ void QNativeSocketEngine::close()
         d->nativeClose();
         d->socketDescriptor = -1;
     }
+#ifdef Q_OS_UNIX
+    d->discardPassedDescriptors();
+#endif
     d->socketState = QAbstractSocket::UnconnectedState;
     d->hasSetSocketError = false;
     d->localPort = 0;
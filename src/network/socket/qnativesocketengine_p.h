@@ -146,6 +146,7 @@ public:
 
     qint64 read(char *data, qint64 maxlen) Q_DECL_OVERRIDE;
     qint64 write(const char *data, qint64 len) Q_DECL_OVERRIDE;
+    qint64 writeBlocks(const char * const *data, const qint64 *lengths, int count) Q_DECL_OVERRIDE;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -163,6 +164,8 @@ public:
 
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = 0,
                         PacketHeaderOptions = WantNone) Q_DECL_OVERRIDE;
+    int readDatagrams(char *data, qint64 maxlen, int count, qint64 *lengths,
+                      QIpPacketHeader *headers, PacketHeaderOptions options) Q_DECL_OVERRIDE;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) Q_DECL_OVERRIDE;
     qint64 bytesToWrite() const Q_DECL_OVERRIDE;
 
@@ -190,6 +193,15 @@ public:
     bool isExceptionNotificationEnabled() const Q_DECL_OVERRIDE;
     void setExceptionNotificationEnabled(bool enable) Q_DECL_OVERRIDE;
 
+#ifdef Q_OS_UNIX
+    // Passing file descriptors over AF_UNIX stream sockets (SCM_RIGHTS)
+    void setDescriptorPassingEnabled(bool enable);
+    bool isDescriptorPassingEnabled() const;
+    bool queueDescriptor(int descriptor, qint64 bytesBefore);
+    int receivedDescriptorCount() const;
+    int takeReceivedDescriptor();
+#endif
+
 public Q_SLOTS:
     // non-virtual override;
     void connectionNotification();
@@ -212,6 +224,20 @@ public:
 
     QSocketNotifier *readNotifier, *writeNotifier, *exceptNotifier;
 
+#ifdef Q_OS_UNIX
+    // Descriptors to send leave with the byte at their offset in the stream
+    struct OutgoingDescriptors
+    {
+        qint64 offset;
+        QVector<int> descriptors;
+    };
+    QVector<OutgoingDescriptors> outgoingDescriptors;
+    QVector<int> receivedDescriptors;
+    qint64 totalBytesWritten;
+    bool descriptorPassing;
+    void discardPassedDescriptors();
+#endif
+
 #if defined(Q_OS_WIN)
     LPFN_WSASENDMSG sendmsg;
     LPFN_WSARECVMSG recvmsg;
@@ -276,9 +302,19 @@ public:
     qint64 nativePendingDatagramSize() const;
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
+#ifdef Q_OS_LINUX
+    int nativeReceiveDatagrams(char *data, qint64 maxSize, int count, qint64 *lengths,
+                               QIpPacketHeader *headers,
+                               QAbstractSocketEngine::PacketHeaderOptions options);
+#endif
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifdef Q_OS_UNIX
+    qint64 nativeWriteBlocks(const char * const *data, const qint64 *lengths, int count);
+    qint64 nativeWriteDescriptors(const char *data, qint64 length, const QVector<int> &descriptors);
+    qint64 nativeReadDescriptors(char *data, qint64 maxLength);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -58,9 +58,7 @@
 #ifdef Q_OS_BSD4
 #include <net/if_dl.h>
 #endif
-#ifdef Q_OS_INTEGRITY
 #include <sys/uio.h>
-#endif
 
 #if defined QNATIVESOCKETENGINE_DEBUG
 #include <qstring.h>
@@ -164,6 +162,11 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
     case QNativeSocketEngine::AddressReusable:
         n = SO_REUSEADDR;
         break;
+    case QNativeSocketEngine::ReusePortOption:
+#ifdef SO_REUSEPORT
+        n = SO_REUSEPORT;
+#endif
+        break;
     case QNativeSocketEngine::ReceiveOutOfBandData:
         n = SO_OOBINLINE;
         break;
@@ -905,11 +908,12 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+namespace {
+// The ancillary data we may receive with a datagram;
+// we use quintptr to force the alignment
+struct ReceiveControlBuffer
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
                    + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
@@ -917,6 +921,78 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
                    + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
                    + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
+} // unnamed namespace
+
+static void qt_parseDatagramHeader(struct msghdr *msg, const qt_sockaddr *aa, quint16 localPort,
+                                   QIpPacketHeader *header)
+{
+    qt_socket_getPortAndAddress(aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != NULL;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
+        }
+
+#ifdef IP_PKTINFO
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
+#else
+#  ifdef IP_RECVDSTADDR
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
+#  endif
+#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
+#  endif
+#endif
+
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            Q_STATIC_ASSERT(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
+
+#ifndef QT_NO_SCTP
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+
+            header->streamNumber = int(rcvInfo->sinfo_stream);
+        }
+#endif
+    }
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    ReceiveControlBuffer cbuf;
 
     struct msghdr msg;
     struct iovec vec;
@@ -936,7 +1012,7 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     }
     if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
                    | QAbstractSocketEngine::WantStreamNumber)) {
-        msg.msg_control = cbuf;
+        msg.msg_control = &cbuf;
         msg.msg_controllen = sizeof(cbuf);
     }
 
@@ -964,66 +1040,7 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
             header->clear();
     } else if (options != QAbstractSocketEngine::WantNone) {
         Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != NULL;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
-
-#ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
-#else
-#  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
-#  endif
-#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
-#  endif
-#endif
-
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                Q_STATIC_ASSERT(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
-
-#ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
-
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
-        }
+        qt_parseDatagramHeader(&msg, &aa, localPort, header);
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
@@ -1038,6 +1055,75 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
 }
 
+#ifdef Q_OS_LINUX
+int QNativeSocketEnginePrivate::nativeReceiveDatagrams(char *data, qint64 maxSize, int count,
+                                                       qint64 *lengths, QIpPacketHeader *headers,
+                                                       QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    Q_ASSERT(maxSize > 0 && count > 0);
+
+    QVarLengthArray<struct mmsghdr, 16> msgs(count);
+    QVarLengthArray<struct iovec, 16> vecs(count);
+    QVarLengthArray<qt_sockaddr, 16> addresses(count);
+    QVarLengthArray<ReceiveControlBuffer, 16> cbufs(count);
+    memset(msgs.data(), 0, count * sizeof(struct mmsghdr));
+    memset(addresses.data(), 0, count * sizeof(qt_sockaddr));
+
+    for (int i = 0; i < count; ++i) {
+        struct msghdr &msg = msgs[i].msg_hdr;
+        vecs[i].iov_base = data + i * maxSize;
+        vecs[i].iov_len = maxSize;
+        msg.msg_iov = &vecs[i];
+        msg.msg_iovlen = 1;
+        if (options & QAbstractSocketEngine::WantDatagramSender) {
+            msg.msg_name = &addresses[i];
+            msg.msg_namelen = sizeof(qt_sockaddr);
+        }
+        if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
+                       | QAbstractSocketEngine::WantStreamNumber)) {
+            msg.msg_control = &cbufs[i];
+            msg.msg_controllen = sizeof(ReceiveControlBuffer);
+        }
+    }
+
+    int received = 0;
+    do {
+        received = ::recvmmsg(socketDescriptor, msgs.data(), count, 0, nullptr);
+    } while (received == -1 && errno == EINTR);
+
+    if (received == -1) {
+        switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            // No datagram was available for reading
+            received = -2;
+            break;
+        case ECONNREFUSED:
+            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
+            break;
+        default:
+            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+        }
+        return received;
+    }
+
+    for (int i = 0; i < received; ++i) {
+        lengths[i] = qint64(msgs[i].msg_len);
+        if (options != QAbstractSocketEngine::WantNone)
+            qt_parseDatagramHeader(&msgs[i].msg_hdr, &addresses[i], localPort, &headers[i]);
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%p, %lli, %i) == %i",
+           data, maxSize, count, received);
+#endif
+
+    return received;
+}
+#endif // Q_OS_LINUX
+
 qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
 {
     // we use quintptr to force the alignment
@@ -1301,7 +1387,23 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     Q_Q(QNativeSocketEngine);
 
     ssize_t writtenBytes;
-    writtenBytes = qt_safe_write_nosignal(socketDescriptor, data, len);
+    if (outgoingDescriptors.isEmpty()) {
+        writtenBytes = qt_safe_write_nosignal(socketDescriptor, data, len);
+    } else if (outgoingDescriptors.constFirst().offset > totalBytesWritten) {
+        // stop short of the byte that carries the next descriptors
+        len = qMin(len, outgoingDescriptors.constFirst().offset - totalBytesWritten);
+        writtenBytes = qt_safe_write_nosignal(socketDescriptor, data, len);
+    } else {
+        writtenBytes = nativeWriteDescriptors(data, len, outgoingDescriptors.constFirst().descriptors);
+        if (writtenBytes > 0) {
+            // the receiver has its own copies now
+            for (int descriptor : outgoingDescriptors.constFirst().descriptors)
+                qt_safe_close(descriptor);
+            outgoingDescriptors.removeFirst();
+        }
+    }
+    if (writtenBytes > 0)
+        totalBytesWritten += writtenBytes;
 
     if (writtenBytes < 0) {
         switch (errno) {
@@ -1330,6 +1432,124 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+qint64 QNativeSocketEnginePrivate::nativeWriteBlocks(const char * const *data, const qint64 *lengths,
+                                                     int count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    QVarLengthArray<struct iovec, 16> vec(count);
+    for (int i = 0; i < count; ++i) {
+        vec[i].iov_base = const_cast<char *>(data[i]);
+        vec[i].iov_len = size_t(lengths[i]);
+    }
+
+    qt_ignore_sigpipe();
+    ssize_t writtenBytes;
+    EINTR_LOOP(writtenBytes, ::writev(socketDescriptor, vec.constData(), count));
+    if (writtenBytes > 0)
+        totalBytesWritten += writtenBytes;
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteBlocks(%d blocks) == %i",
+           count, (int) writtenBytes);
+#endif
+
+    return qint64(writtenBytes);
+}
+
+// The most descriptors received with one read; Linux sends at most 253
+// with one message, and any beyond the buffer are closed by the system.
+enum { MaxReceivedDescriptors = 64 };
+
+qint64 QNativeSocketEnginePrivate::nativeWriteDescriptors(const char *data, qint64 len,
+                                                          const QVector<int> &descriptors)
+{
+    struct iovec vec;
+    vec.iov_base = const_cast<char *>(data);
+    vec.iov_len = size_t(len);
+
+    const size_t descriptorsSize = sizeof(int) * size_t(descriptors.size());
+    QVarLengthArray<char, CMSG_SPACE(sizeof(int) * 4)> control(int(CMSG_SPACE(descriptorsSize)));
+    memset(control.data(), 0, size_t(control.size()));
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data();
+    msg.msg_controllen = control.size();
+
+    struct cmsghdr *cmsgptr = CMSG_FIRSTHDR(&msg);
+    cmsgptr->cmsg_level = SOL_SOCKET;
+    cmsgptr->cmsg_type = SCM_RIGHTS;
+    cmsgptr->cmsg_len = CMSG_LEN(descriptorsSize);
+    memcpy(CMSG_DATA(cmsgptr), descriptors.constData(), descriptorsSize);
+
+    return qt_safe_sendmsg(socketDescriptor, &msg, 0);
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReadDescriptors(char *data, qint64 maxSize)
+{
+    struct iovec vec;
+    vec.iov_base = data;
+    vec.iov_len = size_t(maxSize);
+
+    union {
+        struct cmsghdr align;
+        char data[CMSG_SPACE(sizeof(int) * MaxReceivedDescriptors)];
+    } control;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+
+    int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+    ssize_t r;
+    EINTR_LOOP(r, ::recvmsg(socketDescriptor, &msg, flags));
+    if (r < 0)
+        return r;
+
+    for (struct cmsghdr *cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != 0;
+         cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
+        if (cmsgptr->cmsg_level != SOL_SOCKET || cmsgptr->cmsg_type != SCM_RIGHTS)
+            continue;
+        const int count = int((cmsgptr->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+        const int *received = reinterpret_cast<const int *>(CMSG_DATA(cmsgptr));
+        for (int i = 0; i < count; ++i) {
+            int descriptor;
+            memcpy(&descriptor, received + i, sizeof(int));
+#ifndef MSG_CMSG_CLOEXEC
+            ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+#endif
+            receivedDescriptors.append(descriptor);
+        }
+    }
+    return r;
+}
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
@@ -1341,7 +1561,10 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     }
 
     ssize_t r = 0;
-    r = qt_safe_read(socketDescriptor, data, maxSize);
+    if (descriptorPassing)
+        r = nativeReadDescriptors(data, maxSize);
+    else
+        r = qt_safe_read(socketDescriptor, data, maxSize);
 
     if (r < 0) {
         r = -1;
@@ -1414,4 +1637,78 @@ int QNativeSocketEnginePrivate::nativeSelect(int timeout, bool checkRead, bool c
     return ret;
 }
 
+/*!
+    Enables or disables the reception of file descriptors on an AF_UNIX
+    stream socket. While enabled, descriptors that arrive with the data are
+    kept until takeReceivedDescriptor() is called; otherwise they are
+    closed by the system.
+*/
+void QNativeSocketEngine::setDescriptorPassingEnabled(bool enable)
+{
+    Q_D(QNativeSocketEngine);
+    d->descriptorPassing = enable;
+}
+
+bool QNativeSocketEngine::isDescriptorPassingEnabled() const
+{
+    Q_D(const QNativeSocketEngine);
+    return d->descriptorPassing;
+}
+
+/*!
+    Sends a duplicate of \a descriptor with the byte that is written after
+    the next \a bytesBefore bytes. Returns \c false if the descriptor could
+    not be duplicated.
+*/
+bool QNativeSocketEngine::queueDescriptor(int descriptor, qint64 bytesBefore)
+{
+    Q_D(QNativeSocketEngine);
+    if (d->socketDescriptor == -1)
+        return false;
+
+    const int copy = qt_safe_dup(descriptor);
+    if (copy == -1)
+        return false;
+
+    const qint64 offset = d->totalBytesWritten + bytesBefore;
+    if (d->outgoingDescriptors.isEmpty() || d->outgoingDescriptors.constLast().offset != offset) {
+        QNativeSocketEnginePrivate::OutgoingDescriptors group;
+        group.offset = offset;
+        d->outgoingDescriptors.append(group);
+    }
+    d->outgoingDescriptors.last().descriptors.append(copy);
+    return true;
+}
+
+int QNativeSocketEngine::receivedDescriptorCount() const
+{
+    Q_D(const QNativeSocketEngine);
+    return d->receivedDescriptors.size();
+}
+
+/*!
+    Returns the oldest received file descriptor, which the caller then
+    owns, or -1 if there is none.
+*/
+int QNativeSocketEngine::takeReceivedDescriptor()
+{
+    Q_D(QNativeSocketEngine);
+    if (d->receivedDescriptors.isEmpty())
+        return -1;
+    return d->receivedDescriptors.takeFirst();
+}
+
+void QNativeSocketEnginePrivate::discardPassedDescriptors()
+{
+    for (const OutgoingDescriptors &group : qAsConst(outgoingDescriptors)) {
+        for (int descriptor : group.descriptors)
+            qt_safe_close(descriptor);
+    }
+    outgoingDescriptors.clear();
+    for (int descriptor : qAsConst(receivedDescriptors))
+        qt_safe_close(descriptor);
+    receivedDescriptors.clear();
+    totalBytesWritten = 0;
+}
+
 QT_END_NAMESPACE
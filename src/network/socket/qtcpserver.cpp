@@ -124,6 +124,7 @@ QTcpServerPrivate::QTcpServerPrivate()
  , socketEngine(0)
  , serverSocketError(QAbstractSocket::UnknownSocketError)
  , maxConnections(30)
+ , portSharing(false)
 {
 }
 
@@ -329,6 +330,12 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    if (d->portSharing && !d->socketEngine->setOption(QAbstractSocketEngine::ReusePortOption, 1)) {
+        d->serverSocketError = QAbstractSocket::UnsupportedSocketOperationError;
+        d->serverSocketErrorString = tr("Port sharing is not supported on this platform");
+        return false;
+    }
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
@@ -657,6 +664,46 @@ int QTcpServer::maxPendingConnections() const
     return d_func()->maxConnections;
 }
 
+/*!
+    \since 5.11
+
+    Sets whether listen() allows other sockets to listen on the same
+    address and port at the same time to \a enabled. The default is
+    false. The setting takes effect the next time listen() is called.
+
+    When port sharing is enabled on every server listening on an
+    address and port, the operating system distributes the incoming
+    connections among them. This lets an application create one
+    QTcpServer in each of several worker threads, so that connections
+    are accepted and handled in those threads without being handed
+    over from a single accepting thread.
+
+    Port sharing is implemented using the \c SO_REUSEPORT socket
+    option. Connections are balanced between the servers on Linux;
+    other Unix systems may deliver all of them to one server. On
+    platforms without \c SO_REUSEPORT, listen() fails with
+    QAbstractSocket::UnsupportedSocketOperationError.
+
+    \sa isPortSharingEnabled(), listen()
+*/
+void QTcpServer::setPortSharingEnabled(bool enabled)
+{
+    d_func()->portSharing = enabled;
+}
+
+/*!
+    \since 5.11
+
+    Returns \c true if listen() allows other sockets to share the
+    address and port; otherwise returns \c false.
+
+    \sa setPortSharingEnabled()
+*/
+bool QTcpServer::isPortSharingEnabled() const
+{
+    return d_func()->portSharing;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -102,6 +102,9 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
+
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -125,6 +128,9 @@ public:
 
     inline bool ensureInitialized(const QHostAddress &remoteAddress)
     { return doEnsureInitialized(QHostAddress(), 0, remoteAddress); }
+
+    // receiveDatagrams() reads into this buffer, kept between calls
+    QByteArray datagramsBuffer;
 };
 
 bool QUdpSocketPrivate::doEnsureInitialized(const QHostAddress &bindAddress, quint16 bindPort,
@@ -473,6 +479,61 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 5.11
+
+    Receives up to \a maxCount pending datagrams, each no larger than \a
+    maxSize bytes, and returns them along with their sender's host address
+    and port (and, if possible, their destination address, port and hop
+    count), in the order in which they were received.
+
+    Where the operating system supports it (currently on Linux), all the
+    datagrams are read with a single system call, which makes this function
+    considerably cheaper than calling receiveDatagram() \a maxCount times
+    when datagrams arrive at a high rate.
+
+    Returns an empty list if there are no pending datagrams or on failure.
+    If a datagram is larger than \a maxSize, the rest of it will be lost.
+
+    \sa receiveDatagram(), hasPendingDatagrams()
+*/
+QVector<QNetworkDatagram> QUdpSocket::receiveDatagrams(int maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%d, %lld)", maxCount, maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QVector<QNetworkDatagram>());
+
+    QVector<QNetworkDatagram> result;
+    if (maxCount <= 0 || maxSize <= 0 || maxSize > std::numeric_limits<int>::max() / 2)
+        return result;
+    maxCount = int(qMin<qint64>(maxCount, std::numeric_limits<int>::max() / 2 / maxSize));
+
+    d->datagramsBuffer.resize(int(maxCount * maxSize));
+    QVarLengthArray<qint64, 16> lengths(maxCount);
+    QVarLengthArray<QIpPacketHeader, 16> headers(maxCount);
+    const int received = d->socketEngine->readDatagrams(d->datagramsBuffer.data(), maxSize, maxCount,
+                                                          lengths.data(), headers.data(),
+                                                          QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (received == -1) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        return result;
+    }
+
+    result.reserve(qMax(received, 0));
+    for (int i = 0; i < received; ++i) {
+        QNetworkDatagram datagram(QByteArray(d->datagramsBuffer.constData() + i * maxSize,
+                                             int(lengths[i])));
+        datagram.d->header = headers[i];
+        result.append(datagram);
+    }
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
@@ -176,6 +176,16 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     chosen based on the servers preferences rather than the order ciphers were
     sent by the client. This option is only relevant to server sockets, and is
     only honored by the OpenSSL backend.
+    \value SslOptionEnableSharedSessionCache Lets a client socket resume a
+    session established by another client socket, in any thread, that
+    connected to the same host and port with the same local certificate.
+    Only sessions whose handshake reported no SSL errors are shared. This
+    saves a full handshake with hosts the application connects to often.
+    A resumed session does not verify the peer's certificate again, so only
+    enable this on sockets that verify a given host the same way. The option
+    has no effect if SslOptionDisableSessionSharing is set, and is only
+    honored by the OpenSSL backend.
+    (This value was introduced in 5.11.)
 
     By default, SslOptionDisableEmptyFragments is turned on since this causes
     problems with a large number of servers. SslOptionDisableLegacyRenegotiation
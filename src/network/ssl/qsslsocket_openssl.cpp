@@ -66,6 +66,7 @@
 #include "qsslpresharedkeyauthenticator.h"
 #include "qsslpresharedkeyauthenticator_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
@@ -96,6 +97,44 @@ bool QSslSocketPrivate::s_loadRootCertsOnDemand = false;
 int QSslSocketBackendPrivate::s_indexForSSLExtraData = -1;
 #endif
 
+namespace {
+// Client sessions shared by all sockets that enable
+// QSsl::SslOptionEnableSharedSessionCache, keyed by peer and local
+// certificate. Sockets in different threads use it concurrently.
+class QSslSharedSessionCache
+{
+public:
+    QSslSharedSessionCache() : sessions(256) {}
+
+    bool resume(const QByteArray &key, SSL *ssl)
+    {
+        QMutexLocker locker(&mutex);
+        const Entry *entry = sessions.object(key);
+        return entry && q_SSL_set_session(ssl, entry->session);
+    }
+
+    // takes over the reference held by the caller
+    void insert(const QByteArray &key, SSL_SESSION *session)
+    {
+        QMutexLocker locker(&mutex);
+        sessions.insert(key, new Entry(session));
+    }
+
+private:
+    struct Entry
+    {
+        explicit Entry(SSL_SESSION *s) : session(s) {}
+        ~Entry() { q_SSL_SESSION_free(session); }
+        SSL_SESSION *session;
+    };
+
+    QMutex mutex;
+    QCache<QByteArray, Entry> sessions;
+};
+}
+
+Q_GLOBAL_STATIC(QSslSharedSessionCache, sharedSessionCache)
+
 QString QSslSocketBackendPrivate::getErrorsFromOpenSsl()
 {
     QString errorString;
@@ -340,6 +379,9 @@ bool QSslSocketBackendPrivate::initSslContext()
         }
     }
 
+    if (mode == QSslSocket::SslClientMode && !q_SSL_get_session(ssl) && usesSharedSessionCache())
+        sharedSessionCache()->resume(sharedSessionKey(), ssl);
+
     // Clear the session.
     errorList.clear();
 
@@ -379,6 +421,36 @@ bool QSslSocketBackendPrivate::initSslContext()
     return true;
 }
 
+bool QSslSocketBackendPrivate::usesSharedSessionCache() const
+{
+    return (configuration.sslOptions & QSsl::SslOptionEnableSharedSessionCache)
+            && !(configuration.sslOptions & QSsl::SslOptionDisableSessionSharing);
+}
+
+QByteArray QSslSocketBackendPrivate::sharedSessionKey() const
+{
+    Q_Q(const QSslSocket);
+    QString peer = verificationPeerName.isEmpty() ? q->peerName() : verificationPeerName;
+    if (peer.isEmpty())
+        peer = hostName;
+    QByteArray key = peer.toUtf8() + ':' + QByteArray::number(q->peerPort());
+    if (!configuration.localCertificateChain.isEmpty())
+        key += ':' + configuration.localCertificateChain.first().digest();
+    return key;
+}
+
+// Called once a client handshake has finished. Sessions of handshakes
+// that reported SSL errors are not offered to other sockets, since a
+// resumed session skips certificate verification.
+void QSslSocketBackendPrivate::storeSharedSession()
+{
+    if (mode != QSslSocket::SslClientMode || !sslErrors.isEmpty() || !usesSharedSessionCache())
+        return;
+
+    if (SSL_SESSION *session = q_SSL_get1_session(ssl))
+        sharedSessionCache()->insert(sharedSessionKey(), session);
+}
+
 void QSslSocketBackendPrivate::destroySslContext()
 {
     if (ssl) {
@@ -696,16 +768,25 @@ void QSslSocketBackendPrivate::transmit()
         // Check if we've got any data to be read from the socket.
         if (!connectionEncrypted || !readBufferMaxSize || buffer.size() < readBufferMaxSize)
             while ((pendingBytes = plainSocket->bytesAvailable()) > 0) {
-                // Read encrypted data from the socket into a buffer.
-                data.resize(pendingBytes);
-                // just peek() here because q_BIO_write could write less data than expected
-                int encryptedBytesRead = plainSocket->peek(data.data(), pendingBytes);
+                // Hand the encrypted data to the read BIO straight from the
+                // plain socket's read buffer, one contiguous block at a time.
+                // Only copy it out if it is not buffered there.
+                const QRingBufferRef &plainBuffer =
+                        static_cast<const QAbstractSocketPrivate *>(QObjectPrivate::get(plainSocket))->buffer;
+                const char *encryptedData = plainBuffer.readPointer();
+                int encryptedBytesRead = int(qMin(plainBuffer.nextDataBlockSize(), qint64(pendingBytes)));
+                if (encryptedBytesRead <= 0) {
+                    data.resize(pendingBytes);
+                    // just peek() here because q_BIO_write could write less data than expected
+                    encryptedBytesRead = plainSocket->peek(data.data(), pendingBytes);
+                    encryptedData = data.constData();
+                }
 
 #ifdef QSSLSOCKET_DEBUG
                 qCDebug(lcSsl) << "QSslSocketBackendPrivate::transmit: read" << encryptedBytesRead << "encrypted bytes from the socket";
 #endif
                 // Write encrypted data from the buffer into the read BIO.
-                int writtenToBio = q_BIO_write(readBio, data.constData(), encryptedBytesRead);
+                int writtenToBio = q_BIO_write(readBio, encryptedData, encryptedBytesRead);
 
                 // Throw away the results.
                 if (writtenToBio > 0) {
@@ -757,8 +838,10 @@ void QSslSocketBackendPrivate::transmit()
         // We always read everything from the SSL decryption buffers, even if
         // we have a readBufferMaxSize. There's no point in leaving data there
         // just so that readBuffer.size() == readBufferMaxSize.
+        // Read in chunks of the largest possible TLS record, so that a whole
+        // record is decrypted by a single SSL_read() call.
         int readBytes = 0;
-        const int bytesToRead = 4096;
+        const int bytesToRead = 16384;
         do {
             // Don't use SSL_pending(). It's very unreliable.
             readBytes = q_SSL_read(ssl, buffer.reserve(bytesToRead), bytesToRead);
@@ -1372,9 +1455,20 @@ QList<QSslError> QSslSocketBackendPrivate::verify(const QList<QSslCertificate> &
         return errors;
     }
 
+#if defined(Q_OS_UNIX) && !defined(Q_OS_DARWIN)
+    if (s_loadRootCertsOnDemand) {
+        // Let OpenSSL look the roots up in the hashed directories, as
+        // QSslContext does, instead of parsing the whole system store and
+        // making it the default for all sockets created afterwards.
+        const QList<QByteArray> unixDirs = unixRootCertDirectories();
+        for (const QByteArray &unixDir : unixDirs)
+            q_X509_STORE_load_locations(certStore, nullptr, unixDir.constData());
+    }
+#else
     if (s_loadRootCertsOnDemand) {
         setDefaultCaCertificates(defaultCaCertificates() + systemCaCertificates());
     }
+#endif
 
     const QDateTime now = QDateTime::currentDateTimeUtc();
     const auto caCertificates = QSslConfiguration::defaultConfiguration().caCertificates();
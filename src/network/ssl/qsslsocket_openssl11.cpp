@@ -240,6 +240,7 @@ void QSslSocketBackendPrivate::continueHandshake()
             }
         }
     }
+    storeSharedSession();
 
 #if !defined(OPENSSL_NO_NEXTPROTONEG)
 
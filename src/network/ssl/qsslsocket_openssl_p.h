@@ -122,6 +122,9 @@ public:
     // SSL context
     bool initSslContext();
     void destroySslContext();
+    bool usesSharedSessionCache() const;
+    QByteArray sharedSessionKey() const;
+    void storeSharedSession();
     SSL *ssl;
     BIO *readBio;
     BIO *writeBio;
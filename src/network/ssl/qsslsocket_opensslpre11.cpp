@@ -372,6 +372,7 @@ void QSslSocketBackendPrivate::continueHandshake()
             }
         }
     }
+    storeSharedSession();
 
 #if OPENSSL_VERSION_NUMBER >= 0x1000100fL && !defined(OPENSSL_NO_NEXTPROTONEG)
 
@@ -44,6 +44,8 @@
 #include <QOpenGLContext>
 #include <QtPlatformHeaders/QEGLNativeContext>
 #include <QDebug>
+#include <QtCore/QVarLengthArray>
+#include <QtGui/QRegion>
 
 #if defined(Q_OS_ANDROID) && !defined(Q_OS_ANDROID_EMBEDDED)
 #include <QtCore/private/qjnihelpers_p.h>
@@ -114,6 +116,10 @@ QT_BEGIN_NAMESPACE
 #define GL_CONTEXT_COMPATIBILITY_PROFILE_BIT 0x00000002
 #endif
 
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
 QEGLPlatformContext::QEGLPlatformContext(const QSurfaceFormat &format, QPlatformOpenGLContext *share, EGLDisplay display,
                                          EGLConfig *config, const QVariant &nativeHandle, Flags flags)
     : m_eglDisplay(display)
@@ -121,6 +127,8 @@ QEGLPlatformContext::QEGLPlatformContext(const QSurfaceFormat &format, QPlatform
     , m_swapIntervalEnvChecked(false)
     , m_swapIntervalFromEnv(-1)
     , m_flags(flags)
+    , m_hasBufferAge(false)
+    , m_swapBuffersWithDamage(0)
 {
     if (nativeHandle.isNull()) {
         m_eglConfig = config ? *config : q_configFromGLFormat(display, format);
@@ -130,6 +138,16 @@ QEGLPlatformContext::QEGLPlatformContext(const QSurfaceFormat &format, QPlatform
         m_ownsContext = false;
         adopt(nativeHandle, share);
     }
+    resolveSwapExtensions();
+}
+
+void QEGLPlatformContext::resolveSwapExtensions()
+{
+    m_hasBufferAge = q_hasEglExtension(m_eglDisplay, "EGL_EXT_buffer_age");
+    if (q_hasEglExtension(m_eglDisplay, "EGL_KHR_swap_buffers_with_damage"))
+        m_swapBuffersWithDamage = reinterpret_cast<SwapBuffersWithDamageFunc>(eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+    else if (q_hasEglExtension(m_eglDisplay, "EGL_EXT_swap_buffers_with_damage"))
+        m_swapBuffersWithDamage = reinterpret_cast<SwapBuffersWithDamageFunc>(eglGetProcAddress("eglSwapBuffersWithDamageEXT"));
 }
 
 void QEGLPlatformContext::init(const QSurfaceFormat &format, QPlatformOpenGLContext *share)
@@ -450,6 +468,49 @@ void QEGLPlatformContext::swapBuffers(QPlatformSurface *surface)
     }
 }
 
+void QEGLPlatformContext::swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage)
+{
+    if (!m_swapBuffersWithDamage || damage.isEmpty()) {
+        QEGLPlatformContext::swapBuffers(surface);
+        return;
+    }
+
+    eglBindAPI(m_api);
+    EGLSurface eglSurface = eglSurfaceForPlatformSurface(surface);
+    if (eglSurface == EGL_NO_SURFACE)
+        return;
+
+    // EGL expects the rectangles with the origin in the bottom-left corner.
+    EGLint height = 0;
+    eglQuerySurface(m_eglDisplay, eglSurface, EGL_HEIGHT, &height);
+    QVarLengthArray<EGLint, 16> rects;
+    rects.reserve(damage.rectCount() * 4);
+    for (const QRect &r : damage) {
+        rects.append(r.x());
+        rects.append(height - r.y() - r.height());
+        rects.append(r.width());
+        rects.append(r.height());
+    }
+    bool ok = m_swapBuffersWithDamage(m_eglDisplay, eglSurface, rects.constData(), damage.rectCount());
+    if (!ok)
+        qWarning("QEGLPlatformContext: eglSwapBuffersWithDamage failed: %x", eglGetError());
+}
+
+int QEGLPlatformContext::bufferAge(QPlatformSurface *surface) const
+{
+    if (!m_hasBufferAge)
+        return 0;
+
+    EGLSurface eglSurface = const_cast<QEGLPlatformContext *>(this)->eglSurfaceForPlatformSurface(surface);
+    if (eglSurface == EGL_NO_SURFACE)
+        return 0;
+
+    EGLint age = 0;
+    if (!eglQuerySurface(m_eglDisplay, eglSurface, EGL_BUFFER_AGE_EXT, &age))
+        return 0;
+    return age;
+}
+
 QFunctionPointer QEGLPlatformContext::getProcAddress(const char *procName)
 {
     eglBindAPI(m_api);
@@ -76,6 +76,8 @@ public:
     bool makeCurrent(QPlatformSurface *surface) Q_DECL_OVERRIDE;
     void doneCurrent() Q_DECL_OVERRIDE;
     void swapBuffers(QPlatformSurface *surface) Q_DECL_OVERRIDE;
+    void swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage) Q_DECL_OVERRIDE;
+    int bufferAge(QPlatformSurface *surface) const Q_DECL_OVERRIDE;
     QFunctionPointer getProcAddress(const char *procName) Q_DECL_OVERRIDE;
 
     QSurfaceFormat format() const Q_DECL_OVERRIDE;
@@ -96,6 +98,7 @@ private:
     void init(const QSurfaceFormat &format, QPlatformOpenGLContext *share);
     void adopt(const QVariant &nativeHandle, QPlatformOpenGLContext *share);
     void updateFormatFromGL();
+    void resolveSwapExtensions();
 
     EGLContext m_eglContext;
     EGLContext m_shareContext;
@@ -109,6 +112,10 @@ private:
     Flags m_flags;
     bool m_ownsContext;
     QVector<EGLint> m_contextAttrs;
+    bool m_hasBufferAge;
+    typedef EGLBoolean (EGLAPIENTRYP SwapBuffersWithDamageFunc)(EGLDisplay dpy, EGLSurface surface,
+                                                                const EGLint *rects, EGLint n_rects);
+    SwapBuffersWithDamageFunc m_swapBuffersWithDamage;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QEGLPlatformContext::Flags)
@@ -2270,6 +2270,13 @@ bool QFontEngineFT::initFromFontEngine(const QFontEngineFT *fe)
     // will be using it
     freetype->ref.ref();
 
+    copyRenderingSettings(fe);
+
+    return true;
+}
+
+void QFontEngineFT::copyRenderingSettings(const QFontEngineFT *fe)
+{
     default_load_flags = fe->default_load_flags;
     default_hint_style = fe->default_hint_style;
     antialias = fe->antialias;
@@ -2279,8 +2286,6 @@ bool QFontEngineFT::initFromFontEngine(const QFontEngineFT *fe)
     subpixelType = fe->subpixelType;
     lcdFilterType = fe->lcdFilterType;
     embeddedbitmap = fe->embeddedbitmap;
-
-    return true;
 }
 
 QFontEngine *QFontEngineFT::cloneWithSize(qreal pixelSize) const
@@ -2296,6 +2301,25 @@ QFontEngine *QFontEngineFT::cloneWithSize(qreal pixelSize) const
     }
 }
 
+bool QFontEngineFT::supportsThreadedRasterization() const
+{
+    return !face_id.filename.isEmpty() || !freetype->fontData.isEmpty();
+}
+
+QFontEngine *QFontEngineFT::cloneForThread() const
+{
+    // FreeType faces must not be used from more than one thread, so instead of
+    // sharing ours, load the face again through the calling thread's library
+    QFontEngineFT *fe = new QFontEngineFT(fontDef);
+    if (!fe->init(face_id, antialias, defaultFormat, freetype->fontData)) {
+        delete fe;
+        return 0;
+    }
+    fe->copyRenderingSettings(this);
+    fe->forceAutoHint = forceAutoHint;
+    return fe;
+}
+
 Qt::HANDLE QFontEngineFT::handle() const
 {
     return non_locked_face();
@@ -288,6 +288,8 @@ private:
     void setDefaultHintStyle(HintStyle style) Q_DECL_OVERRIDE;
 
     QFontEngine *cloneWithSize(qreal pixelSize) const Q_DECL_OVERRIDE;
+    bool supportsThreadedRasterization() const Q_DECL_OVERRIDE;
+    QFontEngine *cloneForThread() const Q_DECL_OVERRIDE;
     Qt::HANDLE handle() const Q_DECL_OVERRIDE;
     bool initFromFontEngine(const QFontEngineFT *fontEngine);
 
@@ -318,6 +320,7 @@ private:
     friend class QFreeTypeFontDatabase;
     friend class QFontEngineMultiFontConfig;
 
+    void copyRenderingSettings(const QFontEngineFT *fe);
     int loadFlags(QGlyphSet *set, GlyphFormat format, int flags, bool &hsubpixel, int &vfactor) const;
     bool shouldUseDesignMetrics(ShaperFlags flags) const;
     QFixed scaledBitmapMetrics(QFixed m) const;
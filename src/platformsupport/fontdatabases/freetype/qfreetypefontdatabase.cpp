@@ -46,6 +46,11 @@
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QDir>
 #include <QtCore/QtEndian>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
 
 #undef QT_NO_FREETYPE
 #include <QtFontDatabaseSupport/private/qfontengine_ft_p.h>
@@ -56,6 +61,119 @@
 
 QT_BEGIN_NAMESPACE
 
+struct FontFaceInfo
+{
+    QString family;
+    QString styleName;
+    int index;
+    int weight;
+    int style;
+    bool fixedPitch;
+    quint64 writingSystems; // bit i is set when QFontDatabase::WritingSystem(i) is supported
+};
+
+struct FontCacheEntry
+{
+    qint64 size;
+    qint64 lastModified;
+    QVector<FontFaceInfo> faces;
+};
+
+typedef QHash<QString, FontCacheEntry> FontCache;
+
+static const quint32 fontCacheMagic = 0x51464442; // "QFDB"
+static const quint32 fontCacheVersion = 1;
+
+static QDataStream &operator<<(QDataStream &stream, const FontFaceInfo &face)
+{
+    return stream << face.family << face.styleName << qint32(face.index) << qint32(face.weight)
+                  << qint32(face.style) << face.fixedPitch << face.writingSystems;
+}
+
+static QDataStream &operator>>(QDataStream &stream, FontFaceInfo &face)
+{
+    qint32 index, weight, style;
+    stream >> face.family >> face.styleName >> index >> weight >> style
+           >> face.fixedPitch >> face.writingSystems;
+    face.index = index;
+    face.weight = weight;
+    face.style = style;
+    return stream;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const FontCacheEntry &entry)
+{
+    return stream << entry.size << entry.lastModified << entry.faces;
+}
+
+static QDataStream &operator>>(QDataStream &stream, FontCacheEntry &entry)
+{
+    return stream >> entry.size >> entry.lastModified >> entry.faces;
+}
+
+static QString fontCacheFileName(const QString &fontPath)
+{
+    if (qEnvironmentVariableIsSet("QT_NO_FONTDATABASE_CACHE"))
+        return QString();
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheDir.isEmpty())
+        return QString();
+
+    const QByteArray hash = QCryptographicHash::hash(QFile::encodeName(fontPath), QCryptographicHash::Sha1).toHex();
+    return cacheDir + QLatin1String("/qtfontdatabase/") + QString::fromLatin1(hash) + QLatin1String(".cache");
+}
+
+static FontCache readFontCache(const QString &fileName)
+{
+    FontCache cache;
+    if (fileName.isEmpty())
+        return cache;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return cache;
+
+    // read straight from the mapped file instead of copying it first
+    QByteArray data;
+    if (const uchar *mapped = file.map(0, file.size()))
+        data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), int(file.size()));
+    else
+        data = file.readAll();
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_10);
+    quint32 magic, version;
+    stream >> magic >> version;
+    if (magic != fontCacheMagic || version != fontCacheVersion)
+        return cache;
+
+    stream >> cache;
+    if (stream.status() != QDataStream::Ok)
+        cache.clear();
+    return cache;
+}
+
+static void writeFontCache(const QString &fileName, const FontCache &cache)
+{
+    if (fileName.isEmpty())
+        return;
+
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_10);
+    stream << fontCacheMagic << fontCacheVersion << cache;
+    if (stream.status() == QDataStream::Ok)
+        file.commit();
+}
+
+static QVector<FontFaceInfo> facesInFile(const QByteArray &fontData, const QByteArray &file);
+static QStringList registerFaces(const QVector<FontFaceInfo> &faces, const QByteArray &file);
+
 void QFreeTypeFontDatabase::populateFontDatabase()
 {
     QString fontpath = fontDir();
@@ -75,11 +193,37 @@ void QFreeTypeFontDatabase::populateFontDatabase()
                 << QLatin1String("*.pfb")
                 << QLatin1String("*.otf");
 
+    // Opening every font file is what makes populating slow, so the faces
+    // found in each file are cached on disk and only files whose size or
+    // modification time changed are opened again.
+    const QString cacheFileName = fontCacheFileName(fontpath);
+    const FontCache cache = readFontCache(cacheFileName);
+    FontCache newCache;
+    bool cacheChanged = false;
+
     const auto fis = dir.entryInfoList(nameFilters, QDir::Files);
     for (const QFileInfo &fi : fis) {
-        const QByteArray file = QFile::encodeName(fi.absoluteFilePath());
-        QFreeTypeFontDatabase::addTTFile(QByteArray(), file);
+        const QString fileName = fi.absoluteFilePath();
+        const QByteArray file = QFile::encodeName(fileName);
+        const qint64 lastModified = fi.lastModified().toMSecsSinceEpoch();
+
+        FontCacheEntry entry;
+        FontCache::const_iterator it = cache.constFind(fileName);
+        if (it != cache.constEnd() && it->size == fi.size() && it->lastModified == lastModified) {
+            entry = it.value();
+        } else {
+            entry.size = fi.size();
+            entry.lastModified = lastModified;
+            entry.faces = facesInFile(QByteArray(), file);
+            cacheChanged = true;
+        }
+
+        registerFaces(entry.faces, file);
+        newCache.insert(fileName, entry);
     }
+
+    if (cacheChanged || newCache.size() != cache.size())
+        writeFontCache(cacheFileName, newCache);
 }
 
 QFontEngine *QFreeTypeFontDatabase::fontEngine(const QFontDef &fontDef, void *usrPtr)
@@ -112,12 +256,43 @@ void QFreeTypeFontDatabase::releaseHandle(void *handle)
 extern FT_Library qt_getFreetype();
 
 QStringList QFreeTypeFontDatabase::addTTFile(const QByteArray &fontData, const QByteArray &file)
+{
+    return registerFaces(facesInFile(fontData, file), file);
+}
+
+static QStringList registerFaces(const QVector<FontFaceInfo> &faces, const QByteArray &file)
+{
+    QStringList families;
+    for (const FontFaceInfo &face : faces) {
+        QSupportedWritingSystems writingSystems;
+        for (int i = 0; i < QFontDatabase::WritingSystemsCount; ++i) {
+            if (face.writingSystems & (Q_UINT64_C(1) << i))
+                writingSystems.setSupported(QFontDatabase::WritingSystem(i));
+        }
+
+        FontFile *fontFile = new FontFile;
+        fontFile->fileName = QFile::decodeName(file);
+        fontFile->indexValue = face.index;
+
+        QFont::Stretch stretch = QFont::Unstretched;
+
+        QPlatformFontDatabase::registerFont(face.family, face.styleName, QString(),
+                                            QFont::Weight(face.weight), QFont::Style(face.style),
+                                            stretch, true, true, 0, face.fixedPitch,
+                                            writingSystems, fontFile);
+
+        families.append(face.family);
+    }
+    return families;
+}
+
+static QVector<FontFaceInfo> facesInFile(const QByteArray &fontData, const QByteArray &file)
 {
     FT_Library library = qt_getFreetype();
 
     int index = 0;
     int numFaces = 0;
-    QStringList families;
+    QVector<FontFaceInfo> faces;
     do {
         FT_Face face;
         FT_Error error;
@@ -194,21 +369,24 @@ QStringList QFreeTypeFontDatabase::addTTFile(const QByteArray &fontData, const Q
             }
         }
 
-        QString family = QString::fromLatin1(face->family_name);
-        FontFile *fontFile = new FontFile;
-        fontFile->fileName = QFile::decodeName(file);
-        fontFile->indexValue = index;
-
-        QFont::Stretch stretch = QFont::Unstretched;
-
-        registerFont(family,QString::fromLatin1(face->style_name),QString(),weight,style,stretch,true,true,0,fixedPitch,writingSystems,fontFile);
-
-        families.append(family);
+        FontFaceInfo info;
+        info.family = QString::fromLatin1(face->family_name);
+        info.styleName = QString::fromLatin1(face->style_name);
+        info.index = index;
+        info.weight = weight;
+        info.style = style;
+        info.fixedPitch = fixedPitch;
+        info.writingSystems = 0;
+        for (int i = 0; i < QFontDatabase::WritingSystemsCount; ++i) {
+            if (writingSystems.supported(QFontDatabase::WritingSystem(i)))
+                info.writingSystems |= Q_UINT64_C(1) << i;
+        }
+        faces.append(info);
 
         FT_Done_Face(face);
         ++index;
     } while (index < numFaces);
-    return families;
+    return faces;
 }
 
 QT_END_NAMESPACE
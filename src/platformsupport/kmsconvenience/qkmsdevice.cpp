@@ -339,9 +339,16 @@ QPlatformScreen *QKmsDevice::createScreenForConnector(drmModeResPtr resources,
         connectorPropertyBlob(connector, QByteArrayLiteral("EDID")),
         false,
         0,
-        false
+        false,
+        QVector<QKmsPlane>(),
+        -1
     };
 
+    for (const QKmsPlane &plane : qAsConst(m_planes)) {
+        if (plane.possibleCrtcs & (1 << crtc))
+            output.available_planes.append(plane);
+    }
+
     bool ok;
     int idx = qEnvironmentVariableIntValue("QT_QPA_EGLFS_KMS_PLANE_INDEX", &ok);
     if (ok) {
@@ -352,6 +359,10 @@ QPlatformScreen *QKmsDevice::createScreenForConnector(drmModeResPtr resources,
                 if (plane) {
                     output.wants_plane = true;
                     output.plane_id = plane->plane_id;
+                    for (int i = 0; i < output.available_planes.count(); ++i) {
+                        if (output.available_planes.at(i).id == output.plane_id)
+                            output.eglfs_plane = i;
+                    }
                     qCDebug(qLcKmsDebug, "Forcing plane index %d, plane id %u (belongs to crtc id %u)",
                             idx, plane->plane_id, plane->crtc_id);
                     drmModeFreePlane(plane);
@@ -362,6 +373,19 @@ QPlatformScreen *QKmsDevice::createScreenForConnector(drmModeResPtr resources,
         }
     }
 
+    if (m_has_atomic_support && output.eglfs_plane < 0) {
+        // With atomic modesetting the eglfs surface is shown on the primary plane
+        // unless a specific plane was requested.
+        for (int i = 0; i < output.available_planes.count(); ++i) {
+            if (output.available_planes.at(i).type == QKmsPlane::PrimaryPlane) {
+                output.eglfs_plane = i;
+                break;
+            }
+        }
+    }
+    if (const QKmsPlane *plane = output.eglfsPlane())
+        qCDebug(qLcKmsDebug, "Output %s uses plane id %u", connectorName.constData(), plane->id);
+
     m_crtc_allocator |= (1 << output.crtc_id);
     m_connector_allocator |= (1 << output.connector_id);
 
@@ -407,6 +431,10 @@ QKmsDevice::QKmsDevice(QKmsScreenConfig *screenConfig, const QString &path)
     , m_dri_fd(-1)
     , m_crtc_allocator(0)
     , m_connector_allocator(0)
+    , m_has_atomic_support(false)
+#if QT_CONFIG(drm_atomic)
+    , m_atomic_request(nullptr)
+#endif
 {
     if (m_path.isEmpty()) {
         m_path = m_screenConfig->devicePath();
@@ -420,6 +448,10 @@ QKmsDevice::QKmsDevice(QKmsScreenConfig *screenConfig, const QString &path)
 
 QKmsDevice::~QKmsDevice()
 {
+#if QT_CONFIG(drm_atomic)
+    if (m_atomic_request)
+        drmModeAtomicFree(m_atomic_request);
+#endif
 }
 
 struct OrderedScreen
@@ -449,12 +481,27 @@ static bool orderedScreenLessThan(const OrderedScreen &a, const OrderedScreen &b
 
 void QKmsDevice::createScreens()
 {
+#if QT_CONFIG(drm_atomic)
+    // Atomic modesetting is opt-in. Enabling it also exposes the primary and
+    // cursor planes, which changes the meaning of QT_QPA_EGLFS_KMS_PLANE_INDEX.
+    if (qEnvironmentVariableIntValue("QT_QPA_EGLFS_KMS_ATOMIC")) {
+        m_has_atomic_support = drmSetClientCap(m_dri_fd, DRM_CLIENT_CAP_ATOMIC, 1) == 0
+                && drmSetClientCap(m_dri_fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1) == 0;
+        if (m_has_atomic_support)
+            qCDebug(qLcKmsDebug, "Using atomic modesetting");
+        else
+            qCWarning(qLcKmsDebug, "Atomic modesetting requested but not supported by the DRM device");
+    }
+#endif
+
     drmModeResPtr resources = drmModeGetResources(m_dri_fd);
     if (!resources) {
         qWarning("drmModeGetResources failed");
         return;
     }
 
+    discoverPlanes();
+
     QVector<OrderedScreen> screens;
 
     int wantedConnectorIndex = -1;
@@ -551,6 +598,100 @@ QKmsScreenConfig *QKmsDevice::screenConfig() const
     return m_screenConfig;
 }
 
+bool QKmsDevice::hasAtomicSupport() const
+{
+    return m_has_atomic_support;
+}
+
+#if QT_CONFIG(drm_atomic)
+drmModeAtomicReq *QKmsDevice::atomicRequest()
+{
+    if (!m_atomic_request)
+        m_atomic_request = drmModeAtomicAlloc();
+    return m_atomic_request;
+}
+
+bool QKmsDevice::atomicCommit(void *user_data)
+{
+    if (!m_atomic_request)
+        return false;
+
+    int ret = drmModeAtomicCommit(m_dri_fd, m_atomic_request,
+                                  DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT, user_data);
+    drmModeAtomicFree(m_atomic_request);
+    m_atomic_request = nullptr;
+
+    if (ret) {
+        qErrnoWarning(errno, "Failed to commit atomic request");
+        return false;
+    }
+    return true;
+}
+#endif
+
+void QKmsDevice::discoverPlanes()
+{
+    m_planes.clear();
+
+    drmModePlaneResPtr planeResources = drmModeGetPlaneResources(m_dri_fd);
+    if (!planeResources)
+        return;
+
+    for (uint32_t i = 0; i < planeResources->count_planes; ++i) {
+        drmModePlanePtr drmPlane = drmModeGetPlane(m_dri_fd, planeResources->planes[i]);
+        if (!drmPlane)
+            continue;
+
+        QKmsPlane plane;
+        plane.id = drmPlane->plane_id;
+        plane.possibleCrtcs = drmPlane->possible_crtcs;
+        plane.supportedFormats.reserve(drmPlane->count_formats);
+        for (uint32_t f = 0; f < drmPlane->count_formats; ++f)
+            plane.supportedFormats.append(drmPlane->formats[f]);
+        drmModeFreePlane(drmPlane);
+
+        drmModeObjectPropertiesPtr props = drmModeObjectGetProperties(m_dri_fd, plane.id, DRM_MODE_OBJECT_PLANE);
+        if (props) {
+            for (uint32_t p = 0; p < props->count_props; ++p) {
+                drmModePropertyPtr prop = drmModeGetProperty(m_dri_fd, props->props[p]);
+                if (!prop)
+                    continue;
+                const QByteArray name(prop->name);
+                if (name == "type")
+                    plane.type = QKmsPlane::Type(props->prop_values[p]);
+                else if (name == "FB_ID")
+                    plane.framebufferPropertyId = prop->prop_id;
+                else if (name == "CRTC_ID")
+                    plane.crtcPropertyId = prop->prop_id;
+                else if (name == "SRC_X")
+                    plane.srcXPropertyId = prop->prop_id;
+                else if (name == "SRC_Y")
+                    plane.srcYPropertyId = prop->prop_id;
+                else if (name == "SRC_W")
+                    plane.srcWidthPropertyId = prop->prop_id;
+                else if (name == "SRC_H")
+                    plane.srcHeightPropertyId = prop->prop_id;
+                else if (name == "CRTC_X")
+                    plane.crtcXPropertyId = prop->prop_id;
+                else if (name == "CRTC_Y")
+                    plane.crtcYPropertyId = prop->prop_id;
+                else if (name == "CRTC_W")
+                    plane.crtcWidthPropertyId = prop->prop_id;
+                else if (name == "CRTC_H")
+                    plane.crtcHeightPropertyId = prop->prop_id;
+                drmModeFreeProperty(prop);
+            }
+            drmModeFreeObjectProperties(props);
+        }
+
+        qCDebug(qLcKmsDebug, "Plane id %u type %d possible crtcs 0x%x, %d formats",
+                plane.id, plane.type, plane.possibleCrtcs, plane.supportedFormats.count());
+        m_planes.append(plane);
+    }
+
+    drmModeFreePlaneResources(planeResources);
+}
+
 QKmsScreenConfig::QKmsScreenConfig()
     : m_hwCursor(true)
     , m_separateScreens(false)
@@ -53,9 +53,11 @@
 // We mean it.
 //
 
+#include <QtGui/private/qtguiglobal_p.h>
 #include <qpa/qplatformscreen.h>
 #include <QtCore/QMap>
 #include <QtCore/QVariant>
+#include <QtCore/QVector>
 
 #include <xf86drm.h>
 #include <xf86drmMode.h>
@@ -94,6 +96,33 @@ private:
     QMap<QString, QVariantMap> m_outputSettings;
 };
 
+// Hardware plane as reported by DRM. The property ids are only resolved when
+// atomic modesetting is in use.
+struct QKmsPlane
+{
+    enum Type {
+        OverlayPlane = 0,
+        PrimaryPlane = 1,
+        CursorPlane = 2
+    };
+
+    uint32_t id = 0;
+    Type type = OverlayPlane;
+    uint32_t possibleCrtcs = 0; // bitmask of crtc indices
+    QVector<uint32_t> supportedFormats;
+
+    uint32_t framebufferPropertyId = 0;
+    uint32_t crtcPropertyId = 0;
+    uint32_t srcXPropertyId = 0;
+    uint32_t srcYPropertyId = 0;
+    uint32_t srcWidthPropertyId = 0;
+    uint32_t srcHeightPropertyId = 0;
+    uint32_t crtcXPropertyId = 0;
+    uint32_t crtcYPropertyId = 0;
+    uint32_t crtcWidthPropertyId = 0;
+    uint32_t crtcHeightPropertyId = 0;
+};
+
 struct QKmsOutput
 {
     QString name;
@@ -111,6 +140,13 @@ struct QKmsOutput
     bool wants_plane;
     uint32_t plane_id;
     bool plane_set;
+    QVector<QKmsPlane> available_planes; // planes usable with crtc_id
+    int eglfs_plane; // index in available_planes of the plane showing the eglfs surface, or -1
+
+    const QKmsPlane *eglfsPlane() const
+    {
+        return eglfs_plane >= 0 ? &available_planes.at(eglfs_plane) : nullptr;
+    }
 
     void restoreMode(QKmsDevice *device);
     void cleanup(QKmsDevice *device);
@@ -142,6 +178,12 @@ public:
 
     QKmsScreenConfig *screenConfig() const;
 
+    bool hasAtomicSupport() const;
+#if QT_CONFIG(drm_atomic)
+    drmModeAtomicReq *atomicRequest();
+    bool atomicCommit(void *user_data);
+#endif
+
 protected:
     virtual QPlatformScreen *createScreen(const QKmsOutput &output) = 0;
     virtual void registerScreen(QPlatformScreen *screen,
@@ -156,6 +198,7 @@ protected:
                                               VirtualDesktopInfo *vinfo);
     drmModePropertyPtr connectorProperty(drmModeConnectorPtr connector, const QByteArray &name);
     drmModePropertyBlobPtr connectorPropertyBlob(drmModeConnectorPtr connector, const QByteArray &name);
+    void discoverPlanes();
 
     QKmsScreenConfig *m_screenConfig;
     QString m_path;
@@ -164,6 +207,12 @@ protected:
     quint32 m_crtc_allocator;
     quint32 m_connector_allocator;
 
+    bool m_has_atomic_support;
+#if QT_CONFIG(drm_atomic)
+    drmModeAtomicReq *m_atomic_request;
+#endif
+    QVector<QKmsPlane> m_planes;
+
 private:
     Q_DISABLE_COPY(QKmsDevice)
 };
@@ -74,6 +74,11 @@ extern "C" {
 #endif
 }
 
+// jpeg_crop_scanline() and jpeg_skip_scanlines() were added in libjpeg-turbo 1.5
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+#  define QT_JPEG_PARTIAL_DECODE
+#endif
+
 QT_BEGIN_NAMESPACE
 QT_WARNING_DISABLE_GCC("-Wclobbered")
 
@@ -339,6 +344,13 @@ static bool read_jpeg_image(QImage *outImage,
             info->do_fancy_upsampling = FALSE;
         }
 
+#ifdef JCS_EXTENSIONS
+        // Have libjpeg-turbo write RGB32 pixels instead of converting
+        // packed RGB rows afterwards.
+        if (info->out_color_space == JCS_RGB)
+            info->out_color_space = QSysInfo::ByteOrder == QSysInfo::LittleEndian ? JCS_EXT_BGRX : JCS_EXT_XRGB;
+#endif
+
         (void) jpeg_calc_output_dimensions(info);
 
         // Determine the clip region to extract.
@@ -378,23 +390,50 @@ static bool read_jpeg_image(QImage *outImage,
 
             (void) jpeg_start_decompress(info);
 
+            int xoffset = clip.x();
+#ifdef QT_JPEG_PARTIAL_DECODE
+            // Only decode the iMCU columns around the clip region, and
+            // skip the rows above it without running the IDCT on them.
+            // A margin of one iMCU column keeps the upsampling context
+            // at the clip edges, so the pixels match a full decode.
+            if (clip.width() < imageRect.width()) {
+                const int margin = 16;
+                const int left = qMax(clip.x() - margin, 0);
+                JDIMENSION x = left;
+                JDIMENSION width = qMin(clip.right() + 1 + margin, imageRect.width()) - left;
+                jpeg_crop_scanline(info, &x, &width);
+                xoffset = clip.x() - int(x);
+            }
+            // Skipping crashes with the merged upsampler in libjpeg-turbo 1.5.
+            if (clip.y() > 0 && info->do_fancy_upsampling)
+                jpeg_skip_scanlines(info, clip.y());
+#endif
+            const bool directRgb32 = info->output_components == 4 && info->out_color_space != JCS_CMYK
+                                     && xoffset == 0 && int(info->output_width) == clip.width();
+
             while (info->output_scanline < info->output_height) {
                 int y = int(info->output_scanline) - clip.y();
                 if (y >= clip.height())
                     break;      // We've read the entire clip region, so abort.
 
+                if (directRgb32 && y >= 0) {
+                    uchar *row = outImage->scanLine(y);
+                    (void) jpeg_read_scanlines(info, &row, 1);
+                    continue;
+                }
+
                 (void) jpeg_read_scanlines(info, rows, 1);
 
                 if (y < 0)
                     continue;   // Haven't reached the starting line yet.
 
                 if (info->output_components == 3) {
-                    uchar *in = rows[0] + clip.x() * 3;
+                    uchar *in = rows[0] + xoffset * 3;
                     QRgb *out = (QRgb*)outImage->scanLine(y);
                     converter(out, in, clip.width());
                 } else if (info->out_color_space == JCS_CMYK) {
                     // Convert CMYK->RGB.
-                    uchar *in = rows[0] + clip.x() * 4;
+                    uchar *in = rows[0] + xoffset * 4;
                     QRgb *out = (QRgb*)outImage->scanLine(y);
                     for (int i = 0; i < clip.width(); ++i) {
                         int k = in[3];
@@ -405,7 +444,11 @@ static bool read_jpeg_image(QImage *outImage,
                 } else if (info->output_components == 1) {
                     // Grayscale.
                     memcpy(outImage->scanLine(y),
-                           rows[0] + clip.x(), clip.width());
+                           rows[0] + xoffset, clip.width());
+                } else {
+                    // RGB32 written by libjpeg-turbo.
+                    memcpy(outImage->scanLine(y),
+                           rows[0] + xoffset * 4, clip.width() * 4);
                 }
             }
         } else {
@@ -39,6 +39,7 @@
 
 #include "qeglfsglobal_p.h"
 #include <QtGui/QSurface>
+#include <QtGui/QRegion>
 #include <QtEglSupport/private/qeglconvenience_p.h>
 #include <QtEglSupport/private/qeglpbuffer_p.h>
 
@@ -104,15 +105,26 @@ void QEglFSContext::runGLChecks()
 
 void QEglFSContext::swapBuffers(QPlatformSurface *surface)
 {
+    swapBuffersWithDamage(surface, QRegion());
+}
+
+void QEglFSContext::swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage)
+{
+    QRegion swapDamage = damage;
+
     // draw the cursor
     if (surface->surface()->surfaceClass() == QSurface::Window) {
         QPlatformWindow *window = static_cast<QPlatformWindow *>(surface);
-        if (QEglFSCursor *cursor = qobject_cast<QEglFSCursor *>(window->screen()->cursor()))
+        if (QEglFSCursor *cursor = qobject_cast<QEglFSCursor *>(window->screen()->cursor())) {
             cursor->paintOnScreen();
+            // The cursor is drawn into the back buffer on every frame, so
+            // it cannot be left out of the damage.
+            swapDamage = QRegion();
+        }
     }
 
     qt_egl_device_integration()->waitForVSync(surface);
-    QEGLPlatformContext::swapBuffers(surface);
+    QEGLPlatformContext::swapBuffersWithDamage(surface, swapDamage);
     qt_egl_device_integration()->presentBuffer(surface);
 }
 
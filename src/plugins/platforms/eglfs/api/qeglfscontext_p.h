@@ -68,6 +68,7 @@ public:
     void destroyTemporaryOffscreenSurface(EGLSurface surface) override;
     void runGLChecks() override;
     void swapBuffers(QPlatformSurface *surface) override;
+    void swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage) override;
 
     QEglFSCursorData cursorData;
 
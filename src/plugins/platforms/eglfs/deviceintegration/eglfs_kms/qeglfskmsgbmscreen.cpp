@@ -219,6 +219,30 @@ void QEglFSKmsGbmScreen::flip()
         }
     }
 
+#if QT_CONFIG(drm_atomic)
+    const QKmsPlane *plane = op.eglfsPlane();
+    if (device()->hasAtomicSupport() && plane) {
+        drmModeAtomicReq *request = device()->atomicRequest();
+        if (request) {
+            drmModeAtomicAddProperty(request, plane->id, plane->framebufferPropertyId, fb->fb);
+            drmModeAtomicAddProperty(request, plane->id, plane->crtcPropertyId, op.crtc_id);
+            drmModeAtomicAddProperty(request, plane->id, plane->srcXPropertyId, 0);
+            drmModeAtomicAddProperty(request, plane->id, plane->srcYPropertyId, 0);
+            drmModeAtomicAddProperty(request, plane->id, plane->srcWidthPropertyId, w << 16);
+            drmModeAtomicAddProperty(request, plane->id, plane->srcHeightPropertyId, h << 16);
+            drmModeAtomicAddProperty(request, plane->id, plane->crtcXPropertyId, 0);
+            drmModeAtomicAddProperty(request, plane->id, plane->crtcYPropertyId, 0);
+            drmModeAtomicAddProperty(request, plane->id, plane->crtcWidthPropertyId, w);
+            drmModeAtomicAddProperty(request, plane->id, plane->crtcHeightPropertyId, h);
+        }
+        if (!request || !device()->atomicCommit(this)) {
+            gbm_surface_release_buffer(m_gbm_surface, m_gbm_bo_next);
+            m_gbm_bo_next = Q_NULLPTR;
+        }
+        return;
+    }
+#endif
+
     int ret = drmModePageFlip(fd,
                               op.crtc_id,
                               fb->fb,
@@ -62,6 +62,8 @@ Q_LOGGING_CATEGORY(qLcFbDrm, "qt.qpa.fb")
 
 static const int BUFFER_COUNT = 2;
 
+extern bool qt_linuxfb_copyRegion(QImage *dst, const QImage &src, const QRegion &region);
+
 class QLinuxFbDevice : public QKmsDevice
 {
 public:
@@ -76,12 +78,13 @@ public:
     };
 
     struct Output {
-        Output() : backFb(0), flipped(false) { }
+        Output() : backFb(0), flipped(false), flipPending(false) { }
         QKmsOutput kmsOutput;
         Framebuffer fb[BUFFER_COUNT];
         QRegion dirty[BUFFER_COUNT];
         int backFb;
         bool flipped;
+        bool flipPending;
         QSize currentRes() const {
             const drmModeModeInfo &modeInfo(kmsOutput.modes[kmsOutput.mode]);
             return QSize(modeInfo.hdisplay, modeInfo.vdisplay);
@@ -98,6 +101,7 @@ public:
     void setMode();
 
     void swapBuffers(Output *output);
+    void waitForFlip(Output *output);
 
     int outputCount() const { return m_outputs.count(); }
     Output *output(int idx) { return &m_outputs[idx]; }
@@ -269,6 +273,7 @@ void QLinuxFbDevice::destroyFramebuffer(QLinuxFbDevice::Output *output, int buff
 void QLinuxFbDevice::destroyFramebuffers()
 {
     for (Output &output : m_outputs) {
+        waitForFlip(&output);
         for (int i = 0; i < BUFFER_COUNT; ++i)
             destroyFramebuffer(&output, i);
     }
@@ -300,8 +305,12 @@ void QLinuxFbDevice::pageFlipHandler(int fd, unsigned int sequence,
 
     Output *output = static_cast<Output *>(user_data);
     output->backFb = (output->backFb + 1) % BUFFER_COUNT;
+    output->flipPending = false;
 }
 
+// Queues a flip to the back buffer and returns right away. The flip completes
+// on the next vblank; waitForFlip() must be called before the (new) back
+// buffer is written to, since until then it is still being scanned out.
 void QLinuxFbDevice::swapBuffers(Output *output)
 {
     Framebuffer &fb(output->fb[output->backFb]);
@@ -310,8 +319,12 @@ void QLinuxFbDevice::swapBuffers(Output *output)
         return;
     }
 
-    const int fbIdx = output->backFb;
-    while (output->backFb == fbIdx) {
+    output->flipPending = true;
+}
+
+void QLinuxFbDevice::waitForFlip(Output *output)
+{
+    while (output->flipPending) {
         drmEventContext drmEvent;
         memset(&drmEvent, 0, sizeof(drmEvent));
         drmEvent.version = 2;
@@ -380,16 +393,22 @@ QRegion QLinuxFbDrmScreen::doRedraw()
     for (int i = 0; i < BUFFER_COUNT; ++i)
         output->dirty[i] += dirty;
 
+    // The previous frame may still be waiting for its vblank.
+    m_device->waitForFlip(output);
+
     if (output->fb[output->backFb].wrapper.isNull())
         return dirty;
 
-    QPainter pntr(&output->fb[output->backFb].wrapper);
-    // Image has alpha but no need for blending at this stage.
-    // Do not waste time with the default SourceOver.
-    pntr.setCompositionMode(QPainter::CompositionMode_Source);
-    for (const QRect &rect : qAsConst(output->dirty[output->backFb]))
-        pntr.drawImage(rect, mScreenImage, rect);
-    pntr.end();
+    QImage &wrapper(output->fb[output->backFb].wrapper);
+    if (!qt_linuxfb_copyRegion(&wrapper, mScreenImage, output->dirty[output->backFb])) {
+        QPainter pntr(&wrapper);
+        // Image has alpha but no need for blending at this stage.
+        // Do not waste time with the default SourceOver.
+        pntr.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const QRect &rect : qAsConst(output->dirty[output->backFb]))
+            pntr.drawImage(rect, mScreenImage, rect);
+        pntr.end();
+    }
 
     output->dirty[output->backFb] = QRegion();
 
@@ -402,6 +402,41 @@ bool QLinuxFbScreen::initialize()
     return true;
 }
 
+// Copies \a region from \a src into the framebuffer image \a dst. Returns false
+// when the pixel formats differ and a QPainter has to do the conversion instead.
+// The framebuffer memory is typically uncached, so plain scanline copies that
+// write each byte exactly once are considerably cheaper than going through the
+// raster paint engine for every dirty rectangle.
+bool qt_linuxfb_copyRegion(QImage *dst, const QImage &src, const QRegion &region)
+{
+    if (dst->format() != src.format() || dst->depth() != src.depth())
+        return false;
+
+    const int bpp = src.depth() / 8;
+    if (bpp * 8 != src.depth())
+        return false;
+
+    const QRect bounds = src.rect() & dst->rect();
+    const int srcStride = src.bytesPerLine();
+    const int dstStride = dst->bytesPerLine();
+    const uchar *srcBits = src.constBits();
+    uchar *dstBits = dst->bits();
+    for (const QRect &r : region) {
+        const QRect rect = r & bounds;
+        if (rect.isEmpty())
+            continue;
+        const int length = rect.width() * bpp;
+        const uchar *s = srcBits + rect.y() * srcStride + rect.x() * bpp;
+        uchar *d = dstBits + rect.y() * dstStride + rect.x() * bpp;
+        for (int y = 0; y < rect.height(); ++y) {
+            memcpy(d, s, length);
+            s += srcStride;
+            d += dstStride;
+        }
+    }
+    return true;
+}
+
 QRegion QLinuxFbScreen::doRedraw()
 {
     QRegion touched = QFbScreen::doRedraw();
@@ -409,6 +444,9 @@ QRegion QLinuxFbScreen::doRedraw()
     if (touched.isEmpty())
         return touched;
 
+    if (qt_linuxfb_copyRegion(&mFbScreenImage, mScreenImage, touched))
+        return touched;
+
     if (!mBlitter)
         mBlitter = new QPainter(&mFbScreenImage);
 
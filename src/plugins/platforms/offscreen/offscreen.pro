@@ -26,6 +26,15 @@ qtConfig(xlib):qtConfig(opengl):!qtConfig(opengles2) {
     SOURCES += qoffscreenintegration_dummy.cpp
 }
 
+qtConfig(egl) {
+    SOURCES += qoffscreenintegration_egl.cpp
+    HEADERS += qoffscreenintegration_egl.h
+    QT += egl_support-private
+    # Avoid X11 header collision, use generic EGL native types
+    DEFINES += QT_EGL_NO_X11
+    CONFIG += egl
+}
+
 PLUGIN_TYPE = platforms
 PLUGIN_CLASS_NAME = QOffscreenIntegrationPlugin
 !equals(TARGET, $$QT_DEFAULT_QPA_PLUGIN): PLUGIN_EXTENDS = -
@@ -38,8 +38,16 @@
 ****************************************************************************/
 
 #include "qoffscreenintegration.h"
+#include <QtGui/private/qtguiglobal_p.h>
+#if QT_CONFIG(egl)
+#include "qoffscreenintegration_egl.h"
+#endif
 
 QOffscreenIntegration *QOffscreenIntegration::createOffscreenIntegration()
 {
+#if QT_CONFIG(egl)
+    return new QOffscreenEglIntegration;
+#else
     return new QOffscreenIntegration;
+#endif
 }
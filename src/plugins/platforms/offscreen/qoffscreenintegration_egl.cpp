@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the plugins of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qoffscreenintegration_egl.h"
+
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+
+#include <QtEglSupport/private/qeglconvenience_p.h>
+#include <QtEglSupport/private/qeglpbuffer_p.h>
+#include <QtEglSupport/private/qeglplatformcontext_p.h>
+
+#include <qpa/qplatformsurface.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QOffscreenEglContext : public QEGLPlatformContext
+{
+public:
+    QOffscreenEglContext(const QSurfaceFormat &format, QPlatformOpenGLContext *share, EGLDisplay display,
+                         EGLConfig *config)
+        : QEGLPlatformContext(format, share, display, config)
+        , m_windowSurface(EGL_NO_SURFACE)
+    {
+    }
+
+    ~QOffscreenEglContext()
+    {
+        if (m_windowSurface != EGL_NO_SURFACE)
+            eglDestroySurface(eglDisplay(), m_windowSurface);
+    }
+
+    EGLSurface eglSurfaceForPlatformSurface(QPlatformSurface *surface) Q_DECL_OVERRIDE
+    {
+        if (surface->surface()->surfaceClass() == QSurface::Offscreen)
+            return static_cast<QEGLPbuffer *>(surface)->pbuffer();
+
+        // Like with GLX, windows share one drawable of the context that is
+        // resized to the window being made current.
+        const QSize size = surface->surface()->size().expandedTo(QSize(1, 1));
+        if (m_windowSurface == EGL_NO_SURFACE || size != m_windowSurfaceSize) {
+            if (m_windowSurface != EGL_NO_SURFACE)
+                eglDestroySurface(eglDisplay(), m_windowSurface);
+            const EGLint attributes[] = {
+                EGL_WIDTH, size.width(),
+                EGL_HEIGHT, size.height(),
+                EGL_LARGEST_PBUFFER, EGL_FALSE,
+                EGL_NONE
+            };
+            // Falls back to a surfaceless context when pbuffers are not available.
+            m_windowSurface = eglCreatePbufferSurface(eglDisplay(), eglConfig(), attributes);
+            m_windowSurfaceSize = size;
+        }
+        return m_windowSurface;
+    }
+
+private:
+    EGLSurface m_windowSurface;
+    QSize m_windowSurfaceSize;
+};
+
+QOffscreenEglIntegration::QOffscreenEglIntegration()
+    : m_display(EGL_NO_DISPLAY)
+    , m_displayInitialized(false)
+{
+}
+
+QOffscreenEglIntegration::~QOffscreenEglIntegration()
+{
+    if (m_display != EGL_NO_DISPLAY)
+        eglTerminate(m_display);
+}
+
+/*
+    Returns true when OpenGL should go through EGL instead of GLX, which is
+    the case on machines without an X server or when QT_QPA_OFFSCREEN_EGL is
+    set.
+*/
+bool QOffscreenEglIntegration::isRequested()
+{
+    return qEnvironmentVariableIsEmpty("DISPLAY") || qEnvironmentVariableIntValue("QT_QPA_OFFSCREEN_EGL");
+}
+
+bool QOffscreenEglIntegration::hasCapability(QPlatformIntegration::Capability cap) const
+{
+    switch (cap) {
+    case OpenGL: return true;
+    case ThreadedOpenGL: return true;
+    default: return QOffscreenIntegration::hasCapability(cap);
+    }
+}
+
+/*
+    The display is opened on first use, so that applications never creating
+    an OpenGL context do not pay for initializing the driver. The surfaceless
+    platform is preferred since it needs neither a window system nor a DRM
+    master, which makes it usable on render-only GPU nodes.
+*/
+void *QOffscreenEglIntegration::display() const
+{
+    QMutexLocker lock(&m_displayMutex);
+    if (m_displayInitialized)
+        return m_display;
+    m_displayInitialized = true;
+
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const char *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (extensions && strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay)
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        qWarning("QOffscreenEglIntegration: Could not initialize EGL display");
+        return m_display;
+    }
+
+    m_display = display;
+    return m_display;
+}
+
+QPlatformOpenGLContext *QOffscreenEglIntegration::createPlatformOpenGLContext(QOpenGLContext *context) const
+{
+    EGLDisplay dpy = display();
+    if (dpy == EGL_NO_DISPLAY)
+        return nullptr;
+
+    EGLConfig config = q_configFromGLFormat(dpy, context->format(), false, EGL_PBUFFER_BIT);
+    return new QOffscreenEglContext(context->format(), context->shareHandle(), dpy,
+                                    config ? &config : nullptr);
+}
+
+QPlatformOffscreenSurface *QOffscreenEglIntegration::createPlatformOffscreenSurface(QOffscreenSurface *surface) const
+{
+    EGLDisplay dpy = display();
+    if (dpy == EGL_NO_DISPLAY)
+        return nullptr;
+
+    return new QEGLPbuffer(dpy, surface->requestedFormat(), surface);
+}
+
+QT_END_NAMESPACE
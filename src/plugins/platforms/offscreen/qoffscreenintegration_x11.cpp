@@ -39,6 +39,11 @@
 
 #include "qoffscreenintegration_x11.h"
 
+#include <QtGui/private/qtguiglobal_p.h>
+#if QT_CONFIG(egl)
+#include "qoffscreenintegration_egl.h"
+#endif
+
 #include <QByteArray>
 #include <QOpenGLContext>
 
@@ -54,6 +59,10 @@ QT_BEGIN_NAMESPACE
 
 QOffscreenIntegration *QOffscreenIntegration::createOffscreenIntegration()
 {
+#if QT_CONFIG(egl)
+    if (QOffscreenEglIntegration::isRequested())
+        return new QOffscreenEglIntegration;
+#endif
     return new QOffscreenX11Integration;
 }
 
@@ -98,6 +98,48 @@ inline void QVncDirtyMap::setClean(int x, int y)
     --numDirty;
 }
 
+/*
+    Compares the tiles covered by \a touched with the copy of the screen kept
+    in the map and returns the tiles whose content changed since they were
+    last taken. Repaints that produce the same pixels again, as is common for
+    animations and blinking cursors, no longer need to be sent to the clients.
+*/
+QRegion QVncDirtyMap::takeChangedRegion(const QRegion &touched)
+{
+    const QRect bounds(0, 0, bufferWidth, bufferHeight);
+    for (const QRect &r : touched) {
+        const QRect rect = r & bounds;
+        if (rect.isEmpty())
+            continue;
+        for (int y = rect.top() / MAP_TILE_SIZE; y <= rect.bottom() / MAP_TILE_SIZE; ++y) {
+            for (int x = rect.left() / MAP_TILE_SIZE; x <= rect.right() / MAP_TILE_SIZE; ++x)
+                setDirty(x, y);
+        }
+    }
+
+    QRegion changed;
+    if (!numDirty)
+        return changed;
+
+    for (int y = 0; y < mapHeight; ++y) {
+        int x = 0;
+        while (x < mapWidth) {
+            if (!dirty(x, y)) {
+                ++x;
+                continue;
+            }
+            const int start = x;
+            while (x < mapWidth && dirty(x, y)) {
+                setClean(x, y);
+                ++x;
+            }
+            changed += QRect(start * MAP_TILE_SIZE, y * MAP_TILE_SIZE,
+                             (x - start) * MAP_TILE_SIZE, MAP_TILE_SIZE);
+        }
+    }
+    return changed & bounds;
+}
+
 template <class T>
 void QVncDirtyMapOptimized<T>::setDirty(int tileX, int tileY, bool force)
 {
@@ -531,6 +573,158 @@ void QRfbRawEncoder::write()
     socket->flush();
 }
 
+// Tile size of the ZRLE encoding, fixed by the protocol
+static const int ZrleTileSize = 64;
+
+QRfbZrleEncoder::QRfbZrleEncoder(QVncClient *s)
+    : QRfbEncoder(s), streamInitialized(false), cpixelSize(0), cpixelOffset(0)
+{
+    memset(&stream, 0, sizeof(stream));
+}
+
+QRfbZrleEncoder::~QRfbZrleEncoder()
+{
+    if (streamInitialized)
+        deflateEnd(&stream);
+}
+
+// Appends one tile in the client's pixel format, either as a single
+// CPIXEL when the tile has a solid color or as raw CPIXELs.
+void QRfbZrleEncoder::appendTile(const QImage &screenImage, const QRect &tile)
+{
+    const int clientBpp = client->clientBytesPerPixel();
+    const int screenBpp = screenImage.depth() / 8;
+    const int rowSize = tile.width() * clientBpp;
+    if (rowBuffer.size() < rowSize)
+        rowBuffer.resize(rowSize);
+
+    const int tileStart = data.size();
+    data.append(char(1)); // subencoding: solid, downgraded to raw below if needed
+    bool solid = true;
+    const char *first = nullptr;
+    for (int y = tile.top(); y <= tile.bottom(); ++y) {
+        const char *src = reinterpret_cast<const char *>(screenImage.constScanLine(y))
+                          + tile.x() * screenBpp;
+        const char *row = src;
+        if (client->doPixelConversion()) {
+            client->convertPixels(rowBuffer.data(), src, tile.width());
+            row = rowBuffer.constData();
+        }
+
+        for (int x = 0; x < tile.width(); ++x) {
+            const char *cpixel = row + x * clientBpp + cpixelOffset;
+            if (solid) {
+                if (!first) {
+                    data.append(cpixel, cpixelSize);
+                    first = data.constData() + tileStart + 1;
+                    continue;
+                }
+                if (memcmp(first, cpixel, cpixelSize) == 0)
+                    continue;
+
+                // Not solid after all, replay the pixels seen so far as raw data.
+                solid = false;
+                const QByteArray color(first, cpixelSize);
+                data.resize(tileStart);
+                data.append(char(0)); // subencoding: raw
+                const int seen = (y - tile.top()) * tile.width() + x;
+                data.reserve(data.size() + tile.width() * tile.height() * cpixelSize);
+                for (int i = 0; i < seen; ++i)
+                    data.append(color);
+            }
+            data.append(cpixel, cpixelSize);
+        }
+    }
+}
+
+void QRfbZrleEncoder::write()
+{
+    QTcpSocket *socket = client->clientSocket();
+
+    if (!streamInitialized) {
+        if (deflateInit(&stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+            qWarning("QRfbZrleEncoder: Failed to initialize zlib");
+            return;
+        }
+        streamInitialized = true;
+    }
+
+    // A compact pixel drops the unused byte of 32 bit true color formats.
+    const QRfbPixelFormat &format = client->pixelFormat();
+    cpixelSize = client->clientBytesPerPixel();
+    cpixelOffset = 0;
+    if (format.trueColor && format.bitsPerPixel == 32 && format.depth <= 24) {
+        const int highestBit = qMax(format.redShift + format.redBits,
+                                    qMax(format.greenShift + format.greenBits,
+                                         format.blueShift + format.blueBits));
+        const int lowestBit = qMin(format.redShift, qMin(format.greenShift, format.blueShift));
+        if (highestBit <= 24) {
+            cpixelSize = 3;
+            cpixelOffset = format.bigEndian ? 1 : 0;
+        } else if (lowestBit >= 8) {
+            cpixelSize = 3;
+            cpixelOffset = format.bigEndian ? 0 : 1;
+        }
+    }
+
+    const QRegion rgn = client->dirtyRegion();
+    qCDebug(lcVnc) << "QRfbZrleEncoder::write()" << rgn;
+    const QVector<QRect> rects = rgn.rects();
+
+    {
+        const char tmp[2] = { 0, 0 }; // msg type, padding
+        socket->write(tmp, sizeof(tmp));
+    }
+
+    {
+        const quint16 count = htons(rects.size());
+        socket->write((char *)&count, sizeof(count));
+    }
+
+    if (rects.size() <= 0)
+        return;
+
+    const QImage screenImage = client->server()->screenImage();
+
+    for (const QRect &r : rects) {
+        const QRfbRect rect(r.x(), r.y(), r.width(), r.height());
+        rect.write(socket);
+
+        const quint32 encoding = htonl(16); // ZRLE encoding
+        socket->write((char *)&encoding, sizeof(encoding));
+
+        data.resize(0);
+        for (int y = r.top(); y <= r.bottom(); y += ZrleTileSize) {
+            for (int x = r.left(); x <= r.right(); x += ZrleTileSize) {
+                const QRect tile(x, y, qMin(ZrleTileSize, r.right() - x + 1),
+                                 qMin(ZrleTileSize, r.bottom() - y + 1));
+                appendTile(screenImage, tile);
+            }
+        }
+
+        // All rectangles of a connection share one zlib stream.
+        stream.next_in = reinterpret_cast<Bytef *>(data.data());
+        stream.avail_in = data.size();
+        int compressedSize = 0;
+        do {
+            if (compressed.size() - compressedSize < 4096)
+                compressed.resize(qMax(compressed.size() * 2, compressedSize + int(data.size() / 4) + 4096));
+            stream.next_out = reinterpret_cast<Bytef *>(compressed.data() + compressedSize);
+            stream.avail_out = compressed.size() - compressedSize;
+            deflate(&stream, Z_SYNC_FLUSH);
+            compressedSize = compressed.size() - stream.avail_out;
+        } while (stream.avail_out == 0);
+
+        const quint32 length = htonl(compressedSize);
+        socket->write((char *)&length, sizeof(length));
+        socket->write(compressed.constData(), compressedSize);
+
+        if (socket->state() == QAbstractSocket::UnconnectedState)
+            break;
+    }
+    socket->flush();
+}
+
 #if QT_CONFIG(cursor)
 QVncClientCursor::QVncClientCursor()
 {
@@ -644,8 +838,13 @@ QVncServer::~QVncServer()
 
 void QVncServer::setDirty()
 {
-    for (auto client : clients) {
-        client->setDirty(qvnc_screen->dirtyRegion);
+    if (!clients.isEmpty()) {
+        // Only send the tiles whose pixels actually changed.
+        const QRegion changed = dirtyMap()->takeChangedRegion(qvnc_screen->dirtyRegion);
+        if (!changed.isEmpty()) {
+            for (auto client : clients)
+                client->setDirty(changed);
+        }
     }
     qvnc_screen->clearDirty();
 }
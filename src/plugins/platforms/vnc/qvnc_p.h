@@ -47,6 +47,8 @@
 #include <QtCore/qvarlengtharray.h>
 #include <qpa/qplatformcursor.h>
 
+#include <zlib.h>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(lcVnc)
@@ -72,6 +74,7 @@ public:
     bool dirty(int x, int y) const;
     virtual void setDirty(int x, int y, bool force = false) = 0;
     void setClean(int x, int y);
+    QRegion takeChangedRegion(const QRegion &touched);
 
     QVncScreen *screen;
     int bytesPerPixel;
@@ -222,6 +225,26 @@ private:
     QByteArray buffer;
 };
 
+class QRfbZrleEncoder : public QRfbEncoder
+{
+public:
+    QRfbZrleEncoder(QVncClient *s);
+    ~QRfbZrleEncoder();
+
+    void write() override;
+
+private:
+    void appendTile(const QImage &screenImage, const QRect &tile);
+
+    z_stream stream;
+    bool streamInitialized;
+    int cpixelSize;
+    int cpixelOffset;
+    QByteArray rowBuffer;
+    QByteArray data;
+    QByteArray compressed;
+};
+
 template <class SRC> class QRfbHextileEncoder;
 
 template <class SRC>
@@ -92,8 +92,7 @@ QTcpSocket *QVncClient::clientSocket() const
 void QVncClient::setDirty(const QRegion &region)
 {
     m_dirtyRegion += region;
-    if (m_state == Connected &&
-        ((m_server->dirtyMap()->numDirty > 0) || m_dirtyCursor)) {
+    if (m_state == Connected && (!m_dirtyRegion.isEmpty() || m_dirtyCursor)) {
         scheduleUpdate();
     }
 }
@@ -545,6 +544,10 @@ void QVncClient::setEncodings()
                 break;
             case ZRLE:
                 m_supportZRLE = true;
+                if (!m_encoder) {
+                    m_encoder = new QRfbZrleEncoder(this);
+                    qCDebug(lcVnc, "QVncServer::setEncodings: using ZRLE");
+                }
                 break;
             case Cursor:
                 m_supportCursor = true;
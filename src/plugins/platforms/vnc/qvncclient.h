@@ -77,6 +77,7 @@ public:
         return m_pixelFormat.bitsPerPixel / 8;
     }
 
+    const QRfbPixelFormat &pixelFormat() const { return m_pixelFormat; }
     void convertPixels(char *dst, const char *src, int count) const;
     inline bool doPixelConversion() const { return m_needConversion; }
 
@@ -25,6 +25,8 @@ HEADERS = \
 
 OTHER_FILES += vnc.json
 
+include($$PWD/../../../3rdparty/zlib_dependency.pri)
+
 PLUGIN_TYPE = platforms
 PLUGIN_CLASS_NAME = QVncIntegrationPlugin
 !equals(TARGET, $$QT_DEFAULT_QPA_PLUGIN): PLUGIN_EXTENDS = -
@@ -145,8 +145,10 @@ void QWindowsAccessibility::notifyAccessibilityUpdate(QAccessibleEvent *event)
 
     // An event has to be associated with a window,
     // so find the first parent that is a widget and that has a WId
+    if (!isActive())
+        return;
     QAccessibleInterface *iface = event->accessibleInterface();
-    if (!isActive() || !iface || !iface->isValid())
+    if (!iface || !iface->isValid())
         return;
     QWindow *window = QWindowsAccessibility::windowHelper(iface);
 
@@ -88,6 +88,7 @@ private:
     void ensureGC(xcb_drawable_t dst);
     void flushPixmap(const QRegion &region);
     void setClip(const QRegion &region);
+    void putShm(xcb_drawable_t dst, const QRect &source, const QPoint &target, bool sendEvent);
 
     xcb_shm_segment_info_t m_shm_info;
 
@@ -101,6 +102,9 @@ private:
 
     // When using shared memory this is the region currently shared with the server
     QRegion m_dirtyShm;
+    // Sequence number of the last put from shared memory, completion is reported
+    // by the server with an event so that we rarely have to wait for it
+    uint m_lastShmPutSequence;
 
     // When not using shared memory, we maintain a server-side pixmap with the backing
     // store as well as repainted content not yet flushed to the pixmap. We only flush
@@ -148,6 +152,7 @@ QXcbShmImage::QXcbShmImage(QXcbScreen *screen, const QSize &size, uint depth, QI
     , m_graphics_buffer(Q_NULLPTR)
     , m_gc(0)
     , m_gc_drawable(0)
+    , m_lastShmPutSequence(0)
     , m_xcb_pixmap(0)
 {
     const xcb_format_t *fmt = connection()->formatForDepth(depth);
@@ -248,8 +253,10 @@ bool QXcbShmImage::scroll(const QRegion &area, int dx, int dy)
 void QXcbShmImage::destroy()
 {
     const int segmentSize = m_xcb_image ? (m_xcb_image->stride * m_xcb_image->height) : 0;
-    if (segmentSize && m_shm_info.shmaddr)
+    if (segmentSize && m_shm_info.shmaddr) {
         xcb_shm_detach(xcb_connection(), m_shm_info.shmseg);
+        connection()->forgetShmSegment(m_shm_info.shmseg);
+    }
 
     if (segmentSize) {
         if (m_shm_info.shmaddr) {
@@ -446,6 +453,19 @@ void QXcbShmImage::setClip(const QRegion &region)
 void QXcbShmImage::put(xcb_drawable_t dst, const QRegion &region, const QPoint &offset)
 {
     ensureGC(dst);
+
+    // A few separate rectangles are cheaper to put one by one than their
+    // clipped bounding rectangle, which makes the server walk the whole area.
+    static const int maxSeparatePuts = 8;
+    if (hasShm() && region.rectCount() <= maxSeparatePuts) {
+        const int last = region.rectCount() - 1;
+        int i = 0;
+        for (const QRect &rect : region)
+            putShm(dst, rect.translated(offset), rect.topLeft(), i++ == last);
+        m_dirtyShm |= region.translated(offset);
+        return;
+    }
+
     setClip(region);
 
     const QRect bounds = region.boundingRect();
@@ -453,19 +473,7 @@ void QXcbShmImage::put(xcb_drawable_t dst, const QRegion &region, const QPoint &
     const QRect source = bounds.translated(offset);
 
     if (hasShm()) {
-        xcb_shm_put_image(xcb_connection(),
-                          dst,
-                          m_gc,
-                          m_xcb_image->width,
-                          m_xcb_image->height,
-                          source.x(), source.y(),
-                          source.width(), source.height(),
-                          target.x(), target.y(),
-                          m_xcb_image->depth,
-                          m_xcb_image->format,
-                          0, // send event?
-                          m_shm_info.shmseg,
-                          m_xcb_image->data - m_shm_info.shmaddr);
+        putShm(dst, source, target, true);
         m_dirtyShm |= region.translated(offset);
     } else {
         flushPixmap(region);
@@ -481,12 +489,35 @@ void QXcbShmImage::put(xcb_drawable_t dst, const QRegion &region, const QPoint &
     setClip(QRegion());
 }
 
+void QXcbShmImage::putShm(xcb_drawable_t dst, const QRect &source, const QPoint &target, bool sendEvent)
+{
+    const xcb_void_cookie_t cookie =
+        xcb_shm_put_image(xcb_connection(),
+                          dst,
+                          m_gc,
+                          m_xcb_image->width,
+                          m_xcb_image->height,
+                          source.x(), source.y(),
+                          source.width(), source.height(),
+                          target.x(), target.y(),
+                          m_xcb_image->depth,
+                          m_xcb_image->format,
+                          sendEvent,
+                          m_shm_info.shmseg,
+                          m_xcb_image->data - m_shm_info.shmaddr);
+    if (sendEvent)
+        m_lastShmPutSequence = cookie.sequence;
+}
+
 void QXcbShmImage::preparePaint(const QRegion &region)
 {
     if (hasShm()) {
         // to prevent X from reading from the image region while we're writing to it
         if (m_dirtyShm.intersects(region)) {
-            connection()->sync();
+            // The server processes requests in order, so once the last put has
+            // completed no part of the image is in use anymore.
+            if (!connection()->isShmPutCompleted(m_shm_info.shmseg, m_lastShmPutSequence))
+                connection()->sync();
             m_dirtyShm = QRegion();
         }
     } else {
@@ -587,6 +587,7 @@ QXcbConnection::QXcbConnection(QXcbNativeInterface *nativeInterface, bool canGra
     if (!has_randr_extension)
         initializeXinerama();
     initializeXFixes();
+    initializeShm();
     initializeScreens();
 
     initializeXRender();
@@ -1183,6 +1184,10 @@ void QXcbConnection::handleXcbEvent(xcb_generic_event_t *event)
             for (QXcbVirtualDesktop *virtualDesktop : qAsConst(m_virtualDesktops))
                 virtualDesktop->handleXFixesSelectionNotify(notify_event);
 
+            handled = true;
+        } else if (has_shm && response_type == shm_first_event + XCB_SHM_COMPLETION) {
+            xcb_shm_completion_event_t *completion = reinterpret_cast<xcb_shm_completion_event_t *>(event);
+            m_shmCompletions.insert(completion->shmseg, completion->sequence);
             handled = true;
         } else if (has_randr_extension && response_type == xrandr_first_event + XCB_RANDR_NOTIFY) {
             updateScreens(reinterpret_cast<xcb_randr_notify_event_t *>(event));
@@ -1644,81 +1649,75 @@ static inline bool isValid(xcb_generic_event_t *event)
        because it requires working with native event types.
     3) Or add public API to Qt for disabling event compression QTBUG-44964
 
+    The queue is walked once from the back, starting at index \a from, and every event
+    that is superseded by a later one of the same kind is dropped. This keeps the cost
+    linear in the number of queued events even when high frequency input devices fill
+    the queue with thousands of motion events.
 */
-bool QXcbConnection::compressEvent(xcb_generic_event_t *event, int currentIndex, QXcbEventArray *eventqueue) const
+void QXcbConnection::compressEvents(QXcbEventArray *eventqueue, int from)
 {
-    uint responseType = event->response_type & ~0x80;
-    int nextIndex = currentIndex + 1;
+    bool seenMotion = false;
+    QVarLengthArray<xcb_window_t, 8> seenConfigureWindows;
+#if QT_CONFIG(xinput2)
+    QVarLengthArray<uint16_t, 8> seenXIMotionDevices;
+#ifdef XCB_USE_XINPUT22
+    QVarLengthArray<uint32_t, 16> seenTouchIds;
+#endif
+#endif
 
-    if (responseType == XCB_MOTION_NOTIFY) {
-        // compress XCB_MOTION_NOTIFY notify events
-        for (int j = nextIndex; j < eventqueue->size(); ++j) {
-            xcb_generic_event_t *next = eventqueue->at(j);
-            if (!isValid(next))
-                continue;
-            if (next->response_type == XCB_MOTION_NOTIFY)
-                return true;
-        }
-        return false;
-    }
+    for (int i = eventqueue->size() - 1; i >= from; --i) {
+        xcb_generic_event_t *event = eventqueue->at(i);
+        if (!isValid(event))
+            continue;
+
+        bool superseded = false;
+        const uint responseType = event->response_type & ~0x80;
+        if (responseType == XCB_MOTION_NOTIFY) {
+            // compress XCB_MOTION_NOTIFY notify events
+            superseded = seenMotion;
+            seenMotion = true;
 #if QT_CONFIG(xinput2)
-    // compress XI_* events
-    if (responseType == XCB_GE_GENERIC) {
-        if (!hasXInput2())
-            return false;
+        } else if (responseType == XCB_GE_GENERIC) {
+            // compress XI_* events
+            if (!hasXInput2())
+                continue;
 
-        // compress XI_Motion, but not from tablet devices
-        if (isXIType(event, m_xiOpCode, XI_Motion)) {
+            if (isXIType(event, m_xiOpCode, XI_Motion)) {
+                // compress XI_Motion per source device, but not from tablet devices
+                xXIDeviceEvent *xdev = reinterpret_cast<xXIDeviceEvent *>(event);
 #if QT_CONFIG(tabletevent)
-            xXIDeviceEvent *xdev = reinterpret_cast<xXIDeviceEvent *>(event);
-            if (!QCoreApplication::testAttribute(Qt::AA_CompressTabletEvents) &&
-                    const_cast<QXcbConnection *>(this)->tabletDataForDevice(xdev->sourceid))
-                return false;
-#endif // QT_CONFIG(tabletevent)
-            for (int j = nextIndex; j < eventqueue->size(); ++j) {
-                xcb_generic_event_t *next = eventqueue->at(j);
-                if (!isValid(next))
+                if (!QCoreApplication::testAttribute(Qt::AA_CompressTabletEvents) &&
+                        tabletDataForDevice(xdev->sourceid))
                     continue;
-                if (isXIType(next, m_xiOpCode, XI_Motion))
-                    return true;
+#endif // QT_CONFIG(tabletevent)
+                superseded = seenXIMotionDevices.contains(xdev->sourceid);
+                if (!superseded)
+                    seenXIMotionDevices.append(xdev->sourceid);
             }
-            return false;
-        }
 #ifdef XCB_USE_XINPUT22
-        // compress XI_TouchUpdate for the same touch point id
-        if (isXIType(event, m_xiOpCode, XI_TouchUpdate)) {
-            xXIDeviceEvent *xiDeviceEvent = reinterpret_cast<xXIDeviceEvent *>(event);
-            uint32_t id = xiDeviceEvent->detail % INT_MAX;
-            for (int j = nextIndex; j < eventqueue->size(); ++j) {
-                xcb_generic_event_t *next = eventqueue->at(j);
-                if (!isValid(next))
-                    continue;
-                if (isXIType(next, m_xiOpCode, XI_TouchUpdate)) {
-                    xXIDeviceEvent *xiDeviceNextEvent = reinterpret_cast<xXIDeviceEvent *>(next);
-                    if (id == xiDeviceNextEvent->detail % INT_MAX)
-                        return true;
-                }
+            else if (isXIType(event, m_xiOpCode, XI_TouchUpdate)) {
+                // compress XI_TouchUpdate for the same touch point id
+                xXIDeviceEvent *xiDeviceEvent = reinterpret_cast<xXIDeviceEvent *>(event);
+                const uint32_t id = xiDeviceEvent->detail % INT_MAX;
+                superseded = seenTouchIds.contains(id);
+                if (!superseded)
+                    seenTouchIds.append(id);
             }
-            return false;
-        }
 #endif
-        return false;
-    }
 #endif
-    if (responseType == XCB_CONFIGURE_NOTIFY) {
-        // compress multiple configure notify events for the same window
-        for (int j = nextIndex; j < eventqueue->size(); ++j) {
-            xcb_generic_event_t *next = eventqueue->at(j);
-            if (isValid(next) && next->response_type == XCB_CONFIGURE_NOTIFY
-                && reinterpret_cast<xcb_configure_notify_event_t *>(next)->event == reinterpret_cast<xcb_configure_notify_event_t *>(event)->event)
-            {
-                return true;
-            }
+        } else if (responseType == XCB_CONFIGURE_NOTIFY) {
+            // compress multiple configure notify events for the same window
+            const xcb_window_t window = reinterpret_cast<xcb_configure_notify_event_t *>(event)->event;
+            superseded = seenConfigureWindows.contains(window);
+            if (!superseded)
+                seenConfigureWindows.append(window);
         }
-        return false;
-    }
 
-    return false;
+        if (superseded) {
+            free(event);
+            (*eventqueue)[i] = 0;
+        }
+    }
 }
 
 void QXcbConnection::processXcbEvents()
@@ -1731,7 +1730,16 @@ void QXcbConnection::processXcbEvents()
 
     QXcbEventArray *eventqueue = m_reader->lock();
 
+    const bool compress = QCoreApplication::testAttribute(Qt::AA_CompressHighFrequencyEvents);
+    int compressedSize = -1;
+
     for (int i = 0; i < eventqueue->size(); ++i) {
+        // The reader thread may have appended events while the queue was unlocked
+        if (Q_LIKELY(compress) && compressedSize != eventqueue->size()) {
+            compressEvents(eventqueue, i);
+            compressedSize = eventqueue->size();
+        }
+
         xcb_generic_event_t *event = eventqueue->at(i);
         if (!event)
             continue;
@@ -1743,10 +1751,6 @@ void QXcbConnection::processXcbEvents()
             continue;
         }
 
-        if (Q_LIKELY(QCoreApplication::testAttribute(Qt::AA_CompressHighFrequencyEvents)) &&
-                compressEvent(event, i, eventqueue))
-            continue;
-
 #ifndef QT_NO_CLIPBOARD
         bool accepted = false;
         if (clipboard()->processIncr())
@@ -2097,6 +2101,53 @@ void QXcbConnection::initializeXFixes()
     has_xfixes = true;
 }
 
+void QXcbConnection::initializeShm()
+{
+    const xcb_query_extension_reply_t *reply = xcb_get_extension_data(m_connection, &xcb_shm_id);
+    if (!reply || !reply->present)
+        return;
+
+    shm_first_event = reply->first_event;
+    has_shm = true;
+}
+
+namespace
+{
+    class ShmCompletionEvent {
+    public:
+        ShmCompletionEvent(uint32_t type, xcb_shm_seg_t seg) : type(type), shmseg(seg) {}
+        uint32_t type;
+        xcb_shm_seg_t shmseg;
+        bool checkEvent(xcb_generic_event_t *event) const {
+            if (!event || (event->response_type & ~0x80) != type)
+                return false;
+            return reinterpret_cast<xcb_shm_completion_event_t *>(event)->shmseg == shmseg;
+        }
+    };
+}
+
+/*!
+    Returns \c true if the server has reported completion of the MIT-SHM put
+    request with the given \a sequence number on segment \a shmseg.
+
+    Completion events still waiting in the event queue are taken into account,
+    so this does not need a round trip to the server.
+*/
+bool QXcbConnection::isShmPutCompleted(xcb_shm_seg_t shmseg, uint sequence)
+{
+    if (!has_shm)
+        return false;
+
+    ShmCompletionEvent checker(shm_first_event + XCB_SHM_COMPLETION, shmseg);
+    while (xcb_generic_event_t *event = checkEvent(checker)) {
+        m_shmCompletions.insert(shmseg, reinterpret_cast<xcb_shm_completion_event_t *>(event)->sequence);
+        free(event);
+    }
+
+    const auto it = m_shmCompletions.constFind(shmseg);
+    return it != m_shmCompletions.constEnd() && it.value() == quint16(sequence);
+}
+
 void QXcbConnection::initializeXRender()
 {
 #if QT_CONFIG(xcb_render)
@@ -42,6 +42,7 @@
 
 #include <xcb/xcb.h>
 #include <xcb/randr.h>
+#include <xcb/shm.h>
 
 #include <QtGui/private/qtguiglobal_p.h>
 #include "qxcbexport.h"
@@ -468,6 +469,10 @@ public:
     bool hasInputShape() const { return has_input_shape; }
     bool hasXKB() const { return has_xkb; }
     bool hasXRender() const { return has_render_extension; }
+    bool hasShm() const { return has_shm; }
+
+    bool isShmPutCompleted(xcb_shm_seg_t shmseg, uint sequence);
+    void forgetShmSegment(xcb_shm_seg_t shmseg) { m_shmCompletions.remove(shmseg); }
     bool hasXInput2() const { return m_xi2Enabled; }
 
     bool threadedEventHandling() const { return m_reader->isRunning(); }
@@ -536,6 +541,7 @@ private:
     void initializeAllAtoms();
     void sendConnectionEvent(QXcbAtom::Atom atom, uint id = 0);
     void initializeXFixes();
+    void initializeShm();
     void initializeXRender();
     void initializeXRandr();
     void initializeXinerama();
@@ -553,7 +559,7 @@ private:
                              xcb_randr_get_output_info_reply_t *outputInfo);
     void destroyScreen(QXcbScreen *screen);
     void initializeScreens();
-    bool compressEvent(xcb_generic_event_t *event, int currentIndex, QXcbEventArray *eventqueue) const;
+    void compressEvents(QXcbEventArray *eventqueue, int from);
 
     bool m_xi2Enabled = false;
 #if QT_CONFIG(xinput2)
@@ -677,12 +683,16 @@ private:
     WindowMapper m_mapper;
 
     QVector<PeekFunc> m_peekFuncs;
+    // Sequence number (low 16 bits) of the last completed MIT-SHM put per segment
+    QHash<xcb_shm_seg_t, quint16> m_shmCompletions;
 
     uint32_t xfixes_first_event = 0;
     uint32_t xrandr_first_event = 0;
     uint32_t xkb_first_event = 0;
+    uint32_t shm_first_event = 0;
 
     bool has_xfixes = false;
+    bool has_shm = false;
     bool has_xinerama_extension = false;
     bool has_shape_extension = false;
     bool has_randr_extension = false;
@@ -59,6 +59,11 @@
 
 #include <stdlib.h>
 #include <math.h>
+
+// single row mode, used to stream forward-only results, needs libpq 9.2
+#if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 90200
+#  define QT_PSQL_SINGLE_ROW_MODE
+#endif
 // below code taken from an example at http://www.gnu.org/software/hello/manual/autoconf/Function-Portability.html
 #ifndef isnan
     # define isnan(x) \
@@ -152,19 +157,25 @@ protected:
     QVariant lastInsertId() const Q_DECL_OVERRIDE;
     bool prepare(const QString &query) Q_DECL_OVERRIDE;
     bool exec() Q_DECL_OVERRIDE;
+    bool execBatch(bool arrayBind = false) Q_DECL_OVERRIDE;
 };
 
 class QPSQLDriverPrivate : public QSqlDriverPrivate
 {
     Q_DECLARE_PUBLIC(QPSQLDriver)
 public:
+    typedef int StatementId;
+    enum { InvalidStatementId = 0 };
+
     QPSQLDriverPrivate() : QSqlDriverPrivate(),
         connection(0),
         isUtf8(false),
         pro(QPSQLDriver::Version6),
         sn(0),
         pendingNotifyCheck(false),
-        hasBackslashEscape(false)
+        hasBackslashEscape(false),
+        stmtCount(0),
+        currentStmtId(InvalidStatementId)
     { dbmsType = QSqlDriver::PostgreSQL; }
 
     PGconn *connection;
@@ -174,10 +185,20 @@ public:
     QStringList seid;
     mutable bool pendingNotifyCheck;
     bool hasBackslashEscape;
+    mutable int stmtCount;
+    // the query sent with sendQuery() whose results are still being read
+    mutable StatementId currentStmtId;
 
     void appendTables(QStringList &tl, QSqlQuery &t, QChar type);
     PGresult * exec(const char * stmt) const;
     PGresult * exec(const QString & stmt) const;
+    StatementId sendQuery(const QString &stmt) const;
+    bool setSingleRowMode() const;
+    PGresult *getResult(StatementId stmtId) const;
+    void finishQuery(StatementId stmtId) const;
+    void discardResults() const;
+    StatementId generateStatementId() const;
+    void checkPendingNotifications() const;
     QPSQLDriver::Protocol getPSQLVersion();
     bool setEncodingUtf8();
     void setDatestyle();
@@ -209,14 +230,21 @@ void QPSQLDriverPrivate::appendTables(QStringList &tl, QSqlQuery &t, QChar type)
     }
 }
 
-PGresult * QPSQLDriverPrivate::exec(const char * stmt) const
+void QPSQLDriverPrivate::checkPendingNotifications() const
 {
     Q_Q(const QPSQLDriver);
-    PGresult *result = PQexec(connection, stmt);
     if (seid.size() && !pendingNotifyCheck) {
         pendingNotifyCheck = true;
         QMetaObject::invokeMethod(const_cast<QPSQLDriver*>(q), "_q_handleNotification", Qt::QueuedConnection, Q_ARG(int,0));
     }
+}
+
+PGresult * QPSQLDriverPrivate::exec(const char * stmt) const
+{
+    // PQexec() discards whatever is left of a query sent with sendQuery()
+    PGresult *result = PQexec(connection, stmt);
+    currentStmtId = InvalidStatementId;
+    checkPendingNotifications();
     return result;
 }
 
@@ -225,6 +253,58 @@ PGresult * QPSQLDriverPrivate::exec(const QString & stmt) const
     return exec(isUtf8 ? stmt.toUtf8().constData() : stmt.toLocal8Bit().constData());
 }
 
+QPSQLDriverPrivate::StatementId QPSQLDriverPrivate::sendQuery(const QString &stmt) const
+{
+    // only one query can be in progress on a connection
+    discardResults();
+    const QByteArray query = isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit();
+    currentStmtId = PQsendQuery(connection, query.constData()) ? generateStatementId()
+                                                                : StatementId(InvalidStatementId);
+    return currentStmtId;
+}
+
+bool QPSQLDriverPrivate::setSingleRowMode() const
+{
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+    return PQsetSingleRowMode(connection) > 0;
+#else
+    return false;
+#endif
+}
+
+PGresult *QPSQLDriverPrivate::getResult(StatementId stmtId) const
+{
+    if (stmtId != currentStmtId) {
+        qWarning("QPSQLDriver::getResult: Query results lost - probably discarded on executing "
+                 "another SQL query.");
+        return 0;
+    }
+    PGresult *result = PQgetResult(connection);
+    checkPendingNotifications();
+    return result;
+}
+
+void QPSQLDriverPrivate::finishQuery(StatementId stmtId) const
+{
+    if (stmtId != InvalidStatementId && stmtId == currentStmtId) {
+        discardResults();
+        currentStmtId = InvalidStatementId;
+    }
+}
+
+void QPSQLDriverPrivate::discardResults() const
+{
+    while (PGresult *result = PQgetResult(connection))
+        PQclear(result);
+}
+
+QPSQLDriverPrivate::StatementId QPSQLDriverPrivate::generateStatementId() const
+{
+    if (++stmtCount <= 0)
+        stmtCount = 1;
+    return stmtCount;
+}
+
 class QPSQLResultPrivate : public QSqlResultPrivate
 {
     Q_DECLARE_PUBLIC(QPSQLResult)
@@ -233,18 +313,26 @@ public:
     QPSQLResultPrivate(QPSQLResult *q, const QPSQLDriver *drv)
       : QSqlResultPrivate(q, drv),
         result(0),
+        stmtId(QPSQLDriverPrivate::InvalidStatementId),
         currentSize(-1),
-        preparedQueriesEnabled(false)
+        preparedQueriesEnabled(false),
+        singleRowMode(false)
     { }
 
     QString fieldSerial(int i) const Q_DECL_OVERRIDE { return QLatin1Char('$') + QString::number(i + 1); }
     void deallocatePreparedStmt();
 
     PGresult *result;
+    // set while more rows of a forward-only query can be read
+    QPSQLDriverPrivate::StatementId stmtId;
     int currentSize;
     bool preparedQueriesEnabled;
+    // result holds only the current row of a forward-only query
+    bool singleRowMode;
     QString preparedStmtId;
 
+    bool execute(const QString &stmt);
+    bool fetchNextRow();
     bool processResults();
 };
 
@@ -278,12 +366,74 @@ bool QPSQLResultPrivate::processResults()
         q->setActive(true);
         currentSize = -1;
         return true;
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+    } else if (status == PGRES_SINGLE_TUPLE) {
+        q->setSelect(true);
+        q->setActive(true);
+        currentSize = -1;
+        singleRowMode = true;
+        return true;
+#endif
     }
     q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
                     "Unable to create query"), QSqlError::StatementError, drv_d_func(), result));
     return false;
 }
 
+/*
+    Forward-only queries are sent in single row mode, so that the rows are
+    read from the server one at a time instead of all being held in memory.
+*/
+bool QPSQLResultPrivate::execute(const QString &stmt)
+{
+    Q_Q(QPSQLResult);
+    if (!q->isForwardOnly()) {
+        result = drv_d_func()->exec(stmt);
+        return processResults();
+    }
+
+    stmtId = drv_d_func()->sendQuery(stmt);
+    if (stmtId == QPSQLDriverPrivate::InvalidStatementId) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to send query"), QSqlError::StatementError, drv_d_func()));
+        return false;
+    }
+    drv_d_func()->setSingleRowMode();
+    result = drv_d_func()->getResult(stmtId);
+    const bool ok = processResults();
+    if (!singleRowMode) {
+        drv_d_func()->finishQuery(stmtId);
+        stmtId = QPSQLDriverPrivate::InvalidStatementId;
+    }
+    return ok;
+}
+
+bool QPSQLResultPrivate::fetchNextRow()
+{
+    Q_Q(QPSQLResult);
+    if (stmtId == QPSQLDriverPrivate::InvalidStatementId)
+        return false;
+
+    PGresult *next = drv_d_func()->getResult(stmtId);
+    const int status = next ? PQresultStatus(next) : int(PGRES_FATAL_ERROR);
+#ifdef QT_PSQL_SINGLE_ROW_MODE
+    if (status == PGRES_SINGLE_TUPLE) {
+        PQclear(result);
+        result = next;
+        return true;
+    }
+#endif
+    // PGRES_TUPLES_OK ends the result set; keep the last row readable
+    if (status != PGRES_TUPLES_OK) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to get result"), QSqlError::StatementError, drv_d_func(), next));
+    }
+    PQclear(next);
+    drv_d_func()->finishQuery(stmtId);
+    stmtId = QPSQLDriverPrivate::InvalidStatementId;
+    return false;
+}
+
 static QVariant::Type qDecodePSQLType(int t)
 {
     QVariant::Type type = QVariant::Invalid;
@@ -369,6 +519,9 @@ void QPSQLResult::cleanup()
     if (d->result)
         PQclear(d->result);
     d->result = 0;
+    d->drv_d_func()->finishQuery(d->stmtId);
+    d->stmtId = QPSQLDriverPrivate::InvalidStatementId;
+    d->singleRowMode = false;
     setAt(QSql::BeforeFirstRow);
     d->currentSize = -1;
     setActive(false);
@@ -376,15 +529,24 @@ void QPSQLResult::cleanup()
 
 bool QPSQLResult::fetch(int i)
 {
-    Q_D(const QPSQLResult);
+    Q_D(QPSQLResult);
     if (!isActive())
         return false;
     if (i < 0)
         return false;
-    if (i >= d->currentSize)
-        return false;
     if (at() == i)
         return true;
+    if (d->singleRowMode) {
+        // only the next row can be read, the first one came with the query
+        if (i != at() + 1)
+            return false;
+        if (at() != QSql::BeforeFirstRow && !d->fetchNextRow())
+            return false;
+        setAt(i);
+        return true;
+    }
+    if (i >= d->currentSize)
+        return false;
     setAt(i);
     return true;
 }
@@ -397,6 +559,12 @@ bool QPSQLResult::fetchFirst()
 bool QPSQLResult::fetchLast()
 {
     Q_D(const QPSQLResult);
+    if (d->singleRowMode) {
+        if (at() < 0 && !fetch(0))
+            return false;
+        while (fetch(at() + 1)) {}
+        return true;
+    }
     return fetch(PQntuples(d->result) - 1);
 }
 
@@ -409,8 +577,9 @@ QVariant QPSQLResult::data(int i)
     }
     int ptype = PQftype(d->result, i);
     QVariant::Type type = qDecodePSQLType(ptype);
-    const char *val = PQgetvalue(d->result, at(), i);
-    if (PQgetisnull(d->result, at(), i))
+    const int row = d->singleRowMode ? 0 : at();
+    const char *val = PQgetvalue(d->result, row, i);
+    if (PQgetisnull(d->result, row, i))
         return QVariant(type);
     switch (type) {
     case QVariant::Bool:
@@ -495,8 +664,9 @@ QVariant QPSQLResult::data(int i)
 bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
-    PQgetvalue(d->result, at(), field);
-    return PQgetisnull(d->result, at(), field);
+    const int row = d->singleRowMode ? 0 : at();
+    PQgetvalue(d->result, row, field);
+    return PQgetisnull(d->result, row, field);
 }
 
 bool QPSQLResult::reset (const QString& query)
@@ -507,8 +677,7 @@ bool QPSQLResult::reset (const QString& query)
         return false;
     if (!driver()->isOpen() || driver()->isOpenError())
         return false;
-    d->result = d->drv_d_func()->exec(query);
-    return d->processResults();
+    return d->execute(query);
 }
 
 int QPSQLResult::size()
@@ -675,9 +844,45 @@ bool QPSQLResult::exec()
     else
         stmt = QString::fromLatin1("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
 
-    d->result = d->drv_d_func()->exec(stmt);
+    return d->execute(stmt);
+}
 
-    return d->processResults();
+/*
+    Sends the rows as EXECUTE statements, many at a time, so that the server
+    runs each group in a single round trip (and, outside of a transaction,
+    in a single implicit transaction).
+*/
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QPSQLResult);
+    const QVector<QVariant> values = boundValues();
+    if (!d->preparedQueriesEnabled || values.isEmpty())
+        return QSqlResult::execBatch(arrayBind);
+
+    QVector<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+    const int rows = columns.at(0).count();
+
+    enum { MaxBatchLength = 1024 * 1024 };
+    const QString execute = QString::fromLatin1("EXECUTE %1 (").arg(d->preparedStmtId);
+    QVector<QVariant> row(columns.count());
+    QString stmt;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < columns.count(); ++j)
+            row[j] = columns.at(j).at(i);
+        stmt += execute + qCreateParamString(row, driver()) + QLatin1String(");");
+
+        if (stmt.size() >= MaxBatchLength || i == rows - 1) {
+            cleanup();
+            d->result = d->drv_d_func()->exec(stmt);
+            if (!d->processResults())
+                return false;
+            stmt.clear();
+        }
+    }
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -39,6 +39,7 @@
 
 #include "qsql_sqlite_p.h"
 
+#include <qcache.h>
 #include <qcoreapplication.h>
 #include <qdatetime.h>
 #include <qvariant.h>
@@ -52,7 +53,6 @@
 #include <qvector.h>
 #include <qdebug.h>
 #ifndef QT_NO_REGULAREXPRESSION
-#include <qcache.h>
 #include <qregularexpression.h>
 #endif
 #include <QTimeZone>
@@ -130,6 +130,10 @@ protected:
     bool reset(const QString &query) Q_DECL_OVERRIDE;
     bool prepare(const QString &query) Q_DECL_OVERRIDE;
     bool exec() Q_DECL_OVERRIDE;
+    bool execBatch(bool arrayBind = false) Q_DECL_OVERRIDE;
+    QVariant data(int i) Q_DECL_OVERRIDE;
+    bool isNull(int i) Q_DECL_OVERRIDE;
+    bool fetchLast() Q_DECL_OVERRIDE;
     int size() Q_DECL_OVERRIDE;
     int numRowsAffected() Q_DECL_OVERRIDE;
     QVariant lastInsertId() const Q_DECL_OVERRIDE;
@@ -138,15 +142,29 @@ protected:
     void virtual_hook(int id, void *data) Q_DECL_OVERRIDE;
 };
 
+// a prepared statement that is not used by any result, kept for reuse
+struct QSQLiteCachedStatement
+{
+    explicit QSQLiteCachedStatement(sqlite3_stmt *stmt) : stmt(stmt) {}
+    ~QSQLiteCachedStatement() { sqlite3_finalize(stmt); }
+
+    sqlite3_stmt *stmt;
+
+private:
+    Q_DISABLE_COPY(QSQLiteCachedStatement)
+};
+
 class QSQLiteDriverPrivate : public QSqlDriverPrivate
 {
     Q_DECLARE_PUBLIC(QSQLiteDriver)
 
 public:
-    inline QSQLiteDriverPrivate() : QSqlDriverPrivate(), access(0) { dbmsType = QSqlDriver::SQLite; }
+    inline QSQLiteDriverPrivate() : QSqlDriverPrivate(), access(0), statementCache(0) { dbmsType = QSqlDriver::SQLite; }
     sqlite3 *access;
     QList <QSQLiteResult *> results;
     QStringList notificationid;
+    // prepared statements keyed by their SQL text
+    QCache<QString, QSQLiteCachedStatement> statementCache;
 };
 
 
@@ -162,11 +180,19 @@ public:
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
+    QVariant columnValue(int i) const;
+    void readTypedValue(TypedValue &value) const;
 
     sqlite3_stmt *stmt;
+    QString stmtQuery; // set if stmt goes to the statement cache when finalized
 
     bool skippedStatus; // the status of the fetchNext() that's skipped
     bool skipRow; // skip the next fetchNext()?
+    // Forward-only queries don't convert rows into the cache, the current
+    // row is read from the statement instead; set while it is positioned
+    // on that row.
+    bool rowOnStatement;
+    bool convertRows; // fill the cache even if forward-only
     QSqlRecord rInf;
     QVector<QVariant> firstRow;
 };
@@ -175,7 +201,9 @@ QSQLiteResultPrivate::QSQLiteResultPrivate(QSQLiteResult *q, const QSQLiteDriver
     : QSqlCachedResultPrivate(q, drv),
       stmt(0),
       skippedStatus(false),
-      skipRow(false)
+      skipRow(false),
+      rowOnStatement(false),
+      convertRows(false)
 {
 }
 
@@ -186,6 +214,7 @@ void QSQLiteResultPrivate::cleanup()
     rInf.clear();
     skippedStatus = false;
     skipRow = false;
+    rowOnStatement = false;
     q->setAt(QSql::BeforeFirstRow);
     q->setActive(false);
     q->cleanup();
@@ -196,8 +225,16 @@ void QSQLiteResultPrivate::finalize()
     if (!stmt)
         return;
 
-    sqlite3_finalize(stmt);
+    QSQLiteDriverPrivate *drv = const_cast<QSQLiteDriverPrivate *>(drv_d_func());
+    if (!stmtQuery.isEmpty() && drv && drv->access) {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        drv->statementCache.insert(stmtQuery, new QSQLiteCachedStatement(stmt));
+    } else {
+        sqlite3_finalize(stmt);
+    }
     stmt = 0;
+    stmtQuery.clear();
 }
 
 void QSQLiteResultPrivate::initColumns(bool emptyResultset)
@@ -260,15 +297,23 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
     int res;
     int i;
 
+    const bool lazy = q->isForwardOnly() && !convertRows;
     if (skipRow) {
         // already fetched
         Q_ASSERT(!initialFetch);
         skipRow = false;
-        for(int i=0;i<firstRow.count();i++)
-            values[i]=firstRow[i];
+        if (rowOnStatement && !lazy) {
+            for (i = 0; i < rInf.count(); ++i)
+                values[i] = columnValue(i);
+            rowOnStatement = false;
+        } else {
+            for(int i=0;i<firstRow.count();i++)
+                values[i]=firstRow[i];
+        }
         return skippedStatus;
     }
     skipRow = initialFetch;
+    rowOnStatement = false;
 
     if(initialFetch) {
         firstRow.clear();
@@ -291,41 +336,12 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
             initColumns(false);
         if (idx < 0 && !initialFetch)
             return true;
-        for (i = 0; i < rInf.count(); ++i) {
-            switch (sqlite3_column_type(stmt, i)) {
-            case SQLITE_BLOB:
-                values[i + idx] = QByteArray(static_cast<const char *>(
-                            sqlite3_column_blob(stmt, i)),
-                            sqlite3_column_bytes(stmt, i));
-                break;
-            case SQLITE_INTEGER:
-                values[i + idx] = sqlite3_column_int64(stmt, i);
-                break;
-            case SQLITE_FLOAT:
-                switch(q->numericalPrecisionPolicy()) {
-                    case QSql::LowPrecisionInt32:
-                        values[i + idx] = sqlite3_column_int(stmt, i);
-                        break;
-                    case QSql::LowPrecisionInt64:
-                        values[i + idx] = sqlite3_column_int64(stmt, i);
-                        break;
-                    case QSql::LowPrecisionDouble:
-                    case QSql::HighPrecision:
-                    default:
-                        values[i + idx] = sqlite3_column_double(stmt, i);
-                        break;
-                };
-                break;
-            case SQLITE_NULL:
-                values[i + idx] = QVariant(QVariant::String);
-                break;
-            default:
-                values[i + idx] = QString(reinterpret_cast<const QChar *>(
-                            sqlite3_column_text16(stmt, i)),
-                            sqlite3_column_bytes16(stmt, i) / sizeof(QChar));
-                break;
-            }
+        if (lazy) {
+            rowOnStatement = true;
+            return true;
         }
+        for (i = 0; i < rInf.count(); ++i)
+            values[i + idx] = columnValue(i);
         return true;
     case SQLITE_DONE:
         if (rInf.isEmpty())
@@ -356,6 +372,72 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
     return false;
 }
 
+QVariant QSQLiteResultPrivate::columnValue(int i) const
+{
+    switch (sqlite3_column_type(stmt, i)) {
+    case SQLITE_BLOB:
+        return QByteArray(static_cast<const char *>(
+                    sqlite3_column_blob(stmt, i)),
+                    sqlite3_column_bytes(stmt, i));
+    case SQLITE_INTEGER:
+        return sqlite3_column_int64(stmt, i);
+    case SQLITE_FLOAT:
+        switch(q_func()->numericalPrecisionPolicy()) {
+            case QSql::LowPrecisionInt32:
+                return sqlite3_column_int(stmt, i);
+            case QSql::LowPrecisionInt64:
+                return sqlite3_column_int64(stmt, i);
+            case QSql::LowPrecisionDouble:
+            case QSql::HighPrecision:
+            default:
+                return sqlite3_column_double(stmt, i);
+        };
+    case SQLITE_NULL:
+        return QVariant(QVariant::String);
+    default:
+        return QString(reinterpret_cast<const QChar *>(
+                    sqlite3_column_text16(stmt, i)),
+                    sqlite3_column_bytes16(stmt, i) / sizeof(QChar));
+    }
+    return QVariant();
+}
+
+void QSQLiteResultPrivate::readTypedValue(TypedValue &value) const
+{
+    if (value.column < 0 || value.column >= rInf.count())
+        return;
+
+    // only read values that need no conversion, since converting changes
+    // what sqlite3_column_type() reports for the column
+    const int type = sqlite3_column_type(stmt, value.column);
+    if (type == SQLITE_NULL) {
+        value.handled = true;
+        return;
+    }
+    switch (value.type) {
+    case QMetaType::LongLong:
+        if (type != SQLITE_INTEGER)
+            return;
+        value.int64 = sqlite3_column_int64(stmt, value.column);
+        break;
+    case QMetaType::Double:
+        if (type != SQLITE_FLOAT)
+            return;
+        value.real = sqlite3_column_double(stmt, value.column);
+        break;
+    case QMetaType::QString:
+        if (type != SQLITE_TEXT)
+            return;
+        value.string = QStringView(static_cast<const QChar *>(sqlite3_column_text16(stmt, value.column)),
+                                   sqlite3_column_bytes16(stmt, value.column) / sizeof(QChar));
+        break;
+    default:
+        return;
+    }
+    value.ok = true;
+    value.handled = true;
+}
+
 QSQLiteResult::QSQLiteResult(const QSQLiteDriver* db)
     : QSqlCachedResult(*new QSQLiteResultPrivate(this, db))
 {
@@ -373,9 +455,55 @@ QSQLiteResult::~QSQLiteResult()
 
 void QSQLiteResult::virtual_hook(int id, void *data)
 {
+    Q_D(QSQLiteResult);
+    if (id == QSqlResultPrivate::ReadTypedValueHook && d->rowOnStatement) {
+        d->readTypedValue(*static_cast<QSqlResultPrivate::TypedValue *>(data));
+        if (static_cast<QSqlResultPrivate::TypedValue *>(data)->handled)
+            return;
+    }
     QSqlCachedResult::virtual_hook(id, data);
 }
 
+QVariant QSQLiteResult::data(int i)
+{
+    Q_D(QSQLiteResult);
+    if (!d->rowOnStatement)
+        return QSqlCachedResult::data(i);
+    if (i < 0 || i >= d->rInf.count())
+        return QVariant();
+    return d->columnValue(i);
+}
+
+bool QSQLiteResult::isNull(int i)
+{
+    Q_D(QSQLiteResult);
+    if (!d->rowOnStatement)
+        return QSqlCachedResult::isNull(i);
+    if (i < 0 || i >= d->rInf.count())
+        return true;
+    return sqlite3_column_type(d->stmt, i) == SQLITE_NULL;
+}
+
+bool QSQLiteResult::fetchLast()
+{
+    Q_D(QSQLiteResult);
+    if (!isForwardOnly())
+        return QSqlCachedResult::fetchLast();
+
+    // the brute force walk leaves the statement past the last row, so it
+    // has to be kept in the cache; a row still to be skipped to is
+    // converted by fetchNext()
+    if (d->rowOnStatement && !d->skipRow) {
+        for (int i = 0; i < d->rInf.count(); ++i)
+            cache()[i] = d->columnValue(i);
+        d->rowOnStatement = false;
+    }
+    d->convertRows = true;
+    const bool ok = QSqlCachedResult::fetchLast();
+    d->convertRows = false;
+    return ok;
+}
+
 bool QSQLiteResult::reset(const QString &query)
 {
     if (!prepare(query))
@@ -393,6 +521,15 @@ bool QSQLiteResult::prepare(const QString &query)
 
     setSelect(false);
 
+    QSQLiteDriverPrivate *drv = const_cast<QSQLiteDriverPrivate *>(d->drv_d_func());
+    if (QSQLiteCachedStatement *cached = drv->statementCache.take(query)) {
+        d->stmt = cached->stmt;
+        cached->stmt = 0;
+        delete cached;
+        d->stmtQuery = query;
+        return true;
+    }
+
     const void *pzTail = NULL;
 
 #if (SQLITE_VERSION_NUMBER >= 3003011)
@@ -414,6 +551,8 @@ bool QSQLiteResult::prepare(const QString &query)
         d->finalize();
         return false;
     }
+    if (drv->statementCache.maxCost() > 0)
+        d->stmtQuery = query;
     return true;
 }
 
@@ -443,6 +582,61 @@ static QString timespecToString(const QDateTime &dateTime)
     }
 }
 
+// Binds \a value to the parameter at \a pos, returns the SQLite result code
+static int qBindValue(sqlite3_stmt *stmt, int pos, const QVariant &value)
+{
+    int res = SQLITE_OK;
+    if (value.isNull()) {
+        res = sqlite3_bind_null(stmt, pos);
+    } else {
+        switch (value.type()) {
+        case QVariant::ByteArray: {
+            const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
+            res = sqlite3_bind_blob(stmt, pos, ba->constData(),
+                                    ba->size(), SQLITE_STATIC);
+            break; }
+        case QVariant::Int:
+        case QVariant::Bool:
+            res = sqlite3_bind_int(stmt, pos, value.toInt());
+            break;
+        case QVariant::Double:
+            res = sqlite3_bind_double(stmt, pos, value.toDouble());
+            break;
+        case QVariant::UInt:
+        case QVariant::LongLong:
+            res = sqlite3_bind_int64(stmt, pos, value.toLongLong());
+            break;
+        case QVariant::DateTime: {
+            const QDateTime dateTime = value.toDateTime();
+            const QString str = dateTime.toString(QLatin1String("yyyy-MM-ddThh:mm:ss.zzz") + timespecToString(dateTime));
+            res = sqlite3_bind_text16(stmt, pos, str.utf16(),
+                                      str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+            break;
+        }
+        case QVariant::Time: {
+            const QTime time = value.toTime();
+            const QString str = time.toString(QStringViewLiteral("hh:mm:ss.zzz"));
+            res = sqlite3_bind_text16(stmt, pos, str.utf16(),
+                                      str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+            break;
+        }
+        case QVariant::String: {
+            // lifetime of string == lifetime of its qvariant
+            const QString *str = static_cast<const QString*>(value.constData());
+            res = sqlite3_bind_text16(stmt, pos, str->utf16(),
+                                      (str->size()) * sizeof(QChar), SQLITE_STATIC);
+            break; }
+        default: {
+            QString str = value.toString();
+            // SQLITE_TRANSIENT makes sure that sqlite buffers the data
+            res = sqlite3_bind_text16(stmt, pos, str.utf16(),
+                                      (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
+            break; }
+        }
+    }
+    return res;
+}
+
 bool QSQLiteResult::exec()
 {
     Q_D(QSQLiteResult);
@@ -450,6 +644,7 @@ bool QSQLiteResult::exec()
 
     d->skippedStatus = false;
     d->skipRow = false;
+    d->rowOnStatement = false;
     d->rInf.clear();
     clearValues();
     setLastError(QSqlError());
@@ -497,57 +692,7 @@ bool QSQLiteResult::exec()
 
     if (paramCountIsValid) {
         for (int i = 0; i < paramCount; ++i) {
-            res = SQLITE_OK;
-            const QVariant value = values.at(i);
-
-            if (value.isNull()) {
-                res = sqlite3_bind_null(d->stmt, i + 1);
-            } else {
-                switch (value.type()) {
-                case QVariant::ByteArray: {
-                    const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
-                    res = sqlite3_bind_blob(d->stmt, i + 1, ba->constData(),
-                                            ba->size(), SQLITE_STATIC);
-                    break; }
-                case QVariant::Int:
-                case QVariant::Bool:
-                    res = sqlite3_bind_int(d->stmt, i + 1, value.toInt());
-                    break;
-                case QVariant::Double:
-                    res = sqlite3_bind_double(d->stmt, i + 1, value.toDouble());
-                    break;
-                case QVariant::UInt:
-                case QVariant::LongLong:
-                    res = sqlite3_bind_int64(d->stmt, i + 1, value.toLongLong());
-                    break;
-                case QVariant::DateTime: {
-                    const QDateTime dateTime = value.toDateTime();
-                    const QString str = dateTime.toString(QLatin1String("yyyy-MM-ddThh:mm:ss.zzz") + timespecToString(dateTime));
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QVariant::Time: {
-                    const QTime time = value.toTime();
-                    const QString str = time.toString(QStringViewLiteral("hh:mm:ss.zzz"));
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QVariant::String: {
-                    // lifetime of string == lifetime of its qvariant
-                    const QString *str = static_cast<const QString*>(value.constData());
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str->utf16(),
-                                              (str->size()) * sizeof(QChar), SQLITE_STATIC);
-                    break; }
-                default: {
-                    QString str = value.toString();
-                    // SQLITE_TRANSIENT makes sure that sqlite buffers the data
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
-                    break; }
-                }
-            }
+            res = qBindValue(d->stmt, i + 1, values.at(i));
             if (res != SQLITE_OK) {
                 setLastError(qMakeError(d->drv_d_func()->access, QCoreApplication::translate("QSQLiteResult",
                              "Unable to bind parameters"), QSqlError::StatementError, res));
@@ -571,6 +716,96 @@ bool QSQLiteResult::exec()
     return true;
 }
 
+bool QSQLiteResult::execBatch(bool arrayBind)
+{
+    Q_D(QSQLiteResult);
+    const QVector<QVariant> values = boundValues();
+    // named placeholders used more than once need the generic path
+    if (values.isEmpty() || !d->stmt || sqlite3_bind_parameter_count(d->stmt) != values.count())
+        return QSqlCachedResult::execBatch(arrayBind);
+
+    QVector<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+    const int rows = columns.at(0).count();
+
+    d->skippedStatus = false;
+    d->skipRow = false;
+    d->rowOnStatement = false;
+    d->rInf.clear();
+    clearValues();
+    setLastError(QSqlError());
+    setSelect(false);
+    setActive(false);
+
+    for (const QVariantList &column : qAsConst(columns)) {
+        if (column.count() != rows) {
+            setLastError(QSqlError(QCoreApplication::translate("QSQLiteResult",
+                            "Parameter count mismatch"), QString(), QSqlError::StatementError));
+            return false;
+        }
+    }
+
+    // Unless the user opened a transaction, run all rows in a single one,
+    // so that SQLite does not commit (and sync the database) after each row.
+    sqlite3 *access = d->drv_d_func()->access;
+    const bool ownTransaction = sqlite3_get_autocommit(access);
+    int res = ownTransaction ? sqlite3_exec(access, "BEGIN", 0, 0, 0) : SQLITE_OK;
+    if (res != SQLITE_OK) {
+        setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                     "Unable to execute statement"), QSqlError::StatementError, res));
+        return false;
+    }
+
+    for (int row = 0; row < rows; ++row) {
+        res = sqlite3_reset(d->stmt);
+        if (res != SQLITE_OK) {
+            setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                         "Unable to reset statement"), QSqlError::StatementError, res));
+            break;
+        }
+        for (int i = 0; i < columns.count(); ++i) {
+            res = qBindValue(d->stmt, i + 1, columns.at(i).at(row));
+            if (res != SQLITE_OK) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to bind parameters"), QSqlError::StatementError, res));
+                break;
+            }
+        }
+        if (res != SQLITE_OK)
+            break;
+        res = sqlite3_step(d->stmt);
+        if (res != SQLITE_DONE && res != SQLITE_ROW) {
+            const int err = sqlite3_reset(d->stmt);
+            if (err != SQLITE_OK)
+                res = err;
+            setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                         "Unable to execute statement"), QSqlError::StatementError, res));
+            break;
+        }
+        res = SQLITE_OK;
+    }
+    sqlite3_reset(d->stmt);
+
+    if (ownTransaction) {
+        if (res == SQLITE_OK) {
+            res = sqlite3_exec(access, "COMMIT", 0, 0, 0);
+            if (res != SQLITE_OK) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to execute statement"), QSqlError::StatementError, res));
+            }
+        }
+        if (res != SQLITE_OK)
+            sqlite3_exec(access, "ROLLBACK", 0, 0, 0);
+    }
+
+    if (res != SQLITE_OK)
+        return false;
+    setActive(true);
+    return true;
+}
+
 bool QSQLiteResult::gotoNext(QSqlCachedResult::ValueCache& row, int idx)
 {
     Q_D(QSQLiteResult);
@@ -610,6 +845,7 @@ QSqlRecord QSQLiteResult::record() const
 void QSQLiteResult::detachFromResultSet()
 {
     Q_D(QSQLiteResult);
+    d->rowOnStatement = false;
     if (d->stmt)
         sqlite3_reset(d->stmt);
 }
@@ -710,6 +946,15 @@ bool QSQLiteDriver::hasFeature(DriverFeature f) const
    SQLite dbs have no user name, passwords, hosts or ports.
    just file names.
 */
+// returns the value of a "name=value" connect option
+static QStringRef qOptionValue(const QStringRef &option, QLatin1String name)
+{
+    const QStringRef value = option.mid(name.size()).trimmed();
+    if (!value.startsWith(QLatin1Char('=')))
+        return QStringRef();
+    return value.mid(1).trimmed();
+}
+
 bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, const QString &, int, const QString &conOpts)
 {
     Q_D(QSQLiteDriver);
@@ -718,6 +963,10 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
 
 
     int timeOut = 5000;
+    int statementCacheSize = 32;
+    const char *journalMode = nullptr;
+    qint64 mmapSize = -1;
+    int pageCacheSize = 0; // 0 keeps SQLite's default, negative values are in KiB
     bool sharedCache = false;
     bool openReadOnlyOption = false;
     bool openUriOption = false;
@@ -738,6 +987,28 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
                 if (ok)
                     timeOut = nt;
             }
+        } else if (option.startsWith(QLatin1String("QSQLITE_STATEMENT_CACHE_SIZE"))) {
+            bool ok;
+            const int size = qOptionValue(option, QLatin1String("QSQLITE_STATEMENT_CACHE_SIZE")).toInt(&ok);
+            if (ok)
+                statementCacheSize = qMax(size, 0);
+        } else if (option.startsWith(QLatin1String("QSQLITE_JOURNAL_MODE"))) {
+            static const char *const modes[] = { "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF" };
+            const QStringRef mode = qOptionValue(option, QLatin1String("QSQLITE_JOURNAL_MODE"));
+            for (const char *m : modes) {
+                if (mode.compare(QLatin1String(m), Qt::CaseInsensitive) == 0)
+                    journalMode = m;
+            }
+        } else if (option.startsWith(QLatin1String("QSQLITE_MMAP_SIZE"))) {
+            bool ok;
+            const qint64 size = qOptionValue(option, QLatin1String("QSQLITE_MMAP_SIZE")).toLongLong(&ok);
+            if (ok)
+                mmapSize = qMax(size, Q_INT64_C(0));
+        } else if (option.startsWith(QLatin1String("QSQLITE_CACHE_SIZE"))) {
+            bool ok;
+            const int size = qOptionValue(option, QLatin1String("QSQLITE_CACHE_SIZE")).toInt(&ok);
+            if (ok)
+                pageCacheSize = size;
         } else if (option == QLatin1String("QSQLITE_OPEN_READONLY")) {
             openReadOnlyOption = true;
         } else if (option == QLatin1String("QSQLITE_OPEN_URI")) {
@@ -772,8 +1043,23 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
 
     if (sqlite3_open_v2(db.toUtf8().constData(), &d->access, openMode, NULL) == SQLITE_OK) {
         sqlite3_busy_timeout(d->access, timeOut);
+        d->statementCache.setMaxCost(statementCacheSize);
         setOpen(true);
         setOpenError(false);
+
+        QByteArray pragmas;
+        if (journalMode)
+            pragmas += QByteArray("PRAGMA journal_mode=") + journalMode + ';';
+        if (mmapSize >= 0)
+            pragmas += "PRAGMA mmap_size=" + QByteArray::number(mmapSize) + ';';
+        if (pageCacheSize != 0)
+            pragmas += "PRAGMA cache_size=" + QByteArray::number(pageCacheSize) + ';';
+        if (!pragmas.isEmpty()) {
+            char *error = 0;
+            if (sqlite3_exec(d->access, pragmas.constData(), NULL, NULL, &error) != SQLITE_OK)
+                qWarning("QSQLiteDriver::open: Unable to apply connect options: %s", error);
+            sqlite3_free(error);
+        }
 #ifndef QT_NO_REGULAREXPRESSION
         if (defineRegexp) {
             auto cache = new QCache<QString, QRegularExpression>(regexpCacheSize);
@@ -801,6 +1087,8 @@ void QSQLiteDriver::close()
     if (isOpen()) {
         for (QSQLiteResult *result : qAsConst(d->results))
             result->d_func()->finalize();
+        d->statementCache.clear();
+        d->statementCache.setMaxCost(0);
 
         if (d->access && (d->notificationid.count() > 0)) {
             d->notificationid.clear();
@@ -972,10 +1260,15 @@ static void handle_sqlite_callback(void *qobj,int aoperation, char const *adbnam
 {
     Q_UNUSED(aoperation);
     Q_UNUSED(adbname);
-    QSQLiteDriver *driver = static_cast<QSQLiteDriver *>(qobj);
-    if (driver) {
-        QMetaObject::invokeMethod(driver, "handleNotification", Qt::QueuedConnection,
-                                  Q_ARG(QString, QString::fromUtf8(atablename)), Q_ARG(qint64, arowid));
+    QSQLiteDriverPrivate *d = static_cast<QSQLiteDriverPrivate *>(qobj);
+    if (!d)
+        return;
+    // the hook runs for every changed row, only queue notifications for the
+    // subscribed tables
+    const QString tableName = QString::fromUtf8(atablename);
+    if (d->notificationid.contains(tableName)) {
+        QMetaObject::invokeMethod(d->q_ptr, "handleNotification", Qt::QueuedConnection,
+                                  Q_ARG(QString, tableName), Q_ARG(qint64, arowid));
     }
 }
 
@@ -995,7 +1288,7 @@ bool QSQLiteDriver::subscribeToNotification(const QString &name)
     //sqlite supports only one notification callback, so only the first is registered
     d->notificationid << name;
     if (d->notificationid.count() == 1)
-        sqlite3_update_hook(d->access, &handle_sqlite_callback, reinterpret_cast<void *> (this));
+        sqlite3_update_hook(d->access, &handle_sqlite_callback, reinterpret_cast<void *> (d));
 
     return true;
 }
@@ -116,6 +116,35 @@ void QSqlCachedResultPrivate::revertLast()
     rowCacheEnd -= colCount;
 }
 
+void QSqlCachedResultPrivate::readTypedValue(TypedValue &value) const
+{
+    const int i = value.column;
+    const int index = forwardOnly ? i : idx * colCount + i;
+    if (i >= colCount || i < 0 || idx < 0 || index >= rowCacheEnd)
+        return;
+
+    const QVariant &v = cache.at(index);
+    switch (value.type) {
+    case QMetaType::LongLong:
+        value.int64 = v.toLongLong(&value.ok);
+        break;
+    case QMetaType::Double:
+        value.real = v.toDouble(&value.ok);
+        break;
+    case QMetaType::QString:
+        // only strings can be viewed without a conversion
+        if (v.type() != QVariant::String)
+            return;
+        value.string = *static_cast<const QString *>(v.constData());
+        value.ok = true;
+        break;
+    default:
+        return;
+    }
+    value.ok = value.ok && !v.isNull();
+    value.handled = true;
+}
+
 inline int QSqlCachedResultPrivate::cacheCount() const
 {
     Q_ASSERT(!forwardOnly);
@@ -293,7 +322,11 @@ QSqlCachedResult::ValueCache &QSqlCachedResult::cache()
 
 void QSqlCachedResult::virtual_hook(int id, void *data)
 {
-    QSqlResult::virtual_hook(id, data);
+    Q_D(const QSqlCachedResult);
+    if (id == QSqlCachedResultPrivate::ReadTypedValueHook)
+        d->readTypedValue(*static_cast<QSqlCachedResultPrivate::TypedValue *>(data));
+    else
+        QSqlResult::virtual_hook(id, data);
 }
 
 void QSqlCachedResult::detachFromResultSet()
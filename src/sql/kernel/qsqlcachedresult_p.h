@@ -108,6 +108,7 @@ public:
     void cleanup();
     int nextIndex();
     void revertLast();
+    void readTypedValue(TypedValue &value) const;
 
     QSqlCachedResult::ValueCache cache;
     int rowCacheEnd;
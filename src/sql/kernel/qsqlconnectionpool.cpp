@@ -0,0 +1,413 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsqlconnectionpool.h"
+
+#include "qsqldriver.h"
+#include "qsqlquery.h"
+#include "qatomic.h"
+#include "qcoreapplication.h"
+#include "qelapsedtimer.h"
+#include "qmutex.h"
+#include "qset.h"
+#include "qstringlist.h"
+#include "qthread.h"
+#include "qvector.h"
+#include "qwaitcondition.h"
+
+QT_BEGIN_NAMESPACE
+
+static QBasicAtomicInt qt_sql_pool_id = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+struct QSqlPooledConnection
+{
+    QString name;
+    QElapsedTimer idleTimer;
+};
+
+class QSqlConnectionPoolPrivate
+{
+public:
+    QSqlConnectionPoolPrivate()
+        : maxSize(0), maxIdleTime(60000), opening(0), counter(0)
+    {}
+
+    void takeExpired(QStringList *expired);
+    static QSqlDatabase checkOut(const QString &name);
+    static void removeConnections(const QStringList &names);
+
+    mutable QMutex mutex;
+    QWaitCondition released;
+    QString prefix;
+    QString templateName;
+    QString validationQuery;
+    QSqlError lastError;
+    // most recently released connection last
+    QVector<QSqlPooledConnection> idle;
+    QSet<QString> inUse;
+    int maxSize;
+    int maxIdleTime;
+    int opening; // connections being opened outside the lock
+    int counter;
+};
+
+// must be called with the mutex locked
+void QSqlConnectionPoolPrivate::takeExpired(QStringList *expired)
+{
+    if (maxIdleTime < 0)
+        return;
+    // idle is ordered by release time, so the expired ones are at the front
+    int count = 0;
+    while (count < idle.size() && idle.at(count).idleTimer.hasExpired(maxIdleTime))
+        expired->append(idle.at(count++).name);
+    idle.remove(0, count);
+}
+
+QSqlDatabase QSqlConnectionPoolPrivate::checkOut(const QString &name)
+{
+    QSqlDatabase db = QSqlDatabase::database(name, false);
+    // released connections have no thread affinity, see release()
+    if (QSqlDriver *driver = db.driver())
+        driver->moveToThread(QThread::currentThread());
+    return db;
+}
+
+void QSqlConnectionPoolPrivate::removeConnections(const QStringList &names)
+{
+    for (const QString &name : names)
+        QSqlDatabase::removeDatabase(name);
+}
+
+/*!
+    \class QSqlConnectionPool
+    \brief The QSqlConnectionPool class keeps a set of open database
+    connections that can be shared between threads.
+
+    \ingroup database
+    \inmodule QtSql
+    \since 5.11
+    \threadsafe
+
+    Opening a database connection is expensive, and QSqlDatabase
+    connections may only be used from the thread that created them.
+    QSqlConnectionPool opens connections on demand from a prototype
+    connection, and hands them out to the calling thread with acquire().
+    When the thread is done with a connection, it gives it back with
+    release() and the connection can be reused by any thread.
+
+    \snippet code/src_sql_kernel_qsqlconnectionpool.cpp 0
+
+    The prototype is copied as with QSqlDatabase::cloneDatabase(), it
+    does not need to be open. The pool creates its connections under
+    generated connection names.
+
+    Connections that are idle for longer than maxIdleTime() are closed,
+    and the number of connections can be limited with setMaxSize(). Before
+    an idle connection is handed out, it is checked with the
+    validationQuery(), if one is set, and reopened if the check fails.
+
+    A connection must be released by the thread that acquired it, and
+    neither it nor any QSqlQuery created on it may be used afterwards.
+
+    \sa QSqlDatabase::cloneDatabase()
+*/
+
+/*!
+    Constructs a connection pool that opens copies of \a prototype.
+*/
+QSqlConnectionPool::QSqlConnectionPool(const QSqlDatabase &prototype)
+    : d(new QSqlConnectionPoolPrivate)
+{
+    d->prefix = QLatin1String("qt_sql_pool_") + QString::number(qt_sql_pool_id.fetchAndAddRelaxed(1))
+                + QLatin1Char('_');
+    d->templateName = d->prefix + QLatin1String("template");
+    QSqlDatabase::cloneDatabase(prototype, d->templateName);
+}
+
+/*!
+    Destroys the pool and removes all its connections. Connections that
+    are still acquired must not be used afterwards.
+*/
+QSqlConnectionPool::~QSqlConnectionPool()
+{
+    QStringList names;
+    for (const QSqlPooledConnection &connection : qAsConst(d->idle))
+        names.append(connection.name);
+    for (const QString &name : qAsConst(d->inUse)) {
+        qWarning("QSqlConnectionPool: connection '%s' is still in use", name.toLocal8Bit().constData());
+        names.append(name);
+    }
+    names.append(d->templateName);
+    QSqlConnectionPoolPrivate::removeConnections(names);
+}
+
+/*!
+    Returns an open connection for use in the calling thread.
+
+    An idle connection is reused if there is one, otherwise a new
+    connection is opened. If the pool already has maxSize() connections,
+    this function waits for up to \a msecs milliseconds for one to be
+    released; a negative value waits without a time limit.
+
+    Returns an invalid QSqlDatabase if no connection became available in
+    time or if a new connection could not be opened; lastError() then
+    describes the failure.
+
+    \sa release()
+*/
+QSqlDatabase QSqlConnectionPool::acquire(int msecs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QMutexLocker locker(&d->mutex);
+    forever {
+        QStringList expired;
+        d->takeExpired(&expired);
+
+        if (!d->idle.isEmpty()) {
+            const QString name = d->idle.takeLast().name;
+            d->inUse.insert(name);
+            const QString validationQuery = d->validationQuery;
+            locker.unlock();
+            QSqlConnectionPoolPrivate::removeConnections(expired);
+
+            QSqlDatabase db = QSqlConnectionPoolPrivate::checkOut(name);
+            bool valid = db.isOpen();
+            if (valid && !validationQuery.isEmpty())
+                valid = QSqlQuery(db).exec(validationQuery);
+            if (!valid) {
+                db.close();
+                valid = db.open();
+            }
+            if (valid)
+                return db;
+
+            const QSqlError error = db.lastError();
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(name);
+            locker.relock();
+            d->inUse.remove(name);
+            d->lastError = error;
+            d->released.wakeOne();
+            return QSqlDatabase();
+        }
+
+        if (d->maxSize <= 0 || d->inUse.size() + d->opening < d->maxSize) {
+            const QString name = d->prefix + QString::number(d->counter++);
+            ++d->opening;
+            locker.unlock();
+            QSqlConnectionPoolPrivate::removeConnections(expired);
+
+            QSqlDatabase db = QSqlDatabase::cloneDatabase(QSqlDatabase::database(d->templateName, false), name);
+            const bool opened = db.open();
+            const QSqlError error = db.lastError();
+            if (!opened) {
+                db = QSqlDatabase();
+                QSqlDatabase::removeDatabase(name);
+            }
+
+            locker.relock();
+            --d->opening;
+            if (!opened) {
+                d->lastError = error;
+                d->released.wakeOne();
+                return QSqlDatabase();
+            }
+            d->inUse.insert(name);
+            return db;
+        }
+
+        if (!expired.isEmpty()) {
+            locker.unlock();
+            QSqlConnectionPoolPrivate::removeConnections(expired);
+            locker.relock();
+            continue;
+        }
+
+        if (msecs < 0) {
+            d->released.wait(&d->mutex);
+        } else {
+            const qint64 remaining = msecs - timer.elapsed();
+            if (remaining <= 0 || !d->released.wait(&d->mutex, remaining)) {
+                d->lastError = QSqlError(QCoreApplication::translate("QSqlConnectionPool",
+                                            "Timed out waiting for a connection"),
+                                         QString(), QSqlError::ConnectionError);
+                return QSqlDatabase();
+            }
+        }
+    }
+}
+
+/*!
+    Returns the connection \a db, which was acquired by the calling
+    thread, to the pool.
+
+    \sa acquire()
+*/
+void QSqlConnectionPool::release(const QSqlDatabase &db)
+{
+    const QString name = db.connectionName();
+    QMutexLocker locker(&d->mutex);
+    if (!d->inUse.contains(name)) {
+        qWarning("QSqlConnectionPool::release: connection '%s' does not belong to this pool",
+                 name.toLocal8Bit().constData());
+        return;
+    }
+    // let the next thread that acquires the connection pull it over
+    if (QSqlDriver *driver = db.driver())
+        driver->moveToThread(nullptr);
+    d->inUse.remove(name);
+    QSqlPooledConnection connection;
+    connection.name = name;
+    connection.idleTimer.start();
+    d->idle.append(connection);
+
+    QStringList expired;
+    d->takeExpired(&expired);
+    d->released.wakeOne();
+    locker.unlock();
+    QSqlConnectionPoolPrivate::removeConnections(expired);
+}
+
+/*!
+    Sets the maximum number of connections the pool keeps, both acquired
+    and idle, to \a size. A value of 0 or less means no limit, which is
+    the default.
+
+    Lowering the limit does not close connections that are already open.
+*/
+void QSqlConnectionPool::setMaxSize(int size)
+{
+    QMutexLocker locker(&d->mutex);
+    d->maxSize = size;
+    d->released.wakeAll();
+}
+
+/*!
+    Returns the maximum number of connections of the pool.
+
+    \sa setMaxSize()
+*/
+int QSqlConnectionPool::maxSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maxSize;
+}
+
+/*!
+    Sets the time after which an idle connection is closed to \a msecs
+    milliseconds. A negative value keeps idle connections open until the
+    pool is destroyed. The default is 60 seconds.
+
+    Idle connections are closed when connections are acquired or
+    released.
+*/
+void QSqlConnectionPool::setMaxIdleTime(int msecs)
+{
+    QMutexLocker locker(&d->mutex);
+    d->maxIdleTime = msecs;
+}
+
+/*!
+    Returns the time in milliseconds after which an idle connection is
+    closed.
+
+    \sa setMaxIdleTime()
+*/
+int QSqlConnectionPool::maxIdleTime() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maxIdleTime;
+}
+
+/*!
+    Sets the statement that is executed on an idle connection before it
+    is handed out by acquire() to \a query, for example \c{SELECT 1}. If
+    the statement fails, the connection is reopened.
+
+    By default there is no validation query and only
+    QSqlDatabase::isOpen() is checked.
+*/
+void QSqlConnectionPool::setValidationQuery(const QString &query)
+{
+    QMutexLocker locker(&d->mutex);
+    d->validationQuery = query;
+}
+
+/*!
+    Returns the statement used to check idle connections.
+
+    \sa setValidationQuery()
+*/
+QString QSqlConnectionPool::validationQuery() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->validationQuery;
+}
+
+/*!
+    Returns the number of connections of the pool, both acquired and idle.
+*/
+int QSqlConnectionPool::size() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->inUse.size() + d->idle.size();
+}
+
+/*!
+    Returns the number of connections that are open but not acquired.
+*/
+int QSqlConnectionPool::idleCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->idle.size();
+}
+
+/*!
+    Returns the reason the last call to acquire() failed.
+*/
+QSqlError QSqlConnectionPool::lastError() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->lastError;
+}
+
+QT_END_NAMESPACE
@@ -1187,6 +1187,10 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li QSQLITE_OPEN_URI
     \li QSQLITE_ENABLE_SHARED_CACHE
     \li QSQLITE_ENABLE_REGEXP
+    \li QSQLITE_STATEMENT_CACHE_SIZE
+    \li QSQLITE_JOURNAL_MODE
+    \li QSQLITE_MMAP_SIZE
+    \li QSQLITE_CACHE_SIZE
     \endlist
 
     \li
@@ -49,6 +49,7 @@
 #include "qsqldriver.h"
 #include "qsqldatabase.h"
 #include "private/qsqlnulldriver_p.h"
+#include "private/qsqlresult_p.h"
 #include "qvector.h"
 #include "qmap.h"
 
@@ -61,6 +62,7 @@ public:
     ~QSqlQueryPrivate();
     QAtomicInt ref;
     QSqlResult* sqlResult;
+    QString stringValue; // backs valueStringView() for converted values
 
     static QSqlQueryPrivate* shared_null();
 };
@@ -450,6 +452,94 @@ QVariant QSqlQuery::value(const QString& name) const
     return QVariant();
 }
 
+/*!
+    \since 5.11
+
+    Returns the value of field \a index in the current record converted to
+    a 64-bit integer, or 0 if the value is NULL or cannot be converted.
+
+    If \a ok is not null, *\a{ok} is set to \c true if the value is not NULL
+    and could be converted, otherwise to \c false.
+
+    Unlike value(), this does not construct a QVariant when the driver can
+    read the value directly, which makes it cheaper to use in loops over
+    large result sets.
+
+    \sa value(), valueDouble(), valueStringView()
+*/
+qint64 QSqlQuery::valueInt64(int index, bool *ok) const
+{
+    QSqlResultPrivate::TypedValue value(index, QMetaType::LongLong);
+    if (isActive() && isValid() && (index > -1)) {
+        d->sqlResult->virtual_hook(QSqlResultPrivate::ReadTypedValueHook, &value);
+        if (!value.handled) {
+            const QVariant v = d->sqlResult->data(index);
+            value.int64 = v.toLongLong(&value.ok);
+            value.ok = value.ok && !v.isNull();
+        }
+    } else {
+        qWarning("QSqlQuery::valueInt64: not positioned on a valid record");
+    }
+    if (ok)
+        *ok = value.ok;
+    return value.ok ? value.int64 : 0;
+}
+
+/*!
+    \since 5.11
+
+    Returns the value of field \a index in the current record converted to
+    a double, or 0 if the value is NULL or cannot be converted.
+
+    If \a ok is not null, *\a{ok} is set to \c true if the value is not NULL
+    and could be converted, otherwise to \c false.
+
+    \sa value(), valueInt64(), valueStringView()
+*/
+double QSqlQuery::valueDouble(int index, bool *ok) const
+{
+    QSqlResultPrivate::TypedValue value(index, QMetaType::Double);
+    if (isActive() && isValid() && (index > -1)) {
+        d->sqlResult->virtual_hook(QSqlResultPrivate::ReadTypedValueHook, &value);
+        if (!value.handled) {
+            const QVariant v = d->sqlResult->data(index);
+            value.real = v.toDouble(&value.ok);
+            value.ok = value.ok && !v.isNull();
+        }
+    } else {
+        qWarning("QSqlQuery::valueDouble: not positioned on a valid record");
+    }
+    if (ok)
+        *ok = value.ok;
+    return value.ok ? value.real : 0;
+}
+
+/*!
+    \since 5.11
+
+    Returns a view of the text of field \a index in the current record, or
+    a null view if the value is NULL.
+
+    When the driver holds the text of the current row, the view refers to
+    it and no string is allocated. The view is only valid until the query
+    is moved to another record, or valueStringView() is called again.
+
+    \sa value(), valueInt64(), valueDouble()
+*/
+QStringView QSqlQuery::valueStringView(int index) const
+{
+    QSqlResultPrivate::TypedValue value(index, QMetaType::QString);
+    if (isActive() && isValid() && (index > -1)) {
+        d->sqlResult->virtual_hook(QSqlResultPrivate::ReadTypedValueHook, &value);
+        if (value.handled)
+            return value.ok ? value.string : QStringView();
+        d->stringValue = d->sqlResult->data(index).toString();
+        return d->stringValue;
+    }
+    qWarning("QSqlQuery::valueStringView: not positioned on a valid record");
+    return QStringView();
+}
+
 /*!
     Returns the current internal position of the query. The first
     record is at position zero. If the position is invalid, the
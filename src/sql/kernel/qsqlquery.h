@@ -84,6 +84,9 @@ public:
     bool exec(const QString& query);
     QVariant value(int i) const;
     QVariant value(const QString& name) const;
+    qint64 valueInt64(int i, bool *ok = nullptr) const;
+    double valueDouble(int i, bool *ok = nullptr) const;
+    QStringView valueStringView(int i) const;
 
     void setNumericalPrecisionPolicy(QSql::NumericalPrecisionPolicy precisionPolicy);
     QSql::NumericalPrecisionPolicy numericalPrecisionPolicy() const;
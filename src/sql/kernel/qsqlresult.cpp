@@ -950,12 +950,16 @@ bool QSqlResult::execBatch(bool arrayBind)
     Q_UNUSED(arrayBind);
     Q_D(QSqlResult);
 
-    QVector<QVariant> values = d->values;
+    const QVector<QVariant> values = d->values;
     if (values.count() == 0)
         return false;
-    for (int i = 0; i < values.at(0).toList().count(); ++i) {
-        for (int j = 0; j < values.count(); ++j)
-            bindValue(j, values.at(j).toList().at(i), QSql::In);
+    QVector<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+    for (int i = 0; i < columns.at(0).count(); ++i) {
+        for (int j = 0; j < columns.count(); ++j)
+            bindValue(j, columns.at(j).at(i), QSql::In);
         if (!exec())
             return false;
     }
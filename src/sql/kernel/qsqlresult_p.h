@@ -90,6 +90,24 @@ public:
     { }
     virtual ~QSqlResultPrivate() { }
 
+    // QSqlResult::virtual_hook() operation that reads a column of the
+    // current row without constructing a QVariant; results that don't
+    // support it leave the TypedValue unhandled.
+    enum { ReadTypedValueHook = 1 };
+    struct TypedValue
+    {
+        TypedValue(int column, int type)
+            : column(column), type(type), handled(false), ok(false), int64(0), real(0)
+        {}
+        int column;
+        int type; // QMetaType::LongLong, QMetaType::Double or QMetaType::QString
+        bool handled;
+        bool ok; // false if the value is NULL or could not be converted
+        qint64 int64;
+        double real;
+        QStringView string; // valid until the result moves to another row
+    };
+
     void clearValues()
     {
         values.clear();
@@ -46,8 +46,6 @@
 
 QT_BEGIN_NAMESPACE
 
-#define QSQL_PREFETCH 255
-
 void QSqlQueryModelPrivate::prefetch(int limit)
 {
     Q_Q(QSqlQueryModel);
@@ -192,7 +190,7 @@ void QSqlQueryModel::fetchMore(const QModelIndex &parent)
     Q_D(QSqlQueryModel);
     if (parent.isValid())
         return;
-    d->prefetch(qMax(d->bottom.row(), 0) + QSQL_PREFETCH);
+    d->prefetch(qMax(d->bottom.row(), 0) + d->fetchSize);
 }
 
 /*!
@@ -212,6 +210,37 @@ bool QSqlQueryModel::canFetchMore(const QModelIndex &parent) const
     return (!parent.isValid() && !d->atEnd);
 }
 
+/*!
+    \since 5.11
+
+    Sets the number of rows fetchMore() reads at a time to \a size. The
+    default is 255.
+
+    Larger values mean fewer round trips when a view scrolls through a
+    big result set, smaller ones keep the model responsive for queries
+    with expensive rows.
+
+    \sa fetchSize(), fetchMore()
+*/
+void QSqlQueryModel::setFetchSize(int size)
+{
+    Q_D(QSqlQueryModel);
+    d->fetchSize = qMax(size, 1);
+}
+
+/*!
+    \since 5.11
+
+    Returns the number of rows fetchMore() reads at a time.
+
+    \sa setFetchSize()
+*/
+int QSqlQueryModel::fetchSize() const
+{
+    Q_D(const QSqlQueryModel);
+    return d->fetchSize;
+}
+
 /*!
     \since 5.10
     \reimp
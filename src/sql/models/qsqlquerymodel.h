@@ -86,6 +86,9 @@ public:
     void fetchMore(const QModelIndex &parent = QModelIndex()) override;
     bool canFetchMore(const QModelIndex &parent = QModelIndex()) const override;
 
+    void setFetchSize(int size);
+    int fetchSize() const;
+
     QHash<int, QByteArray> roleNames() const override;
 
 protected:
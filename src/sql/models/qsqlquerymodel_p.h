@@ -66,7 +66,7 @@ class QSqlQueryModelPrivate: public QAbstractItemModelPrivate
 {
     Q_DECLARE_PUBLIC(QSqlQueryModel)
 public:
-    QSqlQueryModelPrivate() : atEnd(false), nestedResetLevel(0) {}
+    QSqlQueryModelPrivate() : atEnd(false), nestedResetLevel(0), fetchSize(255) {}
     ~QSqlQueryModelPrivate();
 
     void prefetch(int);
@@ -81,6 +81,7 @@ public:
     QVector<QHash<int, QVariant> > headers;
     QVarLengthArray<int, 56> colOffsets; // used to calculate indexInQuery of columns
     int nestedResetLevel;
+    int fetchSize;
 };
 
 // helpers for building SQL expressions
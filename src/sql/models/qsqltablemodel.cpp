@@ -729,7 +729,9 @@ bool QSqlTableModel::deleteRowFromTable(int row)
     obtained with lastError().
 
     In OnManualSubmit, on success the model will be repopulated.
-    Any views presenting it will lose their selections.
+    Any views presenting it will lose their selections. If
+    incrementalRefresh() is enabled, only the submitted rows are
+    refreshed with selectRow() instead, as with the other edit strategies.
 
     Note: In OnManualSubmit mode, already submitted changes won't
     be cleared from the cache when submitAll() fails. This allows
@@ -770,14 +772,15 @@ bool QSqlTableModel::submitAll()
             break;
         }
 
+        const bool refreshRow = d->strategy != OnManualSubmit || d->incrementalRefresh;
         if (success) {
-            if (d->strategy != OnManualSubmit && mrow.op() == QSqlTableModelPrivate::Insert) {
+            if (refreshRow && mrow.op() == QSqlTableModelPrivate::Insert) {
                 int c = mrow.rec().indexOf(d->autoColumn);
                 if (c != -1 && !mrow.rec().isGenerated(c))
                     mrow.setValue(c, d->editQuery.lastInsertId());
             }
             mrow.setSubmitted();
-            if (d->strategy != OnManualSubmit)
+            if (refreshRow)
                 success = selectRow(row);
         }
 
@@ -786,7 +789,7 @@ bool QSqlTableModel::submitAll()
     }
 
     if (success) {
-        if (d->strategy == OnManualSubmit)
+        if (d->strategy == OnManualSubmit && !d->incrementalRefresh)
             success = select();
     }
 
@@ -883,6 +886,43 @@ QSqlTableModel::EditStrategy QSqlTableModel::editStrategy() const
     return d->strategy;
 }
 
+/*!
+    \since 5.11
+
+    If \a enable is true, submitAll() in the OnManualSubmit strategy
+    refreshes only the rows it submitted, using selectRow(), instead of
+    calling select() and repopulating the whole model. This keeps large
+    models and the selections of their views intact after a batch of
+    edits.
+
+    As with the OnFieldChange and OnRowChange strategies, rows that were
+    deleted stay in the model as empty rows until the next select(), and
+    rows changed in the database by other means are not refreshed.
+
+    The default is \c false.
+
+    \sa incrementalRefresh(), submitAll(), selectRow()
+*/
+void QSqlTableModel::setIncrementalRefresh(bool enable)
+{
+    Q_D(QSqlTableModel);
+    d->incrementalRefresh = enable;
+}
+
+/*!
+    \since 5.11
+
+    Returns \c true if submitAll() refreshes only the submitted rows in
+    the OnManualSubmit strategy.
+
+    \sa setIncrementalRefresh()
+*/
+bool QSqlTableModel::incrementalRefresh() const
+{
+    Q_D(const QSqlTableModel);
+    return d->incrementalRefresh;
+}
+
 /*!
     Reverts all pending changes.
 
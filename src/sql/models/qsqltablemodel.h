@@ -83,6 +83,9 @@ public:
     virtual void setEditStrategy(EditStrategy strategy);
     EditStrategy editStrategy() const;
 
+    void setIncrementalRefresh(bool enable);
+    bool incrementalRefresh() const;
+
     QSqlIndex primaryKey() const;
     QSqlDatabase database() const;
     int fieldIndex(const QString &fieldName) const;
@@ -67,7 +67,8 @@ public:
         : sortColumn(-1),
           sortOrder(Qt::AscendingOrder),
           strategy(QSqlTableModel::OnRowChange),
-          busyInsertingRows(false)
+          busyInsertingRows(false),
+          incrementalRefresh(false)
     {}
     ~QSqlTableModelPrivate();
 
@@ -90,6 +91,7 @@ public:
 
     QSqlTableModel::EditStrategy strategy;
     bool busyInsertingRows;
+    bool incrementalRefresh;
 
     QSqlQuery editQuery;
     QSqlIndex primaryIndex;
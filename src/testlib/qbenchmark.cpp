@@ -42,7 +42,9 @@
 #include <QtTest/private/qbenchmarkmetric_p.h>
 #include <QtTest/private/qbenchmarktimemeasurers_p.h>
 
+#include <QtCore/qbytearraylist.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qset.h>
 #include <QtCore/qdebug.h>
 
@@ -58,6 +60,8 @@ QBenchmarkGlobalData::QBenchmarkGlobalData()
     , createChart(false)
     , verboseOutput(false)
     , minimumTotal(-1)
+    , warmupCount(-1)
+    , baselineThreshold(10)
     , mode_(WallTime)
 {
     setMode(mode_);
@@ -93,6 +97,10 @@ QBenchmarkMeasurerBase * QBenchmarkGlobalData::createMeasurer()
 #ifdef HAVE_TICK_COUNTER
     } else if (mode_ == TickCounter) {
         measurer = new QBenchmarkTickMeasurer;
+#endif
+#ifdef QTESTLIB_USE_ALLOCATION_COUNTER
+    } else if (mode_ == AllocationCounter) {
+        measurer = new QBenchmarkAllocationMeasurer;
 #endif
     } else if (mode_ == EventCounter) {
         measurer = new QBenchmarkEvent;
@@ -113,6 +121,59 @@ int QBenchmarkGlobalData::adjustMedianIterationCount()
 }
 
 
+int QBenchmarkGlobalData::warmupIterationCount()
+{
+    if (warmupCount != -1)
+        return warmupCount;
+    return measurer->needsWarmupIteration() ? 1 : 0;
+}
+
+QString QBenchmarkGlobalData::baselineKey(const char *function, const char *tag,
+                                          QTest::QBenchmarkMetric metric)
+{
+    return QString::fromLatin1("%1,%2,%3").arg(QString::fromUtf8(function), QString::fromUtf8(tag),
+                                               QLatin1String(QTest::benchmarkMetricName(metric)));
+}
+
+/*
+    Reads benchmark results written by the CSV logger (-o file,csv), whose lines are
+    "function","[globaltag:]tag","metric",value_per_iteration,total,iterations
+*/
+bool QBenchmarkGlobalData::loadBaseline(const char *fileName)
+{
+    QFile file(QFile::decodeName(fileName));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        QByteArrayList fields;
+        QByteArray field;
+        bool quoted = false;
+        for (char c : line) {
+            if (c == '"') {
+                quoted = !quoted;
+            } else if (c == ',' && !quoted) {
+                fields.append(field);
+                field.clear();
+            } else {
+                field += c;
+            }
+        }
+        fields.append(field);
+        if (fields.size() != 6)
+            continue;
+
+        bool ok;
+        const qreal value = fields.at(3).toDouble(&ok);
+        if (!ok)
+            continue;
+        const QString key = QString::fromUtf8(fields.at(0) + ',' + fields.at(1) + ',' + fields.at(2));
+        baseline.insert(key, value);
+    }
+    return true;
+}
+
 QBenchmarkTestMethodData *QBenchmarkTestMethodData::current;
 
 QBenchmarkTestMethodData::QBenchmarkTestMethodData()
@@ -176,6 +237,8 @@ void QBenchmarkTestMethodData::setResult(
 
     this->result = QBenchmarkResult(
         QBenchmarkGlobalData::current->context, value, iterationCount, metric, setByMacro);
+    if (setByMacro)
+        this->result.extraMeasurements = QBenchmarkGlobalData::current->measurer->extraMeasurements();
 }
 
 /*!
@@ -69,6 +69,8 @@ public:
     int i;
 };
 
+Q_TESTLIB_EXPORT void countBenchmarkAllocation(size_t size) Q_DECL_NOTHROW;
+
 }
 
 // --- BEGIN public API ---
@@ -86,6 +88,32 @@ namespace QTest
     void Q_TESTLIB_EXPORT setBenchmarkResult(qreal result, QBenchmarkMetric metric);
 }
 
+#if defined(Q_OS_LINUX) && defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#  define QTEST_COUNT_ALLOCATIONS \
+    extern "C" { \
+    void *__libc_malloc(size_t size); \
+    void *__libc_calloc(size_t count, size_t size); \
+    void *__libc_realloc(void *ptr, size_t size); \
+    void *malloc(size_t size) Q_DECL_NOTHROW \
+    { \
+        QT_PREPEND_NAMESPACE(QTest)::countBenchmarkAllocation(size); \
+        return __libc_malloc(size); \
+    } \
+    void *calloc(size_t count, size_t size) Q_DECL_NOTHROW \
+    { \
+        QT_PREPEND_NAMESPACE(QTest)::countBenchmarkAllocation(count * size); \
+        return __libc_calloc(count, size); \
+    } \
+    void *realloc(void *ptr, size_t size) Q_DECL_NOTHROW \
+    { \
+        QT_PREPEND_NAMESPACE(QTest)::countBenchmarkAllocation(size); \
+        return __libc_realloc(ptr, size); \
+    } \
+    }
+#else
+#  define QTEST_COUNT_ALLOCATIONS
+#endif
+
 // --- END public API ---
 
 QT_END_NAMESPACE
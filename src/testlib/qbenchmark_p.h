@@ -67,8 +67,16 @@
 #undef QTESTLIB_USE_PERF_EVENTS
 #endif
 
+// must match the condition for QTEST_COUNT_ALLOCATIONS in qbenchmark.h
+#if defined(Q_OS_LINUX) && defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#define QTESTLIB_USE_ALLOCATION_COUNTER
+#else
+#undef QTESTLIB_USE_ALLOCATION_COUNTER
+#endif
+
 #include <QtTest/private/qbenchmarkmeasurement_p.h>
 #include <QtCore/QMap>
+#include <QtCore/QHash>
 #include <QtTest/qtest_global.h>
 #ifdef QTESTLIB_USE_VALGRIND
 #include <QtTest/private/qbenchmarkvalgrind_p.h>
@@ -76,6 +84,9 @@
 #ifdef QTESTLIB_USE_PERF_EVENTS
 #include <QtTest/private/qbenchmarkperfevents_p.h>
 #endif
+#ifdef QTESTLIB_USE_ALLOCATION_COUNTER
+#include <QtTest/private/qbenchmarkallocations_p.h>
+#endif
 #include <QtTest/private/qbenchmarkevent_p.h>
 #include <QtTest/private/qbenchmarkmetric_p.h>
 
@@ -108,6 +119,7 @@ public:
     QTest::QBenchmarkMetric metric;
     bool setByMacro;
     bool valid;
+    QVector<QBenchmarkMeasurerBase::Measurement> extraMeasurements;
 
     QBenchmarkResult()
     : value(-1)
@@ -147,11 +159,16 @@ public:
 
     QBenchmarkGlobalData();
     ~QBenchmarkGlobalData();
-    enum Mode { WallTime, CallgrindParentProcess, CallgrindChildProcess, PerfCounter, TickCounter, EventCounter };
+    enum Mode { WallTime, CallgrindParentProcess, CallgrindChildProcess, PerfCounter, TickCounter, EventCounter,
+                AllocationCounter };
     void setMode(Mode mode);
     Mode mode() const { return mode_; }
     QBenchmarkMeasurerBase *createMeasurer();
     int adjustMedianIterationCount();
+    int warmupIterationCount();
+
+    bool loadBaseline(const char *fileName);
+    static QString baselineKey(const char *function, const char *tag, QTest::QBenchmarkMetric metric);
 
     QBenchmarkMeasurerBase *measurer;
     QBenchmarkContext context;
@@ -162,6 +179,9 @@ public:
     bool verboseOutput;
     QString callgrindOutFileBase;
     int minimumTotal;
+    int warmupCount;
+    double baselineThreshold; // in percent
+    QHash<QString, qreal> baseline; // value per iteration, keyed by baselineKey()
 private:
     Mode mode_;
 };
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtTest module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/private/qbenchmarkallocations_p.h>
+#include <QtTest/private/qbenchmark_p.h>
+
+#include <QtCore/qatomic.h>
+
+// Counting is switched on only between start() and stop(), so the
+// allocator replacements cost a single relaxed load the rest of the time.
+// All three are constant-initialized, as malloc() runs before any
+// static constructor.
+static QBasicAtomicInt countingEnabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+static QBasicAtomicInteger<qint64> allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+static QBasicAtomicInteger<qint64> allocatedBytes = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+QT_BEGIN_NAMESPACE
+
+/*! \internal
+    Called by the allocator replacements that QTEST_COUNT_ALLOCATIONS
+    installs in the test executable.
+*/
+void QTest::countBenchmarkAllocation(size_t size) Q_DECL_NOTHROW
+{
+    if (Q_UNLIKELY(countingEnabled.load())) {
+        allocationCount.fetchAndAddRelaxed(1);
+        allocatedBytes.fetchAndAddRelaxed(qint64(size));
+    }
+}
+
+#ifdef QTESTLIB_USE_ALLOCATION_COUNTER
+
+/*!
+    \class QBenchmarkAllocationMeasurer
+    \internal
+
+    Counts the heap allocations, and the number of bytes requested by them,
+    made by all threads while a benchmark runs. Reallocations are counted
+    as allocations of their new size.
+
+    The C library's allocator can only be replaced reliably from the
+    executable itself (the library's own symbols are versioned), so the
+    counting functions are installed by QTEST_COUNT_ALLOCATIONS.
+*/
+
+bool QBenchmarkAllocationMeasurer::isAvailable()
+{
+    // the test must have installed the allocator replacements, and
+    // another allocator (a preloaded library) must not take precedence
+    countingEnabled.store(1);
+    void * volatile p = malloc(1); // volatile, or the compiler drops the pair
+    countingEnabled.store(0);
+    free(p);
+    const bool available = allocationCount.load() > 0;
+    allocationCount.store(0);
+    allocatedBytes.store(0);
+    return available;
+}
+
+void QBenchmarkAllocationMeasurer::start()
+{
+    allocationCount.store(0);
+    allocatedBytes.store(0);
+    countingEnabled.storeRelease(1);
+}
+
+qint64 QBenchmarkAllocationMeasurer::checkpoint()
+{
+    return allocationCount.load();
+}
+
+qint64 QBenchmarkAllocationMeasurer::stop()
+{
+    countingEnabled.storeRelease(0);
+    return allocationCount.load();
+}
+
+bool QBenchmarkAllocationMeasurer::isMeasurementAccepted(qint64)
+{
+    // zero allocations is a perfectly good (and often the desired) result
+    return true;
+}
+
+int QBenchmarkAllocationMeasurer::adjustIterationCount(int suggestion)
+{
+    return suggestion;
+}
+
+int QBenchmarkAllocationMeasurer::adjustMedianCount(int)
+{
+    return 1;
+}
+
+QTest::QBenchmarkMetric QBenchmarkAllocationMeasurer::metricType()
+{
+    return QTest::Allocations;
+}
+
+QVector<QBenchmarkMeasurerBase::Measurement> QBenchmarkAllocationMeasurer::extraMeasurements()
+{
+    const Measurement bytes = { qreal(allocatedBytes.load()), QTest::BytesAllocated };
+    return QVector<Measurement>() << bytes;
+}
+
+#endif // QTESTLIB_USE_ALLOCATION_COUNTER
+
+QT_END_NAMESPACE
@@ -52,12 +52,19 @@
 //
 
 #include <QtTest/qbenchmark.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
 class QBenchmarkMeasurerBase
 {
 public:
+    struct Measurement
+    {
+        qreal value;
+        QTest::QBenchmarkMetric metric;
+    };
+
     virtual ~QBenchmarkMeasurerBase() {}
     virtual void init() {}
     virtual void start() = 0;
@@ -69,6 +76,8 @@ public:
     virtual bool repeatCount() { return 1; }
     virtual bool needsWarmupIteration() { return false; }
     virtual QTest::QBenchmarkMetric metricType() = 0;
+    // additional values taken during the last start()/stop() pair
+    virtual QVector<Measurement> extraMeasurements() { return QVector<Measurement>(); }
 };
 
 QT_END_NAMESPACE
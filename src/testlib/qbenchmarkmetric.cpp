@@ -82,6 +82,7 @@ static const QBenchmarkMetricKey entries[] = {
     { AlignmentFaults, "AlignmentFaults", "alignment faults" },
     { EmulationFaults, "EmulationFaults", "emulation faults" },
     { RefCPUCycles, "RefCPUCycles", "Reference CPU cycles" },
+    { Allocations, "Allocations", "allocations" },
 };
 static const int NumEntries = sizeof(entries) / sizeof(entries[0]);
 
@@ -99,6 +100,7 @@ static const int NumEntries = sizeof(entries) / sizeof(entries[0]);
   \value WalltimeMilliseconds   Clock time in milliseconds
   \value WalltimeNanoseconds    Clock time in nanoseconds
   \value BytesAllocated         Memory usage in bytes
+  \value Allocations            Heap allocations (since Qt 5.11)
   \value Events                 Event count
   \value CPUTicks               CPU time
   \value CPUMigrations          Process migrations between CPUs
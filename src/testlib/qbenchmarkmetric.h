@@ -80,6 +80,7 @@ enum QBenchmarkMetric {
     AlignmentFaults,
     EmulationFaults,
     RefCPUCycles,
+    Allocations,
 };
 
 }
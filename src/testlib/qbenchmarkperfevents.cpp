@@ -83,7 +83,11 @@
 
 QT_BEGIN_NAMESPACE
 
-static perf_event_attr attr;
+// the first entry is the group leader, whose value is the benchmark result;
+// the others are read in the same run and reported alongside it
+static perf_event_attr attrs[QBenchmarkPerfEventsMeasurer::MaxCounters];
+static int attrCount = 1;
+static perf_event_attr &attr = attrs[0];
 
 static void initPerf()
 {
@@ -427,44 +431,43 @@ QTest::QBenchmarkMetric QBenchmarkPerfEventsMeasurer::metricForEvent(quint32 typ
     return QTest::Events;
 }
 
-void QBenchmarkPerfEventsMeasurer::setCounter(const char *name)
+static void parseCounter(const char *name, int len, perf_event_attr *a)
 {
-    initPerf();
-    const char *colon = strchr(name, ':');
-    int n = colon ? colon - name : strlen(name);
+    const char *colon = static_cast<const char *>(memchr(name, ':', len));
+    int n = colon ? colon - name : len;
     const Events *ptr = eventlist;
     for ( ; ptr->type != PERF_TYPE_MAX; ++ptr) {
         int c = strncmp(name, eventlist_strings + ptr->offset, n);
         if (c == 0)
             break;
         if (c < 0) {
-            fprintf(stderr, "ERROR: Performance counter type '%s' is unknown\n", name);
+            fprintf(stderr, "ERROR: Performance counter type '%.*s' is unknown\n", len, name);
             exit(1);
         }
     }
 
-    attr.type = ptr->type;
-    attr.config = ptr->event_id;
+    a->type = ptr->type;
+    a->config = ptr->event_id;
 
     // now parse the attributes
     if (!colon)
         return;
-    while (*++colon) {
+    for (++colon; colon < name + len; ++colon) {
         switch (*colon) {
         case 'u':
-            attr.exclude_user = true;
+            a->exclude_user = true;
             break;
         case 'k':
-            attr.exclude_kernel = true;
+            a->exclude_kernel = true;
             break;
         case 'h':
-            attr.exclude_hv = true;
+            a->exclude_hv = true;
             break;
         case 'G':
-            attr.exclude_guest = true;
+            a->exclude_guest = true;
             break;
         case 'H':
-            attr.exclude_host = true;
+            a->exclude_host = true;
             break;
         default:
             fprintf(stderr, "ERROR: Unknown attribute '%c'\n", *colon);
@@ -473,6 +476,39 @@ void QBenchmarkPerfEventsMeasurer::setCounter(const char *name)
     }
 }
 
+void QBenchmarkPerfEventsMeasurer::setCounter(const char *name)
+{
+    initPerf();
+    const perf_event_attr defaults = attr;
+
+    // a comma-separated list opens a group of counters that are
+    // scheduled together and read in the same run
+    attrCount = 0;
+    for (;;) {
+        const char *comma = strchr(name, ',');
+        int len = comma ? comma - name : strlen(name);
+        if (attrCount == MaxCounters) {
+            fprintf(stderr, "ERROR: At most %d performance counters can be measured at once\n",
+                    int(MaxCounters));
+            exit(1);
+        }
+
+        perf_event_attr *a = &attrs[attrCount];
+        *a = defaults;
+        if (attrCount) {
+            // group members follow their leader
+            a->disabled = false;
+            a->pinned = false;
+        }
+        parseCounter(name, len, a);
+        ++attrCount;
+
+        if (!comma)
+            break;
+        name = comma + 1;
+    }
+}
+
 void QBenchmarkPerfEventsMeasurer::listCounters()
 {
     if (!isAvailable()) {
@@ -495,17 +531,23 @@ void QBenchmarkPerfEventsMeasurer::listCounters()
            "  h - exclude measuring in the hypervisor\n"
            "  G - exclude measuring when running virtualized (guest VM)\n"
            "  H - exclude measuring when running non-virtualized (host system)\n"
-           "Attributes can be combined, for example: -perfcounter branch-mispredicts:kh\n");
+           "Attributes can be combined, for example: -perfcounter branch-mispredicts:kh\n"
+           "\nSeveral counters can be measured in the same run by separating them with\n"
+           "commas, for example: -perfcounter cycles,instructions,branch-misses\n"
+           "The first counter is the benchmark result; the others are reported after it.\n");
 }
 
 QBenchmarkPerfEventsMeasurer::QBenchmarkPerfEventsMeasurer()
-    : fd(-1)
 {
+    for (int i = 0; i < MaxCounters; ++i)
+        fds[i] = -1;
 }
 
 QBenchmarkPerfEventsMeasurer::~QBenchmarkPerfEventsMeasurer()
 {
-    qt_safe_close(fd);
+    // close the members before the group leader
+    for (int i = MaxCounters - 1; i >= 0; --i)
+        qt_safe_close(fds[i]);
 }
 
 void QBenchmarkPerfEventsMeasurer::init()
@@ -516,38 +558,53 @@ void QBenchmarkPerfEventsMeasurer::start()
 {
 
     initPerf();
-    if (fd == -1) {
+    for (int i = 0; i < attrCount; ++i) {
+        if (fds[i] != -1)
+            continue;
+
         // pid == 0 -> attach to the current process
         // cpu == -1 -> monitor on all CPUs
         // group_fd == -1 -> this is the group leader
         // flags == 0 -> reserved, must be zero
-        fd = perf_event_open(&attr, 0, -1, -1, 0);
-        if (fd == -1) {
+        fds[i] = perf_event_open(&attrs[i], 0, -1, i ? fds[0] : -1, 0);
+        if (fds[i] == -1) {
             perror("QBenchmarkPerfEventsMeasurer::start: perf_event_open");
             exit(1);
         } else {
-            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+            ::fcntl(fds[i], F_SETFD, FD_CLOEXEC);
         }
     }
 
-    // enable the counter
-    ::ioctl(fd, PERF_EVENT_IOC_RESET);
-    ::ioctl(fd, PERF_EVENT_IOC_ENABLE);
+    // enable the counters
+    ::ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
 }
 
 qint64 QBenchmarkPerfEventsMeasurer::checkpoint()
 {
-    ::ioctl(fd, PERF_EVENT_IOC_DISABLE);
-    qint64 value = readValue();
-    ::ioctl(fd, PERF_EVENT_IOC_ENABLE);
+    ::ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    qint64 value = readValue(0);
+    ::ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
     return value;
 }
 
 qint64 QBenchmarkPerfEventsMeasurer::stop()
 {
-    // disable the counter
-    ::ioctl(fd, PERF_EVENT_IOC_DISABLE);
-    return readValue();
+    // disable the counters
+    ::ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    return readValue(0);
+}
+
+QVector<QBenchmarkMeasurerBase::Measurement> QBenchmarkPerfEventsMeasurer::extraMeasurements()
+{
+    // the group is disabled by stop(), so these match the leader's value
+    QVector<Measurement> result;
+    result.reserve(attrCount - 1);
+    for (int i = 1; i < attrCount; ++i) {
+        Measurement m = { qreal(readValue(i)), metricForEvent(attrs[i].type, attrs[i].config) };
+        result.append(m);
+    }
+    return result;
 }
 
 bool QBenchmarkPerfEventsMeasurer::isMeasurementAccepted(qint64)
@@ -605,10 +662,10 @@ static quint64 rawReadValue(int fd)
     return results.value * (double(results.time_running) / double(results.time_enabled));
 }
 
-qint64 QBenchmarkPerfEventsMeasurer::readValue()
+qint64 QBenchmarkPerfEventsMeasurer::readValue(int counter)
 {
-    quint64 raw = rawReadValue(fd);
-    if (metricType() == QTest::WalltimeMilliseconds) {
+    quint64 raw = rawReadValue(fds[counter]);
+    if (metricForEvent(attrs[counter].type, attrs[counter].config) == QTest::WalltimeMilliseconds) {
         // perf returns nanoseconds
         return raw / 1000000;
     }
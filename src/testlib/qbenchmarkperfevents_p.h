@@ -58,6 +58,8 @@ QT_BEGIN_NAMESPACE
 class QBenchmarkPerfEventsMeasurer : public QBenchmarkMeasurerBase
 {
 public:
+    enum { MaxCounters = 8 };
+
     QBenchmarkPerfEventsMeasurer();
     ~QBenchmarkPerfEventsMeasurer();
     virtual void init() Q_DECL_OVERRIDE;
@@ -70,15 +72,16 @@ public:
     virtual bool repeatCount() Q_DECL_OVERRIDE { return 1; }
     virtual bool needsWarmupIteration() Q_DECL_OVERRIDE { return true; }
     virtual QTest::QBenchmarkMetric metricType() Q_DECL_OVERRIDE;
+    virtual QVector<Measurement> extraMeasurements() Q_DECL_OVERRIDE;
 
     static bool isAvailable();
     static QTest::QBenchmarkMetric metricForEvent(quint32 type, quint64 event_id);
     static void setCounter(const char *name);
     static void listCounters();
 private:
-    int fd;
+    int fds[MaxCounters];
 
-    qint64 readValue();
+    qint64 readValue(int counter);
 };
 
 QT_END_NAMESPACE
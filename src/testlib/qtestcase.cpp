@@ -75,6 +75,7 @@
 #include <QtTest/private/qtestutil_macos_p.h>
 #endif
 
+#include <cmath>
 #include <numeric>
 #include <algorithm>
 
@@ -556,17 +557,26 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, char *argv[], bool qml)
 #endif
 #ifdef QTESTLIB_USE_PERF_EVENTS
          " -perf               : Use Linux perf events to time benchmarks\n"
-         " -perfcounter name   : Use the counter named 'name'\n"
+         " -perfcounter name   : Use the counter named 'name'; separate several\n"
+         "                       names with commas to measure them in the same run\n"
          " -perfcounterlist    : Lists the counters available\n"
 #endif
 #ifdef HAVE_TICK_COUNTER
          " -tickcounter        : Use CPU tick counters to time benchmarks\n"
 #endif
          " -eventcounter       : Counts events received during benchmarks\n"
+#ifdef QTESTLIB_USE_ALLOCATION_COUNTER
+         " -allocations        : Counts heap allocations and allocated bytes during benchmarks\n"
+#endif
          " -minimumvalue n     : Sets the minimum acceptable measurement value\n"
          " -minimumtotal n     : Sets the minimum acceptable total for repeated executions of a test function\n"
          " -iterations  n      : Sets the number of accumulation iterations.\n"
          " -median  n          : Sets the number of median iterations.\n"
+         " -warmup  n          : Sets the number of warmup iterations, whose results are discarded.\n"
+         " -baseline file      : Fails benchmarks that regress against the results in 'file',\n"
+         "                       as written with -o file,csv\n"
+         " -baselinethreshold n: Sets the tolerated regression against the baseline in percent,\n"
+         "                       default: 10\n"
          " -vb                 : Print out verbose benchmarking information.\n";
 
     for (int i = 1; i < argc; ++i) {
@@ -731,6 +741,15 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, char *argv[], bool qml)
 #endif
         } else if (strcmp(argv[i], "-eventcounter") == 0) {
             QBenchmarkGlobalData::current->setMode(QBenchmarkGlobalData::EventCounter);
+#ifdef QTESTLIB_USE_ALLOCATION_COUNTER
+        } else if (strcmp(argv[i], "-allocations") == 0) {
+            if (QBenchmarkAllocationMeasurer::isAvailable()) {
+                QBenchmarkGlobalData::current->setMode(QBenchmarkGlobalData::AllocationCounter);
+            } else {
+                fprintf(stderr, "WARNING: Heap allocations cannot be counted; the test must use "
+                                "QTEST_COUNT_ALLOCATIONS. Using the walltime measurer.\n");
+            }
+#endif
         } else if (strcmp(argv[i], "-minimumvalue") == 0) {
             if (i + 1 >= argc) {
                 fprintf(stderr, "-minimumvalue needs an extra parameter to indicate the minimum time(ms)\n");
@@ -760,6 +779,28 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, char *argv[], bool qml)
                 QBenchmarkGlobalData::current->medianIterationCount = qToInt(argv[++i]);
             }
 
+        } else if (strcmp(argv[i], "-warmup") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-warmup needs an extra parameter to indicate the number of warmup iterations\n");
+                exit(1);
+            } else {
+                QBenchmarkGlobalData::current->warmupCount = qToInt(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "-baseline") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-baseline needs an extra parameter with the name of the baseline file\n");
+                exit(1);
+            } else if (!QBenchmarkGlobalData::current->loadBaseline(argv[++i])) {
+                fprintf(stderr, "Could not read the baseline file '%s'\n", argv[i]);
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "-baselinethreshold") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-baselinethreshold needs an extra parameter to indicate the threshold in percent\n");
+                exit(1);
+            } else {
+                QBenchmarkGlobalData::current->baselineThreshold = qToInt(argv[++i]);
+            }
         } else if (strcmp(argv[i], "-vb") == 0) {
             QBenchmarkGlobalData::current->verboseOutput = true;
 #if defined(Q_OS_WINRT)
@@ -862,12 +903,140 @@ qreal addResult(qreal current, const QBenchmarkResult& r)
 
 }
 
+// Two-sided 95% quantiles of Student's t distribution for 1 to 30 degrees of freedom
+static const double tQuantiles95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static double quartile(const QVector<qreal> &sorted, double q)
+{
+    const double pos = q * (sorted.size() - 1);
+    const int lower = int(pos);
+    if (lower + 1 >= sorted.size())
+        return sorted.last();
+    return sorted.at(lower) + (pos - lower) * (sorted.at(lower + 1) - sorted.at(lower));
+}
+
+static void reportBenchmarkStatistics(const QVector<QBenchmarkResult> &results)
+{
+    if (results.size() < 2)
+        return;
+
+    QVector<qreal> values;
+    values.reserve(results.size());
+    for (const QBenchmarkResult &r : results)
+        values.append(r.value / r.iterations);
+    std::sort(values.begin(), values.end());
+
+    // reject outliers outside of Tukey's fences once there are enough samples
+    int outliers = 0;
+    if (values.size() >= 4) {
+        const qreal q1 = quartile(values, 0.25);
+        const qreal q3 = quartile(values, 0.75);
+        const qreal low = q1 - 1.5 * (q3 - q1);
+        const qreal high = q3 + 1.5 * (q3 - q1);
+        const int count = values.size();
+        values.erase(std::remove_if(values.begin(), values.end(),
+                                    [=](qreal v) { return v < low || v > high; }),
+                     values.end());
+        outliers = count - values.size();
+    }
+
+    const int n = values.size();
+    const qreal mean = std::accumulate(values.begin(), values.end(), 0.0) / n;
+    qreal variance = 0;
+    for (qreal v : values)
+        variance += (v - mean) * (v - mean);
+    variance = n > 1 ? variance / (n - 1) : 0;
+    const int df = n - 1;
+    const double t = df < 1 ? 0 : df <= 30 ? tQuantiles95[df - 1] : 1.96;
+    const qreal interval = t * std::sqrt(variance / n);
+
+    QTestLog::info(qPrintable(
+        QString::fromLatin1("%1 runs: mean %2 %3 per iteration, 95% confidence interval +/- %4, "
+                            "min %5, max %6, %7 outlier(s) rejected")
+            .arg(results.size())
+            .arg(mean).arg(QLatin1String(QTest::benchmarkMetricUnit(results.first().metric)))
+            .arg(interval).arg(values.first()).arg(values.last()).arg(outliers)), 0, 0);
+}
+
+static void checkBenchmarkBaseline(const QBenchmarkResult &result)
+{
+    const QHash<QString, qreal> &baseline = QBenchmarkGlobalData::current->baseline;
+    if (baseline.isEmpty())
+        return;
+
+    // build the key the same way QCsvBenchmarkLogger writes the row
+    const char *tag = QTestResult::currentDataTag() ? QTestResult::currentDataTag() : "";
+    const char *gtag = QTestResult::currentGlobalDataTag() ? QTestResult::currentGlobalDataTag() : "";
+    const QByteArray fullTag = QByteArray(gtag) + ((tag[0] && gtag[0]) ? ":" : "") + tag;
+    const QString key = QBenchmarkGlobalData::baselineKey(QTestResult::currentTestFunction(),
+                                                         fullTag.constData(), result.metric);
+    QHash<QString, qreal>::const_iterator it = baseline.constFind(key);
+    if (it == baseline.constEnd() || *it <= 0)
+        return;
+
+    const qreal value = result.value / result.iterations;
+    const qreal change = (value - *it) / *it * 100;
+    if (change > QBenchmarkGlobalData::current->baselineThreshold) {
+        QTestResult::addFailure(qPrintable(
+            QString::fromLatin1("Benchmark regressed by %1% against the baseline (%2 vs. %3 %4 per iteration)")
+                .arg(change, 0, 'f', 1).arg(value).arg(*it)
+                .arg(QLatin1String(QTest::benchmarkMetricUnit(result.metric)))), 0, 0);
+    }
+}
+
+static const QBenchmarkMeasurerBase::Measurement *findMeasurement(
+        const QVector<QBenchmarkMeasurerBase::Measurement> &measurements, QTest::QBenchmarkMetric metric)
+{
+    for (const QBenchmarkMeasurerBase::Measurement &m : measurements) {
+        if (m.metric == metric)
+            return &m;
+    }
+    return 0;
+}
+
+static void addBenchmarkRatio(const QVector<QBenchmarkMeasurerBase::Measurement> &measurements,
+                              QTest::QBenchmarkMetric numerator, QTest::QBenchmarkMetric denominator,
+                              const char *description)
+{
+    const QBenchmarkMeasurerBase::Measurement *n = findMeasurement(measurements, numerator);
+    const QBenchmarkMeasurerBase::Measurement *d = findMeasurement(measurements, denominator);
+    if (n && d && d->value > 0) {
+        QTestLog::info(qPrintable(QString::fromLatin1("%1: %2")
+                                  .arg(QLatin1String(description))
+                                  .arg(n->value / d->value, 0, 'f', 4)), 0, 0);
+    }
+}
+
+static void addBenchmarkResults(const QBenchmarkResult &result)
+{
+    QTestLog::addBenchmarkResult(result);
+    if (result.extraMeasurements.isEmpty())
+        return;
+
+    // counters measured in the same run are reported as results of their own
+    QVector<QBenchmarkMeasurerBase::Measurement> all = result.extraMeasurements;
+    for (const QBenchmarkMeasurerBase::Measurement &m : result.extraMeasurements)
+        QTestLog::addBenchmarkResult(QBenchmarkResult(result.context, m.value, result.iterations,
+                                                      m.metric, result.setByMacro));
+
+    const QBenchmarkMeasurerBase::Measurement primary = { result.value, result.metric };
+    all.prepend(primary);
+    addBenchmarkRatio(all, QTest::Instructions, QTest::CPUCycles, "instructions per cycle");
+    addBenchmarkRatio(all, QTest::CacheMisses, QTest::CacheReferences, "cache miss rate");
+    addBenchmarkRatio(all, QTest::BranchMisses, QTest::BranchInstructions, "branch miss rate");
+}
+
 void TestMethods::invokeTestOnData(int index) const
 {
     /* Benchmarking: for each median iteration*/
 
     bool isBenchmark = false;
-    int i = (QBenchmarkGlobalData::current->measurer->needsWarmupIteration()) ? -1 : 0;
+    // negative iterations are warmup iterations
+    int i = -QBenchmarkGlobalData::current->warmupIterationCount();
 
     QVector<QBenchmarkResult> results;
     bool minimumTotalReached = false;
@@ -915,11 +1084,11 @@ void TestMethods::invokeTestOnData(int index) const
 
         QBenchmarkTestMethodData::current->endDataRun();
         if (!QTestResult::skipCurrentTest() && !QTestResult::currentTestFailed()) {
-            if (i > -1)  // iteration -1 is the warmup iteration.
+            if (i > -1)  // negative iterations are warmup iterations.
                 results.append(QBenchmarkTestMethodData::current->result);
 
             if (isBenchmark && QBenchmarkGlobalData::current->verboseOutput) {
-                if (i == -1) {
+                if (i < 0) {
                     QTestLog::info(qPrintable(
                         QString::fromLatin1("warmup stage result      : %1")
                             .arg(QBenchmarkTestMethodData::current->result.value)), 0, 0);
@@ -945,10 +1114,17 @@ void TestMethods::invokeTestOnData(int index) const
     // If the test is a benchmark, finalize the result after all iterations have finished.
     if (isBenchmark) {
         bool testPassed = !QTestResult::skipCurrentTest() && !QTestResult::currentTestFailed();
-        QTestResult::finishedCurrentTestDataCleanup();
         // Only report benchmark figures if the test passed
-        if (testPassed && QBenchmarkTestMethodData::current->resultsAccepted())
-            QTestLog::addBenchmarkResult(qMedian(results));
+        const bool report = testPassed && QBenchmarkTestMethodData::current->resultsAccepted();
+        QBenchmarkResult median;
+        if (report) {
+            median = qMedian(results);
+            reportBenchmarkStatistics(results);
+            checkBenchmarkBaseline(median);
+        }
+        QTestResult::finishedCurrentTestDataCleanup();
+        if (report)
+            addBenchmarkResults(median);
     }
 }
 
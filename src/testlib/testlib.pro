@@ -18,6 +18,7 @@ HEADERS = qbenchmark.h \
     qbenchmarkvalgrind_p.h \
     qbenchmarkevent_p.h \
     qbenchmarkperfevents_p.h \
+    qbenchmarkallocations_p.h \
     qbenchmarkmetric.h \
     qbenchmarkmetric_p.h \
     qsignalspy.h \
@@ -55,6 +56,7 @@ SOURCES = qtestcase.cpp \
     qbenchmarkvalgrind.cpp \
     qbenchmarkevent.cpp \
     qbenchmarkperfevents.cpp \
+    qbenchmarkallocations.cpp \
     qbenchmarkmetric.cpp \
     qcsvbenchmarklogger.cpp \
     qteamcitylogger.cpp \
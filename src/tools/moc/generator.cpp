@@ -372,6 +372,8 @@ void Generator::generateCode()
         index += 4 + (cdef->enumList.at(i).values.count() * 2);
     fprintf(out, "    %4d, %4d, // constructors\n", isConstructible ? cdef->constructorList.count() : 0,
             isConstructible ? index : 0);
+    if (isConstructible)
+        index += cdef->constructorList.count() * 5;
 
     int flags = 0;
     if (cdef->hasQGadget) {
@@ -381,6 +383,7 @@ void Generator::generateCode()
     }
     fprintf(out, "    %4d,       // flags\n", flags);
     fprintf(out, "    %4d,       // signalCount\n", cdef->signalList.count());
+    fprintf(out, "    %4d,       // method hash table\n", methodCount ? index : 0);
 
 
 //
@@ -437,6 +440,11 @@ void Generator::generateCode()
     if (isConstructible)
         generateFunctions(cdef->constructorList, "constructor", MethodConstructor, paramsIndex);
 
+//
+// Build method hash table
+//
+    generateMethodHashTable();
+
 //
 // Terminate data array
 //
@@ -713,6 +721,33 @@ void Generator::generateFunctions(const QVector<FunctionDef>& list, const char *
     }
 }
 
+void Generator::generateMethodHashTable()
+{
+    QVector<uint> hashes;
+    for (const QVector<FunctionDef> *list : { &cdef->signalList, &cdef->slotList, &cdef->methodList }) {
+        for (const FunctionDef &f : *list)
+            hashes.append(QMetaObjectPrivate::methodNameHash(f.name.constData(), f.name.size()));
+    }
+    if (hashes.isEmpty())
+        return;
+
+    QVector<int> table(QMetaObjectPrivate::methodHashTableSize(hashes.count()));
+    QMetaObjectPrivate::buildMethodHashTable(table.data(), hashes.constData(), hashes.count());
+    const int bucketCount = table.at(0);
+
+    fprintf(out, "\n // method hash table: buckets, offsets, indexes\n");
+    fprintf(out, "    %4d,\n", bucketCount);
+    const int groups[] = { 1, bucketCount + 2, table.count() };
+    for (int g = 0; g < 2; ++g) {
+        for (int i = groups[g]; i < groups[g + 1]; ++i) {
+            const int column = (i - groups[g]) % 8;
+            fprintf(out, column ? " %4d," : "    %4d,", table.at(i));
+            if (column == 7 || i == groups[g + 1] - 1)
+                fprintf(out, "\n");
+        }
+    }
+}
+
 void Generator::generateFunctionRevisions(const QVector<FunctionDef>& list, const char *functype)
 {
     if (list.count())
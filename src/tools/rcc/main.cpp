@@ -136,6 +136,9 @@ int runRcc(int argc, char *argv[])
     QCommandLineOption thresholdOption(QStringLiteral("threshold"), QStringLiteral("Threshold to consider compressing files."), QStringLiteral("level"));
     parser.addOption(thresholdOption);
 
+    QCommandLineOption alignOption(QStringLiteral("align"), QStringLiteral("Align the data of uncompressed files to <bytes>."), QStringLiteral("bytes"));
+    parser.addOption(alignOption);
+
     QCommandLineOption binaryOption(QStringLiteral("binary"), QStringLiteral("Output a binary file for use as a dynamic resource."));
     parser.addOption(binaryOption);
 
@@ -191,6 +194,14 @@ int runRcc(int argc, char *argv[])
         library.setCompressLevel(-2);
     if (parser.isSet(thresholdOption))
         library.setCompressThreshold(parser.value(thresholdOption).toInt());
+    if (parser.isSet(alignOption)) {
+        bool ok = false;
+        const int alignment = parser.value(alignOption).toInt(&ok);
+        if (!ok || alignment < 1 || (alignment & (alignment - 1)) || alignment > 4096)
+            errorMsg = QLatin1String("Alignment must be a power of two, no larger than 4096");
+        else
+            library.setAlignment(alignment);
+    }
     if (parser.isSet(binaryOption))
         library.setFormat(RCCResourceLibrary::Binary);
     if (parser.isSet(passOption)) {
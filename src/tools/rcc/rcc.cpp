@@ -221,9 +221,6 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
     const bool pass2 = lib.m_format == RCCResourceLibrary::Pass2;
     const bool binary = lib.m_format == RCCResourceLibrary::Binary;
 
-    //capture the offset
-    m_dataOffset = offset;
-
     //find the data to be written
     QFile file(m_fileInfo.absoluteFilePath());
     if (!file.open(QFile::ReadOnly)) {
@@ -246,6 +243,24 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
     }
 #endif // QT_NO_COMPRESS
 
+    // pad, so that uncompressed data can be used in place
+    if (lib.m_alignment > 1 && !(m_flags & Compressed)) {
+        const qint64 base = binary ? lib.m_dataOffset : 0;
+        const int padding = int((lib.m_alignment - (base + offset + 4) % lib.m_alignment) % lib.m_alignment);
+        if (text) {
+            for (int i = 0; i < padding; ++i)
+                lib.writeHex(0);
+            if (padding)
+                lib.writeString("\n  ");
+        } else if (binary || pass2) {
+            lib.writeByteArray(QByteArray(padding, '\0'));
+        }
+        offset += padding;
+    }
+
+    //capture the offset
+    m_dataOffset = offset;
+
     // some info
     if (text || pass1) {
         lib.writeString("  // ");
@@ -349,6 +364,7 @@ RCCResourceLibrary::RCCResourceLibrary(quint8 formatVersion)
     m_verbose(false),
     m_compressLevel(CONSTANT_COMPRESSLEVEL_DEFAULT),
     m_compressThreshold(CONSTANT_COMPRESSTHRESHOLD_DEFAULT),
+    m_alignment(1),
     m_treeOffset(0),
     m_namesOffset(0),
     m_dataOffset(0),
@@ -900,6 +916,7 @@ bool RCCResourceLibrary::writeDataBlobs()
 {
     Q_ASSERT(m_errorDevice);
     if (m_format == C_Code) {
+        writeDataAlignment();
         writeString("static const unsigned char qt_resource_data[] = {\n");
     } else if (m_format == Binary) {
         m_dataOffset = m_out.size();
@@ -933,13 +950,24 @@ bool RCCResourceLibrary::writeDataBlobs()
     else if (m_format == Pass1) {
         if (offset < 8)
             offset = 8;
-        writeString("\nstatic const unsigned char qt_resource_data[");
+        writeString("\n");
+        writeDataAlignment();
+        writeString("static const unsigned char qt_resource_data[");
         writeByteArray(QByteArray::number(offset));
         writeString("] = { 'Q', 'R', 'C', '_', 'D', 'A', 'T', 'A' };\n\n");
     }
     return true;
 }
 
+void RCCResourceLibrary::writeDataAlignment()
+{
+    if (m_alignment > 1) {
+        writeString("alignas(");
+        writeByteArray(QByteArray::number(m_alignment));
+        writeString(") ");
+    }
+}
+
 bool RCCResourceLibrary::writeDataNames()
 {
     if (m_format == C_Code || m_format == Pass1)
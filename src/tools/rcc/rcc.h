@@ -83,6 +83,9 @@ public:
     void setCompressThreshold(int t) { m_compressThreshold = t; }
     int compressThreshold() const { return m_compressThreshold; }
 
+    void setAlignment(int a) { m_alignment = a; }
+    int alignment() const { return m_alignment; }
+
     void setResourceRoot(const QString &root) { m_resourceRoot = root; }
     QString resourceRoot() const { return m_resourceRoot; }
 
@@ -112,6 +115,7 @@ private:
         QString currentPath = QString(), bool ignoreErrors = false);
     bool writeHeader();
     bool writeDataBlobs();
+    void writeDataAlignment();
     bool writeDataNames();
     bool writeDataStructure();
     bool writeInitializer();
@@ -135,6 +139,7 @@ private:
     bool m_verbose;
     int m_compressLevel;
     int m_compressThreshold;
+    int m_alignment;
     int m_treeOffset;
     int m_namesOffset;
     int m_dataOffset;
@@ -50,6 +50,7 @@
 #include <QtCore/qcollator.h>
 
 #include <algorithm>
+#include <vector>
 
 #ifdef Q_OS_WIN
 #  include <QtCore/QVarLengthArray>
@@ -848,7 +849,14 @@ QIcon QFileSystemModelPrivate::icon(const QModelIndex &index) const
 {
     if (!index.isValid())
         return QIcon();
-    return node(index)->icon();
+    QFileSystemNode *indexNode = node(index);
+#ifndef QT_NO_FILESYSTEMWATCHER
+    // Asking the icon provider while populating a large directory is expensive,
+    // so icons are only resolved once they are shown.
+    if (indexNode->info && indexNode->info->icon.isNull())
+        indexNode->info->icon = fileInfoGatherer.iconProvider()->icon(indexNode->info->fileInfo());
+#endif
+    return indexNode->icon();
 }
 
 /*!
@@ -1013,60 +1021,75 @@ public:
         naturalCompare.setCaseSensitivity(Qt::CaseInsensitive);
     }
 
-    bool compareNodes(const QFileSystemModelPrivate::QFileSystemNode *l,
-                    const QFileSystemModelPrivate::QFileSystemNode *r) const
+    struct SortItem {
+        QFileSystemModelPrivate::QFileSystemNode *node;
+        QCollatorSortKey nameKey;
+    };
+
+    bool compareNodes(const SortItem &l, const SortItem &r) const
     {
         switch (sortColumn) {
         case 0: {
 #ifndef Q_OS_MAC
             // place directories before files
-            bool left = l->isDir();
-            bool right = r->isDir();
+            bool left = l.node->isDir();
+            bool right = r.node->isDir();
             if (left ^ right)
                 return left;
 #endif
-            return naturalCompare.compare(l->fileName, r->fileName) < 0;
+            return l.nameKey.compare(r.nameKey) < 0;
                 }
         case 1:
         {
             // Directories go first
-            bool left = l->isDir();
-            bool right = r->isDir();
+            bool left = l.node->isDir();
+            bool right = r.node->isDir();
             if (left ^ right)
                 return left;
 
-            qint64 sizeDifference = l->size() - r->size();
+            qint64 sizeDifference = l.node->size() - r.node->size();
             if (sizeDifference == 0)
-                return naturalCompare.compare(l->fileName, r->fileName) < 0;
+                return l.nameKey.compare(r.nameKey) < 0;
 
             return sizeDifference < 0;
         }
         case 2:
         {
-            int compare = naturalCompare.compare(l->type(), r->type());
+            int compare = naturalCompare.compare(l.node->type(), r.node->type());
             if (compare == 0)
-                return naturalCompare.compare(l->fileName, r->fileName) < 0;
+                return l.nameKey.compare(r.nameKey) < 0;
 
             return compare < 0;
         }
         case 3:
         {
-            if (l->lastModified() == r->lastModified())
-                return naturalCompare.compare(l->fileName, r->fileName) < 0;
+            if (l.node->lastModified() == r.node->lastModified())
+                return l.nameKey.compare(r.nameKey) < 0;
 
-            return l->lastModified() < r->lastModified();
+            return l.node->lastModified() < r.node->lastModified();
         }
         }
         Q_ASSERT(false);
         return false;
     }
 
-    bool operator()(const QFileSystemModelPrivate::QFileSystemNode *l,
-                    const QFileSystemModelPrivate::QFileSystemNode *r) const
+    bool operator()(const SortItem &l, const SortItem &r) const
     {
         return compareNodes(l, r);
     }
 
+    void sort(QVector<QFileSystemModelPrivate::QFileSystemNode *> &nodes) const
+    {
+        // Collate every file name once up front, instead of in every
+        // comparison, which dominates sorting large directories.
+        std::vector<SortItem> items;
+        items.reserve(nodes.size());
+        for (QFileSystemModelPrivate::QFileSystemNode *node : qAsConst(nodes))
+            items.push_back(SortItem{node, naturalCompare.sortKey(node->fileName)});
+        std::sort(items.begin(), items.end(), *this);
+        for (int i = 0; i < nodes.size(); ++i)
+            nodes[i] = items[i].node;
+    }
 
 private:
     QCollator naturalCompare;
@@ -1095,7 +1118,7 @@ void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent
         }
     }
     QFileSystemModelSorter ms(column);
-    std::sort(values.begin(), values.end(), ms);
+    ms.sort(values);
     // First update the new visible list
     indexNode->visibleChildren.clear();
     //No more dirty item we reset our internal dirty index
@@ -1430,7 +1453,7 @@ void QFileSystemModel::setIconProvider(QFileIconProvider *provider)
 #ifndef QT_NO_FILESYSTEMWATCHER
     d->fileInfoGatherer.setIconProvider(provider);
 #endif
-    d->root.updateIcon(provider, QString());
+    d->root.clearIcons();
 }
 
 /*!
@@ -174,19 +174,12 @@ public:
         inline int visibleLocation(const QString &childName) {
             return visibleChildren.indexOf(childName);
         }
-        void updateIcon(QFileIconProvider *iconProvider, const QString &path) {
+        // the icons are resolved again when they are needed
+        void clearIcons() {
             if (info)
-                info->icon = iconProvider->icon(QFileInfo(path));
-            for (QFileSystemNode *child : qAsConst(children)) {
-                //On windows the root (My computer) has no path so we don't want to add a / for nothing (e.g. /C:/)
-                if (!path.isEmpty()) {
-                    if (path.endsWith(QLatin1Char('/')))
-                        child->updateIcon(iconProvider, path + child->fileName);
-                    else
-                        child->updateIcon(iconProvider, path + QLatin1Char('/') + child->fileName);
-                } else
-                    child->updateIcon(iconProvider, child->fileName);
-            }
+                info->icon = QIcon();
+            for (QFileSystemNode *child : qAsConst(children))
+                child->clearIcons();
         }
 
         void retranslateStrings(QFileIconProvider *iconProvider, const QString &path) {
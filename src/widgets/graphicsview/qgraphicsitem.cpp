@@ -436,6 +436,18 @@
     ItemClipsChildrenToShape.
 
     This flag was introduced in Qt 5.4.
+
+    \value ItemUsesBatchPainting The item may be painted together with
+    other items of the same type() through the function registered with
+    setBatchPaintFunction(), instead of through its own paint()
+    implementation. Items are only batched while they are in their default
+    state (enabled, not selected, without focus and not hovered), have no
+    children, no graphics effect and no cache mode, and are drawn
+    consecutively with the same opacity. In any other case paint() is called
+    as usual, so both must produce the same output. The flag is disabled by
+    default.
+
+    This flag was introduced in Qt 5.11.
 */
 
 /*!
@@ -740,6 +752,7 @@
 #include "qgraphicsproxywidget.h"
 #include "qgraphicsscenebsptreeindex_p.h"
 #include <QtCore/qbitarray.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qpoint.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qtimer.h>
@@ -789,6 +802,27 @@ public:
 };
 Q_GLOBAL_STATIC(QGraphicsItemCustomDataStore, qt_dataStore)
 
+static void qt_graphicsRectItem_batchPaint(QPainter *painter, QGraphicsItem *const *items,
+                                           const QTransform *transforms, int count,
+                                           const QStyleOptionGraphicsItem *option, QWidget *widget);
+static void qt_graphicsEllipseItem_batchPaint(QPainter *painter, QGraphicsItem *const *items,
+                                              const QTransform *transforms, int count,
+                                              const QStyleOptionGraphicsItem *option, QWidget *widget);
+
+class QGraphicsItemBatchPaintRegistry
+{
+public:
+    QGraphicsItemBatchPaintRegistry()
+    {
+        functions.insert(QGraphicsRectItem::Type, qt_graphicsRectItem_batchPaint);
+        functions.insert(QGraphicsEllipseItem::Type, qt_graphicsEllipseItem_batchPaint);
+    }
+
+    QMutex mutex;
+    QHash<int, QGraphicsItem::BatchPaintFunction> functions;
+};
+Q_GLOBAL_STATIC(QGraphicsItemBatchPaintRegistry, qt_batchPaintRegistry)
+
 /*!
     \internal
 
@@ -883,6 +917,7 @@ QGraphicsItemPrivate::QGraphicsItemPrivate()
       isDeclarativeItem(false),
       sendParentChangeNotification(false),
       dirtyChildrenBoundingRect(true),
+      indexMovePending(false),
       globalStackingOrder(-1),
       q_ptr(nullptr)
 {
@@ -5456,6 +5491,72 @@ void QGraphicsItem::setBoundingRegionGranularity(qreal granularity)
     \sa setCacheMode(), QPen::width(), {Item Coordinates}, ItemUsesExtendedStyleOption
 */
 
+/*!
+    \typedef QGraphicsItem::BatchPaintFunction
+    \since 5.11
+
+    This is a typedef for a pointer to a function with the following
+    signature:
+
+    \code
+    void paintBatch(QPainter *painter, QGraphicsItem *const *items,
+                    const QTransform *transforms, int count,
+                    const QStyleOptionGraphicsItem *option, QWidget *widget);
+    \endcode
+
+    The function must paint the \a count items in \a items, in order. Each
+    item is painted in its local coordinates after setting the corresponding
+    entry of \a transforms as the painter's world transform. The painter's
+    pen and brush are undefined on entry. \a option is shared by all items;
+    its state only contains QStyle::State_Enabled and its exposed rect is not
+    set. \a widget is the widget being painted on, or 0.
+
+    \sa setBatchPaintFunction(), ItemUsesBatchPainting
+*/
+
+/*!
+    \since 5.11
+
+    Registers \a function as the batch paint function for items whose
+    type() returns \a type, replacing any previously registered function.
+    Passing a null \a function removes the registration, and items of that
+    type are painted individually.
+
+    Graphics View only uses the function for items that have the
+    ItemUsesBatchPainting flag set. Functions for QGraphicsRectItem and
+    QGraphicsEllipseItem are registered by default.
+
+    This function is thread-safe.
+
+    \sa batchPaintFunction(), paint()
+*/
+void QGraphicsItem::setBatchPaintFunction(int type, BatchPaintFunction function)
+{
+    QGraphicsItemBatchPaintRegistry *registry = qt_batchPaintRegistry();
+    QMutexLocker locker(&registry->mutex);
+    if (function)
+        registry->functions.insert(type, function);
+    else
+        registry->functions.remove(type);
+}
+
+/*!
+    \since 5.11
+
+    Returns the batch paint function registered for items whose type()
+    returns \a type, or 0 if there is none.
+
+    This function is thread-safe.
+
+    \sa setBatchPaintFunction()
+*/
+QGraphicsItem::BatchPaintFunction QGraphicsItem::batchPaintFunction(int type)
+{
+    QGraphicsItemBatchPaintRegistry *registry = qt_batchPaintRegistry();
+    QMutexLocker locker(&registry->mutex);
+    return registry->functions.value(type);
+}
+
 /*!
     \internal
     Returns \c true if we can discard an update request; otherwise false.
@@ -8660,6 +8761,21 @@ void QGraphicsRectItem::paint(QPainter *painter, const QStyleOptionGraphicsItem
         qt_graphicsItem_highlightSelected(this, painter, option);
 }
 
+static void qt_graphicsRectItem_batchPaint(QPainter *painter, QGraphicsItem *const *items,
+                                           const QTransform *transforms, int count,
+                                           const QStyleOptionGraphicsItem *, QWidget *)
+{
+    // Each item is filled and stroked before the next one; drawRects() would
+    // fill all rects before stroking any of them.
+    for (int i = 0; i < count; ++i) {
+        QGraphicsRectItemPrivate *d = static_cast<QGraphicsRectItemPrivate *>(QGraphicsItemPrivate::get(items[i]));
+        painter->setWorldTransform(transforms[i]);
+        painter->setPen(d->pen);
+        painter->setBrush(d->brush);
+        painter->drawRect(d->rect);
+    }
+}
+
 /*!
     \reimp
 */
@@ -8961,6 +9077,22 @@ void QGraphicsEllipseItem::paint(QPainter *painter, const QStyleOptionGraphicsIt
         qt_graphicsItem_highlightSelected(this, painter, option);
 }
 
+static void qt_graphicsEllipseItem_batchPaint(QPainter *painter, QGraphicsItem *const *items,
+                                              const QTransform *transforms, int count,
+                                              const QStyleOptionGraphicsItem *, QWidget *)
+{
+    for (int i = 0; i < count; ++i) {
+        QGraphicsEllipseItemPrivate *d = static_cast<QGraphicsEllipseItemPrivate *>(QGraphicsItemPrivate::get(items[i]));
+        painter->setWorldTransform(transforms[i]);
+        painter->setPen(d->pen);
+        painter->setBrush(d->brush);
+        if ((d->spanAngle != 0) && (qAbs(d->spanAngle) % (360 * 16) == 0))
+            painter->drawEllipse(d->rect);
+        else
+            painter->drawPie(d->rect, d->startAngle, d->spanAngle);
+    }
+}
+
 /*!
     \reimp
 */
@@ -11607,6 +11739,9 @@ QDebug operator<<(QDebug debug, QGraphicsItem::GraphicsItemFlag flag)
     case QGraphicsItem::ItemContainsChildrenInShape:
         str = "ItemContainsChildrenInShape";
         break;
+    case QGraphicsItem::ItemUsesBatchPainting:
+        str = "ItemUsesBatchPainting";
+        break;
     }
     debug << str;
     return debug;
@@ -103,7 +103,8 @@ public:
         ItemSendsScenePositionChanges = 0x10000,
         ItemStopsClickFocusPropagation = 0x20000,
         ItemStopsFocusHandling = 0x40000,
-        ItemContainsChildrenInShape = 0x80000
+        ItemContainsChildrenInShape = 0x80000,
+        ItemUsesBatchPainting = 0x100000
         // NB! Don't forget to increase the d_ptr->flags bit field by 1 when adding a new flag.
     };
     Q_DECLARE_FLAGS(GraphicsItemFlags, GraphicsItemFlag)
@@ -342,6 +343,11 @@ public:
 
     // Drawing
     virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = Q_NULLPTR) = 0;
+    typedef void (*BatchPaintFunction)(QPainter *painter, QGraphicsItem *const *items,
+                                       const QTransform *transforms, int count,
+                                       const QStyleOptionGraphicsItem *option, QWidget *widget);
+    static void setBatchPaintFunction(int type, BatchPaintFunction function);
+    static BatchPaintFunction batchPaintFunction(int type);
     void update(const QRectF &rect = QRectF());
     inline void update(qreal x, qreal y, qreal width, qreal height);
     void scroll(qreal dx, qreal dy, const QRectF &rect = QRectF());
@@ -486,7 +486,7 @@ public:
     quint32 fullUpdatePending : 1;
 
     // Packed 32 bits
-    quint32 flags : 20;
+    quint32 flags : 21;
     quint32 paintedViewBoundingRectsNeedRepaint : 1;
     quint32 dirtySceneTransform : 1;
     quint32 geometryChanged : 1;
@@ -514,7 +514,8 @@ public:
     quint32 isDeclarativeItem : 1;
     quint32 sendParentChangeNotification : 1;
     quint32 dirtyChildrenBoundingRect : 1;
-    quint32 padding : 19;
+    quint32 indexMovePending : 1;
+    quint32 padding : 17;
 
     // Optional stacking order
     int globalStackingOrder;
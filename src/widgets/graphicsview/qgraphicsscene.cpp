@@ -4711,6 +4711,7 @@ void QGraphicsScenePrivate::drawItems(QPainter *painter, const QTransform *const
     const QList<QGraphicsItem *> tli = index->estimateTopLevelItems(exposedSceneRect, Qt::AscendingOrder);
     for (int i = 0; i < tli.size(); ++i)
         drawSubtreeRecursive(tli.at(i), painter, viewTransform, exposedRegion, widget);
+    flushPaintBatch();
 }
 
 void QGraphicsScenePrivate::drawSubtreeRecursive(QGraphicsItem *item, QPainter *painter,
@@ -4812,6 +4813,7 @@ void QGraphicsScenePrivate::drawSubtreeRecursive(QGraphicsItem *item, QPainter *
 #if QT_CONFIG(graphicseffect)
     if (item->d_ptr->graphicsEffect && item->d_ptr->graphicsEffect->isEnabled()) {
         ENSURE_TRANSFORM_PTR;
+        flushPaintBatch();
         QGraphicsItemPaintInfo info(viewTransform, transformPtr, effectTransform, exposedRegion, widget, &styleOptionTmp,
                                     painter, opacity, wasDirtyParentSceneTransform, itemHasContents && !itemIsFullyTransparent);
         QGraphicsEffectSource *source = item->d_ptr->graphicsEffect->d_func()->source;
@@ -4848,11 +4850,113 @@ void QGraphicsScenePrivate::drawSubtreeRecursive(QGraphicsItem *item, QPainter *
     } else
 #endif // QT_CONFIG(graphicseffect)
     {
+        if (drawItem && !itemHasChildren
+            && batchPaintItem(item, painter, transformPtr, effectTransform, widget, opacity)) {
+            return;
+        }
+        flushPaintBatch();
         draw(item, painter, viewTransform, transformPtr, exposedRegion, widget, opacity,
              effectTransform, wasDirtyParentSceneTransform, drawItem);
     }
 }
 
+static bool qt_drawSceneItemRects()
+{
+    static const bool drawRects = qEnvironmentVariableIntValue("QT_DRAW_SCENE_ITEM_RECTS");
+    return drawRects;
+}
+
+/*!
+    \internal
+
+    Queues \a item for painting together with the preceding items of the same
+    type, if it has QGraphicsItem::ItemUsesBatchPainting set and a batch paint
+    function is registered for it. Returns \c false if the item must be
+    painted individually; the caller is then responsible for flushing the
+    pending batch first.
+*/
+bool QGraphicsScenePrivate::batchPaintItem(QGraphicsItem *item, QPainter *painter,
+                                           const QTransform *const transformPtr,
+                                           const QTransform *const effectTransform,
+                                           QWidget *widget, qreal opacity)
+{
+    const QGraphicsItemPrivate *itemd = item->d_ptr.data();
+    if (!(itemd->flags & QGraphicsItem::ItemUsesBatchPainting)
+        || (itemd->flags & (QGraphicsItem::ItemClipsToShape | QGraphicsItem::ItemUsesExtendedStyleOption))
+        || itemd->cacheMode || itemd->isWidget || !itemd->enabled || itemd->selected
+        || qt_drawSceneItemRects()) {
+        return false;
+    }
+#if QT_CONFIG(graphicseffect)
+    if (itemd->graphicsEffect)
+        return false;
+#endif
+    // The batch paint function receives a shared style option, so only batch
+    // items whose own option would not carry any additional state.
+    if (item->hasFocus() || hoverItems.contains(item)
+        || (!mouseGrabberItems.isEmpty() && mouseGrabberItems.constLast() == item)) {
+        return false;
+    }
+
+    const int type = item->type();
+    QGraphicsItem::BatchPaintFunction function = paintBatch.function;
+    if (!function || paintBatch.type != type) {
+        function = QGraphicsItem::batchPaintFunction(type);
+        if (!function)
+            return false;
+    }
+    if (function != paintBatch.function || painter != paintBatch.painter
+        || widget != paintBatch.widget || opacity != paintBatch.opacity) {
+        flushPaintBatch();
+        paintBatch.function = function;
+        paintBatch.type = type;
+        paintBatch.painter = painter;
+        paintBatch.widget = widget;
+        paintBatch.opacity = opacity;
+    }
+
+    Q_ASSERT(transformPtr);
+    paintBatch.items.append(item);
+    if (effectTransform)
+        paintBatch.transforms.append(*transformPtr * *effectTransform);
+    else
+        paintBatch.transforms.append(*transformPtr);
+    return true;
+}
+
+/*!
+    \internal
+
+    Paints the items queued by batchPaintItem(), if any.
+*/
+void QGraphicsScenePrivate::flushPaintBatch()
+{
+    if (paintBatch.items.isEmpty())
+        return;
+
+    QPainter *painter = paintBatch.painter;
+    if (painterStateProtection)
+        painter->save();
+    painter->setOpacity(paintBatch.opacity);
+
+    Q_Q(QGraphicsScene);
+    styleOptionTmp.state = QStyle::State_Enabled;
+    styleOptionTmp.rect = QRect();
+    styleOptionTmp.exposedRect = QRectF();
+    styleOptionTmp.levelOfDetail = 1;
+    styleOptionTmp.matrix = QMatrix();
+    styleOptionTmp.styleObject = q;
+    paintBatch.function(painter, paintBatch.items.constData(), paintBatch.transforms.constData(),
+                        paintBatch.items.size(), &styleOptionTmp, paintBatch.widget);
+
+    if (painterStateProtection)
+        painter->restore();
+
+    paintBatch.function = 0;
+    paintBatch.items.clear();
+    paintBatch.transforms.clear();
+}
+
 static inline void setClip(QPainter *painter, QGraphicsItem *item)
 {
     painter->save();
@@ -4913,6 +5017,7 @@ void QGraphicsScenePrivate::draw(QGraphicsItem *item, QPainter *painter, const Q
                     continue;
                 drawSubtreeRecursive(child, painter, viewTransform, exposedRegion, widget, opacity, effectTransform);
             }
+            flushPaintBatch();
         }
     }
 
@@ -4963,8 +5068,7 @@ void QGraphicsScenePrivate::draw(QGraphicsItem *item, QPainter *painter, const Q
         if (painterStateProtection || restorePainterClip)
             painter->restore();
 
-        static int drawRect = qEnvironmentVariableIntValue("QT_DRAW_SCENE_ITEM_RECTS");
-        if (drawRect) {
+        if (qt_drawSceneItemRects()) {
             QPen oldPen = painter->pen();
             QBrush oldBrush = painter->brush();
             quintptr ptr = reinterpret_cast<quintptr>(item);
@@ -4990,6 +5094,7 @@ void QGraphicsScenePrivate::draw(QGraphicsItem *item, QPainter *painter, const Q
                 continue;
             drawSubtreeRecursive(child, painter, viewTransform, exposedRegion, widget, opacity, effectTransform);
         }
+        flushPaintBatch();
 
         // Restore child clip
         if (itemClipsChildrenToShape)
@@ -5385,6 +5490,7 @@ void QGraphicsScene::drawItems(QPainter *painter,
             d->drawSubtreeRecursive(item, painter, &viewTransform, expose, widget);
         }
     }
+    d->flushPaintBatch();
 
     d->rectAdjust = oldRectAdjust;
     // Reset discovery bits.
@@ -142,6 +142,12 @@ void QGraphicsSceneBspTree::removeItems(const QSet<QGraphicsItem *> &items)
     }
 }
 
+void QGraphicsSceneBspTree::moveItem(QGraphicsItem *item, const QRectF &oldRect, const QRectF &newRect)
+{
+    if (!nodes.isEmpty())
+        moveItem(item, oldRect, newRect, true, true, 0);
+}
+
 QList<QGraphicsItem *> QGraphicsSceneBspTree::items(const QRectF &rect, bool onlyTopLevelItems) const
 {
     QList<QGraphicsItem *> tmp;
@@ -263,6 +269,33 @@ void QGraphicsSceneBspTree::climbTree(QGraphicsSceneBspTreeVisitor *visitor, con
     }
 }
 
+void QGraphicsSceneBspTree::moveItem(QGraphicsItem *item, const QRectF &oldRect, const QRectF &newRect,
+                                     bool inOld, bool inNew, int index)
+{
+    const Node &node = nodes.at(index);
+    if (node.type == Node::Leaf) {
+        // Leaves covered by both rects are left alone.
+        if (!inNew)
+            leaves[node.leafIndex].removeAll(item);
+        else if (!inOld)
+            leaves[node.leafIndex].prepend(item);
+        return;
+    }
+
+    // Follow the same branches as climbTree() does for each rect.
+    const bool vertical = node.type == Node::Vertical;
+    const bool firstOld = inOld && (vertical ? oldRect.left() : oldRect.top()) < node.offset;
+    const bool secondOld = inOld && (!firstOld || (vertical ? oldRect.right() : oldRect.bottom()) >= node.offset);
+    const bool firstNew = inNew && (vertical ? newRect.left() : newRect.top()) < node.offset;
+    const bool secondNew = inNew && (!firstNew || (vertical ? newRect.right() : newRect.bottom()) >= node.offset);
+
+    const int childIndex = firstChildIndex(index);
+    if (firstOld || firstNew)
+        moveItem(item, oldRect, newRect, firstOld, firstNew, childIndex);
+    if (secondOld || secondNew)
+        moveItem(item, oldRect, newRect, secondOld, secondNew, childIndex + 1);
+}
+
 QRectF QGraphicsSceneBspTree::rectForIndex(int index) const
 {
     if (index <= 0)
@@ -90,9 +90,12 @@ public:
     void insertItem(QGraphicsItem *item, const QRectF &rect);
     void removeItem(QGraphicsItem *item, const QRectF &rect);
     void removeItems(const QSet<QGraphicsItem *> &items);
+    void moveItem(QGraphicsItem *item, const QRectF &oldRect, const QRectF &newRect);
 
     QList<QGraphicsItem *> items(const QRectF &rect, bool onlyTopLevelItems = false) const;
     int leafCount() const;
+    inline QRectF partitionedRect() const
+    { return rect; }
 
     inline int firstChildIndex(int index) const
     { return index * 2 + 1; }
@@ -105,6 +108,8 @@ public:
 private:
     void initialize(const QRectF &rect, int depth, int index);
     void climbTree(QGraphicsSceneBspTreeVisitor *visitor, const QRectF &rect, int index = 0) const;
+    void moveItem(QGraphicsItem *item, const QRectF &oldRect, const QRectF &newRect,
+                  bool inOld, bool inNew, int index);
     QRectF rectForIndex(int index) const;
 
     QVector<Node> nodes;
@@ -64,6 +64,7 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qset.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtGui/qfont.h>
 #include <QtGui/qpalette.h>
 #include <QtWidgets/qstyle.h>
@@ -229,6 +230,22 @@ public:
     void draw(QGraphicsItem *, QPainter *, const QTransform *const, const QTransform *const,
               QRegion *, QWidget *, qreal, const QTransform *const, bool, bool);
 
+    struct PaintBatch
+    {
+        PaintBatch() : function(0), painter(0), widget(0), opacity(1), type(0) {}
+        QGraphicsItem::BatchPaintFunction function;
+        QPainter *painter;
+        QWidget *widget;
+        qreal opacity;
+        int type;
+        QVarLengthArray<QGraphicsItem *, 64> items;
+        QVarLengthArray<QTransform, 64> transforms;
+    };
+    PaintBatch paintBatch;
+    bool batchPaintItem(QGraphicsItem *item, QPainter *painter, const QTransform *const transformPtr,
+                        const QTransform *const effectTransform, QWidget *widget, qreal opacity);
+    void flushPaintBatch();
+
     void markDirty(QGraphicsItem *item, const QRectF &rect = QRectF(), bool invalidateChildren = false,
                    bool force = false, bool ignoreOpacity = false, bool removingItemFromScene = false,
                    bool updateBoundingRect = false);
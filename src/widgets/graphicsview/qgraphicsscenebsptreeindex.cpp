@@ -90,6 +90,17 @@ static inline int intmaxlog(int n)
     return  (n > 0 ? qMax(qCeil(qLn(qreal(n)) / qLn(qreal(2))), 5) : 0);
 }
 
+/*
+    Returns true if the tree partitioned for \a partitionedRect can keep being
+    used for the scene rect \a rect.
+*/
+static inline bool qt_fitsPartitionedRect(const QRectF &partitionedRect, const QRectF &rect)
+{
+    return !rect.isEmpty() && partitionedRect.contains(rect)
+        && rect.width() * 2 >= partitionedRect.width()
+        && rect.height() * 2 >= partitionedRect.height();
+}
+
 /*!
     Constructs a private scene bsp index.
 */
@@ -155,11 +166,14 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
     // Regenerate the tree.
     if (regenerateIndex) {
         regenerateIndex = false;
-        bsp.initialize(sceneRect, bspTreeDepth);
+        bsp.initialize(treeRect(), bspTreeDepth);
+        discardMovedItems();
         unindexedItems = indexedItems;
         lastItemCount = indexedItems.size();
     }
 
+    reindexMovedItems();
+
     // Insert all unindexed items into the tree.
     for (int i = 0; i < unindexedItems.size(); ++i) {
         if (QGraphicsItem *item = unindexedItems.at(i)) {
@@ -178,6 +192,23 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
 }
 
 
+/*!
+    \internal
+
+    Returns the rect to partition the BSP tree for. Without an explicit scene
+    rect, the scene rect grows whenever items move beyond it; the tree is then
+    given room to grow into, so that it does not have to be regenerated for
+    every change.
+*/
+QRectF QGraphicsSceneBspTreeIndexPrivate::treeRect() const
+{
+    if (!scene || scene->d_func()->hasSceneRect || sceneRect.isEmpty())
+        return sceneRect;
+    const qreal dx = sceneRect.width() / 4;
+    const qreal dy = sceneRect.height() / 4;
+    return sceneRect.adjusted(-dx, -dy, dx, dy);
+}
+
 /*!
     \internal
 
@@ -190,6 +221,13 @@ void QGraphicsSceneBspTreeIndexPrivate::purgeRemovedItems()
 
     // Remove stale items from the BSP tree.
     bsp.removeItems(removedItems);
+    if (!movedItems.isEmpty()) {
+        movedItems.erase(std::remove_if(movedItems.begin(), movedItems.end(),
+                                        [this](const MovedItem &moved) {
+                                            return removedItems.contains(moved.item);
+                                        }),
+                         movedItems.end());
+    }
     // Purge this list.
     removedItems.clear();
     freeItemIndexes.clear();
@@ -200,6 +238,37 @@ void QGraphicsSceneBspTreeIndexPrivate::purgeRemovedItems()
     purgePending = false;
 }
 
+/*!
+    \internal
+
+    Moves the items whose bounding rect changed since they were inserted
+    into the BSP tree to the leaves covering their new bounding rect.
+*/
+void QGraphicsSceneBspTreeIndexPrivate::reindexMovedItems()
+{
+    for (int i = 0; i < movedItems.size(); ++i) {
+        const MovedItem &moved = movedItems.at(i);
+        moved.item->d_ptr->indexMovePending = 0;
+        bsp.moveItem(moved.item, moved.indexedRect, moved.item->d_ptr->sceneEffectiveBoundingRect());
+    }
+    movedItems.clear();
+}
+
+/*!
+    \internal
+
+    Forgets about moved items, for when the BSP tree is regenerated or cleared.
+*/
+void QGraphicsSceneBspTreeIndexPrivate::discardMovedItems()
+{
+    for (int i = 0; i < movedItems.size(); ++i) {
+        QGraphicsItem *item = movedItems.at(i).item;
+        if (!removedItems.contains(item))
+            item->d_ptr->indexMovePending = 0;
+    }
+    movedItems.clear();
+}
+
 /*!
     \internal
 
@@ -221,6 +290,7 @@ void QGraphicsSceneBspTreeIndexPrivate::startIndexTimer(int interval)
 void QGraphicsSceneBspTreeIndexPrivate::resetIndex()
 {
     purgeRemovedItems();
+    discardMovedItems();
     for (int i = 0; i < indexedItems.size(); ++i) {
         if (QGraphicsItem *item = indexedItems.at(i)) {
             item->d_ptr->index = -1;
@@ -336,6 +406,12 @@ void QGraphicsSceneBspTreeIndexPrivate::removeItem(QGraphicsItem *item, bool rec
     if (!item)
         return;
 
+    if (item->d_ptr->indexMovePending && !item->d_ptr->inDestructor) {
+        // The tree has to know where the item is before it can be removed.
+        purgeRemovedItems();
+        reindexMovedItems();
+    }
+
     if (item->d_ptr->index != -1) {
         Q_ASSERT(item->d_ptr->index < indexedItems.size());
         Q_ASSERT(indexedItems.at(item->d_ptr->index) == item);
@@ -450,6 +526,7 @@ QGraphicsSceneBspTreeIndex::QGraphicsSceneBspTreeIndex(QGraphicsScene *scene)
 QGraphicsSceneBspTreeIndex::~QGraphicsSceneBspTreeIndex()
 {
     Q_D(QGraphicsSceneBspTreeIndex);
+    d->discardMovedItems();
     for (int i = 0; i < d->indexedItems.size(); ++i) {
         // Ensure item bits are reset properly.
         if (QGraphicsItem *item = d->indexedItems.at(i)) {
@@ -466,6 +543,7 @@ QGraphicsSceneBspTreeIndex::~QGraphicsSceneBspTreeIndex()
 void QGraphicsSceneBspTreeIndex::clear()
 {
     Q_D(QGraphicsSceneBspTreeIndex);
+    d->discardMovedItems();
     d->bsp.clear();
     d->lastItemCount = 0;
     d->freeItemIndexes.clear();
@@ -515,9 +593,17 @@ void QGraphicsSceneBspTreeIndex::prepareBoundingRectChange(const QGraphicsItem *
         return; // Item is not in BSP tree; nothing to do.
     }
 
+    // Remember the rect the item is indexed with; it is moved to its new
+    // leaves when the index is next updated.
     Q_D(QGraphicsSceneBspTreeIndex);
-    QGraphicsItem *thatItem = const_cast<QGraphicsItem *>(item);
-    d->removeItem(thatItem, /*recursive=*/false, /*moveToUnindexedItems=*/true);
+    if (!item->d_ptr->indexMovePending) {
+        item->d_ptr->indexMovePending = 1;
+        const QGraphicsSceneBspTreeIndexPrivate::MovedItem moved = {
+            const_cast<QGraphicsItem *>(item), item->d_ptr->sceneEffectiveBoundingRect()
+        };
+        d->movedItems.append(moved);
+        d->startIndexTimer(0);
+    }
     for (int i = 0; i < item->d_ptr->children.size(); ++i)  // ### Do we really need this?
         prepareBoundingRectChange(item->d_ptr->children.at(i));
 }
@@ -619,7 +705,12 @@ void QGraphicsSceneBspTreeIndex::updateSceneRect(const QRectF &rect)
 {
     Q_D(QGraphicsSceneBspTreeIndex);
     d->sceneRect = rect;
-    d->resetIndex();
+    // Items outside the partitioned rect are kept in the outermost leaves, so
+    // a growing scene rect only needs a new tree once it outgrows the old one.
+    if (d->bsp.leafCount() == 0 || !d->scene || d->scene->d_func()->hasSceneRect
+        || !qt_fitsPartitionedRect(d->bsp.partitionedRect(), rect)) {
+        d->resetIndex();
+    }
 }
 
 /*!
@@ -59,6 +59,7 @@
 
 #include <QtCore/qrect.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qvector.h>
 
 QT_REQUIRE_CONFIG(graphicsview);
 
@@ -126,6 +127,17 @@ public:
     QList<QGraphicsItem *> untransformableItems;
     QList<int> freeItemIndexes;
 
+    struct MovedItem
+    {
+        QGraphicsItem *item;
+        QRectF indexedRect;
+    };
+    QVector<MovedItem> movedItems;
+    void reindexMovedItems();
+    void discardMovedItems();
+
+    QRectF treeRect() const;
+
     bool purgePending;
     QSet<QGraphicsItem *> removedItems;
     void purgeRemovedItems();
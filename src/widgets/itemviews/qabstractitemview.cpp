@@ -112,7 +112,8 @@ QAbstractItemViewPrivate::QAbstractItemViewPrivate()
         delayedPendingLayout(true),
         moveCursorUpdatedView(false),
         verticalScrollModeSet(false),
-        horizontalScrollModeSet(false)
+        horizontalScrollModeSet(false),
+        itemPixmapCacheEnabled(false)
 {
     keyboardInputTime.invalidate();
 }
@@ -1114,6 +1115,7 @@ void QAbstractItemView::reset()
 {
     Q_D(QAbstractItemView);
     d->delayedReset.stop(); //make sure we stop the timer
+    d->clearPixmapCache();
     foreach (const QEditorInfo &info, d->indexEditorHash) {
         if (info.widget)
             d->releaseEditor(info.widget.data(), d->indexForEditor(info.widget.data()));
@@ -1618,6 +1620,40 @@ Qt::TextElideMode QAbstractItemView::textElideMode() const
     return d_func()->textElideMode;
 }
 
+/*!
+    \property QAbstractItemView::itemPixmapCacheEnabled
+    \since 5.11
+
+    \brief whether the view caches the painted items in pixmaps
+
+    When enabled, the view keeps what the item delegate painted for each
+    index in a pixmap, and draws the pixmap again when the item is repainted
+    in the same state and size, for example while scrolling. This can make
+    repainting views with many visible items, or with expensive delegates,
+    considerably faster.
+
+    The cached pixmap of an item is discarded when the model reports its data
+    as changed, when the structure or layout of the model changes, and when
+    the style, palette or font changes. Delegates whose painting depends on
+    anything else must not be used with this cache. Text painted into a pixmap
+    does not use subpixel antialiasing.
+
+    The default value is \c false.
+*/
+void QAbstractItemView::setItemPixmapCacheEnabled(bool enable)
+{
+    Q_D(QAbstractItemView);
+    if (d->itemPixmapCacheEnabled == enable)
+        return;
+    d->itemPixmapCacheEnabled = enable;
+    d->clearPixmapCache();
+}
+
+bool QAbstractItemView::isItemPixmapCacheEnabled() const
+{
+    return d_func()->itemPixmapCacheEnabled;
+}
+
 /*!
   \reimp
 */
@@ -1655,6 +1691,7 @@ bool QAbstractItemView::event(QEvent *event)
         }
         break;
     case QEvent::LocaleChange:
+        d->clearPixmapCache();
         viewport()->update();
         break;
     case QEvent::LayoutDirectionChange:
@@ -1662,6 +1699,7 @@ bool QAbstractItemView::event(QEvent *event)
         updateGeometries();
         break;
     case QEvent::StyleChange:
+        d->clearPixmapCache();
         doItemsLayout();
         if (!d->verticalScrollModeSet)
             resetVerticalScrollMode();
@@ -3306,6 +3344,7 @@ void QAbstractItemView::dataChanged(const QModelIndex &topLeft, const QModelInde
     Q_UNUSED(roles);
     // Single item changed
     Q_D(QAbstractItemView);
+    d->removeCachedPixmaps(topLeft, bottomRight);
     if (topLeft == bottomRight && topLeft.isValid()) {
         const QEditorInfo &editorInfo = d->editorForIndex(topLeft);
         //we don't update the edit data if it is static
@@ -3425,6 +3464,7 @@ void QAbstractItemViewPrivate::_q_rowsRemoved(const QModelIndex &index, int star
     Q_UNUSED(start)
     Q_UNUSED(end)
 
+    clearPixmapCache();
     Q_Q(QAbstractItemView);
     if (q->isVisible())
         q->updateEditorGeometries();
@@ -3506,6 +3546,7 @@ void QAbstractItemViewPrivate::_q_columnsRemoved(const QModelIndex &index, int s
     Q_UNUSED(start)
     Q_UNUSED(end)
 
+    clearPixmapCache();
     Q_Q(QAbstractItemView);
     if (q->isVisible())
         q->updateEditorGeometries();
@@ -3533,6 +3574,8 @@ void QAbstractItemViewPrivate::_q_rowsInserted(const QModelIndex &index, int sta
     Q_UNUSED(start)
     Q_UNUSED(end)
 
+    clearPixmapCache();
+
 #ifndef QT_NO_ACCESSIBILITY
     Q_Q(QAbstractItemView);
     if (QAccessible::isActive()) {
@@ -3556,6 +3599,7 @@ void QAbstractItemViewPrivate::_q_columnsInserted(const QModelIndex &index, int
     Q_UNUSED(start)
     Q_UNUSED(end)
 
+    clearPixmapCache();
     Q_Q(QAbstractItemView);
     if (q->isVisible())
         q->updateEditorGeometries();
@@ -3575,6 +3619,7 @@ void QAbstractItemViewPrivate::_q_columnsInserted(const QModelIndex &index, int
 */
 void QAbstractItemViewPrivate::_q_modelDestroyed()
 {
+    clearPixmapCache();
     model = QAbstractItemModelPrivate::staticEmptyModel();
     doDelayedReset();
 }
@@ -3586,6 +3631,7 @@ void QAbstractItemViewPrivate::_q_modelDestroyed()
 */
 void QAbstractItemViewPrivate::_q_layoutChanged()
 {
+    clearPixmapCache();
     doDelayedItemsLayout();
 #ifndef QT_NO_ACCESSIBILITY
     Q_Q(QAbstractItemView);
@@ -3596,6 +3642,97 @@ void QAbstractItemViewPrivate::_q_layoutChanged()
 #endif
 }
 
+static inline bool qt_sameCachedItemOption(const QStyleOptionViewItem &a, const QStyleOptionViewItem &b)
+{
+    return a.rect.size() == b.rect.size()
+        && a.state == b.state
+        && a.features == b.features
+        && a.viewItemPosition == b.viewItemPosition
+        && a.direction == b.direction
+        && a.decorationSize == b.decorationSize
+        && a.decorationAlignment == b.decorationAlignment
+        && a.decorationPosition == b.decorationPosition
+        && a.displayAlignment == b.displayAlignment
+        && a.textElideMode == b.textElideMode
+        && a.showDecorationSelected == b.showDecorationSelected
+        && a.palette.cacheKey() == b.palette.cacheKey()
+        && a.font == b.font;
+}
+
+/*!
+    \internal
+
+    Paints the item at \a index with its delegate, reusing the pixmap painted
+    for the same index, delegate and item options when the item pixmap cache
+    is enabled.
+*/
+void QAbstractItemViewPrivate::paintItem(QPainter *painter, const QStyleOptionViewItem &option,
+                                         const QModelIndex &index) const
+{
+    QAbstractItemDelegate *delegate = delegateForIndex(index);
+    if (!delegate)
+        return;
+    if (!itemPixmapCacheEnabled || option.rect.isEmpty()) {
+        delegate->paint(painter, option, index);
+        return;
+    }
+
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QItemViewCachedPixmap *cached = itemPixmapCache.object(index);
+    if (cached && cached->delegate == delegate && cached->devicePixelRatio == dpr
+        && qt_sameCachedItemOption(cached->option, option)) {
+        painter->drawPixmap(option.rect.topLeft(), cached->pixmap);
+        return;
+    }
+
+    QPixmap pixmap(option.rect.size() * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter pixmapPainter(&pixmap);
+        pixmapPainter.setRenderHints(painter->renderHints());
+        pixmapPainter.setFont(painter->font());
+        pixmapPainter.setPen(painter->pen());
+        pixmapPainter.translate(-option.rect.topLeft());
+        delegate->paint(&pixmapPainter, option, index);
+    }
+    painter->drawPixmap(option.rect.topLeft(), pixmap);
+
+    // keep at least a few screens full of items, the cost is in kilobytes
+    const QSize viewportSize = viewport->size() * dpr;
+    itemPixmapCache.setMaxCost(qMax(10240, viewportSize.width() * viewportSize.height() * 4 * 3 / 1024));
+    const int cost = qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / (8 * 1024));
+    itemPixmapCache.insert(index, new QItemViewCachedPixmap{pixmap, option, delegate, dpr}, cost);
+}
+
+/*!
+    \internal
+
+    Discards the cached pixmaps of the items from \a topLeft to \a bottomRight.
+*/
+void QAbstractItemViewPrivate::removeCachedPixmaps(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (itemPixmapCache.isEmpty())
+        return;
+    if (!topLeft.isValid() || !bottomRight.isValid()) {
+        itemPixmapCache.clear();
+        return;
+    }
+    if (topLeft == bottomRight) {
+        itemPixmapCache.remove(topLeft);
+        return;
+    }
+    const QModelIndex parent = topLeft.parent();
+    const QList<QModelIndex> cachedIndexes = itemPixmapCache.keys();
+    for (const QModelIndex &index : cachedIndexes) {
+        if (index.row() >= topLeft.row() && index.row() <= bottomRight.row()
+            && index.column() >= topLeft.column() && index.column() <= bottomRight.column()
+            && index.parent() == parent) {
+            itemPixmapCache.remove(index);
+        }
+    }
+}
+
 void QAbstractItemViewPrivate::_q_rowsMoved(const QModelIndex &, int, int, const QModelIndex &, int)
 {
   _q_layoutChanged();
@@ -79,6 +79,7 @@ class Q_WIDGETS_EXPORT QAbstractItemView : public QAbstractScrollArea
     Q_PROPERTY(Qt::TextElideMode textElideMode READ textElideMode WRITE setTextElideMode)
     Q_PROPERTY(ScrollMode verticalScrollMode READ verticalScrollMode WRITE setVerticalScrollMode RESET resetVerticalScrollMode)
     Q_PROPERTY(ScrollMode horizontalScrollMode READ horizontalScrollMode WRITE setHorizontalScrollMode RESET resetHorizontalScrollMode)
+    Q_PROPERTY(bool itemPixmapCacheEnabled READ isItemPixmapCacheEnabled WRITE setItemPixmapCacheEnabled)
 
 public:
     enum SelectionMode {
@@ -200,6 +201,9 @@ public:
     void setTextElideMode(Qt::TextElideMode mode);
     Qt::TextElideMode textElideMode() const;
 
+    void setItemPixmapCacheEnabled(bool enable);
+    bool isItemPixmapCacheEnabled() const;
+
     virtual void keyboardSearch(const QString &search);
 
     virtual QRect visualRect(const QModelIndex &index) const = 0;
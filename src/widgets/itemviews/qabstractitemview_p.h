@@ -63,6 +63,7 @@
 #include "QtCore/qdebug.h"
 #include "QtCore/qbasictimer.h"
 #include "QtCore/qelapsedtimer.h"
+#include "QtCore/qcache.h"
 
 QT_REQUIRE_CONFIG(itemviews);
 
@@ -89,6 +90,13 @@ class QTypeInfo<QItemViewPaintPair> : public QTypeInfoMerger<QItemViewPaintPair,
 
 typedef QVector<QItemViewPaintPair> QItemViewPaintPairs;
 
+struct QItemViewCachedPixmap {
+    QPixmap pixmap;
+    QStyleOptionViewItem option;
+    QAbstractItemDelegate *delegate;
+    qreal devicePixelRatio;
+};
+
 class Q_AUTOTEST_EXPORT QAbstractItemViewPrivate : public QAbstractScrollAreaPrivate
 {
     Q_DECLARE_PUBLIC(QAbstractItemView)
@@ -289,6 +297,10 @@ public:
         return itemDelegate;
     }
 
+    void paintItem(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    void removeCachedPixmaps(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    inline void clearPixmapCache() { itemPixmapCache.clear(); }
+
     inline bool isIndexValid(const QModelIndex &index) const {
          return (index.row() >= 0) && (index.column() >= 0) && (index.model() == model);
     }
@@ -452,6 +464,9 @@ public:
     bool verticalScrollModeSet;
     bool horizontalScrollModeSet;
 
+    bool itemPixmapCacheEnabled;
+    mutable QCache<QModelIndex, QItemViewCachedPixmap> itemPixmapCache;
+
 private:
     mutable QBasicTimer delayedLayout;
     mutable QBasicTimer fetchMoreTimer;
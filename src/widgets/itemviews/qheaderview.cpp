@@ -1881,17 +1881,19 @@ void QHeaderView::sectionsInserted(const QModelIndex &parent,
     }
 
     QHeaderViewPrivate::SectionItem section(d->defaultSectionSize, d->globalResizeMode);
-    d->sectionStartposRecalc = true;
 
     if (d->sectionItems.isEmpty() || insertAt >= d->sectionItems.count()) {
         int insertLength = d->defaultSectionSize * insertCount;
         d->length += insertLength;
+        const int oldCount = d->sectionItems.count();
         d->sectionItems.insert(d->sectionItems.count(), insertCount, section); // append
+        d->appendSectionStartPos(oldCount);
     } else {
         // separate them out into their own sections
         int insertLength = d->defaultSectionSize * insertCount;
         d->length += insertLength;
         d->sectionItems.insert(insertAt, insertCount, section);
+        d->sectionStartposRecalc = true;
     }
 
     // update sorting column
@@ -3295,18 +3297,14 @@ bool QHeaderViewPrivate::isSectionSelected(int section) const
 
 bool QHeaderViewPrivate::isFirstVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
     const SectionItem &item = sectionItems.at(section);
-    return item.size > 0 && item.calculated_startpos == 0;
+    return item.size > 0 && sectionSizeSum(section) == 0;
 }
 
 bool QHeaderViewPrivate::isLastVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
     const SectionItem &item = sectionItems.at(section);
-    return item.size > 0 && item.calculatedEndPos() == length;
+    return item.size > 0 && sectionSizeSum(section) + int(item.size) == length;
 }
 
 /*!
@@ -3505,13 +3503,22 @@ void QHeaderViewPrivate::createSectionItems(int start, int end, int size, QHeade
 {
     int sizePerSection = size / (end - start + 1);
     if (end >= sectionItems.count()) {
+        const int oldCount = sectionItems.count();
         sectionItems.resize(end + 1);
-        sectionStartposRecalc = true;
+        appendSectionStartPos(oldCount);
     }
+    // Updating the position tree section by section only pays off for small ranges
+    const bool updatePositions = (end - start) < 64;
     SectionItem *sectiondata = sectionItems.data();
     for (int i = start; i <= end; ++i) {
-        length += (sizePerSection - sectiondata[i].size);
-        sectionStartposRecalc |= (sectiondata[i].size != sizePerSection);
+        const int delta = sizePerSection - int(sectiondata[i].size);
+        if (delta != 0) {
+            length += delta;
+            if (updatePositions)
+                updateSectionStartPos(i, delta);
+            else
+                sectionStartposRecalc = true;
+        }
         sectiondata[i].size = sizePerSection;
         sectiondata[i].resizeMode = mode;
     }
@@ -3519,7 +3526,7 @@ void QHeaderViewPrivate::createSectionItems(int start, int end, int size, QHeade
 
 void QHeaderViewPrivate::removeSectionsFromSectionItems(int start, int end)
 {
-    // remove sections
+    // remove sections, the position tree stays valid when removing from the end
     sectionStartposRecalc |= (end != sectionItems.count() - 1);
     int removedlength = 0;
     for (int u = start; u <= end; ++u)
@@ -3710,16 +3717,65 @@ void QHeaderViewPrivate::updateDefaultSectionSizeFromStyle()
     }
 }
 
+/*
+    The section positions are kept in a binary indexed tree over the section
+    sizes, stored in SectionItem::calculated_sizesum. Node k (counting from 1)
+    holds the total size of the sections k - lowbit(k) to k - 1. Resizing a
+    section and mapping between positions and sections then take logarithmic
+    time, which keeps headers with millions of sections responsive.
+*/
 void QHeaderViewPrivate::recalcSectionStartPos() const // linear (but fast)
 {
-    int pixelpos = 0;
-    for (QVector<SectionItem>::const_iterator i = sectionItems.constBegin(); i != sectionItems.constEnd(); ++i) {
-        i->calculated_startpos = pixelpos; // write into const mutable
-        pixelpos += i->size;
+    const int count = sectionItems.count();
+    const SectionItem *sections = sectionItems.constData();
+    for (int i = 0; i < count; ++i)
+        sections[i].calculated_sizesum = sections[i].size; // write into const mutable
+    for (int k = 1; k <= count; ++k) {
+        const int parent = k + (k & -k);
+        if (parent <= count)
+            sections[parent - 1].calculated_sizesum += sections[k - 1].calculated_sizesum;
     }
     sectionStartposRecalc = false;
 }
 
+// Adds the tree nodes for the sections appended after \a from.
+void QHeaderViewPrivate::appendSectionStartPos(int from) const
+{
+    if (sectionStartposRecalc)
+        return;
+    const int count = sectionItems.count();
+    const SectionItem *sections = sectionItems.constData();
+    for (int k = from + 1; k <= count; ++k) {
+        int sum = sections[k - 1].size;
+        const int first = k - (k & -k);
+        for (int child = k - 1; child > first; child -= child & -child)
+            sum += sections[child - 1].calculated_sizesum;
+        sections[k - 1].calculated_sizesum = sum;
+    }
+}
+
+void QHeaderViewPrivate::updateSectionStartPos(int visual, int delta) const
+{
+    if (sectionStartposRecalc)
+        return;
+    const int count = sectionItems.count();
+    const SectionItem *sections = sectionItems.constData();
+    for (int k = visual + 1; k <= count; k += k & -k)
+        sections[k - 1].calculated_sizesum += delta;
+}
+
+// Returns the total size of the first \a count sections.
+int QHeaderViewPrivate::sectionSizeSum(int count) const
+{
+    if (sectionStartposRecalc)
+        recalcSectionStartPos();
+    const SectionItem *sections = sectionItems.constData();
+    int sum = 0;
+    for (int k = count; k > 0; k -= k & -k)
+        sum += sections[k - 1].calculated_sizesum;
+    return sum;
+}
+
 void QHeaderViewPrivate::resizeSectionItem(int visualIndex, int oldSize, int newSize)
 {
     Q_Q(QHeaderView);
@@ -3737,32 +3793,35 @@ int QHeaderViewPrivate::headerSectionSize(int visual) const
 
 int QHeaderViewPrivate::headerSectionPosition(int visual) const
 {
-    if (visual < sectionCount() && visual >= 0) {
-        if (sectionStartposRecalc)
-            recalcSectionStartPos();
-        return sectionItems.at(visual).calculated_startpos;
-    }
+    if (visual < sectionCount() && visual >= 0)
+        return sectionSizeSum(visual);
     return -1;
 }
 
 int QHeaderViewPrivate::headerVisualIndexAt(int position) const
 {
+    const int count = sectionItems.count();
+    if (position < 0 || count == 0)
+        return -1;
     if (sectionStartposRecalc)
         recalcSectionStartPos();
-    int startidx = 0;
-    int endidx = sectionItems.count() - 1;
-    while (startidx <= endidx) {
-        int middle = (endidx + startidx) / 2;
-        if (sectionItems.at(middle).calculated_startpos > position) {
-            endidx = middle - 1;
-        } else {
-            if (sectionItems.at(middle).calculatedEndPos() <= position)
-                startidx = middle + 1;
-            else // we found it.
-                return middle;
+
+    // Find the number of sections that end at or before position by
+    // descending the tree; the next section is the one containing it.
+    const SectionItem *sections = sectionItems.constData();
+    int step = 1;
+    while (step <= count / 2)
+        step *= 2;
+    int visual = 0;
+    int remaining = position;
+    for (; step > 0; step /= 2) {
+        const int next = visual + step;
+        if (next <= count && sections[next - 1].calculated_sizesum <= remaining) {
+            visual = next;
+            remaining -= sections[next - 1].calculated_sizesum;
         }
     }
-    return -1;
+    return visual < count ? visual : -1;
 }
 
 void QHeaderViewPrivate::setHeaderSectionResizeMode(int visual, QHeaderView::ResizeMode mode)
@@ -311,16 +311,15 @@ public:
         uint currentlyUnusedPadding : 6;
 
         union { // This union is made in order to save space and ensure good vector performance (on remove)
-            mutable int calculated_startpos; // <- this is the primary used member.
+            mutable int calculated_sizesum; // <- this is the primary used member (a node of the position tree).
             mutable int tmpLogIdx;         // When one of these 'tmp'-members has been used we call
             int tmpDataStreamSectionCount; // recalcSectionStartPos() or set sectionStartposRecalc to true
-        };                                 // to ensure that calculated_startpos will be calculated afterwards.
+        };                                 // to ensure that calculated_sizesum will be calculated afterwards.
 
         inline SectionItem() : size(0), isHidden(0), resizeMode(QHeaderView::Interactive) {}
         inline SectionItem(int length, QHeaderView::ResizeMode mode)
-            : size(length), isHidden(0), resizeMode(mode), calculated_startpos(-1) {}
+            : size(length), isHidden(0), resizeMode(mode), calculated_sizesum(0) {}
         inline int sectionSize() const { return size; }
-        inline int calculatedEndPos() const { return calculated_startpos + size; }
 #ifndef QT_NO_DATASTREAM
         inline void write(QDataStream &out) const
         { out << static_cast<int>(size); out << 1; out << (int)resizeMode; }
@@ -342,6 +341,9 @@ public:
     void setDefaultSectionSize(int size);
     void updateDefaultSectionSizeFromStyle();
     void recalcSectionStartPos() const; // not really const
+    void appendSectionStartPos(int from) const;
+    void updateSectionStartPos(int visual, int delta) const;
+    int sectionSizeSum(int count) const;
 
     inline int headerLength() const { // for debugging
         int len = 0;
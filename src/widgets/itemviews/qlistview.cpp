@@ -1036,7 +1036,7 @@ void QListView::paintEvent(QPaintEvent *e)
             previousRow = row;
         }
 
-        d->delegateForIndex(*it)->paint(&painter, option, *it);
+        d->paintItem(&painter, option, *it);
     }
 
 #ifndef QT_NO_DRAGANDDROP
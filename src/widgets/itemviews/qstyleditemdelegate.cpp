@@ -278,28 +278,40 @@ QString QStyledItemDelegate::displayText(const QVariant &value, const QLocale& l
 void QStyledItemDelegate::initStyleOption(QStyleOptionViewItem *option,
                                          const QModelIndex &index) const
 {
-    QVariant value = index.data(Qt::FontRole);
+    QModelRoleData roleData[] = {
+        QModelRoleData(Qt::FontRole),
+        QModelRoleData(Qt::TextAlignmentRole),
+        QModelRoleData(Qt::ForegroundRole),
+        QModelRoleData(Qt::CheckStateRole),
+        QModelRoleData(Qt::DecorationRole),
+        QModelRoleData(Qt::DisplayRole),
+        QModelRoleData(Qt::BackgroundRole)
+    };
+    const QModelRoleDataSpan roles(roleData);
+    index.multiData(roles);
+
+    QVariant value = *roles.dataForRole(Qt::FontRole);
     if (value.isValid() && !value.isNull()) {
         option->font = qvariant_cast<QFont>(value).resolve(option->font);
         option->fontMetrics = QFontMetrics(option->font);
     }
 
-    value = index.data(Qt::TextAlignmentRole);
+    value = *roles.dataForRole(Qt::TextAlignmentRole);
     if (value.isValid() && !value.isNull())
         option->displayAlignment = Qt::Alignment(value.toInt());
 
-    value = index.data(Qt::ForegroundRole);
+    value = *roles.dataForRole(Qt::ForegroundRole);
     if (value.canConvert<QBrush>())
         option->palette.setBrush(QPalette::Text, qvariant_cast<QBrush>(value));
 
     option->index = index;
-    value = index.data(Qt::CheckStateRole);
+    value = *roles.dataForRole(Qt::CheckStateRole);
     if (value.isValid() && !value.isNull()) {
         option->features |= QStyleOptionViewItem::HasCheckIndicator;
         option->checkState = static_cast<Qt::CheckState>(value.toInt());
     }
 
-    value = index.data(Qt::DecorationRole);
+    value = *roles.dataForRole(Qt::DecorationRole);
     if (value.isValid() && !value.isNull()) {
         option->features |= QStyleOptionViewItem::HasDecoration;
         switch (value.type()) {
@@ -342,13 +354,13 @@ void QStyledItemDelegate::initStyleOption(QStyleOptionViewItem *option,
         }
     }
 
-    value = index.data(Qt::DisplayRole);
+    value = *roles.dataForRole(Qt::DisplayRole);
     if (value.isValid() && !value.isNull()) {
         option->features |= QStyleOptionViewItem::HasDisplay;
         option->text = displayText(value, option->locale);
     }
 
-    option->backgroundBrush = qvariant_cast<QBrush>(index.data(Qt::BackgroundRole));
+    option->backgroundBrush = qvariant_cast<QBrush>(*roles.dataForRole(Qt::BackgroundRole));
 
     // disable style animations for checkboxes etc. within itemviews (QTBUG-30146)
     option->styleObject = 0;
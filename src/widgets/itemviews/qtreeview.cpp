@@ -1771,7 +1771,7 @@ void QTreeView::drawRow(QPainter *painter, const QStyleOptionViewItem &option,
             opt.state = oldState;
         }
 
-        d->delegateForIndex(modelIndex)->paint(painter, opt, modelIndex);
+        d->paintItem(painter, opt, modelIndex);
     }
 
     if (currentRowHasFocus) {
@@ -2560,7 +2560,14 @@ void QTreeView::rowsInserted(const QModelIndex &parent, int start, int end)
     const int parentItem = d->viewIndex(parent);
     if (((parentItem != -1) && d->viewItems.at(parentItem).expanded)
         || (parent == d->root)) {
-        d->doDelayedItemsLayout();
+        // rows appended to a parent can be added without a complete relayout
+        if (start == parentRowCount - delta && (parentItem != -1 || !d->viewItems.isEmpty())
+            && d->appendRowItems(parentItem, parent, start, end)) {
+            updateGeometries();
+            d->viewport->update();
+        } else {
+            d->doDelayedItemsLayout();
+        }
     } else if (parentItem != -1 && parentRowCount == delta) {
         // the parent just went from 0 children to more. update to re-paint the decoration
         d->viewItems[parentItem].hasChildren = true;
@@ -2767,14 +2774,9 @@ void QTreeView::expandToDepth(int depth)
     old_expandedIndexes = d->expandedIndexes;
     d->expandedIndexes.clear();
     d->interruptDelayedItemsLayout();
-    d->layout(-1);
-    for (int i = 0; i < d->viewItems.count(); ++i) {
-        if (d->viewItems.at(i).level <= (uint)depth) {
-            d->viewItems[i].expanded = true;
-            d->layout(i);
-            d->storeExpanded(d->viewItems.at(i).index);
-        }
-    }
+    // expand the items while laying them out, instead of inserting
+    // the children of every expanded item into the laid out items
+    d->layout(-1, false, false, depth >= 0 ? depth : INT_MAX);
 
     bool someSignalEnabled = isSignalConnected(QMetaMethod::fromSignal(&QTreeView::collapsed));
     someSignalEnabled |= isSignalConnected(QMetaMethod::fromSignal(&QTreeView::expanded));
@@ -3305,10 +3307,12 @@ void QTreeViewPrivate::_q_columnsRemoved(const QModelIndex &parent, int start, i
     creates and initialize the viewItem structure of the children of the element \li
 
     set \a recursiveExpanding if the function has to expand all the children (called from expandAll)
+    \a maxExpandedLevel expands all items up to that level, without emitting expanded().
     \a afterIsUninitialized is when we recurse from layout(-1), it means all the items after 'i' are
     not yet initialized and need not to be moved
  */
-void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninitialized)
+void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninitialized,
+                              int maxExpandedLevel)
 {
     Q_Q(QTreeView);
     QModelIndex current;
@@ -3347,6 +3351,7 @@ void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninit
 
     int first = i + 1;
     int level = (i >= 0 ? viewItems.at(i).level + 1 : 0);
+    const bool expandChildren = recursiveExpanding || level <= maxExpandedLevel;
     int hidden = 0;
     int last = 0;
     int children = 0;
@@ -3369,11 +3374,11 @@ void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninit
             item->expanded = false;
             item->total = 0;
             item->hasMoreSiblings = false;
-            if ((recursiveExpanding && !(current.flags() & Qt::ItemNeverHasChildren)) || isIndexExpanded(current)) {
-                if (recursiveExpanding && storeExpanded(current) && !q->signalsBlocked())
+            if ((expandChildren && !(current.flags() & Qt::ItemNeverHasChildren)) || isIndexExpanded(current)) {
+                if (expandChildren && storeExpanded(current) && recursiveExpanding && !q->signalsBlocked())
                     emit q->expanded(current);
                 item->expanded = true;
-                layout(last, recursiveExpanding, afterIsUninitialized);
+                layout(last, recursiveExpanding, afterIsUninitialized, maxExpandedLevel);
                 item = &viewItems[last];
                 children += item->total;
                 item->hasChildren = item->total > 0;
@@ -3401,6 +3406,54 @@ void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninit
     }
 }
 
+/*!
+    \internal
+    Adds the rows \a start to \a end that were appended to \a parent, whose item is
+    \a parentItem (-1 for the root), after the last visible descendant of the parent.
+    Only the items following the new ones are touched, so appending to a huge tree
+    does not require laying out all items again.
+    Returns \c false if the new rows need a complete relayout.
+*/
+bool QTreeViewPrivate::appendRowItems(int parentItem, const QModelIndex &parent, int start, int end)
+{
+    Q_Q(QTreeView);
+    for (int row = start; row <= end; ++row) {
+        const QModelIndex index = model->index(row, 0, parent);
+        if (!index.isValid() || isRowHidden(index) || isIndexExpanded(index))
+            return false;
+    }
+
+    const int count = end - start + 1;
+    const int pos = (parentItem == -1 ? viewItems.count()
+                                      : parentItem + int(viewItems.at(parentItem).total) + 1);
+    const uint level = (parentItem == -1 ? 0 : viewItems.at(parentItem).level + 1);
+
+    // the previous last child now has more siblings
+    int previous = pos - 1;
+    while (previous > parentItem && viewItems.at(previous).parentItem != parentItem)
+        previous = viewItems.at(previous).parentItem;
+    if (previous > parentItem)
+        viewItems[previous].hasMoreSiblings = true;
+
+    insertViewItems(pos, count, QTreeViewItem());
+    QTreeViewItem *items = viewItems.data();
+    for (int row = start; row <= end; ++row) {
+        QTreeViewItem &item = items[pos + row - start];
+        item.index = model->index(row, 0, parent);
+        item.parentItem = parentItem;
+        item.level = level;
+        item.spanning = q->isFirstColumnSpanned(row, parent);
+        item.hasChildren = hasVisibleChildren(item.index);
+        item.hasMoreSiblings = row < end;
+    }
+
+    for (int i = parentItem; i > -1; i = items[i].parentItem)
+        items[i].total += count;
+    if (parentItem != -1)
+        items[parentItem].hasChildren = true;
+    return true;
+}
+
 int QTreeViewPrivate::pageUp(int i) const
 {
     int index = itemAtCoordinate(coordinateForItem(i) - viewport->height());
@@ -134,7 +134,9 @@ public:
     void _q_sortIndicatorChanged(int column, Qt::SortOrder order);
     void _q_modelDestroyed() override;
 
-    void layout(int item, bool recusiveExpanding = false, bool afterIsUninitialized = false);
+    void layout(int item, bool recusiveExpanding = false, bool afterIsUninitialized = false,
+                int maxExpandedLevel = -1);
+    bool appendRowItems(int parentItem, const QModelIndex &parent, int start, int end);
 
     int pageUp(int item) const;
     int pageDown(int item) const;
@@ -966,26 +966,15 @@ bool QApplication::compressEvent(QEvent *event, QObject *receiver, QPostEventLis
           || event->type() == QEvent::Resize
           || event->type() == QEvent::Move
           || event->type() == QEvent::LanguageChange)) {
-        for (QPostEventList::const_iterator it = postedEvents->constBegin(); it != postedEvents->constEnd(); ++it) {
-            const QPostEvent &cur = *it;
-            if (cur.receiver != receiver || cur.event == 0 || cur.event->type() != event->type())
-                continue;
-            if (cur.event->type() == QEvent::LayoutRequest
-                 || cur.event->type() == QEvent::UpdateRequest) {
-                ;
-            } else if (cur.event->type() == QEvent::Resize) {
-                ((QResizeEvent *)(cur.event))->s = ((QResizeEvent *)event)->s;
-            } else if (cur.event->type() == QEvent::Move) {
-                ((QMoveEvent *)(cur.event))->p = ((QMoveEvent *)event)->p;
-            } else if (cur.event->type() == QEvent::LanguageChange) {
-                ;
-            } else {
-                continue;
-            }
-            delete event;
-            return true;
-        }
-        return false;
+        QEvent *cur = postedEvents->findCompressible(receiver, event->type());
+        if (!cur)
+            return false;
+        if (cur->type() == QEvent::Resize)
+            static_cast<QResizeEvent *>(cur)->s = static_cast<QResizeEvent *>(event)->s;
+        else if (cur->type() == QEvent::Move)
+            static_cast<QMoveEvent *>(cur)->p = static_cast<QMoveEvent *>(event)->p;
+        delete event;
+        return true;
     }
     return QGuiApplication::compressEvent(event, receiver, postedEvents);
 }
@@ -163,7 +163,7 @@ QLayout::QLayout(QLayoutPrivate &dd, QLayout *lay, QWidget *w)
 QLayoutPrivate::QLayoutPrivate()
     : QObjectPrivate(), insideSpacing(-1), userLeftMargin(-1), userTopMargin(-1), userRightMargin(-1),
       userBottomMargin(-1), topLevel(false), enabled(true), activated(true), autoNewChild(false),
-      constraint(QLayout::SetDefaultConstraint), menubar(0)
+      invalidateSubtree(false), constraint(QLayout::SetDefaultConstraint), menubar(0)
 {
 }
 
@@ -553,6 +553,7 @@ void QLayout::invalidate()
 {
     Q_D(QLayout);
     d->rect = QRect();
+    d->invalidateSubtree = true;
     update();
 }
 
@@ -1007,15 +1008,67 @@ Qt::Orientations QLayout::expandingDirections() const
 
 void QLayout::activateRecursiveHelper(QLayoutItem *item)
 {
-    item->invalidate();
+    QLayoutPrivate::activateRecursiveHelper(item, false);
+}
+
+/*!
+    \internal
+
+    Invalidates the parts of the layout tree rooted at \a item that need to
+    be recalculated, or all of it if \a invalidateAll is true.
+
+    update() clears the activated flag of a layout and of all its ancestors,
+    so an activated layout and everything inside it are unchanged since the
+    last activation and keep their cached geometry. Only the layouts that
+    were invalidated and the ones on the path to them are recalculated.
+    Explicitly invalidating a layout also invalidates all layouts inside it.
+*/
+void QLayoutPrivate::activateRecursiveHelper(QLayoutItem *item, bool invalidateAll)
+{
     QLayout *layout = item->layout();
-    if (layout) {
-        QLayoutItem *child;
-        int i=0;
-        while ((child = layout->itemAt(i++)))
-            activateRecursiveHelper(child);
-        layout->d_func()->activated = true;
+    if (!layout) {
+        item->invalidate();
+        return;
     }
+    QLayoutPrivate *d = layout->d_func();
+    if (d->activated && !invalidateAll)
+        return;
+    invalidateAll = invalidateAll || d->invalidateSubtree;
+    layout->invalidate();
+    QLayoutItem *child;
+    int i = 0;
+    while ((child = layout->itemAt(i++)))
+        activateRecursiveHelper(child, invalidateAll);
+    d->invalidateSubtree = false;
+    d->activated = true;
+}
+
+static QLayout *findLayoutContaining(QLayout *layout, const QLayoutItem *item)
+{
+    QLayoutItem *child;
+    int i = 0;
+    while ((child = layout->itemAt(i++))) {
+        if (child == item)
+            return layout;
+        if (QLayout *childLayout = child->layout()) {
+            if (QLayout *found = findLayoutContaining(childLayout, item))
+                return found;
+        }
+    }
+    return 0;
+}
+
+/*!
+    \internal
+
+    Invalidates the innermost layout in the tree of \a layout that contains
+    \a item, so that only that branch is recalculated on the next
+    activation. Invalidates \a layout itself if \a item is not found.
+*/
+void QLayoutPrivate::invalidateLayoutContaining(QLayout *layout, const QLayoutItem *item)
+{
+    QLayout *found = item ? findLayoutContaining(layout, item) : 0;
+    (found ? found : layout)->invalidate();
 }
 
 /*!
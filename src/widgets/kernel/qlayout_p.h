@@ -78,6 +78,9 @@ public:
     bool checkWidget(QWidget *widget) const;
     bool checkLayout(QLayout *otherLayout) const;
 
+    static void activateRecursiveHelper(QLayoutItem *item, bool invalidateAll);
+    static void invalidateLayoutContaining(QLayout *layout, const QLayoutItem *item);
+
     static QWidgetItem *createWidgetItem(const QLayout *layout, QWidget *widget);
     static QSpacerItem *createSpacerItem(const QLayout *layout, int w, int h, QSizePolicy::Policy hPolicy = QSizePolicy::Minimum, QSizePolicy::Policy vPolicy = QSizePolicy::Minimum);
     virtual QLayoutItem* replaceAt(int index, QLayoutItem *newitem) { Q_UNUSED(index); Q_UNUSED(newitem); return 0; }
@@ -94,6 +97,7 @@ public:
     uint enabled : 1;
     uint activated : 1;
     uint autoNewChild : 1;
+    uint invalidateSubtree : 1;
     QLayout::SizeConstraint constraint;
     QRect rect;
     QWidget *menubar;
@@ -5676,7 +5676,15 @@ void QWidgetPrivate::sendPaintEvent(const QRegion &toBePainted)
 {
     Q_Q(QWidget);
     QPaintEvent e(toBePainted);
+    QElapsedTimer paintTimer;
+    const bool logPainting = lcWidgetPainting().isDebugEnabled();
+    if (Q_UNLIKELY(logPainting))
+        paintTimer.start();
     QCoreApplication::sendSpontaneousEvent(q, &e);
+    if (Q_UNLIKELY(logPainting)) {
+        qCDebug(lcWidgetPainting) << "Painted" << q << toBePainted.boundingRect()
+                                  << "in" << paintTimer.nsecsElapsed() / 1000 << "us";
+    }
 
 #ifndef QT_NO_OPENGL
     if (renderToTexture)
@@ -8368,7 +8376,7 @@ void QWidget::setVisible(bool visible)
         // invalidate layout similar to updateGeometry()
         if (!isWindow() && parentWidget()) {
             if (parentWidget()->d_func()->layout)
-                parentWidget()->d_func()->layout->invalidate();
+                QLayoutPrivate::invalidateLayoutContaining(parentWidget()->d_func()->layout, d->widgetItem);
             else if (parentWidget()->isVisible())
                 QApplication::postEvent(parentWidget(), new QEvent(QEvent::LayoutRequest));
         }
@@ -10448,7 +10456,7 @@ void QWidgetPrivate::updateGeometry_helper(bool forceUpdate)
 
         if (!q->isWindow() && !isHidden && (parent = q->parentWidget())) {
             if (parent->d_func()->layout)
-                parent->d_func()->layout->invalidate();
+                QLayoutPrivate::invalidateLayoutContaining(parent->d_func()->layout, widgetItem);
             else if (parent->isVisible())
                 QApplication::postEvent(parent, new QEvent(QEvent::LayoutRequest));
         }
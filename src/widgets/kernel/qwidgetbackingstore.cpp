@@ -69,6 +69,8 @@
 
 QT_BEGIN_NAMESPACE
 
+Q_LOGGING_CATEGORY(lcWidgetPainting, "qt.widgets.painting")
+
 extern QRegion qt_dirtyRegion(QWidget *);
 
 #ifndef QT_NO_OPENGL
@@ -149,6 +151,14 @@ void QWidgetBackingStore::qt_flush(QWidget *widget, const QRegion &region, QBack
     } else
 #endif
         backingStore->flush(effectiveRegion, widget->windowHandle(), offset);
+
+    if (Q_UNLIKELY(lcWidgetPainting().isDebugEnabled())) {
+        qint64 area = 0;
+        for (const QRect &r : effectiveRegion)
+            area += qint64(r.width()) * r.height();
+        qCDebug(lcWidgetPainting) << "Flushed" << area << "pixels in" << effectiveRegion.rectCount()
+                                  << "rects of" << widget;
+    }
 }
 
 #ifndef QT_NO_PAINT_DEBUG
@@ -489,6 +499,16 @@ void QWidgetBackingStore::sendUpdateRequest(QWidget *widget, UpdateTime updateTi
     switch (updateTime) {
     case UpdateLater:
         updateRequestSent = true;
+        if (widget == tlw && QCoreApplication::testAttribute(Qt::AA_PaceWidgetUpdates)) {
+            // Let the platform deliver the request in step with the display
+            // refresh; QWidgetWindow hands it back to syncPacedUpdate().
+            QWindow *window = tlw->windowHandle();
+            if (window && window->handle()) {
+                updateRequestPaced = true;
+                window->requestUpdate();
+                break;
+            }
+        }
         QApplication::postEvent(widget, new QEvent(QEvent::UpdateRequest), Qt::LowEventPriority);
         break;
     case UpdateNow: {
@@ -773,6 +793,7 @@ QWidgetBackingStore::QWidgetBackingStore(QWidget *topLevel)
     : tlw(topLevel),
       dirtyOnScreenWidgets(0),
       updateRequestSent(0),
+      updateRequestPaced(0),
       textureListWatcher(0),
       perfFrames(0)
 {
@@ -960,22 +981,27 @@ static void findTextureWidgetsRecursively(QWidget *tlw, QWidget *widget, QPlatfo
     }
 }
 
-static void findAllTextureWidgetsRecursively(QWidget *tlw, QWidget *widget)
+static void findAllTextureWidgetsRecursively(QWidget *tlw, QWidget *widget,
+                                             QVector<QPlatformTextureList *> *unusedLists)
 {
     // textureChildSeen does not take native child widgets into account and that's good.
     if (QWidgetPrivate::get(widget)->textureChildSeen) {
         QVector<QWidget *> nativeChildren;
-        QScopedPointer<QPlatformTextureList> tl(new QPlatformTextureList);
+        // Reuse the lists of the previous sync instead of allocating new ones every frame.
+        QPlatformTextureList *tl = unusedLists->isEmpty() ? new QPlatformTextureList
+                                                          : unusedLists->takeLast();
         // Look for texture widgets (incl. widget itself) from 'widget' down,
         // but skip subtrees with a parent of a native child widget.
-        findTextureWidgetsRecursively(tlw, widget, tl.data(), &nativeChildren);
+        findTextureWidgetsRecursively(tlw, widget, tl, &nativeChildren);
         // tl may be empty regardless of textureChildSeen if we have native or hidden children.
         if (!tl->isEmpty())
-            QWidgetPrivate::get(tlw)->topData()->widgetTextures.append(tl.take());
+            QWidgetPrivate::get(tlw)->topData()->widgetTextures.append(tl);
+        else
+            unusedLists->append(tl);
         // Native child widgets, if there was any, get their own separate QPlatformTextureList.
         foreach (QWidget *ncw, nativeChildren) {
             if (QWidgetPrivate::get(ncw)->textureChildSeen)
-                findAllTextureWidgetsRecursively(tlw, ncw);
+                findAllTextureWidgetsRecursively(tlw, ncw, unusedLists);
         }
     }
 }
@@ -1156,6 +1182,21 @@ void QWidgetBackingStore::sync()
         doSync();
 }
 
+/*!
+    Synchronizes the backing store if an update was deferred to the next frame
+    of the top-level window because of Qt::AA_PaceWidgetUpdates.
+
+    Returns \c false if no such update is pending.
+*/
+bool QWidgetBackingStore::syncPacedUpdate()
+{
+    if (!updateRequestPaced)
+        return false;
+    updateRequestPaced = false;
+    sync();
+    return true;
+}
+
 void QWidgetBackingStore::doSync()
 {
     const bool updatesDisabled = !tlw->updatesEnabled();
@@ -1256,9 +1297,12 @@ void QWidgetBackingStore::doSync()
     // The search is cut at native widget boundaries, meaning that each native child widget
     // has its own list for the subtree below it.
     QTLWExtra *tlwExtra = tlw->d_func()->topData();
-    qDeleteAll(tlwExtra->widgetTextures);
-    tlwExtra->widgetTextures.clear();
-    findAllTextureWidgetsRecursively(tlw, tlw);
+    QVector<QPlatformTextureList *> unusedTextureLists;
+    unusedTextureLists.swap(tlwExtra->widgetTextures);
+    for (QPlatformTextureList *tl : qAsConst(unusedTextureLists))
+        tl->clear();
+    findAllTextureWidgetsRecursively(tlw, tlw, &unusedTextureLists);
+    qDeleteAll(unusedTextureLists);
     qt_window_private(tlw->windowHandle())->compositing = false; // will get updated in qt_flush()
 #endif
 
@@ -1277,21 +1321,8 @@ void QWidgetBackingStore::doSync()
             resetWidget(w);
         }
         dirtyRenderToTextureWidgets.clear();
-        for (int i = 0; i < numPaintPending; ++i) {
-            QWidget *w = paintPending[i];
-            w->d_func()->sendPaintEvent(w->rect());
-            if (w != tlw) {
-                QWidget *npw = w->nativeParentWidget();
-                if (w->internalWinId() || (npw && npw != tlw)) {
-                    if (!w->internalWinId())
-                        w = npw;
-                    QWidgetPrivate *wPrivate = w->d_func();
-                    if (!wPrivate->needsFlush)
-                        wPrivate->needsFlush = new QRegion;
-                    appendDirtyOnScreenWidget(w);
-                }
-            }
-        }
+        for (int i = 0; i < numPaintPending; ++i)
+            paintRenderToTextureWidget(paintPending[i]);
 
         // We might have newly exposed areas on the screen if this function was
         // called from sync(QWidget *, QRegion)), so we have to make sure those
@@ -1302,11 +1333,19 @@ void QWidgetBackingStore::doSync()
     }
 
 #ifndef QT_NO_OPENGL
+    // Render-to-texture widgets whose surroundings are not repainted keep the
+    // hole punched for them in the backingstore; only their own texture needs
+    // to be rendered again before it is composed with the rest.
+    QVarLengthArray<QWidget *, 16> texturesPending;
     foreach (QPlatformTextureList *tl, tlwExtra->widgetTextures) {
         for (int i = 0; i < tl->count(); ++i) {
             QWidget *w = static_cast<QWidget *>(tl->source(i));
             if (dirtyRenderToTextureWidgets.contains(w)) {
                 const QRect rect = tl->geometry(i); // mapped to the tlw already
+                if (!toClean.intersects(rect)) {
+                    texturesPending << w;
+                    continue;
+                }
                 // Set a flag to indicate that the paint event for this
                 // render-to-texture widget must not to be optimized away.
                 w->d_func()->renderToTextureReallyDirty = 1;
@@ -1325,6 +1364,14 @@ void QWidgetBackingStore::doSync()
         updateStaticContentsSize();
         dirty = QRegion();
         updateRequestSent = false;
+#ifndef QT_NO_OPENGL
+        // Textures are not composed for proxied widgets, repaint them through the proxy.
+        for (int i = 0; i < texturesPending.size(); ++i) {
+            QWidget *w = texturesPending[i];
+            w->d_func()->renderToTextureReallyDirty = 1;
+            toClean += QRect(w->mapTo(tlw, QPoint()), w->size());
+        }
+#endif
         for (const QRect &rect : toClean)
             tlw->d_func()->extra->proxyWidget->update(rect);
         return;
@@ -1375,9 +1422,34 @@ void QWidgetBackingStore::doSync()
         tlw->d_func()->drawWidget(store->paintDevice(), dirtyCopy, QPoint(), flags, 0, this);
     }
 
+#ifndef QT_NO_OPENGL
+    for (int i = 0; i < texturesPending.size(); ++i)
+        paintRenderToTextureWidget(texturesPending[i]);
+#endif
+
     endPaint(toClean, store, &beginPaintInfo);
 }
 
+/*!
+    Sends a paint event to the render-to-texture widget  w without repainting
+    anything in the backingstore, and makes sure its texture gets composed.
+*/
+void QWidgetBackingStore::paintRenderToTextureWidget(QWidget *w)
+{
+    w->d_func()->sendPaintEvent(w->rect());
+    if (w != tlw) {
+        QWidget *npw = w->nativeParentWidget();
+        if (w->internalWinId() || (npw && npw != tlw)) {
+            if (!w->internalWinId())
+                w = npw;
+            QWidgetPrivate *wPrivate = w->d_func();
+            if (!wPrivate->needsFlush)
+                wPrivate->needsFlush = new QRegion;
+            appendDirtyOnScreenWidget(w);
+        }
+    }
+}
+
 /*!
     Flushes the contents of the backing store into the top-level widget.
     If the \a widget is non-zero, the content is flushed to the \a widget.
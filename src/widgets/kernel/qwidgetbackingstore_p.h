@@ -56,6 +56,7 @@
 #include <QtWidgets/qwidget.h>
 #include <private/qwidget_p.h>
 #include <QtGui/qbackingstore.h>
+#include <QtCore/qloggingcategory.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -63,6 +64,8 @@ class QPlatformTextureList;
 class QPlatformTextureListWatcher;
 class QWidgetBackingStore;
 
+Q_DECLARE_LOGGING_CATEGORY(lcWidgetPainting)
+
 struct BeginPaintInfo {
     inline BeginPaintInfo() : wasFlushed(0), nothingToPaint(0), backingStoreRecreated(0) {}
     uint wasFlushed : 1;
@@ -109,6 +112,7 @@ public:
 
     void sync(QWidget *exposedWidget, const QRegion &exposedRegion);
     void sync();
+    bool syncPacedUpdate();
     void flush(QWidget *widget = 0);
 
     QBackingStore *backingStore() const { return store; }
@@ -135,12 +139,14 @@ private:
     QList<QWidget *> staticWidgets;
     QBackingStore *store;
     uint updateRequestSent : 1;
+    uint updateRequestPaced : 1;
 
     QPlatformTextureListWatcher *textureListWatcher;
     QElapsedTimer perfTime;
     int perfFrames;
 
     void sendUpdateRequest(QWidget *widget, UpdateTime updateTime);
+    void paintRenderToTextureWidget(QWidget *w);
 
     static bool flushPaint(QWidget *widget, const QRegion &rgn);
     static void unflushPaint(QWidget *widget, const QRegion &rgn);
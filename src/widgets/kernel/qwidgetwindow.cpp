@@ -360,11 +360,17 @@ bool QWidgetWindow::event(QEvent *event)
         qt_button_down = 0;
         break;
 
-    case QEvent::UpdateRequest:
+    case QEvent::UpdateRequest: {
+        // Requested by the backing store on behalf of the widget hierarchy,
+        // see Qt::AA_PaceWidgetUpdates.
+        QWidgetBackingStore *bs = m_widget->d_func()->maybeBackingStore();
+        if (bs && bs->syncPacedUpdate())
+            return true;
         // This is not the same as an UpdateRequest for a QWidget. That just
         // syncs the backing store while here we also must mark as dirty.
         m_widget->repaint();
         return true;
+    }
 
     default:
         break;
@@ -176,43 +176,45 @@ void QLineEditPrivate::init(const QString& txt)
     control = new QWidgetLineControl(txt);
     control->setParent(q);
     control->setFont(q->font());
-    QObject::connect(control, SIGNAL(textChanged(QString)),
-            q, SIGNAL(textChanged(QString)));
-    QObject::connect(control, SIGNAL(textEdited(QString)),
-            q, SLOT(_q_textEdited(QString)));
-    QObject::connect(control, SIGNAL(cursorPositionChanged(int,int)),
-            q, SLOT(_q_cursorPositionChanged(int,int)));
-    QObject::connect(control, SIGNAL(selectionChanged()),
-            q, SLOT(_q_selectionChanged()));
-    QObject::connect(control, SIGNAL(accepted()),
-            q, SIGNAL(returnPressed()));
-    QObject::connect(control, SIGNAL(editingFinished()),
-            q, SIGNAL(editingFinished()));
+    // Use function pointer based connections; resolving the string based
+    // signatures dominates the cost of creating a line edit.
+    QObject::connect(control, &QWidgetLineControl::textChanged,
+                     q, &QLineEdit::textChanged);
+    QObjectPrivate::connect(control, &QWidgetLineControl::textEdited,
+                            this, &QLineEditPrivate::_q_textEdited);
+    QObjectPrivate::connect(control, &QWidgetLineControl::cursorPositionChanged,
+                            this, &QLineEditPrivate::_q_cursorPositionChanged);
+    QObjectPrivate::connect(control, &QWidgetLineControl::selectionChanged,
+                            this, &QLineEditPrivate::_q_selectionChanged);
+    QObject::connect(control, &QWidgetLineControl::accepted,
+                     q, &QLineEdit::returnPressed);
+    QObject::connect(control, &QWidgetLineControl::editingFinished,
+                     q, &QLineEdit::editingFinished);
 #ifdef QT_KEYPAD_NAVIGATION
-    QObject::connect(control, SIGNAL(editFocusChange(bool)),
-            q, SLOT(_q_editFocusChange(bool)));
+    QObjectPrivate::connect(control, &QWidgetLineControl::editFocusChange,
+                            this, &QLineEditPrivate::_q_editFocusChange);
 #endif
-    QObject::connect(control, SIGNAL(cursorPositionChanged(int,int)),
-            q, SLOT(updateMicroFocus()));
+    QObject::connect(control, &QWidgetLineControl::cursorPositionChanged,
+                     q, &QLineEdit::updateMicroFocus);
 
-    QObject::connect(control, SIGNAL(textChanged(QString)),
-            q, SLOT(updateMicroFocus()));
+    QObject::connect(control, &QWidgetLineControl::textChanged,
+                     q, &QLineEdit::updateMicroFocus);
 
-    QObject::connect(control, SIGNAL(updateMicroFocus()),
-            q, SLOT(updateMicroFocus()));
+    QObject::connect(control, &QWidgetLineControl::updateMicroFocus,
+                     q, &QLineEdit::updateMicroFocus);
 
     // for now, going completely overboard with updates.
-    QObject::connect(control, SIGNAL(selectionChanged()),
-            q, SLOT(update()));
+    QObject::connect(control, &QWidgetLineControl::selectionChanged,
+                     q, static_cast<void (QWidget::*)()>(&QWidget::update));
 
-    QObject::connect(control, SIGNAL(selectionChanged()),
-            q, SLOT(updateMicroFocus()));
+    QObject::connect(control, &QWidgetLineControl::selectionChanged,
+                     q, &QLineEdit::updateMicroFocus);
 
-    QObject::connect(control, SIGNAL(displayTextChanged(QString)),
-            q, SLOT(update()));
+    QObject::connect(control, &QWidgetLineControl::displayTextChanged,
+                     q, static_cast<void (QWidget::*)()>(&QWidget::update));
 
-    QObject::connect(control, SIGNAL(updateNeeded(QRect)),
-            q, SLOT(_q_updateNeeded(QRect)));
+    QObjectPrivate::connect(control, &QWidgetLineControl::updateNeeded,
+                            this, &QLineEditPrivate::_q_updateNeeded);
 
     QStyleOptionFrame opt;
     q->initStyleOption(&opt);
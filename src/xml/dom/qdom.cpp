@@ -46,6 +46,7 @@
 #include <qatomic.h>
 #include <qbuffer.h>
 #include <qhash.h>
+#include <qset.h>
 #include <qiodevice.h>
 #include <qlist.h>
 #include <qregexp.h>
@@ -522,6 +523,8 @@ public:
 
     QDomNodePrivate* importNode(QDomNodePrivate* importedNode, bool deep);
 
+    void internNames(QDomNodePrivate *node);
+
     // Reimplemented from QDomNodePrivate
     QDomNodePrivate* cloneNode(bool deep = true) Q_DECL_OVERRIDE;
     QDomNode::NodeType nodeType() const Q_DECL_OVERRIDE { return QDomNode::DocumentNode; }
@@ -561,6 +564,12 @@ public:
        stored timestamp.
     */
     long nodeListTime;
+
+    /* \internal
+       While parsing, names and namespace URIs of elements and attributes are
+       looked up here so that all nodes with the same name share one string.
+    */
+    QSet<QString> *nameTable;
 };
 
 /**************************************************************
@@ -4090,6 +4099,8 @@ QDomAttrPrivate::QDomAttrPrivate(QDomDocumentPrivate* d, QDomNodePrivate* parent
     : QDomNodePrivate(d, parent)
 {
     name = name_;
+    if (d)
+        d->internNames(this);
     m_specified = false;
 }
 
@@ -4099,6 +4110,8 @@ QDomAttrPrivate::QDomAttrPrivate(QDomDocumentPrivate* d, QDomNodePrivate* p, con
     qt_split_namespace(prefix, name, qName, !nsURI.isNull());
     namespaceURI = nsURI;
     createdWithDom1Interface = false;
+    if (d)
+        d->internNames(this);
     m_specified = false;
 }
 
@@ -4394,6 +4407,8 @@ QDomElementPrivate::QDomElementPrivate(QDomDocumentPrivate* d, QDomNodePrivate*
     : QDomNodePrivate(d, p)
 {
     name = tagname;
+    if (d)
+        d->internNames(this);
     m_attr = new QDomNamedNodeMapPrivate(this);
 }
 
@@ -4404,6 +4419,8 @@ QDomElementPrivate::QDomElementPrivate(QDomDocumentPrivate* d, QDomNodePrivate*
     qt_split_namespace(prefix, name, qName, !nsURI.isNull());
     namespaceURI = nsURI;
     createdWithDom1Interface = false;
+    if (d)
+        d->internNames(this);
     m_attr = new QDomNamedNodeMapPrivate(this);
 }
 
@@ -6142,7 +6159,8 @@ void QDomProcessingInstruction::setData(const QString& d)
 QDomDocumentPrivate::QDomDocumentPrivate()
     : QDomNodePrivate(0),
       impl(new QDomImplementationPrivate),
-      nodeListTime(1)
+      nodeListTime(1),
+      nameTable(0)
 {
     type = new QDomDocumentTypePrivate(this, this);
     type->ref.deref();
@@ -6153,7 +6171,8 @@ QDomDocumentPrivate::QDomDocumentPrivate()
 QDomDocumentPrivate::QDomDocumentPrivate(const QString& aname)
     : QDomNodePrivate(0),
       impl(new QDomImplementationPrivate),
-      nodeListTime(1)
+      nodeListTime(1),
+      nameTable(0)
 {
     type = new QDomDocumentTypePrivate(this, this);
     type->ref.deref();
@@ -6165,7 +6184,8 @@ QDomDocumentPrivate::QDomDocumentPrivate(const QString& aname)
 QDomDocumentPrivate::QDomDocumentPrivate(QDomDocumentTypePrivate* dt)
     : QDomNodePrivate(0),
       impl(new QDomImplementationPrivate),
-      nodeListTime(1)
+      nodeListTime(1),
+      nameTable(0)
 {
     if (dt != 0) {
         type = dt;
@@ -6180,7 +6200,8 @@ QDomDocumentPrivate::QDomDocumentPrivate(QDomDocumentTypePrivate* dt)
 QDomDocumentPrivate::QDomDocumentPrivate(QDomDocumentPrivate* n, bool deep)
     : QDomNodePrivate(n, deep),
       impl(n->impl->clone()),
-      nodeListTime(1)
+      nodeListTime(1),
+      nameTable(0)
 {
     type = static_cast<QDomDocumentTypePrivate*>(n->type->cloneNode());
     type->setParent(this);
@@ -6228,7 +6249,12 @@ bool QDomDocumentPrivate::setContent(QXmlInputSource *source, QXmlReader *reader
     reader->setDeclHandler(&hnd);
     reader->setDTDHandler(&hnd);
 
-    if (!reader->parse(source)) {
+    QSet<QString> names;
+    nameTable = &names;
+    const bool parsed = reader->parse(source);
+    nameTable = 0;
+
+    if (!parsed) {
         if (errorMsg)
             *errorMsg = hnd.errorMsg;
         if (errorLine)
@@ -6249,6 +6275,25 @@ QDomNodePrivate* QDomDocumentPrivate::cloneNode(bool deep)
     return p;
 }
 
+void QDomDocumentPrivate::internNames(QDomNodePrivate *node)
+{
+    if (!nameTable)
+        return;
+    QString *const names[] = { &node->name, &node->prefix, &node->namespaceURI };
+    for (QString *name : names) {
+        if (name->isEmpty())
+            continue;
+        const auto it = nameTable->constFind(*name);
+        if (it != nameTable->constEnd()) {
+            *name = *it;
+        } else {
+            // the parser's buffers have spare capacity, keep an exact copy
+            name->squeeze();
+            nameTable->insert(*name);
+        }
+    }
+}
+
 QDomElementPrivate* QDomDocumentPrivate::documentElement()
 {
     QDomNodePrivate *p = first;
@@ -6574,6 +6619,10 @@ void QDomDocumentPrivate::saveDocument(QTextStream& s, const int indent, QDomNod
 
     \snippet code/src_xml_dom_qdom.cpp 17
 
+    A document that is no longer modified can be read from several threads
+    at the same time, as long as each thread uses its own QDomNode,
+    QDomNodeList and QDomNamedNodeMap objects.
+
    For further information about the Document Object Model see
     the Document Object Model (DOM)
     \l{http://www.w3.org/TR/REC-DOM-Level-1/}{Level 1} and
@@ -7412,10 +7461,13 @@ bool QDomHandler::startElement(const QString& nsURI, const QString&, const QStri
     // attributes
     for (int i=0; i<atts.length(); i++)
     {
+        // the reader's buffers have spare capacity, store an exact copy
+        QString value = atts.value(i);
+        value.squeeze();
         if (nsProcessing) {
-            ((QDomElementPrivate*)node)->setAttributeNS(atts.uri(i), atts.qName(i), atts.value(i));
+            ((QDomElementPrivate*)node)->setAttributeNS(atts.uri(i), atts.qName(i), value);
         } else {
-            ((QDomElementPrivate*)node)->setAttribute(atts.qName(i), atts.value(i));
+            ((QDomElementPrivate*)node)->setAttribute(atts.qName(i), value);
         }
     }
 
@@ -7431,12 +7483,16 @@ bool QDomHandler::endElement(const QString&, const QString&, const QString&)
     return true;
 }
 
-bool QDomHandler::characters(const QString&  ch)
+bool QDomHandler::characters(const QString&  chars)
 {
     // No text as child of some document
     if (node == doc)
         return false;
 
+    // the reader's buffers have spare capacity, store an exact copy
+    QString ch = chars;
+    ch.squeeze();
+
     QScopedPointer<QDomNodePrivate> n;
     if (cdata) {
         n.reset(doc->createCDATASection(ch));
@@ -58,6 +58,8 @@ private slots:
     void qFutureAssignmentLeak();
     void stressTest();
     void persistentResultTest();
+    void mapRanges();
+    void mappedRanges();
 public slots:
     void throttling();
 };
@@ -2492,5 +2494,72 @@ void tst_QtConcurrentMap::persistentResultTest()
     QCOMPARE(ref.loadAcquire(), 3);
 }
 
+void tst_QtConcurrentMap::mapRanges()
+{
+    const int count = 10000;
+    QVector<int> vector(count);
+    for (int i = 0; i < count; ++i)
+        vector[i] = i;
+
+    QAtomicInt blocks;
+    QAtomicInt wrongSize;
+    const int blockSize = 64;
+    QtConcurrent::blockingMapRanges(vector, blockSize,
+        [&blocks, &wrongSize, blockSize, &vector](QVector<int>::iterator begin, QVector<int>::iterator end) {
+            blocks.ref();
+            // every block but the last one has the requested size
+            if (end - begin != blockSize && end != vector.end())
+                wrongSize.ref();
+            for (QVector<int>::iterator it = begin; it != end; ++it)
+                *it *= 2;
+        });
+    QCOMPARE(blocks.load(), (count + blockSize - 1) / blockSize);
+    QCOMPARE(wrongSize.load(), 0);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(vector.at(i), 2 * i);
+
+    // automatic block size, iterator version
+    QtConcurrent::mapRanges(vector.begin(), vector.end(), 0,
+        [](QVector<int>::iterator begin, QVector<int>::iterator end) {
+            for (QVector<int>::iterator it = begin; it != end; ++it)
+                *it /= 2;
+        }).waitForFinished();
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(vector.at(i), i);
+
+    // empty sequence
+    QVector<int> empty;
+    QtConcurrent::blockingMapRanges(empty, 16, [](QVector<int>::iterator, QVector<int>::iterator) {
+        QFAIL("called for an empty sequence");
+    });
+}
+
+void tst_QtConcurrentMap::mappedRanges()
+{
+    const int count = 5000;
+    QVector<int> vector(count);
+    for (int i = 0; i < count; ++i)
+        vector[i] = i;
+
+    QFuture<double> future = QtConcurrent::mappedRanges<double>(vector, 100,
+        [](QVector<int>::const_iterator begin, QVector<int>::const_iterator end, double *results) {
+            for (QVector<int>::const_iterator it = begin; it != end; ++it)
+                *results++ = *it * 0.5;
+        });
+    const QList<double> results = future.results();
+    QCOMPARE(results.count(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(results.at(i), i * 0.5);
+
+    QFuture<int> future2 = QtConcurrent::mappedRanges<int>(vector.constBegin() + 10, vector.constEnd(), 7,
+        [](QVector<int>::const_iterator begin, QVector<int>::const_iterator end, int *results) {
+            std::transform(begin, end, results, [](int value) { return value + 1; });
+        });
+    future2.waitForFinished();
+    QCOMPARE(future2.resultCount(), count - 10);
+    QCOMPARE(future2.resultAt(0), 11);
+    QCOMPARE(future2.resultAt(count - 11), count);
+}
+
 QTEST_MAIN(tst_QtConcurrentMap)
 #include "tst_qtconcurrentmap.moc"
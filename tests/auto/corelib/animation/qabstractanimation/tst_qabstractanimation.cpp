@@ -29,6 +29,7 @@
 
 #include <QtCore/qabstractanimation.h>
 #include <QtCore/qanimationgroup.h>
+#include <QtCore/private/qabstractanimation_p.h>
 #include <QtTest>
 
 class tst_QAbstractAnimation : public QObject
@@ -48,6 +49,8 @@ private slots:
     void avoidJumpAtStart();
     void avoidJumpAtStartWithStop();
     void avoidJumpAtStartWithRunning();
+    void frameStatistics();
+    void stopManyInOneTick();
 };
 
 class TestableQAbstractAnimation : public QAbstractAnimation
@@ -66,6 +69,17 @@ private:
     int m_duration;
 };
 
+class ManualAnimationDriver : public QAnimationDriver
+{
+public:
+    ManualAnimationDriver() : m_elapsed(0) { install(); }
+
+    qint64 elapsed() const Q_DECL_OVERRIDE { return m_elapsed; }
+    void step(qint64 msecs) { m_elapsed += msecs; advance(); }
+private:
+    qint64 m_elapsed;
+};
+
 class DummyQAnimationGroup : public QAnimationGroup
 {
     Q_OBJECT
@@ -213,6 +227,68 @@ void tst_QAbstractAnimation::avoidJumpAtStartWithRunning()
     QVERIFY(anim3.currentTime() < 50);
 }
 
+void tst_QAbstractAnimation::frameStatistics()
+{
+    ManualAnimationDriver driver;
+    TestableQAbstractAnimation anim;
+    anim.setDuration(1000);
+    anim.start();
+    QUnifiedTimer *timer = QUnifiedTimer::instance();
+    QTRY_COMPARE(timer->runningAnimationCount(), 1);
+    QVERIFY(driver.isRunning());
+
+    driver.step(16);
+    timer->resetFrameStatistics();
+
+    driver.step(16);
+    driver.step(16);
+    driver.step(48); // two frames late
+    QUnifiedTimer::FrameStatistics statistics = timer->frameStatistics();
+    QCOMPARE(statistics.tickCount, qint64(3));
+    QCOMPARE(statistics.droppedFrameCount, qint64(2));
+    QVERIFY(statistics.lastTickDuration <= statistics.maximumTickDuration);
+    QVERIFY(statistics.maximumTickDuration <= statistics.totalTickDuration);
+    QCOMPARE(anim.currentTime(), 96);
+
+    timer->resetFrameStatistics();
+    statistics = timer->frameStatistics();
+    QCOMPARE(statistics.tickCount, qint64(0));
+    QCOMPARE(statistics.droppedFrameCount, qint64(0));
+}
+
+void tst_QAbstractAnimation::stopManyInOneTick()
+{
+    ManualAnimationDriver driver;
+    QList<TestableQAbstractAnimation *> animations;
+    for (int i = 0; i < 20; ++i) {
+        TestableQAbstractAnimation *anim = new TestableQAbstractAnimation;
+        anim->setDuration(i % 2 ? 1000 : 100);
+        animations << anim;
+    }
+    // the short animations stop long ones before and after them in the list
+    for (int i = 0; i < 20; i += 2)
+        connect(animations.at(i), &QAbstractAnimation::finished, animations.at(19 - i), &QAbstractAnimation::stop);
+    for (TestableQAbstractAnimation *anim : qAsConst(animations))
+        anim->start();
+    QTRY_COMPARE(QUnifiedTimer::instance()->runningAnimationCount(), 20);
+    QVERIFY(driver.isRunning());
+
+    driver.step(50);
+    QCOMPARE(QUnifiedTimer::instance()->runningAnimationCount(), 20);
+    driver.step(200);
+    for (TestableQAbstractAnimation *anim : qAsConst(animations))
+        QCOMPARE(anim->state(), QAbstractAnimation::Stopped);
+    QCOMPARE(QUnifiedTimer::instance()->runningAnimationCount(), 0);
+    QTRY_VERIFY(!driver.isRunning());
+
+    // the timer is still usable afterwards
+    animations.first()->start();
+    QTRY_COMPARE(QUnifiedTimer::instance()->runningAnimationCount(), 1);
+    QVERIFY(driver.isRunning());
+    driver.step(50);
+    QVERIFY(animations.first()->currentTime() > 0);
+    qDeleteAll(animations);
+}
 
 QTEST_MAIN(tst_QAbstractAnimation)
 
@@ -61,6 +61,11 @@ private slots:
 
     void nonCharacters_data();
     void nonCharacters();
+
+    void longRuns_data();
+    void longRuns();
+    void invalidInLongRuns_data();
+    void invalidInLongRuns();
 };
 
 void tst_Utf8::initTestCase()
@@ -154,6 +159,7 @@ void tst_Utf8::roundTrip()
 
     QCOMPARE(to8Bit(utf16), utf8);
     QCOMPARE(from8Bit(utf8), utf16);
+    QVERIFY(utf8.isValidUtf8());
 
     QCOMPARE(to8Bit(from8Bit(utf8)), utf8);
     QCOMPARE(from8Bit(to8Bit(utf16)), utf16);
@@ -219,6 +225,8 @@ void tst_Utf8::invalidUtf8()
     QFETCH(QByteArray, utf8);
     QFETCH_GLOBAL(bool, useLocale);
 
+    QVERIFY(!utf8.isValidUtf8());
+
     const QScopedPointer<QTextDecoder> decoder(codec->makeDecoder());
     decoder->toUnicode(utf8);
 
@@ -247,6 +255,8 @@ void tst_Utf8::nonCharacters()
     QFETCH(QString, utf16);
     QFETCH_GLOBAL(bool, useLocale);
 
+    QVERIFY(utf8.isValidUtf8());
+
     const QScopedPointer<QTextDecoder> decoder(codec->makeDecoder());
     decoder->toUnicode(utf8);
 
@@ -264,5 +274,132 @@ void tst_Utf8::nonCharacters()
         qWarning("System codec reports failure when it shouldn't. Should report bug upstream.");
 }
 
+// Converting one character or byte at a time never takes the block-wise
+// code paths, so it provides the expected results for long strings.
+static QByteArray encodeCharByChar(const QString &utf16)
+{
+    const QScopedPointer<QTextEncoder> encoder(QTextCodec::codecForMib(106)->makeEncoder(QTextCodec::IgnoreHeader));
+    QByteArray encoded;
+    for (int i = 0; i < utf16.length(); ++i)
+        encoded += encoder->fromUnicode(utf16.constData() + i, 1);
+    return encoded;
+}
+
+static QString decodeByteByByte(const QByteArray &utf8)
+{
+    const QScopedPointer<QTextDecoder> decoder(QTextCodec::codecForMib(106)->makeDecoder());
+    QString decoded;
+    for (int i = 0; i < utf8.length(); ++i)
+        decoded += decoder->toUnicode(utf8.constData() + i, 1);
+    // flush an incomplete sequence at the end
+    decoded += decoder->toUnicode("", 0);
+    return decoded;
+}
+
+void tst_Utf8::longRuns_data()
+{
+    QTest::addColumn<QString>("utf16");
+
+    // letters of the alphabets that take two or three bytes in UTF-8, and
+    // the values around the boundaries of the encoded lengths
+    static const struct {
+        const char *name;
+        ushort first;
+    } scripts[] = {
+        { "latin1", 0x00c0 },
+        { "greek", 0x03b1 },
+        { "cyrillic", 0x0430 },
+        { "hebrew", 0x05d0 },
+        { "two-byte-end", 0x07f0 },
+        { "three-byte-start", 0x0800 },
+        { "cjk", 0x4e00 },
+        { "before-surrogates", 0xd7f0 },
+        { "after-surrogates", 0xe000 },
+        { "three-byte-end", 0xfff0 }
+    };
+    // separators inserted into the runs
+    static const struct {
+        const char *name;
+        ushort chars[3];
+    } separators[] = {
+        { "space", { ' ', 0, 0 } },
+        { "two-byte", { 0x00e9, 0, 0 } },
+        { "three-byte", { 0x20ac, 0, 0 } },
+        { "surrogate-pair", { 0xd83d, 0xde00, 0 } }
+    };
+    static const int spacings[] = { 0, 1, 5, 8, 15, 16 };
+
+    for (const auto &script : scripts) {
+        for (const auto &separator : separators) {
+            for (int spacing : spacings) {
+                QString str;
+                for (int i = 0; i < 100; ++i) {
+                    if (spacing && i % (spacing + 1) == spacing)
+                        str += QString::fromUtf16(separator.chars);
+                    else
+                        str += QChar(ushort(script.first + i % 16));
+                }
+                QTest::addRow("%s-%s-%d", script.name, separator.name, spacing) << str;
+            }
+        }
+    }
+}
+
+void tst_Utf8::longRuns()
+{
+    QFETCH(QString, utf16);
+
+    const QByteArray expected = encodeCharByChar(utf16);
+    for (int offset = 0; offset < 16; ++offset) {
+        // don't split surrogate pairs
+        if (utf16.at(offset).isLowSurrogate())
+            continue;
+        const QString str = utf16.mid(offset);
+        const QByteArray utf8 = to8Bit(str);
+        QCOMPARE(utf8, encodeCharByChar(str));
+        QCOMPARE(from8Bit(utf8), str);
+        QVERIFY(utf8.isValidUtf8());
+    }
+    QCOMPARE(decodeByteByByte(expected), utf16);
+}
+
+void tst_Utf8::invalidInLongRuns_data()
+{
+    QTest::addColumn<QByteArray>("before");
+    QTest::addColumn<QByteArray>("invalid");
+    QTest::addColumn<QByteArray>("after");
+
+    const QByteArray twoByte = QString(40, QChar(0x0434)).toUtf8();
+    const QByteArray threeByte = QString(40, QChar(0x65e5)).toUtf8();
+    static const char *const invalid[] = {
+        "\xff", "\x80", "\xc1\xbf", "\xd0", "\xe0\x9f\xbf", "\xed\xa0\x80",
+        "\xe6\x97", "\xe6", "\xf4\x90\x80\x80"
+    };
+    for (const char *bytes : invalid) {
+        const QByteArray hex = QByteArray(bytes).toHex();
+        QTest::addRow("two-byte-%s", hex.constData()) << twoByte << QByteArray(bytes) << twoByte;
+        QTest::addRow("three-byte-%s", hex.constData()) << threeByte << QByteArray(bytes) << threeByte;
+        QTest::addRow("two-byte-%s-three-byte", hex.constData()) << twoByte << QByteArray(bytes) << threeByte;
+        QTest::addRow("odd-offset-%s", hex.constData())
+                << QByteArray("x") + twoByte.left(24) << QByteArray(bytes) << twoByte;
+    }
+}
+
+void tst_Utf8::invalidInLongRuns()
+{
+    QFETCH(QByteArray, before);
+    QFETCH(QByteArray, invalid);
+    QFETCH(QByteArray, after);
+
+    // the invalid sequence is too short to be decoded block-wise, and it
+    // cannot affect the decoding of what follows
+    const QByteArray utf8 = before + invalid + after;
+    QVERIFY(!utf8.isValidUtf8());
+    QCOMPARE(QString::fromUtf8(utf8),
+             QString::fromUtf8(before) + QString::fromUtf8(invalid) + QString::fromUtf8(after));
+    QVERIFY(before.isValidUtf8());
+    QVERIFY(after.isValidUtf8());
+}
+
 QTEST_MAIN(tst_Utf8)
 #include "tst_utf8.moc"
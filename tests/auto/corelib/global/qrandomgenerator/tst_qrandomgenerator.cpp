@@ -103,6 +103,8 @@ private slots:
     void bounded();
     void boundedQuality_data() { generate32_data(); }
     void boundedQuality();
+    void fillBounded_data() { generate32_data(); }
+    void fillBounded();
 
     void generateReal_data() { generate32_data(); }
     void generateReal();
@@ -117,6 +119,12 @@ private slots:
     void stdUniformRealDistribution_data();
     void stdUniformRealDistribution();
     void stdRandomDistributions();
+
+    void fastKnownSequence();
+    void fastFillRange();
+    void fastDiscard();
+    void fastCopying();
+    void fastFillBounded();
 };
 
 // The first 20 results of the sequence:
@@ -646,6 +654,37 @@ void tst_QRandomGenerator::boundedQuality()
              << "at" << std::min_element(begin(histogram), end(histogram)) - histogram;
 }
 
+void tst_QRandomGenerator::fillBounded()
+{
+    enum { Bound = 283, BufferCount = Bound * 32, FailureThreshold = 16 * (BufferCount / Bound) };
+
+    QFETCH(uint, control);
+    if (control & RandomDataMask)
+        return;
+    RandomGenerator rng(control);
+
+    QVector<quint32> buffer(BufferCount, 0xcdcdcdcd);
+    rng.fillBounded(buffer.data(), buffer.size(), Bound);
+
+    int histogram[Bound];
+    memset(histogram, 0, sizeof(histogram));
+    for (quint32 value : qAsConst(buffer)) {
+        QVERIFY(value < Bound);
+        histogram[value]++;
+    }
+    for (int v : histogram)
+        QVERIFY(v < FailureThreshold);
+
+    // unbounded corner cases
+    quint32 array[7];
+    rng.fillBounded(array, 1);
+    for (quint32 value : array)
+        QCOMPARE(value, 0U);
+    rng.fillBounded(array, 0);
+    for (quint32 value : array)
+        QCOMPARE(value, 0U);
+}
+
 void tst_QRandomGenerator::generateReal()
 {
     QFETCH(uint, control);
@@ -955,6 +994,144 @@ void tst_QRandomGenerator::stdRandomDistributions()
     stdRandomDistributions_template<QRandomGenerator64>();
 }
 
+// reference implementation: four xoshiro128** streams seeded with SplitMix64,
+// outputs interleaved
+struct ReferenceFastGenerator
+{
+    quint32 s[4][4];
+    quint32 out[4];
+    int index = 4;
+
+    static quint32 rotl(quint32 x, int k) { return (x << k) | (x >> (32 - k)); }
+    ReferenceFastGenerator(quint64 seed)
+    {
+        for (auto &lane : s) {
+            for (int word = 0; word < 4; word += 2) {
+                quint64 z = (seed += Q_UINT64_C(0x9e3779b97f4a7c15));
+                z = (z ^ (z >> 30)) * Q_UINT64_C(0xbf58476d1ce4e5b9);
+                z = (z ^ (z >> 27)) * Q_UINT64_C(0x94d049bb133111eb);
+                z ^= z >> 31;
+                lane[word] = quint32(z);
+                lane[word + 1] = quint32(z >> 32);
+            }
+        }
+    }
+    quint32 operator()()
+    {
+        if (index == 4) {
+            for (int i = 0; i < 4; ++i) {
+                quint32 *st = s[i];
+                out[i] = rotl(st[1] * 5, 7) * 9;
+                const quint32 t = st[1] << 9;
+                st[2] ^= st[0];
+                st[3] ^= st[1];
+                st[1] ^= st[2];
+                st[0] ^= st[3];
+                st[2] ^= t;
+                st[3] = rotl(st[3], 11);
+            }
+            index = 0;
+        }
+        return out[index++];
+    }
+};
+
+void tst_QRandomGenerator::fastKnownSequence()
+{
+    for (quint64 seed : { Q_UINT64_C(1), Q_UINT64_C(0), Q_UINT64_C(0x123456789abcdef) }) {
+        ReferenceFastGenerator reference(seed);
+        QFastRandomGenerator rng(seed);
+        for (int i = 0; i < 100; ++i)
+            QCOMPARE(rng(), reference());
+
+        rng.seed(seed);
+        ReferenceFastGenerator reference2(seed);
+        QVector<quint32> buffer(1001);
+        rng.fillRange(buffer.data(), buffer.size());
+        for (quint32 x : qAsConst(buffer))
+            QCOMPARE(x, reference2());
+    }
+}
+
+void tst_QRandomGenerator::fastFillRange()
+{
+    // mixing single values and bulk fills must not change the sequence
+    ReferenceFastGenerator reference(42);
+    QFastRandomGenerator rng(42);
+    for (int chunk : { 1, 3, 17, 64, 2, 5, 100, 7 }) {
+        QCOMPARE(rng.generate(), reference());
+        QVector<quint32> buffer(chunk);
+        rng.fillRange(buffer.data(), buffer.size());
+        for (quint32 x : qAsConst(buffer))
+            QCOMPARE(x, reference());
+    }
+
+    quint64 array[3];
+    rng.fillRange(array);
+    for (quint64 x : array) {
+        const quint64 low = reference();
+        QCOMPARE(x, low | (quint64(reference()) << 32));
+    }
+}
+
+void tst_QRandomGenerator::fastDiscard()
+{
+    for (unsigned long long z : { 0, 1, 3, 4, 5, 63, 64, 65, 1000 }) {
+        QFastRandomGenerator rng1(7);
+        QFastRandomGenerator rng2(7);
+        rng1.generate();
+        rng2.generate();
+        rng1.discard(z);
+        for (unsigned long long i = 0; i < z; ++i)
+            rng2.generate();
+        QCOMPARE(rng1, rng2);
+        QCOMPARE(rng1(), rng2());
+    }
+}
+
+void tst_QRandomGenerator::fastCopying()
+{
+    QFastRandomGenerator rng1(3);
+    rng1.generate();
+    QFastRandomGenerator rng2 = rng1;
+    QCOMPARE(rng1, rng2);
+
+    quint32 samples[20];
+    rng1.fillRange(samples);
+    QVERIFY(rng1 != rng2);
+    for (quint32 x : samples)
+        QCOMPARE(rng2(), x);
+    QCOMPARE(rng1, rng2);
+
+    QFastRandomGenerator seeded1 = QFastRandomGenerator::securelySeeded();
+    QFastRandomGenerator seeded2 = QFastRandomGenerator::securelySeeded();
+    QVERIFY(seeded1 != seeded2);
+}
+
+void tst_QRandomGenerator::fastFillBounded()
+{
+    for (quint32 bound : { 1U, 2U, 3U, 10U, 283U, 0x80000001U, 0xfffffffeU }) {
+        QFastRandomGenerator rng(bound);
+        QVector<quint32> buffer(1003);
+        rng.fillBounded(buffer.data(), buffer.size(), bound);
+        for (quint32 x : qAsConst(buffer))
+            QVERIFY(x < bound);
+
+        // must match the scalar version of Lemire's method
+        ReferenceFastGenerator reference(bound);
+        QVector<quint32> raw(buffer.size());
+        for (quint32 &x : raw)
+            x = reference();
+        const quint32 threshold = (0U - bound) % bound;
+        for (int i = 0; i < raw.size(); ++i) {
+            quint64 m = quint64(raw.at(i)) * bound;
+            while (quint32(m) < threshold)
+                m = quint64(reference()) * bound;
+            QCOMPARE(buffer.at(i), quint32(m >> 32));
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QRandomGenerator)
 
 #include "tst_qrandomgenerator.moc"
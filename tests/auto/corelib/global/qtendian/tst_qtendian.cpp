@@ -47,6 +47,8 @@ private slots:
     void endianIntegers();
 
     void endianBitfields();
+
+    void bulkSwap();
 };
 
 struct TestData
@@ -213,5 +215,48 @@ void tst_QtEndian::endianBitfields()
     QCOMPARE(u.bottom, -8);
 }
 
+template <typename T>
+static void checkBulkSwap()
+{
+    // odd count, so that the vector and scalar paths are both used
+    const int count = 77;
+    T source[count];
+    T swapped[count];
+    T expected[count];
+    for (int i = 0; i < count; ++i) {
+        source[i] = T(Q_UINT64_C(0x0123456789abcdef) * (i + 1));
+        expected[i] = qbswap(source[i]);
+    }
+
+    void *end = qbswap<sizeof(T)>(source, count, swapped);
+    QCOMPARE(end, static_cast<void *>(swapped + count));
+    QVERIFY(memcmp(swapped, expected, sizeof(expected)) == 0);
+
+    // unaligned, in place
+    uchar buffer[sizeof(source) + 1];
+    memcpy(buffer + 1, source, sizeof(source));
+    qbswap<sizeof(T)>(buffer + 1, count, buffer + 1);
+    QVERIFY(memcmp(buffer + 1, expected, sizeof(expected)) == 0);
+
+    qToBigEndian<T>(source, count, swapped);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(swapped[i], qToBigEndian(source[i]));
+    qFromBigEndian<T>(swapped, count, swapped);
+    QVERIFY(memcmp(swapped, source, sizeof(source)) == 0);
+    qToLittleEndian<T>(source, count, swapped);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(swapped[i], qToLittleEndian(source[i]));
+    qFromLittleEndian<T>(swapped, count, swapped);
+    QVERIFY(memcmp(swapped, source, sizeof(source)) == 0);
+}
+
+void tst_QtEndian::bulkSwap()
+{
+    checkBulkSwap<quint8>();
+    checkBulkSwap<quint16>();
+    checkBulkSwap<quint32>();
+    checkBulkSwap<quint64>();
+}
+
 QTEST_MAIN(tst_QtEndian)
 #include "tst_qtendian.moc"
@@ -1,7 +1,9 @@
 TEMPLATE=subdirs
 SUBDIRS=\
     qabstractfileengine \
+    qasyncfile \
     qbuffer \
+    qcborstream \
     qdatastream \
     qdataurl \
     qdebug \
@@ -0,0 +1,221 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QAsyncFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThreadPool>
+
+class tst_QAsyncFile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void notOpen();
+    void openModes();
+    void read();
+    void readPastEnd();
+    void manyReads();
+    void write();
+    void closeWithPendingOperations();
+    void readAll();
+    void customThreadPool();
+
+private:
+    QString filePath(const QString &name) const { return dir.path() + QLatin1Char('/') + name; }
+
+    QTemporaryDir dir;
+    QByteArray contents;
+    QString dataFile;
+};
+
+void tst_QAsyncFile::initTestCase()
+{
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    contents.resize(1 << 20);
+    for (int i = 0; i < contents.size(); ++i)
+        contents[i] = char(i * 7 + i / 256);
+
+    dataFile = filePath(QStringLiteral("data.bin"));
+    QFile file(dataFile);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(contents), qint64(contents.size()));
+}
+
+void tst_QAsyncFile::notOpen()
+{
+    QAsyncFile file(dataFile);
+    QVERIFY(!file.isOpen());
+    QCOMPARE(file.openMode(), QIODevice::NotOpen);
+    QCOMPARE(file.size(), qint64(0));
+    QVERIFY(file.read(0, 10).result().isEmpty());
+    QCOMPARE(file.write(0, "abc").result(), qint64(-1));
+
+    QAsyncFile missing(filePath(QStringLiteral("missing")));
+    QVERIFY(!missing.open(QIODevice::ReadOnly));
+    QCOMPARE(missing.error(), QFileDevice::OpenError);
+    QVERIFY(!missing.errorString().isEmpty());
+}
+
+void tst_QAsyncFile::openModes()
+{
+    QAsyncFile file(dataFile);
+    QTest::ignoreMessage(QtWarningMsg, "QAsyncFile::open: Append and Text modes are not supported");
+    QVERIFY(!file.open(QIODevice::WriteOnly | QIODevice::Append));
+    QTest::ignoreMessage(QtWarningMsg, "QAsyncFile::open: Append and Text modes are not supported");
+    QVERIFY(!file.open(QIODevice::ReadOnly | QIODevice::Text));
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(file.isOpen());
+    QCOMPARE(file.openMode(), QIODevice::ReadOnly);
+    QCOMPARE(file.size(), qint64(contents.size()));
+
+    // writing to a read-only file fails
+    QCOMPARE(file.write(0, "abc").result(), qint64(-1));
+    file.close();
+    QVERIFY(!file.isOpen());
+}
+
+void tst_QAsyncFile::read()
+{
+    QAsyncFile file(dataFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QFuture<QByteArray> head = file.read(0, 100);
+    QFuture<QByteArray> middle = file.read(12345, 54321);
+    QFuture<QByteArray> whole = file.read(0, contents.size());
+    QCOMPARE(head.result(), contents.left(100));
+    QCOMPARE(middle.result(), contents.mid(12345, 54321));
+    QCOMPARE(whole.result(), contents);
+    QVERIFY(file.read(10, 0).result().isEmpty());
+}
+
+void tst_QAsyncFile::readPastEnd()
+{
+    QAsyncFile file(dataFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QCOMPARE(file.read(contents.size() - 10, 100).result(), contents.right(10));
+    QVERIFY(file.read(contents.size(), 100).result().isEmpty());
+    QVERIFY(file.read(contents.size() + 100, 100).result().isEmpty());
+
+    QTest::ignoreMessage(QtWarningMsg, "QAsyncFile::read: Called with negative offset or size");
+    QVERIFY(file.read(-1, 100).results().isEmpty());
+}
+
+void tst_QAsyncFile::manyReads()
+{
+    QAsyncFile file(dataFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    const int chunkSize = 4096;
+    QVector<QFuture<QByteArray> > futures;
+    for (int offset = 0; offset < contents.size(); offset += chunkSize)
+        futures.append(file.read(offset, chunkSize));
+
+    QByteArray reassembled;
+    for (QFuture<QByteArray> &future : futures)
+        reassembled += future.result();
+    QCOMPARE(reassembled, contents);
+}
+
+void tst_QAsyncFile::write()
+{
+    const QString name = filePath(QStringLiteral("write.bin"));
+    QAsyncFile file(name);
+    QVERIFY(file.open(QIODevice::ReadWrite | QIODevice::Truncate));
+
+    // non-overlapping writes in any order
+    QVector<QFuture<qint64> > futures;
+    const int chunkSize = 4096;
+    for (int offset = contents.size() - chunkSize; offset >= 0; offset -= chunkSize)
+        futures.append(file.write(offset, contents.mid(offset, chunkSize)));
+    for (QFuture<qint64> &future : futures)
+        QCOMPARE(future.result(), qint64(chunkSize));
+
+    QCOMPARE(file.read(0, contents.size()).result(), contents);
+    file.close();
+
+    QFile check(name);
+    QVERIFY(check.open(QIODevice::ReadOnly));
+    QCOMPARE(check.readAll(), contents);
+}
+
+void tst_QAsyncFile::closeWithPendingOperations()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    QVector<QFuture<QByteArray> > futures;
+    {
+        QAsyncFile file(dataFile);
+        file.setThreadPool(&pool);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        for (int i = 0; i < 100; ++i)
+            futures.append(file.read(i * 100, 100));
+    }
+
+    // every operation either completed or failed, none is left hanging
+    for (int i = 0; i < futures.size(); ++i) {
+        const QByteArray data = futures.at(i).result();
+        QVERIFY(data.isEmpty() || data == contents.mid(i * 100, 100));
+    }
+    pool.waitForDone();
+}
+
+void tst_QAsyncFile::readAll()
+{
+    QFuture<QByteArray> future = QAsyncFile::readAll(dataFile);
+    QFuture<QByteArray> missing = QAsyncFile::readAll(filePath(QStringLiteral("missing")));
+    QCOMPARE(future.result(), contents);
+    QVERIFY(missing.result().isEmpty());
+}
+
+void tst_QAsyncFile::customThreadPool()
+{
+    QThreadPool pool;
+    QAsyncFile file(dataFile);
+    QVERIFY(file.threadPool());
+    QVERIFY(file.threadPool() != &pool);
+    file.setThreadPool(&pool);
+    QCOMPARE(file.threadPool(), &pool);
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QFutureWatcher<QByteArray> watcher;
+    QSignalSpy spy(&watcher, &QFutureWatcher<QByteArray>::finished);
+    watcher.setFuture(file.read(100, 200));
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(watcher.result(), contents.mid(100, 200));
+
+    file.setThreadPool(nullptr);
+    QVERIFY(file.threadPool() != &pool);
+}
+
+QTEST_MAIN(tst_QAsyncFile)
+#include "tst_qasyncfile.moc"
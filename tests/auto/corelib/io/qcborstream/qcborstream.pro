@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qcborstream
+QT = core testlib
+SOURCES = tst_qcborstream.cpp
@@ -0,0 +1,526 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qbuffer.h>
+#include <QtCore/qcborstream.h>
+
+Q_DECLARE_METATYPE(QCborStreamReader::Error)
+
+class tst_QCborStream : public QObject
+{
+    Q_OBJECT
+private slots:
+    void integers_data();
+    void integers();
+    void floats_data();
+    void floats();
+    void simpleTypes();
+    void strings_data();
+    void strings();
+    void chunkedStrings();
+    void zeroCopy();
+    void arrays();
+    void maps();
+    void skipping();
+    void tags();
+    void deepNesting();
+    void writerContainerMismatch();
+    void errors_data();
+    void errors();
+};
+
+void tst_QCborStream::integers_data()
+{
+    QTest::addColumn<qint64>("value");
+    QTest::addColumn<QByteArray>("encoded");
+
+    // examples from RFC 7049, appendix A
+    QTest::newRow("0") << Q_INT64_C(0) << QByteArray::fromHex("00");
+    QTest::newRow("23") << Q_INT64_C(23) << QByteArray::fromHex("17");
+    QTest::newRow("24") << Q_INT64_C(24) << QByteArray::fromHex("1818");
+    QTest::newRow("100") << Q_INT64_C(100) << QByteArray::fromHex("1864");
+    QTest::newRow("1000") << Q_INT64_C(1000) << QByteArray::fromHex("1903e8");
+    QTest::newRow("1000000") << Q_INT64_C(1000000) << QByteArray::fromHex("1a000f4240");
+    QTest::newRow("1000000000000") << Q_INT64_C(1000000000000)
+                                   << QByteArray::fromHex("1b000000e8d4a51000");
+    QTest::newRow("-1") << Q_INT64_C(-1) << QByteArray::fromHex("20");
+    QTest::newRow("-100") << Q_INT64_C(-100) << QByteArray::fromHex("3863");
+    QTest::newRow("-1000") << Q_INT64_C(-1000) << QByteArray::fromHex("3903e7");
+    QTest::newRow("min") << std::numeric_limits<qint64>::min()
+                         << QByteArray::fromHex("3b7fffffffffffffff");
+}
+
+void tst_QCborStream::integers()
+{
+    QFETCH(qint64, value);
+    QFETCH(QByteArray, encoded);
+
+    QByteArray output;
+    QCborStreamWriter writer(&output);
+    writer.append(value);
+    QCOMPARE(output.toHex(), encoded.toHex());
+
+    QCborStreamReader reader(encoded);
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.isNegativeInteger(), value < 0);
+    QCOMPARE(reader.toInteger(), value);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.currentOffset(), qint64(encoded.size()));
+}
+
+void tst_QCborStream::floats_data()
+{
+    QTest::addColumn<double>("value");
+    QTest::addColumn<QByteArray>("encoded");
+    QTest::addColumn<int>("type");
+
+    QTest::newRow("half-1.5") << 1.5 << QByteArray::fromHex("f93e00") << int(QCborStreamReader::Float16);
+    QTest::newRow("half-65504") << 65504.0 << QByteArray::fromHex("f97bff") << int(QCborStreamReader::Float16);
+    QTest::newRow("float-100000") << 100000.0 << QByteArray::fromHex("fa47c35000") << int(QCborStreamReader::Float);
+    QTest::newRow("double-1.1") << 1.1 << QByteArray::fromHex("fb3ff199999999999a") << int(QCborStreamReader::Double);
+    QTest::newRow("double--4.1") << -4.1 << QByteArray::fromHex("fbc010666666666666") << int(QCborStreamReader::Double);
+}
+
+void tst_QCborStream::floats()
+{
+    QFETCH(double, value);
+    QFETCH(QByteArray, encoded);
+    QFETCH(int, type);
+
+    QByteArray output;
+    QCborStreamWriter writer(&output);
+    if (type == QCborStreamReader::Float16)
+        writer.append(qfloat16(float(value)));
+    else if (type == QCborStreamReader::Float)
+        writer.append(float(value));
+    else
+        writer.append(value);
+    QCOMPARE(output.toHex(), encoded.toHex());
+
+    QCborStreamReader reader(encoded);
+    QCOMPARE(int(reader.type()), type);
+    QCOMPARE(reader.toDouble(), value);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+}
+
+void tst_QCborStream::simpleTypes()
+{
+    QByteArray output;
+    QCborStreamWriter writer(&output);
+    writer.append(false);
+    writer.append(true);
+    writer.appendNull();
+    writer.appendUndefined();
+    writer.appendSimpleType(16);
+    writer.appendSimpleType(255);
+    QCOMPARE(output.toHex(), QByteArray("f4f5f6f7f0f8ff"));
+
+    QCborStreamReader reader(output);
+    QVERIFY(reader.isFalse());
+    QVERIFY(reader.isBool());
+    QVERIFY(!reader.toBool());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isTrue());
+    QVERIFY(reader.toBool());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isUndefined());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isSimpleType());
+    QCOMPARE(reader.toSimpleType(), quint8(16));
+    QVERIFY(reader.next());
+    QCOMPARE(reader.toSimpleType(), quint8(255));
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QCborStream::strings_data()
+{
+    QTest::addColumn<QString>("string");
+    QTest::addColumn<QByteArray>("encoded");
+
+    QTest::newRow("empty") << QString("") << QByteArray::fromHex("60");
+    QTest::newRow("a") << QString("a") << QByteArray::fromHex("6161");
+    QTest::newRow("IETF") << QString("IETF") << QByteArray::fromHex("6449455446");
+    QTest::newRow("u-umlaut") << QString(QChar(0xfc)) << QByteArray::fromHex("62c3bc");
+    QTest::newRow("water") << QString(QChar(0x6c34)) << QByteArray::fromHex("63e6b0b4");
+    QTest::newRow("long") << QString(30, QLatin1Char('x'))
+                          << QByteArray::fromHex("781e") + QByteArray(30, 'x');
+}
+
+void tst_QCborStream::strings()
+{
+    QFETCH(QString, string);
+    QFETCH(QByteArray, encoded);
+
+    QByteArray output;
+    QCborStreamWriter writer(&output);
+    writer.append(QStringView(string));
+    const QByteArray latin1 = string.toLatin1();
+    if (QString::fromLatin1(latin1) == string)
+        writer.append(QLatin1String(latin1));
+    else
+        writer.append(string.toUtf8().constData());
+    writer.append(string.toUtf8());
+    QCOMPARE(output.left(encoded.size()).toHex(), encoded.toHex());
+    QCOMPARE(output.mid(encoded.size(), encoded.size()).toHex(), encoded.toHex());
+
+    QCborStreamReader reader(output);
+    QVERIFY(reader.isString());
+    QVERIFY(reader.isLengthKnown());
+    QCOMPARE(reader.length(), quint64(string.toUtf8().size()));
+    QCOMPARE(reader.readString(), string);
+    QVERIFY(reader.isString());
+    QCOMPARE(reader.readUtf8String(), string.toUtf8());
+    QVERIFY(reader.isByteArray());
+    QVERIFY(reader.readString().isNull());
+    QCOMPARE(reader.readByteArray(), string.toUtf8());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QCborStream::chunkedStrings()
+{
+    // (_ h'0102', h'030405') and (_ "strea", "ming"), from RFC 7049
+    const QByteArray encoded = QByteArray::fromHex("5f42010243030405ff7f657374726561646d696e67ff");
+
+    QCborStreamReader reader(encoded);
+    QVERIFY(reader.isByteArray());
+    QVERIFY(!reader.isLengthKnown());
+    QVERIFY(reader.byteArrayView().isNull());
+    QCOMPARE(reader.readByteArray(), QByteArray::fromHex("0102030405"));
+    QVERIFY(reader.isString());
+    QCOMPARE(reader.readString(), QString("streaming"));
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+
+    reader.reset();
+    QVERIFY(reader.next());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QCborStream::zeroCopy()
+{
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.startArray(2);
+    writer.append(QByteArray("binary data"));
+    writer.append("text data");
+    QVERIFY(writer.endArray());
+
+    const char *begin = encoded.constData();
+    const char *end = begin + encoded.size();
+    QCborStreamReader reader(begin, encoded.size());
+    QVERIFY(reader.enterContainer());
+
+    QByteArray view = reader.byteArrayView();
+    QCOMPARE(view, QByteArray("binary data"));
+    QVERIFY(view.constData() > begin && view.constData() < end);
+    QByteArray ba = reader.readByteArray();
+    QCOMPARE(ba.constData(), view.constData());
+
+    QByteArray utf8 = reader.readUtf8String();
+    QCOMPARE(utf8, QByteArray("text data"));
+    QVERIFY(utf8.constData() > begin && utf8.constData() + utf8.size() == end);
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasNext());
+}
+
+void tst_QCborStream::arrays()
+{
+    // [1, [2, 3], [4, 5]] and [_ 1, [2, 3], [_ 4, 5]]
+    QByteArray definite;
+    QCborStreamWriter writer(&definite);
+    writer.startArray(3);
+    writer.append(1);
+    writer.startArray(2);
+    writer.append(2);
+    writer.append(3);
+    QVERIFY(writer.endArray());
+    writer.startArray(2);
+    writer.append(4);
+    writer.append(5);
+    QVERIFY(writer.endArray());
+    QVERIFY(writer.endArray());
+    QCOMPARE(writer.containerDepth(), 0);
+    QCOMPARE(definite.toHex(), QByteArray("8301820203820405"));
+
+    QByteArray indefinite;
+    writer.setDevice(Q_NULLPTR);
+    QBuffer buffer(&indefinite);
+    buffer.open(QIODevice::WriteOnly);
+    writer.setDevice(&buffer);
+    QCOMPARE(writer.device(), &buffer);
+    writer.startArray();
+    writer.append(1);
+    writer.startArray(2);
+    writer.append(2);
+    writer.append(3);
+    QVERIFY(writer.endArray());
+    writer.startArray();
+    writer.append(4);
+    writer.append(5);
+    QVERIFY(writer.endArray());
+    QVERIFY(writer.endArray());
+    buffer.close();
+    QCOMPARE(indefinite.toHex(), QByteArray("9f018202039f0405ffff"));
+
+    for (const QByteArray &encoded : { definite, indefinite }) {
+        QCborStreamReader reader(encoded);
+        QVERIFY(reader.isArray());
+        QCOMPARE(reader.isLengthKnown(), encoded == definite);
+        QList<qint64> values;
+        QVERIFY(reader.enterContainer());
+        QCOMPARE(reader.parentContainerType(), QCborStreamReader::Array);
+        while (reader.hasNext()) {
+            if (reader.isArray()) {
+                QVERIFY(reader.enterContainer());
+                QCOMPARE(reader.containerDepth(), 2);
+                while (reader.hasNext()) {
+                    values << reader.toInteger();
+                    QVERIFY(reader.next());
+                }
+                QVERIFY(reader.leaveContainer());
+            } else {
+                values << reader.toInteger();
+                QVERIFY(reader.next());
+            }
+        }
+        QVERIFY(reader.leaveContainer());
+        QCOMPARE(reader.containerDepth(), 0);
+        QCOMPARE(reader.parentContainerType(), QCborStreamReader::Invalid);
+        QCOMPARE(values, QList<qint64>() << 1 << 2 << 3 << 4 << 5);
+        QVERIFY(!reader.hasNext());
+        QVERIFY(!reader.hasError());
+    }
+}
+
+void tst_QCborStream::maps()
+{
+    // {_ "Fun": true, "Amt": -2}
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.startMap();
+    writer.append("Fun");
+    writer.append(true);
+    writer.append(QLatin1String("Amt"));
+    writer.append(-2);
+    QVERIFY(writer.endMap());
+    QCOMPARE(encoded.toHex(), QByteArray("bf6346756ef563416d7421ff"));
+
+    QCborStreamReader reader(encoded);
+    QVERIFY(reader.isMap());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.readString(), QString("Fun"));
+    QVERIFY(reader.isTrue());
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readString(), QString("Amt"));
+    QCOMPARE(reader.toInteger(), Q_INT64_C(-2));
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasError());
+
+    // {"a": 1, "b": [2, 3]}
+    encoded = QByteArray::fromHex("a26161016162820203");
+    reader.setData(encoded);
+    QVERIFY(reader.isMap());
+    QCOMPARE(reader.length(), quint64(2));
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.readUtf8String(), QByteArray("a"));
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readUtf8String(), QByteArray("b"));
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QCborStream::skipping()
+{
+    // ["a", {_ "b": "c"}, [_ 1], 2] followed by 3
+    const QByteArray encoded = QByteArray::fromHex("846161bf61626163ff9f01ff0203");
+
+    QCborStreamReader reader(encoded);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.toInteger(), Q_INT64_C(3));
+
+    // leaving a container skips what was not read
+    reader.reset();
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.next());
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.toInteger(), Q_INT64_C(3));
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QCborStream::tags()
+{
+    // [0("2013-03-21T20:04:00Z"), 1(1363896240)]
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.startArray(2);
+    writer.appendTag(0);
+    writer.append("2013-03-21T20:04:00Z");
+    writer.appendTag(1);
+    writer.append(1363896240);
+    QVERIFY(writer.endArray());
+    QCOMPARE(encoded.toHex(),
+             QByteArray("82c074323031332d30332d32315432303a30343a30305ac11a514b67b0"));
+
+    QCborStreamReader reader(encoded);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isTag());
+    QCOMPARE(reader.toTag(), quint64(0));
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readString(), QString("2013-03-21T20:04:00Z"));
+    QVERIFY(reader.isTag());
+    QCOMPARE(reader.toTag(), quint64(1));
+    QVERIFY(reader.next());
+    QCOMPARE(reader.toUnsignedInteger(), quint64(1363896240));
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QCborStream::deepNesting()
+{
+    const int depth = 100000;
+    QByteArray encoded(depth, char(0x81));
+    encoded.append(char(0));
+    encoded.append(char(0x17));
+
+    QCborStreamReader reader(encoded);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.toInteger(), Q_INT64_C(23));
+
+    encoded.chop(2);
+    reader.setData(encoded);
+    QVERIFY(!reader.next());
+    QCOMPARE(reader.lastError(), QCborStreamReader::EndOfFileError);
+}
+
+void tst_QCborStream::writerContainerMismatch()
+{
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.startArray(2);
+    writer.append(1);
+    QVERIFY(!writer.endArray());
+
+    writer.startMap();
+    writer.append("key");
+    QVERIFY(!writer.endArray());
+    QVERIFY(!writer.endMap());
+
+    writer.startMap(1);
+    writer.append("key");
+    writer.append("value");
+    QVERIFY(writer.endMap());
+    QCOMPARE(writer.containerDepth(), 0);
+}
+
+void tst_QCborStream::errors_data()
+{
+    QTest::addColumn<QByteArray>("encoded");
+    QTest::addColumn<QCborStreamReader::Error>("error");
+    QTest::addColumn<qint64>("offset");
+
+    QTest::newRow("truncated-integer") << QByteArray::fromHex("1901")
+                                       << QCborStreamReader::EndOfFileError << Q_INT64_C(0);
+    QTest::newRow("truncated-string") << QByteArray::fromHex("0045616263")
+                                      << QCborStreamReader::EndOfFileError << Q_INT64_C(1);
+    QTest::newRow("truncated-array") << QByteArray::fromHex("830102")
+                                     << QCborStreamReader::EndOfFileError << Q_INT64_C(3);
+    QTest::newRow("truncated-chunks") << QByteArray::fromHex("5f4101")
+                                      << QCborStreamReader::EndOfFileError << Q_INT64_C(0);
+    QTest::newRow("reserved-length") << QByteArray::fromHex("1c")
+                                     << QCborStreamReader::IllegalNumberError << Q_INT64_C(0);
+    QTest::newRow("indefinite-integer") << QByteArray::fromHex("1f")
+                                        << QCborStreamReader::IllegalNumberError << Q_INT64_C(0);
+    QTest::newRow("indefinite-tag") << QByteArray::fromHex("df")
+                                    << QCborStreamReader::IllegalNumberError << Q_INT64_C(0);
+    QTest::newRow("top-level-break") << QByteArray::fromHex("00ff")
+                                     << QCborStreamReader::UnexpectedBreakError << Q_INT64_C(1);
+    QTest::newRow("break-in-array") << QByteArray::fromHex("8201ff")
+                                    << QCborStreamReader::UnexpectedBreakError << Q_INT64_C(2);
+    QTest::newRow("break-after-key") << QByteArray::fromHex("bf6161ff")
+                                     << QCborStreamReader::UnexpectedBreakError << Q_INT64_C(3);
+    QTest::newRow("two-byte-simple") << QByteArray::fromHex("f810")
+                                     << QCborStreamReader::IllegalSimpleTypeError << Q_INT64_C(0);
+    QTest::newRow("chunk-type") << QByteArray::fromHex("5f6161ff")
+                                << QCborStreamReader::IllegalTypeError << Q_INT64_C(0);
+    QTest::newRow("nested-chunks") << QByteArray::fromHex("7f7f6161ffff")
+                                   << QCborStreamReader::IllegalTypeError << Q_INT64_C(0);
+    QTest::newRow("invalid-utf8") << QByteArray::fromHex("0062c328")
+                                  << QCborStreamReader::InvalidUtf8StringError << Q_INT64_C(1);
+    QTest::newRow("huge-string") << QByteArray::fromHex("5b0000000100000000")
+                                 << QCborStreamReader::DataTooLargeError << Q_INT64_C(0);
+}
+
+void tst_QCborStream::errors()
+{
+    QFETCH(QByteArray, encoded);
+    QFETCH(QCborStreamReader::Error, error);
+    QFETCH(qint64, offset);
+
+    QCborStreamReader reader(encoded);
+    while (reader.hasNext()) {
+        if (reader.isString())
+            reader.readString();
+        else if (reader.isContainer())
+            reader.enterContainer();
+        else
+            reader.next();
+    }
+    QCOMPARE(reader.lastError(), error);
+    QCOMPARE(reader.currentOffset(), offset);
+    QVERIFY(!reader.isValid());
+    QVERIFY(!reader.next());
+}
+
+QTEST_APPLESS_MAIN(tst_QCborStream)
+
+#include "tst_qcborstream.moc"
@@ -168,6 +168,10 @@ private slots:
 
     void status_QLinkedList_QList_QVector();
 
+    void stream_QVector_bulk_data();
+    void stream_QVector_bulk();
+    void rawSpanPastEnd();
+
     void streamToAndFromQByteArray();
 
     void streamRealDataTypes();
@@ -2942,6 +2946,134 @@ void tst_QDataStream::status_QLinkedList_QList_QVector()
     }
 }
 
+template <typename T>
+static void checkVectorStreaming(int byteOrder, int version, int precision)
+{
+    QVector<T> v;
+    for (int i = 0; i < 1000; ++i)
+        v.append(T(i * 37 - 15000) / T(4));
+
+    const auto setup = [&](QDataStream &s) {
+        s.setByteOrder(QDataStream::ByteOrder(byteOrder));
+        s.setVersion(version);
+        s.setFloatingPointPrecision(QDataStream::FloatingPointPrecision(precision));
+    };
+
+    // must produce the same bytes as streaming element by element
+    QByteArray expected;
+    {
+        QDataStream s(&expected, QIODevice::WriteOnly);
+        setup(s);
+        s << quint32(v.size());
+        for (T t : qAsConst(v))
+            s << t;
+    }
+    QByteArray actual;
+    {
+        QDataStream s(&actual, QIODevice::WriteOnly);
+        setup(s);
+        s << v;
+        QCOMPARE(s.status(), QDataStream::Ok);
+    }
+    QCOMPARE(actual.size(), expected.size());
+    QCOMPARE(actual, expected);
+
+    QVector<T> elementwise;
+    {
+        QDataStream s(expected);
+        setup(s);
+        quint32 n;
+        s >> n;
+        for (quint32 i = 0; i < n; ++i) {
+            T t;
+            s >> t;
+            elementwise.append(t);
+        }
+    }
+    QVector<T> result;
+    QDataStream s(actual);
+    setup(s);
+    s >> result;
+    QCOMPARE(s.status(), QDataStream::Ok);
+    QVERIFY(s.atEnd());
+    QCOMPARE(result, elementwise);
+    // streams older than Qt 3.3 read 64-bit integers back with their halves swapped
+    if (version >= QDataStream::Qt_3_3 || sizeof(T) < 8 || std::is_floating_point<T>::value)
+        QCOMPARE(result, v);
+}
+
+void tst_QDataStream::stream_QVector_bulk_data()
+{
+    QTest::addColumn<int>("byteOrder");
+    QTest::addColumn<int>("version");
+    QTest::addColumn<int>("precision");
+
+    const int current = QDataStream::Qt_DefaultCompiledVersion;
+    QTest::newRow("big-endian") << int(QDataStream::BigEndian) << current
+                                << int(QDataStream::DoublePrecision);
+    QTest::newRow("little-endian") << int(QDataStream::LittleEndian) << current
+                                   << int(QDataStream::DoublePrecision);
+    QTest::newRow("big-endian-single") << int(QDataStream::BigEndian) << current
+                                       << int(QDataStream::SinglePrecision);
+    QTest::newRow("little-endian-single") << int(QDataStream::LittleEndian) << current
+                                          << int(QDataStream::SinglePrecision);
+    QTest::newRow("qt4.5") << int(QDataStream::LittleEndian) << int(QDataStream::Qt_4_5)
+                           << int(QDataStream::DoublePrecision);
+    QTest::newRow("qt3.1") << int(QDataStream::LittleEndian) << int(QDataStream::Qt_3_1)
+                           << int(QDataStream::DoublePrecision);
+}
+
+void tst_QDataStream::stream_QVector_bulk()
+{
+    QFETCH(int, byteOrder);
+    QFETCH(int, version);
+    QFETCH(int, precision);
+
+    checkVectorStreaming<qint8>(byteOrder, version, precision);
+    checkVectorStreaming<quint8>(byteOrder, version, precision);
+    checkVectorStreaming<qint16>(byteOrder, version, precision);
+    checkVectorStreaming<quint16>(byteOrder, version, precision);
+    checkVectorStreaming<qint32>(byteOrder, version, precision);
+    checkVectorStreaming<quint32>(byteOrder, version, precision);
+    checkVectorStreaming<qint64>(byteOrder, version, precision);
+    checkVectorStreaming<quint64>(byteOrder, version, precision);
+    checkVectorStreaming<float>(byteOrder, version, precision);
+    checkVectorStreaming<double>(byteOrder, version, precision);
+}
+
+void tst_QDataStream::rawSpanPastEnd()
+{
+    const QByteArray data("\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00", 10);
+    qint32 values[3] = { -1, -1, -1 };
+    QDataStream s(data);
+    s.readRawSpan(values, 3);
+    QCOMPARE(s.status(), QDataStream::ReadPastEnd);
+    QCOMPARE(values[0], 1);
+    QCOMPARE(values[1], 2);
+    QCOMPARE(values[2], 0);
+
+    // a truncated vector reads as empty
+    QByteArray truncated;
+    {
+        QDataStream out(&truncated, QIODevice::WriteOnly);
+        out << QVector<double>(100, 1.5);
+    }
+    truncated.chop(1);
+    QVector<double> v;
+    QDataStream in(truncated);
+    in >> v;
+    QCOMPARE(in.status(), QDataStream::ReadPastEnd);
+    QVERIFY(v.isEmpty());
+
+    // a count much larger than the data does not read past it
+    const QByteArray huge("\x7f\xff\xff\xff\x00\x00\x00\x01", 8);
+    QVector<qint32> w;
+    QDataStream in2(huge);
+    in2 >> w;
+    QCOMPARE(in2.status(), QDataStream::ReadPastEnd);
+    QVERIFY(w.isEmpty());
+}
+
 void tst_QDataStream::streamToAndFromQByteArray()
 {
     QByteArray data;
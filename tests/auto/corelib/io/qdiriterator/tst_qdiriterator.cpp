@@ -92,6 +92,9 @@ private slots:
     void cleanupTestCase();
     void iterateRelativeDirectory_data();
     void iterateRelativeDirectory();
+    void iterateRelativeDirectoryParallel_data();
+    void iterateRelativeDirectoryParallel();
+    void parallelLargeTree();
     void iterateResource_data();
     void iterateResource();
     void stopLinkLoop();
@@ -391,6 +394,79 @@ void tst_QDirIterator::iterateRelativeDirectory()
     QCOMPARE(list, sortedEntries);
 }
 
+void tst_QDirIterator::iterateRelativeDirectoryParallel_data()
+{
+    iterateRelativeDirectory_data();
+}
+
+void tst_QDirIterator::iterateRelativeDirectoryParallel()
+{
+    QFETCH(QString, dirName);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QStringList, entries);
+
+    QDirIterator it(dirName, nameFilters, filters, flags | QDirIterator::Parallel);
+    QStringList list;
+    while (it.hasNext()) {
+        QString next = it.next();
+        QFileInfo info = it.fileInfo();
+        QCOMPARE(it.path(), dirName);
+        QCOMPARE(next, it.filePath());
+        QCOMPARE(info, QFileInfo(next));
+        list << info.canonicalFilePath();
+    }
+    QVERIFY(!it.hasNext());
+    QVERIFY(it.next().isEmpty());
+    list.sort();
+
+    QStringList sortedEntries;
+    for (const QString &item : qAsConst(entries))
+        sortedEntries.append(QFileInfo(item).canonicalFilePath());
+    sortedEntries.sort();
+
+    QCOMPARE(list, sortedEntries);
+}
+
+void tst_QDirIterator::parallelLargeTree()
+{
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    QDir root(tempDir.path());
+    for (int i = 0; i < 8; ++i) {
+        const QString subdir = QString::fromLatin1("dir%1/sub%2").arg(i).arg(i % 3);
+        QVERIFY(root.mkpath(subdir));
+        for (int j = 0; j < 300; ++j) {
+            QFile file(root.filePath(subdir + QString::fromLatin1("/file%1.txt").arg(j)));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+        }
+    }
+
+    const QDirIterator::IteratorFlags flags = QDirIterator::Subdirectories;
+    const QStringList nameFilters(QStringLiteral("*.txt"));
+    QStringList expected;
+    for (QDirIterator it(root.path(), nameFilters, QDir::Files, flags); it.hasNext(); )
+        expected << it.next();
+    QCOMPARE(expected.size(), 8 * 300);
+    expected.sort();
+
+    QStringList actual;
+    for (QDirIterator it(root.path(), nameFilters, QDir::Files, flags | QDirIterator::Parallel);
+         it.hasNext(); ) {
+        actual << it.next();
+    }
+    actual.sort();
+    QCOMPARE(actual, expected);
+
+    // destroying the iterator early stops the walk
+    {
+        QDirIterator it(root.path(), QDir::AllEntries, flags | QDirIterator::Parallel);
+        QVERIFY(it.hasNext());
+        it.next();
+    }
+}
+
 void tst_QDirIterator::iterateResource_data()
 {
     QTest::addColumn<QString>("dirName"); // relative from current path or abs
@@ -471,6 +547,13 @@ void tst_QDirIterator::stopLinkLoop()
         it.next();
     QVERIFY(max);
 
+    QDirIterator parallelIt(QLatin1String("entrylist"), QDirIterator::Subdirectories
+                            | QDirIterator::FollowSymlinks | QDirIterator::Parallel);
+    max = 200;
+    while (--max && parallelIt.hasNext())
+        parallelIt.next();
+    QVERIFY(max);
+
     // The goal of this test is only to ensure that the test above don't malfunction
 }
 
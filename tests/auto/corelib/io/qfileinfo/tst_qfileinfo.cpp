@@ -244,6 +244,8 @@ private slots:
     void invalidState();
     void nonExistingFile();
 
+    void sharedCaching();
+
 private:
     const QString m_currentDir;
     QString m_sourceFile;
@@ -1992,5 +1994,48 @@ void tst_QFileInfo::nonExistingFile()
     stateCheck(info, dirname, filename);
 }
 
+void tst_QFileInfo::sharedCaching()
+{
+    QVERIFY(!QFileInfo::sharedCaching());
+    QFileInfo::setSharedCaching(true);
+    QVERIFY(QFileInfo::sharedCaching());
+
+    const QString path = QDir::current().absoluteFilePath(QStringLiteral("sharedCaching.txt"));
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write("0123456789"), qint64(10));
+    file.close();
+    QCOMPARE(QFileInfo(path).size(), qint64(10));
+    QVERIFY(QFileInfo(path).isFile());
+
+    // changes made through Qt are seen at once
+    QVERIFY(file.open(QIODevice::Append));
+    QCOMPARE(file.write("abcde"), qint64(5));
+    file.close();
+    QCOMPARE(QFileInfo(path).size(), qint64(15));
+
+#ifdef Q_OS_LINUX
+    // others are seen once the watcher has reported them
+    QCOMPARE(::truncate(QFile::encodeName(path).constData(), 3), 0);
+    QFileInfo uncached(path);
+    uncached.setCaching(false);
+    QCOMPARE(uncached.size(), qint64(3));
+    QTRY_COMPARE(QFileInfo(path).size(), qint64(3));
+#endif
+
+    QFileInfo info(path);
+    QVERIFY(info.exists());
+    QVERIFY(file.remove());
+    info.refresh();
+    QVERIFY(!info.exists());
+    QVERIFY(!QFileInfo::exists(path));
+
+    // relative paths bypass the cache
+    QVERIFY(!QFileInfo(QStringLiteral("sharedCaching.txt")).exists());
+
+    QFileInfo::setSharedCaching(false);
+    QVERIFY(!QFileInfo::sharedCaching());
+}
+
 QTEST_MAIN(tst_QFileInfo)
 #include "tst_qfileinfo.moc"
@@ -74,6 +74,7 @@ private slots:
     void signalsEmittedAfterFileMoved();
 
     void watchUnicodeCharacters();
+    void manyPaths();
 
 private:
     QString m_tempDirPattern;
@@ -773,6 +774,55 @@ void tst_QFileSystemWatcher::watchUnicodeCharacters()
     QVERIFY(testDir.mkdir("creme"));
     QTRY_COMPARE(changedSpy.count(), 1);
 }
+
+void tst_QFileSystemWatcher::manyPaths()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const int count = 1000;
+    QDir testDir(temporaryDirectory.path());
+    QStringList files, directories;
+    for (int i = 0; i < count; ++i) {
+        const QString name = QString::number(i);
+        QVERIFY(testDir.mkdir(QLatin1String("d") + name));
+        directories << testDir.filePath(QLatin1String("d") + name);
+        QFile file(testDir.filePath(QLatin1String("f") + name));
+        QVERIFY2(file.open(QIODevice::WriteOnly), msgFileOperationFailed("open", file));
+        files << file.fileName();
+    }
+
+    QFileSystemWatcher watcher;
+    QCOMPARE(watcher.addPaths(files + directories), QStringList());
+    QCOMPARE(watcher.files(), files);
+    QCOMPARE(watcher.directories(), directories);
+
+    // paths that are already watched are not added again
+    QCOMPARE(watcher.addPaths(directories.mid(0, 10)), directories.mid(0, 10));
+    QCOMPARE(watcher.directories().size(), count);
+
+    // remove every other path
+    QStringList removed, remainingFiles, remainingDirectories;
+    for (int i = 0; i < count; ++i) {
+        if (i % 2) {
+            removed << files.at(i) << directories.at(i);
+        } else {
+            remainingFiles << files.at(i);
+            remainingDirectories << directories.at(i);
+        }
+    }
+    QCOMPARE(watcher.removePaths(removed), QStringList());
+    QCOMPARE(watcher.files(), remainingFiles);
+    QCOMPARE(watcher.directories(), remainingDirectories);
+
+    FileSystemWatcherSpy changedSpy(&watcher, FileSystemWatcherSpy::SpyOnDirectoryChanged);
+    QVERIFY(QDir(remainingDirectories.last()).mkdir("sub"));
+    QTRY_COMPARE(changedSpy.count(), 1);
+
+    QCOMPARE(watcher.removePaths(remainingFiles + remainingDirectories), QStringList());
+    QVERIFY(watcher.files().isEmpty());
+    QVERIFY(watcher.directories().isEmpty());
+}
 #endif // QT_NO_FILESYSTEMWATCHER
 
 QTEST_MAIN(tst_QFileSystemWatcher)
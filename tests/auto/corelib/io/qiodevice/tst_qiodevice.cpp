@@ -60,6 +60,10 @@ private slots:
     void skipAfterPeek_data();
     void skipAfterPeek();
 
+    void readSpan_data();
+    void readSpan();
+    void readSpanMappedFile();
+
     void transaction_data();
     void transaction();
 
@@ -719,6 +723,94 @@ void tst_QIODevice::skipAfterPeek()
     QCOMPARE(readSoFar, data.size());
 }
 
+void tst_QIODevice::readSpan_data()
+{
+    QTest::addColumn<bool>("sequential");
+    QTest::addColumn<QByteArray>("data");
+
+    QByteArray bigData;
+    bigData.fill('a', 20000);
+    for (int i = 0; i < bigData.size(); ++i)
+        bigData[i] = char('a' + i % 26);
+
+    QTest::newRow("sequential") << true << bigData;
+    QTest::newRow("random-access") << false << bigData;
+}
+
+void tst_QIODevice::readSpan()
+{
+    QFETCH(bool, sequential);
+    QFETCH(QByteArray, data);
+
+    QScopedPointer<QIODevice> dev(sequential ? (QIODevice *) new SequentialReadBuffer(&data)
+                                             : (QIODevice *) new QBuffer(&data));
+    QVERIFY(dev->open(QIODevice::ReadOnly));
+
+    QByteArray result;
+    qint64 maxSize = 1;
+    forever {
+        // the peeked data is only valid until the next read
+        const QByteArray peeked = dev->peekSpan(maxSize);
+        QCOMPARE(peeked, data.mid(result.size(), peeked.size()));
+        const bool peekedNothing = peeked.isEmpty();
+        const QByteArray span = dev->readSpan(maxSize);
+        if (span.isEmpty()) {
+            QVERIFY(peekedNothing);
+            break;
+        }
+        QVERIFY(span.size() <= maxSize);
+        QCOMPARE(span, data.mid(result.size(), span.size()));
+        result += span;
+        if (!sequential)
+            QCOMPARE(dev->pos(), qint64(result.size()));
+
+        // interleave with ordinary reads
+        result += dev->read(3);
+        maxSize = maxSize * 3 + 1;
+    }
+    QCOMPARE(result, data);
+    QVERIFY(dev->atEnd());
+}
+
+void tst_QIODevice::readSpanMappedFile()
+{
+    QFile file(QFINDTESTDATA("tst_qiodevice.cpp"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QVERIFY(contents.size() > 100);
+    QVERIFY(file.seek(10));
+
+    const QByteArray first = file.readSpan(50);
+    QCOMPARE(first, contents.mid(10, 50));
+    QCOMPARE(file.pos(), qint64(60));
+    QCOMPARE(file.read(5), contents.mid(60, 5));
+
+    const QByteArray rest = file.readSpan(contents.size());
+    QCOMPARE(rest, contents.mid(65));
+    QVERIFY(file.atEnd());
+    QVERIFY(file.readSpan(10).isEmpty());
+
+    // spans stay valid while the file is open and positions behave as usual
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.peekSpan(20), contents.left(20));
+    QCOMPARE(file.read(20), contents.left(20));
+    QCOMPARE(first, contents.mid(10, 50));
+    QCOMPARE(file.error(), QFile::NoError);
+    file.close();
+
+    // in Text mode, a copy is returned
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QByteArray text;
+    forever {
+        const QByteArray span = file.readSpan(4096);
+        if (span.isEmpty())
+            break;
+        text += span;
+    }
+    QVERIFY(file.atEnd());
+    QVERIFY(!text.contains('\r'));
+}
+
 void tst_QIODevice::transaction_data()
 {
     QTest::addColumn<bool>("sequential");
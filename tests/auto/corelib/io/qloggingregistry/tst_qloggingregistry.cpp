@@ -297,6 +297,48 @@ private slots:
         QVERIFY(!cat.isWarningEnabled());
     }
 
+    void QLoggingRegistry_sharedCategoryNames()
+    {
+        // categories with the same name share the evaluated rules, but not
+        // their default levels
+        QLoggingRegistry *registry = QLoggingRegistry::instance();
+        QLoggingSettingsParser parser;
+        parser.setContent("[Rules]\n"
+                          "Digia.Oslo.warning=false\n"
+                          "Digia.*.info=true");
+        registry->ruleSets[QLoggingRegistry::ApiRules].clear();
+        registry->ruleSets[QLoggingRegistry::ConfigRules] = parser.rules();
+        registry->ruleSets[QLoggingRegistry::EnvironmentRules].clear();
+        registry->updateRules();
+
+        QLoggingCategory debugCat("Digia.Oslo");
+        QLoggingCategory criticalCat("Digia.Oslo", QtCriticalMsg);
+        QVERIFY(debugCat.isDebugEnabled());
+        QVERIFY(debugCat.isInfoEnabled());
+        QVERIFY(!debugCat.isWarningEnabled());
+        QVERIFY(debugCat.isCriticalEnabled());
+        QVERIFY(!criticalCat.isDebugEnabled());
+        QVERIFY(criticalCat.isInfoEnabled());
+        QVERIFY(!criticalCat.isWarningEnabled());
+        QVERIFY(criticalCat.isCriticalEnabled());
+
+        // changing the rules must not reuse the old results
+        parser.setContent("[Rules]\nDigia.Oslo=false");
+        registry->ruleSets[QLoggingRegistry::ConfigRules] = parser.rules();
+        registry->updateRules();
+        QLoggingCategory newCat("Digia.Oslo");
+        for (const QLoggingCategory *cat : { &debugCat, &criticalCat, &newCat }) {
+            QVERIFY(!cat->isDebugEnabled());
+            QVERIFY(!cat->isInfoEnabled());
+            QVERIFY(!cat->isWarningEnabled());
+            QVERIFY(!cat->isCriticalEnabled());
+        }
+
+        registry->ruleSets[QLoggingRegistry::ConfigRules].clear();
+        registry->updateRules();
+        QVERIFY(newCat.isDebugEnabled());
+        QVERIFY(newCat.isCriticalEnabled());
+    }
 
     void QLoggingRegistry_checkErrors()
     {
@@ -40,6 +40,10 @@
 #include <QtNetwork/QHostInfo>
 #include <stdlib.h>
 
+#ifdef Q_OS_UNIX
+#  include <unistd.h>
+#endif
+
 typedef void (QProcess::*QProcessFinishedSignal1)(int);
 typedef void (QProcess::*QProcessFinishedSignal2)(int, QProcess::ExitStatus);
 typedef void (QProcess::*QProcessErrorSignal)(QProcess::ProcessError);
@@ -83,6 +87,7 @@ private slots:
     void softExitInSlots_data();
     void softExitInSlots();
     void mergedChannels();
+    void pipeBufferSize();
     void forwardedChannels_data();
     void forwardedChannels();
     void atEnd();
@@ -108,6 +113,9 @@ private slots:
     void switchReadChannels();
     void discardUnwantedOutput();
     void setWorkingDirectory();
+#ifdef Q_OS_UNIX
+    void setupChildProcess();
+#endif
     void setNonExistentWorkingDirectory();
 
     void exitStatus_data();
@@ -1044,6 +1052,25 @@ void tst_QProcess::mergedChannels()
     QCOMPARE(process.exitCode(), 0);
 }
 
+void tst_QProcess::pipeBufferSize()
+{
+    QProcess process;
+    QCOMPARE(process.pipeBufferSize(), 0);
+    process.setPipeBufferSize(-1);
+    QCOMPARE(process.pipeBufferSize(), 0);
+    process.setPipeBufferSize(1024 * 1024);
+    QCOMPARE(process.pipeBufferSize(), 1024 * 1024);
+
+    process.start("testProcessOutput/testProcessOutput");
+    QVERIFY(process.waitForFinished(5000));
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(process.exitCode(), 0);
+
+    const QString output = process.readAll();
+    QCOMPARE(output.count("\n"), 10*1024);
+    QVERIFY(output.trimmed().endsWith("10239 -this is a number"));
+}
+
 void tst_QProcess::forwardedChannels_data()
 {
     QTest::addColumn<int>("mode");
@@ -2246,6 +2273,29 @@ void tst_QProcess::setNonExistentWorkingDirectory()
 #endif
 }
 
+#ifdef Q_OS_UNIX
+class SetupChildProcess : public QProcess
+{
+protected:
+    void setupChildProcess() override
+    {
+        ::write(STDOUT_FILENO, "setup\n", 6);
+    }
+};
+
+void tst_QProcess::setupChildProcess()
+{
+    // the override must run in the child, so QProcess cannot use posix_spawn()
+    SetupChildProcess process;
+    process.start("testProcessOutput/testProcessOutput");
+    QVERIFY2(process.waitForFinished(5000), qPrintable(process.errorString()));
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(process.exitCode(), 0);
+    QCOMPARE(process.readLine(), QByteArray("setup\n"));
+    QCOMPARE(process.readLine(), QByteArray("0 -this is a number\n"));
+}
+#endif
+
 void tst_QProcess::startFinishStartFinish()
 {
     QProcess process;
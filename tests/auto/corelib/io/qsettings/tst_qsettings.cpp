@@ -185,6 +185,7 @@ private slots:
     void testByteArrayNativeFormat();
     void iniCodec();
     void bom();
+    void unchangedIniSections();
     void embeddedZeroByte_data();
     void embeddedZeroByte();
 
@@ -717,6 +718,40 @@ void tst_QSettings::bom()
     QVERIFY(allkeys.contains("section2/foo2"));
 }
 
+void tst_QSettings::unchangedIniSections()
+{
+    QTemporaryFile tempFile;
+    QVERIFY2(tempFile.open(), qPrintable(tempFile.errorString()));
+    tempFile.write("[a]\nkey=1\n\n[b]\n; comment\nkey=2\n\n[b\\c]\nkey=3\n\n[d]\nkey=4\n");
+    const QString fileName = tempFile.fileName();
+    tempFile.close();
+
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        settings.setValue("a/key", 5);
+        settings.remove("d/key");
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+    }
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QVERIFY(contents.contains("; comment"));
+    QVERIFY(!contents.contains("[d]"));
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    QCOMPARE(settings.allKeys(), QStringList() << "a/key" << "b/c/key" << "b/key");
+    QCOMPARE(settings.value("a/key").toInt(), 5);
+    QCOMPARE(settings.value("b/key").toInt(), 2);
+    QCOMPARE(settings.value("b/c/key").toInt(), 3);
+
+    settings.setValue("b/c/key", 6);
+    settings.sync();
+    QCOMPARE(settings.value("b/key").toInt(), 2);
+    QCOMPARE(settings.value("b/c/key").toInt(), 6);
+}
+
 void tst_QSettings::embeddedZeroByte_data()
 {
     QTest::addColumn<QVariant>("value");
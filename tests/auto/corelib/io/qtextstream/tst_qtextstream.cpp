@@ -79,6 +79,7 @@ private slots:
     void readLineMaxlen();
     void readLinesFromBufferCRCR();
     void readLineInto();
+    void readAcrossBufferBoundary();
 
     // all
     void readAllFromDevice_data();
@@ -663,6 +664,43 @@ void tst_QTextStream::readLineInto()
     QVERIFY(line.isEmpty());
 }
 
+void tst_QTextStream::readAcrossBufferBoundary()
+{
+    // lines and numbers that straddle the internal read buffer, including a
+    // "\r\n" that is split between two reads
+    QByteArray data;
+    QList<QByteArray> lines;
+    for (int i = 0; data.size() < 100000; ++i) {
+        QByteArray line = QByteArray::number(i * 7919) + ' ' + QByteArray::number(i);
+        lines << line;
+        data += line + (i % 3 ? "\n" : "\r\n");
+    }
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QTextStream ts(&buffer);
+    QString line;
+    int count = 0;
+    while (ts.readLineInto(&line)) {
+        QCOMPARE(line.toLatin1(), lines.at(count));
+        ++count;
+    }
+    QCOMPARE(count, lines.size());
+
+    QVERIFY(buffer.seek(0));
+    ts.setDevice(&buffer);
+    for (int i = 0; i < lines.size(); ++i) {
+        qlonglong product, index;
+        ts >> product >> index;
+        QCOMPARE(ts.status(), QTextStream::Ok);
+        QCOMPARE(product, qlonglong(i) * 7919);
+        QCOMPARE(index, qlonglong(i));
+    }
+    qlonglong dummy;
+    ts >> dummy;
+    QCOMPARE(ts.status(), QTextStream::ReadPastEnd);
+}
+
 // ------------------------------------------------------------------------------
 void tst_QTextStream::readLineFromString_data()
 {
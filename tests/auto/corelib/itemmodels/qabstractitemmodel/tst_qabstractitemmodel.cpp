@@ -52,6 +52,7 @@ private slots:
     void data();
     void headerData();
     void itemData();
+    void multiData();
     void itemFlags();
     void match();
     void dropMimeData_data();
@@ -410,6 +411,33 @@ void tst_QAbstractItemModel::itemData()
     QCOMPARE(dat.value(Qt::DisplayRole).toString(), QString("0/0"));
 }
 
+void tst_QAbstractItemModel::multiData()
+{
+    QtTestModel model(1, 1);
+    QModelIndex idx = model.index(0, 0, QModelIndex());
+    QVERIFY(idx.isValid());
+
+    QModelRoleData roleData[] = {
+        QModelRoleData(Qt::DisplayRole),
+        QModelRoleData(Qt::DecorationRole),
+        QModelRoleData(Qt::UserRole)
+    };
+    roleData[1].setData(42);
+    QModelRoleDataSpan span(roleData);
+    QCOMPARE(span.size(), 3);
+
+    // QtTestModel returns the same data for every role
+    idx.multiData(span);
+    for (const QModelRoleData &data : roleData)
+        QCOMPARE(data.data(), model.data(idx, data.role()));
+    QCOMPARE(span.dataForRole(Qt::DisplayRole), &roleData[0].data());
+    QVERIFY(!span.dataForRole(Qt::ToolTipRole));
+
+    // An index without a model clears the data
+    QModelIndex().multiData(span);
+    QVERIFY(!roleData[0].data().isValid());
+}
+
 void tst_QAbstractItemModel::itemFlags()
 {
     QtTestModel model(1, 1);
@@ -111,6 +111,9 @@ private slots:
     void sortColumnTracking2();
 
     void sortStable();
+    void sortKeyCaching_data();
+    void sortKeyCaching();
+    void narrowFixedStringFilter();
 
     void hiddenColumns();
     void insertRowsSort();
@@ -2580,6 +2583,93 @@ void tst_QSortFilterProxyModel::sortStable()
     QCOMPARE(lastItemData, filterModel->index(2,0, firstRoot).data());
 }
 
+void tst_QSortFilterProxyModel::sortKeyCaching_data()
+{
+    QTest::addColumn<QVariantList>("values");
+    QTest::addColumn<bool>("localeAware");
+
+    QTest::newRow("int") << (QVariantList() << 3 << -1 << 7 << 3 << 0 << -20) << false;
+    QTest::newRow("uint") << (QVariantList() << 3u << 1u << 4294967295u << 3u << 0u) << false;
+    QTest::newRow("double") << (QVariantList() << 2.5 << -1.0 << 1e10 << 2.5 << 0.1) << false;
+    QTest::newRow("string") << (QVariantList() << "b" << "A" << "a" << "c" << "B" << "a") << false;
+    QTest::newRow("string, locale aware") << (QVariantList() << "b" << "A" << "a" << "c" << "B" << "a") << true;
+    QTest::newRow("date") << (QVariantList() << QDate(2010, 1, 1) << QDate(2000, 5, 5) << QDate(2010, 1, 1)) << false;
+    QTest::newRow("mixed") << (QVariantList() << 3 << "x" << 2.5 << QVariant() << 1 << QVariant()) << false;
+}
+
+void tst_QSortFilterProxyModel::sortKeyCaching()
+{
+    QFETCH(QVariantList, values);
+    QFETCH(bool, localeAware);
+
+    QStandardItemModel model(values.size(), 1);
+    for (int row = 0; row < values.size(); ++row) {
+        QStandardItem *item = new QStandardItem(QString::number(row));
+        item->setData(values.at(row), Qt::UserRole);
+        model.setItem(row, 0, item);
+    }
+
+    QSortFilterProxyModel expectedProxy;
+    expectedProxy.setSortRole(Qt::UserRole);
+    expectedProxy.setSortCaseSensitivity(Qt::CaseInsensitive);
+    expectedProxy.setSortLocaleAware(localeAware);
+    expectedProxy.setSourceModel(&model);
+
+    QSortFilterProxyModel proxy;
+    QVERIFY(!proxy.isSortKeyCachingEnabled());
+    proxy.setSortKeyCachingEnabled(true);
+    QVERIFY(proxy.isSortKeyCachingEnabled());
+    proxy.setSortRole(Qt::UserRole);
+    proxy.setSortCaseSensitivity(Qt::CaseInsensitive);
+    proxy.setSortLocaleAware(localeAware);
+    proxy.setSourceModel(&model);
+
+    for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder }) {
+        expectedProxy.sort(0, order);
+        proxy.sort(0, order);
+        for (int row = 0; row < values.size(); ++row)
+            QCOMPARE(proxy.index(row, 0).data(), expectedProxy.index(row, 0).data());
+    }
+}
+
+void tst_QSortFilterProxyModel::narrowFixedStringFilter()
+{
+    class CountingProxy : public QSortFilterProxyModel
+    {
+    public:
+        mutable QSet<int> checkedRows;
+    protected:
+        bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override
+        {
+            checkedRows.insert(source_row);
+            return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+        }
+    };
+
+    QStringListModel model(QStringList() << "apple" << "apricot" << "banana" << "grape" << "april");
+    CountingProxy proxy;
+    proxy.setSourceModel(&model);
+
+    proxy.setFilterFixedString("a");
+    QCOMPARE(proxy.rowCount(), 5);
+    proxy.setFilterFixedString("ap");
+    QCOMPARE(proxy.rowCount(), 4);
+
+    // Rows rejected by "ap" cannot match "apr", so they are not checked again.
+    proxy.checkedRows.clear();
+    proxy.setFilterFixedString("apr");
+    QCOMPARE(proxy.rowCount(), 2);
+    QCOMPARE(proxy.checkedRows, QSet<int>() << 0 << 1 << 3 << 4);
+    QCOMPARE(proxy.index(0, 0).data().toString(), QString("apricot"));
+    QCOMPARE(proxy.index(1, 0).data().toString(), QString("april"));
+
+    // Widening the filter checks all rows again.
+    proxy.checkedRows.clear();
+    proxy.setFilterFixedString("p");
+    QCOMPARE(proxy.rowCount(), 4);
+    QCOMPARE(proxy.checkedRows.size(), 5);
+}
+
 void tst_QSortFilterProxyModel::hiddenColumns()
 {
     class MyStandardItemModel : public QStandardItemModel
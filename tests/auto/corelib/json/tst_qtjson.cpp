@@ -32,6 +32,8 @@
 #include "qjsonobject.h"
 #include "qjsonvalue.h"
 #include "qjsondocument.h"
+#include "qjsonstream.h"
+#include "qjsonbuilder.h"
 #include "qregularexpression.h"
 #include <limits>
 
@@ -135,6 +137,9 @@ private Q_SLOTS:
     void nesting();
 
     void longStrings();
+    void stringRuns_data();
+    void stringRuns();
+    void whitespaceRuns();
 
     void arrayInitializerList();
     void objectInitializerList();
@@ -151,6 +156,22 @@ private Q_SLOTS:
     void implicitValueType();
     void implicitDocumentType();
 
+    void streamReaderTokens();
+    void streamReaderReadValue_data();
+    void streamReaderReadValue();
+    void streamReaderChunked();
+    void streamReaderJsonLines();
+    void streamReaderSkipValue();
+    void streamReaderErrors_data();
+    void streamReaderErrors();
+    void streamWriter_data();
+    void streamWriter();
+    void streamWriterJsonLines();
+
+    void objectBuilder();
+    void arrayBuilder();
+    void builderBinaryFormat();
+
 private:
     QString testDataDir;
 };
@@ -2716,6 +2737,59 @@ void tst_QtJson::testJsonValueRefDefault()
     QCOMPARE(empty["n/a"].toDouble(42.0), 42.0);
 }
 
+void tst_QtJson::stringRuns_data()
+{
+    QTest::addColumn<QByteArray>("insert");
+    QTest::addColumn<QString>("decoded");
+
+    QTest::newRow("ascii") << QByteArray() << QString();
+    QTest::newRow("escape") << QByteArray("\\n") << QString("\n");
+    QTest::newRow("quote") << QByteArray("\\\"") << QString("\"");
+    QTest::newRow("latin1") << QByteArray("\xc3\xa9") << QString::fromUtf8("\xc3\xa9");
+    QTest::newRow("utf16") << QByteArray("\xe2\x82\xac") << QString::fromUtf8("\xe2\x82\xac");
+    QTest::newRow("surrogates") << QByteArray("\xf0\x9f\x98\x80") << QString::fromUtf8("\xf0\x9f\x98\x80");
+}
+
+void tst_QtJson::stringRuns()
+{
+    // ASCII runs of all lengths around the block size of the scanner,
+    // interrupted by other characters at every position
+    QFETCH(QByteArray, insert);
+    QFETCH(QString, decoded);
+
+    for (int length = 0; length < 40; ++length) {
+        for (int at = 0; at <= length; ++at) {
+            QByteArray ascii(length, 'a');
+            for (int i = 0; i < length; ++i) {
+                const char c = char(' ' + (i * 13) % 95);
+                ascii[i] = (c == '"' || c == '\\') ? 'b' : c;
+            }
+            QString expected = QString::fromLatin1(ascii);
+            expected.insert(at, decoded);
+            ascii.insert(at, insert);
+
+            const QByteArray json = "[\"" + ascii + "\", {\"" + ascii + "\": 1}]";
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            QVERIFY2(error.error == QJsonParseError::NoError, json.constData());
+            QCOMPARE(doc.array().at(0).toString(), expected);
+            QCOMPARE(doc.array().at(1).toObject().keys(), QStringList(expected));
+        }
+    }
+}
+
+void tst_QtJson::whitespaceRuns()
+{
+    for (int indent = 0; indent < 40; ++indent) {
+        const QByteArray ws = QByteArray(indent, ' ') + (indent % 3 ? "\t\r\n" : "");
+        const QByteArray json = "[" + ws + "1," + ws + "{" + ws + "\"a\"" + ws + ":" + ws + "true" + ws + "}" + ws + "]" + ws;
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QVERIFY2(error.error == QJsonParseError::NoError, json.constData());
+        QCOMPARE(doc.array(), (QJsonArray { 1, QJsonObject { { "a", true } } }));
+    }
+}
+
 void tst_QtJson::arrayInitializerList()
 {
 #ifndef Q_COMPILER_INITIALIZER_LISTS
@@ -2986,5 +3060,454 @@ void tst_QtJson::implicitDocumentType()
     QCOMPARE(arrayDocument[-1].toInt(123), 123);
 }
 
+void tst_QtJson::streamReaderTokens()
+{
+    QJsonStreamReader reader(QByteArray("\xef\xbb\xbf { \"a\": [1, -2.5e1, \"x\\u00e9\\n\"], \"b\": {}, \"c\": true, \"d\": null }"));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.name(), QString("a"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.depth(), 2);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.value(), QJsonValue(1));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.value(), QJsonValue(-25));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.value(), QJsonValue(QString::fromUtf8("x\xc3\xa9\n")));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.name(), QString("b"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Bool);
+    QCOMPARE(reader.value(), QJsonValue(true));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.name(), QString("d"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Null);
+    QCOMPARE(reader.value(), QJsonValue(QJsonValue::Null));
+    QVERIFY(!reader.atEnd());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 0);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QCOMPARE(reader.tokenString(), QString("EndDocument"));
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QtJson::streamReaderReadValue_data()
+{
+    QTest::addColumn<QString>("fileName");
+
+    QTest::newRow("test.json") << QString("test.json");
+    QTest::newRow("test2.json") << QString("test2.json");
+    QTest::newRow("test3.json") << QString("test3.json");
+}
+
+void tst_QtJson::streamReaderReadValue()
+{
+    QFETCH(QString, fileName);
+
+    QFile file(testDataDir + '/' + fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QByteArray json = file.readAll();
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    QVERIFY(!doc.isNull());
+
+    QVERIFY(file.seek(0));
+    QJsonStreamReader reader(&file);
+    reader.readNext();
+    const QJsonValue value = reader.readValue();
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    if (doc.isObject())
+        QCOMPARE(value, QJsonValue(doc.object()));
+    else
+        QCOMPARE(value, QJsonValue(doc.array()));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QCOMPARE(reader.characterOffset(), qint64(json.size()));
+}
+
+void tst_QtJson::streamReaderChunked()
+{
+    const QByteArray json = "{\"key\": [\"abc\\u20ac\\\"\xce\xba\", 12345.5, false, null], \"k" "\xf0\x9f\x98\x80\": true}";
+    const QJsonValue expected = QJsonDocument::fromJson(json).object();
+
+    // feed one byte at a time, resuming after each premature end
+    QJsonStreamReader reader;
+    QVector<QJsonStreamReader::TokenType> tokens;
+    int fed = 0;
+    while (tokens.isEmpty() || tokens.last() != QJsonStreamReader::EndObject) {
+        const QJsonStreamReader::TokenType t = reader.readNext();
+        if (t == QJsonStreamReader::Invalid || t == QJsonStreamReader::EndDocument) {
+            // nothing at all has been read before the first byte arrives
+            if (t == QJsonStreamReader::EndDocument)
+                QCOMPARE(fed, 0);
+            else
+                QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+            QVERIFY(reader.atEnd());
+            QVERIFY(fed < json.size());
+            reader.addData(json.mid(fed++, 1));
+            continue;
+        }
+        tokens.append(t);
+        if (t == QJsonStreamReader::Name && tokens.size() == 9) {
+            QCOMPARE(reader.name(), QString::fromUtf8("k\xf0\x9f\x98\x80"));
+        } else if (t == QJsonStreamReader::String) {
+            QCOMPARE(reader.value().toString(), QString::fromUtf8("abc\xe2\x82\xac\"\xce\xba"));
+        } else if (t == QJsonStreamReader::Number) {
+            QCOMPARE(reader.value().toDouble(), 12345.5);
+        }
+    }
+    QCOMPARE(fed, json.size());
+    QCOMPARE(tokens.size(), 11);
+
+    // a device delivering the same data in a single read
+    QBuffer buffer;
+    buffer.setData(json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader deviceReader(&buffer);
+    deviceReader.readNext();
+    QCOMPARE(deviceReader.readValue(), expected);
+}
+
+void tst_QtJson::streamReaderJsonLines()
+{
+    QByteArray json;
+    for (int i = 0; i < 1000; ++i)
+        json += "{\"id\": " + QByteArray::number(i) + ", \"name\": \"record " + QByteArray::number(i) + "\"}\n";
+    json += "42\n\"str\"\n[]\n7";
+
+    // larger than the reader's chunk size, so records straddle reads
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    int records = 0;
+    while (reader.readNext() == QJsonStreamReader::StartObject) {
+        const QJsonObject o = reader.readValue().toObject();
+        QCOMPARE(o.value("id").toInt(), records);
+        QCOMPARE(o.value("name").toString(), QString("record %1").arg(records));
+        ++records;
+    }
+    QCOMPARE(records, 1000);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Number);
+    QCOMPARE(reader.value(), QJsonValue(42));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    // a number at the very end of the input is complete at the top level
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.value(), QJsonValue(7));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // EndDocument is not sticky when more data arrives
+    QJsonStreamReader incremental(QByteArray("{}\n"));
+    QCOMPARE(incremental.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(incremental.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(incremental.readNext(), QJsonStreamReader::EndDocument);
+    incremental.addData("[true]");
+    QCOMPARE(incremental.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(incremental.readNext(), QJsonStreamReader::Bool);
+    QCOMPARE(incremental.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(incremental.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QtJson::streamReaderSkipValue()
+{
+    QJsonStreamReader reader(QByteArray("{\"skip\": {\"a\": [1, {\"b\": []}]}, \"keep\": \"yes\", \"also\": [[]]}"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    reader.skipValue();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.name(), QString("keep"));
+    QCOMPARE(reader.readValue(), QJsonValue("yes"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    reader.skipValue();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QtJson::streamReaderErrors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<int>("error");
+
+    // the same inputs as parseErrorOffset(), which fromJson() rejects
+    QTest::newRow("Trailing comma in object") << QByteArray("{ \"value\": false, }") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Trailing comma in array") << QByteArray("[ false, ]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Missing value in object") << QByteArray("{ \"value\": , } ") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Missing value in array") << QByteArray("[ \"value\" , , ] ") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Leading comma in object") << QByteArray("{ ,  \"value\": false}") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Leading comma in array") << QByteArray("[ ,  false]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Stray ,") << QByteArray("  ,  ") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Stray }") << QByteArray("  }  ") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Missing name separator") << QByteArray("{\"a\" 1}") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Missing value separator") << QByteArray("[1 2]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Illegal number") << QByteArray("[-]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Illegal literal") << QByteArray("[nul]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Invalid UTF-8") << QByteArray("[\"" INVALID_UNICODE "\"]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Bad escape") << QByteArray("[\"\\u12g4\"]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Deep nesting") << QByteArray(1025, '[') << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("Stray [") << QByteArray("  [  ") << int(QJsonStreamReader::PrematureEndOfDocumentError);
+    QTest::newRow("Unterminated string") << QByteArray("[\"abc") << int(QJsonStreamReader::PrematureEndOfDocumentError);
+    QTest::newRow("Unterminated literal") << QByteArray("tru") << int(QJsonStreamReader::PrematureEndOfDocumentError);
+    QTest::newRow("Number in array") << QByteArray("[12") << int(QJsonStreamReader::PrematureEndOfDocumentError);
+}
+
+void tst_QtJson::streamReaderErrors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(int, error);
+
+    QJsonStreamReader reader(json);
+    while (!reader.atEnd())
+        reader.readNext();
+    QCOMPARE(int(reader.error()), error);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QVERIFY(!reader.errorString().isEmpty());
+    if (error == QJsonStreamReader::NotWellFormedError) {
+        // syntax errors are final
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+        QCOMPARE(int(reader.error()), error);
+    }
+}
+
+void tst_QtJson::streamWriter_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<bool>("autoFormatting");
+
+    const char *files[] = { "test.json", "test2.json", "test3.json" };
+    for (const char *file : files) {
+        QTest::newRow(QByteArray(file).append(" compact")) << QString(file) << false;
+        QTest::newRow(QByteArray(file).append(" indented")) << QString(file) << true;
+    }
+}
+
+void tst_QtJson::streamWriter()
+{
+    QFETCH(QString, fileName);
+    QFETCH(bool, autoFormatting);
+
+    QFile file(testDataDir + '/' + fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    QVERIFY(!doc.isNull());
+    const QByteArray expected = doc.toJson(autoFormatting ? QJsonDocument::Indented : QJsonDocument::Compact);
+
+    QByteArray fromValue;
+    QJsonStreamWriter writer(&fromValue);
+    writer.setAutoFormatting(autoFormatting);
+    writer.writeValue(doc.isObject() ? QJsonValue(doc.object()) : QJsonValue(doc.array()));
+    QCOMPARE(writer.depth(), 0);
+    QCOMPARE(fromValue, expected);
+
+    // copy token by token from a reader to a writer on a device
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QJsonStreamWriter deviceWriter(&buffer);
+    deviceWriter.setAutoFormatting(autoFormatting);
+    QJsonStreamReader reader(expected);
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::StartObject: deviceWriter.writeStartObject(); break;
+        case QJsonStreamReader::EndObject: deviceWriter.writeEndObject(); break;
+        case QJsonStreamReader::StartArray: deviceWriter.writeStartArray(); break;
+        case QJsonStreamReader::EndArray: deviceWriter.writeEndArray(); break;
+        case QJsonStreamReader::Name: deviceWriter.writeName(reader.name()); break;
+        case QJsonStreamReader::String:
+        case QJsonStreamReader::Number:
+        case QJsonStreamReader::Bool:
+        case QJsonStreamReader::Null:
+            deviceWriter.writeValue(reader.value());
+            break;
+        default:
+            break;
+        }
+    }
+    QVERIFY(!reader.hasError());
+    QVERIFY(!deviceWriter.hasError());
+    QCOMPARE(buffer.data(), expected);
+}
+
+void tst_QtJson::streamWriterJsonLines()
+{
+    QByteArray json;
+    QJsonStreamWriter writer(&json);
+    QVERIFY(!writer.autoFormatting());
+    writer.writeStartObject();
+    writer.writeMember("id", 1);
+    writer.writeStartArray("tags");
+    writer.writeString("a\"b");
+    writer.writeNumber(qInf());
+    writer.writeNumber(0.5);
+    writer.writeEndArray();
+    writer.writeStartObject("empty");
+    writer.writeEndObject();
+    writer.writeEndObject();
+    writer.writeBool(false);
+    writer.writeNull();
+    QCOMPARE(json, QByteArray("{\"id\":1,\"tags\":[\"a\\\"b\",null,0.5],\"empty\":{}}\nfalse\nnull"));
+
+    QByteArray indented;
+    QJsonStreamWriter indentedWriter(&indented);
+    indentedWriter.setAutoFormatting(true);
+    indentedWriter.writeStartArray();
+    indentedWriter.writeStartObject();
+    indentedWriter.writeEndObject();
+    indentedWriter.writeEndArray();
+    indentedWriter.writeNumber(3);
+    QCOMPARE(indented, QByteArray("[\n    {\n    }\n]\n3\n"));
+    QCOMPARE(indented.left(indented.indexOf("]\n") + 2),
+             QJsonDocument(QJsonArray { QJsonObject() }).toJson(QJsonDocument::Indented));
+
+    // misuse is ignored with a warning
+    QByteArray misuse;
+    QJsonStreamWriter misuseWriter(&misuse);
+    misuseWriter.writeStartObject();
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter::writeNumber: object members need a name");
+    misuseWriter.writeNumber(1);
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter::writeEndArray: no matching array to end");
+    misuseWriter.writeEndArray();
+    misuseWriter.writeEndObject();
+    QCOMPARE(misuse, QByteArray("{}"));
+}
+
+void tst_QtJson::objectBuilder()
+{
+    const QJsonObject nested { { "x", 1 }, { "y", QJsonArray { 1, "two" } } };
+
+    QJsonObjectBuilder builder;
+    QVERIFY(builder.isEmpty());
+    builder.insert("zeta", 1.5);
+    builder.insert("alpha", QString::fromUtf8("Stra\xc3\x9f" "e"));
+    builder.insert(QString::fromUtf8(UNICODE_DJE), QString::fromUtf8(UNICODE_DJE));
+    builder.insert("int", 42);
+    builder.insert("large", 1e300);
+    builder.insert("bool", true);
+    builder.insert("null", QJsonValue());
+    builder.insert("replaced", "first");
+    builder.insert("replaced", "second");
+    builder.insert("removed", 1);
+    builder.insert("undefined", 2);
+    builder.insert("undefined", QJsonValue(QJsonValue::Undefined));
+    builder.insert("frozen", nested);
+    QJsonObjectBuilder &child = builder.insertObject("child");
+    child.insert("b", 2);
+    child.insert("a", 1);
+    child.insertArray("empty");
+    QJsonArrayBuilder &list = builder.insertArray("list");
+    list.append(1);
+    list.appendObject().insert("k", "v");
+    builder.insertObject("emptyObject");
+    QJsonObjectBuilder moved;
+    moved.insert("m", false);
+    builder.insert("moved", std::move(moved));
+    QVERIFY(moved.isEmpty());
+    builder.remove("removed");
+    builder.remove("not there");
+
+    QVERIFY(builder.contains("child"));
+    QVERIFY(!builder.contains("removed"));
+    QVERIFY(!builder.contains("undefined"));
+    QCOMPARE(builder.size(), 13);
+
+    QJsonObject expected;
+    expected.insert("zeta", 1.5);
+    expected.insert("alpha", QString::fromUtf8("Stra\xc3\x9f" "e"));
+    expected.insert(QString::fromUtf8(UNICODE_DJE), QString::fromUtf8(UNICODE_DJE));
+    expected.insert("int", 42);
+    expected.insert("large", 1e300);
+    expected.insert("bool", true);
+    expected.insert("null", QJsonValue());
+    expected.insert("replaced", "second");
+    expected.insert("frozen", nested);
+    expected.insert("child", QJsonObject { { "a", 1 }, { "b", 2 }, { "empty", QJsonArray() } });
+    expected.insert("list", QJsonArray { 1, QJsonObject { { "k", "v" } } });
+    expected.insert("emptyObject", QJsonObject());
+    expected.insert("moved", QJsonObject { { "m", false } });
+
+    const QJsonObject object = builder.toObject();
+    QCOMPARE(object, expected);
+    QCOMPARE(object.keys(), expected.keys());
+    QCOMPARE(object.value("child").toObject().value("a"), QJsonValue(1));
+
+    // freezing leaves the builder usable
+    builder.insert("late", 3);
+    QCOMPARE(builder.toObject().size(), expected.size() + 1);
+    QCOMPARE(object, expected);
+
+    builder.clear();
+    QVERIFY(builder.isEmpty());
+    QCOMPARE(builder.toObject(), QJsonObject());
+}
+
+void tst_QtJson::arrayBuilder()
+{
+    QJsonArrayBuilder builder;
+    builder.reserve(8);
+    builder.append(1);
+    builder.append("latin");
+    builder.append(QString::fromUtf8(UNICODE_DJE));
+    builder.append(QJsonValue(QJsonValue::Undefined));
+    builder.append(2.5);
+    builder.append(QJsonObject { { "a", true } });
+    QJsonArrayBuilder &inner = builder.appendArray();
+    inner.append(false);
+    inner.appendArray();
+    QJsonObjectBuilder object;
+    object.insert("b", "c");
+    builder.append(std::move(object));
+    QCOMPARE(builder.size(), 8);
+
+    const QJsonArray expected {
+        1, "latin", QString::fromUtf8(UNICODE_DJE), QJsonValue(), 2.5,
+        QJsonObject { { "a", true } },
+        QJsonArray { false, QJsonArray() },
+        QJsonObject { { "b", "c" } }
+    };
+    QCOMPARE(builder.toArray(), expected);
+
+    QJsonArrayBuilder moved(std::move(builder));
+    QVERIFY(builder.isEmpty());
+    QCOMPARE(moved.toArray(), expected);
+    QCOMPARE(QJsonArrayBuilder().toArray(), QJsonArray());
+}
+
+void tst_QtJson::builderBinaryFormat()
+{
+    // a builder must produce the same object as incremental insert()s
+    QJsonObject expected;
+    QJsonObjectBuilder builder;
+    for (int i = 0; i < 500; ++i) {
+        const QString key = QString::number((i * 7919) % 500) + (i % 3 ? QString() : QString::fromUtf8(UNICODE_DJE));
+        const QJsonValue value = i % 2 ? QJsonValue(i * 1.25) : QJsonValue(QString(i % 7, QLatin1Char('x') ));
+        expected.insert(key, value);
+        builder.insert(key, value);
+    }
+    const QJsonObject object = builder.toObject();
+    QCOMPARE(object, expected);
+
+    const QByteArray binary = QJsonDocument(object).toBinaryData();
+    QCOMPARE(binary.size(), QJsonDocument(expected).toBinaryData().size());
+    const QJsonDocument validated = QJsonDocument::fromBinaryData(binary, QJsonDocument::Validate);
+    QVERIFY(!validated.isNull());
+    QCOMPARE(validated.object(), expected);
+    QCOMPARE(QJsonDocument(object).toJson(), QJsonDocument(expected).toJson());
+
+    QJsonArrayBuilder array;
+    array.append(object);
+    array.appendObject().insert("x", "y");
+    const QJsonArray arr = array.toArray();
+    QVERIFY(!QJsonDocument::fromBinaryData(QJsonDocument(arr).toBinaryData(), QJsonDocument::Validate).isNull());
+    QCOMPARE(arr.at(0).toObject(), expected);
+}
+
 QTEST_MAIN(tst_QtJson)
 #include "tst_qtjson.moc"
@@ -415,6 +415,75 @@ void tst_QCoreApplication::removePostedEvents()
     expected.clear();
 }
 
+void tst_QCoreApplication::compressPostedQuitEvents()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    EventSpy spy;
+    app.installEventFilter(&spy);
+
+    QCoreApplication::postEvent(&app, new QEvent(QEvent::Quit));
+    QCoreApplication::postEvent(&app, new QEvent(QEvent::Type(QEvent::User + 1)));
+    QCoreApplication::postEvent(&app, new QEvent(QEvent::Quit));
+    QCoreApplication::postEvent(&app, new QEvent(QEvent::Quit));
+    QCoreApplication::sendPostedEvents();
+
+    QList<int> expected;
+    expected << QEvent::Quit << QEvent::User + 1;
+    QCOMPARE(spy.recordedEvents, expected);
+
+    // once the pending event is gone, the next one must be queued again
+    spy.recordedEvents.clear();
+    QCoreApplication::postEvent(&app, new QEvent(QEvent::Quit));
+    QCoreApplication::removePostedEvents(&app, QEvent::Quit);
+    QCoreApplication::postEvent(&app, new QEvent(QEvent::Quit));
+    QCoreApplication::postEvent(&app, new QEvent(QEvent::Quit));
+    QCoreApplication::sendPostedEvents();
+
+    expected.clear();
+    expected << QEvent::Quit;
+    QCOMPARE(spy.recordedEvents, expected);
+}
+
+class SlowEventReceiver : public QObject
+{
+public:
+    int received = 0;
+    bool event(QEvent *event) Q_DECL_OVERRIDE
+    {
+        if (event->type() != QEvent::User)
+            return QObject::event(event);
+        ++received;
+        QThread::msleep(5);
+        return true;
+    }
+};
+
+void tst_QCoreApplication::postedEventsTimeBudget()
+{
+    qputenv("QT_POSTED_EVENTS_TIME_BUDGET", "20");
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+    qunsetenv("QT_POSTED_EVENTS_TIME_BUDGET");
+
+    const int count = 20;
+    SlowEventReceiver receiver;
+    for (int i = 0; i < count; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+
+    // a global pass stops once the budget is used up...
+    QCoreApplication::sendPostedEvents();
+    QVERIFY(receiver.received > 0);
+    QVERIFY(receiver.received < count);
+
+    // ...but sending to a given receiver is never limited
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::User);
+    QCOMPARE(receiver.received, count);
+}
+
 #ifndef QT_NO_THREAD
 class DeliverInDefinedOrderThread : public QThread
 {
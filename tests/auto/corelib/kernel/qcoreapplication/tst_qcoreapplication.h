@@ -43,6 +43,8 @@ private slots:
     void argc();
     void postEvent();
     void removePostedEvents();
+    void compressPostedQuitEvents();
+    void postedEventsTimeBudget();
 #ifndef QT_NO_THREAD
     void deliverInDefinedOrder();
 #endif
@@ -302,6 +302,8 @@ private slots:
     void indexOfMethod();
 
     void indexOfMethodPMF();
+    void indexOfMethodEveryMethod_data();
+    void indexOfMethodEveryMethod();
 
     void signalOffset_data();
     void signalOffset();
@@ -1603,6 +1605,35 @@ void tst_QMetaObject::indexOfMethodPMF()
     INDEXOFMETHODPMF_HELPER(QtTestCustomObject, sig_custom, (const CustomString &))
 }
 
+void tst_QMetaObject::indexOfMethodEveryMethod_data()
+{
+    QTest::addColumn<const QMetaObject *>("mo");
+    QTest::newRow("QObject") << &QObject::staticMetaObject;
+    QTest::newRow("QtTestObject") << &QtTestObject::staticMetaObject;
+    QTest::newRow("tst_QMetaObject") << &tst_QMetaObject::staticMetaObject;
+}
+
+void tst_QMetaObject::indexOfMethodEveryMethod()
+{
+    QFETCH(const QMetaObject *, mo);
+    for (int i = 0; i < mo->methodCount(); ++i) {
+        const QMetaMethod method = mo->method(i);
+        const QByteArray signature = method.methodSignature();
+        // A method redeclared in a derived class hides the inherited one.
+        int expected = i;
+        for (int j = i + 1; j < mo->methodCount(); ++j) {
+            if (mo->method(j).methodSignature() == signature)
+                expected = j;
+        }
+        QCOMPARE(mo->indexOfMethod(signature), expected);
+        if (method.methodType() == QMetaMethod::Signal)
+            QCOMPARE(mo->indexOfSignal(signature), expected);
+        else if (method.methodType() == QMetaMethod::Slot)
+            QCOMPARE(mo->indexOfSlot(signature), expected);
+    }
+    QCOMPARE(mo->indexOfMethod("noSuchMethod()"), -1);
+}
+
 namespace SignalTestHelper
 {
 // These functions use the public QMetaObject/QMetaMethod API to implement
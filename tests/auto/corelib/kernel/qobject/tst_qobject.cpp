@@ -72,6 +72,7 @@ private slots:
     void connectDisconnectNotify_shadowing();
     void emitInDefinedOrder();
     void customTypes();
+    void queuedArgumentPacks();
     void streamCustomTypes();
     void metamethod();
     void namespaces();
@@ -91,7 +92,10 @@ private slots:
     void recursiveSignalEmission();
     void signalBlocking();
     void blockingQueuedConnection();
+    void batchedConnection();
+    void coalescedConnection();
     void childEvents();
+    void deleteChildrenWithPostedEvents();
     void installEventFilter();
     void deleteSelfInSlot();
     void disconnectSelfInSlotAndDeleteAfterEmit();
@@ -1481,6 +1485,73 @@ void tst_QObject::customTypes()
     QCOMPARE(instanceCount, 3);
 }
 
+class QueuedArgumentsSender : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void smallArguments(char c, short s, int i, double d);
+    void manyArguments(const QString &s, CustomType ct, qint64 l, const QByteArray &ba, double d, char c);
+    void largeArguments(const QRectF &r1, const QRectF &r2, const QRectF &r3, CustomType ct);
+};
+
+void tst_QObject::queuedArgumentPacks()
+{
+    qRegisterMetaType<CustomType>();
+    CustomType ct(1, 2, 3);
+    const QRectF r1(1, 2, 3, 4), r2(5, 6, 7, 8), r3(9, 10, 11, 12);
+    int received = 0;
+    {
+        CheckInstanceCount checker;
+        QueuedArgumentsSender sender;
+        QObject context;
+
+        connect(&sender, &QueuedArgumentsSender::smallArguments, &context,
+                [&received](char c, short s, int i, double d) {
+            QCOMPARE(c, 'a');
+            QCOMPARE(s, short(-2));
+            QCOMPARE(i, 3);
+            QCOMPARE(d, 4.5);
+            ++received;
+        }, Qt::QueuedConnection);
+        // more arguments than the event keeps inline
+        connect(&sender, &QueuedArgumentsSender::manyArguments, &context,
+                [&received](const QString &s, CustomType ct, qint64 l, const QByteArray &ba, double d, char c) {
+            QCOMPARE(s, QStringLiteral("string"));
+            QCOMPARE(ct.value(), 6);
+            QCOMPARE(l, Q_INT64_C(1) << 40);
+            QCOMPARE(ba, QByteArray("bytes"));
+            QCOMPARE(d, 0.25);
+            QCOMPARE(c, 'z');
+            ++received;
+        }, Qt::QueuedConnection);
+        // more argument data than the event keeps inline
+        connect(&sender, &QueuedArgumentsSender::largeArguments, &context,
+                [&](const QRectF &a1, const QRectF &a2, const QRectF &a3, CustomType a4) {
+            QCOMPARE(a1, r1);
+            QCOMPARE(a2, r2);
+            QCOMPARE(a3, r3);
+            QCOMPARE(a4.value(), ct.value());
+            ++received;
+        }, Qt::QueuedConnection);
+
+        for (int i = 0; i < 10; ++i) {
+            emit sender.smallArguments('a', -2, 3, 4.5);
+            emit sender.manyArguments(QStringLiteral("string"), ct, Q_INT64_C(1) << 40, "bytes", 0.25, 'z');
+            emit sender.largeArguments(r1, r2, r3, ct);
+        }
+        QCOMPARE(received, 0);
+        QCoreApplication::processEvents();
+        QCOMPARE(received, 30);
+
+        // pending calls are destroyed with their receiver
+        emit sender.manyArguments(QStringLiteral("string"), ct, 0, "bytes", 0.25, 'z');
+        emit sender.largeArguments(r1, r2, r3, ct);
+    }
+    QCoreApplication::processEvents();
+    QCOMPARE(received, 30);
+}
+
 QDataStream &operator<<(QDataStream &stream, const CustomType &ct)
 {
     stream << ct.i1 << ct.i2 << ct.i3;
@@ -3074,6 +3145,127 @@ void tst_QObject::blockingQueuedConnection()
     }
 }
 
+class BatchedEmitThread : public QThread
+{
+public:
+    BatchedEmitThread(SenderObject *sender, int count) : sender(sender), count(count) {}
+
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            emit sender->signal7(i, QString());
+    }
+
+private:
+    SenderObject *sender;
+    int count;
+};
+
+void tst_QObject::batchedConnection()
+{
+    SenderObject sender;
+    QVector<int> received;
+    QVector<int> expected;
+
+    {
+        // calls are delivered in the order they were emitted
+        QObject context;
+        connect(&sender, &SenderObject::signal7, &context, [&received](int i, const QString &) {
+            received << i;
+        }, Qt::BatchedConnection);
+        for (int i = 0; i < 100; ++i) {
+            emit sender.signal7(i, QString());
+            expected << i;
+        }
+        QVERIFY(received.isEmpty());
+        QCoreApplication::processEvents();
+        QCOMPARE(received, expected);
+
+        // from another thread
+        received.clear();
+        expected.clear();
+        BatchedEmitThread thread(&sender, 10000);
+        thread.start();
+        QVERIFY(thread.wait());
+        for (int i = 0; i < 10000; ++i)
+            expected << i;
+        QTRY_COMPARE(received.size(), expected.size());
+        QCOMPARE(received, expected);
+
+        // pending calls are discarded on disconnect
+        received.clear();
+        emit sender.signal7(1, QString());
+        QVERIFY(sender.disconnect(&context));
+        QCoreApplication::processEvents();
+        QVERIFY(received.isEmpty());
+    }
+
+    {
+        // and when the receiver is destroyed
+        ReceiverObject *receiver = new ReceiverObject;
+        connect(&sender, &SenderObject::signal1, receiver, &ReceiverObject::slot1, Qt::BatchedConnection);
+        sender.emitSignal1();
+        delete receiver;
+        QCoreApplication::processEvents();
+    }
+
+    {
+        ReceiverObject receiver;
+        receiver.reset();
+        connect(&sender, &SenderObject::signal1, &receiver, &ReceiverObject::slot1, Qt::BatchedConnection);
+        QVERIFY(QObject::connect(&sender, SIGNAL(signal2()), &receiver, SLOT(slot2()), Qt::BatchedConnection));
+        sender.emitSignal1();
+        sender.emitSignal2();
+        sender.emitSignal1();
+        QCOMPARE(receiver.count_slot1, 0);
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.count_slot1, 2);
+        QCOMPARE(receiver.count_slot2, 1);
+        QVERIFY(receiver.called(1));
+        QVERIFY(receiver.called(2));
+
+        // invoking a method does not batch anything
+        receiver.reset();
+        QVERIFY(QMetaObject::invokeMethod(&receiver, "slot1", Qt::BatchedConnection));
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.count_slot1, 1);
+    }
+}
+
+void tst_QObject::coalescedConnection()
+{
+    SenderObject sender;
+    QObject context;
+    QVector<int> received;
+    QVector<int> receivedByOther;
+    connect(&sender, &SenderObject::signal7, &context, [&received](int i, const QString &) {
+        received << i;
+    }, Qt::CoalescedConnection);
+    connect(&sender, &SenderObject::signal7, &context, [&receivedByOther](int i, const QString &) {
+        receivedByOther << i;
+    }, Qt::CoalescedConnection);
+
+    // only the most recent pending call is delivered, for each connection
+    for (int i = 0; i < 100; ++i)
+        emit sender.signal7(i, QString());
+    QVERIFY(received.isEmpty());
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QVector<int>() << 99);
+    QCOMPARE(receivedByOther, QVector<int>() << 99);
+
+    emit sender.signal7(100, QString());
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QVector<int>() << 99 << 100);
+
+    // from another thread, the last call is always delivered
+    received.clear();
+    BatchedEmitThread thread(&sender, 10000);
+    thread.start();
+    QVERIFY(thread.wait());
+    QTRY_VERIFY(!received.isEmpty() && received.last() == 9999);
+    QVERIFY(std::is_sorted(received.constBegin(), received.constEnd()));
+}
+
 class EventSpy : public QObject
 {
     Q_OBJECT
@@ -3189,6 +3381,35 @@ void tst_QObject::childEvents()
     }
 }
 
+class CountedEvent : public QEvent
+{
+public:
+    CountedEvent(int *alive) : QEvent(QEvent::User), alive(alive) { ++*alive; }
+    ~CountedEvent() { --*alive; }
+    int *alive;
+};
+
+void tst_QObject::deleteChildrenWithPostedEvents()
+{
+    int alive = 0;
+    QObject other;
+    QCoreApplication::postEvent(&other, new CountedEvent(&alive));
+    {
+        QObject parent;
+        for (int i = 0; i < 100; ++i) {
+            QObject *child = new QObject(&parent);
+            QCoreApplication::postEvent(child, new CountedEvent(&alive));
+            if (i % 2)
+                child->deleteLater();
+        }
+        QCOMPARE(alive, 101);
+    }
+    // the events of the children are gone, not those of other objects
+    QCOMPARE(alive, 1);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(alive, 0);
+}
+
 void tst_QObject::installEventFilter()
 {
     QEvent event(QEvent::User);
@@ -32,6 +32,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTimer>
+#include <QtCore/QTemporaryFile>
 #include <QtCore/QSocketNotifier>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
@@ -44,6 +45,7 @@
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
+#include <private/qeventdispatcher_unix_p.h>
 #include <sys/select.h>
 #endif
 #include <limits>
@@ -61,6 +63,7 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void epollDispatcher();
 #endif
     void asyncMultipleDatagram();
 
@@ -323,6 +326,57 @@ void tst_QSocketNotifier::posixSockets()
     }
     qt_safe_close(posixSocket);
 }
+
+void tst_QSocketNotifier::epollDispatcher()
+{
+#if !QT_CONFIG(epoll)
+    QSKIP("This test requires epoll(7)");
+#else
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    QEventDispatcherUNIX dispatcher;
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds, O_NONBLOCK), 0);
+
+    // drive the notifiers through our own dispatcher, not the application's
+    QSocketNotifier rn(fds[0], QSocketNotifier::Read);
+    rn.setEnabled(false);
+    QSignalSpy readSpy(&rn, &QSocketNotifier::activated);
+    QVERIFY(readSpy.isValid());
+    dispatcher.registerSocketNotifier(&rn);
+
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(readSpy.count(), 0);
+
+    QCOMPARE(qt_safe_write(fds[1], "x", 1), qint64(1));
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(readSpy.count(), 1);
+
+    // level-triggered, like poll(2)
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(readSpy.count(), 2);
+
+    dispatcher.unregisterSocketNotifier(&rn);
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(readSpy.count(), 2);
+
+    // regular files cannot be added to an epoll set and are polled instead
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QSocketNotifier fn(file.handle(), QSocketNotifier::Read);
+    fn.setEnabled(false);
+    QSignalSpy fileSpy(&fn, &QSocketNotifier::activated);
+    QVERIFY(fileSpy.isValid());
+    dispatcher.registerSocketNotifier(&fn);
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(fileSpy.count(), 1);
+    dispatcher.unregisterSocketNotifier(&fn);
+
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+#endif
+}
 #endif
 
 void tst_QSocketNotifier::async_readDatagramSlot()
@@ -67,6 +67,7 @@ private slots:
     void timerFiresOnlyOncePerProcessEvents();
     void timerIdPersistsAfterThreadExit();
     void cancelLongTimer();
+    void manyTimersFireInOrder();
     void singleShotStaticFunctionZeroTimeout();
     void recurseOnTimeoutAndStopTimer();
     void singleShotToFunctors();
@@ -690,6 +691,36 @@ void tst_QTimer::cancelLongTimer()
     QVERIFY(!timer.isActive());
 }
 
+void tst_QTimer::manyTimersFireInOrder()
+{
+    // timers started in sequence with the same interval must fire in the
+    // order they were started, also after some of them have been stopped
+    const int count = 500;
+    QVector<int> fired;
+    QVector<QTimer *> timers;
+    for (int i = 0; i < count; ++i) {
+        QTimer *timer = new QTimer(this);
+        timer->setSingleShot(true);
+        timer->setTimerType(Qt::PreciseTimer);
+        connect(timer, &QTimer::timeout, [&fired, i]() { fired << i; });
+        timers << timer;
+    }
+
+    QVector<int> expected;
+    for (int i = 0; i < count; ++i) {
+        timers.at(i)->start(50);
+        if (i % 3 != 0)
+            expected << i;
+    }
+    for (int i = 0; i < count; i += 3)
+        timers.at(i)->stop();
+
+    QTRY_COMPARE(fired.size(), expected.size());
+    QCOMPARE(fired, expected);
+
+    qDeleteAll(timers);
+}
+
 void tst_QTimer::singleShotStaticFunctionZeroTimeout()
 {
     TimerHelper helper;
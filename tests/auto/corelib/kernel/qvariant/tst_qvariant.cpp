@@ -244,6 +244,7 @@ private slots:
     void numericalConvert();
     void moreCustomTypes();
     void movabilityTest();
+    void inlineStorage();
     void variantInVariant();
     void userConversion();
     void modelIndexConversion();
@@ -3860,6 +3861,39 @@ void tst_QVariant::movabilityTest()
     QVERIFY(!MyNotMovable::count);
 }
 
+struct ThreePointers
+{
+    void *a, *b, *c;
+    bool operator==(const ThreePointers &other) const
+    { return a == other.a && b == other.b && c == other.c; }
+};
+Q_DECLARE_TYPEINFO(ThreePointers, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(ThreePointers);
+
+struct FourPointers
+{
+    void *a, *b, *c, *d;
+};
+Q_DECLARE_TYPEINFO(FourPointers, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(FourPointers);
+
+void tst_QVariant::inlineStorage()
+{
+    // Movable types of up to three pointers are stored without allocating
+    int i, j, k;
+    const ThreePointers small = { &i, &j, &k };
+    QVariant variant = QVariant::fromValue(small);
+    QVERIFY(!variant.data_ptr().is_shared);
+    QVERIFY(variant.value<ThreePointers>() == small);
+
+    QVariant copy = variant;
+    QVERIFY(!copy.data_ptr().is_shared);
+    QVERIFY(copy.value<ThreePointers>() == small);
+
+    const FourPointers big = { &i, &j, &k, &i };
+    QVERIFY(QVariant::fromValue(big).data_ptr().is_shared);
+}
+
 void tst_QVariant::variantInVariant()
 {
     QVariant var1 = 5;
@@ -3909,6 +3943,8 @@ struct BigConvertible {
     double d;
     double dummy;
     double dummy2;
+    double dummy3;
+    double dummy4;
     operator int() const { return (int)d; }
     operator double() const { return d; }
     operator QString() const { return QString::number(d); }
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qconcurrentqueue
+QT = core testlib
+SOURCES = tst_qconcurrentqueue.cpp
@@ -0,0 +1,341 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qconcurrentqueue.h>
+#include <qthread.h>
+
+class tst_QConcurrentQueue : public QObject
+{
+    Q_OBJECT
+private slots:
+    void capacity();
+    void nonBlocking_data() { queueTypes(); }
+    void nonBlocking();
+    void wrapAround_data() { queueTypes(); }
+    void wrapAround();
+    void moveOnlyAndDestruction_data() { queueTypes(); }
+    void moveOnlyAndDestruction();
+    void timeout_data() { queueTypes(); }
+    void timeout();
+    void blockingWakeUp_data() { queueTypes(); }
+    void blockingWakeUp();
+    void spscThroughput();
+    void mpmcThroughput();
+
+private:
+    void queueTypes();
+};
+
+enum QueueType { Spsc, Mpmc };
+Q_DECLARE_METATYPE(QueueType)
+
+void tst_QConcurrentQueue::queueTypes()
+{
+    QTest::addColumn<QueueType>("type");
+    QTest::newRow("spsc") << Spsc;
+    QTest::newRow("mpmc") << Mpmc;
+}
+
+// runs test<Queue>() for the queue type of the current data row
+#define DISPATCH(test, T) \
+    do { \
+        QFETCH(QueueType, type); \
+        if (type == Spsc) \
+            test<QSpscQueue<T> >(); \
+        else \
+            test<QMpmcQueue<T> >(); \
+    } while (false)
+
+void tst_QConcurrentQueue::capacity()
+{
+    QCOMPARE(QSpscQueue<int>(0).capacity(), 2);
+    QCOMPARE(QSpscQueue<int>(5).capacity(), 8);
+    QCOMPARE(QMpmcQueue<int>(1).capacity(), 2);
+    QCOMPARE(QMpmcQueue<int>(64).capacity(), 64);
+    QCOMPARE(QMpmcQueue<int>(65).capacity(), 128);
+}
+
+template <typename Queue>
+static void testNonBlocking()
+{
+    Queue queue(4);
+    QVERIFY(queue.isEmpty());
+    int value = -1;
+    QVERIFY(!queue.tryPop(&value));
+    QCOMPARE(value, -1);
+
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(queue.tryPush(i));
+    QVERIFY(!queue.tryPush(4));
+    QCOMPARE(queue.size(), 4);
+
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(queue.tryPop(&value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!queue.tryPop(&value));
+    QVERIFY(queue.isEmpty());
+}
+
+void tst_QConcurrentQueue::nonBlocking()
+{
+    DISPATCH(testNonBlocking, int);
+}
+
+template <typename Queue>
+static void testWrapAround()
+{
+    Queue queue(8);
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 1 + round % 8; ++i)
+            QVERIFY(queue.tryPush(next++));
+        int value;
+        while (queue.tryPop(&value))
+            QCOMPARE(value, expected++);
+    }
+    QCOMPARE(expected, next);
+}
+
+void tst_QConcurrentQueue::wrapAround()
+{
+    DISPATCH(testWrapAround, int);
+}
+
+struct Tracked
+{
+    static int alive;
+    Tracked() : value(0) { ++alive; }
+    explicit Tracked(int v) : value(v) { ++alive; }
+    Tracked(Tracked &&other) : value(other.value) { other.value = -1; ++alive; }
+    Tracked &operator=(Tracked &&other) { value = other.value; other.value = -1; return *this; }
+    ~Tracked() { --alive; }
+    int value;
+private:
+    Q_DISABLE_COPY(Tracked)
+};
+
+int Tracked::alive = 0;
+
+template <typename Queue>
+static void testMoveOnlyAndDestruction()
+{
+    {
+        Queue queue(4);
+        QVERIFY(queue.tryPush(Tracked(1)));
+        queue.push(Tracked(2));
+        QVERIFY(queue.tryPush(Tracked(3), 10));
+        QCOMPARE(Tracked::alive, 3);
+
+        Tracked t;
+        QVERIFY(queue.tryPop(&t));
+        QCOMPARE(t.value, 1);
+        QCOMPARE(queue.pop().value, 2);
+        QCOMPARE(Tracked::alive, 2);
+    }
+    // the queue destroys the values it still holds
+    QCOMPARE(Tracked::alive, 0);
+}
+
+void tst_QConcurrentQueue::moveOnlyAndDestruction()
+{
+    DISPATCH(testMoveOnlyAndDestruction, Tracked);
+}
+
+template <typename Queue>
+static void testTimeout()
+{
+    Queue queue(2);
+    int value;
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(!queue.tryPop(&value, 50));
+    QVERIFY(timer.elapsed() >= 45);
+
+    QVERIFY(queue.tryPush(1, 0));
+    QVERIFY(queue.tryPush(2, 0));
+    timer.start();
+    QVERIFY(!queue.tryPush(3, 50));
+    QVERIFY(timer.elapsed() >= 45);
+
+    QVERIFY(queue.tryPop(&value, 0));
+    QCOMPARE(value, 1);
+}
+
+void tst_QConcurrentQueue::timeout()
+{
+    DISPATCH(testTimeout, int);
+}
+
+template <typename Queue>
+class DelayedPusher : public QThread
+{
+public:
+    explicit DelayedPusher(Queue *q) : queue(q) {}
+    void run() override
+    {
+        msleep(50);
+        queue->push(42);
+    }
+    Queue *queue;
+};
+
+template <typename Queue>
+static void testBlockingWakeUp()
+{
+    Queue queue(2);
+    DelayedPusher<Queue> pusher(&queue);
+    pusher.start();
+    QCOMPARE(queue.pop(), 42);
+    QVERIFY(pusher.wait());
+
+    // a full queue blocks the producer until the consumer makes room
+    queue.push(1);
+    queue.push(2);
+    DelayedPusher<Queue> blocked(&queue);
+    blocked.start();
+    QThread::msleep(100);
+    QCOMPARE(queue.size(), 2);
+    int value;
+    QVERIFY(queue.tryPop(&value, 5000));
+    QCOMPARE(value, 1);
+    QVERIFY(blocked.wait(5000));
+    QCOMPARE(queue.pop(), 2);
+    QCOMPARE(queue.pop(), 42);
+}
+
+void tst_QConcurrentQueue::blockingWakeUp()
+{
+    DISPATCH(testBlockingWakeUp, int);
+}
+
+template <typename Queue>
+class Producer : public QThread
+{
+public:
+    Producer(Queue *q, int f, int c) : queue(q), first(f), count(c) {}
+    void run() override
+    {
+        for (int i = 0; i < count; ++i) {
+            if (i % 2)
+                queue->push(first + i);
+            else
+                while (!queue->tryPush(first + i))
+                    yieldCurrentThread();
+        }
+    }
+    Queue *queue;
+    int first;
+    int count;
+};
+
+template <typename Queue>
+class Consumer : public QThread
+{
+public:
+    Consumer(Queue *q, int c) : queue(q), count(c) {}
+    void run() override
+    {
+        values.reserve(count);
+        for (int i = 0; i < count; ++i)
+            values.append(queue->pop());
+    }
+    Queue *queue;
+    int count;
+    QVector<int> values;
+};
+
+void tst_QConcurrentQueue::spscThroughput()
+{
+    const int count = 100000;
+    QSpscQueue<int> queue(16);
+    Producer<QSpscQueue<int> > producer(&queue, 0, count);
+    Consumer<QSpscQueue<int> > consumer(&queue, count);
+    consumer.start();
+    producer.start();
+    QVERIFY(producer.wait(60000));
+    QVERIFY(consumer.wait(60000));
+
+    // a single consumer sees the values of a single producer in order
+    QCOMPARE(consumer.values.size(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(consumer.values.at(i), i);
+    QVERIFY(queue.isEmpty());
+}
+
+void tst_QConcurrentQueue::mpmcThroughput()
+{
+    const int producerCount = 4;
+    const int consumerCount = 4;
+    const int perProducer = 25000;
+    const int perConsumer = producerCount * perProducer / consumerCount;
+    QMpmcQueue<int> queue(64);
+
+    QVector<Producer<QMpmcQueue<int> > *> producers;
+    QVector<Consumer<QMpmcQueue<int> > *> consumers;
+    for (int i = 0; i < consumerCount; ++i)
+        consumers.append(new Consumer<QMpmcQueue<int> >(&queue, perConsumer));
+    for (int i = 0; i < producerCount; ++i)
+        producers.append(new Producer<QMpmcQueue<int> >(&queue, i * perProducer, perProducer));
+    for (auto consumer : qAsConst(consumers))
+        consumer->start();
+    for (auto producer : qAsConst(producers))
+        producer->start();
+    for (auto producer : qAsConst(producers))
+        QVERIFY(producer->wait(60000));
+    for (auto consumer : qAsConst(consumers))
+        QVERIFY(consumer->wait(60000));
+
+    // every value arrives exactly once, and the values of each producer
+    // arrive at each consumer in order
+    QVector<int> all;
+    for (auto consumer : qAsConst(consumers)) {
+        QVector<int> last(producerCount, -1);
+        for (int value : qAsConst(consumer->values)) {
+            const int p = value / perProducer;
+            QVERIFY(value > last.at(p));
+            last[p] = value;
+        }
+        all += consumer->values;
+    }
+    std::sort(all.begin(), all.end());
+    QCOMPARE(all.size(), producerCount * perProducer);
+    for (int i = 0; i < all.size(); ++i)
+        QCOMPARE(all.at(i), i);
+    QVERIFY(queue.isEmpty());
+
+    qDeleteAll(producers);
+    qDeleteAll(consumers);
+}
+
+QTEST_MAIN(tst_QConcurrentQueue)
+#include "tst_qconcurrentqueue.moc"
@@ -75,6 +75,15 @@ private slots:
     void nestedExceptions();
 #endif
     void nonGlobalThreadPool();
+    void then();
+    void thenCanceled();
+#ifndef QT_NO_EXCEPTIONS
+    void thenExceptions();
+    void onFailed();
+#endif
+    void whenAll();
+    void whenAny();
+    void reservedResults();
 };
 
 void tst_QFuture::resultStore()
@@ -1486,5 +1495,231 @@ void tst_QFuture::nonGlobalThreadPool()
     }
 }
 
+void tst_QFuture::then()
+{
+    // chain started before the source has finished
+    {
+        QFutureInterface<int> source;
+        source.reportStarted();
+        QFuture<QString> f = source.future()
+                .then([](int value) { return value * 2; })
+                .then([](int value) { return QString::number(value); });
+        QVERIFY(!f.isFinished());
+
+        source.reportResult(21);
+        source.reportFinished();
+        QCOMPARE(f.result(), QString("42"));
+    }
+
+    // attached to a future that has already finished
+    {
+        QFutureInterface<int> source;
+        source.reportStarted();
+        source.reportResult(1);
+        source.reportFinished();
+        QFuture<int> f = source.future().then([](int value) { return value + 1; });
+        QCOMPARE(f.result(), 2);
+    }
+
+    // void futures, several continuations on the same future
+    {
+        QFutureInterface<void> source;
+        source.reportStarted();
+        QAtomicInt count;
+        QFuture<void> f1 = source.future().then([&count]() { count.ref(); });
+        QFuture<void> f2 = source.future().then([&count]() { count.ref(); });
+        source.reportFinished();
+        f1.waitForFinished();
+        f2.waitForFinished();
+        QCOMPARE(count.load(), 2);
+    }
+
+    // custom thread pool
+    {
+        QThreadPool pool;
+        QFutureInterface<int> source;
+        source.reportStarted();
+        QFuture<QThread *> f = source.future().then(&pool, [](int) {
+            return QThread::currentThread();
+        });
+        source.reportResult(0);
+        source.reportFinished();
+        QThread *thread = f.result();
+        QVERIFY(thread != QThread::currentThread());
+        QVERIFY(thread != Q_NULLPTR);
+        QVERIFY(pool.waitForDone(10000));
+    }
+}
+
+void tst_QFuture::thenCanceled()
+{
+    QFutureInterface<int> source;
+    source.reportStarted();
+    bool called = false;
+    QFuture<int> f = source.future().then([&called](int value) { called = true; return value; });
+    source.reportCanceled();
+    source.reportFinished();
+    f.waitForFinished();
+    QVERIFY(f.isCanceled());
+    QVERIFY(!called);
+
+    // canceling the continuation's future before it runs
+    QFutureInterface<int> source2;
+    source2.reportStarted();
+    QFuture<int> f2 = source2.future().then([&called](int value) { called = true; return value; });
+    f2.cancel();
+    source2.reportResult(1);
+    source2.reportFinished();
+    f2.waitForFinished();
+    QVERIFY(f2.isCanceled());
+    QVERIFY(!called);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QFuture::thenExceptions()
+{
+    // thrown by the continuation
+    {
+        QFutureInterface<int> source;
+        source.reportStarted();
+        QFuture<int> f = source.future().then([](int) -> int { throw QException(); });
+        source.reportResult(1);
+        source.reportFinished();
+        bool caught = false;
+        try {
+            f.waitForFinished();
+        } catch (QException &) {
+            caught = true;
+        }
+        QVERIFY(caught);
+    }
+
+    // reported by the source, skips the continuation
+    {
+        QFutureInterface<int> source;
+        source.reportStarted();
+        bool called = false;
+        QFuture<int> f = source.future().then([&called](int value) { called = true; return value; });
+        source.reportException(QException());
+        source.reportFinished();
+        bool caught = false;
+        try {
+            f.waitForFinished();
+        } catch (QException &) {
+            caught = true;
+        }
+        QVERIFY(caught);
+        QVERIFY(!called);
+    }
+}
+
+void tst_QFuture::onFailed()
+{
+    // the handler provides a replacement result
+    {
+        QFutureInterface<int> source;
+        source.reportStarted();
+        QFuture<int> f = source.future()
+                .then([](int value) -> int { if (value) throw QException(); return 1; })
+                .onFailed([](const QException &) { return -1; });
+        source.reportResult(1);
+        source.reportFinished();
+        QCOMPARE(f.result(), -1);
+    }
+
+    // no failure, results are passed through
+    {
+        QFutureInterface<int> source;
+        source.reportStarted();
+        bool called = false;
+        QFuture<int> f = source.future().onFailed([&called](const QException &) { called = true; return -1; });
+        source.reportResult(5);
+        source.reportFinished();
+        QCOMPARE(f.result(), 5);
+        QVERIFY(!called);
+    }
+
+    // void
+    {
+        QFutureInterface<void> source;
+        source.reportStarted();
+        bool called = false;
+        QFuture<void> f = source.future().onFailed([&called](const QException &) { called = true; });
+        source.reportException(QException());
+        source.reportFinished();
+        f.waitForFinished();
+        QVERIFY(called);
+        QVERIFY(!f.isCanceled());
+    }
+}
+#endif
+
+void tst_QFuture::whenAll()
+{
+    QFutureInterface<int> a;
+    QFutureInterface<int> b;
+    a.reportStarted();
+    b.reportStarted();
+    QList<QFuture<int> > futures;
+    futures << a.future() << b.future();
+
+    QFuture<void> all = QtFuture::whenAll(futures);
+    QVERIFY(!all.isFinished());
+    a.reportFinished();
+    QVERIFY(!all.isFinished());
+    b.reportCanceled();
+    b.reportFinished();
+    QVERIFY(all.isFinished());
+    QVERIFY(!all.isCanceled());
+
+    QVERIFY(QtFuture::whenAll(QList<QFuture<int> >()).isFinished());
+}
+
+void tst_QFuture::whenAny()
+{
+    QFutureInterface<int> a;
+    QFutureInterface<int> b;
+    a.reportStarted();
+    b.reportStarted();
+    QList<QFuture<int> > futures;
+    futures << a.future() << b.future();
+
+    QFuture<int> any = QtFuture::whenAny(futures);
+    QVERIFY(!any.isFinished());
+    b.reportFinished();
+    a.reportFinished();
+    QVERIFY(any.isFinished());
+    QCOMPARE(any.result(), 1);
+
+    QVERIFY(QtFuture::whenAny(QList<QFuture<int> >()).isCanceled());
+}
+
+void tst_QFuture::reservedResults()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    iface.reserveResults(3);
+    QFuture<int> f = iface.future();
+
+    QFutureWatcher<int> watcher;
+    QSignalSpy resultSpy(&watcher, &QFutureWatcher<int>::resultsReadyAt);
+    watcher.setFuture(f);
+
+    iface.reportResult(20, 2);
+    QCOMPARE(f.resultCount(), 0);
+    QVERIFY(f.isResultReadyAt(2));
+    QCOMPARE(f.resultAt(2), 20);
+
+    QVector<int> first;
+    first << 0 << 10;
+    iface.reportResults(first, 0);
+    QCOMPARE(f.resultCount(), 3);
+    QCOMPARE(f.resultAt(1), 10);
+
+    iface.reportFinished();
+    QCOMPARE(f.results(), QList<int>() << 0 << 10 << 20);
+    QTRY_COMPARE(resultSpy.count(), 2);
+}
+
 QTEST_MAIN(tst_QFuture)
 #include "tst_qfuture.moc"
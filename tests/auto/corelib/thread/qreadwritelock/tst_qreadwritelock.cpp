@@ -55,6 +55,9 @@
 
 #include <stdio.h>
 
+Q_DECLARE_METATYPE(QReadWriteLock::RecursionMode)
+Q_DECLARE_METATYPE(QReadWriteLock::Preference)
+
 class tst_QReadWriteLock : public QObject
 {
     Q_OBJECT
@@ -87,6 +90,8 @@ private slots:
     void countingTest();
     void limitedReaders();
     void deleteOnUnlock();
+    void preference_data();
+    void preference();
 
 /*
     Performance tests
@@ -890,6 +895,77 @@ void tst_QReadWriteLock::deleteOnUnlock()
     }
 }
 
+void tst_QReadWriteLock::preference_data()
+{
+    QTest::addColumn<QReadWriteLock::RecursionMode>("recursionMode");
+    QTest::addColumn<QReadWriteLock::Preference>("preference");
+
+    QTest::newRow("NonRecursive, PreferWriters") << QReadWriteLock::NonRecursive << QReadWriteLock::PreferWriters;
+    QTest::newRow("NonRecursive, PreferReaders") << QReadWriteLock::NonRecursive << QReadWriteLock::PreferReaders;
+    QTest::newRow("Recursive, PreferWriters") << QReadWriteLock::Recursive << QReadWriteLock::PreferWriters;
+    QTest::newRow("Recursive, PreferReaders") << QReadWriteLock::Recursive << QReadWriteLock::PreferReaders;
+}
+
+class PreferenceWriterThread : public QThread
+{
+public:
+    QReadWriteLock *lock;
+    QSemaphore started;
+    QAtomicInt locked;
+
+    explicit PreferenceWriterThread(QReadWriteLock *lock) : lock(lock) {}
+
+    void run() override
+    {
+        started.release();
+        lock->lockForWrite();
+        locked.store(1);
+        lock->unlock();
+    }
+};
+
+void tst_QReadWriteLock::preference()
+{
+    QFETCH(QReadWriteLock::RecursionMode, recursionMode);
+    QFETCH(QReadWriteLock::Preference, preference);
+
+    QReadWriteLock lock(recursionMode, preference);
+    QCOMPARE(lock.preference(), preference);
+
+    // the preference survives the lock being contended
+    lock.lockForRead();
+    PreferenceWriterThread writer(&lock);
+    writer.start();
+    writer.started.acquire();
+    QTest::qSleep(100); // give the writer time to block
+
+    class ReaderThread : public QThread
+    {
+    public:
+        QReadWriteLock *lock;
+        bool result;
+        explicit ReaderThread(QReadWriteLock *lock) : lock(lock), result(false) {}
+        void run() override
+        {
+            result = lock->tryLockForRead();
+            if (result)
+                lock->unlock();
+        }
+    } reader(&lock);
+    reader.start();
+    QVERIFY(reader.wait());
+    QCOMPARE(reader.result, preference == QReadWriteLock::PreferReaders);
+    QCOMPARE(lock.preference(), preference);
+    QVERIFY(!writer.locked.load());
+
+    lock.unlock();
+    QVERIFY(writer.wait());
+    QVERIFY(writer.locked.load());
+    QCOMPARE(lock.preference(), preference);
+
+    QVERIFY(lock.tryLockForWrite());
+    lock.unlock();
+}
 
 void tst_QReadWriteLock::uncontendedLocks()
 {
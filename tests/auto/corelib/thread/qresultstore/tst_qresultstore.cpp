@@ -53,6 +53,8 @@ private slots:
     void filterMode();
     void addCanceledResult();
     void count();
+    void indexedResults();
+    void indexedResultsConcurrent();
 private:
     int int0;
     int int1;
@@ -477,5 +479,80 @@ void tst_QtConcurrentResultStore::count()
     }
 }
 
+void tst_QtConcurrentResultStore::indexedResults()
+{
+    ResultStoreInt store;
+    store.reserveIndexedResults<int>(4);
+    QVERIFY(store.isIndexed());
+    QCOMPARE(store.count(), 0);
+    QVERIFY(!store.hasNextResult());
+
+    QCOMPARE(store.addIndexedResult(1, int1), 1);
+    QCOMPARE(store.count(), 0);
+    QVERIFY(store.contains(1));
+    QVERIFY(!store.contains(0));
+    QVERIFY(store.hasNextResult());
+
+    QCOMPARE(store.addIndexedResult(0, int0), 0);
+    QCOMPARE(store.count(), 2);
+    QCOMPARE(store.indexedResult<int>(0), int0);
+    QCOMPARE(store.indexedResult<int>(1), int1);
+
+    QCOMPARE(store.addIndexedResults(2, vec0, vec0.count()), 2);
+    QCOMPARE(store.count(), 4);
+    QCOMPARE(store.indexedResult<int>(3), vec0.at(1));
+
+    // no room left
+    QTest::ignoreMessage(QtWarningMsg, "QFutureInterface: result index 4 is out of the reserved range");
+    QCOMPARE(store.addIndexedResult(4, int2), -1);
+    QVERIFY(!store.contains(4));
+
+    // not possible once non-indexed results are stored
+    ResultStoreInt mapStore;
+    mapStore.addResult(0, &int0);
+    mapStore.reserveIndexedResults<int>(4);
+    QVERIFY(!mapStore.isIndexed());
+}
+
+void tst_QtConcurrentResultStore::indexedResultsConcurrent()
+{
+    const int threadCount = 4;
+    const int perThread = 10000;
+
+    class Writer : public QThread
+    {
+    public:
+        Writer(ResultStoreBase *store, int first, int count)
+            : store(store), first(first), count(count) {}
+        void run() override
+        {
+            // interleave the indexes written by the threads
+            for (int i = 0; i < count; ++i) {
+                const int index = first + i * threadCount;
+                store->addIndexedResult(index, index);
+            }
+        }
+        ResultStoreBase *store;
+        int first;
+        int count;
+    };
+
+    ResultStoreInt store;
+    store.reserveIndexedResults<int>(threadCount * perThread);
+    QVector<Writer *> writers;
+    for (int t = 0; t < threadCount; ++t) {
+        writers.append(new Writer(&store, t, perThread));
+        writers.last()->start();
+    }
+    for (Writer *writer : qAsConst(writers)) {
+        QVERIFY(writer->wait(30000));
+        delete writer;
+    }
+
+    QCOMPARE(store.count(), threadCount * perThread);
+    for (int i = 0; i < threadCount * perThread; ++i)
+        QCOMPARE(store.indexedResult<int>(i), i);
+}
+
 QTEST_MAIN(tst_QtConcurrentResultStore)
 #include "tst_qresultstore.moc"
@@ -40,6 +40,9 @@
 #ifdef Q_OS_UNIX
 #include <pthread.h>
 #endif
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
 #if defined(Q_OS_WIN)
 #include <windows.h>
 #if defined(Q_OS_WIN32)
@@ -64,6 +67,7 @@ private slots:
     void isRunning();
     void setPriority();
     void setStackSize();
+    void setCpuAffinity();
     void exit();
     void start();
     void terminate();
@@ -402,6 +406,69 @@ void tst_QThread::setStackSize()
     QCOMPARE(thread.stackSize(), 0u);
 }
 
+#if defined(Q_OS_LINUX) && defined(CPU_SETSIZE)
+static QVector<int> currentThreadCpus()
+{
+    QVector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set))
+                cpus.append(cpu);
+        }
+    }
+    return cpus;
+}
+
+class Affinity_Thread : public QThread
+{
+public:
+    QVector<int> cpusAtStart;
+    QVector<int> cpusAfterChange;
+    QSemaphore changed;
+    QSemaphore running;
+
+    void run()
+    {
+        cpusAtStart = currentThreadCpus();
+        running.release();
+        changed.acquire();
+        cpusAfterChange = currentThreadCpus();
+    }
+};
+#endif
+
+void tst_QThread::setCpuAffinity()
+{
+    Simple_Thread thread;
+    QVERIFY(thread.cpuAffinity().isEmpty());
+    thread.setCpuAffinity(QVector<int>() << 0 << 1);
+    QCOMPARE(thread.cpuAffinity(), QVector<int>() << 0 << 1);
+    thread.setCpuAffinity(QVector<int>());
+    QVERIFY(thread.cpuAffinity().isEmpty());
+
+#if defined(Q_OS_LINUX) && defined(CPU_SETSIZE)
+    const QVector<int> allowed = currentThreadCpus();
+    QVERIFY(!allowed.isEmpty());
+    const QVector<int> first(1, allowed.first());
+    const QVector<int> last(1, allowed.last());
+
+    // applied before run() is called
+    Affinity_Thread affinityThread;
+    affinityThread.setCpuAffinity(first);
+    affinityThread.start();
+    QVERIFY(affinityThread.running.tryAcquire(1, 30000));
+    QCOMPARE(affinityThread.cpusAtStart, first);
+
+    // and changed while running
+    affinityThread.setCpuAffinity(last);
+    affinityThread.changed.release();
+    QVERIFY(affinityThread.wait(30000));
+    QCOMPARE(affinityThread.cpusAfterChange, last);
+#endif
+}
+
 void tst_QThread::exit()
 {
     Exit_Thread thread;
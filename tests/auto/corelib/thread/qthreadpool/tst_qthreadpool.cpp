@@ -32,6 +32,10 @@
 #include <qstring.h>
 #include <qmutex.h>
 
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
+
 typedef void (*FunctionPointer)();
 
 class FunctionPointerTask : public QRunnable
@@ -96,6 +100,8 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing();
+    void threadAffinityPolicy();
 
 private:
     QMutex m_functionTestMutex;
@@ -1335,5 +1341,97 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing()
+{
+    class SplittingTask : public QRunnable
+    {
+    public:
+        SplittingTask(QThreadPool *pool, QAtomicInt *count, int depth)
+            : m_pool(pool), m_count(count), m_depth(depth)
+        {}
+
+        void run()
+        {
+            m_count->ref();
+            if (m_depth > 0) {
+                // started from a pool thread, so these may be queued locally
+                m_pool->start(new SplittingTask(m_pool, m_count, m_depth - 1));
+                m_pool->start(new SplittingTask(m_pool, m_count, m_depth - 1));
+            }
+        }
+
+    private:
+        QThreadPool *m_pool;
+        QAtomicInt *m_count;
+        int m_depth;
+    };
+
+    QThreadPool pool;
+    QVERIFY(!pool.isWorkStealingEnabled());
+    pool.setWorkStealingEnabled(true);
+    QVERIFY(pool.isWorkStealingEnabled());
+    pool.setMaxThreadCount(4);
+
+    const int depth = 12;
+    for (int run = 0; run < 3; ++run) {
+        QAtomicInt count;
+        pool.start(new SplittingTask(&pool, &count, depth));
+        QVERIFY(pool.waitForDone(30000));
+        QCOMPARE(count.load(), (1 << (depth + 1)) - 1);
+        QCOMPARE(pool.activeThreadCount(), 0);
+    }
+}
+
+void tst_QThreadPool::threadAffinityPolicy()
+{
+    QThreadPool pool;
+    QCOMPARE(pool.threadAffinityPolicy(), QThreadPool::NoAffinity);
+    QVERIFY(pool.cpuAffinity().isEmpty());
+    QVERIFY(QThreadPool::numaNodeCount() >= 1);
+    QVERIFY(!QThreadPool::numaNodeCpus(0).isEmpty());
+    QVERIFY(QThreadPool::numaNodeCpus(QThreadPool::numaNodeCount()).isEmpty());
+
+    pool.setNumaNode(0);
+    QCOMPARE(pool.threadAffinityPolicy(), QThreadPool::SharedCpuAffinity);
+    QCOMPARE(pool.cpuAffinity(), QThreadPool::numaNodeCpus(0));
+
+#if defined(Q_OS_LINUX) && defined(CPU_SETSIZE)
+    class CpuCountTask : public QRunnable
+    {
+    public:
+        CpuCountTask(QAtomicInt *pinned) : m_pinned(pinned) {}
+        void run()
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) == 1)
+                m_pinned->ref();
+        }
+    private:
+        QAtomicInt *m_pinned;
+    };
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    QVERIFY(sched_getaffinity(0, sizeof(set), &set) == 0);
+    QVector<int> allowed;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set))
+            allowed.append(cpu);
+    }
+
+    QThreadPool pinnedPool;
+    pinnedPool.setCpuAffinity(allowed);
+    pinnedPool.setThreadAffinityPolicy(QThreadPool::OneCpuPerThread);
+    QCOMPARE(pinnedPool.threadAffinityPolicy(), QThreadPool::OneCpuPerThread);
+    QAtomicInt pinned;
+    const int taskCount = 16;
+    for (int i = 0; i < taskCount; ++i)
+        pinnedPool.start(new CpuCountTask(&pinned));
+    QVERIFY(pinnedPool.waitForDone(30000));
+    QCOMPARE(pinned.load(), taskCount);
+#endif
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -3,6 +3,7 @@ SUBDIRS=\
     qatomicint \
     qatomicinteger \
     qatomicpointer \
+    qconcurrentqueue \
     qresultstore \
     qfuture \
     qfuturesynchronizer \
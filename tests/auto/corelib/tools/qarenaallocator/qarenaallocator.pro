@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qarenaallocator
+QT = core testlib
+SOURCES = $$PWD/tst_qarenaallocator.cpp
@@ -0,0 +1,228 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qarenaallocator.h>
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qmap.h>
+#include <qstring.h>
+#include <qvector.h>
+
+class tst_QArenaAllocator : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void allocate_data();
+    void allocate();
+    void containers();
+    void inPlaceGrowth();
+    void nestedScopes();
+    void release();
+    void outliveScope();
+};
+
+void tst_QArenaAllocator::initTestCase()
+{
+    // create the global data of the locale outside of any arena
+    QVERIFY(!QString::number(1.5).isEmpty());
+}
+
+void tst_QArenaAllocator::allocate_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("alignment");
+
+    QTest::newRow("1/1") << 1 << 1;
+    QTest::newRow("3/4") << 3 << 4;
+    QTest::newRow("17/8") << 17 << 8;
+    QTest::newRow("100/16") << 100 << 16;
+    QTest::newRow("1000/64") << 1000 << 64;
+    QTest::newRow("large") << 100000 << 16;
+}
+
+void tst_QArenaAllocator::allocate()
+{
+    QFETCH(int, size);
+    QFETCH(int, alignment);
+
+    QArenaAllocator arena(4096);
+    QCOMPARE(arena.bytesReserved(), size_t(0));
+    QCOMPARE(arena.blockSize(), 4096);
+
+    char *previous = 0;
+    for (int i = 0; i < 10; ++i) {
+        char *ptr = static_cast<char *>(arena.allocate(size, alignment));
+        QVERIFY(ptr);
+        QCOMPARE(quintptr(ptr) % alignment, quintptr(0));
+        if (previous)
+            QVERIFY(ptr >= previous + size || ptr + size <= previous);
+        memset(ptr, i, size);
+        previous = ptr;
+    }
+    QVERIFY(arena.bytesReserved() >= size_t(10 * size));
+}
+
+void tst_QArenaAllocator::containers()
+{
+    QArenaAllocator arena;
+    {
+        QArenaAllocatorScope scope(&arena);
+        QCOMPARE(QArenaAllocator::current(), &arena);
+
+        QVector<int> vector;
+        QHash<int, QString> hash;
+        QMap<QString, int> map;
+        for (int i = 0; i < 1000; ++i) {
+            vector.append(i);
+            hash.insert(i, QString::number(i));
+            map.insert(QString::number(i), i);
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            QCOMPARE(vector.at(i), i);
+            QCOMPARE(hash.value(i), QString::number(i));
+            QCOMPARE(map.value(QString::number(i)), i);
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            hash.remove(i);
+            map.remove(QString::number(i));
+        }
+        QCOMPARE(hash.size(), 500);
+        QCOMPARE(map.size(), 500);
+        QCOMPARE(map.firstKey(), QString::number(1));
+    }
+    QCOMPARE(QArenaAllocator::current(), static_cast<QArenaAllocator *>(0));
+#if defined(Q_COMPILER_THREAD_LOCAL)
+    QVERIFY(arena.bytesReserved() > 0);
+#endif
+}
+
+void tst_QArenaAllocator::inPlaceGrowth()
+{
+#if !defined(Q_COMPILER_THREAD_LOCAL)
+    QSKIP("This test requires thread_local support");
+#else
+    QArenaAllocator arena;
+    QArenaAllocatorScope scope(&arena);
+
+    QByteArray ba;
+    ba.reserve(100);
+    ba.append("Hello");
+    const char *data = ba.constData();
+    ba.reserve(1000);
+    QCOMPARE(ba.constData(), data);
+    QCOMPARE(ba, QByteArray("Hello"));
+
+    // a later allocation prevents growing in place
+    QByteArray other(200, 'x');
+    ba.reserve(5000);
+    QCOMPARE(ba, QByteArray("Hello"));
+    QCOMPARE(other, QByteArray(200, 'x'));
+#endif
+}
+
+void tst_QArenaAllocator::nestedScopes()
+{
+    QArenaAllocator outer;
+    QArenaAllocator inner;
+    QScopedPointer<QVector<int> > heapVector;
+    {
+        QArenaAllocatorScope outerScope(&outer);
+        {
+            QArenaAllocatorScope innerScope(&inner);
+            QCOMPARE(QArenaAllocator::current(), &inner);
+            {
+                QArenaAllocatorScope nullScope(0);
+                QCOMPARE(QArenaAllocator::current(), static_cast<QArenaAllocator *>(0));
+                heapVector.reset(new QVector<int>(1000, 42));
+            }
+            QCOMPARE(QArenaAllocator::current(), &inner);
+            QVector<int> innerVector(1000, 1);
+            QCOMPARE(innerVector.count(1), 1000);
+        }
+        QCOMPARE(QArenaAllocator::current(), &outer);
+    }
+    QCOMPARE(QArenaAllocator::current(), static_cast<QArenaAllocator *>(0));
+
+    // the vector from the null scope does not depend on any arena
+    inner.release();
+    outer.release();
+    QCOMPARE(heapVector->count(42), 1000);
+    heapVector->append(43);
+    QCOMPARE(heapVector->last(), 43);
+}
+
+void tst_QArenaAllocator::release()
+{
+    QArenaAllocator arena(1024);
+    for (int round = 0; round < 3; ++round) {
+        {
+            QArenaAllocatorScope scope(&arena);
+            QHash<QString, QVector<int> > hash;
+            for (int i = 0; i < 500; ++i)
+                hash[QString::number(i)].append(i);
+            QCOMPARE(hash.value(QString::number(123)), QVector<int>() << 123);
+        }
+        arena.release();
+        QCOMPARE(arena.bytesReserved(), size_t(0));
+    }
+}
+
+void tst_QArenaAllocator::outliveScope()
+{
+    QArenaAllocator arena;
+    QVector<QString> strings;
+    QMap<int, QByteArray> map;
+    {
+        QArenaAllocatorScope scope(&arena);
+        for (int i = 0; i < 100; ++i) {
+            strings.append(QString::number(i));
+            map.insert(i, QByteArray::number(i));
+        }
+    }
+
+    // memory from the arena may be modified and freed outside of the scope
+    for (int i = 0; i < 100; ++i) {
+        strings[i].append(QLatin1String(" and more text than fits"));
+        map[i].append(" and more");
+    }
+    strings.resize(10000);
+    QCOMPARE(strings.at(42), QString::number(42) + QLatin1String(" and more text than fits"));
+    QCOMPARE(map.value(42), QByteArray("42 and more"));
+    for (int i = 0; i < 100; i += 3)
+        map.remove(i);
+    strings.clear();
+    map.clear();
+}
+
+QTEST_APPLESS_MAIN(tst_QArenaAllocator)
+#include "tst_qarenaallocator.moc"
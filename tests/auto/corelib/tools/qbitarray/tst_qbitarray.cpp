@@ -84,6 +84,11 @@ private slots:
     void operator_noteq();
 
     void resize();
+    void largeBitwiseOperators_data();
+    void largeBitwiseOperators();
+    void rvalueBitwiseOperators();
+    void indexOf_data();
+    void indexOf();
 };
 
 void tst_QBitArray::size_data()
@@ -610,5 +615,140 @@ void tst_QBitArray::resize()
 
 }
 
+static QBitArray patternBitArray(int size, uint seed)
+{
+    QBitArray result(size);
+    for (int i = 0; i < size; ++i) {
+        seed = seed * 1103515245 + 12345;
+        result.setBit(i, seed & 0x10000);
+    }
+    return result;
+}
+
+void tst_QBitArray::largeBitwiseOperators_data()
+{
+    QTest::addColumn<int>("size1");
+    QTest::addColumn<int>("size2");
+
+    // sizes around the 8, 64 and 128 bit steps of the implementation
+    const int sizes[] = { 0, 1, 7, 63, 64, 65, 127, 128, 129, 200, 1000, 1031 };
+    for (int size1 : sizes) {
+        for (int size2 : sizes)
+            QTest::addRow("%d-%d", size1, size2) << size1 << size2;
+    }
+}
+
+void tst_QBitArray::largeBitwiseOperators()
+{
+    QFETCH(int, size1);
+    QFETCH(int, size2);
+
+    const QBitArray a = patternBitArray(size1, 1);
+    const QBitArray b = patternBitArray(size2, 2);
+    const int size = qMax(size1, size2);
+
+    QBitArray expectedAnd(size), expectedOr(size), expectedXor(size);
+    for (int i = 0; i < size; ++i) {
+        const bool bitA = i < size1 && a.testBit(i);
+        const bool bitB = i < size2 && b.testBit(i);
+        expectedAnd.setBit(i, bitA && bitB);
+        expectedOr.setBit(i, bitA || bitB);
+        expectedXor.setBit(i, bitA != bitB);
+    }
+
+    QCOMPARE(a & b, expectedAnd);
+    QCOMPARE(b & a, expectedAnd);
+    QCOMPARE(a | b, expectedOr);
+    QCOMPARE(b | a, expectedOr);
+    QCOMPARE(a ^ b, expectedXor);
+    QCOMPARE(b ^ a, expectedXor);
+
+    QBitArray c = a;
+    c &= b;
+    QCOMPARE(c, expectedAnd);
+    c = a;
+    c |= b;
+    QCOMPARE(c, expectedOr);
+    c = a;
+    c ^= b;
+    QCOMPARE(c, expectedXor);
+
+    QCOMPARE((a & b).count(true), expectedAnd.count(true));
+    QCOMPARE((a | b).count(false), expectedOr.count(false));
+}
+
+void tst_QBitArray::rvalueBitwiseOperators()
+{
+    const QBitArray a = QStringToQBitArray(QString("1100110011"));
+    const QBitArray b = QStringToQBitArray(QString("1010101010"));
+    const QBitArray c = QStringToQBitArray(QString("111"));
+
+    QCOMPARE(QBitArray(a) & b, QStringToQBitArray(QString("1000100010")));
+    QCOMPARE(QBitArray(a) | b, QStringToQBitArray(QString("1110111011")));
+    QCOMPARE(QBitArray(a) ^ b, QStringToQBitArray(QString("0110011001")));
+    QCOMPARE(a & b & c, QStringToQBitArray(QString("1000000000")));
+    QCOMPARE(QBitArray(c) | a, QStringToQBitArray(QString("1110110011")));
+
+    // a shared temporary must not modify the array it shares its data with
+    QBitArray shared = a;
+    QCOMPARE(std::move(shared) ^ b, QStringToQBitArray(QString("0110011001")));
+    QCOMPARE(a, QStringToQBitArray(QString("1100110011")));
+}
+
+void tst_QBitArray::indexOf_data()
+{
+    QTest::addColumn<QBitArray>("array");
+    QTest::addColumn<bool>("on");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("null") << QBitArray() << true << 0 << -1;
+    QTest::newRow("null-false") << QBitArray() << false << 0 << -1;
+    QTest::newRow("all-false") << QBitArray(100) << true << 0 << -1;
+    QTest::newRow("all-false-off") << QBitArray(100) << false << 0 << 0;
+    QTest::newRow("all-true-off") << QBitArray(100, true) << false << 0 << -1;
+    QTest::newRow("all-true-off-odd") << QBitArray(13, true) << false << 5 << -1;
+    QTest::newRow("from-end") << QBitArray(100, true) << true << 100 << -1;
+    QTest::newRow("from-negative") << QBitArray(100, true) << true << -1 << 99;
+    QTest::newRow("from-too-negative") << QBitArray(100, true) << true << -200 << 0;
+
+    QBitArray sparse(1000);
+    sparse.setBit(3);
+    sparse.setBit(70);
+    sparse.setBit(999);
+    QTest::newRow("sparse-0") << sparse << true << 0 << 3;
+    QTest::newRow("sparse-3") << sparse << true << 3 << 3;
+    QTest::newRow("sparse-4") << sparse << true << 4 << 70;
+    QTest::newRow("sparse-71") << sparse << true << 71 << 999;
+    QTest::newRow("sparse-off") << sparse << false << 3 << 4;
+
+    QBitArray dense(1000, true);
+    dense.clearBit(8);
+    dense.clearBit(500);
+    QTest::newRow("dense-0") << dense << false << 0 << 8;
+    QTest::newRow("dense-9") << dense << false << 9 << 500;
+    QTest::newRow("dense-501") << dense << false << 501 << -1;
+}
+
+void tst_QBitArray::indexOf()
+{
+    QFETCH(QBitArray, array);
+    QFETCH(bool, on);
+    QFETCH(int, from);
+    QFETCH(int, expected);
+
+    QCOMPARE(array.indexOf(on, from), expected);
+
+    // compare with testBit()
+    int naive = -1;
+    for (int i = from < 0 ? qMax(from + array.size(), 0) : from; i < array.size(); ++i) {
+        if (array.testBit(i) == on) {
+            naive = i;
+            break;
+        }
+    }
+    QCOMPARE(naive, expected);
+}
+
 QTEST_APPLESS_MAIN(tst_QBitArray)
 #include "tst_qbitarray.moc"
@@ -44,6 +44,10 @@ private slots:
     void interface();
     void indexIn();
     void staticByteArrayMatcher();
+    void needleLengths();
+    void multiMatcher_data();
+    void multiMatcher();
+    void multiMatcherDevice();
 };
 
 void tst_QByteArrayMatcher::interface()
@@ -213,5 +217,124 @@ void tst_QByteArrayMatcher::staticByteArrayMatcher()
 #undef LONG_STRING__64
 #undef LONG_STRING__32
 
+static int naiveIndexOf(const QByteArray &haystack, const QByteArray &needle, int from)
+{
+    for (int i = from; i <= haystack.size() - needle.size(); ++i) {
+        if (memcmp(haystack.constData() + i, needle.constData(), needle.size()) == 0)
+            return i;
+    }
+    return -1;
+}
+
+void tst_QByteArrayMatcher::needleLengths()
+{
+    // covers needles shorter and longer than the vectorized search handles,
+    // matches within and at the end of the blocks, and near misses where
+    // only the first and the last byte of the needle match
+    QByteArray haystack;
+    for (int i = 0; i < 200; ++i)
+        haystack += char('a' + i % 7);
+
+    for (int length = 1; length <= 40; ++length) {
+        for (int start = 0; start + length <= haystack.size(); start += 13) {
+            QByteArray needle = haystack.mid(start, length);
+            for (int from = 0; from < 40; from += 9) {
+                const QByteArrayMatcher matcher(needle);
+                QCOMPARE(matcher.indexIn(haystack, from), naiveIndexOf(haystack, needle, from));
+                QCOMPARE(haystack.indexOf(needle, from), naiveIndexOf(haystack, needle, from));
+            }
+            if (length > 2) {
+                needle[length / 2] = 'x';
+                QCOMPARE(QByteArrayMatcher(needle).indexIn(haystack), -1);
+                QCOMPARE(haystack.indexOf(needle), -1);
+            }
+        }
+    }
+}
+
+void tst_QByteArrayMatcher::multiMatcher_data()
+{
+    QTest::addColumn<QList<QByteArray> >("patterns");
+    QTest::addColumn<QByteArray>("haystack");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("indexIn");
+    QTest::addColumn<int>("patternIndex");
+
+    const QList<QByteArray> keywords = { "he", "she", "his", "hers" };
+    QTest::newRow("no-patterns") << QList<QByteArray>() << QByteArray("ushers") << 0 << -1 << -1;
+    QTest::newRow("no-match") << keywords << QByteArray("abcdef") << 0 << -1 << -1;
+    QTest::newRow("empty-haystack") << keywords << QByteArray() << 0 << -1 << -1;
+    // "she" and "he" both end at 3: the longest is reported
+    QTest::newRow("ushers") << keywords << QByteArray("ushers") << 0 << 1 << 1;
+    QTest::newRow("ushers-from-2") << keywords << QByteArray("ushers") << 2 << 2 << 0;
+    QTest::newRow("ushers-from-3") << keywords << QByteArray("ushers") << 3 << -1 << -1;
+    QTest::newRow("ahishers") << keywords << QByteArray("ahishers") << 0 << 1 << 2;
+    QTest::newRow("at-end") << keywords << QByteArray("xxxhers") << 0 << 3 << 0;
+    // the one ending first wins, even if another one starts earlier
+    QTest::newRow("overlap") << (QList<QByteArray>() << "abcd" << "bc") << QByteArray("abcd") << 0 << 1 << 1;
+    QTest::newRow("failure-links") << (QList<QByteArray>() << "aab" << "ab") << QByteArray("aaab") << 0 << 1 << 0;
+    QTest::newRow("duplicates") << (QList<QByteArray>() << "foo" << "bar" << "foo") << QByteArray("xbarfoo") << 0 << 1 << 1;
+    QTest::newRow("duplicates2") << (QList<QByteArray>() << "foo" << "bar" << "foo") << QByteArray("xfoo") << 0 << 1 << 0;
+    QTest::newRow("empty-pattern") << (QList<QByteArray>() << "foo" << "") << QByteArray("xfoo") << 2 << 2 << 1;
+    QTest::newRow("binary") << (QList<QByteArray>() << QByteArray("\0\xff", 2)) << QByteArray("a\xff\0\xff", 4) << 0 << 2 << 0;
+}
+
+void tst_QByteArrayMatcher::multiMatcher()
+{
+    QFETCH(QList<QByteArray>, patterns);
+    QFETCH(QByteArray, haystack);
+    QFETCH(int, from);
+    QFETCH(int, indexIn);
+    QFETCH(int, patternIndex);
+
+    const QMultiByteArrayMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+
+    int index = -1;
+    QCOMPARE(matcher.indexIn(haystack, from, &index), indexIn);
+    QCOMPARE(index, patternIndex);
+    QCOMPARE(matcher.indexIn(haystack.constData(), haystack.size(), from), indexIn);
+
+    QMultiByteArrayMatcher copy;
+    QCOMPARE(copy.indexIn(haystack, from), -1);
+    copy = matcher;
+    QCOMPARE(copy.indexIn(haystack, from), indexIn);
+
+    QMultiByteArrayMatcher other;
+    other.setPatterns(patterns);
+    QCOMPARE(other.indexIn(haystack, from), indexIn);
+}
+
+void tst_QByteArrayMatcher::multiMatcherDevice()
+{
+    QList<QByteArray> keywords;
+    for (int i = 0; i < 1000; ++i)
+        keywords.append("keyword" + QByteArray::number(i) + '!');
+    const QMultiByteArrayMatcher matcher(keywords);
+
+    // matches inside and across the chunks read from the device
+    QByteArray data(300 * 1024, '.');
+    const QVector<int> positions = { 10, 64 * 1024 - 5, 64 * 1024 + 100, 200 * 1024 - 1, 300 * 1024 - 12 };
+    const QVector<int> patterns = { 7, 42, 999, 0, 123 };
+    for (int i = 0; i < positions.size(); ++i)
+        data.replace(positions.at(i), keywords.at(patterns.at(i)).size(), keywords.at(patterns.at(i)));
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    qint64 base = 0;
+    for (int i = 0; i < positions.size(); ++i) {
+        int patternIndex = -1;
+        const qint64 found = matcher.indexIn(&buffer, &patternIndex);
+        QCOMPARE(base + found, qint64(positions.at(i)));
+        QCOMPARE(patternIndex, patterns.at(i));
+        QCOMPARE(buffer.pos(), positions.at(i) + keywords.at(patterns.at(i)).size());
+        QCOMPARE(matcher.indexIn(data, int(base)), int(base + found));
+        base = buffer.pos();
+    }
+    QCOMPARE(matcher.indexIn(&buffer), qint64(-1));
+    QVERIFY(buffer.atEnd());
+}
+
 QTEST_APPLESS_MAIN(tst_QByteArrayMatcher)
 #include "tst_qbytearraymatcher.moc"
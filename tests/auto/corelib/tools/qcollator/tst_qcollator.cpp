@@ -45,6 +45,10 @@ private Q_SLOTS:
     void compare();
 
     void state();
+
+    void sort_data();
+    void sort();
+    void sortAsciiNumbers();
 };
 
 #ifdef Q_COMPILER_RVALUE_REFS
@@ -228,6 +232,56 @@ void tst_QCollator::state()
 
 }
 
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("empty") << 0 << 1;
+    QTest::newRow("single") << 1 << 1;
+    QTest::newRow("small") << 100 << 1;
+    QTest::newRow("large") << 20000 << 1;
+    QTest::newRow("large-parallel") << 20000 << 4;
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(int, count);
+    QFETCH(int, threads);
+
+    QStringList list;
+    for (int i = 0; i < count; ++i)
+        list << QString::number(i * 7919 % 10007, 36) + QLatin1Char(i % 2 ? 'a' : 'B');
+
+    QCollator collator;
+    QStringList expected = list;
+    std::stable_sort(expected.begin(), expected.end(), collator);
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int oldMaxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+    collator.sort(list);
+    pool->setMaxThreadCount(oldMaxThreadCount);
+
+    QCOMPARE(list, expected);
+}
+
+void tst_QCollator::sortAsciiNumbers()
+{
+    QCollator collator;
+    collator.setNumericMode(true);
+
+    QStringList list;
+    list << "100" << "9" << "1000" << "0" << "10" << "99" << "9";
+    collator.sort(list);
+    QCOMPARE(list, QStringList() << "0" << "9" << "9" << "10" << "99" << "100" << "1000");
+
+    QVERIFY(collator.compare(QString("9"), QString("10")) < 0);
+    QVERIFY(collator.compare(QString("123"), QString("124")) < 0);
+    QCOMPARE(collator.compare(QString("42"), QString("42")), 0);
+    QVERIFY(collator.compare(QString("1000"), QString("999")) > 0);
+}
+
 QTEST_APPLESS_MAIN(tst_QCollator)
 
 #include "tst_qcollator.moc"
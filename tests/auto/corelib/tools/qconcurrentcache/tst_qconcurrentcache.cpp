@@ -0,0 +1,316 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qconcurrentcache.h>
+#include <qthread.h>
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void basics();
+    void shards();
+    void replace();
+    void take();
+    void eviction();
+    void setMaxCost();
+    void statistics();
+    void objectLifetime();
+    void threads();
+};
+
+struct Counted
+{
+    static QAtomicInt count;
+    explicit Counted(int v = 0) : value(v) { count.ref(); }
+    ~Counted() { count.deref(); }
+    int value;
+};
+
+QAtomicInt Counted::count;
+
+void tst_QConcurrentCache::basics()
+{
+    QConcurrentCache<int, Counted> cache(100, 1);
+    QCOMPARE(cache.maxCost(), 100);
+    QCOMPARE(cache.shardCount(), 1);
+    QVERIFY(cache.isEmpty());
+    QVERIFY(cache.object(1).isNull());
+
+    QVERIFY(cache.insert(1, new Counted(10)));
+    QVERIFY(cache.insert(2, new Counted(20), 10));
+    QCOMPARE(cache.size(), 2);
+    QCOMPARE(cache.totalCost(), 11);
+    QVERIFY(cache.contains(1));
+    QVERIFY(!cache.contains(3));
+    QCOMPARE(cache.object(1)->value, 10);
+    QCOMPARE(cache[2]->value, 20);
+
+    QList<int> keys = cache.keys();
+    std::sort(keys.begin(), keys.end());
+    QCOMPARE(keys, QList<int>() << 1 << 2);
+
+    QVERIFY(cache.remove(1));
+    QVERIFY(!cache.remove(1));
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.totalCost(), 10);
+    QCOMPARE(Counted::count.load(), 1);
+
+    cache.clear();
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.totalCost(), 0);
+    QCOMPARE(Counted::count.load(), 0);
+
+    // too expensive
+    QVERIFY(!cache.insert(3, new Counted, 101));
+    QVERIFY(!cache.contains(3));
+    QCOMPARE(Counted::count.load(), 0);
+}
+
+void tst_QConcurrentCache::shards()
+{
+    QCOMPARE((QConcurrentCache<int, int>(100, 0).shardCount()), 1);
+    QCOMPARE((QConcurrentCache<int, int>(100, 5).shardCount()), 8);
+    QCOMPARE((QConcurrentCache<int, int>(100, 16).shardCount()), 16);
+    QCOMPARE((QConcurrentCache<int, int>(100, 100000).shardCount()), 1024);
+
+    // the shards share maxCost() between them
+    QConcurrentCache<int, Counted> cache(100, 4);
+    QVERIFY(cache.insert(1, new Counted, 25));
+    QVERIFY(!cache.insert(2, new Counted, 26));
+
+    for (int i = 0; i < 1000; ++i)
+        cache.insert(i, new Counted);
+    QVERIFY(cache.totalCost() <= 100);
+    QCOMPARE(cache.size(), cache.totalCost());
+    QCOMPARE(Counted::count.load(), cache.size());
+}
+
+void tst_QConcurrentCache::replace()
+{
+    QConcurrentCache<QString, Counted> cache(10, 1);
+    QVERIFY(cache.insert("a", new Counted(1), 5));
+    QVERIFY(cache.insert("a", new Counted(2), 3));
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.totalCost(), 3);
+    QCOMPARE(cache.object("a")->value, 2);
+    QCOMPARE(Counted::count.load(), 1);
+
+    // a failed insertion still removes the old object
+    QVERIFY(!cache.insert("a", new Counted(3), 11));
+    QVERIFY(!cache.contains("a"));
+    QCOMPARE(Counted::count.load(), 0);
+}
+
+void tst_QConcurrentCache::take()
+{
+    QConcurrentCache<int, Counted> cache(10, 1);
+    cache.insert(1, new Counted(42), 4);
+    QSharedPointer<Counted> taken = cache.take(1);
+    QVERIFY(taken);
+    QCOMPARE(taken->value, 42);
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.totalCost(), 0);
+    QVERIFY(cache.take(1).isNull());
+    QCOMPARE(Counted::count.load(), 1);
+    taken.reset();
+    QCOMPARE(Counted::count.load(), 0);
+}
+
+void tst_QConcurrentCache::eviction()
+{
+    QConcurrentCache<int, Counted> cache(4, 1);
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(cache.insert(i, new Counted(i)));
+
+    // without lookups, the oldest objects go first
+    cache.insert(4, new Counted(4));
+    QVERIFY(!cache.contains(0));
+    QCOMPARE(cache.size(), 4);
+
+    // objects that were looked up get a second chance
+    QVERIFY(cache.object(1));
+    QVERIFY(cache.object(2));
+    cache.insert(5, new Counted(5));
+    QVERIFY(cache.contains(1));
+    QVERIFY(cache.contains(2));
+    QVERIFY(!cache.contains(3));
+    QVERIFY(cache.contains(4));
+    QVERIFY(cache.contains(5));
+
+    // ...but only one
+    cache.insert(6, new Counted(6));
+    cache.insert(7, new Counted(7));
+    cache.insert(8, new Counted(8));
+    QVERIFY(!cache.contains(1));
+    QVERIFY(!cache.contains(2));
+    QCOMPARE(cache.size(), 4);
+    QCOMPARE(Counted::count.load(), 4);
+
+    // all referenced: the hand clears the flags and evicts anyway
+    for (int key : cache.keys())
+        QVERIFY(cache.object(key));
+    QVERIFY(cache.insert(9, new Counted(9), 2));
+    QCOMPARE(cache.totalCost(), 4);
+    QCOMPARE(cache.size(), 3);
+}
+
+void tst_QConcurrentCache::setMaxCost()
+{
+    QConcurrentCache<int, Counted> cache(10, 2);
+    for (int i = 0; i < 100; ++i)
+        cache.insert(i, new Counted);
+    QCOMPARE(cache.totalCost(), 10);
+
+    cache.setMaxCost(3);
+    QCOMPARE(cache.maxCost(), 3);
+    QCOMPARE(cache.totalCost(), 3);
+    QCOMPARE(Counted::count.load(), 3);
+
+    // the limits of the shards add up to maxCost()
+    cache.setMaxCost(101);
+    for (int i = 0; i < 1000; ++i)
+        cache.insert(i, new Counted);
+    QCOMPARE(cache.totalCost(), 101);
+
+    cache.setMaxCost(0);
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(Counted::count.load(), 0);
+}
+
+void tst_QConcurrentCache::statistics()
+{
+    QConcurrentCache<int, Counted> cache(2, 1);
+    cache.insert(1, new Counted);
+    cache.insert(2, new Counted);
+    cache.insert(3, new Counted);
+    cache.object(1);
+    cache.object(2);
+    cache.object(3);
+    cache.object(3);
+
+    QConcurrentCache<int, Counted>::Statistics stats = cache.statistics();
+    QCOMPARE(stats.hits, qint64(3));
+    QCOMPARE(stats.misses, qint64(1));
+    QCOMPARE(stats.insertions, qint64(3));
+    QCOMPARE(stats.evictions, qint64(1));
+
+    cache.resetStatistics();
+    stats = cache.statistics();
+    QCOMPARE(stats.hits, qint64(0));
+    QCOMPARE(stats.misses, qint64(0));
+    QCOMPARE(stats.insertions, qint64(0));
+    QCOMPARE(stats.evictions, qint64(0));
+}
+
+void tst_QConcurrentCache::objectLifetime()
+{
+    QConcurrentCache<int, Counted> cache(1, 1);
+    cache.insert(1, new Counted(1));
+    QSharedPointer<Counted> held = cache.object(1);
+
+    // evicting an object that is still in use does not delete it
+    cache.insert(2, new Counted(2));
+    QVERIFY(!cache.contains(1));
+    QCOMPARE(held->value, 1);
+    QCOMPARE(Counted::count.load(), 2);
+    held.reset();
+    QCOMPARE(Counted::count.load(), 1);
+
+    {
+        QConcurrentCache<int, Counted> other;
+        other.insert(1, QSharedPointer<Counted>::create(5));
+        held = other.object(1);
+    }
+    QCOMPARE(held->value, 5);
+    held.reset();
+    QCOMPARE(Counted::count.load(), 1);
+}
+
+class CacheUser : public QThread
+{
+public:
+    CacheUser(QConcurrentCache<int, Counted> *c, int s) : cache(c), seed(s) {}
+    void run() override
+    {
+        uint state = uint(seed);
+        for (int i = 0; i < 20000; ++i) {
+            state = state * 1103515245 + 12345;
+            const int key = int((state >> 8) % 500);
+            switch ((state >> 4) % 8) {
+            case 0:
+                cache->insert(key, new Counted(key), 1 + key % 3);
+                break;
+            case 1:
+                cache->remove(key);
+                break;
+            case 2:
+                cache->take(key);
+                break;
+            default:
+                if (QSharedPointer<Counted> p = cache->object(key))
+                    correct = correct && p->value == key;
+                break;
+            }
+        }
+    }
+
+    QConcurrentCache<int, Counted> *cache;
+    int seed;
+    bool correct = true;
+};
+
+void tst_QConcurrentCache::threads()
+{
+    QConcurrentCache<int, Counted> cache(200, 4);
+    QVector<CacheUser *> users;
+    for (int i = 0; i < 8; ++i)
+        users.append(new CacheUser(&cache, i));
+    for (CacheUser *user : qAsConst(users))
+        user->start();
+    for (CacheUser *user : qAsConst(users)) {
+        QVERIFY(user->wait(60000));
+        QVERIFY(user->correct);
+    }
+    qDeleteAll(users);
+
+    QVERIFY(cache.totalCost() <= 200);
+    QCOMPARE(Counted::count.load(), cache.size());
+    const QConcurrentCache<int, Counted>::Statistics stats = cache.statistics();
+    QVERIFY(stats.hits > 0);
+    QVERIFY(stats.insertions > 0);
+
+    cache.clear();
+    QCOMPARE(Counted::count.load(), 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentCache)
+#include "tst_qconcurrentcache.moc"
@@ -43,6 +43,10 @@ private slots:
     void sha1();
     void sha3_data();
     void sha3();
+    void blake2_data();
+    void blake2();
+    void largeData_data();
+    void largeData();
     void files_data();
     void files();
 };
@@ -262,6 +266,153 @@ void tst_QCryptographicHash::sha3()
     QCOMPARE(result, expectedResult);
 }
 
+void tst_QCryptographicHash::blake2_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+#define ROW(Tag, Algorithm, Input, Result) \
+    QTest::newRow(Tag) << Algorithm << QByteArrayLiteral(Input) << QByteArray::fromHex(Result)
+
+    ROW("blake2b_160_empty",
+        QCryptographicHash::Blake2b_160,
+        "",
+        "3345524abf6bbe1809449224b5972c41790b6cf2");
+
+    ROW("blake2b_256_empty",
+        QCryptographicHash::Blake2b_256,
+        "",
+        "0e5751c026e543b2e8ab2eb06099daa1d1e5df47778f7787faab45cdf12fe3a8");
+
+    ROW("blake2b_384_empty",
+        QCryptographicHash::Blake2b_384,
+        "",
+        "b32811423377f52d7862286ee1a72ee540524380fda1724a6f25d7978c6fd3244a6caf0498812673c5e05ef583825100");
+
+    ROW("blake2b_512_empty",
+        QCryptographicHash::Blake2b_512,
+        "",
+        "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419d25e1031afee585313896444934eb04b903a685b1448b755d56f701afe9be2ce");
+
+    ROW("blake2s_128_empty",
+        QCryptographicHash::Blake2s_128,
+        "",
+        "64550d6ffe2c0a01a14aba1eade0200c");
+
+    ROW("blake2s_160_empty",
+        QCryptographicHash::Blake2s_160,
+        "",
+        "354c9c33f735962418bdacb9479873429c34916f");
+
+    ROW("blake2s_224_empty",
+        QCryptographicHash::Blake2s_224,
+        "",
+        "1fa1291e65248b37b3433475b2a0dd63d54a11ecc4e3e034e7bc1ef4");
+
+    ROW("blake2s_256_empty",
+        QCryptographicHash::Blake2s_256,
+        "",
+        "69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9");
+
+    ROW("blake2b_160_pangram",
+        QCryptographicHash::Blake2b_160,
+        "The quick brown fox jumps over the lazy dog",
+        "3c523ed102ab45a37d54f5610d5a983162fde84f");
+
+    ROW("blake2b_256_pangram",
+        QCryptographicHash::Blake2b_256,
+        "The quick brown fox jumps over the lazy dog",
+        "01718cec35cd3d796dd00020e0bfecb473ad23457d063b75eff29c0ffa2e58a9");
+
+    ROW("blake2b_384_pangram",
+        QCryptographicHash::Blake2b_384,
+        "The quick brown fox jumps over the lazy dog",
+        "b7c81b228b6bd912930e8f0b5387989691c1cee1e65aade4da3b86a3c9f678fc8018f6ed9e2906720c8d2a3aeda9c03d");
+
+    ROW("blake2b_512_pangram",
+        QCryptographicHash::Blake2b_512,
+        "The quick brown fox jumps over the lazy dog",
+        "a8add4bdddfd93e4877d2746e62817b116364a1fa7bc148d95090bc7333b3673f82401cf7aa2e4cb1ecd90296e3f14cb5413f8ed77be73045b13914cdcd6a918");
+
+    ROW("blake2s_128_pangram",
+        QCryptographicHash::Blake2s_128,
+        "The quick brown fox jumps over the lazy dog",
+        "96fd07258925748a0d2fb1c8a1167a73");
+
+    ROW("blake2s_160_pangram",
+        QCryptographicHash::Blake2s_160,
+        "The quick brown fox jumps over the lazy dog",
+        "5a604fec9713c369e84b0ed68daed7d7504ef240");
+
+    ROW("blake2s_224_pangram",
+        QCryptographicHash::Blake2s_224,
+        "The quick brown fox jumps over the lazy dog",
+        "e4e5cb6c7cae41982b397bf7b7d2d9d1949823ae78435326e8db4912");
+
+    ROW("blake2s_256_pangram",
+        QCryptographicHash::Blake2s_256,
+        "The quick brown fox jumps over the lazy dog",
+        "606beeec743ccbeff6cbcdf5d5302aa855c256c29b88c8ed331ea1a6bf3c8812");
+
+#undef ROW
+}
+
+void tst_QCryptographicHash::blake2()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, expectedResult);
+
+    const auto result = QCryptographicHash::hash(data, algorithm);
+    QCOMPARE(result, expectedResult);
+}
+
+void tst_QCryptographicHash::largeData_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    // 1 MiB of (i % 251)
+    QTest::newRow("sha1") << QCryptographicHash::Sha1
+        << QByteArray::fromHex("c2fc4cb20f1301a6b0dd211c19e69a13925dbe40");
+    QTest::newRow("sha256") << QCryptographicHash::Sha256
+        << QByteArray::fromHex("631b84027d6b9e52b539c4e8373622d23032dfadc64d60af87339c9037e4f769");
+    QTest::newRow("blake2b_512") << QCryptographicHash::Blake2b_512
+        << QByteArray::fromHex("797c6241704933d0c62cea0793db1dd5c65ffd258f8340d394d2cd26b7bf5370"
+                               "46ebb5914fb1fae7635ce1f379fb819abc57ad509c015bb4dba4bc981bb1c446");
+}
+
+void tst_QCryptographicHash::largeData()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QByteArray, expectedResult);
+
+    QByteArray data(1024 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i % 251);
+
+    QCOMPARE(QCryptographicHash::hash(data, algorithm), expectedResult);
+
+    // pieces that do not line up with the block size
+    QCryptographicHash hash(algorithm);
+    for (int pos = 0, step = 1; pos < data.size(); pos += step, step = step * 3 + 1)
+        hash.addData(data.constData() + pos, qMin(step, data.size() - pos));
+    QCOMPARE(hash.result(), expectedResult);
+
+    // through a file, starting from a position that is not block aligned
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.read(3), data.left(3));
+    hash.reset();
+    hash.addData(data.constData(), 3);
+    QVERIFY(hash.addData(&file));
+    QVERIFY(file.atEnd());
+    QCOMPARE(hash.result(), expectedResult);
+}
+
 void tst_QCryptographicHash::files_data() {
     QTest::addColumn<QString>("filename");
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
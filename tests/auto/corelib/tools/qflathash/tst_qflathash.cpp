@@ -0,0 +1,358 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qflathash.h>
+#include <qhash.h>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void insertAndFind();
+    void remove();
+    void iterate();
+    void erase();
+    void implicitSharing();
+    void reserveAndSqueeze();
+    void operatorEquals();
+    void nonTrivialTypes();
+    void takeAndValue();
+    void initializerList();
+    void compareWithQHash();
+};
+
+void tst_QFlatHash::insertAndFind()
+{
+    QFlatHash<quint64, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(0));
+    QVERIFY(hash.find(0) == hash.end());
+
+    const int count = 10000;
+    for (int i = 0; i < count; ++i)
+        hash.insert(quint64(i) << 32, i);
+    QCOMPARE(hash.size(), count);
+    QVERIFY(hash.capacity() >= count);
+
+    for (int i = 0; i < count; ++i) {
+        QFlatHash<quint64, int>::const_iterator it = hash.constFind(quint64(i) << 32);
+        QVERIFY(it != hash.constEnd());
+        QCOMPARE(it.key(), quint64(i) << 32);
+        QCOMPARE(it.value(), i);
+    }
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.count(quint64(1) << 32), 1);
+    QCOMPARE(hash.count(1), 0);
+
+    // inserting an existing key replaces its value
+    QFlatHash<quint64, int>::iterator it = hash.insert(0, -1);
+    QCOMPARE(it.value(), -1);
+    QCOMPARE(hash.size(), count);
+    QCOMPARE(hash.value(0), -1);
+
+    hash[7] = 7;
+    QCOMPARE(hash.size(), count + 1);
+    ++hash[7];
+    QCOMPARE(hash.value(7), 8);
+}
+
+void tst_QFlatHash::remove()
+{
+    QFlatHash<int, int> hash;
+    QCOMPARE(hash.remove(1), 0);
+
+    // removing and inserting over and over must not fill the table
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 100; ++i)
+            hash.insert(round * 100 + i, i);
+        for (int i = 0; i < 100; ++i)
+            QCOMPARE(hash.remove(round * 100 + i), 1);
+        QVERIFY(hash.isEmpty());
+    }
+    QVERIFY(hash.capacity() <= 256);
+
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    for (int i = 0; i < 1000; i += 2)
+        QCOMPARE(hash.remove(i), 1);
+    QCOMPARE(hash.remove(0), 0);
+    QCOMPARE(hash.size(), 500);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+}
+
+void tst_QFlatHash::iterate()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.begin() == hash.end());
+    QVERIFY(hash.constBegin() == hash.constEnd());
+
+    for (int i = 0; i < 300; ++i)
+        hash.insert(i, i * 2);
+
+    QSet<int> seen;
+    for (QFlatHash<int, int>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        QCOMPARE(it.value(), it.key() * 2);
+        seen.insert(it.key());
+    }
+    QCOMPARE(seen.size(), 300);
+
+    for (QFlatHash<int, int>::iterator it = hash.begin(); it != hash.end(); ++it)
+        *it += 1;
+    int sum = 0;
+    for (int value : qAsConst(hash))
+        sum += value;
+    QCOMPARE(sum, 299 * 300 + 300);
+
+    QList<int> keys = hash.keys();
+    std::sort(keys.begin(), keys.end());
+    QCOMPARE(keys.size(), 300);
+    QCOMPARE(keys.first(), 0);
+    QCOMPARE(keys.last(), 299);
+    QCOMPARE(hash.values().size(), 300);
+}
+
+void tst_QFlatHash::erase()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+
+    // erasing never moves the other elements
+    QFlatHash<int, int>::iterator it = hash.begin();
+    int visited = 0;
+    while (it != hash.end()) {
+        ++visited;
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(visited, 1000);
+    QCOMPARE(hash.size(), 666);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), i % 3 != 0);
+
+    // erasing through a shared copy detaches
+    QFlatHash<int, int> copy = hash;
+    it = copy.find(1);
+    QVERIFY(it != copy.end());
+    copy.erase(it);
+    QVERIFY(!copy.contains(1));
+    QVERIFY(hash.contains(1));
+}
+
+void tst_QFlatHash::implicitSharing()
+{
+    QFlatHash<int, QString> hash;
+    hash.insert(1, QStringLiteral("one"));
+    hash.insert(2, QStringLiteral("two"));
+
+    QFlatHash<int, QString> copy = hash;
+    QVERIFY(copy.isSharedWith(hash));
+    QVERIFY(!hash.isDetached());
+    QCOMPARE(copy.constFind(1).value(), QStringLiteral("one"));
+    QVERIFY(copy.isSharedWith(hash));
+
+    copy.insert(3, QStringLiteral("three"));
+    QVERIFY(!copy.isSharedWith(hash));
+    QVERIFY(hash.isDetached());
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(copy.size(), 3);
+
+    QFlatHash<int, QString> other = hash;
+    other[1] = QStringLiteral("uno");
+    QCOMPARE(hash.value(1), QStringLiteral("one"));
+    QCOMPARE(other.value(1), QStringLiteral("uno"));
+
+    other = hash;
+    QCOMPARE(other.remove(2), 1);
+    QVERIFY(hash.contains(2));
+
+    QFlatHash<int, QString> moved = std::move(other);
+    QVERIFY(other.isEmpty());
+    QCOMPARE(moved.size(), 1);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(copy.size(), 3);
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    const int capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QCOMPARE(hash.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i), i);
+
+    hash.clear();
+    hash.squeeze();
+    QCOMPARE(hash.capacity(), 0);
+}
+
+void tst_QFlatHash::operatorEquals()
+{
+    QFlatHash<int, int> a;
+    QFlatHash<int, int> b;
+    QVERIFY(a == b);
+
+    for (int i = 0; i < 100; ++i)
+        a.insert(i, i);
+    QVERIFY(a != b);
+    // the same contents in a table of a different size
+    b.reserve(1000);
+    for (int i = 99; i >= 0; --i)
+        b.insert(i, i);
+    QVERIFY(a == b);
+
+    b[50] = -1;
+    QVERIFY(a != b);
+    b.remove(50);
+    QVERIFY(a != b);
+    b.insert(50, 50);
+    QVERIFY(a == b);
+}
+
+struct Counted
+{
+    Counted(int v = 0) : value(v) { ++instances; }
+    Counted(const Counted &other) : value(other.value) { ++instances; }
+    ~Counted() { --instances; }
+    Counted &operator=(const Counted &other) { value = other.value; return *this; }
+    bool operator==(const Counted &other) const { return value == other.value; }
+
+    int value;
+    static int instances;
+};
+
+int Counted::instances = 0;
+
+void tst_QFlatHash::nonTrivialTypes()
+{
+    {
+        QFlatHash<QString, Counted> hash;
+        for (int i = 0; i < 500; ++i)
+            hash.insert(QString::number(i), Counted(i));
+        QCOMPARE(Counted::instances, 500);
+        for (int i = 0; i < 500; ++i)
+            QCOMPARE(hash.value(QString::number(i)).value, i);
+
+        QFlatHash<QString, Counted> copy = hash;
+        QCOMPARE(Counted::instances, 500);
+        copy.remove(QStringLiteral("1"));
+        QCOMPARE(Counted::instances, 999);
+        copy.clear();
+        QCOMPARE(Counted::instances, 500);
+
+        for (int i = 0; i < 500; i += 2)
+            hash.remove(QString::number(i));
+        QCOMPARE(Counted::instances, 250);
+        hash.squeeze();
+        QCOMPARE(Counted::instances, 250);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+void tst_QFlatHash::takeAndValue()
+{
+    QFlatHash<QString, QString> hash;
+    QCOMPARE(hash.value(QStringLiteral("a")), QString());
+    QCOMPARE(hash.value(QStringLiteral("a"), QStringLiteral("default")), QStringLiteral("default"));
+    QCOMPARE(hash.take(QStringLiteral("a")), QString());
+
+    hash.insert(QStringLiteral("a"), QStringLiteral("b"));
+    QCOMPARE(hash.key(QStringLiteral("b")), QStringLiteral("a"));
+    QCOMPARE(hash.key(QStringLiteral("c"), QStringLiteral("none")), QStringLiteral("none"));
+    QCOMPARE(hash.take(QStringLiteral("a")), QStringLiteral("b"));
+    QVERIFY(hash.isEmpty());
+
+    const QFlatHash<QString, QString> constHash = hash;
+    QCOMPARE(constHash[QStringLiteral("a")], QString());
+    QVERIFY(constHash.isEmpty());
+}
+
+void tst_QFlatHash::initializerList()
+{
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatHash<int, QString> hash = {{1, QStringLiteral("bar")}, {1, QStringLiteral("hello")}, {2, QStringLiteral("initializer_list")}};
+    QCOMPARE(hash.count(), 2);
+    QCOMPARE(hash[1], QStringLiteral("hello"));
+    QCOMPARE(hash[2], QStringLiteral("initializer_list"));
+
+    QFlatHash<int, int> empty = {};
+    QVERIFY(empty.isEmpty());
+#else
+    QSKIP("Compiler doesn't support initializer lists");
+#endif
+}
+
+void tst_QFlatHash::compareWithQHash()
+{
+    QFlatHash<uint, int> flat;
+    QHash<uint, int> reference;
+    quint32 state = 1;
+    for (int i = 0; i < 50000; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const uint key = (state >> 8) % 4096;
+        switch (state % 3) {
+        case 0:
+        case 1:
+            flat.insert(key, i);
+            reference.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(flat.remove(key), reference.remove(key));
+            break;
+        }
+    }
+    QCOMPARE(flat.size(), reference.size());
+    for (QHash<uint, int>::const_iterator it = reference.constBegin(); it != reference.constEnd(); ++it)
+        QCOMPARE(flat.value(it.key(), -1), it.value());
+    int count = 0;
+    for (QFlatHash<uint, int>::const_iterator it = flat.constBegin(); it != flat.constEnd(); ++it, ++count)
+        QCOMPARE(reference.value(it.key(), -1), it.value());
+    QCOMPARE(count, reference.size());
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
@@ -53,6 +53,7 @@ private Q_SLOTS:
     void qhash();
     void qhash_of_empty_and_null_qstring();
     void qhash_of_empty_and_null_qbytearray();
+    void qhash_of_all_lengths();
     void fp_qhash_of_zero_is_seed();
     void qthash_data();
     void qthash();
@@ -189,6 +190,40 @@ void tst_QHashFunctions::qhash_of_empty_and_null_qbytearray()
     QCOMPARE(qHash(null, seed), qHash(empty, seed));
 }
 
+void tst_QHashFunctions::qhash_of_all_lengths()
+{
+    // covers the short and long key paths, and the partial blocks at the end
+    QByteArray bytes;
+    QString string;
+    for (int i = 0; i < 1100; ++i) {
+        bytes.append(char('a' + i % 26));
+        string.append(QChar(0x100 + i % 331));
+    }
+
+    for (int len = 0; len <= 1100; len = len < 200 ? len + 1 : len + 61) {
+        const QByteArray b = bytes.left(len);
+        const QString s = string.left(len);
+        QCOMPARE(qHash(b, seed), qHashBits(b.constData(), size_t(len), seed));
+        QCOMPARE(qHash(s, seed), qHash(QStringView(s), seed));
+        QCOMPARE(qHash(s, seed), qHash(QStringRef(&s), seed));
+        // keys in the middle of a larger buffer
+        QCOMPARE(qHash(QStringView(string.constData() + 1, len), seed), qHash(string.mid(1, len), seed));
+
+        if (len == 0)
+            continue;
+        QVERIFY(qHash(b, seed) != qHash(bytes.left(len - 1), seed));   // not guaranteed
+        QVERIFY(qHash(s, seed) != qHash(string.left(len - 1), seed));  // not guaranteed
+        for (int pos : {0, len / 2, len - 1}) {
+            QByteArray changedBytes = b;
+            changedBytes[pos] = char(changedBytes.at(pos) ^ 0x10);
+            QVERIFY(qHash(b, seed) != qHash(changedBytes, seed));      // not guaranteed
+            QString changedString = s;
+            changedString[pos] = QChar(changedString.at(pos).unicode() ^ 0x1000);
+            QVERIFY(qHash(s, seed) != qHash(changedString, seed));     // not guaranteed
+        }
+    }
+}
+
 void tst_QHashFunctions::fp_qhash_of_zero_is_seed()
 {
     QCOMPARE(qHash(-0.0f, seed), seed);
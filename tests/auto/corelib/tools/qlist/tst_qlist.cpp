@@ -191,6 +191,85 @@ int qHash(const Optimal& key)
     return qHash(key.i);
 }
 
+// Larger than a pointer, but stored directly in QList's array
+struct Direct
+{
+    Direct(char input = 'j')
+        : i(input),
+          state(Constructed)
+    {
+        ++liveCount;
+    }
+    Direct(const Direct &other)
+        : i(other.i),
+          state(Constructed)
+    {
+        check(other.state, Constructed);
+        ++liveCount;
+    }
+
+    ~Direct()
+    {
+        check(state, Constructed);
+        i = 0;
+        --liveCount;
+        state = Destructed;
+    }
+
+    bool operator ==(const Direct &other) const
+    {
+        check(state, Constructed);
+        check(other.state, Constructed);
+        return i == other.i;
+    }
+
+    bool operator<(const Direct &other) const
+    {
+        check(state, Constructed);
+        check(other.state, Constructed);
+        return i < other.i;
+    }
+
+    Direct &operator=(const Direct &other)
+    {
+        check(state, Constructed);
+        check(other.state, Constructed);
+        i = other.i;
+        return *this;
+    }
+    char i;
+
+    static int getLiveCount() { return liveCount; }
+private:
+    static int liveCount;
+
+    enum State { Constructed = 106, Destructed = 110 };
+    uchar state;
+    char padding[2 * sizeof(void*) + 3];
+
+    static void check(const uchar state1, const uchar state2)
+    {
+        QCOMPARE(state1, state2);
+    }
+};
+
+Q_STATIC_ASSERT(sizeof(Direct) > 2 * sizeof(void*));
+Q_STATIC_ASSERT(sizeof(Direct) % sizeof(void*) != 0);
+
+int Direct::liveCount = 0;
+
+QT_BEGIN_NAMESPACE
+Q_DECLARE_TYPEINFO(Direct, Q_MOVABLE_TYPE);
+Q_DECLARE_LIST_DIRECT_STORAGE(Direct)
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(Direct);
+
+int qHash(const Direct& key)
+{
+    return qHash(key.i);
+}
+
 struct Complex
 {
     Complex(int val = 0)
@@ -260,6 +339,8 @@ Q_STATIC_ASSERT(QTypeInfo<Movable>::isComplex);
 Q_STATIC_ASSERT(!QTypeInfo<Optimal>::isStatic);
 Q_STATIC_ASSERT(QTypeInfo<Optimal>::isComplex);
 Q_STATIC_ASSERT(QTypeInfo<Complex>::isStatic);
+Q_STATIC_ASSERT(QTypeInfo<Direct>::isLarge);
+Q_STATIC_ASSERT(QListDirectStorage<Direct>::value);
 Q_STATIC_ASSERT(QTypeInfo<Complex>::isComplex);
 // iow:
 Q_STATIC_ASSERT(( is_qlist_array_memory_layout<int, QListData::NotIndirectLayout>       ::value));
@@ -277,6 +358,12 @@ Q_STATIC_ASSERT(( is_qlist_array_memory_layout<Movable, QListData::NotIndirectLa
 Q_STATIC_ASSERT((!is_qlist_array_memory_layout<Movable, QListData::ArrayCompatibleLayout>   ::value));
 Q_STATIC_ASSERT((!is_qlist_array_memory_layout<Movable, QListData::IndirectLayout>          ::value));
 
+Q_STATIC_ASSERT(( is_qlist_array_memory_layout<Direct, QListData::InlineWithPaddingLayout> ::value));
+Q_STATIC_ASSERT(( is_qlist_array_memory_layout<Direct, QListData::NotArrayCompatibleLayout>::value));
+Q_STATIC_ASSERT(( is_qlist_array_memory_layout<Direct, QListData::NotIndirectLayout>       ::value));
+Q_STATIC_ASSERT((!is_qlist_array_memory_layout<Direct, QListData::ArrayCompatibleLayout>   ::value));
+Q_STATIC_ASSERT((!is_qlist_array_memory_layout<Direct, QListData::IndirectLayout>          ::value));
+
 Q_STATIC_ASSERT((!is_qlist_array_memory_layout<Complex, QListData::InlineWithPaddingLayout> ::value));
 Q_STATIC_ASSERT(( is_qlist_array_memory_layout<Complex, QListData::NotArrayCompatibleLayout>::value));
 Q_STATIC_ASSERT((!is_qlist_array_memory_layout<Complex, QListData::NotIndirectLayout>       ::value));
@@ -291,104 +378,135 @@ private slots:
     void lengthOptimal() const;
     void lengthMovable() const;
     void lengthComplex() const;
+    void lengthDirect() const;
     void lengthSignature() const;
     void appendOptimal() const;
     void appendMovable() const;
     void appendComplex() const;
+    void appendDirect() const;
     void prepend() const;
     void midOptimal() const;
     void midMovable() const;
     void midComplex() const;
+    void midDirect() const;
     void atOptimal() const;
     void atMovable() const;
     void atComplex() const;
+    void atDirect() const;
     void firstOptimal() const;
     void firstMovable() const;
     void firstComplex() const;
+    void firstDirect() const;
     void lastOptimal() const;
     void lastMovable() const;
     void lastComplex() const;
+    void lastDirect() const;
     void constFirst() const;
     void constLast() const;
     void beginOptimal() const;
     void beginMovable() const;
     void beginComplex() const;
+    void beginDirect() const;
     void endOptimal() const;
     void endMovable() const;
     void endComplex() const;
+    void endDirect() const;
     void containsOptimal() const;
     void containsMovable() const;
     void containsComplex() const;
+    void containsDirect() const;
     void countOptimal() const;
     void countMovable() const;
     void countComplex() const;
+    void countDirect() const;
     void emptyOptimal() const;
     void emptyMovable() const;
     void emptyComplex() const;
+    void emptyDirect() const;
     void endsWithOptimal() const;
     void endsWithMovable() const;
     void endsWithComplex() const;
+    void endsWithDirect() const;
     void lastIndexOfOptimal() const;
     void lastIndexOfMovable() const;
     void lastIndexOfComplex() const;
+    void lastIndexOfDirect() const;
     void moveOptimal() const;
     void moveMovable() const;
     void moveComplex() const;
+    void moveDirect() const;
     void removeAllOptimal() const;
     void removeAllMovable() const;
     void removeAllComplex() const;
+    void removeAllDirect() const;
     void removeAtOptimal() const;
     void removeAtMovable() const;
     void removeAtComplex() const;
+    void removeAtDirect() const;
     void removeOneOptimal() const;
     void removeOneMovable() const;
     void removeOneComplex() const;
+    void removeOneDirect() const;
     void replaceOptimal() const;
     void replaceMovable() const;
     void replaceComplex() const;
+    void replaceDirect() const;
     void reverseIteratorsOptimal() const;
     void reverseIteratorsMovable() const;
     void reverseIteratorsComplex() const;
+    void reverseIteratorsDirect() const;
     void startsWithOptimal() const;
     void startsWithMovable() const;
     void startsWithComplex() const;
+    void startsWithDirect() const;
     void swapOptimal() const;
     void swapMovable() const;
     void swapComplex() const;
+    void swapDirect() const;
     void takeAtOptimal() const;
     void takeAtMovable() const;
     void takeAtComplex() const;
+    void takeAtDirect() const;
     void takeFirstOptimal() const;
     void takeFirstMovable() const;
     void takeFirstComplex() const;
+    void takeFirstDirect() const;
     void takeLastOptimal() const;
     void takeLastMovable() const;
     void takeLastComplex() const;
+    void takeLastDirect() const;
     void toSetOptimal() const;
     void toSetMovable() const;
     void toSetComplex() const;
+    void toSetDirect() const;
     void toStdListOptimal() const;
     void toStdListMovable() const;
     void toStdListComplex() const;
+    void toStdListDirect() const;
     void toVectorOptimal() const;
     void toVectorMovable() const;
     void toVectorComplex() const;
+    void toVectorDirect() const;
     void valueOptimal() const;
     void valueMovable() const;
     void valueComplex() const;
+    void valueDirect() const;
 
     void testOperatorsOptimal() const;
     void testOperatorsMovable() const;
     void testOperatorsComplex() const;
+    void testOperatorsDirect() const;
     void testSTLIteratorsOptimal() const;
     void testSTLIteratorsMovable() const;
     void testSTLIteratorsComplex() const;
+    void testSTLIteratorsDirect() const;
 
     void initializeList() const;
 
     void constSharedNullOptimal() const;
     void constSharedNullMovable() const;
     void constSharedNullComplex() const;
+    void constSharedNullDirect() const;
     void setSharableInt_data() const;
     void setSharableInt() const;
     void setSharableComplex_data() const;
@@ -399,7 +517,9 @@ private slots:
     void qhashOptimal() const { qhash<Optimal>(); }
     void qhashMovable() const { qhash<Movable>(); }
     void qhashComplex() const { qhash<Complex>(); }
+    void qhashDirect() const { qhash<Direct>(); }
     void reserve() const;
+    void directStorage() const;
 private:
     template<typename T> void length() const;
     template<typename T> void append() const;
@@ -455,6 +575,8 @@ template<>
 const Movable SimpleValue<Movable>::values[] = { 10, 20, 30, 40, 100, 101, 102 };
 template<>
 const Complex SimpleValue<Complex>::values[] = { 10, 20, 30, 40, 100, 101, 102 };
+template<>
+const Direct SimpleValue<Direct>::values[] = { 10, 20, 30, 40, 100, 101, 102 };
 
 // Make some macros for the tests to use in order to be slightly more readable...
 #define T_FOO SimpleValue<T>::at(0)
@@ -520,6 +642,13 @@ void tst_QList::lengthComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::lengthDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    length<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 void tst_QList::lengthSignature() const
 {
     /* Constness. */
@@ -574,6 +703,13 @@ void tst_QList::appendComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::appendDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    append<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 void tst_QList::prepend() const
 {
     QList<int *> list;
@@ -641,6 +777,13 @@ void tst_QList::midComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::midDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    mid<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::at() const
 {
@@ -691,6 +834,13 @@ void tst_QList::atComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::atDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    at<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::first() const
 {
@@ -726,6 +876,13 @@ void tst_QList::firstComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::firstDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    first<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 void tst_QList::constFirst() const
 {
     // Based on tst_QVector::constFirst()
@@ -895,6 +1052,13 @@ void tst_QList::lastComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::lastDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    last<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::begin() const
 {
@@ -930,6 +1094,13 @@ void tst_QList::beginComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::beginDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    begin<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::end() const
 {
@@ -965,6 +1136,13 @@ void tst_QList::endComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::endDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    end<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::contains() const
 {
@@ -1000,6 +1178,13 @@ void tst_QList::containsComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::containsDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    contains<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::count() const
 {
@@ -1046,6 +1231,13 @@ void tst_QList::countComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::countDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    count<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::empty() const
 {
@@ -1084,6 +1276,13 @@ void tst_QList::emptyComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::emptyDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    empty<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::endsWith() const
 {
@@ -1120,6 +1319,13 @@ void tst_QList::endsWithComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::endsWithDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    endsWith<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::lastIndexOf() const
 {
@@ -1165,6 +1371,13 @@ void tst_QList::lastIndexOfComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::lastIndexOfDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    lastIndexOf<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::move() const
 {
@@ -1205,6 +1418,13 @@ void tst_QList::moveComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::moveDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    move<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::removeAll() const
 {
@@ -1246,6 +1466,13 @@ void tst_QList::removeAllComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::removeAllDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    removeAll<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::removeAt() const
 {
@@ -1286,6 +1513,13 @@ void tst_QList::removeAtComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::removeAtDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    removeAt<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::removeOne() const
 {
@@ -1335,6 +1569,13 @@ void tst_QList::removeOneComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::removeOneDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    removeOne<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::replace() const
 {
@@ -1378,6 +1619,13 @@ void tst_QList::replaceComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::replaceDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    replace<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::reverseIterators() const
 {
@@ -1415,6 +1663,13 @@ void tst_QList::reverseIteratorsComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::reverseIteratorsDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    reverseIterators<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::startsWith() const
 {
@@ -1450,6 +1705,13 @@ void tst_QList::startsWithComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::startsWithDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    startsWith<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::swap() const
 {
@@ -1493,6 +1755,13 @@ void tst_QList::swapComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::swapDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    swap<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::takeAt() const
 {
@@ -1528,6 +1797,13 @@ void tst_QList::takeAtComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::takeAtDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    takeAt<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::takeFirst() const
 {
@@ -1563,6 +1839,13 @@ void tst_QList::takeFirstComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::takeFirstDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    takeFirst<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::takeLast() const
 {
@@ -1595,6 +1878,13 @@ void tst_QList::takeLastComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::takeLastDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    takeLast<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::toSet() const
 {
@@ -1633,6 +1923,13 @@ void tst_QList::toSetComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::toSetDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    toSet<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::toStdList() const
 {
@@ -1670,6 +1967,13 @@ void tst_QList::toStdListComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::toStdListDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    toStdList<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::toVector() const
 {
@@ -1700,6 +2004,13 @@ void tst_QList::toVectorComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::toVectorDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    toVector<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::value() const
 {
@@ -1741,6 +2052,13 @@ void tst_QList::valueComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::valueDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    value<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::testOperators() const
 {
@@ -1808,6 +2126,13 @@ void tst_QList::testOperatorsComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::testOperatorsDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    testOperators<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template<typename T>
 void tst_QList::testSTLIterators() const
 {
@@ -1869,6 +2194,13 @@ void tst_QList::testSTLIteratorsComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::testSTLIteratorsDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    testSTLIterators<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 void tst_QList::initializeList() const
 {
 #ifdef Q_COMPILER_INITIALIZER_LISTS
@@ -1918,6 +2250,13 @@ void tst_QList::constSharedNullComplex() const
     QCOMPARE(liveCount, Complex::getLiveCount());
 }
 
+void tst_QList::constSharedNullDirect() const
+{
+    const int liveCount = Direct::getLiveCount();
+    constSharedNull<Direct>();
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 template <class T>
 void generateSetSharableData()
 {
@@ -2079,5 +2418,87 @@ void tst_QList::reserve() const
     QVERIFY(&list.at(0) != data);
 }
 
+void tst_QList::directStorage() const
+{
+    const int liveCount = Direct::getLiveCount();
+    {
+        // Direct items span several entries of the array; mix the operations
+        // that move entries around and compare against a plain array
+        QList<Direct> list;
+        std::vector<char> expected;
+        for (int round = 0; round < 200; ++round) {
+            const char c = char(round % 100 + 1);
+            switch (round % 7) {
+            case 0:
+            case 1:
+                list.append(Direct(c));
+                expected.push_back(c);
+                break;
+            case 2:
+                list.prepend(Direct(c));
+                expected.insert(expected.begin(), c);
+                break;
+            case 3: {
+                const int i = round % (int(expected.size()) + 1);
+                list.insert(i, Direct(c));
+                expected.insert(expected.begin() + i, c);
+                break;
+            }
+            case 4: {
+                const int i = round % int(expected.size());
+                list.removeAt(i);
+                expected.erase(expected.begin() + i);
+                break;
+            }
+            case 5: {
+                // detach_helper_grow() with a shared list
+                QList<Direct> copy = list;
+                const int i = round % (int(expected.size()) + 1);
+                list.insert(i, Direct(c));
+                expected.insert(expected.begin() + i, c);
+                QCOMPARE(copy.size() + 1, list.size());
+                break;
+            }
+            case 6:
+                list.move(0, list.size() - 1);
+                std::rotate(expected.begin(), expected.begin() + 1, expected.end());
+                list.swap(0, list.size() / 2);
+                std::swap(expected[0], expected[expected.size() / 2]);
+                break;
+            }
+
+            QCOMPARE(list.size(), int(expected.size()));
+            for (int i = 0; i < list.size(); ++i)
+                QCOMPARE(list.at(i).i, expected[i]);
+        }
+
+        // items are stored in the array itself, without any padding between them
+        QCOMPARE(reinterpret_cast<const char *>(&list.at(1)) - reinterpret_cast<const char *>(&list.at(0)),
+                 qptrdiff((sizeof(Direct) + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *)));
+
+        QList<Direct> mid = list.mid(3, 10);
+        QCOMPARE(mid.size(), 10);
+        for (int i = 0; i < mid.size(); ++i)
+            QCOMPARE(mid.at(i).i, expected[i + 3]);
+
+        list.erase(list.begin() + 2, list.begin() + 12);
+        expected.erase(expected.begin() + 2, expected.begin() + 12);
+        list += mid;
+        for (int i = 0; i < mid.size(); ++i)
+            expected.push_back(mid.at(i).i);
+        QCOMPARE(list.size(), int(expected.size()));
+        for (int i = 0; i < list.size(); ++i)
+            QCOMPARE(list.at(i).i, expected[i]);
+
+        const Direct first = list.first();
+        QCOMPARE(list.removeAll(first), int(std::count(expected.begin(), expected.end(), first.i)));
+        expected.erase(std::remove(expected.begin(), expected.end(), first.i), expected.end());
+        QCOMPARE(list.size(), int(expected.size()));
+        QCOMPARE(list.takeFirst().i, expected.front());
+        QCOMPARE(list.takeLast().i, expected.back());
+    }
+    QCOMPARE(liveCount, Direct::getLiveCount());
+}
+
 QTEST_APPLESS_MAIN(tst_QList)
 #include "tst_qlist.moc"
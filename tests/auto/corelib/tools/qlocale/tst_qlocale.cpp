@@ -87,6 +87,7 @@ private slots:
     void stringToDouble();
     void doubleToString_data();
     void doubleToString();
+    void doubleToStringCLocaleFlags();
     void strtod_data();
     void strtod();
     void long_long_conversion_data();
@@ -917,6 +918,29 @@ void tst_QLocale::doubleToString()
     setlocale(LC_ALL, currentLocale);
 }
 
+void tst_QLocale::doubleToStringCLocaleFlags()
+{
+    // These go through the allocation free C locale formatter
+    QCOMPARE(QString("%1").arg(-1.5, 8, 'f', 2, QLatin1Char('0')), QString("-0001.50"));
+    QCOMPARE(QString("%1").arg(1.5, 8, 'f', 2, QLatin1Char('0')), QString("00001.50"));
+    QCOMPARE(QString("%1").arg(1.5, 8, 'E', 1, QLatin1Char('0')), QString("001.5E+0"));
+    QCOMPARE(QString("%1").arg(-qInf(), 0, 'G'), QString("-INF"));
+    QCOMPARE(QString("%1").arg(-0.0, 0, 'f', 1), QString("0.0"));
+
+    QCOMPARE(QByteArray::number(1.5e100, 'E', 3), QByteArray("1.500E+100"));
+    QCOMPARE(QByteArray::number(-1e-5, 'e', 0), QByteArray("-1e-05"));
+    QCOMPARE(QByteArray::number(123456789.0, 'f', 0), QByteArray("123456789"));
+    QCOMPARE(QByteArray::number(0.000123, 'g', 6), QByteArray("0.000123"));
+    QCOMPARE(QByteArray::number(0.0000123, 'g', 6), QByteArray("1.23e-05"));
+    QCOMPARE(QByteArray::number(1e21, 'g', QLocale::FloatingPointShortest), QByteArray("1e+21"));
+    QCOMPARE(QByteArray::number(qQNaN()), QByteArray("nan"));
+
+    QLocale c(QLocale::C);
+    c.setNumberOptions(QLocale::DefaultNumberOptions);
+    QCOMPARE(c.toString(1234567.25, 'f', 2), QString("1,234,567.25"));
+    QCOMPARE(c.toString(1234567.25, 'g', QLocale::FloatingPointShortest), QString("1,234,567.25"));
+}
+
 void tst_QLocale::strtod_data()
 {
     QTest::addColumn<QString>("num_str");
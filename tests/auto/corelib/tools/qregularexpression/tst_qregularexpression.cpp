@@ -843,6 +843,32 @@ void tst_QRegularExpression::normalMatch()
                                        match);
 }
 
+void tst_QRegularExpression::hasMatch_data()
+{
+    normalMatch_data();
+}
+
+void tst_QRegularExpression::hasMatch()
+{
+    QFETCH(QRegularExpression, regexp);
+    QFETCH(QString, subject);
+    QFETCH(int, offset);
+    QFETCH(QRegularExpression::MatchOptions, matchOptions);
+    QFETCH(Match, match);
+
+    if (forceOptimize)
+        regexp.optimize();
+
+    const bool expected = match.isValid && match.hasMatch;
+    QCOMPARE(regexp.hasMatch(subject, offset, matchOptions), expected);
+    QCOMPARE(regexp.hasMatch(QStringView(subject), offset, matchOptions),
+             regexp.match(subject, offset, QRegularExpression::NormalMatch, matchOptions).hasMatch());
+
+    // the same subject, embedded in a larger string
+    const QString padded = QLatin1String("xx") + subject + QLatin1String("yy");
+    QCOMPARE(regexp.hasMatch(QStringView(padded).mid(2, subject.size()), offset, matchOptions), expected);
+}
+
 void tst_QRegularExpression::partialMatch_data()
 {
     QTest::addColumn<QRegularExpression>("regexp");
@@ -2066,3 +2092,39 @@ void tst_QRegularExpression::QStringAndQStringRefEquivalence()
         }
     }
 }
+
+void tst_QRegularExpression::sharedPatterns()
+{
+    // objects built from the same pattern share its compiled form, but
+    // changing one of them must never affect the others
+    QRegularExpression re1(QStringLiteral("a(b+)c"));
+    QRegularExpression re2(QStringLiteral("a(b+)c"));
+    if (forceOptimize) {
+        re1.optimize();
+        re2.optimize();
+    }
+    QVERIFY(re1.hasMatch(QStringLiteral("xabbbcx")));
+    QCOMPARE(re2.match(QStringLiteral("xabbbcx")).captured(1), QStringLiteral("bbb"));
+
+    re2.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(!re1.hasMatch(QStringLiteral("ABC")));
+    QVERIFY(re2.hasMatch(QStringLiteral("ABC")));
+    QCOMPARE(re1.patternOptions(), QRegularExpression::NoPatternOption);
+
+    re2.setPattern(QStringLiteral("[0-9]+"));
+    QCOMPARE(re1.pattern(), QStringLiteral("a(b+)c"));
+    QVERIFY(re1.hasMatch(QStringLiteral("abc")));
+    QVERIFY(!re2.hasMatch(QStringLiteral("abc")));
+    QVERIFY(re2.hasMatch(QStringLiteral("ABC123")));
+    QCOMPARE(re2.captureCount(), 0);
+    QCOMPARE(re1.captureCount(), 1);
+
+    // invalid patterns are shared as well, and stay invalid
+    QRegularExpression invalid1(QStringLiteral("a(b"));
+    QRegularExpression invalid2(QStringLiteral("a(b"));
+    QVERIFY(!invalid1.isValid());
+    QVERIFY(!invalid2.isValid());
+    QCOMPARE(invalid2.patternErrorOffset(), invalid1.patternErrorOffset());
+    QTest::ignoreMessage(QtWarningMsg, "QRegularExpressionPrivate::doHasMatch(): called on an invalid QRegularExpression object");
+    QVERIFY(!invalid2.hasMatch(QStringLiteral("a(b")));
+}
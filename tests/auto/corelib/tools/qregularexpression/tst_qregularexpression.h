@@ -49,6 +49,8 @@ private slots:
     void patternOptions();
     void normalMatch_data();
     void normalMatch();
+    void hasMatch_data();
+    void hasMatch();
     void partialMatch_data();
     void partialMatch();
     void globalMatch_data();
@@ -68,6 +70,7 @@ private slots:
     void JOptionUsage_data();
     void JOptionUsage();
     void QStringAndQStringRefEquivalence();
+    void sharedPatterns();
 
 private:
     void provideRegularExpressions();
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qsmallstring
+QT = core testlib
+SOURCES = $$PWD/tst_qsmallstring.cpp
@@ -0,0 +1,205 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+
+#include <qhash.h>
+#include <qsmallstring.h>
+#include <qstringbuilder.h>
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+private slots:
+    void constructFromView_data();
+    void constructFromView();
+    void constructFromString();
+    void fromUtf8_data();
+    void fromUtf8();
+    void fromLatin1();
+    void copyAndMove();
+    void compare();
+    void hash();
+    void stringBuilder();
+};
+
+void tst_QSmallString::constructFromView_data()
+{
+    QTest::addColumn<QString>("str");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("short") << QString("abc");
+    QTest::newRow("full") << QString(QSmallString::InlineCapacity, QLatin1Char('x'));
+    QTest::newRow("too long") << QString(QSmallString::InlineCapacity + 1, QLatin1Char('y'));
+    QTest::newRow("long") << QString::fromLatin1("The quick brown fox jumps over the lazy dog");
+}
+
+void tst_QSmallString::constructFromView()
+{
+    QFETCH(QString, str);
+
+    const QSmallString small{QStringView(str)};
+    QCOMPARE(small.size(), str.size());
+    QCOMPARE(small.isEmpty(), str.isEmpty());
+    QCOMPARE(small.isInline(), str.size() <= int(QSmallString::InlineCapacity));
+    QCOMPARE(small.toString(), str);
+    QVERIFY(QStringView(small) == QStringView(str));
+    for (int i = 0; i < str.size(); ++i)
+        QCOMPARE(small.at(i), str.at(i));
+    QCOMPARE(int(small.end() - small.begin()), str.size());
+    if (!str.isEmpty())
+        QVERIFY(small.constData() != str.constData());
+}
+
+void tst_QSmallString::constructFromString()
+{
+    const QString shortString = QStringLiteral("key");
+    const QSmallString shortSmall(shortString);
+    QVERIFY(shortSmall.isInline());
+    QCOMPARE(shortSmall, shortString);
+
+    // long strings are shared, in both directions
+    const QString longString = QString::fromLatin1("a string that does not fit inline");
+    const QSmallString longSmall(longString);
+    QVERIFY(!longSmall.isInline());
+    QCOMPARE(longSmall.constData(), longString.constData());
+    QCOMPARE(longSmall.toString().constData(), longString.constData());
+}
+
+void tst_QSmallString::fromUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+
+    QTest::newRow("null") << QByteArray();
+    QTest::newRow("ascii") << QByteArray("hello");
+    QTest::newRow("latin1") << QByteArray("gr\xc3\xbc\xc3\x9f" "e");
+    QTest::newRow("cjk-inline") << QByteArray("\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xa7\xe3\x81\x99");
+    QTest::newRow("supplementary") << QByteArray("\xf0\x9f\x98\x80 \xf0\x9f\x98\x81");
+    QTest::newRow("cjk-long") << QByteArray("\xe6\x97\xa5\xe6\x9c\xac").repeated(10);
+    QTest::newRow("ascii-long") << QByteArray("abcdefghij").repeated(10);
+    QTest::newRow("invalid") << QByteArray("ab\xff\xfe" "cd");
+}
+
+void tst_QSmallString::fromUtf8()
+{
+    QFETCH(QByteArray, utf8);
+
+    const QString expected = QString::fromUtf8(utf8);
+    const QSmallString small = QSmallString::fromUtf8(utf8);
+    QCOMPARE(small.toString(), expected);
+    QCOMPARE(small.isInline(), expected.size() <= int(QSmallString::InlineCapacity));
+    QCOMPARE(QSmallString::fromUtf8(utf8.constData()).toString(), expected);
+}
+
+void tst_QSmallString::fromLatin1()
+{
+    QCOMPARE(QSmallString::fromLatin1("gr\xfc\xdf" "e").toString(), QString::fromLatin1("gr\xfc\xdf" "e"));
+    QCOMPARE(QSmallString::fromLatin1("abcdef", 3).toString(), QString::fromLatin1("abc"));
+    QVERIFY(QSmallString::fromLatin1(0).isEmpty());
+    const QSmallString small(QLatin1String("a Latin-1 string that does not fit inline"));
+    QVERIFY(!small.isInline());
+    QCOMPARE(small, QLatin1String("a Latin-1 string that does not fit inline"));
+}
+
+void tst_QSmallString::copyAndMove()
+{
+    const QString longString = QString::fromLatin1("a string that does not fit inline");
+    QSmallString a(QStringLiteral("short"));
+    QSmallString b(longString);
+
+    QSmallString c = a;
+    QSmallString d = b;
+    QCOMPARE(c, a);
+    QCOMPARE(d, b);
+    QCOMPARE(d.constData(), b.constData());
+
+    c = d;
+    QCOMPARE(c, longString);
+    d = a;
+    QCOMPARE(d, QLatin1String("short"));
+
+    c.swap(d);
+    QCOMPARE(c, QLatin1String("short"));
+    QCOMPARE(d, longString);
+
+    QSmallString moved(std::move(d));
+    QCOMPARE(moved, longString);
+    QVERIFY(d.isEmpty());
+    d = std::move(c);
+    QCOMPARE(d, QLatin1String("short"));
+
+    b = QSmallString();
+    QVERIFY(b.isEmpty());
+    QVERIFY(b.isInline());
+}
+
+void tst_QSmallString::compare()
+{
+    const QSmallString a(QStringLiteral("apple"));
+    const QSmallString b(QStringLiteral("banana"));
+    const QSmallString c(QString::fromLatin1("a string that does not fit inline"));
+
+    QVERIFY(a == a);
+    QVERIFY(a != b);
+    QVERIFY(a < b);
+    QVERIFY(a <= b);
+    QVERIFY(b > a);
+    QVERIFY(b >= a);
+    QVERIFY(c < b);
+    QVERIFY(a == QStringLiteral("apple"));
+    QVERIFY(QStringLiteral("banana") == b);
+    QVERIFY(a != QLatin1String("Apple"));
+    QCOMPARE(a.compare(QStringLiteral("APPLE"), Qt::CaseInsensitive), 0);
+    QVERIFY(a.compare(QStringLiteral("APPLE")) > 0);
+}
+
+void tst_QSmallString::hash()
+{
+    const QString str = QStringLiteral("hello");
+    const QString longStr = QString::fromLatin1("a string that does not fit inline");
+    QCOMPARE(qHash(QSmallString(str)), qHash(str));
+    QCOMPARE(qHash(QSmallString(longStr), 42), qHash(longStr, 42));
+
+    QHash<QSmallString, int> hash;
+    hash.insert(QSmallString(str), 1);
+    hash.insert(QSmallString(longStr), 2);
+    QCOMPARE(hash.value(QSmallString(QStringLiteral("hello"))), 1);
+    QCOMPARE(hash.value(QSmallString(longStr)), 2);
+}
+
+void tst_QSmallString::stringBuilder()
+{
+    const QSmallString a(QStringLiteral("key"));
+    const QSmallString b(QString::fromLatin1("a string that does not fit inline"));
+    const QString result = a % QLatin1Char('=') % b;
+    QCOMPARE(result, QString::fromLatin1("key=a string that does not fit inline"));
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+#include "tst_qsmallstring.moc"
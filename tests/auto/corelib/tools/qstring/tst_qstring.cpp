@@ -50,6 +50,7 @@
 #include <qlocale.h>
 #include <locale.h>
 #include <qhash.h>
+#include <private/qstringalgorithms_p.h>
 
 #include <string>
 #include <algorithm>
@@ -453,6 +454,8 @@ private slots:
     void toUpper();
     void toLower();
     void toCaseFolded();
+    void asciiCaseConversion();
+    void caseFoldedHash();
     void rightJustified();
     void leftJustified();
     void mid();
@@ -520,6 +523,7 @@ private slots:
     void number();
     void arg_fillChar_data();
     void arg_fillChar();
+    void variadicArg();
     void capacity_data();
     void capacity();
     void section_data();
@@ -2371,6 +2375,66 @@ void tst_QString::toCaseFolded()
     }
 }
 
+void tst_QString::asciiCaseConversion()
+{
+    // long enough for the vectorized code paths, with the mismatch and the
+    // non-ASCII character at every position relative to the block size
+    const QString lower = QStringLiteral("content-type: text/html; charset=utf-8");
+    const QString upper = QStringLiteral("CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8");
+    QCOMPARE(upper.toLower(), lower);
+    QCOMPARE(lower.toUpper(), upper);
+    QCOMPARE(upper.toCaseFolded(), lower);
+    QCOMPARE(QString(upper).toLower(), lower);
+    QCOMPARE(lower.compare(upper, Qt::CaseInsensitive), 0);
+    QCOMPARE(lower.compare(QLatin1String("CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8"), Qt::CaseInsensitive), 0);
+    QVERIFY(lower.startsWith(QStringLiteral("CONTENT-TYPE: TEXT"), Qt::CaseInsensitive));
+    QVERIFY(lower.endsWith(QLatin1String("HTML; CHARSET=UTF-8"), Qt::CaseInsensitive));
+    QCOMPARE(lower.indexOf(QStringLiteral("CHARSET"), 0, Qt::CaseInsensitive), 25);
+
+    for (int i = 0; i < upper.size(); ++i) {
+        QString mixed = upper;
+        mixed[i] = QChar(0xc4);     // LATIN CAPITAL LETTER A WITH DIAERESIS
+        QString expected = lower;
+        expected[i] = QChar(0xe4);
+        QCOMPARE(mixed.toLower(), expected);
+        QCOMPARE(expected.toUpper(), mixed);
+        QCOMPARE(mixed.compare(expected, Qt::CaseInsensitive), 0);
+        QCOMPARE(expected.compare(QLatin1String(mixed.toLatin1()), Qt::CaseInsensitive), 0);
+
+        QString different = lower;
+        different[i] = QLatin1Char('~');
+        QVERIFY(different.compare(upper, Qt::CaseInsensitive) != 0);
+        QVERIFY(upper.compare(different, Qt::CaseInsensitive) != 0);
+        QVERIFY(upper.compare(QLatin1String(different.toLatin1()), Qt::CaseInsensitive) != 0);
+    }
+
+    // a surrogate pair straddling the blocks of eight
+    QString deseretUpper = QStringLiteral("abcdefg");
+    deseretUpper += QChar(QChar::highSurrogate(0x10400));
+    deseretUpper += QChar(QChar::lowSurrogate(0x10400));
+    QString deseretLower = QStringLiteral("ABCDEFG");
+    deseretLower += QChar(QChar::highSurrogate(0x10428));
+    deseretLower += QChar(QChar::lowSurrogate(0x10428));
+    QCOMPARE(deseretUpper.compare(deseretLower, Qt::CaseInsensitive), 0);
+}
+
+void tst_QString::caseFoldedHash()
+{
+    const uint seed = 0x1234;
+    QCOMPARE(QtPrivate::qHashCaseFolded(QLatin1String(), seed), qHash(QString(), seed));
+    QCOMPARE(QtPrivate::qHashCaseFolded(QLatin1String("Content-Length"), seed),
+             QtPrivate::qHashCaseFolded(QLatin1String("content-length"), seed));
+    QCOMPARE(QtPrivate::qHashCaseFolded(QLatin1String("CONTENT-LENGTH"), seed),
+             qHash(QStringLiteral("content-length"), seed));
+
+    QByteArray all(256, Qt::Uninitialized);
+    for (int i = 0; i < 256; ++i)
+        all[i] = char(i);
+    const QLatin1String latin1(all.constData(), all.size());
+    QCOMPARE(QtPrivate::qHashCaseFolded(latin1, seed), qHash(QString(latin1).toCaseFolded(), seed));
+    QCOMPARE(QtPrivate::qHashCaseFolded(latin1), qHash(QString(latin1).toCaseFolded()));
+}
+
 void tst_QString::trimmed()
 {
     QString a;
@@ -6479,6 +6543,47 @@ void tst_QString::compareRef()
     QVERIFY(QStringRef(&a2, 1, 2).compare(QStringRef(&a, 1, 3), Qt::CaseInsensitive) < 0);
 }
 
+void tst_QString::variadicArg()
+{
+    const QString s = QStringLiteral("abc");
+    const QChar c = QLatin1Char('x');
+
+    QCOMPARE(QString("%1 %2 %3").arg(s, QLatin1String("def"), QStringView(s)),
+             QString("abc def abc"));
+    QCOMPARE(QString("%1-%2").arg(s, c), QString("abc-x"));
+    QCOMPARE(QString("%1 %2").arg(s.midRef(1), QLatin1String("!")), QString("bc !"));
+
+    // numbers
+    QCOMPARE(QString("%1, %2, %3").arg(42, -7, s), QString("42, -7, abc"));
+    QCOMPARE(QString("%1|%2|%3").arg(std::numeric_limits<qlonglong>::min(),
+                                      std::numeric_limits<qulonglong>::max(), s),
+             QString("-9223372036854775808|18446744073709551615|abc"));
+    QCOMPARE(QString("%1 %2 %3").arg(short(-1), ushort(2), 0u), QString("-1 2 0"));
+    QCOMPARE(QString("%1 %2 %3").arg(long(-3), ulong(4), s), QString("-3 4 abc"));
+    QCOMPARE(QString("%1 %2").arg(s, 1.5), QString("abc 1.5"));
+    QCOMPARE(QString("%1 %2 %3").arg(0.1f, 1e20, s), QString("0.1 1e+20 abc"));
+
+    // same numbering rules as the multi-QString overloads
+    QCOMPARE(QString("%3 %1 %2 %1").arg(s, c, 1), QString("1 abc x abc"));
+    QCOMPARE(QString("%1 %5 %9").arg(s, c), QString("abc x %9"));
+    QCOMPARE(QString("%1%1%2").arg(QLatin1String(""), 100, s), QString("100"));
+    QCOMPARE(QString("%%1 %L2 %x %").arg(s, QLatin1String("def")), QString("%abc def %x %"));
+    QTest::ignoreMessage(QtWarningMsg, "QString::arg: 1 argument(s) missing in %1 %2");
+    QCOMPARE(QString("%1 %2").arg(s, c, 3), QString("abc x"));
+
+    // %L formats numbers according to the default locale, and leaves strings alone
+    QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedKingdom));
+    QCOMPARE(QString("%1 %L1 %L2 %3 %L3").arg(123456, 1234.56, QLatin1String("1,0")),
+             QString("123456 123,456 1,234.56 1,0 1,0"));
+    QLocale::setDefault(QLocale::C);
+    QCOMPARE(QString("%L1 %L2").arg(123456, s), QString("123456 abc"));
+
+    // the existing overloads keep their meaning
+    QCOMPARE(QString("%1").arg(s, 5), QString("  abc"));
+    QCOMPARE(QString("%1").arg(s, 5, c), QString("xxabc"));
+    QCOMPARE(QString("%1").arg(10, 4, 16), QString("   a"));
+}
+
 void tst_QString::arg_locale()
 {
     QLocale l(QLocale::English, QLocale::UnitedKingdom);
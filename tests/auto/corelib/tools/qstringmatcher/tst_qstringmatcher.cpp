@@ -41,6 +41,7 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void needleLengths();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -142,6 +143,35 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+void tst_QStringMatcher::needleLengths()
+{
+    // covers needles shorter and longer than the vectorized search handles,
+    // and near misses where only the first and the last character match
+    QString haystack;
+    for (int i = 0; i < 200; ++i)
+        haystack += QChar(i % 3 ? 'a' + i % 7 : 0x3b1 + i % 5);
+
+    for (int length = 1; length <= 24; ++length) {
+        for (int start = 0; start + length <= haystack.size(); start += 11) {
+            QString needle = haystack.mid(start, length);
+            for (int from = 0; from < 40; from += 9) {
+                int expected = -1;
+                for (int i = from; i <= haystack.size() - length; ++i) {
+                    if (haystack.midRef(i, length) == needle) {
+                        expected = i;
+                        break;
+                    }
+                }
+                QCOMPARE(QStringMatcher(needle).indexIn(haystack, from), expected);
+            }
+            if (length > 2) {
+                needle[length / 2] = QLatin1Char('x');
+                QCOMPARE(QStringMatcher(needle).indexIn(haystack), -1);
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
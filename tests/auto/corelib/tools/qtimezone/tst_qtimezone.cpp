@@ -48,6 +48,7 @@ private slots:
     void transitionEachZone_data();
     void transitionEachZone();
     void stressTest();
+    void offsetsFromUtc();
     void windowsId();
     void isValidId_data();
     void isValidId();
@@ -446,6 +447,45 @@ void tst_QTimeZone::transitionEachZone()
     }
 }
 
+void tst_QTimeZone::offsetsFromUtc()
+{
+    const QByteArrayList zones = QByteArrayList() << "Europe/Berlin" << "America/New_York"
+                                                  << "Australia/Sydney" << "UTC" << "Nowhere/Special";
+    // 1900 to 2100 in uneven steps, crossing many transitions, then the same backwards
+    QVector<qint64> times;
+    for (qint64 msecs = -2208988800000LL; msecs < 4102444800000LL; msecs += 561599999LL)
+        times << msecs;
+    const int forward = times.size();
+    for (int i = forward - 1; i >= 0; --i)
+        times << times.at(i);
+
+    for (const QByteArray &id : zones) {
+        const QTimeZone zone(id);
+        QVector<int> offsets(times.size());
+        zone.offsetsFromUtc(times.constData(), offsets.data(), times.size());
+        for (int i = 0; i < times.size(); ++i) {
+            const QDateTime when = QDateTime::fromMSecsSinceEpoch(times.at(i), Qt::UTC);
+            QCOMPARE(offsets.at(i), zone.offsetFromUtc(when));
+            if (i < forward)
+                QCOMPARE(offsets.at(i), offsets.at(times.size() - 1 - i));
+        }
+    }
+
+    const QTimeZone berlin("Europe/Berlin");
+    const qint64 when[] = {
+        QDateTime(QDate(2010, 1, 1), QTime(12, 0), Qt::UTC).toMSecsSinceEpoch(),
+        QDateTime(QDate(2010, 7, 1), QTime(12, 0), Qt::UTC).toMSecsSinceEpoch(),
+        QDateTime(QDate(2060, 1, 1), QTime(12, 0), Qt::UTC).toMSecsSinceEpoch(),
+        QDateTime(QDate(2060, 7, 1), QTime(12, 0), Qt::UTC).toMSecsSinceEpoch()
+    };
+    int offsets[4];
+    berlin.offsetsFromUtc(when, offsets, 4);
+    QCOMPARE(offsets[0], 3600);
+    QCOMPARE(offsets[1], 7200);
+    QCOMPARE(offsets[2], 3600);
+    QCOMPARE(offsets[3], 7200);
+}
+
 void tst_QTimeZone::availableTimeZoneIds()
 {
     if (debug) {
@@ -3,6 +3,7 @@ SUBDIRS=\
     collections \
     containerapisymmetry \
     qalgorithms \
+    qarenaallocator \
     qarraydata \
     qarraydata_strictiterators \
     qbitarray \
@@ -14,12 +15,14 @@ SUBDIRS=\
     qchar \
     qcollator \
     qcommandlineparser \
+    qconcurrentcache \
     qcontiguouscache \
     qcryptographichash \
     qdate \
     qdatetime \
     qeasingcurve \
     qexplicitlyshareddatapointer \
+    qflathash \
     qfreelist \
     qhash \
     qhash_strictiterators \
@@ -46,6 +49,7 @@ SUBDIRS=\
     qscopedvaluerollback \
     qset \
     qsharedpointer \
+    qsmallstring \
     qsize \
     qsizef \
     qstl \
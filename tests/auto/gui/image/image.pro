@@ -5,6 +5,8 @@ SUBDIRS=\
    qpixmap \
    qpixmapcache \
    qimage \
+   qimagecache \
+   qsharedimagecache \
    qimageiohandler \
    qimagewriter \
    qmovie \
@@ -120,6 +120,11 @@ private slots:
 
     void smoothScaleBig();
     void smoothScaleAlpha();
+    void smoothScaleThreaded_data();
+    void smoothScaleThreaded();
+
+    void convertToFormatThreaded_data();
+    void convertToFormatThreaded();
 
     void transformed_data();
     void transformed();
@@ -199,6 +204,8 @@ private slots:
     void rgb30Unpremul();
     void rgb30Repremul_data();
     void rgb30Repremul();
+    void rgb30ToArgb32_data();
+    void rgb30ToArgb32();
 
     void metadataPassthrough();
 
@@ -1879,6 +1886,138 @@ void tst_QImage::smoothScaleAlpha()
     QCOMPARE(dst, expected);
 }
 
+void tst_QImage::smoothScaleThreaded_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<QSize>("size");
+
+    QTest::newRow("argb32pm down") << QImage::Format_ARGB32_Premultiplied << QSize(300, 200);
+    QTest::newRow("argb32pm up") << QImage::Format_ARGB32_Premultiplied << QSize(2000, 1500);
+    QTest::newRow("argb32pm down x up y") << QImage::Format_ARGB32_Premultiplied << QSize(500, 1500);
+    QTest::newRow("argb32pm up x down y") << QImage::Format_ARGB32_Premultiplied << QSize(2000, 300);
+    QTest::newRow("rgb32 down") << QImage::Format_RGB32 << QSize(300, 200);
+    QTest::newRow("rgb32 down x up y") << QImage::Format_RGB32 << QSize(500, 1500);
+    QTest::newRow("rgb32 up x down y") << QImage::Format_RGB32 << QSize(2000, 300);
+}
+
+class BlockingRunnable : public QRunnable
+{
+public:
+    QSemaphore started;
+    QSemaphore finish;
+
+    void run() override
+    {
+        started.release();
+        finish.acquire();
+    }
+};
+
+void tst_QImage::smoothScaleThreaded()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(QSize, size);
+
+    QImage src(1200, 900, format);
+    for (int y = 0; y < src.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(src.scanLine(y));
+        for (int x = 0; x < src.width(); ++x)
+            line[x] = qPremultiply(qRgba(x * 7, y * 13, x ^ y, (x + y) | 0x80));
+    }
+    if (format == QImage::Format_RGB32)
+        src = src.convertToFormat(format);
+
+    // large enough to be scaled in bands on several threads
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(4);
+    const QImage threaded = src.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    // with the only pool thread busy, the calling thread scales all bands
+    pool->setMaxThreadCount(1);
+    BlockingRunnable blocker;
+    blocker.setAutoDelete(false);
+    pool->start(&blocker);
+    blocker.started.acquire();
+
+    const QImage single = src.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    blocker.finish.release();
+    pool->waitForDone();
+    pool->setMaxThreadCount(maxThreadCount);
+
+    QCOMPARE(threaded.size(), size);
+    QCOMPARE(threaded, single);
+}
+
+void tst_QImage::convertToFormatThreaded_data()
+{
+    QTest::addColumn<QImage::Format>("srcFormat");
+    QTest::addColumn<QImage::Format>("destFormat");
+    QTest::addColumn<int>("flags");
+    QTest::addColumn<bool>("inplace");
+
+    const int autoColor = int(Qt::AutoColor);
+    const int orderedDither = int(Qt::PreferDither | Qt::OrderedDither);
+
+    QTest::newRow("argb32 -> argb32pm") << QImage::Format_ARGB32 << QImage::Format_ARGB32_Premultiplied << autoColor << false;
+    QTest::newRow("rgba8888 -> rgba8888pm") << QImage::Format_RGBA8888 << QImage::Format_RGBA8888_Premultiplied << autoColor << false;
+    QTest::newRow("rgb888 -> rgb32") << QImage::Format_RGB888 << QImage::Format_RGB32 << autoColor << false;
+    QTest::newRow("rgb888 -> rgbx8888") << QImage::Format_RGB888 << QImage::Format_RGBX8888 << autoColor << false;
+    QTest::newRow("argb32pm -> rgb16") << QImage::Format_ARGB32_Premultiplied << QImage::Format_RGB16 << autoColor << false;
+    QTest::newRow("argb32 -> rgb444 dithered") << QImage::Format_ARGB32 << QImage::Format_RGB444 << orderedDither << false;
+    QTest::newRow("argb32 -> argb32pm inplace") << QImage::Format_ARGB32 << QImage::Format_ARGB32_Premultiplied << autoColor << true;
+    QTest::newRow("argb32pm -> rgba8888pm inplace") << QImage::Format_ARGB32_Premultiplied << QImage::Format_RGBA8888_Premultiplied << autoColor << true;
+    QTest::newRow("rgb16 -> rgb444 inplace dithered") << QImage::Format_RGB16 << QImage::Format_RGB444 << orderedDither << true;
+}
+
+void tst_QImage::convertToFormatThreaded()
+{
+    QFETCH(QImage::Format, srcFormat);
+    QFETCH(QImage::Format, destFormat);
+    QFETCH(int, flags);
+    QFETCH(bool, inplace);
+
+    // large enough to be converted in bands on several threads
+    QImage src(1000, 700, QImage::Format_ARGB32);
+    for (int y = 0; y < src.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(src.scanLine(y));
+        for (int x = 0; x < src.width(); ++x)
+            line[x] = qRgba(x * 7, y * 13, x ^ y, (x + y) | 0x40);
+    }
+    src = src.convertToFormat(srcFormat);
+
+    const Qt::ImageConversionFlags conversionFlags(flags);
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(4);
+    QImage threaded = src.copy();
+    if (inplace)
+        threaded = std::move(threaded).convertToFormat(destFormat, conversionFlags);
+    else
+        threaded = threaded.convertToFormat(destFormat, conversionFlags);
+
+    // with the only pool thread busy, the calling thread converts all bands
+    pool->setMaxThreadCount(1);
+    BlockingRunnable blocker;
+    blocker.setAutoDelete(false);
+    pool->start(&blocker);
+    blocker.started.acquire();
+
+    QImage single = src.copy();
+    if (inplace)
+        single = std::move(single).convertToFormat(destFormat, conversionFlags);
+    else
+        single = single.convertToFormat(destFormat, conversionFlags);
+
+    blocker.finish.release();
+    pool->waitForDone();
+    pool->setMaxThreadCount(maxThreadCount);
+
+    QCOMPARE(threaded.format(), destFormat);
+    QCOMPARE(threaded, single);
+}
+
 static int count(const QImage &img, int x, int y, int dx, int dy, QRgb pixel)
 {
     int i = 0;
@@ -3167,6 +3306,57 @@ void tst_QImage::rgb30Repremul()
     QVERIFY(qAbs(qRed(newColor) - qRed(expectedColor)) <= 1);
 }
 
+void tst_QImage::rgb30ToArgb32_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+
+    QTest::newRow("RGB30") << QImage::Format_RGB30;
+    QTest::newRow("A2RGB30pm") << QImage::Format_A2RGB30_Premultiplied;
+    QTest::newRow("BGR30") << QImage::Format_BGR30;
+    QTest::newRow("A2BGR30pm") << QImage::Format_A2BGR30_Premultiplied;
+}
+
+void tst_QImage::rgb30ToArgb32()
+{
+    QFETCH(QImage::Format, format);
+
+    // odd width to cover both the vectorized and the scalar pixels of each line
+    QImage a(37, 5, format);
+    uint seed = 0x12345678;
+    for (int y = 0; y < a.height(); ++y) {
+        uint *line = reinterpret_cast<uint *>(a.scanLine(y));
+        for (int x = 0; x < a.width(); ++x) {
+            seed = seed * 1103515245 + 12345;
+            uint alpha = seed >> 30;
+            uint peak = alpha * 0x155;
+            if (format == QImage::Format_RGB30 || format == QImage::Format_BGR30) {
+                alpha = 3;
+                peak = 0x3ff;
+            }
+            const uint r = ((seed >> 4) & 0x3ff) * peak / 0x3ff;
+            const uint g = ((seed >> 8) & 0x3ff) * peak / 0x3ff;
+            const uint b = ((seed >> 14) & 0x3ff) * peak / 0x3ff;
+            line[x] = (alpha << 30) | (r << 20) | (g << 10) | b;
+        }
+    }
+
+    const bool bgr = format == QImage::Format_BGR30 || format == QImage::Format_A2BGR30_Premultiplied;
+    const QImage b = a.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < a.height(); ++y) {
+        const uint *src = reinterpret_cast<const uint *>(a.constScanLine(y));
+        const QRgb *dst = reinterpret_cast<const QRgb *>(b.constScanLine(y));
+        for (int x = 0; x < a.width(); ++x) {
+            const uint c = src[x];
+            uint red = (c >> 22) & 0xff;
+            uint blue = (c >> 2) & 0xff;
+            if (bgr)
+                qSwap(red, blue);
+            const QRgb expected = qRgba(red, (c >> 12) & 0xff, blue, (c >> 30) * 0x55);
+            QCOMPARE(dst[x], expected);
+        }
+    }
+}
+
 void tst_QImage::metadataPassthrough()
 {
     QImage a(64, 64, QImage::Format_ARGB32);
@@ -0,0 +1,207 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtGui/QImageCache>
+#include <QtCore/QThreadPool>
+
+class tst_QImageCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndFind();
+    void replace();
+    void rejectsNullAndOversized();
+    void leastRecentlyUsedIsRemoved();
+    void setCacheLimit();
+    void statistics();
+    void clear();
+    void concurrentAccess();
+};
+
+static QImage image(int size, QRgb color)
+{
+    QImage img(size, size, QImage::Format_ARGB32);
+    img.fill(color);
+    return img;
+}
+
+void tst_QImageCache::insertAndFind()
+{
+    QImageCache cache;
+    const QImage red = image(16, 0xffff0000);
+    QVERIFY(cache.insert("red", red));
+    QVERIFY(cache.contains("red"));
+    QCOMPARE(cache.count(), 1);
+    QCOMPARE(cache.totalUsed(), red.sizeInBytes());
+
+    QImage found;
+    QVERIFY(cache.find("red", &found));
+    QCOMPARE(found, red);
+    QCOMPARE(cache.find("red"), red);
+    QVERIFY(!cache.find("blue", &found));
+    QVERIFY(cache.find("blue").isNull());
+
+    QVERIFY(cache.remove("red"));
+    QVERIFY(!cache.remove("red"));
+    QCOMPARE(cache.count(), 0);
+    QCOMPARE(cache.totalUsed(), qint64(0));
+}
+
+void tst_QImageCache::replace()
+{
+    QImageCache cache;
+    QVERIFY(cache.insert("key", image(16, 0xffff0000)));
+    const QImage green = image(32, 0xff00ff00);
+    QVERIFY(cache.insert("key", green));
+    QCOMPARE(cache.count(), 1);
+    QCOMPARE(cache.find("key"), green);
+    QCOMPARE(cache.totalUsed(), green.sizeInBytes());
+}
+
+void tst_QImageCache::rejectsNullAndOversized()
+{
+    QImageCache cache(4);
+    QVERIFY(!cache.insert("null", QImage()));
+    QVERIFY(!cache.insert("big", image(64, 0xff000000)));   // 16 KB
+    QVERIFY(cache.insert("small", image(16, 0xff000000)));  // 1 KB
+    QCOMPARE(cache.count(), 1);
+}
+
+void tst_QImageCache::leastRecentlyUsedIsRemoved()
+{
+    // room for four 1 KB images
+    QImageCache cache(4);
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(cache.insert(QString::number(i), image(16, 0xff000000 | i)));
+    QCOMPARE(cache.count(), 4);
+
+    // Using "0" makes "1" the least recently used image
+    QVERIFY(cache.find("0", nullptr));
+    QVERIFY(cache.insert("4", image(16, 0xff0000ff)));
+    QCOMPARE(cache.count(), 4);
+    QVERIFY(cache.contains("0"));
+    QVERIFY(!cache.contains("1"));
+    QVERIFY(cache.contains("2"));
+    QVERIFY(cache.contains("4"));
+
+    // contains() does not count as a use
+    QVERIFY(cache.contains("2"));
+    QVERIFY(cache.insert("5", image(16, 0xff0000ff)));
+    QVERIFY(!cache.contains("2"));
+    QVERIFY(cache.totalUsed() <= 4 * 1024);
+}
+
+void tst_QImageCache::setCacheLimit()
+{
+    QImageCache cache;
+    QCOMPARE(cache.cacheLimit(), 10240);
+    for (int i = 0; i < 8; ++i)
+        QVERIFY(cache.insert(QString::number(i), image(16, 0xff000000)));
+    cache.setCacheLimit(3);
+    QCOMPARE(cache.cacheLimit(), 3);
+    QCOMPARE(cache.count(), 3);
+    for (int i = 5; i < 8; ++i)
+        QVERIFY(cache.contains(QString::number(i)));
+}
+
+void tst_QImageCache::statistics()
+{
+    QImageCache cache;
+    cache.insert("a", image(8, 0xff000000));
+    cache.find("a");
+    cache.find("a");
+    cache.find("b");
+    QCOMPARE(cache.hitCount(), qint64(2));
+    QCOMPARE(cache.missCount(), qint64(1));
+    cache.clear();
+    QCOMPARE(cache.hitCount(), qint64(2));
+    cache.resetStatistics();
+    QCOMPARE(cache.hitCount(), qint64(0));
+    QCOMPARE(cache.missCount(), qint64(0));
+}
+
+void tst_QImageCache::clear()
+{
+    QImageCache cache;
+    for (int i = 0; i < 100; ++i)
+        cache.insert(QString::number(i), image(8, 0xff000000));
+    QCOMPARE(cache.count(), 100);
+    cache.clear();
+    QCOMPARE(cache.count(), 0);
+    QCOMPARE(cache.totalUsed(), qint64(0));
+    QVERIFY(QImageCache::globalInstance());
+    QCOMPARE(QImageCache::globalInstance(), QImageCache::globalInstance());
+}
+
+class CacheUser : public QRunnable
+{
+public:
+    CacheUser(QImageCache *cache, int id) : cache(cache), id(id) {}
+    void run() override
+    {
+        for (int i = 0; i < 2000; ++i) {
+            const QString key = QString::number((i * 7 + id) % 300);
+            QImage found;
+            if (cache->find(key, &found)) {
+                // each key always maps to the same contents
+                if (found.pixel(0, 0) != (0xff000000 | uint(key.toInt())))
+                    failed.store(1);
+            } else {
+                cache->insert(key, image(16, 0xff000000 | uint(key.toInt())));
+            }
+            if (i % 100 == 0)
+                cache->remove(QString::number(i % 300));
+        }
+    }
+
+    QImageCache *cache;
+    int id;
+    static QAtomicInt failed;
+};
+
+QAtomicInt CacheUser::failed;
+
+void tst_QImageCache::concurrentAccess()
+{
+    QImageCache cache(64);
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+    for (int i = 0; i < 8; ++i)
+        pool.start(new CacheUser(&cache, i));
+    pool.waitForDone();
+    QCOMPARE(CacheUser::failed.load(), 0);
+    QVERIFY(cache.totalUsed() <= 64 * 1024);
+    QCOMPARE(cache.totalUsed(), qint64(cache.count()) * image(16, 0).sizeInBytes());
+    QCOMPARE(cache.hitCount() + cache.missCount(), qint64(8 * 2000));
+}
+
+QTEST_MAIN(tst_QImageCache)
+#include "tst_qimagecache.moc"
@@ -130,6 +130,11 @@ private slots:
 
     void gifHandlerBugs();
     void animatedGif();
+    void readAsync_data();
+    void readAsync();
+    void readAsyncAnimation();
+    void readAsyncError();
+    void readAsyncCancel();
     void gifImageCount();
     void gifLoopCount();
 
@@ -421,6 +426,11 @@ void tst_QImageReader::setClipRect_data()
     QTest::newRow("XBM: gnus") << "gnus" << QRect(0, 0, 50, 50) << QByteArray("xbm");
 
     QTest::newRow("JPEG: beavis") << "beavis" << QRect(0, 0, 50, 50) << QByteArray("jpeg");
+    QTest::newRow("JPEG: beavis offset") << "beavis" << QRect(37, 101, 77, 45) << QByteArray("jpeg");
+    QTest::newRow("JPEG: txts offset") << "txts" << QRect(17, 9, 40, 33) << QByteArray("jpeg");
+    QTest::newRow("JPEG: txts right edge") << "txts" << QRect(48, 20, 43, 49) << QByteArray("jpeg");
+    QTest::newRow("JPEG: qtbug13653-no_eoi offset") << "qtbug13653-no_eoi" << QRect(32, 48, 100, 60) << QByteArray("jpeg");
+    QTest::newRow("JPEG: YCbCr_cmyk offset") << "YCbCr_cmyk" << QRect(10, 5, 30, 20) << QByteArray("jpeg");
 
     QTest::newRow("GIF: earth") << "earth" << QRect(0, 0, 50, 50) << QByteArray("gif");
     QTest::newRow("GIF: trolltech") << "trolltech" << QRect(0, 0, 50, 50) << QByteArray("gif");
@@ -807,6 +817,103 @@ void tst_QImageReader::animatedGif()
     }
 }
 
+void tst_QImageReader::readAsync_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QByteArray>("format");
+
+    QTest::newRow("BMP: colorful") << "colorful.bmp" << QByteArray("bmp");
+    QTest::newRow("PNG: kollada") << "kollada.png" << QByteArray("png");
+    QTest::newRow("JPEG: beavis") << "beavis.jpg" << QByteArray("jpeg");
+    QTest::newRow("XPM: marble") << "marble.xpm" << QByteArray("xpm");
+}
+
+void tst_QImageReader::readAsync()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QByteArray, format);
+
+    SKIP_IF_UNSUPPORTED(format);
+
+    QImageReader reader(prefix + fileName);
+    reader.setScaledSize(QSize(40, 30));
+    QFuture<QImage> future = reader.readAsync();
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), 1);
+
+    QImageReader syncReader(prefix + fileName);
+    syncReader.setScaledSize(QSize(40, 30));
+    const QImage expected = syncReader.read();
+    QVERIFY(!expected.isNull());
+    QCOMPARE(future.result(), expected);
+
+    // the reader can be used again afterwards
+    reader.setFileName(prefix + fileName);
+    QCOMPARE(reader.read(), expected);
+}
+
+void tst_QImageReader::readAsyncAnimation()
+{
+    SKIP_IF_UNSUPPORTED("gif");
+
+    QImageReader reader(":images/qt.gif");
+    QFuture<QImage> future = reader.readAsync();
+    future.waitForFinished();
+
+    const QList<QImage> frames = future.results();
+    QImageReader syncReader(":images/qt.gif");
+    int i = 0;
+    for (QImage frame = syncReader.read(); !frame.isNull(); frame = syncReader.read()) {
+        QVERIFY(i < frames.size());
+        QCOMPARE(frames.at(i++), frame);
+    }
+    QCOMPARE(i, frames.size());
+    QVERIFY(i > 1);
+}
+
+void tst_QImageReader::readAsyncError()
+{
+    QImageReader reader(prefix + "corrupt.png");
+    QFuture<QImage> future = reader.readAsync();
+    QVERIFY(future.result().isNull());
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), 1);
+    QCOMPARE(reader.error(), QImageReader::InvalidDataError);
+}
+
+void tst_QImageReader::readAsyncCancel()
+{
+    SKIP_IF_UNSUPPORTED("gif");
+
+    // A blocked pool keeps the read from starting before it is canceled
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    QSemaphore block;
+    struct Blocker : public QRunnable
+    {
+        explicit Blocker(QSemaphore *semaphore) : semaphore(semaphore) {}
+        void run() override { semaphore->acquire(); }
+        QSemaphore *semaphore;
+    };
+    pool.start(new Blocker(&block));
+
+    QImageReader reader(":images/qt.gif");
+    QFuture<QImage> future = reader.readAsync(&pool);
+    QTest::ignoreMessage(QtWarningMsg, "QImageReader::readAsync: An asynchronous read is already in progress");
+    QVERIFY(reader.readAsync(&pool).isCanceled());
+    future.cancel();
+    block.release();
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), 0);
+
+    // Destroying the reader waits for a running read
+    {
+        QImageReader other(":images/qt.gif");
+        future = other.readAsync();
+    }
+    QVERIFY(future.isFinished());
+}
+
 // QTBUG-6696
 // Check the count of images in various call orders...
 void tst_QImageReader::gifImageCount()
@@ -80,6 +80,9 @@ private slots:
 
     void writeEmpty();
 
+    void pngSubTypes_data();
+    void pngSubTypes();
+
 private:
     QTemporaryDir m_temporaryDir;
     QString prefix;
@@ -409,7 +412,9 @@ void tst_QImageWriter::supportsOption_data()
                               << QImageIOHandler::Description
                               << QImageIOHandler::Quality
                               << QImageIOHandler::Size
-                              << QImageIOHandler::ScaledSize);
+                              << QImageIOHandler::ScaledSize
+                              << QImageIOHandler::SubType
+                              << QImageIOHandler::SupportedSubTypes);
 }
 
 void tst_QImageWriter::supportsOption()
@@ -545,5 +550,56 @@ void tst_QImageWriter::writeEmpty()
     QVERIFY(!QFileInfo(fileName).exists());
 }
 
+void tst_QImageWriter::pngSubTypes_data()
+{
+    QTest::addColumn<QByteArray>("subType");
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<int>("quality");
+
+    const QList<QByteArray> subTypes = QList<QByteArray>() << QByteArray() << "none" << "sub"
+                                                           << "up" << "average" << "paeth"
+                                                           << "adaptive";
+    const QImage::Format formats[] = { QImage::Format_RGB32, QImage::Format_ARGB32,
+                                       QImage::Format_ARGB32_Premultiplied,
+                                       QImage::Format_RGBX8888, QImage::Format_RGBA8888 };
+    for (const QByteArray &subType : subTypes) {
+        for (QImage::Format format : formats) {
+            const QByteArray tag = (subType.isEmpty() ? QByteArray("default") : subType)
+                                 + '-' + QByteArray::number(int(format));
+            QTest::newRow(tag.constData()) << subType << format << -1;
+            QTest::newRow((tag + "-uncompressed").constData()) << subType << format << 100;
+        }
+    }
+}
+
+void tst_QImageWriter::pngSubTypes()
+{
+    QFETCH(QByteArray, subType);
+    QFETCH(QImage::Format, format);
+    QFETCH(int, quality);
+
+    QImage image(61, 37, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x)
+            image.setPixel(x, y, qRgba(x * 4, y * 7, (x * y) & 0xff, 255 - x - y));
+    }
+    image = image.convertToFormat(format);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, "png");
+    QVERIFY(writer.supportedSubTypes().contains("paeth"));
+    writer.setSubType(subType);
+    writer.setQuality(quality);
+    QVERIFY(writer.write(image));
+    buffer.close();
+
+    QImage read = QImage::fromData(buffer.data(), "png");
+    QVERIFY(!read.isNull());
+    const QImage::Format compareFormat = image.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                                 : QImage::Format_RGB32;
+    QCOMPARE(read.convertToFormat(compareFormat), image.convertToFormat(compareFormat));
+}
+
 QTEST_MAIN(tst_QImageWriter)
 #include "tst_qimagewriter.moc"
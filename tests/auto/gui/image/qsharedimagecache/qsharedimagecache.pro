@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qsharedimagecache
+QT += testlib
+SOURCES += tst_qsharedimagecache.cpp
@@ -0,0 +1,204 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtGui/QSharedImageCache>
+#include <QtCore/QThreadPool>
+
+class tst_QSharedImageCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndFind();
+    void sharedBetweenInstances();
+    void imageOutlivesCache();
+    void indexedImagesAreConverted();
+    void full();
+    void concurrentInserts();
+};
+
+static QImage image(int size, QRgb color)
+{
+    QImage img(size, size, QImage::Format_ARGB32_Premultiplied);
+    img.fill(color);
+    return img;
+}
+
+// A key that no other test run uses at the same time.
+static QString segmentKey(const char *name)
+{
+    return QLatin1String("tst_qsharedimagecache-") + QLatin1String(name) + QLatin1Char('-')
+            + QString::number(QCoreApplication::applicationPid());
+}
+
+#define REQUIRE_ATTACHED(cache) \
+    if (!(cache).isAttached()) \
+        QSKIP("Shared memory is not available")
+
+void tst_QSharedImageCache::insertAndFind()
+{
+    QSharedImageCache cache(segmentKey("insertAndFind"), 1024);
+    REQUIRE_ATTACHED(cache);
+    QCOMPARE(cache.size(), 1024);
+    QCOMPARE(cache.count(), 0);
+    QCOMPARE(cache.totalUsed(), qint64(0));
+
+    QImage red = image(16, 0xffff0000);
+    red.setDevicePixelRatio(2);
+    QVERIFY(!cache.insert("null", QImage()));
+    QVERIFY(cache.insert("red", red));
+    QVERIFY(cache.insert("red", red));
+    QCOMPARE(cache.count(), 1);
+    QCOMPARE(cache.totalUsed(), red.sizeInBytes());
+    QVERIFY(cache.contains("red"));
+    QVERIFY(!cache.contains("blue"));
+
+    QImage found;
+    QVERIFY(cache.find("red", &found));
+    QCOMPARE(found, red);
+    QCOMPARE(found.devicePixelRatio(), qreal(2));
+    QVERIFY(!cache.find("blue", &found));
+    QCOMPARE(found, red);
+    QVERIFY(cache.find("blue").isNull());
+
+    // Modifying a found image detaches it from the shared memory
+    const uchar *shared = found.constBits();
+    found.setPixel(0, 0, 0xff0000ff);
+    QVERIFY(found.constBits() != shared);
+    QCOMPARE(cache.find("red"), red);
+}
+
+void tst_QSharedImageCache::sharedBetweenInstances()
+{
+    const QString key = segmentKey("sharedBetweenInstances");
+    QSharedImageCache first(key, 1024);
+    REQUIRE_ATTACHED(first);
+    // The size of the segment is decided by whoever creates it
+    QSharedImageCache second(key, 4096);
+    QVERIFY(second.isAttached());
+    QCOMPARE(second.key(), key);
+    QCOMPARE(second.size(), 1024);
+
+    const QImage green = image(32, 0xff00ff00);
+    QVERIFY(first.insert("green", green));
+    QCOMPARE(second.count(), 1);
+    QCOMPARE(second.find("green"), green);
+    QVERIFY(second.insert("blue", image(8, 0xff0000ff)));
+    QVERIFY(first.contains("blue"));
+    QCOMPARE(first.totalUsed(), second.totalUsed());
+}
+
+void tst_QSharedImageCache::imageOutlivesCache()
+{
+    const QImage blue = image(16, 0xff0000ff);
+    QImage found;
+    {
+        QSharedImageCache cache(segmentKey("imageOutlivesCache"), 1024);
+        REQUIRE_ATTACHED(cache);
+        QVERIFY(cache.insert("blue", blue));
+        found = cache.find("blue");
+    }
+    QCOMPARE(found, blue);
+}
+
+void tst_QSharedImageCache::indexedImagesAreConverted()
+{
+    QSharedImageCache cache(segmentKey("indexedImagesAreConverted"), 1024);
+    REQUIRE_ATTACHED(cache);
+
+    QImage indexed(8, 8, QImage::Format_Indexed8);
+    indexed.setColorTable(QVector<QRgb>() << 0xff000000 << 0xffffffff);
+    indexed.fill(1);
+    QVERIFY(cache.insert("indexed", indexed));
+    const QImage found = cache.find("indexed");
+    QCOMPARE(found.format(), QImage::Format_RGB32);
+    QCOMPARE(found.pixel(3, 3), 0xffffffff);
+}
+
+void tst_QSharedImageCache::full()
+{
+    // The smallest segment has room for a bit more than 64 KB of images
+    QSharedImageCache cache(segmentKey("full"), 0);
+    REQUIRE_ATTACHED(cache);
+
+    int inserted = 0;
+    while (cache.insert(QByteArray::number(inserted), image(60, 0xff000000 | inserted)))   // 14 KB
+        ++inserted;
+    QCOMPARE(inserted, 4);
+    QCOMPARE(cache.count(), inserted);
+    QVERIFY(!cache.contains(QByteArray::number(inserted)));
+    for (int i = 0; i < inserted; ++i)
+        QCOMPARE(cache.find(QByteArray::number(i)).pixel(0, 0), 0xff000000 | uint(i));
+
+    // smaller images can still fit
+    QVERIFY(cache.insert("small", image(4, 0xff000000)));
+}
+
+class CacheUser : public QRunnable
+{
+public:
+    CacheUser(QSharedImageCache *cache, int id) : cache(cache), id(id) {}
+    void run() override
+    {
+        for (int i = 0; i < 500; ++i) {
+            const int value = (i * 7 + id) % 200;
+            const QByteArray key = QByteArray::number(value);
+            QImage found;
+            if (cache->find(key, &found)) {
+                // each key always maps to the same contents
+                if (found.pixel(0, 0) != (0xff000000 | uint(value)))
+                    failed.store(1);
+            } else if (!cache->insert(key, image(16, 0xff000000 | uint(value)))) {
+                failed.store(1);
+            }
+        }
+    }
+
+    QSharedImageCache *cache;
+    int id;
+    static QAtomicInt failed;
+};
+
+QAtomicInt CacheUser::failed;
+
+void tst_QSharedImageCache::concurrentInserts()
+{
+    QSharedImageCache cache(segmentKey("concurrentInserts"), 4096);
+    REQUIRE_ATTACHED(cache);
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+    for (int i = 0; i < 8; ++i)
+        pool.start(new CacheUser(&cache, i));
+    pool.waitForDone();
+    QCOMPARE(CacheUser::failed.load(), 0);
+    QCOMPARE(cache.count(), 200);
+}
+
+QTEST_MAIN(tst_QSharedImageCache)
+#include "tst_qsharedimagecache.moc"
@@ -125,6 +125,7 @@ private slots:
     void treeDragAndDrop();
 #endif
     void removeRowsAndColumns();
+    void flatStorage();
 
     void itemRoleNames();
     void getMimeDataWithInvalidModelIndex();
@@ -1668,6 +1669,86 @@ void tst_QStandardItemModel::removeRowsAndColumns()
     VERIFY_MODEL
 }
 
+void tst_QStandardItemModel::flatStorage()
+{
+    QStandardItemModel model;
+    QVERIFY(!model.isFlatStorageEnabled());
+    model.setFlatStorageEnabled(true);
+    QVERIFY(model.isFlatStorageEnabled());
+
+    QSignalSpy rowsInsertedSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy dataChangedSpy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    QVector<QVector<QVariant> > rows;
+    rows << (QVector<QVariant>() << QString("c") << 3)
+         << (QVector<QVariant>() << QString("a") << 1 << 10.5)
+         << (QVector<QVariant>() << QString("b"));
+    model.appendRows(rows);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.columnCount(), 3);
+    QCOMPARE(model.data(model.index(1, 2)), QVariant(10.5));
+    QCOMPARE(model.data(model.index(1, 0), Qt::EditRole), QVariant(QString("a")));
+    QVERIFY(!model.data(model.index(2, 1)).isValid());
+    QVERIFY(!model.data(model.index(0, 0), Qt::ToolTipRole).isValid());
+    QCOMPARE(model.itemData(model.index(0, 1)).value(Qt::DisplayRole), QVariant(3));
+
+    // no items until they are asked for
+    QVERIFY(!model.invisibleRootItem()->child(0, 0));
+    QVERIFY(!model.item(2, 1));
+    QStandardItem *item = model.item(0, 0);
+    QVERIFY(item);
+    QCOMPARE(item->text(), QString("c"));
+    QCOMPARE(model.invisibleRootItem()->child(0, 0), item);
+    QCOMPARE(model.item(0, 0), item);
+
+    QVERIFY(model.setData(model.index(2, 1), 2));
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(model.data(model.index(2, 1)), QVariant(2));
+    QVERIFY(!model.invisibleRootItem()->child(2, 1));
+    QVERIFY(model.setData(model.index(2, 1), 2));
+    QCOMPARE(dataChangedSpy.count(), 1);
+
+    // other roles need an item
+    QVERIFY(model.setData(model.index(1, 1), QString("tip"), Qt::ToolTipRole));
+    QVERIFY(model.invisibleRootItem()->child(1, 1));
+    QCOMPARE(model.data(model.index(1, 1)), QVariant(1));
+
+    model.sort(1);
+    QCOMPARE(model.data(model.index(0, 0)).toString(), QString("a"));
+    QCOMPARE(model.data(model.index(1, 0)).toString(), QString("b"));
+    QCOMPARE(model.data(model.index(2, 0)).toString(), QString("c"));
+    QCOMPARE(model.item(2, 0), item);
+    QCOMPARE(model.data(model.index(0, 1), Qt::ToolTipRole).toString(), QString("tip"));
+
+    dataChangedSpy.clear();
+    model.setColumnData(2, QVector<QVariant>() << 1.5 << 2.5 << 3.5, 1);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.data(model.index(0, 2)), QVariant(10.5));
+    QCOMPARE(model.data(model.index(3, 2)), QVariant(3.5));
+
+    model.removeRow(0);
+    QCOMPARE(model.data(model.index(0, 2)), QVariant(1.5));
+    model.insertColumn(0);
+    QCOMPARE(model.data(model.index(0, 1)).toString(), QString("b"));
+    QVERIFY(!model.data(model.index(0, 0)).isValid());
+
+    const QList<QStandardItem *> taken = model.takeRow(0);
+    QCOMPARE(taken.count(), 4);
+    QVERIFY(!taken.at(0));
+    QCOMPARE(taken.at(1)->text(), QString("b"));
+    QCOMPARE(taken.at(2)->data(Qt::DisplayRole), QVariant(2));
+    qDeleteAll(taken);
+    QCOMPARE(model.rowCount(), 2);
+
+    model.setFlatStorageEnabled(false);
+    QVERIFY(model.invisibleRootItem()->child(0, 1));
+    QCOMPARE(model.invisibleRootItem()->child(0, 1)->text(), QString("c"));
+    QCOMPARE(model.invisibleRootItem()->child(1, 3)->data(Qt::DisplayRole), QVariant(3.5));
+    QVERIFY(!model.invisibleRootItem()->child(1, 1));
+}
+
 void tst_QStandardItemModel::itemRoleNames()
 {
     QVector<QString> row_list = QString("1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20").split(',').toVector();
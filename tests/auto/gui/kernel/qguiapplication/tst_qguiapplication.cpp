@@ -36,6 +36,7 @@
 #include <QtGui/QPalette>
 #include <QtGui/QStyleHints>
 #include <qpa/qwindowsysteminterface.h>
+#include <qpa/qwindowsysteminterface_p.h>
 #include <qgenericplugin.h>
 
 #if defined(Q_OS_QNX)
@@ -76,6 +77,7 @@ private slots:
     void layoutDirection();
     void globalShareContext();
     void testSetPaletteAttribute();
+    void windowSystemEventsFromThread();
 
     void staticFunctions();
 
@@ -1036,6 +1038,48 @@ void tst_QGuiApplication::testSetPaletteAttribute()
     QVERIFY(QCoreApplication::testAttribute(Qt::AA_SetPalette));
 }
 
+class KeyEventThread : public QThread
+{
+public:
+    void run() override
+    {
+        for (int i = 0; i < 100; ++i) {
+            QWindowSystemInterface::handleKeyEvent<QWindowSystemInterface::AsynchronousDelivery>(
+                        nullptr, QEvent::KeyPress, Qt::Key_A, Qt::NoModifier, QStringLiteral("a"));
+        }
+    }
+};
+
+// Events queued from another thread must all be delivered, even though
+// only the first one wakes up the event dispatcher, and their delivery
+// latency is recorded.
+void tst_QGuiApplication::windowSystemEventsFromThread()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>("tst_qguiapplication") };
+    QGuiApplication app(argc, argv);
+
+    QWindowSystemInterfacePrivate::resetDeliveryLatency();
+
+    KeyEventThread thread;
+    thread.start();
+    QVERIFY(thread.wait());
+
+    QTRY_COMPARE(QWindowSystemInterface::windowSystemEventsQueued(), 0);
+
+    const QWindowSystemInterfacePrivate::DeliveryLatency &latency =
+            QWindowSystemInterfacePrivate::deliveryLatency;
+    QCOMPARE(latency.eventCount, quint64(100));
+    quint64 bucketTotal = 0;
+    for (int i = 0; i < QWindowSystemInterfacePrivate::DeliveryLatency::BucketCount; ++i)
+        bucketTotal += latency.counts[i];
+    QCOMPARE(bucketTotal, latency.eventCount);
+    QVERIFY(latency.maximum >= 0);
+
+    // Once delivered, the next event needs a new wakeup.
+    QCOMPARE(QWindowSystemInterfacePrivate::wakeUpPending.load(), 0);
+}
+
 // Test that static functions do not crash if there is no application instance.
 void tst_QGuiApplication::staticFunctions()
 {
@@ -155,6 +155,9 @@ private slots:
     void mapVector_data();
     void mapVector();
 
+    void mapPoints_data();
+    void mapPoints();
+
     void properties();
     void metaTypes();
 
@@ -3354,6 +3357,51 @@ void tst_QMatrixNxN::mapVector()
     QVERIFY(qFuzzyCompare(actual2.z(), expected.z()));
 }
 
+void tst_QMatrixNxN::mapPoints_data()
+{
+    QTest::addColumn<QMatrix4x4>("matrix");
+
+    QTest::newRow("identity") << QMatrix4x4();
+
+    QMatrix4x4 m;
+    m.translate(1.0f, -2.0f, 3.5f);
+    QTest::newRow("translate") << m;
+
+    m.scale(2.0f, 11.0f, -6.5f);
+    QTest::newRow("scaleTranslate") << m;
+
+    m.rotate(30.0f, 0.0f, 0.0f, 1.0f);
+    QTest::newRow("rotate2D") << m;
+
+    m.rotate(45.0f, 1.0f, 1.0f, 0.0f);
+    QTest::newRow("rotate") << m;
+
+    m.perspective(60.0f, 1.5f, 0.1f, 100.0f);
+    QTest::newRow("perspective") << m;
+
+    QTest::newRow("general") << QMatrix4x4(uniqueValues4);
+}
+void tst_QMatrixNxN::mapPoints()
+{
+    QFETCH(QMatrix4x4, matrix);
+
+    QVector<QVector3D> points;
+    for (int i = 0; i < 50; ++i)
+        points.append(QVector3D(i * 0.5f - 10.0f, 3.0f - i, i * 0.25f + 1.0f));
+
+    QVector<QVector3D> results(points.size());
+    matrix.map(points.constData(), results.data(), points.size());
+    for (int i = 0; i < points.size(); ++i)
+        QCOMPARE(results.at(i), matrix.map(points.at(i)));
+
+    // Mapping in place must give the same results.
+    QVector<QVector3D> inPlace = points;
+    matrix.map(inPlace.constData(), inPlace.data(), inPlace.size());
+    QCOMPARE(inPlace, results);
+
+    matrix.map(points.constData(), results.data(), 0);
+}
+
 class tst_QMatrixNxN4x4Properties : public QObject
 {
     Q_OBJECT
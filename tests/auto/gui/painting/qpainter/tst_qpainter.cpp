@@ -40,6 +40,7 @@
 #include <qthread.h>
 #include <limits.h>
 #include <math.h>
+#include <qmath.h>
 #include <qpaintengine.h>
 #ifndef QT_NO_WIDGETS
 #include <qdesktopwidget.h>
@@ -48,6 +49,7 @@
 #include <qrandom.h>
 
 #include <private/qdrawhelper_p.h>
+#include <private/qpaintengine_raster_p.h>
 #include <qpainter.h>
 
 #ifndef QT_NO_WIDGETS
@@ -306,6 +308,12 @@ private slots:
 
     void fillPolygon();
 
+    void paintThreaded_data();
+    void paintThreaded();
+    void cachedPathFill();
+    void cellRasterizer_data();
+    void cellRasterizer();
+
 private:
     void fillData();
     void setPenColor(QPainter& p);
@@ -5253,6 +5261,220 @@ void tst_QPainter::fillPolygon()
     }
 }
 
+void tst_QPainter::paintThreaded_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<int>("scene");
+
+    const QImage::Format formats[] = {
+        QImage::Format_ARGB32_Premultiplied,
+        QImage::Format_RGB32,
+        QImage::Format_RGB16,
+        QImage::Format_A2RGB30_Premultiplied
+    };
+    const char *sceneNames[] = { "solid", "gradient", "image", "texture" };
+    for (QImage::Format format : formats) {
+        for (int scene = 0; scene < 4; ++scene)
+            QTest::addRow("%d: %s", int(format), sceneNames[scene]) << format << scene;
+    }
+}
+
+static void paintScene(QImage *image, int scene)
+{
+    QImage source(400, 300, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < source.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(source.scanLine(y));
+        for (int x = 0; x < source.width(); ++x)
+            line[x] = qPremultiply(qRgba(x, y, x ^ y, (x + y) | 0x40));
+    }
+
+    image->fill(Qt::white);
+    QPainter p(image);
+    p.setRenderHint(QPainter::Antialiasing);
+    switch (scene) {
+    case 0:
+        p.fillRect(image->rect(), QColor(10, 200, 30, 128));
+        p.setBrush(Qt::red);
+        p.drawEllipse(QRectF(13.5, 7.25, 900, 700));
+        p.setCompositionMode(QPainter::CompositionMode_Source);
+        p.setBrush(QColor(0, 0, 255, 100));
+        p.drawEllipse(QRectF(200.5, 100.25, 700, 600));
+        break;
+    case 1: {
+        QLinearGradient gradient(0, 0, image->width(), image->height());
+        gradient.setColorAt(0, QColor(255, 0, 0, 200));
+        gradient.setColorAt(1, QColor(0, 0, 255, 50));
+        p.fillRect(image->rect(), gradient);
+        QRadialGradient radial(500, 400, 400);
+        radial.setColorAt(0, Qt::yellow);
+        radial.setColorAt(1, Qt::transparent);
+        p.setBrush(radial);
+        p.drawEllipse(QRectF(100.5, 50.5, 800, 700));
+        break;
+    }
+    case 2:
+        p.drawImage(QPoint(0, 0), source.scaled(image->size()));
+        p.setOpacity(0.6);
+        p.drawImage(QPoint(37, 21), source.scaled(image->size()));
+        break;
+    case 3:
+        p.setBrushOrigin(7, 3);
+        p.fillRect(image->rect(), QBrush(source));
+        p.setOpacity(0.5);
+        p.translate(11, 5);
+        p.drawImage(QRectF(0, 0, 900, 700), source);
+        break;
+    }
+}
+
+void tst_QPainter::paintThreaded()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(int, scene);
+
+    // large enough to be blended in bands on several threads
+    QImage threaded(1000, 800, format);
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(4);
+    paintScene(&threaded, scene);
+
+    // with the only pool thread busy, the painting thread blends everything
+    class BlockingRunnable : public QRunnable
+    {
+    public:
+        QSemaphore started;
+        QSemaphore finish;
+
+        void run() override
+        {
+            started.release();
+            finish.acquire();
+        }
+    } blocker;
+    blocker.setAutoDelete(false);
+    pool->setMaxThreadCount(1);
+    pool->start(&blocker);
+    blocker.started.acquire();
+
+    QImage single(threaded.size(), format);
+    paintScene(&single, scene);
+
+    blocker.finish.release();
+    pool->waitForDone();
+    pool->setMaxThreadCount(maxThreadCount);
+
+    QCOMPARE(threaded, single);
+}
+
+static void paintSymbols(QImage *image, const QPainterPath &symbol)
+{
+    image->fill(Qt::white);
+    QPainter p(image);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setBrush(QColor(200, 20, 60, 180));
+    p.setPen(Qt::NoPen);
+    for (int i = 0; i < 3; ++i)
+        p.drawPath(symbol);
+    // replayed at integer offsets, including partly outside the image
+    for (int x = -20; x < image->width(); x += 37) {
+        p.save();
+        p.translate(x, 150);
+        p.fillPath(symbol, Qt::blue);
+        p.restore();
+    }
+    for (int y = -20; y < image->height(); y += 29) {
+        p.save();
+        p.translate(y / 2, y);
+        p.fillPath(symbol, QColor(0, 160, 0, 120));
+        p.translate(0.25, 0.5);
+        p.fillPath(symbol, QColor(0, 0, 0, 60));
+        p.restore();
+    }
+    p.setClipRect(QRect(30, 40, 100, 70));
+    p.fillPath(symbol, Qt::yellow);
+    p.setClipping(false);
+    p.scale(1.5, 1.5);
+    p.fillPath(symbol, QColor(255, 0, 255, 100));
+    p.fillPath(symbol, QColor(255, 0, 255, 100));
+}
+
+void tst_QPainter::cachedPathFill()
+{
+    QPainterPath symbol;
+    symbol.addEllipse(QRectF(0.5, 0.5, 30, 20));
+    symbol.moveTo(5, 5);
+    symbol.cubicTo(40, 0, 0, 40, 35.5, 30.25);
+    symbol.closeSubpath();
+
+    QImage uncached(300, 200, QImage::Format_ARGB32_Premultiplied);
+    paintSymbols(&uncached, symbol);
+
+    QImage cached(uncached.size(), uncached.format());
+    QRasterPaintEngine *engine = static_cast<QRasterPaintEngine *>(cached.paintEngine());
+    QCOMPARE(engine->pathCacheLimit(), 0);
+    engine->setPathCacheLimit(256);
+    QCOMPARE(engine->pathCacheLimit(), 256);
+    paintSymbols(&cached, symbol);
+    QCOMPARE(cached, uncached);
+
+    // a cache too small for any entry falls back to plain rasterization
+    engine->setPathCacheLimit(1);
+    paintSymbols(&cached, symbol);
+    QCOMPARE(cached, uncached);
+
+    engine->setPathCacheLimit(0);
+    QCOMPARE(engine->pathCacheLimit(), 0);
+}
+
+void tst_QPainter::cellRasterizer_data()
+{
+    QTest::addColumn<QPainterPath>("path");
+
+    QPainterPath star;
+    star.moveTo(250, 150);
+    for (int i = 1; i < 31; ++i) {
+        const qreal angle = 2 * M_PI * i * 15 / 31;
+        star.lineTo(150 + 140 * qCos(angle), 100 + 140 * qSin(angle));
+    }
+    QTest::newRow("star winding") << star;
+    star.setFillRule(Qt::OddEvenFill);
+    QTest::newRow("star odd-even") << star;
+
+    QPainterPath ellipses;
+    for (int i = 0; i < 10; ++i)
+        ellipses.addEllipse(QRectF(i * 31.3 - 20, i * 17.7 - 10, 60.5, 40.25));
+    QTest::newRow("ellipses") << ellipses;
+
+    QPainterPath thin;
+    for (int i = 0; i < 20; ++i)
+        thin.addRect(QRectF(i * 14.6 + 0.3, 5.5, 0.2 + i * 0.05, 190));
+    QTest::newRow("thin rects") << thin;
+
+    QPainterPath large;
+    large.addEllipse(QRectF(-1000.5, -500.25, 2000, 1600));
+    QTest::newRow("larger than device") << large;
+}
+
+void tst_QPainter::cellRasterizer()
+{
+    QFETCH(QPainterPath, path);
+
+    QImage images[2];
+    for (int i = 0; i < 2; ++i) {
+        images[i] = QImage(300, 200, QImage::Format_ARGB32_Premultiplied);
+        images[i].fill(Qt::white);
+        static_cast<QRasterPaintEngine *>(images[i].paintEngine())->setCellRasterizerEnabled(i);
+        QPainter p(&images[i]);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.fillPath(path, QColor(30, 60, 200, 160));
+        p.rotate(7.5);
+        p.scale(0.75, 1.25);
+        p.fillPath(path, QColor(200, 0, 0, 120));
+    }
+    QCOMPARE(images[1], images[0]);
+}
+
 QTEST_MAIN(tst_QPainter)
 
 #include "tst_qpainter.moc"
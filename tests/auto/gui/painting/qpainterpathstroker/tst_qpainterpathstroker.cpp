@@ -41,6 +41,7 @@ public:
 
 private slots:
     void strokeEmptyPath();
+    void strokeAgain();
 };
 
 void tst_QPainterPathStroker::strokeEmptyPath()
@@ -52,6 +53,53 @@ void tst_QPainterPathStroker::strokeEmptyPath()
     QCOMPARE(stroker.createStroke(path), path);
 }
 
+void tst_QPainterPathStroker::strokeAgain()
+{
+    QPainterPath path;
+    path.moveTo(10, 10);
+    path.lineTo(100, 10);
+    path.cubicTo(150, 10, 150, 60, 100, 60);
+
+    QPainterPathStroker stroker;
+    stroker.setWidth(4);
+    stroker.setDashPattern(Qt::DashLine);
+    const QPainterPath first = stroker.createStroke(path);
+    QVERIFY(!first.isEmpty());
+    QCOMPARE(stroker.createStroke(path), first);
+
+    // A fresh stroker must produce the same outline.
+    QPainterPathStroker other;
+    other.setWidth(4);
+    other.setDashPattern(Qt::DashLine);
+    QCOMPARE(other.createStroke(path), first);
+
+    // Modifying the path must not reuse the previous outline.
+    QPainterPath modified = path;
+    modified.lineTo(10, 60);
+    const QPainterPath second = stroker.createStroke(modified);
+    QVERIFY(second != first);
+    QCOMPARE(second, other.createStroke(modified));
+
+    path.lineTo(10, 60);
+    QCOMPARE(stroker.createStroke(path), second);
+
+    // Changing the stroker's settings must not reuse it either.
+    stroker.setWidth(8);
+    other.setWidth(8);
+    QCOMPARE(stroker.createStroke(path), other.createStroke(path));
+    QVERIFY(stroker.createStroke(path) != second);
+
+    stroker.setDashPattern(Qt::SolidLine);
+    other.setDashPattern(Qt::SolidLine);
+    QCOMPARE(stroker.createStroke(path), other.createStroke(path));
+
+    stroker.setDashOffset(2);
+    stroker.setDashPattern(Qt::DotLine);
+    other.setDashOffset(2);
+    other.setDashPattern(Qt::DotLine);
+    QCOMPARE(stroker.createStroke(path), other.createStroke(path));
+}
+
 QTEST_APPLESS_MAIN(tst_QPainterPathStroker)
 
 #include "tst_qpainterpathstroker.moc"
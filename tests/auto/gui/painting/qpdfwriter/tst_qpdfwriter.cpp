@@ -31,6 +31,7 @@
 #include <QtAlgorithms>
 #include <QtGui/QAbstractTextDocumentLayout>
 #include <QtGui/QPageLayout>
+#include <QtGui/QPainter>
 #include <QtGui/QPdfWriter>
 #include <QtGui/QTextCursor>
 #include <QtGui/QTextDocument>
@@ -44,6 +45,7 @@ private slots:
     void testPageMetrics_data();
     void testPageMetrics();
     void qtbug59443();
+    void identicalImagesEmbeddedOnce();
 };
 
 void tst_QPdfWriter::basics()
@@ -271,6 +273,31 @@ void tst_QPdfWriter::qtbug59443()
 
 }
 
+void tst_QPdfWriter::identicalImagesEmbeddedOnce()
+{
+    QImage image(64, 64, QImage::Format_RGB32);
+    image.fill(Qt::darkCyan);
+    QImage other(64, 64, QImage::Format_RGB32);
+    other.fill(Qt::darkRed);
+
+    QTemporaryFile file;
+    QVERIFY2(file.open(), qPrintable(file.errorString()));
+    {
+        QPdfWriter writer(file.fileName());
+        QPainter painter(&writer);
+        for (int page = 0; page < 3; ++page) {
+            if (page)
+                writer.newPage();
+            // A separate copy each time, so the images do not share a cache key
+            painter.drawImage(0, 0, image.copy());
+            painter.drawImage(100, 0, other.copy());
+        }
+    }
+
+    const QByteArray pdf = file.readAll();
+    QCOMPARE(pdf.count("/Subtype /Image"), 2);
+}
+
 QTEST_MAIN(tst_QPdfWriter)
 
 #include "tst_qpdfwriter.moc"
@@ -42,6 +42,7 @@
 #include <QtGui/QGenericMatrix>
 #include <QtGui/QMatrix4x4>
 #include <QtGui/qopengltextureblitter.h>
+#include <QtGui/qopengltextureuploader.h>
 #include <QtGui/private/qguiapplication_p.h>
 #include <QtGui/private/qopenglextensions_p.h>
 #include <qpa/qplatformintegration.h>
@@ -98,7 +99,10 @@ private slots:
     void textureblitterPartTargetRectTransform();
     void defaultSurfaceFormat();
     void imageFormatPainting();
+    void batchedImagePainting();
     void nullTextureInitializtion();
+    void textureUploader();
+    void precompileShaders();
 
 #ifdef USE_GLX
     void glxContextWrap();
@@ -945,6 +949,61 @@ void tst_QOpenGL::imageFormatPainting()
 
 }
 
+void tst_QOpenGL::batchedImagePainting()
+{
+    QScopedPointer<QSurface> surface(createSurface(QSurface::Window));
+
+    QOpenGLContext ctx;
+    QVERIFY(ctx.create());
+
+    QVERIFY(ctx.makeCurrent(surface.data()));
+
+    if (!QOpenGLFramebufferObject::hasOpenGLFramebufferObjects())
+        QSKIP("QOpenGLFramebufferObject not supported on this platform");
+
+    const QSize size(128, 128);
+    QOpenGLFramebufferObject fbo(size);
+    QVERIFY(fbo.bind());
+
+    // A 2x2 "atlas" of solid colors; each tile is drawn from a different part
+    QImage atlas(32, 32, QImage::Format_RGB32);
+    atlas.fill(Qt::red);
+    {
+        QPainter p(&atlas);
+        p.fillRect(16, 0, 16, 16, Qt::green);
+        p.fillRect(0, 16, 16, 16, Qt::blue);
+        p.fillRect(16, 16, 16, 16, Qt::yellow);
+    }
+    QImage other(16, 16, QImage::Format_RGB32);
+    other.fill(Qt::cyan);
+
+    QPainter fboPainter;
+    QOpenGLPaintDevice device(fbo.width(), fbo.height());
+
+    QVERIFY(fboPainter.begin(&device));
+    fboPainter.fillRect(0, 0, 128, 128, Qt::black);
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            const QRect source(((x + y) % 2) * 16, (y % 2) * 16, 16, 16);
+            fboPainter.drawImage(QRect(x * 16, y * 16, 16, 16), atlas, source);
+        }
+    }
+    // Interrupt the batch with another image and a fill, then resume it
+    fboPainter.drawImage(QPoint(0, 0), other);
+    fboPainter.fillRect(16, 0, 16, 16, Qt::white);
+    fboPainter.drawImage(QRect(32, 0, 16, 16), atlas, QRect(0, 0, 16, 16));
+    fboPainter.end();
+
+    const QImage fb = fbo.toImage().convertToFormat(QImage::Format_RGB32);
+    QCOMPARE(fb.pixel(8, 8), QColor(Qt::cyan).rgb());
+    QCOMPARE(fb.pixel(24, 8), QColor(Qt::white).rgb());
+    QCOMPARE(fb.pixel(40, 8), QColor(Qt::red).rgb());
+    QCOMPARE(fb.pixel(56, 8), QColor(Qt::green).rgb());
+    QCOMPARE(fb.pixel(8, 24), QColor(Qt::yellow).rgb());
+    QCOMPARE(fb.pixel(24, 24), QColor(Qt::blue).rgb());
+    QCOMPARE(fb.pixel(120, 120), QColor(Qt::blue).rgb());
+}
+
 void tst_QOpenGL::openGLPaintDevice_data()
 {
     QTest::addColumn<int>("surfaceClass");
@@ -1624,6 +1683,94 @@ void tst_QOpenGL::nullTextureInitializtion()
     QVERIFY(!t.isCreated());
 }
 
+void tst_QOpenGL::textureUploader()
+{
+    QScopedPointer<QSurface> surface(createSurface(QSurface::Window));
+    QOpenGLContext ctx;
+    QVERIFY(ctx.create());
+    QVERIFY(ctx.makeCurrent(surface.data()));
+
+    if (!QOpenGLFramebufferObject::hasOpenGLFramebufferObjects())
+        QSKIP("QOpenGLFramebufferObject not supported on this platform");
+
+    QOpenGLTextureUploader uploader(2);
+    QVERIFY(uploader.create());
+    QVERIFY(uploader.isCreated());
+    QCOMPARE(uploader.bufferCount(), 2);
+
+    QOpenGLTexture texture(QOpenGLTexture::Target2D);
+    texture.setSize(16, 16);
+    texture.setFormat(QOpenGLTexture::RGBA8_UNorm);
+    texture.allocateStorage(QOpenGLTexture::RGBA, QOpenGLTexture::UInt8);
+
+    QOpenGLFunctions *f = ctx.functions();
+    GLuint fbo = 0;
+    f->glGenFramebuffers(1, &fbo);
+    f->glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    f->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.textureId(), 0);
+
+    // Cycle through the ring more than once so that buffers get reused
+    const QRgb colors[] = { qRgb(255, 0, 0), qRgb(0, 255, 0), qRgb(0, 0, 255), qRgb(255, 255, 0) };
+    for (QRgb color : colors) {
+        QImage image(16, 16, QImage::Format_RGB32);
+        image.fill(color);
+        QVERIFY(uploader.setData(&texture, image));
+
+        quint8 pixel[4] = { 0, 0, 0, 0 };
+        f->glReadPixels(8, 8, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        QCOMPARE(qRgb(pixel[0], pixel[1], pixel[2]), color);
+    }
+
+    // Write the data as a worker thread would, through uploadData()
+    const int upload = uploader.beginUpload(16 * 16 * 4);
+    QVERIFY(upload >= 0);
+    quint8 *data = static_cast<quint8 *>(uploader.uploadData(upload));
+    QVERIFY(data);
+    for (int i = 0; i < 16 * 16; ++i) {
+        data[i * 4] = 0;
+        data[i * 4 + 1] = 255;
+        data[i * 4 + 2] = 255;
+        data[i * 4 + 3] = 255;
+    }
+    uploader.endUpload(upload, &texture, 0, QOpenGLTexture::RGBA, QOpenGLTexture::UInt8);
+    QVERIFY(!uploader.uploadData(upload));
+
+    quint8 pixel[4] = { 0, 0, 0, 0 };
+    f->glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    QCOMPARE(qRgb(pixel[0], pixel[1], pixel[2]), qRgb(0, 255, 255));
+
+    f->glBindFramebuffer(GL_FRAMEBUFFER, ctx.defaultFramebufferObject());
+    f->glDeleteFramebuffers(1, &fbo);
+
+    uploader.destroy();
+    QVERIFY(!uploader.isCreated());
+}
+
+void tst_QOpenGL::precompileShaders()
+{
+    QScopedPointer<QSurface> surface(createSurface(QSurface::Window));
+    QOpenGLContext ctx;
+    QVERIFY(ctx.create());
+    QVERIFY(ctx.makeCurrent(surface.data()));
+
+    if (!QOpenGLFramebufferObject::hasOpenGLFramebufferObjects())
+        QSKIP("QOpenGLFramebufferObject not supported on this platform");
+
+    QVERIFY(QOpenGLPaintDevice::precompileShaders());
+
+    // Painting afterwards picks up the precompiled programs
+    QOpenGLFramebufferObject fbo(QSize(64, 64));
+    QVERIFY(fbo.bind());
+    QOpenGLPaintDevice device(fbo.size());
+    {
+        QPainter p(&device);
+        p.fillRect(0, 0, 64, 64, Qt::red);
+        p.setOpacity(0.5);
+        p.fillRect(0, 0, 32, 32, QLinearGradient(0, 0, 32, 0));
+    }
+    QCOMPARE(fbo.toImage().pixel(48, 48), qRgb(255, 0, 0));
+}
+
 QTEST_MAIN(tst_QOpenGL)
 
 #include "tst_qopengl.moc"
@@ -62,6 +62,7 @@ private slots:
     void styleSelector();
     void specificity_data();
     void specificity();
+    void classIndex();
     void specificitySort_data();
     void specificitySort();
     void rulesForNode_data();
@@ -1028,6 +1029,9 @@ void tst_QCssParser::styleSelector_data()
     QTest::newRow("universal6") << true << QString("[foo=bar]") << QString("<p foo=\"bar\" />") << QString();
 
     QTest::newRow("universal7") << true << QString(".charfmt1") << QString("<p class=\"charfmt1\" />") << QString();
+    QTest::newRow("multiclass") << true << QString(".bar") << QString("<p class=\"foo bar\" />") << QString();
+    QTest::newRow("multiclass2") << true << QString(".foo.bar") << QString("<p class=\"bar foo\" />") << QString();
+    QTest::newRow("nomulticlass") << false << QString(".foo.bar") << QString("<p class=\"foo\" />") << QString();
 
     QTest::newRow("id") << true << QString("#blub") << QString("<p id=\"blub\" />") << QString();
     QTest::newRow("noid") << false << QString("#blub") << QString("<p id=\"other\" />") << QString();
@@ -1200,6 +1204,21 @@ void tst_QCssParser::specificity()
     QTEST(rule.selectors.at(0).specificity(), "specificity");
 }
 
+void tst_QCssParser::classIndex()
+{
+    QCss::Parser parser(".foo { } .bar.baz:hover { } p.foo { } #id.foo { } *[class~=qux] { } [class=foo] { }");
+    QCss::StyleSheet sheet;
+    QVERIFY(parser.parse(&sheet));
+
+    QCOMPARE(sheet.classIndex.count(), 3);
+    QCOMPARE(sheet.classIndex.count(QLatin1String("foo")), 1);
+    QCOMPARE(sheet.classIndex.count(QLatin1String("bar")), 1);
+    QCOMPARE(sheet.classIndex.count(QLatin1String("qux")), 1);
+    QCOMPARE(sheet.nameIndex.count(), 1);
+    QCOMPARE(sheet.idIndex.count(), 1);
+    QCOMPARE(sheet.styleRules.count(), 1);
+}
+
 void tst_QCssParser::specificitySort_data()
 {
     QTest::addColumn<QString>("firstSelector");
@@ -1301,6 +1320,10 @@ void tst_QCssParser::rulesForNode_data()
     QTest::newRow("!-3") << QString("<p/>")
         << QString("p:checked:!hover:!pressed { color: red; } p:!checked:hover { color: gray } p:!focus { color: blue; }")
         << quint64(QCss::PseudoClass_Pressed) << 1 << "blue" << "";
+
+    QTest::newRow("classes") << QString("<p class=\"a b a\"/>")
+        << QString(".a { color: red; } .c { color: gray } .b { color: blue; }")
+        << (quint64)QCss::PseudoClass_Unspecified << 2 << "red" << "blue";
 }
 
 void tst_QCssParser::rulesForNode()
@@ -31,6 +31,7 @@
 #include <qfont.h>
 #include <qfontmetrics.h>
 #include <qfontdatabase.h>
+#include <qtextlayout.h>
 #include <private/qfontengine_p.h>
 #include <qstringlist.h>
 #include <qlist.h>
@@ -58,6 +59,7 @@ private slots:
     void lineWidth();
     void mnemonicTextWidth();
     void leadingBelowLine();
+    void asciiWidth();
 };
 
 void tst_QFontMetrics::same()
@@ -331,5 +333,36 @@ void tst_QFontMetrics::leadingBelowLine()
     QCOMPARE(line.base(), line.ascent);
 }
 
+void tst_QFontMetrics::asciiWidth()
+{
+    // the widths of printable ASCII text must match the shaped widths,
+    // whether or not they are taken from QFontEngine::asciiAdvances()
+    QString ascii;
+    for (ushort uc = 0x20; uc < 0x7f; ++uc)
+        ascii += QChar(uc);
+    const QString texts[] = { ascii, QStringLiteral("Hello World"), QStringLiteral("1234.56"),
+                              QStringLiteral("AVATAR office fi fl") };
+
+    QStringList families = QFontDatabase().families().mid(0, 10);
+    families.prepend(QFont().family());
+    for (const QString &family : qAsConst(families)) {
+        QFont font(family);
+        font.setPixelSize(13);
+        const QFontMetrics fm(font);
+        const QFontMetricsF fmf(font);
+
+        for (const QString &text : texts) {
+            QTextLayout layout(text, font);
+            layout.beginLayout();
+            layout.createLine();
+            layout.endLayout();
+            const qreal shapedWidth = layout.lineAt(0).naturalTextWidth();
+
+            QCOMPARE(fmf.width(text), shapedWidth);
+            QCOMPARE(fm.width(text), qRound(shapedWidth));
+        }
+    }
+}
+
 QTEST_MAIN(tst_QFontMetrics)
 #include "tst_qfontmetrics.moc"
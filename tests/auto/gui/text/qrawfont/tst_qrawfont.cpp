@@ -31,6 +31,8 @@
 
 #include <qrawfont.h>
 #include <private/qrawfont_p.h>
+#include <private/qfontengine_p.h>
+#include <private/qtextureglyphcache_p.h>
 
 class tst_QRawFont: public QObject
 {
@@ -93,6 +95,8 @@ private slots:
 
     void fallbackFontsOrder();
 
+    void threadedGlyphRasterization();
+
 private:
     QString testFont;
     QString testFontBoldItalic;
@@ -1044,6 +1048,59 @@ void tst_QRawFont::fallbackFontsOrder()
     fontDatabase.removeApplicationFont(id);
 }
 
+void tst_QRawFont::threadedGlyphRasterization()
+{
+    QFont f;
+    f.setPixelSize(20);
+    QRawFont font = QRawFont::fromFont(f);
+    QVERIFY(font.isValid());
+
+    QFontEngine *fontEngine = QRawFontPrivate::get(font)->fontEngine;
+    if (!fontEngine->supportsThreadedRasterization())
+        QSKIP("The font engine does not support rasterizing on other threads");
+
+    const int glyphCount = qMin(fontEngine->glyphCount(), 512);
+    if (glyphCount < 128)
+        QSKIP("The default font does not have enough glyphs");
+
+    QVector<glyph_t> glyphs;
+    for (int i = 1; i < glyphCount; ++i)
+        glyphs.append(i);
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(4);
+
+    QImageTextureGlyphCache cache(QFontEngine::Format_A8, QTransform());
+    QVERIFY(cache.populate(fontEngine, glyphs.size(), glyphs.constData(), 0));
+    cache.fillInPendingGlyphs();
+
+    pool->setMaxThreadCount(maxThreadCount);
+
+    const QImage &texture = cache.image();
+    for (glyph_t glyph : qAsConst(glyphs)) {
+        const QFixed subPixelPosition = fontEngine->supportsSubPixelPositions()
+                ? fontEngine->subPixelPositionForX(QFixed())
+                : QFixed();
+        const QTextureGlyphCache::Coord c =
+                cache.coords.value(QTextureGlyphCache::GlyphAndSubPixelPosition(glyph, subPixelPosition));
+        if (c.isNull())
+            continue;
+
+        const QImage expected = fontEngine->alphaMapForGlyph(glyph, subPixelPosition, QTransform());
+        if (expected.depth() != 8)
+            QSKIP("The font engine does not produce 8-bit alpha maps");
+
+        const int w = qMin(expected.width(), c.w);
+        const int h = qMin(expected.height(), c.h);
+        for (int y = 0; y < h; ++y) {
+            const uchar *textureLine = texture.constScanLine(c.y + y) + c.x;
+            QVERIFY2(memcmp(textureLine, expected.constScanLine(y), w) == 0,
+                     qPrintable(QString::fromLatin1("glyph %1, line %2").arg(glyph).arg(y)));
+        }
+    }
+}
+
 #endif // QT_NO_RAWFONT
 
 QTEST_MAIN(tst_QRawFont)
@@ -98,6 +98,8 @@ private slots:
 
     void multiLine();
 
+    void drawStaticTexts();
+
 private:
     bool supportsTransformations() const;
 
@@ -912,5 +914,50 @@ void tst_QStaticText::multiLine()
     QCOMPARE(paintEngine->differentVerticalPositions.size(), 2);
 }
 
+void tst_QStaticText::drawStaticTexts()
+{
+    QFont underlinedFont = QGuiApplication::font();
+    underlinedFont.setUnderline(true);
+
+    QVector<QStaticText> texts;
+    QVector<QPointF> positions;
+    for (int i = 0; i < 20; ++i) {
+        QStaticText text(QString::fromLatin1("Lorem ipsum %1").arg(i));
+        text.setTextFormat(Qt::PlainText);
+        texts.append(text);
+        positions.append(QPointF(10 + (i % 3) * 300, 10 + i * 40));
+    }
+    texts.append(QStaticText(QLatin1String("<b>bold</b> and <font color=\"red\">red</font>")));
+    positions.append(QPointF(10, 900));
+
+    QPixmap imageDrawStaticText(1000, 1000);
+    imageDrawStaticText.fill(Qt::white);
+    {
+        QPainter p(&imageDrawStaticText);
+        p.setPen(Qt::blue);
+        for (int i = 0; i < texts.size(); ++i)
+            p.drawStaticText(positions.at(i), texts.at(i));
+        p.setFont(underlinedFont);
+        for (int i = 0; i < texts.size(); ++i)
+            p.drawStaticText(positions.at(i) + QPointF(0, 20), texts.at(i));
+    }
+
+    QPixmap imageDrawStaticTexts(1000, 1000);
+    imageDrawStaticTexts.fill(Qt::white);
+    {
+        QPainter p(&imageDrawStaticTexts);
+        p.setPen(Qt::blue);
+        p.drawStaticTexts(positions.constData(), texts.constData(), texts.size());
+        QVector<QPointF> shiftedPositions;
+        for (const QPointF &position : qAsConst(positions))
+            shiftedPositions.append(position + QPointF(0, 20));
+        p.setFont(underlinedFont);
+        p.drawStaticTexts(shiftedPositions.constData(), texts.constData(), texts.size());
+    }
+
+    QVERIFY(imageDrawStaticText.toImage() != m_whiteSquare);
+    QCOMPARE(imageDrawStaticTexts, imageDrawStaticText);
+}
+
 QTEST_MAIN(tst_QStaticText)
 #include "tst_qstatictext.moc"
@@ -48,6 +48,7 @@
 #include <qimage.h>
 #include <qtextlayout.h>
 #include <QDomDocument>
+#include <private/qtextdocument_p.h>
 #include "common.h"
 
 
@@ -188,6 +189,8 @@ private slots:
 
     void lineHeightType();
     void cssLineHeightMultiplier();
+    void maximumUndoSteps();
+    void maximumUndoStepsCompressesText();
 private:
     void backgroundImage_checkExpectedHtml(const QTextDocument &doc);
     void buildRegExpData();
@@ -3473,5 +3476,61 @@ void tst_QTextDocument::cssLineHeightMultiplier()
     }
 }
 
+void tst_QTextDocument::maximumUndoSteps()
+{
+    QCOMPARE(doc->maximumUndoSteps(), 0);
+    doc->setMaximumUndoSteps(3);
+    QCOMPARE(doc->maximumUndoSteps(), 3);
+
+    for (int i = 0; i < 5; ++i) {
+        cursor.beginEditBlock();
+        cursor.insertText(QString::number(i));
+        cursor.insertBlock();
+        cursor.endEditBlock();
+    }
+    QCOMPARE(doc->toPlainText(), QString("0\n1\n2\n3\n4\n"));
+
+    int undoCount = 0;
+    while (doc->isUndoAvailable()) {
+        doc->undo();
+        ++undoCount;
+    }
+    QCOMPARE(undoCount, 3);
+    QCOMPARE(doc->toPlainText(), QString("0\n1\n"));
+
+    while (doc->isRedoAvailable())
+        doc->redo();
+    QCOMPARE(doc->toPlainText(), QString("0\n1\n2\n3\n4\n"));
+
+    // lowering the limit trims the existing history
+    doc->setMaximumUndoSteps(1);
+    doc->undo();
+    QVERIFY(!doc->isUndoAvailable());
+    QCOMPARE(doc->toPlainText(), QString("0\n1\n2\n3\n"));
+}
+
+void tst_QTextDocument::maximumUndoStepsCompressesText()
+{
+    doc->setMaximumUndoSteps(2);
+
+    const QString chunk(4096, QLatin1Char('x'));
+    const int iterations = 100;
+    for (int i = 0; i < iterations; ++i) {
+        cursor.insertText(chunk);
+        cursor.movePosition(QTextCursor::Start, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
+    }
+    QVERIFY(doc->isEmpty());
+
+    // text that is no longer reachable through the undo stack gets dropped
+    QVERIFY(doc->docHandle()->buffer().size() < iterations * chunk.size() / 4);
+
+    doc->undo();
+    QCOMPARE(doc->toPlainText(), chunk);
+    doc->undo();
+    QVERIFY(doc->isEmpty());
+    QVERIFY(!doc->isUndoAvailable());
+}
+
 QTEST_MAIN(tst_QTextDocument)
 #include "tst_qtextdocument.moc"
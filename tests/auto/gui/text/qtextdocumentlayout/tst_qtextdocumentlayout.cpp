@@ -34,6 +34,7 @@
 #include <qdebug.h>
 #include <qpainter.h>
 #include <qtexttable.h>
+#include <private/qtextdocumentlayout_p.h>
 #ifndef QT_NO_WIDGETS
 #include <qtextedit.h>
 #include <qscrollbar.h>
@@ -58,6 +59,7 @@ private slots:
     void floatingTablePageBreak();
     void imageAtRightAlignedTab();
     void blockVisibility();
+    void parallelLayout();
 
 private:
     QTextDocument *doc;
@@ -344,5 +346,55 @@ void tst_QTextDocumentLayout::blockVisibility()
     QCOMPARE(doc->size(), halfSize);
 }
 
+void tst_QTextDocumentLayout::parallelLayout()
+{
+    QString html;
+    for (int i = 0; i < 200; ++i) {
+        switch (i % 5) {
+        case 0:
+            html += QStringLiteral("<p>Paragraph %1 with some text that wraps over a few lines, at least when the page is narrow.</p>").arg(i);
+            break;
+        case 1:
+            html += QStringLiteral("<p style=\"margin-left: 20px; text-indent: 30px\">Indented paragraph %1 with a first line indent.</p>").arg(i);
+            break;
+        case 2:
+            html += QStringLiteral("<p dir=\"rtl\">\u05e9\u05dc\u05d5\u05dd \u05e2\u05d5\u05dc\u05dd %1 \u05e9\u05dc\u05d5\u05dd \u05e2\u05d5\u05dc\u05dd \u05e9\u05dc\u05d5\u05dd \u05e2\u05d5\u05dc\u05dd</p>").arg(i);
+            break;
+        case 3:
+            html += QStringLiteral("<ul><li>List item %1</li><li>averyveryveryveryveryveryveryveryveryveryverylongword</li></ul>").arg(i);
+            break;
+        default:
+            html += QStringLiteral("<p style=\"line-height: 150%\"><b>Bold</b> and <i>italic</i> text %1\twith a tab.</p>").arg(i);
+            break;
+        }
+        if (i == 100)
+            html += QStringLiteral("<table border=\"1\"><tr><td>Cell</td><td>Another cell</td></tr></table>");
+    }
+
+    QTextDocument sequential;
+    sequential.setHtml(html);
+    sequential.setTextWidth(200);
+
+    QTextDocument parallel;
+    QTextDocumentLayout *layout = new QTextDocumentLayout(&parallel);
+    QVERIFY(!layout->isParallelLayoutEnabled());
+    layout->setParallelLayoutEnabled(true);
+    QVERIFY(layout->isParallelLayoutEnabled());
+    parallel.setDocumentLayout(layout);
+    parallel.setHtml(html);
+    parallel.setTextWidth(200);
+
+    QCOMPARE(parallel.size(), sequential.size());
+    QCOMPARE(parallel.blockCount(), sequential.blockCount());
+    for (QTextBlock a = sequential.begin(), b = parallel.begin(); a.isValid(); a = a.next(), b = b.next()) {
+        QCOMPARE(b.layout()->position(), a.layout()->position());
+        QCOMPARE(b.layout()->lineCount(), a.layout()->lineCount());
+        for (int i = 0; i < a.layout()->lineCount(); ++i) {
+            QCOMPARE(b.layout()->lineAt(i).textStart(), a.layout()->lineAt(i).textStart());
+            QCOMPARE(b.layout()->lineAt(i).rect(), a.layout()->lineAt(i).rect());
+        }
+    }
+}
+
 QTEST_MAIN(tst_QTextDocumentLayout)
 #include "tst_qtextdocumentlayout.moc"
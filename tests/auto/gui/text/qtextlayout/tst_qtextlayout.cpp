@@ -38,6 +38,7 @@
 
 #include <private/qtextengine_p.h>
 #include <qtextlayout.h>
+#include <qpainter.h>
 
 #include <qdebug.h>
 
@@ -137,6 +138,8 @@ private slots:
     void nbspWithFormat();
     void noModificationOfInputString();
     void superscriptCrash_qtbug53911();
+    void shapingCache();
+    void drawClippedLongLine();
 
 private:
     QFont testFont;
@@ -2291,5 +2294,95 @@ void tst_QTextLayout::nbspWithFormat()
     QCOMPARE(layout.lineAt(1).textLength(), s2.length() + 1 + s3.length());
 }
 
+static QTextLayout *layoutSingleLine(const QString &text, const QFont &font)
+{
+    QTextLayout *layout = new QTextLayout(text, font);
+    layout->setCacheEnabled(true);
+    layout->beginLayout();
+    layout->createLine();
+    layout->endLayout();
+    return layout;
+}
+
+void tst_QTextLayout::shapingCache()
+{
+    const QString text = QStringLiteral("shaping cache");
+
+    QScopedPointer<QTextLayout> reference(layoutSingleLine(text, testFont));
+    const QList<QGlyphRun> referenceRuns = reference->glyphRuns();
+    QVERIFY(!referenceRuns.isEmpty());
+    const qreal referenceWidth = reference->lineAt(0).naturalTextWidth();
+
+    // A second layout of the same text reuses the shaped glyphs
+    QScopedPointer<QTextLayout> cached(layoutSingleLine(text, testFont));
+    QCOMPARE(cached->glyphRuns(), referenceRuns);
+    QCOMPARE(cached->lineAt(0).naturalTextWidth(), referenceWidth);
+
+    // Letter spacing is applied on top of the shaped run and must not
+    // end up in the cached glyphs
+    QFont spacedFont = testFont;
+    spacedFont.setLetterSpacing(QFont::AbsoluteSpacing, 2);
+    QScopedPointer<QTextLayout> spaced(layoutSingleLine(text, spacedFont));
+    QVERIFY(spaced->lineAt(0).naturalTextWidth() > referenceWidth);
+    cached.reset(layoutSingleLine(text, testFont));
+    QCOMPARE(cached->lineAt(0).naturalTextWidth(), referenceWidth);
+    QCOMPARE(cached->glyphRuns(), referenceRuns);
+
+    // The same text with a different capitalization is shaped separately
+    QFont upperCaseFont = testFont;
+    upperCaseFont.setCapitalization(QFont::AllUppercase);
+    QScopedPointer<QTextLayout> upperCase(layoutSingleLine(text, upperCaseFont));
+    QScopedPointer<QTextLayout> upperCaseText(layoutSingleLine(text.toUpper(), testFont));
+    QCOMPARE(upperCase->glyphRuns().size(), 1);
+    QCOMPARE(upperCaseText->glyphRuns().size(), 1);
+    QCOMPARE(upperCase->glyphRuns().first().glyphIndexes(),
+             upperCaseText->glyphRuns().first().glyphIndexes());
+#ifndef QT_BUILD_INTERNAL
+    // the box engine used for internal builds has the same glyph for every character
+    QVERIFY(upperCase->glyphRuns().first().glyphIndexes() != referenceRuns.first().glyphIndexes());
+#endif
+}
+
+void tst_QTextLayout::drawClippedLongLine()
+{
+    QString text;
+    for (int i = 0; i < 2000; ++i)
+        text += QLatin1String("clipped drawing ");
+
+    QTextLayout layout(text, testFont);
+    QTextOption option;
+    option.setWrapMode(QTextOption::NoWrap);
+    layout.setTextOption(option);
+    layout.beginLayout();
+    layout.createLine();
+    layout.endLayout();
+    QVERIFY(layout.lineAt(0).naturalTextWidth() > 10000);
+
+    // draw a part from the middle of the line, with and without telling
+    // QTextLayout about the visible area
+    const QRectF visible(0, 0, 400, 40);
+    const QPointF position(-5000, 0);
+
+    QImage unclipped(visible.size().toSize(), QImage::Format_ARGB32_Premultiplied);
+    unclipped.fill(Qt::white);
+    {
+        QPainter p(&unclipped);
+        layout.draw(&p, position);
+    }
+
+    QImage clipped(visible.size().toSize(), QImage::Format_ARGB32_Premultiplied);
+    clipped.fill(Qt::white);
+    {
+        QPainter p(&clipped);
+        layout.draw(&p, position, QVector<QTextLayout::FormatRange>(), visible);
+    }
+
+    QCOMPARE(clipped, unclipped);
+
+    QImage blank(visible.size().toSize(), QImage::Format_ARGB32_Premultiplied);
+    blank.fill(Qt::white);
+    QVERIFY(clipped != blank);
+}
+
 QTEST_MAIN(tst_QTextLayout)
 #include "tst_qtextlayout.moc"
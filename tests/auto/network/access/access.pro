@@ -1,6 +1,7 @@
 TEMPLATE=subdirs
 SUBDIRS=\
    qnetworkdiskcache \
+   qnetworkmemorycache \
    qnetworkcookiejar \
    qnetworkaccessmanager \
    qnetworkcookie \
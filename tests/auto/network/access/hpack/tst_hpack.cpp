@@ -53,6 +53,7 @@ private Q_SLOTS:
     void bitstreamWrite();
     void bitstreamReadWrite();
     void bitstreamCompression();
+    void bitstreamCompressionAllOctets();
     void bitstreamErrors();
 
     void lookupTableConstructor();
@@ -318,6 +319,29 @@ void tst_Hpack::bitstreamCompression()
     }
 }
 
+void tst_Hpack::bitstreamCompressionAllOctets()
+{
+    // Every octet value (including those >= 0x80) must survive
+    // Huffman encoding and decoding, at any string length.
+    QByteArray data;
+    for (int i = 0; i < 256; ++i)
+        data.append(char(i));
+
+    for (int length = 0; length <= data.size(); length += 17) {
+        const QByteArray src(data.left(length));
+        std::vector<uchar> buffer;
+        BitOStream out(buffer);
+        out.write(src, true);
+
+        BitIStream in(out.begin(), out.end());
+        QByteArray decoded;
+        QVERIFY(in.read(&decoded));
+        QCOMPARE(in.error(), StreamError::NoError);
+        QCOMPARE(decoded, src);
+        QVERIFY(!in.hasMoreBits());
+    }
+}
+
 void tst_Hpack::bitstreamErrors()
 {
     {
@@ -46,6 +46,7 @@ private Q_SLOTS:
     void testSingleKnownHost_data();
     void testSingleKnownHost();
     void testMultilpeKnownHosts();
+    void testManyKnownHosts();
     void testPolicyExpiration();
     void testSTSHeaderParser();
     void testStore();
@@ -172,6 +173,31 @@ void tst_QHsts::testMultilpeKnownHosts()
     QVERIFY(!cache.isKnownHost(exampleCom));
 }
 
+void tst_QHsts::testManyKnownHosts()
+{
+    const QDateTime validDate(QDateTime::currentDateTimeUtc().addSecs(10000));
+    QHstsCache cache;
+    // add hosts in an order that is not sorted, to build the
+    // domain tree with siblings inserted before and after each other
+    for (int i = 0; i < 100; ++i) {
+        const int n = (i * 37) % 100;
+        const QString host = QString::fromLatin1("host%1.domain%2.example%3.org")
+                                 .arg(n).arg(n % 10).arg(n % 3);
+        cache.updateKnownHost(QUrl(QLatin1String("https://") + host), validDate, n % 2);
+    }
+    QCOMPARE(cache.policies().size(), 100);
+
+    for (int n = 0; n < 100; ++n) {
+        const QString host = QString::fromLatin1("host%1.domain%2.example%3.org")
+                                 .arg(n).arg(n % 10).arg(n % 3);
+        QVERIFY(cache.isKnownHost(QUrl(QLatin1String("https://") + host)));
+        QCOMPARE(cache.isKnownHost(QUrl(QLatin1String("https://sub.") + host)), bool(n % 2));
+        QVERIFY(!cache.isKnownHost(QUrl(QLatin1String("https://") + host.mid(host.indexOf('.') + 1))));
+    }
+    QVERIFY(!cache.isKnownHost(QUrl(QLatin1String("https://host100.domain0.example1.org"))));
+    QVERIFY(!cache.isKnownHost(QUrl(QLatin1String("https://org"))));
+}
+
 void tst_QHsts::testPolicyExpiration()
 {
     QDateTime currentUTC = QDateTime::currentDateTimeUtc();
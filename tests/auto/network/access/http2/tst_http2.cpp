@@ -71,6 +71,7 @@ private slots:
     void multipleRequests();
     void flowControlClientSide();
     void flowControlServerSide();
+    void flowControlWindowScaling();
     void pushPromise();
     void goaway_data();
     void goaway();
@@ -317,6 +318,46 @@ void tst_Http2::flowControlServerSide()
     QVERIFY(serverGotSettingsACK);
 }
 
+void tst_Http2::flowControlWindowScaling()
+{
+    // A stream that keeps exhausting its receive window must have this
+    // window enlarged, otherwise a large download would need one WINDOW_UPDATE
+    // (and one round trip) per each initial window size of data.
+    using namespace Http2;
+
+    clearHTTP2State();
+
+    serverPort = 0;
+    nRequests = 1;
+    windowUpdates = 0;
+
+    Http2::ProtocolParameters params;
+    params.settingsFrameData[Settings::INITIAL_WINDOW_SIZE_ID] = Http2::defaultSessionWindowSize;
+    manager.setProperty(Http2::http2ParametersPropertyName, QVariant::fromValue(params));
+
+    ServerPtr srv(newServer(defaultServerSettings, params));
+
+    const QByteArray respond(int(Http2::defaultSessionWindowSize * 64), 'x');
+    srv->setResponseBody(respond);
+
+    QMetaObject::invokeMethod(srv.data(), "startServer", Qt::QueuedConnection);
+
+    runEventLoop();
+    QVERIFY(serverPort != 0);
+
+    sendRequest(1);
+
+    runEventLoop(120000);
+
+    QVERIFY(nRequests == 0);
+    QVERIFY(prefaceOK);
+    QVERIFY(serverGotSettingsACK);
+    // With a fixed window we'd need ~64 updates, doubling the window
+    // gives us log2(64) + 1:
+    QVERIFY(windowUpdates > 0);
+    QVERIFY(windowUpdates <= 8);
+}
+
 void tst_Http2::pushPromise()
 {
     // We will first send some request, the server should reply and also emulate
@@ -47,6 +47,8 @@ private slots:
     void setCookiesFromUrl();
     void cookiesForUrl_data();
     void cookiesForUrl();
+    void insertionOrder();
+    void removeExpiredCookies();
 #ifdef QT_BUILD_INTERNAL
     void effectiveTLDs_data();
     void effectiveTLDs();
@@ -351,6 +353,36 @@ void tst_QNetworkCookieJar::cookiesForUrl_data()
     result.clear();
     result += rootCookie;
     QTest::newRow("root-path-match") << allCookies << "http://qt-project.org" << result;
+
+    // Cookies for several domains, only the host and its parents match
+    allCookies.clear();
+    QNetworkCookie parentCookie;
+    parentCookie.setName("a");
+    parentCookie.setPath("/");
+    parentCookie.setDomain(".qt-project.org");
+    QNetworkCookie hostCookie;
+    hostCookie.setName("b");
+    hostCookie.setPath("/web");
+    hostCookie.setDomain("www.qt-project.org");
+    QNetworkCookie hostDotCookie;
+    hostDotCookie.setName("c");
+    hostDotCookie.setPath("/");
+    hostDotCookie.setDomain(".www.qt-project.org");
+    QNetworkCookie otherCookie;
+    otherCookie.setName("d");
+    otherCookie.setPath("/");
+    otherCookie.setDomain(".other.org");
+    QNetworkCookie parentHostOnlyCookie;
+    parentHostOnlyCookie.setName("e");
+    parentHostOnlyCookie.setPath("/");
+    parentHostOnlyCookie.setDomain("qt-project.org");
+    allCookies << parentCookie << hostCookie << hostDotCookie << otherCookie << parentHostOnlyCookie;
+    result.clear();
+    result << hostCookie << parentCookie << hostDotCookie;
+    QTest::newRow("parent-domains") << allCookies << "http://www.qt-project.org/web" << result;
+    result.clear();
+    result << parentCookie << parentHostOnlyCookie;
+    QTest::newRow("parent-domains-2") << allCookies << "http://qt-project.org/web" << result;
 }
 
 void tst_QNetworkCookieJar::cookiesForUrl()
@@ -366,6 +398,55 @@ void tst_QNetworkCookieJar::cookiesForUrl()
     QCOMPARE(result, expectedResult);
 }
 
+void tst_QNetworkCookieJar::insertionOrder()
+{
+    MyCookieJar jar;
+    QList<QNetworkCookie> expected;
+    for (int i = 0; i < 6; ++i) {
+        QNetworkCookie cookie;
+        cookie.setName(QByteArray::number(i));
+        cookie.setPath("/");
+        cookie.setDomain(i % 2 ? ".qt-project.org" : ".example.com");
+        QVERIFY(jar.insertCookie(cookie));
+        expected << cookie;
+    }
+    QCOMPARE(jar.allCookies(), expected);
+
+    // a replaced cookie moves to the end
+    QNetworkCookie cookie = expected.takeAt(1);
+    cookie.setValue("new");
+    QVERIFY(jar.updateCookie(cookie));
+    expected << cookie;
+    QCOMPARE(jar.allCookies(), expected);
+
+    QVERIFY(jar.deleteCookie(expected.takeFirst()));
+    QCOMPARE(jar.allCookies(), expected);
+    QVERIFY(!jar.deleteCookie(QNetworkCookie("none")));
+}
+
+void tst_QNetworkCookieJar::removeExpiredCookies()
+{
+    MyCookieJar jar;
+    QNetworkCookie expired("expired", "value");
+    expired.setDomain(".qt-project.org");
+    expired.setPath("/");
+    expired.setExpirationDate(QDateTime::currentDateTimeUtc().addDays(-1));
+    jar.setAllCookies(QList<QNetworkCookie>() << expired);
+    QCOMPARE(jar.allCookies().count(), 1);
+    QVERIFY(jar.cookiesForUrl(QUrl("http://www.qt-project.org/")).isEmpty());
+
+    // the jar drops expired cookies while new ones are inserted
+    for (int i = 0; i < 100; ++i) {
+        QNetworkCookie cookie(QByteArray::number(i), "value");
+        cookie.setDomain(".qt-project.org");
+        cookie.setPath("/");
+        QVERIFY(jar.insertCookie(cookie));
+    }
+    QCOMPARE(jar.allCookies().count(), 100);
+    QVERIFY(!jar.allCookies().contains(expired));
+    QCOMPARE(jar.cookiesForUrl(QUrl("http://www.qt-project.org/")).count(), 100);
+}
+
 // This test requires private API.
 #ifdef QT_BUILD_INTERNAL
 void tst_QNetworkCookieJar::effectiveTLDs_data()
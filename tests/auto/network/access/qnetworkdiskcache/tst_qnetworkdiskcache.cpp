@@ -69,6 +69,8 @@ private slots:
     void updateMetaData();
     void fileMetaData();
     void expire();
+    void expireLeastRecentlyUsed();
+    void index();
 
     void oldCacheVersionFile_data();
     void oldCacheVersionFile();
@@ -529,6 +531,104 @@ void tst_QNetworkDiskCache::expire()
     }
 }
 
+static void insertItem(QNetworkDiskCache *cache, int i, int size)
+{
+    QNetworkCacheMetaData m;
+    m.setUrl(QUrl("http://localhost:4/" + QString::number(i)));
+    QIODevice *d = cache->prepare(m);
+    d->write(QByteArray(size, 'Z'));
+    cache->insert(d);
+}
+
+void tst_QNetworkDiskCache::expireLeastRecentlyUsed()
+{
+    QTemporaryDir dir(QDir::tempPath() + "/tst_qnetworkdiskcache-lru.XXXXXX");
+    QVERIFY(dir.isValid());
+    SubQNetworkDiskCache cache;
+    cache.setCacheDirectory(dir.path());
+    cache.setMaximumCacheSize(1024 * 1024);
+
+    const int size = 1024 * 1024 / 5;
+    for (int i = 0; i < 4; ++i)
+        insertItem(&cache, i, size);
+
+    // reading the oldest item makes it the most recently used one
+    QScopedPointer<QIODevice> device(cache.data(QUrl("http://localhost:4/0")));
+    QVERIFY(device);
+    device.reset();
+
+    insertItem(&cache, 4, size);
+    insertItem(&cache, 5, size);
+    QVERIFY(cache.call_expire() < cache.maximumCacheSize());
+
+    QVERIFY(cache.metaData(QUrl("http://localhost:4/0")).isValid());
+    QVERIFY(!cache.metaData(QUrl("http://localhost:4/1")).isValid());
+    QVERIFY(cache.metaData(QUrl("http://localhost:4/5")).isValid());
+}
+
+void tst_QNetworkDiskCache::index()
+{
+    QTemporaryDir dir(QDir::tempPath() + "/tst_qnetworkdiskcache-index.XXXXXX");
+    QVERIFY(dir.isValid());
+    const QString path = dir.path();
+    const auto cacheFiles = [&path]() {
+        QStringList files = countFiles(path + "/data8");
+        files.erase(std::remove_if(files.begin(), files.end(),
+                                   [](const QString &f) { return !f.endsWith(".d"); }),
+                    files.end());
+        return files;
+    };
+    const auto filesSize = [&cacheFiles]() {
+        qint64 size = 0;
+        for (const QString &file : cacheFiles())
+            size += QFileInfo(file).size();
+        return size;
+    };
+
+    {
+        QNetworkDiskCache cache;
+        cache.setCacheDirectory(path);
+        for (int i = 0; i < 3; ++i)
+            insertItem(&cache, i, 1024);
+    }
+
+    // the index is written on destruction and consumed when read back
+    const QString indexFile = path + "/data8/index";
+    QVERIFY(QFile::exists(indexFile));
+    {
+        SubQNetworkDiskCache cache;
+        cache.setCacheDirectory(path);
+        QCOMPARE(cache.cacheSize(), filesSize());
+        QVERIFY(!QFile::exists(indexFile));
+
+        // a cache file removed behind the back of the cache is forgotten
+        const QStringList files = cacheFiles();
+        QCOMPARE(files.count(), 3);
+        QVERIFY(QFile::remove(files.first()));
+        cache.clear();
+        QCOMPARE(cache.cacheSize(), qint64(0));
+        QCOMPARE(countFiles(path + "/data8").count(), NUM_SUBDIRECTORIES);
+    }
+
+    // a corrupted index makes the cache look at the files again
+    {
+        QNetworkDiskCache cache;
+        cache.setCacheDirectory(path);
+        insertItem(&cache, 0, 1024);
+    }
+    {
+        QFile file(indexFile);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(file.size() - 1));
+    }
+    {
+        SubQNetworkDiskCache cache;
+        cache.setCacheDirectory(path);
+        QCOMPARE(cache.cacheSize(), filesSize());
+        QVERIFY(cache.metaData(QUrl("http://localhost:4/0")).isValid());
+    }
+}
+
 void tst_QNetworkDiskCache::oldCacheVersionFile_data()
 {
     QTest::addColumn<int>("pass");
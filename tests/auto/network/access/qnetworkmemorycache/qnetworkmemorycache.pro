@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qnetworkmemorycache
+QT = core network testlib
+SOURCES  += tst_qnetworkmemorycache.cpp
@@ -331,6 +331,9 @@ private Q_SLOTS:
     void ioPostToHttpFromMiddleOfFileFiveBytes();
     void ioPostToHttpFromMiddleOfQBufferFiveBytes();
     void ioPostToHttpNoBufferFlag();
+    void ioPostToHttpChunked_data();
+    void ioPostToHttpChunked();
+    void ioPostToHttpChunkedRedirect();
     void ioPostToHttpUploadProgress();
     void emitAllUploadProgressSignals();
     void ioPostToHttpEmptyUploadProgress();
@@ -382,6 +385,12 @@ private Q_SLOTS:
     void httpReUsingConnectionSequential();
     void httpReUsingConnectionFromFinishedSlot_data();
     void httpReUsingConnectionFromFinishedSlot();
+    void httpMaximumConnectionsPerHost_data();
+    void httpMaximumConnectionsPerHost();
+    void httpRunInManagerThread();
+    void httpConnectionIdleTimeout_data();
+    void httpConnectionIdleTimeout();
+    void connectToHostOpensConnections();
 
     void httpRecursiveCreation();
 
@@ -418,6 +427,9 @@ private Q_SLOTS:
     void ioGetFromHttpBrokenChunkedEncoding();
     void qtbug12908compressedHttpReply();
     void compressedHttpReplyBrokenGzip();
+    void compressedHttpReplyEncodings_data();
+    void compressedHttpReplyEncodings();
+    void compressedHttpUpload();
 
     void getFromUnreachableIp();
 
@@ -938,6 +950,78 @@ public:
     }
 };
 
+// Receives one request with a chunked or Content-Length delimited body and
+// answers it once the body is complete. With echoBody, the answer is
+// dataToTransmit, which must end in header fields, followed by the body.
+class UploadServer : public QTcpServer
+{
+    Q_OBJECT
+public:
+    QByteArray dataToTransmit;
+    QByteArray receivedHeader;
+    QByteArray receivedBody;
+    bool echoBody;
+
+    UploadServer(const QByteArray &data, bool echo = false)
+        : dataToTransmit(data), echoBody(echo)
+    {
+        listen(QHostAddress::LocalHost);
+        connect(this, SIGNAL(newConnection()), this, SLOT(newConnectionSlot()));
+    }
+
+private slots:
+    void newConnectionSlot()
+    {
+        QTcpSocket *client = nextPendingConnection();
+        connect(client, SIGNAL(readyRead()), this, SLOT(readyReadSlot()));
+    }
+
+    void readyReadSlot()
+    {
+        QTcpSocket *client = qobject_cast<QTcpSocket *>(sender());
+        received += client->readAll();
+        const int endOfHeader = received.indexOf("\r\n\r\n");
+        if (endOfHeader == -1)
+            return;
+        receivedHeader = received.left(endOfHeader + 4);
+
+        QByteArray body;
+        int pos = endOfHeader + 4;
+        const int lengthIndex = receivedHeader.indexOf("Content-Length: ");
+        if (lengthIndex != -1) {
+            const int endOfLength = receivedHeader.indexOf("\r\n", lengthIndex);
+            const int length = receivedHeader.mid(lengthIndex + 16, endOfLength - lengthIndex - 16).toInt();
+            if (received.size() < pos + length)
+                return;
+            body = received.mid(pos, length);
+        } else {
+            // decode the chunks, wait for more if one is incomplete
+            forever {
+                const int endOfLine = received.indexOf("\r\n", pos);
+                if (endOfLine == -1)
+                    return;
+                bool ok;
+                const int chunkSize = received.mid(pos, endOfLine - pos).toInt(&ok, 16);
+                if (!ok || received.size() < endOfLine + 2 + chunkSize + 2)
+                    return;
+                if (chunkSize == 0)
+                    break;
+                body += received.mid(endOfLine + 2, chunkSize);
+                pos = endOfLine + 2 + chunkSize + 2;
+            }
+        }
+
+        receivedBody = body;
+        received.clear();
+        client->write(dataToTransmit);
+        if (echoBody)
+            client->write("Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n" + body);
+    }
+
+private:
+    QByteArray received;
+};
+
 // A blocking tcp server (must be used in a thread) which supports SSL.
 class BlockingTcpServer : public QTcpServer
 {
@@ -4812,6 +4896,70 @@ void tst_QNetworkReply::ioPostToHttpNoBufferFlag()
     QCOMPARE(reply->error(), QNetworkReply::ContentReSendError);
 }
 
+void tst_QNetworkReply::ioPostToHttpChunked_data()
+{
+    QTest::addColumn<bool>("doNotBuffer");
+    QTest::addColumn<QVariant>("bufferLimit");
+
+    QTest::newRow("no-buffering") << true << QVariant();
+    QTest::newRow("buffer-limit") << false << QVariant(qint64(1024));
+}
+
+void tst_QNetworkReply::ioPostToHttpChunked()
+{
+    QFETCH(bool, doNotBuffer);
+    QFETCH(QVariant, bufferLimit);
+
+    QByteArray data(100*1024, 'd');
+    // create a sequential QIODevice of unknown size by feeding the data into a local TCP server
+    SocketPair socketpair;
+    QTRY_VERIFY(socketpair.create()); //QTRY_VERIFY as a workaround for QTBUG-24451
+    socketpair.endPoints[0]->write(data);
+
+    UploadServer server("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+    QUrl url("http://localhost/");
+    url.setPort(server.serverPort());
+    QNetworkRequest request(url);
+    request.setRawHeader("Content-Type", "application/octet-stream");
+    request.setAttribute(QNetworkRequest::DoNotBufferUploadDataAttribute, doNotBuffer);
+    request.setAttribute(QNetworkRequest::MaximumUploadBufferSizeAttribute, bufferLimit);
+    QNetworkReplyPtr reply(manager.post(request, socketpair.endPoints[1]));
+    static_cast<QTcpSocket *>(socketpair.endPoints[0])->waitForBytesWritten(5000);
+    socketpair.endPoints[0]->close();
+
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    QCOMPARE(reply->readAll(), QByteArray("ok"));
+    QVERIFY(server.receivedHeader.contains("Transfer-Encoding: chunked\r\n"));
+    QVERIFY(!server.receivedHeader.contains("Content-Length"));
+    QCOMPARE(server.receivedBody.size(), data.size());
+    QCOMPARE(server.receivedBody, data);
+}
+
+void tst_QNetworkReply::ioPostToHttpChunkedRedirect()
+{
+    QByteArray data("daaaaaaataaaaaaa");
+    SocketPair socketpair;
+    QTRY_VERIFY(socketpair.create()); //QTRY_VERIFY as a workaround for QTBUG-24451
+    socketpair.endPoints[0]->write(data);
+
+    UploadServer server("HTTP/1.1 307 Temporary Redirect\r\n"
+                               "Location: /target\r\n"
+                               "Content-Length: 0\r\n\r\n");
+    QUrl url("http://localhost/");
+    url.setPort(server.serverPort());
+    QNetworkRequest request(url);
+    request.setRawHeader("Content-Type", "application/octet-stream");
+    request.setAttribute(QNetworkRequest::DoNotBufferUploadDataAttribute, true);
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    QNetworkReplyPtr reply(manager.post(request, socketpair.endPoints[1]));
+    socketpair.endPoints[0]->close();
+
+    // the streamed data is gone, it cannot be sent to the redirect target
+    QCOMPARE(waitForFinish(reply), int(Failure));
+    QCOMPARE(reply->error(), QNetworkReply::ContentReSendError);
+    QCOMPARE(server.receivedBody, data);
+}
+
 #ifndef QT_NO_SSL
 class SslServer : public QTcpServer
 {
@@ -6065,6 +6213,131 @@ void tst_QNetworkReply::httpReUsingConnectionFromFinishedSlot()
     QCOMPARE(server.totalConnections, 1);
 }
 
+void tst_QNetworkReply::httpMaximumConnectionsPerHost_data()
+{
+    QTest::addColumn<QVariant>("attribute");
+    QTest::addColumn<int>("expectedConnections");
+
+    QTest::newRow("default") << QVariant() << 6;
+    QTest::newRow("2") << QVariant(2) << 2;
+    QTest::newRow("12") << QVariant(12) << 12;
+}
+
+void tst_QNetworkReply::httpMaximumConnectionsPerHost()
+{
+    QFETCH(QVariant, attribute);
+    QFETCH(int, expectedConnections);
+
+    // the server never replies, so every request keeps its connection busy
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QSignalSpy connectionSpy(&server, SIGNAL(newConnection()));
+
+    QUrl url;
+    url.setScheme("http");
+    url.setHost("127.0.0.1");
+    url.setPort(server.serverPort());
+    QNetworkRequest request(url);
+    if (attribute.isValid())
+        request.setAttribute(QNetworkRequest::MaximumConnectionsPerHostAttribute, attribute);
+
+    QNetworkAccessManager manager;
+    QList<QNetworkReply *> replies;
+    for (int i = 0; i < 16; ++i)
+        replies << manager.get(request);
+
+    QTRY_COMPARE(connectionSpy.count(), expectedConnections);
+    QTest::qWait(200);
+    QCOMPARE(connectionSpy.count(), expectedConnections);
+
+    for (QNetworkReply *reply : qAsConst(replies)) {
+        reply->abort();
+        delete reply;
+    }
+}
+
+void tst_QNetworkReply::httpRunInManagerThread()
+{
+    QByteArray response("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nHello");
+    MiniHttpServer server(response);
+    server.multiple = true;
+    server.doClose = false;
+
+    QUrl url;
+    url.setScheme("http");
+    url.setPort(server.serverPort());
+    url.setHost("127.0.0.1");
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::HttpRunInManagerThreadAttribute, true);
+
+    for (int i = 0; i < 3; ++i) {
+        QNetworkReplyPtr reply(manager.get(request));
+        QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QCOMPARE(reply->readAll(), QByteArray("Hello"));
+    }
+    // the connection is kept by the manager and reused
+    QCOMPARE(server.totalConnections, 1);
+}
+
+void tst_QNetworkReply::httpConnectionIdleTimeout_data()
+{
+    QTest::addColumn<QVariant>("attribute");
+    QTest::addColumn<int>("expectedConnections");
+
+    QTest::newRow("default") << QVariant() << 1;
+    QTest::newRow("0") << QVariant(0) << 2;
+    QTest::newRow("60") << QVariant(60) << 1;
+}
+
+void tst_QNetworkReply::httpConnectionIdleTimeout()
+{
+    QFETCH(QVariant, attribute);
+    QFETCH(int, expectedConnections);
+
+    QByteArray response("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nHello");
+    MiniHttpServer server(response);
+    server.multiple = true;
+    server.doClose = false;
+
+    QUrl url;
+    url.setScheme("http");
+    url.setPort(server.serverPort());
+    url.setHost("127.0.0.1");
+    QNetworkRequest request(url);
+    if (attribute.isValid())
+        request.setAttribute(QNetworkRequest::ConnectionIdleTimeoutAttribute, attribute);
+
+    QNetworkAccessManager manager;
+    QNetworkReplyPtr reply(manager.get(request));
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    reply.clear();
+
+    // give an expiring connection the chance to be closed
+    QTest::qWait(200);
+
+    reply.reset(manager.get(request));
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    QCOMPARE(reply->readAll(), QByteArray("Hello"));
+    QCOMPARE(server.totalConnections, expectedConnections);
+}
+
+void tst_QNetworkReply::connectToHostOpensConnections()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QSignalSpy connectionSpy(&server, SIGNAL(newConnection()));
+
+    // every call opens one more connection, up to six per host
+    QNetworkAccessManager manager;
+    for (int i = 0; i < 3; ++i)
+        manager.connectToHost(QStringLiteral("127.0.0.1"), server.serverPort());
+
+    QTRY_COMPARE(connectionSpy.count(), 3);
+    QTest::qWait(200);
+    QCOMPARE(connectionSpy.count(), 3);
+}
+
 class HttpRecursiveCreationHelper : public QObject
 {
     Q_OBJECT
@@ -6765,6 +7038,66 @@ void tst_QNetworkReply::compressedHttpReplyBrokenGzip()
     QCOMPARE(reply->error(), QNetworkReply::ProtocolFailure);
 }
 
+void tst_QNetworkReply::compressedHttpReplyEncodings_data()
+{
+    QTest::addColumn<QByteArray>("encoding");
+    QTest::addColumn<QByteArray>("encodedFile");
+
+    // dd if=/dev/zero of=qtbug-12908 bs=16384  count=1 && gzip qtbug-12908 && base64 -w 0 qtbug-12908.gz
+    QTest::newRow("gzip") << QByteArray("gzip")
+        << QByteArray("H4sICDdDaUwAA3F0YnVnLTEyOTA4AO3BMQEAAADCoPVPbQwfoAAAAAAAAAAAAAAAAAAAAIC3AYbSVKsAQAAA");
+#if QT_CONFIG(brotli)
+    // the same 16 kB of zeros, compressed with BrotliEncoderCompress()
+    QTest::newRow("br") << QByteArray("br") << QByteArray("G/8/+CcA4rFAIPcGAA==");
+#endif
+#if QT_CONFIG(zstd)
+    // head -c 16384 /dev/zero | zstd | base64 -w 0
+    QTest::newRow("zstd") << QByteArray("zstd") << QByteArray("KLUv/QRYTQAAEAAAAQD7nwdY7EUsMw==");
+#endif
+}
+
+void tst_QNetworkReply::compressedHttpReplyEncodings()
+{
+    QFETCH(QByteArray, encoding);
+    QFETCH(QByteArray, encodedFile);
+
+    const QByteArray decodedFile = QByteArray::fromBase64(encodedFile);
+    const QByteArray header = "HTTP/1.0 200 OK\r\nContent-Encoding: " + encoding
+            + "\r\nContent-Length: " + QByteArray::number(decodedFile.size()) + "\r\n\r\n";
+
+    MiniHttpServer server(header + decodedFile);
+    server.doClose = true;
+
+    QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+    QNetworkReplyPtr reply(manager.get(request));
+
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+
+    QVERIFY(server.receivedData.contains(encoding));
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->readAll(), QByteArray(16384, '\0'));
+}
+
+void tst_QNetworkReply::compressedHttpUpload()
+{
+    // the server sends the compressed body back, to be decompressed by the reply
+    UploadServer server("HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\n", true);
+    QUrl url("http://localhost/");
+    url.setPort(server.serverPort());
+    QNetworkRequest request(url);
+    request.setRawHeader("Content-Type", "text/plain");
+    request.setAttribute(QNetworkRequest::CompressUploadDataAttribute, true);
+
+    const QByteArray data = QByteArray("abcdefghij").repeated(10000);
+    QNetworkReplyPtr reply(manager.post(request, data));
+
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    QVERIFY(server.receivedHeader.contains("Content-Encoding: gzip\r\n"));
+    QVERIFY(server.receivedBody.startsWith("\x1f\x8b"));
+    QVERIFY(server.receivedBody.size() < data.size() / 10);
+    QCOMPARE(reply->readAll(), data);
+}
+
 // TODO add similar test for FTP
 void tst_QNetworkReply::getFromUnreachableIp()
 {
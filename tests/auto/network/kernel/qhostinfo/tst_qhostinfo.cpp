@@ -109,6 +109,7 @@ private slots:
     void multipleDifferentLookups();
 
     void cache();
+    void cacheHostNotFound();
 
     void abortHostLookup();
 protected slots:
@@ -642,6 +643,40 @@ void tst_QHostInfo::cache()
     QCOMPARE(lookupsDoneCounter, 2);
 }
 
+void tst_QHostInfo::cacheHostNotFound()
+{
+    QFETCH_GLOBAL(bool, cache);
+    if (!cache)
+        return; // test makes only sense when cache enabled
+
+    QHostInfo notFound;
+    notFound.setError(QHostInfo::HostNotFound);
+    notFound.setErrorString("Host not found");
+    qt_qhostinfo_cache_inject("notfound.invalid", notFound);
+
+    // a host known not to exist is answered from the cache
+    bool valid = false;
+    int id = -1;
+    QHostInfo result = qt_qhostinfo_lookup("notfound.invalid", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(valid);
+    QCOMPARE(result.error(), QHostInfo::HostNotFound);
+    QVERIFY(result.addresses().isEmpty());
+
+    // other errors may be temporary and are not cached
+    QHostInfo failed;
+    failed.setError(QHostInfo::UnknownError);
+    failed.setErrorString("Temporary failure");
+    qt_qhostinfo_cache_inject("failed.invalid", failed);
+
+    valid = true;
+    lookupsDoneCounter = 0;
+    result = qt_qhostinfo_lookup("failed.invalid", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(!valid);
+    QTestEventLoop::instance().enterLoop(10);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QCOMPARE(lookupsDoneCounter, 1);
+}
+
 void tst_QHostInfo::resultsReady(const QHostInfo &hi)
 {
     lookupDone = true;
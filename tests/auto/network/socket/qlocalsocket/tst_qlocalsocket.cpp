@@ -116,6 +116,8 @@ private slots:
     void verifyListenWithDescriptor();
     void verifyListenWithDescriptor_data();
 
+    void passFileDescriptors();
+
 };
 
 tst_QLocalSocket::tst_QLocalSocket()
@@ -1405,6 +1407,56 @@ void tst_QLocalSocket::verifyListenWithDescriptor_data()
 
 }
 
+void tst_QLocalSocket::passFileDescriptors()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("File descriptors can only be passed over Unix domain sockets");
+#else
+    const QString serverName = QLatin1String("tst_localsocket_descriptors");
+    LocalServer server;
+    QVERIFY(server.listen(serverName));
+
+    LocalSocket client;
+    client.connectToServer(serverName);
+    QVERIFY(server.waitForNewConnection(3000));
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+    QCOMPARE(client.state(), QLocalSocket::ConnectedState);
+
+    int pipeDescriptors[2];
+    QCOMPARE(::pipe(pipeDescriptors), 0);
+
+    // the descriptor leaves with the first byte of "second"
+    QCOMPARE(client.write("first"), qint64(5));
+    QVERIFY(client.writeFileDescriptor(pipeDescriptors[1]));
+    ::close(pipeDescriptors[1]);
+    QCOMPARE(client.fileDescriptorsAvailable(), 0);
+    QCOMPARE(client.write("second"), qint64(6));
+    while (client.bytesToWrite() > 0)
+        QVERIFY(client.waitForBytesWritten());
+
+    QByteArray received;
+    while (received.size() < 11) {
+        QVERIFY(serverSocket->waitForReadyRead());
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(received, QByteArray("firstsecond"));
+    QCOMPARE(serverSocket->fileDescriptorsAvailable(), 1);
+    const qintptr descriptor = serverSocket->readFileDescriptor();
+    QVERIFY(descriptor != -1);
+    QCOMPARE(serverSocket->fileDescriptorsAvailable(), 0);
+    QCOMPARE(serverSocket->readFileDescriptor(), qintptr(-1));
+
+    // writing to the received copy reaches the pipe
+    QCOMPARE(::write(int(descriptor), "pipe", 4), ssize_t(4));
+    ::close(int(descriptor));
+    char buffer[4];
+    QCOMPARE(::read(pipeDescriptors[0], buffer, 4), ssize_t(4));
+    QCOMPARE(QByteArray(buffer, 4), QByteArray("pipe"));
+    ::close(pipeDescriptors[0]);
+#endif
+}
+
 QTEST_MAIN(tst_QLocalSocket)
 #include "tst_qlocalsocket.moc"
 
@@ -95,6 +95,7 @@ private slots:
 #endif
     void listenWhileListening();
     void addressReusable();
+    void portSharing();
     void setNewSocketDescriptorBlocking();
 #ifndef QT_NO_NETWORKPROXY
     void invalidProxy_data();
@@ -632,6 +633,51 @@ void tst_QTcpServer::addressReusable()
 #endif
 }
 
+void tst_QTcpServer::portSharing()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("Connections are only balanced between sharing servers on Linux");
+#else
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        QSKIP("Port sharing does not apply to proxied servers");
+
+    QTcpServer server1;
+    QVERIFY(!server1.isPortSharingEnabled());
+    server1.setPortSharingEnabled(true);
+    QVERIFY(server1.isPortSharingEnabled());
+    QVERIFY2(server1.listen(QHostAddress::LocalHost), qPrintable(server1.errorString()));
+    const quint16 port = server1.serverPort();
+
+    QTcpServer server2;
+    server2.setPortSharingEnabled(true);
+    QVERIFY2(server2.listen(QHostAddress::LocalHost, port), qPrintable(server2.errorString()));
+    QCOMPARE(server2.serverPort(), port);
+
+    // A server that does not ask for sharing must still be refused
+    QTcpServer server3;
+    QVERIFY(!server3.listen(QHostAddress::LocalHost, port));
+    QCOMPARE(server3.serverError(), QAbstractSocket::AddressInUseError);
+
+    const int connectionCount = 20;
+    server1.setMaxPendingConnections(connectionCount);
+    server2.setMaxPendingConnections(connectionCount);
+    QSignalSpy spy1(&server1, SIGNAL(newConnection()));
+    QSignalSpy spy2(&server2, SIGNAL(newConnection()));
+
+    QVector<QTcpSocket *> clients;
+    for (int i = 0; i < connectionCount; ++i) {
+        QTcpSocket *client = new QTcpSocket;
+        client->connectToHost(QHostAddress::LocalHost, port);
+        clients.append(client);
+    }
+
+    // Each connection is accepted by exactly one of the servers
+    QTRY_COMPARE_WITH_TIMEOUT(spy1.count() + spy2.count(), connectionCount, 5000);
+    qDeleteAll(clients);
+#endif
+}
+
 void tst_QTcpServer::setNewSocketDescriptorBlocking()
 {
     QFETCH_GLOBAL(bool, setProxy);
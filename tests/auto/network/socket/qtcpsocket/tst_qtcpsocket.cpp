@@ -157,6 +157,7 @@ private slots:
     void flush();
     void synchronousApi();
     void dontCloseOnTimeout();
+    void writeSpanningBufferChunks();
     void recursiveReadyRead();
     void atEnd();
     void socketInAThread();
@@ -180,6 +181,7 @@ private slots:
     void suddenRemoteDisconnect_data();
     void suddenRemoteDisconnect();
     void connectToMultiIP();
+    void connectWithUnresponsiveFirstAddress();
     void moveToThread0();
     void increaseReadBufferSize();
     void increaseReadBufferSizeFromSlot();
@@ -1747,6 +1749,57 @@ void tst_QTcpSocket::dontCloseOnTimeout()
     delete socket;
 }
 
+//----------------------------------------------------------------------------------
+void tst_QTcpSocket::writeSpanningBufferChunks()
+{
+    // Data buffered in many chunks is handed to the socket engine several
+    // chunks at a time; make sure it arrives complete and in order.
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return; //proxy not useful for localhost test case
+
+    QTcpServer server;
+#ifndef QT_NO_NETWORKPROXY
+    server.setProxy(QNetworkProxy(QNetworkProxy::NoProxy));
+#endif
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QTcpSocket *socket = newSocket();
+    socket->connectToHost(server.serverAddress(), server.serverPort());
+
+    QByteArray expected;
+    for (int i = 0; i < 40; ++i) {
+        const QByteArray block(50000 + i, char('a' + i % 26));
+        QCOMPARE(socket->write(block), qint64(block.size()));
+        expected += block;
+    }
+
+    qint64 bytesWritten = 0;
+    connect(socket, &QIODevice::bytesWritten, [&bytesWritten](qint64 bytes) {
+        bytesWritten += bytes;
+    });
+
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket *peer = server.nextPendingConnection();
+    QVERIFY(peer);
+
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size() && timer.elapsed() < 30000) {
+        socket->waitForBytesWritten(10);
+        if (peer->bytesAvailable() || peer->waitForReadyRead(10))
+            received += peer->readAll();
+    }
+
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+    QCOMPARE(bytesWritten, qint64(expected.size()));
+
+    delete peer;
+    delete socket;
+}
+
 //----------------------------------------------------------------------------------
 void tst_QTcpSocket::recursiveReadyRead()
 {
@@ -2507,6 +2560,38 @@ void tst_QTcpSocket::connectToMultiIP()
 #endif
 }
 
+//----------------------------------------------------------------------------------
+void tst_QTcpSocket::connectWithUnresponsiveFirstAddress()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    // 192.0.2.1 (TEST-NET-1) either fails at once or never answers; the
+    // connection must not wait for the full connect timeout before trying
+    // the next address.
+    const QString name = QStringLiteral("qt-test-server-unresponsive-first");
+    QHostInfo info;
+    info.setAddresses(QList<QHostAddress>() << QHostAddress("192.0.2.1") << QHostAddress(QHostAddress::LocalHost));
+    qt_qhostinfo_cache_inject(name, info);
+
+    QElapsedTimer timer;
+    timer.start();
+    QScopedPointer<QTcpSocket> socket(newSocket());
+    socket->connectToHost(name, server.serverPort());
+    QVERIFY2(socket->waitForConnected(10000), qPrintable(socket->errorString()));
+    QVERIFY(timer.elapsed() < 10000);
+    QCOMPARE(socket->peerAddress(), QHostAddress(QHostAddress::LocalHost));
+    socket->abort();
+
+    socket->connectToHost(name, server.serverPort());
+    QTRY_COMPARE_WITH_TIMEOUT(socket->state(), QAbstractSocket::ConnectedState, 10000);
+    QCOMPARE(socket->peerAddress(), QHostAddress(QHostAddress::LocalHost));
+}
+
 //----------------------------------------------------------------------------------
 void tst_QTcpSocket::moveToThread0()
 {
@@ -117,6 +117,7 @@ private slots:
     void readyRead();
     void readyReadForEmptyDatagram();
     void asyncReadDatagram();
+    void receiveDatagrams();
     void writeInHostLookupState();
 
 protected slots:
@@ -1897,6 +1898,50 @@ void tst_QUdpSocket::asyncReadDatagram()
     delete m_asyncReceiver;
 }
 
+void tst_QUdpSocket::receiveDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket sender;
+    QUdpSocket receiver;
+    QHostAddress localhost = QHostAddress::LocalHost;
+    QVERIFY2(sender.bind(localhost), sender.errorString().toLatin1().constData());
+    QVERIFY2(receiver.bind(localhost), receiver.errorString().toLatin1().constData());
+
+    const int datagramCount = 40;
+    for (int i = 0; i < datagramCount; ++i) {
+        const QByteArray data = QByteArray::number(i).repeated(i + 1);
+        QCOMPARE(sender.writeDatagram(data, makeNonAny(receiver.localAddress()), receiver.localPort()),
+                 qint64(data.size()));
+    }
+
+    // Read in batches smaller than what is pending; also check that a
+    // datagram above maxSize bytes is truncated.
+    const qint64 maxSize = 64;
+    QVector<QNetworkDatagram> datagrams;
+    while (datagrams.size() < datagramCount) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(5000), QtNetworkSettings::msgSocketError(receiver).constData());
+        const QVector<QNetworkDatagram> batch = receiver.receiveDatagrams(16, maxSize);
+        QVERIFY(batch.size() <= 16);
+        datagrams += batch;
+    }
+
+    QCOMPARE(datagrams.size(), datagramCount);
+    for (int i = 0; i < datagramCount; ++i) {
+        const QNetworkDatagram &dgram = datagrams.at(i);
+        QVERIFY(dgram.isValid());
+        QCOMPARE(dgram.data(), QByteArray::number(i).repeated(i + 1).left(maxSize));
+        QCOMPARE(dgram.senderAddress(), makeNonAny(sender.localAddress()));
+        QCOMPARE(dgram.senderPort(), int(sender.localPort()));
+        QCOMPARE(dgram.destinationPort(), int(receiver.localPort()));
+    }
+    QVERIFY(!receiver.hasPendingDatagrams());
+    QVERIFY(receiver.receiveDatagrams(16, maxSize).isEmpty());
+}
+
 void tst_QUdpSocket::writeInHostLookupState()
 {
     QFETCH_GLOBAL(bool, setProxy);
@@ -2,6 +2,7 @@ TEMPLATE=subdirs
 SUBDIRS=\
    qsqlfield \
    qsqldatabase \
+   qsqlconnectionpool \
    qsqlerror \
    qsqldriver \
    qsqlquery \
@@ -0,0 +1,210 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtSql/QtSql>
+
+class tst_QSqlConnectionPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void reuse();
+    void maxSize();
+    void idleEviction();
+    void validationQuery();
+    void openFailure();
+    void threads();
+
+private:
+    QTemporaryDir dir;
+    QSqlDatabase prototype;
+};
+
+void tst_QSqlConnectionPool::initTestCase()
+{
+    if (!QSqlDatabase::isDriverAvailable("QSQLITE"))
+        QSKIP("The SQLite driver is not available");
+    QVERIFY(dir.isValid());
+}
+
+void tst_QSqlConnectionPool::init()
+{
+    prototype = QSqlDatabase::addDatabase("QSQLITE", "prototype");
+    prototype.setDatabaseName(dir.filePath("pool.db"));
+}
+
+void tst_QSqlConnectionPool::cleanup()
+{
+    prototype = QSqlDatabase();
+    QSqlDatabase::removeDatabase("prototype");
+}
+
+void tst_QSqlConnectionPool::reuse()
+{
+    QSqlConnectionPool pool(prototype);
+    QCOMPARE(pool.size(), 0);
+
+    QSqlDatabase db = pool.acquire();
+    QVERIFY(db.isValid());
+    QVERIFY(db.isOpen());
+    QCOMPARE(db.databaseName(), prototype.databaseName());
+    const QString name = db.connectionName();
+    QVERIFY(name != prototype.connectionName());
+    QCOMPARE(pool.size(), 1);
+    QCOMPARE(pool.idleCount(), 0);
+
+    pool.release(db);
+    QCOMPARE(pool.size(), 1);
+    QCOMPARE(pool.idleCount(), 1);
+
+    db = pool.acquire();
+    QCOMPARE(db.connectionName(), name);
+    QCOMPARE(pool.idleCount(), 0);
+
+    QSqlDatabase other = pool.acquire();
+    QVERIFY(other.isOpen());
+    QVERIFY(other.connectionName() != name);
+    QCOMPARE(pool.size(), 2);
+    pool.release(other);
+    pool.release(db);
+    QCOMPARE(pool.idleCount(), 2);
+}
+
+void tst_QSqlConnectionPool::maxSize()
+{
+    QSqlConnectionPool pool(prototype);
+    pool.setMaxSize(1);
+    QCOMPARE(pool.maxSize(), 1);
+
+    QSqlDatabase db = pool.acquire();
+    QVERIFY(db.isOpen());
+    QVERIFY(!pool.acquire(10).isValid());
+    QCOMPARE(pool.lastError().type(), QSqlError::ConnectionError);
+    pool.release(db);
+
+    db = pool.acquire(0);
+    QVERIFY(db.isOpen());
+    pool.release(db);
+}
+
+void tst_QSqlConnectionPool::idleEviction()
+{
+    QSqlConnectionPool pool(prototype);
+    QCOMPARE(pool.maxIdleTime(), 60000);
+    pool.setMaxIdleTime(10);
+
+    QSqlDatabase db = pool.acquire();
+    const QString name = db.connectionName();
+    pool.release(db);
+    db = QSqlDatabase();
+    QTest::qSleep(50);
+
+    db = pool.acquire();
+    QVERIFY(db.isOpen());
+    QVERIFY(db.connectionName() != name);
+    QVERIFY(!QSqlDatabase::contains(name));
+    QCOMPARE(pool.size(), 1);
+    pool.release(db);
+}
+
+void tst_QSqlConnectionPool::validationQuery()
+{
+    QSqlConnectionPool pool(prototype);
+    pool.setValidationQuery("SELECT 1");
+    QCOMPARE(pool.validationQuery(), QString("SELECT 1"));
+
+    QSqlDatabase db = pool.acquire();
+    const QString name = db.connectionName();
+    db.close();
+    pool.release(db);
+
+    db = pool.acquire();
+    QCOMPARE(db.connectionName(), name);
+    QVERIFY(db.isOpen());
+    pool.release(db);
+}
+
+void tst_QSqlConnectionPool::openFailure()
+{
+    prototype.setDatabaseName(dir.filePath("missing.db"));
+    prototype.setConnectOptions("QSQLITE_OPEN_READONLY");
+    QSqlConnectionPool pool(prototype);
+
+    QVERIFY(!pool.acquire().isValid());
+    QVERIFY(pool.lastError().isValid());
+    QCOMPARE(pool.size(), 0);
+}
+
+class PoolUser : public QThread
+{
+public:
+    PoolUser(QSqlConnectionPool *pool) : pool(pool), failures(0) {}
+
+    void run() override
+    {
+        for (int i = 0; i < 50; ++i) {
+            QSqlDatabase db = pool->acquire();
+            QSqlQuery query(db);
+            if (!query.exec("SELECT 1") || !query.next() || query.value(0).toInt() != 1)
+                ++failures;
+            query.clear();
+            pool->release(db);
+        }
+    }
+
+    QSqlConnectionPool *pool;
+    int failures;
+};
+
+void tst_QSqlConnectionPool::threads()
+{
+    QSqlConnectionPool pool(prototype);
+    pool.setMaxSize(2);
+
+    QVector<PoolUser *> users;
+    for (int i = 0; i < 4; ++i) {
+        users.append(new PoolUser(&pool));
+        users.last()->start();
+    }
+    for (PoolUser *user : qAsConst(users)) {
+        QVERIFY(user->wait(30000));
+        QCOMPARE(user->failures, 0);
+        delete user;
+    }
+    QVERIFY(pool.size() <= 2);
+    QCOMPARE(pool.idleCount(), pool.size());
+}
+
+QTEST_MAIN(tst_QSqlConnectionPool)
+#include "tst_qsqlconnectionpool.moc"
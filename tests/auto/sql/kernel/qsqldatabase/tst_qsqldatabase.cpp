@@ -191,6 +191,9 @@ private slots:
     void sqlite_enableRegexp_data() { generic_data("QSQLITE"); }
     void sqlite_enableRegexp();
 
+    void sqlite_pragmaOptions_data() { generic_data("QSQLITE"); }
+    void sqlite_pragmaOptions();
+
 private:
     void createTestTables(QSqlDatabase db);
     void dropTestTables(QSqlDatabase db);
@@ -2291,5 +2294,34 @@ void tst_QSqlDatabase::sqlite_enableRegexp()
     QFAIL_SQL(q, next());
 }
 
+void tst_QSqlDatabase::sqlite_pragmaOptions()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    if (db.driverName().startsWith("QSQLITE2"))
+        QSKIP("SQLite3 specific test");
+    if (db.databaseName() == ":memory:")
+        QSKIP("Journal modes need a database file");
+
+    db.close();
+    db.setConnectOptions("QSQLITE_JOURNAL_MODE=wal;QSQLITE_CACHE_SIZE=-4000;QSQLITE_MMAP_SIZE=0");
+    QVERIFY_SQL(db, open());
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("PRAGMA journal_mode"));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toString(), QString("wal"));
+    QVERIFY_SQL(q, exec("PRAGMA cache_size"));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), -4000);
+    QVERIFY_SQL(q, exec("PRAGMA journal_mode=DELETE"));
+    q.clear();
+
+    db.close();
+    db.setConnectOptions(QString());
+    QVERIFY_SQL(db, open());
+}
+
 QTEST_MAIN(tst_QSqlDatabase)
 #include "tst_qsqldatabase.moc"
@@ -248,6 +248,12 @@ private slots:
     void QTBUG_57138_data() { generic_data("QSQLITE"); }
     void QTBUG_57138();
 
+    void typedValues_data() { generic_data(); }
+    void typedValues();
+
+    void sqlite_statementCache_data() { generic_data("QSQLITE"); }
+    void sqlite_statementCache();
+
 private:
     // returns all database connections
     void generic_data(const QString &engine=QString());
@@ -363,7 +369,8 @@ void tst_QSqlQuery::dropTestTables( QSqlDatabase db )
                << qTableName("task_234422", __FILE__, db)
                << qTableName("test141895", __FILE__, db)
                << qTableName("qtest_oraOCINumber", __FILE__, db)
-               << qTableName("bug2192", __FILE__, db);
+               << qTableName("bug2192", __FILE__, db)
+               << qTableName("typedValues", __FILE__, db);
 
     if (dbType == QSqlDriver::PostgreSQL)
         tablenames << qTableName("task_233829", __FILE__, db);
@@ -4167,5 +4174,83 @@ void tst_QSqlQuery::QTBUG_57138()
     QCOMPARE(q.value(2).toDateTime(), tzoffset);
 }
 
+void tst_QSqlQuery::typedValues()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    const QString tableName = qTableName("typedValues", __FILE__, db);
+    QVERIFY_SQL(q, exec("create table " + tableName + " (id int, num double precision, txt varchar(20))"));
+    QVERIFY_SQL(q, exec("insert into " + tableName + " values (1, 2.5, 'foo')"));
+    QVERIFY_SQL(q, exec("insert into " + tableName + " values (2, NULL, NULL)"));
+
+    for (bool forwardOnly : {false, true}) {
+        q.setForwardOnly(forwardOnly);
+        QVERIFY_SQL(q, exec("select id, num, txt from " + tableName + " order by id"));
+
+        bool ok = true;
+        q.valueInt64(0, &ok);
+        QVERIFY(!ok);
+
+        QVERIFY(q.next());
+        QCOMPARE(q.valueInt64(0, &ok), Q_INT64_C(1));
+        QVERIFY(ok);
+        QCOMPARE(q.valueDouble(1, &ok), 2.5);
+        QVERIFY(ok);
+        QCOMPARE(q.valueStringView(2), QStringView(u"foo"));
+        QCOMPARE(q.valueStringView(0), QStringView(u"1"));
+
+        QVERIFY(q.next());
+        QCOMPARE(q.valueInt64(0, &ok), Q_INT64_C(2));
+        QVERIFY(ok);
+        q.valueDouble(1, &ok);
+        QVERIFY(!ok);
+        QVERIFY(q.valueStringView(2).isEmpty());
+        QVERIFY(!q.next());
+    }
+
+    q.setForwardOnly(true);
+    QVERIFY_SQL(q, exec("select id from " + tableName + " order by id"));
+    QVERIFY(q.last());
+    QCOMPARE(q.valueInt64(0), Q_INT64_C(2));
+    QCOMPARE(q.value(0).toInt(), 2);
+}
+
+void tst_QSqlQuery::sqlite_statementCache()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString select = "SELECT id, t_varchar FROM " + qtest + " WHERE id = ?";
+    void *stmt = 0;
+    {
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, prepare(select));
+        stmt = *static_cast<void * const *>(q.result()->handle().data());
+        q.addBindValue(1);
+        QVERIFY_SQL(q, exec());
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), 1);
+    }
+
+    // the statement is reused once the query that prepared it is gone
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, prepare(select));
+    QCOMPARE(*static_cast<void * const *>(q.result()->handle().data()), stmt);
+    q.addBindValue(2);
+    QVERIFY_SQL(q, exec());
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 2);
+    QVERIFY(!q.next());
+
+    // but not while it is in use
+    QSqlQuery q2(db);
+    QVERIFY_SQL(q2, prepare(select));
+    QVERIFY(*static_cast<void * const *>(q2.result()->handle().data()) != stmt);
+}
+
 QTEST_MAIN( tst_QSqlQuery )
 #include "tst_qsqlquery.moc"
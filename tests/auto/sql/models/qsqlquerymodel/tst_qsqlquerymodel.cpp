@@ -70,6 +70,8 @@ private slots:
     void setHeaderData();
     void fetchMore_data() { generic_data(); }
     void fetchMore();
+    void fetchSize_data() { generic_data(); }
+    void fetchSize();
 
     //problem specific tests
     void withSortFilterProxyModel_data() { generic_data(); }
@@ -490,6 +492,28 @@ void tst_QSqlQueryModel::fetchMore()
     }
 }
 
+void tst_QSqlQueryModel::fetchSize()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    if (db.driver()->hasFeature(QSqlDriver::QuerySize))
+        QSKIP("Test applies only for drivers not reporting the query size.");
+
+    QSqlQueryModel model;
+    QCOMPARE(model.fetchSize(), 255);
+    model.setFetchSize(100);
+    QCOMPARE(model.fetchSize(), 100);
+
+    model.setQuery(QSqlQuery("select * from " + qTableName("many", __FILE__, db), db));
+    const int rowCount = model.rowCount();
+    QVERIFY(rowCount > 0 && rowCount <= 101);
+    QVERIFY(model.canFetchMore());
+    model.fetchMore();
+    QCOMPARE(model.rowCount(), rowCount + 100);
+}
+
 // For task 149491: When used with QSortFilterProxyModel, a view and a
 // database that doesn't support the QuerySize feature, blank rows was
 // appended if the query returned more than 256 rows and setQuery()
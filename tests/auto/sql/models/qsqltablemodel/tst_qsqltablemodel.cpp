@@ -70,6 +70,8 @@ private slots:
     void insertColumns();
     void submitAll_data() { generic_data(); }
     void submitAll();
+    void submitAllIncremental_data() { generic_data(); }
+    void submitAllIncremental();
     void setData_data()  { generic_data(); }
     void setData();
     void setRecord_data()  { generic_data(); }
@@ -1057,6 +1059,48 @@ void tst_QSqlTableModel::submitAll()
     QCOMPARE(model.data(model.index(1, 1)).toString(), QString("trond"));
 }
 
+void tst_QSqlTableModel::submitAllIncremental()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlTableModel model(0, db);
+    model.setTable(test);
+    model.setSort(0, Qt::AscendingOrder);
+    model.setEditStrategy(QSqlTableModel::OnManualSubmit);
+    QVERIFY(!model.incrementalRefresh());
+    model.setIncrementalRefresh(true);
+    QVERIFY(model.incrementalRefresh());
+    QVERIFY_SQL(model, select());
+
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy changedSpy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+
+    QVERIFY(model.setData(model.index(0, 1), "harry2", Qt::EditRole));
+    QVERIFY(model.setData(model.index(2, 1), "vohi2", Qt::EditRole));
+    changedSpy.clear();
+    QVERIFY_SQL(model, submitAll());
+
+    QCOMPARE(resetSpy.count(), 0);
+    QVERIFY(!model.isDirty());
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.data(model.index(0, 1)).toString(), QString("harry2"));
+    QCOMPARE(model.data(model.index(1, 1)).toString(), QString("trond"));
+    QCOMPARE(model.data(model.index(2, 1)).toString(), QString("vohi2"));
+    // only the submitted rows were refreshed
+    for (const QList<QVariant> &args : qAsConst(changedSpy))
+        QVERIFY(args.at(0).toModelIndex().row() != 1);
+
+    QVERIFY_SQL(model, select());
+    QCOMPARE(model.data(model.index(0, 1)).toString(), QString("harry2"));
+    QCOMPARE(model.data(model.index(2, 1)).toString(), QString("vohi2"));
+
+    QVERIFY(model.setData(model.index(0, 1), "harry", Qt::EditRole));
+    QVERIFY(model.setData(model.index(2, 1), "vohi", Qt::EditRole));
+    QVERIFY_SQL(model, submitAll());
+}
+
 void tst_QSqlTableModel::removeRow()
 {
     QFETCH(QString, dbName);
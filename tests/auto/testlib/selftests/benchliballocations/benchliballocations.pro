@@ -0,0 +1,7 @@
+SOURCES += tst_benchliballocations.cpp
+QT = core testlib
+
+mac:CONFIG -= app_bundle
+CONFIG -= debug_and_release_target
+
+TARGET = benchliballocations
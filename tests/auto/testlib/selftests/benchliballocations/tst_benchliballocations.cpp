@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/QCoreApplication>
+#include <QtTest/QtTest>
+
+#include <new>
+
+class tst_BenchlibAllocations: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void allocations();
+    void allocations_data();
+};
+
+void tst_BenchlibAllocations::allocations()
+{
+    QFETCH(int, allocationCount);
+
+    QBENCHMARK {
+        for (int i = 0; i < allocationCount; ++i) {
+            // calling the allocation function directly can't be optimized away
+            void *p = ::operator new(16);
+            ::operator delete(p);
+        }
+    }
+}
+
+void tst_BenchlibAllocations::allocations_data()
+{
+    QTest::addColumn<int>("allocationCount");
+
+    QTest::newRow("0")      << 0;
+    QTest::newRow("1")      << 1;
+    QTest::newRow("10")     << 10;
+    QTest::newRow("100")    << 100;
+}
+
+QTEST_COUNT_ALLOCATIONS
+QTEST_APPLESS_MAIN(tst_BenchlibAllocations)
+
+#include "tst_benchliballocations.moc"
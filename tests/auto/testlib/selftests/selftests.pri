@@ -2,6 +2,7 @@ SUBPROGRAMS = \
      #alive \
      assert \
      badxml \
+     benchliballocations \
      benchlibcallgrind \
      benchlibcounting \
      benchlibeventcounter \
@@ -361,6 +361,10 @@ void tst_Selftests::runSubTest_data()
         << "assert"
 #endif
         << "badxml"
+#if defined(Q_OS_LINUX) && defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+        // Only run where allocations can be counted.
+        << "benchliballocations"
+#endif
 #if defined(__GNUC__) && defined(__i386) && defined(Q_OS_LINUX)
         // Only run on platforms where callgrind is available.
         << "benchlibcallgrind"
@@ -436,6 +440,9 @@ void tst_Selftests::runSubTest_data()
             if (subtest == "commandlinedata") {
                 arguments << QString("fiveTablePasses fiveTablePasses:fiveTablePasses_data1 -v2").split(' ');
             }
+            else if (subtest == "benchliballocations") {
+                arguments << "-allocations";
+            }
             else if (subtest == "benchlibcallgrind") {
                 arguments << "-callgrind";
             }
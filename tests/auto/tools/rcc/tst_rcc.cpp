@@ -39,6 +39,7 @@
 #include <QtCore/QList>
 #include <QtCore/QResource>
 #include <QtCore/QLocale>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QtGlobal>
 
 #include <algorithm>
@@ -58,6 +59,8 @@ private slots:
     void binary_data();
     void binary();
 
+    void alignment();
+
     void cleanupTestCase();
 
 private:
@@ -353,6 +356,40 @@ void tst_rcc::binary()
     QLocale::setDefault(oldDefaultLocale);
 }
 
+void tst_rcc::alignment()
+{
+    const QString imagesDir = QFINDTESTDATA("data/images");
+    QVERIFY(!imagesDir.isEmpty());
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString resourceFile = tempDir.path() + QLatin1String("/images.rcc");
+
+    QProcess process;
+    process.setWorkingDirectory(imagesDir);
+    process.start(m_rcc, QStringList() << QLatin1String("-binary") << QLatin1String("-no-compress")
+                  << QLatin1String("-align") << QLatin1String("64")
+                  << QLatin1String("images.qrc") << QLatin1String("-o") << resourceFile);
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitCode(), 0);
+
+    const QString rootPrefix = QLatin1String("/test_align/");
+    QVERIFY(QResource::registerResource(resourceFile, rootPrefix));
+    const QStringList files = QStringList() << QLatin1String("images/circle.png")
+                                            << QLatin1String("images/square.png")
+                                            << QLatin1String("images/subdir/triangle.png");
+    for (const QString &file : files) {
+        const QResource resource(QLatin1Char(':') + rootPrefix + file);
+        QVERIFY2(resource.isValid(), qPrintable(file));
+        QVERIFY(!resource.isCompressed());
+        QCOMPARE(quintptr(resource.data()) % 64, quintptr(0));
+
+        QFile actualFile(imagesDir + QLatin1Char('/') + file);
+        QVERIFY(actualFile.open(QIODevice::ReadOnly));
+        QCOMPARE(QByteArray::fromRawData(reinterpret_cast<const char *>(resource.data()), resource.size()),
+                 actualFile.readAll());
+    }
+    QVERIFY(QResource::unregisterResource(resourceFile, rootPrefix));
+}
 
 void tst_rcc::cleanupTestCase()
 {
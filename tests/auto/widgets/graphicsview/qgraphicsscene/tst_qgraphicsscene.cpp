@@ -174,6 +174,8 @@ private slots:
     void sceneRect();
     void itemIndexMethod();
     void bspTreeDepth();
+    void bspTreeMovedItems_data();
+    void bspTreeMovedItems();
     void itemsBoundingRect_data();
     void itemsBoundingRect();
     void items();
@@ -218,6 +220,8 @@ private slots:
     void render_data();
     void render();
     void renderItemsWithNegativeWidthOrHeight();
+    void batchPainting();
+    void customBatchPaintFunction();
 #ifndef QT_NO_CONTEXTMENU
     void contextMenuEvent();
     void contextMenuEvent_ItemIgnoresTransformations();
@@ -409,6 +413,59 @@ void tst_QGraphicsScene::bspTreeDepth()
     QCOMPARE(scene.bspTreeDepth(), 1);
 }
 
+void tst_QGraphicsScene::bspTreeMovedItems_data()
+{
+    QTest::addColumn<QRectF>("sceneRect");
+
+    QTest::newRow("growing scene rect") << QRectF();
+    QTest::newRow("fixed scene rect") << QRectF(0, 0, 400, 400);
+}
+
+void tst_QGraphicsScene::bspTreeMovedItems()
+{
+    QFETCH(QRectF, sceneRect);
+
+    QGraphicsScene scene;
+    QCOMPARE(scene.itemIndexMethod(), QGraphicsScene::BspTreeIndex);
+    scene.setSceneRect(sceneRect);
+
+    QList<QGraphicsItem *> items;
+    for (int i = 0; i < 400; ++i) {
+        QGraphicsItem *item = scene.addRect(QRectF(0, 0, 10, 10));
+        item->setPos((i % 20) * 20, (i / 20) * 20);
+        items << item;
+    }
+    itemAt(scene, 0, 0); // trigger indexing
+
+    // Small moves, moves across the scene and moves beyond the scene rect.
+    const QPointF offsets[] = { QPointF(1, 1), QPointF(-170, 90), QPointF(2000, -3000) };
+    for (const QPointF &offset : offsets) {
+        for (int i = 0; i < items.size(); ++i)
+            items.at(i)->moveBy(offset.x() * (i % 3), offset.y() * (i % 5));
+        scene.sceneRect(); // may grow the scene rect
+
+        // Moved items that are removed before the index is updated.
+        scene.removeItem(items.last());
+        delete items.takeLast();
+        delete items.takeFirst();
+
+        for (int x = -400; x < 8500; x += 250) {
+            for (int y = -12500; y < 2000; y += 250) {
+                const QRectF rect(x, y, 300, 300);
+                QList<QGraphicsItem *> expected;
+                for (QGraphicsItem *item : qAsConst(items)) {
+                    if (item->sceneBoundingRect().intersects(rect))
+                        expected << item;
+                }
+                QList<QGraphicsItem *> found = scene.items(rect, Qt::IntersectsItemBoundingRect);
+                std::sort(expected.begin(), expected.end());
+                std::sort(found.begin(), found.end());
+                QCOMPARE(found, expected);
+            }
+        }
+    }
+}
+
 void tst_QGraphicsScene::items()
 {
 #ifdef Q_PROCESSOR_ARM
@@ -2695,6 +2752,129 @@ void tst_QGraphicsScene::renderItemsWithNegativeWidthOrHeight()
     QCOMPARE(actual, expected);
 }
 
+static QImage renderScene(QGraphicsScene *scene)
+{
+    QImage image(scene->sceneRect().size().toSize(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    scene->render(&painter);
+    painter.end();
+    return image;
+}
+
+void tst_QGraphicsScene::batchPainting()
+{
+    QGraphicsScene scene(0, 0, 200, 200);
+    QList<QGraphicsItem *> items;
+    for (int i = 0; i < 40; ++i) {
+        QAbstractGraphicsShapeItem *item;
+        if (i % 3)
+            item = scene.addRect(QRectF(0, 0, 30, 20), QPen(QColor::fromHsv(i * 9, 255, 128), i % 4));
+        else
+            item = new QGraphicsEllipseItem(QRectF(0, 0, 25, 25));
+        item->setBrush(QColor::fromHsv(i * 9, 200, 255, 160));
+        item->setPos((i * 37) % 180, (i * 23) % 180);
+        item->setRotation(i * 7);
+        if (!item->scene())
+            scene.addItem(item);
+        items << item;
+    }
+    static_cast<QGraphicsEllipseItem *>(items.at(3))->setSpanAngle(120 * 16);
+    items.at(5)->setOpacity(0.5);
+    items.at(7)->setFlag(QGraphicsItem::ItemIsSelectable);
+    items.at(7)->setSelected(true);
+    items.at(11)->setEnabled(false);
+    new QGraphicsRectItem(QRectF(5, 5, 10, 10), items.at(13));
+
+    const QImage expected = renderScene(&scene);
+    for (QGraphicsItem *item : qAsConst(items))
+        item->setFlag(QGraphicsItem::ItemUsesBatchPainting);
+    QCOMPARE(renderScene(&scene), expected);
+}
+
+class BatchPaintItem : public QGraphicsRectItem
+{
+public:
+    enum { Type = UserType + 90 };
+
+    BatchPaintItem(const QRectF &rect) : QGraphicsRectItem(rect), paintCount(0)
+    { setFlag(ItemUsesBatchPainting); }
+
+    int type() const Q_DECL_OVERRIDE { return Type; }
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) Q_DECL_OVERRIDE
+    {
+        ++paintCount;
+        QGraphicsRectItem::paint(painter, option, widget);
+    }
+
+    int paintCount;
+};
+
+static int batchPaintCalls = 0;
+static int batchPaintedItems = 0;
+
+static void countingBatchPaint(QPainter *painter, QGraphicsItem *const *items, const QTransform *transforms,
+                               int count, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    ++batchPaintCalls;
+    batchPaintedItems += count;
+    for (int i = 0; i < count; ++i) {
+        painter->setWorldTransform(transforms[i]);
+        static_cast<BatchPaintItem *>(items[i])->QGraphicsRectItem::paint(painter, option, widget);
+    }
+}
+
+void tst_QGraphicsScene::customBatchPaintFunction()
+{
+    QVERIFY(!QGraphicsItem::batchPaintFunction(BatchPaintItem::Type));
+    QVERIFY(QGraphicsItem::batchPaintFunction(QGraphicsRectItem::Type));
+
+    QGraphicsScene scene(0, 0, 100, 100);
+    QList<BatchPaintItem *> items;
+    for (int i = 0; i < 5; ++i) {
+        BatchPaintItem *item = new BatchPaintItem(QRectF(0, 0, 10, 10));
+        item->setBrush(Qt::red);
+        item->setPos(i * 20, i * 10);
+        scene.addItem(item);
+        items << item;
+    }
+
+    // Without a registered function, every item paints itself.
+    const QImage expected = renderScene(&scene);
+    for (BatchPaintItem *item : qAsConst(items))
+        QCOMPARE(item->paintCount, 1);
+
+    batchPaintCalls = 0;
+    batchPaintedItems = 0;
+    QGraphicsItem::setBatchPaintFunction(BatchPaintItem::Type, countingBatchPaint);
+    QVERIFY(QGraphicsItem::batchPaintFunction(BatchPaintItem::Type) == countingBatchPaint);
+    QCOMPARE(renderScene(&scene), expected);
+    QCOMPARE(batchPaintCalls, 1);
+    QCOMPARE(batchPaintedItems, items.size());
+    for (BatchPaintItem *item : qAsConst(items))
+        QCOMPARE(item->paintCount, 1);
+
+    // An item on top of a different type splits the batch.
+    QGraphicsEllipseItem *ellipse = scene.addEllipse(QRectF(30, 10, 20, 20));
+    ellipse->setZValue(0.5);
+    items.at(2)->setZValue(1);
+    items.at(3)->setZValue(1);
+    items.at(4)->setZValue(1);
+    batchPaintCalls = 0;
+    batchPaintedItems = 0;
+    renderScene(&scene);
+    QCOMPARE(batchPaintCalls, 2);
+    QCOMPARE(batchPaintedItems, items.size());
+
+    QGraphicsItem::setBatchPaintFunction(BatchPaintItem::Type, 0);
+    QVERIFY(!QGraphicsItem::batchPaintFunction(BatchPaintItem::Type));
+    renderScene(&scene);
+    for (BatchPaintItem *item : qAsConst(items))
+        QCOMPARE(item->paintCount, 2);
+}
+
 #ifndef QT_NO_CONTEXTMENU
 void tst_QGraphicsScene::contextMenuEvent()
 {
@@ -147,6 +147,7 @@ private slots:
     void testClearModelInClickedSignal();
     void inputMethodEnabled_data();
     void inputMethodEnabled();
+    void itemPixmapCache();
 };
 
 class MyAbstractItemDelegate : public QAbstractItemDelegate
@@ -2391,4 +2392,63 @@ void tst_QAbstractItemView::inputMethodEnabled()
 }
 
 QTEST_MAIN(tst_QAbstractItemView)
+class PaintCountingDelegate : public QStyledItemDelegate
+{
+public:
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override
+    {
+        paintedIndexes.append(index);
+        QStyledItemDelegate::paint(painter, option, index);
+    }
+
+    mutable QModelIndexList paintedIndexes;
+};
+
+void tst_QAbstractItemView::itemPixmapCache()
+{
+    QStandardItemModel model(4, 4);
+    for (int row = 0; row < model.rowCount(); ++row) {
+        for (int column = 0; column < model.columnCount(); ++column)
+            model.setData(model.index(row, column), QString::number(row * 10 + column));
+    }
+    PaintCountingDelegate delegate;
+    QTableView view;
+    view.setModel(&model);
+    view.setItemDelegate(&delegate);
+    QVERIFY(!view.isItemPixmapCacheEnabled());
+    view.setItemPixmapCacheEnabled(true);
+    QVERIFY(view.isItemPixmapCacheEnabled());
+    centerOnScreen(&view);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    view.viewport()->repaint();
+    delegate.paintedIndexes.clear();
+    view.viewport()->repaint();
+    QVERIFY(delegate.paintedIndexes.isEmpty());
+
+    // changed data is painted again
+    model.setData(model.index(1, 2), QStringLiteral("changed"));
+    view.viewport()->repaint();
+    QCOMPARE(delegate.paintedIndexes, QModelIndexList() << model.index(1, 2));
+
+    // so are items in a different state
+    delegate.paintedIndexes.clear();
+    view.selectionModel()->select(model.index(2, 0), QItemSelectionModel::Select);
+    view.viewport()->repaint();
+    QCOMPARE(delegate.paintedIndexes, QModelIndexList() << model.index(2, 0));
+
+    // and all items after the model changed its structure
+    delegate.paintedIndexes.clear();
+    model.removeRow(3);
+    view.viewport()->repaint();
+    const int repaintedCount = delegate.paintedIndexes.count();
+
+    delegate.paintedIndexes.clear();
+    view.setItemPixmapCacheEnabled(false);
+    view.viewport()->repaint();
+    QVERIFY(!delegate.paintedIndexes.isEmpty());
+    QCOMPARE(repaintedCount, delegate.paintedIndexes.count());
+}
+
 #include "tst_qabstractitemview.moc"
@@ -213,6 +213,7 @@ private slots:
     void QTBUG53221_assertShiftHiddenRow();
     void ensureNoIndexAtLength();
     void offsetConsistent();
+    void sectionPositionsConsistent();
 
     void initialSortOrderRole();
 
@@ -2482,6 +2483,48 @@ void tst_QHeaderView::offsetConsistent()
     QVERIFY(offset2 > offset1);
 }
 
+void tst_QHeaderView::sectionPositionsConsistent()
+{
+    QStandardItemModel amodel(1000, 1);
+    QHeaderView hv(Qt::Vertical);
+    hv.setModel(&amodel);
+    hv.setDefaultSectionSize(20);
+
+    const auto verifyPositions = [&hv]() {
+        int pos = 0;
+        for (int visual = 0; visual < hv.count(); ++visual) {
+            const int i = hv.logicalIndex(visual);
+            QCOMPARE(hv.sectionPosition(i), pos);
+            if (hv.sectionSize(i) > 0) {
+                QCOMPARE(hv.logicalIndexAt(pos), i);
+                QCOMPARE(hv.logicalIndexAt(pos + hv.sectionSize(i) - 1), i);
+            }
+            pos += hv.sectionSize(i);
+        }
+        QCOMPARE(hv.length(), pos);
+        QCOMPARE(hv.logicalIndexAt(pos), -1);
+    };
+
+    verifyPositions();
+    for (int i = 0; i < hv.count(); i += 7)
+        hv.resizeSection(i, i % 3 == 0 ? 0 : 5 + i % 11);
+    verifyPositions();
+    hv.hideSection(500);
+    hv.resizeSection(999, 100);
+    verifyPositions();
+    amodel.appendRow(new QStandardItem);
+    amodel.insertRows(amodel.rowCount(), 37);
+    verifyPositions();
+    hv.resizeSection(1020, 3);
+    amodel.insertRows(10, 5);
+    verifyPositions();
+    amodel.removeRows(amodel.rowCount() - 20, 20);
+    hv.resizeSection(1, 77);
+    verifyPositions();
+    hv.moveSection(3, 900);
+    verifyPositions();
+}
+
 void tst_QHeaderView::initialSortOrderRole()
 {
     QTableView view; // ### Shadowing member view (of type QHeaderView)
@@ -193,6 +193,7 @@ private slots:
     void taskQTBUG_25333_adjustViewOptionsForIndex();
     void taskQTBUG_18539_emitLayoutChanged();
     void taskQTBUG_8176_emitOnExpandAll();
+    void appendRowsToExpandedParent();
     void taskQTBUG_37813_crash();
     void taskQTBUG_45697_crash();
     void taskQTBUG_7232_AllowUserToControlSingleStep();
@@ -4323,6 +4324,48 @@ void tst_QTreeView::taskQTBUG_8176_emitOnExpandAll()
     QCOMPARE(spy2.size(), 1); // item2 is collapsed
 }
 
+static QModelIndexList visibleIndexes(const QTreeView &view)
+{
+    QModelIndexList result;
+    for (QModelIndex index = view.model()->index(0, 0); index.isValid(); index = view.indexBelow(index))
+        result << index;
+    return result;
+}
+
+void tst_QTreeView::appendRowsToExpandedParent()
+{
+    QStandardItemModel model;
+    for (int i = 0; i < 3; ++i) {
+        QStandardItem *item = new QStandardItem(QString::number(i));
+        for (int j = 0; j < 3; ++j)
+            item->appendRow(new QStandardItem(QString::number(i) + QString::number(j)));
+        model.appendRow(item);
+    }
+    QTreeView view;
+    view.setModel(&model);
+    view.expandAll();
+    view.setRowHidden(1, model.index(0, 0), true);
+    view.collapse(model.index(2, 0));
+    view.doItemsLayout();
+
+    QStandardItem *first = model.item(0);
+    first->appendRow(new QStandardItem("03"));
+    first->child(0)->appendRow(new QStandardItem("000"));
+    model.item(1)->appendRows(QList<QStandardItem *>() << new QStandardItem("13") << new QStandardItem("14"));
+    model.item(2)->appendRow(new QStandardItem("23"));
+    model.appendRow(new QStandardItem("3"));
+
+    QTreeView reference;
+    reference.setModel(&model);
+    reference.expandAll();
+    reference.setRowHidden(1, model.index(0, 0), true);
+    reference.collapse(model.index(2, 0));
+    const QModelIndexList expected = visibleIndexes(reference);
+    QCOMPARE(visibleIndexes(view), expected);
+    for (const QModelIndex &index : expected)
+        QCOMPARE(view.visualRect(index), reference.visualRect(index));
+}
+
 void tst_QTreeView::testInitialFocus()
 {
     QTreeWidget treeWidget;
@@ -69,6 +69,7 @@ private slots:
     void controlTypes2();
     void adjustSizeShouldMakeSureLayoutIsActivated();
     void testRetainSizeWhenHidden();
+    void relayoutOnlyInvalidatedBranch();
 };
 
 tst_QLayout::tst_QLayout()
@@ -381,5 +382,57 @@ void tst_QLayout::testRetainSizeWhenHidden()
     QCOMPARE(widget.sizeHint().height(), normalHeight);
 }
 
+class CountingBoxLayout : public QVBoxLayout
+{
+public:
+    CountingBoxLayout() : invalidateCount(0) {}
+    void invalidate() override { ++invalidateCount; QVBoxLayout::invalidate(); }
+    int invalidateCount;
+};
+
+void tst_QLayout::relayoutOnlyInvalidatedBranch()
+{
+    QWidget widget;
+    QHBoxLayout *top = new QHBoxLayout(&widget);
+    CountingBoxLayout *left = new CountingBoxLayout;
+    CountingBoxLayout *right = new CountingBoxLayout;
+    top->addLayout(left);
+    top->addLayout(right);
+
+    SizeHinterFrame *leftFrame = new SizeHinterFrame(QSize(50, 20));
+    left->addWidget(leftFrame);
+    SizeHinterFrame *rightFrame1 = new SizeHinterFrame(QSize(50, 20));
+    SizeHinterFrame *rightFrame2 = new SizeHinterFrame(QSize(50, 20));
+    right->addWidget(rightFrame1);
+    right->addWidget(rightFrame2);
+
+    widget.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&widget));
+    QApplication::sendPostedEvents(0, QEvent::LayoutRequest);
+    const QRect leftGeometry = leftFrame->geometry();
+
+    // Changing a widget in one branch recalculates that branch only.
+    left->invalidateCount = 0;
+    right->invalidateCount = 0;
+    rightFrame1->setMinimumHeight(80);
+    QApplication::sendPostedEvents(0, QEvent::LayoutRequest);
+    QVERIFY(right->invalidateCount > 0);
+    QCOMPARE(left->invalidateCount, 0);
+    QVERIFY(rightFrame1->height() >= 80);
+    QCOMPARE(leftFrame->geometry().x(), leftGeometry.x());
+
+    // Hiding a widget gives its space to the siblings in the same layout.
+    const int height2 = rightFrame2->height();
+    rightFrame1->hide();
+    QApplication::sendPostedEvents(0, QEvent::LayoutRequest);
+    QVERIFY(rightFrame2->height() > height2);
+    QCOMPARE(left->invalidateCount, 0);
+
+    // Explicitly invalidating a layout still recalculates everything inside it.
+    top->invalidate();
+    QApplication::sendPostedEvents(0, QEvent::LayoutRequest);
+    QVERIFY(left->invalidateCount > 0);
+}
+
 QTEST_MAIN(tst_QLayout)
 #include "tst_qlayout.moc"
@@ -242,6 +242,7 @@ private slots:
     void lostUpdatesOnHide();
 
     void update();
+    void pacedUpdates();
     void isOpaque();
 
 #ifndef Q_OS_OSX
@@ -4461,6 +4462,55 @@ void tst_QWidget::update()
     }
 }
 
+void tst_QWidget::pacedUpdates()
+{
+    Q_CHECK_PAINTEVENTS
+
+    QCoreApplication::setAttribute(Qt::AA_PaceWidgetUpdates);
+
+    UpdateWidget w;
+    w.resize(100, 100);
+    centerOnScreen(&w);
+    UpdateWidget child(&w);
+    child.setAttribute(Qt::WA_OpaquePaintEvent);
+    child.setGeometry(10, 10, 50, 50);
+    w.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&w));
+    QTRY_VERIFY(w.numPaintEvents > 0);
+    QTRY_VERIFY(child.numPaintEvents > 0);
+    w.reset();
+    child.reset();
+
+    // Updates are collected until the window delivers its next update
+    // request, and are then painted in one pass.
+    for (int i = 0; i < 10; ++i) {
+        w.update(QRect(70 + i, 70, 1, 1));
+        child.update(QRect(i, 0, 1, 1));
+    }
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(w.numPaintEvents, 0);
+    QCOMPARE(child.numPaintEvents, 0);
+
+    QTRY_COMPARE(w.numPaintEvents, 1);
+    QCOMPARE(child.numPaintEvents, 1);
+    QCOMPARE(w.paintedRegion, QRegion(70, 70, 10, 1));
+    QCOMPARE(child.paintedRegion, QRegion(0, 0, 10, 1));
+    QCOMPARE(w.numUpdateRequestEvents, 0);
+
+    // repaint() is not deferred.
+    w.reset();
+    w.repaint(QRect(0, 0, 5, 5));
+    QCOMPARE(w.numPaintEvents, 1);
+
+    QCoreApplication::setAttribute(Qt::AA_PaceWidgetUpdates, false);
+
+    w.reset();
+    w.update();
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(w.numUpdateRequestEvents, 1);
+    QCOMPARE(w.numPaintEvents, 1);
+}
+
 #ifndef Q_OS_OSX
 static inline bool isOpaque(QWidget *widget)
 {
@@ -58,6 +58,7 @@ private slots:
     void reparentHidden();
     void asViewport();
     void requestUpdate();
+    void updateWithRasterSibling();
     void fboRedirect();
     void showHide();
     void nativeWindow();
@@ -390,6 +391,40 @@ void tst_QOpenGLWidget::requestUpdate()
     QTRY_VERIFY(w.m_count > 0);
 }
 
+class PaintRegionWidget : public QWidget
+{
+public:
+    PaintRegionWidget(QWidget *parent = 0) : QWidget(parent) { }
+    void paintEvent(QPaintEvent *e) Q_DECL_OVERRIDE { m_region += e->region(); }
+    QRegion m_region;
+};
+
+void tst_QOpenGLWidget::updateWithRasterSibling()
+{
+    PaintRegionWidget w;
+    PaintCountWidget *glw = new PaintCountWidget;
+    glw->setParent(&w);
+    glw->setGeometry(0, 0, 100, 100);
+    PaintRegionWidget *sibling = new PaintRegionWidget(&w);
+    sibling->setGeometry(150, 0, 50, 50);
+    w.resize(200, 100);
+    w.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&w));
+    QTRY_VERIFY(glw->m_count > 0);
+
+    glw->reset();
+    w.m_region = QRegion();
+    sibling->m_region = QRegion();
+
+    // Only the texture of the OpenGL widget needs to be rendered again, the
+    // backingstore content around it is left alone.
+    glw->update();
+    sibling->update();
+    QTRY_COMPARE(glw->m_count, 1);
+    QTRY_COMPARE(sibling->m_region, QRegion(sibling->rect()));
+    QVERIFY(!w.m_region.intersects(glw->geometry()));
+}
+
 class FboCheckWidget : public QOpenGLWidget
 {
 public:
@@ -115,6 +115,7 @@ private slots:
     void DTDNotationDecl();
     void DTDEntityDecl();
     void QTBUG49113_dontCrashWithNegativeIndex() const;
+    void sharedNames() const;
 
     void cleanupTestCase() const;
 
@@ -1983,5 +1984,23 @@ void tst_QDom::QTBUG49113_dontCrashWithNegativeIndex() const
     QVERIFY(node.isNull());
 }
 
+void tst_QDom::sharedNames() const
+{
+    QDomDocument doc;
+    QVERIFY(doc.setContent(QLatin1String("<a:root xmlns:a='urn:a'>"
+                                         "<a:item a:key='1'>x</a:item>"
+                                         "<a:item a:key='2'>y</a:item>"
+                                         "</a:root>"), true));
+    QDomElement first = doc.documentElement().firstChildElement();
+    QDomElement second = first.nextSiblingElement();
+    QCOMPARE(second.localName(), QString("item"));
+    QCOMPARE(second.attributeNS("urn:a", "key"), QString("2"));
+    QCOMPARE(first.localName().constData(), second.localName().constData());
+    QCOMPARE(first.prefix().constData(), second.prefix().constData());
+    QCOMPARE(first.namespaceURI().constData(), second.namespaceURI().constData());
+    QCOMPARE(first.attributeNodeNS("urn:a", "key").localName().constData(),
+             second.attributeNodeNS("urn:a", "key").localName().constData());
+}
+
 QTEST_MAIN(tst_QDom)
 #include "tst_qdom.moc"
@@ -4,6 +4,7 @@ SUBDIRS = \
         qdiriterator \
         qfile \
         qfileinfo \
+        qfilesystemwatcher \
         qiodevice \
         qtemporaryfile \
         qtextstream
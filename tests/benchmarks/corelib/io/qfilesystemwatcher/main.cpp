@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+class tst_QFileSystemWatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void addPaths_data();
+    void addPaths();
+    void addPath_data();
+    void addPath();
+
+private:
+    QStringList paths(const QString &kind, int count) const;
+
+    QTemporaryDir tempDir;
+    QStringList files;
+    QStringList directories;
+};
+
+enum { MaxPathCount = 1000 };
+
+void tst_QFileSystemWatcher::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+
+    QDir dir(tempDir.path());
+    for (int i = 0; i < MaxPathCount; ++i) {
+        const QString name = QString::number(i);
+
+        QFile file(dir.filePath(QLatin1String("file") + name));
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        files.append(file.fileName());
+
+        QVERIFY(dir.mkdir(QLatin1String("dir") + name));
+        directories.append(dir.filePath(QLatin1String("dir") + name));
+    }
+}
+
+QStringList tst_QFileSystemWatcher::paths(const QString &kind, int count) const
+{
+    return (kind == QLatin1String("files") ? files : directories).mid(0, count);
+}
+
+static void pathData()
+{
+    QTest::addColumn<QString>("kind");
+    QTest::addColumn<int>("count");
+
+    for (const char *kind : { "files", "directories" }) {
+        for (int count : { 1, 10, 100, int(MaxPathCount) }) {
+            QTest::newRow(qPrintable(QString::fromLatin1("%1 %2").arg(count).arg(QLatin1String(kind))))
+                << QString::fromLatin1(kind) << count;
+        }
+    }
+}
+
+// The watcher is created outside of the measured block, as constructing the
+// native engine dominates everything else; every iteration registers the
+// paths and unregisters them again, so both directions are measured.
+
+void tst_QFileSystemWatcher::addPaths_data()
+{
+    pathData();
+}
+
+void tst_QFileSystemWatcher::addPaths()
+{
+    QFETCH(QString, kind);
+    QFETCH(int, count);
+    const QStringList list = paths(kind, count);
+
+    QFileSystemWatcher watcher;
+    QBENCHMARK {
+        QVERIFY(watcher.addPaths(list).isEmpty());
+        QVERIFY(watcher.removePaths(list).isEmpty());
+    }
+}
+
+void tst_QFileSystemWatcher::addPath_data()
+{
+    pathData();
+}
+
+void tst_QFileSystemWatcher::addPath()
+{
+    // one call per path, like an application discovering files one by one
+    QFETCH(QString, kind);
+    QFETCH(int, count);
+    const QStringList list = paths(kind, count);
+
+    QFileSystemWatcher watcher;
+    QBENCHMARK {
+        for (const QString &path : list)
+            watcher.addPath(path);
+        for (const QString &path : list)
+            watcher.removePath(path);
+    }
+}
+
+QTEST_MAIN(tst_QFileSystemWatcher)
+
+#include "main.moc"
@@ -29,6 +29,8 @@
 #include <QtTest>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qjsonarray.h>
+#include <qjsonbuilder.h>
 
 class BenchmarkQtBinaryJson: public QObject
 {
@@ -51,6 +53,11 @@ private Q_SLOTS:
 
     void jsonObjectInsert();
     void variantMapInsert();
+
+    void buildObject_data();
+    void buildObject();
+    void buildNestedObject_data();
+    void buildNestedObject();
 };
 
 BenchmarkQtBinaryJson::BenchmarkQtBinaryJson(QObject *parent) : QObject(parent)
@@ -174,6 +181,97 @@ void BenchmarkQtBinaryJson::variantMapInsert()
     }
 }
 
+void BenchmarkQtBinaryJson::buildObject_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("useBuilder");
+
+    for (int count : { 1000, 10000, 100000 }) {
+        const QByteArray n = QByteArray::number(count);
+        QTest::newRow("insert-" + n) << count << false;
+        QTest::newRow("builder-" + n) << count << true;
+    }
+}
+
+void BenchmarkQtBinaryJson::buildObject()
+{
+    QFETCH(int, count);
+    QFETCH(bool, useBuilder);
+
+    QStringList keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; ++i)
+        keys << QLatin1String("testkey_") + QString::number((i * 7919) % count);
+    QJsonValue value(1.5);
+
+    if (useBuilder) {
+        QBENCHMARK {
+            QJsonObjectBuilder builder;
+            builder.reserve(count);
+            for (const QString &key : qAsConst(keys))
+                builder.insert(key, value);
+            QJsonObject object = builder.toObject();
+        }
+    } else {
+        QBENCHMARK {
+            QJsonObject object;
+            for (const QString &key : qAsConst(keys))
+                object.insert(key, value);
+        }
+    }
+}
+
+void BenchmarkQtBinaryJson::buildNestedObject_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("useBuilder");
+
+    for (int count : { 100, 1000 }) {
+        const QByteArray n = QByteArray::number(count);
+        QTest::newRow("insert-" + n) << count << false;
+        QTest::newRow("builder-" + n) << count << true;
+    }
+}
+
+void BenchmarkQtBinaryJson::buildNestedObject()
+{
+    // records of the form { "id": { "name": "...", "tags": [ ... ] } }, filled in a member at a time
+    QFETCH(int, count);
+    QFETCH(bool, useBuilder);
+
+    const QString name = QStringLiteral("name");
+    const QString tags = QStringLiteral("tags");
+
+    if (useBuilder) {
+        QBENCHMARK {
+            QJsonObjectBuilder builder;
+            for (int i = 0; i < count; ++i) {
+                QJsonObjectBuilder &record = builder.insertObject(QString::number(i));
+                record.insert(name, QStringLiteral("record"));
+                QJsonArrayBuilder &list = record.insertArray(tags);
+                for (int j = 0; j < 10; ++j)
+                    list.append(j);
+            }
+            QJsonObject object = builder.toObject();
+        }
+    } else {
+        QBENCHMARK {
+            QJsonObject object;
+            for (int i = 0; i < count; ++i) {
+                const QString id = QString::number(i);
+                object.insert(id, QJsonObject());
+                QJsonObject record = object.value(id).toObject();
+                record.insert(name, QStringLiteral("record"));
+                QJsonArray list;
+                for (int j = 0; j < 10; ++j)
+                    list.append(j);
+                record.insert(tags, list);
+                object.insert(id, record);
+            }
+        }
+    }
+}
+
 QTEST_MAIN(BenchmarkQtBinaryJson)
 #include "tst_bench_qtbinaryjson.moc"
 
@@ -28,6 +28,7 @@
 #include <QtCore>
 #include <QtWidgets/QTreeView>
 #include <qtest.h>
+#include <qtesteventloop.h>
 #include "object.h"
 #include <qcoreapplication.h>
 #include <qdatetime.h>
@@ -49,6 +50,10 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void concurrent_emission_benchmark_data();
+    void concurrent_emission_benchmark();
+    void queued_emission_benchmark_data();
+    void queued_emission_benchmark();
 };
 
 struct Functor {
@@ -233,6 +238,95 @@ void QObjectBenchmark::receiver_destroyed_benchmark()
     }
 }
 
+class EmitterThread : public QThread
+{
+public:
+    EmitterThread(Object *sender, int count = SignalsAndSlotsBenchmarkConstant)
+        : sender(sender), count(count) {}
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            sender->emitSignal0();
+    }
+
+    Object *sender;
+    int count;
+};
+
+void QObjectBenchmark::concurrent_emission_benchmark_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("8 threads") << 8;
+}
+
+void QObjectBenchmark::concurrent_emission_benchmark()
+{
+    QFETCH(int, threadCount);
+
+    // direct connections to functors, so that the emissions only contend
+    // on the connection lists of the sender
+    Object sender;
+    Functor functor;
+    for (int i = 0; i < 4; ++i)
+        QObject::connect(&sender, &Object::signal0, &sender, functor, Qt::DirectConnection);
+
+    QBENCHMARK {
+        QVector<EmitterThread *> threads;
+        for (int i = 0; i < threadCount; ++i)
+            threads.append(new EmitterThread(&sender));
+        for (EmitterThread *thread : qAsConst(threads))
+            thread->start();
+        for (EmitterThread *thread : qAsConst(threads))
+            thread->wait();
+        qDeleteAll(threads);
+    }
+}
+
+void QObjectBenchmark::queued_emission_benchmark_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("8 threads") << 8;
+}
+
+void QObjectBenchmark::queued_emission_benchmark()
+{
+    QFETCH(int, threadCount);
+
+    // every sender thread posts its emissions to a receiver living in the
+    // main thread, so this measures posting, waking up and dispatching the
+    // QMetaCallEvents rather than the emission itself
+    enum { EmissionsPerThread = 10000 };
+    const int expected = threadCount * EmissionsPerThread;
+    int received = 0;
+
+    Object sender;
+    QObject receiver;
+    QObject::connect(&sender, &Object::signal0, &receiver, [&received, expected]() {
+        if (++received == expected)
+            QTestEventLoop::instance().exitLoop();
+    }, Qt::QueuedConnection);
+
+    QBENCHMARK {
+        received = 0;
+        QVector<EmitterThread *> threads;
+        for (int i = 0; i < threadCount; ++i)
+            threads.append(new EmitterThread(&sender, EmissionsPerThread));
+        for (EmitterThread *thread : qAsConst(threads))
+            thread->start();
+        QTestEventLoop::instance().enterLoop(60);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+        for (EmitterThread *thread : qAsConst(threads))
+            thread->wait();
+        qDeleteAll(threads);
+    }
+}
+
 QTEST_MAIN(QObjectBenchmark)
 
 #include "main.moc"
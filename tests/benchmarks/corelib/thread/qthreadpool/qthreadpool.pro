@@ -3,3 +3,4 @@ TARGET = tst_bench_qthreadpool
 
 SOURCES += tst_qthreadpool.cpp
 QT = core testlib
+qtHaveModule(concurrent): QT += concurrent
@@ -28,6 +28,9 @@
 
 #include <qtest.h>
 #include <QtCore>
+#ifdef QT_CONCURRENT_LIB
+#include <QtConcurrent>
+#endif
 
 class tst_QThreadPool : public QObject
 {
@@ -40,6 +43,12 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void scaling_data();
+    void scaling();
+#ifdef QT_CONCURRENT_LIB
+    void concurrentMap_data();
+    void concurrentMap();
+#endif
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +84,83 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+static void threadCountData()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("8 threads") << 8;
+    const int ideal = QThread::idealThreadCount();
+    if (ideal > 8)
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 threads").arg(ideal))) << ideal;
+}
+
+// a small, fixed amount of CPU work, so that the cost of handing out the
+// runnables is visible next to the work itself
+static uint spin(uint seed)
+{
+    for (int i = 0; i < 2000; ++i)
+        seed = seed * 1103515245 + 12345;
+    return seed;
+}
+
+class SpinRunnable : public QRunnable
+{
+public:
+    explicit SpinRunnable(QAtomicInt *sink) : sink(sink) {}
+    void run() Q_DECL_OVERRIDE {
+        sink->fetchAndAddRelaxed(int(spin(uint(quintptr(this)))));
+    }
+
+    QAtomicInt *sink;
+};
+
+void tst_QThreadPool::scaling_data()
+{
+    threadCountData();
+}
+
+void tst_QThreadPool::scaling()
+{
+    QFETCH(int, threadCount);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QAtomicInt sink;
+
+    QBENCHMARK {
+        for (int i = 0; i < 10000; ++i)
+            threadPool.start(new SpinRunnable(&sink));
+        threadPool.waitForDone();
+    }
+}
+
+#ifdef QT_CONCURRENT_LIB
+void tst_QThreadPool::concurrentMap_data()
+{
+    threadCountData();
+}
+
+void tst_QThreadPool::concurrentMap()
+{
+    QFETCH(int, threadCount);
+
+    // QtConcurrent always runs on the global pool
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const int oldMaxThreadCount = threadPool->maxThreadCount();
+    threadPool->setMaxThreadCount(threadCount);
+    QVector<uint> values(10000);
+    for (int i = 0; i < values.size(); ++i)
+        values[i] = uint(i);
+
+    QBENCHMARK {
+        QtConcurrent::blockingMap(values, [](uint &value) { value = spin(value); });
+    }
+
+    threadPool->setMaxThreadCount(oldMaxThreadCount);
+}
+#endif
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
@@ -50,6 +50,8 @@ private slots:
     void itemAt_data();
     void itemAt();
     void initialShow();
+    void moveItems_data();
+    void moveItems();
 };
 
 tst_QGraphicsScene::tst_QGraphicsScene()
@@ -239,5 +241,47 @@ void tst_QGraphicsScene::initialShow()
     }
 }
 
+void tst_QGraphicsScene::moveItems_data()
+{
+    QTest::addColumn<int>("numItems");
+    QTest::addColumn<bool>("fixedSceneRect");
+
+    QTest::newRow("10000 items, growing scene rect") << 10000 << false;
+    QTest::newRow("10000 items, fixed scene rect") << 10000 << true;
+    QTest::newRow("100000 items, growing scene rect") << 100000 << false;
+    QTest::newRow("100000 items, fixed scene rect") << 100000 << true;
+}
+
+void tst_QGraphicsScene::moveItems()
+{
+    QFETCH(int, numItems);
+    QFETCH(bool, fixedSceneRect);
+
+    QGraphicsScene scene;
+    if (fixedSceneRect)
+        scene.setSceneRect(-5000, -5000, 10000, 10000);
+
+    qsrand(42);
+    QVector<QGraphicsItem *> items;
+    items.reserve(numItems);
+    for (int i = 0; i < numItems; ++i) {
+        QGraphicsRectItem *item = scene.addRect(0, 0, 10, 10);
+        item->setPos(qrand() % 2000 - 1000, qrand() % 2000 - 1000);
+        items << item;
+    }
+    scene.items(QPointF(0, 0)); // triggers indexing
+    processEvents();
+
+    // Every item drifts away from the origin, so the items bounding rect
+    // keeps growing unless the scene rect is fixed.
+    QBENCHMARK {
+        for (QGraphicsItem *item : qAsConst(items))
+            item->moveBy(item->x() / 100, item->y() / 100);
+        scene.sceneRect(); // grows the scene rect, as a view would
+        scene.items(QRectF(-10, -10, 20, 20)); // triggers indexing
+        processEvents();
+    }
+}
+
 QTEST_MAIN(tst_QGraphicsScene)
 #include "tst_qgraphicsscene.moc"
@@ -119,6 +119,8 @@ private slots:
     void paintSingleItem();
     void paintDeepStackingItems();
     void paintDeepStackingItems_clipped();
+    void paintManyItems_data();
+    void paintManyItems();
     void moveSingleItem();
     void mapPointToScene_data();
     void mapPointToScene();
@@ -250,6 +252,41 @@ void tst_QGraphicsView::paintDeepStackingItems_clipped()
     }
 }
 
+void tst_QGraphicsView::paintManyItems_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::newRow("individual") << false;
+    QTest::newRow("batched") << true;
+}
+
+void tst_QGraphicsView::paintManyItems()
+{
+    QFETCH(bool, batched);
+
+    QGraphicsScene scene(0, 0, 100, 100);
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            QAbstractGraphicsShapeItem *item;
+            if (x < 50)
+                item = scene.addRect(0, 0, 2, 2, QPen(Qt::black), QBrush(Qt::red));
+            else
+                item = scene.addEllipse(0, 0, 2, 2, QPen(Qt::black), QBrush(Qt::blue));
+            item->setPos(x, y);
+            item->setFlag(QGraphicsItem::ItemUsesBatchPainting, batched);
+        }
+    }
+
+    mView.setScene(&scene);
+    mView.tryResize(100, 100);
+    processEvents();
+
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    QBENCHMARK {
+        mView.viewport()->render(&painter);
+    }
+}
+
 void tst_QGraphicsView::moveSingleItem()
 {
     QGraphicsScene scene(0, 0, 100, 100);
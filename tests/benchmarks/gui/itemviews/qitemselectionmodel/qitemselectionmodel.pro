@@ -0,0 +1,6 @@
+QT = core testlib
+
+TEMPLATE = app
+TARGET = tst_bench_qitemselectionmodel
+
+SOURCES += tst_qitemselectionmodel.cpp
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QAbstractTableModel>
+#include <QItemSelectionModel>
+
+class FlatTableModel : public QAbstractTableModel
+{
+public:
+    FlatTableModel(int rows, int columns, QObject *parent = nullptr)
+        : QAbstractTableModel(parent), m_rows(rows), m_columns(columns) {}
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    { return parent.isValid() ? 0 : m_rows; }
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    { return parent.isValid() ? 0 : m_columns; }
+    QVariant data(const QModelIndex &, int) const override { return QVariant(); }
+
+private:
+    int m_rows;
+    int m_columns;
+};
+
+class tst_QItemSelectionModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void isSelected_data();
+    void isSelected();
+    void toggleRow_data();
+    void toggleRow();
+    void selectRows_data();
+    void selectRows();
+
+private:
+    void setupTestData();
+    void selectDisjointRows(QItemSelectionModel *selectionModel, int rangeCount);
+};
+
+static const int rowCount = 1000000;
+
+void tst_QItemSelectionModel::setupTestData()
+{
+    QTest::addColumn<int>("rangeCount");
+    QTest::newRow("100 ranges") << 100;
+    QTest::newRow("1000 ranges") << 1000;
+    QTest::newRow("10000 ranges") << 10000;
+}
+
+// Selects rangeCount disjoint rows, as if they had been ctrl-clicked.
+void tst_QItemSelectionModel::selectDisjointRows(QItemSelectionModel *selectionModel, int rangeCount)
+{
+    const QAbstractItemModel *model = selectionModel->model();
+    const int step = model->rowCount() / rangeCount;
+    QItemSelection selection;
+    for (int row = 0; row < model->rowCount(); row += step)
+        selection.select(model->index(row, 0), model->index(row, model->columnCount() - 1));
+    selectionModel->select(selection, QItemSelectionModel::Select);
+}
+
+void tst_QItemSelectionModel::isSelected_data()
+{
+    setupTestData();
+}
+
+void tst_QItemSelectionModel::isSelected()
+{
+    QFETCH(int, rangeCount);
+    FlatTableModel model(rowCount, 4);
+    QItemSelectionModel selectionModel(&model);
+    selectDisjointRows(&selectionModel, rangeCount);
+
+    // a screen full of cells
+    QBENCHMARK {
+        for (int row = rowCount / 2; row < rowCount / 2 + 50; ++row) {
+            for (int column = 0; column < 4; ++column)
+                selectionModel.isSelected(model.index(row, column));
+        }
+    }
+}
+
+void tst_QItemSelectionModel::toggleRow_data()
+{
+    setupTestData();
+}
+
+void tst_QItemSelectionModel::toggleRow()
+{
+    QFETCH(int, rangeCount);
+    FlatTableModel model(rowCount, 4);
+    QItemSelectionModel selectionModel(&model);
+    selectDisjointRows(&selectionModel, rangeCount);
+
+    const QModelIndex index = model.index(rowCount / 2 + 1, 0);
+    QBENCHMARK {
+        selectionModel.select(index, QItemSelectionModel::Toggle | QItemSelectionModel::Rows);
+    }
+}
+
+void tst_QItemSelectionModel::selectRows_data()
+{
+    setupTestData();
+}
+
+void tst_QItemSelectionModel::selectRows()
+{
+    QFETCH(int, rangeCount);
+    FlatTableModel model(rowCount, 4);
+    QItemSelectionModel selectionModel(&model);
+
+    // a shift-click extending the current selection
+    const QItemSelection selection(model.index(0, 0), model.index(rowCount / 2, 3));
+    QBENCHMARK {
+        selectDisjointRows(&selectionModel, rangeCount);
+        selectionModel.select(selection, QItemSelectionModel::Select | QItemSelectionModel::Current);
+        selectionModel.clearSelection();
+    }
+}
+
+QTEST_MAIN(tst_QItemSelectionModel)
+#include "tst_qitemselectionmodel.moc"
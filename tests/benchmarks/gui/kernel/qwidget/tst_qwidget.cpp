@@ -29,6 +29,8 @@
 #include <qtest.h>
 
 #include <QtWidgets/QLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QLineEdit>
 #include <QtGui/QPainter>
 
 static void processEvents()
@@ -114,6 +116,9 @@ private slots:
     void updatePartial();
     void updateComplex_data();
     void updateComplex();
+    void createForm_data();
+    void createForm();
+    void relayoutForm();
 
 private:
     UpdateWidget widget;
@@ -238,6 +243,60 @@ void tst_QWidget::updateComplex()
     }
 }
 
+void tst_QWidget::createForm_data()
+{
+    QTest::addColumn<int>("fields");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("2500") << 2500;
+}
+
+void tst_QWidget::createForm()
+{
+    QFETCH(int, fields);
+
+    QBENCHMARK {
+        QWidget form;
+        QGridLayout *layout = new QGridLayout(&form);
+        for (int i = 0; i < fields; ++i) {
+            layout->addWidget(new QLabel(QString::number(i)), i / 25, (i % 25) * 2);
+            layout->addWidget(new QLineEdit, i / 25, (i % 25) * 2 + 1);
+        }
+        form.show();
+        processEvents();
+    }
+}
+
+void tst_QWidget::relayoutForm()
+{
+    QWidget form;
+    QVBoxLayout *layout = new QVBoxLayout(&form);
+    QList<QLabel *> labels;
+    for (int group = 0; group < 20; ++group) {
+        QHBoxLayout *row = new QHBoxLayout;
+        layout->addLayout(row);
+        for (int column = 0; column < 3; ++column) {
+            QGridLayout *grid = new QGridLayout;
+            row->addLayout(grid);
+            for (int i = 0; i < 8; ++i) {
+                QLabel *label = new QLabel(QString::number(i));
+                grid->addWidget(label, i, 0);
+                grid->addWidget(new QLineEdit, i, 1);
+                labels.append(label);
+            }
+        }
+    }
+    form.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&form));
+
+    int i = 0;
+    QBENCHMARK {
+        labels.at((i * 7) % labels.size())->setText(QString::number(i));
+        QApplication::sendPostedEvents(0, QEvent::LayoutRequest);
+        ++i;
+    }
+}
+
 QTEST_MAIN(tst_QWidget)
 
 #include "tst_qwidget.moc"
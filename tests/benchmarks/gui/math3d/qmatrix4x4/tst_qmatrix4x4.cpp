@@ -55,6 +55,15 @@ private slots:
     void mapVectorDirect_data();
     void mapVectorDirect();
 
+    void mapPoints_data();
+    void mapPoints();
+
+    void mapPointsBatched_data();
+    void mapPointsBatched();
+
+    void inverted_data();
+    void inverted();
+
     void compareTranslate_data();
     void compareTranslate();
 
@@ -270,6 +279,114 @@ void tst_QMatrix4x4::mapVectorDirect()
     }
 }
 
+static QVector<QVector3D> pointCloud(int count)
+{
+    QVector<QVector3D> points;
+    points.reserve(count);
+    for (int i = 0; i < count; ++i)
+        points.append(QVector3D(i % 97 - 48.5f, i % 89 * 0.25f, i % 83 - 41.0f));
+    return points;
+}
+
+void tst_QMatrix4x4::mapPoints_data()
+{
+    QTest::addColumn<QMatrix4x4>("m1");
+    QTest::addColumn<int>("count");
+
+    QMatrix4x4 t;
+    t.translate(-100.5f, 64.0f, 75.25f);
+    t.scale(2.0f, 3.0f, 4.0f);
+
+    QMatrix4x4 r = t;
+    r.rotate(45.0f, 1.0f, 1.0f, 1.0f);
+
+    QMatrix4x4 p;
+    p.perspective(60.0f, 1.5f, 0.1f, 1000.0f);
+    p *= r;
+
+    for (int count : {100, 10000}) {
+        const QByteArray suffix = ' ' + QByteArray::number(count);
+        QTest::newRow(("translateScale" + suffix).constData()) << t << count;
+        QTest::newRow(("rotate" + suffix).constData()) << r << count;
+        QTest::newRow(("perspective" + suffix).constData()) << p << count;
+    }
+}
+
+// Map a point cloud one point at a time.
+void tst_QMatrix4x4::mapPoints()
+{
+    QFETCH(QMatrix4x4, m1);
+    QFETCH(int, count);
+
+    const QVector<QVector3D> points = pointCloud(count);
+    QVector<QVector3D> results(count);
+    const QVector3D *in = points.constData();
+    QVector3D *out = results.data();
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            out[i] = m1.map(in[i]);
+    }
+
+    vresult = results.last();
+}
+
+void tst_QMatrix4x4::mapPointsBatched_data()
+{
+    mapPoints_data();
+}
+
+// Map the same point cloud with a single call.
+void tst_QMatrix4x4::mapPointsBatched()
+{
+    QFETCH(QMatrix4x4, m1);
+    QFETCH(int, count);
+
+    const QVector<QVector3D> points = pointCloud(count);
+    QVector<QVector3D> results(count);
+
+    QBENCHMARK {
+        m1.map(points.constData(), results.data(), count);
+    }
+
+    vresult = results.last();
+}
+
+void tst_QMatrix4x4::inverted_data()
+{
+    QTest::addColumn<QMatrix4x4>("m1");
+
+    QMatrix4x4 t;
+    t.translate(-100.5f, 64.0f, 75.25f);
+    QTest::newRow("translate") << t;
+
+    QMatrix4x4 r = t;
+    r.rotate(45.0f, 1.0f, 1.0f, 1.0f);
+    QTest::newRow("rotate") << r;
+
+    QMatrix4x4 s = r;
+    s.scale(2.0f, 3.0f, 4.0f);
+    QTest::newRow("affine") << s;
+
+    QMatrix4x4 p;
+    p.perspective(60.0f, 1.5f, 0.1f, 1000.0f);
+    p *= s;
+    QTest::newRow("perspective") << p;
+}
+
+void tst_QMatrix4x4::inverted()
+{
+    QFETCH(QMatrix4x4, m1);
+
+    QMatrix4x4 m2;
+
+    QBENCHMARK {
+        m2 = m1.inverted();
+    }
+
+    mresult = m2;
+}
+
 // Compare the performance of QTransform::translate() to
 // QMatrix4x4::translate().
 void tst_QMatrix4x4::compareTranslate_data()
@@ -1,5 +1,6 @@
 TEMPLATE = subdirs
 SUBDIRS = \
+        qcellrasterizer \
         qcolor \
         qpainter \
         qregion \
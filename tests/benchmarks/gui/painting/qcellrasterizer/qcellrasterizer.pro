@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qcellrasterizer
+QT += testlib gui-private
+SOURCES += tst_qcellrasterizer.cpp
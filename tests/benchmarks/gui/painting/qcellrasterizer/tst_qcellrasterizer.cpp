@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <qmath.h>
+#include <private/qpaintengine_raster_p.h>
+
+Q_DECLARE_METATYPE(QPainterPath)
+
+// Compares the gray raster with the cell rasterizer for antialiased fills.
+class tst_QCellRasterizer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void fillPath_data();
+    void fillPath();
+};
+
+static QPainterPath star(const QPointF &center, qreal radius, int points)
+{
+    QPainterPath path;
+    path.moveTo(center + QPointF(radius, 0));
+    for (int i = 1; i < points; ++i) {
+        const qreal angle = 2 * M_PI * i * (points / 2) / points;
+        path.lineTo(center + radius * QPointF(qCos(angle), qSin(angle)));
+    }
+    path.closeSubpath();
+    return path;
+}
+
+void tst_QCellRasterizer::fillPath_data()
+{
+    QTest::addColumn<QPainterPath>("path");
+    QTest::addColumn<bool>("cellRasterizer");
+
+    QPainterPath icons;
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x)
+            icons.addEllipse(QRectF(x * 50 + 5.5, y * 50 + 5.25, 40, 40));
+    }
+
+    QPainterPath text;
+    QFont font;
+    font.setPixelSize(40);
+    for (int y = 1; y < 25; ++y)
+        text.addText(0, y * 40, font, QStringLiteral("The quick brown fox jumps over the lazy dog"));
+
+    QPainterPath oddEvenStar = star(QPointF(500, 500), 490, 101);
+    oddEvenStar.setFillRule(Qt::OddEvenFill);
+
+    const struct {
+        const char *name;
+        QPainterPath path;
+    } paths[] = {
+        { "large ellipse", [] { QPainterPath p; p.addEllipse(QRectF(10.5, 10.5, 979, 979)); return p; }() },
+        { "small ellipses", icons },
+        { "text", text },
+        { "star winding", star(QPointF(500, 500), 490, 101) },
+        { "star odd-even", oddEvenStar }
+    };
+
+    for (const auto &p : paths) {
+        QTest::addRow("%s, gray raster", p.name) << p.path << false;
+        QTest::addRow("%s, cell rasterizer", p.name) << p.path << true;
+    }
+}
+
+void tst_QCellRasterizer::fillPath()
+{
+    QFETCH(QPainterPath, path);
+    QFETCH(bool, cellRasterizer);
+
+    QImage image(1000, 1000, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    static_cast<QRasterPaintEngine *>(image.paintEngine())->setCellRasterizerEnabled(cellRasterizer);
+
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(40, 80, 160, 200));
+    QBENCHMARK {
+        p.drawPath(path);
+    }
+}
+
+QTEST_MAIN(tst_QCellRasterizer)
+#include "tst_qcellrasterizer.moc"
@@ -39,6 +39,12 @@ private slots:
 
     void intersects_data();
     void intersects();
+
+    void unitedRects_data();
+    void unitedRects();
+
+    void intersected_data();
+    void intersected();
 };
 
 
@@ -121,6 +127,68 @@ void tst_qregion::intersects()
     }
 }
 
+static QVector<QRect> dirtyRects(int count, int size)
+{
+    // A pattern similar to what a widget backing store accumulates when
+    // many small widgets are updated: rectangles spread over a grid, some
+    // of them overlapping their neighbours.
+    QVector<QRect> rects;
+    rects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const int x = (i * 37) % 800;
+        const int y = ((i * 53) / 800) * size + (i % 3) * (size / 2);
+        rects.append(QRect(x, y, size, size));
+    }
+    return rects;
+}
+
+void tst_qregion::unitedRects_data()
+{
+    QTest::addColumn<QVector<QRect> >("rects");
+
+    QTest::newRow("10 rects") << dirtyRects(10, 24);
+    QTest::newRow("100 rects") << dirtyRects(100, 24);
+    QTest::newRow("1000 rects") << dirtyRects(1000, 16);
+}
+
+void tst_qregion::unitedRects()
+{
+    QFETCH(QVector<QRect>, rects);
+
+    QBENCHMARK {
+        QRegion region;
+        for (const QRect &rect : qAsConst(rects))
+            region += rect;
+    }
+}
+
+void tst_qregion::intersected_data()
+{
+    QTest::addColumn<QRegion>("region");
+    QTest::addColumn<QRegion>("clip");
+
+    QRegion clip;
+    for (const QRect &rect : dirtyRects(50, 40))
+        clip += rect;
+
+    for (int count : {10, 100, 1000}) {
+        QRegion region;
+        for (const QRect &rect : dirtyRects(count, 24))
+            region += rect.translated(7, 5);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 rects").arg(count))) << region << clip;
+    }
+}
+
+void tst_qregion::intersected()
+{
+    QFETCH(QRegion, region);
+    QFETCH(QRegion, clip);
+
+    QBENCHMARK {
+        region.intersected(clip);
+    }
+}
+
 QTEST_MAIN(tst_qregion)
 
 #include "main.moc"
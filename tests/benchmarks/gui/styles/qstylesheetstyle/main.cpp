@@ -52,6 +52,9 @@ private slots:
     void grid_data();
     void grid();
 
+    void classes_data();
+    void classes();
+
 private:
     QWidget *buildSimpleWidgets();
 
@@ -184,6 +187,41 @@ void tst_qstylesheetstyle::grid()
     delete w;
 }
 
+void tst_qstylesheetstyle::classes_data()
+{
+    QTest::addColumn<int>("N");
+    for (int n = 5; n <= 25; n += 5)
+        QTest::newRow(QByteArray::number(n*n).constData()) << n;
+}
+
+void tst_qstylesheetstyle::classes()
+{
+    QFETCH(int, N);
+
+    QWidget *w = new QWidget();
+    QGridLayout *layout = new QGridLayout(w);
+    w->setLayout(layout);
+    QString stylesheet;
+    for(int x=0; x<N ;x++)
+        for(int y=0; y<N ;y++) {
+        QLabel *label = new QLabel(QString::number(y * N + x));
+        layout->addWidget(label ,x,y);
+        label->setProperty("class", QString("cell%1 row%2").arg(y * N + x).arg(x));
+        stylesheet += QString(".cell%1 { background-color: rgb(0,%2,%3); } ").arg(y*N+x).arg(y*255/N).arg(x*255/N);
+    }
+    for (int x = 0; x < N; x++)
+        stylesheet += QString(".row%1 { color: rgb(%2,0,255); } ").arg(x).arg(x*255/N);
+
+    w->setStyleSheet("/* */");
+    QApplication::processEvents();
+    int i = 0;
+    QBENCHMARK {
+        w->setStyleSheet(stylesheet + "/*" + QString::number(i) + "*/");
+        i++; // we want a different string in case we have severals iterations
+    }
+    delete w;
+}
+
 QTEST_MAIN(tst_qstylesheetstyle)
 
 #include "main.moc"
@@ -3,4 +3,10 @@ SUBDIRS = \
         qfile_vs_qnetworkaccessmanager \
         qnetworkreply \
         qnetworkreply_from_cache \
-        qnetworkdiskcache
+        qnetworkdiskcache \
+        hpack \
+        http2
+
+!qtConfig(private_tests): SUBDIRS -= \
+        hpack \
+        http2
@@ -0,0 +1,15 @@
+TEMPLATE = app
+TARGET = tst_bench_http2
+
+QT -= gui
+QT += core-private network network-private testlib
+
+CONFIG += release c++11
+
+# the in-process server of the auto test, together with its certificates
+HTTP2_SERVER_DIR = $$PWD/../../../../auto/network/access/http2
+INCLUDEPATH += $$HTTP2_SERVER_DIR
+HEADERS += $$HTTP2_SERVER_DIR/http2srv.h
+SOURCES += tst_bench_http2.cpp $$HTTP2_SERVER_DIR/http2srv.cpp
+
+DEFINES += SRCDIR=\\\"$$HTTP2_SERVER_DIR/\\\"
@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include "http2srv.h"
+
+#include <QtNetwork/private/http2protocol_p.h>
+#include <QtNetwork/qnetworkaccessmanager.h>
+#include <QtNetwork/qnetworkrequest.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qurl.h>
+
+#if !defined(QT_NO_OPENSSL) && OPENSSL_VERSION_NUMBER >= 0x10002000L && !defined(OPENSSL_NO_TLSEXT)
+const bool clearTextHTTP2 = false;
+#else
+const bool clearTextHTTP2 = true;
+#endif
+
+QT_USE_NAMESPACE
+
+class tst_Http2 : public QObject
+{
+    Q_OBJECT
+public:
+    tst_Http2();
+    ~tst_Http2();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void multiplexedRequests_data();
+    void multiplexedRequests();
+
+private:
+    void sendRequest(int streamNumber);
+    bool runRequests(int count);
+
+    QThread serverThread;
+    Http2Server *server = nullptr;
+    quint16 serverPort = 0;
+    QNetworkAccessManager manager;
+    int pendingReplies = 0;
+    bool failed = false;
+};
+
+tst_Http2::tst_Http2()
+{
+    serverThread.start();
+}
+
+tst_Http2::~tst_Http2()
+{
+    serverThread.quit();
+    serverThread.wait();
+}
+
+void tst_Http2::initTestCase()
+{
+    using namespace Http2;
+
+    const RawSettings serverSettings{{Settings::MAX_CONCURRENT_STREAMS_ID, 100}};
+    server = new Http2Server(clearTextHTTP2, serverSettings, {});
+    // a 16 KiB body: large enough to need several DATA frames per stream,
+    // small enough to stay within the default flow control windows
+    server->setResponseBody(QByteArray(16 * 1024, 'x'));
+
+    connect(server, &Http2Server::serverStarted, this, [this](quint16 port) {
+        serverPort = port;
+        QTestEventLoop::instance().exitLoop();
+    });
+    connect(server, &Http2Server::receivedRequest, this, [this](quint32 streamID) {
+        QMetaObject::invokeMethod(server, "sendResponse", Qt::QueuedConnection,
+                                  Q_ARG(quint32, streamID), Q_ARG(bool, false));
+    });
+    server->moveToThread(&serverThread);
+
+    QMetaObject::invokeMethod(server, "startServer", Qt::QueuedConnection);
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(serverPort != 0);
+
+    // Establish the connection up front, so that the handshake and the
+    // SETTINGS exchange are not part of the first measurement.
+    QVERIFY(runRequests(1));
+}
+
+void tst_Http2::cleanupTestCase()
+{
+    if (server)
+        QMetaObject::invokeMethod(server, "deleteLater", Qt::QueuedConnection);
+    server = nullptr;
+}
+
+void tst_Http2::multiplexedRequests_data()
+{
+    QTest::addColumn<int>("concurrentStreams");
+    QTest::newRow("1 stream") << 1;
+    QTest::newRow("10 streams") << 10;
+    QTest::newRow("50 streams") << 50;
+    QTest::newRow("100 streams") << 100;
+}
+
+void tst_Http2::multiplexedRequests()
+{
+    QFETCH(int, concurrentStreams);
+
+    QBENCHMARK {
+        QVERIFY(runRequests(concurrentStreams));
+    }
+}
+
+void tst_Http2::sendRequest(int streamNumber)
+{
+    QUrl url(QLatin1String(clearTextHTTP2 ? "http://127.0.0.1" : "https://127.0.0.1"));
+    url.setPort(serverPort);
+    url.setPath(QString::fromLatin1("/stream%1.html").arg(streamNumber));
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, QVariant(true));
+
+    QNetworkReply *reply = manager.get(request);
+    // the server uses a self-signed certificate
+    reply->ignoreSslErrors();
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        if (reply->error() != QNetworkReply::NoError
+            || !reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool()) {
+            failed = true;
+        }
+        reply->deleteLater();
+        if (!--pendingReplies)
+            QTestEventLoop::instance().exitLoop();
+    });
+}
+
+bool tst_Http2::runRequests(int count)
+{
+    pendingReplies = count;
+    failed = false;
+    for (int i = 0; i < count; ++i)
+        sendRequest(i);
+    QTestEventLoop::instance().enterLoop(30);
+    return !QTestEventLoop::instance().timeout() && !failed;
+}
+
+QTEST_MAIN(tst_Http2)
+
+#include "tst_bench_http2.moc"
@@ -45,6 +45,8 @@ public slots:
 private slots:
     void lookupSpeed_data();
     void lookupSpeed();
+    void lookupThroughput_data();
+    void lookupThroughput();
 };
 
 class SignalReceiver : public QObject
@@ -101,6 +103,33 @@ void tst_qhostinfo::lookupSpeed()
     }
 }
 
+void tst_qhostinfo::lookupThroughput_data()
+{
+    QTest::addColumn<int>("concurrentLookups");
+    QTest::newRow("1 lookup") << 1;
+    QTest::newRow("10 lookups") << 10;
+    QTest::newRow("100 lookups") << 100;
+    QTest::newRow("1000 lookups") << 1000;
+}
+
+void tst_qhostinfo::lookupThroughput()
+{
+    // "localhost" is resolved by the system resolver, usually without going
+    // to the network, so this measures the lookup manager and its thread
+    // pool rather than DNS latency
+    QFETCH(int, concurrentLookups);
+    qt_qhostinfo_enable_cache(false);
+
+    SignalReceiver receiver(concurrentLookups);
+
+    QBENCHMARK {
+        receiver.receiveCount = 0;
+        for (int i = 0; i < concurrentLookups; ++i)
+            QHostInfo::lookupHost(QStringLiteral("localhost"), &receiver, SLOT(resultsReady(QHostInfo)));
+        QTestEventLoop::instance().enterLoop(20);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    }
+}
 
 QTEST_MAIN(tst_qhostinfo)
 